@@ -0,0 +1,85 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+package com.trustwallet.core.app.benchmarks
+
+import com.trustwallet.core.app.utils.toHexByteArray
+import org.junit.Assert.assertTrue
+import org.junit.Test
+import wallet.core.java.AnySigner
+import wallet.core.jni.CoinType
+import wallet.core.jni.HDWallet
+import wallet.core.jni.Hash
+import java.nio.ByteBuffer
+
+/**
+ * The binding benchmarks of benchmarks/BindingBenchmarks.cpp through the JNI wrapper.
+ * Compare `BM_Binding/<operation>/jni` with `BM_Binding/<operation>/c` of the native run for the wrapper overhead;
+ * `jniDirect` signs between direct buffers with `AnySigner.signInto`.
+ */
+class TestBindingBenchmarks {
+
+    init {
+        System.loadLibrary("TrustWalletCore")
+    }
+
+    private val iterations = 2000
+    private val mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal"
+    private val ethereumInput = "0a0101120109220504a817c8002a025208422a3078333533353335333533353335333533353335333533353335333533353335333533353335333533354a204646464646464646464646464646464646464646464646464646464646464646520c0a0a0a080de0b6b3a7640000".toHexByteArray()
+    private val bitcoinInput = "080110b0ff8ea001180122223142703955316f675633413134464d764b62524a6d7337637479736f345a345463782a2231465163354c646747484d48454e396e776b6a6d7a3674576b7868507078427642553220619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9424a0a2a0a20ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a100118ffffffff0f121600141d0f172a0ecb48aee1be1f2687d2963ae33f71a118808c8d9e02".toHexByteArray()
+
+    /** Runs [body], which returns the number of bytes copied across the binding, and prints the time and the copied bytes per call. */
+    private fun run(operation: String, layer: String, body: () -> Int) {
+        var copied = 0L
+        val start = System.nanoTime()
+        repeat(iterations) {
+            copied += body()
+        }
+        val nsPerOp = (System.nanoTime() - start).toDouble() / iterations
+        println("BM_Binding/$operation/$layer ns_per_op=$nsPerOp bytes_copied_per_op=${copied / iterations}")
+    }
+
+    private fun runSign(operation: String, input: ByteArray, coin: CoinType) {
+        assertTrue(AnySigner.nativeSign(input, coin.value()).isNotEmpty())
+        run(operation, "jni") {
+            input.size + AnySigner.nativeSign(input, coin.value()).size
+        }
+
+        val directInput = ByteBuffer.allocateDirect(input.size).put(input)
+        directInput.flip()
+        val directOutput = ByteBuffer.allocateDirect(4096)
+        run(operation, "jniDirect") {
+            directOutput.clear()
+            input.size + AnySigner.signInto(directInput, coin, directOutput)
+        }
+    }
+
+    @Test
+    fun testHash() {
+        val input = ByteArray(1024) { 0x5a }
+        run("hash", "jni") {
+            input.size + Hash.keccak256(input).size
+        }
+    }
+
+    @Test
+    fun testDeriveAddress() {
+        val wallet = HDWallet(mnemonic, "")
+        run("deriveAddress", "jni") {
+            wallet.getAddressForCoin(CoinType.ETHEREUM).length
+        }
+    }
+
+    @Test
+    fun testSignEthereum() {
+        runSign("signEthereum", ethereumInput, CoinType.ETHEREUM)
+    }
+
+    @Test
+    fun testSignBitcoin() {
+        runSign("signBitcoin", bitcoinInput, CoinType.BITCOIN)
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace TW::benchmarks {
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+void* countedAllocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+uint64_t allocationCount() noexcept {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace TW::benchmarks
+
+// Replacements of the global allocation operators. The nothrow forms call these by default; over-aligned
+// allocations are not counted.
+void* operator new(std::size_t size) {
+    return TW::benchmarks::countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return TW::benchmarks::countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,17 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <cstdint>
+
+namespace TW::benchmarks {
+
+/// Number of `operator new` calls made so far by the benchmark process, on all threads.
+/// The global allocation operators of the benchmark executable are replaced to count them.
+uint64_t allocationCount() noexcept;
+
+} // namespace TW::benchmarks
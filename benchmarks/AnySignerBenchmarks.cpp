@@ -0,0 +1,159 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Aptos.pb.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Cosmos.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/Solana.pb.h"
+
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW::benchmarks {
+
+/// A representative signing input per blockchain, taken from the unit tests.
+struct SigningCase {
+    const char* name;
+    TWCoinType coin;
+    std::function<std::string()> input;
+};
+
+static std::string ethereumTransfer() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return input.SerializeAsString();
+}
+
+static std::string bitcoinP2WPKH() {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(335'790'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+    const auto key = parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9");
+    input.add_private_key(key.data(), key.size());
+
+    const auto hash = parse_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+    const auto script = parse_hex("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    auto& utxo = *input.add_utxo();
+    utxo.mutable_out_point()->set_hash(hash.data(), hash.size());
+    utxo.mutable_out_point()->set_index(1);
+    utxo.mutable_out_point()->set_sequence(UINT32_MAX);
+    utxo.set_script(script.data(), script.size());
+    utxo.set_amount(600'000'000);
+    return input.SerializeAsString();
+}
+
+static std::string solanaTransfer() {
+    Solana::Proto::SigningInput input;
+    const auto key = Base58::decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr");
+    input.mutable_transfer_transaction()->set_recipient("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd");
+    input.mutable_transfer_transaction()->set_value(42);
+    input.set_private_key(key.data(), key.size());
+    input.set_recent_blockhash("11111111111111111111111111111111");
+    return input.SerializeAsString();
+}
+
+static std::string cosmosSend() {
+    Cosmos::Proto::SigningInput input;
+    input.set_signing_mode(Cosmos::Proto::Protobuf);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_sequence(8);
+    auto& message = *input.add_messages()->mutable_send_coins_message();
+    message.set_from_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    message.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+    auto& amount = *message.add_amounts();
+    amount.set_denom("muon");
+    amount.set_amount("1");
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    auto& feeAmount = *fee.add_amounts();
+    feeAmount.set_denom("muon");
+    feeAmount.set_amount("200");
+    const auto key = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(key.data(), key.size());
+    return input.SerializeAsString();
+}
+
+static std::string aptosTransfer() {
+    Aptos::Proto::SigningInput input;
+    input.set_sender("0x07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30");
+    input.set_sequence_number(99);
+    input.mutable_transfer()->set_to("0x07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30");
+    input.mutable_transfer()->set_amount(1000);
+    input.set_max_gas_amount(3296766);
+    input.set_gas_unit_price(100);
+    input.set_expiration_timestamp_secs(3664390082);
+    input.set_chain_id(33);
+    const auto key = parse_hex("5d996aa76b3212142792d9130796cd2e11e3c445a93118c08414df4f66bc60ec");
+    input.set_private_key(key.data(), key.size());
+    return input.SerializeAsString();
+}
+
+static const std::vector<SigningCase> signingCases = {
+    {"Ethereum", TWCoinTypeEthereum, ethereumTransfer},
+    {"Bitcoin", TWCoinTypeBitcoin, bitcoinP2WPKH},
+    {"Solana", TWCoinTypeSolana, solanaTransfer},
+    {"Cosmos", TWCoinTypeCosmos, cosmosSend},
+    {"Aptos", TWCoinTypeAptos, aptosTransfer},
+};
+
+/// `anyCoinSign` (the implementation of `TWAnySignerSign`) of one serialized input.
+static void BM_AnySignerSign(benchmark::State& state, const SigningCase& signingCase) {
+    const auto serialized = signingCase.input();
+    const Data input(serialized.begin(), serialized.end());
+    for (auto _ : state) {
+        Data output;
+        anyCoinSign(signingCase.coin, input, output);
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+/// `anyCoinSignBatch` of 64 copies of the same input on all cores.
+static void BM_AnySignerSignBatch(benchmark::State& state, const SigningCase& signingCase) {
+    const auto serialized = signingCase.input();
+    const std::vector<Data> inputs(64, Data(serialized.begin(), serialized.end()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(anyCoinSignBatch(signingCase.coin, inputs, 0));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(inputs.size()));
+}
+
+static const bool anySignerBenchmarksRegistered = [] {
+    for (const auto& signingCase : signingCases) {
+        benchmark::RegisterBenchmark((std::string("BM_AnySignerSign/") + signingCase.name).c_str(), BM_AnySignerSign, signingCase);
+        benchmark::RegisterBenchmark((std::string("BM_AnySignerSignBatch/") + signingCase.name).c_str(), BM_AnySignerSignBatch, signingCase)
+            ->UseRealTime();
+    }
+    return true;
+}();
+
+} // namespace TW::benchmarks
@@ -0,0 +1,136 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Operations of the binding benchmarks, through the C++ core and through the C interface every wrapper calls.
+// The wrappers run the same operations on the same inputs:
+// - swift/Tests/BindingBenchmarks.swift
+// - android/app/src/androidTest/java/com/trustwallet/core/app/benchmarks/TestBindingBenchmarks.kt (JNI)
+// - wasm/bench/bindings.ts
+// and report `BM_Binding/<operation>/<layer>` with the same counters, so the overhead of a wrapper is its time minus
+// the one of the `c` layer here, and the cost of the C interface is the `c` time minus the `core` one.
+
+#include "AllocationCounter.h"
+#include "Coin.h"
+#include "HDWallet.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWData.h>
+#include <TrustWalletCore/TWHash.h>
+#include <TrustWalletCore/TWHDWallet.h>
+#include <TrustWalletCore/TWString.h>
+
+#include <benchmark/benchmark.h>
+
+namespace TW::benchmarks {
+
+namespace {
+
+const auto bindingMnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+/// Size of the input of the hash operation.
+constexpr std::size_t hashInputSize = 1024;
+
+/// Serialized signing inputs, the transfers of AnySignerBenchmarks.
+const auto ethereumInput = parse_hex("0a0101120109220504a817c8002a025208422a3078333533353335333533353335333533353335333533353335333533353335333533353335333533354a204646464646464646464646464646464646464646464646464646464646464646520c0a0a0a080de0b6b3a7640000");
+const auto bitcoinInput = parse_hex("080110b0ff8ea001180122223142703955316f675633413134464d764b62524a6d7337637479736f345a345463782a2231465163354c646747484d48454e396e776b6a6d7a3674576b7868507078427642553220619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9424a0a2a0a20ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a100118ffffffff0f121600141d0f172a0ecb48aee1be1f2687d2963ae33f71a118808c8d9e02");
+
+/// Runs `operation`, which returns the number of bytes it copied across the binding, and reports per call
+/// the allocations and the copied bytes.
+template <typename Operation>
+void measure(benchmark::State& state, Operation&& operation) {
+    std::size_t copied = 0;
+    const auto allocations = allocationCount();
+    for (auto _ : state) {
+        copied += operation();
+    }
+    const auto iterations = static_cast<double>(state.iterations());
+    state.counters["allocs_per_op"] = static_cast<double>(allocationCount() - allocations) / iterations;
+    state.counters["bytes_copied_per_op"] = static_cast<double>(copied) / iterations;
+}
+
+/// Copies the bytes of `data` out and deletes it, as a wrapper does with a returned TWData.
+std::size_t takeData(TWData* data) {
+    const auto size = TWDataSize(data);
+    Data copy(TWDataBytes(data), TWDataBytes(data) + size);
+    benchmark::DoNotOptimize(copy);
+    TWDataDelete(data);
+    return size;
+}
+
+} // namespace
+
+static void BM_Binding_Hash_core(benchmark::State& state) {
+    const Data input(hashInputSize, 0x5a);
+    measure(state, [&] {
+        benchmark::DoNotOptimize(Hash::keccak256(input));
+        return std::size_t(0);
+    });
+}
+BENCHMARK(BM_Binding_Hash_core)->Name("BM_Binding/hash/core");
+
+static void BM_Binding_Hash_c(benchmark::State& state) {
+    const Data input(hashInputSize, 0x5a);
+    measure(state, [&] {
+        auto* data = TWDataCreateWithBytes(input.data(), input.size());
+        const auto copied = input.size() + takeData(TWHashKeccak256(data));
+        TWDataDelete(data);
+        return copied;
+    });
+}
+BENCHMARK(BM_Binding_Hash_c)->Name("BM_Binding/hash/c");
+
+static void BM_Binding_DeriveAddress_core(benchmark::State& state) {
+    const HDWallet wallet(bindingMnemonic, "");
+    measure(state, [&] {
+        benchmark::DoNotOptimize(wallet.deriveAddress(TWCoinTypeEthereum));
+        return std::size_t(0);
+    });
+}
+BENCHMARK(BM_Binding_DeriveAddress_core)->Name("BM_Binding/deriveAddress/core");
+
+static void BM_Binding_DeriveAddress_c(benchmark::State& state) {
+    auto* mnemonic = TWStringCreateWithUTF8Bytes(bindingMnemonic);
+    auto* passphrase = TWStringCreateWithUTF8Bytes("");
+    auto* wallet = TWHDWalletCreateWithMnemonic(mnemonic, passphrase);
+    measure(state, [&] {
+        auto* address = TWHDWalletGetAddressForCoin(wallet, TWCoinTypeEthereum);
+        const auto size = TWStringSize(address);
+        std::string copy(TWStringUTF8Bytes(address), size);
+        benchmark::DoNotOptimize(copy);
+        TWStringDelete(address);
+        return size;
+    });
+    TWHDWalletDelete(wallet);
+    TWStringDelete(passphrase);
+    TWStringDelete(mnemonic);
+}
+BENCHMARK(BM_Binding_DeriveAddress_c)->Name("BM_Binding/deriveAddress/c");
+
+static void BM_Binding_Sign_core(benchmark::State& state, TWCoinType coin, const Data& input) {
+    measure(state, [&] {
+        Data output;
+        anyCoinSign(coin, input, output);
+        benchmark::DoNotOptimize(output);
+        return std::size_t(0);
+    });
+}
+BENCHMARK_CAPTURE(BM_Binding_Sign_core, ethereum, TWCoinTypeEthereum, ethereumInput)->Name("BM_Binding/signEthereum/core");
+BENCHMARK_CAPTURE(BM_Binding_Sign_core, bitcoin, TWCoinTypeBitcoin, bitcoinInput)->Name("BM_Binding/signBitcoin/core");
+
+static void BM_Binding_Sign_c(benchmark::State& state, TWCoinType coin, const Data& input) {
+    measure(state, [&] {
+        auto* data = TWDataCreateWithBytes(input.data(), input.size());
+        const auto copied = input.size() + takeData(TWAnySignerSign(data, coin));
+        TWDataDelete(data);
+        return copied;
+    });
+}
+BENCHMARK_CAPTURE(BM_Binding_Sign_c, ethereum, TWCoinTypeEthereum, ethereumInput)->Name("BM_Binding/signEthereum/c");
+BENCHMARK_CAPTURE(BM_Binding_Sign_c, bitcoin, TWCoinTypeBitcoin, bitcoinInput)->Name("BM_Binding/signBitcoin/c");
+
+} // namespace TW::benchmarks
@@ -0,0 +1,107 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "Bech32.h"
+#include "Cbor.h"
+#include "Ethereum/ABI.h"
+#include "Ethereum/RLP.h"
+#include "HexCoding.h"
+
+#include <benchmark/benchmark.h>
+
+namespace TW::benchmarks {
+
+static void BM_Base58EncodeCheck(benchmark::State& state) {
+    const Data payload = parse_hex("0088a5e143bd53bca4a4c2bd8cad1ef9a102d8e9a7fa6f8b5c");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base58::encodeCheck(payload));
+    }
+}
+BENCHMARK(BM_Base58EncodeCheck);
+
+static void BM_Base58DecodeCheck(benchmark::State& state) {
+    const std::string encoded = "1DeK7xHvwZA4Q7gEiWRZXvYUU7VqAhzuUf";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base58::decodeCheck(encoded));
+    }
+}
+BENCHMARK(BM_Base58DecodeCheck);
+
+static void BM_Bech32Encode(benchmark::State& state) {
+    Data values;
+    Bech32::convertBits<8, 5, true>(values, parse_hex("751e76e8199196d454941c45d1b3a323f1433bd6"));
+    values.insert(values.begin(), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Bech32::encode("bc", values, Bech32::ChecksumVariant::Bech32));
+    }
+}
+BENCHMARK(BM_Bech32Encode);
+
+static void BM_Bech32Decode(benchmark::State& state) {
+    const std::string encoded = "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Bech32::decode(encoded));
+    }
+}
+BENCHMARK(BM_Bech32Decode);
+
+static void BM_RLPEncodeList(benchmark::State& state) {
+    // fields of a legacy Ethereum transaction
+    const auto to = parse_hex("3535353535353535353535353535353535353535");
+    for (auto _ : state) {
+        Data encoded;
+        append(encoded, Ethereum::RLP::encode(uint256_t(9)));
+        append(encoded, Ethereum::RLP::encode(uint256_t(20000000000)));
+        append(encoded, Ethereum::RLP::encode(uint256_t(21000)));
+        append(encoded, Ethereum::RLP::encode(to));
+        append(encoded, Ethereum::RLP::encode(uint256_t(1000000000000000000)));
+        append(encoded, Ethereum::RLP::encode(Data()));
+        benchmark::DoNotOptimize(Ethereum::RLP::encodeList(encoded));
+    }
+}
+BENCHMARK(BM_RLPEncodeList);
+
+static void BM_ABIEncodeTransfer(benchmark::State& state) {
+    const auto to = parse_hex("5322b34c88ed0691971bf52a7047448f0f4efc84");
+    for (auto _ : state) {
+        auto func = Ethereum::ABI::Function("transfer", std::vector<std::shared_ptr<Ethereum::ABI::ParamBase>>{
+                                                            std::make_shared<Ethereum::ABI::ParamAddress>(to),
+                                                            std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(2000000000000000000))});
+        Data payload;
+        func.encode(payload);
+        benchmark::DoNotOptimize(payload);
+    }
+}
+BENCHMARK(BM_ABIEncodeTransfer);
+
+static void BM_CborEncodeMap(benchmark::State& state) {
+    const auto address = parse_hex("01d3ba7c5d3b8d4c1d7e3e4f6a5b1e2d3c4b5a6978");
+    for (auto _ : state) {
+        const auto encoded = Cbor::Encode::map({
+            {Cbor::Encode::uint(0), Cbor::Encode::array({Cbor::Encode::bytes(address), Cbor::Encode::uint(1)})},
+            {Cbor::Encode::uint(1), Cbor::Encode::array({Cbor::Encode::array({Cbor::Encode::bytes(address), Cbor::Encode::uint(2000000)})})},
+            {Cbor::Encode::uint(2), Cbor::Encode::uint(170000)},
+            {Cbor::Encode::uint(3), Cbor::Encode::uint(53333345)},
+        });
+        benchmark::DoNotOptimize(encoded.encoded());
+    }
+}
+BENCHMARK(BM_CborEncodeMap);
+
+static void BM_CborDecodeMap(benchmark::State& state) {
+    const auto address = parse_hex("01d3ba7c5d3b8d4c1d7e3e4f6a5b1e2d3c4b5a6978");
+    const auto encoded = Cbor::Encode::map({
+        {Cbor::Encode::uint(0), Cbor::Encode::array({Cbor::Encode::bytes(address), Cbor::Encode::uint(1)})},
+        {Cbor::Encode::uint(2), Cbor::Encode::uint(170000)},
+    }).encoded();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Cbor::Decode(encoded).getMapElements());
+    }
+}
+BENCHMARK(BM_CborDecodeMap);
+
+} // namespace TW::benchmarks
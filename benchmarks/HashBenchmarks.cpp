@@ -0,0 +1,106 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Blake2b.h"
+#include "Hash.h"
+#include "rust/bindgen/WalletCoreRSBindgen.h"
+#include "rust/Wrapper.h"
+
+#include <benchmark/benchmark.h>
+
+namespace TW::benchmarks {
+
+/// Runs `hasher` over an input of `state.range(0)` bytes.
+template <Data (*hasher)(const byte*, size_t)>
+static void BM_Hash(benchmark::State& state) {
+    const Data input(state.range(0), 0x5a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hasher(input.data(), input.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+#define HASH_BENCHMARK(hasher) BENCHMARK_TEMPLATE(BM_Hash, hasher)->Arg(32)->Arg(1024)->Arg(64 * 1024)
+
+HASH_BENCHMARK(Hash::sha1);
+HASH_BENCHMARK(Hash::sha256);
+HASH_BENCHMARK(Hash::sha512);
+HASH_BENCHMARK(Hash::keccak256);
+HASH_BENCHMARK(Hash::sha3_256);
+HASH_BENCHMARK(Hash::ripemd);
+HASH_BENCHMARK(Hash::blake256);
+HASH_BENCHMARK(Hash::blake2b);
+HASH_BENCHMARK(Hash::groestl512);
+HASH_BENCHMARK(Hash::groestl512d);
+HASH_BENCHMARK(Hash::sha256d);
+HASH_BENCHMARK(Hash::sha256ripemd);
+
+static void BM_Sha256Into(benchmark::State& state) {
+    const Data input(state.range(0), 0x5a);
+    Hash::Digest32 digest;
+    for (auto _ : state) {
+        Hash::sha256Into(input.data(), input.size(), digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Sha256Into)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+
+/// The portable Groestl512, which `Hash::groestl512` falls back to without AES-NI.
+static Data groestl512Portable(const byte* data, size_t size) {
+    return Rust::CByteArrayWrapper(Rust::groestl_512(data, size)).data;
+}
+HASH_BENCHMARK(groestl512Portable);
+
+/// Blake2b-256 of `state.range(0)` 32-byte keys, one at a time or as a batch.
+static void BM_Blake2bKeys(benchmark::State& state, bool batch) {
+    const Blake2b::Context context(32);
+    std::vector<Data> keys;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        keys.emplace_back(32, static_cast<byte>(i));
+    }
+    Data digests(keys.size() * context.hashSize());
+    for (auto _ : state) {
+        if (batch) {
+            context.hashBatch(keys, digests.data());
+        } else {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                context.hash(keys[i].data(), keys[i].size(), digests.data() + i * context.hashSize());
+            }
+        }
+        benchmark::DoNotOptimize(digests);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_Blake2bKeys, single, false)->Arg(64);
+BENCHMARK_CAPTURE(BM_Blake2bKeys, batch, true)->Arg(64);
+
+/// Keccak256 of `state.range(0)` 64-byte public keys as a batch.
+static void BM_Keccak256Batch(benchmark::State& state) {
+    std::vector<Data> keys;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        keys.emplace_back(64, static_cast<byte>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hash::keccak256Batch(keys));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Keccak256Batch)->Arg(64);
+
+static void BM_Sha256ripemdBatch(benchmark::State& state) {
+    std::vector<Data> keys;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        keys.emplace_back(33, static_cast<byte>(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hash::sha256ripemdBatch(keys));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Sha256ripemdBatch)->Arg(64);
+
+} // namespace TW::benchmarks
@@ -0,0 +1,151 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Coin.h"
+#include "HDWallet.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "Keystore/Scrypt.h"
+#include "PrivateKey.h"
+#include "SigningContext.h"
+
+#include <benchmark/benchmark.h>
+
+namespace TW::benchmarks {
+
+const auto privateKeyData = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+static void BM_PrivateKeySign(benchmark::State& state) {
+    const auto curve = static_cast<TWCurve>(state.range(0));
+    const auto privateKey = PrivateKey(privateKeyData);
+    const auto digest = Hash::keccak256(TW::data("hello"));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(privateKey.sign(digest, curve));
+    }
+}
+BENCHMARK(BM_PrivateKeySign)
+    ->ArgName("curve")
+    ->Arg(TWCurveSECP256k1)
+    ->Arg(TWCurveNIST256p1)
+    ->Arg(TWCurveED25519)
+    ->Arg(TWCurveCurve25519);
+
+static void BM_SigningContextSign(benchmark::State& state) {
+    const auto context = SigningContext(PrivateKey(privateKeyData), TWCurveSECP256k1);
+    const auto digest = Hash::keccak256(TW::data("hello"));
+    SigningContext::Signature signature;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.sign(digest, signature));
+    }
+}
+BENCHMARK(BM_SigningContextSign);
+
+static void BM_PrivateKeyGetPublicKey(benchmark::State& state) {
+    const auto type = static_cast<TWPublicKeyType>(state.range(0));
+    const auto privateKey = PrivateKey(privateKeyData);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(privateKey.getPublicKey(type));
+    }
+}
+BENCHMARK(BM_PrivateKeyGetPublicKey)
+    ->ArgName("type")
+    ->Arg(TWPublicKeyTypeSECP256k1)
+    ->Arg(TWPublicKeyTypeSECP256k1Extended)
+    ->Arg(TWPublicKeyTypeNIST256p1Extended)
+    ->Arg(TWPublicKeyTypeED25519);
+
+/// `PrivateKey::getPublicKeys` on one thread, with 4- or 8-bit generator table windows.
+static void BM_PrivateKeyGetPublicKeys(benchmark::State& state) {
+    const auto type = static_cast<TWPublicKeyType>(state.range(0));
+    const auto windowBits = static_cast<unsigned>(state.range(1));
+    std::vector<PrivateKey> privateKeys;
+    for (int i = 0; i < 256; ++i) {
+        privateKeys.emplace_back(Hash::sha256(TW::data(std::to_string(i))));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PrivateKey::getPublicKeys(privateKeys, type, 1, windowBits));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 256);
+}
+BENCHMARK(BM_PrivateKeyGetPublicKeys)
+    ->ArgNames({"type", "window"})
+    ->Args({TWPublicKeyTypeSECP256k1Extended, 4})
+    ->Args({TWPublicKeyTypeSECP256k1Extended, 8})
+    ->Args({TWPublicKeyTypeNIST256p1Extended, 4})
+    ->Args({TWPublicKeyTypeNIST256p1Extended, 8})
+    ->Args({TWPublicKeyTypeED25519, 4});
+
+static void BM_HDWalletCreate(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HDWallet(mnemonic, ""));
+    }
+}
+BENCHMARK(BM_HDWalletCreate);
+
+/// `HDWallet::createBatch` for 16 passphrases of one mnemonic, in the calling thread (1) or on all cores (0).
+static void BM_HDWalletCreateBatch(benchmark::State& state) {
+    std::vector<std::string> passphrases;
+    for (auto i = 0; i < 16; ++i) {
+        passphrases.push_back(std::to_string(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HDWallet<>::createBatch({mnemonic}, passphrases, true, state.range(0)));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(passphrases.size()));
+}
+BENCHMARK(BM_HDWalletCreateBatch)->ArgName("threads")->Arg(1)->Arg(0);
+
+/// `HDWallet::getKey` for consecutive address indices, with (1) or without (0) the node cache.
+static void BM_HDWalletGetKey(benchmark::State& state) {
+    auto wallet = HDWallet(mnemonic, "");
+    if (state.range(0) != 0) {
+        wallet.enableNodeCache();
+    }
+    uint32_t index = 0;
+    for (auto _ : state) {
+        const auto path = DerivationPath(TWPurposeBIP84, TWCoinTypeBitcoin, 0, 0, index++ % 1000);
+        benchmark::DoNotOptimize(wallet.getKey(TWCoinTypeBitcoin, path));
+    }
+}
+BENCHMARK(BM_HDWalletGetKey)->ArgName("cache")->Arg(0)->Arg(1);
+
+static void BM_HDWalletDeriveAddresses(benchmark::State& state) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto count = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(wallet.deriveAddresses(TWCoinTypeEthereum, TWDerivationDefault, 0, 0, 0, count));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_HDWalletDeriveAddresses)->Arg(100);
+
+static void BM_DeriveAddress(benchmark::State& state) {
+    const auto coin = static_cast<TWCoinType>(state.range(0));
+    const auto privateKey = PrivateKey(privateKeyData);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TW::deriveAddress(coin, privateKey));
+    }
+}
+BENCHMARK(BM_DeriveAddress)
+    ->ArgName("coin")
+    ->Arg(TWCoinTypeBitcoin)
+    ->Arg(TWCoinTypeEthereum)
+    ->Arg(TWCoinTypeCosmos)
+    ->Arg(TWCoinTypeSolana);
+
+/// Key derivation of a stored key with the minimal scrypt parameters.
+static void BM_Scrypt(benchmark::State& state) {
+    const auto password = TW::data("password");
+    const auto salt = parse_hex("ab0c7876052600dd703518d6fc3fe8984592145b591fc8fb5c6d43190334ba19");
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Keystore::scrypt(password, salt, 1 << 12, 8, 6, 32, threads));
+    }
+}
+BENCHMARK(BM_Scrypt)->ArgName("threads")->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+} // namespace TW::benchmarks
@@ -0,0 +1,292 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AllocationCounter.h"
+#include "Base58.h"
+#include "Coin.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Cardano.pb.h"
+#include "proto/Cosmos.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/Solana.pb.h"
+
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW::benchmarks {
+
+/// A realistic, heavy signing input: the transactions wallets sign in production rather than minimal transfers.
+/// Gated by tools/benchmark-gate against benchmarks/thresholds.json.
+struct Scenario {
+    const char* name;
+    TWCoinType coin;
+    std::function<std::string()> input;
+    /// Whether `anyCoinPlan` is meaningful for the coin.
+    bool plan;
+};
+
+/// Consolidation of 200 P2WPKH outputs of one key into a single output.
+static std::string bitcoinConsolidation() {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_byte_fee(10);
+    input.set_use_max_amount(true);
+    input.set_to_address("bc1q2dsdlq3343vk29runkgv4yc292hmq53jedfjmp");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+    const auto key = parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9");
+    input.add_private_key(key.data(), key.size());
+
+    const auto script = parse_hex("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    int64_t total = 0;
+    for (uint32_t i = 0; i < 200; ++i) {
+        const auto hash = Hash::sha256(data(std::to_string(i)));
+        auto& utxo = *input.add_utxo();
+        utxo.mutable_out_point()->set_hash(hash.data(), hash.size());
+        utxo.mutable_out_point()->set_index(i % 4);
+        utxo.mutable_out_point()->set_sequence(UINT32_MAX);
+        utxo.set_script(script.data(), script.size());
+        utxo.set_amount(100'000 + i);
+        total += utxo.amount();
+    }
+    input.set_amount(total);
+    return input.SerializeAsString();
+}
+
+/// EIP-1559 contract call with 4 KiB of calldata.
+static std::string ethereumLongCalldata() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(6));
+    const auto gasLimit = store(uint256_t(1'000'000));
+    const auto maxInclusionFeePerGas = store(uint256_t(2'000'000'000));
+    const auto maxFeePerGas = store(uint256_t(30'000'000'000));
+    const auto key = parse_hex("4f96ed80e9a7555a6f74b3d658afdd9c756b0a40d4ca30c42c2039eb449bb904");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_tx_mode(Ethereum::Proto::TransactionMode::Enveloped);
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_max_inclusion_fee_per_gas(maxInclusionFeePerGas.data(), maxInclusionFeePerGas.size());
+    input.set_max_fee_per_gas(maxFeePerGas.data(), maxFeePerGas.size());
+    input.set_to_address("0xB9F5771C27664bF2282D98E09D7F50cEc7cB01a7");
+    input.set_private_key(key.data(), key.size());
+
+    Data calldata = parse_hex("ac9650d8"); // multicall(bytes[])
+    for (std::size_t i = 0; calldata.size() < 4096; ++i) {
+        append(calldata, Hash::keccak256(data(std::to_string(i))));
+    }
+    input.mutable_transaction()->mutable_contract_generic()->set_data(calldata.data(), calldata.size());
+    return input.SerializeAsString();
+}
+
+/// Cosmos transaction with 32 messages of the common kinds, in `mode`.
+static std::string cosmosMultiMessage(Cosmos::Proto::SigningMode mode) {
+    Cosmos::Proto::SigningInput input;
+    input.set_signing_mode(mode);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_memo("batched payout");
+    input.set_sequence(8);
+    const auto delegator = "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02";
+    const auto validator = "cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp";
+    for (int i = 0; i < 32; ++i) {
+        auto& message = *input.add_messages();
+        switch (i % 4) {
+        case 0: {
+            auto& send = *message.mutable_send_coins_message();
+            send.set_from_address(delegator);
+            send.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+            auto& amount = *send.add_amounts();
+            amount.set_denom("uatom");
+            amount.set_amount(std::to_string(1000 + i));
+            break;
+        }
+        case 1: {
+            auto& stake = *message.mutable_stake_message();
+            stake.set_delegator_address(delegator);
+            stake.set_validator_address(validator);
+            stake.mutable_amount()->set_denom("uatom");
+            stake.mutable_amount()->set_amount(std::to_string(2000 + i));
+            break;
+        }
+        case 2: {
+            auto& withdraw = *message.mutable_withdraw_stake_reward_message();
+            withdraw.set_delegator_address(delegator);
+            withdraw.set_validator_address(validator);
+            break;
+        }
+        default: {
+            auto& restake = *message.mutable_restake_message();
+            restake.set_delegator_address(delegator);
+            restake.set_validator_src_address(validator);
+            restake.set_validator_dst_address("cosmosvaloper1sxx9mszve0gaedz5ld7qdkjkfv8z992ax69k08");
+            restake.mutable_amount()->set_denom("uatom");
+            restake.mutable_amount()->set_amount(std::to_string(3000 + i));
+            break;
+        }
+        }
+    }
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(4'000'000);
+    auto& feeAmount = *fee.add_amounts();
+    feeAmount.set_denom("uatom");
+    feeAmount.set_amount("10000");
+    const auto key = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(key.data(), key.size());
+    return input.SerializeAsString();
+}
+
+/// Versioned (V0) message creating the recipient token account and transferring with a memo and references.
+static std::string solanaV0TokenTransfer() {
+    Solana::Proto::SigningInput input;
+    const auto key = Base58::decode("66ApBuKpo2uSzpjGBraHq7HP8UZMUJzp3um8FdEjkC9c");
+    auto& message = *input.mutable_create_and_transfer_token_transaction();
+    message.set_recipient_main_address("71e8mDsh3PR6gN64zL1HjwuxyKpgRXrPDUJT7XXojsVd");
+    message.set_token_mint_address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    message.set_recipient_token_address("EF6L8yJT1SoRoDCkAZfSVmaweqMzfhxZiptKi7Tgj5XY");
+    message.set_sender_token_address("ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+    message.set_amount(2900);
+    message.set_decimals(6);
+    message.set_memo("HelloSolanaMemo370");
+    message.add_references("CuieVDEDtLo7FypA9SbLM9saXFdb1dsshEkyErMqkRQq");
+    message.add_references("tFpP7tZUt6zb7YZPpQ11kXNmsc5YzpMXmahGMvCHhqS");
+    input.set_private_key(key.data(), key.size());
+    input.set_recent_blockhash("DMmDdJP41M9mw8Z4586VSvxqGCrqPy5uciF6HsKUVDja");
+    input.set_v0_msg(true);
+    return input.SerializeAsString();
+}
+
+/// NFT transfer spending 9 UTXOs that hold 25 different native assets, which all go to the change output.
+static std::string cardanoMultiAsset() {
+    Cardano::Proto::SigningInput input;
+    const auto fromAddress = "addr1qy5eme9r6frr0m6q2qpncg282jtrhq5lg09uxy2j0545hj8rv7v2ntdxuv6p4s3eq4lqzg39lewgvt6fk5kmpa0zppesufzjud";
+    const auto nftPolicyId = "219820e6cb04316f41a337fea356480f412e7acc147d28f175f21b5e";
+    const auto nftAssetName = "coolcatssociety4567";
+    const auto one = store(uint256_t(1));
+
+    const auto addUtxo = [&](const Data& hash, uint64_t amount) {
+        auto& utxo = *input.add_utxos();
+        utxo.mutable_out_point()->set_tx_hash(hash.data(), hash.size());
+        utxo.mutable_out_point()->set_output_index(0);
+        utxo.set_address(fromAddress);
+        utxo.set_amount(amount);
+        return &utxo;
+    };
+    auto& nft = *addUtxo(parse_hex("aba499ec2f23529e70bb256ceaffcc6274a882cf02f29e5670c75ee980d7c2b8"), 1'202'490)->add_token_amount();
+    nft.set_policy_id(nftPolicyId);
+    nft.set_asset_name(nftAssetName);
+    nft.set_amount(one.data(), one.size());
+    for (int i = 0; i < 8; ++i) {
+        auto& utxo = *addUtxo(Hash::sha256(data("cardano" + std::to_string(i))), 5'000'000);
+        for (int j = 0; j < 3; ++j) {
+            auto& token = *utxo.add_token_amount();
+            token.set_policy_id(hex(Hash::sha256(data("policy" + std::to_string(j)))).substr(0, 56));
+            token.set_asset_name("asset" + std::to_string(i));
+            const auto amount = store(uint256_t(1000 * (j + 1)));
+            token.set_amount(amount.data(), amount.size());
+        }
+    }
+
+    const auto key = parse_hex("d09831a668db6b36ffb747600cb1cd3e3d34f36e1e6feefc11b5f988719b7557a7029ab80d3e6fe4180ad07a59ddf742ea9730f3c4145df6365fa4ae2ee49c3392e19444caf461567727b7fefec40a3763bdb6ce5e0e8c05f5e340355a8fef4528dfe7502cfbda49e38f5a0021962d52dc3dee82834a23abb6750981799b75577d1ed9af9853707f0ef74264274e71b2f12e86e3c91314b6efa75ef750d9711b84cedd742ab873ef2f9566ad20b3fc702232c6d2f5d83ff425019234037d1e58");
+    input.add_private_key(key.data(), key.size());
+
+    auto& transfer = *input.mutable_transfer_message();
+    transfer.set_to_address("addr1qy9wjfn6nd8kak6dd8z53u7t5wt9f4lx0umll40px5hnq05avwcsq5r3ytdp36wttzv4558jaq8lvhgqhe3y8nuf5xrquju7z4");
+    transfer.set_change_address(fromAddress);
+    transfer.set_amount(1'202'490);
+    auto& token = *transfer.mutable_token_amount()->add_token();
+    token.set_policy_id(nftPolicyId);
+    token.set_asset_name(nftAssetName);
+    token.set_amount(one.data(), one.size());
+    input.set_ttl(89'130'965);
+    return input.SerializeAsString();
+}
+
+static const std::vector<Scenario> scenarios = {
+    {"BitcoinConsolidation", TWCoinTypeBitcoin, bitcoinConsolidation, true},
+    {"EthereumLongCalldata", TWCoinTypeEthereum, ethereumLongCalldata, false},
+    {"CosmosMultiMessage", TWCoinTypeCosmos, [] { return cosmosMultiMessage(Cosmos::Proto::Protobuf); }, false},
+    {"CosmosMultiMessageAmino", TWCoinTypeCosmos, [] { return cosmosMultiMessage(Cosmos::Proto::JSON); }, false},
+    {"SolanaV0TokenTransfer", TWCoinTypeSolana, solanaV0TokenTransfer, false},
+    {"CardanoMultiAsset", TWCoinTypeCardano, cardanoMultiAsset, true},
+};
+
+/// Runs `operation` once per iteration and reports, next to the timings, the throughput (`items_per_second`),
+/// the p50 and p99 latency of single operations in microseconds and the allocations per operation.
+template <typename Operation>
+static void runScenario(benchmark::State& state, const Operation& operation) {
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<std::size_t>(state.max_iterations));
+    const auto allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        operation();
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    const auto allocations = allocationCount() - allocationsBefore;
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p) {
+        const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(latencies.size())));
+        return latencies[std::clamp<std::size_t>(rank, 1, latencies.size()) - 1];
+    };
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["allocs_per_op"] = static_cast<double>(allocations) / static_cast<double>(latencies.size());
+}
+
+/// `anyCoinSign` of a scenario input.
+static void BM_ScenarioSign(benchmark::State& state, const Scenario& scenario) {
+    const auto serialized = scenario.input();
+    const Data input(serialized.begin(), serialized.end());
+    Data output;
+    runScenario(state, [&] {
+        output.clear();
+        anyCoinSign(scenario.coin, input, output);
+        benchmark::DoNotOptimize(output);
+    });
+    if (output.empty()) {
+        state.SkipWithError("signing produced no output");
+    }
+}
+
+/// `anyCoinPlan` of a scenario input.
+static void BM_ScenarioPlan(benchmark::State& state, const Scenario& scenario) {
+    const auto serialized = scenario.input();
+    const Data input(serialized.begin(), serialized.end());
+    Data output;
+    runScenario(state, [&] {
+        output.clear();
+        anyCoinPlan(scenario.coin, input, output);
+        benchmark::DoNotOptimize(output);
+    });
+}
+
+static const bool scenarioBenchmarksRegistered = [] {
+    for (const auto& scenario : scenarios) {
+        benchmark::RegisterBenchmark((std::string("BM_ScenarioSign/") + scenario.name).c_str(), BM_ScenarioSign, scenario);
+        if (scenario.plan) {
+            benchmark::RegisterBenchmark((std::string("BM_ScenarioPlan/") + scenario.name).c_str(), BM_ScenarioPlan, scenario);
+        }
+    }
+    return true;
+}();
+
+} // namespace TW::benchmarks
@@ -0,0 +1,145 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Time to first sign of a freshly started process, the cold start cost apps see after loading the library.
+// Each run measures a single process, see tools/startup-benchmark for repeated runs and release tracking.
+//
+// Usage: TrustWalletCoreStartup [ethereum|bitcoin|solana]
+// Prints a JSON object with the times in microseconds:
+// - input_us: building the first signing input, including protobuf descriptor and default instance setup;
+// - first_sign_us: the first TWAnySignerSign, including the lazy initialization of the coin;
+// - second_sign_us: a second, warm TWAnySignerSign for comparison.
+// The time spent loading the library and running static constructors is what the script measures on top.
+
+#include "Base58.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/Solana.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+#include <TrustWalletCore/TWData.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace TW;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string ethereumTransfer() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return input.SerializeAsString();
+}
+
+std::string bitcoinP2WPKH() {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(335'790'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+    const auto key = parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9");
+    input.add_private_key(key.data(), key.size());
+
+    const auto hash = parse_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+    const auto script = parse_hex("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    auto& utxo = *input.add_utxo();
+    utxo.mutable_out_point()->set_hash(hash.data(), hash.size());
+    utxo.mutable_out_point()->set_index(1);
+    utxo.mutable_out_point()->set_sequence(UINT32_MAX);
+    utxo.set_script(script.data(), script.size());
+    utxo.set_amount(600'000'000);
+    return input.SerializeAsString();
+}
+
+std::string solanaTransfer() {
+    Solana::Proto::SigningInput input;
+    const auto key = Base58::decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr");
+    input.mutable_transfer_transaction()->set_recipient("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd");
+    input.mutable_transfer_transaction()->set_value(42);
+    input.set_private_key(key.data(), key.size());
+    input.set_recent_blockhash("11111111111111111111111111111111");
+    return input.SerializeAsString();
+}
+
+struct Case {
+    const char* name;
+    TWCoinType coin;
+    std::string (*input)();
+};
+
+constexpr Case cases[] = {
+    {"ethereum", TWCoinTypeEthereum, ethereumTransfer},
+    {"bitcoin", TWCoinTypeBitcoin, bitcoinP2WPKH},
+    {"solana", TWCoinTypeSolana, solanaTransfer},
+};
+
+long long microseconds(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+/// Signs `input` with the C interface, as apps do. Returns the output size.
+std::size_t sign(const std::string& input, TWCoinType coin) {
+    auto* data = TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    auto* output = TWAnySignerSign(data, coin);
+    const auto size = TWDataSize(output);
+    TWDataDelete(output);
+    TWDataDelete(data);
+    return size;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const auto start = Clock::now();
+    const char* name = argc > 1 ? argv[1] : "ethereum";
+    const Case* selected = nullptr;
+    for (const auto& c : cases) {
+        if (std::strcmp(c.name, name) == 0) {
+            selected = &c;
+        }
+    }
+    if (selected == nullptr) {
+        std::fprintf(stderr, "Unknown coin %s\n", name);
+        return 1;
+    }
+
+    const auto input = selected->input();
+    const auto built = Clock::now();
+    const auto size = sign(input, selected->coin);
+    const auto signedFirst = Clock::now();
+    sign(input, selected->coin);
+    const auto signedSecond = Clock::now();
+    if (size == 0) {
+        std::fprintf(stderr, "Signing failed\n");
+        return 1;
+    }
+
+    std::printf("{\"coin\": \"%s\", \"input_us\": %lld, \"first_sign_us\": %lld, \"second_sign_us\": %lld}\n",
+                selected->name, microseconds(start, built), microseconds(built, signedFirst), microseconds(signedFirst, signedSecond));
+    return 0;
+}
@@ -0,0 +1,45 @@
+# Copyright © 2017-2023 Trust Wallet.
+#
+# This file is part of Trust. The full Trust copyright notice, including
+# terms governing use, modification, and redistribution, is contained in the
+# file LICENSE at the root of the source code distribution tree.
+
+# Coin subset build, driven by TW_ENABLED_BLOCKCHAINS.
+# codegen/bin/coins generates the coin dispatcher and coin infos of the enabled blockchains,
+# and src/Generated/Blockchains.cmake with the sources to leave out.
+
+if (NOT "${TW_ENABLED_BLOCKCHAINS}" STREQUAL "${TW_GENERATED_BLOCKCHAINS_REQUEST}")
+    find_program(RUBY_EXECUTABLE ruby REQUIRED)
+    execute_process(
+            COMMAND ${CMAKE_COMMAND} -E env "TW_ENABLED_BLOCKCHAINS=${TW_ENABLED_BLOCKCHAINS}" ${RUBY_EXECUTABLE} codegen/bin/coins
+            WORKING_DIRECTORY ${CMAKE_SOURCE_DIR}
+            RESULT_VARIABLE TW_CODEGEN_RESULT
+    )
+    if (NOT TW_CODEGEN_RESULT EQUAL 0)
+        message(FATAL_ERROR "codegen/bin/coins failed for TW_ENABLED_BLOCKCHAINS=${TW_ENABLED_BLOCKCHAINS}")
+    endif ()
+    set(TW_GENERATED_BLOCKCHAINS_REQUEST "${TW_ENABLED_BLOCKCHAINS}" CACHE INTERNAL "TW_ENABLED_BLOCKCHAINS of the last generation")
+endif ()
+
+if (EXISTS ${CMAKE_SOURCE_DIR}/src/Generated/Blockchains.cmake)
+    include(${CMAKE_SOURCE_DIR}/src/Generated/Blockchains.cmake)
+endif ()
+
+if (NOT "${TW_ENABLED_BLOCKCHAINS}" STREQUAL "")
+    message(STATUS "Coin subset enabled: ${TW_GENERATED_BLOCKCHAINS}")
+endif ()
+
+# Removes the sources of the blockchains left out of the build from the list `var`
+function(tw_filter_blockchain_sources var)
+    set(result ${${var}})
+    foreach (folder ${TW_EXCLUDED_FOLDERS})
+        list(FILTER result EXCLUDE REGEX "/src/${folder}/")
+    endforeach ()
+    foreach (proto ${TW_EXCLUDED_PROTOS})
+        list(FILTER result EXCLUDE REGEX "/src/proto/${proto}\\.pb\\.")
+    endforeach ()
+    foreach (interface ${TW_EXCLUDED_INTERFACES})
+        list(FILTER result EXCLUDE REGEX "/src/interface/${interface}\\.cpp$")
+    endforeach ()
+    set(${var} ${result} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,58 @@
+# Copyright © 2017-2023 Trust Wallet.
+#
+# This file is part of Trust. The full Trust copyright notice, including
+# terms governing use, modification, and redistribution, is contained in the
+# file LICENSE at the root of the source code distribution tree.
+
+# Link-time and profile-guided optimization of the native build.
+# The flags are global so that trezor-crypto, the core and the final executables are built alike.
+# The matching Rust library is built by tools/pgo into rust/target/${TW_RUST_TARGET_SUBDIR}:
+# with -Clinker-plugin-lto its bitcode is optimized together with the C++ one by lld,
+# which lets small wrappers such as Hash::sha256 inline their Rust implementation.
+
+set(TW_PGO_PROFILE_DIR ${CMAKE_BINARY_DIR}/pgo CACHE PATH "Where instrumented builds write their raw profiles")
+set(TW_RUST_TARGET_SUBDIR "")
+
+if (TW_PGO_GENERATE AND NOT TW_PGO_USE STREQUAL "")
+    message(FATAL_ERROR "TW_PGO_GENERATE and TW_PGO_USE are exclusive")
+endif ()
+
+if ((TW_ENABLE_LTO OR TW_PGO_GENERATE OR NOT TW_PGO_USE STREQUAL "") AND (TW_COMPILE_WASM OR ANDROID OR IOS_PLATFORM))
+    message(FATAL_ERROR "LTO and PGO profiles are only supported for native builds")
+endif ()
+
+if (TW_ENABLE_LTO)
+    find_program(LLVM_AR llvm-ar REQUIRED)
+    find_program(LLVM_RANLIB llvm-ranlib REQUIRED)
+    # The static library holds bitcode, which only the LLVM tools can index
+    set(CMAKE_AR ${LLVM_AR})
+    set(CMAKE_RANLIB ${LLVM_RANLIB})
+    add_compile_options(-flto=thin)
+    add_link_options(-flto=thin -fuse-ld=lld)
+    message(STATUS "ThinLTO enabled")
+endif ()
+
+if (TW_PGO_GENERATE)
+    add_compile_options(-fprofile-generate=${TW_PGO_PROFILE_DIR})
+    add_link_options(-fprofile-generate=${TW_PGO_PROFILE_DIR})
+    set(TW_RUST_TARGET_SUBDIR pgo-generate)
+    message(STATUS "PGO instrumentation enabled, profiles in ${TW_PGO_PROFILE_DIR}")
+elseif (NOT TW_PGO_USE STREQUAL "")
+    if (NOT EXISTS ${TW_PGO_USE})
+        message(FATAL_ERROR "PGO profile ${TW_PGO_USE} not found, see tools/pgo")
+    endif ()
+    # Code added since the training run has no profile, which is expected
+    add_compile_options(-fprofile-use=${TW_PGO_USE} -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+    add_link_options(-fprofile-use=${TW_PGO_USE})
+    set(TW_RUST_TARGET_SUBDIR pgo-use)
+    message(STATUS "PGO optimization enabled with ${TW_PGO_USE}")
+endif ()
+
+# Rust objects built for linker-plugin LTO are bitcode, they can't be mixed with a regular link
+if (TW_ENABLE_LTO)
+    if (TW_RUST_TARGET_SUBDIR)
+        set(TW_RUST_TARGET_SUBDIR ${TW_RUST_TARGET_SUBDIR}-lto)
+    else ()
+        set(TW_RUST_TARGET_SUBDIR lto)
+    endif ()
+endif ()
@@ -16,6 +16,9 @@ option(TW_IDE_VSCODE "Enable if your IDE is VSCode" OFF)
 # Build Settings
 #
 option(TW_UNITY_BUILD "Enable Unity build for TrustWalletCore and unit tests." OFF)
+# Coin subset: blockchains to compile (TWBlockchain names, e.g. "Bitcoin;Ethereum;Solana"), all of them if empty.
+# The coin dispatcher and coin infos are regenerated for the subset, see codegen/lib/blockchains.rb.
+set(TW_ENABLED_BLOCKCHAINS "" CACHE STRING "Blockchains to compile, all if empty")
 
 #
 # Static analyzers
@@ -35,6 +38,15 @@ option(TW_CLANG_ASAN "Enable ASAN dynamic address sanitizer" OFF)
 #
 # Currently supporting: Wasm.
 option(TW_COMPILE_WASM "Target Wasm" OFF)
+# Wasm flavour with 128-bit SIMD and pthreads (SharedArrayBuffer), built as `wallet-core-simd` next to the default module.
+option(TW_WASM_SIMD_THREADS "Target Wasm with SIMD and threads" OFF)
+
+#
+# Link-time and profile-guided optimization, see cmake/Optimization.cmake and tools/pgo
+#
+option(TW_ENABLE_LTO "Enable ThinLTO of the C++ core, across languages with a Rust library built for linker-plugin LTO" OFF)
+option(TW_PGO_GENERATE "Instrument the build to record a PGO training profile" OFF)
+set(TW_PGO_USE "" CACHE FILEPATH "Merged .profdata of a training run to optimize the build with")
 
 #
 # Coverage
@@ -65,10 +77,20 @@ endif ()
 #
 option(TW_UNIT_TESTS "Enable the unit tests of the project" ON)
 option(TW_BUILD_EXAMPLES "Enable the examples builds of the project" ON)
+option(TW_BENCHMARKS "Enable the microbenchmarks of the project (requires Google Benchmark, see tools/download-dependencies)" OFF)
+option(TW_BUILD_SIGNERD "Enable the walletcore-signerd local signing daemon (Unix only), see signerd/README.md" OFF)
 
 if (ANDROID OR IOS_PLATFORM OR TW_COMPILE_WASM)
     set(TW_UNIT_TESTS OFF)
     set(TW_BUILD_EXAMPLES OFF)
+    set(TW_BENCHMARKS OFF)
+    set(TW_BUILD_SIGNERD OFF)
+endif()
+
+# Tests and examples cover every blockchain
+if (NOT TW_ENABLED_BLOCKCHAINS STREQUAL "")
+    set(TW_UNIT_TESTS OFF)
+    set(TW_BUILD_EXAMPLES OFF)
 endif()
 
 if (TW_UNIT_TESTS)
@@ -83,4 +105,10 @@ else()
     message(STATUS "Native examples skipped")
 endif()
 
+if (TW_BENCHMARKS)
+    message(STATUS "Native benchmarks activated")
+else()
+    message(STATUS "Native benchmarks skipped")
+endif()
+
 
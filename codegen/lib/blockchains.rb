@@ -0,0 +1,127 @@
+# frozen_string_literal: true
+
+# Blockchain implementations, keyed by the `blockchain` name used in registry.json.
+# Drives the generated coin dispatcher and, with TW_ENABLED_BLOCKCHAINS, the coin subset build.
+#
+# - namespace: C++ namespace of the Entry (default: the key)
+# - folder: source folder under src/ (default: namespace)
+# - protos: files in src/proto owned by the blockchain (default: [namespace])
+# - interfaces: blockchain specific files in src/interface
+# - depends: blockchains whose sources are needed to compile this one
+module Blockchains
+  ALL = {
+    'Bitcoin' => { 'depends' => %w[Decred Groestlcoin Zcash],
+                   'interfaces' => %w[TWBitcoinAddress TWBitcoinMessageSigner TWBitcoinScript TWBitcoinSigHashType TWBitcoinUtxoPool TWSegwitAddress] },
+    'Ethereum' => { 'protos' => %w[Ethereum Barz],
+                    'interfaces' => %w[TWBarz TWEthereum TWEthereumAbi TWEthereumAbiCallDecoder TWEthereumAbiFunction TWEthereumAbiValue TWEthereumMessageSigner] },
+    'Vechain' => { 'namespace' => 'VeChain', 'depends' => %w[Ethereum] },
+    'Tron' => { 'interfaces' => %w[TWTronMessageSigner] },
+    'Icon' => {},
+    'Binance' => { 'depends' => %w[Ethereum] },
+    'Ripple' => { 'folder' => 'XRP', 'interfaces' => %w[TWRippleXAddress] },
+    'Tezos' => { 'interfaces' => %w[TWTezosMessageSigner] },
+    'Nimiq' => {},
+    'Stellar' => {},
+    'Aion' => { 'depends' => %w[Ethereum] },
+    'Cosmos' => {},
+    'Theta' => { 'depends' => %w[Ethereum] },
+    'Ontology' => {},
+    'Zilliqa' => {},
+    'IoTeX' => {},
+    'EOS' => {},
+    'Nano' => {},
+    'NULS' => {},
+    'Waves' => {},
+    'Aeternity' => {},
+    'Nebulas' => {},
+    'FIO' => { 'depends' => %w[EOS], 'interfaces' => %w[TWFIOAccount] },
+    'Solana' => { 'interfaces' => %w[TWSolanaAddress] },
+    'Harmony' => { 'depends' => %w[Ethereum] },
+    'NEAR' => { 'interfaces' => %w[TWNEARAccount] },
+    'Algorand' => {},
+    'Polkadot' => {},
+    'Cardano' => { 'interfaces' => %w[TWCardano] },
+    'NEO' => { 'depends' => %w[Ontology] },
+    'Filecoin' => { 'depends' => %w[Ethereum], 'interfaces' => %w[TWFilecoinAddressConverter] },
+    'MultiversX' => {},
+    'OasisNetwork' => { 'namespace' => 'Oasis' },
+    'Decred' => { 'depends' => %w[Bitcoin] },
+    'Groestlcoin' => { 'protos' => [], 'depends' => %w[Bitcoin], 'interfaces' => %w[TWGroestlcoinAddress] },
+    'Zcash' => { 'protos' => [], 'depends' => %w[Bitcoin] },
+    'Thorchain' => { 'namespace' => 'THORChain', 'protos' => %w[THORChainSwap], 'depends' => %w[Binance Bitcoin Cosmos Ethereum] },
+    'Ronin' => { 'protos' => [], 'depends' => %w[Ethereum] },
+    'Kusama' => { 'protos' => [], 'depends' => %w[Polkadot] },
+    'Nervos' => { 'interfaces' => %w[TWNervosAddress] },
+    'Everscale' => {},
+    'Aptos' => {},
+    'Hedera' => {},
+    'TheOpenNetwork' => { 'depends' => %w[Everscale] },
+    'Sui' => {},
+    # end_of_blockchains_marker_do_not_modify
+  }.freeze
+
+  # Features outside of a blockchain folder, compiled only when all their blockchains are
+  FEATURES = [
+    { 'folders' => %w[LiquidStaking], 'protos' => %w[LiquidStaking], 'requires' => %w[Aptos Cosmos Ethereum] },
+  ].freeze
+
+  # Always compiled, HDWallet derives Bitcoin extended keys
+  REQUIRED = %w[Bitcoin].freeze
+
+  def self.namespace(name)
+    ALL[name]['namespace'] || name
+  end
+
+  def self.folder(name)
+    ALL[name]['folder'] || namespace(name)
+  end
+
+  def self.protos(name)
+    ALL[name]['protos'] || [namespace(name)]
+  end
+
+  def self.interfaces(name)
+    ALL[name]['interfaces'] || []
+  end
+
+  def self.dispatcher(name)
+    "#{namespace(name).downcase}DP"
+  end
+
+  # Blockchains listed in TW_ENABLED_BLOCKCHAINS (comma or semicolon separated) with their dependencies,
+  # or all of them if it is not set.
+  def self.enabled(list = ENV['TW_ENABLED_BLOCKCHAINS'])
+    requested = (list || '').split(/[,;\s]+/).reject(&:empty?)
+    return ALL.keys if requested.empty?
+
+    unknown = requested - ALL.keys
+    raise "Unknown blockchains in TW_ENABLED_BLOCKCHAINS: #{unknown.join(', ')}" unless unknown.empty?
+
+    enabled = []
+    pending = REQUIRED + requested
+    until pending.empty?
+      name = pending.shift
+      next if enabled.include?(name)
+
+      enabled << name
+      pending.concat(ALL[name]['depends'] || [])
+    end
+    ALL.keys.select { |name| enabled.include?(name) }
+  end
+
+  # Source folders, src/proto files and src/interface files left out of the build
+  def self.excluded(enabled)
+    disabled = ALL.keys - enabled
+    folders = disabled.map { |name| folder(name) }
+    protos = disabled.flat_map { |name| protos(name) }
+    interfaces = disabled.flat_map { |name| interfaces(name) }
+    FEATURES.each do |feature|
+      next if (feature['requires'] - enabled).empty?
+
+      folders += feature['folders'] || []
+      protos += feature['protos'] || []
+      interfaces += feature['interfaces'] || []
+    end
+    { 'folders' => folders.uniq.sort, 'protos' => protos.uniq.sort, 'interfaces' => interfaces.uniq.sort }
+  end
+end
@@ -60,14 +60,9 @@ def insert_blockchain_type(coin)
 end
 
 def insert_coin_entry(coin)
-    target_file = "src/Coin.cpp"
-    entryName = coin['blockchain']
-    target_line = "#include \"#{entryName}/Entry.h\"" + $flag_comment + "\n"
-    insert_target_line(target_file, target_line, "// end_of_coin_includes_marker_do_not_modify\n")
-    target_line = "#{entryName}::Entry #{entryName}DP;" + $flag_comment + "\n"
-    insert_target_line(target_file, target_line, "// end_of_coin_dipatcher_declarations_marker_do_not_modify\n")
-    target_line = "        case TWBlockchain#{entryName}: entry = &#{entryName}DP; break;" + $flag_comment + "\n"
-    insert_target_line(target_file, target_line, "        // end_of_coin_dipatcher_switch_marker_do_not_modify\n")
+    target_file = "codegen/lib/blockchains.rb"
+    target_line = "    '#{coin['blockchain']}' => {}," + $flag_comment.sub('//', '#') + "\n"
+    insert_target_line(target_file, target_line, "    # end_of_blockchains_marker_do_not_modify\n")
 end
 
 def self.insert_target_line(target_file, target_line, original_line)
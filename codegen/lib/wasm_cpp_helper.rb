@@ -90,7 +90,7 @@ module WasmCppHelper
       when :size
         'size_t'
       when :data
-          'const std::string&'
+          'const emscripten::val&'
       when :string
           'const std::string&'
       else
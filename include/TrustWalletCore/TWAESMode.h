@@ -0,0 +1,21 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Block cipher mode of an AES stream.
+TW_EXPORT_ENUM(uint32_t)
+enum TWAESMode {
+    TWAESModeCBC = 0, // cipher block chaining, padded as specified
+    TWAESModeCTR = 1, // counter
+    TWAESModeGCM = 2, // Galois/counter, authenticated: the ciphertext is followed by a 16-byte tag
+};
+
+TW_EXTERN_C_END
@@ -0,0 +1,67 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWData.h"
+#include "TWAESMode.h"
+#include "TWAESPaddingMode.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Incremental AES encryption or decryption, for data too large to be held in memory, such as backups: the data is
+/// given in chunks of any size, and the output is the same as the one of `TWAES` in the end.
+TW_EXPORT_CLASS
+struct TWAESStream;
+
+/// Creates an encryption stream.
+///
+/// \param mode block cipher mode.
+/// \param key encryption key Data, must be 16, 24, or 32 bytes long.
+/// \param iv initialization vector Data, 16 bytes for CBC and CTR; the nonce for GCM, 12 bytes recommended.
+/// \param padding padding mode, for CBC.
+/// \param aad additional data authenticated but not encrypted, for GCM.
+/// \note Must be deleted with \TWAESStreamDelete
+/// \return the stream, null if the key or the iv is invalid.
+TW_EXPORT_STATIC_METHOD
+struct TWAESStream* _Nullable TWAESStreamCreateEncryptor(enum TWAESMode mode, TWData* _Nonnull key, TWData* _Nonnull iv, enum TWAESPaddingMode padding, TWData* _Nonnull aad);
+
+/// Creates a decryption stream. GCM input is the ciphertext followed by the tag.
+///
+/// \param mode block cipher mode.
+/// \param key decryption key Data, must be 16, 24, or 32 bytes long.
+/// \param iv initialization vector Data, 16 bytes for CBC and CTR; the nonce for GCM.
+/// \param padding padding mode, for CBC.
+/// \param aad additional data authenticated with the ciphertext, for GCM.
+/// \note Must be deleted with \TWAESStreamDelete
+/// \return the stream, null if the key or the iv is invalid.
+TW_EXPORT_STATIC_METHOD
+struct TWAESStream* _Nullable TWAESStreamCreateDecryptor(enum TWAESMode mode, TWData* _Nonnull key, TWData* _Nonnull iv, enum TWAESPaddingMode padding, TWData* _Nonnull aad);
+
+/// Deletes the stream, wiping its state.
+///
+/// \param stream A non-null stream.
+TW_EXPORT_METHOD
+void TWAESStreamDelete(struct TWAESStream* _Nonnull stream);
+
+/// Encrypts or decrypts the next chunk. Decrypted GCM output must not be trusted before `TWAESStreamFinish` succeeded.
+///
+/// \param stream A non-null stream.
+/// \param data next chunk of input.
+/// \return the next chunk of output, possibly empty as CBC and decryption hold back up to one block.
+TW_EXPORT_METHOD
+TWData* _Nonnull TWAESStreamUpdate(struct TWAESStream* _Nonnull stream, TWData* _Nonnull data);
+
+/// Ends the stream, which can't be used afterwards.
+///
+/// \param stream A non-null stream.
+/// \return the end of the output: the last CBC block or the GCM tag; null if the CBC input is not a whole number of
+/// blocks or the GCM tag doesn't match.
+TW_EXPORT_METHOD
+TWData* _Nullable TWAESStreamFinish(struct TWAESStream* _Nonnull stream);
+
+TW_EXTERN_C_END
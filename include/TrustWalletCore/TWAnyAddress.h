@@ -9,6 +9,7 @@
 #include "TWBase.h"
 #include "TWCoinType.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWFilecoinAddressType.h"
 #include "TWString.h"
 
@@ -54,6 +55,25 @@ bool TWAnyAddressIsValidBech32(TWString* _Nonnull string, enum TWCoinType coin,
 TW_EXPORT_STATIC_METHOD
 bool TWAnyAddressIsValidSS58(TWString* _Nonnull string, enum TWCoinType coin, uint32_t ss58Prefix);
 
+/// Determines which strings of a batch are valid addresses of the given coin.
+///
+/// \param addresses UTF-8 encoded addresses to validate.
+/// \param coin coin type of the addresses.
+/// \return one byte per address, in the same order: 1 if the address is valid, 0 otherwise.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWAnyAddressValidateBatch(const struct TWDataVector* _Nonnull addresses, enum TWCoinType coin);
+
+/// Validates, normalizes and decodes a batch of addresses of the given coin, spreading the work over a fixed-size pool of worker threads.
+///
+/// \param addresses UTF-8 encoded addresses to decode.
+/// \param coin coin type of the addresses.
+/// \param threads The number of worker threads; 0 uses the hardware concurrency, 1 decodes sequentially in the calling thread.
+/// \return one packed record per address, in the same order: a byte that is 1 if the address is valid, 0 otherwise;
+/// for valid addresses it is followed by the normalized address and then its data (see TWAnyAddressData),
+/// each prefixed with its length as a 4-byte little-endian integer.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWAnyAddressDecodeBatch(const struct TWDataVector* _Nonnull addresses, enum TWCoinType coin, uint32_t threads);
+
 /// Creates an address from a string representation and a coin type. Must be deleted with TWAnyAddressDelete after use.
 ///
 /// \param string address to create.
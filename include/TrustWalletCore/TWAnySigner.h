@@ -8,6 +8,7 @@
 #include "TWBase.h"
 #include "TWCoinType.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWString.h"
 
 TW_EXTERN_C_BEGIN
@@ -22,6 +23,15 @@ struct TWAnySigner;
 /// \return The serialized data of a `SigningOutput` proto object. (e.g. TW.Bitcoin.Proto.SigningOutput).
 extern TWData *_Nonnull TWAnySignerSign(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Signs a batch of transactions for the same coin type, spreading the work over a fixed-size pool of worker threads.
+///
+/// \param inputs The serialized data of the signing inputs (e.g. TW.Bitcoin.Proto.SigningInput).
+/// \param coin The given coin type to sign the transactions for.
+/// \param threads The number of worker threads; 0 uses the hardware concurrency, 1 signs sequentially in the calling thread.
+/// \return The serialized `SigningOutput` proto objects, in the same order as `inputs`.
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+extern struct TWDataVector *_Nonnull TWAnySignerSignBatch(const struct TWDataVector *_Nonnull inputs, enum TWCoinType coin, uint32_t threads);
+
 /// Signs a transaction specified by the JSON representation of signing input, coin type and a private key, returning the JSON representation of the signing output.
 ///
 /// \param json JSON representation of a signing input
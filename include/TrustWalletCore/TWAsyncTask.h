@@ -0,0 +1,99 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+#include "TWString.h"
+
+TW_EXTERN_C_BEGIN
+
+struct TWDataVector;
+struct TWHDWallet;
+struct TWStoredKey;
+
+/// Long-running operation (signing, planning, key derivation from a mnemonic or password) run on the executor shared
+/// by all the parallel work of the library (see `TWExecutor.h`), for the platform wrappers to build their asynchronous
+/// APIs on.
+///
+/// Submitting copies the arguments and returns at once. Completion is signalled through the optional callback,
+/// called on a worker thread, or can be polled with `TWAsyncTaskGetStatus` or waited for with `TWAsyncTaskWait`.
+/// In builds without threads (wasm without pthreads) the operation and the callback run in the submitting call.
+struct TWAsyncTask;
+
+enum TWAsyncTaskStatus {
+    TWAsyncTaskStatusPending = 0,
+    TWAsyncTaskStatusCompleted = 1,
+    /// The operation returned no result, e.g. a wrong password or an invalid mnemonic.
+    TWAsyncTaskStatusFailed = 2,
+    TWAsyncTaskStatusCancelled = 3,
+};
+
+/// Called once on a worker thread when `task` is no longer pending, including when it was cancelled.
+/// The task may be deleted from its callback, unless it runs in the submitting call.
+typedef void (*TWAsyncTaskCallback)(struct TWAsyncTask* _Nonnull task, void* _Nullable context);
+
+/// Signs like `TWAnySignerSign`; the result is the serialized signing output, see `TWAsyncTaskGetData`.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerSign(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Plans like `TWAnySignerPlan`; the result is the serialized plan, see `TWAsyncTaskGetData`.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerPlan(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Signs like `TWAnySignerSignBatch` on `threads` workers (0 for the hardware concurrency); the result is the
+/// serialized signing outputs, see `TWAsyncTaskGetDataVector`. Cancellation stops the batch between inputs.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerSignBatch(const struct TWDataVector* _Nonnull inputs, enum TWCoinType coin, uint32_t threads, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Creates a wallet like `TWHDWalletCreateWithMnemonic`; the result is taken with `TWAsyncTaskTakeHDWallet`.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskHDWalletCreateWithMnemonic(TWString* _Nonnull mnemonic, TWString* _Nonnull passphrase, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Imports a mnemonic like `TWStoredKeyImportHDWallet`; the result is taken with `TWAsyncTaskTakeStoredKey`.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyImportHDWallet(TWString* _Nonnull mnemonic, TWString* _Nonnull name, TWData* _Nonnull password, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Decrypts like `TWStoredKeyDecryptPrivateKey`; the result is the private key, see `TWAsyncTaskGetData`.
+/// `key` is not copied and must outlive the task.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyDecryptPrivateKey(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Decrypts like `TWStoredKeyDecryptMnemonic`; the result is the mnemonic, see `TWAsyncTaskGetString`.
+/// `key` is not copied and must outlive the task.
+extern struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyDecryptMnemonic(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context);
+
+/// Current status of the task.
+extern enum TWAsyncTaskStatus TWAsyncTaskGetStatus(struct TWAsyncTask* _Nonnull task);
+
+/// Blocks until the task is no longer pending and returns its status.
+extern enum TWAsyncTaskStatus TWAsyncTaskWait(struct TWAsyncTask* _Nonnull task);
+
+/// Requests cancellation: a task still queued doesn't run, a running one is stopped where the operation allows it,
+/// otherwise its result is discarded. Returns false if the task had already completed or failed.
+extern bool TWAsyncTaskCancel(struct TWAsyncTask* _Nonnull task);
+
+/// Copy of the data result of a completed task, or null.
+/// \note Returned object needs to be deleted with \TWDataDelete
+extern TWData* _Nullable TWAsyncTaskGetData(struct TWAsyncTask* _Nonnull task);
+
+/// Copy of the string result of a completed task, or null.
+/// \note Returned object needs to be deleted with \TWStringDelete
+extern TWString* _Nullable TWAsyncTaskGetString(struct TWAsyncTask* _Nonnull task);
+
+/// Copy of the data vector result of a completed task, or null.
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+extern struct TWDataVector* _Nullable TWAsyncTaskGetDataVector(struct TWAsyncTask* _Nonnull task);
+
+/// Takes the wallet created by a completed task; later calls return null.
+/// \note Returned object needs to be deleted with \TWHDWalletDelete
+extern struct TWHDWallet* _Nullable TWAsyncTaskTakeHDWallet(struct TWAsyncTask* _Nonnull task);
+
+/// Takes the stored key created by a completed task; later calls return null.
+/// \note Returned object needs to be deleted with \TWStoredKeyDelete
+extern struct TWStoredKey* _Nullable TWAsyncTaskTakeStoredKey(struct TWAsyncTask* _Nonnull task);
+
+/// Deletes the task and the results not taken. A pending task is cancelled and waited for first, including its
+/// callback, so `context` can be freed afterwards; when called from the task's own callback, the task is freed once the
+/// callback returns. Don't delete a queued task from the callback of another one, the executor could be saturated.
+extern void TWAsyncTaskDelete(struct TWAsyncTask* _Nonnull task);
+
+TW_EXTERN_C_END
@@ -0,0 +1,82 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Persistent set of unspent outputs of a Bitcoin-like wallet, for planning repeatedly against the same UTXOs
+/// without passing and parsing the full UTXO list on every call. The UTXOs are kept sorted by amount.
+/// Not thread-safe.
+TW_EXPORT_CLASS
+struct TWBitcoinUtxoPool;
+
+/// Creates an empty pool.
+///
+/// \param coin The coin type, determines the fee calculation used for dust classification
+/// \note Must be deleted with \TWBitcoinUtxoPoolDelete
+/// \return A pointer to the pool
+TW_EXPORT_STATIC_METHOD
+struct TWBitcoinUtxoPool* _Nonnull TWBitcoinUtxoPoolCreate(enum TWCoinType coin);
+
+/// Delete/Deallocate a given pool.
+///
+/// \param pool Non-null pointer to a pool
+TW_EXPORT_METHOD
+void TWBitcoinUtxoPoolDelete(struct TWBitcoinUtxoPool* _Nonnull pool);
+
+/// Adds an unspent output; an output with the same out-point is replaced.
+///
+/// \param pool Non-null pointer to a pool
+/// \param utxo The serialized data of a Bitcoin.Proto.UnspentTransaction
+/// \return false if the data is not a valid unspent output
+TW_EXPORT_METHOD
+bool TWBitcoinUtxoPoolAdd(struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull utxo);
+
+/// Removes a spent output.
+///
+/// \param pool Non-null pointer to a pool
+/// \param hash The hash of the transaction of the output (32 bytes)
+/// \param index The index of the output in the transaction
+/// \return false if the output is not in the pool
+TW_EXPORT_METHOD
+bool TWBitcoinUtxoPoolSpend(struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull hash, uint32_t index);
+
+/// Number of unspent outputs in the pool.
+///
+/// \param pool Non-null pointer to a pool
+/// \return the number of outputs
+TW_EXPORT_PROPERTY
+size_t TWBitcoinUtxoPoolSize(const struct TWBitcoinUtxoPool* _Nonnull pool);
+
+/// Total amount of the unspent outputs in the pool, dust included.
+///
+/// \param pool Non-null pointer to a pool
+/// \return the total amount in satoshis
+TW_EXPORT_PROPERTY
+int64_t TWBitcoinUtxoPoolAmount(const struct TWBitcoinUtxoPool* _Nonnull pool);
+
+/// Total amount of the unspent outputs which are worth more than the fee of spending them.
+///
+/// \param pool Non-null pointer to a pool
+/// \param byteFee The fee rate, in satoshis per byte
+/// \return the spendable amount in satoshis
+TW_EXPORT_METHOD
+int64_t TWBitcoinUtxoPoolSpendableAmount(const struct TWBitcoinUtxoPool* _Nonnull pool, int64_t byteFee);
+
+/// Plans a transaction selecting from the outputs of the pool, in place of the `utxo` list of the input.
+///
+/// \param pool Non-null pointer to a pool
+/// \param input The serialized data of a Bitcoin.Proto.SigningInput
+/// \return The serialized data of a Bitcoin.Proto.TransactionPlan, usable as the plan of the input for signing
+TW_EXPORT_METHOD
+TWData* _Nonnull TWBitcoinUtxoPoolPlan(const struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull input);
+
+TW_EXTERN_C_END
@@ -11,7 +11,7 @@
 
 TW_EXTERN_C_BEGIN
 
-/// A vector of TWData byte arrays
+/// A vector of TWData byte arrays, stored one after the other in a single buffer
 TW_EXPORT_CLASS
 struct TWDataVector;
 
@@ -29,6 +29,16 @@ struct TWDataVector* _Nonnull TWDataVectorCreate();
 TW_EXPORT_STATIC_METHOD
 struct TWDataVector* _Nonnull TWDataVectorCreateWithData(TWData* _Nonnull data);
 
+/// Creates a Vector of Data from its packed representation, copying the two buffers instead of each element.
+///
+/// \param bytes A non-null block of data with the elements one after the other
+/// \param offsets A non-null block of data with the start of each element followed by the end of the last one,
+///                as 32-bit little-endian integers (4 bytes for an empty vector)
+/// \note Must be deleted with \TWDataVectorDelete
+/// \return A Vector of data, null if the offsets don't go from 0 to the size of `bytes` without decreasing
+TW_EXPORT_STATIC_METHOD
+struct TWDataVector* _Nullable TWDataVectorCreateWithPacked(TWData* _Nonnull bytes, TWData* _Nonnull offsets);
+
 /// Delete/Deallocate a Vector of Data
 ///
 /// \param dataVector A non-null Vector of data
@@ -59,4 +69,20 @@ size_t TWDataVectorSize(const struct TWDataVector* _Nonnull dataVector);
 TW_EXPORT_METHOD
 TWData* _Nullable TWDataVectorGet(const struct TWDataVector* _Nonnull dataVector, size_t index);
 
+/// Retrieve all the elements one after the other, see \TWDataVectorCreateWithPacked.
+///
+/// \param dataVector A non-null Vector of data
+/// \note Returned element must be freed with \TWDataDelete
+/// \return A non-null block of data
+TW_EXPORT_PROPERTY
+TWData* _Nonnull TWDataVectorPackedBytes(const struct TWDataVector* _Nonnull dataVector);
+
+/// Retrieve the offsets of the elements in \TWDataVectorPackedBytes, see \TWDataVectorCreateWithPacked.
+///
+/// \param dataVector A non-null Vector of data
+/// \note Returned element must be freed with \TWDataDelete
+/// \return A non-null block of data, with `size + 1` 32-bit little-endian integers
+TW_EXPORT_PROPERTY
+TWData* _Nonnull TWDataVectorPackedOffsets(const struct TWDataVector* _Nonnull dataVector);
+
 TW_EXTERN_C_END
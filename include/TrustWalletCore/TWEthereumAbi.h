@@ -82,4 +82,37 @@ TWString* _Nullable TWEthereumAbiDecodeCall(TWData* _Nonnull data, TWString* _No
 TW_EXPORT_STATIC_METHOD
 TWData* _Nonnull TWEthereumAbiEncodeTyped(TWString* _Nonnull messageJson);
 
+/// Encode a function call with static parameters in one call, without building a function object.
+/// The signature is compiled once and cached, e.g. "transfer(address,uint256)"; supported parameter
+/// types are address, bool, uint8 ... uint256 and bytes1 ... bytes32.
+/// Arguments are packed: concatenated, each big endian in its natural size
+/// (20 bytes for address, 1 for bool, N/8 for uintN, N for bytesN).
+/// On error, empty Data is returned.
+///
+/// \param signature Non-null function signature
+/// \param packedArguments Non-null packed arguments
+/// \return Non-null encoded call data
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWEthereumAbiEncodeCompiled(TWString* _Nonnull signature, TWData* _Nonnull packedArguments);
+
+/// Encode a function call with static parameters like `TWEthereumAbiEncodeCompiled`, from a JSON array of arguments:
+/// numbers as JSON numbers or decimal or 0x-prefixed hex strings, bools as JSON booleans, addresses and bytes as hex strings.
+/// On error, empty Data is returned.
+///
+/// \param signature Non-null function signature
+/// \param argumentsJson Non-null JSON array of arguments
+/// \return Non-null encoded call data
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWEthereumAbiEncodeCompiledJson(TWString* _Nonnull signature, TWString* _Nonnull argumentsJson);
+
+/// Decode call data (with the selector) or return data (without) of a function with static parameters
+/// into packed values, the layout of `TWEthereumAbiEncodeCompiled` arguments.
+/// On error, empty Data is returned.
+///
+/// \param signature Non-null function signature
+/// \param encoded Non-null call data or return data
+/// \return Non-null packed values
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWEthereumAbiDecodeCompiled(TWString* _Nonnull signature, TWData* _Nonnull encoded);
+
 TW_EXTERN_C_END
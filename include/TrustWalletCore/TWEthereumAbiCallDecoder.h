@@ -0,0 +1,48 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWData.h"
+#include "TWString.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Index of Ethereum ABI functions by selector, to decode many calls without parsing the ABI each time.
+TW_EXPORT_CLASS
+struct TWEthereumAbiCallDecoder;
+
+/// Creates an empty decoder. It must be deleted at the end.
+///
+/// \return Non-null decoder
+TW_EXPORT_STATIC_METHOD
+struct TWEthereumAbiCallDecoder* _Nonnull TWEthereumAbiCallDecoderCreate(void);
+
+/// Deletes a decoder created with `TWEthereumAbiCallDecoderCreate`.
+///
+/// \param decoder Non-null decoder
+TW_EXPORT_METHOD
+void TWEthereumAbiCallDecoderDelete(struct TWEthereumAbiCallDecoder* _Nonnull decoder);
+
+/// Adds the functions of an ABI json: an object of functions keyed by hex selector, like the abi of
+/// `TWEthereumAbiDecodeCall`, or a standard ABI array. Functions of the same selector are replaced.
+///
+/// \param decoder Non-null decoder
+/// \param abi Non-null ABI json string
+/// \return false if the ABI is malformed
+TW_EXPORT_METHOD
+bool TWEthereumAbiCallDecoderAddAbi(struct TWEthereumAbiCallDecoder* _Nonnull decoder, TWString* _Nonnull abi);
+
+/// Decodes function call data to human readable json format, like `TWEthereumAbiDecodeCall`.
+///
+/// \param decoder Non-null decoder
+/// \param callData Non-null block of data
+/// \return json string of the call, null if its function is unknown or it is invalid
+TW_EXPORT_METHOD
+TWString* _Nullable TWEthereumAbiCallDecoderDecode(struct TWEthereumAbiCallDecoder* _Nonnull decoder, TWData* _Nonnull callData);
+
+TW_EXTERN_C_END
@@ -0,0 +1,47 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Pool of worker threads running all the parallel work of the library: batch signing, key derivation, keystore
+/// encryption and the `TWAsyncTask` operations. The threads calling the library take part in their own batches,
+/// so the total number of threads is bounded by the worker count plus the number of calling threads.
+///
+/// By default there is one worker per hardware thread, started on first use, with the default affinity and priority.
+
+/// Job handed to the host executor, see `TWExecutorSetHost`.
+struct TWExecutorJob;
+
+/// Host executor receiving the jobs of the library, which must run each one with `TWExecutorRunJob`, exactly once,
+/// on any thread. A job may wait for nothing but jobs already running.
+typedef void (*TWExecutorHostCallback)(struct TWExecutorJob* _Nonnull job, void* _Nullable context);
+
+/// Configures the worker threads. Extra workers exit after their current job; the affinity and the priority are
+/// applied by each worker before its next job, where the platform supports it (Linux and Android for the affinity,
+/// Linux, Android and Apple platforms for the priority), and are otherwise ignored.
+///
+/// \param threads Number of worker threads, 0 for the hardware concurrency, at most 256.
+/// \param affinityMask CPUs the workers may run on, bit `i` set for CPU `i`, 0 for no restriction.
+/// \param priority Nice value of the workers, 0 for the default, greater values for lower priorities.
+extern void TWExecutorConfigure(uint32_t threads, uint64_t affinityMask, int32_t priority);
+
+/// Number of worker threads, also the default parallelism of the batch operations.
+extern uint32_t TWExecutorThreadCount(void);
+
+/// Hands the jobs submitted from now on to the host executor, or back to the worker threads if `callback` is null.
+/// `TWExecutorConfigure` still sets the default parallelism of the batch operations.
+///
+/// \param callback Host executor, or null.
+/// \param context Passed to `callback` with each job.
+extern void TWExecutorSetHost(TWExecutorHostCallback _Nullable callback, void* _Nullable context);
+
+/// Runs and frees a job received by the host executor.
+extern void TWExecutorRunJob(struct TWExecutorJob* _Nonnull job);
+
+TW_EXTERN_C_END
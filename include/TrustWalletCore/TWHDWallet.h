@@ -10,6 +10,7 @@
 #include "TWCoinType.h"
 #include "TWCurve.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWDerivation.h"
 #include "TWDerivationPath.h"
 #include "TWHDVersion.h"
@@ -131,6 +132,23 @@ TWString* _Nonnull TWHDWalletGetAddressForCoin(struct TWHDWallet* _Nonnull walle
 TW_EXPORT_METHOD
 TWString* _Nonnull TWHDWalletGetAddressDerivation(struct TWHDWallet* _Nonnull wallet, enum TWCoinType coin, enum TWDerivation derivation);
 
+/// Generates a range of addresses for the specified coin and derivation (without exposing intermediary private keys).
+/// The account and change levels are derived once, addresses are generated for indices startIndex ..< startIndex + count.
+///
+/// \see TWHDWalletGetAddressDerivation
+/// \param wallet non-null TWHDWallet
+/// \param coin  a coin type
+/// \param derivation  a (custom) derivation to use
+/// \param account  the account index
+/// \param change  the change index
+/// \param startIndex  the first address index
+/// \param count  the number of addresses
+/// \param threads  the number of worker threads; 0 uses the hardware concurrency, 1 derives in the calling thread
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+/// \return UTF-8 encoded addresses in index order; empty if the coin's derivation path doesn't support it
+TW_EXPORT_METHOD
+struct TWDataVector* _Nonnull TWHDWalletDeriveAddresses(struct TWHDWallet* _Nonnull wallet, enum TWCoinType coin, enum TWDerivation derivation, uint32_t account, uint32_t change, uint32_t startIndex, uint32_t count, uint32_t threads);
+
 /// Generates the private key for the specified derivation path.
 ///
 /// \see TWHDWalletGetKeyForCoin
@@ -0,0 +1,66 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Operations reported by the instrumentation.
+enum TWInstrumentationOperation {
+    TWInstrumentationOperationSign = 0,
+    TWInstrumentationOperationPlan = 1,
+    TWInstrumentationOperationPreImageHashes = 2,
+    TWInstrumentationOperationCompile = 3,
+};
+
+/// One signing, planning, pre-image hashing or compiling operation, reported when it completes.
+///
+/// The phase times are filled by the coins whose input and output are protobuf messages handled by the
+/// library (most of them); they are 0 for the others. Operations nested in another one, e.g. a coin signing
+/// through another coin's signer, are reported separately.
+struct TWInstrumentationSpan {
+    /// The coin of the operation.
+    enum TWCoinType coin;
+    /// The operation.
+    enum TWInstrumentationOperation operation;
+    /// Wall time of the whole operation, in nanoseconds.
+    uint64_t totalNanos;
+    /// Time spent parsing the input.
+    uint64_t parseNanos;
+    /// Time spent signing, planning, hashing or compiling.
+    uint64_t signNanos;
+    /// Time spent serializing the output.
+    uint64_t serializeNanos;
+    /// Size of the serialized input.
+    uint64_t bytesIn;
+    /// Size of the serialized output.
+    uint64_t bytesOut;
+    /// Difference of the installed allocation counter over the operation; 0 without one.
+    uint64_t allocations;
+};
+
+/// Receives the completed spans, on the thread that ran the operation. Must be thread safe and must not throw.
+typedef void (*TWInstrumentationCallback)(const struct TWInstrumentationSpan *_Nonnull span, void *_Nullable context);
+
+/// Returns a monotonically increasing allocation count, e.g. from a replaced `malloc` or `operator new`.
+typedef uint64_t (*TWInstrumentationAllocationCounter)(void *_Nullable context);
+
+/// Installs the span callback, or disables the instrumentation if it is null. Disabled, an operation costs an
+/// atomic load. Operations already running when the callback changes report to the previous one, or not at all.
+///
+/// \param callback The span callback, or null.
+/// \param context Passed to the callback as is.
+extern void TWInstrumentationSetCallback(TWInstrumentationCallback _Nullable callback, void *_Nullable context);
+
+/// Installs the allocation counter sampled at the start and end of the operations, or removes it if it is null.
+///
+/// \param counter The allocation counter, or null.
+/// \param context Passed to the counter as is.
+extern void TWInstrumentationSetAllocationCounter(TWInstrumentationAllocationCounter _Nullable counter, void *_Nullable context);
+
+TW_EXTERN_C_END
@@ -22,4 +22,11 @@ struct TWLiquidStaking;
 TW_EXPORT_STATIC_METHOD
 TWData *_Nonnull TWLiquidStakingBuildRequest(TWData *_Nonnull input);
 
+/// Builds many LiquidStaking transaction inputs in one call.
+///
+/// \param input The serialized data of LiquidStakingInputBatch.
+/// \return The serialized data of LiquidStakingOutputBatch, with the outputs in the order of the inputs.
+TW_EXPORT_STATIC_METHOD
+TWData *_Nonnull TWLiquidStakingBuildRequests(TWData *_Nonnull input);
+
 TW_EXTERN_C_END
@@ -0,0 +1,64 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+#include "TWInstrumentation.h"
+
+TW_EXTERN_C_BEGIN
+
+/// The in-process caches whose memory is reported.
+enum TWMemoryCache {
+    /// BIP32 nodes of the HD wallets with a node cache, all wallets together.
+    TWMemoryCacheHDNode = 0,
+    /// Solana program derived addresses.
+    TWMemoryCacheProgramAddress = 1,
+    /// Ethereum ABI function selectors, the keccak256 hashes of function type signatures.
+    TWMemoryCacheFunctionSelector = 2,
+    /// Outputs of signing and planning, see `TWSigningCacheConfigure`.
+    TWMemoryCacheSigning = 3,
+};
+
+/// Memory held by one cache: its entries, and the containers indexing them.
+struct TWMemoryCacheStats {
+    /// Bytes currently allocated.
+    uint64_t bytes;
+    /// Highest `bytes` since the start or the last `TWMemoryStatsResetPeaks`.
+    uint64_t peakBytes;
+    /// Number of entries.
+    uint64_t entries;
+};
+
+/// Returns the memory held by a cache.
+///
+/// \param cache The cache.
+extern struct TWMemoryCacheStats TWMemoryStatsCache(enum TWMemoryCache cache);
+
+/// Bytes currently allocated by all the caches.
+extern uint64_t TWMemoryStatsTotalBytes(void);
+
+/// Highest total of the caches at the end of an operation of the given kind, since the start or the last
+/// `TWMemoryStatsResetPeaks`. Sampled only while the instrumentation is enabled, see `TWInstrumentationSetCallback`.
+///
+/// \param operation The kind of operation.
+extern uint64_t TWMemoryStatsOperationPeakBytes(enum TWInstrumentationOperation operation);
+
+/// Resets the peaks of the caches and of the operations to the current totals.
+extern void TWMemoryStatsResetPeaks(void);
+
+/// Evicts entries of a cache until it has at most `maxEntries`, least recently used first.
+/// The cache keeps its configuration and may grow again.
+///
+/// \param cache The cache.
+/// \param maxEntries Number of entries to keep.
+extern void TWMemoryStatsTrim(enum TWMemoryCache cache, uint32_t maxEntries);
+
+/// Wipes and removes all entries of a cache.
+///
+/// \param cache The cache.
+extern void TWMemoryStatsFlush(enum TWMemoryCache cache);
+
+TW_EXTERN_C_END
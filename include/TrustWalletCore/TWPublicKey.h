@@ -8,6 +8,7 @@
 
 #include "TWBase.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWPublicKeyType.h"
 #include "TWString.h"
 
@@ -98,6 +99,18 @@ bool TWPublicKeyVerifyAsDER(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull si
 TW_EXPORT_METHOD
 bool TWPublicKeyVerifyZilliqaSchnorr(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull signature, TWData *_Nonnull message);
 
+/// Verifies a batch of Ed25519-family signatures, spreading the work over a fixed-size pool of worker threads.
+///
+/// \param publicKeys Non-null pointer to the raw public keys
+/// \param type public key type: ED25519, ED25519Blake2b or ED25519Cardano
+/// \param signatures Non-null pointer to the signatures, one per public key
+/// \param messages Non-null pointer to the messages, one per public key
+/// \param threads The number of worker threads; 0 uses the hardware concurrency, 1 verifies sequentially in the calling thread.
+/// \return one byte per item, in the same order: 1 if the signature is valid, 0 otherwise (including invalid public keys);
+/// null if the vectors differ in size or the type is not an Ed25519 type.
+TW_EXPORT_STATIC_METHOD
+TWData *_Nullable TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, uint32_t threads);
+
 /// Give the public key type (eliptic) of a given public key
 ///
 /// \param publicKey Non-null pointer to a public key
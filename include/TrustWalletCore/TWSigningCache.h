@@ -0,0 +1,31 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+
+TW_EXTERN_C_BEGIN
+
+/// In-process cache of the outputs of `TWAnySignerSign`, `TWAnySignerSignBatch` and `TWAnySignerPlan`, keyed by the
+/// coin and the SHA256 digest of the serialized input: a byte-identical input submitted again, e.g. a retry after a
+/// timeout, gets the previous output without being planned or signed again.
+///
+/// Disabled by default. Outputs are only kept in memory, and are wiped when they are evicted, expire or are flushed.
+
+/// Enables the cache with the given limits, or disables and flushes it if `capacity` is 0.
+/// Cached outputs are kept if the cache stays enabled, the least recently used are evicted if it shrinks.
+///
+/// \param capacity Maximum number of cached outputs, the least recently used one is evicted first.
+/// \param ttlSeconds Number of seconds an output is reused after it was computed, 0 for no limit.
+extern void TWSigningCacheConfigure(uint32_t capacity, uint32_t ttlSeconds);
+
+/// Wipes and removes all cached outputs. The cache stays enabled.
+extern void TWSigningCacheFlush(void);
+
+/// Number of cached outputs, expired ones not removed yet included.
+extern uint32_t TWSigningCacheSize(void);
+
+TW_EXTERN_C_END
@@ -0,0 +1,63 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWData.h"
+#include "TWString.h"
+
+TW_EXTERN_C_BEGIN
+
+struct TWHDWallet;
+
+/// SLIP-39 Shamir share generation and recovery. Share sets are passed as one string, one share mnemonic per line.
+TW_EXPORT_STRUCT
+struct TWSlip39;
+
+/// Splits a master secret into SLIP-39 shares.
+///
+/// \param masterSecret Non-null master secret, at least 16 bytes and of even length
+/// \param groupThreshold number of groups needed to recover the secret
+/// \param groups Non-null member threshold and member count of each group, two bytes per group
+/// \param passphrase Non-null passphrase encrypting the master secret, can be empty
+/// \return the share mnemonics, one per line in group order, or null if the parameters are invalid
+TW_EXPORT_STATIC_METHOD
+TWString* _Nullable TWSlip39Generate(TWData* _Nonnull masterSecret, uint8_t groupThreshold, TWData* _Nonnull groups, TWString* _Nonnull passphrase);
+
+/// Splits the entropy of a wallet into SLIP-39 shares, see \TWSlip39Generate.
+/// The wallet is recovered with \TWHDWalletCreateWithEntropy from the recovered secret.
+///
+/// \param wallet Non-null wallet, created from a 16, 24 or 32 byte entropy (12, 18 or 24 words)
+/// \return the share mnemonics, one per line in group order, or null if the parameters are invalid
+TW_EXPORT_STATIC_METHOD
+TWString* _Nullable TWSlip39GenerateWithWallet(struct TWHDWallet* _Nonnull wallet, uint8_t groupThreshold, TWData* _Nonnull groups, TWString* _Nonnull passphrase);
+
+/// Recovers the master secret from SLIP-39 shares, in any order.
+///
+/// \param shares Non-null share mnemonics, one per line
+/// \param passphrase Non-null passphrase used when generating the shares
+/// \return the master secret, or null if the shares are invalid, inconsistent or not enough.
+/// A wrong passphrase recovers a different secret.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nullable TWSlip39Recover(TWString* _Nonnull shares, TWString* _Nonnull passphrase);
+
+/// Determines whether a SLIP-39 share mnemonic has valid words and checksum.
+///
+/// \param share Non-null share mnemonic
+/// \return true if the share is valid, false otherwise
+TW_EXPORT_STATIC_METHOD
+bool TWSlip39IsValidShare(TWString* _Nonnull share);
+
+/// Audits a share set: every threshold combination of the shares of each group, then of the groups, must recover the
+/// same secret. Combinations are checked in parallel, without the passphrase.
+///
+/// \param shares Non-null share mnemonics, one per line
+/// \return the number of combinations checked, or 0 if a combination fails or the shares are invalid
+TW_EXPORT_STATIC_METHOD
+uint64_t TWSlip39VerifyCombinations(TWString* _Nonnull shares);
+
+TW_EXTERN_C_END
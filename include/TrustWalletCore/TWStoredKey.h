@@ -9,6 +9,7 @@
 #include "TWBase.h"
 #include "TWCoinType.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWDerivation.h"
 #include "TWHDWallet.h"
 #include "TWPrivateKey.h"
@@ -84,6 +85,32 @@ struct TWStoredKey* _Nullable TWStoredKeyImportHDWalletWithEncryption(TWString*
 TW_EXPORT_STATIC_METHOD
 struct TWStoredKey* _Nullable TWStoredKeyImportJSON(TWData* _Nonnull json);
 
+/// Imports many HD wallets sharing a password, as \TWStoredKeyImportHDWalletWithEncryption for each mnemonic,
+/// encrypting the keys on the worker threads of the library.
+///
+/// \param mnemonics UTF-8 encoded mnemonics
+/// \param names UTF-8 encoded names, one per mnemonic
+/// \param password Non-null block of data, password shared by the keys
+/// \param coin the coin of the default account of each key
+/// \param encryption cipher encryption mode
+/// \param threads the number of worker threads; 0 uses the threads of the library, 1 imports in the calling thread
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+/// \return the JSON key file of each mnemonic, in the same order; empty data if the mnemonic can't be imported,
+/// or for all of them if there isn't one name per mnemonic
+TW_EXPORT_STATIC_METHOD
+struct TWDataVector* _Nonnull TWStoredKeyImportHDWalletBatch(const struct TWDataVector* _Nonnull mnemonics, const struct TWDataVector* _Nonnull names, TWData* _Nonnull password, enum TWCoinType coin, enum TWStoredKeyEncryption encryption, uint32_t threads);
+
+/// Decrypts the payloads of many JSON key files sharing a password, on the worker threads of the library.
+///
+/// \param jsons JSON key files
+/// \param password Non-null block of data, password shared by the keys
+/// \param threads the number of worker threads; 0 uses the threads of the library, 1 decrypts in the calling thread
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+/// \return the decrypted payload of each key file, in the same order: the UTF-8 encoded mnemonic or the private key;
+/// empty data if the key file is invalid or the password is wrong
+TW_EXPORT_STATIC_METHOD
+struct TWDataVector* _Nonnull TWStoredKeyDecryptJSONBatch(const struct TWDataVector* _Nonnull jsons, TWData* _Nonnull password, uint32_t threads);
+
 /// Creates a new key, with given encryption strength level. Returned object needs to be deleted.
 ///
 /// \param name The name of the key to be stored
@@ -304,4 +331,23 @@ bool TWStoredKeyFixAddresses(struct TWStoredKey* _Nonnull key, TWData* _Nonnull
 TW_EXPORT_PROPERTY
 TWString* _Nullable TWStoredKeyEncryptionParameters(struct TWStoredKey* _Nonnull key);
 
+/// Picks encryption parameters tuned to this device: scrypt parameters taking about the unlock time of the level
+/// (100ms minimal, 250ms weak and default, 1s standard), instead of the fixed presets.
+/// Tuning benchmarks scrypt for up to about twice that time, so it is best run once, off the main thread.
+///
+/// \param encryptionLevel The level of encryption, see \TWStoredKeyEncryptionLevel
+/// \param encryption cipher encryption mode
+/// \return encryption parameters as a json string, for \TWStoredKeyUpdateEncryptionParameters
+TW_EXPORT_STATIC_METHOD
+TWString* _Nonnull TWStoredKeyTuneEncryptionParameters(enum TWStoredKeyEncryptionLevel encryptionLevel, enum TWStoredKeyEncryption encryption);
+
+/// Re-encrypts the key with new encryption parameters, using a fresh salt and IV.
+///
+/// \param key Non-null pointer to a stored key
+/// \param password Non-null block of data, password of the stored key
+/// \param parameters Non-null json string of encryption parameters, as returned by \TWStoredKeyTuneEncryptionParameters or \TWStoredKeyEncryptionParameters
+/// \return `false` if the password is incorrect or the parameters are invalid, true otherwise.
+TW_EXPORT_METHOD
+bool TWStoredKeyUpdateEncryptionParameters(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWString* _Nonnull parameters);
+
 TW_EXTERN_C_END
@@ -0,0 +1,65 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+#include "TWDataVector.h"
+
+TW_EXTERN_C_BEGIN
+
+/// External signing of a batch of transactions of one coin. Each signing input is parsed, and planned for UTXO
+/// chains, once: for obtaining its pre-image hashes and then for compiling it with the signatures of those hashes.
+/// The results are the same as those of TWTransactionCompilerPreImageHashes and
+/// TWTransactionCompilerCompileWithSignatures. Not thread-safe.
+TW_EXPORT_CLASS
+struct TWTransactionCompilerBatch;
+
+/// Parses (and plans) a batch of signing inputs.
+///
+/// \param coinType coin type of all the inputs.
+/// \param txInputs the serialized data of the signing inputs.
+/// \param threads the number of worker threads; 0 uses the hardware concurrency, 1 works in the calling thread.
+/// \note Must be deleted with \TWTransactionCompilerBatchDelete
+/// \return A pointer to the batch
+TW_EXPORT_STATIC_METHOD
+struct TWTransactionCompilerBatch* _Nonnull TWTransactionCompilerBatchCreate(enum TWCoinType coinType, const struct TWDataVector* _Nonnull txInputs, uint32_t threads);
+
+/// Delete/Deallocate a given batch.
+///
+/// \param batch Non-null pointer to a batch
+TW_EXPORT_METHOD
+void TWTransactionCompilerBatchDelete(struct TWTransactionCompilerBatch* _Nonnull batch);
+
+/// Number of transactions in the batch.
+///
+/// \param batch Non-null pointer to a batch
+/// \return the number of transactions
+TW_EXPORT_PROPERTY
+size_t TWTransactionCompilerBatchSize(const struct TWTransactionCompilerBatch* _Nonnull batch);
+
+/// Obtains the pre-signing hashes of all the transactions.
+///
+/// \param batch Non-null pointer to a batch
+/// \param threads the number of worker threads; 0 uses the hardware concurrency, 1 works in the calling thread.
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+/// \return serialized data of a proto object `PreSigningOutput` per transaction, in input order.
+TW_EXPORT_METHOD
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchPreImageHashes(struct TWTransactionCompilerBatch* _Nonnull batch, uint32_t threads);
+
+/// Compiles one transaction of the batch with its external signatures.
+///
+/// \param batch Non-null pointer to a batch
+/// \param index index of the transaction in the batch.
+/// \param signatures signatures of the pre-image hashes of the transaction, in the same order.
+/// \param publicKeys public keys of the signatures.
+/// \return serialized data of a proto object `SigningOutput`; empty for an invalid index or public key.
+TW_EXPORT_METHOD
+TWData* _Nonnull TWTransactionCompilerBatchCompileWithSignatures(struct TWTransactionCompilerBatch* _Nonnull batch, size_t index, const struct TWDataVector* _Nonnull signatures, const struct TWDataVector* _Nonnull publicKeys);
+
+TW_EXTERN_C_END
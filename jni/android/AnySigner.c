@@ -39,3 +39,36 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativePlan(JNIEnv *env, jclas
     TWDataDelete(inputData);
     return resultData;
 }
+
+jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativeSignDirect(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jint coin) {
+    TWData *inputData = TWDataCreateWithJByteBuffer(env, input, offset, size);
+    if (inputData == NULL) {
+        return NULL;
+    }
+    TWData *outputData = TWAnySignerSign(inputData, coin);
+    jbyteArray resultData = TWDataJByteArray(outputData, env);
+    TWDataDelete(inputData);
+    return resultData;
+}
+
+jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativePlanDirect(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jint coin) {
+    TWData *inputData = TWDataCreateWithJByteBuffer(env, input, offset, size);
+    if (inputData == NULL) {
+        return NULL;
+    }
+    TWData *outputData = TWAnySignerPlan(inputData, coin);
+    jbyteArray resultData = TWDataJByteArray(outputData, env);
+    TWDataDelete(inputData);
+    return resultData;
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignInto(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jint coin, jobject output, jint outputOffset, jint outputCapacity) {
+    TWData *inputData = TWDataCreateWithJByteBuffer(env, input, offset, size);
+    if (inputData == NULL) {
+        return -1;
+    }
+    TWData *outputData = TWAnySignerSign(inputData, coin);
+    jint outputSize = TWDataCopyToJByteBuffer(outputData, env, output, outputOffset, outputCapacity);
+    TWDataDelete(inputData);
+    return outputSize;
+}
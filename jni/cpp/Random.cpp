@@ -8,6 +8,9 @@
 #include <string.h>
 
 static JavaVM* cachedJVM;
+// One SecureRandom for the process: random_buffer only seeds the per-thread generators of TW::Random
+static jobject cachedSecureRandom;
+static jmethodID cachedNextBytes;
 
 extern "C" {
     uint32_t random32();
@@ -16,6 +19,20 @@ extern "C" {
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved) {
     cachedJVM = jvm;
+
+    JNIEnv *env;
+    if (jvm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_2) != JNI_OK) {
+        return JNI_ERR;
+    }
+    // SecureRandom random = new SecureRandom();
+    jclass secureRandomClass = env->FindClass("java/security/SecureRandom");
+    jmethodID constructor = env->GetMethodID(secureRandomClass, "<init>", "()V");
+    jobject random = env->NewObject(secureRandomClass, constructor);
+    cachedSecureRandom = env->NewGlobalRef(random);
+    cachedNextBytes = env->GetMethodID(secureRandomClass, "nextBytes", "([B)V");
+    env->DeleteLocalRef(random);
+    env->DeleteLocalRef(secureRandomClass);
+
     return JNI_VERSION_1_2;
 }
 
@@ -29,23 +46,13 @@ void random_buffer(uint8_t *buf, size_t len) {
     JNIEnv *env;
     cachedJVM->AttachCurrentThread(&env, nullptr);
 
-    // SecureRandom random = new SecureRandom();
-    jclass secureRandomClass = env->FindClass("java/security/SecureRandom");
-    jmethodID constructor = env->GetMethodID(secureRandomClass, "<init>", "()V");
-    jobject random = env->NewObject(secureRandomClass, constructor);
-
     //byte array[] = new byte[len];
     jbyteArray array = env->NewByteArray(static_cast<jsize>(len));
 
     //random.nextBytes(bytes);
-    jmethodID nextBytes = env->GetMethodID(secureRandomClass, "nextBytes", "([B)V");
-    env->CallVoidMethod(random, nextBytes, array);
+    env->CallVoidMethod(cachedSecureRandom, cachedNextBytes, array);
 
-    jbyte* bytes = env->GetByteArrayElements(array, nullptr);
-    memcpy(buf, bytes, len);
-    env->ReleaseByteArrayElements(array, bytes, JNI_ABORT);
+    env->GetByteArrayRegion(array, 0, static_cast<jsize>(len), reinterpret_cast<jbyte*>(buf));
 
     env->DeleteLocalRef(array);
-    env->DeleteLocalRef(random);
-    env->DeleteLocalRef(secureRandomClass);
 }
@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include <algorithm>
 #include <assert.h>
 #include <vector>
 
@@ -19,6 +20,36 @@ jbyteArray TWDataJByteArray(TWData *_Nonnull data, JNIEnv *env) {
 
 TWData *_Nonnull TWDataCreateWithJByteArray(JNIEnv *env, jbyteArray _Nonnull array) {
     jsize size = env->GetArrayLength(array);
-    jbyte *bytes = env->GetByteArrayElements(array, nullptr);
-    return TWDataCreateWithBytes((uint8_t *) bytes, size);
+    // copy straight into the new data, without pinning or copying the array elements first
+    TWData *data = TWDataCreateWithSize(size);
+    env->GetByteArrayRegion(array, 0, size, (jbyte *) TWDataBytes(data));
+    return data;
+}
+
+TWData *_Nullable TWDataCreateWithJByteBuffer(JNIEnv *env, jobject _Nonnull buffer, jint offset, jint size) {
+    auto *bytes = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (bytes == nullptr || offset < 0 || size < 0 || static_cast<jlong>(offset) + size > capacity) {
+        jclass exceptionClass = env->FindClass("java/lang/IllegalArgumentException");
+        env->ThrowNew(exceptionClass, "Expected a direct ByteBuffer holding the given range");
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(bytes + offset, static_cast<size_t>(size));
+}
+
+jint TWDataCopyToJByteBuffer(TWData *_Nonnull data, JNIEnv *env, jobject _Nonnull buffer, jint offset, jint capacity) {
+    auto dataSize = static_cast<jint>(TWDataSize(data));
+    auto *bytes = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    jlong bufferCapacity = env->GetDirectBufferCapacity(buffer);
+    if (bytes == nullptr || offset < 0 || capacity < 0 || static_cast<jlong>(offset) + capacity > bufferCapacity) {
+        TWDataDelete(data);
+        jclass exceptionClass = env->FindClass("java/lang/IllegalArgumentException");
+        env->ThrowNew(exceptionClass, "Expected a direct ByteBuffer holding the given range");
+        return -1;
+    }
+    if (dataSize <= capacity) {
+        std::copy(TWDataBytes(data), TWDataBytes(data) + dataSize, bytes + offset);
+    }
+    TWDataDelete(data);
+    return dataSize;
 }
@@ -17,4 +17,14 @@ jbyteArray TWDataJByteArray(TWData *data, JNIEnv *env);
 /// Converts a Java byte array to a TWData, caller must delete it after use.
 TWData * TWDataCreateWithJByteArray(JNIEnv *env, jbyteArray array);
 
+/// Creates a TWData from `size` bytes at `offset` of a direct ByteBuffer, copying them once.
+/// Throws IllegalArgumentException and returns null if the buffer is not direct or too small.
+TWData * TWDataCreateWithJByteBuffer(JNIEnv *env, jobject buffer, jint offset, jint size);
+
+/// Copies a TWData (will be deleted within this call) to `offset` of a direct ByteBuffer holding `capacity` bytes there,
+/// so that a pooled buffer can be reused instead of allocating a byte array per call.
+/// Returns the size of the data; nothing is copied if it exceeds `capacity`.
+/// Throws IllegalArgumentException and returns -1 if the buffer is not direct or too small for the given range.
+jint TWDataCopyToJByteBuffer(TWData *data, JNIEnv *env, jobject buffer, jint offset, jint capacity);
+
 TW_EXTERN_C_END
@@ -9,6 +9,8 @@ package wallet.core.java;
 import com.google.protobuf.MessageLite;
 import com.google.protobuf.Parser;
 
+import java.nio.ByteBuffer;
+
 import wallet.core.jni.CoinType;
 
 public class AnySigner {
@@ -21,6 +23,29 @@ public class AnySigner {
     }
     public static native byte[] nativeSign(byte[] data, int coin);
 
+    /// Signs the serialized input held by the remaining bytes of a direct ByteBuffer.
+    public static <T extends MessageLite> T sign(ByteBuffer input, CoinType coin, Parser<T> parser) throws Exception {
+        byte[] outputData = nativeSignDirect(input, input.position(), input.remaining(), coin.value());
+        T output = parser.parseFrom(outputData);
+        outputData = null;
+        return output;
+    }
+    public static native byte[] nativeSignDirect(ByteBuffer data, int offset, int size, int coin);
+
+    /// Signs the serialized input held by the remaining bytes of a direct ByteBuffer into a reusable direct
+    /// output ByteBuffer, without allocating a byte array for the output.
+    /// On success the output is written at the output position and the output limit is set to its end.
+    /// Returns the size of the serialized output; if it exceeds the remaining bytes of the output,
+    /// nothing is written and the buffer is left unchanged, so that a larger one can be used.
+    public static int signInto(ByteBuffer input, CoinType coin, ByteBuffer output) {
+        int size = nativeSignInto(input, input.position(), input.remaining(), coin.value(), output, output.position(), output.remaining());
+        if (size >= 0 && size <= output.remaining()) {
+            output.limit(output.position() + size);
+        }
+        return size;
+    }
+    public static native int nativeSignInto(ByteBuffer data, int offset, int size, int coin, ByteBuffer output, int outputOffset, int outputCapacity);
+
     public static native String signJSON(String json, byte[] key, int coin);
 
     public static native boolean supportsJSON(int coin);
@@ -33,4 +58,13 @@ public class AnySigner {
         return output;
     }
     public static native byte[] nativePlan(byte[] data, int coin);
+
+    /// Plans the serialized input held by the remaining bytes of a direct ByteBuffer.
+    public static <T extends MessageLite> T plan(ByteBuffer input, CoinType coin, Parser<T> parser) throws Exception {
+        byte[] outputData = nativePlanDirect(input, input.position(), input.remaining(), coin.value());
+        T output = parser.parseFrom(outputData);
+        outputData = null;
+        return output;
+    }
+    public static native byte[] nativePlanDirect(ByteBuffer data, int offset, int size, int coin);
 }
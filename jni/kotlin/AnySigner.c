@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <TrustWalletCore/TWDataVector.h>
+
 #include "AnySigner.h"
 #include "TWJNI.h"
 
@@ -54,3 +56,61 @@ jbyteArray JNICALL Java_com_trustwallet_core_AnySigner_plan(JNIEnv *env, jclass
     TWDataDelete(inputData);
     return resultData;
 }
+
+jbyteArray JNICALL Java_com_trustwallet_core_AnySigner_signDirect(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jobject coin) {
+    jclass coinClass = (*env)->GetObjectClass(env, coin);
+    jmethodID coinValueMethodID = (*env)->GetMethodID(env, coinClass, "value", "()I");
+    uint32_t coinValue = (*env)->CallIntMethod(env, coin, coinValueMethodID);
+
+    TWData *inputData = TWDataCreateWithJByteBuffer(env, input, offset, size);
+    if (inputData == NULL) {
+        return NULL;
+    }
+    TWData *outputData = TWAnySignerSign(inputData, coinValue);
+    jbyteArray resultData = TWDataJByteArray(outputData, env);
+    TWDataDelete(inputData);
+    return resultData;
+}
+
+jint JNICALL Java_com_trustwallet_core_AnySigner_signInto(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jobject coin, jobject output, jint outputOffset, jint outputCapacity) {
+    jclass coinClass = (*env)->GetObjectClass(env, coin);
+    jmethodID coinValueMethodID = (*env)->GetMethodID(env, coinClass, "value", "()I");
+    uint32_t coinValue = (*env)->CallIntMethod(env, coin, coinValueMethodID);
+
+    TWData *inputData = TWDataCreateWithJByteBuffer(env, input, offset, size);
+    if (inputData == NULL) {
+        return -1;
+    }
+    TWData *outputData = TWAnySignerSign(inputData, coinValue);
+    jint outputSize = TWDataCopyToJByteBuffer(outputData, env, output, outputOffset, outputCapacity);
+    TWDataDelete(inputData);
+    return outputSize;
+}
+
+jobjectArray JNICALL Java_com_trustwallet_core_AnySigner_signBatch(JNIEnv *env, jclass thisClass, jobjectArray inputs, jobject coin, jint threads) {
+    jclass coinClass = (*env)->GetObjectClass(env, coin);
+    jmethodID coinValueMethodID = (*env)->GetMethodID(env, coinClass, "value", "()I");
+    uint32_t coinValue = (*env)->CallIntMethod(env, coin, coinValueMethodID);
+
+    jsize count = (*env)->GetArrayLength(env, inputs);
+    struct TWDataVector *inputVector = TWDataVectorCreate();
+    for (jsize i = 0; i < count; ++i) {
+        jbyteArray input = (jbyteArray) (*env)->GetObjectArrayElement(env, inputs, i);
+        TWData *inputData = TWDataCreateWithJByteArray(env, input);
+        TWDataVectorAdd(inputVector, inputData);
+        TWDataDelete(inputData);
+        (*env)->DeleteLocalRef(env, input);
+    }
+    struct TWDataVector *outputVector = TWAnySignerSignBatch(inputVector, coinValue, (uint32_t) threads);
+    TWDataVectorDelete(inputVector);
+
+    jclass byteArrayClass = (*env)->FindClass(env, "[B");
+    jobjectArray result = (*env)->NewObjectArray(env, count, byteArrayClass, NULL);
+    for (jsize i = 0; i < count; ++i) {
+        jbyteArray output = TWDataJByteArray(TWDataVectorGet(outputVector, i), env);
+        (*env)->SetObjectArrayElement(env, result, i, output);
+        (*env)->DeleteLocalRef(env, output);
+    }
+    TWDataVectorDelete(outputVector);
+    return result;
+}
@@ -24,6 +24,15 @@ jstring JNICALL Java_com_trustwallet_core_AnySigner_signJson(JNIEnv *env, jclass
 JNIEXPORT
 jbyteArray JNICALL Java_com_trustwallet_core_AnySigner_plan(JNIEnv *env, jclass thisClass, jbyteArray input, jobject coin);
 
+JNIEXPORT
+jbyteArray JNICALL Java_com_trustwallet_core_AnySigner_signDirect(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jobject coin);
+
+JNIEXPORT
+jint JNICALL Java_com_trustwallet_core_AnySigner_signInto(JNIEnv *env, jclass thisClass, jobject input, jint offset, jint size, jobject coin, jobject output, jint outputOffset, jint outputCapacity);
+
+JNIEXPORT
+jobjectArray JNICALL Java_com_trustwallet_core_AnySigner_signBatch(JNIEnv *env, jclass thisClass, jobjectArray inputs, jobject coin, jint threads);
+
 TW_EXTERN_C_END
 
 #endif // JNI_TW_ANYSIGNER_H
@@ -48,6 +48,7 @@ kotlin {
 
             dependencies {
                 api(libs.wire.runtime)
+                api(libs.kotlinx.coroutines.core)
             }
         }
         val iosArm64Main by getting
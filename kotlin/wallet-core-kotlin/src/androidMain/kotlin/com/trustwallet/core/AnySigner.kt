@@ -6,6 +6,8 @@
 
 package com.trustwallet.core
 
+import java.nio.ByteBuffer
+
 actual object AnySigner {
 
     @JvmStatic
@@ -19,4 +21,37 @@ actual object AnySigner {
 
     @JvmStatic
     actual external fun plan(input: ByteArray, coin: CoinType): ByteArray
+
+    @JvmStatic
+    actual fun signBatch(inputs: List<ByteArray>, coin: CoinType, threads: Int): List<ByteArray> =
+        signBatch(inputs.toTypedArray(), coin, threads).asList()
+
+    @JvmStatic
+    private external fun signBatch(inputs: Array<ByteArray>, coin: CoinType, threads: Int): Array<ByteArray>
+
+    // Signs the serialized input held by the remaining bytes of a direct ByteBuffer
+    @JvmStatic
+    fun sign(input: ByteBuffer, coin: CoinType): ByteArray =
+        signDirect(input, input.position(), input.remaining(), coin)
+
+    @JvmStatic
+    private external fun signDirect(input: ByteBuffer, offset: Int, size: Int, coin: CoinType): ByteArray
+
+    // Signs the serialized input held by the remaining bytes of a direct ByteBuffer into a reusable direct output
+    // ByteBuffer, without allocating a byte array. On success the output limit is set to the end of the output.
+    // Returns the output size; if it exceeds the remaining bytes of the output, nothing is written.
+    @JvmStatic
+    fun signInto(input: ByteBuffer, coin: CoinType, output: ByteBuffer): Int {
+        val size = signInto(input, input.position(), input.remaining(), coin, output, output.position(), output.remaining())
+        if (size >= 0 && size <= output.remaining()) {
+            output.limit(output.position() + size)
+        }
+        return size
+    }
+
+    @JvmStatic
+    private external fun signInto(
+        input: ByteBuffer, offset: Int, size: Int, coin: CoinType,
+        output: ByteBuffer, outputOffset: Int, outputCapacity: Int,
+    ): Int
 }
@@ -18,6 +18,9 @@ expect object AnySigner {
     fun signJson(json: String, key: ByteArray, coin: CoinType): String
 
     fun plan(input: ByteArray, coin: CoinType): ByteArray
+
+    // Signs the inputs on `threads` native workers (0 for the number of cores), the outputs in the order of the inputs
+    fun signBatch(inputs: List<ByteArray>, coin: CoinType, threads: Int): List<ByteArray>
 }
 
 fun <T : Message<T, *>> AnySigner.sign(input: Message<*, *>, coin: CoinType, adapter: ProtoAdapter<T>): T =
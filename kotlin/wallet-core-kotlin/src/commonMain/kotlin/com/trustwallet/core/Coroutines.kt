@@ -0,0 +1,66 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+package com.trustwallet.core
+
+import com.squareup.wire.Message
+import com.squareup.wire.ProtoAdapter
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.ensureActive
+import kotlinx.coroutines.withContext
+
+// Suspending variants of the calls that block for tens to hundreds of milliseconds: signing, key decryption and
+// wallet creation. They run on WalletCoreDispatchers.signing instead of the calling thread.
+//
+// A native call can't be interrupted once started: cancelling the caller discards its result, and a batch
+// stops before its next chunk of inputs.
+
+object WalletCoreDispatchers {
+    // Bounded by the number of cores by default. On JS, without threads, the calls still run on the event loop.
+    var signing: CoroutineDispatcher = Dispatchers.Default
+}
+
+// Inputs signed per native batch call, between cancellation checks
+private const val SIGN_BATCH_CHUNK_SIZE = 16
+
+suspend fun AnySigner.signSuspending(input: ByteArray, coin: CoinType): ByteArray =
+    withContext(WalletCoreDispatchers.signing) { sign(input, coin) }
+
+suspend fun AnySigner.planSuspending(input: ByteArray, coin: CoinType): ByteArray =
+    withContext(WalletCoreDispatchers.signing) { plan(input, coin) }
+
+suspend fun <T : Message<T, *>> AnySigner.signSuspending(input: Message<*, *>, coin: CoinType, adapter: ProtoAdapter<T>): T =
+    withContext(WalletCoreDispatchers.signing) { sign(input, coin, adapter) }
+
+suspend fun <T : Message<T, *>> AnySigner.planSuspending(input: Message<*, *>, coin: CoinType, adapter: ProtoAdapter<T>): T =
+    withContext(WalletCoreDispatchers.signing) { plan(input, coin, adapter) }
+
+// Signs the inputs with the native batch signer on `threads` workers (0 for the number of cores)
+suspend fun AnySigner.signBatchSuspending(inputs: List<ByteArray>, coin: CoinType, threads: Int = 0): List<ByteArray> =
+    withContext(WalletCoreDispatchers.signing) {
+        val outputs = ArrayList<ByteArray>(inputs.size)
+        for (chunk in inputs.chunked(SIGN_BATCH_CHUNK_SIZE)) {
+            ensureActive()
+            outputs += signBatch(chunk, coin, threads)
+        }
+        outputs
+    }
+
+suspend fun StoredKey.decryptPrivateKeySuspending(password: ByteArray): ByteArray? =
+    withContext(WalletCoreDispatchers.signing) { decryptPrivateKey(password) }
+
+suspend fun StoredKey.decryptMnemonicSuspending(password: ByteArray): String? =
+    withContext(WalletCoreDispatchers.signing) { decryptMnemonic(password) }
+
+suspend fun StoredKey.privateKeySuspending(coin: CoinType, password: ByteArray): PrivateKey? =
+    withContext(WalletCoreDispatchers.signing) { privateKey(coin, password) }
+
+suspend fun StoredKey.walletSuspending(password: ByteArray): HDWallet? =
+    withContext(WalletCoreDispatchers.signing) { wallet(password) }
+
+suspend fun HDWallet.Companion.createSuspending(mnemonic: String, passphrase: String): HDWallet =
+    withContext(WalletCoreDispatchers.signing) { HDWallet(mnemonic, passphrase) }
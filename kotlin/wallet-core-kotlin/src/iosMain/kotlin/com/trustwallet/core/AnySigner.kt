@@ -19,4 +19,23 @@ actual object AnySigner {
 
     actual fun plan(input: ByteArray, coin: CoinType): ByteArray =
         TWAnySignerPlan(input.toTwData(), coin.value)?.readTwBytes()!!
+
+    actual fun signBatch(inputs: List<ByteArray>, coin: CoinType, threads: Int): List<ByteArray> {
+        val inputVector = TWDataVectorCreate()
+        inputs.forEach { input ->
+            val data = input.toTwData()
+            TWDataVectorAdd(inputVector, data)
+            TWDataDelete(data)
+        }
+        val outputVector = TWAnySignerSignBatch(inputVector, coin.value, threads.toUInt())
+        TWDataVectorDelete(inputVector)
+        val outputs = List(inputs.size) { index ->
+            val data = TWDataVectorGet(outputVector, index.toULong())
+            val output = data.readTwBytes()!!
+            TWDataDelete(data)
+            output
+        }
+        TWDataVectorDelete(outputVector)
+        return outputs
+    }
 }
@@ -21,4 +21,8 @@ actual object AnySigner {
 
     actual fun plan(input: ByteArray, coin: CoinType): ByteArray =
         WalletCore.Instance.AnySigner.plan(input.asUInt8Array(), coin.jsValue).asByteArray()
+
+    actual fun signBatch(inputs: List<ByteArray>, coin: CoinType, threads: Int): List<ByteArray> =
+        WalletCore.Instance.AnySigner.signBatch(inputs.map { it.asUInt8Array() }.toTypedArray(), coin.jsValue, threads)
+            .map { it.asByteArray() }
 }
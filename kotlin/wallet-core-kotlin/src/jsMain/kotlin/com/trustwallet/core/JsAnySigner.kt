@@ -12,6 +12,7 @@ external class JsAnySigner {
     companion object {
         fun sign(data: UInt8Array, coin: JsCoinType): UInt8Array
         fun plan(data: UInt8Array, coin: JsCoinType): UInt8Array
+        fun signBatch(data: Array<UInt8Array>, coin: JsCoinType, threads: Int): Array<UInt8Array>
         fun supportsJSON(coin: JsCoinType): Boolean
     }
 }
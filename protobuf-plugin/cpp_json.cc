@@ -0,0 +1,289 @@
+#include <google/protobuf/compiler/code_generator.h>
+#include <google/protobuf/compiler/plugin.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/io/printer.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace google::protobuf;
+
+/// Generates C++ parsers of the proto3 JSON mapping for Protobuf messages, one per message type, reading with
+/// `TW::ProtoJson::Reader` (src/ProtoJson.h) instead of reflection.
+/// For `File.proto` it writes `File.json.pb.h` and `File.json.pb.cc`.
+class Generator : public compiler::CodeGenerator {
+    static std::string baseName(const std::string& proto_file) {
+        return proto_file.substr(0, proto_file.find_last_of("."));
+    }
+
+    static void replaceAll(std::string& string, const std::string& from, const std::string& to) {
+        for (size_t pos = 0; (pos = string.find(from, pos)) != std::string::npos; pos += to.size()) {
+            string.replace(pos, from.size(), to);
+        }
+    }
+
+    /// C++ namespace of the package, e.g. "TW::Ethereum::Proto".
+    static std::string cppNamespace(const FileDescriptor* file) {
+        auto ns = file->package();
+        replaceAll(ns, ".", "::");
+        return ns;
+    }
+
+    /// Unqualified C++ name of a message or enum: nested types are joined with '_'.
+    template <typename Descriptor>
+    static std::string cppName(const Descriptor* descriptor) {
+        auto name = descriptor->full_name().substr(descriptor->file()->package().size() + 1);
+        replaceAll(name, ".", "_");
+        return name;
+    }
+
+    template <typename Descriptor>
+    static std::string qualifiedName(const Descriptor* descriptor) {
+        return "::" + cppNamespace(descriptor->file()) + "::" + cppName(descriptor);
+    }
+
+    /// Name of the generated accessors of a field: lower case, with '_' appended to C++ keywords.
+    static std::string accessorName(const FieldDescriptor* field) {
+        static const std::set<std::string> keywords = {
+            "NULL", "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case",
+            "catch", "char", "class", "compl", "const", "constexpr", "const_cast", "continue", "decltype", "default",
+            "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float",
+            "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not",
+            "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+            "reinterpret_cast", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast",
+            "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid",
+            "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor",
+            "xor_eq",
+        };
+        auto name = field->name();
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (keywords.count(name) > 0) {
+            name += "_";
+        }
+        return name;
+    }
+
+    template <typename Descriptor>
+    static void collect(const Descriptor* scope, std::vector<const EnumDescriptor*>& enums, std::vector<const Descriptor*>& messages) {
+        for (int i = 0; i < scope->enum_type_count(); i += 1) {
+            enums.push_back(scope->enum_type(i));
+        }
+        for (int i = 0; i < scope->nested_type_count(); i += 1) {
+            // map entries have no generated class, map fields aren't parsed
+            if (scope->nested_type(i)->options().map_entry()) {
+                continue;
+            }
+            messages.push_back(scope->nested_type(i));
+            collect(scope->nested_type(i), enums, messages);
+        }
+    }
+
+    /// Printer indents by 2 spaces, the sources by 4.
+    static void indent(io::Printer& printer) {
+        printer.Indent();
+        printer.Indent();
+    }
+
+    static void outdent(io::Printer& printer) {
+        printer.Outdent();
+        printer.Outdent();
+    }
+
+    static void printHeader(io::Printer& printer) {
+        printer.Print(
+            "// Copyright © 2017-2023 Trust Wallet.\n"
+            "//\n"
+            "// This file is part of Trust. The full Trust copyright notice, including\n"
+            "// terms governing use, modification, and redistribution, is contained in the\n"
+            "// file LICENSE at the root of the source code distribution tree.\n"
+            "//\n"
+            "// This is a GENERATED FILE, changes made here WILL BE LOST.\n"
+            "\n"
+        );
+    }
+
+    /// Prints the statements reading one value of `field` into `message`, returning false on error.
+    static void printReadValue(io::Printer& printer, const FieldDescriptor* field, const std::string& name) {
+        std::map<std::string, std::string> vars = {{"name", name}};
+        const auto repeated = field->is_repeated();
+        const auto setter = repeated ? "add_" + name : "set_" + name;
+        const auto pointer = repeated ? "message.add_" + name + "()" : "message.mutable_" + name + "()";
+        vars["setter"] = setter;
+        vars["pointer"] = pointer;
+
+        std::string type;
+        std::string read;
+        switch (field->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_INT32: type = "int32_t"; read = "readInt32"; break;
+        case FieldDescriptor::CPPTYPE_INT64: type = "int64_t"; read = "readInt64"; break;
+        case FieldDescriptor::CPPTYPE_UINT32: type = "uint32_t"; read = "readUint32"; break;
+        case FieldDescriptor::CPPTYPE_UINT64: type = "uint64_t"; read = "readUint64"; break;
+        case FieldDescriptor::CPPTYPE_DOUBLE: type = "double"; read = "readDouble"; break;
+        case FieldDescriptor::CPPTYPE_FLOAT: type = "float"; read = "readFloat"; break;
+        case FieldDescriptor::CPPTYPE_BOOL: type = "bool"; read = "readBool"; break;
+        case FieldDescriptor::CPPTYPE_ENUM: type = qualifiedName(field->enum_type()); read = "readEnum"; break;
+        case FieldDescriptor::CPPTYPE_STRING:
+            vars["read"] = field->type() == FieldDescriptor::TYPE_BYTES ? "readBytes" : "readString";
+            printer.Print(vars, "if (!reader.$read$(*$pointer$)) {\n    return false;\n}\n");
+            return;
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+            printer.Print(vars, "if (!parseJson(reader, *$pointer$)) {\n    return false;\n}\n");
+            return;
+        }
+        vars["type"] = type;
+        vars["read"] = read;
+        printer.Print(vars,
+            "$type$ value{};\n"
+            "if (!reader.$read$(value)) {\n"
+            "    return false;\n"
+            "}\n"
+            "message.$setter$(value);\n"
+        );
+    }
+
+    static void printField(io::Printer& printer, const FieldDescriptor* field, bool first) {
+        std::map<std::string, std::string> vars = {
+            {"else", first ? "" : "} else "},
+            {"json_name", field->json_name()},
+            {"proto_name", field->name()},
+        };
+        if (field->json_name() == field->name()) {
+            printer.Print(vars, "$else$if (key == \"$json_name$\") {\n");
+        } else {
+            printer.Print(vars, "$else$if (key == \"$json_name$\" || key == \"$proto_name$\") {\n");
+        }
+        indent(printer);
+        const auto oneof = field->real_containing_oneof();
+        if (oneof != nullptr) {
+            // JsonStringToMessage rejects a second member of a oneof; a null member is left to it as well
+            auto name = oneof->name();
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+            auto notSet = oneof->name();
+            std::transform(notSet.begin(), notSet.end(), notSet.begin(), [](unsigned char c) { return std::toupper(c); });
+            printer.Print(
+                "if (message.$name$_case() != $type$::$not_set$_NOT_SET || reader.readNull()) {\n"
+                "    return reader.fail();\n"
+                "}\n",
+                "name", name, "type", cppName(field->containing_type()), "not_set", notSet);
+        } else {
+            // a null field keeps its default value
+            printer.Print(
+                "if (reader.readNull()) {\n"
+                "    continue;\n"
+                "}\n");
+        }
+        const auto unsupported = field->is_map() ||
+                                 (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+                                  field->message_type()->file()->package() == "google.protobuf");
+        if (unsupported) {
+            printer.Print("// not supported, left to JsonStringToMessage\nreturn reader.fail();\n");
+        } else if (field->is_repeated()) {
+            printer.Print("if (!reader.beginArray()) {\n    return false;\n}\nwhile (reader.nextElement()) {\n");
+            indent(printer);
+            printReadValue(printer, field, accessorName(field));
+            outdent(printer);
+            printer.Print("}\nif (!reader.ok()) {\n    return false;\n}\n");
+        } else {
+            printReadValue(printer, field, accessorName(field));
+        }
+        outdent(printer);
+    }
+
+    static void printMessageParser(io::Printer& printer, const Descriptor* message) {
+        printer.Print("bool parseJson(::TW::ProtoJson::Reader& reader, $type$& message) {\n", "type", cppName(message));
+        indent(printer);
+        printer.Print(
+            "if (!reader.beginObject()) {\n"
+            "    return false;\n"
+            "}\n"
+            "std::string_view key;\n"
+            "while (reader.nextKey(key)) {\n"
+        );
+        indent(printer);
+        for (int i = 0; i < message->field_count(); i += 1) {
+            printField(printer, message->field(i), i == 0);
+        }
+        if (message->field_count() > 0) {
+            printer.Print("} else {\n    return reader.fail();\n}\n");
+        } else {
+            printer.Print("return reader.fail();\n");
+        }
+        outdent(printer);
+        printer.Print("}\nreturn reader.ok();\n");
+        outdent(printer);
+        printer.Print("}\n\n");
+    }
+
+    static void printEnumParser(io::Printer& printer, const EnumDescriptor* enumType) {
+        printer.Print("bool parseJsonEnum(std::string_view name, $type$& value) {\n", "type", cppName(enumType));
+        indent(printer);
+        for (int i = 0; i < enumType->value_count(); i += 1) {
+            const auto enumValue = enumType->value(i);
+            printer.Print("if (name == \"$name$\") {\n    value = static_cast<$type$>($number$);\n    return true;\n}\n",
+                          "name", enumValue->name(), "type", cppName(enumType), "number", std::to_string(enumValue->number()));
+        }
+        printer.Print("return false;\n");
+        outdent(printer);
+        printer.Print("}\n\n");
+    }
+
+    bool Generate(const FileDescriptor* file, const std::string& parameter, compiler::GeneratorContext* generator_context, std::string* error) const {
+        const auto base = baseName(file->name());
+        std::vector<const EnumDescriptor*> enums;
+        std::vector<const Descriptor*> messages;
+        for (int i = 0; i < file->enum_type_count(); i += 1) {
+            enums.push_back(file->enum_type(i));
+        }
+        for (int i = 0; i < file->message_type_count(); i += 1) {
+            messages.push_back(file->message_type(i));
+            collect(file->message_type(i), enums, messages);
+        }
+
+        {
+            std::unique_ptr<io::ZeroCopyOutputStream> output(generator_context->Open(base + ".json.pb.h"));
+            io::Printer printer(output.get(), '$');
+            printHeader(printer);
+            printer.Print("#pragma once\n\n#include \"$base$.pb.h\"\n#include \"../ProtoJson.h\"\n\n#include <string_view>\n\n", "base", base);
+            printer.Print("namespace $ns$ {\n\n", "ns", cppNamespace(file));
+            for (const auto enumType : enums) {
+                printer.Print("bool parseJsonEnum(std::string_view name, $type$& value);\n", "type", cppName(enumType));
+            }
+            for (const auto message : messages) {
+                printer.Print("bool parseJson(::TW::ProtoJson::Reader& reader, $type$& message);\n", "type", cppName(message));
+            }
+            printer.Print("\n} // namespace $ns$\n", "ns", cppNamespace(file));
+        }
+
+        std::unique_ptr<io::ZeroCopyOutputStream> output(generator_context->Open(base + ".json.pb.cc"));
+        io::Printer printer(output.get(), '$');
+        printHeader(printer);
+        printer.Print("#include \"$base$.json.pb.h\"\n", "base", base);
+        for (int i = 0; i < file->dependency_count(); i += 1) {
+            const auto dependency = file->dependency(i);
+            if (dependency->package() != "google.protobuf") {
+                printer.Print("#include \"$base$.json.pb.h\"\n", "base", baseName(dependency->name()));
+            }
+        }
+        printer.Print("\nnamespace $ns$ {\n\n", "ns", cppNamespace(file));
+        for (const auto enumType : enums) {
+            printEnumParser(printer, enumType);
+        }
+        for (const auto message : messages) {
+            printMessageParser(printer, message);
+        }
+        printer.Print("} // namespace $ns$\n", "ns", cppNamespace(file));
+        return true;
+    }
+};
+
+int main(int argc, char* argv[]) {
+  Generator generator;
+  return compiler::PluginMain(argc, argv, &generator);
+}
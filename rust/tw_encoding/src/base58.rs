@@ -24,6 +24,22 @@ pub fn decode(input: &str, alphabet: &Alphabet) -> EncodingResult<Vec<u8>> {
         .map_err(EncodingError::from)
 }
 
+/// Encodes `input` into the beginning of `output`, returns the number of encoded characters.
+pub fn encode_into(input: &[u8], alphabet: &Alphabet, output: &mut [u8]) -> EncodingResult<usize> {
+    bs58::encode(input)
+        .with_alphabet(alphabet)
+        .into(output)
+        .map_err(|_| EncodingError::InvalidInput)
+}
+
+/// Decodes the base58 characters of `input` into the beginning of `output`, returns the number of decoded bytes.
+pub fn decode_into(input: &[u8], alphabet: &Alphabet, output: &mut [u8]) -> EncodingResult<usize> {
+    bs58::decode(input)
+        .with_alphabet(alphabet)
+        .into(output)
+        .map_err(EncodingError::from)
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -22,3 +22,38 @@ pub fn decode(data: &str, is_url: bool) -> EncodingResult<Vec<u8>> {
     }
     .map_err(|_| EncodingError::InvalidInput)
 }
+
+/// Encodes `data` into the beginning of `output`, which must be at least `encode_len(data.len())` long.
+/// Returns the number of encoded characters.
+pub fn encode_into(data: &[u8], is_url: bool, output: &mut [u8]) -> EncodingResult<usize> {
+    let encoding = if is_url {
+        &data_encoding::BASE64URL
+    } else {
+        &data_encoding::BASE64
+    };
+    let len = encoding.encode_len(data.len());
+    if output.len() < len {
+        return Err(EncodingError::InvalidInput);
+    }
+    encoding.encode_mut(data, &mut output[..len]);
+    Ok(len)
+}
+
+/// Decodes `data` into the beginning of `output`, which must be at least `decode_len(data.len())` long.
+/// Returns the number of decoded bytes.
+pub fn decode_into(data: &[u8], is_url: bool, output: &mut [u8]) -> EncodingResult<usize> {
+    let encoding = if is_url {
+        &data_encoding::BASE64URL
+    } else {
+        &data_encoding::BASE64
+    };
+    let len = encoding
+        .decode_len(data.len())
+        .map_err(|_| EncodingError::InvalidInput)?;
+    if output.len() < len {
+        return Err(EncodingError::InvalidInput);
+    }
+    encoding
+        .decode_mut(data, &mut output[..len])
+        .map_err(|_| EncodingError::InvalidInput)
+}
@@ -146,6 +146,60 @@ pub unsafe extern "C" fn decode_base58(
         .into()
 }
 
+/// Encodes `count` byte arrays as base58 in one call, writing the strings one after the other into `output`.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param inputs *non-null* array of `count` byte arrays, may be null if `count` is 0.
+/// \param input_lens *non-null* array of the `count` lengths of the `inputs` arrays.
+/// \param count the number of inputs.
+/// \param alphabet alphabet type.
+/// \param output *non-null* byte array of `output_len` bytes, the strings are not nul-terminated.
+/// \param output_len the length of the `output` array, `input_len * 138 / 100 + 1` per input is enough.
+/// \param offsets *non-null* array of `count + 1` entries, receiving the start of each string
+///                followed by the end of the last one.
+/// \return whether all the strings fit in `output`.
+#[no_mangle]
+pub unsafe extern "C" fn encode_base58_batch(
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    alphabet: Base58Alphabet,
+    output: *mut u8,
+    output_len: usize,
+    offsets: *mut usize,
+) -> bool {
+    let alphabet: &Alphabet = alphabet.into();
+    write_batch(inputs, input_lens, count, output, output_len, offsets, |input, out| {
+        base58::encode_into(input, alphabet, out).ok()
+    })
+}
+
+/// Decodes `count` base58 strings in one call, writing the bytes one after the other into `output`.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param inputs *non-null* array of `count` strings, not nul-terminated, may be null if `count` is 0.
+/// \param input_lens *non-null* array of the `count` lengths of the `inputs` strings.
+/// \param count the number of inputs.
+/// \param alphabet alphabet type.
+/// \param output *non-null* byte array of `output_len` bytes, the length of the strings is enough.
+/// \param output_len the length of the `output` array.
+/// \param offsets *non-null* array of `count + 1` entries, receiving the start of each decoded array
+///                followed by the end of the last one.
+/// \return whether all the strings are valid and fit in `output`.
+#[no_mangle]
+pub unsafe extern "C" fn decode_base58_batch(
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    alphabet: Base58Alphabet,
+    output: *mut u8,
+    output_len: usize,
+    offsets: *mut usize,
+) -> bool {
+    let alphabet: &Alphabet = alphabet.into();
+    write_batch(inputs, input_lens, count, output, output_len, offsets, |input, out| {
+        base58::decode_into(input, alphabet, out).ok()
+    })
+}
+
 /// Encodes the `data` data as a padded, base64 string.
 /// \param data *non-null* byte array.
 /// \param len - the length of the `data` array.
@@ -177,6 +231,116 @@ pub unsafe extern "C" fn decode_base64(data: *const c_char, is_url: bool) -> CBy
         .into()
 }
 
+/// Encodes the `data` data as a padded, base64 string into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param data *non-null* byte array.
+/// \param len the length of the `data` array.
+/// \param is_url whether to use the [URL safe alphabet](https://www.rfc-editor.org/rfc/rfc3548#section-4).
+/// \param output *non-null* byte array of `output_len` bytes, at least `(len + 2) / 3 * 4`. The string is not nul-terminated.
+/// \param output_len the length of the `output` array.
+/// \param written *non-null* pointer receiving the number of encoded characters.
+/// \return whether the string fits in `output`.
+#[no_mangle]
+pub unsafe extern "C" fn encode_base64_into(
+    data: *const u8,
+    len: usize,
+    is_url: bool,
+    output: *mut u8,
+    output_len: usize,
+    written: *mut usize,
+) -> bool {
+    let data = std::slice::from_raw_parts(data, len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    match base64::encode_into(data, is_url, output) {
+        Ok(size) => {
+            *written = size;
+            true
+        },
+        Err(_) => false,
+    }
+}
+
+/// Decodes the base64 `data` string into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param data *non-null* byte array of the base64 characters, not nul-terminated.
+/// \param len the length of the `data` array.
+/// \param is_url whether to use the [URL safe alphabet](https://www.rfc-editor.org/rfc/rfc3548#section-4).
+/// \param output *non-null* byte array of `output_len` bytes, at least `len / 4 * 3` (rounded up to a multiple of 3).
+/// \param output_len the length of the `output` array.
+/// \param written *non-null* pointer receiving the number of decoded bytes.
+/// \return whether `data` has been decoded successfully.
+#[no_mangle]
+pub unsafe extern "C" fn decode_base64_into(
+    data: *const u8,
+    len: usize,
+    is_url: bool,
+    output: *mut u8,
+    output_len: usize,
+    written: *mut usize,
+) -> bool {
+    let data = std::slice::from_raw_parts(data, len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    match base64::decode_into(data, is_url, output) {
+        Ok(size) => {
+            *written = size;
+            true
+        },
+        Err(_) => false,
+    }
+}
+
+/// Encodes `count` byte arrays as padded base64 in one call, writing the strings one after the other into `output`.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param inputs *non-null* array of `count` byte arrays, may be null if `count` is 0.
+/// \param input_lens *non-null* array of the `count` lengths of the `inputs` arrays.
+/// \param count the number of inputs.
+/// \param is_url whether to use the [URL safe alphabet](https://www.rfc-editor.org/rfc/rfc3548#section-4).
+/// \param output *non-null* byte array of `output_len` bytes, the strings are not nul-terminated.
+/// \param output_len the length of the `output` array, `(input_len + 2) / 3 * 4` per input.
+/// \param offsets *non-null* array of `count + 1` entries, receiving the start of each string
+///                followed by the end of the last one.
+/// \return whether all the strings fit in `output`.
+#[no_mangle]
+pub unsafe extern "C" fn encode_base64_batch(
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    is_url: bool,
+    output: *mut u8,
+    output_len: usize,
+    offsets: *mut usize,
+) -> bool {
+    write_batch(inputs, input_lens, count, output, output_len, offsets, |input, out| {
+        base64::encode_into(input, is_url, out).ok()
+    })
+}
+
+/// Decodes `count` base64 strings in one call, writing the bytes one after the other into `output`.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param inputs *non-null* array of `count` strings, not nul-terminated, may be null if `count` is 0.
+/// \param input_lens *non-null* array of the `count` lengths of the `inputs` strings.
+/// \param count the number of inputs.
+/// \param is_url whether to use the [URL safe alphabet](https://www.rfc-editor.org/rfc/rfc3548#section-4).
+/// \param output *non-null* byte array of `output_len` bytes, `input_len / 4 * 3` per input.
+/// \param output_len the length of the `output` array.
+/// \param offsets *non-null* array of `count + 1` entries, receiving the start of each decoded array
+///                followed by the end of the last one.
+/// \return whether all the strings are valid and fit in `output`.
+#[no_mangle]
+pub unsafe extern "C" fn decode_base64_batch(
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    is_url: bool,
+    output: *mut u8,
+    output_len: usize,
+    offsets: *mut usize,
+) -> bool {
+    write_batch(inputs, input_lens, count, output, output_len, offsets, |input, out| {
+        base64::decode_into(input, is_url, out).ok()
+    })
+}
+
 /// Decodes the hex `data` string.
 /// \param data *optional* C-compatible, nul-terminated string.
 /// \return C-compatible result with a C-compatible byte array.
@@ -216,3 +380,48 @@ fn get_alphabet(alphabet: *const c_char) -> Result<Option<String>, CEncodingCode
         .map(|alphabet| Some(alphabet.to_string()))
         .map_err(|_| CEncodingCode::InvalidAlphabet)
 }
+
+/// Writes the result of `write` for every input one after the other into `output`,
+/// recording where each one starts in `offsets`.
+/// `write` returns the number of bytes written at the beginning of the given buffer, or `None` on failure.
+unsafe fn write_batch<F>(
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    output: *mut u8,
+    output_len: usize,
+    offsets: *mut usize,
+    mut write: F,
+) -> bool
+where
+    F: FnMut(&[u8], &mut [u8]) -> Option<usize>,
+{
+    let offsets = std::slice::from_raw_parts_mut(offsets, count + 1);
+    if count == 0 {
+        offsets[0] = 0;
+        return true;
+    }
+    let inputs = std::slice::from_raw_parts(inputs, count);
+    let input_lens = std::slice::from_raw_parts(input_lens, count);
+    let output: &mut [u8] = if output_len == 0 {
+        &mut []
+    } else {
+        std::slice::from_raw_parts_mut(output, output_len)
+    };
+
+    let mut position = 0;
+    for (i, (input, input_len)) in inputs.iter().zip(input_lens).enumerate() {
+        offsets[i] = position;
+        let input = if *input_len == 0 {
+            &[]
+        } else {
+            std::slice::from_raw_parts(*input, *input_len)
+        };
+        match write(input, &mut output[position..]) {
+            Some(written) => position += written,
+            None => return false,
+        }
+    }
+    offsets[count] = position;
+    true
+}
@@ -5,7 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 use std::ffi::CString;
-use tw_encoding::ffi::{decode_base58, encode_base58, Base58Alphabet};
+use tw_encoding::ffi::{
+    decode_base58, decode_base58_batch, encode_base58, encode_base58_batch, Base58Alphabet,
+};
 
 #[test]
 fn test_base58_encode() {
@@ -30,3 +32,66 @@ fn test_base58_decode() {
     };
     assert_eq!(decoded, expected);
 }
+
+#[test]
+fn test_base58_batch() {
+    let inputs: [&[u8]; 3] = [b"Hello, world!", b"", b"\0\x01"];
+    let ptrs: Vec<*const u8> = inputs.iter().map(|input| input.as_ptr()).collect();
+    let lens: Vec<usize> = inputs.iter().map(|input| input.len()).collect();
+    let mut encoded = [0u8; 64];
+    let mut offsets = [0usize; 4];
+    let ok = unsafe {
+        encode_base58_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            inputs.len(),
+            Base58Alphabet::Bitcoin,
+            encoded.as_mut_ptr(),
+            encoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(offsets, [0, 18, 18, 20]);
+    assert_eq!(&encoded[..20], b"72k1xXWG59wUsYv7h212");
+
+    let strings: Vec<&[u8]> = offsets.windows(2).map(|w| &encoded[w[0]..w[1]]).collect();
+    let ptrs: Vec<*const u8> = strings.iter().map(|string| string.as_ptr()).collect();
+    let lens: Vec<usize> = strings.iter().map(|string| string.len()).collect();
+    let mut decoded = [0u8; 20];
+    let ok = unsafe {
+        decode_base58_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            strings.len(),
+            Base58Alphabet::Bitcoin,
+            decoded.as_mut_ptr(),
+            decoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(offsets, [0, 13, 13, 15]);
+    assert_eq!(&decoded[..15], b"Hello, world!\0\x01");
+}
+
+#[test]
+fn test_base58_batch_output_too_small() {
+    let input = b"Hello, world!";
+    let ptrs = [input.as_ptr()];
+    let lens = [input.len()];
+    let mut encoded = [0u8; 10];
+    let mut offsets = [0usize; 2];
+    let ok = unsafe {
+        encode_base58_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            1,
+            Base58Alphabet::Bitcoin,
+            encoded.as_mut_ptr(),
+            encoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(!ok);
+}
@@ -5,7 +5,10 @@
 // file LICENSE at the root of the source code distribution tree.
 
 use std::ffi::{CStr, CString};
-use tw_encoding::ffi::{decode_base64, encode_base64};
+use tw_encoding::ffi::{
+    decode_base64, decode_base64_batch, decode_base64_into, encode_base64, encode_base64_batch,
+    encode_base64_into,
+};
 
 #[test]
 fn test_encode_base64() {
@@ -55,3 +58,175 @@ fn test_decode_base64_invalid() {
     let res = unsafe { decode_base64(encoded_ptr, false) };
     assert!(res.is_err());
 }
+
+#[test]
+fn test_encode_base64_into() {
+    let mut output = [0u8; 16];
+    let mut written = 0;
+
+    let data = b"hello world";
+    let ok = unsafe {
+        encode_base64_into(
+            data.as_ptr(),
+            data.len(),
+            false,
+            output.as_mut_ptr(),
+            output.len(),
+            &mut written,
+        )
+    };
+    assert!(ok);
+    assert_eq!(&output[..written], b"aGVsbG8gd29ybGQ=");
+
+    let data = b"+'?ab";
+    let ok = unsafe {
+        encode_base64_into(
+            data.as_ptr(),
+            data.len(),
+            true,
+            output.as_mut_ptr(),
+            output.len(),
+            &mut written,
+        )
+    };
+    assert!(ok);
+    assert_eq!(&output[..written], b"Kyc_YWI=");
+
+    // too small an output
+    let data = b"hello world!";
+    let ok = unsafe {
+        encode_base64_into(
+            data.as_ptr(),
+            data.len(),
+            false,
+            output.as_mut_ptr(),
+            15,
+            &mut written,
+        )
+    };
+    assert!(!ok);
+}
+
+#[test]
+fn test_decode_base64_into() {
+    let mut output = [0xffu8; 12];
+    let mut written = 0;
+
+    let encoded = b"aGVsbG8gd29ybGQ=";
+    let ok = unsafe {
+        decode_base64_into(
+            encoded.as_ptr(),
+            encoded.len(),
+            false,
+            output.as_mut_ptr(),
+            output.len(),
+            &mut written,
+        )
+    };
+    assert!(ok);
+    assert_eq!(&output[..written], b"hello world");
+
+    let encoded = b"Kyc_YWI=";
+    let ok = unsafe {
+        decode_base64_into(
+            encoded.as_ptr(),
+            encoded.len(),
+            true,
+            output.as_mut_ptr(),
+            output.len(),
+            &mut written,
+        )
+    };
+    assert!(ok);
+    assert_eq!(&output[..written], b"+'?ab");
+
+    // too small an output
+    let encoded = b"aGVsbG8gd29ybGQh";
+    let ok = unsafe {
+        decode_base64_into(
+            encoded.as_ptr(),
+            encoded.len(),
+            false,
+            output.as_mut_ptr(),
+            output.len() - 1,
+            &mut written,
+        )
+    };
+    assert!(!ok);
+
+    let invalid = b"_This_is_an_invalid_base64_";
+    let ok = unsafe {
+        decode_base64_into(
+            invalid.as_ptr(),
+            invalid.len(),
+            false,
+            output.as_mut_ptr(),
+            output.len(),
+            &mut written,
+        )
+    };
+    assert!(!ok);
+}
+
+#[test]
+fn test_base64_batch() {
+    let inputs: [&[u8]; 3] = [b"hello world", b"", b"\xff\xfe"];
+    let ptrs: Vec<*const u8> = inputs.iter().map(|input| input.as_ptr()).collect();
+    let lens: Vec<usize> = inputs.iter().map(|input| input.len()).collect();
+    let mut encoded = [0u8; 20];
+    let mut offsets = [0usize; 4];
+    let ok = unsafe {
+        encode_base64_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            inputs.len(),
+            true,
+            encoded.as_mut_ptr(),
+            encoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(offsets, [0, 16, 16, 20]);
+    assert_eq!(&encoded, b"aGVsbG8gd29ybGQ=__4=");
+
+    let strings: Vec<&[u8]> = offsets.windows(2).map(|w| &encoded[w[0]..w[1]]).collect();
+    let ptrs: Vec<*const u8> = strings.iter().map(|string| string.as_ptr()).collect();
+    let lens: Vec<usize> = strings.iter().map(|string| string.len()).collect();
+    let mut decoded = [0u8; 15];
+    let ok = unsafe {
+        decode_base64_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            strings.len(),
+            true,
+            decoded.as_mut_ptr(),
+            decoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(offsets, [0, 11, 11, 13]);
+    assert_eq!(&decoded[..13], b"hello world\xff\xfe");
+}
+
+#[test]
+fn test_base64_batch_invalid() {
+    let input = b"!!!!";
+    let ptrs = [input.as_ptr()];
+    let lens = [input.len()];
+    let mut decoded = [0u8; 3];
+    let mut offsets = [0usize; 2];
+    let ok = unsafe {
+        decode_base64_batch(
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            1,
+            false,
+            decoded.as_mut_ptr(),
+            decoded.len(),
+            offsets.as_mut_ptr(),
+        )
+    };
+    assert!(!ok);
+}
@@ -12,3 +12,13 @@ pub fn blake_256(input: &[u8]) -> Vec<u8> {
     let result = &hasher.finalize()[..];
     result.to_vec()
 }
+
+pub fn blake_256_into(input: &[u8], output: &mut [u8]) -> bool {
+    if output.len() != Blake256::output_size() {
+        return false;
+    }
+    let mut hasher = Blake256::new();
+    hasher.update(input);
+    output.copy_from_slice(&hasher.finalize());
+    true
+}
@@ -27,3 +27,11 @@ pub fn blake2_b_personal(input: &[u8], hash_size: usize, personal_input: &[u8])
     blake2b.finalize(&mut output);
     output
 }
+
+pub fn blake2_b_into(input: &[u8], output: &mut [u8]) -> bool {
+    let Ok(mut hasher) = Blake2bVar::new(output.len()) else {
+        return false;
+    };
+    hasher.update(input);
+    hasher.finalize_variable(output).is_ok()
+}
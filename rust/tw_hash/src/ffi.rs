@@ -6,9 +6,71 @@
 
 #![allow(clippy::missing_safety_doc)]
 
+use crate::streaming::StreamHasher;
 use crate::{blake, blake2, groestl, hmac, ripemd, sha1, sha2, sha3};
 use tw_memory::ffi::c_byte_array::CByteArray;
 
+/// The hash functions supported by [`StreamHasher`].
+/// BLAKE2B is created separately by [`stream_hasher_new_blake2b`].
+#[repr(C)]
+pub enum CStreamHasherType {
+    Sha256 = 1,
+    Sha512 = 2,
+    Keccak256 = 3,
+    Blake256 = 4,
+    Groestl512 = 5,
+    Sha512_256 = 6,
+    Sha3_256 = 7,
+}
+
+/// The fixed-size hash functions supported by [`hash_batch_into`].
+#[repr(C)]
+pub enum CHashType {
+    Sha1 = 1,
+    Sha256 = 2,
+    Sha512 = 3,
+    Sha512_256 = 4,
+    Keccak256 = 5,
+    Keccak512 = 6,
+    Sha3_256 = 7,
+    Sha3_512 = 8,
+    Ripemd160 = 9,
+    Blake256 = 10,
+    Groestl512 = 11,
+}
+
+impl CHashType {
+    fn digest_size(&self) -> usize {
+        match self {
+            CHashType::Sha1 | CHashType::Ripemd160 => 20,
+            CHashType::Sha256
+            | CHashType::Sha512_256
+            | CHashType::Keccak256
+            | CHashType::Sha3_256
+            | CHashType::Blake256 => 32,
+            CHashType::Sha512 | CHashType::Keccak512 | CHashType::Sha3_512 | CHashType::Groestl512 => {
+                64
+            },
+        }
+    }
+
+    fn hash_into(&self, input: &[u8], output: &mut [u8]) -> bool {
+        match self {
+            CHashType::Sha1 => sha1::sha1_into(input, output),
+            CHashType::Sha256 => sha2::sha256_into(input, output),
+            CHashType::Sha512 => sha2::sha512_into(input, output),
+            CHashType::Sha512_256 => sha2::sha512_256_into(input, output),
+            CHashType::Keccak256 => sha3::keccak256_into(input, output),
+            CHashType::Keccak512 => sha3::keccak512_into(input, output),
+            CHashType::Sha3_256 => sha3::sha3_256_into(input, output),
+            CHashType::Sha3_512 => sha3::sha3_512_into(input, output),
+            CHashType::Ripemd160 => ripemd::ripemd_160_into(input, output),
+            CHashType::Blake256 => blake::blake_256_into(input, output),
+            CHashType::Groestl512 => groestl::groestl_512_into(input, output),
+        }
+    }
+}
+
 /// Computes the Blake-256 hash of the `input` byte array.
 /// \param input *non-null* byte array.
 /// \param input_len the length of the `input` array.
@@ -171,3 +233,374 @@ pub unsafe extern "C" fn sha3__512(input: *const u8, input_len: usize) -> CByteA
     let input = std::slice::from_raw_parts(input, input_len);
     sha3::sha3_512(input).into()
 }
+
+/// Computes the BLAKE2B hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, used as the output hash size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn blake2_b_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    blake2::blake2_b_into(input, output)
+}
+
+/// Computes the Blake-256 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn blake_256_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    blake::blake_256_into(input, output)
+}
+
+/// Computes the Groestl-512 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn groestl_512_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    groestl::groestl_512_into(input, output)
+}
+
+/// Computes the RIPEMD-160 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn ripemd_160_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    ripemd::ripemd_160_into(input, output)
+}
+
+/// Computes the SHA-1 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha1_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha1::sha1_into(input, output)
+}
+
+/// Computes the SHA-256 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha256_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha2::sha256_into(input, output)
+}
+
+/// Computes the SHA-512 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha512_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha2::sha512_into(input, output)
+}
+
+/// Computes the SHA-512/256 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha512_256_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha2::sha512_256_into(input, output)
+}
+
+/// Computes the Keccak-256 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn keccak256_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha3::keccak256_into(input, output)
+}
+
+/// Computes the Keccak-512 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn keccak512_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha3::keccak512_into(input, output)
+}
+
+/// Computes the SHA-3-256 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha3__256_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha3::sha3_256_into(input, output)
+}
+
+/// Computes the SHA-3-512 hash of the `input` byte array and writes it into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn sha3__512_into(
+    input: *const u8,
+    input_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let input = std::slice::from_raw_parts(input, input_len);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    sha3::sha3_512_into(input, output)
+}
+
+/// Hashes `count` byte arrays with the same hash function in one call,
+/// writing the digests one after the other into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+/// \param hash_type the hash function.
+/// \param inputs *non-null* array of `count` byte arrays, may be null if `count` is 0.
+/// \param input_lens *non-null* array of the `count` lengths of the `inputs` arrays.
+/// \param count the number of inputs.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to `count` times the digest size.
+/// \return whether the hashes have been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn hash_batch_into(
+    hash_type: CHashType,
+    inputs: *const *const u8,
+    input_lens: *const usize,
+    count: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let digest_size = hash_type.digest_size();
+    if count == 0 || output_len != count * digest_size {
+        return count == 0 && output_len == 0;
+    }
+    let inputs = std::slice::from_raw_parts(inputs, count);
+    let input_lens = std::slice::from_raw_parts(input_lens, count);
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    inputs
+        .iter()
+        .zip(input_lens)
+        .zip(output.chunks_exact_mut(digest_size))
+        .all(|((input, input_len), digest)| {
+            let input = if *input_len == 0 {
+                &[]
+            } else {
+                std::slice::from_raw_parts(*input, *input_len)
+            };
+            hash_type.hash_into(input, digest)
+        })
+}
+
+/// Creates a new incremental hasher.
+/// \param hasher_type the hash function.
+/// \return *non-null* pointer to the hasher, must be released by `stream_hasher_free`
+///         or consumed by `stream_hasher_finalize`/`stream_hasher_finalize_into`.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_new(hasher_type: CStreamHasherType) -> *mut StreamHasher {
+    let hasher = match hasher_type {
+        CStreamHasherType::Sha256 => StreamHasher::sha256(),
+        CStreamHasherType::Sha512 => StreamHasher::sha512(),
+        CStreamHasherType::Keccak256 => StreamHasher::keccak256(),
+        CStreamHasherType::Blake256 => StreamHasher::blake256(),
+        CStreamHasherType::Groestl512 => StreamHasher::groestl512(),
+        CStreamHasherType::Sha512_256 => StreamHasher::sha512_256(),
+        CStreamHasherType::Sha3_256 => StreamHasher::sha3_256(),
+    };
+    Box::into_raw(Box::new(hasher))
+}
+
+/// Creates a new incremental BLAKE2B hasher with an optional personalization.
+/// \param hash_size the size of the output hash, up to 64 bytes.
+/// \param personal_input *optional* byte array, up to 16 bytes.
+/// \param personal_len the length of the `personal_input` array.
+/// \return *nullable* pointer to the hasher, null if the parameters are invalid.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_new_blake2b(
+    hash_size: usize,
+    personal_input: *const u8,
+    personal_len: usize,
+) -> *mut StreamHasher {
+    let personal = if personal_input.is_null() || personal_len == 0 {
+        &[]
+    } else {
+        std::slice::from_raw_parts(personal_input, personal_len)
+    };
+    match StreamHasher::blake2b(hash_size, personal) {
+        Some(hasher) => Box::into_raw(Box::new(hasher)),
+        None => std::ptr::null_mut(),
+    }
+}
+
+/// Clones the current state of the hasher, e.g. to reuse a common prefix (midstate).
+/// \param hasher *non-null* pointer to the hasher.
+/// \return *non-null* pointer to the new hasher.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_clone(hasher: *const StreamHasher) -> *mut StreamHasher {
+    Box::into_raw(Box::new((*hasher).clone()))
+}
+
+/// Feeds the `input` byte array into the hasher.
+/// \param hasher *non-null* pointer to the hasher.
+/// \param input *non-null* byte array.
+/// \param input_len the length of the `input` array.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_update(
+    hasher: *mut StreamHasher,
+    input: *const u8,
+    input_len: usize,
+) {
+    let input = std::slice::from_raw_parts(input, input_len);
+    (*hasher).update(input);
+}
+
+/// Returns the size of the digest produced by the hasher.
+/// \param hasher *non-null* pointer to the hasher.
+/// \return the digest size in bytes.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_output_size(hasher: *const StreamHasher) -> usize {
+    (*hasher).output_size()
+}
+
+/// Consumes and releases the hasher, returning the digest.
+/// \param hasher *non-null* pointer to the hasher, must not be used afterwards.
+/// \return C-compatible byte array.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_finalize(hasher: *mut StreamHasher) -> CByteArray {
+    Box::from_raw(hasher).finalize().into()
+}
+
+/// Consumes and releases the hasher, writing the digest into the `output` buffer.
+/// \param hasher *non-null* pointer to the hasher, must not be used afterwards.
+/// \param output *non-null* byte array of `output_len` bytes.
+/// \param output_len the length of the `output` array, must be equal to the digest size.
+/// \return whether the hash has been written successfully.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_finalize_into(
+    hasher: *mut StreamHasher,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let output = std::slice::from_raw_parts_mut(output, output_len);
+    Box::from_raw(hasher).finalize_into(output)
+}
+
+/// Releases the hasher without computing the digest.
+/// \param hasher *nullable* pointer to the hasher.
+#[no_mangle]
+pub unsafe extern "C" fn stream_hasher_free(hasher: *mut StreamHasher) {
+    if hasher.is_null() {
+        return;
+    }
+    let _ = Box::from_raw(hasher);
+}
@@ -4,9 +4,13 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-use crate::hash_wrapper::hasher;
+use crate::hash_wrapper::{hasher, hasher_into};
 use groestl::Groestl512;
 
 pub fn groestl_512(input: &[u8]) -> Vec<u8> {
     hasher::<Groestl512>(input)
 }
+
+pub fn groestl_512_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Groestl512>(input, output)
+}
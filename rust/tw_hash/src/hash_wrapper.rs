@@ -12,3 +12,15 @@ pub fn hasher<D: Digest>(input: &[u8]) -> Vec<u8> {
     let result = &hasher.finalize()[..];
     result.to_vec()
 }
+
+/// Computes the hash of the `input` and writes it into the `output` buffer without allocating.
+/// Returns `false` if the `output` length doesn't match the digest size.
+pub fn hasher_into<D: Digest>(input: &[u8], output: &mut [u8]) -> bool {
+    if output.len() != <D as Digest>::output_size() {
+        return false;
+    }
+    let mut hasher = D::new();
+    hasher.update(input);
+    output.copy_from_slice(&hasher.finalize());
+    true
+}
@@ -13,5 +13,6 @@ pub mod ripemd;
 pub mod sha1;
 pub mod sha2;
 pub mod sha3;
+pub mod streaming;
 
 mod hash_wrapper;
@@ -4,9 +4,13 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-use crate::hash_wrapper::hasher;
+use crate::hash_wrapper::{hasher, hasher_into};
 use ripemd::Ripemd160;
 
 pub fn ripemd_160(input: &[u8]) -> Vec<u8> {
     hasher::<Ripemd160>(input)
 }
+
+pub fn ripemd_160_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Ripemd160>(input, output)
+}
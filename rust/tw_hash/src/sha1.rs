@@ -4,9 +4,13 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-use crate::hash_wrapper::hasher;
+use crate::hash_wrapper::{hasher, hasher_into};
 use sha1::Sha1;
 
 pub fn sha1(input: &[u8]) -> Vec<u8> {
     hasher::<Sha1>(input)
 }
+
+pub fn sha1_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha1>(input, output)
+}
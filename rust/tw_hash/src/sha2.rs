@@ -4,7 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-use crate::hash_wrapper::hasher;
+use crate::hash_wrapper::{hasher, hasher_into};
 use sha2::{Sha256, Sha512, Sha512_256};
 
 pub fn sha256(input: &[u8]) -> Vec<u8> {
@@ -18,3 +18,15 @@ pub fn sha512(input: &[u8]) -> Vec<u8> {
 pub fn sha512_256(input: &[u8]) -> Vec<u8> {
     hasher::<Sha512_256>(input)
 }
+
+pub fn sha256_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha256>(input, output)
+}
+
+pub fn sha512_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha512>(input, output)
+}
+
+pub fn sha512_256_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha512_256>(input, output)
+}
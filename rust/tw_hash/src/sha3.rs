@@ -4,7 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-use crate::hash_wrapper::hasher;
+use crate::hash_wrapper::{hasher, hasher_into};
 use sha3::{Keccak256, Keccak512, Sha3_256, Sha3_512};
 
 pub fn keccak256(input: &[u8]) -> Vec<u8> {
@@ -22,3 +22,19 @@ pub fn sha3_256(input: &[u8]) -> Vec<u8> {
 pub fn sha3_512(input: &[u8]) -> Vec<u8> {
     hasher::<Sha3_512>(input)
 }
+
+pub fn keccak256_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Keccak256>(input, output)
+}
+
+pub fn keccak512_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Keccak512>(input, output)
+}
+
+pub fn sha3_256_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha3_256>(input, output)
+}
+
+pub fn sha3_512_into(input: &[u8], output: &mut [u8]) -> bool {
+    hasher_into::<Sha3_512>(input, output)
+}
@@ -0,0 +1,140 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+use blake2b_ref::{Blake2b, Blake2bBuilder};
+use blake_hash::Blake256;
+use groestl::Groestl512;
+use sha2::{Sha256, Sha512, Sha512_256};
+use sha3::{Keccak256, Sha3_256};
+
+/// The maximum output size of the BLAKE2B hash.
+pub const BLAKE2B_MAX_HASH_SIZE: usize = 64;
+/// The maximum length of the BLAKE2B personalization.
+pub const BLAKE2B_PERSONAL_SIZE: usize = 16;
+
+/// An incremental (init/update/finalize) hasher.
+/// Allows to feed the input in chunks instead of concatenating it into a single buffer first.
+#[derive(Clone)]
+pub enum StreamHasher {
+    Sha256(Sha256),
+    Sha512(Sha512),
+    Sha512_256(Sha512_256),
+    Keccak256(Keccak256),
+    Sha3_256(Sha3_256),
+    Blake256(Blake256),
+    Groestl512(Groestl512),
+    Blake2b { hasher: Blake2b, hash_size: usize },
+}
+
+impl StreamHasher {
+    pub fn sha256() -> StreamHasher {
+        StreamHasher::Sha256(sha2::Digest::new())
+    }
+
+    pub fn sha512() -> StreamHasher {
+        StreamHasher::Sha512(sha2::Digest::new())
+    }
+
+    pub fn sha512_256() -> StreamHasher {
+        StreamHasher::Sha512_256(sha2::Digest::new())
+    }
+
+    pub fn keccak256() -> StreamHasher {
+        StreamHasher::Keccak256(sha3::Digest::new())
+    }
+
+    pub fn sha3_256() -> StreamHasher {
+        StreamHasher::Sha3_256(sha3::Digest::new())
+    }
+
+    pub fn blake256() -> StreamHasher {
+        StreamHasher::Blake256(blake_hash::Digest::new())
+    }
+
+    pub fn groestl512() -> StreamHasher {
+        StreamHasher::Groestl512(groestl::Digest::new())
+    }
+
+    /// Returns `None` if `hash_size` or `personal` have an invalid length.
+    pub fn blake2b(hash_size: usize, personal: &[u8]) -> Option<StreamHasher> {
+        if hash_size == 0
+            || hash_size > BLAKE2B_MAX_HASH_SIZE
+            || personal.len() > BLAKE2B_PERSONAL_SIZE
+        {
+            return None;
+        }
+        let mut builder = Blake2bBuilder::new(hash_size);
+        if !personal.is_empty() {
+            builder = builder.personal(personal);
+        }
+        Some(StreamHasher::Blake2b {
+            hasher: builder.build(),
+            hash_size,
+        })
+    }
+
+    /// Returns the size of the resulting digest.
+    pub fn output_size(&self) -> usize {
+        match self {
+            StreamHasher::Sha256(_)
+            | StreamHasher::Sha512_256(_)
+            | StreamHasher::Keccak256(_)
+            | StreamHasher::Sha3_256(_)
+            | StreamHasher::Blake256(_) => 32,
+            StreamHasher::Sha512(_) | StreamHasher::Groestl512(_) => 64,
+            StreamHasher::Blake2b { hash_size, .. } => *hash_size,
+        }
+    }
+
+    pub fn update(&mut self, input: &[u8]) {
+        match self {
+            StreamHasher::Sha256(hasher) => sha2::Digest::update(hasher, input),
+            StreamHasher::Sha512(hasher) => sha2::Digest::update(hasher, input),
+            StreamHasher::Sha512_256(hasher) => sha2::Digest::update(hasher, input),
+            StreamHasher::Keccak256(hasher) => sha3::Digest::update(hasher, input),
+            StreamHasher::Sha3_256(hasher) => sha3::Digest::update(hasher, input),
+            StreamHasher::Blake256(hasher) => blake_hash::Digest::update(hasher, input),
+            StreamHasher::Groestl512(hasher) => groestl::Digest::update(hasher, input),
+            StreamHasher::Blake2b { hasher, .. } => hasher.update(input),
+        }
+    }
+
+    /// Consumes the hasher and writes the digest into the `output` buffer.
+    /// Returns `false` if the `output` length doesn't match [`StreamHasher::output_size`].
+    pub fn finalize_into(self, output: &mut [u8]) -> bool {
+        if output.len() != self.output_size() {
+            return false;
+        }
+        match self {
+            StreamHasher::Sha256(hasher) => output.copy_from_slice(&sha2::Digest::finalize(hasher)),
+            StreamHasher::Sha512(hasher) => output.copy_from_slice(&sha2::Digest::finalize(hasher)),
+            StreamHasher::Sha512_256(hasher) => {
+                output.copy_from_slice(&sha2::Digest::finalize(hasher))
+            },
+            StreamHasher::Keccak256(hasher) => {
+                output.copy_from_slice(&sha3::Digest::finalize(hasher))
+            },
+            StreamHasher::Sha3_256(hasher) => {
+                output.copy_from_slice(&sha3::Digest::finalize(hasher))
+            },
+            StreamHasher::Blake256(hasher) => {
+                output.copy_from_slice(&blake_hash::Digest::finalize(hasher))
+            },
+            StreamHasher::Groestl512(hasher) => {
+                output.copy_from_slice(&groestl::Digest::finalize(hasher))
+            },
+            StreamHasher::Blake2b { hasher, .. } => hasher.finalize(output),
+        }
+        true
+    }
+
+    /// Consumes the hasher and returns the digest.
+    pub fn finalize(self) -> Vec<u8> {
+        let mut output = vec![0; self.output_size()];
+        self.finalize_into(&mut output);
+        output
+    }
+}
@@ -5,12 +5,14 @@
 // file LICENSE at the root of the source code distribution tree.
 
 use tw_hash::ffi::{
-    blake2_b, blake2_b_personal, blake_256, groestl_512, hmac__sha256, keccak256, keccak512,
-    ripemd_160, sha1, sha256, sha3__256, sha3__512, sha512, sha512_256,
+    blake2_b, blake2_b_into, blake2_b_personal, blake_256, groestl_512, hash_batch_into,
+    hmac__sha256, keccak256, keccak256_into, keccak512, ripemd_160, ripemd_160_into, sha1, sha256,
+    sha256_into, sha3__256, sha3__512, sha512, sha512_256, CHashType,
 };
 use tw_memory::ffi::c_byte_array::CByteArray;
 
 type ExternFn = unsafe extern "C" fn(*const u8, usize) -> CByteArray;
+type ExternIntoFn = unsafe extern "C" fn(*const u8, usize, *mut u8, usize) -> bool;
 
 #[track_caller]
 pub fn test_hash_helper(hash: ExternFn, input: &[u8], expected: &str) {
@@ -18,6 +20,14 @@ pub fn test_hash_helper(hash: ExternFn, input: &[u8], expected: &str) {
     assert_eq!(hex::encode(decoded), expected);
 }
 
+#[track_caller]
+pub fn test_hash_into_helper<const N: usize>(hash: ExternIntoFn, input: &[u8], expected: &str) {
+    let mut output = [0u8; N];
+    let ok = unsafe { hash(input.as_ptr(), input.len(), output.as_mut_ptr(), output.len()) };
+    assert!(ok);
+    assert_eq!(hex::encode(output), expected);
+}
+
 #[test]
 fn test_blake2b() {
     const HASH_SIZE: usize = 64;
@@ -210,3 +220,72 @@ fn test_sha3_512() {
         "01dedd5de4ef14642445ba5f5b97c15e47b9ad931326e4b0727cd94cefc44fff23f07bf543139939b49128caf436dc1bdee54fcb24023a08d9403f9b4bf0d450",
     );
 }
+
+#[test]
+fn test_hash_into() {
+    test_hash_into_helper::<32>(
+        sha256_into,
+        b"hello world",
+        "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9",
+    );
+    test_hash_into_helper::<32>(
+        keccak256_into,
+        b"hello world",
+        "47173285a8d7341e5e972fc677286384f802f8ef42a5ec5f03bbfa254cb01fad",
+    );
+    test_hash_into_helper::<20>(
+        ripemd_160_into,
+        b"hello world",
+        "98c615784ccb5fe5936fbc0cbe9dfdb408d92f0f",
+    );
+    test_hash_into_helper::<64>(blake2_b_into, b"Hello world", "6ff843ba685842aa82031d3f53c48b66326df7639a63d128974c5c14f31a0f33343a8c65551134ed1ae0f2b0dd2bb495dc81039e3eeb0aa1bb0388bbeac29183");
+}
+
+#[test]
+fn test_hash_into_invalid_output_len() {
+    let input = b"hello world";
+    let mut output = [0u8; 20];
+    let ok = unsafe { sha256_into(input.as_ptr(), input.len(), output.as_mut_ptr(), output.len()) };
+    assert!(!ok);
+    assert_eq!(output, [0u8; 20]);
+}
+
+#[test]
+fn test_hash_batch_into() {
+    let inputs: [&[u8]; 2] = [b"hello world", b""];
+    let ptrs: Vec<*const u8> = inputs.iter().map(|input| input.as_ptr()).collect();
+    let lens: Vec<usize> = inputs.iter().map(|input| input.len()).collect();
+    let mut output = [0u8; 64];
+    let ok = unsafe {
+        hash_batch_into(
+            CHashType::Sha256,
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            inputs.len(),
+            output.as_mut_ptr(),
+            output.len(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(
+        hex::encode(&output[..32]),
+        "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9"
+    );
+    assert_eq!(
+        hex::encode(&output[32..]),
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"
+    );
+
+    // the output must hold exactly one digest per input
+    let ok = unsafe {
+        hash_batch_into(
+            CHashType::Sha256,
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            inputs.len(),
+            output.as_mut_ptr(),
+            32,
+        )
+    };
+    assert!(!ok);
+}
@@ -0,0 +1,77 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+use tw_hash::ffi::{
+    stream_hasher_clone, stream_hasher_finalize, stream_hasher_free, stream_hasher_new,
+    stream_hasher_new_blake2b, stream_hasher_update, CStreamHasherType,
+};
+use tw_hash::streaming::StreamHasher;
+
+#[test]
+fn test_stream_hasher_chunks() {
+    let mut hasher = StreamHasher::sha256();
+    hasher.update(b"hello");
+    hasher.update(b" ");
+    hasher.update(b"world");
+    assert_eq!(
+        hex::encode(hasher.finalize()),
+        "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9"
+    );
+
+    let mut hasher = StreamHasher::keccak256();
+    hasher.update(b"The quick brown fox ");
+    hasher.update(b"jumps over the lazy dog");
+    assert_eq!(
+        hex::encode(hasher.finalize()),
+        "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15"
+    );
+
+    let mut hasher = StreamHasher::sha512_256();
+    hasher.update(b"hello");
+    hasher.update(b" world");
+    assert_eq!(hasher.finalize(), tw_hash::sha2::sha512_256(b"hello world"));
+
+    let mut hasher = StreamHasher::sha3_256();
+    hasher.update(b"hello");
+    hasher.update(b" world");
+    assert_eq!(hasher.finalize(), tw_hash::sha3::sha3_256(b"hello world"));
+}
+
+#[test]
+fn test_stream_hasher_blake2b_personal() {
+    let mut hasher = StreamHasher::blake2b(32, b"MyApp Files Hash").unwrap();
+    hasher.update(b"the same ");
+    hasher.update(b"content");
+    assert_eq!(
+        hex::encode(hasher.finalize()),
+        "20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4"
+    );
+
+    assert!(StreamHasher::blake2b(65, &[]).is_none());
+    assert!(StreamHasher::blake2b(32, &[0; 17]).is_none());
+}
+
+#[test]
+fn test_stream_hasher_ffi_clone() {
+    unsafe {
+        let hasher = stream_hasher_new(CStreamHasherType::Blake256);
+        let prefix = b"The quick brown fox ";
+        stream_hasher_update(hasher, prefix.as_ptr(), prefix.len());
+
+        let cloned = stream_hasher_clone(hasher);
+        let suffix = b"jumps over the lazy dog";
+        stream_hasher_update(cloned, suffix.as_ptr(), suffix.len());
+        let actual = stream_hasher_finalize(cloned).into_vec();
+        assert_eq!(
+            hex::encode(actual),
+            "7576698ee9cad30173080678e5965916adbb11cb5245d386bf1ffda1cb26c9d7"
+        );
+        stream_hasher_free(hasher);
+
+        let invalid = stream_hasher_new_blake2b(0, std::ptr::null(), 0);
+        assert!(invalid.is_null());
+    }
+}
@@ -10,12 +10,18 @@ use der::{Decode, Reader};
 
 /// The standard binary signature representation length.
 /// RS, where R - 32 byte array, S - 32 byte array.
-const SIGNATURE_LENGTH: usize = 64;
+pub const SIGNATURE_LENGTH: usize = 64;
 const R_LENGTH: usize = 32;
 const S_LENGTH: usize = 32;
 
 pub type SignatureBytes = [u8; SIGNATURE_LENGTH];
 
+/// The maximum length of a DER-encoded signature with 32-byte `r` and `s`.
+pub const MAX_DER_LENGTH: usize = 72;
+
+const TAG_SEQUENCE: u8 = 0x30;
+const TAG_INTEGER: u8 = 0x02;
+
 /// ASN.1 DER-encoded signature as specified in [RFC5912 Appendix A]:
 ///
 /// ```text
@@ -81,6 +87,35 @@ impl Signature {
     pub fn to_vec(&self) -> Vec<u8> {
         self.to_bytes().to_vec()
     }
+
+    /// Encodes the signature as canonical DER into the `output` buffer, without allocating.
+    /// Returns the encoded length.
+    pub fn to_der_into(&self, output: &mut [u8; MAX_DER_LENGTH]) -> usize {
+        let mut pos = 2;
+        pos += write_uint(&self.r, &mut output[pos..]);
+        pos += write_uint(&self.s, &mut output[pos..]);
+        output[0] = TAG_SEQUENCE;
+        output[1] = (pos - 2) as u8;
+        pos
+    }
+}
+
+/// Writes a big-endian unsigned value as a minimal non-negative DER INTEGER.
+/// Returns the encoded length.
+fn write_uint(value: &[u8], output: &mut [u8]) -> usize {
+    let skip = value[..value.len() - 1]
+        .iter()
+        .take_while(|byte| **byte == 0)
+        .count();
+    let value = &value[skip..];
+    let padding = usize::from(value[0] & 0x80 != 0);
+    let len = padding + value.len();
+
+    output[0] = TAG_INTEGER;
+    output[1] = len as u8;
+    output[2] = 0;
+    output[2 + padding..2 + len].copy_from_slice(value);
+    2 + len
 }
 
 /// Decode the `r` and `s` components of a DER-encoded ECDSA signature.
@@ -145,6 +180,22 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_ecdsa_signature_to_der() {
+        #[track_caller]
+        fn test_impl(encoded: &str) {
+            let encoded_bytes = hex::decode(encoded).unwrap();
+            let sign = Signature::from_bytes(&encoded_bytes).unwrap();
+            let mut output = [0; MAX_DER_LENGTH];
+            let len = sign.to_der_into(&mut output);
+            assert_eq!(hex::encode(&output[..len], false), encoded);
+        }
+
+        test_impl("3046022100db421231f23d0320dbb8f1284b600cd34b8e9218628139539ff4f1f6c05495da022100ff715aab70d5317dbf8ee224eb18bec3120cfb9db1000dbb31eadaf96c71c1b1");
+        test_impl("303d021d00f23d0320dbb8f1284b600cd34b8e9218628139539ff4f1f600000000021c70d5317dbf8ee224eb18bec3120cfb9db1000dbb31eadaf900000000");
+        test_impl("3006020110020110");
+    }
+
     #[test]
     fn test_parse_ecdsa_signature_invalid() {
         #[track_caller]
@@ -43,3 +43,31 @@ pub unsafe extern "C" fn ecdsa_signature_from_asn_der(
         .map_err(|_| CKeyPairError::InvalidSignature)
         .into()
 }
+
+/// Parses the given ECDSA signature from ASN.1 DER encoded bytes and writes `r` and `s` into the `output` buffer.
+/// No memory is allocated, so the result doesn't need to be released.
+///
+/// \param encoded *non-null* byte array.
+/// \param encoded_len the length of the `encoded` array.
+/// \param output *non-null* buffer of 64 bytes.
+/// \param output_len the length of the `output` buffer, must be 64.
+/// \return true if the signature is valid DER and `output_len` is 64.
+#[no_mangle]
+pub unsafe extern "C" fn ecdsa_signature_from_asn_der_into(
+    encoded: *const u8,
+    encoded_len: usize,
+    output: *mut u8,
+    output_len: usize,
+) -> bool {
+    let Some(encoded) = CByteArrayRef::new(encoded, encoded_len).as_slice() else {
+        return false;
+    };
+    if output.is_null() || output_len != der::SIGNATURE_LENGTH {
+        return false;
+    }
+    let Ok(sign) = der::Signature::from_bytes(encoded) else {
+        return false;
+    };
+    std::slice::from_raw_parts_mut(output, output_len).copy_from_slice(&sign.to_bytes());
+    true
+}
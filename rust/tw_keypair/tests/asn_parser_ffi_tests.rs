@@ -5,7 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 use tw_encoding::hex;
-use tw_keypair::ffi::asn::ecdsa_signature_from_asn_der;
+use tw_keypair::ffi::asn::{ecdsa_signature_from_asn_der, ecdsa_signature_from_asn_der_into};
 use tw_memory::ffi::c_byte_array::CByteArray;
 
 #[test]
@@ -30,3 +30,32 @@ fn test_ecdsa_signature_from_asn_der_invalid() {
     let res = unsafe { ecdsa_signature_from_asn_der(encoded.data(), encoded.size()) };
     assert!(res.is_err());
 }
+
+#[test]
+fn test_ecdsa_signature_from_asn_der_into() {
+    let encoded = hex::decode("3046022100db421231f23d0320dbb8f1284b600cd34b8e9218628139539ff4f1f6c05495da022100ff715aab70d5317dbf8ee224eb18bec3120cfb9db1000dbb31eadaf96c71c1b1").unwrap();
+    let expected = "db421231f23d0320dbb8f1284b600cd34b8e9218628139539ff4f1f6c05495daff715aab70d5317dbf8ee224eb18bec3120cfb9db1000dbb31eadaf96c71c1b1";
+
+    let mut output = [0u8; 64];
+    let ok = unsafe {
+        ecdsa_signature_from_asn_der_into(
+            encoded.as_ptr(),
+            encoded.len(),
+            output.as_mut_ptr(),
+            output.len(),
+        )
+    };
+    assert!(ok);
+    assert_eq!(hex::encode(output, false), expected);
+
+    let mut short_output = [0u8; 32];
+    let ok = unsafe {
+        ecdsa_signature_from_asn_der_into(
+            encoded.as_ptr(),
+            encoded.len(),
+            short_output.as_mut_ptr(),
+            short_output.len(),
+        )
+    };
+    assert!(!ok);
+}
@@ -8,6 +8,7 @@
 
 use crate::key_pair;
 use std::ffi::{c_char, CStr};
+use tw_memory::ffi::c_byte_array::{CByteArray, CByteArrayResult};
 use tw_memory::ffi::c_result::{CBoolResult, CStrResult, ErrorCode};
 
 #[repr(C)]
@@ -95,3 +96,52 @@ pub unsafe extern "C" fn starknet_verify(
         .map_err(CStarknetCode::from)
         .into()
 }
+
+/// Signs the 32-byte hashes in `hashes` (concatenated) with the given 32-byte `priv_key`,
+/// without hex encoding. Returns the signatures compatible with StarkNet, 64 bytes each (`r || s`), concatenated.
+/// \param priv_key *non-null* byte array.
+/// \param priv_key_len the length of the `priv_key` array.
+/// \param hashes *non-null* byte array.
+/// \param hashes_len the length of the `hashes` array, a multiple of 32.
+/// \return C-compatible byte array.
+#[no_mangle]
+pub unsafe extern "C" fn starknet_sign_batch(
+    priv_key: *const u8,
+    priv_key_len: usize,
+    hashes: *const u8,
+    hashes_len: usize,
+) -> CByteArrayResult {
+    let priv_key = std::slice::from_raw_parts(priv_key, priv_key_len);
+    let hashes = std::slice::from_raw_parts(hashes, hashes_len);
+    key_pair::starknet_sign_batch(priv_key, hashes)
+        .map(CByteArray::from)
+        .map_err(CStarknetCode::from)
+        .into()
+}
+
+/// Verifies the signatures in `signatures` (64 bytes each, `r || s`, concatenated) over the 32-byte hashes
+/// in `hashes` (concatenated) given a StarkNet `pub_key`, without hex encoding.
+/// \param pub_key *non-null* byte array.
+/// \param pub_key_len the length of the `pub_key` array.
+/// \param hashes *non-null* byte array.
+/// \param hashes_len the length of the `hashes` array, a multiple of 32.
+/// \param signatures *non-null* byte array.
+/// \param signatures_len the length of the `signatures` array, twice `hashes_len`.
+/// \return C-compatible byte array, one byte per signature: 1 if it is valid, 0 otherwise.
+#[no_mangle]
+pub unsafe extern "C" fn starknet_verify_batch(
+    pub_key: *const u8,
+    pub_key_len: usize,
+    hashes: *const u8,
+    hashes_len: usize,
+    signatures: *const u8,
+    signatures_len: usize,
+) -> CByteArrayResult {
+    let pub_key = std::slice::from_raw_parts(pub_key, pub_key_len);
+    let hashes = std::slice::from_raw_parts(hashes, hashes_len);
+    let signatures = std::slice::from_raw_parts(signatures, signatures_len);
+    key_pair::starknet_verify_batch(pub_key, hashes, signatures)
+        .map(CByteArray::from)
+        .map_err(CStarknetCode::from)
+        .into()
+}
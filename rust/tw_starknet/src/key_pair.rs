@@ -50,14 +50,61 @@ pub fn starknet_verify(pub_key: &str, hash: &str, r: &str, s: &str) -> Result<bo
     Ok(verify(&pub_key, &hash, &r, &s).unwrap_or_default())
 }
 
+/// Size of a field element in bytes.
+pub const FIELD_ELEMENT_SIZE: usize = 32;
+/// Size of a raw signature in bytes: `r` followed by `s`.
+pub const SIGNATURE_SIZE: usize = 2 * FIELD_ELEMENT_SIZE;
+
+/// Signs each of the 32-byte `hashes` (concatenated) with `priv_key`.
+/// Returns the raw signatures (`r || s`, 64 bytes each) in the same order, concatenated.
+pub fn starknet_sign_batch(priv_key: &[u8], hashes: &[u8]) -> Result<Vec<u8>> {
+    if hashes.len() % FIELD_ELEMENT_SIZE != 0 {
+        return Err(StarknetKeyPairError::InvalidLength);
+    }
+    let private_key = field_element_from_be_bytes(priv_key)?;
+
+    let mut signatures = Vec::with_capacity(hashes.len() * 2);
+    for hash in hashes.chunks_exact(FIELD_ELEMENT_SIZE) {
+        let hash = field_element_from_be_bytes(hash)?;
+        let signature = ecdsa_sign(&private_key, &hash)?;
+        signatures.extend_from_slice(&signature.r.to_bytes_be());
+        signatures.extend_from_slice(&signature.s.to_bytes_be());
+    }
+    Ok(signatures)
+}
+
+/// Verifies each of the raw `signatures` (`r || s`, concatenated) over the 32-byte `hashes` (concatenated)
+/// with `pub_key`. Returns one byte per signature, 1 if it is valid and 0 otherwise.
+pub fn starknet_verify_batch(pub_key: &[u8], hashes: &[u8], signatures: &[u8]) -> Result<Vec<u8>> {
+    if hashes.len() % FIELD_ELEMENT_SIZE != 0 || signatures.len() != hashes.len() * 2 {
+        return Err(StarknetKeyPairError::InvalidLength);
+    }
+    let pub_key = field_element_from_be_bytes(pub_key)?;
+
+    hashes
+        .chunks_exact(FIELD_ELEMENT_SIZE)
+        .zip(signatures.chunks_exact(SIGNATURE_SIZE))
+        .map(|(hash, signature)| {
+            let hash = field_element_from_be_bytes(hash)?;
+            let r = field_element_from_be_bytes(&signature[..FIELD_ELEMENT_SIZE])?;
+            let s = field_element_from_be_bytes(&signature[FIELD_ELEMENT_SIZE..])?;
+            Ok(verify(&pub_key, &hash, &r, &s).unwrap_or_default() as u8)
+        })
+        .collect()
+}
+
 fn field_element_from_be_hex(hex: &str) -> Result<FieldElement> {
     let decoded = tw_hex::decode(hex)?;
-    if decoded.len() > 32 {
+    field_element_from_be_bytes(&decoded)
+}
+
+fn field_element_from_be_bytes(bytes: &[u8]) -> Result<FieldElement> {
+    if bytes.len() > FIELD_ELEMENT_SIZE {
         return Err(StarknetKeyPairError::InvalidLength);
     }
 
-    let mut buffer = [0u8; 32];
-    buffer[(32 - decoded.len())..].copy_from_slice(&decoded[..]);
+    let mut buffer = [0u8; FIELD_ELEMENT_SIZE];
+    buffer[(FIELD_ELEMENT_SIZE - bytes.len())..].copy_from_slice(bytes);
 
     FieldElement::from_bytes_be(&buffer).map_err(StarknetKeyPairError::from)
 }
@@ -1,9 +1,11 @@
 use std::ffi::{c_char, CString};
+use tw_encoding::hex;
 use tw_memory::c_string_standalone;
 use tw_memory::ffi::c_result::OK_CODE;
 use tw_memory::ffi::free_string;
 use tw_starknet::ffi::{
-    starknet_pubkey_from_private, starknet_sign, starknet_verify, CStarknetCode,
+    starknet_pubkey_from_private, starknet_sign, starknet_sign_batch, starknet_verify,
+    starknet_verify_batch, CStarknetCode,
 };
 
 #[test]
@@ -126,3 +128,74 @@ fn test_starknet_private_key_zero() {
 
     unsafe { free_string(private_raw) };
 }
+
+#[test]
+fn test_starknet_sign_batch() {
+    let priv_key =
+        hex::decode("0139fe4d6f02e666e86a6f58e65060f115cd3c185bd9e98bd829636931458f79").unwrap();
+    let hash =
+        hex::decode("06fea80189363a786037ed3e7ba546dad0ef7de49fccae0e31eb658b7dd4ea76").unwrap();
+    let hashes = [hash.clone(), hash].concat();
+
+    let res = unsafe {
+        starknet_sign_batch(
+            priv_key.as_ptr(),
+            priv_key.len(),
+            hashes.as_ptr(),
+            hashes.len(),
+        )
+    };
+    assert_eq!(res.code, OK_CODE);
+    let signatures = unsafe { res.result.into_vec() };
+    let expected = hex::decode("061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9a").unwrap();
+    assert_eq!(signatures, [expected.clone(), expected].concat());
+
+    // Hashes must be 32 bytes each.
+    let res = unsafe {
+        starknet_sign_batch(
+            priv_key.as_ptr(),
+            priv_key.len(),
+            hashes.as_ptr(),
+            hashes.len() - 1,
+        )
+    };
+    assert_eq!(res.code, CStarknetCode::PrivKeyError as i32);
+}
+
+#[test]
+fn test_starknet_verify_batch() {
+    let pub_key =
+        hex::decode("02c5dbad71c92a45cc4b40573ae661f8147869a91d57b8d9b8f48c8af7f83159").unwrap();
+    let hash =
+        hex::decode("06fea80189363a786037ed3e7ba546dad0ef7de49fccae0e31eb658b7dd4ea76").unwrap();
+    let valid = hex::decode("061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9a").unwrap();
+    let invalid = hex::decode("061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9b").unwrap();
+    let hashes = [hash.clone(), hash].concat();
+    let signatures = [valid, invalid].concat();
+
+    let res = unsafe {
+        starknet_verify_batch(
+            pub_key.as_ptr(),
+            pub_key.len(),
+            hashes.as_ptr(),
+            hashes.len(),
+            signatures.as_ptr(),
+            signatures.len(),
+        )
+    };
+    assert_eq!(res.code, OK_CODE);
+    assert_eq!(unsafe { res.result.into_vec() }, vec![1, 0]);
+
+    // One signature per hash.
+    let res = unsafe {
+        starknet_verify_batch(
+            pub_key.as_ptr(),
+            pub_key.len(),
+            hashes.as_ptr(),
+            hashes.len(),
+            signatures.as_ptr(),
+            signatures.len() - 64,
+        )
+    };
+    assert_eq!(res.code, CStarknetCode::PrivKeyError as i32);
+}
@@ -0,0 +1,80 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Framing.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace TW::Signerd {
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+// macOS: SIGPIPE is ignored by the daemon instead
+constexpr int sendFlags = 0;
+#endif
+
+bool readAll(int fd, uint8_t* buffer, std::size_t size) {
+    while (size > 0) {
+        const auto count = ::read(fd, buffer, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const uint8_t* buffer, std::size_t size) {
+    while (size > 0) {
+        const auto count = ::send(fd, buffer, size, sendFlags);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+} // namespace
+
+bool readFrame(int fd, std::string& message, std::size_t maxSize) {
+    uint8_t prefix[framePrefixSize];
+    if (!readAll(fd, prefix, sizeof(prefix))) {
+        return false;
+    }
+    const std::size_t size = (uint32_t(prefix[0]) << 24) | (uint32_t(prefix[1]) << 16) | (uint32_t(prefix[2]) << 8) | uint32_t(prefix[3]);
+    if (size > maxSize) {
+        return false;
+    }
+    message.resize(size);
+    return readAll(fd, reinterpret_cast<uint8_t*>(message.data()), size);
+}
+
+bool writeFrame(int fd, const std::string& message) {
+    if (message.size() > UINT32_MAX) {
+        return false;
+    }
+    const auto size = static_cast<uint32_t>(message.size());
+    const uint8_t prefix[framePrefixSize] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
+    return writeAll(fd, prefix, sizeof(prefix)) && writeAll(fd, reinterpret_cast<const uint8_t*>(message.data()), message.size());
+}
+
+} // namespace TW::Signerd
@@ -0,0 +1,24 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace TW::Signerd {
+
+/// Size of the big-endian length prefix of every message.
+static constexpr std::size_t framePrefixSize = 4;
+
+/// Reads a length-prefixed message from a socket, retrying on interruptions.
+/// Returns false at the end of the stream, on errors, or if the message is larger than `maxSize`.
+bool readFrame(int fd, std::string& message, std::size_t maxSize);
+
+/// Writes a length-prefixed message to a socket. Returns false on errors.
+bool writeFrame(int fd, const std::string& message);
+
+} // namespace TW::Signerd
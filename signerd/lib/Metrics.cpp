@@ -0,0 +1,100 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Metrics.h"
+
+#include <TrustWalletCore/TWCoinTypeConfiguration.h>
+
+#include <cstdio>
+
+namespace TW::Signerd {
+
+namespace {
+
+constexpr uint64_t firstBucketMicros = 16;
+
+std::string coinId(std::optional<TWCoinType> coin) {
+    if (!coin) {
+        return "";
+    }
+    auto* id = TWCoinTypeConfigurationGetID(*coin);
+    std::string result = TWStringUTF8Bytes(id);
+    TWStringDelete(id);
+    return result;
+}
+
+} // namespace
+
+const char* operationName(Operation operation) {
+    switch (operation) {
+    case Operation::Sign:
+        return "sign";
+    case Operation::PreImageHashes:
+        return "pre_image_hashes";
+    case Operation::Compile:
+        return "compile";
+    case Operation::Unlock:
+        return "unlock";
+    case Operation::Lock:
+        return "lock";
+    case Operation::SignHashes:
+        return "sign_hashes";
+    case Operation::DeriveAddress:
+        return "derive_address";
+    }
+    return "unknown";
+}
+
+void Metrics::record(std::optional<TWCoinType> coin, Operation operation, std::chrono::nanoseconds latency, bool failed) {
+    const auto micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    std::size_t bucket = 0;
+    while (bucket < bucketCount && micros > (firstBucketMicros << bucket)) {
+        ++bucket;
+    }
+
+    std::lock_guard lock(mutex);
+    auto& entry = series[{coin, operation}];
+    ++entry.buckets[bucket];
+    ++entry.count;
+    entry.failures += failed ? 1 : 0;
+    entry.sumSeconds += std::chrono::duration<double>(latency).count();
+}
+
+std::string Metrics::prometheus() const {
+    std::lock_guard lock(mutex);
+    std::string out;
+    char line[256];
+    out += "# TYPE walletcore_signerd_request_duration_seconds histogram\n";
+    for (const auto& [key, entry] : series) {
+        const auto labels = "coin=\"" + coinId(key.first) + "\",operation=\"" + operationName(key.second) + "\"";
+        uint64_t cumulative = 0;
+        for (std::size_t i = 0; i <= bucketCount; ++i) {
+            cumulative += entry.buckets[i];
+            if (i < bucketCount) {
+                std::snprintf(line, sizeof(line), "walletcore_signerd_request_duration_seconds_bucket{%s,le=\"%g\"} %llu\n",
+                              labels.c_str(), static_cast<double>(firstBucketMicros << i) / 1e6, static_cast<unsigned long long>(cumulative));
+            } else {
+                std::snprintf(line, sizeof(line), "walletcore_signerd_request_duration_seconds_bucket{%s,le=\"+Inf\"} %llu\n",
+                              labels.c_str(), static_cast<unsigned long long>(cumulative));
+            }
+            out += line;
+        }
+        std::snprintf(line, sizeof(line), "walletcore_signerd_request_duration_seconds_sum{%s} %.9f\n", labels.c_str(), entry.sumSeconds);
+        out += line;
+        std::snprintf(line, sizeof(line), "walletcore_signerd_request_duration_seconds_count{%s} %llu\n",
+                      labels.c_str(), static_cast<unsigned long long>(entry.count));
+        out += line;
+    }
+    out += "# TYPE walletcore_signerd_request_failures_total counter\n";
+    for (const auto& [key, entry] : series) {
+        std::snprintf(line, sizeof(line), "walletcore_signerd_request_failures_total{coin=\"%s\",operation=\"%s\"} %llu\n",
+                      coinId(key.first).c_str(), operationName(key.second), static_cast<unsigned long long>(entry.failures));
+        out += line;
+    }
+    return out;
+}
+
+} // namespace TW::Signerd
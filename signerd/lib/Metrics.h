@@ -0,0 +1,60 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace TW::Signerd {
+
+enum class Operation : uint8_t {
+    Sign,
+    PreImageHashes,
+    Compile,
+    Unlock,
+    Lock,
+    SignHashes,
+    DeriveAddress,
+};
+
+const char* operationName(Operation operation);
+
+/// Request counts and latency histograms per coin and operation, exported in the Prometheus text format.
+class Metrics {
+public:
+    /// Latency buckets are powers of two microseconds, from 16us to about 8s.
+    static constexpr std::size_t bucketCount = 20;
+
+    /// `coin` is empty for the operations not related to a coin (unlock, lock).
+    void record(std::optional<TWCoinType> coin, Operation operation, std::chrono::nanoseconds latency, bool failed);
+
+    /// Histograms `walletcore_signerd_request_duration_seconds` and counters `walletcore_signerd_request_failures_total`,
+    /// labelled by coin id (empty if none) and operation.
+    std::string prometheus() const;
+
+private:
+    struct Series {
+        std::array<uint64_t, bucketCount + 1> buckets{}; // the last one has no upper bound
+        uint64_t count = 0;
+        uint64_t failures = 0;
+        double sumSeconds = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::pair<std::optional<TWCoinType>, Operation>, Series> series;
+};
+
+} // namespace TW::Signerd
@@ -0,0 +1,278 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Server.h"
+#include "Framing.h"
+
+#include "Coin.h"
+#include "DerivationPath.h"
+#include "TransactionCompiler.h"
+#include "memory/memzero_wrapper.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace TW::Signerd {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Interval of the session expiry checks while waiting for connections.
+constexpr int pollIntervalMillis = 1000;
+
+TWCoinType coinType(uint32_t value) {
+    static const auto supported = [] {
+        const auto coins = getCoinTypes();
+        return std::set<TWCoinType>(coins.begin(), coins.end());
+    }();
+    const auto coin = static_cast<TWCoinType>(value);
+    if (supported.count(coin) == 0) {
+        throw std::invalid_argument("Unsupported coin");
+    }
+    return coin;
+}
+
+DerivationPath path(TWCoinType coin, const std::string& value) {
+    return value.empty() ? derivationPath(coin) : DerivationPath(value);
+}
+
+Data toData(const std::string& bytes) {
+    return Data(bytes.begin(), bytes.end());
+}
+
+std::string toBytes(std::span<const byte> data) {
+    return std::string(data.begin(), data.end());
+}
+
+void wipe(std::string& string) {
+    memzero(string.data(), string.size());
+}
+
+} // namespace
+
+std::string defaultSocketPath() {
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    const std::string directory = runtimeDir != nullptr && runtimeDir[0] != '\0' ? runtimeDir : "/tmp";
+    return directory + "/walletcore-signerd.sock";
+}
+
+Server::Server(const Options& options)
+    : options(options),
+      coalescer(options.maxBatch, options.batchWindow, options.threads),
+      sessionStore(options.sessionTtl) {}
+
+Server::~Server() {
+    stop();
+}
+
+Proto::Response Server::handle(const Proto::Request& request) {
+    Proto::Response response;
+    response.set_id(request.id());
+    if (request.operation_case() == Proto::Request::kMetrics) {
+        response.set_text(requestMetrics.prometheus());
+        return response;
+    }
+
+    const auto start = Clock::now();
+    std::optional<TWCoinType> coin;
+    auto operation = Operation::Sign;
+    try {
+        switch (request.operation_case()) {
+        case Proto::Request::kSign: {
+            const auto& sign = request.sign();
+            coin = coinType(sign.coin());
+            response.set_output(toBytes(coalescer.sign(*coin, toData(sign.input()))));
+            break;
+        }
+        case Proto::Request::kPreImageHashes: {
+            operation = Operation::PreImageHashes;
+            const auto& preImage = request.pre_image_hashes();
+            coin = coinType(preImage.coin());
+            response.set_output(toBytes(TransactionCompiler::preImageHashes(*coin, toData(preImage.input()))));
+            break;
+        }
+        case Proto::Request::kCompile: {
+            operation = Operation::Compile;
+            const auto& compile = request.compile();
+            coin = coinType(compile.coin());
+            std::vector<Data> signatures;
+            std::vector<Data> publicKeys;
+            for (const auto& signature : compile.signatures()) {
+                signatures.push_back(toData(signature));
+            }
+            for (const auto& publicKey : compile.public_keys()) {
+                publicKeys.push_back(toData(publicKey));
+            }
+            response.set_output(toBytes(TransactionCompiler::compileWithSignatures(*coin, toData(compile.input()), signatures, publicKeys)));
+            break;
+        }
+        case Proto::Request::kUnlock: {
+            operation = Operation::Unlock;
+            const auto& unlock = request.unlock();
+            auto password = toData(unlock.password());
+            try {
+                response.set_session(sessionStore.unlock(unlock.keystore_json(), password, std::chrono::seconds(unlock.ttl_seconds())));
+            } catch (...) {
+                memzero(password.data(), password.size());
+                throw;
+            }
+            memzero(password.data(), password.size());
+            break;
+        }
+        case Proto::Request::kLock:
+            operation = Operation::Lock;
+            if (!sessionStore.lock(request.lock().session())) {
+                throw std::invalid_argument("Unknown or expired session");
+            }
+            break;
+        case Proto::Request::kSignHashes: {
+            operation = Operation::SignHashes;
+            const auto& signHashes = request.sign_hashes();
+            coin = coinType(signHashes.coin());
+            const auto wallet = sessionStore.wallet(signHashes.session());
+            const auto key = wallet->getKey(*coin, path(*coin, signHashes.derivation_path()));
+            const auto keyCurve = curve(*coin);
+            for (const auto& hash : signHashes.hashes()) {
+                const auto signature = key.sign(toData(hash), keyCurve);
+                if (signature.empty()) {
+                    throw std::invalid_argument("Signing failed");
+                }
+                response.add_outputs(toBytes(signature));
+            }
+            response.set_output(toBytes(key.getPublicKey(publicKeyType(*coin)).bytes));
+            break;
+        }
+        case Proto::Request::kDeriveAddress: {
+            operation = Operation::DeriveAddress;
+            const auto& derive = request.derive_address();
+            coin = coinType(derive.coin());
+            const auto wallet = sessionStore.wallet(derive.session());
+            response.set_text(deriveAddress(*coin, wallet->getKey(*coin, path(*coin, derive.derivation_path()))));
+            break;
+        }
+        default:
+            throw std::invalid_argument("Missing operation");
+        }
+    } catch (const std::exception& error) {
+        response.Clear();
+        response.set_id(request.id());
+        response.set_error(error.what());
+    } catch (...) {
+        response.Clear();
+        response.set_id(request.id());
+        response.set_error("Internal error");
+    }
+    requestMetrics.record(coin, operation, Clock::now() - start, !response.error().empty());
+    return response;
+}
+
+void Server::listen() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path too long");
+    }
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+    // A socket left by a previous run
+    ::unlink(options.socketPath.c_str());
+    // The socket is created owner-only, other users can't connect before the chmod
+    const auto mask = ::umask(S_IRWXG | S_IRWXO);
+    const auto bound = ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    const auto bindError = errno;
+    ::umask(mask);
+    if (!bound || ::chmod(options.socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+        const auto error = bound ? errno : bindError;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "bind");
+    }
+    listenFd = fd;
+
+    while (!stopping) {
+        pollfd pending{fd, POLLIN, 0};
+        const auto ready = ::poll(&pending, 1, pollIntervalMillis);
+        sessionStore.expire();
+        if (ready <= 0) {
+            continue;
+        }
+        const int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        {
+            std::lock_guard lock(connectionsMutex);
+            if (stopping) {
+                ::close(client);
+                break;
+            }
+            connections.insert(client);
+        }
+        try {
+            std::thread([this, client] { serve(client); }).detach();
+        } catch (const std::system_error&) {
+            std::lock_guard lock(connectionsMutex);
+            connections.erase(client);
+            ::close(client);
+        }
+    }
+
+    listenFd = -1;
+    ::close(fd);
+    ::unlink(options.socketPath.c_str());
+}
+
+void Server::stop() {
+    stopping = true;
+    std::unique_lock lock(connectionsMutex);
+    for (const auto fd : connections) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    connectionsDone.wait(lock, [this] { return connections.empty(); });
+}
+
+void Server::serve(int fd) {
+    std::string frame;
+    while (!stopping && readFrame(fd, frame, options.maxMessageSize)) {
+        Proto::Request request;
+        Proto::Response response;
+        if (request.ParseFromString(frame)) {
+            response = handle(request);
+        } else {
+            response.set_error("Invalid request");
+        }
+        // Unlock requests carry the password.
+        wipe(frame);
+        if (request.has_unlock()) {
+            wipe(*request.mutable_unlock()->mutable_password());
+        }
+        if (!writeFrame(fd, response.SerializeAsString())) {
+            break;
+        }
+    }
+
+    std::lock_guard lock(connectionsMutex);
+    connections.erase(fd);
+    ::close(fd);
+    connectionsDone.notify_all();
+}
+
+} // namespace TW::Signerd
@@ -0,0 +1,79 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Metrics.h"
+#include "Sessions.h"
+#include "SignCoalescer.h"
+#include "Signerd.pb.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace TW::Signerd {
+
+/// `walletcore-signerd.sock` in `$XDG_RUNTIME_DIR`, the private runtime directory of the user, or in `/tmp` without it.
+std::string defaultSocketPath();
+
+struct Options {
+    /// Created readable by the owner only.
+    std::string socketPath = defaultSocketPath();
+    /// Most sign requests of a coin coalesced into a batch.
+    std::size_t maxBatch = 64;
+    /// Longest wait of a sign request for others to join its batch, 0 to sign every request on its own.
+    std::chrono::microseconds batchWindow{500};
+    /// Workers of a batch, 0 for the hardware concurrency.
+    std::size_t threads = 0;
+    /// Default time to live of an unused session.
+    std::chrono::seconds sessionTtl{900};
+    std::size_t maxMessageSize = 16 << 20;
+};
+
+/// The walletcore-signerd daemon: serves length-prefixed `Proto::Request` messages (see Signerd.proto) on a Unix
+/// domain socket, one thread per connection, sharing the sign coalescer, sessions and metrics between connections.
+class Server {
+public:
+    explicit Server(const Options& options);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /// Handles a request; errors are reported in the response.
+    Proto::Response handle(const Proto::Request& request);
+
+    /// Binds the socket (readable by the owner only) and serves connections until `stop`.
+    /// Throws std::system_error if the socket can't be bound.
+    void listen();
+
+    /// Stops `listen`, closing the connections and waiting for their threads.
+    void stop();
+
+    Sessions& sessions() { return sessionStore; }
+    const Metrics& metrics() const { return requestMetrics; }
+
+private:
+    void serve(int fd);
+
+    const Options options;
+    SignCoalescer coalescer;
+    Sessions sessionStore;
+    Metrics requestMetrics;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<int> listenFd{-1};
+    std::mutex connectionsMutex;
+    std::condition_variable connectionsDone;
+    std::set<int> connections;
+};
+
+} // namespace TW::Signerd
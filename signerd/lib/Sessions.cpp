@@ -0,0 +1,67 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Sessions.h"
+
+#include "HexCoding.h"
+#include "Keystore/StoredKey.h"
+#include "Random.h"
+
+#include <stdexcept>
+
+namespace TW::Signerd {
+
+std::string Sessions::unlock(const std::string& keystoreJson, const Data& password, Clock::duration ttl) {
+    const auto key = Keystore::StoredKey::createWithJsonText(keystoreJson);
+    auto wallet = std::make_shared<HDWallet<>>(key.wallet(password));
+    wallet->enableNodeCache();
+    if (ttl == Clock::duration::zero()) {
+        ttl = defaultTtl;
+    }
+
+    const auto id = hex(Random::generate(16));
+    std::lock_guard lock(mutex);
+    sessions[id] = Session{std::move(wallet), ttl, Clock::now() + ttl};
+    return id;
+}
+
+bool Sessions::lock(const std::string& id) {
+    std::lock_guard lock(mutex);
+    const auto it = sessions.find(id);
+    if (it == sessions.end()) {
+        return false;
+    }
+    const auto live = it->second.expiry > Clock::now();
+    sessions.erase(it);
+    return live;
+}
+
+std::shared_ptr<const HDWallet<>> Sessions::wallet(const std::string& id) {
+    std::lock_guard lock(mutex);
+    const auto it = sessions.find(id);
+    const auto now = Clock::now();
+    if (it == sessions.end() || it->second.expiry <= now) {
+        if (it != sessions.end()) {
+            sessions.erase(it);
+        }
+        throw std::invalid_argument("Unknown or expired session");
+    }
+    it->second.expiry = now + it->second.ttl;
+    return it->second.wallet;
+}
+
+void Sessions::expire() {
+    std::lock_guard lock(mutex);
+    const auto now = Clock::now();
+    std::erase_if(sessions, [now](const auto& entry) { return entry.second.expiry <= now; });
+}
+
+std::size_t Sessions::size() const {
+    std::lock_guard lock(mutex);
+    return sessions.size();
+}
+
+} // namespace TW::Signerd
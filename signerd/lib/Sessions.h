@@ -0,0 +1,58 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "HDWallet.h"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace TW::Signerd {
+
+/// Decrypted keystores kept in memory, so that the key derivation function runs once per unlock rather than once per
+/// request. Each wallet has a node cache, keeping the derivation of its accounts warm.
+/// A session expires after its time to live without use; the wallets are wiped when expired, locked or destroyed.
+class Sessions {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Sessions(Clock::duration defaultTtl) : defaultTtl(defaultTtl) {}
+
+    /// Decrypts the mnemonic of a keystore JSON and returns the identifier of the new session.
+    /// `ttl` is the default one if zero. Throws if the keystore is invalid, has no mnemonic or the password is wrong.
+    std::string unlock(const std::string& keystoreJson, const Data& password, Clock::duration ttl);
+
+    /// Removes a session. Returns false if it didn't exist or had expired.
+    bool lock(const std::string& id);
+
+    /// The wallet of a session, extending its expiry. Throws if the session doesn't exist or has expired.
+    /// The wallet stays valid for the caller if the session is locked meanwhile.
+    std::shared_ptr<const HDWallet<>> wallet(const std::string& id);
+
+    /// Removes the expired sessions.
+    void expire();
+
+    std::size_t size() const;
+
+private:
+    struct Session {
+        std::shared_ptr<const HDWallet<>> wallet;
+        Clock::duration ttl;
+        Clock::time_point expiry;
+    };
+
+    const Clock::duration defaultTtl;
+    mutable std::mutex mutex;
+    std::map<std::string, Session> sessions;
+};
+
+} // namespace TW::Signerd
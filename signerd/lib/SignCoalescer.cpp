@@ -0,0 +1,67 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignCoalescer.h"
+
+#include "Coin.h"
+
+namespace TW::Signerd {
+
+Data SignCoalescer::sign(TWCoinType coin, const Data& input) {
+    if (window.count() == 0 || maxBatch <= 1) {
+        Data output;
+        anyCoinSign(coin, input, output);
+        return output;
+    }
+
+    auto request = std::make_shared<Request>();
+    request->input = input;
+    auto output = request->output.get_future();
+
+    std::unique_lock lock(mutex);
+    auto& queue = queues[coin];
+    queue.push_back(request);
+    Queue batch;
+    if (queue.size() >= maxBatch) {
+        // Filled the batch: sign it now.
+        batch.swap(queue);
+    } else if (queue.size() == 1) {
+        // First of the batch: wait for others, unless a later request fills it, then sign them all.
+        const auto taken = [&] { return queue.empty() || queue.front() != request; };
+        if (!full.wait_for(lock, window, taken)) {
+            batch.swap(queue);
+        }
+    }
+    lock.unlock();
+    if (!batch.empty()) {
+        full.notify_all();
+        signBatch(coin, batch);
+    }
+    return output.get();
+}
+
+void SignCoalescer::signBatch(TWCoinType coin, Queue& batch) {
+    std::vector<Data> inputs;
+    inputs.reserve(batch.size());
+    for (const auto& request : batch) {
+        inputs.push_back(std::move(request->input));
+    }
+    std::vector<Data> outputs;
+    try {
+        outputs = anyCoinSignBatch(coin, inputs, threads);
+    } catch (...) {
+        const auto error = std::current_exception();
+        for (const auto& request : batch) {
+            request->output.set_exception(error);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        batch[i]->output.set_value(std::move(outputs[i]));
+    }
+}
+
+} // namespace TW::Signerd
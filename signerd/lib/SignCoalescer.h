@@ -0,0 +1,56 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace TW::Signerd {
+
+/// Coalesces concurrent sign requests for the same coin into `anyCoinSignBatch` calls.
+///
+/// The first request of a coin waits for up to `window` for others to join, then signs them all in its thread on
+/// `threads` workers; the request filling a batch to `maxBatch` signs it at once instead. The other requests of a
+/// batch wait for their output.
+/// A zero window or a `maxBatch` of 1 signs every request on its own.
+class SignCoalescer {
+public:
+    SignCoalescer(std::size_t maxBatch, std::chrono::microseconds window, std::size_t threads)
+        : maxBatch(maxBatch), window(window), threads(threads) {}
+
+    /// Signs `input` like `anyCoinSign`, possibly in a batch with other requests. Rethrows the signing error.
+    Data sign(TWCoinType coin, const Data& input);
+
+private:
+    struct Request {
+        Data input;
+        std::promise<Data> output;
+    };
+
+    using Queue = std::vector<std::shared_ptr<Request>>;
+
+    void signBatch(TWCoinType coin, Queue& batch);
+
+    const std::size_t maxBatch;
+    const std::chrono::microseconds window;
+    const std::size_t threads;
+    std::mutex mutex;
+    std::condition_variable full;
+    std::map<TWCoinType, Queue> queues;
+};
+
+} // namespace TW::Signerd
@@ -0,0 +1,96 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Server.h"
+
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+
+static void usage() {
+    std::cerr << "Usage: walletcore-signerd [--socket <path>] [--max-batch <n>] [--batch-window-us <us>] [--threads <n>] [--session-ttl <s>]" << std::endl;
+    std::cerr << "  --socket           Unix domain socket to serve (default: " << TW::Signerd::defaultSocketPath() << ")" << std::endl;
+    std::cerr << "  --max-batch        Most sign requests of a coin coalesced into a batch (default: 64)" << std::endl;
+    std::cerr << "  --batch-window-us  Longest wait for a batch to fill, 0 to disable coalescing (default: 500)" << std::endl;
+    std::cerr << "  --threads          Workers of a batch (default: hardware concurrency)" << std::endl;
+    std::cerr << "  --session-ttl      Seconds an unused session stays unlocked (default: 900)" << std::endl;
+}
+
+/// Parses a non-negative decimal number, the whole of `value`.
+static bool parseNumber(const std::string& value, unsigned long& number) {
+    if (value.empty() || value[0] < '0' || value[0] > '9') {
+        return false;
+    }
+    try {
+        std::size_t end = 0;
+        number = std::stoul(value, &end);
+        return end == value.size();
+    } catch (const std::logic_error&) {
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    TW::Signerd::Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        const std::string value = argv[++i];
+        unsigned long number = 0;
+        if (arg == "--socket") {
+            options.socketPath = value;
+        } else if (!parseNumber(value, number)) {
+            usage();
+            return 1;
+        } else if (arg == "--max-batch") {
+            options.maxBatch = number;
+        } else if (arg == "--batch-window-us") {
+            options.batchWindow = std::chrono::microseconds(number);
+        } else if (arg == "--threads") {
+            options.threads = number;
+        } else if (arg == "--session-ttl") {
+            options.sessionTtl = std::chrono::seconds(number);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    // Signals are handled by the main thread only, the server runs in another one.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    TW::Signerd::Server server(options);
+    int result = 0;
+    std::thread listener([&] {
+        try {
+            server.listen();
+        } catch (const std::exception& error) {
+            std::cerr << "walletcore-signerd: " << error.what() << std::endl;
+            result = 1;
+            kill(getpid(), SIGTERM);
+        }
+    });
+    std::cerr << "walletcore-signerd: serving " << options.socketPath << std::endl;
+
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.stop();
+    listener.join();
+    return result;
+}
@@ -0,0 +1,176 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AccountDiscovery.h"
+
+#include "Bech32Address.h"
+#include "Coin.h"
+#include "algorithm/parallel.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+namespace TW {
+
+namespace {
+
+/// Highest address or account index, plus one.
+const uint64_t indexLimit = 0x80000000;
+
+/// Identifies the address format of a coin and derivation; equal keys give equal addresses for equal keys.
+/// Coins of the Cosmos blockchain only differ by HRP for the same key type and hasher, see `hrpsOf`.
+std::pair<int, int> addressFormat(const DiscoveryRequest& request) {
+    switch (TW::blockchain(request.coin)) {
+    case TWBlockchainEthereum:
+        return {-1, -1};
+    case TWBlockchainCosmos:
+        return {-2 - static_cast<int>(TW::publicKeyType(request.coin)), static_cast<int>(TW::addressHasher(request.coin))};
+    default:
+        return {static_cast<int>(request.coin), static_cast<int>(request.derivation)};
+    }
+}
+
+/// HRPs of the members of a Cosmos chain, whose addresses are the leader's key hash with each of them;
+/// empty when all the members share the leader's addresses.
+std::vector<std::string> hrpsOf(const AccountDiscovery::Chain& chain) {
+    const auto& leader = chain.members.front();
+    if (TW::blockchain(leader.coin) != TWBlockchainCosmos || chain.members.size() == 1) {
+        return {};
+    }
+    std::vector<std::string> hrps;
+    for (const auto& member : chain.members) {
+        hrps.emplace_back(stringForHRP(TW::hrp(member.coin)));
+    }
+    return hrps;
+}
+
+/// Addresses of each member for the leader's `addresses`, indexed by address then member; the key hash of
+/// each address is decoded once, only the Bech32 checksum is computed for each member.
+std::vector<std::vector<std::string>> memberAddresses(const std::vector<std::string>& addresses, const std::vector<std::string>& hrps) {
+    std::vector<std::vector<std::string>> result;
+    result.reserve(addresses.size());
+    for (const auto& address : addresses) {
+        Bech32Address decoded("");
+        if (!Bech32Address::decode(address, decoded, "")) {
+            throw std::runtime_error("Invalid derived address");
+        }
+        result.push_back(Bech32Address::strings(decoded.getKeyHash(), hrps));
+    }
+    return result;
+}
+
+} // namespace
+
+AccountDiscovery::AccountDiscovery(const HDWallet<>& wallet, const std::vector<DiscoveryRequest>& requests)
+    : wallet(wallet) {
+    std::map<std::tuple<TWCurve, std::string, std::pair<int, int>>, std::size_t> chainIndex;
+    for (const auto& request : requests) {
+        if (static_cast<uint64_t>(request.firstAccount) + request.accountCount > indexLimit) {
+            throw std::invalid_argument("Account index out of range");
+        }
+        const auto basePath = TW::derivationPath(request.coin, request.derivation);
+        const auto gapScan = basePath.indices.size() == 5;
+        for (uint32_t i = 0; i < request.accountCount; ++i) {
+            auto path = basePath;
+            // keep the hardened flags of the coin's derivation path
+            if (path.indices.size() >= 3) {
+                path.indices[2].value = request.firstAccount + i;
+            }
+            if (gapScan) {
+                path.indices[3].value = 0;
+                path.indices[4].value = 0;
+            }
+
+            const auto key = std::make_tuple(TW::curve(request.coin), path.string(), addressFormat(request));
+            const auto [it, inserted] = chainIndex.emplace(key, chains.size());
+            if (inserted) {
+                chains.push_back(Chain{{}, request.firstAccount + i, path, gapScan});
+            }
+            auto& members = chains[it->second].members;
+            const auto duplicate = std::any_of(members.begin(), members.end(), [&](const auto& member) {
+                return member.coin == request.coin && member.derivation == request.derivation;
+            });
+            if (!duplicate) {
+                members.push_back(request);
+            }
+        }
+    }
+
+    // the hardened levels above the change level are shared by the chains of an account, and often by coins
+    this->wallet.enableNodeCache(std::max(HDWallet<>::defaultNodeCacheSize, chains.size() * 4));
+}
+
+std::vector<DiscoveredAddress> AccountDiscovery::run(const UsageCheck& isUsed, const Callback& onAddress, std::size_t threads) const {
+    std::vector<std::vector<DiscoveredAddress>> used(chains.size());
+    std::mutex mutex;
+    parallelFor(chains.size(), threads, [&](std::size_t i) {
+        scanChain(chains[i], isUsed, [&](const DiscoveredAddress& address, bool isAddressUsed) {
+            std::lock_guard lock(mutex);
+            if (isAddressUsed) {
+                used[i].push_back(address);
+            }
+            if (onAddress) {
+                onAddress(address, isAddressUsed);
+            }
+        });
+    });
+
+    std::vector<DiscoveredAddress> result;
+    for (auto& addresses : used) {
+        std::move(addresses.begin(), addresses.end(), std::back_inserter(result));
+    }
+    return result;
+}
+
+void AccountDiscovery::scanChain(const Chain& chain, const UsageCheck& isUsed, const std::function<void(const DiscoveredAddress&, bool)>& report) const {
+    const auto& leader = chain.members.front();
+    const auto hrps = hrpsOf(chain);
+    if (!chain.gapScan) {
+        const auto address = TW::deriveAddress(leader.coin, wallet.getKey(leader.coin, chain.path), leader.derivation);
+        const auto perMember = hrps.empty() ? std::vector<std::vector<std::string>>() : memberAddresses({address}, hrps);
+        for (std::size_t m = 0; m < chain.members.size(); ++m) {
+            const auto& member = chain.members[m];
+            const auto discovered = DiscoveredAddress{member.coin, member.derivation, chain.account, 0, chain.path, hrps.empty() ? address : perMember[0][m]};
+            report(discovered, isUsed(discovered));
+        }
+        return;
+    }
+
+    uint32_t window = 1;
+    for (const auto& member : chain.members) {
+        window = std::max(window, member.gapLimit);
+    }
+    // consecutive unused addresses of each member, the member is done once it reaches its gap limit
+    std::vector<uint32_t> unused(chain.members.size(), 0);
+    const auto isDone = [&](std::size_t m) { return unused[m] >= std::max(chain.members[m].gapLimit, 1u); };
+
+    auto path = chain.path;
+    for (uint64_t start = 0; start < indexLimit; start += window) {
+        const auto count = static_cast<uint32_t>(std::min<uint64_t>(window, indexLimit - start));
+        const auto addresses = wallet.deriveAddresses(leader.coin, leader.derivation, chain.account, 0, static_cast<uint32_t>(start), count, 1);
+        const auto perMember = hrps.empty() ? std::vector<std::vector<std::string>>() : memberAddresses(addresses, hrps);
+        bool active = false;
+        for (std::size_t m = 0; m < chain.members.size(); ++m) {
+            const auto& member = chain.members[m];
+            for (uint32_t i = 0; i < count && !isDone(m); ++i) {
+                path.indices[4].value = static_cast<uint32_t>(start) + i;
+                const auto discovered = DiscoveredAddress{member.coin, member.derivation, chain.account, path.indices[4].value, path, hrps.empty() ? addresses[i] : perMember[i][m]};
+                const auto used = isUsed(discovered);
+                unused[m] = used ? 0 : unused[m] + 1;
+                report(discovered, used);
+            }
+            active = active || !isDone(m);
+        }
+        if (!active) {
+            break;
+        }
+    }
+}
+
+} // namespace TW
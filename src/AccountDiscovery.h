@@ -0,0 +1,96 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "DerivationPath.h"
+#include "HDWallet.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWDerivation.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Accounts to scan for one coin and derivation.
+struct DiscoveryRequest {
+    TWCoinType coin;
+    TWDerivation derivation = TWDerivationDefault;
+
+    /// Scans accounts `firstAccount` ..< `firstAccount + accountCount`.
+    uint32_t firstAccount = 0;
+    uint32_t accountCount = 1;
+
+    /// Number of consecutive unused addresses that ends the scan of an account (20 in BIP44).
+    uint32_t gapLimit = 20;
+};
+
+/// An address derived by `AccountDiscovery`.
+struct DiscoveredAddress {
+    TWCoinType coin;
+    TWDerivation derivation;
+    uint32_t account;
+    uint32_t index;
+    DerivationPath path;
+    std::string address;
+};
+
+/// Scans the addresses of a wallet over many coins and derivations, as for a wallet restore.
+///
+/// The requests are turned into a plan of address chains, one per account and distinct derivation path.
+/// Coins of the Ethereum blockchain sharing a path (e.g. the EVM chains using coin type 60) share one chain,
+/// so each address is derived once; Cosmos coins sharing a path also share one chain, the address of each coin
+/// being the key hash of the first one re-encoded with the coin's HRP. Chains are scanned in parallel: the addresses of a BIP44 path
+/// (`m/purpose'/coin'/account'/change/index`) are derived in windows of the gap limit, external chain only,
+/// until `gapLimit` consecutive addresses are unused on every coin of the chain.
+/// Shorter paths have one address per account, with the account at the third level when there is one.
+/// Hardened prefixes shared by chains (e.g. `m/44'` or `m/44'/60'/0'`) are derived once, via a node cache.
+class AccountDiscovery {
+public:
+    /// Tells whether an address has transactions on the chain of its coin, usually by querying it.
+    /// Called from worker threads, once per coin and address.
+    using UsageCheck = std::function<bool(const DiscoveredAddress&)>;
+
+    /// Receives each address as soon as its usage is known; calls are serialized, in no particular order across chains.
+    using Callback = std::function<void(const DiscoveredAddress&, bool used)>;
+
+    /// A chain of addresses in the plan.
+    struct Chain {
+        /// Coins and derivations sharing the addresses, the first one derives them.
+        std::vector<DiscoveryRequest> members;
+        uint32_t account;
+        /// Derivation path of the first address.
+        DerivationPath path;
+        /// Whether the path has change and address levels, so addresses are scanned up to the gap limit.
+        bool gapScan;
+    };
+
+    /// Plans the scan of `requests`.
+    ///
+    /// @throws std::invalid_argument if an account range overflows.
+    AccountDiscovery(const HDWallet<>& wallet, const std::vector<DiscoveryRequest>& requests);
+
+    /// Address chains to scan, in request order.
+    const std::vector<Chain>& plan() const { return chains; }
+
+    /// Scans the plan on `threads` worker threads (0 uses the hardware concurrency, 1 the calling thread),
+    /// streaming every address to `onAddress`. Returns the used addresses, grouped by chain in plan order.
+    /// The first exception thrown by a callback stops the scan and is rethrown.
+    std::vector<DiscoveredAddress> run(const UsageCheck& isUsed, const Callback& onAddress = nullptr, std::size_t threads = 0) const;
+
+private:
+    /// Copy of the wallet with a node cache for the shared prefixes.
+    HDWallet<> wallet;
+    std::vector<Chain> chains;
+
+    void scanChain(const Chain& chain, const UsageCheck& isUsed, const std::function<void(const DiscoveredAddress&, bool)>& report) const;
+};
+
+} // namespace TW
@@ -0,0 +1,276 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressIndex.h"
+
+#include "BinaryCoding.h"
+#include "ExtendedPublicKey.h"
+#include "Hash.h"
+#include "algorithm/parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TW {
+
+namespace {
+
+constexpr std::array<uint8_t, 4> magic = {'T', 'W', 'A', 'I'};
+constexpr uint32_t version = 1;
+constexpr std::size_t headerSize = 32;
+constexpr std::size_t hashSize = 16;
+constexpr std::size_t entrySize = 32;
+constexpr uint32_t hardenedIndex = 0x80000000;
+/// Addresses derived per task when building.
+constexpr uint32_t chunkSize = 256;
+
+using Entry = std::array<uint8_t, entrySize>;
+
+/// Bloom filter probe positions, from the digest bytes not stored in the entries.
+class BloomProbe {
+public:
+    BloomProbe(const uint8_t* digest, uint64_t bits) noexcept
+        : first(decode64LE(digest + hashSize)), step(decode64LE(digest + hashSize + 8) | 1), bits(bits) {}
+
+    uint64_t position(uint32_t i) const noexcept { return (first + i * step) % bits; }
+
+private:
+    uint64_t first;
+    uint64_t step;
+    uint64_t bits;
+};
+
+bool bloomContains(const uint8_t* bloom, uint64_t bits, uint32_t hashes, const Hash::Digest32& digest) noexcept {
+    const auto probe = BloomProbe(digest.data(), bits);
+    for (uint32_t i = 0; i < hashes; ++i) {
+        const auto bit = probe.position(i);
+        if ((bloom[bit / 8] & (1u << (bit % 8))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Hash::Digest32 addressDigest(const std::string& address) {
+    return Hash::sha256Into(reinterpret_cast<const byte*>(address.data()), address.size());
+}
+
+void storeLE(uint32_t value, uint8_t* out) noexcept {
+    for (auto i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+} // namespace
+
+std::size_t AddressIndex::build(const std::string& path, const std::vector<Source>& sources, const Options& options) {
+    if (options.changeCount > hardenedIndex || static_cast<uint64_t>(options.startIndex) + options.count > hardenedIndex) {
+        throw std::invalid_argument("Address index out of range");
+    }
+
+    struct Branch {
+        ExtendedPublicKey key;
+        const Source* source;
+        uint32_t account;
+        uint32_t change;
+    };
+    std::vector<Branch> branches;
+    branches.reserve(sources.size() * options.changeCount);
+    for (const auto& source : sources) {
+        const auto key = ExtendedPublicKey::parse(source.extendedPublicKey, source.coin);
+        if (!key) {
+            throw std::invalid_argument("Invalid extended public key");
+        }
+        for (uint32_t change = 0; change < options.changeCount; ++change) {
+            auto branch = key->derive(change);
+            if (!branch) {
+                throw std::invalid_argument("Invalid extended public key");
+            }
+            branches.push_back(Branch{*branch, &source, key->childNumber() & ~hardenedIndex, change});
+        }
+    }
+
+    // derive in chunks of consecutive indices, each entry written in place;
+    // the digests are kept whole for the Bloom filter, which doesn't depend on the order
+    const std::size_t chunksPerBranch = (options.count + chunkSize - 1) / chunkSize;
+    std::vector<Entry> entries(branches.size() * options.count);
+    std::vector<Hash::Digest32> digests(entries.size());
+    parallelFor(branches.size() * chunksPerBranch, options.threads, [&](std::size_t task) {
+        const auto& branch = branches[task / chunksPerBranch];
+        const auto first = static_cast<uint32_t>(task % chunksPerBranch) * chunkSize;
+        const auto last = std::min(first + chunkSize, options.count);
+        const auto position = (task / chunksPerBranch) * options.count;
+        for (auto offset = first; offset < last; ++offset) {
+            const auto index = options.startIndex + offset;
+            const auto child = branch.key.derive(index);
+            if (!child) {
+                throw std::runtime_error("Child derivation failed");
+            }
+            auto& digest = digests[position + offset];
+            auto& entry = entries[position + offset];
+            digest = addressDigest(child->address(branch.source->derivation));
+            std::copy(digest.begin(), digest.begin() + hashSize, entry.begin());
+            storeLE(static_cast<uint32_t>(branch.source->coin), entry.data() + hashSize);
+            storeLE(branch.account, entry.data() + hashSize + 4);
+            storeLE(branch.change, entry.data() + hashSize + 8);
+            storeLE(index, entry.data() + hashSize + 12);
+        }
+    });
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return std::memcmp(lhs.data(), rhs.data(), hashSize) < 0;
+    });
+
+    // Bloom filter over whole 64-bit words
+    uint64_t bloomBits = 0;
+    uint32_t bloomHashes = 0;
+    std::vector<uint8_t> bloom;
+    if (options.bloomBitsPerAddress > 0 && !entries.empty()) {
+        bloomBits = (std::max<uint64_t>(entries.size() * options.bloomBitsPerAddress, 64) + 63) / 64 * 64;
+        bloomHashes = std::clamp(static_cast<uint32_t>(std::lround(options.bloomBitsPerAddress * std::log(2.0))), 1u, 16u);
+        bloom.resize(bloomBits / 8);
+        for (const auto& digest : digests) {
+            const auto probe = BloomProbe(digest.data(), bloomBits);
+            for (uint32_t i = 0; i < bloomHashes; ++i) {
+                const auto bit = probe.position(i);
+                bloom[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+            }
+        }
+    }
+
+    Data header(magic.begin(), magic.end());
+    encode32LE(version, header);
+    encode64LE(entries.size(), header);
+    encode64LE(bloomBits, header);
+    encode32LE(bloomHashes, header);
+    encode32LE(0, header);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(bloom.data()), static_cast<std::streamsize>(bloom.size()));
+    file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * entrySize));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write address index");
+    }
+    return entries.size();
+}
+
+AddressIndex::AddressIndex(const std::string& path) {
+#ifdef _WIN32
+    const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open address index");
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(headerSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Invalid address index");
+    }
+    mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mappingHandle == nullptr) {
+        throw std::runtime_error("Failed to map address index");
+    }
+    mapping = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (mapping == nullptr) {
+        CloseHandle(mappingHandle);
+        throw std::runtime_error("Failed to map address index");
+    }
+#else
+    const auto file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Failed to open address index");
+    }
+    struct stat status {};
+    if (fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(headerSize)) {
+        close(file);
+        throw std::runtime_error("Invalid address index");
+    }
+    mappingSize = static_cast<std::size_t>(status.st_size);
+    auto* pointer = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (pointer == MAP_FAILED) {
+        throw std::runtime_error("Failed to map address index");
+    }
+    mapping = static_cast<const uint8_t*>(pointer);
+#endif
+
+    count = static_cast<std::size_t>(decode64LE(mapping + 8));
+    bloomBits = decode64LE(mapping + 16);
+    bloomHashes = decode32LE(mapping + 24);
+    const auto valid = std::equal(magic.begin(), magic.end(), mapping) && decode32LE(mapping + 4) == version &&
+                       bloomBits % 64 == 0 && (bloomBits == 0) == (bloomHashes == 0) &&
+                       count <= (mappingSize - headerSize) / entrySize &&
+                       mappingSize == headerSize + bloomBits / 8 + count * entrySize;
+    if (!valid) {
+        unmap();
+        throw std::runtime_error("Invalid address index");
+    }
+    bloom = mapping + headerSize;
+    entries = bloom + bloomBits / 8;
+}
+
+AddressIndex::~AddressIndex() {
+    unmap();
+}
+
+void AddressIndex::unmap() noexcept {
+    if (mapping == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(mappingHandle);
+#else
+    munmap(const_cast<uint8_t*>(mapping), mappingSize);
+#endif
+    mapping = nullptr;
+}
+
+bool AddressIndex::mayContain(const std::string& address) const {
+    return bloomBits == 0 || bloomContains(bloom, bloomBits, bloomHashes, addressDigest(address));
+}
+
+std::optional<AddressIndex::Location> AddressIndex::find(const std::string& address) const {
+    const auto digest = addressDigest(address);
+    if (bloomBits != 0 && !bloomContains(bloom, bloomBits, bloomHashes, digest)) {
+        return std::nullopt;
+    }
+
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        const auto* entry = entries + middle * entrySize;
+        const auto order = std::memcmp(entry, digest.data(), hashSize);
+        if (order == 0) {
+            const auto* fields = entry + hashSize;
+            return Location{static_cast<TWCoinType>(decode32LE(fields)), decode32LE(fields + 4), decode32LE(fields + 8), decode32LE(fields + 12)};
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace TW
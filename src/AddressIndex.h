@@ -0,0 +1,99 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWDerivation.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Read-only, memory-mapped index from addresses to where they are derived in watch-only HD accounts, for
+/// attributing incoming deposits without deriving addresses.
+///
+/// The index file is built from account-level extended public keys with `build`. It holds a header, an optional
+/// Bloom filter and entries sorted by address hash, each 32 bytes: the first 16 bytes of the SHA256 of the address,
+/// then the coin, account, change and address index (little-endian). Lookups hash the address, check the Bloom filter,
+/// then binary search the entries; the mapping is shared and only the pages touched are resident.
+/// Addresses are compared as strings, in the form the coin derives them (e.g. EIP-55 checksummed for Ethereum).
+class AddressIndex {
+public:
+    /// An account-level extended public key (e.g. at `m/44'/0'/0'`).
+    struct Source {
+        std::string extendedPublicKey;
+        TWCoinType coin;
+        TWDerivation derivation = TWDerivationDefault;
+    };
+
+    struct Location {
+        TWCoinType coin;
+        /// Child number of the extended public key without the hardened bit, the account of a BIP44 account key.
+        uint32_t account;
+        uint32_t change;
+        uint32_t index;
+
+        bool operator==(const Location&) const = default;
+    };
+
+    struct Options {
+        /// Change branches `0 ..< changeCount` are indexed, 2 for the external and internal chains.
+        uint32_t changeCount = 2;
+        /// Address indices `startIndex ..< startIndex + count` of every branch are indexed.
+        uint32_t startIndex = 0;
+        uint32_t count = 1000;
+        /// Size of the Bloom filter in bits per address, 0 for none; 10 gives about 1% false positives.
+        uint32_t bloomBitsPerAddress = 10;
+        /// Number of derivation threads, 0 means hardware concurrency.
+        std::size_t threads = 1;
+    };
+
+    /// Derives the addresses of `sources` and writes the index to `path`, replacing any existing file.
+    /// Returns the number of addresses.
+    /// Throws std::invalid_argument on an invalid extended public key or index range, std::runtime_error on write errors.
+    static std::size_t build(const std::string& path, const std::vector<Source>& sources, const Options& options);
+
+    /// Maps the index file at `path`.
+    /// Throws std::runtime_error if it can't be mapped or isn't a valid index.
+    explicit AddressIndex(const std::string& path);
+    ~AddressIndex();
+
+    AddressIndex(const AddressIndex&) = delete;
+    AddressIndex& operator=(const AddressIndex&) = delete;
+
+    /// Returns where `address` is derived, or nullopt if it isn't in the index.
+    std::optional<Location> find(const std::string& address) const;
+
+    /// Checks `address` against the Bloom filter only: false means it is not in the index.
+    /// Always true without a filter.
+    bool mayContain(const std::string& address) const;
+
+    /// Number of addresses.
+    std::size_t size() const { return count; }
+
+    bool hasBloomFilter() const { return bloomBits != 0; }
+
+private:
+    void unmap() noexcept;
+
+    const uint8_t* mapping = nullptr;
+    std::size_t mappingSize = 0;
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#endif
+    std::size_t count = 0;
+    uint64_t bloomBits = 0;
+    uint32_t bloomHashes = 0;
+    const uint8_t* bloom = nullptr;
+    const uint8_t* entries = nullptr;
+};
+
+} // namespace TW
@@ -28,7 +28,7 @@ Address::Address(const PublicKey& publicKey) {
         throw std::invalid_argument("Invalid public key type");
     }
 
-    bytes = publicKey.bytes;
+    bytes = Data(publicKey.bytes);
 }
 
 /// Initializes an address from a string representation.
@@ -43,7 +43,9 @@ Address::Address(const std::string& string) {
 
 /// Returns a string representation of the Aeternity address.
 std::string Address::string() const {
-    return Identifiers::prefixAccountPubkey + Base58::encodeCheck(bytes);
+    auto string = std::string(Identifiers::prefixAccountPubkey);
+    Base58::appendEncodedCheck(bytes.data(), bytes.size(), string);
+    return string;
 }
 
 bool Address::checkType(const std::string& type) {
@@ -6,20 +6,22 @@
 
 #pragma once
 
-#include <string>
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 /// refers to https://github.com/aeternity/aepp-sdk-go/blob/07aa8a77e5/aeternity/identifiers.go
 namespace TW::Aeternity::Identifiers {
 
 /// default network id
-static const std::string networkId = "ae_mainnet";
+inline constexpr std::string_view networkId = "ae_mainnet";
 
 /// Base58 prefixes
-static const std::string prefixAccountPubkey = "ak_";
-static const std::string prefixSignature = "sg_";
+inline constexpr std::string_view prefixAccountPubkey = "ak_";
+inline constexpr std::string_view prefixSignature = "sg_";
 
 /// Base 64 encoded transactions
-static const std::string prefixTransaction = "tx_";
+inline constexpr std::string_view prefixTransaction = "tx_";
 
 /// version used in the rlp message
 static const uint8_t rlpMessageVersion = 1;
@@ -29,6 +31,10 @@ static const uint8_t rlpMessageVersion = 1;
 static const uint64_t objectTagSignedTransaction = 11;
 static const uint64_t objectTagSpendTransaction = 12;
 
+/// RLP encodings of the leading fields of the spend and signed transactions: object tag, then version
+inline constexpr std::array<uint8_t, 2> rlpSpendTransactionHeader = {objectTagSpendTransaction, rlpMessageVersion};
+inline constexpr std::array<uint8_t, 2> rlpSignedTransactionHeader = {objectTagSignedTransaction, rlpMessageVersion};
+
 /// Tag constant for ids
 /// \see https://github.com/aeternity/protocol/blob/master/serializations.md#the-id-type
 static const uint8_t iDTagAccount = 1;
@@ -37,7 +37,8 @@ Proto::SigningOutput Signer::sign(const TW::PrivateKey& privateKey, Transaction&
 
     /// sign ed25519
     auto sigRaw = privateKey.sign(msg, TWCurveED25519);
-    auto signature = Identifiers::prefixSignature + Base58::encodeCheck(sigRaw);
+    auto signature = std::string(Identifiers::prefixSignature);
+    Base58::appendEncodedCheck(sigRaw.data(), sigRaw.size(), signature);
 
     /// encode the message using rlp
     auto rlpTxRaw = buildRlpTxRaw(txRlp, sigRaw);
@@ -49,22 +50,21 @@ Proto::SigningOutput Signer::sign(const TW::PrivateKey& privateKey, Transaction&
 }
 
 Data Signer::buildRlpTxRaw(Data& txRaw, Data& sigRaw) {
-    auto rlpTxRaw = Data();
-    auto signaturesList = Data();
-    append(signaturesList, Ethereum::RLP::encode(sigRaw));
-
-    append(rlpTxRaw, Ethereum::RLP::encode(Identifiers::objectTagSignedTransaction));
-    append(rlpTxRaw, Ethereum::RLP::encode(Identifiers::rlpMessageVersion));
-    append(rlpTxRaw, Ethereum::RLP::encodeList(signaturesList));
-    append(rlpTxRaw, Ethereum::RLP::encode(txRaw));
-
-    return Ethereum::RLP::encodeList(rlpTxRaw);
+    return Ethereum::RLP::encodeWith([&](Ethereum::RLP::Writer& writer) {
+        writer.beginList();
+        writer.appendEncoded(Identifiers::rlpSignedTransactionHeader);
+        writer.beginList();
+        writer.append(sigRaw);
+        writer.endList();
+        writer.append(txRaw);
+        writer.endList();
+    });
 }
 
 Data Signer::buildMessageToSign(Data& txRaw) {
     auto data = Data();
-    Data bytes(Identifiers::networkId.begin(), Identifiers::networkId.end());
-    append(data, bytes);
+    data.reserve(Identifiers::networkId.size() + txRaw.size());
+    data.insert(data.end(), Identifiers::networkId.begin(), Identifiers::networkId.end());
     append(data, txRaw);
     return data;
 }
@@ -77,15 +77,18 @@ Proto::SigningOutput Signer::createProtoOutput(std::string& signature, const std
     return output;
 }
 
-std::string Signer::encodeBase64WithChecksum(const std::string& prefix, const TW::Data& rawTx) {
-    auto checksum = Hash::sha256(Hash::sha256(rawTx));
-    std::vector<unsigned char> checksumPart(checksum.begin(), checksum.begin() + checkSumSize);
+std::string Signer::encodeBase64WithChecksum(std::string_view prefix, const TW::Data& rawTx) {
+    Hash::Digest32 checksum;
+    Hash::sha256dInto(rawTx.data(), rawTx.size(), checksum);
 
     auto data = Data();
+    data.reserve(rawTx.size() + checkSumSize);
     append(data, rawTx);
-    append(data, checksumPart);
+    data.insert(data.end(), checksum.begin(), checksum.begin() + checkSumSize);
 
-    return prefix + TW::Base64::encode(data);
+    auto encoded = std::string(prefix);
+    encoded += TW::Base64::encode(data);
+    return encoded;
 }
 
 } // namespace TW::Aeternity
@@ -10,6 +10,8 @@
 #include "../proto/Aeternity.pb.h"
 #include <PrivateKey.h>
 
+#include <string_view>
+
 namespace TW::Aeternity {
 
 class Signer {
@@ -30,7 +32,7 @@ private:
     static Proto::SigningOutput createProtoOutput(std::string& signature, const std::string& signedTx);
 
     /// Encode a byte array into base64 with prefix and a checksum
-    static std::string encodeBase64WithChecksum(const std::string& prefix, const TW::Data& rawTx);
+    static std::string encodeBase64WithChecksum(std::string_view prefix, const TW::Data& rawTx);
 };
 
 } // namespace TW::Aeternity
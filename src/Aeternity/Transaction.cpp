@@ -10,30 +10,44 @@
 #include <Ethereum/RLP.h>
 #include <Hash.h>
 
+#include <span>
+
 namespace TW::Aeternity {
 
 /// RLP returns a byte serialized representation
+/// Appends a non-negative integer, zero as a zero byte rather than as an empty string (see `encodeSafeZero`).
+static void appendSafeZero(Ethereum::RLP::Writer& writer, const uint256_t& value) {
+    static const Data zero = {0};
+    if (value == 0) {
+        writer.append(zero);
+    } else {
+        writer.append(value);
+    }
+}
+
 Data Transaction::encode() {
-    auto encoded = Data();
-    append(encoded, Ethereum::RLP::encode(Identifiers::objectTagSpendTransaction));
-    append(encoded, Ethereum::RLP::encode(Identifiers::rlpMessageVersion));
-    append(encoded, Ethereum::RLP::encode(buildTag(sender_id)));
-    append(encoded, Ethereum::RLP::encode(buildTag(recipient_id)));
-    append(encoded, encodeSafeZero(amount));
-    append(encoded, encodeSafeZero(fee));
-    append(encoded, encodeSafeZero(ttl));
-    append(encoded, encodeSafeZero(nonce));
-    append(encoded, Ethereum::RLP::encode(payload));
-
-    const Data& raw = Ethereum::RLP::encodeList(encoded);
-    return raw;
+    // the tags are decoded once, the writer runs twice
+    const auto senderTag = buildTag(sender_id);
+    const auto recipientTag = buildTag(recipient_id);
+    const auto payloadBytes = std::span(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    return Ethereum::RLP::encodeWith([&](Ethereum::RLP::Writer& writer) {
+        writer.beginList();
+        writer.appendEncoded(Identifiers::rlpSpendTransactionHeader);
+        writer.append(senderTag);
+        writer.append(recipientTag);
+        appendSafeZero(writer, amount);
+        appendSafeZero(writer, fee);
+        appendSafeZero(writer, ttl);
+        appendSafeZero(writer, nonce);
+        writer.append(payloadBytes);
+        writer.endList();
+    });
 }
 
 TW::Data Transaction::buildTag(const std::string& address) {
     auto payload = address.substr(Identifiers::prefixTransaction.size(), address.size());
 
-    auto data = Data();
-    append(data, Identifiers::iDTagAccount);
+    auto data = Data{Identifiers::iDTagAccount};
     append(data, Base58::decodeCheck(payload));
 
     return data;
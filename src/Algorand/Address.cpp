@@ -12,15 +12,13 @@
 namespace TW::Algorand {
 
 bool Address::isValid(const std::string& string) {
-    if (string.size() != encodedSize) {
-        return false;
-    }
-    Data decoded;
-    if (!Base32::decode(string, decoded)) {
+    static_assert(Base32::encodedSize(PublicKey::ed25519Size + checksumSize) == encodedSize);
+    std::array<byte, PublicKey::ed25519Size + checksumSize> decoded;
+    if (!Base32::decodeArray(string, decoded)) {
         return false;
     }
     // compute public key hash
-    auto hash = Hash::sha512_256(decoded.data(), decoded.size() - checksumSize);
+    auto hash = Hash::sha512_256(decoded.data(), PublicKey::ed25519Size);
     // last 4 bytes are checksum
     std::array<byte, checksumSize> checksum;
     std::copy(hash.end() - checksumSize, hash.end(), checksum.data());
@@ -35,8 +33,8 @@ Address::Address(const std::string& string) {
     if (!isValid(string)) {
         throw std::invalid_argument("Invalid address string");
     }
-    Data decoded;
-    if (!Base32::decode(string, decoded)) {
+    std::array<byte, PublicKey::ed25519Size + checksumSize> decoded;
+    if (!Base32::decodeArray(string, decoded)) {
         throw std::invalid_argument("Invalid address string");
     }
     std::copy(decoded.begin(), decoded.begin() + PublicKey::ed25519Size, bytes.begin());
@@ -51,15 +49,13 @@ Address::Address(const PublicKey& publicKey) {
 
 std::string Address::string() const {
     auto hash = Hash::sha512_256(bytes);
-    const size_t dataSize = PublicKey::ed25519Size + checksumSize;
-    Data data;
-    data.resize(dataSize);
+    std::array<byte, PublicKey::ed25519Size + checksumSize> data;
 
     // base32_encode(publickey + checksum)
     std::copy(bytes.begin(), bytes.end(), data.data());
     std::copy(hash.end() - checksumSize, hash.end(), data.data() + PublicKey::ed25519Size);
-    std::string encoded = Base32::encode(data);
-    return encoded;
+    const auto encoded = Base32::encodeArray(data);
+    return {encoded.begin(), encoded.end()};
 }
 
 } // namespace TW::Algorand
@@ -8,11 +8,18 @@
 
 #include "BinaryCoding.h"
 #include "Data.h"
+#include "../Hash.h"
 
 namespace TW::Algorand {
 
+/// Domain separation prefix of signed transactions, "TX".
+inline constexpr std::array<byte, 2> TRANSACTION_TAG = {'T', 'X'};
+
 class BaseTransaction {
 public:
+    /// ID of the atomic group the transaction is part of (32 bytes), empty if none.
+    Data group;
+
     virtual ~BaseTransaction() noexcept = default;
     virtual Data serialize() const = 0;
     virtual Data serialize(const Data& signature) const {
@@ -22,18 +29,45 @@ public:
             "txn": <encoded transaction object>,
         }
         */
+        const auto transaction = serialize();
         Data data;
+        data.reserve(1 + Keys::sig.size() + 2 + signature.size() + Keys::txn.size() + transaction.size());
         // encode map length
         data.push_back(0x80 + 2);
         // signature
-        encodeString("sig", data);
+        encodeKey(Keys::sig, data);
         encodeBytes(signature, data);
 
         // transaction
-        encodeString("txn", data);
-        append(data, serialize());
+        encodeKey(Keys::txn, data);
+        append(data, transaction);
+        return data;
+    }
+
+    /// The bytes to sign: the "TX" prefix followed by the encoded transaction.
+    Data signingMessage() const {
+        const auto transaction = serialize();
+        Data data;
+        data.reserve(TRANSACTION_TAG.size() + transaction.size());
+        data.insert(data.end(), TRANSACTION_TAG.begin(), TRANSACTION_TAG.end());
+        append(data, transaction);
         return data;
     }
+
+    /// The transaction ID hash, as used in atomic groups.
+    Data id() const { return Hash::sha512_256(signingMessage()); }
+
+protected:
+    /// Number of bytes to reserve for encoding a transaction, besides its variable-size fields.
+    static constexpr std::size_t encodedSizeHint = 256;
+
+    /// Encodes the optional group ID field.
+    void encodeGroup(Data& data) const {
+        if (!group.empty()) {
+            encodeKey(Keys::grp, data);
+            encodeBytes(group, data);
+        }
+    }
 };
 
 } // namespace TW::Algorand
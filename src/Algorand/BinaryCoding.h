@@ -9,34 +9,78 @@
 #include "Data.h"
 #include "../BinaryCoding.h"
 
+#include <array>
+#include <string_view>
+
 namespace TW::Algorand {
 
 #pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
 #pragma GCC diagnostic ignored "-Wunused-function"
 
-static inline void encodeString(std::string string, Data& data) {
+static inline void encodeString(std::string_view string, Data& data) {
     // encode string header
-    auto bytes = Data(string.begin(), string.end());
-    if (bytes.size() < 0x20) {
+    const auto size = string.size();
+    if (size < 0x20) {
         // fixstr
-        data.push_back(static_cast<uint8_t>(0xa0 + bytes.size()));
-    } else if (bytes.size() < 0x100) {
+        data.push_back(static_cast<uint8_t>(0xa0 + size));
+    } else if (size < 0x100) {
         // str 8
         data.push_back(static_cast<uint8_t>(0xd9));
-        data.push_back(static_cast<uint8_t>(bytes.size()));
-    } else if (bytes.size() < 0x10000) {
+        data.push_back(static_cast<uint8_t>(size));
+    } else if (size < 0x10000) {
         // str 16
         data.push_back(static_cast<uint8_t>(0xda));
-        encode16BE(static_cast<uint16_t>(bytes.size()), data);
-    } else if (bytes.size() < 0x100000000) { // depending on size_t size on platform, may be always true 
+        encode16BE(static_cast<uint16_t>(size), data);
+    } else if (size < 0x100000000) { // depending on size_t size on platform, may be always true 
         // str 32
         data.push_back(static_cast<uint8_t>(0xdb));
-        encode32BE(static_cast<uint32_t>(bytes.size()), data);
+        encode32BE(static_cast<uint32_t>(size), data);
     } else {
         // too long string
         return;
     }
-    append(data, bytes);
+    data.insert(data.end(), string.begin(), string.end());
+}
+
+/// A map key, msgpack encoded at compile time (as a fixstr).
+template <std::size_t N>
+using EncodedKey = std::array<byte, N>;
+
+template <std::size_t N>
+constexpr EncodedKey<N> encodeKey(const char (&name)[N]) {
+    static_assert(N - 1 < 0x20, "keys are encoded as fixstr");
+    EncodedKey<N> key{};
+    key[0] = static_cast<byte>(0xa0 + N - 1);
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        key[i + 1] = static_cast<byte>(name[i]);
+    }
+    return key;
+}
+
+/// The keys of transaction fields.
+namespace Keys {
+inline constexpr auto aamt = encodeKey("aamt");
+inline constexpr auto amt = encodeKey("amt");
+inline constexpr auto arcv = encodeKey("arcv");
+inline constexpr auto fee = encodeKey("fee");
+inline constexpr auto fv = encodeKey("fv");
+inline constexpr auto gen = encodeKey("gen");
+inline constexpr auto gh = encodeKey("gh");
+inline constexpr auto grp = encodeKey("grp");
+inline constexpr auto lv = encodeKey("lv");
+inline constexpr auto note = encodeKey("note");
+inline constexpr auto rcv = encodeKey("rcv");
+inline constexpr auto sig = encodeKey("sig");
+inline constexpr auto snd = encodeKey("snd");
+inline constexpr auto txlist = encodeKey("txlist");
+inline constexpr auto txn = encodeKey("txn");
+inline constexpr auto type = encodeKey("type");
+inline constexpr auto xaid = encodeKey("xaid");
+} // namespace Keys
+
+template <std::size_t N>
+static inline void encodeKey(const EncodedKey<N>& key, Data& data) {
+    data.insert(data.end(), key.begin(), key.end());
 }
 
 static inline void encodeNumber(uint64_t number, Data& data) {
@@ -62,8 +106,7 @@ static inline void encodeNumber(uint64_t number, Data& data) {
     }
 }
 
-static inline void encodeBytes(const Data& bytes, Data& data) {
-    auto size = bytes.size();
+static inline void encodeBytes(const byte* bytes, std::size_t size, Data& data) {
     if (size < 0x100) {
         // bin 8
         data.push_back(static_cast<uint8_t>(0xc4));
@@ -80,7 +123,31 @@ static inline void encodeBytes(const Data& bytes, Data& data) {
         // too long binary
         return;
     }
-    append(data, bytes);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+static inline void encodeBytes(const Data& bytes, Data& data) {
+    encodeBytes(bytes.data(), bytes.size(), data);
+}
+
+template <std::size_t N>
+static inline void encodeBytes(const std::array<byte, N>& bytes, Data& data) {
+    encodeBytes(bytes.data(), bytes.size(), data);
+}
+
+static inline void encodeArrayHeader(std::size_t size, Data& data) {
+    if (size < 0x10) {
+        // fixarray
+        data.push_back(static_cast<uint8_t>(0x90 + size));
+    } else if (size < 0x10000) {
+        // array 16
+        data.push_back(static_cast<uint8_t>(0xdc));
+        encode16BE(static_cast<uint16_t>(size), data);
+    } else {
+        // array 32
+        data.push_back(static_cast<uint8_t>(0xdd));
+        encode32BE(static_cast<uint32_t>(size), data);
+    }
 }
 
 } // namespace TW::Algorand
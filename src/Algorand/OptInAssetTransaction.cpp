@@ -11,6 +11,7 @@ namespace TW::Algorand {
 
 Data OptInAssetTransaction::serialize() const {
     Data data;
+    data.reserve(encodedSizeHint + note.size() + genesisId.size() + genesisHash.size() + group.size());
 
     // encode map length
     uint8_t size = 9;
@@ -18,39 +19,45 @@ Data OptInAssetTransaction::serialize() const {
         // note is optional
         size += 1;
     }
+    if (!group.empty()) {
+        // group is optional
+        size += 1;
+    }
     data.push_back(0x80 + size);
 
     // encode fields one by one (sorted by name)
-    encodeString("arcv", data);
-    encodeBytes(Data(address.bytes.begin(), address.bytes.end()), data);
+    encodeKey(Keys::arcv, data);
+    encodeBytes(address.bytes, data);
 
-    encodeString("fee", data);
+    encodeKey(Keys::fee, data);
     encodeNumber(fee, data);
 
-    encodeString("fv", data);
+    encodeKey(Keys::fv, data);
     encodeNumber(firstRound, data);
 
-    encodeString("gen", data);
+    encodeKey(Keys::gen, data);
     encodeString(genesisId, data);
 
-    encodeString("gh", data);
+    encodeKey(Keys::gh, data);
     encodeBytes(genesisHash, data);
 
-    encodeString("lv", data);
+    encodeGroup(data);
+
+    encodeKey(Keys::lv, data);
     encodeNumber(lastRound, data);
 
     if (!note.empty()) {
-        encodeString("note", data);
+        encodeKey(Keys::note, data);
         encodeBytes(note, data);
     }
 
-    encodeString("snd", data);
-    encodeBytes(Data(address.bytes.begin(), address.bytes.end()), data);
+    encodeKey(Keys::snd, data);
+    encodeBytes(address.bytes, data);
 
-    encodeString("type", data);
+    encodeKey(Keys::type, data);
     encodeString(type, data);
 
-    encodeString("xaid", data);
+    encodeKey(Keys::xaid, data);
     encodeNumber(assetId, data);
 
     return data;
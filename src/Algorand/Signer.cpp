@@ -9,18 +9,24 @@
 #include "BaseTransaction.h"
 #include "Base64.h"
 #include "../HexCoding.h"
+#include "../proto/Algorand.json.pb.h"
 
-#include <google/protobuf/util/json_util.h>
+#include <array>
+#include <memory>
+#include <stdexcept>
 
 namespace TW::Algorand {
 
-const Data TRANSACTION_TAG = {84, 88};
 const std::string TRANSACTION_PAY = "pay";
 const std::string ASSET_TRANSACTION = "axfer";
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto protoOutput = Proto::SigningOutput();
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+/// Domain separation prefix of transaction groups, "TG".
+constexpr std::array<byte, 2> GROUP_TAG = {'T', 'G'};
+
+namespace {
+
+/// Builds the transaction of the input, sent from the account of `key`; null if the input has no message.
+std::unique_ptr<BaseTransaction> transactionFromInput(const Proto::SigningInput& input, const PrivateKey& key) {
     auto pubkey = key.getPublicKey(TWPublicKeyTypeED25519);
     auto from = Address(pubkey);
     auto firstRound = input.first_round();
@@ -34,51 +40,103 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         auto message = input.transfer();
         auto to = Address(message.to_address());
 
-        auto transaction = Transfer(from, to, fee, message.amount(), firstRound,
-                                    lastRound, note, TRANSACTION_PAY, genesisId, genesisHash);
-        auto signature = sign(key, transaction);
-        auto serialized = transaction.BaseTransaction::serialize(signature);
-        protoOutput.set_encoded(serialized.data(), serialized.size());
-        protoOutput.set_signature(Base64::encode(signature));
+        return std::make_unique<Transfer>(from, to, fee, message.amount(), firstRound,
+                                          lastRound, note, TRANSACTION_PAY, genesisId, genesisHash);
     } else if (input.has_asset_transfer()) {
         auto message = input.asset_transfer();
         auto to = Address(message.to_address());
 
-        auto transaction =
-            AssetTransfer(from, to, fee, message.amount(),
-                          message.asset_id(), firstRound, lastRound, note,
-                          ASSET_TRANSACTION, genesisId, genesisHash);
-        auto signature = sign(key, transaction);
-        auto serialized = transaction.BaseTransaction::serialize(signature);
-        protoOutput.set_encoded(serialized.data(), serialized.size());
-        protoOutput.set_signature(Base64::encode(signature));
+        return std::make_unique<AssetTransfer>(from, to, fee, message.amount(),
+                                               message.asset_id(), firstRound, lastRound, note,
+                                               ASSET_TRANSACTION, genesisId, genesisHash);
     } else if (input.has_asset_opt_in()) {
         auto message = input.asset_opt_in();
 
-        auto transaction = OptInAssetTransaction(from, fee, message.asset_id(),
-                                                 firstRound, lastRound, note,
-                                                 ASSET_TRANSACTION, genesisId, genesisHash);
-        auto signature = sign(key, transaction);
-        auto serialized = transaction.BaseTransaction::serialize(signature);
-        protoOutput.set_encoded(serialized.data(), serialized.size());
-        protoOutput.set_signature(Base64::encode(signature));
+        return std::make_unique<OptInAssetTransaction>(from, fee, message.asset_id(),
+                                                       firstRound, lastRound, note,
+                                                       ASSET_TRANSACTION, genesisId, genesisHash);
     }
+    return nullptr;
+}
 
+Proto::SigningOutput signTransaction(const PrivateKey& key, const BaseTransaction& transaction) {
+    auto protoOutput = Proto::SigningOutput();
+    auto signature = Signer::sign(key, transaction);
+    auto serialized = transaction.serialize(signature);
+    protoOutput.set_encoded(serialized.data(), serialized.size());
+    protoOutput.set_signature(Base64::encode(signature));
     return protoOutput;
 }
 
+} // namespace
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    const auto transaction = transactionFromInput(input, key);
+    if (!transaction) {
+        return Proto::SigningOutput();
+    }
+    return signTransaction(key, *transaction);
+}
+
+std::vector<Proto::SigningOutput> Signer::signGroup(const std::vector<Proto::SigningInput>& inputs) {
+    if (inputs.empty() || inputs.size() > maxGroupSize) {
+        throw std::invalid_argument("Invalid transaction group size");
+    }
+
+    std::vector<PrivateKey> keys;
+    std::vector<std::unique_ptr<BaseTransaction>> transactions;
+    std::vector<Data> ids;
+    keys.reserve(inputs.size());
+    transactions.reserve(inputs.size());
+    ids.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        const auto& key = keys.emplace_back(Data(input.private_key().begin(), input.private_key().end()));
+        auto transaction = transactionFromInput(input, key);
+        if (!transaction) {
+            throw std::invalid_argument("Missing transaction message");
+        }
+        ids.push_back(transaction->id());
+        transactions.push_back(std::move(transaction));
+    }
+
+    const auto group = groupId(ids);
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(inputs.size());
+    for (std::size_t i = 0; i < transactions.size(); ++i) {
+        transactions[i]->group = group;
+        outputs.push_back(signTransaction(keys[i], *transactions[i]));
+    }
+    return outputs;
+}
+
+Data Signer::groupId(const std::vector<Data>& transactionIds) {
+    /* The group ID is the hash of the msgpack encoded transaction IDs, with the "TG" prefix:
+    {
+        "txlist": [<transaction id bytes>, ...]
+    }
+    */
+    Data data;
+    data.reserve(GROUP_TAG.size() + 1 + Keys::txlist.size() + 3 + transactionIds.size() * (2 + 32));
+    data.insert(data.end(), GROUP_TAG.begin(), GROUP_TAG.end());
+    data.push_back(0x80 + 1);
+    encodeKey(Keys::txlist, data);
+    encodeArrayHeader(transactionIds.size(), data);
+    for (const auto& id : transactionIds) {
+        encodeBytes(id, data);
+    }
+    return Hash::sha512_256(data);
+}
+
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     return hex(Signer::sign(input).encoded());
 }
 
 Data Signer::sign(const PrivateKey& privateKey, const BaseTransaction& transaction) noexcept {
-    Data data;
-    append(data, TRANSACTION_TAG);
-    append(data, transaction.serialize());
-    auto signature = privateKey.sign(data, TWCurveED25519);
+    auto signature = privateKey.sign(transaction.signingMessage(), TWCurveED25519);
     return {signature.begin(), signature.end()};
 }
 
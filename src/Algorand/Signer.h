@@ -13,6 +13,8 @@
 #include "Data.h"
 #include "../PrivateKey.h"
 
+#include <vector>
+
 namespace TW::Algorand {
 
 /// Helper class that performs Algorand transaction signing.
@@ -20,9 +22,20 @@ class Signer {
   public:
     Signer() = delete;
 
+    /// Maximum number of transactions in an atomic group.
+    static constexpr std::size_t maxGroupSize = 16;
+
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs the transactions of the inputs as an atomic group: the group ID is computed once from all of them,
+    /// then each transaction is signed with the private key of its own input.
+    /// Throws `std::invalid_argument` if the group is empty or too large, or an input has no transaction.
+    static std::vector<Proto::SigningOutput> signGroup(const std::vector<Proto::SigningInput>& inputs);
+
+    /// Computes the ID of an atomic group from the IDs of its transactions (see `BaseTransaction::id`).
+    static Data groupId(const std::vector<Data>& transactionIds);
+
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
 
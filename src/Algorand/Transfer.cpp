@@ -25,6 +25,7 @@ Data Transfer::serialize() const {
     }
     */
     Data data;
+    data.reserve(encodedSizeHint + note.size() + genesisId.size() + genesisHash.size() + group.size());
 
     // encode map length
     uint8_t size = 9;
@@ -32,6 +33,10 @@ Data Transfer::serialize() const {
         // note is optional
         size += 1;
     }
+    if (!group.empty()) {
+        // group is optional
+        size += 1;
+    }
     // don't encode 0 amount
     if (amount == 0) {
         size -= 1;
@@ -40,37 +45,39 @@ Data Transfer::serialize() const {
 
     // encode fields one by one (sorted by name)
     if (amount > 0) {
-        encodeString("amt", data);
+        encodeKey(Keys::amt, data);
         encodeNumber(amount, data);
     }
 
-    encodeString("fee", data);
+    encodeKey(Keys::fee, data);
     encodeNumber(fee, data);
 
-    encodeString("fv", data);
+    encodeKey(Keys::fv, data);
     encodeNumber(firstRound, data);
 
-    encodeString("gen", data);
+    encodeKey(Keys::gen, data);
     encodeString(genesisId, data);
 
-    encodeString("gh", data);
+    encodeKey(Keys::gh, data);
     encodeBytes(genesisHash, data);
 
-    encodeString("lv", data);
+    encodeGroup(data);
+
+    encodeKey(Keys::lv, data);
     encodeNumber(lastRound, data);
 
     if (!note.empty()) {
-        encodeString("note", data);
+        encodeKey(Keys::note, data);
         encodeBytes(note, data);
     }
 
-    encodeString("rcv", data);
-    encodeBytes(Data(to.bytes.begin(), to.bytes.end()), data);
+    encodeKey(Keys::rcv, data);
+    encodeBytes(to.bytes, data);
 
-    encodeString("snd", data);
-    encodeBytes(Data(from.bytes.begin(), from.bytes.end()), data);
+    encodeKey(Keys::snd, data);
+    encodeBytes(from.bytes, data);
 
-    encodeString("type", data);
+    encodeKey(Keys::type, data);
     encodeString(type, data);
     return data;
 }
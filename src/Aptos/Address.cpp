@@ -17,7 +17,7 @@ Address::Address(const PublicKey& publicKey): Address::AptosAddress(publicKey) {
 }
 
 Data Address::getDigest(const PublicKey& publicKey) {
-    auto key_data = publicKey.bytes;
+    auto key_data = Data(publicKey.bytes);
     append(key_data, 0x00);
     return key_data;
 }
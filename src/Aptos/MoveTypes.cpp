@@ -14,9 +14,7 @@ Aptos::ModuleId::ModuleId(Address accountAddress, Identifier name) noexcept
 }
 
 Data ModuleId::accessVector() const noexcept {
-    BCS::Serializer serializer;
-    serializer << static_cast<std::byte>(gCodeTag) << mAccountAddress << mName;
-    return serializer.bytes;
+    return BCS::serialize(static_cast<std::byte>(gCodeTag), mAccountAddress, mName);
 }
 
 std::string ModuleId::string() const noexcept {
@@ -32,13 +30,20 @@ std::string ModuleId::shortString() const noexcept {
 }
 
 Data StructTag::serialize(bool withResourceTag) const noexcept {
+    auto counter = BCS::Serializer::counter();
+    serialize(counter, withResourceTag);
     BCS::Serializer serializer;
+    serializer.bytes.reserve(counter.size());
+    serialize(serializer, withResourceTag);
+    return serializer.bytes;
+}
+
+void StructTag::serialize(BCS::Serializer& stream, bool withResourceTag) const noexcept {
     if (withResourceTag)
     {
-        serializer << gResourceTag;
+        stream << gResourceTag;
     }
-    serializer << mAccountAddress << mModule << mName << mTypeParams;
-    return serializer.bytes;
+    stream << mAccountAddress << mModule << mName << mTypeParams;
 }
 
 StructTag::StructTag(Address accountAddress, Identifier module, Identifier name, std::vector<TypeTag> typeParams) noexcept
@@ -84,15 +89,13 @@ BCS::Serializer& operator<<(BCS::Serializer& stream, TSigner) noexcept {
 }
 
 BCS::Serializer& operator<<(BCS::Serializer& stream, const StructTag& st) noexcept {
-    auto res = st.serialize();
-    stream.add_bytes(begin(res), end(res));
+    st.serialize(stream);
     return stream;
 }
 
 BCS::Serializer& operator<<(BCS::Serializer& stream, const TStructTag& st) noexcept {
     stream << TStructTag::value;
-    auto res = st.st.serialize(false);
-    stream.add_bytes(begin(res), end(res));
+    st.st.serialize(stream, false);
     return stream;
 }
 
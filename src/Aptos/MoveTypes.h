@@ -69,6 +69,8 @@ class StructTag {
 public:
     explicit StructTag(Address accountAddress, Identifier module, Identifier name, std::vector<TypeTag> typeParams) noexcept;
     [[nodiscard]] Data serialize(bool withResourceTag = true) const noexcept;
+    /// Appends the encoding to `stream`, without an intermediate buffer.
+    void serialize(BCS::Serializer& stream, bool withResourceTag = true) const noexcept;
     [[nodiscard]] ModuleId moduleID() const noexcept { return {mAccountAddress, mName}; };
     [[nodiscard]] std::string string() const noexcept;
 
@@ -0,0 +1,98 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PreparedTransfer.h"
+#include "Signer.h"
+
+#include <algorithm>
+
+namespace TW::Aptos {
+
+namespace {
+
+void patch64LE(Data& data, std::size_t offset, std::uint64_t value) noexcept {
+    for (std::size_t i = 0; i < sizeof(value); ++i) {
+        data[offset + i] = static_cast<byte>(value >> (8 * i));
+    }
+}
+
+EntryFunction transferFunction(const ModuleId& module, std::vector<TypeTag> tyArgs) {
+    // placeholders, of the size of the actual arguments
+    std::vector<Data> args{BCS::serialize(Address::zero()), BCS::serialize(std::uint64_t{0})};
+    return EntryFunction(module, "transfer", std::move(tyArgs), std::move(args), nlohmann::json::array({"", ""}));
+}
+
+} // namespace
+
+PreparedTransfer::PreparedTransfer(const Address& sender, const EntryFunction& function, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId) {
+    const TransactionPayload payload = function;
+    const auto payloadEnd = gAptosSaltHash.size() + BCS::serialize(sender, std::uint64_t{0}, payload).size();
+    mMessage = gAptosSaltHash;
+    append(mMessage, BCS::serialize(sender, std::uint64_t{0}, payload, maxGasAmount, gasUnitPrice, std::uint64_t{0}, chainId));
+
+    // the payload ends with the arguments, each prefixed by its size: uleb128(32) recipient, uleb128(8) amount
+    mSequenceNumberOffset = gAptosSaltHash.size() + Address::size;
+    mAmountOffset = payloadEnd - sizeof(std::uint64_t);
+    mRecipientOffset = mAmountOffset - 1 - Address::size;
+    // followed by the max gas amount, gas unit price, expiration and chain id
+    mExpirationOffset = mMessage.size() - 1 - sizeof(std::uint64_t);
+
+    // clang-format off
+    mJson = {
+        {"sender", sender.string()},
+        {"max_gas_amount", std::to_string(maxGasAmount)},
+        {"gas_unit_price", std::to_string(gasUnitPrice)},
+        {"payload", function.json()}
+    };
+    // clang-format on
+}
+
+PreparedTransfer PreparedTransfer::aptosAccountTransfer(const Address& sender, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId) {
+    return PreparedTransfer(sender, transferFunction(gAptosAccountModule, {}), maxGasAmount, gasUnitPrice, chainId);
+}
+
+PreparedTransfer PreparedTransfer::coinTransfer(const Address& sender, const StructTag& coinType, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId) {
+    TypeTag coinTag = {TypeTag::TypeTagVariant(TStructTag{.st = coinType})};
+    return PreparedTransfer(sender, transferFunction(gAptosCoinModule, {coinTag}), maxGasAmount, gasUnitPrice, chainId);
+}
+
+StructTag PreparedTransfer::aptosCoin() {
+    return StructTag(Address::one(), "aptos_coin", "AptosCoin", {});
+}
+
+Proto::SigningOutput PreparedTransfer::sign(const PrivateKey& privateKey, std::uint64_t sequenceNumber, const Address& to, std::uint64_t amount, std::uint64_t expirationTimestampSecs) const {
+    auto message = mMessage;
+    patch64LE(message, mSequenceNumberOffset, sequenceNumber);
+    std::transform(to.bytes.begin(), to.bytes.end(), message.begin() + mRecipientOffset, [](auto b) { return static_cast<byte>(b); });
+    patch64LE(message, mAmountOffset, amount);
+    patch64LE(message, mExpirationOffset, expirationTimestampSecs);
+
+    auto output = Proto::SigningOutput();
+    const auto signature = privateKey.sign(message, TWCurveED25519);
+    const auto pubKeyData = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
+    const auto rawTxn = Data(message.begin() + gAptosSaltHash.size(), message.end());
+    output.set_raw_txn(rawTxn.data(), rawTxn.size());
+    output.mutable_authenticator()->set_public_key(pubKeyData.data(), pubKeyData.size());
+    output.mutable_authenticator()->set_signature(signature.data(), signature.size());
+    const auto encoded = BCS::serialize(BCS::raw_bytes{rawTxn}, BCS::uleb128{.value = 0}, pubKeyData, signature);
+    output.set_encoded(encoded.data(), encoded.size());
+
+    auto json = mJson;
+    json["sequence_number"] = std::to_string(sequenceNumber);
+    json["expiration_timestamp_secs"] = std::to_string(expirationTimestampSecs);
+    json["payload"]["arguments"] = nlohmann::json::array({to.string(), std::to_string(amount)});
+    // clang-format off
+    json["signature"] = {
+        {"type", "ed25519_signature"},
+        {"public_key", hexEncoded(pubKeyData)},
+        {"signature", hexEncoded(signature)}
+    };
+    // clang-format on
+    output.set_json(json.dump());
+    return output;
+}
+
+} // namespace TW::Aptos
@@ -0,0 +1,52 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "MoveTypes.h"
+#include "TransactionPayload.h"
+#include "../PrivateKey.h"
+#include "../proto/Aptos.pb.h"
+
+#include <nlohmann/json.hpp>
+
+namespace TW::Aptos {
+
+/// A coin transfer serialized once, for signing many transfers from the same sender.
+///
+/// The signing message (domain separator and raw transaction) is encoded with placeholders when prepared;
+/// signing only patches the sequence number, recipient, amount and expiration into a copy of it.
+/// Signing gives the same output as `Signer::sign` with the equivalent `SigningInput`.
+class PreparedTransfer {
+public:
+    /// `0x1::aptos_account::transfer`, sending APT and creating the recipient account if needed.
+    static PreparedTransfer aptosAccountTransfer(const Address& sender, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId);
+
+    /// `0x1::coin::transfer<coinType>`, for APT (see `aptosCoin`) or any registered coin.
+    static PreparedTransfer coinTransfer(const Address& sender, const StructTag& coinType, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId);
+
+    /// `0x1::aptos_coin::AptosCoin`.
+    static StructTag aptosCoin();
+
+    /// Signs a transfer of `amount` to `to` with the key of the sender.
+    Proto::SigningOutput sign(const PrivateKey& privateKey, std::uint64_t sequenceNumber, const Address& to, std::uint64_t amount, std::uint64_t expirationTimestampSecs) const;
+
+    /// The signing message with placeholders.
+    const Data& message() const noexcept { return mMessage; }
+
+private:
+    PreparedTransfer(const Address& sender, const EntryFunction& function, std::uint64_t maxGasAmount, std::uint64_t gasUnitPrice, std::uint8_t chainId);
+
+    Data mMessage;
+    std::size_t mSequenceNumberOffset;
+    std::size_t mRecipientOffset;
+    std::size_t mAmountOffset;
+    std::size_t mExpirationOffset;
+    nlohmann::json mJson;
+};
+
+} // namespace TW::Aptos
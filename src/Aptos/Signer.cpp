@@ -14,9 +14,7 @@
 namespace {
 template <typename T>
 void serializeToArgs(std::vector<TW::Data>& args, T&& toSerialize) {
-    TW::BCS::Serializer serializer;
-    serializer << std::forward<T>(toSerialize);
-    args.emplace_back(serializer.bytes);
+    args.emplace_back(TW::BCS::serialize(toSerialize));
 }
 } // namespace
 
@@ -174,17 +172,15 @@ TransactionPayload registerTokenPayload(const Proto::SigningInput& input) {
 Proto::SigningOutput blindSign(const Proto::SigningInput& input) {
     auto output = Proto::SigningOutput();
     auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto pubKeyData = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
+    auto pubKeyData = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
     if (nlohmann::json j = nlohmann::json::parse(input.any_encoded(), nullptr, false); j.is_discarded()) {
-        BCS::Serializer serializer;
         auto encodedCall = parse_hex(input.any_encoded());
-        serializer.add_bytes(begin(encodedCall), end(encodedCall));
         auto signature = privateKey.sign(encodedCall, TWCurveED25519);
         output.set_raw_txn(encodedCall.data(), encodedCall.size());
         output.mutable_authenticator()->set_public_key(pubKeyData.data(), pubKeyData.size());
         output.mutable_authenticator()->set_signature(signature.data(), signature.size());
-        serializer << BCS::uleb128{.value = 0} << pubKeyData << signature;
-        output.set_encoded(serializer.bytes.data(), serializer.bytes.size());
+        const auto encoded = BCS::serialize(BCS::raw_bytes{encodedCall}, BCS::uleb128{.value = 0}, pubKeyData, signature);
+        output.set_encoded(encoded.data(), encoded.size());
 
         // clang-format off
         nlohmann::json json = {
@@ -7,12 +7,15 @@
 #pragma once
 
 #include "Data.h"
+#include "Hash.h"
 #include "../PrivateKey.h"
 #include "../proto/Aptos.pb.h"
 
 namespace TW::Aptos {
 
 inline const Data gAptosSalt = data("APTOS::RawTransaction");
+/// Domain separator prefixing the signing message of raw transactions.
+inline const Data gAptosSaltHash = Hash::sha3_256(gAptosSalt);
 
 /// Helper class that performs Aptos transaction signing.
 class Signer {
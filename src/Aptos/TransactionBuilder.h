@@ -54,18 +54,17 @@ public:
     }
 
     TransactionBuilder& sign(const Proto::SigningInput& input, Proto::SigningOutput& output) noexcept {
-        BCS::Serializer serializer;
-        serializer << mSender << mSequenceNumber << mPayload << mMaxGasAmount << mGasUnitPrice << mExpirationTimestampSecs << mChainId;
+        const auto rawTxn = BCS::serialize(mSender, mSequenceNumber, mPayload, mMaxGasAmount, mGasUnitPrice, mExpirationTimestampSecs, mChainId);
         auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-        output.set_raw_txn(serializer.bytes.data(), serializer.bytes.size());
-        auto msgToSign = TW::Hash::sha3_256(gAptosSalt.data(), gAptosSalt.size());
-        append(msgToSign, serializer.bytes);
+        output.set_raw_txn(rawTxn.data(), rawTxn.size());
+        auto msgToSign = gAptosSaltHash;
+        append(msgToSign, rawTxn);
         auto signature = privateKey.sign(msgToSign, TWCurveED25519);
-        auto pubKeyData = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
+        auto pubKeyData = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
         output.mutable_authenticator()->set_public_key(pubKeyData.data(), pubKeyData.size());
         output.mutable_authenticator()->set_signature(signature.data(), signature.size());
-        serializer << BCS::uleb128{.value = 0} << pubKeyData << signature;
-        output.set_encoded(serializer.bytes.data(), serializer.bytes.size());
+        const auto encoded = BCS::serialize(BCS::raw_bytes{rawTxn}, BCS::uleb128{.value = 0}, pubKeyData, signature);
+        output.set_encoded(encoded.data(), encoded.size());
 
         // https://fullnode.devnet.aptoslabs.com/v1/spec#/operations/submit_transaction
         // clang-format off
@@ -0,0 +1,119 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AsnParser.h"
+
+#include <algorithm>
+
+namespace TW::ASN {
+
+namespace {
+
+constexpr byte tagSequence = 0x30;
+constexpr byte tagInteger = 0x02;
+constexpr std::size_t valueSize = 32;
+
+/// Reads a tag and its minimally encoded length at `pos`, advancing past them.
+/// Returns false if the tag doesn't match or the content doesn't fit before `end`.
+bool readHeader(const byte* data, std::size_t end, std::size_t& pos, byte tag, std::size_t& length) {
+    if (pos + 2 > end || data[pos] != tag) {
+        return false;
+    }
+    const auto first = data[pos + 1];
+    pos += 2;
+    if (first < 0x80) {
+        length = first;
+    } else if (first == 0x81) {
+        // long form only for lengths that don't fit the short form
+        if (pos + 1 > end || data[pos] < 0x80) {
+            return false;
+        }
+        length = data[pos];
+        pos += 1;
+    } else if (first == 0x82) {
+        if (pos + 2 > end || data[pos] == 0) {
+            return false;
+        }
+        length = (static_cast<std::size_t>(data[pos]) << 8) | data[pos + 1];
+        pos += 2;
+    } else {
+        return false;
+    }
+    return length <= end - pos;
+}
+
+/// Reads a non-negative INTEGER of up to 32 bytes, right-aligned into `out`.
+bool readUnsigned(const byte* data, std::size_t end, std::size_t& pos, byte* out) {
+    std::size_t length = 0;
+    if (!readHeader(data, end, pos, tagInteger, length) || length == 0) {
+        return false;
+    }
+    const auto* value = data + pos;
+    pos += length;
+    if ((value[0] & 0x80) != 0) {
+        // negative
+        return false;
+    }
+    if (value[0] == 0 && length > 1) {
+        // a leading zero is only allowed before a byte with the high bit set
+        if ((value[1] & 0x80) == 0) {
+            return false;
+        }
+        ++value;
+        --length;
+    }
+    if (length > valueSize) {
+        return false;
+    }
+    std::fill(out, out + valueSize - length, 0);
+    std::copy(value, value + length, out + valueSize - length);
+    return true;
+}
+
+/// Writes a 32-byte big-endian value as a minimal non-negative INTEGER, returns the encoded size.
+std::size_t writeUnsigned(const byte* value, byte* out) noexcept {
+    std::size_t skip = 0;
+    while (skip + 1 < valueSize && value[skip] == 0) {
+        ++skip;
+    }
+    const auto padding = (value[skip] & 0x80) != 0 ? 1 : 0;
+    const auto length = valueSize - skip + padding;
+    out[0] = tagInteger;
+    out[1] = static_cast<byte>(length);
+    out[2] = 0;
+    std::copy(value + skip, value + valueSize, out + 2 + padding);
+    return 2 + length;
+}
+
+} // namespace
+
+bool AsnParser::ecdsa_signature_from_der(const byte* derEncoded, std::size_t size, EcdsaSignature& out) {
+    std::size_t pos = 0;
+    std::size_t length = 0;
+    if (!readHeader(derEncoded, size, pos, tagSequence, length) || pos + length != size) {
+        return false;
+    }
+    EcdsaSignature signature;
+    if (!readUnsigned(derEncoded, size, pos, signature.data()) ||
+        !readUnsigned(derEncoded, size, pos, signature.data() + valueSize) ||
+        pos != size) {
+        return false;
+    }
+    out = signature;
+    return true;
+}
+
+std::size_t AsnParser::ecdsa_signature_to_der(const byte* signature, byte* out) noexcept {
+    // the two integers take at most 2 * 35 bytes, the sequence length fits in one byte
+    std::size_t pos = 2;
+    pos += writeUnsigned(signature, out + pos);
+    pos += writeUnsigned(signature + valueSize, out + pos);
+    out[0] = tagSequence;
+    out[1] = static_cast<byte>(pos - 2);
+    return pos;
+}
+
+} // namespace TW::ASN
@@ -7,19 +7,35 @@
 #pragma once
 
 #include "Data.h"
-#include "rust/bindgen/WalletCoreRSBindgen.h"
-#include "rust/Wrapper.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
 
 namespace TW::ASN {
 
 struct AsnParser {
+    /// ECDSA signature: `r` and `s` as 32-byte big-endian values.
+    using EcdsaSignature = std::array<byte, 64>;
+
+    /// Maximum size of a DER encoded ECDSA signature with 32-byte values.
+    static constexpr std::size_t maxDerSignatureSize = 72;
+
+    /// Parses the given ECDSA signature from strict ASN.1 DER encoded bytes into `out`, without allocating.
+    /// Returns false if the encoding is invalid or `r`/`s` don't fit in 32 bytes.
+    static bool ecdsa_signature_from_der(const byte* derEncoded, std::size_t size, EcdsaSignature& out);
+
     static std::optional<Data> ecdsa_signature_from_der(const Data& derEncoded) {
-        Rust::CByteArrayResultWrapper res = Rust::ecdsa_signature_from_asn_der(derEncoded.data(), derEncoded.size());
-        if (!res.isOk()) {
+        EcdsaSignature signature;
+        if (!ecdsa_signature_from_der(derEncoded.data(), derEncoded.size(), signature)) {
             return std::nullopt;
         }
-        return res.unwrap().data;
+        return Data(signature.begin(), signature.end());
     }
+
+    /// Encodes the given ECDSA signature as canonical ASN.1 DER into `out` (at least `maxDerSignatureSize` bytes),
+    /// returns the encoded size.
+    static std::size_t ecdsa_signature_to_der(const byte* signature, byte* out) noexcept;
 };
 
 } // namespace TW::ASN
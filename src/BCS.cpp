@@ -34,6 +34,11 @@ Serializer& operator<<(Serializer& stream, std::string_view sv) noexcept {
     return stream;
 }
 
+Serializer& operator<<(Serializer& stream, raw_bytes raw) noexcept {
+    stream.add_bytes(raw.data.data(), raw.data.size());
+    return stream;
+}
+
 Serializer& operator<<(Serializer& stream, std::nullopt_t) noexcept {
     stream << false;
     return stream;
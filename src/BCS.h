@@ -8,12 +8,16 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <concepts>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <tuple>
 #include <variant>
+#include <vector>
 
 #include "Data.h"
 #include "concepts/tw_concepts.h"
@@ -25,20 +29,67 @@ namespace TW::BCS {
 struct Serializer {
     Data bytes;
 
+    Serializer() noexcept = default;
+
+    /// A serializer that only counts the bytes it is given, without storing them; see `serialize`.
+    static Serializer counter() noexcept {
+        Serializer serializer;
+        serializer.counting = true;
+        return serializer;
+    }
+
     void add_byte(std::byte b) noexcept {
+        if (counting) {
+            ++counted;
+            return;
+        }
         bytes.emplace_back(static_cast<Data::value_type>(b));
     }
 
+    /// Appends `size` bytes at once.
+    void add_bytes(const Data::value_type* data, std::size_t size) noexcept {
+        if (counting) {
+            counted += size;
+            return;
+        }
+        bytes.insert(bytes.end(), data, data + size);
+    }
+
     template <typename Iterator>
     void add_bytes(Iterator first, Iterator last) noexcept {
-        std::transform(first, last, std::back_inserter(bytes), [](auto&& c) {
-            return static_cast<Data::value_type>(c);
-        });
+        if constexpr (std::contiguous_iterator<Iterator> && sizeof(std::iter_value_t<Iterator>) == 1) {
+            add_bytes(reinterpret_cast<const Data::value_type*>(std::to_address(first)), static_cast<std::size_t>(last - first));
+        } else if (counting) {
+            counted += static_cast<std::size_t>(std::distance(first, last));
+        } else {
+            std::transform(first, last, std::back_inserter(bytes), [](auto&& c) {
+                return static_cast<Data::value_type>(c);
+            });
+        }
     }
 
+    /// Whether this is a counting serializer.
+    bool is_counter() const noexcept { return counting; }
+
+    /// Accounts for `size` bytes in a counting serializer, without visiting them.
+    void count(std::size_t size) noexcept { counted += size; }
+
+    /// Number of bytes serialized so far.
+    std::size_t size() const noexcept { return counting ? counted : bytes.size(); }
+
     void clear() noexcept {
         bytes.clear();
+        counted = 0;
     }
+
+private:
+    bool counting = false;
+    std::size_t counted = 0;
+};
+
+/// Bytes written as is, without a length prefix, e.g. an already encoded value.
+struct raw_bytes {
+    const Data& data;
 };
 
 struct uleb128 {
@@ -57,6 +108,21 @@ concept map_container = requires(T t) {
                             { std::declval<const T>().size() } -> std::same_as<typename T::size_type>;
                         };
 
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct is_tuple_like : std::false_type {};
+
+template <typename... Ts>
+struct is_tuple_like<std::tuple<Ts...>> : std::true_type {};
+
+template <typename T, typename U>
+struct is_tuple_like<std::pair<T, U>> : std::true_type {};
+
 template <typename T>
     requires integral<T> ||
              floating_point<T> ||
@@ -94,11 +160,18 @@ struct is_serializable<std::variant<Ts...>> {
     static constexpr auto value = (is_serializable<Ts>::value && ...);
 };
 
-template <integral T, std::size_t... Is>
-Serializer& serialize_integral_impl(Serializer& stream, T t, std::index_sequence<Is...>) noexcept {
-    const char* bytes = reinterpret_cast<const char*>(&t);
-    // Add each byte in little-endian order
-    return (stream << ... << static_cast<std::byte>(bytes[Is]));
+template <integral T>
+Serializer& serialize_integral_impl(Serializer& stream, T t) noexcept {
+    // BCS integers are little-endian
+    if constexpr (std::endian::native == std::endian::little) {
+        stream.add_bytes(reinterpret_cast<const Data::value_type*>(&t), sizeof(T));
+    } else {
+        std::array<Data::value_type, sizeof(T)> bytes;
+        const auto* first = reinterpret_cast<const Data::value_type*>(&t);
+        std::reverse_copy(first, first + sizeof(T), bytes.begin());
+        stream.add_bytes(bytes.data(), bytes.size());
+    }
+    return stream;
 }
 
 template <typename T, std::size_t... Is>
@@ -111,30 +184,79 @@ struct dependent_false {
     static constexpr auto value = false;
 };
 
+// Tries structured bindings of `t` with the given names, returning a tuple of references to its members.
+#define TW_BCS_TIE_MEMBERS(...)                                                        \
+    else if constexpr (requires { [&t] { auto&& [__VA_ARGS__] = t; }; }) {             \
+        auto&& [__VA_ARGS__] = std::forward<T>(t);                                     \
+        return std::tie(__VA_ARGS__);                                                  \
+    }
+
+/// The members of an aggregate as a tuple of references, for structures of up to 16 members.
+/// Larger structures need a custom `operator<<`, which may serialize a `std::tie` of the members.
 template <aggregate_struct T>
 constexpr auto to_tuple(T&& t) {
-    if constexpr (std::is_empty_v<T>) {
+    if constexpr (std::is_empty_v<std::remove_cvref_t<T>>) {
         return std::make_tuple();
-    } else if constexpr (requires { [&t] { auto&& [a0] = t; }; }) {
-        auto&& [a0] = std::forward<T>(t);
-        return std::make_tuple(a0);
-    } else if constexpr (requires { [&t] { auto&& [a0, a1] = t; }; }) {
-        auto&& [a0, a1] = std::forward<T>(t);
-        return std::make_tuple(a0, a1);
-    } else if constexpr (requires { [&t] { auto&& [a0, a1, a2] = t; }; }) {
-        auto&& [a0, a1, a2] = std::forward<T>(t);
-        return std::make_tuple(a0, a1, a2);
-    } else if constexpr (requires { [&t] { auto&& [a0, a1, a2, a3] = t; }; }) {
-        auto&& [a0, a1, a2, a3] = std::forward<T>(t);
-        return std::make_tuple(a0, a1, a2, a3);
-    } else if constexpr (requires { [&t] { auto&& [a0, a1, a2, a3, a4] = t; }; }) {
-        auto&& [a0, a1, a2, a3, a4] = std::forward<T>(t);
-        return std::make_tuple(a0, a1, a2, a3, a4);
-    } else if constexpr (requires { [&t] { auto&& [a0, a1, a2, a3, a4, a5] = t; }; }) {
-        auto&& [a0, a1, a2, a3, a4, a5] = std::forward<T>(t);
-        return std::make_tuple(a0, a1, a2, a3, a4, a5);
+    }
+    TW_BCS_TIE_MEMBERS(a0)
+    TW_BCS_TIE_MEMBERS(a0, a1)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14)
+    TW_BCS_TIE_MEMBERS(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15)
+    else {
+        static_assert(dependent_false<T>::value, "the structure has more than 16 members");
+    }
+}
+
+#undef TW_BCS_TIE_MEMBERS
+
+/// Size of the encoding of a `T`, if it is the same for all values (integers, and arrays, tuples and pairs of those),
+/// 0 otherwise. Aggregates are left out, as they may have a custom encoding.
+template <typename T>
+constexpr std::size_t fixed_size() noexcept {
+    if constexpr (integral<T> || std::is_same_v<T, std::byte>) {
+        return sizeof(T);
+    } else if constexpr (is_std_array<T>::value) {
+        return std::tuple_size_v<T> * fixed_size<typename T::value_type>();
+    } else if constexpr (is_tuple_like<T>::value) {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            constexpr std::size_t sizes[] = {fixed_size<std::tuple_element_t<Is, T>>()..., 1};
+            return std::all_of(std::begin(sizes), std::end(sizes), [](auto size) { return size > 0; })
+                       ? (fixed_size<std::tuple_element_t<Is, T>>() + ... + 0)
+                       : 0;
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
     } else {
-        static_assert(dependent_false<T>::value, "the structure has more than 6 members");
+        return 0;
+    }
+}
+
+/// Serializes `count` values, with one bulk copy for integers (stored little-endian in memory), and without
+/// visiting the values in a counting serializer when they have a fixed size.
+template <typename T>
+void serialize_range(Serializer& stream, const T* values, std::size_t count) noexcept {
+    if constexpr (integral<T> && (sizeof(T) == 1 || std::endian::native == std::endian::little)) {
+        stream.add_bytes(reinterpret_cast<const Data::value_type*>(values), count * sizeof(T));
+    } else {
+        if constexpr (fixed_size<T>() > 0) {
+            if (stream.is_counter()) {
+                stream.count(count * fixed_size<T>());
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            stream << values[i];
+        }
     }
 }
 
@@ -159,7 +281,7 @@ Serializer& operator<<(Serializer& stream, std::byte b) noexcept;
 
 template <integral T>
 Serializer& operator<<(Serializer& stream, T t) noexcept {
-    return details::serialize_integral_impl(stream, t, std::make_index_sequence<sizeof(T)>{});
+    return details::serialize_integral_impl(stream, t);
 }
 
 Serializer& operator<<(Serializer& stream, uleb128 t) noexcept;
@@ -189,6 +311,15 @@ Serializer& operator<<(Serializer& stream, const std::pair<T, U>& t) noexcept {
     return details::serialize_tuple_impl(stream, t, std::make_index_sequence<2>{});
 }
 
+Serializer& operator<<(Serializer& stream, raw_bytes raw) noexcept;
+
+/// Fixed-size arrays have no length prefix.
+template <typename T, std::size_t N>
+Serializer& operator<<(Serializer& stream, const std::array<T, N>& t) noexcept {
+    details::serialize_range(stream, t.data(), N);
+    return stream;
+}
+
 template <details::aggregate_struct T>
 Serializer& operator<<(Serializer& stream, const T& t) noexcept {
     return details::serialize_struct_impl(stream, t);
@@ -197,8 +328,12 @@ Serializer& operator<<(Serializer& stream, const T& t) noexcept {
 template <typename T>
 Serializer& operator<<(Serializer& stream, const std::vector<T>& t) noexcept {
     stream << uleb128{static_cast<uint32_t>(t.size())};
-    for (auto&& cur: t) {
-        stream << cur;
+    if constexpr (std::is_same_v<T, bool>) {
+        for (bool cur : t) {
+            stream << cur;
+        }
+    } else {
+        details::serialize_range(stream, t.data(), t.size());
     }
     return stream;
 }
@@ -219,4 +354,16 @@ Serializer& operator<<(Serializer& stream, const T& t) noexcept {
     return stream;
 }
 
+/// Serializes `values` in order into a buffer of the exact size: a first, counting pass computes the size
+/// (without visiting fixed-size arrays of integers), then the second pass writes without reallocating.
+template <typename... Ts>
+Data serialize(const Ts&... values) noexcept {
+    auto counter = Serializer::counter();
+    (counter << ... << values);
+    Serializer serializer;
+    serializer.bytes.reserve(counter.size());
+    (serializer << ... << values);
+    return std::move(serializer.bytes);
+}
+
 } // namespace TW::BCS
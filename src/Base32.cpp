@@ -0,0 +1,67 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base32.h"
+
+namespace TW::Base32 {
+
+void encodeInto(std::span<const byte> data, char* out, const Alphabet& alphabet) noexcept {
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (const auto b : data) {
+        buffer = (buffer << 8) | b;
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            *out++ = alphabet.encode(static_cast<uint8_t>(buffer >> bits));
+        }
+    }
+    if (bits > 0) {
+        *out = alphabet.encode(static_cast<uint8_t>(buffer << (5 - bits)));
+    }
+}
+
+bool decodeInto(std::string_view encoded, byte* out, const Alphabet& alphabet) noexcept {
+    // a last group of 1, 3 or 6 symbols doesn't end on a byte
+    const auto tail = encoded.size() % 8;
+    if (tail == 1 || tail == 3 || tail == 6) {
+        return false;
+    }
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (const auto symbol : encoded) {
+        const auto value = alphabet.decode(symbol);
+        if (value < 0) {
+            return false;
+        }
+        buffer = (buffer << 5) | static_cast<uint32_t>(value);
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            *out++ = static_cast<byte>(buffer >> bits);
+        }
+    }
+    return (buffer & ((1u << bits) - 1)) == 0;
+}
+
+void encodeBatch(const byte* data, std::size_t size, std::size_t count, char* out, const Alphabet& alphabet) noexcept {
+    const auto length = encodedSize(size);
+    for (std::size_t i = 0; i < count; ++i) {
+        encodeInto(std::span<const byte>(data + i * size, size), out + i * length, alphabet);
+    }
+}
+
+std::size_t decodeBatch(std::span<const std::string_view> encoded, std::size_t size, byte* out, bool* valid, const Alphabet& alphabet) noexcept {
+    const auto length = encodedSize(size);
+    std::size_t validCount = 0;
+    for (std::size_t i = 0; i < encoded.size(); ++i) {
+        valid[i] = encoded[i].size() == length && decodeInto(encoded[i], out + i * size, alphabet);
+        validCount += valid[i];
+    }
+    return validCount;
+}
+
+} // namespace TW::Base32
@@ -10,10 +10,77 @@
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 #include "rust/Wrapper.h"
 
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <span>
+#include <string_view>
 
 namespace TW::Base32 {
 
+/// Base32 alphabet with its reverse lookup table, built at compile time for the constant alphabets.
+class Alphabet {
+public:
+    /// `chars` holds the 32 symbols in order.
+    constexpr explicit Alphabet(const char* chars) {
+        values.fill(-1);
+        for (auto i = 0; i < 32; ++i) {
+            symbols[i] = chars[i];
+            values[static_cast<unsigned char>(chars[i])] = static_cast<int8_t>(i);
+        }
+    }
+
+    constexpr char encode(uint8_t value) const noexcept { return symbols[value & 0x1f]; }
+
+    /// Value of a symbol, -1 if not in the alphabet.
+    constexpr int8_t decode(char symbol) const noexcept { return values[static_cast<unsigned char>(symbol)]; }
+
+private:
+    std::array<char, 32> symbols{};
+    std::array<int8_t, 256> values{};
+};
+
+inline constexpr Alphabet RFC4648{"ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"};
+
+/// Length of the unpadded encoding of `size` bytes.
+constexpr std::size_t encodedSize(std::size_t size) noexcept {
+    return (size * 8 + 4) / 5;
+}
+
+/// Number of bytes decoded from an unpadded encoding of `length` symbols.
+constexpr std::size_t decodedSize(std::size_t length) noexcept {
+    return length * 5 / 8;
+}
+
+/// Encodes `data` unpadded into `out`, which must hold `encodedSize(data.size())` chars. Doesn't allocate.
+void encodeInto(std::span<const byte> data, char* out, const Alphabet& alphabet = RFC4648) noexcept;
+
+/// Decodes the unpadded `encoded` into `out`, which must hold `decodedSize(encoded.size())` bytes. Doesn't allocate.
+/// Like `decode`, rejects symbols outside the alphabet, incomplete groups and non-zero trailing bits.
+bool decodeInto(std::string_view encoded, byte* out, const Alphabet& alphabet = RFC4648) noexcept;
+
+/// Encodes fixed-size data, e.g. an address payload, on the stack.
+template <std::size_t N>
+std::array<char, encodedSize(N)> encodeArray(const std::array<byte, N>& data, const Alphabet& alphabet = RFC4648) noexcept {
+    std::array<char, encodedSize(N)> out;
+    encodeInto(data, out.data(), alphabet);
+    return out;
+}
+
+/// Decodes into fixed-size data on the stack, false unless `encoded` is exactly the encoding of `N` bytes.
+template <std::size_t N>
+bool decodeArray(std::string_view encoded, std::array<byte, N>& out, const Alphabet& alphabet = RFC4648) noexcept {
+    return encoded.size() == encodedSize(N) && decodeInto(encoded, out.data(), alphabet);
+}
+
+/// Encodes `count` inputs of `size` bytes each, stored back to back in `data`, into `count` encodings of
+/// `encodedSize(size)` chars each, stored back to back in `out`.
+void encodeBatch(const byte* data, std::size_t size, std::size_t count, char* out, const Alphabet& alphabet = RFC4648) noexcept;
+
+/// Decodes encodings of `size` bytes each into `out`, back to back; `valid[i]` tells whether `encoded[i]` decoded,
+/// the bytes of an invalid one are unspecified. Returns the number of valid encodings.
+std::size_t decodeBatch(std::span<const std::string_view> encoded, std::size_t size, byte* out, bool* valid, const Alphabet& alphabet = RFC4648) noexcept;
+
 /// Decode Base32 string, return bytes as Data
 /// alphabet: Optional alphabet, if missing, default ALPHABET_RFC4648
 inline bool decode(const std::string& encoded_in, Data& decoded_out, const char* alphabet_in = nullptr) {
@@ -0,0 +1,272 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+
+#include <array>
+#include <cassert>
+
+namespace TW::Base58 {
+
+namespace {
+
+constexpr char bitcoinAlphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+constexpr char rippleAlphabet[] = "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+
+constexpr uint8_t invalidDigit = 0xff;
+
+using DigitTable = std::array<uint8_t, 256>;
+
+constexpr DigitTable digitTable(const char* alphabet) {
+    DigitTable table{};
+    table.fill(invalidDigit);
+    for (uint8_t i = 0; i < 58; ++i) {
+        table[static_cast<uint8_t>(alphabet[i])] = i;
+    }
+    return table;
+}
+
+constexpr DigitTable bitcoinDigits = digitTable(bitcoinAlphabet);
+constexpr DigitTable rippleDigits = digitTable(rippleAlphabet);
+
+const char* characters(Rust::Base58Alphabet alphabet) {
+    return alphabet == Rust::Base58Alphabet::Ripple ? rippleAlphabet : bitcoinAlphabet;
+}
+
+const DigitTable& digits(Rust::Base58Alphabet alphabet) {
+    return alphabet == Rust::Base58Alphabet::Ripple ? rippleDigits : bitcoinDigits;
+}
+
+/// The bignum is held in limbs of 58^5, which fit in 32 bits and leave room for
+/// multiplying by 2^32 in 64-bit arithmetic, so four input bytes are consumed per pass.
+constexpr uint64_t limbBase = 58ull * 58 * 58 * 58 * 58;
+constexpr std::size_t digitsPerLimb = 5;
+
+/// Payloads up to this size (addresses, extended keys) are converted without heap allocation.
+constexpr std::size_t maxStackLimbs = 24;
+
+/// Upper bound of the number of limbs needed for `size` bytes: log(256) / log(58^5) < 0.274.
+constexpr std::size_t limbCount(std::size_t size) {
+    return size * 274 / 1000 + 1;
+}
+
+/// Holds limbs on the stack for small inputs, on the heap otherwise.
+template <typename T>
+class Limbs {
+public:
+    explicit Limbs(std::size_t count) : count(count) {
+        if (count > maxStackLimbs) {
+            heap.resize(count);
+        }
+    }
+    T* data() { return count > maxStackLimbs ? heap.data() : stack.data(); }
+
+private:
+    std::size_t count;
+    std::array<T, maxStackLimbs> stack;
+    std::vector<T> heap;
+};
+
+} // namespace
+
+void appendEncoded(const byte* data, std::size_t size, std::string& out, Rust::Base58Alphabet alphabet) {
+    const auto* chars = characters(alphabet);
+
+    std::size_t zeros = 0;
+    while (zeros < size && data[zeros] == 0) {
+        ++zeros;
+    }
+    data += zeros;
+    size -= zeros;
+
+    const auto capacity = limbCount(size);
+    Limbs<uint32_t> storage(capacity);
+    auto* limbs = storage.data();
+    // Limbs are little-endian; only the first `used` ones are significant.
+    std::size_t used = 0;
+
+    auto feed = [&](uint64_t value, unsigned bits) {
+        uint64_t carry = value;
+        for (std::size_t i = 0; i < used; ++i) {
+            const auto t = (uint64_t(limbs[i]) << bits) + carry;
+            limbs[i] = static_cast<uint32_t>(t % limbBase);
+            carry = t / limbBase;
+        }
+        while (carry != 0) {
+            assert(used < capacity);
+            limbs[used++] = static_cast<uint32_t>(carry % limbBase);
+            carry /= limbBase;
+        }
+    };
+
+    const auto head = size % 4;
+    if (head != 0) {
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < head; ++i) {
+            value = (value << 8) | data[i];
+        }
+        feed(value, unsigned(8 * head));
+    }
+    for (std::size_t i = head; i < size; i += 4) {
+        const uint64_t value = (uint64_t(data[i]) << 24) | (uint64_t(data[i + 1]) << 16) | (uint64_t(data[i + 2]) << 8) | data[i + 3];
+        feed(value, 32);
+    }
+
+    std::array<char, digitsPerLimb> group;
+    const auto offset = out.size();
+    out.reserve(offset + zeros + used * digitsPerLimb);
+    out.append(zeros, chars[0]);
+    for (std::size_t i = used; i-- > 0;) {
+        auto limb = limbs[i];
+        for (std::size_t j = digitsPerLimb; j-- > 0;) {
+            group[j] = chars[limb % 58];
+            limb /= 58;
+        }
+        // Leading zero digits of the most significant limb are not part of the encoding.
+        std::size_t skip = 0;
+        if (i + 1 == used) {
+            while (group[skip] == chars[0]) {
+                ++skip;
+            }
+        }
+        out.append(group.data() + skip, group.size() - skip);
+    }
+}
+
+bool appendDecoded(std::string_view string, Data& out, Rust::Base58Alphabet alphabet) {
+    const auto& table = digits(alphabet);
+    const auto zeroChar = characters(alphabet)[0];
+
+    std::size_t zeros = 0;
+    while (zeros < string.size() && string[zeros] == zeroChar) {
+        ++zeros;
+    }
+    string.remove_prefix(zeros);
+
+    // log(58) / log(2^32) < 0.1831, per character.
+    const auto capacity = string.size() * 1831 / 10000 + 1;
+    Limbs<uint32_t> storage(capacity);
+    auto* limbs = storage.data();
+    // Limbs are little-endian base 2^32; only the first `used` ones are significant.
+    std::size_t used = 0;
+
+    auto feed = [&](uint64_t value, uint64_t multiplier) {
+        uint64_t carry = value;
+        for (std::size_t i = 0; i < used; ++i) {
+            const auto t = uint64_t(limbs[i]) * multiplier + carry;
+            limbs[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        while (carry != 0) {
+            assert(used < capacity);
+            limbs[used++] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+    };
+
+    const auto head = string.size() % digitsPerLimb;
+    std::size_t i = 0;
+    while (i < string.size()) {
+        const auto count = (i == 0 && head != 0) ? head : digitsPerLimb;
+        uint64_t value = 0;
+        uint64_t multiplier = 1;
+        for (std::size_t j = 0; j < count; ++j, ++i) {
+            const auto digit = table[static_cast<uint8_t>(string[i])];
+            if (digit == invalidDigit) {
+                return false;
+            }
+            value = value * 58 + digit;
+            multiplier *= 58;
+        }
+        feed(value, multiplier);
+    }
+
+    const auto offset = out.size();
+    out.reserve(offset + zeros + used * 4);
+    out.resize(offset + zeros, 0);
+    for (std::size_t k = used; k-- > 0;) {
+        const auto limb = limbs[k];
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            const auto b = static_cast<byte>(limb >> shift);
+            // Leading zero bytes of the most significant limb are not part of the value.
+            if (k + 1 == used && out.size() == offset + zeros && b == 0) {
+                continue;
+            }
+            out.push_back(b);
+        }
+    }
+    return true;
+}
+
+void appendEncodedCheck(const byte* data, std::size_t size, std::string& out, Rust::Base58Alphabet alphabet, Hash::Hasher hasher) {
+    Hash::withHasher(hasher, [&](auto selected) {
+        appendEncodedCheck<decltype(selected)::value>(data, size, out, alphabet);
+    });
+}
+
+Data decodeCheck(const std::string& string, Rust::Base58Alphabet alphabet, Hash::Hasher hasher) {
+    return Hash::withHasher(hasher, [&](auto selected) {
+        return decodeCheck<decltype(selected)::value>(string, alphabet);
+    });
+}
+
+std::string encodeBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet) {
+    std::size_t estimate = 0;
+    for (const auto& payload : payloads) {
+        estimate += payload.size() * 138 / 100 + 1;
+    }
+    std::string arena;
+    arena.reserve(estimate);
+    offsets.clear();
+    offsets.reserve(payloads.size() + 1);
+    for (const auto& payload : payloads) {
+        offsets.push_back(arena.size());
+        appendEncoded(payload.data(), payload.size(), arena, alphabet);
+    }
+    offsets.push_back(arena.size());
+    return arena;
+}
+
+bool decodeBatch(const std::vector<std::string>& strings, Data& out, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet) {
+    std::size_t estimate = 0;
+    for (const auto& string : strings) {
+        // log(58) / log(256) < 0.733 bytes per character
+        estimate += string.size() * 733 / 1000 + 1;
+    }
+    out.clear();
+    out.reserve(estimate);
+    offsets.clear();
+    offsets.reserve(strings.size() + 1);
+    for (const auto& string : strings) {
+        offsets.push_back(out.size());
+        if (!appendDecoded(string, out, alphabet)) {
+            out.clear();
+            offsets.clear();
+            return false;
+        }
+    }
+    offsets.push_back(out.size());
+    return true;
+}
+
+std::string encodeCheckBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet, Hash::Hasher hasher) {
+    std::size_t estimate = 0;
+    for (const auto& payload : payloads) {
+        estimate += (payload.size() + checksumSize) * 138 / 100 + 1;
+    }
+    std::string arena;
+    arena.reserve(estimate);
+    offsets.clear();
+    offsets.reserve(payloads.size() + 1);
+    for (const auto& payload : payloads) {
+        offsets.push_back(arena.size());
+        appendEncodedCheck(payload.data(), payload.size(), arena, alphabet, hasher);
+    }
+    offsets.push_back(arena.size());
+    return arena;
+}
+
+} // namespace TW::Base58
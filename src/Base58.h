@@ -11,46 +11,105 @@
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 #include "rust/Wrapper.h"
 
+#include <algorithm>
+#include <array>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace TW::Base58 {
+    /// Number of checksum bytes appended by the Base58Check encoding.
+    constexpr std::size_t checksumSize = 4;
+
+    /// Appends the base 58 encoding of `size` bytes to `out`.
+    void appendEncoded(const byte* data, std::size_t size, std::string& out, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin);
+
+    /// Appends the bytes of a base 58 string to `out`.
+    /// \returns false and leaves `out` unchanged if the string contains a character outside the alphabet.
+    bool appendDecoded(std::string_view string, Data& out, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin);
+
+    /// Appends the base 58 encoding of `size` bytes followed by their 4-byte checksum to `out`.
+    void appendEncodedCheck(const byte* data, std::size_t size, std::string& out, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d);
+
     /// Decodes a base 58 string into `result`, returns `false` on failure.
     static inline Data decode(const std::string& string, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin)  {
-        if (string.empty()) {
+        Data result;
+        // Read up to the first NUL, like a C string.
+        if (!appendDecoded(string.c_str(), result, alphabet)) {
             return {};
         }
-        Rust::CByteArrayResultWrapper res = Rust::decode_base58(string.c_str(), alphabet);
-        return res.unwrap_or_default().data;
+        return result;
+    }
+
+    Data decodeCheck(const std::string& string, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d);
+
+    template <typename T>
+    static inline std::string encode(const T& data, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin) {
+        std::string encoded;
+        appendEncoded(reinterpret_cast<const byte*>(data.data()), data.size(), encoded, alphabet);
+        return encoded;
     }
 
-    static inline Data decodeCheck(const std::string& string, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d) {
+    /// Appends the base 58 encoding of `size` bytes followed by their 4-byte checksum to `out`,
+    /// with the checksum hasher selected at compile time.
+    template <Hash::Hasher H>
+    void appendEncodedCheck(const byte* data, std::size_t size, std::string& out, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin) {
+        constexpr std::size_t maxStackPayload = 124;
+        std::array<byte, maxStackPayload + checksumSize> stack;
+        Data heap;
+        byte* payload = stack.data();
+        if (size > maxStackPayload) {
+            heap.resize(size + checksumSize);
+            payload = heap.data();
+        }
+        std::copy(data, data + size, payload);
+        const auto hash = Hash::hashInto<H>(data, size);
+        std::copy(hash.begin(), hash.begin() + checksumSize, payload + size);
+        appendEncoded(payload, size + checksumSize, out, alphabet);
+    }
+
+    /// Decodes a base 58 string and checks its 4-byte checksum with the hasher selected at compile time.
+    /// \returns the payload without the checksum, or empty data on failure.
+    template <Hash::Hasher H>
+    Data decodeCheck(const std::string& string, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin) {
         auto result = decode(string, alphabet);
-        if (result.size() < 4) {
+        if (result.size() < checksumSize) {
             return {};
         }
-
-        // re-calculate the checksum, ensure it matches the included 4-byte checksum
-        auto hash = Hash::hash(hasher, result.data(), result.size() - 4);
-        if (!std::equal(hash.begin(), hash.begin() + 4, result.end() - 4)) {
+        const auto payloadSize = result.size() - checksumSize;
+        const auto hash = Hash::hashInto<H>(result.data(), payloadSize);
+        if (!std::equal(hash.begin(), hash.begin() + checksumSize, result.begin() + payloadSize)) {
             return {};
         }
-
-        return Data(result.begin(), result.end() - 4);
+        result.resize(payloadSize);
+        return result;
     }
 
-    template <typename T>
-    static inline std::string encode(const T& data, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin) {
-        auto encoded = encode_base58(data.data(), data.size(), alphabet);
-        std::string encoded_str(encoded);
-        Rust::free_string(encoded);
-        return encoded_str;
+    template <Hash::Hasher H, typename T>
+    std::string encodeCheck(const T& data, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin) {
+        std::string encoded;
+        appendEncodedCheck<H>(reinterpret_cast<const byte*>(data.data()), data.size(), encoded, alphabet);
+        return encoded;
     }
 
     template <typename T>
     static inline std::string encodeCheck(const T& data, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d) {
-        auto hash = Hash::hash(hasher, data);
-        Data toBeEncoded(std::begin(data), std::end(data));
-        toBeEncoded.insert(toBeEncoded.end(), hash.begin(), hash.begin() + 4);
-        return encode(toBeEncoded, alphabet);
+        std::string encoded;
+        appendEncodedCheck(reinterpret_cast<const byte*>(data.data()), data.size(), encoded, alphabet, hasher);
+        return encoded;
     }
+
+    /// Base58-encodes every payload into one string.
+    /// `offsets` receives the start of each encoding followed by the end of the last one,
+    /// so encoding `i` is `[offsets[i], offsets[i + 1])`.
+    std::string encodeBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin);
+
+    /// Decodes every base 58 string into `out`, with `offsets` as in `encodeBatch`.
+    /// \returns false, with `out` and `offsets` empty, if a string contains a character outside the alphabet.
+    bool decodeBatch(const std::vector<std::string>& strings, Data& out, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin);
+
+    /// Base58Check-encodes every payload into one string.
+    /// `offsets` receives the start of each encoding followed by the end of the last one,
+    /// so encoding `i` is `[offsets[i], offsets[i + 1])`.
+    std::string encodeCheckBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d);
 }
@@ -33,7 +33,7 @@ class Base58Address {
 
     /// Determines whether a string makes a valid address.
     static bool isValid(const std::string& string) {
-        const auto decoded = Base58::decodeCheck(string);
+        const auto decoded = Base58::decodeCheck<Hash::HasherSha256d>(string);
         if (decoded.size() != Base58Address::size) {
             return false;
         }
@@ -43,7 +43,7 @@ class Base58Address {
     /// Determines whether a string makes a valid address, and the prefix is
     /// within the valid set.
     static bool isValid(const std::string& string, const std::vector<Data>& validPrefixes) {
-        const auto decoded = Base58::decodeCheck(string);
+        const auto decoded = Base58::decodeCheck<Hash::HasherSha256d>(string);
         if (decoded.size() != Base58Address::size) {
             return false;
         }
@@ -59,7 +59,7 @@ class Base58Address {
 
     /// Initializes an address with a string representation.
     explicit Base58Address(const std::string& string) {
-        const auto decoded = Base58::decodeCheck(string);
+        const auto decoded = Base58::decodeCheck<Hash::HasherSha256d>(string);
         if (decoded.size() != Base58Address::size) {
             throw std::invalid_argument("Invalid address string");
         }
@@ -80,13 +80,16 @@ class Base58Address {
         if (publicKey.type != TWPublicKeyTypeSECP256k1) {
             throw std::invalid_argument("Bitcoin::Address needs a compressed SECP256k1 public key.");
         }
-        const auto data = publicKey.hash(prefix, Hash::HasherSha256ripemd);
-        std::copy(data.begin(), data.end(), bytes.begin());
+        const auto hash = publicKey.hash<Hash::HasherSha256ripemd>();
+        if (prefix.size() + hash.size() > size) {
+            throw std::invalid_argument("Invalid address prefix");
+        }
+        std::copy(hash.begin(), hash.end(), std::copy(prefix.begin(), prefix.end(), bytes.begin()));
     }
 
     /// Returns a string representation of the address.
     std::string string() const {
-        return Base58::encodeCheck(bytes);
+        return Base58::encodeCheck<Hash::HasherSha256d>(bytes);
     }
 };
 
@@ -8,6 +8,8 @@
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 #include "rust/Wrapper.h"
 
+#include <algorithm>
+
 namespace TW::Base64::internal {
 
 std::string encode(const Data& val, bool is_url) {
@@ -23,6 +25,33 @@ Data decode(const std::string& val, bool is_url) {
     return res.unwrap_or_default().data;
 }
 
+bool decodeInto(std::string_view val, Data& out, bool is_url) {
+    out.clear();
+    if (val.empty()) {
+        return true;
+    }
+    // upper bound of the decoded size, the exact size depends on the padding
+    out.resize((val.size() + 3) / 4 * 3);
+    std::size_t written = 0;
+    if (!Rust::decode_base64_into(reinterpret_cast<const uint8_t*>(val.data()), val.size(), is_url, out.data(), out.size(), &written)) {
+        out.clear();
+        return false;
+    }
+    out.resize(written);
+    return true;
+}
+
+void appendEncoded(std::span<const byte> val, std::string& out, bool is_url) {
+    if (val.empty()) {
+        return;
+    }
+    const auto offset = out.size();
+    const auto size = encodedSize(val.size());
+    out.resize(offset + size);
+    std::size_t written = 0;
+    Rust::encode_base64_into(val.data(), val.size(), is_url, reinterpret_cast<uint8_t*>(out.data() + offset), size, &written);
+}
+
 } // namespace TW::Base64::internal
 
 namespace TW::Base64 {
@@ -66,4 +95,110 @@ Data decode(const string& val) {
    return internal::decode(val, false);
 }
 
+bool decodeInto(std::string_view val, Data& out, bool isUrl) {
+    return internal::decodeInto(val, out, isUrl);
+}
+
+std::size_t decodedSize(std::string_view val) {
+    if (val.empty() || val.size() % 4 != 0) {
+        return 0;
+    }
+    const auto padding = static_cast<std::size_t>(val.back() == '=') + static_cast<std::size_t>(val[val.size() - 2] == '=');
+    return val.size() / 4 * 3 - padding;
+}
+
+bool decodeInto(std::string_view val, std::span<byte> out, bool isUrl) {
+    if (val.size() % 4 != 0 || out.size() != decodedSize(val)) {
+        return false;
+    }
+    if (val.empty()) {
+        return true;
+    }
+    // The groups before the last one have no padding and decode straight into `out`.
+    // The decoder needs room for 3 bytes per group, so the last one goes through a small buffer.
+    const auto* data = reinterpret_cast<const uint8_t*>(val.data());
+    const auto head = val.size() - 4;
+    const auto headSize = head / 4 * 3;
+    std::size_t written = 0;
+    if (head > 0 && !Rust::decode_base64_into(data, head, isUrl, out.data(), headSize, &written)) {
+        return false;
+    }
+    std::array<byte, 3> last;
+    if (!Rust::decode_base64_into(data + head, 4, isUrl, last.data(), last.size(), &written) || headSize + written != out.size()) {
+        return false;
+    }
+    std::copy_n(last.begin(), written, out.begin() + headSize);
+    return true;
+}
+
+void encodeInto(std::span<const byte> val, std::string& out, bool isUrl) {
+    internal::appendEncoded(val, out, isUrl);
+}
+
+Encoder& Encoder::append(std::span<const byte> data) {
+    if (pendingSize > 0) {
+        const auto count = std::min(data.size(), pending.size() - pendingSize);
+        std::copy_n(data.begin(), count, pending.begin() + pendingSize);
+        pendingSize += count;
+        data = data.subspan(count);
+        if (pendingSize < pending.size()) {
+            return *this;
+        }
+        internal::appendEncoded(pending, out, isUrl);
+        pendingSize = 0;
+    }
+    // whole groups are encoded without padding, the rest waits for more bytes
+    const auto whole = data.size() - data.size() % pending.size();
+    internal::appendEncoded(data.first(whole), out, isUrl);
+    std::copy(data.begin() + whole, data.end(), pending.begin());
+    pendingSize = data.size() - whole;
+    return *this;
+}
+
+void Encoder::finish() {
+    internal::appendEncoded(std::span<const byte>(pending.data(), pendingSize), out, isUrl);
+    pendingSize = 0;
+}
+
+std::string encodeBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, bool isUrl) {
+    std::vector<const uint8_t*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(payloads.size());
+    sizes.reserve(payloads.size());
+    std::size_t length = 0;
+    for (const auto& payload : payloads) {
+        pointers.push_back(payload.data());
+        sizes.push_back(payload.size());
+        length += (payload.size() + 2) / 3 * 4;
+    }
+    std::string arena(length, '\0');
+    offsets.resize(payloads.size() + 1);
+    Rust::encode_base64_batch(pointers.data(), sizes.data(), payloads.size(), isUrl,
+                              reinterpret_cast<uint8_t*>(arena.data()), arena.size(), offsets.data());
+    return arena;
+}
+
+bool decodeBatch(const std::vector<std::string>& strings, Data& out, std::vector<std::size_t>& offsets, bool isUrl) {
+    std::vector<const uint8_t*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(strings.size());
+    sizes.reserve(strings.size());
+    std::size_t capacity = 0;
+    for (const auto& string : strings) {
+        pointers.push_back(reinterpret_cast<const uint8_t*>(string.data()));
+        sizes.push_back(string.size());
+        // upper bound of the decoded size, the exact size depends on the padding
+        capacity += (string.size() + 3) / 4 * 3;
+    }
+    out.resize(capacity);
+    offsets.resize(strings.size() + 1);
+    if (!Rust::decode_base64_batch(pointers.data(), sizes.data(), strings.size(), isUrl, out.data(), out.size(), offsets.data())) {
+        out.clear();
+        offsets.clear();
+        return false;
+    }
+    out.resize(offsets.back());
+    return true;
+}
+
 } // namespace TW::Base64
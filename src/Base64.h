@@ -8,6 +8,11 @@
 
 #include "Data.h"
 
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+
 namespace TW::Base64 {
 
 // Checks if as string is in Base64-format or Base64Url-format
@@ -16,6 +21,25 @@ bool isBase64orBase64Url(const std::string& val);
 // Decode a Base64-format string
 Data decode(const std::string& val);
 
+// Decode a Base64 (or Base64Url) string into `out`, reusing its capacity instead of allocating a new buffer.
+// Returns false, with `out` empty, if the string is not valid.
+bool decodeInto(std::string_view val, Data& out, bool isUrl = false);
+
+// Length of the padded Base64 encoding of `size` bytes.
+constexpr std::size_t encodedSize(std::size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+// Exact number of bytes a padded Base64 (or Base64Url) string decodes to, 0 if its length is not a multiple of 4.
+std::size_t decodedSize(std::string_view val);
+
+// Decode a Base64 (or Base64Url) string into `out`, which must be exactly `decodedSize(val)` bytes, without allocating.
+// Returns false if the string is not valid or `out` has another size.
+bool decodeInto(std::string_view val, std::span<byte> out, bool isUrl = false);
+
+// Append the Base64 (or Base64Url) encoding of `val` to `out`, without an intermediate string.
+void encodeInto(std::span<const byte> val, std::string& out, bool isUrl = false);
+
 // Encode bytes into Base64 string
 std::string encode(const TW::Data& val);
 
@@ -26,4 +50,34 @@ Data decodeBase64Url(const std::string& val);
 // Encode bytes into Base64Url string (uses '-' and '_' as special characters)
 std::string encodeBase64Url(const Data& val);
 
+// Encode every payload into one Base64 (or Base64Url) string, with a single call into the Rust library.
+// `offsets` receives the start of each encoding followed by the end of the last one,
+// so encoding `i` is `[offsets[i], offsets[i + 1])`.
+std::string encodeBatch(const std::vector<Data>& payloads, std::vector<std::size_t>& offsets, bool isUrl = false);
+
+// Decode every Base64 (or Base64Url) string into `out`, with `offsets` as in `encodeBatch`.
+// Returns false, with `out` and `offsets` empty, if a string is not valid.
+bool decodeBatch(const std::vector<std::string>& strings, Data& out, std::vector<std::size_t>& offsets, bool isUrl = false);
+
+// Incremental Base64 (or Base64Url) encoder, appending to `out` as a serializer produces the bytes, so the input
+// doesn't need to be assembled in one buffer. The result is the encoding of all the appended bytes once `finish`ed.
+class Encoder {
+public:
+    // `out` must outlive the encoder.
+    explicit Encoder(std::string& out, bool isUrl = false) : out(out), isUrl(isUrl) {}
+
+    Encoder& append(std::span<const byte> data);
+    Encoder& append(byte value) { return append(std::span<const byte>(&value, 1)); }
+
+    // Encode the last incomplete group, with padding.
+    void finish();
+
+private:
+    std::string& out;
+    bool isUrl;
+    // bytes not encoded yet, short of a group of 3
+    std::array<byte, 3> pending{};
+    std::size_t pendingSize = 0;
+};
+
 } // namespace TW::Base64
@@ -36,16 +36,23 @@ constexpr std::array<int8_t, 128> charset_rev = {
 const uint32_t BECH32_XOR_CONST = 0x01;
 const uint32_t BECH32M_XOR_CONST = 0x2bc830a3;
 
-/** Find the polynomial with value coefficients mod the generator as 30-bit. */
-uint32_t polymod(const Data& values) {
-    uint32_t chk = 1;
-    for (const auto& value : values) {
-        uint8_t top = chk >> 25;
-        chk = (chk & 0x1ffffff) << 5 ^ value ^ (-((top >> 0) & 1) & 0x3b6a57b2UL) ^
-              (-((top >> 1) & 1) & 0x26508e6dUL) ^ (-((top >> 2) & 1) & 0x1ea119faUL) ^
-              (-((top >> 3) & 1) & 0x3d4233ddUL) ^ (-((top >> 4) & 1) & 0x2a1462b3UL);
+/** Generator terms selected by the five bits shifted out of the checksum at each step. */
+constexpr std::array<uint32_t, 32> generatorTable = [] {
+    constexpr uint32_t generator[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+    std::array<uint32_t, 32> table{};
+    for (uint32_t top = 0; top < 32; ++top) {
+        for (int i = 0; i < 5; ++i) {
+            if ((top >> i) & 1) {
+                table[top] ^= generator[i];
+            }
+        }
     }
-    return chk;
+    return table;
+}();
+
+/** Feeds one 5-bit value into the polynomial checksum. */
+inline uint32_t polymodStep(uint32_t chk, uint8_t value) {
+    return ((chk & 0x1ffffff) << 5) ^ value ^ generatorTable[chk >> 25];
 }
 
 /** Convert to lower case. */
@@ -53,17 +60,18 @@ unsigned char lc(unsigned char c) {
     return (c >= 'A' && c <= 'Z') ? (c - 'A') + 'a' : c;
 }
 
-/** Expand a HRP for use in checksum computation. */
-Data expand_hrp(const std::string& hrp) {
-    Data ret;
-    ret.resize(hrp.size() * 2 + 1);
-    for (size_t i = 0; i < hrp.size(); ++i) {
-        unsigned char c = hrp[i];
-        ret[i] = c >> 5;
-        ret[i + hrp.size() + 1] = c & 0x1f;
+/** Feeds the expansion of a HRP into the checksum, without materializing it. */
+template <bool lowerCase>
+uint32_t polymodHrp(std::string_view hrp) {
+    uint32_t chk = 1;
+    for (unsigned char c : hrp) {
+        chk = polymodStep(chk, (lowerCase ? lc(c) : c) >> 5);
     }
-    ret[hrp.size()] = 0;
-    return ret;
+    chk = polymodStep(chk, 0);
+    for (unsigned char c : hrp) {
+        chk = polymodStep(chk, (lowerCase ? lc(c) : c) & 0x1f);
+    }
+    return chk;
 }
 
 inline uint32_t xorConstant(ChecksumVariant variant) {
@@ -74,96 +82,92 @@ inline uint32_t xorConstant(ChecksumVariant variant) {
     return BECH32M_XOR_CONST;
 }
 
-/** Verify a checksum. */
-ChecksumVariant verify_checksum(const std::string& hrp, const Data& values) {
-    Data enc = expand_hrp(hrp);
-    append(enc, values);
-    auto poly = polymod(enc);
-    if (poly == BECH32_XOR_CONST) {
-        return ChecksumVariant::Bech32;
+} // namespace
+
+/** Encode a Bech32 string. */
+std::string encode(const std::string& hrp, const byte* values, std::size_t size, ChecksumVariant variant) {
+    std::string ret;
+    ret.reserve(hrp.size() + 1 + size + 6);
+    ret.append(hrp);
+    ret.push_back('1');
+    auto chk = polymodHrp<false>(hrp);
+    for (std::size_t i = 0; i < size; ++i) {
+        chk = polymodStep(chk, values[i]);
+        ret.push_back(charset[values[i]]);
     }
-    if (poly == BECH32M_XOR_CONST) {
-        return ChecksumVariant::Bech32M;
+    for (int i = 0; i < 6; ++i) {
+        chk = polymodStep(chk, 0);
     }
-    return ChecksumVariant::None;
-}
-
-/** Create a checksum. */
-Data create_checksum(const std::string& hrp, const Data& values, ChecksumVariant variant) {
-    Data enc = expand_hrp(hrp);
-    append(enc, values);
-    enc.resize(enc.size() + 6);
-    auto xorConst = xorConstant(variant);
-    uint32_t mod = polymod(enc) ^ xorConst;
-    Data ret;
-    ret.resize(6);
-    for (size_t i = 0; i < 6; ++i) {
-        ret[i] = (mod >> (5 * (5 - i))) & 31;
+    const auto mod = chk ^ xorConstant(variant);
+    for (int i = 0; i < 6; ++i) {
+        ret.push_back(charset[(mod >> (5 * (5 - i))) & 31]);
     }
     return ret;
 }
 
-} // namespace
-
-/** Encode a Bech32 string. */
 std::string encode(const std::string& hrp, const Data& values, ChecksumVariant variant) {
-    Data checksum = create_checksum(hrp, values, variant);
-    Data combined = values;
-    append(combined, checksum);
-    std::string ret = hrp + '1';
-    ret.reserve(ret.size() + combined.size());
-    for (const auto& value : combined) {
-        ret += charset[value];
-    }
-    return ret;
+    return encode(hrp, values.data(), values.size(), variant);
 }
 
-/** Decode a Bech32 string. */
-std::tuple<std::string, Data, ChecksumVariant> decode(const std::string& str) {
+ChecksumVariant verify(std::string_view str, std::size_t& separator) {
     if (str.length() > 120 || str.length() < 2) {
         // too long or too short
-        return std::make_tuple(std::string(), Data(), None);
+        return None;
     }
     bool lower = false, upper = false;
-    bool ok = true;
-    for (size_t i = 0; ok && i < str.size(); ++i) {
-        unsigned char c = str[i];
+    for (unsigned char c : str) {
         if (c < 33 || c > 126) {
-            ok = false;
-        }
-        if (c >= 'a' && c <= 'z') {
-            lower = true;
-        }
-        if (c >= 'A' && c <= 'Z') {
-            upper = true;
+            return None;
         }
+        lower |= (c >= 'a' && c <= 'z');
+        upper |= (c >= 'A' && c <= 'Z');
     }
     if (lower && upper) {
-        ok = false;
-    }
-    size_t pos = str.rfind('1');
-    if (ok && pos != std::string::npos && pos >= 1 && pos + 7 <= str.size()) {
-        Data values;
-        values.resize(str.size() - 1 - pos);
-        for (size_t i = 0; i < str.size() - 1 - pos; ++i) {
-            unsigned char c = str[i + pos + 1];
-            if (charset_rev[c] == -1) {
-                ok = false;
-            }
-            values[i] = charset_rev[c];
-        }
-        if (ok) {
-            std::string hrp;
-            for (size_t i = 0; i < pos; ++i) {
-                hrp += lc(str[i]);
-            }
-            auto variant = verify_checksum(hrp, values);
-            if (variant != None) {
-                return std::make_tuple(hrp, Data(values.begin(), values.end() - 6), variant);
-            }
+        return None;
+    }
+    const auto pos = str.rfind('1');
+    if (pos == std::string_view::npos || pos < 1 || pos + 7 > str.size()) {
+        return None;
+    }
+    auto chk = polymodHrp<true>(str.substr(0, pos));
+    for (std::size_t i = pos + 1; i < str.size(); ++i) {
+        const auto value = charset_rev[static_cast<unsigned char>(str[i])];
+        if (value == -1) {
+            return None;
         }
+        chk = polymodStep(chk, static_cast<uint8_t>(value));
+    }
+    separator = pos;
+    if (chk == BECH32_XOR_CONST) {
+        return ChecksumVariant::Bech32;
+    }
+    if (chk == BECH32M_XOR_CONST) {
+        return ChecksumVariant::Bech32M;
+    }
+    return None;
+}
+
+int8_t valueOf(char c) {
+    const auto index = static_cast<unsigned char>(c);
+    return index < charset_rev.size() ? charset_rev[index] : -1;
+}
+
+/** Decode a Bech32 string. */
+std::tuple<std::string, Data, ChecksumVariant> decode(const std::string& str) {
+    std::size_t pos = 0;
+    const auto variant = verify(str, pos);
+    if (variant == None) {
+        return std::make_tuple(std::string(), Data(), None);
+    }
+    std::string hrp(pos, '\0');
+    for (size_t i = 0; i < pos; ++i) {
+        hrp[i] = static_cast<char>(lc(str[i]));
+    }
+    Data values(str.size() - 1 - pos - 6);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<byte>(charset_rev[static_cast<unsigned char>(str[i + pos + 1])]);
     }
-    return std::make_tuple(std::string(), Data(), None);
+    return std::make_tuple(std::move(hrp), std::move(values), variant);
 }
 
 } // namespace TW::Bech32
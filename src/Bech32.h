@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <tuple>
 
@@ -27,6 +28,9 @@ enum ChecksumVariant {
 /// \returns the encoded string, or an empty string in case of failure.
 std::string encode(const std::string& hrp, const Data& values, ChecksumVariant variant);
 
+/// Encodes `size` 5-bit values, as encode() above.
+std::string encode(const std::string& hrp, const byte* values, std::size_t size, ChecksumVariant variant);
+
 /// Decodes a Bech32 string.
 ///
 /// \returns a tuple with
@@ -36,28 +40,56 @@ std::string encode(const std::string& hrp, const Data& values, ChecksumVariant v
 /// or empty values on failure.
 std::tuple<std::string, Data, ChecksumVariant> decode(const std::string& str);
 
-/// Converts from one power-of-2 number base to another.
+/// Checks the format and checksum of a Bech32 string, without materializing its HRP and data.
+///
+/// \returns the checksum variant, or None if invalid; on success `separator` is the position of the separator '1',
+/// so the HRP has `separator` characters and the data `str.size() - separator - 7` values.
+ChecksumVariant verify(std::string_view str, std::size_t& separator);
+
+/// Returns the 5-bit value of a Bech32 data character (either case), or -1 if it is not one.
+int8_t valueOf(char c);
+
+/// Number of output groups produced by convertBits for `size` input groups.
 template <int frombits, int tobits, bool pad>
-inline bool convertBits(Data& out, const Data& in) {
+constexpr std::size_t convertedSize(std::size_t size) {
+    return (size * frombits + (pad ? tobits - 1 : 0)) / tobits;
+}
+
+/// Converts from one power-of-2 number base to another, writing into `out`,
+/// which must have room for convertedSize() groups; `outSize` receives the number written.
+template <int frombits, int tobits, bool pad>
+inline bool convertBits(const byte* in, std::size_t size, byte* out, std::size_t& outSize) {
     int acc = 0;
     int bits = 0;
     const int maxv = (1 << tobits) - 1;
     const int max_acc = (1 << (frombits + tobits - 1)) - 1;
-    for (const auto& value : in) {
-        acc = ((acc << frombits) | value) & max_acc;
+    outSize = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        acc = ((acc << frombits) | in[i]) & max_acc;
         bits += frombits;
         while (bits >= tobits) {
             bits -= tobits;
-            out.push_back((acc >> bits) & maxv);
+            out[outSize++] = (acc >> bits) & maxv;
         }
     }
     if (pad) {
         if (bits)
-            out.push_back((acc << (tobits - bits)) & maxv);
+            out[outSize++] = (acc << (tobits - bits)) & maxv;
     } else if (bits >= frombits || ((acc << (tobits - bits)) & maxv)) {
         return false;
     }
     return true;
 }
 
+/// Converts from one power-of-2 number base to another.
+template <int frombits, int tobits, bool pad>
+inline bool convertBits(Data& out, const Data& in) {
+    const auto offset = out.size();
+    out.resize(offset + convertedSize<frombits, tobits, pad>(in.size()));
+    std::size_t written = 0;
+    const auto success = convertBits<frombits, tobits, pad>(in.data(), in.size(), out.data() + offset, written);
+    out.resize(offset + written);
+    return success;
+}
+
 } // namespace TW::Bech32
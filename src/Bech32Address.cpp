@@ -9,6 +9,9 @@
 #include "Data.h"
 #include <TrezorCrypto/ecdsa.h>
 
+#include <array>
+#include <cctype>
+
 using namespace TW;
 
 bool Bech32Address::isValid(const std::string& addr) {
@@ -16,22 +19,41 @@ bool Bech32Address::isValid(const std::string& addr) {
 }
 
 bool Bech32Address::isValid(const std::string& addr, const std::string& hrp) {
-    auto dec = Bech32::decode(addr);
-    // check hrp prefix (if given)
-    if (hrp.length() > 0 && std::get<0>(dec).compare(0, hrp.length(), hrp) != 0) {
+    // Validity only needs the checksum and the lengths, the data is not decoded.
+    std::size_t separator = 0;
+    if (Bech32::verify(addr, separator) == Bech32::None) {
         return false;
     }
-    if (std::get<1>(dec).empty()) {
+    // check hrp prefix (if given), the decoded hrp is lower case
+    if (hrp.length() > separator) {
+        return false;
+    }
+    for (std::size_t i = 0; i < hrp.length(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(addr[i])) != hrp[i]) {
+            return false;
+        }
+    }
+    const auto values = addr.size() - separator - 7;
+    if (values == 0) {
         return false;
     }
 
-    Data conv;
-    auto success = Bech32::convertBits<5, 8, false>(conv, std::get<1>(dec));
-    if (!success || conv.size() < 2 || conv.size() > 40) {
+    // Same outcome as convertBits<5, 8, false>: the leftover bits must be fewer than 5 and all zero.
+    const auto leftover = (values * 5) % 8;
+    const auto last = Bech32::valueOf(addr[addr.size() - 7]);
+    if (leftover >= 5 || (last & ((1 << leftover) - 1)) != 0) {
         return false;
     }
+    const auto size = values * 5 / 8;
+    return size >= 2 && size <= 40;
+}
 
-    return true;
+std::vector<bool> Bech32Address::isValidBatch(const std::vector<std::string>& addrs, const std::string& hrp) {
+    std::vector<bool> valid(addrs.size());
+    for (std::size_t i = 0; i < addrs.size(); ++i) {
+        valid[i] = isValid(addrs[i], hrp);
+    }
+    return valid;
 }
 
 bool Bech32Address::decode(const std::string& addr, Bech32Address& obj_out, const std::string& hrp) {
@@ -57,26 +79,53 @@ bool Bech32Address::decode(const std::string& addr, Bech32Address& obj_out, cons
 
 Bech32Address::Bech32Address(const std::string& hrp, Hash::Hasher hasher, const PublicKey& publicKey)
 : hrp(hrp) {
-    bool skipTypeByte = false;
-    // Extended-key / keccak-hash skips first byte (Evmos)
-    if (publicKey.type == TWPublicKeyTypeSECP256k1Extended || hasher == Hash::HasherKeccak256) {
-        skipTypeByte = true;
-    }
-    const auto hash = publicKey.hash({}, hasher, skipTypeByte);
-    auto key = subData(hash, hash.size() - 20, 20);
-    setKey(key);
+    keyHash = Hash::withHasher(hasher, [&](auto selected) {
+        return keyHashOf<decltype(selected)::value>(publicKey);
+    });
 }
 
-std::string Bech32Address::string() const {
-    Data enc;
-    if (!Bech32::convertBits<8, 5, true>(enc, keyHash)) {
-        return "";
-    }
-    std::string result = Bech32::encode(hrp, enc, Bech32::ChecksumVariant::Bech32);
-    // check back
-    Bech32Address obj;
-    if (!decode(result, obj, hrp)) {
+namespace {
+
+/// Encodes converted key hash values, checking back the result; empty if it isn't a valid address.
+std::string encodeChecked(const std::string& hrp, const byte* values, std::size_t size) {
+    std::string result = Bech32::encode(hrp, values, size, Bech32::ChecksumVariant::Bech32);
+    if (!Bech32Address::isValid(result, hrp)) {
         return "";
     }
     return result;
 }
+
+/// Converts the key hash to 5-bit values and passes them to `encode`, without allocating for valid key hashes.
+template <typename Encode>
+auto withValues(const Data& keyHash, Encode&& encode) {
+    // Key hashes are at most 40 bytes for a valid address, larger ones fail the check back.
+    std::array<byte, Bech32::convertedSize<8, 5, true>(64)> stack;
+    Data heap;
+    byte* values = stack.data();
+    if (keyHash.size() > 64) {
+        heap.resize(Bech32::convertedSize<8, 5, true>(keyHash.size()));
+        values = heap.data();
+    }
+    std::size_t size = 0;
+    const auto converted = Bech32::convertBits<8, 5, true>(keyHash.data(), keyHash.size(), values, size);
+    return encode(converted, values, size);
+}
+
+} // namespace
+
+std::string Bech32Address::string() const {
+    return withValues(keyHash, [&](bool converted, const byte* values, std::size_t size) {
+        return converted ? encodeChecked(hrp, values, size) : std::string();
+    });
+}
+
+std::vector<std::string> Bech32Address::strings(const Data& keyHash, const std::vector<std::string>& hrps) {
+    return withValues(keyHash, [&](bool converted, const byte* values, std::size_t size) {
+        std::vector<std::string> result;
+        result.reserve(hrps.size());
+        for (const auto& hrp : hrps) {
+            result.push_back(converted ? encodeChecked(hrp, values, size) : std::string());
+        }
+        return result;
+    });
+}
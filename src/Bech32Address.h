@@ -12,6 +12,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace TW {
 
@@ -32,6 +33,9 @@ public:
     /// Determines whether a string makes a valid Bech32 address, and the HRP matches.
     static bool isValid(const std::string& addr, const std::string& hrp);
 
+    /// Determines for each string whether it makes a valid Bech32 address and the HRP matches (if given).
+    static std::vector<bool> isValidBatch(const std::vector<std::string>& addrs, const std::string& hrp);
+
     /// Decodes an address and create an address object out of it.  
     /// obj_out:  Pass-by-ref, result is initialized here if possible, it can be a derived address type.
     /// hrp: the expected hrp prefix (if missing ("") no prefix check is done).
@@ -47,6 +51,11 @@ public:
     /// Initialization from public key --> chain specific hash methods
     Bech32Address(const std::string& hrp, Hash::Hasher hasher, const PublicKey& publicKey);
 
+    /// Initialization from public key, with the chain specific hash method selected at compile time.
+    template <Hash::Hasher H>
+    Bech32Address(const std::string& hrp, Hash::HasherConstant<H>, const PublicKey& publicKey)
+        : hrp(hrp), keyHash(keyHashOf<H>(publicKey)) {}
+
     void setHrp(const std::string& hrp_in) { hrp = std::move(hrp_in); }
     void setKey(const Data& keyHash_in) { keyHash = std::move(keyHash_in); }
 
@@ -58,10 +67,24 @@ public:
     /// \returns encoded address string, or empty string on failure.
     std::string string() const;
 
+    /// Encodes the key hash with each of the prefixes, as `string()` of the address with each prefix would;
+    /// the key hash is converted to 5-bit values once, only the checksum is computed for each prefix.
+    static std::vector<std::string> strings(const Data& keyHash, const std::vector<std::string>& hrps);
+
     bool operator==(const Bech32Address& rhs) const { return hrp == rhs.hrp && keyHash == rhs.keyHash; }
 
 private:
     Bech32Address() = default;
+
+    /// The last 20 bytes of the public key hash.
+    template <Hash::Hasher H>
+    static Data keyHashOf(const PublicKey& publicKey) {
+        // Extended-key / keccak-hash skips first byte (Evmos)
+        const bool skipTypeByte = publicKey.type == TWPublicKeyTypeSECP256k1Extended || H == Hash::HasherKeccak256;
+        const auto hash = publicKey.hash<H>(skipTypeByte);
+        static_assert(Hash::digestSize(H) >= 20);
+        return Data(hash.end() - 20, hash.end());
+    }
 };
 
 } // namespace TW
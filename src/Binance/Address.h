@@ -27,8 +27,8 @@ public:
     Address(const Data& keyHash) : Bech32Address(_hrp, keyHash) {}
 
     /// Initializes an address with a public key.
-    Address(const PublicKey& publicKey) : Bech32Address(_hrp, Hash::HasherSha256ripemd, publicKey) {}
-    Address(const PublicKey& publicKey, const std::string hrp) : Bech32Address(hrp, Hash::HasherSha256ripemd, publicKey) {}
+    Address(const PublicKey& publicKey) : Bech32Address(_hrp, Hash::HasherConstant<Hash::HasherSha256ripemd>{}, publicKey) {}
+    Address(const PublicKey& publicKey, const std::string hrp) : Bech32Address(hrp, Hash::HasherConstant<Hash::HasherSha256ripemd>{}, publicKey) {}
 
     static bool decode(const std::string& addr, Address& obj_out);
 };
@@ -37,6 +37,27 @@ json signatureJSON(const Proto::SigningInput& input) {
     return j;
 }
 
+SignDocWriter::SignDocWriter(const Proto::SigningInput& input) {
+    head = R"({"account_number":")" + std::to_string(input.account_number()) +
+           R"(","chain_id":)" + json(input.chain_id()).dump() +
+           R"(,"data":null,"memo":)" + json(input.memo()).dump() +
+           R"(,"msgs":[)";
+    tail = R"(","source":")" + std::to_string(input.source()) + R"("})";
+}
+
+std::string SignDocWriter::write(const json& order, int64_t sequence) const {
+    const auto sequenceString = std::to_string(sequence);
+    const auto orderString = order.dump();
+    std::string doc;
+    doc.reserve(head.size() + orderString.size() + sequenceString.size() + tail.size() + 16);
+    doc += head;
+    doc += orderString;
+    doc += R"(],"sequence":")";
+    doc += sequenceString;
+    doc += tail;
+    return doc;
+}
+
 json orderJSON(const Proto::SigningInput& input) {
     json j;
     if (input.has_trade_order()) {
@@ -9,6 +9,9 @@
 #include "../proto/Binance.pb.h"
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
+#include <string>
+
 namespace TW::Binance {
 
 nlohmann::json signatureJSON(const Proto::SigningInput& input);
@@ -18,4 +21,20 @@ nlohmann::json outputsJSON(const Proto::SendOrder& order);
 nlohmann::json tokenJSON(const Proto::SendOrder_Token& token, bool stringAmount = false);
 nlohmann::json tokensJSON(const ::google::protobuf::RepeatedPtrField<Proto::SendOrder_Token>& tokens);
 
+/// Writes the canonical sign doc, `signatureJSON(input).dump()`, without building the envelope object:
+/// its fields (sorted keys, compact) are escaped once, so orders can be written with the same envelope
+/// and successive sequence numbers.
+class SignDocWriter {
+  public:
+    explicit SignDocWriter(const Proto::SigningInput& input);
+
+    std::string write(const nlohmann::json& order, int64_t sequence) const;
+
+  private:
+    /// `{"account_number":...,"msgs":[`
+    std::string head;
+    /// `","source":"..."}`
+    std::string tail;
+};
+
 } // namespace TW::Binance
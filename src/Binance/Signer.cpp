@@ -8,10 +8,7 @@
 #include "Serialization.h"
 #include "../HexCoding.h"
 #include "../PrivateKey.h"
-
-#include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
-#include <google/protobuf/util/json_util.h>
+#include "../proto/Binance.json.pb.h"
 
 #include <string>
 
@@ -51,7 +48,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return hex(output.encoded());
@@ -91,9 +88,38 @@ Proto::SigningOutput Signer::compile(const Data& signature, const PublicKey& pub
     return output;
 }
 
+std::vector<Proto::SigningOutput> Signer::signBatch(const Proto::SigningInput& envelope, const std::vector<Proto::SigningInput>& orders) {
+    // shared by all orders: key, encoded public key, sign doc envelope
+    const auto key = PrivateKey(envelope.private_key());
+    const auto encodedPublicKey = encodePublicKey(key.getPublicKey(TWPublicKeyTypeSECP256k1));
+    const auto writer = SignDocWriter(envelope);
+
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(orders.size());
+    auto signer = Signer(Proto::SigningInput());
+    auto sequence = envelope.sequence();
+    for (const auto& order : orders) {
+        auto& input = signer.input;
+        input = order;
+        input.set_chain_id(envelope.chain_id());
+        input.set_account_number(envelope.account_number());
+        input.set_sequence(sequence++);
+        input.set_source(envelope.source());
+        input.set_memo(envelope.memo());
+        input.clear_private_key();
+
+        const auto hash = Hash::sha256(writer.write(orderJSON(input), input.sequence()));
+        auto signature = key.sign(hash, TWCurveSECP256k1);
+        signature.pop_back();
+        const auto encoded = signer.encodeTransaction(signer.encodeSignature(signature, encodedPublicKey));
+        auto& output = outputs.emplace_back();
+        output.set_encoded(encoded.data(), encoded.size());
+    }
+    return outputs;
+}
+
 std::string Signer::signaturePreimage() const {
-    auto json = signatureJSON(input);
-    return json.dump();
+    return SignDocWriter(input).write(orderJSON(input), input.sequence());
 }
 
 Data Signer::encodeTransaction(const Data& signature) const {
@@ -110,68 +136,68 @@ Data Signer::encodeTransaction(const Data& signature) const {
 
 Data Signer::encodeOrder() const {
     std::string data;
-    Data prefix;
+    const Data* prefix;
     if (input.has_trade_order()) {
         data = input.trade_order().SerializeAsString();
-        prefix = tradeOrderPrefix;
+        prefix = &tradeOrderPrefix;
     } else if (input.has_cancel_trade_order()) {
         data = input.cancel_trade_order().SerializeAsString();
-        prefix = cancelTradeOrderPrefix;
+        prefix = &cancelTradeOrderPrefix;
     } else if (input.has_send_order()) {
         data = input.send_order().SerializeAsString();
-        prefix = sendOrderPrefix;
+        prefix = &sendOrderPrefix;
     } else if (input.has_issue_order()) {
         data = input.issue_order().SerializeAsString();
-        prefix = tokenIssueOrderPrefix;
+        prefix = &tokenIssueOrderPrefix;
     } else if (input.has_mint_order()) {
         data = input.mint_order().SerializeAsString();
-        prefix = tokenMintOrderPrefix;
+        prefix = &tokenMintOrderPrefix;
     } else if (input.has_burn_order()) {
         data = input.burn_order().SerializeAsString();
-        prefix = tokenBurnOrderPrefix;
+        prefix = &tokenBurnOrderPrefix;
     } else if (input.has_freeze_order()) {
         data = input.freeze_order().SerializeAsString();
-        prefix = tokenFreezeOrderPrefix;
+        prefix = &tokenFreezeOrderPrefix;
     } else if (input.has_unfreeze_order()) {
         data = input.unfreeze_order().SerializeAsString();
-        prefix = tokenUnfreezeOrderPrefix;
+        prefix = &tokenUnfreezeOrderPrefix;
     } else if (input.has_htlt_order()) {
         data = input.htlt_order().SerializeAsString();
-        prefix = HTLTOrderPrefix;
+        prefix = &HTLTOrderPrefix;
     } else if (input.has_deposithtlt_order()) {
         data = input.deposithtlt_order().SerializeAsString();
-        prefix = depositHTLTOrderPrefix;
+        prefix = &depositHTLTOrderPrefix;
     } else if (input.has_claimhtlt_order()) {
         data = input.claimhtlt_order().SerializeAsString();
-        prefix = claimHTLTOrderPrefix;
+        prefix = &claimHTLTOrderPrefix;
     } else if (input.has_refundhtlt_order()) {
         data = input.refundhtlt_order().SerializeAsString();
-        prefix = refundHTLTOrderPrefix;
+        prefix = &refundHTLTOrderPrefix;
     } else if (input.has_transfer_out_order()) {
         data = input.transfer_out_order().SerializeAsString();
-        prefix = transferOutOrderPrefix;
+        prefix = &transferOutOrderPrefix;
     } else if (input.has_side_delegate_order()) {
         data = input.side_delegate_order().SerializeAsString();
-        prefix = sideDelegateOrderPrefix;
+        prefix = &sideDelegateOrderPrefix;
     } else if (input.has_side_redelegate_order()) {
         data = input.side_redelegate_order().SerializeAsString();
-        prefix = sideRedelegateOrderPrefix;
+        prefix = &sideRedelegateOrderPrefix;
     } else if (input.has_side_undelegate_order()) {
         data = input.side_undelegate_order().SerializeAsString();
-        prefix = sideUndelegateOrderPrefix;
+        prefix = &sideUndelegateOrderPrefix;
     } else if (input.has_time_lock_order()) {
         data = input.time_lock_order().SerializeAsString();
-        prefix = timeLockOrderPrefix;
+        prefix = &timeLockOrderPrefix;
     } else if (input.has_time_relock_order()) {
         data = input.time_relock_order().SerializeAsString();
-        prefix = timeRelockOrderPrefix;
+        prefix = &timeRelockOrderPrefix;
     } else if (input.has_time_unlock_order()) {
         data = input.time_unlock_order().SerializeAsString();
-        prefix = timeUnlockOrderPrefix;
+        prefix = &timeUnlockOrderPrefix;
     } else {
         return {};
     }
-    return aminoWrap(data, prefix, false);
+    return aminoWrap(data, *prefix, false);
 }
 
 Data Signer::encodeSignature(const Data& signature) const {
@@ -181,10 +207,17 @@ Data Signer::encodeSignature(const Data& signature) const {
 }
 
 Data Signer::encodeSignature(const Data& signature, const PublicKey& publicKey) const {
+    return encodeSignature(signature, encodePublicKey(publicKey));
+}
+
+Data Signer::encodePublicKey(const PublicKey& publicKey) {
     auto encodedPublicKey = pubKeyPrefix;
     encodedPublicKey.insert(encodedPublicKey.end(), static_cast<uint8_t>(publicKey.bytes.size()));
     encodedPublicKey.insert(encodedPublicKey.end(), publicKey.bytes.begin(), publicKey.bytes.end());
+    return encodedPublicKey;
+}
 
+Data Signer::encodeSignature(const Data& signature, const Data& encodedPublicKey) const {
     auto object = Binance::Proto::Signature();
     object.set_pub_key(encodedPublicKey.data(), encodedPublicKey.size());
     object.set_signature(signature.data(), signature.size());
@@ -196,24 +229,20 @@ Data Signer::encodeSignature(const Data& signature, const PublicKey& publicKey)
 
 Data Signer::aminoWrap(const std::string& raw, const Data& typePrefix, bool prefixWithSize) const {
     const auto contentsSize = raw.size() + typePrefix.size();
-    auto size = contentsSize;
+    Data msg;
+    msg.reserve(contentsSize + (prefixWithSize ? 10 : 0));
     if (prefixWithSize) {
-        size += 10;
-    }
-
-    std::string msg;
-    msg.reserve(size);
-    {
-        google::protobuf::io::StringOutputStream output(&msg);
-        google::protobuf::io::CodedOutputStream cos(&output);
-        if (prefixWithSize) {
-            cos.WriteVarint64(contentsSize);
+        // varint length
+        auto size = static_cast<uint64_t>(contentsSize);
+        while (size >= 0x80) {
+            msg.push_back(static_cast<byte>(size | 0x80));
+            size >>= 7;
         }
-        cos.WriteRaw(typePrefix.data(), static_cast<int>(typePrefix.size()));
-        cos.WriteRaw(raw.data(), static_cast<int>(raw.size()));
+        msg.push_back(static_cast<byte>(size));
     }
-
-    return {msg.begin(), msg.end()};
+    msg.insert(msg.end(), typePrefix.begin(), typePrefix.end());
+    msg.insert(msg.end(), raw.begin(), raw.end());
+    return msg;
 }
 
 } // namespace TW::Binance
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 namespace TW::Binance {
 
@@ -22,6 +23,10 @@ class Signer {
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
+    /// Signs the orders of `orders` (other fields are ignored) with the chain id, account number, source,
+    /// memo and key of `envelope`, and sequence numbers incremented from the envelope's.
+    /// The key, public key encoding and sign doc envelope are prepared once for all orders.
+    static std::vector<Proto::SigningOutput> signBatch(const Proto::SigningInput& envelope, const std::vector<Proto::SigningInput>& orders);
   public:
     Proto::SigningInput input;
 
@@ -49,6 +54,8 @@ class Signer {
     TW::Data encodeOrder() const;
     TW::Data encodeSignature(const TW::Data& signature) const;
     TW::Data encodeSignature(const TW::Data& signature, const PublicKey& publicKey) const;
+    TW::Data encodeSignature(const TW::Data& signature, const TW::Data& encodedPublicKey) const;
+    static TW::Data encodePublicKey(const PublicKey& publicKey);
     TW::Data aminoWrap(const std::string& raw, const TW::Data& typePrefix,
                        bool isPrefixLength) const;
 };
@@ -11,8 +11,57 @@
 #include "SegwitAddress.h"
 #include "Signer.h"
 
+#include <algorithm>
+
 namespace TW::Bitcoin {
 
+namespace {
+
+/// The address of a compressed public key with the given hash160, for the coins without cash addresses.
+std::string keyHashAddress(TWCoinType coin, const Data& keyHash, TWDerivation derivation, const PrefixVariant& addressPrefix) {
+    byte p2pkh = getFromPrefixPkhOrDefault(addressPrefix, coin);
+    const char* hrp = getFromPrefixHrpOrDefault(addressPrefix, coin);
+    const auto legacy = [&] {
+        Data data = {p2pkh};
+        append(data, keyHash);
+        return Address(data).string();
+    };
+
+    switch (coin) {
+    case TWCoinTypeBitcoin:
+    case TWCoinTypeLitecoin:
+        switch (derivation) {
+        case TWDerivationBitcoinLegacy:
+        case TWDerivationLitecoinLegacy:
+            return legacy();
+
+        case TWDerivationBitcoinTestnet:
+            return SegwitAddress(SegwitAddress::TestnetPrefix, 0, keyHash).string();
+
+        case TWDerivationBitcoinSegwit:
+        case TWDerivationDefault:
+        default:
+            return SegwitAddress(hrp, 0, keyHash).string();
+        }
+
+    case TWCoinTypeDigiByte:
+    case TWCoinTypeViacoin:
+    case TWCoinTypeBitcoinGold:
+        return SegwitAddress(hrp, 0, keyHash).string();
+
+    case TWCoinTypeDash:
+    case TWCoinTypeDogecoin:
+    case TWCoinTypeMonacoin:
+    case TWCoinTypeQtum:
+    case TWCoinTypeRavencoin:
+    case TWCoinTypeFiro:
+    default:
+        return legacy();
+    }
+}
+
+} // namespace
+
 bool Entry::validateAddress(TWCoinType coin, const std::string& address, const PrefixVariant& addressPrefix) const {
     auto* base58Prefix = std::get_if<Base58Prefix>(&addressPrefix);
     auto* hrp = std::get_if<Bech32Prefix>(&addressPrefix);
@@ -64,46 +113,46 @@ std::string Entry::normalizeAddress(TWCoinType coin, const std::string& address)
 }
 
 std::string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const {
-    byte p2pkh = getFromPrefixPkhOrDefault(addressPrefix, coin);
-    const char* hrp = getFromPrefixHrpOrDefault(addressPrefix, coin);
-
     switch (coin) {
-    case TWCoinTypeBitcoin:
-    case TWCoinTypeLitecoin:
-        switch (derivation) {
-        case TWDerivationBitcoinLegacy:
-        case TWDerivationLitecoinLegacy:
-            return Address(publicKey, p2pkh).string();
-
-        case TWDerivationBitcoinTestnet:
-            return SegwitAddress::createTestnetFromPublicKey(publicKey).string();
-
-        case TWDerivationBitcoinSegwit:
-        case TWDerivationDefault:
-        default:
-            return SegwitAddress(publicKey, hrp).string();
-        }
-
-    case TWCoinTypeDigiByte:
-    case TWCoinTypeViacoin:
-    case TWCoinTypeBitcoinGold:
-        return SegwitAddress(publicKey, hrp).string();
-
     case TWCoinTypeBitcoinCash:
         return BitcoinCashAddress(publicKey).string();
 
     case TWCoinTypeECash:
         return ECashAddress(publicKey).string();
 
-    case TWCoinTypeDash:
-    case TWCoinTypeDogecoin:
-    case TWCoinTypeMonacoin:
-    case TWCoinTypeQtum:
-    case TWCoinTypeRavencoin:
-    case TWCoinTypeFiro:
     default:
-        return Address(publicKey, p2pkh).string();
+        if (publicKey.type != TWPublicKeyTypeSECP256k1) {
+            throw std::invalid_argument("Bitcoin address needs a compressed SECP256k1 public key.");
+        }
+        return keyHashAddress(coin, Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size()), derivation, addressPrefix);
+    }
+}
+
+std::vector<std::string> Entry::deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const {
+    const auto compressed = std::all_of(publicKeys.begin(), publicKeys.end(), [](const auto& publicKey) { return publicKey.type == TWPublicKeyTypeSECP256k1; });
+    if (coin == TWCoinTypeBitcoinCash || coin == TWCoinTypeECash || !compressed) {
+        return CoinEntry::deriveAddresses(coin, publicKeys, derivation, addressPrefix);
     }
+
+    // hash160 of all the keys together
+    std::vector<const byte*> data;
+    std::vector<size_t> sizes;
+    data.reserve(publicKeys.size());
+    sizes.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        data.push_back(publicKey.bytes.data());
+        sizes.push_back(publicKey.bytes.size());
+    }
+    Data keyHashes(publicKeys.size() * Hash::ripemdSize);
+    Hash::sha256ripemdBatchInto(data.data(), sizes.data(), publicKeys.size(), keyHashes.data());
+
+    std::vector<std::string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (std::size_t i = 0; i < publicKeys.size(); ++i) {
+        const auto keyHash = subData(keyHashes, i * Hash::ripemdSize, Hash::ripemdSize);
+        addresses.push_back(keyHashAddress(coin, keyHash, derivation, addressPrefix));
+    }
+    return addresses;
 }
 
 template <typename CashAddress>
@@ -162,30 +211,12 @@ Data Entry::preImageHashes([[maybe_unused]] TWCoinType coin, const Data& txInput
 
 void Entry::compile([[maybe_unused]] TWCoinType coin, const Data& txInputData, const std::vector<Data>& signatures,
                     const std::vector<PublicKey>& publicKeys, Data& dataOut) const {
-    auto txCompilerFunctor = [&signatures, &publicKeys](auto&& input, auto&& output) noexcept {
-        if (signatures.empty() || publicKeys.empty()) {
-            output.set_error(Common::Proto::Error_invalid_params);
-            output.set_error_message("empty signatures or publickeys");
-            return;
-        }
-
-        if (signatures.size() != publicKeys.size()) {
-            output.set_error(Common::Proto::Error_invalid_params);
-            output.set_error_message("signatures size and publickeys size not equal");
-            return;
-        }
-
-        HashPubkeyList externalSignatures;
-        auto insertFunctor = [](auto&& signature, auto&& pubkey) noexcept {
-            return std::make_pair(signature, pubkey.bytes);
-        };
-        transform(begin(signatures), end(signatures), begin(publicKeys),
-                  back_inserter(externalSignatures), insertFunctor);
-        output = Signer::sign(input, externalSignatures);
-    };
+    dataOut = txCompilerTemplate<Proto::SigningInput, Proto::SigningOutput>(
+        txInputData, [&](auto&& input, auto&& output) { output = Signer::compile(input, signatures, publicKeys); });
+}
 
-    dataOut = txCompilerTemplate<Proto::SigningInput, Proto::SigningOutput>(txInputData,
-                                                                            txCompilerFunctor);
+std::unique_ptr<CompileContext> Entry::compileContext([[maybe_unused]] TWCoinType coin, const Data& txInputData) const {
+    return Signer::compileContext(txInputData);
 }
 
 } // namespace TW::Bitcoin
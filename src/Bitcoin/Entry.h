@@ -18,6 +18,7 @@ public:
     bool validateAddress(TWCoinType coin, const std::string& address, const PrefixVariant& addressPrefix) const;
     std::string normalizeAddress(TWCoinType coin, const std::string& address) const;
     std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const;
+    std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const;
     Data addressToData(TWCoinType coin, const std::string& address) const;
     void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
     void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
@@ -25,6 +26,7 @@ public:
     Data preImageHashes(TWCoinType coin, const Data& txInputData) const;
     void compile(TWCoinType coin, const Data& txInputData, const std::vector<Data>& signatures,
                  const std::vector<PublicKey>& publicKeys, Data& dataOut) const;
+    std::unique_ptr<CompileContext> compileContext(TWCoinType coin, const Data& txInputData) const;
     // Note: buildTransactionInput is not implemented for Binance chain with UTXOs
 };
 
@@ -9,6 +9,7 @@
 #include "UTXO.h"
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <cassert>
 
@@ -199,6 +200,172 @@ std::vector<TypeWithAmount> InputSelector<TypeWithAmount>::selectSimple(int64_t
     return {};
 }
 
+template <typename TypeWithAmount>
+std::vector<typename InputSelector<TypeWithAmount>::Candidate>
+InputSelector<TypeWithAmount>::candidates(int64_t inputFee) const {
+    std::vector<Candidate> result;
+    result.reserve(_inputs.size());
+    for (auto i = 0ul; i < _inputs.size(); ++i) {
+        const auto amount = static_cast<int64_t>(_inputs[i].amount);
+        if (amount > inputFee) {
+            result.push_back(Candidate{amount - inputFee, static_cast<uint32_t>(i)});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.value > rhs.value || (lhs.value == rhs.value && lhs.index < rhs.index);
+    });
+    return result;
+}
+
+// Depth-first search over the inclusion/omission tree of the sorted candidates, as in Bitcoin Core's SelectCoinsBnB.
+template <typename TypeWithAmount>
+std::vector<std::size_t>
+InputSelector<TypeWithAmount>::branchAndBound(const std::vector<Candidate>& sorted, int64_t target,
+                                              int64_t costOfChange, std::size_t maxIterations) {
+    int64_t available = 0;
+    for (const auto& candidate : sorted) {
+        available += candidate.value;
+    }
+    if (available < target) {
+        return {};
+    }
+
+    int64_t value = 0;
+    int64_t bestExcess = std::numeric_limits<int64_t>::max();
+    std::vector<std::size_t> selection;
+    std::vector<std::size_t> best;
+    std::size_t depth = 0;
+    for (std::size_t iteration = 0; iteration < maxIterations; ++iteration, ++depth) {
+        bool backtrack = false;
+        if (value + available < target || value > target + costOfChange) {
+            // cannot reach the target, or overshoots it by more than a change output costs
+            backtrack = true;
+        } else if (value >= target) {
+            const auto excess = value - target;
+            if (excess < bestExcess || (excess == bestExcess && selection.size() < best.size())) {
+                best = selection;
+                bestExcess = excess;
+                if (excess == 0) {
+                    break;
+                }
+            }
+            backtrack = true;
+        }
+
+        if (backtrack) {
+            if (selection.empty()) {
+                // the whole tree has been explored
+                break;
+            }
+            // re-add the omitted candidates after the last included one, then omit that one instead
+            for (--depth; depth > selection.back(); --depth) {
+                available += sorted[depth].value;
+            }
+            value -= sorted[depth].value;
+            selection.pop_back();
+        } else {
+            const auto& candidate = sorted[depth];
+            available -= candidate.value;
+            // skip a branch equivalent to an already explored one: including this candidate
+            // after omitting a previous one of the same value
+            if (selection.empty() || depth - 1 == selection.back() || candidate.value != sorted[depth - 1].value) {
+                selection.push_back(depth);
+                value += candidate.value;
+            }
+        }
+    }
+    return best;
+}
+
+template <typename TypeWithAmount>
+std::vector<std::size_t>
+InputSelector<TypeWithAmount>::knapsack(const std::vector<Candidate>& sorted, int64_t target) {
+    // smallest candidate covering the target on its own, and the candidates below the target
+    std::optional<std::size_t> lowestLarger;
+    std::size_t firstSmaller = 0;
+    while (firstSmaller < sorted.size() && sorted[firstSmaller].value >= target) {
+        lowestLarger = firstSmaller++;
+    }
+    if (lowestLarger.has_value() && sorted[*lowestLarger].value == target) {
+        return {*lowestLarger};
+    }
+    int64_t smallerTotal = 0;
+    for (auto i = firstSmaller; i < sorted.size(); ++i) {
+        smallerTotal += sorted[i].value;
+    }
+    if (smallerTotal < target) {
+        if (lowestLarger.has_value()) {
+            return {*lowestLarger};
+        }
+        return {};
+    }
+
+    // accumulate the smaller candidates, largest first, then drop the ones not needed
+    std::vector<std::size_t> selection;
+    int64_t value = 0;
+    for (auto i = firstSmaller; i < sorted.size() && value < target; ++i) {
+        selection.push_back(i);
+        value += sorted[i].value;
+    }
+    for (auto it = selection.begin(); it != selection.end();) {
+        if (value - sorted[*it].value >= target) {
+            value -= sorted[*it].value;
+            it = selection.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (value != target && lowestLarger.has_value() && sorted[*lowestLarger].value <= value) {
+        return {*lowestLarger};
+    }
+    return selection;
+}
+
+template <typename TypeWithAmount>
+std::vector<TypeWithAmount>
+InputSelector<TypeWithAmount>::selectBranchAndBound(uint64_t targetValue, uint64_t byteFee,
+                                                    uint64_t numOutputs, std::size_t maxIterations) {
+    // if target value is zero, no UTXOs are needed
+    if (targetValue == 0 || _inputs.empty()) {
+        return {};
+    }
+
+    // Fees are accounted per input through effective values, and per output through the targets
+    const auto fee = static_cast<int64_t>(byteFee);
+    const auto outputs = static_cast<int64_t>(std::max<uint64_t>(numOutputs, 1));
+    const int64_t inputFee = feeCalculator.calculateSingleInput(fee);
+    const int64_t changelessFee = feeCalculator.calculate(0, outputs - 1, fee);
+    const int64_t withChangeFee = feeCalculator.calculate(0, outputs, fee);
+    // creating the change output now and spending it later
+    const int64_t costOfChange = withChangeFee - changelessFee + inputFee;
+
+    const auto sorted = candidates(inputFee);
+    const auto target = static_cast<int64_t>(targetValue);
+
+    // 1. A selection that needs no change output
+    auto positions = branchAndBound(sorted, target + changelessFee, costOfChange, maxIterations);
+    // 2. A selection with change, which is not dust
+    if (positions.empty()) {
+        positions = knapsack(sorted, target + withChangeFee + inputFee);
+    }
+    // 3. A selection with change, even if it is dust
+    if (positions.empty()) {
+        positions = knapsack(sorted, target + withChangeFee);
+    }
+
+    std::vector<TypeWithAmount> selected;
+    selected.reserve(positions.size());
+    for (auto position : positions) {
+        selected.push_back(_inputs[sorted[position].index]);
+    }
+    std::sort(selected.begin(), selected.end(),
+              [](const TypeWithAmount& lhs, const TypeWithAmount& rhs) {
+                  return lhs.amount < rhs.amount;
+              });
+    return selected;
+}
+
 template <typename TypeWithAmount>
 std::vector<TypeWithAmount>
 InputSelector<TypeWithAmount>::selectMaxAmount(int64_t byteFee) noexcept {
@@ -9,6 +9,7 @@
 #include "FeeCalculator.h"
 #include <TrustWalletCore/TWCoinType.h>
 
+#include <cstddef>
 #include <numeric>
 #include <vector>
 
@@ -32,6 +33,19 @@ public:
     std::vector<TypeWithAmount> selectSimple(int64_t targetValue, int64_t byteFee,
                                              int64_t numOutputs = 2);
 
+    /// Default search budget of `selectBranchAndBound`, in branch-and-bound steps.
+    static constexpr std::size_t defaultMaxIterations = 100'000;
+
+    /// Selects unspent transactions in the style of Bitcoin Core: a branch-and-bound search for a
+    /// selection needing no change output (excess below the cost of a change output), falling back to
+    /// a knapsack-style selection with change if none is found within `maxIterations` steps.
+    /// Works on a compact, sorted array of amounts, suitable for very large UTXO sets.
+    ///
+    /// \returns the list of selected inputs, or an empty list if there are insufficient funds.
+    std::vector<TypeWithAmount> selectBranchAndBound(uint64_t targetValue, uint64_t byteFee,
+                                                     uint64_t numOutputs = 2,
+                                                     std::size_t maxIterations = defaultMaxIterations);
+
     /// Selects UTXOs for max amount; select all except those which would reduce output (dust).
     /// Return indices. One output and no change is assumed.
     std::vector<TypeWithAmount> selectMaxAmount(int64_t byteFee) noexcept;
@@ -53,6 +67,24 @@ public:
                                                        uint64_t minimumAmount) noexcept;
 
 private:
+    /// Effective value (amount less the fee of spending it) and position of a candidate input.
+    struct Candidate {
+        int64_t value;
+        uint32_t index;
+    };
+
+    /// Returns the candidates not considered dust, sorted by decreasing effective value.
+    std::vector<Candidate> candidates(int64_t inputFee) const;
+
+    /// Branch-and-bound search for a subset with total in `[target, target + costOfChange]`, minimizing the excess.
+    /// Returns positions in `sorted`, or empty if none was found within `maxIterations` steps.
+    static std::vector<std::size_t> branchAndBound(const std::vector<Candidate>& sorted, int64_t target,
+                                                   int64_t costOfChange, std::size_t maxIterations);
+
+    /// Knapsack-style selection of a subset with total at least `target`, preferring a small excess.
+    /// Returns positions in `sorted`, or empty if the candidates are insufficient.
+    static std::vector<std::size_t> knapsack(const std::vector<Candidate>& sorted, int64_t target);
+
     const std::vector<TypeWithAmount> _inputs;
     const FeeCalculator& feeCalculator;
 };
@@ -6,12 +6,21 @@
 
 #include "MessageSigner.h"
 #include "Address.h"
+#include "OpCodes.h"
+#include "Schnorr.h"
+#include "SegwitAddress.h"
 
 #include "Base64.h"
 #include "BinaryCoding.h"
 #include "Coin.h"
 #include "Data.h"
 #include "HexCoding.h"
+#include "../algorithm/parallel.h"
+
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+
+#include <optional>
+#include <string_view>
 
 using namespace TW;
 
@@ -32,9 +41,266 @@ Data messageToFullData(const std::string& message) {
     return d;
 }
 
+namespace {
+
+using Bytes32 = std::array<byte, 32>;
+
+/// Feeds the variable-length encoding of `size`, as `encodeVarInt` writes it.
+void updateVarInt(SHA256_CTX& ctx, uint64_t size) {
+    std::array<byte, 9> encoded;
+    std::size_t length = 1;
+    if (size < 0xfd) {
+        encoded[0] = static_cast<byte>(size);
+    } else if (size <= 0xffff) {
+        encoded[0] = 0xfd;
+        length = 3;
+    } else if (size <= 0xffffffff) {
+        encoded[0] = 0xfe;
+        length = 5;
+    } else {
+        encoded[0] = 0xff;
+        length = 9;
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        encoded[i] = static_cast<byte>(size >> (8 * (i - 1)));
+    }
+    sha256_Update(&ctx, encoded.data(), length);
+}
+
+/// SHA256 context fed with the length-encoded `MessagePrefix`. The prefix is shorter than a block, so the context
+/// just buffers it; each message copies it instead of encoding and feeding the prefix again.
+const SHA256_CTX& prefixContext() {
+    static const SHA256_CTX context = [] {
+        SHA256_CTX ctx;
+        sha256_Init(&ctx);
+        const std::string_view prefix = MessageSigner::MessagePrefix;
+        updateVarInt(ctx, prefix.size());
+        sha256_Update(&ctx, reinterpret_cast<const byte*>(prefix.data()), prefix.size());
+        return ctx;
+    }();
+    return context;
+}
+
+/// SHA256d of the prefixed, length-encoded message.
+Bytes32 messageDigest(std::string_view message) {
+    auto ctx = prefixContext();
+    updateVarInt(ctx, message.size());
+    sha256_Update(&ctx, reinterpret_cast<const byte*>(message.data()), message.size());
+    Bytes32 first;
+    sha256_Final(&ctx, first.data());
+    Bytes32 digest;
+    sha256_Raw(first.data(), first.size(), digest.data());
+    return digest;
+}
+
+enum class AddressType { P2PKH, P2SH, P2WPKH, P2TR };
+
+/// Address a message is signed for: its type, and its key hash (Taproot output key for P2TR).
+struct Target {
+    AddressType type;
+    Data program;
+};
+
+std::optional<Target> parseTarget(const std::string& address) {
+    if (Address::isValid(address)) {
+        const auto legacy = Address(address);
+        auto hash = Data(legacy.bytes.begin() + 1, legacy.bytes.end());
+        if (legacy.bytes[0] == TW::p2pkhPrefix(TWCoinTypeBitcoin)) {
+            return Target{AddressType::P2PKH, std::move(hash)};
+        }
+        if (legacy.bytes[0] == TW::p2shPrefix(TWCoinTypeBitcoin)) {
+            return Target{AddressType::P2SH, std::move(hash)};
+        }
+        return std::nullopt;
+    }
+    auto [segwit, hrp, valid] = SegwitAddress::decode(address);
+    if (!valid) {
+        return std::nullopt;
+    }
+    if (segwit.witnessVersion == 0 && segwit.witnessProgram.size() == Hash::ripemdSize) {
+        return Target{AddressType::P2WPKH, std::move(segwit.witnessProgram)};
+    }
+    if (segwit.witnessVersion == 1 && segwit.witnessProgram.size() == XOnlyPublicKey::size) {
+        return Target{AddressType::P2TR, std::move(segwit.witnessProgram)};
+    }
+    return std::nullopt;
+}
+
+/// Hash a recovered 65-byte key is committed to by an address: the hash160 of the key, or of its P2WPKH script
+/// for P2SH-P2WPKH.
+Hash::Digest20 committedHash(AddressType type, const byte* extended, bool compressed) {
+    std::array<byte, 65> key;
+    std::size_t size = key.size();
+    if (compressed) {
+        key[0] = 0x02 | (extended[64] & 0x01);
+        std::copy(extended + 1, extended + 33, key.begin() + 1);
+        size = 33;
+    } else {
+        std::copy(extended, extended + 65, key.begin());
+    }
+    auto hash = Hash::sha256ripemdInto(key.data(), size);
+    if (type == AddressType::P2SH) {
+        std::array<byte, 22> script{0x00, 0x14};
+        std::copy(hash.begin(), hash.end(), script.begin() + 2);
+        hash = Hash::sha256ripemdInto(script.data(), script.size());
+    }
+    return hash;
+}
+
+// BIP322: the signature is the witness of the input of a virtual `to_sign` transaction, spending the output of a
+// virtual `to_spend` transaction which commits to the message. Both have version 0 and lock time 0, and `to_sign`
+// has a single output: 0 sat to an empty OP_RETURN.
+
+const TaggedHash& bip322MessageHash() {
+    static const TaggedHash hasher("BIP0322-signed-message");
+    return hasher;
+}
+
+/// The output of `to_sign`: value 0, script OP_RETURN.
+constexpr std::array<byte, 10> toSignOutput{0, 0, 0, 0, 0, 0, 0, 0, 1, OP_RETURN};
+
+/// The output script of `to_spend`, the one of the address.
+Data outputScript(const Target& target) {
+    Data script = target.type == AddressType::P2TR ? Data{OP_1, 0x20} : Data{OP_0, 0x14};
+    append(script, target.program);
+    return script;
+}
+
+/// Outpoint of the input of `to_sign`: the first output of `to_spend`.
+Data toSpendOutpoint(const Data& script, const std::string& message) {
+    const auto messageHash = bip322MessageHash().hash({std::span(reinterpret_cast<const byte*>(message.data()), message.size())});
+    Data tx;
+    tx.reserve(128);
+    encode32LE(0, tx);
+    tx.push_back(1);
+    tx.insert(tx.end(), 32, 0);
+    encode32LE(0xffffffff, tx);
+    tx.push_back(34);
+    tx.push_back(OP_0);
+    tx.push_back(32);
+    append(tx, Data(messageHash.begin(), messageHash.end()));
+    encode32LE(0, tx);
+    tx.push_back(1);
+    encode64LE(0, tx);
+    tx.push_back(static_cast<byte>(script.size()));
+    append(tx, script);
+    encode32LE(0, tx);
+
+    const auto id = Hash::sha256dInto(tx.data(), tx.size());
+    Data outpoint(id.begin(), id.end());
+    encode32LE(0, outpoint);
+    return outpoint;
+}
+
+/// Items of a serialized witness stack, empty if it is malformed.
+std::vector<Data> decodeWitness(const Data& serialized) {
+    std::size_t index = 0;
+    const auto [valid, count] = decodeVarInt(serialized, index);
+    if (!valid || count > 2) {
+        return {};
+    }
+    std::vector<Data> items;
+    for (uint64_t i = 0; i < count; ++i) {
+        const auto [validSize, size] = decodeVarInt(serialized, index);
+        if (!validSize || size > serialized.size() - index) {
+            return {};
+        }
+        items.emplace_back(serialized.begin() + index, serialized.begin() + index + size);
+        index += size;
+    }
+    if (index != serialized.size()) {
+        return {};
+    }
+    return items;
+}
+
+/// P2WPKH: the witness is an ECDSA signature with SIGHASH_ALL and the public key, signing the BIP143 pre-image.
+bool verifyWitnessV0(const Data& keyHash, const Data& outpoint, const std::vector<Data>& witness) {
+    if (witness.size() != 2 || witness[0].empty() || witness[0].back() != TWBitcoinSigHashTypeAll ||
+        !PublicKey::isValid(witness[1], TWPublicKeyTypeSECP256k1)) {
+        return false;
+    }
+    const auto hash = Hash::sha256ripemdInto(witness[1]);
+    if (!std::equal(hash.begin(), hash.end(), keyHash.begin(), keyHash.end())) {
+        return false;
+    }
+
+    static const auto hashSequence = Hash::sha256dInto(Data(4, 0).data(), 4);
+    static const auto hashOutputs = Hash::sha256dInto(toSignOutput.data(), toSignOutput.size());
+    const auto hashPrevouts = Hash::sha256dInto(outpoint.data(), outpoint.size());
+
+    Data preImage;
+    preImage.reserve(160);
+    encode32LE(0, preImage);
+    preImage.insert(preImage.end(), hashPrevouts.begin(), hashPrevouts.end());
+    preImage.insert(preImage.end(), hashSequence.begin(), hashSequence.end());
+    append(preImage, outpoint);
+    append(preImage, Data{0x19, OP_DUP, OP_HASH160, 0x14});
+    append(preImage, keyHash);
+    append(preImage, Data{OP_EQUALVERIFY, OP_CHECKSIG});
+    encode64LE(0, preImage);
+    encode32LE(0, preImage);
+    preImage.insert(preImage.end(), hashOutputs.begin(), hashOutputs.end());
+    encode32LE(0, preImage);
+    encode32LE(TWBitcoinSigHashTypeAll, preImage);
+
+    const auto digest = Hash::sha256dInto(preImage.data(), preImage.size());
+    const auto signature = Data(witness[0].begin(), witness[0].end() - 1);
+    return PublicKey(witness[1], TWPublicKeyTypeSECP256k1).verifyAsDER(signature, Data(digest.begin(), digest.end()));
+}
+
+/// P2TR key path: the witness is a Schnorr signature by the output key, signing the BIP341 signature message.
+bool verifyTaproot(const Data& outputKey, const Data& script, const Data& outpoint, const std::vector<Data>& witness) {
+    if (witness.size() != 1) {
+        return false;
+    }
+    auto signature = witness[0];
+    byte hashType = 0; // SIGHASH_DEFAULT
+    if (signature.size() == 65 && signature.back() == TWBitcoinSigHashTypeAll) {
+        hashType = TWBitcoinSigHashTypeAll;
+        signature.pop_back();
+    } else if (signature.size() != 64) {
+        return false;
+    }
+
+    static const auto shaAmounts = Hash::sha256Into(Data(8, 0));
+    static const auto shaSequences = Hash::sha256Into(Data(4, 0));
+    static const auto shaOutputs = Hash::sha256Into(toSignOutput);
+    const auto shaPrevouts = Hash::sha256Into(outpoint);
+    Data scriptPubKeys{static_cast<byte>(script.size())};
+    append(scriptPubKeys, script);
+    const auto shaScriptPubKeys = Hash::sha256Into(scriptPubKeys);
+
+    // epoch, hash type, version, lock time
+    const std::array<byte, 10> head{0, hashType, 0, 0, 0, 0, 0, 0, 0, 0};
+    // spend type (key path, no annex), input index
+    constexpr std::array<byte, 5> tail{0, 0, 0, 0, 0};
+    const auto sighash = TaggedHash::tapSighash().hash({head, shaPrevouts, shaAmounts, shaScriptPubKeys, shaSequences, shaOutputs, tail});
+    try {
+        return XOnlyPublicKey(outputKey).verify(signature, Data(sighash.begin(), sighash.end()));
+    } catch (...) {
+        return false;
+    }
+}
+
+bool verifySimple(const Target& target, const std::string& message, const Data& signature) {
+    const auto witness = decodeWitness(signature);
+    if (witness.empty()) {
+        return false;
+    }
+    const auto script = outputScript(target);
+    const auto outpoint = toSpendOutpoint(script, message);
+    if (target.type == AddressType::P2WPKH) {
+        return verifyWitnessV0(target.program, outpoint, witness);
+    }
+    return verifyTaproot(target.program, script, outpoint, witness);
+}
+
+} // namespace
+
 Data MessageSigner::messageToHash(const std::string& message) {
-    Data d = messageToFullData(message);
-    return Hash::sha256d(d.data(), d.size());
+    const auto digest = messageDigest(message);
+    return Data(digest.begin(), digest.end());
 }
 
 std::string MessageSigner::signMessage(const PrivateKey& privateKey, const std::string& address, const std::string& message, bool compressed) {
@@ -108,4 +374,64 @@ bool MessageSigner::verifyMessage(const std::string& address, const std::string&
     return (addressRecovered == address);
 }
 
+std::vector<bool> MessageSigner::verifyMessageBatch(std::span<const MessageVerification> items, std::size_t threads) {
+    const auto count = items.size();
+    std::vector<std::optional<Target>> targets(count);
+    std::vector<Data> signatures(count);
+
+    // BIP137 signatures, with their keys recovered together, and BIP322 simple signatures
+    std::vector<std::size_t> recoverable;
+    std::vector<Data> recoverableSignatures;
+    std::vector<Data> digests;
+    std::vector<std::size_t> simple;
+    for (std::size_t i = 0; i < count; ++i) {
+        targets[i] = parseTarget(items[i].address);
+        if (!targets[i] || !Base64::decodeInto(items[i].signature, signatures[i])) {
+            continue;
+        }
+        const auto& signature = signatures[i];
+        const auto type = targets[i]->type;
+        if (signature.size() == SignatureRSVLength && signature[0] >= VOffset && signature[0] < VOffset + 16) {
+            // header: 27 + recovery id, + 4 for a compressed key (+ 8 or 12 for segwit addresses)
+            const auto compressed = signature[0] >= VOffset + 4;
+            if (type == AddressType::P2TR || (type != AddressType::P2PKH && !compressed)) {
+                continue;
+            }
+            auto rsv = Data(signature.begin() + 1, signature.end());
+            rsv.push_back((signature[0] - VOffset) & 0x03);
+            recoverableSignatures.push_back(std::move(rsv));
+            const auto digest = messageDigest(items[i].message);
+            digests.emplace_back(digest.begin(), digest.end());
+            recoverable.push_back(i);
+        } else if (type == AddressType::P2WPKH || type == AddressType::P2TR) {
+            simple.push_back(i);
+        }
+    }
+
+    std::vector<bool> valid(count, false);
+
+    constexpr std::size_t extendedSize = 65;
+    Data keys(recoverable.size() * extendedSize);
+    const auto recovered = PublicKey::recoverBatch(recoverableSignatures, digests, keys.data(), threads);
+    for (std::size_t j = 0; j < recoverable.size(); ++j) {
+        if (!recovered[j]) {
+            continue;
+        }
+        const auto i = recoverable[j];
+        const auto& target = *targets[i];
+        const auto hash = committedHash(target.type, keys.data() + j * extendedSize, signatures[i][0] >= VOffset + 4);
+        valid[i] = std::equal(hash.begin(), hash.end(), target.program.begin(), target.program.end());
+    }
+
+    std::vector<char> results(simple.size(), 0);
+    parallelFor(simple.size(), threads, [&](std::size_t j) {
+        const auto i = simple[j];
+        results[j] = verifySimple(*targets[i], items[i].message, signatures[i]);
+    });
+    for (std::size_t j = 0; j < simple.size(); ++j) {
+        valid[simple[j]] = results[j] != 0;
+    }
+    return valid;
+}
+
 } // namespace TW::Bitcoin
@@ -9,10 +9,21 @@
 #include "Data.h"
 #include "PrivateKey.h"
 
+#include <span>
 #include <string>
+#include <vector>
 
 namespace TW::Bitcoin {
 
+/// One signed message of a batch verification.
+struct MessageVerification {
+    const std::string& address;
+    /// The message signed (without prefix).
+    const std::string& message;
+    /// Base64-encoded signature: BIP137 (65 bytes), or a BIP322 simple signature (the witness stack).
+    const std::string& signature;
+};
+
 /// Class for message signing and verification.
 ///
 /// Bitcoin Core and some other wallets support a message signing & verification format, to create a proof (a signature)
@@ -45,6 +56,14 @@ class MessageSigner {
     /// May throw
     static bool verifyMessage(const std::string& address, const std::string& message, const Data& signature);
 
+    /// Verifies many signed messages at once, e.g. the address signatures of a proof of reserves.
+    /// BIP137 signatures are accepted for P2PKH, P2SH-P2WPKH and P2WPKH addresses: the public keys are recovered in
+    /// batches, and their hash is compared to the one of the address.
+    /// BIP322 simple signatures are accepted for P2WPKH (SIGHASH_ALL) and P2TR key-path (SIGHASH_DEFAULT or
+    /// SIGHASH_ALL) addresses, they are verified on `threads` workers (0: hardware concurrency).
+    /// Returns the validity of every signature, in order; invalid input is reported as false (does not throw).
+    static std::vector<bool> verifyMessageBatch(std::span<const MessageVerification> items, std::size_t threads = 0);
+
     /// Recover address from signature and message. May throw.
     static std::string recoverAddressFromMessage(const std::string& message, const Data& signature);
 
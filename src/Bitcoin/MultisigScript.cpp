@@ -0,0 +1,79 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "MultisigScript.h"
+
+#include "../Hash.h"
+#include "../PublicKey.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace TW::Bitcoin {
+
+MultisigScript::MultisigScript(std::vector<Data> keys, int required, bool sortKeys)
+    : _required(required), _keys(std::move(keys)) {
+    if (_keys.empty() || _keys.size() > maxKeys || required < 1 || static_cast<std::size_t>(required) > _keys.size()) {
+        throw std::invalid_argument("Invalid multisig key count");
+    }
+    for (const auto& key : _keys) {
+        if (!PublicKey::isValid(key, TWPublicKeyTypeSECP256k1)) {
+            throw std::invalid_argument("Invalid multisig public key");
+        }
+    }
+    if (sortKeys) {
+        std::sort(_keys.begin(), _keys.end());
+    }
+
+    auto& bytes = _script.bytes;
+    bytes.reserve(3 + _keys.size() * (1 + PublicKey::secp256k1Size));
+    bytes.push_back(Script::encodeNumber(required));
+    for (const auto& key : _keys) {
+        bytes.push_back(static_cast<byte>(key.size()));
+        append(bytes, key);
+    }
+    bytes.push_back(Script::encodeNumber(static_cast<int>(_keys.size())));
+    bytes.push_back(OP_CHECKMULTISIG);
+    computeHashes();
+}
+
+std::optional<MultisigScript> MultisigScript::match(const Script& script) {
+    const auto multisig = script.view().matchMultisig();
+    if (!multisig.has_value()) {
+        return std::nullopt;
+    }
+    MultisigScript result;
+    result._required = multisig->required;
+    result._keys.reserve(multisig->count);
+    const auto keys = ScriptView(multisig->keys);
+    std::size_t index = 0;
+    ScriptView::Op key;
+    while (keys.nextOp(index, key)) {
+        result._keys.emplace_back(key.operand.begin(), key.operand.end());
+    }
+    result._script = script;
+    result.computeHashes();
+    return result;
+}
+
+std::optional<std::size_t> MultisigScript::indexOf(const Data& keyHash) const {
+    const auto it = std::find(_keyHashes.begin(), _keyHashes.end(), keyHash);
+    if (it == _keyHashes.end()) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - _keyHashes.begin());
+}
+
+void MultisigScript::computeHashes() {
+    _keyHashes.reserve(_keys.size());
+    for (const auto& key : _keys) {
+        _keyHashes.push_back(Hash::sha256ripemd(key.data(), key.size()));
+    }
+    _scriptHash = Hash::sha256ripemd(_script.bytes.data(), _script.bytes.size());
+    _witnessScriptHash = Hash::sha256(_script.bytes);
+}
+
+} // namespace TW::Bitcoin
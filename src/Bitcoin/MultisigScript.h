@@ -0,0 +1,61 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+
+#include "Data.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// An m-of-n multisig redeem script, with what signing needs computed once: the keys in script order, which is the
+/// order of the signatures, their hashes and the script hashes. Built once for a wallet and reused for every input
+/// paying to it.
+class MultisigScript {
+public:
+    /// Maximum number of keys, the count being a small integer opcode.
+    static constexpr std::size_t maxKeys = 16;
+
+    /// Builds the script requiring `required` signatures of the compressed public `keys`, sorted in lexicographic
+    /// order as BIP67 specifies unless `sortKeys` is false.
+    /// Throws std::invalid_argument if a key is not a compressed public key or the counts are out of range.
+    MultisigScript(std::vector<Data> keys, int required, bool sortKeys = true);
+
+    /// Parses a bare multisig script with compressed public keys, keeping the order of its keys.
+    static std::optional<MultisigScript> match(const Script& script);
+
+    int required() const noexcept { return _required; }
+    /// The public keys in script order, the order of the signatures.
+    const std::vector<Data>& keys() const noexcept { return _keys; }
+    /// HASH160 of each public key.
+    const std::vector<Data>& keyHashes() const noexcept { return _keyHashes; }
+    const Script& script() const noexcept { return _script; }
+    /// HASH160 of the script, paid to by P2SH.
+    const Data& scriptHash() const noexcept { return _scriptHash; }
+    /// SHA256 of the script, paid to by P2WSH.
+    const Data& witnessScriptHash() const noexcept { return _witnessScriptHash; }
+
+    /// Position of the key with HASH160 `keyHash`, which is the position of its signature.
+    std::optional<std::size_t> indexOf(const Data& keyHash) const;
+
+private:
+    MultisigScript() = default;
+    void computeHashes();
+
+    int _required = 0;
+    std::vector<Data> _keys;
+    std::vector<Data> _keyHashes;
+    Script _script;
+    Data _scriptHash;
+    Data _witnessScriptHash;
+};
+
+} // namespace TW::Bitcoin
@@ -44,6 +44,9 @@ struct OutPoint {
     /// Encodes the out-point into the provided buffer.
     void encode(Data& data) const noexcept;
 
+    /// Size of the encoded out-point.
+    static constexpr std::size_t serializedSize() noexcept { return 32 + 4; }
+
     Proto::OutPoint proto() const {
         auto op = Proto::OutPoint();
         op.set_hash(std::string(hash.begin(), hash.end()));
@@ -0,0 +1,186 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PayoutPlanner.h"
+#include "SizeEstimator.h"
+#include "TransactionBuilder.h"
+
+#include <optional>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+/// Virtual size of a P2PKH input, for change outputs whose spending size is unknown.
+constexpr std::size_t legacyInputVirtualSize = 148;
+
+struct Candidate {
+    const UTXO* utxo;
+    InputSize size;
+};
+
+struct Selection {
+    std::size_t inputs = 0;
+    Amount available = 0;
+    Amount fee = 0;
+    Amount change = 0;
+};
+
+std::size_t virtualSize(const InputSize& size) {
+    return size.base + (size.witness + 3) / 4;
+}
+
+/// Selects the first candidates from `first` covering `amount` and the fee of the outputs, with a change output if
+/// the change is worth more than `changeCost`; nullopt if they don't, or only beyond the size limit.
+std::optional<Selection> select(const std::vector<Candidate>& candidates, std::size_t first, Amount amount,
+                                std::vector<std::size_t> outputSizes, std::size_t changeSize, Amount changeCost,
+                                const SigningInput& input, const PayoutPlanner::Limits& limits) {
+    std::vector<InputSize> inputSizes;
+    Amount available = 0;
+    for (auto i = first; i < candidates.size(); ++i) {
+        inputSizes.push_back(candidates[i].size);
+        available += candidates[i].utxo->amount;
+
+        const auto size = SizeEstimator::transaction(inputSizes, outputSizes);
+        if (size.virtualSize() > limits.maxVirtualSize) {
+            return std::nullopt;
+        }
+        const auto fee = input.byteFee * static_cast<Amount>(size.virtualSize());
+        if (available < amount + fee) {
+            continue;
+        }
+
+        outputSizes.push_back(changeSize);
+        const auto sizeWithChange = SizeEstimator::transaction(inputSizes, outputSizes);
+        outputSizes.pop_back();
+        const auto feeWithChange = input.byteFee * static_cast<Amount>(sizeWithChange.virtualSize());
+        const auto change = available - amount - feeWithChange;
+        if (change > changeCost && sizeWithChange.virtualSize() <= limits.maxVirtualSize) {
+            return Selection{inputSizes.size(), available, feeWithChange, change};
+        }
+        // the excess goes to the fee
+        return Selection{inputSizes.size(), available, available - amount, 0};
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+PayoutPlan PayoutPlanner::plan(const SigningInput& input, const std::vector<Payout>& payouts, const UtxoPool& pool, const Limits& limits) {
+    PayoutPlan result;
+
+    const auto& changeScript = input.lockScript(input.changeAddress);
+    if (changeScript.empty()) {
+        result.error = Common::Proto::Error_invalid_address;
+        return result;
+    }
+    std::vector<const Script*> scripts;
+    scripts.reserve(payouts.size());
+    for (const auto& payout : payouts) {
+        if (payout.amount <= 0) {
+            result.error = Common::Proto::Error_zero_amount_requested;
+            return result;
+        }
+        const auto& script = input.lockScript(payout.address);
+        if (script.empty()) {
+            result.error = Common::Proto::Error_invalid_address;
+            return result;
+        }
+        scripts.push_back(&script);
+    }
+
+    // UTXOs the size estimator supports, largest first
+    const auto estimator = TransactionBuilder::sizeEstimator(input);
+    const auto spendable = pool.spendable(input.byteFee);
+    std::vector<Candidate> candidates;
+    candidates.reserve(spendable.size());
+    Amount remaining = 0;
+    for (auto it = spendable.rbegin(); it != spendable.rend(); ++it) {
+        if (const auto size = estimator.input(it->script); size.has_value()) {
+            candidates.push_back(Candidate{&*it, *size});
+            remaining += it->amount;
+        }
+    }
+
+    // change worth less than its output and its later spending goes to the fee
+    const auto changeSize = SizeEstimator::output(changeScript);
+    const auto changeInput = estimator.input(changeScript);
+    const auto changeCost = input.byteFee * static_cast<Amount>(changeSize + (changeInput.has_value() ? virtualSize(*changeInput) : legacyInputVirtualSize));
+
+    std::size_t nextPayout = 0;
+    std::size_t nextCandidate = 0;
+    while (nextPayout < payouts.size()) {
+        // take payouts in order up to the limits
+        auto end = nextPayout;
+        std::size_t outputsSize = changeSize;
+        while (end < payouts.size() && end - nextPayout < limits.maxOutputs) {
+            const auto outputSize = SizeEstimator::output(*scripts[end]);
+            if (end > nextPayout && outputsSize + outputSize > limits.maxVirtualSize) {
+                break;
+            }
+            outputsSize += outputSize;
+            ++end;
+        }
+
+        // drop the last payouts of the batch until the candidates cover it within the size limit
+        Amount amount = 0;
+        for (auto i = nextPayout; i < end; ++i) {
+            amount += payouts[i].amount;
+        }
+        while (end > nextPayout && amount > remaining) {
+            amount -= payouts[--end].amount;
+        }
+        std::optional<Selection> selection;
+        while (end > nextPayout) {
+            std::vector<std::size_t> outputSizes;
+            outputSizes.reserve(end - nextPayout + 1);
+            for (auto i = nextPayout; i < end; ++i) {
+                outputSizes.push_back(SizeEstimator::output(*scripts[i]));
+            }
+            selection = select(candidates, nextCandidate, amount, std::move(outputSizes), changeSize, changeCost, input, limits);
+            if (selection.has_value()) {
+                break;
+            }
+            amount -= payouts[--end].amount;
+        }
+        if (!selection.has_value()) {
+            // not even the next payout can be funded any more
+            break;
+        }
+
+        PayoutBatch batch;
+        batch.transaction.lockTime = input.lockTime;
+        for (auto i = nextPayout; i < end; ++i) {
+            batch.payouts.push_back(i);
+            batch.plan.amount += payouts[i].amount;
+            batch.transaction.outputs.emplace_back(payouts[i].amount, *scripts[i]);
+        }
+        if (selection->change > 0) {
+            batch.transaction.outputs.emplace_back(selection->change, changeScript);
+        }
+        const auto emptyScript = Script();
+        for (auto i = nextCandidate; i < nextCandidate + selection->inputs; ++i) {
+            const auto& utxo = *candidates[i].utxo;
+            batch.plan.utxos.push_back(utxo);
+            batch.transaction.inputs.emplace_back(utxo.outPoint, emptyScript, utxo.outPoint.sequence);
+        }
+        batch.plan.availableAmount = selection->available;
+        batch.plan.fee = selection->fee;
+        batch.plan.change = selection->change;
+        result.batches.push_back(std::move(batch));
+
+        nextPayout = end;
+        nextCandidate += selection->inputs;
+        remaining -= selection->available;
+    }
+
+    for (auto i = nextPayout; i < payouts.size(); ++i) {
+        result.unpaid.push_back(i);
+    }
+    return result;
+}
+
+} // namespace TW::Bitcoin
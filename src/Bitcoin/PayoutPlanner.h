@@ -0,0 +1,75 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Amount.h"
+#include "SigningInput.h"
+#include "Transaction.h"
+#include "TransactionPlan.h"
+#include "UtxoPool.h"
+#include "../proto/Common.pb.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// A withdrawal to pay: an amount to an address.
+struct Payout {
+    std::string address;
+    Amount amount = 0;
+};
+
+/// One transaction of a payout plan.
+struct PayoutBatch {
+    /// Indices of the paid payouts, in the order of the transaction outputs; the change output, if any, is last.
+    std::vector<std::size_t> payouts;
+
+    /// Selected UTXOs, sum of the payouts (`amount`), fee and change.
+    TransactionPlan plan;
+
+    /// The unsigned transaction, to sign with `TransactionSigner::sign(input, {plan, transaction}, mode)`.
+    Transaction transaction;
+};
+
+/// Result of `PayoutPlanner::plan`.
+struct PayoutPlan {
+    std::vector<PayoutBatch> batches;
+
+    /// Indices of the payouts which could not be funded by the remaining UTXOs, to retry later.
+    std::vector<std::size_t> unpaid;
+
+    Common::Proto::SigningError error = Common::Proto::OK;
+};
+
+/// Merges many payouts into few transactions, each paying a batch of them plus one change output.
+///
+/// Payouts are taken in order, so older withdrawals are paid first. Each batch selects the largest unspent UTXOs
+/// of the pool until they cover its payouts and fee. Sizes come from `SizeEstimator`, so UTXOs with scripts it
+/// does not support are not spent.
+class PayoutPlanner {
+public:
+    /// Policy limits of one transaction.
+    struct Limits {
+        /// Maximum number of payout outputs.
+        std::size_t maxOutputs = 500;
+        /// Maximum virtual size; 100000 vbytes is the standardness limit of Bitcoin Core.
+        std::size_t maxVirtualSize = 100000;
+    };
+
+    /// Plans the payouts with the byte fee, change address, redeem scripts, keys, coin and lock time of `input`,
+    /// spending the UTXOs of `pool` which are not dust. The pool is not modified: spend the UTXOs of the batches
+    /// once the transactions are broadcast.
+    static PayoutPlan plan(const SigningInput& input, const std::vector<Payout>& payouts, const UtxoPool& pool, const Limits& limits);
+
+    static PayoutPlan plan(const SigningInput& input, const std::vector<Payout>& payouts, const UtxoPool& pool) {
+        return plan(input, payouts, pool, Limits());
+    }
+};
+
+} // namespace TW::Bitcoin
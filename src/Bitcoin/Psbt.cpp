@@ -0,0 +1,699 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Psbt.h"
+#include "SignatureBuilder.h"
+
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+
+#include <algorithm>
+
+namespace TW::Bitcoin {
+
+using Bytes = Psbt::Bytes;
+using SigningResult = Result<void, Common::Proto::SigningError>;
+
+namespace {
+
+constexpr std::array<byte, 5> magic = {'p', 's', 'b', 't', 0xff};
+
+/// Bounds-checked reader of serialized data, returning views into it.
+class Reader {
+public:
+    explicit Reader(Bytes bytes) noexcept : bytes(bytes) {}
+
+    bool done() const noexcept { return offset == bytes.size(); }
+
+    bool read(std::size_t size, Bytes& out) noexcept {
+        if (bytes.size() - offset < size) {
+            return false;
+        }
+        out = bytes.subspan(offset, size);
+        offset += size;
+        return true;
+    }
+
+    bool readVarInt(uint64_t& value) noexcept {
+        Bytes prefix;
+        if (!read(1, prefix)) {
+            return false;
+        }
+        const std::size_t size = prefix[0] == 0xfd ? 2 : prefix[0] == 0xfe ? 4 : prefix[0] == 0xff ? 8 : 0;
+        if (size == 0) {
+            value = prefix[0];
+            return true;
+        }
+        Bytes number;
+        if (!read(size, number)) {
+            return false;
+        }
+        value = size == 2 ? decode16LE(number.data()) : size == 4 ? decode32LE(number.data()) : decode64LE(number.data());
+        return true;
+    }
+
+    bool readVarBytes(Bytes& out) noexcept {
+        uint64_t size = 0;
+        return readVarInt(size) && size <= bytes.size() && read(static_cast<std::size_t>(size), out);
+    }
+
+    bool readU32(uint32_t& value) noexcept {
+        Bytes number;
+        if (!read(4, number)) {
+            return false;
+        }
+        value = decode32LE(number.data());
+        return true;
+    }
+
+    bool readU64(uint64_t& value) noexcept {
+        Bytes number;
+        if (!read(8, number)) {
+            return false;
+        }
+        value = decode64LE(number.data());
+        return true;
+    }
+
+    bool peek(byte& value) const noexcept {
+        if (done()) {
+            return false;
+        }
+        value = bytes[offset];
+        return true;
+    }
+
+private:
+    Bytes bytes;
+    std::size_t offset = 0;
+};
+
+/// Serialized transaction, with views of its scripts.
+struct TxView {
+    struct Input {
+        Bytes hash;
+        uint32_t index = 0;
+        Bytes script;
+        uint32_t sequence = 0;
+    };
+    struct Output {
+        uint64_t value = 0;
+        Bytes script;
+    };
+    uint32_t version = 0;
+    std::vector<Input> inputs;
+    std::vector<Output> outputs;
+    uint32_t lockTime = 0;
+
+    static std::optional<TxView> parse(Bytes bytes) {
+        Reader reader(bytes);
+        TxView tx;
+        uint64_t count = 0;
+        byte marker = 0;
+        if (!reader.readU32(tx.version) || !reader.peek(marker)) {
+            return std::nullopt;
+        }
+        const bool segwit = marker == 0;
+        Bytes flag;
+        if (segwit && !reader.read(2, flag)) {
+            return std::nullopt;
+        }
+        if (!reader.readVarInt(count) || count > bytes.size()) {
+            return std::nullopt;
+        }
+        tx.inputs.resize(static_cast<std::size_t>(count));
+        for (auto& input : tx.inputs) {
+            if (!reader.read(32, input.hash) || !reader.readU32(input.index) ||
+                !reader.readVarBytes(input.script) || !reader.readU32(input.sequence)) {
+                return std::nullopt;
+            }
+        }
+        if (!reader.readVarInt(count) || count > bytes.size()) {
+            return std::nullopt;
+        }
+        tx.outputs.resize(static_cast<std::size_t>(count));
+        for (auto& output : tx.outputs) {
+            if (!reader.readU64(output.value) || !reader.readVarBytes(output.script)) {
+                return std::nullopt;
+            }
+        }
+        for (std::size_t i = 0; segwit && i < tx.inputs.size(); ++i) {
+            uint64_t items = 0;
+            Bytes item;
+            if (!reader.readVarInt(items)) {
+                return std::nullopt;
+            }
+            for (uint64_t j = 0; j < items; ++j) {
+                if (!reader.readVarBytes(item)) {
+                    return std::nullopt;
+                }
+            }
+        }
+        if (!reader.readU32(tx.lockTime) || !reader.done()) {
+            return std::nullopt;
+        }
+        return tx;
+    }
+};
+
+/// Three-way comparison of an entry key with `type || keyData`.
+int compareKey(Bytes key, byte type, Bytes keyData) noexcept {
+    if (key[0] != type) {
+        return key[0] < type ? -1 : 1;
+    }
+    const auto rest = key.subspan(1);
+    if (std::lexicographical_compare(rest.begin(), rest.end(), keyData.begin(), keyData.end())) {
+        return -1;
+    }
+    return std::equal(rest.begin(), rest.end(), keyData.begin(), keyData.end()) ? 0 : 1;
+}
+
+bool keyLess(const Psbt::Entry& lhs, const Psbt::Entry& rhs) noexcept {
+    return std::lexicographical_compare(lhs.key.begin(), lhs.key.end(), rhs.key.begin(), rhs.key.end());
+}
+
+bool keyEqual(const Psbt::Entry& lhs, const Psbt::Entry& rhs) noexcept {
+    return std::equal(lhs.key.begin(), lhs.key.end(), rhs.key.begin(), rhs.key.end());
+}
+
+bool parseMap(Reader& reader, Psbt::Map& map, std::vector<Psbt::Entry>& entries) {
+    entries.clear();
+    while (true) {
+        Psbt::Entry entry;
+        if (!reader.readVarBytes(entry.key)) {
+            return false;
+        }
+        if (entry.key.empty()) {
+            break;
+        }
+        if (!reader.readVarBytes(entry.value)) {
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), keyLess);
+    if (std::adjacent_find(entries.begin(), entries.end(), keyEqual) != entries.end()) {
+        // duplicate keys are not allowed
+        return false;
+    }
+    for (const auto& entry : entries) {
+        map.set(entry);
+    }
+    return true;
+}
+
+void encodeMap(const Psbt::Map& map, Data& data) {
+    for (const auto& entry : map.entries()) {
+        encodeVarInt(entry.key.size(), data);
+        data.insert(data.end(), entry.key.begin(), entry.key.end());
+        encodeVarInt(entry.value.size(), data);
+        data.insert(data.end(), entry.value.begin(), entry.value.end());
+    }
+    data.push_back(0);
+}
+
+std::optional<uint64_t> readCompactSize(std::optional<Bytes> value) {
+    uint64_t result = 0;
+    if (!value.has_value()) {
+        return std::nullopt;
+    }
+    auto reader = Reader(*value);
+    if (!reader.readVarInt(result) || !reader.done()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<uint32_t> readU32(std::optional<Bytes> value) {
+    if (!value.has_value() || value->size() != 4) {
+        return std::nullopt;
+    }
+    return decode32LE(value->data());
+}
+
+/// Parses the BIP174 serialization of a witness stack.
+std::optional<std::vector<Data>> parseWitness(Bytes bytes) {
+    auto reader = Reader(bytes);
+    uint64_t count = 0;
+    if (!reader.readVarInt(count) || count > bytes.size()) {
+        return std::nullopt;
+    }
+    std::vector<Data> stack;
+    stack.reserve(static_cast<std::size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        Bytes item;
+        if (!reader.readVarBytes(item)) {
+            return std::nullopt;
+        }
+        stack.emplace_back(item.begin(), item.end());
+    }
+    if (!reader.done()) {
+        return std::nullopt;
+    }
+    return stack;
+}
+
+/// Signature of `publicKey` in the partial signatures of `input`.
+std::optional<Bytes> partialSignature(const Psbt::Map& input, Bytes publicKey) {
+    return input.get(Psbt::InputPartialSig, publicKey);
+}
+
+/// Signature script items for `script`: the signatures and public keys it needs.
+Result<std::vector<Data>, Common::Proto::SigningError> solve(const Psbt::Map& input, Bytes script) {
+    using SolveResult = Result<std::vector<Data>, Common::Proto::SigningError>;
+    const auto view = ScriptView(script);
+    if (const auto multisig = view.matchMultisig(); multisig.has_value()) {
+        auto results = std::vector<Data>{{}}; // workaround CHECKMULTISIG bug
+        const auto keys = ScriptView(multisig->keys);
+        std::size_t index = 0;
+        ScriptView::Op key;
+        while (results.size() < static_cast<std::size_t>(multisig->required) + 1 && keys.nextOp(index, key)) {
+            if (const auto signature = partialSignature(input, key.operand); signature.has_value()) {
+                results.emplace_back(signature->begin(), signature->end());
+            }
+        }
+        if (results.size() < static_cast<std::size_t>(multisig->required) + 1) {
+            return SolveResult::failure(Common::Proto::Error_signatures_count);
+        }
+        return SolveResult::success(std::move(results));
+    }
+    if (const auto publicKey = view.matchPayToPublicKey(); publicKey.has_value()) {
+        const auto signature = partialSignature(input, *publicKey);
+        if (!signature.has_value()) {
+            return SolveResult::failure(Common::Proto::Error_signatures_count);
+        }
+        return SolveResult::success({Data(signature->begin(), signature->end())});
+    }
+    auto keyHash = view.matchPayToPublicKeyHash();
+    if (!keyHash.has_value()) {
+        keyHash = view.matchPayToWitnessPublicKeyHash();
+    }
+    if (keyHash.has_value()) {
+        for (const auto& entry : input.range(Psbt::InputPartialSig)) {
+            const auto publicKey = entry.keyData();
+            const auto hash = Hash::sha256ripemdInto(publicKey.data(), publicKey.size());
+            if (std::equal(hash.begin(), hash.end(), keyHash->begin(), keyHash->end())) {
+                return SolveResult::success({Data(entry.value.begin(), entry.value.end()), Data(publicKey.begin(), publicKey.end())});
+            }
+        }
+        return SolveResult::failure(Common::Proto::Error_signatures_count);
+    }
+    return SolveResult::failure(Common::Proto::Error_script_output);
+}
+
+} // namespace
+
+std::optional<Bytes> Psbt::Map::get(byte type, Bytes keyData) const noexcept {
+    const auto it = std::lower_bound(_entries.begin(), _entries.end(), 0, [&](const Entry& entry, int) {
+        return compareKey(entry.key, type, keyData) < 0;
+    });
+    if (it == _entries.end() || compareKey(it->key, type, keyData) != 0) {
+        return std::nullopt;
+    }
+    return it->value;
+}
+
+std::span<const Psbt::Entry> Psbt::Map::range(byte type) const noexcept {
+    const auto first = std::partition_point(_entries.begin(), _entries.end(), [&](const Entry& entry) { return entry.type() < type; });
+    const auto last = std::partition_point(first, _entries.end(), [&](const Entry& entry) { return entry.type() == type; });
+    return {first, last};
+}
+
+void Psbt::Map::set(Entry entry) {
+    const auto it = std::lower_bound(_entries.begin(), _entries.end(), entry, keyLess);
+    if (it != _entries.end() && keyEqual(*it, entry)) {
+        *it = entry;
+        return;
+    }
+    _entries.insert(it, entry);
+}
+
+void Psbt::Map::erase(byte first, byte last) {
+    std::erase_if(_entries, [&](const Entry& entry) { return entry.type() >= first && entry.type() <= last; });
+}
+
+void Psbt::Map::merge(const Map& other) {
+    std::vector<Entry> merged;
+    merged.reserve(_entries.size() + other._entries.size());
+    auto it = _entries.begin();
+    auto otherIt = other._entries.begin();
+    while (it != _entries.end() || otherIt != other._entries.end()) {
+        if (otherIt == other._entries.end() || (it != _entries.end() && keyLess(*it, *otherIt))) {
+            merged.push_back(*it++);
+        } else if (it == _entries.end() || keyLess(*otherIt, *it)) {
+            merged.push_back(*otherIt++);
+        } else {
+            // same key: keep ours
+            merged.push_back(*it++);
+            ++otherIt;
+        }
+    }
+    _entries = std::move(merged);
+}
+
+std::optional<Psbt> Psbt::parse(Data data) {
+    Psbt psbt;
+    const auto bytes = psbt.store(std::move(data));
+    auto reader = Reader(bytes);
+    Bytes header;
+    if (!reader.read(magic.size(), header) || !std::equal(header.begin(), header.end(), magic.begin())) {
+        return std::nullopt;
+    }
+    std::vector<Entry> entries;
+    if (!parseMap(reader, psbt.global, entries)) {
+        return std::nullopt;
+    }
+
+    std::size_t inputCount = 0;
+    std::size_t outputCount = 0;
+    if (psbt.version() == 0) {
+        const auto unsignedTx = psbt.global.get(GlobalUnsignedTx);
+        const auto tx = unsignedTx.has_value() ? TxView::parse(*unsignedTx) : std::nullopt;
+        if (!tx.has_value()) {
+            return std::nullopt;
+        }
+        inputCount = tx->inputs.size();
+        outputCount = tx->outputs.size();
+    } else {
+        const auto inputs = readCompactSize(psbt.global.get(GlobalInputCount));
+        const auto outputs = readCompactSize(psbt.global.get(GlobalOutputCount));
+        if (!inputs.has_value() || !outputs.has_value() || *inputs > bytes.size() || *outputs > bytes.size()) {
+            return std::nullopt;
+        }
+        inputCount = static_cast<std::size_t>(*inputs);
+        outputCount = static_cast<std::size_t>(*outputs);
+    }
+
+    psbt.inputs.resize(inputCount);
+    for (auto& input : psbt.inputs) {
+        if (!parseMap(reader, input, entries)) {
+            return std::nullopt;
+        }
+    }
+    psbt.outputs.resize(outputCount);
+    for (auto& output : psbt.outputs) {
+        if (!parseMap(reader, output, entries)) {
+            return std::nullopt;
+        }
+    }
+    if (!reader.done()) {
+        return std::nullopt;
+    }
+    return psbt;
+}
+
+Psbt Psbt::create(const Transaction& transaction) {
+    Psbt psbt;
+    Data unsignedTx;
+    transaction.encode(unsignedTx, Transaction::NonSegwit);
+    psbt.global.set({psbt.store({GlobalUnsignedTx}), psbt.store(std::move(unsignedTx))});
+    psbt.inputs.resize(transaction.inputs.size());
+    psbt.outputs.resize(transaction.outputs.size());
+    return psbt;
+}
+
+uint32_t Psbt::version() const noexcept {
+    return readU32(global.get(GlobalVersion)).value_or(0);
+}
+
+Data Psbt::encode() const {
+    std::size_t size = magic.size() + 1 + inputs.size() + outputs.size();
+    const auto addSize = [&size](const Map& map) {
+        for (const auto& entry : map.entries()) {
+            size += varIntSize(entry.key.size()) + entry.key.size() + varIntSize(entry.value.size()) + entry.value.size();
+        }
+    };
+    addSize(global);
+    std::for_each(inputs.begin(), inputs.end(), addSize);
+    std::for_each(outputs.begin(), outputs.end(), addSize);
+    Data data;
+    data.reserve(size);
+    data.insert(data.end(), magic.begin(), magic.end());
+    encodeMap(global, data);
+    for (const auto& input : inputs) {
+        encodeMap(input, data);
+    }
+    for (const auto& output : outputs) {
+        encodeMap(output, data);
+    }
+    return data;
+}
+
+bool Psbt::combine(const Psbt& other) {
+    if (inputs.size() != other.inputs.size() || outputs.size() != other.outputs.size() || version() != other.version()) {
+        return false;
+    }
+    if (version() == 0) {
+        const auto tx = global.get(GlobalUnsignedTx);
+        const auto otherTx = other.global.get(GlobalUnsignedTx);
+        if (!tx.has_value() || !otherTx.has_value() || !std::equal(tx->begin(), tx->end(), otherTx->begin(), otherTx->end())) {
+            return false;
+        }
+    } else {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            for (const auto type : {InputPreviousTxid, InputOutputIndex}) {
+                const auto value = inputs[i].get(type);
+                const auto otherValue = other.inputs[i].get(type);
+                if (!value.has_value() || !otherValue.has_value() ||
+                    !std::equal(value->begin(), value->end(), otherValue->begin(), otherValue->end())) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    buffers.insert(buffers.end(), other.buffers.begin(), other.buffers.end());
+    global.merge(other.global);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i].merge(other.inputs[i]);
+    }
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        outputs[i].merge(other.outputs[i]);
+    }
+    return true;
+}
+
+void Psbt::addPartialSignature(std::size_t index, const Data& publicKey, const Data& signature) {
+    Data key;
+    key.reserve(1 + publicKey.size());
+    key.push_back(InputPartialSig);
+    append(key, publicKey);
+    inputs.at(index).set({store(std::move(key)), store(signature)});
+}
+
+Bytes Psbt::store(Data data) {
+    const auto& buffer = buffers.emplace_back(std::make_shared<const Data>(std::move(data)));
+    return *buffer;
+}
+
+std::optional<std::pair<Amount, Bytes>> Psbt::spentOutput(std::size_t index, uint32_t outputIndex) const {
+    const auto& input = inputs[index];
+    if (const auto utxo = input.get(InputWitnessUtxo); utxo.has_value()) {
+        auto reader = Reader(*utxo);
+        uint64_t value = 0;
+        Bytes script;
+        if (!reader.readU64(value) || !reader.readVarBytes(script) || !reader.done()) {
+            return std::nullopt;
+        }
+        return std::make_pair(static_cast<Amount>(value), script);
+    }
+    const auto utxo = input.get(InputNonWitnessUtxo);
+    const auto previous = utxo.has_value() ? TxView::parse(*utxo) : std::nullopt;
+    if (!previous.has_value()) {
+        return std::nullopt;
+    }
+    if (outputIndex >= previous->outputs.size()) {
+        return std::nullopt;
+    }
+    const auto& output = previous->outputs[outputIndex];
+    return std::make_pair(static_cast<Amount>(output.value), output.script);
+}
+
+SigningResult Psbt::finalizeInput(std::size_t index, uint32_t outputIndex) {
+    auto& input = inputs[index];
+    if (input.get(InputFinalScriptSig).has_value() || input.get(InputFinalScriptWitness).has_value()) {
+        return SigningResult::success();
+    }
+    const auto spent = spentOutput(index, outputIndex);
+    if (!spent.has_value()) {
+        return SigningResult::failure(Common::Proto::Error_missing_input_utxos);
+    }
+
+    std::vector<Data> scriptSig;
+    std::vector<Data> witness;
+    auto script = spent->second;
+    const bool isScriptHash = ScriptView(script).isPayToScriptHash();
+    if (isScriptHash) {
+        const auto redeemScript = input.get(InputRedeemScript);
+        if (!redeemScript.has_value()) {
+            return SigningResult::failure(Common::Proto::Error_script_redeem);
+        }
+        script = *redeemScript;
+    }
+    const auto view = ScriptView(script);
+    if (view.isPayToWitnessScriptHash()) {
+        const auto witnessScript = input.get(InputWitnessScript);
+        if (!witnessScript.has_value()) {
+            return SigningResult::failure(Common::Proto::Error_script_redeem);
+        }
+        auto result = solve(input, *witnessScript);
+        if (!result) {
+            return SigningResult::failure(result.error());
+        }
+        witness = result.payload();
+        witness.emplace_back(witnessScript->begin(), witnessScript->end());
+    } else if (view.isPayToWitnessPublicKeyHash()) {
+        auto result = solve(input, script);
+        if (!result) {
+            return SigningResult::failure(result.error());
+        }
+        witness = result.payload();
+    } else if (view.isWitnessProgram()) {
+        return SigningResult::failure(Common::Proto::Error_script_witness_program);
+    } else {
+        auto result = solve(input, script);
+        if (!result) {
+            return SigningResult::failure(result.error());
+        }
+        scriptSig = result.payload();
+    }
+    if (isScriptHash) {
+        scriptSig.emplace_back(script.begin(), script.end());
+    }
+
+    input.erase(InputPartialSig, InputBip32Derivation);
+    if (!scriptSig.empty()) {
+        input.set({store({InputFinalScriptSig}), store(SignatureBuilder<Transaction>::pushAll(scriptSig))});
+    }
+    if (!witness.empty()) {
+        Data encoded;
+        encodeVarInt(witness.size(), encoded);
+        for (const auto& item : witness) {
+            encodeVarInt(item.size(), encoded);
+            append(encoded, item);
+        }
+        input.set({store({InputFinalScriptWitness}), store(std::move(encoded))});
+    }
+    return SigningResult::success();
+}
+
+SigningResult Psbt::finalize() {
+    const auto transaction = unsignedTransaction();
+    if (!transaction.has_value()) {
+        return SigningResult::failure(Common::Proto::Error_input_parse);
+    }
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (auto result = finalizeInput(i, transaction->inputs[i].previousOutput.index); !result) {
+            return result;
+        }
+    }
+    return SigningResult::success();
+}
+
+std::optional<Transaction> Psbt::unsignedTransaction() const {
+    Transaction transaction;
+    if (version() == 0) {
+        const auto unsignedTx = global.get(GlobalUnsignedTx);
+        const auto tx = unsignedTx.has_value() ? TxView::parse(*unsignedTx) : std::nullopt;
+        if (!tx.has_value()) {
+            return std::nullopt;
+        }
+        transaction._version = static_cast<int32_t>(tx->version);
+        transaction.lockTime = tx->lockTime;
+        for (const auto& input : tx->inputs) {
+            transaction.inputs.emplace_back(OutPoint(input.hash, input.index, input.sequence), Script(input.script.begin(), input.script.end()), input.sequence);
+        }
+        for (const auto& output : tx->outputs) {
+            transaction.outputs.emplace_back(static_cast<Amount>(output.value), Script(output.script.begin(), output.script.end()));
+        }
+        return transaction;
+    }
+
+    const auto txVersion = readU32(global.get(GlobalTxVersion));
+    if (!txVersion.has_value()) {
+        return std::nullopt;
+    }
+    transaction._version = static_cast<int32_t>(*txVersion);
+    transaction.lockTime = readU32(global.get(GlobalFallbackLocktime)).value_or(0);
+    for (const auto& input : inputs) {
+        const auto txid = input.get(InputPreviousTxid);
+        const auto index = readU32(input.get(InputOutputIndex));
+        if (!txid.has_value() || txid->size() != 32 || !index.has_value()) {
+            return std::nullopt;
+        }
+        const auto sequence = readU32(input.get(InputSequence)).value_or(0xffffffff);
+        transaction.inputs.emplace_back(OutPoint(*txid, *index, sequence), Script(), sequence);
+    }
+    for (const auto& output : outputs) {
+        const auto amount = output.get(OutputAmount);
+        const auto script = output.get(OutputScript);
+        if (!amount.has_value() || amount->size() != 8 || !script.has_value()) {
+            return std::nullopt;
+        }
+        transaction.outputs.emplace_back(static_cast<Amount>(decode64LE(amount->data())), Script(script->begin(), script->end()));
+    }
+    return transaction;
+}
+
+Result<Transaction, Common::Proto::SigningError> Psbt::extract() const {
+    using ExtractResult = Result<Transaction, Common::Proto::SigningError>;
+    auto transaction = unsignedTransaction();
+    if (!transaction.has_value()) {
+        return ExtractResult::failure(Common::Proto::Error_input_parse);
+    }
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const auto scriptSig = inputs[i].get(InputFinalScriptSig);
+        const auto witness = inputs[i].get(InputFinalScriptWitness);
+        if (!scriptSig.has_value() && !witness.has_value()) {
+            // not finalized
+            return ExtractResult::failure(Common::Proto::Error_signing);
+        }
+        auto& txInput = transaction->inputs[i];
+        txInput.script = scriptSig.has_value() ? Script(scriptSig->begin(), scriptSig->end()) : Script();
+        if (witness.has_value()) {
+            auto stack = parseWitness(*witness);
+            if (!stack.has_value()) {
+                return ExtractResult::failure(Common::Proto::Error_input_parse);
+            }
+            txInput.scriptWitness = std::move(*stack);
+        }
+    }
+    return ExtractResult::success(std::move(*transaction));
+}
+
+std::optional<SignaturePubkeyList> Psbt::externalSignatures(const HashPubkeyList& hashes) const {
+    SignaturePubkeyList signatures;
+    signatures.reserve(hashes.size());
+    std::size_t index = 0;
+    std::vector<const Entry*> used;
+    for (const auto& [sighash, publicKeyHash] : hashes) {
+        const Entry* found = nullptr;
+        for (; index < inputs.size() && found == nullptr; ++index) {
+            for (const auto& entry : inputs[index].range(InputPartialSig)) {
+                const auto publicKey = entry.keyData();
+                const auto hash = Hash::sha256ripemdInto(publicKey.data(), publicKey.size());
+                if (std::equal(hash.begin(), hash.end(), publicKeyHash.begin(), publicKeyHash.end()) && std::find(used.begin(), used.end(), &entry) == used.end() && !entry.value.empty()) {
+                    found = &entry;
+                    break;
+                }
+            }
+            if (found == nullptr) {
+                used.clear();
+            }
+        }
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        // stay on this input, it may have more signatures to use
+        --index;
+        used.push_back(found);
+        const auto publicKey = found->keyData();
+        signatures.emplace_back(Data(found->value.begin(), found->value.end() - 1), Data(publicKey.begin(), publicKey.end()));
+    }
+    return signatures;
+}
+
+} // namespace TW::Bitcoin
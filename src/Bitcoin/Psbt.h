@@ -0,0 +1,141 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Signer.h"
+#include "Transaction.h"
+#include "Data.h"
+#include "../CoinEntry.h"
+#include "../Result.h"
+#include "../proto/Common.pb.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Partially signed Bitcoin transaction, BIP174 (version 0) and BIP370 (version 2).
+/// Parsing doesn't copy: keys and values are views into the serialized PSBT, whose buffer is shared by
+/// copies of the object. Maps are kept sorted by key, so combining PSBTs is a linear merge.
+class Psbt {
+public:
+    using Bytes = std::span<const byte>;
+
+    /// A key-value pair, the key starts with its type byte.
+    struct Entry {
+        Bytes key;
+        Bytes value;
+
+        byte type() const noexcept { return key[0]; }
+        /// Key without its type byte, e.g. the public key of a partial signature.
+        Bytes keyData() const noexcept { return key.subspan(1); }
+    };
+
+    /// Key-value map, sorted by key.
+    class Map {
+    public:
+        const std::vector<Entry>& entries() const noexcept { return _entries; }
+
+        /// Value of the given key, if present.
+        std::optional<Bytes> get(byte type, Bytes keyData = {}) const noexcept;
+
+        /// Entries of the given type, contiguous as keys start with their type.
+        std::span<const Entry> range(byte type) const noexcept;
+
+        /// Inserts or replaces an entry.
+        void set(Entry entry);
+
+        /// Removes the entries of the types in `[first, last]`.
+        void erase(byte first, byte last);
+
+        /// Adds the entries of `other` missing in this map, in one pass over both.
+        void merge(const Map& other);
+
+    private:
+        friend class Psbt;
+        std::vector<Entry> _entries;
+    };
+
+    static constexpr byte GlobalUnsignedTx = 0x00;
+    static constexpr byte GlobalTxVersion = 0x02;
+    static constexpr byte GlobalFallbackLocktime = 0x03;
+    static constexpr byte GlobalInputCount = 0x04;
+    static constexpr byte GlobalOutputCount = 0x05;
+    static constexpr byte GlobalVersion = 0xfb;
+
+    static constexpr byte InputNonWitnessUtxo = 0x00;
+    static constexpr byte InputWitnessUtxo = 0x01;
+    static constexpr byte InputPartialSig = 0x02;
+    static constexpr byte InputSighashType = 0x03;
+    static constexpr byte InputRedeemScript = 0x04;
+    static constexpr byte InputWitnessScript = 0x05;
+    static constexpr byte InputBip32Derivation = 0x06;
+    static constexpr byte InputFinalScriptSig = 0x07;
+    static constexpr byte InputFinalScriptWitness = 0x08;
+    static constexpr byte InputPreviousTxid = 0x0e;
+    static constexpr byte InputOutputIndex = 0x0f;
+    static constexpr byte InputSequence = 0x10;
+
+    static constexpr byte OutputAmount = 0x03;
+    static constexpr byte OutputScript = 0x04;
+
+    Map global;
+    std::vector<Map> inputs;
+    std::vector<Map> outputs;
+
+    /// Parses a serialized PSBT, taking ownership of its bytes. Returns nothing if it is malformed.
+    static std::optional<Psbt> parse(Data data);
+
+    /// Creates a version 0 PSBT of an unsigned transaction.
+    static Psbt create(const Transaction& transaction);
+
+    /// PSBT version, 0 if not set.
+    uint32_t version() const noexcept;
+
+    /// Serializes the PSBT.
+    Data encode() const;
+
+    /// Combiner: adds the entries of `other`, a PSBT of the same transaction. Returns false if it is not.
+    bool combine(const Psbt& other);
+
+    /// Adds the signature of input `index` by `publicKey`; `signature` ends with its sighash type byte.
+    void addPartialSignature(std::size_t index, const Data& publicKey, const Data& signature);
+
+    /// Finalizer: builds the final scriptSig and witness of the inputs from their partial signatures
+    /// and scripts, and drops the signing data. Supports P2PK, P2PKH, P2WPKH and multisig,
+    /// bare or in P2SH, P2WSH or P2SH-P2WSH; multisig takes the signatures of any `required` keys.
+    /// Signatures are not verified.
+    Result<void, Common::Proto::SigningError> finalize();
+
+    /// The unsigned transaction, from the global transaction (version 0) or the input and output fields (version 2).
+    std::optional<Transaction> unsignedTransaction() const;
+
+    /// Extractor: the signed transaction of a finalized PSBT.
+    Result<Transaction, Common::Proto::SigningError> extract() const;
+
+    /// Partial signatures in the order of the pre-image hashes (`preImageHashes`) of the same transaction,
+    /// for signing with `SigningMode_External`. Each hash gets the next unused signature by a key of its
+    /// public key hash, looking from the input of the previous hash on; signature hash type bytes are removed.
+    /// As `SignatureBuilder` hashes the first `required` keys of multisig scripts, these have to be signed.
+    std::optional<SignaturePubkeyList> externalSignatures(const HashPubkeyList& hashes) const;
+
+private:
+    /// Keeps `data` alive with the PSBT and returns a view of it.
+    Bytes store(Data data);
+
+    /// Amount and script of the output spent by input `index`, output `outputIndex` of its previous transaction.
+    std::optional<std::pair<Amount, Bytes>> spentOutput(std::size_t index, uint32_t outputIndex) const;
+
+    Result<void, Common::Proto::SigningError> finalizeInput(std::size_t index, uint32_t outputIndex);
+
+    std::vector<std::shared_ptr<const Data>> buffers;
+};
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,291 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Schnorr.h"
+#include "../Random.h"
+#include "../algorithm/parallel.h"
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace TW::Bitcoin {
+
+using Bytes32 = std::array<byte, 32>;
+
+TaggedHash::TaggedHash(const std::string& tag) {
+    std::array<byte, 2 * SHA256_DIGEST_LENGTH> prefix;
+    sha256_Raw(reinterpret_cast<const byte*>(tag.data()), tag.size(), prefix.data());
+    std::copy_n(prefix.begin(), SHA256_DIGEST_LENGTH, prefix.begin() + SHA256_DIGEST_LENGTH);
+    sha256_Init(&midstate);
+    sha256_Update(&midstate, prefix.data(), prefix.size());
+}
+
+Bytes32 TaggedHash::hash(std::initializer_list<std::span<const byte>> parts) const {
+    auto ctx = midstate;
+    for (const auto& part : parts) {
+        sha256_Update(&ctx, part.data(), part.size());
+    }
+    Bytes32 digest;
+    sha256_Final(&ctx, digest.data());
+    return digest;
+}
+
+const TaggedHash& TaggedHash::aux() {
+    static const TaggedHash hasher("BIP0340/aux");
+    return hasher;
+}
+
+const TaggedHash& TaggedHash::nonce() {
+    static const TaggedHash hasher("BIP0340/nonce");
+    return hasher;
+}
+
+const TaggedHash& TaggedHash::challenge() {
+    static const TaggedHash hasher("BIP0340/challenge");
+    return hasher;
+}
+
+const TaggedHash& TaggedHash::tapTweak() {
+    static const TaggedHash hasher("TapTweak");
+    return hasher;
+}
+
+const TaggedHash& TaggedHash::tapSighash() {
+    static const TaggedHash hasher("TapSighash");
+    return hasher;
+}
+
+namespace {
+
+/// Reads the point with the given x coordinate and an even y; false if there is none.
+bool liftX(const byte* x, curve_point& point) {
+    std::array<byte, 33> compressed;
+    compressed[0] = 0x02;
+    std::copy_n(x, 32, compressed.begin() + 1);
+    return ecdsa_read_pubkey(&secp256k1, compressed.data(), &point) != 0;
+}
+
+/// Negates `point` if its y is odd.
+void makeEvenY(curve_point& point) {
+    bn_mod(&point.y, &secp256k1.prime);
+    if (bn_is_odd(&point.y)) {
+        bn_subtract(&secp256k1.prime, &point.y, &point.y);
+    }
+}
+
+/// Reduces a 32-byte hash modulo the curve order.
+bignum256 scalar(const Bytes32& hash) {
+    bignum256 result;
+    bn_read_be(hash.data(), &result);
+    bn_mod(&result, &secp256k1.order);
+    return result;
+}
+
+} // namespace
+
+XOnlyPublicKey::XOnlyPublicKey(const Data& x) {
+    curve_point point;
+    if (x.size() != size || !liftX(x.data(), point)) {
+        throw std::invalid_argument("Invalid x-only public key");
+    }
+    bn_write_be(&point.x, this->x.data());
+    bn_write_be(&point.y, this->y.data());
+}
+
+XOnlyPublicKey::XOnlyPublicKey(const PublicKey& publicKey) {
+    if (publicKey.type != TWPublicKeyTypeSECP256k1 && publicKey.type != TWPublicKeyTypeSECP256k1Extended) {
+        throw std::invalid_argument("Invalid public key type");
+    }
+    curve_point point;
+    if (!liftX(publicKey.bytes.data() + 1, point)) {
+        throw std::invalid_argument("Invalid public key");
+    }
+    std::copy_n(publicKey.bytes.begin() + 1, size, x.begin());
+    bn_write_be(&point.y, y.data());
+}
+
+bool XOnlyPublicKey::verify(const Data& signature, const Data& message) const noexcept {
+    if (signature.size() != 64 || message.size() != 32) {
+        return false;
+    }
+    bignum256 r;
+    bignum256 s;
+    bn_read_be(signature.data(), &r);
+    bn_read_be(signature.data() + 32, &s);
+    if (!bn_is_less(&r, &secp256k1.prime) || !bn_is_less(&s, &secp256k1.order)) {
+        return false;
+    }
+
+    // R = s * G - e * P
+    auto e = scalar(TaggedHash::challenge().hash({std::span(signature.data(), 32), x, message}));
+    bn_subtract(&secp256k1.order, &e, &e);
+    bn_mod(&e, &secp256k1.order);
+    curve_point point;
+    bn_read_be(x.data(), &point.x);
+    bn_read_be(y.data(), &point.y);
+    curve_point eP;
+    curve_point R;
+    point_multiply(&secp256k1, &e, &point, &eP);
+    scalar_multiply(&secp256k1, &s, &R);
+    point_add(&secp256k1, &eP, &R);
+
+    if (point_is_infinity(&R)) {
+        return false;
+    }
+    bn_mod(&R.x, &secp256k1.prime);
+    bn_mod(&R.y, &secp256k1.prime);
+    return bn_is_even(&R.y) && bn_is_equal(&R.x, &r);
+}
+
+XOnlyPublicKey XOnlyPublicKey::tweak(const Data& merkleRoot) const {
+    bignum256 t;
+    bn_read_be(TaggedHash::tapTweak().hash({x, merkleRoot}).data(), &t);
+    if (!bn_is_less(&t, &secp256k1.order)) {
+        throw std::invalid_argument("Invalid Taproot tweak");
+    }
+    curve_point point;
+    bn_read_be(x.data(), &point.x);
+    bn_read_be(y.data(), &point.y);
+    curve_point Q;
+    scalar_multiply(&secp256k1, &t, &Q);
+    point_add(&secp256k1, &point, &Q);
+    if (point_is_infinity(&Q)) {
+        throw std::invalid_argument("Invalid Taproot tweak");
+    }
+    bn_mod(&Q.x, &secp256k1.prime);
+    makeEvenY(Q);
+    Bytes32 qx;
+    Bytes32 qy;
+    bn_write_be(&Q.x, qx.data());
+    bn_write_be(&Q.y, qy.data());
+    return XOnlyPublicKey(qx, qy);
+}
+
+bool verifySchnorrBatch(std::span<const SchnorrVerification> items, std::size_t threads) {
+    std::atomic<bool> valid{true};
+    parallelFor(items.size(), threads, [&](std::size_t i) {
+        if (valid.load(std::memory_order_relaxed) && !items[i].publicKey.verify(items[i].signature, items[i].message)) {
+            valid.store(false, std::memory_order_relaxed);
+        }
+    });
+    return valid.load();
+}
+
+SchnorrSigner SchnorrSigner::fromSecret(const Bytes32& secret) {
+    bignum256 d;
+    bn_read_be(secret.data(), &d);
+    curve_point P;
+    if (bn_is_zero(&d) || scalar_multiply(&secp256k1, &d, &P) != 0) {
+        memzero(&d, sizeof(d));
+        throw std::invalid_argument("Invalid private key");
+    }
+    bn_mod(&P.x, &secp256k1.prime);
+    bn_mod(&P.y, &secp256k1.prime);
+    if (bn_is_odd(&P.y)) {
+        bn_subtract(&secp256k1.order, &d, &d);
+        bn_subtract(&secp256k1.prime, &P.y, &P.y);
+    }
+    Bytes32 negated;
+    Bytes32 px;
+    Bytes32 py;
+    bn_write_be(&d, negated.data());
+    bn_write_be(&P.x, px.data());
+    bn_write_be(&P.y, py.data());
+    auto signer = SchnorrSigner(negated, XOnlyPublicKey(px, py));
+    memzero(&d, sizeof(d));
+    memzero(negated.data(), negated.size());
+    return signer;
+}
+
+SchnorrSigner::SchnorrSigner(const PrivateKey& privateKey)
+    : SchnorrSigner(fromSecret([&] {
+          Bytes32 secret;
+          if (privateKey.bytes.size() < secret.size()) {
+              throw std::invalid_argument("Invalid private key");
+          }
+          std::copy_n(privateKey.bytes.begin(), secret.size(), secret.begin());
+          return secret;
+      }())) {
+}
+
+SchnorrSigner SchnorrSigner::taprootKeyPath(const PrivateKey& privateKey, const Data& merkleRoot) {
+    const auto internal = SchnorrSigner(privateKey);
+    bignum256 t;
+    bn_read_be(TaggedHash::tapTweak().hash({internal.xOnly.x, merkleRoot}).data(), &t);
+    if (!bn_is_less(&t, &secp256k1.order)) {
+        throw std::invalid_argument("Invalid Taproot tweak");
+    }
+    bignum256 d;
+    bn_read_be(internal.secret.data(), &d);
+    bn_addmod(&d, &t, &secp256k1.order);
+    bn_mod(&d, &secp256k1.order);
+    Bytes32 tweaked;
+    bn_write_be(&d, tweaked.data());
+    memzero(&d, sizeof(d));
+    auto signer = fromSecret(tweaked);
+    memzero(tweaked.data(), tweaked.size());
+    return signer;
+}
+
+SchnorrSigner::~SchnorrSigner() {
+    memzero(secret.data(), secret.size());
+}
+
+Data SchnorrSigner::sign(const Data& message, const Data& auxRand) const {
+    if (message.size() != 32 || auxRand.size() != 32) {
+        return {};
+    }
+    auto t = TaggedHash::aux().hash({auxRand});
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        t[i] ^= secret[i];
+    }
+    auto k = scalar(TaggedHash::nonce().hash({t, xOnly.x, message}));
+    memzero(t.data(), t.size());
+    if (bn_is_zero(&k)) {
+        return {};
+    }
+
+    curve_point R;
+    scalar_multiply(&secp256k1, &k, &R);
+    bn_mod(&R.x, &secp256k1.prime);
+    bn_mod(&R.y, &secp256k1.prime);
+    if (bn_is_odd(&R.y)) {
+        bn_subtract(&secp256k1.order, &k, &k);
+    }
+    Data signature(64);
+    bn_write_be(&R.x, signature.data());
+
+    // s = k + e * d
+    auto e = scalar(TaggedHash::challenge().hash({std::span(signature.data(), 32), xOnly.x, message}));
+    bignum256 d;
+    bn_read_be(secret.data(), &d);
+    bn_multiply(&d, &e, &secp256k1.order);
+    bn_addmod(&e, &k, &secp256k1.order);
+    bn_mod(&e, &secp256k1.order);
+    bn_write_be(&e, signature.data() + 32);
+
+    memzero(&d, sizeof(d));
+    memzero(&k, sizeof(k));
+    return signature;
+}
+
+std::vector<Data> SchnorrSigner::signBatch(const std::vector<Data>& messages, std::size_t threads) const {
+    std::vector<Data> signatures(messages.size());
+    parallelFor(messages.size(), threads, [&](std::size_t i) {
+        Data auxRand(32);
+        Random::fill(auxRand.data(), auxRand.size());
+        signatures[i] = sign(messages[i], auxRand);
+    });
+    return signatures;
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,119 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "../PrivateKey.h"
+#include "../PublicKey.h"
+
+#include <TrezorCrypto/sha2.h>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// BIP340 tagged hash, SHA256(SHA256(tag) || SHA256(tag) || data).
+/// The tag prefix is exactly one SHA256 block: its midstate is computed once, and each hash resumes from it.
+class TaggedHash {
+public:
+    explicit TaggedHash(const std::string& tag);
+
+    /// Hash of the concatenation of `parts`.
+    std::array<byte, 32> hash(std::initializer_list<std::span<const byte>> parts) const;
+
+    static const TaggedHash& aux();
+    static const TaggedHash& nonce();
+    static const TaggedHash& challenge();
+    static const TaggedHash& tapTweak();
+    static const TaggedHash& tapSighash();
+
+private:
+    SHA256_CTX midstate;
+};
+
+/// BIP340 x-only public key: the x coordinate of a secp256k1 point with an even y.
+/// The point is lifted once on construction, verifications don't redo the square root.
+class XOnlyPublicKey {
+public:
+    static constexpr std::size_t size = 32;
+
+    /// Lifts `x`; throws std::invalid_argument if it is not the x coordinate of a curve point.
+    explicit XOnlyPublicKey(const Data& x);
+
+    /// x-only key of a secp256k1 public key, its y parity is dropped.
+    explicit XOnlyPublicKey(const PublicKey& publicKey);
+
+    const std::array<byte, 32>& bytes() const noexcept { return x; }
+
+    /// Verifies a 64-byte BIP340 signature of a 32-byte message.
+    bool verify(const Data& signature, const Data& message) const noexcept;
+
+    /// Taproot output key of this internal key (BIP341), `merkleRoot` is empty for key-path only outputs.
+    XOnlyPublicKey tweak(const Data& merkleRoot = {}) const;
+
+private:
+    XOnlyPublicKey(const std::array<byte, 32>& x, const std::array<byte, 32>& y) noexcept : x(x), y(y) {}
+
+    std::array<byte, 32> x;
+    std::array<byte, 32> y;
+
+    friend class SchnorrSigner;
+};
+
+/// One signature of a batch verification.
+struct SchnorrVerification {
+    const XOnlyPublicKey& publicKey;
+    const Data& signature;
+    const Data& message;
+};
+
+/// Returns true if all signatures are valid; stops at the first invalid one.
+/// Signatures are checked independently, on `threads` workers (0: hardware concurrency).
+bool verifySchnorrBatch(std::span<const SchnorrVerification> items, std::size_t threads = 0);
+
+/// BIP340 signer of one key, for producing many signatures: the key parity and x-only public key
+/// (and Taproot tweak) are computed once, each signature then costs one nonce point multiplication.
+class SchnorrSigner {
+public:
+    /// Signer with the untweaked key, for BIP340 signatures.
+    explicit SchnorrSigner(const PrivateKey& privateKey);
+
+    /// Signer of Taproot key-path spends: the key is tweaked with `merkleRoot` (empty for key-path only outputs).
+    static SchnorrSigner taprootKeyPath(const PrivateKey& privateKey, const Data& merkleRoot = {});
+
+    ~SchnorrSigner();
+    SchnorrSigner(const SchnorrSigner&) = default;
+    SchnorrSigner& operator=(const SchnorrSigner&) = default;
+
+    /// Public key the signatures verify against, the Taproot output key for `taprootKeyPath`.
+    const XOnlyPublicKey& publicKey() const noexcept { return xOnly; }
+
+    /// Signs a 32-byte message (e.g. a TapSighash) with the 32-byte auxiliary randomness `auxRand`.
+    /// Returns the 64-byte signature, empty for invalid arguments.
+    Data sign(const Data& message, const Data& auxRand) const;
+
+    /// Signs each of `messages` with fresh auxiliary randomness, on `threads` workers (0: hardware concurrency).
+    std::vector<Data> signBatch(const std::vector<Data>& messages, std::size_t threads = 0) const;
+
+private:
+    SchnorrSigner(const std::array<byte, 32>& secret, const XOnlyPublicKey& xOnly) noexcept
+        : secret(secret), xOnly(xOnly) {}
+
+    /// Throws std::invalid_argument if `secret` is not a valid secp256k1 secret key.
+    static SchnorrSigner fromSecret(const std::array<byte, 32>& secret);
+
+    /// Secret key negated for an even public key y
+    std::array<byte, 32> secret;
+    XOnlyPublicKey xOnly;
+};
+
+} // namespace TW::Bitcoin
@@ -28,174 +28,76 @@ Data Script::hash() const {
 }
 
 bool Script::isPayToScriptHash() const {
-    // Extra-fast test for pay-to-script-hash
-    return bytes.size() == 23 && bytes[0] == OP_HASH160 && bytes[1] == 0x14 &&
-           bytes[22] == OP_EQUAL;
+    return view().isPayToScriptHash();
 }
 
 bool Script::isPayToWitnessScriptHash() const {
-    // Extra-fast test for pay-to-witness-script-hash
-    return bytes.size() == 34 && bytes[0] == OP_0 && bytes[1] == 0x20;
+    return view().isPayToWitnessScriptHash();
 }
 
 bool Script::isPayToWitnessPublicKeyHash() const {
-    // Extra-fast test for pay-to-witness-public-key-hash
-    return bytes.size() == 22 && bytes[0] == OP_0 && bytes[1] == 0x14;
+    return view().isPayToWitnessPublicKeyHash();
 }
 
 bool Script::isWitnessProgram() const {
-    if (bytes.size() < 4 || bytes.size() > 42) {
-        return false;
-    }
-    if (bytes[0] != OP_0 && (bytes[0] < OP_1 || bytes[0] > OP_16)) {
+    return view().isWitnessProgram();
+}
+
+/// Copies a matched part of the script into `result`.
+static bool assignMatch(const std::optional<ScriptView::Bytes>& match, Data& result) {
+    if (!match.has_value()) {
         return false;
     }
-    return bytes[1] + 2 == bytes.size();
+    result.assign(match->begin(), match->end());
+    return true;
 }
 
 bool Script::matchPayToPublicKey(Data& result) const {
-    if (bytes.size() == PublicKey::secp256k1ExtendedSize + 2 &&
-        bytes[0] == PublicKey::secp256k1ExtendedSize && bytes.back() == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 1, std::begin(bytes) + 1 + PublicKey::secp256k1Size,
-                  std::back_inserter(result));
-        return true;
-    }
-    if (bytes.size() == PublicKey::secp256k1Size + 2 && bytes[0] == PublicKey::secp256k1Size &&
-        bytes.back() == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 1, std::begin(bytes) + 1 + PublicKey::secp256k1Size,
-                  std::back_inserter(result));
-        return true;
-    }
-    return false;
+    return assignMatch(view().matchPayToPublicKey(), result);
 }
 
 bool Script::matchPayToPublicKeyHash(Data& result) const {
-    if (bytes.size() == 25 && bytes[0] == OP_DUP && bytes[1] == OP_HASH160 && bytes[2] == 20 &&
-        bytes[23] == OP_EQUALVERIFY && bytes[24] == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 3, std::begin(bytes) + 3 + 20, std::back_inserter(result));
-        return true;
-    }
-    return false;
+    return assignMatch(view().matchPayToPublicKeyHash(), result);
 }
 
 bool Script::matchPayToScriptHash(Data& result) const {
-    if (!isPayToScriptHash()) {
-        return false;
-    }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::begin(bytes) + 22, std::back_inserter(result));
-    return true;
+    return assignMatch(view().matchPayToScriptHash(), result);
 }
 
 bool Script::matchPayToWitnessPublicKeyHash(Data& result) const {
-    if (!isPayToWitnessPublicKeyHash()) {
-        return false;
-    }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::end(bytes), std::back_inserter(result));
-    return true;
+    return assignMatch(view().matchPayToWitnessPublicKeyHash(), result);
 }
 
 bool Script::matchPayToWitnessScriptHash(Data& result) const {
-    if (!isPayToWitnessScriptHash()) {
-        return false;
-    }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::end(bytes), std::back_inserter(result));
-    return true;
+    return assignMatch(view().matchPayToWitnessScriptHash(), result);
 }
 
 bool Script::matchMultisig(std::vector<Data>& keys, int& required) const {
     keys.clear();
     required = 0;
 
-    if (bytes.size() < 1 || bytes.back() != OP_CHECKMULTISIG) {
-        return false;
-    }
-
-    size_t it = 0;
-    uint8_t opcode;
-    Data operand;
-
-    auto op = getScriptOp(it, opcode, operand);
-    if (!op || !TWOpCodeIsSmallInteger(opcode)) {
-        return false;
-    }
-    required = decodeNumber(opcode);
-    while (true) {
-        auto res = getScriptOp(it, opcode, operand);
-        if (!res) {
-            break;
-        }
-        if (!PublicKey::isValid(operand, TWPublicKeyTypeSECP256k1)) {
-            break;
-        }
-        keys.push_back(operand);
-    }
-
-    if (!TWOpCodeIsSmallInteger(opcode)) {
-        return false;
-    }
-
-    std::size_t expectedCount = decodeNumber(opcode);
-    if (keys.size() != expectedCount || expectedCount < static_cast<std::size_t>(required)) {
+    const auto multisig = view().matchMultisig();
+    if (!multisig.has_value()) {
         return false;
     }
-    if (it + 1 != bytes.size()) {
-        return false;
+    required = multisig->required;
+    keys.reserve(multisig->count);
+    const auto keyOps = ScriptView(multisig->keys);
+    std::size_t index = 0;
+    ScriptView::Op op;
+    while (keyOps.nextOp(index, op)) {
+        keys.emplace_back(op.operand.begin(), op.operand.end());
     }
-
     return true;
 }
 
 bool Script::getScriptOp(size_t& index, uint8_t& opcode, Data& operand) const {
-    operand.clear();
-
-    // Read instruction
-    if (index >= bytes.size()) {
-        return false;
-    }
-
-    opcode = bytes[index];
-    index += 1;
-
-    if (opcode > OP_PUSHDATA4) {
-        return true;
-    }
-
-    // Immediate operand
-    size_t size = 0;
-    if (opcode < OP_PUSHDATA1) {
-        size = static_cast<size_t>(opcode);
-    } else if (opcode == OP_PUSHDATA1) {
-        if (bytes.size() - index < 1) {
-            return false;
-        }
-        size = bytes[index];
-        index += 1;
-    } else if (opcode == OP_PUSHDATA2) {
-        if (bytes.size() - index < 2) {
-            return false;
-        }
-        size = static_cast<size_t>(decode16LE(bytes.data() + index));
-        index += 2;
-    } else if (opcode == OP_PUSHDATA4) {
-        if (bytes.size() - index < 4) {
-            return false;
-        }
-        size = static_cast<size_t>(decode32LE(bytes.data() + index));
-        index += 4;
-    }
-    if (bytes.size() - index < size) {
-        return false;
-    }
-    operand = Data(bytes.begin() + index, bytes.begin() + index + size);
-    index += size;
-
-    return true;
+    // the opcode is left unchanged at the end of the script
+    ScriptView::Op op{opcode, {}};
+    const auto result = view().nextOp(index, op);
+    opcode = op.opcode;
+    operand.assign(op.operand.begin(), op.operand.end());
+    return result;
 }
 
 Script Script::buildPayToPublicKey(const Data& publicKey) {
@@ -288,30 +190,32 @@ Script Script::buildOpReturnScript(const Data& data) {
 
 void Script::encode(Data& data) const {
     encodeVarInt(bytes.size(), data);
-    std::copy(std::begin(bytes), std::end(bytes), std::back_inserter(data));
+    data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+std::size_t Script::serializedSize() const {
+    return varIntSize(bytes.size()) + bytes.size();
+}
+
+/// Locking script of the prefix and hash of a legacy address, empty if the prefix is not the coin's P2PKH or P2SH one.
+template <typename Bytes>
+static Script lockScriptForLegacyAddress(const Bytes& bytes, enum TWCoinType coin) {
+    const auto hash = Data(bytes.begin() + 1, bytes.end());
+    if (bytes[0] == TW::p2pkhPrefix(coin)) {
+        // address starts with 1/L
+        return Script::buildPayToPublicKeyHash(hash);
+    }
+    if (bytes[0] == TW::p2shPrefix(coin)) {
+        // address starts with 3/M
+        return Script::buildPayToScriptHash(hash);
+    }
+    return {};
 }
 
 Script Script::lockScriptForAddress(const std::string& string, enum TWCoinType coin) {
-    // First try legacy address, for all coins
-    if (Address::isValid(string)) {
-        auto address = Address(string);
-        auto p2pkh = TW::p2pkhPrefix(coin);
-        auto p2sh = TW::p2shPrefix(coin);
-        if (p2pkh == address.bytes[0]) {
-            // address starts with 1/L
-            auto data = Data();
-            data.reserve(Address::size - 1);
-            std::copy(address.bytes.begin() + 1, address.bytes.end(), std::back_inserter(data));
-            return buildPayToPublicKeyHash(data);
-        }
-        if (p2sh == address.bytes[0]) {
-            // address starts with 3/M
-            auto data = Data();
-            data.reserve(Address::size - 1);
-            std::copy(address.bytes.begin() + 1, address.bytes.end(), std::back_inserter(data));
-            return buildPayToScriptHash(data);
-        }
-        return {};
+    // First try legacy address, for all coins; decoded once instead of validating and then parsing
+    if (const auto decoded = Base58::decodeCheck(string); decoded.size() == Address::size) {
+        return lockScriptForLegacyAddress(decoded, coin);
     }
 
     // Second, try Segwit address, for all coins; also check HRP
@@ -335,14 +239,13 @@ Script Script::lockScriptForAddress(const std::string& string, enum TWCoinType c
         case TWCoinTypeBitcoinCash:
             if (BitcoinCashAddress::isValid(string)) {
                 auto address = BitcoinCashAddress(string);
-                auto bitcoinAddress = address.legacyAddress();
-                return lockScriptForAddress(bitcoinAddress.string(), TWCoinTypeBitcoinCash);
+                return lockScriptForLegacyAddress(address.legacyAddress().bytes, TWCoinTypeBitcoinCash);
             }
             return {};
 
         case TWCoinTypeDecred:
             if (Decred::Address::isValid(string)) {
-                auto bytes = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherBlake256d);
+                auto bytes = Base58::decodeCheck<Hash::HasherBlake256d>(string);
                 if (bytes[1] == TW::p2pkhPrefix(TWCoinTypeDecred)) {
                     return buildPayToPublicKeyHash(Data(bytes.begin() + 2, bytes.end()));
                 }
@@ -355,8 +258,7 @@ Script Script::lockScriptForAddress(const std::string& string, enum TWCoinType c
         case TWCoinTypeECash:
             if (ECashAddress::isValid(string)) {
                 auto address = ECashAddress(string);
-                auto bitcoinAddress = address.legacyAddress();
-                return lockScriptForAddress(bitcoinAddress.string(), TWCoinTypeECash);
+                return lockScriptForLegacyAddress(address.legacyAddress().bytes, TWCoinTypeECash);
             }
             return {};
 
@@ -9,6 +9,7 @@
 #include "Data.h"
 
 #include "OpCodes.h"
+#include "ScriptView.h"
 #include <TrustWalletCore/TWCoinType.h>
 
 #include <string>
@@ -39,6 +40,9 @@ class Script {
     /// Whether the script is empty.
     bool empty() const { return bytes.empty(); }
 
+    /// Non-owning view of the script bytes, for matching without copies.
+    ScriptView view() const noexcept { return ScriptView(bytes); }
+
     /// Returns the script's script hash.
     Data hash() const;
 
@@ -104,6 +108,9 @@ class Script {
     /// Encodes the script.
     void encode(Data& data) const;
 
+    /// Size of the encoded script, including the length prefix.
+    std::size_t serializedSize() const;
+
     /// Encodes a small integer
     static inline uint8_t encodeNumber(int n) {
         assert(n >= 0 && n <= 16);
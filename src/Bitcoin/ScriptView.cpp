@@ -0,0 +1,200 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ScriptView.h"
+#include "OpCodes.h"
+
+#include "../BinaryCoding.h"
+#include "../PublicKey.h"
+
+namespace TW::Bitcoin {
+
+static bool isCompressedPublicKey(ScriptView::Bytes key) noexcept {
+    return key.size() == PublicKey::secp256k1Size && (key[0] == 0x02 || key[0] == 0x03);
+}
+
+bool ScriptView::isPayToScriptHash() const noexcept {
+    // Extra-fast test for pay-to-script-hash
+    return bytes.size() == 23 && bytes[0] == OP_HASH160 && bytes[1] == 0x14 &&
+           bytes[22] == OP_EQUAL;
+}
+
+bool ScriptView::isPayToWitnessScriptHash() const noexcept {
+    // Extra-fast test for pay-to-witness-script-hash
+    return bytes.size() == 34 && bytes[0] == OP_0 && bytes[1] == 0x20;
+}
+
+bool ScriptView::isPayToWitnessPublicKeyHash() const noexcept {
+    // Extra-fast test for pay-to-witness-public-key-hash
+    return bytes.size() == 22 && bytes[0] == OP_0 && bytes[1] == 0x14;
+}
+
+bool ScriptView::isPayToTaproot() const noexcept {
+    return bytes.size() == 34 && bytes[0] == OP_1 && bytes[1] == 0x20;
+}
+
+bool ScriptView::isWitnessProgram() const noexcept {
+    if (bytes.size() < 4 || bytes.size() > 42) {
+        return false;
+    }
+    if (bytes[0] != OP_0 && (bytes[0] < OP_1 || bytes[0] > OP_16)) {
+        return false;
+    }
+    return static_cast<std::size_t>(bytes[1]) + 2 == bytes.size();
+}
+
+std::optional<ScriptView::Bytes> ScriptView::matchPayToPublicKey() const noexcept {
+    if (bytes.size() == PublicKey::secp256k1ExtendedSize + 2 &&
+        bytes[0] == PublicKey::secp256k1ExtendedSize && bytes.back() == OP_CHECKSIG) {
+        // only the first 33 bytes, as `Script::matchPayToPublicKey` always did
+        return bytes.subspan(1, PublicKey::secp256k1Size);
+    }
+    if (bytes.size() == PublicKey::secp256k1Size + 2 && bytes[0] == PublicKey::secp256k1Size &&
+        bytes.back() == OP_CHECKSIG) {
+        return bytes.subspan(1, PublicKey::secp256k1Size);
+    }
+    return std::nullopt;
+}
+
+std::optional<ScriptView::Bytes> ScriptView::matchPayToPublicKeyHash() const noexcept {
+    if (bytes.size() == 25 && bytes[0] == OP_DUP && bytes[1] == OP_HASH160 && bytes[2] == 20 &&
+        bytes[23] == OP_EQUALVERIFY && bytes[24] == OP_CHECKSIG) {
+        return bytes.subspan(3, 20);
+    }
+    return std::nullopt;
+}
+
+std::optional<ScriptView::Bytes> ScriptView::matchPayToScriptHash() const noexcept {
+    if (!isPayToScriptHash()) {
+        return std::nullopt;
+    }
+    return bytes.subspan(2, 20);
+}
+
+std::optional<ScriptView::Bytes> ScriptView::matchPayToWitnessPublicKeyHash() const noexcept {
+    if (!isPayToWitnessPublicKeyHash()) {
+        return std::nullopt;
+    }
+    return bytes.subspan(2);
+}
+
+std::optional<ScriptView::Bytes> ScriptView::matchPayToWitnessScriptHash() const noexcept {
+    if (!isPayToWitnessScriptHash()) {
+        return std::nullopt;
+    }
+    return bytes.subspan(2);
+}
+
+std::optional<ScriptView::Multisig> ScriptView::matchMultisig() const noexcept {
+    if (bytes.empty() || bytes.back() != OP_CHECKMULTISIG) {
+        return std::nullopt;
+    }
+
+    std::size_t index = 0;
+    Op op;
+    if (!nextOp(index, op) || !TWOpCodeIsSmallInteger(op.opcode)) {
+        return std::nullopt;
+    }
+    Multisig multisig;
+    multisig.required = static_cast<int>(op.opcode) - static_cast<int>(OP_1 - 1);
+
+    const auto keysBegin = index;
+    auto keysEnd = index;
+    while (nextOp(index, op) && isCompressedPublicKey(op.operand)) {
+        multisig.count += 1;
+        keysEnd = index;
+    }
+
+    if (!TWOpCodeIsSmallInteger(op.opcode)) {
+        return std::nullopt;
+    }
+    const std::size_t expectedCount = static_cast<int>(op.opcode) - static_cast<int>(OP_1 - 1);
+    if (multisig.count != expectedCount || expectedCount < static_cast<std::size_t>(multisig.required)) {
+        return std::nullopt;
+    }
+    if (index + 1 != bytes.size()) {
+        return std::nullopt;
+    }
+    multisig.keys = bytes.subspan(keysBegin, keysEnd - keysBegin);
+    return multisig;
+}
+
+ScriptType ScriptView::type() const noexcept {
+    if (isPayToScriptHash()) {
+        return ScriptType::PayToScriptHash;
+    }
+    if (isPayToWitnessPublicKeyHash()) {
+        return ScriptType::PayToWitnessPublicKeyHash;
+    }
+    if (isPayToWitnessScriptHash()) {
+        return ScriptType::PayToWitnessScriptHash;
+    }
+    if (isPayToTaproot()) {
+        return ScriptType::PayToTaproot;
+    }
+    if (isWitnessProgram()) {
+        return ScriptType::WitnessProgram;
+    }
+    if (matchPayToPublicKeyHash().has_value()) {
+        return ScriptType::PayToPublicKeyHash;
+    }
+    if (matchPayToPublicKey().has_value()) {
+        return ScriptType::PayToPublicKey;
+    }
+    if (matchMultisig().has_value()) {
+        return ScriptType::Multisig;
+    }
+    return ScriptType::Unknown;
+}
+
+bool ScriptView::nextOp(std::size_t& index, Op& op) const noexcept {
+    op.operand = {};
+
+    // Read instruction
+    if (index >= bytes.size()) {
+        return false;
+    }
+
+    op.opcode = bytes[index];
+    index += 1;
+
+    if (op.opcode > OP_PUSHDATA4) {
+        return true;
+    }
+
+    // Immediate operand
+    std::size_t size = 0;
+    if (op.opcode < OP_PUSHDATA1) {
+        size = static_cast<std::size_t>(op.opcode);
+    } else if (op.opcode == OP_PUSHDATA1) {
+        if (bytes.size() - index < 1) {
+            return false;
+        }
+        size = bytes[index];
+        index += 1;
+    } else if (op.opcode == OP_PUSHDATA2) {
+        if (bytes.size() - index < 2) {
+            return false;
+        }
+        size = static_cast<std::size_t>(decode16LE(bytes.data() + index));
+        index += 2;
+    } else if (op.opcode == OP_PUSHDATA4) {
+        if (bytes.size() - index < 4) {
+            return false;
+        }
+        size = static_cast<std::size_t>(decode32LE(bytes.data() + index));
+        index += 4;
+    }
+    if (bytes.size() - index < size) {
+        return false;
+    }
+    op.operand = bytes.subspan(index, size);
+    index += size;
+
+    return true;
+}
+
+} // namespace TW::Bitcoin
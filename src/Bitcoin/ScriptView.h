@@ -0,0 +1,93 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace TW::Bitcoin {
+
+/// Standard script types, see `ScriptView::type`.
+enum class ScriptType {
+    Unknown,
+    PayToPublicKey,
+    PayToPublicKeyHash,
+    PayToScriptHash,
+    PayToWitnessPublicKeyHash,
+    PayToWitnessScriptHash,
+    PayToTaproot,
+    WitnessProgram, // other witness versions and lengths
+    Multisig,
+};
+
+/// Non-owning view of the bytes of a Bitcoin script.
+/// Matching and operation parsing return views into the script bytes and never allocate;
+/// the viewed bytes must outlive the view and its results.
+class ScriptView {
+public:
+    using Bytes = std::span<const byte>;
+
+    /// A script operation: the opcode and, for push opcodes, the pushed data.
+    struct Op {
+        uint8_t opcode = 0;
+        Bytes operand;
+    };
+
+    /// A matched multisig script.
+    struct Multisig {
+        /// Number of required signatures.
+        int required = 0;
+        /// Number of public keys.
+        std::size_t count = 0;
+        /// The public key pushes, to be iterated with `nextOp`.
+        Bytes keys;
+    };
+
+    ScriptView() noexcept = default;
+    ScriptView(Bytes bytes) noexcept : bytes(bytes) {}
+    ScriptView(const Data& bytes) noexcept : bytes(bytes) {}
+
+    Bytes data() const noexcept { return bytes; }
+    std::size_t size() const noexcept { return bytes.size(); }
+    bool empty() const noexcept { return bytes.empty(); }
+
+    bool isPayToScriptHash() const noexcept;
+    bool isPayToWitnessScriptHash() const noexcept;
+    bool isPayToWitnessPublicKeyHash() const noexcept;
+    /// Segwit version 1 program with a 32-byte key.
+    bool isPayToTaproot() const noexcept;
+    bool isWitnessProgram() const noexcept;
+
+    /// Public key of a pay-to-public-key (P2PK) script.
+    std::optional<Bytes> matchPayToPublicKey() const noexcept;
+    /// Key hash of a pay-to-public-key-hash (P2PKH) script.
+    std::optional<Bytes> matchPayToPublicKeyHash() const noexcept;
+    /// Script hash of a pay-to-script-hash (P2SH) script.
+    std::optional<Bytes> matchPayToScriptHash() const noexcept;
+    /// Key hash of a pay-to-witness-public-key-hash (P2WPKH) script.
+    std::optional<Bytes> matchPayToWitnessPublicKeyHash() const noexcept;
+    /// Script hash (SHA256 of the witness script) of a pay-to-witness-script-hash (P2WSH) script.
+    std::optional<Bytes> matchPayToWitnessScriptHash() const noexcept;
+    /// Bare multisig script with compressed public keys.
+    std::optional<Multisig> matchMultisig() const noexcept;
+
+    /// Classifies the script.
+    ScriptType type() const noexcept;
+
+    /// Reads the operation at `index` and advances `index` to the next one.
+    /// \returns false at the end of the script or on a truncated push; `op.opcode` is set in the latter case.
+    bool nextOp(std::size_t& index, Op& op) const noexcept;
+
+private:
+    Bytes bytes;
+};
+
+} // namespace TW::Bitcoin
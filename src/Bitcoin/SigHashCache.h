@@ -0,0 +1,54 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "Hash.h"
+
+#include <optional>
+#include <utility>
+
+namespace TW::Bitcoin {
+
+/// Caches the transaction-wide parts of BIP143-style signature pre-images
+/// (hashPrevouts, hashSequence, hashOutputs), so that they are computed once per transaction
+/// instead of once per signed input.
+/// The cache is only valid while the outpoints, sequences and outputs of the transaction don't change.
+struct SigHashCache {
+    std::optional<Data> prevoutHash;
+    std::optional<Data> sequenceHash;
+    std::optional<Data> outputsHash;
+    /// Hash of the whole transaction prefix, for transactions committing to it as one (Decred).
+    std::optional<Data> prefixHash;
+    /// Hasher fed with the pre-image prefix shared by the inputs signed with one hash type, and that hash type.
+    /// Used by transactions whose signature hash is a single pass over the pre-image (Zcash ZIP-243).
+    std::optional<std::pair<uint32_t, Hash::StreamHasher>> preImagePrefix;
+
+    void clear() {
+        prevoutHash.reset();
+        sequenceHash.reset();
+        outputsHash.reset();
+        prefixHash.reset();
+        preImagePrefix.reset();
+    }
+
+    /// Returns the value of the given cache field, computing it first if needed.
+    /// If `cache` is null, always computes the value.
+    template <typename Compute>
+    static Data get(SigHashCache* cache, std::optional<Data> SigHashCache::*field, Compute&& compute) {
+        if (cache == nullptr) {
+            return compute();
+        }
+        auto& value = cache->*field;
+        if (!value.has_value()) {
+            value = compute();
+        }
+        return *value;
+    }
+};
+
+} // namespace TW::Bitcoin
@@ -11,6 +11,7 @@
 
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
+#include "../algorithm/parallel.h"
 #include "../Groestlcoin/Transaction.h"
 #include "../Zcash/Transaction.h"
 #include "../Zcash/TransactionBuilder.h"
@@ -29,18 +30,29 @@ Result<Transaction, Common::Proto::SigningError> SignatureBuilder<Transaction>::
 
     transactionToSign = _transaction;
     transactionToSign.inputs.clear();
+    sigHashCache.clear();
+    prepareKeys();
     std::copy(std::begin(_transaction.inputs), std::end(_transaction.inputs),
               std::back_inserter(transactionToSign.inputs));
 
-    const auto hashSingle = hashTypeIsSingle(input.hashType);
-    for (auto i = 0ul; i < plan.utxos.size(); i++) {
-        // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
-        if (hashSingle && i >= _transaction.outputs.size()) {
-            continue;
+    const auto count = std::min(plan.utxos.size(), _transaction.inputs.size());
+    // External signatures are consumed in signing order, size estimation is too cheap to be worth it
+    const auto parallel = input.signingThreads > 1 && count > 1 &&
+                          (signingMode == SigningMode_Normal || signingMode == SigningMode_HashOnly);
+    if (parallel) {
+        auto result = signParallel(count);
+        if (!result) {
+            return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
         }
-        auto& utxo = plan.utxos[i];
-        if (i < _transaction.inputs.size()) {
-            auto result = sign(utxo.script, i, utxo);
+    } else {
+        const auto hashSingle = hashTypeIsSingle(input.hashType);
+        for (auto i = 0ul; i < count; i++) {
+            // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
+            if (hashSingle && i >= _transaction.outputs.size()) {
+                continue;
+            }
+            auto& utxo = plan.utxos[i];
+            auto result = sign(utxo.script, i, utxo, hashesForSigning, transactionToSign.inputs[i]);
             if (!result) {
                 return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
             }
@@ -55,9 +67,46 @@ Result<Transaction, Common::Proto::SigningError> SignatureBuilder<Transaction>::
     return Result<Transaction, Common::Proto::SigningError>::success(std::move(transactionToSign));
 }
 
+template <typename Transaction>
+Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::signParallel(size_t count) {
+    // Compute the transaction-wide sighash parts up front, workers then only read the cache
+    transactionToSign.primeSigHashCache(sigHashCache, input.hashType);
+
+    // Workers write their own slots, and never the transaction being hashed
+    auto signedInputs = transactionToSign.inputs;
+    std::vector<HashPubkeyList> hashes(count);
+    std::vector<Common::Proto::SigningError> errors(count, Common::Proto::OK);
+
+    const auto hashSingle = hashTypeIsSingle(input.hashType);
+    parallelFor(count, input.signingThreads, [&](size_t i) {
+        // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
+        if (hashSingle && i >= _transaction.outputs.size()) {
+            return;
+        }
+        auto& utxo = plan.utxos[i];
+        auto result = sign(utxo.script, i, utxo, hashes[i], signedInputs[i]);
+        if (!result) {
+            errors[i] = result.error();
+        }
+    });
+
+    // Report the error of the first failing input, like sequential signing
+    for (auto i = 0ul; i < count; ++i) {
+        if (errors[i] != Common::Proto::OK) {
+            return Result<void, Common::Proto::SigningError>::failure(std::move(errors[i]));
+        }
+    }
+    for (auto& inputHashes : hashes) {
+        std::move(inputHashes.begin(), inputHashes.end(), std::back_inserter(hashesForSigning));
+    }
+    transactionToSign.inputs = std::move(signedInputs);
+    return Result<void, Common::Proto::SigningError>::success();
+}
+
 template <typename Transaction>
 Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::sign(Script script, size_t index,
-                                                                              const UTXO& utxo) {
+                                                                              const UTXO& utxo, HashPubkeyList& hashes,
+                                                                              TransactionInput& signedInput) {
     assert(index < _transaction.inputs.size());
 
     Script redeemScript;
@@ -69,7 +118,7 @@ Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::sign(Sc
         }
         return BASE;
     }();
-    auto result = signStep(script, index, utxo, signatureVersion);
+    auto result = signStep(script, index, utxo, signatureVersion, hashes);
     if (!result) {
         return Result<void, Common::Proto::SigningError>::failure(result.error());
     }
@@ -79,7 +128,7 @@ Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::sign(Sc
 
     if (script.isPayToScriptHash()) {
         script = Script(results[0]);
-        auto signStepResult = signStep(script, index, utxo, signatureVersion);
+        auto signStepResult = signStep(script, index, utxo, signatureVersion, hashes);
         if (!signStepResult) {
             return Result<void, Common::Proto::SigningError>::failure(signStepResult.error());
         }
@@ -89,18 +138,17 @@ Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::sign(Sc
     }
 
     std::vector<Data> witnessStack;
-    Data data;
-    if (script.matchPayToWitnessPublicKeyHash(data)) {
+    if (script.isPayToWitnessPublicKeyHash()) {
         auto witnessScript = Script::buildPayToPublicKeyHash(results[0]);
-        auto _result = signStep(witnessScript, index, utxo, WITNESS_V0);
+        auto _result = signStep(witnessScript, index, utxo, WITNESS_V0, hashes);
         if (!_result) {
             return Result<void, Common::Proto::SigningError>::failure(_result.error());
         }
         witnessStack = _result.payload();
         results.clear();
-    } else if (script.matchPayToWitnessScriptHash(data)) {
+    } else if (script.isPayToWitnessScriptHash()) {
         auto witnessScript = Script(results[0]);
-        auto _result = signStep(witnessScript, index, utxo, WITNESS_V0);
+        auto _result = signStep(witnessScript, index, utxo, WITNESS_V0, hashes);
         if (!_result) {
             return Result<void, Common::Proto::SigningError>::failure(_result.error());
         }
@@ -118,17 +166,15 @@ Result<void, Common::Proto::SigningError> SignatureBuilder<Transaction>::sign(Sc
 
     auto transactionInput = TransactionInput(txin.previousOutput, Script(pushAll(results)), txin.sequence);
     transactionInput.scriptWitness = witnessStack;
-    transactionToSign.inputs[index] = transactionInput;
+    signedInput = transactionInput;
     return Result<void, Common::Proto::SigningError>::success();
 }
 
 template <typename Transaction>
 Result<std::vector<Data>, Common::Proto::SigningError> SignatureBuilder<Transaction>::signStep(
-    Script script, size_t index, const UTXO& utxo, uint32_t version) {
+    Script script, size_t index, const UTXO& utxo, uint32_t version, HashPubkeyList& hashes) {
 
     Data data;
-    std::vector<Data> keys;
-    int required;
 
     if (script.matchPayToScriptHash(data)) {
         auto redeemScript = scriptForScriptHash(data);
@@ -154,26 +200,32 @@ Result<std::vector<Data>, Common::Proto::SigningError> SignatureBuilder<Transact
         // Error: Invalid output script
         return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_script_output);
     }
-    if (script.matchMultisig(keys, required)) {
+    std::optional<MultisigScript> bareMultisig;
+    const MultisigScript* multisig = nullptr;
+    if (const auto it = multisigScripts.find(script.bytes); it != multisigScripts.end()) {
+        multisig = &it->second;
+    } else if (bareMultisig = MultisigScript::match(script); bareMultisig.has_value()) {
+        multisig = &bareMultisig.value();
+    }
+    if (multisig != nullptr) {
+        // the first `required` keys sign, in script order
+        const auto required = static_cast<std::size_t>(multisig->required());
         auto results = std::vector<Data>{{}}; // workaround CHECKMULTISIG bug
-        for (auto& pubKey : keys) {
-            if (results.size() >= required + 1ul) {
-                break;
-            }
-            auto keyHash = Hash::ripemd(Hash::sha256(pubKey));
+        results.reserve(required + 1);
+        for (std::size_t i = 0; i < required; ++i) {
+            const auto& keyHash = multisig->keyHashes()[i];
             auto pair = keyPairForPubKeyHash(keyHash);
             if (!pair.has_value() && signingMode == SigningMode_Normal) {
                 // Error: missing key
                 return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
             }
-            auto signature = createSignature(transactionToSign, script, keyHash, pair, index, utxo.amount, version);
+            auto signature = createSignature(transactionToSign, script, keyHash, pair, index, utxo.amount, version, hashes);
             if (signature.empty()) {
                 // Error: Failed to sign
                 return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
             }
-            results.push_back(signature);
+            results.push_back(std::move(signature));
         }
-        results.resize(required + 1);
         return Result<std::vector<Data>, Common::Proto::SigningError>::success(std::move(results));
     }
     if (script.matchPayToPublicKey(data)) {
@@ -183,7 +235,7 @@ Result<std::vector<Data>, Common::Proto::SigningError> SignatureBuilder<Transact
             // Error: Missing key
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
         }
-        auto signature = createSignature(transactionToSign, script, keyHash, pair, index, utxo.amount, version);
+        auto signature = createSignature(transactionToSign, script, keyHash, pair, index, utxo.amount, version, hashes);
         if (signature.empty()) {
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
@@ -199,7 +251,7 @@ Result<std::vector<Data>, Common::Proto::SigningError> SignatureBuilder<Transact
                 // estimation mode, key is missing: use placeholder for public key
                 pubkey = Data(PublicKey::secp256k1Size);
             } else if (signingMode == SigningMode_External) {
-                size_t _index = hashesForSigning.size();
+                size_t _index = hashes.size();
                 if (!externalSignatures.has_value() || externalSignatures.value().size() <= _index) {
                     // Error: no or not enough signatures provided
                     return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
@@ -210,11 +262,11 @@ Result<std::vector<Data>, Common::Proto::SigningError> SignatureBuilder<Transact
                 return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
             }
         } else {
-            pubkey = std::get<1>(pair.value()).bytes;
+            pubkey = Data(std::get<1>(pair.value()).bytes);
         }
         assert(!pubkey.empty());
 
-        auto signature = createSignature(transactionToSign, script, data, pair, index, utxo.amount, version);
+        auto signature = createSignature(transactionToSign, script, data, pair, index, utxo.amount, version, hashes);
         if (signature.empty()) {
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
@@ -233,26 +285,28 @@ Data SignatureBuilder<Transaction>::createSignature(
     const std::optional<KeyPair>& pair,
     size_t index,
     Amount amount,
-    uint32_t version) {
+    uint32_t version,
+    HashPubkeyList& hashes) {
     if (signingMode == SigningMode_SizeEstimationOnly) {
         // Don't sign, only estimate signature size. It is 71-72 bytes.  Return placeholder.
         return Data(72);
     }
 
+    // Only scriptSig/witness of inputs change during signing, so the cached hashes stay valid.
     const Data sighash = transaction.getSignatureHash(script, index, input.hashType, amount,
-                                                      static_cast<SignatureVersion>(version));
+                                                      static_cast<SignatureVersion>(version), &sigHashCache);
 
     if (signingMode == SigningMode_HashOnly) {
         // Don't sign, only store hash-to-be-signed + pubkeyhash.  Return placeholder.
-        hashesForSigning.push_back(std::make_pair(sighash, publicKeyHash));
+        hashes.push_back(std::make_pair(sighash, publicKeyHash));
         return Data(72);
     }
 
     if (signingMode == SigningMode_External) {
         // Use externally-provided signature
         // Store hash, only for counting
-        size_t _index = hashesForSigning.size();
-        hashesForSigning.push_back(std::make_pair(sighash, publicKeyHash));
+        size_t _index = hashes.size();
+        hashes.push_back(std::make_pair(sighash, publicKeyHash));
 
         if (!externalSignatures.has_value() || externalSignatures.value().size() <= _index) {
             // Error: no or not enough signatures provided
@@ -313,15 +367,31 @@ Data SignatureBuilder<Transaction>::pushAll(const std::vector<Data>& results) {
 }
 
 template <typename Transaction>
-std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
-    for (auto& key : input.privateKeys) {
+void SignatureBuilder<Transaction>::prepareKeys() {
+    keyPairs.clear();
+    keyPairs.reserve(input.privateKeys.size() * 2);
+    for (const auto& key : input.privateKeys) {
         auto pubKeyExtended = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
         auto pubKey = pubKeyExtended.compressed();
-        if (Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKey);
+        auto hash = Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size());
+        keyPairs.emplace_back(std::move(hash), std::make_tuple(key, std::move(pubKey)));
+        auto extendedHash = Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size());
+        keyPairs.emplace_back(std::move(extendedHash), std::make_tuple(key, std::move(pubKeyExtended)));
+    }
+
+    multisigScripts.clear();
+    for (const auto& [hash, script] : input.scripts) {
+        if (auto multisig = MultisigScript::match(script); multisig.has_value()) {
+            multisigScripts.emplace(script.bytes, std::move(multisig.value()));
         }
-        if (Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKeyExtended);
+    }
+}
+
+template <typename Transaction>
+std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
+    for (const auto& [keyHash, pair] : keyPairs) {
+        if (keyHash == hash) {
+            return pair;
         }
     }
     return {};
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include "MultisigScript.h"
 #include "Script.h"
+#include "SigHashCache.h"
 #include "SigningInput.h"
 #include "Transaction.h"
 #include "TransactionInput.h"
@@ -17,6 +19,7 @@
 #include "../PublicKey.h"
 #include "../CoinEntry.h"
 
+#include <map>
 #include <utility>
 #include <vector>
 #include <optional>
@@ -56,13 +59,22 @@ private:
     /// For SigningMode_External, signatures are provided here
     std::optional<SignaturePubkeyList> externalSignatures;
 
+    /// Transaction-wide sighash parts, shared by all inputs during one `sign()` pass.
+    SigHashCache sigHashCache;
+
+    /// The private keys by HASH160 of their compressed and uncompressed public keys, derived once per `sign()` pass.
+    std::vector<std::pair<Data, KeyPair>> keyPairs;
+
+    /// The multisig redeem scripts of `input.scripts` by script bytes, parsed and hashed once per `sign()` pass.
+    std::map<Data, MultisigScript> multisigScripts;
+
 public:
     /// Initializes a transaction signer with signing input.
     /// estimationMode: is set, no real signing is performed, only as much as needed to get the almost-exact signed size 
     SignatureBuilder(
         SigningInput input,
         TransactionPlan plan,
-        Transaction& transaction,
+        const Transaction& transaction,
         SigningMode signingMode = SigningMode_Normal,
         std::optional<SignaturePubkeyList> externalSignatures = {}
     )
@@ -80,13 +92,22 @@ public:
     HashPubkeyList getHashesForSigning() const { return hashesForSigning; }
 
 private:
-    Result<void, Common::Proto::SigningError> sign(Script script, size_t index, const UTXO& utxo);
+    /// Signs input `index` into `signedInput`; in SigningMode_HashOnly and SigningMode_External the hashes are appended to `hashes`.
+    /// Only reads the shared state (except a non-primed `sigHashCache`), so distinct inputs can be signed concurrently.
+    Result<void, Common::Proto::SigningError> sign(Script script, size_t index, const UTXO& utxo,
+                                                   HashPubkeyList& hashes, TransactionInput& signedInput);
     Result<std::vector<Data>, Common::Proto::SigningError> signStep(Script script, size_t index,
-                                       const UTXO& utxo, uint32_t version);
+                                       const UTXO& utxo, uint32_t version, HashPubkeyList& hashes);
 
     Data createSignature(const Transaction& transaction, const Script& script,
                          const Data& publicKeyHash, const std::optional<KeyPair>& key,
-                         size_t index, Amount amount, uint32_t version);
+                         size_t index, Amount amount, uint32_t version, HashPubkeyList& hashes);
+
+    /// Signs the inputs on `input.signingThreads` threads, merging the collected hashes in input order.
+    Result<void, Common::Proto::SigningError> signParallel(size_t count);
+
+    /// Derives `keyPairs` and parses `multisigScripts`, before any input is signed.
+    void prepareKeys();
 
     /// Returns the private key for the given public key hash.
     std::optional<KeyPair> keyPairForPubKeyHash(const Data& hash) const;
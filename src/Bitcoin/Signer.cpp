@@ -15,25 +15,27 @@
 
 namespace TW::Bitcoin {
 
-Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) noexcept {
-    auto plan = TransactionSigner<Transaction, TransactionBuilder>::plan(input);
-    return plan.proto();
-}
+namespace {
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, std::optional<SignaturePubkeyList> optionalExternalSigs) noexcept {
+using BitcoinSigner = TransactionSigner<Transaction, TransactionBuilder>;
+
+/// `skipOutputs` is a mask of `Common::Proto::SigningOutputField` bits.
+Proto::SigningOutput signingOutput(const Result<Transaction, Common::Proto::SigningError>& result, uint32_t skipOutputs) {
     Proto::SigningOutput output;
-    auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input, false, optionalExternalSigs);
     if (!result) {
         output.set_error(result.error());
         return output;
     }
 
     const auto& tx = result.payload();
-    *output.mutable_transaction() = tx.proto();
-
     Data encoded;
     tx.encode(encoded);
     output.set_encoded(encoded.data(), encoded.size());
+    if ((skipOutputs & Common::Proto::OutputField_transaction_details) != 0) {
+        return output;
+    }
+
+    *output.mutable_transaction() = tx.proto();
 
     Data txHashData = encoded;
     if (tx.hasWitness()) {
@@ -46,18 +48,16 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, std::optiona
     return output;
 }
 
-Proto::PreSigningOutput Signer::preImageHashes(const Proto::SigningInput& input) noexcept {
+Proto::PreSigningOutput preSigningOutput(const Result<HashPubkeyList, Common::Proto::SigningError>& result) {
     Proto::PreSigningOutput output;
-    auto result = TransactionSigner<Transaction, TransactionBuilder>::preImageHashes(input);
     if (!result) {
         output.set_error(result.error());
         output.set_error_message(Common::Proto::SigningError_Name(result.error()));
         return output;
     }
 
-    auto hashList = result.payload();
     auto* hashPubKeys = output.mutable_hash_public_keys();
-    for (auto& h : hashList) {
+    for (auto& h : result.payload()) {
         auto* hpk = hashPubKeys->Add();
         hpk->set_data_hash(h.first.data(), h.first.size());
         hpk->set_public_key_hash(h.second.data(), h.second.size());
@@ -65,4 +65,127 @@ Proto::PreSigningOutput Signer::preImageHashes(const Proto::SigningInput& input)
     return output;
 }
 
+/// Pairs the external signatures with their public keys, or sets the error of `output`.
+std::optional<SignaturePubkeyList> externalSignatures(const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Proto::SigningOutput& output) {
+    if (signatures.empty() || publicKeys.empty()) {
+        output.set_error(Common::Proto::Error_invalid_params);
+        output.set_error_message("empty signatures or publickeys");
+        return std::nullopt;
+    }
+    if (signatures.size() != publicKeys.size()) {
+        output.set_error(Common::Proto::Error_invalid_params);
+        output.set_error_message("signatures size and publickeys size not equal");
+        return std::nullopt;
+    }
+    SignaturePubkeyList list;
+    list.reserve(signatures.size());
+    for (std::size_t i = 0; i < signatures.size(); ++i) {
+        list.emplace_back(signatures[i], publicKeys[i].bytes);
+    }
+    return list;
+}
+
+/// Keeps the parsed input and the planned, built transaction.
+/// Produces the same outputs as `Entry::preImageHashes` and `Entry::compile` of the serialized input.
+class SignerCompileContext final : public CompileContext {
+public:
+    explicit SignerCompileContext(const Data& txInputData) {
+        Proto::SigningInput proto;
+        if (!proto.ParseFromArray(txInputData.data(), static_cast<int>(txInputData.size()))) {
+            failure = {Common::Proto::Error_input_parse, "failed to parse input data"};
+            return;
+        }
+        try {
+            input.emplace(proto);
+            auto result = BitcoinSigner::prepare(*input);
+            if (!result) {
+                prepareError = result.error();
+                return;
+            }
+            prepared.emplace(std::move(result.payload()));
+        } catch (const std::exception& e) {
+            failure = {Common::Proto::Error_internal, e.what()};
+        }
+    }
+
+    Data preImageHashes() override {
+        Proto::PreSigningOutput output;
+        if (!setFailure(output)) {
+            try {
+                output = prepared.has_value()
+                    ? preSigningOutput(BitcoinSigner::preImageHashes(*input, *prepared))
+                    : preSigningOutput(Result<HashPubkeyList, Common::Proto::SigningError>::failure(prepareError));
+            } catch (const std::exception& e) {
+                output.set_error(Common::Proto::Error_internal);
+                output.set_error_message(e.what());
+            }
+        }
+        Data dataOut;
+        appendSerialized(output, dataOut);
+        return dataOut;
+    }
+
+    void compile(const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& dataOut) override {
+        Proto::SigningOutput output;
+        if (!setFailure(output)) {
+            try {
+                if (auto external = externalSignatures(signatures, publicKeys, output); external.has_value()) {
+                    output = prepared.has_value()
+                        ? signingOutput(BitcoinSigner::sign(*input, *prepared, SigningMode_External, std::move(external)), input->skipOutputs)
+                        : signingOutput(Result<Transaction, Common::Proto::SigningError>::failure(prepareError), 0);
+                }
+            } catch (const std::exception& e) {
+                output.set_error(Common::Proto::Error_internal);
+                output.set_error_message(e.what());
+            }
+        }
+        dataOut.clear();
+        appendSerialized(output, dataOut);
+    }
+
+private:
+    /// Sets the parse or internal error of the input, if any.
+    template <typename Output>
+    bool setFailure(Output& output) const {
+        if (!failure.has_value()) {
+            return false;
+        }
+        output.set_error(failure->first);
+        output.set_error_message(failure->second);
+        return true;
+    }
+
+    std::optional<std::pair<Common::Proto::SigningError, std::string>> failure;
+    std::optional<SigningInput> input;
+    std::optional<BitcoinSigner::Prepared> prepared;
+    Common::Proto::SigningError prepareError = Common::Proto::OK;
+};
+
+} // namespace
+
+Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) noexcept {
+    auto plan = BitcoinSigner::plan(input);
+    return plan.proto();
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, std::optional<SignaturePubkeyList> optionalExternalSigs) noexcept {
+    return signingOutput(BitcoinSigner::sign(input, false, optionalExternalSigs), input.skip_outputs());
+}
+
+Proto::PreSigningOutput Signer::preImageHashes(const Proto::SigningInput& input) noexcept {
+    return preSigningOutput(BitcoinSigner::preImageHashes(input));
+}
+
+Proto::SigningOutput Signer::compile(const Proto::SigningInput& input, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys) noexcept {
+    Proto::SigningOutput output;
+    if (auto external = externalSignatures(signatures, publicKeys, output); external.has_value()) {
+        output = sign(input, std::move(external));
+    }
+    return output;
+}
+
+std::unique_ptr<CompileContext> Signer::compileContext(const Data& txInputData) {
+    return std::make_unique<SignerCompileContext>(txInputData);
+}
+
 } // namespace TW::Bitcoin
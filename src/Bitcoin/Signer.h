@@ -9,6 +9,7 @@
 #include "Data.h"
 #include "CoinEntry.h"
 
+#include <memory>
 #include <vector>
 #include <optional>
 #include <utility>
@@ -29,6 +30,13 @@ class Signer {
 
     /// Collect pre-image hashes to be signed
     static Proto::PreSigningOutput preImageHashes(const Proto::SigningInput& input) noexcept;
+
+    /// Signs with external signatures of the pre-image hashes and their public keys, in the same order
+    static Proto::SigningOutput compile(const Proto::SigningInput& input, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys) noexcept;
+
+    /// Parses, plans and builds the transaction of a serialized Proto::SigningInput once, for its pre-image hashes
+    /// followed by its compilation
+    static std::unique_ptr<CompileContext> compileContext(const Data& txInputData);
 };
 
 } // namespace TW::Bitcoin
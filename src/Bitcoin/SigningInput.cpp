@@ -30,6 +30,18 @@ SigningInput::SigningInput(const Proto::SigningInput& input) {
     }
     outputOpReturn = data(input.output_op_return());
     lockTime = input.lock_time();
+    coinSelection = input.coin_selection();
+    coinSelectionMaxIterations = input.coin_selection_max_iterations();
+    signingThreads = input.signing_threads();
+    skipOutputs = input.skip_outputs();
+}
+
+const Script& SigningInput::lockScript(const std::string& address, TWCoinType coin) const {
+    auto key = std::make_pair(coin, address);
+    if (auto it = lockScripts.find(key); it != lockScripts.end()) {
+        return it->second;
+    }
+    return lockScripts.emplace(std::move(key), Script::lockScriptForAddress(address, coin)).first->second;
 }
 
 } // namespace TW::Bitcoin
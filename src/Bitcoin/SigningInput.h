@@ -16,6 +16,7 @@
 #include <vector>
 #include <map>
 #include <optional>
+#include <utility>
 
 namespace TW::Bitcoin {
 
@@ -61,10 +62,33 @@ public:
 
     uint32_t lockTime = 0;
 
+    // Coin selection algorithm used when planning
+    Proto::CoinSelection coinSelection = Proto::Automatic;
+
+    // Search step limit of branch and bound coin selection, 0 for the default
+    uint32_t coinSelectionMaxIterations = 0;
+
+    // Number of threads signing inputs concurrently, 0 or 1 for sequential signing
+    std::size_t signingThreads = 1;
+
+    // Mask of `Common::Proto::SigningOutputField` outputs not to produce
+    uint32_t skipOutputs = 0;
+
 public:
     SigningInput() = default;
 
     SigningInput(const Proto::SigningInput& input);
+
+    /// Returns the locking script of `address` for `coin`, see `Script::lockScriptForAddress`.
+    /// Each distinct address is decoded once per input, and copies made while planning keep the resolved scripts.
+    /// Not thread-safe.
+    const Script& lockScript(const std::string& address, TWCoinType coin) const;
+
+    /// Returns the locking script of `address` for `coinType`.
+    const Script& lockScript(const std::string& address) const { return lockScript(address, coinType); }
+
+private:
+    mutable std::map<std::pair<TWCoinType, std::string>, Script> lockScripts;
 };
 
 } // namespace TW::Bitcoin
@@ -0,0 +1,192 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SizeEstimator.h"
+#include "OpCodes.h"
+
+#include "../BinaryCoding.h"
+#include "../HexCoding.h"
+#include "../PublicKey.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace TW::Bitcoin {
+
+/// Size of a script pushing items of the given sizes, see `SignatureBuilder::pushAll`.
+static std::size_t pushAllSize(const std::vector<std::size_t>& items) {
+    std::size_t size = 0;
+    for (const auto item : items) {
+        if (item == 0) {
+            size += 1; // OP_0
+        } else if (item < OP_PUSHDATA1) {
+            size += 1 + item;
+        } else if (item <= 0xff) {
+            size += 2 + item;
+        } else if (item <= 0xffff) {
+            size += 3 + item;
+        } else {
+            size += 5 + item;
+        }
+    }
+    return size;
+}
+
+/// Size of a witness stack with items of the given sizes, see `TransactionInput::encodeWitness`.
+static std::size_t witnessStackSize(const std::vector<std::size_t>& items) {
+    std::size_t size = varIntSize(items.size());
+    for (const auto item : items) {
+        size += varIntSize(item) + item;
+    }
+    return size;
+}
+
+/// Out-point, scriptSig length and sequence.
+static std::size_t inputBaseSize(std::size_t scriptSigSize) {
+    return 32 + 4 + varIntSize(scriptSigSize) + scriptSigSize + 4;
+}
+
+SizeEstimator::SizeEstimator(std::map<std::string, Script> scripts, std::set<Data> uncompressedKeyHashes)
+    : scripts(std::move(scripts)), uncompressedKeyHashes(std::move(uncompressedKeyHashes)) {}
+
+std::optional<InputSize> SizeEstimator::input(const Script& lockingScript) const {
+    const auto script = lockingScript.view();
+    if (const auto scriptHash = script.matchPayToScriptHash(); scriptHash.has_value()) {
+        const auto* redeemScript = scriptForScriptHash(*scriptHash);
+        if (redeemScript == nullptr) {
+            return std::nullopt;
+        }
+        const auto scriptSigSize = pushAllSize({redeemScript->bytes.size()});
+        const auto redeem = redeemScript->view();
+        if (const auto keyHash = redeem.matchPayToWitnessPublicKeyHash(); keyHash.has_value()) {
+            return InputSize{inputBaseSize(scriptSigSize), witnessStackSize({signatureSize, publicKeySize(*keyHash)})};
+        }
+        if (const auto witnessHash = redeem.matchPayToWitnessScriptHash(); witnessHash.has_value()) {
+            const auto witnessItems = witnessScriptItems(*witnessHash);
+            if (!witnessItems.has_value()) {
+                return std::nullopt;
+            }
+            return InputSize{inputBaseSize(scriptSigSize), witnessStackSize(*witnessItems)};
+        }
+        // non-witness P2SH is not supported
+        return std::nullopt;
+    }
+    if (const auto witnessHash = script.matchPayToWitnessScriptHash(); witnessHash.has_value()) {
+        const auto witnessItems = witnessScriptItems(*witnessHash);
+        if (!witnessItems.has_value()) {
+            return std::nullopt;
+        }
+        return InputSize{inputBaseSize(0), witnessStackSize(*witnessItems)};
+    }
+    if (const auto keyHash = script.matchPayToWitnessPublicKeyHash(); keyHash.has_value()) {
+        return InputSize{inputBaseSize(0), witnessStackSize({signatureSize, publicKeySize(*keyHash)})};
+    }
+    if (script.isPayToTaproot()) {
+        // key path spend, default sighash type
+        return InputSize{inputBaseSize(0), witnessStackSize({schnorrSignatureSize})};
+    }
+    if (script.isWitnessProgram()) {
+        return std::nullopt;
+    }
+    const auto items = signatureItems(script);
+    if (!items.has_value()) {
+        return std::nullopt;
+    }
+    return InputSize{inputBaseSize(pushAllSize(*items)), 0};
+}
+
+std::size_t SizeEstimator::output(const Script& lockingScript) {
+    return 8 + varIntSize(lockingScript.bytes.size()) + lockingScript.bytes.size();
+}
+
+TransactionSize SizeEstimator::transaction(const std::vector<InputSize>& inputs, const std::vector<std::size_t>& outputs) {
+    TransactionSize size;
+    // version, counts, lock time
+    size.base = 4 + varIntSize(inputs.size()) + varIntSize(outputs.size()) + 4;
+    bool hasWitness = false;
+    for (const auto& input : inputs) {
+        size.base += input.base;
+        size.witness += input.witness > 0 ? input.witness : 1;
+        hasWitness = hasWitness || input.witness > 0;
+    }
+    size.base = std::accumulate(outputs.begin(), outputs.end(), size.base);
+    // marker and flag
+    size.witness = hasWitness ? 2 + size.witness : 0;
+    return size;
+}
+
+std::optional<TransactionSize> SizeEstimator::transaction(const std::vector<UTXO>& utxos, const std::vector<Script>& outputScripts) const {
+    std::vector<InputSize> inputs;
+    inputs.reserve(utxos.size());
+    for (const auto& utxo : utxos) {
+        const auto size = input(utxo.script);
+        if (!size.has_value()) {
+            return std::nullopt;
+        }
+        inputs.push_back(*size);
+    }
+    std::vector<std::size_t> outputs;
+    outputs.reserve(outputScripts.size());
+    for (const auto& script : outputScripts) {
+        outputs.push_back(output(script));
+    }
+    return transaction(inputs, outputs);
+}
+
+std::optional<std::vector<std::size_t>> SizeEstimator::signatureItems(ScriptView script) const {
+    if (const auto multisig = script.matchMultisig(); multisig.has_value()) {
+        // leading empty item for the CHECKMULTISIG bug
+        std::vector<std::size_t> items(1 + multisig->required, signatureSize);
+        items[0] = 0;
+        return items;
+    }
+    if (script.matchPayToPublicKey().has_value()) {
+        return std::vector<std::size_t>{signatureSize};
+    }
+    if (const auto keyHash = script.matchPayToPublicKeyHash(); keyHash.has_value()) {
+        return std::vector<std::size_t>{signatureSize, publicKeySize(*keyHash)};
+    }
+    return std::nullopt;
+}
+
+std::optional<std::vector<std::size_t>> SizeEstimator::witnessScriptItems(ScriptView::Bytes witnessScriptHash) const {
+    const auto* witnessScript = scriptForScriptHash(Hash::ripemd(witnessScriptHash));
+    if (witnessScript == nullptr) {
+        return std::nullopt;
+    }
+    auto items = signatureItems(witnessScript->view());
+    if (!items.has_value()) {
+        return std::nullopt;
+    }
+    items->push_back(witnessScript->bytes.size());
+    return items;
+}
+
+std::size_t SizeEstimator::publicKeySize(ScriptView::Bytes keyHash) const {
+    const auto uncompressed = std::any_of(uncompressedKeyHashes.begin(), uncompressedKeyHashes.end(),
+                                          [keyHash](const Data& hash) { return std::ranges::equal(hash, keyHash); });
+    return uncompressed ? PublicKey::secp256k1ExtendedSize : PublicKey::secp256k1Size;
+}
+
+const Script* SizeEstimator::scriptForScriptHash(ScriptView::Bytes hash) const {
+    const auto it = scripts.find(hex(hash));
+    return it == scripts.end() ? nullptr : &it->second;
+}
+
+int64_t ScriptFeeCalculator::calculate(int64_t inputs, int64_t outputs, int64_t byteFee) const noexcept {
+    const auto in = static_cast<std::size_t>(inputs);
+    const auto out = static_cast<std::size_t>(outputs);
+    TransactionSize size;
+    size.base = 4 + varIntSize(in) + varIntSize(out) + 4 + in * inputSize.base + out * outputSize;
+    size.witness = inputSize.witness > 0 && in > 0 ? 2 + in * inputSize.witness : 0;
+    return static_cast<int64_t>(size.virtualSize()) * byteFee;
+}
+
+int64_t ScriptFeeCalculator::calculateSingleInput(int64_t byteFee) const noexcept {
+    return static_cast<int64_t>(inputSize.base + (inputSize.witness + 3) / 4) * byteFee;
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,101 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "FeeCalculator.h"
+#include "Script.h"
+#include "ScriptView.h"
+#include "UTXO.h"
+#include "../Data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Serialized size of one transaction input.
+struct InputSize {
+    /// Non-witness part: out-point, scriptSig and sequence.
+    std::size_t base = 0;
+    /// Witness stack, 0 for inputs without witness.
+    std::size_t witness = 0;
+
+    bool operator==(const InputSize& other) const { return base == other.base && witness == other.witness; }
+};
+
+/// Serialized size of a transaction.
+struct TransactionSize {
+    /// Size without witness data.
+    std::size_t base = 0;
+    /// Size of the witness data, including the segwit marker and flag; 0 if no input has a witness.
+    std::size_t witness = 0;
+
+    std::size_t weight() const { return 4 * base + witness; }
+    /// Virtual size, in vbytes.
+    std::size_t virtualSize() const { return base + (witness + 3) / 4; }
+};
+
+/// Computes the serialized size of Bitcoin transactions from the types of their scripts, without building
+/// or signing them: P2PK, P2PKH, bare multisig, P2WPKH, P2WSH, P2SH-P2WPKH, P2SH-P2WSH and P2TR (key path).
+/// Sizes are those of `SigningMode_SizeEstimationOnly`: 72-byte signatures (64 for Schnorr),
+/// compressed public keys unless declared uncompressed.
+class SizeEstimator {
+public:
+    static constexpr std::size_t signatureSize = 72;
+    static constexpr std::size_t schnorrSignatureSize = 64;
+
+    /// `scripts` are the redeem and witness scripts indexed by hex script hash, like `SigningInput::scripts`;
+    /// `uncompressedKeyHashes` are the hashes of public keys used in their extended form.
+    explicit SizeEstimator(std::map<std::string, Script> scripts = {}, std::set<Data> uncompressedKeyHashes = {});
+
+    /// Size of an input spending an output with the given locking script, or nullopt if the script type is
+    /// not supported or a needed redeem script is missing.
+    std::optional<InputSize> input(const Script& lockingScript) const;
+
+    /// Size of an output with the given locking script.
+    static std::size_t output(const Script& lockingScript);
+
+    /// Size of a transaction with the given inputs sizes and outputs sizes.
+    static TransactionSize transaction(const std::vector<InputSize>& inputs, const std::vector<std::size_t>& outputs);
+
+    /// Size of a transaction spending `utxos` to outputs with the given locking scripts,
+    /// or nullopt if one of the inputs is not supported.
+    std::optional<TransactionSize> transaction(const std::vector<UTXO>& utxos, const std::vector<Script>& outputScripts) const;
+
+private:
+    /// Sizes of the items needed to satisfy a script requiring signatures (P2PK, P2PKH, multisig).
+    std::optional<std::vector<std::size_t>> signatureItems(ScriptView script) const;
+
+    /// Sizes of the witness stack items spending a P2WSH output, the witness script last.
+    std::optional<std::vector<std::size_t>> witnessScriptItems(ScriptView::Bytes witnessScriptHash) const;
+
+    std::size_t publicKeySize(ScriptView::Bytes keyHash) const;
+    const Script* scriptForScriptHash(ScriptView::Bytes hash) const;
+
+    std::map<std::string, Script> scripts;
+    std::set<Data> uncompressedKeyHashes;
+};
+
+/// Fee calculator with the exact sizes of a single input type and a single output type, see `SizeEstimator`.
+class ScriptFeeCalculator : public FeeCalculator {
+public:
+    const InputSize inputSize;
+    const std::size_t outputSize;
+
+    ScriptFeeCalculator(InputSize inputSize, std::size_t outputSize) noexcept
+        : inputSize(inputSize), outputSize(outputSize) {}
+
+    [[nodiscard]] int64_t calculate(int64_t inputs, int64_t outputs, int64_t byteFee) const noexcept override;
+    [[nodiscard]] int64_t calculateSingleInput(int64_t byteFee) const noexcept override;
+};
+
+} // namespace TW::Bitcoin
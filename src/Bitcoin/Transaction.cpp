@@ -11,34 +11,43 @@
 
 #include "../BinaryCoding.h"
 
+#include <array>
 #include <cassert>
 
 namespace TW::Bitcoin {
 
 Data Transaction::getPreImage(const Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType, uint64_t amount) const {
-    assert(index < inputs.size());
-
+                              enum TWBitcoinSigHashType hashType, uint64_t amount,
+                              SigHashCache* cache) const {
     Data data;
+    data.reserve(preImageSize(scriptCode));
+    encodePreImage(scriptCode, index, hashType, amount, cache, data);
+    return data;
+}
+
+void Transaction::encodePreImage(const Script& scriptCode, size_t index,
+                                 enum TWBitcoinSigHashType hashType, uint64_t amount,
+                                 SigHashCache* cache, Data& data) const {
+    assert(index < inputs.size());
 
     // Version
     encode32LE(_version, data);
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
-        std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
+        const auto& hashPrevouts = SigHashCache::get(cache, &SigHashCache::prevoutHash, [this] { return getPrevoutHash(); });
+        data.insert(data.end(), hashPrevouts.begin(), hashPrevouts.end());
     } else {
-        std::fill_n(back_inserter(data), 32, 0);
+        data.insert(data.end(), 32, 0);
     }
 
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 && !hashTypeIsSingle(hashType) &&
         !hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
-        std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
+        const auto& hashSequence = SigHashCache::get(cache, &SigHashCache::sequenceHash, [this] { return getSequenceHash(); });
+        data.insert(data.end(), hashSequence.begin(), hashSequence.end());
     } else {
-        std::fill_n(back_inserter(data), 32, 0);
+        data.insert(data.end(), 32, 0);
     }
 
     // The input being signed (replacing the scriptSig with scriptCode + amount)
@@ -52,15 +61,16 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Outputs (none/one/all, depending on flags)
     if (!hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
-        copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
+        const auto& hashOutputs = SigHashCache::get(cache, &SigHashCache::outputsHash, [this] { return getOutputsHash(); });
+        data.insert(data.end(), hashOutputs.begin(), hashOutputs.end());
     } else if (hashTypeIsSingle(hashType) && index < outputs.size()) {
         Data outputData;
+        outputData.reserve(outputs[index].serializedSize());
         outputs[index].encode(outputData);
-        auto hashOutputs = Hash::hash(hasher, outputData);
-        copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
+        const auto hashOutputs = Hash::hash(hasher, outputData);
+        data.insert(data.end(), hashOutputs.begin(), hashOutputs.end());
     } else {
-        fill_n(back_inserter(data), 32, 0);
+        data.insert(data.end(), 32, 0);
     }
 
     // Locktime
@@ -68,36 +78,68 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Sighash type
     encode32LE(hashType, data);
-
-    return data;
 }
 
 Data Transaction::getPrevoutHash() const {
+    auto hashStream = Hash::StreamHasher(hasher);
     Data data;
     for (auto& input : inputs) {
         auto& outpoint = reinterpret_cast<const OutPoint&>(input.previousOutput);
+        data.clear();
         outpoint.encode(data);
+        hashStream.update(data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashStream.finalize();
 }
 
 Data Transaction::getSequenceHash() const {
+    auto hashStream = Hash::StreamHasher(hasher);
     Data data;
     for (auto& input : inputs) {
+        data.clear();
         encode32LE(input.sequence, data);
+        hashStream.update(data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashStream.finalize();
 }
 
 Data Transaction::getOutputsHash() const {
+    auto hashStream = Hash::StreamHasher(hasher);
     Data data;
     for (auto& output : outputs) {
+        data.clear();
         output.encode(data);
+        hashStream.update(data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashStream.finalize();
+}
+
+void Transaction::primeSigHashCache(SigHashCache& cache, [[maybe_unused]] enum TWBitcoinSigHashType hashType) const {
+    if (hasher != Hash::HasherSha256d) {
+        cache.prevoutHash = getPrevoutHash();
+        cache.sequenceHash = getSequenceHash();
+        cache.outputsHash = getOutputsHash();
+        return;
+    }
+
+    // the three parts are serialized, then hashed as a batch
+    std::array<Data, 3> parts;
+    parts[0].reserve(inputs.size() * OutPoint::serializedSize());
+    parts[1].reserve(inputs.size() * 4);
+    for (const auto& input : inputs) {
+        reinterpret_cast<const OutPoint&>(input.previousOutput).encode(parts[0]);
+        encode32LE(input.sequence, parts[1]);
+    }
+    for (const auto& output : outputs) {
+        output.encode(parts[2]);
+    }
+    const std::array<const byte*, 3> pointers = {parts[0].data(), parts[1].data(), parts[2].data()};
+    const std::array<size_t, 3> sizes = {parts[0].size(), parts[1].size(), parts[2].size()};
+    std::array<byte, 3 * 32> digests;
+    Hash::sha256dBatchInto(pointers.data(), sizes.data(), parts.size(), digests.data());
+    cache.prevoutHash = Data(digests.begin(), digests.begin() + 32);
+    cache.sequenceHash = Data(digests.begin() + 32, digests.begin() + 64);
+    cache.outputsHash = Data(digests.begin() + 64, digests.end());
 }
 
 void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
@@ -114,6 +156,8 @@ void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
         break;
     }
 
+    data.reserve(data.size() + serializedSize(useWitnessFormat ? Segwit : NonSegwit));
+
     encode32LE(_version, data);
 
     if (useWitnessFormat) {
@@ -147,25 +191,53 @@ void Transaction::encodeWitness(Data& data) const {
     }
 }
 
+std::size_t Transaction::serializedSize(enum SegwitFormatMode segwitFormat) const {
+    const auto useWitnessFormat = segwitFormat == Segwit || (segwitFormat == IfHasWitness && hasWitness());
+
+    // version, lock time
+    std::size_t size = 4 + 4;
+    size += varIntSize(inputs.size());
+    for (const auto& input : inputs) {
+        size += input.serializedSize();
+    }
+    size += varIntSize(outputs.size());
+    for (const auto& output : outputs) {
+        size += output.serializedSize();
+    }
+    if (useWitnessFormat) {
+        // marker, flag
+        size += 2 + witnessSize();
+    }
+    return size;
+}
+
+std::size_t Transaction::witnessSize() const {
+    std::size_t size = 0;
+    for (const auto& input : inputs) {
+        size += input.witnessSize();
+    }
+    return size;
+}
+
 bool Transaction::hasWitness() const {
     return std::any_of(inputs.begin(), inputs.end(), [](auto& input) { return !input.scriptWitness.empty(); });
 }
 
 Data Transaction::getSignatureHash(const Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   enum SignatureVersion version) const {
+                                   enum SignatureVersion version, SigHashCache* cache) const {
     if (version == BASE) {
         return getSignatureHashBase(scriptCode, index, hashType);
     }
     // version == WITNESS_V0
-    return getSignatureHashWitnessV0(scriptCode, index, hashType, amount);
+    return getSignatureHashWitnessV0(scriptCode, index, hashType, amount, cache);
 }
 
 /// Generates the signature hash for Witness version 0 scripts.
 Data Transaction::getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
                                             enum TWBitcoinSigHashType hashType,
-                                            uint64_t amount) const {
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
+                                            uint64_t amount, SigHashCache* cache) const {
+    auto preimage = getPreImage(scriptCode, index, hashType, amount, cache);
     auto hash = Hash::hash(hasher, preimage);
     return hash;
 }
@@ -175,20 +247,29 @@ Data Transaction::getSignatureHashBase(const Script& scriptCode, size_t index,
                                        enum TWBitcoinSigHashType hashType) const {
     assert(index < inputs.size());
 
+    auto serializedInputCount =
+        (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0 ? 1 : inputs.size();
+    auto hashNone = hashTypeIsNone(hashType);
+    auto hashSingle = hashTypeIsSingle(hashType);
+    auto serializedOutputCount = hashNone ? 0 : (hashSingle ? index + 1 : outputs.size());
+
+    // other inputs and blanked outputs have an empty script; one byte over for the signed input
+    std::size_t size = 4 + varIntSize(serializedInputCount) + varIntSize(serializedOutputCount) + 4 + 4;
+    size += serializedInputCount * (OutPoint::serializedSize() + 1 + 4) + scriptCode.serializedSize();
+    for (auto subindex = 0ul; subindex < serializedOutputCount; subindex += 1) {
+        size += hashSingle && subindex != index ? 8 + 1 : outputs[subindex].serializedSize();
+    }
+
     Data data;
+    data.reserve(size);
 
     encode32LE(_version, data);
 
-    auto serializedInputCount =
-        (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0 ? 1 : inputs.size();
     encodeVarInt(serializedInputCount, data);
     for (auto subindex = 0ul; subindex < serializedInputCount; subindex += 1) {
         serializeInput(subindex, scriptCode, index, hashType, data);
     }
 
-    auto hashNone = hashTypeIsNone(hashType);
-    auto hashSingle = hashTypeIsSingle(hashType);
-    auto serializedOutputCount = hashNone ? 0 : (hashSingle ? index + 1 : outputs.size());
     encodeVarInt(serializedOutputCount, data);
     for (auto subindex = 0ul; subindex < serializedOutputCount; subindex += 1) {
         if (hashSingle && subindex != index) {
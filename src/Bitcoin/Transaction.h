@@ -8,6 +8,7 @@
 
 #include <TrustWalletCore/TWBitcoinSigHashType.h>
 #include "Script.h"
+#include "SigHashCache.h"
 #include "TransactionInput.h"
 #include "TransactionOutput.h"
 #include "TransactionPlan.h"
@@ -68,18 +69,30 @@ public:
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
-    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+    /// If `cache` is provided, the transaction-wide hashes are reused across calls.
+    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     SigHashCache* cache = nullptr) const;
+
+    /// Appends the signature pre-image to the provided buffer, see `getPreImage`.
+    void encodePreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount,
+                        SigHashCache* cache, Data& data) const;
+
+    /// Size of the signature pre-image, see `getPreImage`.
+    static std::size_t preImageSize(const Script& scriptCode) { return 4 + 32 + 32 + OutPoint::serializedSize() + scriptCode.serializedSize() + 8 + 4 + 32 + 4 + 4; }
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the transaction-wide sighash parts into `cache` up front, inputs can then be hashed concurrently.
+    void primeSigHashCache(SigHashCache& cache, enum TWBitcoinSigHashType hashType) const;
+
     enum SegwitFormatMode {
         NonSegwit,
         IfHasWitness,
         Segwit
     };
 
-    /// Encodes the transaction into the provided buffer.
+    /// Encodes the transaction into the provided buffer, reserving the needed space once.
     void encode(Data& data, enum SegwitFormatMode segwitFormat) const;
 
     /// Default one-parameter version, needed for templated usage.
@@ -88,11 +101,18 @@ public:
     /// Encodes the witness part of the transaction into the provided buffer.
     void encodeWitness(Data& data) const;
 
+    /// Size of the encoded transaction, see `encode`.
+    std::size_t serializedSize(enum SegwitFormatMode segwitFormat) const;
+
+    /// Size of the encoded witness part, see `encodeWitness`.
+    std::size_t witnessSize() const;
+
     bool hasWitness() const;
 
     /// Generates the signature hash for this transaction.
+    /// If `cache` is provided, the transaction-wide hashes are reused across calls.
     Data getSignatureHash(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                          uint64_t amount, enum SignatureVersion version) const;
+                          uint64_t amount, enum SignatureVersion version, SigHashCache* cache = nullptr) const;
 
     void serializeInput(size_t subindex, const Script&, size_t index, enum TWBitcoinSigHashType hashType, Data& data) const;
 
@@ -102,7 +122,8 @@ public:
 private:
     /// Generates the signature hash for Witness version 0 scripts.
     Data getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
-                                   enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                                   enum TWBitcoinSigHashType hashType, uint64_t amount,
+                                   SigHashCache* cache) const;
 
     /// Generates the signature hash for for scripts other than witness scripts.
     Data getSignatureHashBase(const Script& scriptCode, size_t index,
@@ -6,13 +6,18 @@
 
 #include "TransactionBuilder.h"
 #include "Script.h"
+#include "SigHashType.h"
+#include "SizeEstimator.h"
 #include "TransactionSigner.h"
 #include "SignatureBuilder.h"
 
 #include "../Coin.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <optional>
+#include <set>
 
 namespace TW::Bitcoin {
 
@@ -36,14 +41,92 @@ int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, const TransactionP
     return feeCalculator.calculate(plan.utxos.size(), outputSize, byteFee);
 }
 
-/// Estimate encoded size by invoking sign(sizeOnly), get actual size
-int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const SigningInput& input) {
+SizeEstimator TransactionBuilder::sizeEstimator(const SigningInput& input) {
+    std::set<Data> uncompressedKeyHashes;
+    for (const auto& key : input.privateKeys) {
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+        uncompressedKeyHashes.insert(Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size()));
+    }
+    return SizeEstimator(input.scripts, std::move(uncompressedKeyHashes));
+}
+
+/// Size estimator of a signing input, built on first use: it derives the public key of every private key,
+/// which only the script based estimates need
+class LazySizeEstimator {
+public:
+    explicit LazySizeEstimator(const SigningInput& input) : input(input) {}
+
+    const SizeEstimator& get() {
+        if (!estimator.has_value()) {
+            estimator.emplace(TransactionBuilder::sizeEstimator(input));
+        }
+        return *estimator;
+    }
+
+private:
+    const SigningInput& input;
+    std::optional<SizeEstimator> estimator;
+};
+
+/// Estimate virtual size from the script types of inputs and outputs, without building and signing; nullopt if not possible
+std::optional<int64_t> estimateScriptVirtualSize(LazySizeEstimator& sizeEstimator, const TransactionPlan& plan, const SigningInput& input) {
+    std::vector<Script> outputScripts{input.lockScript(input.toAddress)};
+    if (plan.change > 0) {
+        outputScripts.push_back(input.lockScript(input.changeAddress));
+    }
+    if (!plan.outputOpReturn.empty()) {
+        outputScripts.push_back(Script::buildOpReturnScript(plan.outputOpReturn));
+    }
+    if (std::any_of(outputScripts.begin(), outputScripts.end(), [](const Script& script) { return script.empty(); })) {
+        return std::nullopt;
+    }
+    if (hashTypeIsSingle(input.hashType) && plan.utxos.size() > outputScripts.size()) {
+        // inputs without corresponding output are left unsigned
+        return std::nullopt;
+    }
+    const auto size = sizeEstimator.get().transaction(plan.utxos, outputScripts);
+    if (!size.has_value()) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(size->virtualSize());
+}
+
+/// Estimate fee from the script types of inputs and outputs; nullopt if not possible
+std::optional<int64_t> estimateScriptFee(LazySizeEstimator& sizeEstimator, const TransactionPlan& plan, const SigningInput& input) {
+    const auto virtualSize = estimateScriptVirtualSize(sizeEstimator, plan, input);
+    if (!virtualSize.has_value()) {
+        return std::nullopt;
+    }
+    return input.byteFee * *virtualSize;
+}
+
+/// Fee of `plan` replacing a transaction which paid `previousFee`: `byteFee` per virtual byte, and at least
+/// the previous fee plus the incremental relay fee of its own size (BIP125 rule 4)
+int64_t replacementFee(const FeeCalculator& feeCalculator, LazySizeEstimator& sizeEstimator, const TransactionPlan& plan,
+                       const SigningInput& input, int64_t byteFee, int64_t previousFee) {
+    std::optional<int64_t> virtualSize;
+    if (TW::purpose(static_cast<TWCoinType>(input.coinType)) == TWPurposeBIP84) {
+        virtualSize = estimateScriptVirtualSize(sizeEstimator, plan, input);
+    }
+    if (!virtualSize.has_value()) {
+        const auto outputs = 1 + int(plan.change > 0) + int(!plan.outputOpReturn.empty());
+        virtualSize = feeCalculator.calculate(static_cast<int64_t>(plan.utxos.size()), outputs, 1);
+    }
+    return std::max(byteFee * *virtualSize, previousFee + TransactionBuilder::incrementalRelayByteFee * *virtualSize);
+}
+
+/// Estimate encoded size from the script types, or by invoking sign(sizeOnly) and getting the actual size
+int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, LazySizeEstimator& sizeEstimator, const TransactionPlan& plan, int outputSize, const SigningInput& input) {
     TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coinType));
     if (coinPurpose != TWPurposeBIP84) {
         // not segwit, return default simple estimate
         return estimateSimpleFee(feeCalculator, plan, outputSize, input.byteFee);
     }
 
+    if (const auto fee = estimateScriptFee(sizeEstimator, plan, input); fee.has_value()) {
+        return *fee;
+    }
+
     // duplicate input, with the current plan
     auto inputWithPlan = std::move(input);
     inputWithPlan.plan = plan;
@@ -55,19 +138,15 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
     }
 
     // Obtain the encoded size
-    auto transaction = result.payload();
-    Data dataNonSegwit;
-    transaction.encode(dataNonSegwit, Transaction::SegwitFormatMode::NonSegwit);
-    int64_t sizeNonSegwit = dataNonSegwit.size();
+    const auto& transaction = result.payload();
+    int64_t sizeNonSegwit = transaction.serializedSize(Transaction::SegwitFormatMode::NonSegwit);
     uint64_t vSize = 0;
     // Check if there is segwit
     if (!transaction.hasWitness()) {
         // no segwit, virtual size is defined as non-segwit size
         vSize = sizeNonSegwit;
     } else {
-        Data dataWitness;
-        transaction.encodeWitness(dataWitness);
-        int64_t witnessSize = 2 + dataWitness.size();
+        int64_t witnessSize = 2 + transaction.witnessSize();
         // compute virtual size:  (smaller) non-segwit + 1/4 of the diff (witness-only)
         // (in other way: 3/4 of (smaller) non-segwit + 1/4 of segwit size)
         vSize = sizeNonSegwit + witnessSize/4 + (witnessSize % 4 != 0);
@@ -77,12 +156,112 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
     return fee;
 }
 
+/// Fee calculator with the exact sizes of the UTXOs, if all have the same script type
+std::optional<ScriptFeeCalculator> scriptFeeCalculator(LazySizeEstimator& lazySizeEstimator, const UTXOs& utxos, const SigningInput& input) {
+    const auto& toScript = input.lockScript(input.toAddress);
+    if (utxos.empty() || toScript.empty()) {
+        return std::nullopt;
+    }
+    const auto& sizeEstimator = lazySizeEstimator.get();
+    const auto inputSize = sizeEstimator.input(utxos.front().script);
+    if (!inputSize.has_value()) {
+        return std::nullopt;
+    }
+    for (const auto& utxo : utxos) {
+        if (utxo.script != utxos.front().script && sizeEstimator.input(utxo.script) != inputSize) {
+            return std::nullopt;
+        }
+    }
+    return ScriptFeeCalculator(*inputSize, SizeEstimator::output(toScript));
+}
+
 int extraOutputCount(const SigningInput& input) {
     int count = int(input.outputOpReturn.size() > 0);
     return count;
 }
 
 TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
+    return plan(input, input.utxos, InputSelector<UTXO>::sum(input.utxos));
+}
+
+TransactionPlan TransactionBuilder::plan(const SigningInput& input, const UtxoPool& pool) {
+    // dust is excluded before selection, using the pool's cached classification
+    return plan(input, pool.spendable(input.byteFee), static_cast<uint64_t>(pool.amount()));
+}
+
+TransactionPlan TransactionBuilder::bumpFee(const SigningInput& input, const TransactionPlan& previous, int64_t byteFee, const UtxoPool* pool) {
+    auto plan = previous;
+    if (plan.error != Common::Proto::OK) {
+        return plan;
+    }
+    if (plan.utxos.empty()) {
+        plan.error = Common::Proto::Error_missing_input_utxos;
+        return plan;
+    }
+    const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coinType));
+    auto estimator = LazySizeEstimator(input);
+
+    if (input.useMaxAmount) {
+        // no change, the amount pays the fee
+        plan.change = 0;
+        plan.fee = replacementFee(feeCalculator, estimator, plan, input, byteFee, previous.fee);
+        if (plan.fee >= plan.availableAmount) {
+            plan.error = Common::Proto::Error_not_enough_utxos;
+            return plan;
+        }
+        plan.amount = plan.availableAmount - plan.fee;
+        return plan;
+    }
+
+    // UTXOs of the pool the plan doesn't spend yet, to add largest first
+    UTXOs candidates;
+    if (pool != nullptr) {
+        std::set<std::pair<std::array<byte, 32>, uint32_t>> spent;
+        for (const auto& utxo : plan.utxos) {
+            spent.emplace(utxo.outPoint.hash, utxo.outPoint.index);
+        }
+        for (const auto& utxo : pool->spendable(byteFee)) {
+            if (spent.count({utxo.outPoint.hash, utxo.outPoint.index}) == 0) {
+                candidates.push_back(utxo);
+            }
+        }
+    }
+    auto next = candidates.rbegin();
+
+    // change worth less than creating and later spending it goes to the fee
+    const auto outputs = 1 + extraOutputCount(input);
+    const auto costOfChange = feeCalculator.calculate(0, outputs + 1, byteFee) - feeCalculator.calculate(0, outputs, byteFee) +
+                              feeCalculator.calculateSingleInput(byteFee);
+    while (true) {
+        // any positive change sizes the transaction with a change output
+        plan.change = 1;
+        plan.fee = replacementFee(feeCalculator, estimator, plan, input, byteFee, previous.fee);
+        const auto excess = plan.availableAmount - plan.amount - plan.fee;
+        if (excess >= costOfChange) {
+            plan.change = excess;
+            return plan;
+        }
+
+        plan.change = 0;
+        const auto changelessFee = replacementFee(feeCalculator, estimator, plan, input, byteFee, previous.fee);
+        if (plan.availableAmount - plan.amount >= changelessFee) {
+            plan.fee = plan.availableAmount - plan.amount;
+            return plan;
+        }
+
+        if (next == candidates.rend()) {
+            plan.fee = previous.fee;
+            plan.change = previous.change;
+            plan.error = Common::Proto::Error_not_enough_utxos;
+            return plan;
+        }
+        plan.utxos.push_back(*next);
+        plan.availableAmount += next->amount;
+        ++next;
+    }
+}
+
+TransactionPlan TransactionBuilder::plan(const SigningInput& input, const UTXOs& utxos, uint64_t inputSum) {
     TransactionPlan plan;
     if (input.outputOpReturn.size() > 0) {
         plan.outputOpReturn = input.outputOpReturn;
@@ -91,12 +270,19 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
     bool maxAmount = input.useMaxAmount;
     if (input.amount == 0 && !maxAmount) {
         plan.error = Common::Proto::Error_zero_amount_requested;
-    } else if (input.utxos.empty()) {
+    } else if (utxos.empty() && inputSum == 0) {
         plan.error = Common::Proto::Error_missing_input_utxos;
     } else {
         const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coinType));
-        auto inputSelector = InputSelector<UTXO>(input.utxos, feeCalculator);
-        auto inputSum = InputSelector<UTXO>::sum(input.utxos);
+        auto estimator = LazySizeEstimator(input);
+        const auto branchAndBound = input.coinSelection == Proto::BranchAndBound;
+
+        // branch and bound selection uses the exact input and output sizes when possible
+        const auto exactFeeCalculator = branchAndBound && TW::purpose(static_cast<TWCoinType>(input.coinType)) == TWPurposeBIP84
+                                            ? scriptFeeCalculator(estimator, utxos, input)
+                                            : std::nullopt;
+        const FeeCalculator& selectionFeeCalculator = exactFeeCalculator.has_value() ? *exactFeeCalculator : feeCalculator;
+        auto inputSelector = InputSelector<UTXO>(utxos, selectionFeeCalculator);
 
         // select UTXOs
         plan.amount = input.amount;
@@ -112,7 +298,10 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
         UTXOs selectedInputs;
         if (!maxAmount) {
             output_size = 2 + extraOutputs; // output + change
-            if (input.utxos.size() <= SimpleModeLimit && input.utxos.size() <= MaxUtxosHardLimit) {
+            if (branchAndBound) {
+                const auto maxIterations = input.coinSelectionMaxIterations > 0 ? input.coinSelectionMaxIterations : InputSelector<UTXO>::defaultMaxIterations;
+                selectedInputs = inputSelector.selectBranchAndBound(plan.amount, input.byteFee, output_size, maxIterations);
+            } else if (utxos.size() <= SimpleModeLimit && utxos.size() <= MaxUtxosHardLimit) {
                 selectedInputs = inputSelector.select(plan.amount, input.byteFee, output_size);
             } else {
                 selectedInputs = inputSelector.selectSimple(plan.amount, input.byteFee, output_size);
@@ -137,35 +326,55 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
         } else {
             plan.availableAmount = InputSelector<UTXO>::sum(plan.utxos);
 
-            // Compute fee.
-            // must preliminary set change so that there is a second output
-            if (!maxAmount) {
-                assert(input.amount <= plan.availableAmount);
+            // With branch and bound selection, first try without change output:
+            // an excess smaller than the cost of creating and later spending the change goes to the fee
+            auto changeless = false;
+            if (!maxAmount && branchAndBound) {
                 plan.amount = input.amount;
                 plan.fee = 0;
-                plan.change = plan.availableAmount - plan.amount;
-            } else {
-                plan.amount = plan.availableAmount;
-                plan.fee = 0;
                 plan.change = 0;
+                const auto changelessFee = estimateSegwitFee(feeCalculator, estimator, plan, output_size - 1, input);
+                const auto excess = plan.availableAmount - plan.amount - changelessFee;
+                const auto costOfChange = selectionFeeCalculator.calculate(0, output_size, input.byteFee) -
+                                          selectionFeeCalculator.calculate(0, output_size - 1, input.byteFee) +
+                                          selectionFeeCalculator.calculateSingleInput(input.byteFee);
+                if (excess >= 0 && excess < costOfChange) {
+                    plan.fee = plan.availableAmount - plan.amount;
+                    changeless = true;
+                }
             }
-            plan.fee = estimateSegwitFee(feeCalculator, plan, output_size, input);
-            // If fee is larger than availableAmount (can happen in special maxAmount case), we reduce it (and hope it will go through)
-            plan.fee = std::min(plan.availableAmount, plan.fee);
-            assert(plan.fee >= 0 && plan.fee <= plan.availableAmount);
-
-            // adjust/compute amount
-            if (!maxAmount) {
-                // reduce amount if needed
-                plan.amount = std::max(Amount(0), std::min(plan.amount, plan.availableAmount - plan.fee));
-            } else {
-                // max available amount
-                plan.amount = std::max(Amount(0), plan.availableAmount - plan.fee);
-            }
-            assert(plan.amount >= 0 && plan.amount <= plan.availableAmount);
 
-            // compute change
-            plan.change = plan.availableAmount - plan.amount - plan.fee;
+            if (!changeless) {
+                // Compute fee.
+                // must preliminary set change so that there is a second output
+                if (!maxAmount) {
+                    assert(input.amount <= plan.availableAmount);
+                    plan.amount = input.amount;
+                    plan.fee = 0;
+                    plan.change = plan.availableAmount - plan.amount;
+                } else {
+                    plan.amount = plan.availableAmount;
+                    plan.fee = 0;
+                    plan.change = 0;
+                }
+                plan.fee = estimateSegwitFee(feeCalculator, estimator, plan, output_size, input);
+                // If fee is larger than availableAmount (can happen in special maxAmount case), we reduce it (and hope it will go through)
+                plan.fee = std::min(plan.availableAmount, plan.fee);
+                assert(plan.fee >= 0 && plan.fee <= plan.availableAmount);
+
+                // adjust/compute amount
+                if (!maxAmount) {
+                    // reduce amount if needed
+                    plan.amount = std::max(Amount(0), std::min(plan.amount, plan.availableAmount - plan.fee));
+                } else {
+                    // max available amount
+                    plan.amount = std::max(Amount(0), plan.availableAmount - plan.fee);
+                }
+                assert(plan.amount >= 0 && plan.amount <= plan.availableAmount);
+
+                // compute change
+                plan.change = plan.availableAmount - plan.amount - plan.fee;
+            }
         }
     }
     assert(plan.change >= 0 && plan.change <= plan.availableAmount);
@@ -10,6 +10,8 @@
 #include "Transaction.h"
 #include "TransactionPlan.h"
 #include "InputSelector.h"
+#include "SizeEstimator.h"
+#include "UtxoPool.h"
 #include "../Result.h"
 #include "../proto/Bitcoin.pb.h"
 #include <TrustWalletCore/TWCoinType.h>
@@ -24,25 +26,60 @@ public:
     /// Plans a transaction by selecting UTXOs and calculating fees.
     static TransactionPlan plan(const SigningInput& input);
 
+    /// Plans a transaction selecting from the UTXOs of a pool instead of `input.utxos`.
+    static TransactionPlan plan(const SigningInput& input, const UtxoPool& pool);
+
+    /// Replans `previous`, a plan of `input`, to pay `byteFee` for replacing its transaction (BIP125), without
+    /// selecting the UTXOs again: the fee is taken from the change, or from the amount with `useMaxAmount`.
+    /// If the change can't cover it, the change output is dropped or, failing that, the largest UTXOs of `pool`
+    /// not yet spent by the plan are added. The replacement pays at least the previous fee plus its own virtual
+    /// size at `incrementalRelayByteFee`. Sign it by setting it as `input.plan`; the UTXO sequences must signal
+    /// replaceability.
+    static TransactionPlan bumpFee(const SigningInput& input, const TransactionPlan& previous, int64_t byteFee, const UtxoPool* pool = nullptr);
+
+    /// Minimum fee rate increase of a replacement transaction, in satoshis per virtual byte (Bitcoin Core default).
+    static constexpr int64_t incrementalRelayByteFee = 1;
+
     /// Builds a transaction with the selected input UTXOs, and one main output and an optional change output.
     template <typename Transaction>
     static Result<Transaction, Common::Proto::SigningError> build(const TransactionPlan& plan, const std::string& toAddress,
                              const std::string& changeAddress, enum TWCoinType coin, uint32_t lockTime) {
+        const auto changeScript = plan.change > 0 ? Script::lockScriptForAddress(changeAddress, coin) : Script();
+        return build<Transaction>(plan, Script::lockScriptForAddress(toAddress, coin), changeScript, lockTime);
+    }
+
+    /// Builds a transaction for the addresses of `input`, resolved with `SigningInput::lockScript` for `coin`.
+    template <typename Transaction>
+    static Result<Transaction, Common::Proto::SigningError> build(const TransactionPlan& plan, const SigningInput& input, enum TWCoinType coin) {
+        const Script noChange;
+        const auto& changeScript = plan.change > 0 ? input.lockScript(input.changeAddress, coin) : noChange;
+        return build<Transaction>(plan, input.lockScript(input.toAddress, coin), changeScript, input.lockTime);
+    }
+
+    /// Builds a transaction for the addresses of `input`.
+    template <typename Transaction>
+    static Result<Transaction, Common::Proto::SigningError> build(const TransactionPlan& plan, const SigningInput& input) {
+        return build<Transaction>(plan, input, input.coinType);
+    }
+
+    /// Builds a transaction from the already resolved locking scripts of the main and change outputs;
+    /// an empty script is an invalid address. `changeScript` is only used if the plan has change.
+    template <typename Transaction>
+    static Result<Transaction, Common::Proto::SigningError> build(const TransactionPlan& plan, const Script& toScript,
+                             const Script& changeScript, uint32_t lockTime) {
         Transaction tx;
         tx.lockTime = lockTime;
 
-        auto outputTo = prepareOutputWithScript(toAddress, plan.amount, coin);
-        if (!outputTo.has_value()) {
+        if (toScript.empty()) {
             return Result<Transaction, Common::Proto::SigningError>::failure(Common::Proto::Error_invalid_address);
         }
-        tx.outputs.push_back(outputTo.value());
+        tx.outputs.emplace_back(plan.amount, toScript);
 
         if (plan.change > 0) {
-            auto outputChange = prepareOutputWithScript(changeAddress, plan.change, coin);
-            if (!outputChange.has_value()) {
+            if (changeScript.empty()) {
                 return Result<Transaction, Common::Proto::SigningError>::failure(Common::Proto::Error_invalid_address);
             }
-            tx.outputs.push_back(outputChange.value());
+            tx.outputs.emplace_back(plan.change, changeScript);
         }
 
         const auto emptyScript = Script();
@@ -62,11 +99,17 @@ public:
         return Result<Transaction, Common::Proto::SigningError>(tx);
     }
 
+    /// Size estimator for the redeem scripts and private keys of `input`.
+    static SizeEstimator sizeEstimator(const SigningInput& input);
+
     /// Prepares a TransactionOutput with given address and amount, prepares script for it
     static std::optional<TransactionOutput> prepareOutputWithScript(std::string address, Amount amount, enum TWCoinType coin);
 
     /// The maximum number of UTXOs to consider.  UTXOs above this limit are cut off because it cak take very long.
     static const size_t MaxUtxosHardLimit;
+
+private:
+    static TransactionPlan plan(const SigningInput& input, const UTXOs& utxos, uint64_t inputSum);
 };
 
 } // namespace TW::Bitcoin
@@ -21,8 +21,20 @@ void TransactionInput::encodeWitness(Data& data) const {
     encodeVarInt(scriptWitness.size(), data);
     for (auto& item : scriptWitness) {
         encodeVarInt(item.size(), data);
-        std::copy(std::begin(item), std::end(item), std::back_inserter(data));
+        data.insert(data.end(), item.begin(), item.end());
     }
 }
 
+std::size_t TransactionInput::serializedSize() const {
+    return OutPoint::serializedSize() + script.serializedSize() + 4;
+}
+
+std::size_t TransactionInput::witnessSize() const {
+    std::size_t size = varIntSize(scriptWitness.size());
+    for (const auto& item : scriptWitness) {
+        size += varIntSize(item.size()) + item.size();
+    }
+    return size;
+}
+
 } // namespace TW::Bitcoin
@@ -42,6 +42,12 @@ class TransactionInput {
 
     /// Encodes the witness data into the provided buffer.
     void encodeWitness(Data& data) const;
+
+    /// Size of the encoded input, without witness.
+    std::size_t serializedSize() const;
+
+    /// Size of the encoded witness data.
+    std::size_t witnessSize() const;
 };
 
 } // namespace TW::Bitcoin
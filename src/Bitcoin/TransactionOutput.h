@@ -31,6 +31,9 @@ struct TransactionOutput {
 
     /// Encodes the output into the provided buffer.
     void encode(Data& data) const;
+
+    /// Size of the encoded output.
+    std::size_t serializedSize() const { return 8 + script.serializedSize(); }
 };
 
 } // namespace TW::Bitcoin
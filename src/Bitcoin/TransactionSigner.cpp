@@ -20,39 +20,51 @@ TransactionPlan TransactionSigner<Transaction, TransactionBuilder>::plan(const S
 }
 
 template <typename Transaction, typename TransactionBuilder>
-Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(const SigningInput& input, bool estimationMode, std::optional<SignaturePubkeyList> optionalExternalSigs) {
+Result<typename TransactionSigner<Transaction, TransactionBuilder>::Prepared, Common::Proto::SigningError>
+TransactionSigner<Transaction, TransactionBuilder>::prepare(const SigningInput& input) {
     TransactionPlan plan;
     if (input.plan.has_value()) {
         plan = input.plan.value();
     } else {
         plan = TransactionBuilder::plan(input);
     }
-    auto tx_result = TransactionBuilder::template build<Transaction>(plan, input.toAddress, input.changeAddress, input.coinType, input.lockTime);
+    auto tx_result = TransactionBuilder::template build<Transaction>(plan, input);
     if (!tx_result) {
-        return Result<Transaction, Common::Proto::SigningError>::failure(tx_result.error());
+        return Result<Prepared, Common::Proto::SigningError>::failure(tx_result.error());
+    }
+    return Result<Prepared, Common::Proto::SigningError>::success(Prepared{std::move(plan), tx_result.payload()});
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(const SigningInput& input, bool estimationMode, std::optional<SignaturePubkeyList> optionalExternalSigs) {
+    auto prepared = prepare(input);
+    if (!prepared) {
+        return Result<Transaction, Common::Proto::SigningError>::failure(prepared.error());
     }
-    Transaction transaction = tx_result.payload();
     SigningMode signingMode =
         estimationMode ? SigningMode_SizeEstimationOnly : optionalExternalSigs.has_value() ? SigningMode_External
                                                                                            : SigningMode_Normal;
-    SignatureBuilder<Transaction> signer(std::move(input), plan, transaction, signingMode, optionalExternalSigs);
+    return sign(input, prepared.payload(), signingMode, std::move(optionalExternalSigs));
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(const SigningInput& input, const Prepared& prepared, SigningMode signingMode, std::optional<SignaturePubkeyList> optionalExternalSigs) {
+    SignatureBuilder<Transaction> signer(input, prepared.plan, prepared.transaction, signingMode, std::move(optionalExternalSigs));
     return signer.sign();
 }
 
 template <typename Transaction, typename TransactionBuilder>
 Result<HashPubkeyList, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::preImageHashes(const SigningInput& input) {
-    TransactionPlan plan;
-    if (input.plan.has_value()) {
-        plan = input.plan.value();
-    } else {
-        plan = TransactionBuilder::plan(input);
+    auto prepared = prepare(input);
+    if (!prepared) {
+        return Result<HashPubkeyList, Common::Proto::SigningError>::failure(prepared.error());
     }
-    auto tx_result = TransactionBuilder::template build<Transaction>(plan, input.toAddress, input.changeAddress, input.coinType, input.lockTime);
-    if (!tx_result) {
-        return Result<HashPubkeyList, Common::Proto::SigningError>::failure(tx_result.error());
-    }
-    Transaction transaction = tx_result.payload();
-    SignatureBuilder<Transaction> signer(std::move(input), plan, transaction, SigningMode_HashOnly);
+    return preImageHashes(input, prepared.payload());
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<HashPubkeyList, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::preImageHashes(const SigningInput& input, const Prepared& prepared) {
+    SignatureBuilder<Transaction> signer(input, prepared.plan, prepared.transaction, SigningMode_HashOnly);
     auto signResult = signer.sign();
     if (!signResult) {
         return Result<HashPubkeyList, Common::Proto::SigningError>::failure(signResult.error());
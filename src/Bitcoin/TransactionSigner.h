@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "SignatureBuilder.h"
 #include "SigningInput.h"
 #include "Transaction.h"
 #include "TransactionBuilder.h"
@@ -26,14 +27,29 @@ namespace TW::Bitcoin {
 template <typename Transaction, typename TransactionBuilder>
 class TransactionSigner {
 public:
+    /// A planned and built, still unsigned transaction.
+    struct Prepared {
+        TransactionPlan plan;
+        Transaction transaction;
+    };
+
     // Create plan for a transaction
     static TransactionPlan plan(const SigningInput& input);
 
+    /// Plans, unless the input has a plan, and builds the unsigned transaction.
+    static Result<Prepared, Common::Proto::SigningError> prepare(const SigningInput& input);
+
     // Sign an unsigned transaction.  Plan it if needed beforehand.
     static Result<Transaction, Common::Proto::SigningError> sign(const SigningInput& input, bool estimationMode = false, std::optional<SignaturePubkeyList> optionalExternalSigs = {});
 
+    /// Signs a prepared transaction, without planning and building it again.
+    static Result<Transaction, Common::Proto::SigningError> sign(const SigningInput& input, const Prepared& prepared, SigningMode signingMode, std::optional<SignaturePubkeyList> optionalExternalSigs = {});
+
     /// Collect pre-image hashes to be signed
     static Result<HashPubkeyList, Common::Proto::SigningError> preImageHashes(const SigningInput& input);
+
+    /// Collects the pre-image hashes of a prepared transaction.
+    static Result<HashPubkeyList, Common::Proto::SigningError> preImageHashes(const SigningInput& input, const Prepared& prepared);
 };
 
 } // namespace TW::Bitcoin
@@ -0,0 +1,124 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "UtxoPool.h"
+
+#include <algorithm>
+
+namespace TW::Bitcoin {
+
+static bool lessAmount(const UTXO& utxo, Amount amount) {
+    return utxo.amount < amount;
+}
+
+static bool greaterAmount(Amount amount, const UTXO& utxo) {
+    return amount < utxo.amount;
+}
+
+UtxoPool::UtxoPool(TWCoinType coin) noexcept
+    : feeCalculator(getFeeCalculator(coin)) {}
+
+void UtxoPool::add(const UTXO& utxo) {
+    const auto key = Key(utxo.outPoint.hash, utxo.outPoint.index);
+    if (const auto existing = amounts.find(key); existing != amounts.end()) {
+        const auto position = find(key, existing->second);
+        total -= sorted[position].amount;
+        sorted.erase(sorted.begin() + position);
+    }
+    // after the UTXOs with the same amount, to keep the insertion order among them
+    const auto position = std::upper_bound(sorted.begin(), sorted.end(), utxo.amount, greaterAmount);
+    sorted.insert(position, utxo);
+    amounts[key] = utxo.amount;
+    total += utxo.amount;
+    dustCache.clear();
+}
+
+void UtxoPool::add(const UTXOs& utxos) {
+    if (!sorted.empty()) {
+        for (const auto& utxo : utxos) {
+            add(utxo);
+        }
+        return;
+    }
+    // bulk load: sort once; the last of duplicate out-points wins
+    std::map<Key, std::size_t> positions;
+    for (auto i = 0ul; i < utxos.size(); ++i) {
+        positions[Key(utxos[i].outPoint.hash, utxos[i].outPoint.index)] = i;
+    }
+    sorted.reserve(positions.size());
+    for (auto i = 0ul; i < utxos.size(); ++i) {
+        const auto key = Key(utxos[i].outPoint.hash, utxos[i].outPoint.index);
+        if (positions[key] == i) {
+            sorted.push_back(utxos[i]);
+            amounts[key] = utxos[i].amount;
+            total += utxos[i].amount;
+        }
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const UTXO& lhs, const UTXO& rhs) {
+        return lhs.amount < rhs.amount;
+    });
+    dustCache.clear();
+}
+
+bool UtxoPool::spend(const OutPoint& outPoint) {
+    const auto key = Key(outPoint.hash, outPoint.index);
+    const auto existing = amounts.find(key);
+    if (existing == amounts.end()) {
+        return false;
+    }
+    const auto position = find(key, existing->second);
+    total -= sorted[position].amount;
+    sorted.erase(sorted.begin() + position);
+    amounts.erase(existing);
+    dustCache.clear();
+    return true;
+}
+
+void UtxoPool::clear() noexcept {
+    sorted.clear();
+    amounts.clear();
+    total = 0;
+    dustCache.clear();
+}
+
+std::size_t UtxoPool::dustCount(int64_t byteFee) const {
+    return dust(byteFee).count;
+}
+
+Amount UtxoPool::spendableAmount(int64_t byteFee) const {
+    return total - dust(byteFee).amount;
+}
+
+UTXOs UtxoPool::spendable(int64_t byteFee) const {
+    const auto count = dust(byteFee).count;
+    return std::vector<UTXO>(sorted.begin() + count, sorted.end());
+}
+
+const UtxoPool::Dust& UtxoPool::dust(int64_t byteFee) const {
+    if (const auto cached = dustCache.find(byteFee); cached != dustCache.end()) {
+        return cached->second;
+    }
+    // same threshold as InputSelector::filterOutDust: dust is not above the fee of spending it
+    const auto threshold = feeCalculator.calculateSingleInput(byteFee);
+    const auto end = std::upper_bound(sorted.begin(), sorted.end(), threshold, greaterAmount);
+    Amount amount = 0;
+    for (auto it = sorted.begin(); it != end; ++it) {
+        amount += it->amount;
+    }
+    return dustCache[byteFee] = Dust{static_cast<std::size_t>(end - sorted.begin()), amount};
+}
+
+std::size_t UtxoPool::find(const Key& key, Amount amount) const {
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), amount, lessAmount);
+    for (; it != sorted.end() && it->amount == amount; ++it) {
+        if (it->outPoint.hash == key.first && it->outPoint.index == key.second) {
+            break;
+        }
+    }
+    return static_cast<std::size_t>(it - sorted.begin());
+}
+
+} // namespace TW::Bitcoin
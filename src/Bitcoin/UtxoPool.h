@@ -0,0 +1,83 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Amount.h"
+#include "FeeCalculator.h"
+#include "OutPoint.h"
+#include "UTXO.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <utility>
+
+namespace TW::Bitcoin {
+
+/// Persistent set of the unspent outputs of a wallet, for planning repeatedly against the same UTXOs.
+/// Loaded once and updated incrementally, it keeps the UTXOs sorted by amount and caches, per byte fee,
+/// which of them are dust. Not thread-safe.
+class UtxoPool {
+public:
+    explicit UtxoPool(TWCoinType coin = TWCoinTypeBitcoin) noexcept;
+
+    /// Adds an unspent output; an output with the same out-point is replaced.
+    void add(const UTXO& utxo);
+    void add(const UTXOs& utxos);
+
+    /// Removes a spent output, returns false if it is not in the pool.
+    bool spend(const OutPoint& outPoint);
+
+    void clear() noexcept;
+
+    std::size_t size() const noexcept { return sorted.size(); }
+    bool empty() const noexcept { return sorted.empty(); }
+
+    /// Sum of all amounts, dust included.
+    Amount amount() const noexcept { return total; }
+
+    /// All UTXOs, sorted by increasing amount.
+    const UTXOs& utxos() const noexcept { return sorted; }
+
+    /// Number of UTXOs worth less than the fee of spending them.
+    std::size_t dustCount(int64_t byteFee) const;
+
+    /// Sum of the amounts of the UTXOs which are not dust.
+    Amount spendableAmount(int64_t byteFee) const;
+
+    /// UTXOs which are not dust, sorted by increasing amount.
+    UTXOs spendable(int64_t byteFee) const;
+
+private:
+    using Key = std::pair<std::array<byte, 32>, uint32_t>;
+
+    struct Dust {
+        std::size_t count;
+        Amount amount;
+    };
+
+    /// Dust classification for a byte fee, computed on first use after a change.
+    const Dust& dust(int64_t byteFee) const;
+
+    /// Position of the UTXO with the out-point in `sorted`, or `sorted.size()`.
+    std::size_t find(const Key& key, Amount amount) const;
+
+    const FeeCalculator& feeCalculator;
+    UTXOs sorted;
+    std::map<Key, Amount> amounts;
+    Amount total = 0;
+    mutable std::map<int64_t, Dust> dustCache;
+};
+
+} // namespace TW::Bitcoin
+
+/// Wrapper for C interface.
+struct TWBitcoinUtxoPool {
+    TW::Bitcoin::UtxoPool impl;
+};
@@ -0,0 +1,242 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Blake2b.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TW_BLAKE2B_AVX2 1
+#endif
+
+namespace TW::Blake2b {
+
+namespace {
+
+#if defined(TW_BLAKE2B_AVX2)
+
+constexpr std::size_t lanes = 4;
+
+#define TW_BLAKE2B_TARGET __attribute__((target("avx2")))
+
+constexpr std::array<std::array<byte, 16>, 12> sigma = {{
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+}};
+
+constexpr std::array<uint64_t, 8> iv = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+};
+
+/// One 64-bit word of each of the four messages.
+using Words = __m256i;
+
+TW_BLAKE2B_TARGET inline Words rotr32(Words x) {
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+TW_BLAKE2B_TARGET inline Words rotr24(Words x) {
+    const auto shuffle = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                          3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+TW_BLAKE2B_TARGET inline Words rotr16(Words x) {
+    const auto shuffle = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                          2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+TW_BLAKE2B_TARGET inline Words rotr63(Words x) {
+    return _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+}
+
+TW_BLAKE2B_TARGET inline void mix(Words& a, Words& b, Words& c, Words& d, Words x, Words y) {
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+    d = rotr32(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi64(c, d);
+    b = rotr24(_mm256_xor_si256(b, c));
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+    d = rotr16(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi64(c, d);
+    b = rotr63(_mm256_xor_si256(b, c));
+}
+
+/// Loads the 16 message words of a block of each message, transposing 4 words of the 4 messages at a time.
+TW_BLAKE2B_TARGET inline void loadBlocks(const std::array<const byte*, lanes>& blocks, Words (&m)[16]) {
+    for (std::size_t i = 0; i < 16; i += 4) {
+        const auto r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[0] + 8 * i));
+        const auto r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[1] + 8 * i));
+        const auto r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[2] + 8 * i));
+        const auto r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[3] + 8 * i));
+        const auto t0 = _mm256_unpacklo_epi64(r0, r1); // words 0, 2 of messages 0, 1
+        const auto t1 = _mm256_unpackhi_epi64(r0, r1); // words 1, 3 of messages 0, 1
+        const auto t2 = _mm256_unpacklo_epi64(r2, r3);
+        const auto t3 = _mm256_unpackhi_epi64(r2, r3);
+        m[i] = _mm256_permute2x128_si256(t0, t2, 0x20);
+        m[i + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+        m[i + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+        m[i + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+    }
+}
+
+TW_BLAKE2B_TARGET void compress(Words (&h)[8], const std::array<const byte*, lanes>& blocks, uint64_t counter, bool last) {
+    Words m[16];
+    loadBlocks(blocks, m);
+    Words v[16];
+    for (std::size_t i = 0; i < 8; ++i) {
+        v[i] = h[i];
+        v[i + 8] = _mm256_set1_epi64x(static_cast<long long>(iv[i]));
+    }
+    v[12] = _mm256_xor_si256(v[12], _mm256_set1_epi64x(static_cast<long long>(counter)));
+    if (last) {
+        v[14] = _mm256_xor_si256(v[14], _mm256_set1_epi64x(-1));
+    }
+    for (const auto& s : sigma) {
+        mix(v[0], v[4], v[8], v[12], m[s[0]], m[s[1]]);
+        mix(v[1], v[5], v[9], v[13], m[s[2]], m[s[3]]);
+        mix(v[2], v[6], v[10], v[14], m[s[4]], m[s[5]]);
+        mix(v[3], v[7], v[11], v[15], m[s[6]], m[s[7]]);
+        mix(v[0], v[5], v[10], v[15], m[s[8]], m[s[9]]);
+        mix(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        mix(v[2], v[7], v[8], v[13], m[s[12]], m[s[13]]);
+        mix(v[3], v[4], v[9], v[14], m[s[14]], m[s[15]]);
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+    }
+}
+
+/// Hashes four messages of `size` bytes from the initial state `initial`.
+TW_BLAKE2B_TARGET void hash4(const blake2b_state& initial, const std::array<const byte*, lanes>& messages, std::size_t size, byte* out) {
+    Words h[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = _mm256_set1_epi64x(static_cast<long long>(initial.h[i]));
+    }
+    std::size_t offset = 0;
+    for (; size - offset > BLAKE2B_BLOCKBYTES; offset += BLAKE2B_BLOCKBYTES) {
+        std::array<const byte*, lanes> blocks;
+        for (std::size_t l = 0; l < lanes; ++l) {
+            blocks[l] = messages[l] + offset;
+        }
+        compress(h, blocks, offset + BLAKE2B_BLOCKBYTES, false);
+    }
+    // last block, zero padded; an empty message has one empty block
+    std::array<std::array<byte, BLAKE2B_BLOCKBYTES>, lanes> padded{};
+    std::array<const byte*, lanes> blocks;
+    for (std::size_t l = 0; l < lanes; ++l) {
+        if (size > offset) {
+            std::memcpy(padded[l].data(), messages[l] + offset, size - offset);
+        }
+        blocks[l] = padded[l].data();
+    }
+    compress(h, blocks, size, true);
+
+    alignas(32) std::array<std::array<uint64_t, lanes>, 8> words;
+    for (std::size_t i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i].data()), h[i]);
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+        std::array<byte, BLAKE2B_OUTBYTES> digest;
+        for (std::size_t i = 0; i < 8; ++i) {
+            // little endian words
+            for (std::size_t b = 0; b < 8; ++b) {
+                digest[8 * i + b] = static_cast<byte>(words[i][l] >> (8 * b));
+            }
+        }
+        std::memcpy(out + l * initial.outlen, digest.data(), initial.outlen);
+    }
+}
+
+#endif
+
+} // namespace
+
+bool avx2Supported() noexcept {
+    return CpuFeatures::avx2();
+}
+
+Context::Context(std::size_t hashSize, const Data& personal) {
+    if (hashSize == 0 || hashSize > BLAKE2B_OUTBYTES || personal.size() > BLAKE2B_PERSONALBYTES) {
+        throw std::invalid_argument("Invalid Blake2b parameters");
+    }
+    // a shorter personalization is zero padded
+    std::array<byte, BLAKE2B_PERSONALBYTES> padded{};
+    std::copy(personal.begin(), personal.end(), padded.begin());
+    blake2b_InitPersonal(&initial, hashSize, padded.data(), padded.size());
+}
+
+void Context::hash(const byte* data, std::size_t size, byte* out) const noexcept {
+    auto state = initial;
+    blake2b_Update(&state, data, size);
+    blake2b_Final(&state, out, initial.outlen);
+}
+
+Data Context::hash(const Data& data) const {
+    Data digest(hashSize());
+    hash(data.data(), data.size(), digest.data());
+    return digest;
+}
+
+template <typename Message>
+void Context::hashEach(std::span<const Message> messages, byte* out) const noexcept {
+    std::size_t i = 0;
+#if defined(TW_BLAKE2B_AVX2)
+    if (avx2Supported()) {
+        while (i + lanes <= messages.size()) {
+            const auto size = messages[i].size();
+            if (!std::all_of(messages.begin() + i + 1, messages.begin() + i + lanes, [size](const auto& m) { return m.size() == size; })) {
+                hash(messages[i].data(), size, out + i * hashSize());
+                ++i;
+                continue;
+            }
+            hash4(initial, {messages[i].data(), messages[i + 1].data(), messages[i + 2].data(), messages[i + 3].data()}, size, out + i * hashSize());
+            i += lanes;
+        }
+    }
+#endif
+    for (; i < messages.size(); ++i) {
+        hash(messages[i].data(), messages[i].size(), out + i * hashSize());
+    }
+}
+
+void Context::hashBatch(std::span<const Data> messages, byte* out) const noexcept {
+    hashEach(messages, out);
+}
+
+void Context::hashBatch(std::span<const std::span<const byte>> messages, byte* out) const noexcept {
+    hashEach(messages, out);
+}
+
+std::vector<Data> Context::hashBatch(std::span<const Data> messages) const {
+    Data digests(messages.size() * hashSize());
+    hashBatch(messages, digests.data());
+    std::vector<Data> result;
+    result.reserve(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        const auto* digest = digests.data() + i * hashSize();
+        result.emplace_back(digest, digest + hashSize());
+    }
+    return result;
+}
+
+} // namespace TW::Blake2b
@@ -0,0 +1,53 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrezorCrypto/blake2b.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace TW::Blake2b {
+
+/// Whether `Context::hashBatch` hashes four messages at a time with AVX2, checked once.
+bool avx2Supported() noexcept;
+
+/// Blake2b with a fixed digest size and personalization, whose initial state is built once.
+/// Contexts are immutable and can be shared between threads.
+class Context {
+public:
+    /// \throws std::invalid_argument if `hashSize` is not between 1 and 64, or `personal` is longer than 16 bytes.
+    explicit Context(std::size_t hashSize = 32, const Data& personal = {});
+
+    std::size_t hashSize() const noexcept { return initial.outlen; }
+
+    /// Hashes `data` into `out`, `hashSize()` bytes.
+    void hash(const byte* data, std::size_t size, byte* out) const noexcept;
+
+    Data hash(const Data& data) const;
+
+    /// Hashes every message into `out`, `hashSize()` bytes each, in order.
+    /// Runs of four messages of the same size are hashed together on AVX2.
+    void hashBatch(std::span<const Data> messages, byte* out) const noexcept;
+
+    /// Same as above, for messages viewed in place.
+    void hashBatch(std::span<const std::span<const byte>> messages, byte* out) const noexcept;
+
+    /// Digests of every message, in order.
+    std::vector<Data> hashBatch(std::span<const Data> messages) const;
+
+private:
+    template <typename Message>
+    void hashEach(std::span<const Message> messages, byte* out) const noexcept;
+
+    blake2b_state initial;
+};
+
+} // namespace TW::Blake2b
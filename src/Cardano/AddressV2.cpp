@@ -10,37 +10,113 @@
 #include "../Crc.h"
 
 #include <array>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
 
 namespace TW::Cardano {
 
-bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& attrs_out, byte& type_out) {
+namespace {
+
+/// Elements of a parsed address string.
+struct Parsed {
+    Data root;
+    Data attrs;
+    byte type;
+};
+
+/// Thread-safe LRU cache of parsed address strings, so that an address seen again, e.g. in every UTXO of a plan,
+/// skips the Base58, CBOR and CRC work. Only valid addresses are stored.
+class ParsedCache {
+public:
+    static ParsedCache& shared() {
+        static ParsedCache cache;
+        return cache;
+    }
+
+    std::optional<Parsed> find(const std::string& addr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = lookup.find(addr);
+        if (it == lookup.end()) {
+            return std::nullopt;
+        }
+        // mark as most recently used
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+
+    void insert(const std::string& addr, const Parsed& parsed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lookup.find(addr) != lookup.end()) {
+            return;
+        }
+        if (entries.size() >= capacity) {
+            lookup.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(addr, parsed);
+        lookup.emplace(addr, entries.begin());
+    }
+
+private:
+    /// Number of addresses kept, e.g. the distinct addresses of a large UTXO set.
+    static constexpr std::size_t capacity = 1024;
+
+    using Entries = std::list<std::pair<std::string, Parsed>>;
+
+    /// Most recently used first.
+    Entries entries;
+    std::map<std::string, Entries::iterator> lookup;
+    std::mutex mutex;
+};
+
+Parsed parse(const std::string& addr) {
     // Decode Bas58, decode payload + crc, decode root, attr
     Data base58decoded = Base58::decode(addr);
     if (base58decoded.empty()) {
         throw std::invalid_argument("Invalid address: could not Base58 decode");
     }
-    auto elems = Cbor::Decode(base58decoded).getArrayElements();
+    auto elems = Cbor::Decode(std::move(base58decoded)).getArrayElements();
     if (elems.size() < 2) {
         throw std::invalid_argument("Could not parse address payload from CBOR data");
     }
     auto tag = elems[0].getTagValue();
-    if (tag != PayloadTag) {
+    if (tag != AddressV2::PayloadTag) {
         throw std::invalid_argument("wrong tag value");
     }
-    Data payload = elems[0].getTagElement().getBytes();
+    // the payload is checked and parsed in place, within the decoded buffer
+    const auto payload = elems[0].getTagElement();
+    const auto payloadBytes = payload.getBytesView();
     uint64_t crcPresent = (uint32_t)elems[1].getValue();
-    uint32_t crcComputed = TW::Crc::crc32(payload);
+    uint32_t crcComputed = TW::Crc::crc32(payloadBytes.data(), payloadBytes.size());
     if (crcPresent != crcComputed) {
         throw std::invalid_argument("CRC mismatch");
     }
     // parse payload, 3 elements
-    auto payloadElems = Cbor::Decode(payload).getArrayElements();
+    auto payloadElems = payload.getBytesContent().getArrayElements();
     if (payloadElems.size() < 3) {
         throw std::invalid_argument("Could not parse address root and attrs from CBOR data");
     }
-    root_out = payloadElems[0].getBytes();
-    attrs_out = payloadElems[1].encoded(); // map, but encoded as bytes
-    type_out = (TW::byte)payloadElems[2].getValue();
+    return Parsed{
+        payloadElems[0].getBytes(),
+        payloadElems[1].encoded(), // map, but encoded as bytes
+        (TW::byte)payloadElems[2].getValue(),
+    };
+}
+
+} // namespace
+
+bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& attrs_out, byte& type_out) {
+    auto& cache = ParsedCache::shared();
+    auto parsed = cache.find(addr);
+    if (!parsed.has_value()) {
+        parsed = parse(addr);
+        cache.insert(addr, *parsed);
+    }
+    root_out = std::move(parsed->root);
+    attrs_out = std::move(parsed->attrs);
+    type_out = parsed->type;
     return true;
 }
 
@@ -74,28 +150,22 @@ AddressV2::AddressV2(const PublicKey& publicKey) {
     type = 0; // public key
     root = keyHash(subData(publicKey.bytes, 0, 64));
     // address attributes: empty map for V2, for V1 encrypted derivation path
-    Cbor::Encode emptyMap = Cbor::Encode::map({});
-    attrs = emptyMap.encoded();
+    attrs = Cbor::Writer().map(0).release();
 }
 
 Data AddressV2::getCborData() const {
     // put together string representation, CBOR representation
     // inner data: pubkey, attrs, type
-    auto cbor1 = Cbor::Encode::array({
-        Cbor::Encode::bytes(root),
-        Cbor::Encode::fromRaw(attrs),
-        Cbor::Encode::uint(type),
-    });
-    auto payloadData = cbor1.encoded();
+    const auto payloadData = Cbor::Writer(root.size() + attrs.size() + 12)
+        .array(3).bytes(root).raw(attrs).uint(type)
+        .release();
 
     // crc checksum
     auto crc = TW::Crc::crc32(payloadData);
     // second pack: tag, base, crc
-    auto cbor2 = Cbor::Encode::array({
-        Cbor::Encode::tag(PayloadTag, Cbor::Encode::bytes(payloadData)),
-        Cbor::Encode::uint(crc),
-    });
-    return cbor2.encoded();
+    return Cbor::Writer(payloadData.size() + 16)
+        .array(2).tag(PayloadTag).bytes(payloadData).uint(crc)
+        .release();
 }
 
 std::string AddressV2::string() const {
@@ -109,14 +179,9 @@ Data AddressV2::keyHash(const TW::Data& xpub) {
     }
     // hash of following Cbor-array: [0, [0, xpub], {} ]
     // 3rd entry map is empty map for V2, contains derivation path for V1
-    // clang-format off
-    Data cborData = Cbor::Encode::array({
-        Cbor::Encode::uint(0),
-        Cbor::Encode::array({Cbor::Encode::uint(0),
-                                Cbor::Encode::bytes(xpub)}),
-        Cbor::Encode::map({}),
-    }).encoded();
-    // clang-format on
+    const auto cborData = Cbor::Writer(xpub.size() + 8)
+        .array(3).uint(0).array(2).uint(0).bytes(xpub).map(0)
+        .release();
     // SHA3 hash, then blake
     Data firstHash = Hash::sha3_256(cborData);
     Data blake = Hash::blake2b(firstHash, 28);
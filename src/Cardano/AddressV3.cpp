@@ -9,8 +9,10 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include "../Bech32.h"
 #include "../Base32.h"
+#include "../Blake2b.h"
 #include "../HexCoding.h"
 
+#include <algorithm>
 #include <array>
 
 namespace TW::Cardano {
@@ -30,57 +32,100 @@ bool AddressV3::checkLength(Kind kind, size_t length) noexcept {
     }
 }
 
-bool AddressV3::parseAndCheckV3(const Data& raw, NetworkId& networkId, Kind& kind, Data& bytes) noexcept {
-    if (raw.empty()) {
+namespace {
+
+/// Longest string accepted by bech32.
+constexpr std::size_t maxBechSize = 120;
+/// Bytes of the longest data part of a bech32 string.
+constexpr std::size_t maxRawSize = Bech32::convertedSize<5, 8, false>(maxBechSize);
+
+using RawBuffer = std::array<byte, maxRawSize>;
+
+bool checkRaw(const byte* raw, std::size_t size, AddressV3::NetworkId& networkId, AddressV3::Kind& kind) noexcept {
+    if (size == 0) {
         // too short, cannot extract kind and networkId
         return false;
     }
-    kind = kindFromFirstByte(raw[0]);
-    networkId = networkIdFromFirstByte(raw[0]);
-    if (networkId != Network_Production) {
+    kind = AddressV3::kindFromFirstByte(raw[0]);
+    networkId = AddressV3::networkIdFromFirstByte(raw[0]);
+    if (networkId != AddressV3::Network_Production) {
+        return false;
+    }
+    return AddressV3::checkLength(kind, size);
+}
+
+/// Decodes and checks a string address into `raw` on the stack, `rawSize` bytes: first byte and keys.
+bool parseString(const std::string& addr, AddressV3::NetworkId& networkId, AddressV3::Kind& kind, RawBuffer& raw, std::size_t& rawSize) noexcept {
+    std::size_t separator = 0;
+    if (Bech32::verify(addr, separator) == Bech32::None) {
+        return false;
+    }
+    // data part, without the checksum
+    const auto valueCount = addr.size() - separator - 1 - 6;
+    if (valueCount == 0) {
+        // empty Bech data
         return false;
     }
+    std::array<byte, maxBechSize> values;
+    for (std::size_t i = 0; i < valueCount; ++i) {
+        values[i] = static_cast<byte>(Bech32::valueOf(addr[separator + 1 + i]));
+    }
+    // Bech bits conversion
+    if (!Bech32::convertBits<5, 8, false>(values.data(), valueCount, raw.data(), rawSize)) {
+        return false;
+    }
+    if (!checkRaw(raw.data(), rawSize, networkId, kind)) {
+        return false;
+    }
+    // check prefix
+    return addr.starts_with(AddressV3::getHrp(kind));
+}
+
+/// Bech32 string of a raw address, converted on the stack.
+std::string encodeRaw(const std::string& hrp, const byte* raw, std::size_t size) {
+    std::array<byte, Bech32::convertedSize<8, 5, true>(maxRawSize)> values;
+    if (size > maxRawSize) {
+        // longer than any valid address, converted on the heap
+        Data bech;
+        Bech32::convertBits<8, 5, true>(bech, Data(raw, raw + size));
+        return Bech32::encode(hrp, bech, Bech32::ChecksumVariant::Bech32);
+    }
+    std::size_t valueCount = 0;
+    Bech32::convertBits<8, 5, true>(raw, size, values.data(), valueCount);
+    return Bech32::encode(hrp, values.data(), valueCount, Bech32::ChecksumVariant::Bech32);
+}
 
-    bytes = Data();
-    std::copy(cbegin(raw) + 1, cend(raw), std::back_inserter(bytes));
+} // namespace
 
-    return checkLength(kind, raw.size());
+bool AddressV3::parseAndCheckV3(const Data& raw, NetworkId& networkId, Kind& kind, Data& bytes) noexcept {
+    if (raw.empty()) {
+        return false;
+    }
+    const auto valid = checkRaw(raw.data(), raw.size(), networkId, kind);
+    if (networkId != Network_Production) {
+        return false;
+    }
+    // bytes are kept even if the length doesn't match the kind
+    bytes.assign(raw.begin() + 1, raw.end());
+    return valid;
 }
 
 bool AddressV3::parseAndCheckV3(const std::string& addr, NetworkId& networkId, Kind& kind, Data& bytes) noexcept {
-    try {
-        auto bech = Bech32::decode(addr);
-        if (std::get<1>(bech).empty()) {
-            // empty Bech data
-            return false;
-        }
-        // Bech bits conversion
-        Data conv;
-        auto success = Bech32::convertBits<5, 8, false>(conv, std::get<1>(bech));
-        if (!success) {
-            return false;
-        }
-
-        if (!parseAndCheckV3(conv, networkId, kind, bytes)) {
-            return false;
-        }
-
-        // check prefix
-        if (const auto expectedHrp = getHrp(kind); !addr.starts_with(expectedHrp)) {
-            return false;
-        }
-
-        return true;
-    } catch (...) {
+    RawBuffer raw;
+    std::size_t rawSize = 0;
+    if (!parseString(addr, networkId, kind, raw, rawSize)) {
         return false;
     }
+    bytes.assign(raw.begin() + 1, raw.begin() + rawSize);
+    return true;
 }
 
 bool AddressV3::isValid(const std::string& addr) {
     NetworkId networkId;
     Kind kind;
-    Data key;
-    return parseAndCheckV3(addr, networkId, kind, key);
+    RawBuffer raw;
+    std::size_t rawSize = 0;
+    return parseString(addr, networkId, kind, raw, rawSize);
 }
 
 bool AddressV3::isValidLegacy(const std::string& addr) {
@@ -114,6 +159,24 @@ AddressV3 AddressV3::createBase(NetworkId networkId, const TW::Data& spendingKey
     return addr;
 }
 
+std::vector<AddressV3> AddressV3::createBaseBatch(NetworkId networkId, std::span<const Data> spendingKeys, const Data& stakingKey) {
+    if (stakingKey.size() != 32 || std::any_of(spendingKeys.begin(), spendingKeys.end(), [](const auto& key) { return key.size() != 32; })) {
+        throw std::invalid_argument("Wrong spending key size");
+    }
+    static const Blake2b::Context hasher(HashSize);
+    const auto stakingKeyHash = hasher.hash(stakingKey);
+    Data spendingKeyHashes(spendingKeys.size() * HashSize);
+    hasher.hashBatch(spendingKeys, spendingKeyHashes.data());
+
+    std::vector<AddressV3> addresses;
+    addresses.reserve(spendingKeys.size());
+    for (std::size_t i = 0; i < spendingKeys.size(); ++i) {
+        const auto* hash = spendingKeyHashes.data() + i * HashSize;
+        addresses.push_back(createBase(networkId, Data(hash, hash + HashSize), stakingKeyHash));
+    }
+    return addresses;
+}
+
 AddressV3 AddressV3::createBase(NetworkId networkId, const PublicKey& spendingKey, const PublicKey& stakingKey) {
     if (spendingKey.bytes.size() != 32) {
         throw std::invalid_argument("Wrong spending key size");
@@ -122,8 +185,8 @@ AddressV3 AddressV3::createBase(NetworkId networkId, const PublicKey& spendingKe
         throw std::invalid_argument("Wrong spending key size");
     }
 
-    const Data hash1 = blakeHash(spendingKey.bytes);
-    const Data hash2 = blakeHash(stakingKey.bytes);
+    const Data hash1 = blakeHash(Data(spendingKey.bytes));
+    const Data hash2 = blakeHash(Data(stakingKey.bytes));
     return createBase(networkId, hash1, hash2);
 }
 
@@ -196,13 +259,14 @@ std::string AddressV3::string(const std::string& hrp) const {
         return legacyAddressV2->string();
     }
 
-    const Data raw = data();
-    // bech
-    Data bech;
-    if (!Bech32::convertBits<8, 5, true>(bech, raw)) {
-        return "";
+    if (bytes.size() >= maxRawSize) {
+        const Data raw = data();
+        return encodeRaw(hrp, raw.data(), raw.size());
     }
-    return Bech32::encode(hrp, bech, Bech32::ChecksumVariant::Bech32);
+    RawBuffer raw;
+    raw[0] = firstByte(networkId, kind);
+    std::copy(bytes.begin(), bytes.end(), raw.begin() + 1);
+    return encodeRaw(hrp, raw.data(), 1 + bytes.size());
 }
 
 Data AddressV3::data() const noexcept {
@@ -210,9 +274,9 @@ Data AddressV3::data() const noexcept {
         return legacyAddressV2->getCborData();
     }
 
-    const byte first = firstByte(networkId, kind);
     Data raw;
-    TW::append(raw, first);
+    raw.reserve(1 + bytes.size());
+    TW::append(raw, firstByte(networkId, kind));
     TW::append(raw, bytes);
     return raw;
 }
@@ -221,8 +285,10 @@ std::string AddressV3::getStakingAddress() const noexcept {
     if (kind != Kind_Base || bytes.size() != (2 * HashSize)) {
         return "";
     }
-    const auto& stakingKeyHash = TW::subData(bytes, HashSize, HashSize);
-    return createReward(this->networkId, stakingKeyHash).string();
+    std::array<byte, EncodedSize1> raw;
+    raw[0] = firstByte(networkId, Kind_Reward);
+    std::copy(bytes.begin() + HashSize, bytes.end(), raw.begin() + 1);
+    return encodeRaw(getHrp(Kind_Reward), raw.data(), raw.size());
 }
 
 } // namespace TW::Cardano
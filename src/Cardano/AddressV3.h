@@ -12,6 +12,8 @@
 
 #include <string>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace TW::Cardano {
 
@@ -65,6 +67,10 @@ class AddressV3 {
     /// Create a base address, given public keys
     static AddressV3 createBase(NetworkId networkId, const PublicKey& spendingKey, const PublicKey& stakingKey);
 
+    /// Create the base addresses of spending public keys (32 bytes each) sharing a staking public key;
+    /// the spending keys are hashed as a batch.
+    static std::vector<AddressV3> createBaseBatch(NetworkId networkId, std::span<const Data> spendingKeys, const Data& stakingKey);
+
     /// Create a staking (reward) address, given a staking key
     static AddressV3 createReward(NetworkId networkId, const TW::Data& stakingKeyHash);
 
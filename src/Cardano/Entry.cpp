@@ -9,6 +9,8 @@
 #include "AddressV3.h"
 #include "Signer.h"
 
+#include <algorithm>
+
 namespace TW::Cardano {
 
 // Note: avoid business logic from here, rather just call into classes like Address, Signer, etc.
@@ -21,6 +23,30 @@ std::string Entry::deriveAddress([[maybe_unused]] TWCoinType coin, const PublicK
     return AddressV3(publicKey).string();
 }
 
+std::vector<std::string> Entry::deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const {
+    // the spending keys are hashed together when the keys share their staking key, as the keys of one account do
+    const auto shared = !publicKeys.empty() && std::all_of(publicKeys.begin(), publicKeys.end(), [&](const auto& publicKey) {
+        return publicKey.type == TWPublicKeyTypeED25519Cardano && publicKey.bytes.size() == PublicKey::cardanoKeySize &&
+               std::equal(publicKey.bytes.begin() + 64, publicKey.bytes.begin() + 96, publicKeys.front().bytes.begin() + 64);
+    });
+    if (!shared) {
+        return CoinEntry::deriveAddresses(coin, publicKeys, derivation, addressPrefix);
+    }
+
+    std::vector<Data> spendingKeys;
+    spendingKeys.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        spendingKeys.push_back(subData(publicKey.bytes, 0, 32));
+    }
+    const auto baseAddresses = AddressV3::createBaseBatch(AddressV3::Network_Production, spendingKeys, subData(publicKeys.front().bytes, 64, 32));
+    std::vector<std::string> addresses;
+    addresses.reserve(baseAddresses.size());
+    for (const auto& address : baseAddresses) {
+        addresses.push_back(address.string());
+    }
+    return addresses;
+}
+
 Data Entry::addressToData([[maybe_unused]] TWCoinType coin, const std::string& address) const {
     return AddressV3(address).data();
 }
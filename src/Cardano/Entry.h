@@ -16,6 +16,7 @@ class Entry final : public CoinEntry {
 public:
     bool validateAddress(TWCoinType coin, const std::string& address, const PrefixVariant& addressPrefix) const;
      std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const;
+     std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const;
      Data addressToData(TWCoinType coin, const std::string& address) const;
      void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
      void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
@@ -15,11 +15,13 @@
 #include <cassert>
 #include <cmath>
 #include <numeric>
+#include <set>
+#include <unordered_set>
 #include <vector>
 
 namespace TW::Cardano {
 
-static const Data placeholderPrivateKey = parse_hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+static constexpr auto placeholderPrivateKeyHex = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
 static const auto PlaceholderFee = 170000;
 static const auto ExtraInputAmount = 500000;
 
@@ -48,7 +50,7 @@ Common::Proto::SigningError Signer::buildTransactionAux(Transaction& tx, const P
     const auto toAddress = AddressV3(input.transfer_message().to_address());
     tx.outputs.emplace_back(toAddress.data(), plan.amount, plan.outputTokens);
     // Change
-    bool hasChangeToken = any_of(plan.changeTokens.bundle.begin(), plan.changeTokens.bundle.end(), [](auto&& t) { return t.second.amount > 0; });
+    bool hasChangeToken = any_of(plan.changeTokens.begin(), plan.changeTokens.end(), [](auto&& t) { return t.amount > 0; });
     if (plan.change > 0 || hasChangeToken) {
         if (!AddressV3::isValidLegacy(input.transfer_message().change_address())) {
             return Common::Proto::Error_invalid_address;
@@ -99,6 +101,39 @@ Data deriveStakingPrivateKey(const Data& privateKeyData) {
     return stakingPrivKeyData;
 }
 
+// Collect every unique address that needs a signature: input UTXO addresses and staking addresses, preserving order
+Common::Proto::SigningError collectSigningAddresses(std::vector<std::string>& addressesUnique, const Proto::SigningInput& input, const TransactionPlan& plan) {
+    std::vector<std::string> addresses;
+    for (auto& u : plan.utxos) {
+        if (!AddressV3::isValid(u.address)) {
+            return Common::Proto::Error_invalid_address;
+        }
+        addresses.emplace_back(u.address);
+    }
+    // Staking key is also an address that needs signature
+    if (input.has_register_staking_key()) {
+        addresses.emplace_back(input.register_staking_key().staking_address());
+    }
+    if (input.has_deregister_staking_key()) {
+        addresses.emplace_back(input.deregister_staking_key().staking_address());
+    }
+    if (input.has_delegate()) {
+        addresses.emplace_back(input.delegate().staking_address());
+    }
+    if (input.has_withdraw()) {
+        addresses.emplace_back(input.withdraw().staking_address());
+    }
+    // discard duplicates, preserving order of first occurrence
+    addressesUnique.clear();
+    std::unordered_set<std::string> seen;
+    for (auto& a: addresses) {
+        if (seen.insert(a).second) {
+            addressesUnique.emplace_back(a);
+        }
+    }
+    return Common::Proto::OK;
+}
+
 Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Data, Data>>& signatures, const Proto::SigningInput& input, const TransactionPlan& plan, const Data& txId, bool sizeEstimationOnly) {
     signatures.clear();
     // Private keys and corresponding addresses
@@ -122,33 +157,10 @@ Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Dat
         }
     }
 
-    // collect every unique input UTXO address, preserving order
-    std::vector<std::string> addresses;
-    for (auto& u : plan.utxos) {
-        if (!AddressV3::isValid(u.address)) {
-            return Common::Proto::Error_invalid_address;
-        }
-        addresses.emplace_back(u.address);
-    }
-    // Staking key is also an address that needs signature
-    if (input.has_register_staking_key()) {
-        addresses.emplace_back(input.register_staking_key().staking_address());
-    }
-    if (input.has_deregister_staking_key()) {
-        addresses.emplace_back(input.deregister_staking_key().staking_address());
-    }
-    if (input.has_delegate()) {
-        addresses.emplace_back(input.delegate().staking_address());
-    }
-    if (input.has_withdraw()) {
-        addresses.emplace_back(input.withdraw().staking_address());
-    }
-    // discard duplicates (std::set, std::copy_if, std::unique does not work well here)
     std::vector<std::string> addressesUnique;
-    for (auto& a: addresses) {
-        if (find(addressesUnique.begin(), addressesUnique.end(), a) == addressesUnique.end()) {
-            addressesUnique.emplace_back(a);
-        }
+    const auto addressError = collectSigningAddresses(addressesUnique, input, plan);
+    if (addressError != Common::Proto::OK) {
+        return addressError;
     }
 
     // create signature for each address
@@ -160,7 +172,7 @@ Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Dat
         } else {
             // private key not found
             if (sizeEstimationOnly) {
-                privateKeyData = placeholderPrivateKey;
+                privateKeyData = parse_hex(placeholderPrivateKeyHex);
             } else {
                 return Common::Proto::Error_missing_private_key;
             }
@@ -175,25 +187,12 @@ Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Dat
     return Common::Proto::OK;
 }
 
-Cbor::Encode cborizeSignatures(const std::vector<std::pair<Data, Data>>& signatures) {
+void writeSignatures(Cbor::Writer& writer, const std::vector<std::pair<Data, Data>>& signatures) {
     // signatures as Cbor
-    // clang-format off
-    std::vector<Cbor::Encode> sigsCbor;
+    writer.map(1).uint(0).array(signatures.size());
     for (auto& s : signatures) {
-        sigsCbor.emplace_back(Cbor::Encode::array({
-            Cbor::Encode::bytes(s.first),
-            Cbor::Encode::bytes(s.second)
-        }));
+        writer.array(2).bytes(s.first).bytes(s.second);
     }
-
-    // Cbor-encode txAux & signatures
-    return Cbor::Encode::map({
-        std::make_pair(
-            Cbor::Encode::uint(0),
-            Cbor::Encode::array(sigsCbor)
-        )
-    });
-    // clang-format on
 }
 
 Proto::SigningOutput Signer::signWithPlan() const {
@@ -236,33 +235,42 @@ Common::Proto::SigningError Signer::encodeTransaction(Data& encoded, Data& txId,
     if (sigError != Common::Proto::OK) {
         return sigError;
     }
-    const auto sigsCbor = cborizeSignatures(signatures);
 
     // Cbor-encode txAux & signatures
-    const auto cbor = Cbor::Encode::array({
-        // txaux
-        Cbor::Encode::fromRaw(txAux.encode()),
-        // signatures
-        sigsCbor,
-        // aux data
-        Cbor::Encode::null(),
-    });
-    encoded = cbor.encoded();
+    Cbor::Writer writer;
+    writer.array(3);
+    // txaux
+    writer.raw(txAux.encode());
+    // signatures
+    writeSignatures(writer, signatures);
+    // aux data
+    writer.null();
+    encoded = writer.release();
     return Common::Proto::OK;
 }
 
+// Indices of inputs, sorted descending by the given per-input amounts (same order as sorting the inputs themselves)
+template <typename T>
+std::vector<std::size_t> sortedIndicesDescending(const std::vector<T>& amounts) {
+    std::vector<std::size_t> indices(amounts.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::sort(indices.begin(), indices.end(), [&amounts](auto i1, auto i2) { return amounts[i1] > amounts[i2]; });
+    return indices;
+}
+
 // Select a subset of inputs, to cover desired coin amount. Simple algorithm: pick the largest ones.
 std::vector<TxInput> selectInputsSimpleNative(const std::vector<TxInput>& inputs, Amount amount) {
-    auto ii = std::vector<TxInput>(inputs);
-    sort(ii.begin(), ii.end(), [](auto&& t1, auto&& t2) {
-        return t1.amount > t2.amount;
-    });
+    std::vector<Amount> amounts;
+    amounts.reserve(inputs.size());
+    for (const auto& i : inputs) {
+        amounts.emplace_back(i.amount);
+    }
     auto selected = std::vector<TxInput>();
     Amount selectedAmount = 0;
 
-    for (const auto& i : ii) {
-        selected.emplace_back(i);
-        selectedAmount += i.amount;
+    for (const auto idx : sortedIndicesDescending(amounts)) {
+        selected.emplace_back(inputs[idx]);
+        selectedAmount += inputs[idx].amount;
         if (selectedAmount >= amount) {
             break;
         }
@@ -271,17 +279,26 @@ std::vector<TxInput> selectInputsSimpleNative(const std::vector<TxInput>& inputs
 }
 
 // Select a subset of inputs, to cover desired token amount. Simple algorithm: pick the largest ones.
-void selectInputsSimpleToken(const std::vector<TxInput>& inputs, std::string key, const uint256_t& amount, std::vector<TxInput>& selectedInputs) {
-    auto accumulateFunctor = [key]([[maybe_unused]] auto&& sum, auto&& si) { return si.tokenBundle.getAmount(key); };
+void selectInputsSimpleToken(const std::vector<TxInput>& inputs, const TokenAmount& token, std::vector<TxInput>& selectedInputs) {
+    const auto& amount = token.amount;
+    auto accumulateFunctor = [&token]([[maybe_unused]] auto&& sum, auto&& si) { return si.tokenBundle.getAmount(token.policyId, token.assetName); };
     uint256_t selectedAmount = std::accumulate(selectedInputs.begin(), selectedInputs.end(), uint256_t(0), accumulateFunctor);
     if (selectedAmount >= amount) {
         return; // already covered
     }
+    std::set<std::pair<Data, uint64_t>> selectedOutPoints;
+    for (const auto& si : selectedInputs) {
+        selectedOutPoints.emplace(si.txHash, si.outputIndex);
+    }
     // sort inputs descending
-    auto ii = std::vector<TxInput>(inputs);
-    std::sort(ii.begin(), ii.end(), [key](auto&& t1, auto&& t2) { return t1.tokenBundle.getAmount(key) > t2.tokenBundle.getAmount(key); });
-    for (const auto& i : ii) {
-        if (static_cast<std::size_t>(distance(selectedInputs.begin(), find(selectedInputs.begin(), selectedInputs.end(), i))) < selectedInputs.size()) {
+    std::vector<uint256_t> tokenAmounts;
+    tokenAmounts.reserve(inputs.size());
+    for (const auto& i : inputs) {
+        tokenAmounts.emplace_back(i.tokenBundle.getAmount(token.policyId, token.assetName));
+    }
+    for (const auto idx : sortedIndicesDescending(tokenAmounts)) {
+        const auto& i = inputs[idx];
+        if (!selectedOutPoints.emplace(i.txHash, i.outputIndex).second) {
             // already selected
             continue;
         }
@@ -297,8 +314,8 @@ void selectInputsSimpleToken(const std::vector<TxInput>& inputs, std::string key
 // Select a subset of inputs, to cover desired amount. Simple algorithm: pick the largest ones
 std::vector<TxInput> Signer::selectInputsWithTokens(const std::vector<TxInput>& inputs, Amount amount, const TokenBundle& requestedTokens) {
     auto selected = selectInputsSimpleNative(inputs, amount);
-    for (auto&& [_, curAmount] : requestedTokens.bundle) {
-        selectInputsSimpleToken(inputs, curAmount.key(), curAmount.amount, selected);
+    for (const auto& token : requestedTokens) {
+        selectInputsSimpleToken(inputs, token, selected);
     }
     return selected;
 }
@@ -310,9 +327,7 @@ TransactionPlan simplePlan(Amount amount, const TokenBundle& requestedTokens, co
     plan.availableAmount = 0;
     for (auto& u : plan.utxos) {
         plan.availableAmount += u.amount;
-        for (auto && [_, curAmount] : u.tokenBundle.bundle) {
-            plan.availableTokens.add(curAmount);
-        }
+        plan.availableTokens.add(u.tokenBundle);
     }
     plan.fee = PlaceholderFee; // placeholder value
     const auto availAfterDeposit = plan.availableAmount + plan.undeposit - plan.deposit;
@@ -329,13 +344,7 @@ TransactionPlan simplePlan(Amount amount, const TokenBundle& requestedTokens, co
 
     // compute change
     plan.change = availAfterDeposit - (plan.amount + plan.fee);
-    for (auto iter = plan.availableTokens.bundle.begin(); iter != plan.availableTokens.bundle.end(); ++iter) {
-        const auto key = iter->second.key();
-        const auto changeAmount = iter->second.amount - plan.outputTokens.getAmount(key);
-        assert(changeAmount >= 0);
-        plan.changeTokens.bundle[key] = iter->second;
-        plan.changeTokens.bundle[key].amount = changeAmount;
-    }
+    plan.changeTokens = plan.availableTokens.subtract(plan.outputTokens, true);
     return plan;
 }
 
@@ -362,23 +371,34 @@ uint64_t sumUndeposits(const Proto::SigningInput& input) {
 }
 
 // Estimates size of transaction in bytes.
+// The size is computed from the encoded transaction body and the known size of the signatures,
+// without deriving keys and signing with placeholders; it equals the size of the transaction signed in
+// size estimation mode.
 uint64_t estimateTxSize(const Proto::SigningInput& input, Amount amount, const TokenBundle& requestedTokens, const std::vector<TxInput>& selectedInputs) {
-    auto inputs = std::vector<TxInput>();
-    for (auto i = 0; i < input.utxos_size(); ++i) {
-        inputs.emplace_back(TxInput::fromProto(input.utxos(i)));
-    }
     const auto deposits = sumDeposits(input);
     const uint64_t undeposits = sumUndeposits(input);
     const auto _simplePlan = simplePlan(amount, requestedTokens, selectedInputs, input.transfer_message().use_max_amount(), deposits, undeposits);
 
-    Data encoded;
-    Data txId;
-    const auto encodeError = Signer::encodeTransaction(encoded, txId, input, _simplePlan, true);
-    if (encodeError != Common::Proto::OK) {
+    Transaction txAux;
+    if (Signer::buildTransactionAux(txAux, input, _simplePlan) != Common::Proto::OK) {
+        return 0;
+    }
+    for (auto i = 0; i < input.private_key_size(); ++i) {
+        if (!PrivateKey::isValid(data(input.private_key(i)))) {
+            return 0;
+        }
+    }
+    std::vector<std::string> addresses;
+    if (collectSigningAddresses(addresses, input, _simplePlan) != Common::Proto::OK) {
         return 0;
     }
 
-    return encoded.size();
+    // one signature entry: [public key (32 bytes), signature (64 bytes)]
+    const auto signatureSize = 1 + Cbor::Writer::headerSize(32) + 32 + Cbor::Writer::headerSize(64) + 64;
+    // signatures: {0: [entries]}
+    const auto signaturesSize = 1 + 1 + Cbor::Writer::headerSize(addresses.size()) + addresses.size() * signatureSize;
+    // [txaux, signatures, null]
+    return 1 + txAux.encode().size() + signaturesSize + 1;
 }
 
 // Compute fee from tx size, with some over-estimation
@@ -455,9 +475,7 @@ TransactionPlan Signer::doPlan() const {
     plan.availableAmount = 0;
     for (auto& u : plan.utxos) {
         plan.availableAmount += u.amount;
-        for (auto && [_, curAmount] : u.tokenBundle.bundle) {
-            plan.availableTokens.add(curAmount);
-        }
+        plan.availableTokens.add(u.tokenBundle);
     }
     if (plan.availableAmount == 0) {
         plan.error = Common::Proto::Error_missing_input_utxos;
@@ -474,8 +492,8 @@ TransactionPlan Signer::doPlan() const {
     }
     assert(plan.amount <= availableAmountAfterDeposit);
     // check that there are enough tokens in the inputs
-    for (auto && [_, curAmount] : requestedTokens.bundle) {
-        if (curAmount.amount > plan.availableTokens.getAmount(curAmount.key())) {
+    for (const auto& token : requestedTokens) {
+        if (token.amount > plan.availableTokens.getAmount(token.policyId, token.assetName)) {
             plan.error = Common::Proto::Error_low_balance;
             return plan;
         }
@@ -515,14 +533,7 @@ TransactionPlan Signer::doPlan() const {
 
     // compute change
     plan.change = availableAmountAfterDeposit - (plan.amount + plan.fee);
-    for (auto iter = plan.availableTokens.bundle.begin(); iter != plan.availableTokens.bundle.end(); ++iter) {
-        const auto key = iter->second.key();
-        const auto changeAmount = iter->second.amount - plan.outputTokens.getAmount(key);
-        if (changeAmount > 0) { // omit 0-amount tokens
-            plan.changeTokens.bundle[key] = iter->second;
-            plan.changeTokens.bundle[key].amount = changeAmount;
-        }
-    }
+    plan.changeTokens = plan.availableTokens.subtract(plan.outputTokens); // omit 0-amount tokens
 
     assert(plan.change >= 0 && plan.change <= availableAmountAfterDeposit);
     assert(!maxAmount || plan.change == 0); // change is 0 in max amount case
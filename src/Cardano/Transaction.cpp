@@ -11,6 +11,11 @@
 #include "HexCoding.h"
 #include "Numeric.h"
 
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <tuple>
+
 namespace TW::Cardano {
 
 TokenAmount TokenAmount::fromProto(const Proto::TokenAmount& proto) {
@@ -26,6 +31,20 @@ Proto::TokenAmount TokenAmount::toProto() const {
     return tokenAmount;
 }
 
+/// Order of the token amounts of a TokenBundle.
+static bool tokenLess(const TokenAmount& lhs, const TokenAmount& rhs) {
+    return std::tie(lhs.policyId, lhs.assetName) < std::tie(rhs.policyId, rhs.assetName);
+}
+
+static bool sameToken(const TokenAmount& lhs, const TokenAmount& rhs) {
+    return lhs.policyId == rhs.policyId && lhs.assetName == rhs.assetName;
+}
+
+/// End of the run of tokens with the policy ID of `first`.
+static std::vector<TokenAmount>::const_iterator policyEnd(std::vector<TokenAmount>::const_iterator first, std::vector<TokenAmount>::const_iterator end) {
+    return std::find_if(first, end, [&first](const TokenAmount& t) { return t.policyId != first->policyId; });
+}
+
 TokenBundle TokenBundle::fromProto(const Proto::TokenBundle& proto) {
     TokenBundle ret;
     const auto addFunctor =  [&ret](auto&& cur) { ret.add(TokenAmount::fromProto(cur)); };
@@ -35,40 +54,86 @@ TokenBundle TokenBundle::fromProto(const Proto::TokenBundle& proto) {
 
 Proto::TokenBundle TokenBundle::toProto() const {
     Proto::TokenBundle proto;
-    for (const auto& t : bundle) {
-        *(proto.add_token()) = t.second.toProto();
+    for (const auto& t : tokens) {
+        *(proto.add_token()) = t.toProto();
     }
     return proto;
 }
 
 void TokenBundle::add(const TokenAmount& ta) {
-    const auto key = ta.key();
-    if (auto&& [it, inserted] = bundle.try_emplace(key, ta); !inserted) {
-        it->second.amount += ta.amount;
+    // tokens mostly come in order, appended at the end
+    const auto it = std::lower_bound(tokens.begin(), tokens.end(), ta, tokenLess);
+    if (it != tokens.end() && sameToken(*it, ta)) {
+        it->amount += ta.amount;
+    } else {
+        tokens.insert(it, ta);
+    }
+}
+
+void TokenBundle::add(const TokenBundle& other) {
+    std::vector<TokenAmount> merged;
+    merged.reserve(tokens.size() + other.tokens.size());
+    auto lhs = tokens.begin();
+    auto rhs = other.tokens.begin();
+    while (lhs != tokens.end() || rhs != other.tokens.end()) {
+        if (rhs == other.tokens.end() || (lhs != tokens.end() && tokenLess(*lhs, *rhs))) {
+            merged.emplace_back(std::move(*lhs++));
+        } else if (lhs == tokens.end() || tokenLess(*rhs, *lhs)) {
+            merged.emplace_back(*rhs++);
+        } else {
+            merged.emplace_back(std::move(*lhs++));
+            merged.back().amount += (rhs++)->amount;
+        }
     }
+    tokens = std::move(merged);
+}
+
+TokenBundle TokenBundle::subtract(const TokenBundle& other, bool keepZero) const {
+    TokenBundle ret;
+    ret.tokens.reserve(tokens.size());
+    auto rhs = other.tokens.begin();
+    for (const auto& t : tokens) {
+        while (rhs != other.tokens.end() && tokenLess(*rhs, t)) {
+            ++rhs;
+        }
+        auto amount = t.amount;
+        if (rhs != other.tokens.end() && sameToken(*rhs, t)) {
+            amount = amount > rhs->amount ? amount - rhs->amount : 0;
+        }
+        if (amount > 0 || keepZero) {
+            ret.tokens.emplace_back(t.policyId, t.assetName, amount);
+        }
+    }
+    return ret;
+}
+
+uint256_t TokenBundle::getAmount(const std::string& policyId, const std::string& assetName) const {
+    const auto key = std::tie(policyId, assetName);
+    const auto it = std::lower_bound(tokens.begin(), tokens.end(), key,
+                                     [](const TokenAmount& t, const auto& k) { return std::tie(t.policyId, t.assetName) < k; });
+    return it == tokens.end() || it->policyId != policyId || it->assetName != assetName ? 0 : it->amount;
 }
 
 uint256_t TokenBundle::getAmount(const std::string& key) const {
-    const auto& findkey = bundle.find(key);
-    return findkey == bundle.end() ? 0 : findkey->second.amount;
+    const auto separator = key.find('_');
+    if (separator == std::string::npos) {
+        return 0;
+    }
+    return getAmount(key.substr(0, separator), key.substr(separator + 1));
 }
 
 std::unordered_set<std::string> TokenBundle::getPolicyIds() const {
     std::unordered_set<std::string> policyIds;
-    std::transform(bundle.cbegin(), bundle.cend(),
-                   std::inserter(policyIds, policyIds.begin()),
-                   [](auto&& cur) { return cur.second.policyId; });
+    for (auto first = tokens.begin(); first != tokens.end(); first = policyEnd(first, tokens.end())) {
+        policyIds.emplace(first->policyId);
+    }
     return policyIds;
 }
 
 std::vector<TokenAmount> TokenBundle::getByPolicyId(const std::string& policyId) const {
-    std::vector<TokenAmount> filtered;
-    for (auto&& t : bundle) {
-        if (t.second.policyId == policyId) {
-            filtered.emplace_back(t.second);
-        }
-    }
-    return filtered;
+    const auto first = std::lower_bound(tokens.begin(), tokens.end(), policyId,
+                                        [](const TokenAmount& t, const std::string& p) { return t.policyId < p; });
+    return {first, policyEnd(first, tokens.end())};
 }
 
 uint64_t roundupBytesToWords(uint64_t b) {
@@ -97,19 +162,41 @@ uint64_t TokenBundle::minAdaAmount() const {
         return MinUtxoValue;
     }
 
-    std::unordered_set<std::string> policyIdRegistry;
-    std::unordered_set<std::string> assetNameRegistry;
+    uint64_t numPids = 0;
+    std::unordered_set<std::string_view> assetNameRegistry;
     uint64_t sumAssetNameLengths = 0;
-    for (const auto& t : bundle) {
-        policyIdRegistry.emplace(t.second.policyId);
-        if (t.second.assetName.length() > 0) {
-            assetNameRegistry.emplace(t.second.assetName);
+    for (auto first = tokens.begin(); first != tokens.end();) {
+        const auto last = policyEnd(first, tokens.end());
+        ++numPids;
+        for (; first != last; ++first) {
+            if (!first->assetName.empty() && assetNameRegistry.emplace(first->assetName).second) {
+                sumAssetNameLengths += first->assetName.length();
+            }
         }
     }
-    auto numPids = uint64_t(policyIdRegistry.size());
-    auto numAssets = uint64_t(assetNameRegistry.size());
-    for_each(assetNameRegistry.begin(), assetNameRegistry.end(), [&sumAssetNameLengths](auto&& a) { sumAssetNameLengths += a.length(); });
-    return minAdaAmountHelper(numPids, numAssets, sumAssetNameLengths);
+    return minAdaAmountHelper(numPids, uint64_t(assetNameRegistry.size()), sumAssetNameLengths);
+}
+
+std::size_t TokenBundle::encodedSize() const {
+    // per policy: the encoded key and the size of its asset map; like in `cborMapOrder`, only the first of
+    // policies with the same encoded key is written
+    std::vector<std::pair<Data, std::size_t>> policies;
+    for (auto first = tokens.begin(); first != tokens.end();) {
+        const auto last = policyEnd(first, tokens.end());
+        auto assetsSize = Cbor::Writer::headerSize(static_cast<uint64_t>(std::distance(first, last)));
+        for (auto it = first; it != last; ++it) {
+            assetsSize += Cbor::Writer::headerSize(it->assetName.size()) + it->assetName.size() + Cbor::Writer::headerSize(uint64_t(it->amount));
+        }
+        policies.emplace_back(parse_hex(first->policyId), assetsSize);
+        first = last;
+    }
+    std::stable_sort(policies.begin(), policies.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    policies.erase(std::unique(policies.begin(), policies.end(), [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }), policies.end());
+    auto size = Cbor::Writer::headerSize(policies.size());
+    for (const auto& [key, assetsSize] : policies) {
+        size += Cbor::Writer::headerSize(key.size()) + key.size() + assetsSize;
+    }
+    return size;
 }
 
 TxInput TxInput::fromProto(const Cardano::Proto::TxInput& proto) {
@@ -131,8 +218,8 @@ Proto::TxInput TxInput::toProto() const {
     txInput.mutable_out_point()->set_output_index(outputIndex);
     txInput.set_address(address.data(), address.size());
     txInput.set_amount(amount);
-    for (const auto& token : tokenBundle.bundle) {
-        *txInput.add_token_amount() = token.second.toProto();
+    for (const auto& token : tokenBundle) {
+        *txInput.add_token_amount() = token.toProto();
     }
     return txInput;
 }
@@ -173,14 +260,14 @@ Proto::TransactionPlan TransactionPlan::toProto() const {
     plan.set_change(change);
     plan.set_deposit(deposit);
     plan.set_undeposit(undeposit);
-    for (const auto& token : availableTokens.bundle) {
-        *plan.add_available_tokens() = token.second.toProto();
+    for (const auto& token : availableTokens) {
+        *plan.add_available_tokens() = token.toProto();
     }
-    for (const auto& token : outputTokens.bundle) {
-        *plan.add_output_tokens() = token.second.toProto();
+    for (const auto& token : outputTokens) {
+        *plan.add_output_tokens() = token.toProto();
     }
-    for (const auto& token : changeTokens.bundle) {
-        *plan.add_change_tokens() = token.second.toProto();
+    for (const auto& token : changeTokens) {
+        *plan.add_change_tokens() = token.toProto();
     }
     for (const auto& u : utxos) {
         *plan.add_utxos() = u.toProto();
@@ -189,120 +276,115 @@ Proto::TransactionPlan TransactionPlan::toProto() const {
     return plan;
 }
 
-Cbor::Encode cborizeInputs(const std::vector<OutPoint>& inputs) {
-    // clang-format off
-    std::vector<Cbor::Encode> ii;
+void writeInputs(Cbor::Writer& writer, const std::vector<OutPoint>& inputs) {
+    writer.array(inputs.size());
     for (const auto& i : inputs) {
-        ii.emplace_back(Cbor::Encode::array({
-            Cbor::Encode::bytes(i.txHash),
-            Cbor::Encode::uint(i.outputIndex)
-        }));
+        writer.array(2).bytes(i.txHash).uint(i.outputIndex);
     }
-    // clang-format on
-    return Cbor::Encode::array(ii);
 }
 
-Cbor::Encode cborizeOutputAmounts(const Amount& amount, const TokenBundle& tokenBundle) {
+/// Order of map entries with the given encoded keys, same as in `Cbor::Encode::map`:
+/// sorted by encoded key, and only the first of repeated keys.
+std::vector<std::size_t> cborMapOrder(const std::vector<Data>& keys) {
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](auto lhs, auto rhs) { return keys[lhs] < keys[rhs]; });
+    order.erase(std::unique(order.begin(), order.end(), [&keys](auto lhs, auto rhs) { return keys[lhs] == keys[rhs]; }), order.end());
+    return order;
+}
+
+Data cborBytes(const Data& data) {
+    return Cbor::Writer(data.size() + 9).bytes(data).release();
+}
+
+void writeOutputAmounts(Cbor::Writer& writer, const Amount& amount, const TokenBundle& tokenBundle) {
     if (tokenBundle.size() == 0) {
         // native amount only
-        return Cbor::Encode::uint(amount);
+        writer.uint(amount);
+        return;
     }
     // native and token amounts
     // tokens: organized in two levels: by policyId and by assetName
-    const auto policyIds = tokenBundle.getPolicyIds();
-    std::map<Cbor::Encode, Cbor::Encode> tokensMap;
-    for (const auto& policy : policyIds) {
-        const auto& subTokens = tokenBundle.getByPolicyId(policy);
-        std::map<Cbor::Encode, Cbor::Encode> subTokensMap;
+    std::vector<Data> policyKeys;
+    std::vector<std::vector<TokenAmount>> policyTokens;
+    for (auto first = tokenBundle.begin(); first != tokenBundle.end();) {
+        const auto last = policyEnd(first, tokenBundle.end());
+        policyKeys.emplace_back(cborBytes(parse_hex(first->policyId)));
+        policyTokens.emplace_back(first, last);
+        first = last;
+    }
+    const auto policyOrder = cborMapOrder(policyKeys);
+    writer.array(2).uint(amount).map(policyOrder.size());
+    for (const auto p : policyOrder) {
+        const auto& subTokens = policyTokens[p];
+        std::vector<Data> assetKeys;
+        assetKeys.reserve(subTokens.size());
         for (const auto& token : subTokens) {
-            subTokensMap.emplace(
-                Cbor::Encode::bytes(data(token.assetName)),
-                Cbor::Encode::uint(uint64_t(token.amount)) // 64 bits
-            );
+            assetKeys.emplace_back(cborBytes(data(token.assetName)));
+        }
+        const auto assetOrder = cborMapOrder(assetKeys);
+        writer.raw(policyKeys[p]).map(assetOrder.size());
+        for (const auto a : assetOrder) {
+            writer.raw(assetKeys[a]).uint(uint64_t(subTokens[a].amount)); // 64 bits
         }
-        tokensMap.emplace(
-            Cbor::Encode::bytes(parse_hex(policy)),
-            Cbor::Encode::map(subTokensMap));
     }
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(amount),
-        Cbor::Encode::map(tokensMap)
-    });
-    // clang-format on
 }
 
-Cbor::Encode cborizeOutput(const TxOutput& output) {
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::bytes(output.address),
-        cborizeOutputAmounts(output.amount, output.tokenBundle)
-    });
-    // clang-format on
+void writeOutput(Cbor::Writer& writer, const TxOutput& output) {
+    writer.array(2).bytes(output.address);
+    writeOutputAmounts(writer, output.amount, output.tokenBundle);
 }
 
-Cbor::Encode cborizeOutputs(const std::vector<TxOutput>& outputs) {
-    std::vector<Cbor::Encode> oo;
+void writeOutputs(Cbor::Writer& writer, const std::vector<TxOutput>& outputs) {
+    writer.array(outputs.size());
     for (const auto& o : outputs) {
-        oo.emplace_back(cborizeOutput(o));
+        writeOutput(writer, o);
     }
-    return Cbor::Encode::array(oo);
-}
-
-Cbor::Encode cborizeCertificateKey(const CertificateKey& certKey) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(certKey.type)));
-    c.emplace_back(Cbor::Encode::bytes(certKey.key));
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCert(const Certificate& cert) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(cert.type)));
-    c.emplace_back(cborizeCertificateKey(cert.certKey));
+void writeCert(Cbor::Writer& writer, const Certificate& cert) {
+    writer.array(cert.poolId.empty() ? 2 : 3).uint(static_cast<uint8_t>(cert.type));
+    writer.array(2).uint(static_cast<uint8_t>(cert.certKey.type)).bytes(cert.certKey.key);
     if (!cert.poolId.empty()) {
-        c.emplace_back(Cbor::Encode::bytes(cert.poolId));
+        writer.bytes(cert.poolId);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCerts(const std::vector<Certificate>& certs) {
-    std::vector<Cbor::Encode> c;
+void writeCerts(Cbor::Writer& writer, const std::vector<Certificate>& certs) {
+    writer.array(certs.size());
     for (const auto& i : certs) {
-        c.emplace_back(cborizeCert(i));
+        writeCert(writer, i);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeWithdrawals(const std::vector<Withdrawal>& withdrawals) {
-    std::map<Cbor::Encode, Cbor::Encode> mapElems;
+void writeWithdrawals(Cbor::Writer& writer, const std::vector<Withdrawal>& withdrawals) {
+    std::vector<Data> keys;
+    keys.reserve(withdrawals.size());
     for (const auto& w : withdrawals) {
-        mapElems.emplace(Cbor::Encode::bytes(w.stakingKey), Cbor::Encode::uint(w.amount));
+        keys.emplace_back(cborBytes(w.stakingKey));
+    }
+    const auto order = cborMapOrder(keys);
+    writer.map(order.size());
+    for (const auto i : order) {
+        writer.raw(keys[i]).uint(withdrawals[i].amount);
     }
-    return Cbor::Encode::map(mapElems);
 }
 
 Data Transaction::encode() const {
-    const auto ii = cborizeInputs(inputs);
-    const auto oo = cborizeOutputs(outputs);
-
-    // Encode elements in a map, with fixed numbers as keys
-    std::map<Cbor::Encode, Cbor::Encode> mapElems = {
-        std::make_pair(Cbor::Encode::uint(0), ii),
-        std::make_pair(Cbor::Encode::uint(1), oo),
-        std::make_pair(Cbor::Encode::uint(2), Cbor::Encode::uint(fee)),
-        std::make_pair(Cbor::Encode::uint(3), Cbor::Encode::uint(ttl)),
-    };
-
+    // Encode elements in a map, with fixed numbers as keys, in increasing order
+    Cbor::Writer writer;
+    writer.map(4 + (certificates.empty() ? 0 : 1) + (withdrawals.empty() ? 0 : 1));
+    writeInputs(writer.uint(0), inputs);
+    writeOutputs(writer.uint(1), outputs);
+    writer.uint(2).uint(fee);
+    writer.uint(3).uint(ttl);
     if (!certificates.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(4), cborizeCerts(certificates));
+        writeCerts(writer.uint(4), certificates);
     }
     if (!withdrawals.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(5), cborizeWithdrawals(withdrawals));
+        writeWithdrawals(writer.uint(5), withdrawals);
     }
-
-    Cbor::Encode encode = Cbor::Encode::map(mapElems);
-    return encode.encoded();
+    return writer.release();
 
     // Note: following fields are not included:
     // 7 AUXILIARY_DATA_HASH, 8 VALIDITY_INTERVAL_START
@@ -314,31 +396,31 @@ Data Transaction::getId() const {
     return hash;
 }
 
-/// https://github.com/Emurgo/cardano-serialization-lib/blob/78184e0a2c207c2f8bba57b0d3c437f4c808c125/rust/src/utils.rs#L1415
-std::optional<uint64_t> minAdaAmountHelper(const TxOutput& output, uint64_t coinsPerUtxoByte) noexcept {
-    const size_t outputSize = cborizeOutput(output).encoded().size();
-    const auto outputSizeExtended = static_cast<uint64_t>(outputSize + 160);
-    if (checkMulUnsignedOverflow(outputSizeExtended, coinsPerUtxoByte)) {
-        return std::nullopt;
+std::size_t TxOutput::encodedSize() const {
+    // [address, amount] or [address, [amount, tokens]]
+    auto size = 1 + Cbor::Writer::headerSize(address.size()) + address.size() + Cbor::Writer::headerSize(amount);
+    if (tokenBundle.size() > 0) {
+        size += 1 + tokenBundle.encodedSize();
     }
-    return outputSizeExtended * coinsPerUtxoByte;
+    return size;
 }
 
 /// https://github.com/Emurgo/cardano-serialization-lib/blob/78184e0a2c207c2f8bba57b0d3c437f4c808c125/rust/src/utils.rs#L1388
 std::optional<uint64_t> TxOutput::minAdaAmount(uint64_t coinsPerUtxoByte) const noexcept {
-    // A copy of `this`.
-    TxOutput output(address, amount, tokenBundle);
-
+    // only the size of the ADA amount changes between the tries
+    const auto sizeWithoutAmount = encodedSize() - Cbor::Writer::headerSize(amount);
+    auto outputAmount = amount;
     while (true) {
-        const auto minAmount = minAdaAmountHelper(output, coinsPerUtxoByte);
-        if (!minAmount) {
+        const auto outputSizeExtended = static_cast<uint64_t>(sizeWithoutAmount + Cbor::Writer::headerSize(outputAmount) + 160);
+        if (checkMulUnsignedOverflow(outputSizeExtended, coinsPerUtxoByte)) {
             return std::nullopt;
         }
-        if (output.amount >= *minAmount) {
+        const auto minAmount = outputSizeExtended * coinsPerUtxoByte;
+        if (outputAmount >= minAmount) {
             return minAmount;
         }
         // Set the amount to `minAmount` and re-try again.
-        output.amount = *minAmount;
+        outputAmount = minAmount;
     }
 }
 
@@ -15,6 +15,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -34,14 +35,15 @@ public:
 
     static TokenAmount fromProto(const Proto::TokenAmount& proto);
     Proto::TokenAmount toProto() const;
-    /// Key used in TokenBundle
+    /// Key of the token, as accepted by `TokenBundle::getAmount`
     std::string key() const { return policyId + "_" + assetName; }
 };
 
+/// Token amounts by policy ID and asset name.
+/// Kept in a vector sorted by policy ID then asset name, so the tokens of a policy are contiguous, lookups are
+/// binary searches and bundles are added or subtracted in one merge pass.
 class TokenBundle {
 public:
-    std::map<std::string, TokenAmount> bundle;
-
     TokenBundle() = default;
     explicit TokenBundle(const std::vector<TokenAmount>& tokens) {
         for (const auto& t : tokens) {
@@ -53,8 +55,19 @@ public:
     Proto::TokenBundle toProto() const;
 
     void add(const TokenAmount& ta);
+    /// Adds all the token amounts of `other`.
+    void add(const TokenBundle& other);
+    /// The token amounts of this bundle less the ones of `other`, at least 0; tokens only in `other` are ignored.
+    /// Tokens with a 0 amount are omitted, unless `keepZero`.
+    TokenBundle subtract(const TokenBundle& other, bool keepZero = false) const;
+
+    uint256_t getAmount(const std::string& policyId, const std::string& assetName) const;
+    /// Amount by `TokenAmount::key()`.
     uint256_t getAmount(const std::string& key) const;
-    size_t size() const { return bundle.size(); }
+    size_t size() const { return tokens.size(); }
+    /// The token amounts, sorted by policy ID and asset name.
+    std::vector<TokenAmount>::const_iterator begin() const { return tokens.begin(); }
+    std::vector<TokenAmount>::const_iterator end() const { return tokens.end(); }
     /// Get the unique policyIds, can be the same number as the elements, or less (in case a policyId appears more than once, with different asset names).
     std::unordered_set<std::string> getPolicyIds() const;
     /// Filter by policyIds
@@ -65,6 +78,12 @@ public:
     // The minimum ADA amount needed for a UTXO with this token bundle.  See https://docs.cardano.org/native-tokens/minimum-ada-value-requirement
     uint64_t minAdaAmount() const;
     static uint64_t minAdaAmountHelper(uint64_t numPids, uint64_t numAssets, uint64_t sumAssetNameLengths);
+
+    /// Size of the CBOR map of the token amounts in an output, computed without encoding them.
+    std::size_t encodedSize() const;
+
+private:
+    std::vector<TokenAmount> tokens;
 };
 
 class OutPoint {
@@ -106,6 +125,9 @@ public:
     /// Returns minimal amount of ADA for the output or `std::nullopt` if there a problem happened.
     std::optional<uint64_t> minAdaAmount(uint64_t coinsPerUtxoByte) const noexcept;
 
+    /// Size of the CBOR encoded output, computed without encoding it.
+    std::size_t encodedSize() const;
+
     TxOutput() = default;
     TxOutput(Data address, Amount amount)
         : address(std::move(address)), amount(amount) {}
@@ -110,7 +110,8 @@ Encode Encode::fromRaw(const TW::Data& rawData) {
     return Encode(rawData);
 }
 
-Encode Encode::appendValue(byte majorType, uint64_t value) {
+/// Append types + value, on variable number of bytes (1..8).
+static void appendTypeValue(Data& data, byte majorType, uint64_t value) {
     byte byteCount = 0;
     byte minorType = 0;
     if (value < 24) {
@@ -130,13 +131,17 @@ Encode Encode::appendValue(byte majorType, uint64_t value) {
         minorType = 27;
     }
     // add bytes
-    TW::append(_data, (byte)((majorType << 5) | (minorType & 0x1F)));
-    Data valBytes = Data(byteCount - 1);
-    for (auto i = 0ul; i < valBytes.size(); ++i) {
-        valBytes[valBytes.size() - 1 - i] = (byte)(value & 0xFF);
+    TW::append(data, (byte)((majorType << 5) | (minorType & 0x1F)));
+    const auto start = data.size();
+    data.resize(start + byteCount - 1);
+    for (auto i = data.size(); i > start; --i) {
+        data[i - 1] = (byte)(value & 0xFF);
         value = value >> 8;
     }
-    append(valBytes);
+}
+
+Encode Encode::appendValue(byte majorType, uint64_t value) {
+    appendTypeValue(_data, majorType, value);
     return *this;
 }
 
@@ -145,6 +150,78 @@ void Encode::appendIndefinite(byte majorType) {
     TW::append(_data, (byte)((majorType << 5) | (minorType & 0x1F)));
 }
 
+std::size_t Writer::headerSize(uint64_t value) {
+    if (value < 24) {
+        return 1;
+    }
+    if (value <= 0xFF) {
+        return 1 + 1;
+    }
+    if (value <= 0xFFFF) {
+        return 1 + 2;
+    }
+    if (value <= 0xFFFFFFFF) {
+        return 1 + 4;
+    }
+    return 1 + 8;
+}
+
+Writer& Writer::uint(uint64_t value) {
+    appendTypeValue(_data, Decode::MT_uint, value);
+    return *this;
+}
+
+Writer& Writer::negInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow, as in Encode::negInt
+        return uint(0);
+    }
+    appendTypeValue(_data, Decode::MT_negint, value - 1);
+    return *this;
+}
+
+Writer& Writer::string(std::string_view str) {
+    appendTypeValue(_data, Decode::MT_string, str.size());
+    _data.insert(_data.end(), str.begin(), str.end());
+    return *this;
+}
+
+Writer& Writer::bytes(const Data& data) {
+    appendTypeValue(_data, Decode::MT_bytes, data.size());
+    TW::append(_data, data);
+    return *this;
+}
+
+Writer& Writer::array(uint64_t count) {
+    appendTypeValue(_data, Decode::MT_array, count);
+    return *this;
+}
+
+Writer& Writer::map(uint64_t count) {
+    appendTypeValue(_data, Decode::MT_map, count);
+    return *this;
+}
+
+Writer& Writer::tag(uint64_t value) {
+    appendTypeValue(_data, Decode::MT_tag, value);
+    return *this;
+}
+
+Writer& Writer::null() {
+    appendTypeValue(_data, Decode::MT_special, 0x16);
+    return *this;
+}
+
+Writer& Writer::encode(const Encode& elem) {
+    TW::append(_data, elem.encoded());
+    return *this;
+}
+
+Writer& Writer::raw(const Data& rawData) {
+    TW::append(_data, rawData);
+    return *this;
+}
+
 
 Decode::Decode(const Data& input)
 : data(std::make_shared<OrigDataRef>(input)) {
@@ -153,6 +230,22 @@ Decode::Decode(const Data& input)
     subLen = (uint32_t)input.size();
 }
 
+Decode::Decode(Data&& input)
+: data(std::make_shared<OrigDataRef>(std::move(input))) {
+    subStart = 0;
+    subLen = (uint32_t)data->origData.size();
+}
+
+Decode Decode::indexed(Data input) {
+    Decode decode(std::move(input));
+    if (!decode.isValid()) {
+        throw std::invalid_argument("CBOR invalid data");
+    }
+    decode.data->totalLens.assign(decode.data->origData.size(), 0);
+    decode.indexTotalLen();
+    return decode;
+}
+
 Decode::Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubStart, uint32_t nSubLen)
 : data(nData) {
     // shared_ptr to original input data added
@@ -219,6 +312,10 @@ Decode::TypeDesc Decode::getTypeDesc() const {
 }
 
 uint32_t Decode::getTotalLen() const {
+    if (subStart < data->totalLens.size() && data->totalLens[subStart] != 0) {
+        // already known from indexing
+        return data->totalLens[subStart];
+    }
     TypeDesc typeDesc = getTypeDesc();
     switch (typeDesc.majorType) {
         case MT_uint:
@@ -251,11 +348,16 @@ uint64_t Decode::getValue() const {
 }
 
 std::string Decode::getString() const {
-    Data strData = getBytes();
-    return std::string((const char*)strData.data(), strData.size()); 
+    const auto view = getBytesView();
+    return std::string(view.begin(), view.end());
 }
 
 Data Decode::getBytes() const {
+    const auto view = getBytesView();
+    return Data(view.begin(), view.end());
+}
+
+std::span<const TW::byte> Decode::getBytesView() const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != MT_bytes && typeDesc.majorType != MT_string) {
         throw std::invalid_argument("CBOR data type not bytes/string");
@@ -265,7 +367,16 @@ Data Decode::getBytes() const {
         throw std::invalid_argument("CBOR bytes/string data too short");
     }
     assert(subStart + typeDesc.byteCount + len <= data->origData.size());
-    return TW::data(data->origData.data() + (subStart + typeDesc.byteCount), len); 
+    return {data->origData.data() + (subStart + typeDesc.byteCount), len};
+}
+
+Decode Decode::getBytesContent(uint32_t offset) const {
+    const auto view = getBytesView();
+    if (offset > view.size()) {
+        throw std::invalid_argument("CBOR bytes content offset out of range");
+    }
+    const auto start = static_cast<uint32_t>(view.data() - data->origData.data()) + offset;
+    return Decode(data, start, static_cast<uint32_t>(view.size()) - offset);
 }
 
 bool Decode::isBreak() const {
@@ -296,43 +407,75 @@ uint32_t Decode::getCompoundLength(uint32_t countMultiplier) const {
     return len;
 }
 
-vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
+uint32_t Decode::indexTotalLen() const {
+    TypeDesc typeDesc = getTypeDesc();
+    uint32_t len = typeDesc.byteCount;
+    switch (typeDesc.majorType) {
+        case MT_bytes:
+        case MT_string:
+            len += (uint32_t)typeDesc.value;
+            break;
+
+        case MT_array:
+        case MT_map:
+            {
+                uint64_t count = typeDesc.isIndefiniteValue ? 0 : typeDesc.value * (typeDesc.majorType == MT_map ? 2 : 1);
+                for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i) {
+                    Decode nextElem = skipClone(len);
+                    if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
+                        len += 1; // account for break
+                        break;
+                    }
+                    len += nextElem.indexTotalLen();
+                }
+            }
+            break;
+
+        case MT_tag:
+            len += skipClone(len).indexTotalLen();
+            break;
+
+        default:
+            break;
+    }
+    data->totalLens[subStart] = len;
+    return len;
+}
+
+ElementIterator Decode::compoundBegin(uint32_t countMultiplier, TW::byte expectedType) const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != expectedType) {
         throw std::invalid_argument("CBOR data type mismatch");
     }
+    uint64_t count = typeDesc.isIndefiniteValue ? 0 : typeDesc.value * countMultiplier;
+    return ElementIterator(*this, typeDesc.byteCount, count, typeDesc.isIndefiniteValue);
+}
+
+vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
     vector<Decode> elems;
-    uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    uint32_t idx = typeDesc.byteCount;
-    for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(idx);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
-            // end of indefinite-length
-            break;
-        }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (elemLen == 0 || checkAddUnsignedOverflow(idx, elemLen)) {
-            throw std::invalid_argument("CBOR invalid element length");
-        }
-        if (idx + elemLen > length()) {
-            throw std::invalid_argument("CBOR invalid array data");
-        }
-        elems.emplace_back(Decode(data, subStart + idx, elemLen));
-        idx += elemLen;
+    const auto end = ElementIterator(*this);
+    for (auto it = compoundBegin(countMultiplier, expectedType); it != end; ++it) {
+        elems.emplace_back(*it);
     }
     return elems;
 }
 
 vector<pair<Decode, Decode>> Decode::getMapElements() const {
-    auto elems = getCompoundElements(2, MT_map);
     vector<pair<Decode, Decode>> map;
-    for (auto i = 0ul; i < elems.size(); i += 2) {
-        map.emplace_back(make_pair(elems[i], elems[i + 1]));
+    for (auto&& elem : mapElements()) {
+        map.emplace_back(std::move(elem));
     }
     return map;
 }
 
+ElementRange<ElementIterator> Decode::arrayElements() const {
+    return ElementRange<ElementIterator>(compoundBegin(1, MT_array), ElementIterator(*this));
+}
+
+ElementRange<MapElementIterator> Decode::mapElements() const {
+    return ElementRange<MapElementIterator>(MapElementIterator(compoundBegin(2, MT_map)), MapElementIterator(ElementIterator(*this)));
+}
+
 uint64_t Decode::getTagValue() const {
     TypeDesc typeDesc = getTypeDesc();
     if (typeDesc.majorType != MT_tag) {
@@ -476,4 +619,60 @@ Data Decode::encoded() const
     return TW::data(data->origData.data() + subStart, subLen);
 }
 
+ElementIterator::ElementIterator(const Decode& parent, uint32_t idx, uint64_t remaining, bool isIndefinite)
+: parent(parent), idx(idx), remaining(remaining), isIndefinite(isIndefinite) {
+    seek();
+}
+
+void ElementIterator::seek() {
+    if (!isIndefinite && remaining == 0) {
+        atEnd = true;
+        return;
+    }
+    Decode nextElem = parent.skipClone(idx);
+    if (isIndefinite && nextElem.isBreak()) {
+        // end of indefinite-length
+        atEnd = true;
+        return;
+    }
+    elemLen = nextElem.getTotalLen();
+    if (elemLen == 0 || checkAddUnsignedOverflow(idx, elemLen)) {
+        throw std::invalid_argument("CBOR invalid element length");
+    }
+    if (idx + elemLen > parent.length()) {
+        throw std::invalid_argument("CBOR invalid array data");
+    }
+}
+
+Decode ElementIterator::operator*() const {
+    if (atEnd) {
+        throw std::invalid_argument("CBOR missing element");
+    }
+    return Decode(parent.data, parent.subStart + idx, elemLen);
+}
+
+ElementIterator& ElementIterator::operator++() {
+    if (atEnd) {
+        throw std::invalid_argument("CBOR missing element");
+    }
+    idx += elemLen;
+    if (!isIndefinite) {
+        --remaining;
+    }
+    seek();
+    return *this;
+}
+
+std::pair<Decode, Decode> MapElementIterator::operator*() const {
+    auto valueIt = keyIt;
+    ++valueIt;
+    return std::make_pair(*keyIt, *valueIt);
+}
+
+MapElementIterator& MapElementIterator::operator++() {
+    ++keyIt;
+    ++keyIt;
+    return *this;
+}
+
 } // namespace TW::Cbor
@@ -8,9 +8,13 @@
 
 #include "Data.h"
 
+#include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <span>
 #include <vector>
 #include <map>
 
@@ -78,12 +82,68 @@ inline bool operator<(const Encode& lhs, const Encode& rhs) {
     return lhs.getDataInternal() < rhs.getDataInternal();
 }
 
+/// Streaming CBOR encoder, writes values directly into one growing buffer, in call order.
+/// Arrays and maps are definite-length: their element count is written first, followed by their elements
+/// (for maps: key, value, key, value ...), written with further calls.  Map entries are written in the given order;
+/// for the same output as `Encode::map` write them sorted by their encoded keys.
+/// Produces the same encoding as `Encode`, without an intermediary object per value.
+/// See CborTests.cpp for usage.
+class Writer {
+public:
+    Writer() = default;
+    /// Starts with a buffer with `capacity` reserved bytes.
+    explicit Writer(std::size_t capacity) { _data.reserve(capacity); }
+
+    /// Encoded bytes written so far
+    const TW::Data& encoded() const { return _data; }
+    /// Take out the encoded bytes, leaving the writer empty
+    TW::Data release() { return std::move(_data); }
+    /// Encoded size of a type header carrying the given value, count or length
+    static std::size_t headerSize(uint64_t value);
+
+    /// write an unsigned int
+    Writer& uint(uint64_t value);
+    /// write a negative int (positive is given)
+    Writer& negInt(uint64_t value);
+    /// write a string
+    Writer& string(std::string_view str);
+    /// write a byte array
+    Writer& bytes(const Data& data);
+    /// start an array of `count` elements, to be written next
+    Writer& array(uint64_t count);
+    /// start a map of `count` key-value pairs, to be written next
+    Writer& map(uint64_t count);
+    /// write a tag, its element is to be written next
+    Writer& tag(uint64_t value);
+    /// write a null value (special)
+    Writer& null();
+    /// write an already encoded element
+    Writer& encode(const Encode& elem);
+    /// write raw encoded bytes, must be valid CBOR data (not checked)
+    Writer& raw(const Data& rawData);
+
+private:
+    TW::Data _data;
+};
+
+class ElementIterator;
+class MapElementIterator;
+template <typename Iterator>
+class ElementRange;
+
 /// CBOR Decoder and container for data for decoding.  Contains reference to read-only CBOR data.
+/// Sub-elements share the same read-only buffer, they refer to it with an offset and length.
 /// See CborTests.cpp for usage.
 class Decode {
 public:
     /// Constructor, create from CBOR byte stream
     Decode(const Data& input);
+    /// Constructor, create from CBOR byte stream, taking over the buffer without copying
+    Decode(Data&& input);
+    /// Create from CBOR byte stream, validating the whole structure once and recording the length of each element,
+    /// so that later element access and iteration does not need to re-scan nested elements.
+    /// Throws if the input is not valid CBOR.
+    static Decode indexed(Data input);
 
 public: // decoding
     /// Check if contains a valid CBOR byte stream.
@@ -94,10 +154,19 @@ public: // decoding
     std::string getString() const;
     /// Get the value of a string/bytes as Data
     TW::Data getBytes() const;
+    /// Get the value of a string/bytes without copying, as a view into the shared input buffer
+    /// (valid as long as any Decode of the same input lives)
+    std::span<const TW::byte> getBytesView() const;
+    /// Decode the CBOR data embedded in a byte string, from `offset` within its content, sharing the input buffer
+    Decode getBytesContent(uint32_t offset = 0) const;
     /// Get all elements of array
     std::vector<Decode> getArrayElements() const { return getCompoundElements(1, MT_array); }
     /// Get all elements of map
     std::vector<std::pair<Decode, Decode>> getMapElements() const;
+    /// Iterate lazily over elements of array, without collecting them
+    ElementRange<ElementIterator> arrayElements() const;
+    /// Iterate lazily over key-value pairs of map, without collecting them
+    ElementRange<MapElementIterator> mapElements() const;
     /// Get the tag number
     uint64_t getTagValue() const;
     /// Get the tag element
@@ -118,12 +187,17 @@ public: // decoding
         MT_tag = 6,
         MT_special = 7,
     };
-    
+    /// Get the major type of the element
+    MajorType getMajorType() const { return getTypeDesc().majorType; }
+
 private:
     /// Struct used to keep reference to original data
     struct OrigDataRef {
         Data origData;
+        /// Total length of the element starting at each offset, 0 if not known; empty if not indexed
+        std::vector<uint32_t> totalLens;
         OrigDataRef(const Data& o) : origData(o) {}
+        OrigDataRef(Data&& o) : origData(std::move(o)) {}
     };
     Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubIdx, uint32_t nSubLen);
     /// Skip ahead: form other Decode data with offset
@@ -144,9 +218,14 @@ private:
     uint32_t getTotalLen() const;
     uint32_t getCompoundLength(uint32_t countMultiplier) const;
     std::vector<Decode> getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const;
+    ElementIterator compoundBegin(uint32_t countMultiplier, TW::byte expectedType) const;
+    /// Compute and record total length of this element and all nested elements
+    uint32_t indexTotalLen() const;
     bool isBreak() const;
     std::string dumpToStringInternal() const;
 
+    friend class ElementIterator;
+
 private:
     /// Reference to raw data, to the whole orginal, smart ptr
     std::shared_ptr<OrigDataRef> data;
@@ -155,4 +234,69 @@ private:
     uint32_t subLen;
 };
 
+/// Lazy forward iterator over the elements of a CBOR array or map (for maps keys and values alternate).
+/// Element lengths are computed one at a time, as the iterator advances.
+class ElementIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Decode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Decode;
+
+    Decode operator*() const;
+    ElementIterator& operator++();
+    bool operator==(const ElementIterator& other) const { return atEnd == other.atEnd && (atEnd || idx == other.idx); }
+    bool operator!=(const ElementIterator& other) const { return !(*this == other); }
+
+private:
+    friend class Decode;
+    /// Iterator at the element at offset `idx` of `parent`, with `remaining` elements left
+    ElementIterator(const Decode& parent, uint32_t idx, uint64_t remaining, bool isIndefinite);
+    /// End iterator
+    explicit ElementIterator(const Decode& parent) : parent(parent), atEnd(true) {}
+    /// Determine the length of the current element, or detect the end
+    void seek();
+
+    Decode parent;
+    uint32_t idx = 0;
+    uint32_t elemLen = 0;
+    uint64_t remaining = 0;
+    bool isIndefinite = false;
+    bool atEnd = false;
+};
+
+/// Lazy forward iterator over the key-value pairs of a CBOR map
+class MapElementIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::pair<Decode, Decode>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::pair<Decode, Decode>;
+
+    explicit MapElementIterator(const ElementIterator& keyIt) : keyIt(keyIt) {}
+
+    std::pair<Decode, Decode> operator*() const;
+    MapElementIterator& operator++();
+    bool operator==(const MapElementIterator& other) const { return keyIt == other.keyIt; }
+    bool operator!=(const MapElementIterator& other) const { return keyIt != other.keyIt; }
+
+private:
+    ElementIterator keyIt;
+};
+
+/// Range of lazily decoded elements, for use in range-based for loops
+template <typename Iterator>
+class ElementRange {
+public:
+    ElementRange(Iterator first, Iterator last) : first(std::move(first)), last(std::move(last)) {}
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+
+private:
+    Iterator first;
+    Iterator last;
+};
+
 } // namespace TW::Cbor
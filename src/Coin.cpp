@@ -7,179 +7,40 @@
 #include "Coin.h"
 
 #include "CoinEntry.h"
+#include "Instrumentation.h"
+#include "SigningCache.h"
+#include "algorithm/parallel.h"
+#include "interface/TWString+Constant.h"
 #include <TrustWalletCore/TWCoinTypeConfiguration.h>
 #include <TrustWalletCore/TWHRP.h>
 
 #include <map>
 
-// #coin-list# Includes for entry points for coin implementations
-#include "Aeternity/Entry.h"
-#include "Aion/Entry.h"
-#include "Algorand/Entry.h"
-#include "Aptos/Entry.h"
-#include "Binance/Entry.h"
-#include "Bitcoin/Entry.h"
-#include "Cardano/Entry.h"
-#include "Cosmos/Entry.h"
-#include "Decred/Entry.h"
-#include "EOS/Entry.h"
-#include "MultiversX/Entry.h"
-#include "Ethereum/Entry.h"
-#include "Everscale/Entry.h"
-#include "FIO/Entry.h"
-#include "Filecoin/Entry.h"
-#include "Groestlcoin/Entry.h"
-#include "Harmony/Entry.h"
-#include "Icon/Entry.h"
-#include "IoTeX/Entry.h"
-#include "Kusama/Entry.h"
-#include "NEAR/Entry.h"
-#include "NEO/Entry.h"
-#include "NULS/Entry.h"
-#include "Nano/Entry.h"
-#include "Nebulas/Entry.h"
-#include "Nervos/Entry.h"
-#include "Nimiq/Entry.h"
-#include "Oasis/Entry.h"
-#include "Ontology/Entry.h"
-#include "Polkadot/Entry.h"
-#include "Ronin/Entry.h"
-#include "Solana/Entry.h"
-#include "Stellar/Entry.h"
-#include "THORChain/Entry.h"
-#include "Tezos/Entry.h"
-#include "Theta/Entry.h"
-#include "Tron/Entry.h"
-#include "VeChain/Entry.h"
-#include "Waves/Entry.h"
-#include "XRP/Entry.h"
-#include "Zcash/Entry.h"
-#include "Zilliqa/Entry.h"
-#include "Hedera/Entry.h"
-#include "TheOpenNetwork/Entry.h"
-#include "Sui/Entry.h"
-// end_of_coin_includes_marker_do_not_modify
-
 using namespace TW;
 using namespace std;
 
-// #coin-list# Global coin entry dispatcher entries
-Aeternity::Entry aeternityDP;
-Aion::Entry aionDP;
-Algorand::Entry algorandDP;
-Aptos::Entry AptosDP;
-Binance::Entry binanceDP;
-Bitcoin::Entry bitcoinDP;
-Cardano::Entry cardanoDP;
-Cosmos::Entry cosmosDP;
-MultiversX::Entry multiversxDP;
-EOS::Entry eosDP;
-Ethereum::Entry ethereumDP;
-Decred::Entry decredDP;
-Filecoin::Entry filecoinDP;
-FIO::Entry fioDP;
-Groestlcoin::Entry groestlcoinDP;
-Harmony::Entry harmonyDP;
-Icon::Entry iconDP;
-IoTeX::Entry iotexDP;
-Kusama::Entry kusamaDP;
-Nano::Entry nanoDP;
-NEAR::Entry nearDP;
-Nebulas::Entry nebulasDP;
-NEO::Entry neoDP;
-Nimiq::Entry nimiqDP;
-NULS::Entry nulsDP;
-Ontology::Entry ontologyDP;
-Oasis::Entry oasisDP;
-Polkadot::Entry polkadotDP;
-Ripple::Entry rippleDP;
-Ronin::Entry roninDP;
-Solana::Entry solanaDP;
-Stellar::Entry stellarDP;
-Tezos::Entry tezosDP;
-Theta::Entry thetaDP;
-THORChain::Entry thorchainDP;
-Tron::Entry tronDP;
-VeChain::Entry vechainDP;
-Waves::Entry wavesDP;
-Zcash::Entry zcashDP;
-Zilliqa::Entry zilliqaDP;
-Nervos::Entry NervosDP;
-Everscale::Entry EverscaleDP;
-Hedera::Entry HederaDP;
-TheOpenNetwork::Entry tonDP;
-Sui::Entry SuiDP;
-// end_of_coin_dipatcher_declarations_marker_do_not_modify
-
-CoinEntry* coinDispatcher(TWCoinType coinType) {
-    // switch is preferred instead of a data structure, due to initialization issues
-    CoinEntry* entry = nullptr;
-    const auto blockchain = TW::blockchain(coinType);
-    switch (blockchain) {
-        // #coin-list#
-        case TWBlockchainBitcoin: entry = &bitcoinDP; break;
-        case TWBlockchainEthereum: entry = &ethereumDP; break;
-        case TWBlockchainVechain: entry = &vechainDP; break;
-        case TWBlockchainTron: entry = &tronDP; break;
-        case TWBlockchainIcon: entry = &iconDP; break;
-        case TWBlockchainBinance: entry = &binanceDP; break;
-        case TWBlockchainRipple: entry = &rippleDP; break;
-        case TWBlockchainTezos: entry = &tezosDP; break;
-        case TWBlockchainNimiq: entry = &nimiqDP; break;
-        case TWBlockchainStellar: entry = &stellarDP; break;
-        case TWBlockchainAion: entry = &aionDP; break;
-        case TWBlockchainCosmos: entry = &cosmosDP; break;
-        case TWBlockchainTheta: entry = &thetaDP; break;
-        case TWBlockchainOntology: entry = &ontologyDP; break;
-        case TWBlockchainZilliqa: entry = &zilliqaDP; break;
-        case TWBlockchainIoTeX: entry = &iotexDP; break;
-        case TWBlockchainEOS: entry = &eosDP; break;
-        case TWBlockchainNano: entry = &nanoDP; break;
-        case TWBlockchainNULS: entry = &nulsDP; break;
-        case TWBlockchainWaves: entry = &wavesDP; break;
-        case TWBlockchainAeternity: entry = &aeternityDP; break;
-        case TWBlockchainNebulas: entry = &nebulasDP; break;
-        case TWBlockchainFIO: entry = &fioDP; break;
-        case TWBlockchainSolana: entry = &solanaDP; break;
-        case TWBlockchainHarmony: entry = &harmonyDP; break;
-        case TWBlockchainNEAR: entry = &nearDP; break;
-        case TWBlockchainAlgorand: entry = &algorandDP; break;
-        case TWBlockchainPolkadot: entry = &polkadotDP; break;
-        case TWBlockchainCardano: entry = &cardanoDP; break;
-        case TWBlockchainNEO: entry = &neoDP; break;
-        case TWBlockchainFilecoin: entry = &filecoinDP; break;
-        case TWBlockchainMultiversX: entry = &multiversxDP; break;
-        case TWBlockchainOasisNetwork: entry = &oasisDP; break;
-        case TWBlockchainDecred: entry = &decredDP; break;
-        case TWBlockchainGroestlcoin: entry = &groestlcoinDP; break;
-        case TWBlockchainZcash: entry = &zcashDP; break;
-        case TWBlockchainThorchain: entry = &thorchainDP; break;
-        case TWBlockchainRonin: entry = &roninDP; break;
-        case TWBlockchainKusama: entry = &kusamaDP; break;
-        case TWBlockchainNervos: entry = &NervosDP; break;
-        case TWBlockchainEverscale: entry = &EverscaleDP; break;
-        case TWBlockchainAptos: entry = &AptosDP; break;
-        case TWBlockchainHedera: entry = &HederaDP; break;
-        case TWBlockchainTheOpenNetwork: entry = &tonDP; break;
-        case TWBlockchainSui: entry = &SuiDP; break;
-        // end_of_coin_dipatcher_switch_marker_do_not_modify
-
-        default: entry = nullptr; break;
-    }
-    assert(entry != nullptr);
-    return entry;
+extern const CoinInfo& getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+
+extern CoinEntry* coinDispatcher(TWCoinType coinType); // in generated CoinDispatcher.cpp file
+
+namespace {
+constexpr Derivation emptyDerivation;
+} // namespace
+
+const Derivation& CoinInfo::defaultDerivation() const {
+    return (derivation.size() > 0) ? derivation[0] : emptyDerivation;
 }
 
-const Derivation CoinInfo::derivationByName(TWDerivation nameIn) const {
+const Derivation& CoinInfo::derivationByName(TWDerivation nameIn) const {
     if (nameIn == TWDerivationDefault && derivation.size() > 0) {
         return derivation[0];
     }
-    for (auto deriv : derivation) {
+    for (const auto& deriv : derivation) {
         if (deriv.name == nameIn) {
             return deriv;
         }
     }
-    return Derivation();
+    return emptyDerivation;
 }
 
 bool TW::validateAddress(TWCoinType coin, const string& address, const PrefixVariant& prefix) {
@@ -190,9 +51,10 @@ bool TW::validateAddress(TWCoinType coin, const string& address, const PrefixVar
 }
 
 bool TW::validateAddress(TWCoinType coin, const std::string& string) {
-    const auto* hrp = stringForHRP(TW::hrp(coin));
-    auto p2pkh = TW::p2pkhPrefix(coin);
-    auto p2sh = TW::p2shPrefix(coin);
+    const auto& info = getCoinInfo(coin);
+    const auto* hrp = stringForHRP(info.hrp);
+    const auto p2pkh = info.p2pkhPrefix;
+    const auto p2sh = info.p2shPrefix;
 
     // dispatch
     auto* dispatcher = coinDispatcher(coin);
@@ -255,16 +117,54 @@ std::string TW::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDer
     return dispatcher->deriveAddress(coin, publicKey, derivation, addressPrefix);
 }
 
+std::vector<std::string> TW::deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) {
+    auto const* dispatcher = coinDispatcher(coin);
+    assert(dispatcher != nullptr);
+    return dispatcher->deriveAddresses(coin, publicKeys, derivation, addressPrefix);
+}
+
 Data TW::addressToData(TWCoinType coin, const std::string& address) {
     const auto* dispatcher = coinDispatcher(coin);
     assert(dispatcher != nullptr);
     return dispatcher->addressToData(coin, address);
 }
 
+std::vector<DecodedAddress> TW::decodeAddressBatch(TWCoinType coin, const std::vector<std::string>& addresses, std::size_t threads) {
+    std::vector<DecodedAddress> decoded(addresses.size());
+    parallelFor(addresses.size(), threads, [&](std::size_t i) {
+        auto& result = decoded[i];
+        if (!TW::validateAddress(coin, addresses[i])) {
+            return;
+        }
+        result.valid = true;
+        result.normalized = internal::normalizeAddress(coin, addresses[i]);
+        result.data = TW::addressToData(coin, result.normalized);
+    });
+    return decoded;
+}
+
 void TW::anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
-    dispatcher->sign(coinType, dataIn, dataOut);
+    Instrumentation::Operation operation(coinType, TWInstrumentationOperationSign, dataIn.size());
+    SigningCache::shared().getOrCompute(coinType, SigningCache::Operation::Sign, dataIn, dataOut, [&] {
+        dispatcher->sign(coinType, dataIn, dataOut);
+    });
+    operation.setBytesOut(dataOut.size());
+}
+
+std::vector<Data> TW::anyCoinSignBatch(TWCoinType coinType, const std::vector<Data>& dataIn, std::size_t threads) {
+    auto* dispatcher = coinDispatcher(coinType);
+    assert(dispatcher != nullptr);
+    std::vector<Data> dataOut(dataIn.size());
+    parallelFor(dataIn.size(), threads, [&](std::size_t i) {
+        Instrumentation::Operation operation(coinType, TWInstrumentationOperationSign, dataIn[i].size());
+        SigningCache::shared().getOrCompute(coinType, SigningCache::Operation::Sign, dataIn[i], dataOut[i], [&] {
+            dispatcher->sign(coinType, dataIn[i], dataOut[i]);
+        });
+        operation.setBytesOut(dataOut[i].size());
+    });
+    return dataOut;
 }
 
 std::string TW::anySignJSON(TWCoinType coinType, const std::string& json, const Data& key) {
@@ -282,19 +182,34 @@ bool TW::supportsJSONSigning(TWCoinType coinType) {
 void TW::anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
-    dispatcher->plan(coinType, dataIn, dataOut);
+    Instrumentation::Operation operation(coinType, TWInstrumentationOperationPlan, dataIn.size());
+    SigningCache::shared().getOrCompute(coinType, SigningCache::Operation::Plan, dataIn, dataOut, [&] {
+        dispatcher->plan(coinType, dataIn, dataOut);
+    });
+    operation.setBytesOut(dataOut.size());
 }
 
 Data TW::anyCoinPreImageHashes(TWCoinType coinType, const Data& txInputData) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
-    return dispatcher->preImageHashes(coinType, txInputData);
+    Instrumentation::Operation operation(coinType, TWInstrumentationOperationPreImageHashes, txInputData.size());
+    auto hashes = dispatcher->preImageHashes(coinType, txInputData);
+    operation.setBytesOut(hashes.size());
+    return hashes;
 }
 
 void TW::anyCoinCompileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& txOutputOut) {
     auto* dispatcher = coinDispatcher(coinType);
     assert(dispatcher != nullptr);
+    Instrumentation::Operation operation(coinType, TWInstrumentationOperationCompile, txInputData.size());
     dispatcher->compile(coinType, txInputData, signatures, publicKeys, txOutputOut);
+    operation.setBytesOut(txOutputOut.size());
+}
+
+std::unique_ptr<CompileContext> TW::anyCoinCompileContext(TWCoinType coinType, const Data& txInputData) {
+    auto* dispatcher = coinDispatcher(coinType);
+    assert(dispatcher != nullptr);
+    return dispatcher->compileContext(coinType, txInputData);
 }
 
 Data TW::anyCoinBuildTransactionInput(TWCoinType coinType, const std::string& from, const std::string& to, const uint256_t& amount, const std::string& asset, const std::string& memo, const std::string& chainId) {
@@ -305,8 +220,6 @@ Data TW::anyCoinBuildTransactionInput(TWCoinType coinType, const std::string& fr
 
 // Coin info accessors
 
-extern const CoinInfo getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
-
 TWBlockchain TW::blockchain(TWCoinType coin) {
     return getCoinInfo(coin).blockchain;
 }
@@ -336,11 +249,11 @@ TWHDVersion TW::xprvVersionDerivation(TWCoinType coin, TWDerivation derivation)
 }
 
 DerivationPath TW::derivationPath(TWCoinType coin) {
-    return DerivationPath(getCoinInfo(coin).defaultDerivation().path);
+    return getCoinInfo(coin).defaultDerivation().parsedPath;
 }
 
 DerivationPath TW::derivationPath(TWCoinType coin, TWDerivation derivation) {
-    return DerivationPath(getCoinInfo(coin).derivationByName(derivation).path);
+    return getCoinInfo(coin).derivationByName(derivation).parsedPath;
 }
 
 const char* TW::derivationName(TWCoinType coin, TWDerivation derivation) {
@@ -392,7 +305,7 @@ std::uint32_t TW::ss58Prefix(TWCoinType coin) {
 }
 
 TWString* _Nullable TWCoinTypeConfigurationGetSymbol(enum TWCoinType coin) {
-    return TWStringCreateWithUTF8Bytes(getCoinInfo(coin).symbol);
+    return TWStringCreateWithConstant(getCoinInfo(coin).symbol);
 }
 
 int TWCoinTypeConfigurationGetDecimals(enum TWCoinType coin) {
@@ -412,9 +325,9 @@ TWString* _Nullable TWCoinTypeConfigurationGetAccountURL(enum TWCoinType coin, T
 }
 
 TWString* _Nonnull TWCoinTypeConfigurationGetID(enum TWCoinType coin) {
-    return TWStringCreateWithUTF8Bytes(getCoinInfo(coin).id);
+    return TWStringCreateWithConstant(getCoinInfo(coin).id);
 }
 
 TWString* _Nonnull TWCoinTypeConfigurationGetName(enum TWCoinType coin) {
-    return TWStringCreateWithUTF8Bytes(getCoinInfo(coin).name);
+    return TWStringCreateWithConstant(getCoinInfo(coin).name);
 }
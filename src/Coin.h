@@ -21,6 +21,7 @@
 #include <TrustWalletCore/TWPurpose.h>
 #include <TrustWalletCore/TWDerivation.h>
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -81,9 +82,25 @@ std::string deriveAddress(TWCoinType coin, const PrivateKey& privateKey, TWDeriv
 /// Derives the address for a particular coin from the public key, with given derivation and addressPrefix.
 std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation = TWDerivationDefault, const PrefixVariant& addressPrefix = std::monostate());
 
+/// Derives the addresses for a particular coin from several public keys at once, in order; the same as calling
+/// `deriveAddress` for each key.
+std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation = TWDerivationDefault, const PrefixVariant& addressPrefix = std::monostate());
+
 /// Returns the binary representation of a string address
 Data addressToData(TWCoinType coin, const std::string& address);
 
+/// Result of validating and decoding one address of a batch.
+struct DecodedAddress {
+    bool valid = false;
+    std::string normalized;
+    Data data;
+};
+
+/// Validates, normalizes and decodes every address with the given coin, spreading the work over `threads` workers
+/// (0 means hardware concurrency, 1 means sequential in the calling thread).
+/// Results are returned in the order of the inputs; invalid addresses have empty fields.
+std::vector<DecodedAddress> decodeAddressBatch(TWCoinType coin, const std::vector<std::string>& addresses, std::size_t threads);
+
 /// Hasher for deriving the extended public key
 Hash::Hasher publicKeyHasher(TWCoinType coin);
 
@@ -112,8 +129,14 @@ std::uint32_t ss58Prefix(TWCoinType coin);
 const char* chainId(TWCoinType coin);
 
 // Note: use output parameter to avoid unneeded copies
+// Signing and planning outputs come from the `SigningCache` when it is enabled.
 void anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut);
 
+/// Signs every input with the given coin, spreading the work over `threads` workers
+/// (0 means hardware concurrency, 1 means sequential in the calling thread).
+/// Outputs are returned in the order of the inputs.
+std::vector<Data> anyCoinSignBatch(TWCoinType coinType, const std::vector<Data>& dataIn, std::size_t threads);
+
 uint32_t slip44Id(TWCoinType coin);
 
 std::string anySignJSON(TWCoinType coinType, const std::string& json, const Data& key);
@@ -126,6 +149,9 @@ Data anyCoinPreImageHashes(TWCoinType coinType, const Data& txInputData);
 
 void anyCoinCompileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& txOutputOut);
 
+/// Parses (and plans) a compiler input once, for its pre-image hashes followed by its compilation.
+std::unique_ptr<CompileContext> anyCoinCompileContext(TWCoinType coinType, const Data& txInputData);
+
 Data anyCoinBuildTransactionInput(TWCoinType coinType, const std::string& from, const std::string& to, const uint256_t& amount, const std::string& asset, const std::string& memo, const std::string& chainId);
 
 // Describes a derivation: path + optional format + optional name
@@ -135,16 +161,18 @@ struct Derivation {
     const char* nameString = "";
     TWHDVersion xpubVersion = TWHDVersionNone;
     TWHDVersion xprvVersion = TWHDVersionNone;
+    // `path`, parsed at code generation time
+    DerivationPath parsedPath;
 };
 
-// Contains only simple types.
+// Contains only simple types, so that the generated table can be constexpr.
 struct CoinInfo {
     const char* id;
     const char* name;
     TWBlockchain blockchain;
     TWPurpose purpose;
     TWCurve curve;
-    std::vector<Derivation> derivation;
+    std::span<const Derivation> derivation;
     TWPublicKeyType publicKeyType;
     byte staticPrefix;
     byte p2pkhPrefix;
@@ -162,10 +190,8 @@ struct CoinInfo {
     std::uint32_t ss58Prefix;
 
     // returns default derivation
-    const Derivation defaultDerivation() const {
-        return (derivation.size() > 0) ? derivation[0] : Derivation();
-    }
-    const Derivation derivationByName(TWDerivation name) const;
+    const Derivation& defaultDerivation() const;
+    const Derivation& derivationByName(TWDerivation name) const;
 };
 
 } // namespace TW
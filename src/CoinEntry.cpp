@@ -10,6 +10,43 @@
 
 namespace TW {
 
+namespace {
+
+/// Calls the entry with the serialized input, for the coins which don't keep it parsed.
+class SerializedCompileContext final : public CompileContext {
+public:
+    SerializedCompileContext(const CoinEntry& entry, TWCoinType coin, const Data& txInputData)
+        : entry(entry), coin(coin), txInputData(txInputData) {}
+
+    Data preImageHashes() override {
+        return entry.preImageHashes(coin, txInputData);
+    }
+
+    void compile(const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& dataOut) override {
+        entry.compile(coin, txInputData, signatures, publicKeys, dataOut);
+    }
+
+private:
+    const CoinEntry& entry;
+    TWCoinType coin;
+    Data txInputData;
+};
+
+} // namespace
+
+std::vector<std::string> CoinEntry::deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const {
+    std::vector<std::string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        addresses.push_back(deriveAddress(coin, publicKey, derivation, addressPrefix));
+    }
+    return addresses;
+}
+
+std::unique_ptr<CompileContext> CoinEntry::compileContext(TWCoinType coin, const Data& txInputData) const {
+    return std::make_unique<SerializedCompileContext>(*this, coin, txInputData);
+}
+
 const char* getFromPrefixHrpOrDefault(const PrefixVariant &prefix, TWCoinType coin) {
     if (std::holds_alternative<Bech32Prefix>(prefix)) {
         const char* fromPrefix = std::get<Bech32Prefix>(prefix);
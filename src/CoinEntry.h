@@ -11,11 +11,15 @@
 #include <TrustWalletCore/TWFilecoinAddressType.h>
 
 #include "Data.h"
+#include "Instrumentation.h"
 #include "PublicKey.h"
 #include "PrivateKey.h"
 #include "proto/Common.pb.h"
 #include "uint256.h"
 
+#include <google/protobuf/arena.h>
+
+#include <memory>
 #include <string>
 #include <vector>
 #include <variant>
@@ -38,6 +42,19 @@ struct DelegatedPrefix {};
 
 using PrefixVariant = std::variant<Base58Prefix, Bech32Prefix, SS58Prefix, DelegatedPrefix, std::monostate>;
 
+/// A compiler input kept parsed, and planned where the coin plans, between obtaining its pre-image hashes and
+/// compiling it with the external signatures of those hashes. See `TransactionCompilerBatch`.
+class CompileContext {
+public:
+    virtual ~CompileContext() = default;
+
+    /// Returns the same as `CoinEntry::preImageHashes` of the input.
+    virtual Data preImageHashes() = 0;
+
+    /// Writes the same as `CoinEntry::compile` of the input.
+    virtual void compile(const std::vector<Data>& signatures, const std::vector<PublicKey>& publicKeys, Data& dataOut) = 0;
+};
+
 /// Interface for coin-specific entry, used to dispatch calls to coins
 /// Implement this for all coins.
 class CoinEntry {
@@ -48,6 +65,8 @@ public:
     virtual std::string normalizeAddress([[maybe_unused]] TWCoinType coin, const std::string& address) const { return address; }
     // Address derivation
     virtual std::string deriveAddress([[maybe_unused]] TWCoinType coin, const PublicKey& publicKey, [[maybe_unused]] TWDerivation derivation, [[maybe_unused]] const PrefixVariant& addressPrefix) const = 0;
+    // Optional batch address derivation, for coins hashing several keys together. The default calls deriveAddress for each key.
+    virtual std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const;
     // Return the binary representation of a string address, used by AnyAddress
     // It is optional, if not defined, 'AnyAddress' interface will not support this coin.
     virtual Data addressToData([[maybe_unused]] TWCoinType coin, [[maybe_unused]] const std::string& address) const { return {}; }
@@ -67,51 +86,91 @@ public:
     virtual Data preImageHashes([[maybe_unused]] TWCoinType coin, [[maybe_unused]] const Data& txInputData) const { return {}; }
     // Optional method for compiling a transaction with externally-supplied signatures & pubkeys.
     virtual void compile([[maybe_unused]] TWCoinType coin, [[maybe_unused]] const Data& txInputData, [[maybe_unused]] const std::vector<Data>& signatures, [[maybe_unused]] const std::vector<PublicKey>& publicKeys, [[maybe_unused]] Data& dataOut) const {}
+    // Optional method keeping a compiler input parsed (and planned) for preImageHashes followed by compile.
+    // The default context keeps the serialized input and calls them.
+    virtual std::unique_ptr<CompileContext> compileContext(TWCoinType coin, const Data& txInputData) const;
     // Optional helper to prepare a SigningInput from simple parameters.
     // Not suitable for UTXO chains. Some parameters, like chain-specific fee/gas paraemters, may need to be set in the SigningInput.
     virtual Data buildTransactionInput([[maybe_unused]] TWCoinType coinType, [[maybe_unused]] const std::string& from, [[maybe_unused]] const std::string& to, [[maybe_unused]] const uint256_t& amount, [[maybe_unused]] const std::string& asset, [[maybe_unused]] const std::string& memo, [[maybe_unused]] const std::string& chainId) const { return Data(); }
 };
 
+/// Appends the serialization of `message` to `data`, without an intermediate string.
+inline void appendSerialized(const google::protobuf::MessageLite& message, Data& data) {
+    const auto size = message.ByteSizeLong();
+    const auto offset = data.size();
+    data.resize(offset + size);
+    message.SerializeToArray(data.data() + offset, static_cast<int>(size));
+}
+
 // In each coin's Entry.cpp the specific types of the coin are used, this template enforces the Signer implement:
 // static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+// Inputs are parsed into a per-call arena, which frees all their sub-messages at once.
+// The arena is not shared between calls, so templates stay reentrant (a signer may call another coin's signer).
 // Note: use output parameter to avoid unneeded copies
 template <typename Signer, typename Input>
 void signTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Signer::sign(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
+    {
+        Instrumentation::Phase parse(&TWInstrumentationSpan::parseNanos);
+        input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+    }
+    const auto output = [&] {
+        Instrumentation::Phase sign(&TWInstrumentationSpan::signNanos);
+        return Signer::sign(*input);
+    }();
+    Instrumentation::Phase serialize(&TWInstrumentationSpan::serializeNanos);
+    appendSerialized(output, dataOut);
 }
 
 // Note: use output parameter to avoid unneeded copies
 template <typename Planner, typename Input>
 void planTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Planner::plan(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    google::protobuf::Arena arena;
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(&arena);
+    {
+        Instrumentation::Phase parse(&TWInstrumentationSpan::parseNanos);
+        input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+    }
+    const auto output = [&] {
+        Instrumentation::Phase plan(&TWInstrumentationSpan::signNanos);
+        return Planner::plan(*input);
+    }();
+    Instrumentation::Phase serialize(&TWInstrumentationSpan::serializeNanos);
+    appendSerialized(output, dataOut);
 }
 
 // This template will be used for preImageHashes and compile in each coin's Entry.cpp.
 // It is a helper function to simplify exception handle.
 template <typename Input, typename Output, typename Func>
 Data txCompilerTemplate(const Data& dataIn, Func&& fnHandler) {
-    auto input = Input();
-    auto output = Output();
-    if (!input.ParseFromArray(dataIn.data(), (int)dataIn.size())) {
+    google::protobuf::Arena arena;
+    auto& input = *google::protobuf::Arena::CreateMessage<Input>(&arena);
+    auto& output = *google::protobuf::Arena::CreateMessage<Output>(&arena);
+    Data dataOut;
+    bool parsed;
+    {
+        Instrumentation::Phase parse(&TWInstrumentationSpan::parseNanos);
+        parsed = input.ParseFromArray(dataIn.data(), (int)dataIn.size());
+    }
+    if (!parsed) {
         output.set_error(Common::Proto::Error_input_parse);
         output.set_error_message("failed to parse input data");
-        return TW::data(output.SerializeAsString());;
+        appendSerialized(output, dataOut);
+        return dataOut;
     }
 
     try {
+        Instrumentation::Phase handle(&TWInstrumentationSpan::signNanos);
         // each coin function handler
         fnHandler(input, output);
     } catch (const std::exception& e) {
         output.set_error(Common::Proto::Error_internal);
         output.set_error_message(e.what());
     }
-    return TW::data(output.SerializeAsString());
+    Instrumentation::Phase serialize(&TWInstrumentationSpan::serializeNanos);
+    appendSerialized(output, dataOut);
+    return dataOut;
 }
 
 // Get the hrp from the prefix variant, or the coin-default if it is empty or it is not an hrp
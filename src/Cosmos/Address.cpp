@@ -6,3 +6,29 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Address.h"
+
+#include <map>
+
+namespace TW::Cosmos {
+
+std::vector<std::string> Address::strings(const PublicKey& publicKey, const std::vector<TWCoinType>& coins) {
+    // HRPs of the coins and their positions in the result, by address hasher
+    std::map<Hash::Hasher, std::pair<std::vector<std::string>, std::vector<std::size_t>>> groups;
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        auto& [hrps, positions] = groups[TW::addressHasher(coins[i])];
+        hrps.emplace_back(stringForHRP(TW::hrp(coins[i])));
+        positions.push_back(i);
+    }
+
+    std::vector<std::string> result(coins.size());
+    for (const auto& [hasher, group] : groups) {
+        const auto& [hrps, positions] = group;
+        auto encoded = Bech32Address::strings(Bech32Address("", hasher, publicKey).getKeyHash(), hrps);
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            result[positions[i]] = std::move(encoded[i]);
+        }
+    }
+    return result;
+}
+
+} // namespace TW::Cosmos
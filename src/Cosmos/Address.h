@@ -14,6 +14,7 @@
 #include <TrustWalletCore/TWHRP.h>
 
 #include <string>
+#include <vector>
 
 namespace TW::Cosmos {
 
@@ -31,6 +32,11 @@ public:
     /// Initializes an address with a public key, with given prefix.
     Address(const std::string& hrp, const PublicKey& publicKey, TWCoinType coin = TWCoinTypeCosmos) : Bech32Address(hrp, TW::addressHasher(coin), publicKey) {}
 
+    /// Encodes the address of the public key for each of the coins, as `Address(coin, publicKey).string()`.
+    /// The key is hashed once per address hasher, e.g. once for all the coins using sha256ripemd, and only
+    /// the Bech32 checksum is computed for each coin's HRP.
+    static std::vector<std::string> strings(const PublicKey& publicKey, const std::vector<TWCoinType>& coins);
+
     /// Determines whether a string makes a valid Bech32 address, and the HRP matches to the coin.
     static bool isValid(TWCoinType coin, const std::string& addr) {
         const auto* const hrp = stringForHRP(TW::hrp(coin));
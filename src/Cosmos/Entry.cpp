@@ -46,6 +46,13 @@ void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) con
     dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
 }
 
+void Entry::plan(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+    auto input = Proto::SigningInput();
+    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
+    auto serializedOut = Signer::plan(input, coin).SerializeAsString();
+    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+}
+
 string Entry::signJSON(TWCoinType coin, const std::string& json, const Data& key) const {
     return Signer::signJSON(json, key, coin);
 }
@@ -18,6 +18,7 @@ public:
     std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const override;
     Data addressToData(TWCoinType coin, const std::string& address) const final;
     void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const override;
+    void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const override;
     bool supportsJSONSigning() const final { return true; }
     std::string signJSON(TWCoinType coin, const std::string& json, const Data& key) const override;
 };
@@ -12,6 +12,10 @@
 #include "Base64.h"
 #include "PrivateKey.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
 using namespace TW;
 
 namespace TW::Cosmos::Json {
@@ -166,6 +170,7 @@ static json messageRawJSON(const Proto::Message_RawJSON& message) {
     };
 }
 
+/// Has to stay in step with `writeMessages`, which writes the same messages into the signature preimage.
 static json messagesJSON(const Proto::SigningInput& input) {
     json j = json::array();
     for (auto& msg : input.messages()) {
@@ -212,6 +217,277 @@ json signaturePreimageJSON(const Proto::SigningInput& input) {
     };
 }
 
+namespace {
+
+/// Whether `text` is well-formed UTF-8, which `json::dump()` requires of every string.
+bool isValidUtf8(std::string_view text) noexcept {
+    for (std::size_t i = 0; i < text.size();) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+        // bounds of the second byte exclude overlong encodings, surrogates and code points above U+10FFFF
+        std::size_t length = 0;
+        unsigned char low = 0x80;
+        unsigned char high = 0xbf;
+        if (c >= 0xc2 && c <= 0xdf) {
+            length = 2;
+        } else if (c >= 0xe0 && c <= 0xef) {
+            length = 3;
+            low = c == 0xe0 ? 0xa0 : low;
+            high = c == 0xed ? 0x9f : high;
+        } else if (c >= 0xf0 && c <= 0xf4) {
+            length = 4;
+            low = c == 0xf0 ? 0x90 : low;
+            high = c == 0xf4 ? 0x8f : high;
+        } else {
+            return false;
+        }
+        if (text.size() - i < length) {
+            return false;
+        }
+        for (std::size_t j = 1; j < length; ++j) {
+            const auto next = static_cast<unsigned char>(text[i + j]);
+            if (next < low || next > high) {
+                return false;
+            }
+            low = 0x80;
+            high = 0xbf;
+        }
+        i += length;
+    }
+    return true;
+}
+
+/// Writes compact JSON straight into a string, the same as `json::dump()` of the equivalent tree.
+/// Object keys have to be written in sorted order, like nlohmann::json stores them.
+/// Strings which are not valid UTF-8 are rejected, as `json::dump()` rejects them.
+class CanonicalWriter {
+public:
+    string out;
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    void key(std::string_view name) {
+        value(name);
+        out.push_back(':');
+        needsComma = false;
+    }
+
+    /// \throws std::invalid_argument if `text` is not valid UTF-8.
+    void value(std::string_view text) {
+        if (!isValidUtf8(text)) {
+            throw std::invalid_argument("Invalid UTF-8 in JSON string");
+        }
+        separate();
+        out.push_back('"');
+        for (const auto c : text) {
+            escape(static_cast<unsigned char>(c));
+        }
+        out.push_back('"');
+        needsComma = true;
+    }
+
+    /// Writes already serialized JSON.
+    void raw(const string& serialized) {
+        separate();
+        out += serialized;
+        needsComma = true;
+    }
+
+private:
+    bool needsComma = false;
+
+    void separate() {
+        if (needsComma) {
+            out.push_back(',');
+        }
+    }
+
+    void open(char bracket) {
+        separate();
+        out.push_back(bracket);
+        needsComma = false;
+    }
+
+    void close(char bracket) {
+        out.push_back(bracket);
+        needsComma = true;
+    }
+
+    void escape(unsigned char c) {
+        switch (c) {
+        case '"': out += "\\\""; return;
+        case '\\': out += "\\\\"; return;
+        case '\b': out += "\\b"; return;
+        case '\f': out += "\\f"; return;
+        case '\n': out += "\\n"; return;
+        case '\r': out += "\\r"; return;
+        case '\t': out += "\\t"; return;
+        default:
+            break;
+        }
+        if (c < 0x20) {
+            static constexpr char digits[] = "0123456789abcdef";
+            out += "\\u00";
+            out.push_back(digits[c >> 4]);
+            out.push_back(digits[c & 0xf]);
+            return;
+        }
+        out.push_back(static_cast<char>(c));
+    }
+};
+
+void writeAmount(CanonicalWriter& writer, const Proto::Amount& amount) {
+    writer.beginObject();
+    writer.key("amount");
+    writer.value(amount.amount());
+    writer.key("denom");
+    writer.value(amount.denom());
+    writer.endObject();
+}
+
+void writeAmounts(CanonicalWriter& writer, const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    writer.beginArray();
+    for (auto& amount : amounts) {
+        writeAmount(writer, amount);
+    }
+    writer.endArray();
+}
+
+void writeFee(CanonicalWriter& writer, const Proto::Fee& fee) {
+    writer.beginObject();
+    writer.key("amount");
+    writeAmounts(writer, fee.amounts());
+    writer.key("gas");
+    writer.value(std::to_string(fee.gas()));
+    writer.endObject();
+}
+
+/// Writes `{"type": type, "value": {...}}`, the value written by `writeValue`.
+template <typename WriteValue>
+void writeTypedMessage(CanonicalWriter& writer, const string& typePrefix, const string& defaultTypePrefix, WriteValue&& writeValue) {
+    writer.beginObject();
+    writer.key("type");
+    writer.value(typePrefix.empty() ? defaultTypePrefix : typePrefix);
+    writer.key("value");
+    writer.beginObject();
+    writeValue();
+    writer.endObject();
+    writer.endObject();
+}
+
+/// Writes a Delegate or Undelegate message, which have the same fields.
+template <typename Message>
+void writeDelegation(CanonicalWriter& writer, const Message& message, const string& defaultTypePrefix) {
+    writeTypedMessage(writer, message.type_prefix(), defaultTypePrefix, [&] {
+        writer.key("amount");
+        writeAmount(writer, message.amount());
+        writer.key("delegator_address");
+        writer.value(message.delegator_address());
+        writer.key("validator_address");
+        writer.value(message.validator_address());
+    });
+}
+
+/// Writes the same messages as `messagesJSON`, keys in sorted order.
+void writeMessages(CanonicalWriter& writer, const Proto::SigningInput& input) {
+    writer.beginArray();
+    const auto unsupported = std::any_of(input.messages().begin(), input.messages().end(), [](const auto& msg) {
+        return msg.has_transfer_tokens_message() || msg.has_wasm_terra_execute_contract_generic();
+    });
+    if (unsupported) {
+        assert(false); // not supported, use protobuf serialization
+        writer.endArray();
+        return;
+    }
+    for (auto& msg : input.messages()) {
+        if (msg.has_send_coins_message()) {
+            const auto& message = msg.send_coins_message();
+            writeTypedMessage(writer, message.type_prefix(), TYPE_PREFIX_MSG_SEND, [&] {
+                writer.key("amount");
+                writeAmounts(writer, message.amounts());
+                writer.key("from_address");
+                writer.value(message.from_address());
+                writer.key("to_address");
+                writer.value(message.to_address());
+            });
+        } else if (msg.has_stake_message()) {
+            writeDelegation(writer, msg.stake_message(), TYPE_PREFIX_MSG_DELEGATE);
+        } else if (msg.has_unstake_message()) {
+            writeDelegation(writer, msg.unstake_message(), TYPE_PREFIX_MSG_UNDELEGATE);
+        } else if (msg.has_withdraw_stake_reward_message()) {
+            const auto& message = msg.withdraw_stake_reward_message();
+            writeTypedMessage(writer, message.type_prefix(), TYPE_PREFIX_MSG_WITHDRAW_REWARD, [&] {
+                writer.key("delegator_address");
+                writer.value(message.delegator_address());
+                writer.key("validator_address");
+                writer.value(message.validator_address());
+            });
+        } else if (msg.has_restake_message()) {
+            const auto& message = msg.restake_message();
+            writeTypedMessage(writer, message.type_prefix(), TYPE_PREFIX_MSG_REDELEGATE, [&] {
+                writer.key("amount");
+                writeAmount(writer, message.amount());
+                writer.key("delegator_address");
+                writer.value(message.delegator_address());
+                writer.key("validator_dst_address");
+                writer.value(message.validator_dst_address());
+                writer.key("validator_src_address");
+                writer.value(message.validator_src_address());
+            });
+        } else if (msg.has_raw_json_message()) {
+            const auto& message = msg.raw_json_message();
+            writer.beginObject();
+            writer.key("type");
+            writer.value(message.type());
+            writer.key("value");
+            // arbitrary JSON, sorted through a tree
+            writer.raw(json::parse(message.value()).dump());
+            writer.endObject();
+        } else if (msg.has_wasm_terra_execute_contract_transfer_message()) {
+            const auto& message = msg.wasm_terra_execute_contract_transfer_message();
+            writeTypedMessage(writer, "", TYPE_PREFIX_WASM_MSG_EXECUTE, [&] {
+                writer.key("coins");
+                writer.raw("[]");
+                writer.key("contract");
+                writer.value(message.contract_address());
+                writer.key("execute_msg");
+                writer.raw(Protobuf::wasmTerraExecuteTransferPayload(message).dump());
+                writer.key("sender");
+                writer.value(message.sender_address());
+            });
+        }
+    }
+    writer.endArray();
+}
+
+} // namespace
+
+string signaturePreimage(const Proto::SigningInput& input) {
+    CanonicalWriter writer;
+    writer.out.reserve(512);
+    writer.beginObject();
+    writer.key("account_number");
+    writer.value(std::to_string(input.account_number()));
+    writer.key("chain_id");
+    writer.value(input.chain_id());
+    writer.key("fee");
+    writeFee(writer, input.fee());
+    writer.key("memo");
+    writer.value(input.memo());
+    writer.key("msgs");
+    writeMessages(writer, input);
+    writer.key("sequence");
+    writer.value(std::to_string(input.sequence()));
+    writer.endObject();
+    return std::move(writer.out);
+}
+
 json transactionJSON(const Proto::SigningInput& input, const Data& signature, TWCoinType coin) {
     auto privateKey = PrivateKey(input.private_key());
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
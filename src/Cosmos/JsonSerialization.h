@@ -25,6 +25,9 @@ using string = std::string;
 using json = nlohmann::json;
 
 json signaturePreimageJSON(const Proto::SigningInput& input);
+/// The serialized signature preimage, `signaturePreimageJSON(input).dump()`, written directly without building the tree.
+/// \throws std::invalid_argument if a string field is not valid UTF-8.
+string signaturePreimage(const Proto::SigningInput& input);
 json transactionJSON(const Proto::SigningInput& input, const Data& signature, TWCoinType coin);
 json signatureJSON(const Data& signature, const Data& pubkey, TWCoinType coin);
 
@@ -316,11 +316,7 @@ google::protobuf::Any convertMessage(const Proto::Message& msg) {
     }
 }
 
-std::string buildProtoTxBody(const Proto::SigningInput& input) {
-    if (input.messages_size() >= 1 && input.messages(0).has_sign_direct_message()) {
-        return input.messages(0).sign_direct_message().body_bytes();
-    }
-
+static cosmos::TxBody makeTxBody(const Proto::SigningInput& input) {
     if (input.messages_size() < 1) {
         throw std::invalid_argument("No message found");
     }
@@ -332,8 +328,21 @@ std::string buildProtoTxBody(const Proto::SigningInput& input) {
     }
     txBody.set_memo(input.memo());
     txBody.set_timeout_height(0);
+    return txBody;
+}
 
-    return txBody.SerializeAsString();
+std::string buildProtoTxBody(const Proto::SigningInput& input) {
+    if (input.messages_size() >= 1 && input.messages(0).has_sign_direct_message()) {
+        return input.messages(0).sign_direct_message().body_bytes();
+    }
+    return makeTxBody(input).SerializeAsString();
+}
+
+std::size_t protoTxBodySize(const Proto::SigningInput& input) {
+    if (input.messages_size() >= 1 && input.messages(0).has_sign_direct_message()) {
+        return input.messages(0).sign_direct_message().body_bytes().size();
+    }
+    return makeTxBody(input).ByteSizeLong();
 }
 
 std::string buildAuthInfo(const Proto::SigningInput& input, TWCoinType coin) {
@@ -341,54 +350,142 @@ std::string buildAuthInfo(const Proto::SigningInput& input, TWCoinType coin) {
         return input.messages(0).sign_direct_message().auth_info_bytes();
     }
 
-    // AuthInfo
     const auto privateKey = PrivateKey(input.private_key());
     const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
-    auto authInfo = cosmos::AuthInfo();
-    auto* signerInfo = authInfo.add_signer_infos();
+    return AuthInfoBuilder(Data(publicKey.bytes), input.fee(), coin).build(input.sequence());
+}
+
+std::size_t authInfoSize(const Proto::SigningInput& input, TWCoinType coin) {
+    if (input.messages_size() >= 1 && input.messages(0).has_sign_direct_message()) {
+        return input.messages(0).sign_direct_message().auth_info_bytes().size();
+    }
+    return AuthInfoBuilder(Data(PublicKey::secp256k1Size), input.fee(), coin).size(input.sequence());
+}
+
+namespace {
+
+// Protobuf wire format, for the messages written field by field
+constexpr uint32_t varintWireType = 0;
+constexpr uint32_t lengthDelimitedWireType = 2;
+
+template <typename Buffer>
+void appendVarint(uint64_t value, Buffer& out) {
+    for (; value >= 0x80; value >>= 7) {
+        out.push_back(static_cast<typename Buffer::value_type>(value | 0x80));
+    }
+    out.push_back(static_cast<typename Buffer::value_type>(value));
+}
+
+std::size_t varintSize(uint64_t value) {
+    std::size_t size = 1;
+    for (; value >= 0x80; value >>= 7) {
+        ++size;
+    }
+    return size;
+}
+
+/// Size of a length-delimited field with a number below 16, whose tag is a single byte.
+std::size_t bytesFieldSize(std::size_t size) {
+    return 1 + varintSize(size) + size;
+}
 
-    signerInfo->mutable_mode_info()->mutable_single()->set_mode(cosmos::signing::v1beta1::SIGN_MODE_DIRECT);
-    signerInfo->set_sequence(input.sequence());
+template <typename Buffer>
+void appendBytesField(uint32_t field, std::string_view bytes, Buffer& out) {
+    appendVarint(field << 3 | lengthDelimitedWireType, out);
+    appendVarint(bytes.size(), out);
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+/// Appends a varint field, omitted if zero like proto3 does.
+template <typename Buffer>
+void appendVarintField(uint32_t field, uint64_t value, Buffer& out) {
+    if (value == 0) {
+        return;
+    }
+    appendVarint(field << 3 | varintWireType, out);
+    appendVarint(value, out);
+}
+
+} // namespace
+
+AuthInfoBuilder::AuthInfoBuilder(const Data& publicKey, const Proto::Fee& fee, TWCoinType coin) {
+    auto info = cosmos::SignerInfo();
+    info.mutable_mode_info()->mutable_single()->set_mode(cosmos::signing::v1beta1::SIGN_MODE_DIRECT);
     switch(coin) {
         case TWCoinTypeNativeEvmos: {
             auto pubKey = ethermint::crypto::v1::ethsecp256k1::PubKey();
-            pubKey.set_key(publicKey.bytes.data(), publicKey.bytes.size());
-            signerInfo->mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
+            pubKey.set_key(publicKey.data(), publicKey.size());
+            info.mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
             break;
         }
         case TWCoinTypeNativeInjective: {
             auto pubKey = injective::crypto::v1beta1::ethsecp256k1::PubKey();
-            pubKey.set_key(publicKey.bytes.data(), publicKey.bytes.size());
-            signerInfo->mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
+            pubKey.set_key(publicKey.data(), publicKey.size());
+            info.mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
             break;
         }
         default: {
             auto pubKey = cosmos::crypto::secp256k1::PubKey();
-            pubKey.set_key(publicKey.bytes.data(), publicKey.bytes.size());
-            signerInfo->mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
+            pubKey.set_key(publicKey.data(), publicKey.size());
+            info.mutable_public_key()->PackFrom(pubKey, ProtobufAnyNamespacePrefix);
         }
     }
+    // the sequence is left out, and appended by `build`
+    signerInfo = info.SerializeAsString();
 
-    auto* fee = authInfo.mutable_fee();
-    for (auto i = 0; i < input.fee().amounts_size(); ++i) {
-        *fee->add_amount() = convertCoin(input.fee().amounts(i));
+    auto authInfo = cosmos::AuthInfo();
+    auto* authFee = authInfo.mutable_fee();
+    for (auto i = 0; i < fee.amounts_size(); ++i) {
+        *authFee->add_amount() = convertCoin(fee.amounts(i));
     }
-
-    fee->set_gas_limit(input.fee().gas());
-    fee->set_payer("");
-    fee->set_granter("");
+    authFee->set_gas_limit(fee.gas());
+    authFee->set_payer("");
+    authFee->set_granter("");
     // tip is omitted
-    return authInfo.SerializeAsString();
+    feeField = authInfo.SerializeAsString();
+}
+
+std::string AuthInfoBuilder::build(uint64_t sequence) const {
+    const auto sequenceSize = sequence == 0 ? 0 : 1 + varintSize(sequence);
+    const auto signerInfoSize = signerInfo.size() + sequenceSize;
+
+    std::string authInfo;
+    authInfo.reserve(bytesFieldSize(signerInfoSize) + feeField.size());
+    // signer_infos, with the sequence as last field
+    appendVarint(1 << 3 | lengthDelimitedWireType, authInfo);
+    appendVarint(signerInfoSize, authInfo);
+    authInfo.append(signerInfo);
+    appendVarintField(3, sequence, authInfo);
+    authInfo.append(feeField);
+    return authInfo;
+}
+
+std::size_t AuthInfoBuilder::size(uint64_t sequence) const {
+    const auto sequenceSize = sequence == 0 ? 0 : 1 + varintSize(sequence);
+    return bytesFieldSize(signerInfo.size() + sequenceSize) + feeField.size();
+}
+
+Data buildSignDoc(std::string_view serializedTxBody, std::string_view serializedAuthInfo, const std::string& chainId, uint64_t accountNumber) {
+    Data signDoc;
+    signDoc.reserve(bytesFieldSize(serializedTxBody.size()) + bytesFieldSize(serializedAuthInfo.size()) +
+                    bytesFieldSize(chainId.size()) + 1 + varintSize(accountNumber));
+    // Fields in field number order, empty ones omitted, like SignDoc::SerializeAsString
+    if (!serializedTxBody.empty()) {
+        appendBytesField(1, serializedTxBody, signDoc);
+    }
+    if (!serializedAuthInfo.empty()) {
+        appendBytesField(2, serializedAuthInfo, signDoc);
+    }
+    if (!chainId.empty()) {
+        appendBytesField(3, chainId, signDoc);
+    }
+    appendVarintField(4, accountNumber, signDoc);
+    return signDoc;
 }
 
 Data buildSignature(const Proto::SigningInput& input, const std::string& serializedTxBody, const std::string& serializedAuthInfo, TWCoinType coin) {
     // SignDoc Preimage
-    auto signDoc = cosmos::SignDoc();
-    signDoc.set_body_bytes(serializedTxBody);
-    signDoc.set_auth_info_bytes(serializedAuthInfo);
-    signDoc.set_chain_id(input.chain_id());
-    signDoc.set_account_number(input.account_number());
-    const auto serializedSignDoc = signDoc.SerializeAsString();
+    const auto serializedSignDoc = buildSignDoc(serializedTxBody, serializedAuthInfo, input.chain_id(), input.account_number());
 
     Data hashToSign;
     switch(coin) {
@@ -409,11 +506,23 @@ Data buildSignature(const Proto::SigningInput& input, const std::string& seriali
 }
 
 std::string buildProtoTxRaw(const std::string& serializedTxBody, const std::string& serializedAuthInfo, const Data& signature) {
-    auto txRaw = cosmos::TxRaw();
-    txRaw.set_body_bytes(serializedTxBody);
-    txRaw.set_auth_info_bytes(serializedAuthInfo);
-    *txRaw.add_signatures() = std::string(signature.begin(), signature.end());
-    return txRaw.SerializeAsString();
+    std::string txRaw;
+    txRaw.reserve(bytesFieldSize(serializedTxBody.size()) + bytesFieldSize(serializedAuthInfo.size()) +
+                  bytesFieldSize(signature.size()));
+    // Fields in field number order, empty ones omitted, like TxRaw::SerializeAsString; the signature always is written
+    if (!serializedTxBody.empty()) {
+        appendBytesField(1, serializedTxBody, txRaw);
+    }
+    if (!serializedAuthInfo.empty()) {
+        appendBytesField(2, serializedAuthInfo, txRaw);
+    }
+    appendBytesField(3, std::string_view(reinterpret_cast<const char*>(signature.data()), signature.size()), txRaw);
+    return txRaw;
+}
+
+std::size_t protoTxRawSize(std::size_t txBodySize, std::size_t authInfoSize, std::size_t signatureSize) {
+    return (txBodySize == 0 ? 0 : bytesFieldSize(txBodySize)) + (authInfoSize == 0 ? 0 : bytesFieldSize(authInfoSize)) +
+           bytesFieldSize(signatureSize);
 }
 
 static string broadcastMode(Proto::BroadcastMode mode) {
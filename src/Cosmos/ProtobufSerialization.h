@@ -11,6 +11,7 @@
 
 #include <nlohmann/json.hpp>
 #include <string>
+#include <string_view>
 
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -18,12 +19,44 @@ namespace TW::Cosmos::Protobuf {
 
 std::string buildProtoTxBody(const Proto::SigningInput& input);
 
+/// Serialized size of the TxBody, without serializing it.
+std::size_t protoTxBodySize(const Proto::SigningInput& input);
+
 std::string buildAuthInfo(const Proto::SigningInput& input, TWCoinType coin);
 
+/// Serialized size of the AuthInfo, without deriving the public key: a compressed key always has the same size.
+std::size_t authInfoSize(const Proto::SigningInput& input, TWCoinType coin);
+
+/// Serializes the AuthInfo of a single SIGN_MODE_DIRECT signer.
+/// The public key, sign mode and fee are serialized once, the builder then only writes the sequence, so that
+/// the same signer and fee are cheap to encode for many sequences.
+class AuthInfoBuilder {
+public:
+    AuthInfoBuilder(const Data& publicKey, const Proto::Fee& fee, TWCoinType coin);
+
+    /// Returns the serialized AuthInfo with the given signer sequence.
+    std::string build(uint64_t sequence) const;
+
+    /// Size of the serialized AuthInfo with the given signer sequence.
+    std::size_t size(uint64_t sequence) const;
+
+private:
+    /// The SignerInfo without its sequence, which is its last field.
+    std::string signerInfo;
+    /// The fee field of the AuthInfo, which follows the signer infos.
+    std::string feeField;
+};
+
+/// Serializes the SignDoc, the signature preimage, in one pass.
+Data buildSignDoc(std::string_view serializedTxBody, std::string_view serializedAuthInfo, const std::string& chainId, uint64_t accountNumber);
+
 Data buildSignature(const Proto::SigningInput& input, const std::string& serializedTxBody, const std::string& serializedAuthInfo, TWCoinType coin);
 
 std::string buildProtoTxRaw(const std::string& serializedTxBody, const std::string& serializedAuthInfo, const Data& signature);
 
+/// Serialized size of the TxRaw of `buildProtoTxRaw` with parts of the given sizes.
+std::size_t protoTxRawSize(std::size_t txBodySize, std::size_t authInfoSize, std::size_t signatureSize);
+
 std::string buildProtoTxJson(const Proto::SigningInput& input, const std::string& serializedTx);
 
 nlohmann::json wasmExecuteTransferPayload(const Proto::Message_WasmExecuteContractTransfer& msg);
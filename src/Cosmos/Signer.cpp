@@ -10,10 +10,58 @@
 
 #include "PrivateKey.h"
 #include "Data.h"
-#include <google/protobuf/util/json_util.h>
+#include "../proto/Common.pb.h"
+#include "../proto/Cosmos.json.pb.h"
 
 namespace TW::Cosmos {
 
+namespace {
+
+/// Gas of each byte of the transaction, the TxSizeCostPerByte default of the auth module.
+constexpr uint64_t gasPerByte = 10;
+/// Gas of the verification of a secp256k1 signature, the SigVerifyCostSecp256k1 default of the auth module.
+constexpr uint64_t signatureGas = 1000;
+/// Signature size in a TxRaw, R and S.
+constexpr std::size_t signatureSize = 64;
+
+/// Heuristic execution gas of a message, from the usual gas used by its type on the Cosmos Hub and similar chains.
+uint64_t messageGas(const Proto::Message& message) {
+    switch (message.message_oneof_case()) {
+    case Proto::Message::kSendCoinsMessage:
+    case Proto::Message::kThorchainSendMessage:
+        return 50'000;
+    case Proto::Message::kTransferTokensMessage:
+        return 90'000;
+    case Proto::Message::kStakeMessage:
+        return 150'000;
+    case Proto::Message::kUnstakeMessage:
+        return 170'000;
+    case Proto::Message::kRestakeMessage:
+        return 230'000;
+    case Proto::Message::kWithdrawStakeRewardMessage:
+        return 90'000;
+    case Proto::Message::kWasmTerraExecuteContractTransferMessage:
+    case Proto::Message::kWasmTerraExecuteContractSendMessage:
+    case Proto::Message::kWasmTerraExecuteContractGeneric:
+    case Proto::Message::kWasmExecuteContractTransferMessage:
+    case Proto::Message::kWasmExecuteContractSendMessage:
+    case Proto::Message::kWasmExecuteContractGeneric:
+        return 180'000;
+    case Proto::Message::kAuthGrant:
+    case Proto::Message::kAuthRevoke:
+        return 60'000;
+    case Proto::Message::kMsgVote:
+        return 40'000;
+    case Proto::Message::kMsgStrideLiquidStakingStake:
+    case Proto::Message::kMsgStrideLiquidStakingRedeem:
+        return 200'000;
+    default:
+        return 100'000;
+    }
+}
+
+} // namespace
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, TWCoinType coin) noexcept {
     switch (input.signing_mode()) {
     case Proto::JSON:
@@ -26,20 +74,28 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, TWCoinType c
 }
 
 Proto::SigningOutput Signer::signJsonSerialized(const Proto::SigningInput& input, TWCoinType coin) noexcept {
-    auto key = PrivateKey(input.private_key());
-    auto preimage = Json::signaturePreimageJSON(input).dump();
-    auto hash = Hash::sha256(preimage);
-    auto signedHash = key.sign(hash, TWCurveSECP256k1);
-
-    auto output = Proto::SigningOutput();
-    auto signature = Data(signedHash.begin(), signedHash.end() - 1);
-    auto txJson = Json::transactionJSON(input, signature, coin);
-    output.set_json(txJson.dump());
-    output.set_signature(signature.data(), signature.size());
-    output.set_serialized("");
-    output.set_error("");
-    output.set_signature_json(txJson["tx"]["signatures"].dump());
-    return output;
+    try {
+        auto key = PrivateKey(input.private_key());
+        auto preimage = Json::signaturePreimage(input);
+        auto hash = Hash::sha256(preimage);
+        auto signedHash = key.sign(hash, TWCurveSECP256k1);
+
+        auto output = Proto::SigningOutput();
+        auto signature = Data(signedHash.begin(), signedHash.end() - 1);
+        auto txJson = Json::transactionJSON(input, signature, coin);
+        output.set_json(txJson.dump());
+        output.set_signature(signature.data(), signature.size());
+        output.set_serialized("");
+        output.set_error("");
+        if ((input.skip_outputs() & Common::Proto::OutputField_json) == 0) {
+            output.set_signature_json(txJson["tx"]["signatures"].dump());
+        }
+        return output;
+    } catch (const std::exception& ex) {
+        auto output = Proto::SigningOutput();
+        output.set_error(std::string("Error: ") + ex.what());
+        return output;
+    }
 }
 
 Proto::SigningOutput Signer::signProtobuf(const Proto::SigningInput& input, TWCoinType coin) noexcept {
@@ -53,13 +109,15 @@ Proto::SigningOutput Signer::signProtobuf(const Proto::SigningInput& input, TWCo
 
         auto output = Proto::SigningOutput();
         const std::string jsonSerialized = buildProtoTxJson(input, serializedTxRaw);
-        auto publicKey = PrivateKey(input.private_key()).getPublicKey(TWPublicKeyTypeSECP256k1);
-        auto signatures = nlohmann::json::array({signatureJSON(signature, publicKey.bytes, coin)});
         output.set_serialized(jsonSerialized);
         output.set_signature(signature.data(), signature.size());
         output.set_json("");
         output.set_error("");
-        output.set_signature_json(signatures.dump());
+        if ((input.skip_outputs() & Common::Proto::OutputField_json) == 0) {
+            auto publicKey = PrivateKey(input.private_key()).getPublicKey(TWPublicKeyTypeSECP256k1);
+            auto signatures = nlohmann::json::array({signatureJSON(signature, Data(publicKey.bytes), coin)});
+            output.set_signature_json(signatures.dump());
+        }
         return output;
     } catch (const std::exception& ex) {
         auto output = Proto::SigningOutput();
@@ -68,9 +126,37 @@ Proto::SigningOutput Signer::signProtobuf(const Proto::SigningInput& input, TWCo
     }
 }
 
+Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input, TWCoinType coin) noexcept {
+    auto plan = Proto::TransactionPlan();
+    if (input.signing_mode() != Proto::Protobuf) {
+        plan.set_error("Error: plan is only supported in Protobuf signing mode");
+        return plan;
+    }
+    try {
+        const auto txSize = Protobuf::protoTxRawSize(Protobuf::protoTxBodySize(input), Protobuf::authInfoSize(input, coin), signatureSize);
+        uint64_t gas = txSize * gasPerByte + signatureGas;
+        if (input.messages(0).has_sign_direct_message()) {
+            plan.add_message_gas(messageGas(input.messages(0)));
+        } else {
+            for (const auto& message : input.messages()) {
+                plan.add_message_gas(messageGas(message));
+            }
+        }
+        for (const auto each : plan.message_gas()) {
+            gas += each;
+        }
+        plan.set_tx_size(txSize);
+        plan.set_gas(gas);
+    } catch (const std::exception& ex) {
+        plan.Clear();
+        plan.set_error(std::string("Error: ") + ex.what());
+    }
+    return plan;
+}
+
 std::string Signer::signJSON(const std::string& json, const Data& key, TWCoinType coin) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input, coin);
     return output.json();
@@ -25,6 +25,10 @@ class Signer {
     /// Signs a Proto::SigningInput transaction, using binary Protobuf serialization
     static Proto::SigningOutput signProtobuf(const Proto::SigningInput& input, TWCoinType coin) noexcept;
 
+    /// Computes the exact size of the signed TxRaw and estimates the gas of a Protobuf mode transaction, without signing
+    /// it or deriving its public key, for fee quotes
+    static Proto::TransactionPlan plan(const Proto::SigningInput& input, TWCoinType coin) noexcept;
+
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key, TWCoinType coin);
 };
@@ -0,0 +1,70 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CpuFeatures.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#define TW_CPU_FEATURES_X86 1
+#endif
+
+namespace TW::CpuFeatures {
+
+namespace {
+
+struct Features {
+    bool avx2 = false;
+    bool shani = false;
+    bool aesni = false;
+};
+
+Features detect() noexcept {
+    Features features;
+#if defined(TW_CPU_FEATURES_X86)
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+        return features;
+    }
+    const auto ssse3 = (ecx & bit_SSSE3) != 0;
+    const auto sse41 = (ecx & bit_SSE4_1) != 0;
+    features.aesni = ssse3 && (ecx & bit_AES) != 0;
+
+    // the OS saves the AVX registers
+    auto avxEnabled = false;
+    if ((ecx & bit_OSXSAVE) != 0) {
+        unsigned xcr0Low = 0, xcr0High = 0;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        avxEnabled = (xcr0Low & 0x6) == 0x6;
+    }
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0) {
+        features.avx2 = avxEnabled && (ebx & bit_AVX2) != 0;
+        features.shani = ssse3 && sse41 && (ebx & bit_SHA) != 0;
+    }
+#endif
+    return features;
+}
+
+const Features& features() noexcept {
+    static const auto detected = detect();
+    return detected;
+}
+
+} // namespace
+
+bool avx2() noexcept {
+    return features().avx2;
+}
+
+bool shani() noexcept {
+    return features().shani;
+}
+
+bool aesni() noexcept {
+    return features().aesni;
+}
+
+} // namespace TW::CpuFeatures
@@ -0,0 +1,23 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+namespace TW::CpuFeatures {
+
+/// Instruction set extensions used by the accelerated hash functions, detected once with cpuid.
+/// All of them are false on other architectures than x86-64, or with other compilers than GCC and Clang.
+
+/// Whether the CPU supports AVX2, and the OS saves the AVX registers.
+bool avx2() noexcept;
+
+/// Whether the CPU supports the SHA extensions, with SSSE3 and SSE4.1.
+bool shani() noexcept;
+
+/// Whether the CPU supports AES-NI, with SSSE3.
+bool aesni() noexcept;
+
+} // namespace TW::CpuFeatures
@@ -6,6 +6,7 @@
 
 #include "Crc.h"
 
+#include <array>
 #include <limits>
 #include <string>
 
@@ -34,9 +35,34 @@ uint16_t Crc::crc16(uint8_t* bytes, uint32_t length) {
 // Algorithm inspired by this old-style C implementation:
 // https://web.mit.edu/freebsd/head/sys/libkern/crc32.c (Public Domain code)
 uint32_t Crc::crc32(const Data& data) {
+    return crc32(data.data(), data.size());
+}
+
+uint32_t Crc::crc32(const uint8_t* _Nonnull data, size_t size) {
+    uint32_t c = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < size; ++i) {
+        c = crc32_table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    return ~c;
+}
+
+// Lookup table for the reflected Castagnoli polynomial 0x82F63B78
+static constexpr std::array<uint32_t, 256> crc32cTable = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < table.size(); ++i) {
+        uint32_t c = i;
+        for (auto bit = 0; bit < 8; ++bit) {
+            c = (c & 1) ? (c >> 1) ^ 0x82F63B78 : (c >> 1);
+        }
+        table[i] = c;
+    }
+    return table;
+}();
+
+uint32_t Crc::crc32c(const uint8_t* _Nonnull data, size_t size) {
     uint32_t c = std::numeric_limits<uint32_t>::max();
-    for (const auto byte : data) {
-        c = crc32_table[(c ^ byte) & 0xFF] ^ (c >> 8);
+    for (size_t i = 0; i < size; ++i) {
+        c = crc32cTable[(c ^ data[i]) & 0xFF] ^ (c >> 8);
     }
     return ~c;
 }
@@ -17,6 +17,11 @@ uint16_t crc16(uint8_t* bytes, uint32_t length);
 
 uint32_t crc32(const TW::Data& data);
 
+uint32_t crc32(const uint8_t* _Nonnull data, size_t size);
+
+/// CRC32C (Castagnoli), as used e.g. by TON bag-of-cells
+uint32_t crc32c(const uint8_t* _Nonnull data, size_t size);
+
 // Table taken from https://web.mit.edu/freebsd/head/sys/libkern/crc32.c (Public Domain code)
 // This table is used to speed up the crc calculation.
 static constexpr uint32_t crc32_table[] = {
@@ -0,0 +1,126 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CryptoBackend.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/ed25519.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <atomic>
+
+namespace TW {
+
+namespace {
+
+const CryptoBackend defaultBackend;
+
+std::atomic<const CryptoBackend*> installedBackend{&defaultBackend};
+
+const ecdsa_curve* ecdsaCurve(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+        return &secp256k1;
+    case TWCurveNIST256p1:
+        return &nist256p1;
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace
+
+const CryptoBackend& CryptoBackend::current() noexcept {
+    return *installedBackend.load(std::memory_order_acquire);
+}
+
+bool CryptoBackend::isDefault() noexcept {
+    return &current() == &defaultBackend;
+}
+
+void CryptoBackend::install(const CryptoBackend* backend) noexcept {
+    installedBackend.store(backend != nullptr ? backend : &defaultBackend, std::memory_order_release);
+}
+
+bool CryptoBackend::ecdsaGetPublicKey(TWCurve curve, const byte* privateKey, bool compressed, byte* publicKey) const {
+    const auto* params = ecdsaCurve(curve);
+    if (params == nullptr) {
+        return false;
+    }
+    if (compressed) {
+        return ecdsa_get_public_key33(params, privateKey, publicKey) == 0;
+    }
+    return ecdsa_get_public_key65(params, privateKey, publicKey) == 0;
+}
+
+bool CryptoBackend::ecdsaSign(TWCurve curve, const byte* privateKey, const byte* digest, byte* signature, byte* recoveryId,
+                              CanonicalChecker canonicalChecker) const {
+    const auto* params = ecdsaCurve(curve);
+    return params != nullptr && ecdsa_sign_digest(params, privateKey, digest, signature, recoveryId, canonicalChecker) == 0;
+}
+
+bool CryptoBackend::ecdsaVerify(TWCurve curve, const byte* publicKey, const byte* signature, const byte* digest) const {
+    const auto* params = ecdsaCurve(curve);
+    return params != nullptr && ecdsa_verify_digest(params, publicKey, signature, digest) == 0;
+}
+
+int CryptoBackend::ecdsaRecover(TWCurve curve, const byte* signature, int recoveryId, const byte* digest, byte* publicKey) const {
+    const auto* params = ecdsaCurve(curve);
+    if (params == nullptr) {
+        return -1;
+    }
+    return ecdsa_recover_pub_from_sig(params, publicKey, signature, digest, recoveryId);
+}
+
+bool CryptoBackend::eddsaGetPublicKey(TWCurve curve, const byte* privateKey, byte* publicKey) const {
+    switch (curve) {
+    case TWCurveED25519:
+        ed25519_publickey(privateKey, publicKey);
+        return true;
+    case TWCurveED25519Blake2bNano:
+        ed25519_publickey_blake2b(privateKey, publicKey);
+        return true;
+    case TWCurveED25519ExtendedCardano:
+        ed25519_publickey_ext(privateKey, publicKey);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool CryptoBackend::eddsaSign(TWCurve curve, const byte* privateKey, const byte* extension, const byte* message,
+                              std::size_t size, byte* signature) const {
+    switch (curve) {
+    case TWCurveED25519:
+        ed25519_sign(message, size, privateKey, signature);
+        return true;
+    case TWCurveED25519Blake2bNano:
+        ed25519_sign_blake2b(message, size, privateKey, signature);
+        return true;
+    case TWCurveED25519ExtendedCardano:
+        ed25519_sign_ext(message, size, privateKey, extension, signature);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool CryptoBackend::eddsaVerify(TWCurve curve, const byte* publicKey, const byte* message, std::size_t size,
+                                const byte* signature) const {
+    switch (curve) {
+    case TWCurveED25519:
+    case TWCurveED25519ExtendedCardano:
+        return ed25519_sign_open(message, size, publicKey, signature) == 0;
+    case TWCurveED25519Blake2bNano:
+        return ed25519_sign_open_blake2b(message, size, publicKey, signature) == 0;
+    default:
+        return false;
+    }
+}
+
+} // namespace TW
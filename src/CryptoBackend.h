@@ -0,0 +1,72 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrustWalletCore/TWCurve.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TW {
+
+/// The ECDSA and EdDSA primitives behind `PrivateKey`, `PublicKey` and `SigningContext`.
+///
+/// This class is the default backend and implements them with trezor-crypto. Another implementation,
+/// e.g. libsecp256k1 or a hardware security module, is plugged in by deriving from it, overriding the
+/// operations it provides, delegating the other curves to the base class, and installing it at initialization.
+///
+/// ECDSA operations cover `TWCurveSECP256k1` and `TWCurveNIST256p1`; EdDSA operations cover `TWCurveED25519`,
+/// `TWCurveED25519Blake2bNano` and `TWCurveED25519ExtendedCardano`. Other curves are rejected.
+class CryptoBackend {
+public:
+    using CanonicalChecker = int (*)(uint8_t by, uint8_t sig[64]);
+
+    virtual ~CryptoBackend() = default;
+
+    /// Returns the installed backend.
+    static const CryptoBackend& current() noexcept;
+
+    /// Returns true if the trezor-crypto backend is installed, which also enables its batch functions.
+    static bool isDefault() noexcept;
+
+    /// Installs `backend`, or restores the default one if it is null.
+    /// The backend must outlive its use; install it before keys are used from other threads.
+    static void install(const CryptoBackend* backend) noexcept;
+
+    /// Writes the public key of a 32-byte private key, 33 bytes if `compressed` or 65 bytes otherwise.
+    /// \returns false if the private key is not valid on the curve
+    virtual bool ecdsaGetPublicKey(TWCurve curve, const byte* privateKey, bool compressed, byte* publicKey) const;
+
+    /// Signs a 32-byte digest with a deterministic (RFC6979) nonce, writing r | s (64 bytes) and the recovery id.
+    /// Only signatures accepted by `canonicalChecker`, if given, are returned.
+    virtual bool ecdsaSign(TWCurve curve, const byte* privateKey, const byte* digest, byte* signature, byte* recoveryId,
+                           CanonicalChecker canonicalChecker) const;
+
+    /// Verifies an r | s signature of a 32-byte digest against a 33- or 65-byte public key.
+    virtual bool ecdsaVerify(TWCurve curve, const byte* publicKey, const byte* signature, const byte* digest) const;
+
+    /// Recovers the 65-byte public key of an r | s signature of a 32-byte digest.
+    /// \returns 0 on success, a backend specific error code otherwise
+    virtual int ecdsaRecover(TWCurve curve, const byte* signature, int recoveryId, const byte* digest, byte* publicKey) const;
+
+    /// Writes the 32-byte public key of a 32-byte private key.
+    /// For Cardano the private key is the first half of the extended key, which is used as the scalar as is.
+    virtual bool eddsaGetPublicKey(TWCurve curve, const byte* privateKey, byte* publicKey) const;
+
+    /// Signs a message into a 64-byte signature. `extension` is the second half of the extended key for Cardano,
+    /// and ignored otherwise.
+    virtual bool eddsaSign(TWCurve curve, const byte* privateKey, const byte* extension, const byte* message,
+                           std::size_t size, byte* signature) const;
+
+    /// Verifies a 64-byte signature of a message against a 32-byte public key.
+    virtual bool eddsaVerify(TWCurve curve, const byte* publicKey, const byte* message, std::size_t size,
+                             const byte* signature) const;
+};
+
+} // namespace TW
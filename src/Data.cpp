@@ -9,6 +9,14 @@
 namespace TW {
 
 Data subData(const Data& data, size_t startIndex, size_t length) {
+    return subData(std::span<const byte>(data), startIndex, length);
+}
+
+Data subData(const Data& data, size_t startIndex) {
+    return subData(std::span<const byte>(data), startIndex);
+}
+
+Data subData(std::span<const byte> data, size_t startIndex, size_t length) {
     if (startIndex >= data.size()) {
         return Data();
     }
@@ -16,7 +24,7 @@ Data subData(const Data& data, size_t startIndex, size_t length) {
     return TW::data(data.data() + startIndex, subLength);
 }
 
-Data subData(const Data& data, size_t startIndex) {
+Data subData(std::span<const byte> data, size_t startIndex) {
     if (startIndex >= data.size()) {
         return Data();
     }
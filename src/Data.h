@@ -10,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <span>
 
 namespace TW {
 
@@ -47,6 +48,11 @@ inline void append(Data& data, const Data& suffix) {
     data.insert(data.end(), suffix.begin(), suffix.end());
 }
 
+/// Appends a view, e.g. of an `InlineData` key.
+inline void append(Data& data, std::span<const byte> suffix) {
+    data.insert(data.end(), suffix.begin(), suffix.end());
+}
+
 inline Data concat(const Data& data, const Data& suffix) {
     Data out = data;
     append(out, suffix);
@@ -63,6 +69,12 @@ Data subData(const Data& data, size_t startIndex, size_t length);
 /// Return the tail part (subdata) from the requested start position of the input data.
 Data subData(const Data& data, size_t startIndex);
 
+/// Return a part (subdata) of a view, e.g. of an `InlineData` key; as above.
+Data subData(std::span<const byte> data, size_t startIndex, size_t length);
+
+/// Return the tail part (subdata) of a view.
+Data subData(std::span<const byte> data, size_t startIndex);
+
 /// Determines if a byte array has a specific prefix.
 template <typename T>
 inline bool has_prefix(const Data& data, T& prefix) {
@@ -0,0 +1,53 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "DataVector.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace TW {
+
+DataVector::DataVector(Data bytes, std::vector<std::size_t> offsets)
+    : bytes(std::move(bytes)), offsets(std::move(offsets)) {
+    if (this->offsets.empty() || this->offsets.front() != 0 || this->offsets.back() != this->bytes.size() ||
+        !std::is_sorted(this->offsets.begin(), this->offsets.end())) {
+        throw std::invalid_argument("Invalid packed offsets");
+    }
+}
+
+DataVector::DataVector(const std::vector<Data>& elements) {
+    std::size_t size = 0;
+    for (const auto& element : elements) {
+        size += element.size();
+    }
+    reserve(elements.size(), size);
+    for (const auto& element : elements) {
+        push_back(element);
+    }
+}
+
+void DataVector::reserve(std::size_t count, std::size_t size) {
+    bytes.reserve(bytes.size() + size);
+    offsets.reserve(offsets.size() + count);
+}
+
+void DataVector::push_back(std::span<const byte> element) {
+    bytes.insert(bytes.end(), element.begin(), element.end());
+    offsets.push_back(bytes.size());
+}
+
+std::vector<Data> DataVector::toVector() const {
+    std::vector<Data> result;
+    result.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        const auto element = (*this)[i];
+        result.emplace_back(element.begin(), element.end());
+    }
+    return result;
+}
+
+} // namespace TW
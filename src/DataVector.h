@@ -0,0 +1,63 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <span>
+#include <vector>
+
+namespace TW {
+
+/// Byte arrays packed one after the other in a single buffer, with an offset table:
+/// element `i` is `[offsets[i], offsets[i + 1])` of the buffer. Adding an element appends to the buffer,
+/// and elements are viewed in place, so a vector of n elements costs two allocations instead of n + 1.
+class DataVector {
+public:
+    DataVector() = default;
+
+    /// Takes the packed buffer and the `count + 1` offsets: the start of each element followed by the end of the last one.
+    /// \throws std::invalid_argument if the offsets don't go from 0 to the buffer size without decreasing.
+    DataVector(Data bytes, std::vector<std::size_t> offsets);
+
+    /// Packs copies of `elements`.
+    explicit DataVector(const std::vector<Data>& elements);
+
+    std::size_t size() const noexcept { return offsets.size() - 1; }
+    bool empty() const noexcept { return size() == 0; }
+
+    /// View of element `index`, valid until the vector is modified.
+    std::span<const byte> operator[](std::size_t index) const noexcept {
+        return {bytes.data() + offsets[index], offsets[index + 1] - offsets[index]};
+    }
+
+    /// Reserves room for `count` more elements of `size` bytes in total.
+    void reserve(std::size_t count, std::size_t size);
+
+    /// Appends a copy of `element`.
+    void push_back(std::span<const byte> element);
+
+    /// Copies of the elements.
+    std::vector<Data> toVector() const;
+
+    /// The elements one after the other.
+    const Data& packedBytes() const noexcept { return bytes; }
+
+    /// The start of each element followed by the end of the last one.
+    const std::vector<std::size_t>& packedOffsets() const noexcept { return offsets; }
+
+private:
+    Data bytes;
+    std::vector<std::size_t> offsets{0};
+};
+
+} // namespace TW
+
+/// Wrapper for C interface.
+struct TWDataVector {
+    TW::DataVector impl;
+};
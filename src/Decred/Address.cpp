@@ -17,7 +17,7 @@ static const auto keyhashSize = Hash::ripemdSize;
 static const auto addressDataSize = keyhashSize + 2;
 
 bool Address::isValid(const std::string& string) noexcept {
-    const auto data = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherBlake256d);
+    const auto data = Base58::decodeCheck<Hash::HasherBlake256d>(string);
     if (data.size() != addressDataSize) {
         return false;
     }
@@ -30,7 +30,7 @@ bool Address::isValid(const std::string& string) noexcept {
 }
 
 Address::Address(const std::string& string) {
-    const auto data = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherBlake256d);
+    const auto data = Base58::decodeCheck<Hash::HasherBlake256d>(string);
     if (data.size() != addressDataSize) {
         throw std::invalid_argument("Invalid address string");
     }
@@ -42,14 +42,14 @@ Address::Address(const PublicKey& publicKey) {
     if (publicKey.type != TWPublicKeyTypeSECP256k1) {
         throw std::invalid_argument("Invalid public key type");
     }
-    const auto hash = Hash::ripemd(Hash::blake256(publicKey.bytes));
+    const auto hash = publicKey.hash<Hash::HasherBlake256ripemd>();
     std::copy(hash.begin(), hash.end(), bytes.begin() + 2);
     bytes[0] = TW::staticPrefix(TWCoinTypeDecred);
     bytes[1] = TW::p2pkhPrefix(TWCoinTypeDecred);
 }
 
 std::string Address::string() const {
-    return Base58::encodeCheck(bytes, Rust::Base58Alphabet::Bitcoin, Hash::HasherBlake256d);
+    return Base58::encodeCheck<Hash::HasherBlake256d>(bytes);
 }
 
 } // namespace TW::Decred
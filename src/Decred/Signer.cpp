@@ -47,6 +47,7 @@ Result<Transaction, Common::Proto::SigningError> Signer::sign() {
     }
 
     signedInputs = _transaction.inputs;
+    sigHashCache.clear();
 
     const auto hashSingle = Bitcoin::hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
     for (auto i = 0ul; i < txPlan.utxos.size(); i += 1) {
@@ -99,9 +100,8 @@ Result<Bitcoin::Script, Common::Proto::SigningError> Signer::sign(Bitcoin::Scrip
 }
 
 Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin::Script script, size_t index) {
-    Transaction transactionToSign(_transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = _transaction.outputs;
+    // The signature hash doesn't commit to input scripts, so the inputs signed so far don't matter
+    const auto& transactionToSign = _transaction;
 
     Data data;
     std::vector<Data> keys;
@@ -133,7 +133,7 @@ Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin:
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
         }
-        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, pubkey.bytes});
+        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, Data(pubkey.bytes)});
     } else if (script.matchPayToScriptHash(data)) {
         auto redeemScript = scriptForScriptHash(data);
         if (redeemScript.empty()) {
@@ -170,7 +170,8 @@ Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin:
 
 Data Signer::createSignature(const Transaction& transaction, const Bitcoin::Script& script,
                              const Data& key, size_t index) {
-    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()));
+    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()),
+                                                    &sigHashCache);
     auto pk = PrivateKey(key);
     auto signature = pk.signAsDER(Data(begin(sighash), end(sighash)));
     if (script.empty()) {
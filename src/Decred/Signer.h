@@ -47,6 +47,9 @@ class Signer {
     /// List of signed inputs.
     Bitcoin::TransactionInputs<TransactionInput> signedInputs;
 
+    /// Transaction-wide sighash parts, shared by all inputs during one `sign()` pass.
+    Bitcoin::SigHashCache sigHashCache;
+
   public:
     /// Initializes a transaction signer.
     Signer() = default;
@@ -9,6 +9,8 @@
 #include "../Bitcoin/SigHashType.h"
 #include "../BinaryCoding.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 namespace TW::Decred {
@@ -19,13 +21,10 @@ static const uint32_t sigHashSerializePrefix = 1;
 
 // Indicates the serialization only contains witness data.
 static const uint32_t sigHashSerializeWitness = 3;
-
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript);
 } // namespace
 
 Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, size_t index,
-                                       enum TWBitcoinSigHashType hashType) const {
+                                       enum TWBitcoinSigHashType hashType, Bitcoin::SigHashCache* cache) const {
     assert(index < inputs.size());
 
     if (Bitcoin::hashTypeIsSingle(hashType) && index >= outputs.size()) {
@@ -33,22 +32,21 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
                                     "larger than the number of outputs");
     }
 
-    auto inputsToSign = inputs;
+    auto inputsToSign = std::span<const TransactionInput>(inputs);
     auto signIndex = index;
-    if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0) {
-        inputsToSign.clear();
-        inputsToSign.push_back(inputs[index]);
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    if (anyoneCanPay) {
+        inputsToSign = inputsToSign.subspan(index, 1);
         signIndex = 0;
     }
 
-    auto outputsToSign = outputs;
+    auto outputCount = outputs.size();
     switch (hashType & Bitcoin::SigHashMask) {
     case TWBitcoinSigHashTypeNone:
-        outputsToSign = {};
+        outputCount = 0;
         break;
     case TWBitcoinSigHashTypeSingle:
-        outputsToSign.clear();
-        std::copy(outputs.begin(), outputs.begin() + index + 1, std::back_inserter(outputsToSign));
+        outputCount = index + 1;
         break;
     default:
         // Keep all outputs
@@ -59,85 +57,102 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
     preimage.reserve(Hash::sha256Size * 2 + 4);
     encode32LE(hashType, preimage);
 
-    const auto prefixHash =
-        computePrefixHash(inputsToSign, outputsToSign, signIndex, index, hashType);
+    // The prefix commits to the input being signed only with these flags
+    const auto computePrefix = [&] { return computePrefixHash(inputsToSign, outputCount, signIndex, index, hashType); };
+    const auto prefixHash = anyoneCanPay || Bitcoin::hashTypeIsNone(hashType) || Bitcoin::hashTypeIsSingle(hashType)
+                                ? computePrefix()
+                                : Bitcoin::SigHashCache::get(cache, &Bitcoin::SigHashCache::prefixHash, computePrefix);
     std::copy(prefixHash.begin(), prefixHash.end(), std::back_inserter(preimage));
 
-    const auto witnessHash = computeWitnessHash(inputsToSign, prevOutScript, signIndex);
+    const auto witnessHash = computeWitnessHash(inputsToSign.size(), prevOutScript, signIndex);
     std::copy(witnessHash.begin(), witnessHash.end(), std::back_inserter(preimage));
 
     return Hash::blake256(preimage);
 }
 
-Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                                    const std::vector<TransactionOutput>& outputsToSign,
+Data Transaction::computePrefixHash(std::span<const TransactionInput> inputsToSign, std::size_t outputCount,
                                     std::size_t signIndex, std::size_t index,
                                     enum TWBitcoinSigHashType hashType) const {
-    auto preimage = Data{};
+    auto hasher = Hash::StreamHasher(Hash::HasherBlake256);
+    auto buffer = Data{};
 
     // Commit to the version and hash serialization type.
     encode32LE(static_cast<uint32_t>(version) |
                    (static_cast<uint32_t>(sigHashSerializePrefix) << 16),
-               preimage);
+               buffer);
 
     // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), preimage);
+    encodeVarInt(inputsToSign.size(), buffer);
+    hasher.update(buffer);
     for (auto i = 0ul; i < inputsToSign.size(); i += 1) {
         auto& input = inputsToSign[i];
-        input.previousOutput.encode(preimage);
+        buffer.clear();
+        input.previousOutput.encode(buffer);
 
         auto sequence = input.sequence;
         if ((Bitcoin::hashTypeIsNone(hashType) || Bitcoin::hashTypeIsSingle(hashType)) &&
             i != signIndex) {
             sequence = 0;
         }
-        encode32LE(sequence, preimage);
+        encode32LE(sequence, buffer);
+        hasher.update(buffer);
     }
 
     // Commit to the relevant transaction outputs.
-    encodeVarInt(outputsToSign.size(), preimage);
-    for (auto i = 0ul; i < outputsToSign.size(); i += 1) {
-        auto& output = outputsToSign[i];
-        auto value = output.value;
-        auto pkScript = output.script;
+    buffer.clear();
+    encodeVarInt(outputCount, buffer);
+    hasher.update(buffer);
+    for (auto i = 0ul; i < outputCount; i += 1) {
+        auto& output = outputs[i];
+        buffer.clear();
         if (Bitcoin::hashTypeIsSingle(hashType) && i != index) {
-            value = -1;
-            pkScript = {};
+            encode64LE(static_cast<uint64_t>(-1), buffer);
+            encode16LE(output.version, buffer);
+            encodeVarInt(0, buffer);
+        } else {
+            encode64LE(output.value, buffer);
+            encode16LE(output.version, buffer);
+            output.script.encode(buffer);
         }
-        encode64LE(value, preimage);
-        encode16LE(output.version, preimage);
-        pkScript.encode(preimage);
+        hasher.update(buffer);
     }
 
-    encode32LE(lockTime, preimage);
-    encode32LE(expiry, preimage);
+    buffer.clear();
+    encode32LE(lockTime, buffer);
+    encode32LE(expiry, buffer);
+    hasher.update(buffer);
 
-    return Hash::blake256(preimage);
+    return hasher.finalize();
 }
 
-Data Transaction::computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                                     const Bitcoin::Script& signScript,
+Data Transaction::computeWitnessHash(std::size_t inputCount, const Bitcoin::Script& signScript,
                                      std::size_t signIndex) const {
-    const auto size = sigHashWitnessSize(inputsToSign, signScript);
-    auto witnessBuf = Data();
-    witnessBuf.reserve(size);
+    // The other inputs commit to an empty script, a single zero byte each
+    static const std::array<byte, 256> emptyScripts{};
+    const auto updateEmptyScripts = [](Hash::StreamHasher& hasher, std::size_t count) {
+        for (; count > 0; count -= std::min(count, emptyScripts.size())) {
+            hasher.update(emptyScripts.data(), std::min(count, emptyScripts.size()));
+        }
+    };
+
+    auto hasher = Hash::StreamHasher(Hash::HasherBlake256);
+    auto buffer = Data{};
 
     // Commit to the version and hash serialization type.
     encode32LE(static_cast<uint32_t>(version) |
                    (static_cast<uint32_t>(sigHashSerializeWitness) << 16),
-               witnessBuf);
+               buffer);
 
     // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), witnessBuf);
-    for (auto i = 0ul; i < inputsToSign.size(); i += 1) {
-        if (i == signIndex) {
-            signScript.encode(witnessBuf);
-        } else {
-            Bitcoin::Script().encode(witnessBuf);
-        }
-    }
-
-    return Hash::blake256(witnessBuf);
+    encodeVarInt(inputCount, buffer);
+    hasher.update(buffer);
+    updateEmptyScripts(hasher, signIndex);
+    buffer.clear();
+    signScript.encode(buffer);
+    hasher.update(buffer);
+    updateEmptyScripts(hasher, inputCount - signIndex - 1);
+
+    return hasher.finalize();
 }
 
 Data Transaction::hash() const {
@@ -211,29 +226,4 @@ Proto::Transaction Transaction::proto() const {
     return protoTx;
 }
 
-namespace {
-/// Returns the number of bytes the passed parameters would take when encoded
-/// with the format used by the witness hash portion of the overall signature
-/// hash.
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript) {
-    // 1) 4 bytes version/serialization type
-    // 2) number of inputs varint
-    // 3) per input:
-    //    a) prevout pkscript varint (1 byte if not input being signed)
-    //    b) N bytes prevout pkscript (0 bytes if not input being signed)
-    //
-    // NOTE: The prevout pkscript is replaced by nil for all inputs except
-    // the input being signed.  Thus, all other inputs (aka numTxIns-1) commit
-    // to a nil script which gets encoded as a single 0x00 byte.  This is
-    // because encoding 0 as a varint results in 0x00 and there is no script
-    // to write.  So, rather than looping through all inputs and manually
-    // calculating the size per input, use (numTxIns - 1) as an
-    // optimization.
-    const auto numTxIns = inputs.size();
-    return 4 + varIntSize(numTxIns) + (numTxIns - 1) + varIntSize(signScript.bytes.size()) +
-           signScript.bytes.size();
-}
-} // namespace
-
 } // namespace TW::Decred
@@ -15,6 +15,7 @@
 #include "../proto/Decred.pb.h"
 
 #include "Bitcoin/SignatureVersion.h"
+#include <span>
 #include <vector>
 
 namespace TW::Decred {
@@ -50,8 +51,9 @@ struct Transaction {
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
+    /// If `cache` is provided, the prefix hash is reused across calls for the hash types that don't depend on the input.
     Data computeSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType) const;
+                              enum TWBitcoinSigHashType hashType, Bitcoin::SigHashCache* cache = nullptr) const;
 
     /// Generates the transaction hash.
     Data hash() const;
@@ -63,11 +65,9 @@ struct Transaction {
     Proto::Transaction proto() const;
 
   private:
-    Data computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                           const std::vector<TransactionOutput>& outputsToSign,
+    Data computePrefixHash(std::span<const TransactionInput> inputsToSign, std::size_t outputCount,
                            std::size_t signIndex, std::size_t index, enum TWBitcoinSigHashType hashType) const;
-    Data computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                            const Bitcoin::Script& signScript, std::size_t signIndex) const;
+    Data computeWitnessHash(std::size_t inputCount, const Bitcoin::Script& signScript, std::size_t signIndex) const;
 
     void encodePrefix(Data& data) const;
     void encodeWitness(Data& data) const;
@@ -6,7 +6,8 @@
 
 #include "DerivationPath.h"
 
-#include <cstdio>
+#include <cctype>
+#include <limits>
 #include <stdexcept>
 
 using namespace TW;
@@ -23,11 +24,15 @@ DerivationPath::DerivationPath(const std::string& string) {
     }
 
     while (it != end) {
-        uint32_t value;
-        if (std::sscanf(it, "%ud", &value) != 1) {
+        if (!isdigit(*it)) {
             throw std::invalid_argument("Invalid component");
         }
+        uint64_t value = 0;
         while (it != end && isdigit(*it)) {
+            value = value * 10 + static_cast<uint64_t>(*it - '0');
+            if (value > std::numeric_limits<uint32_t>::max()) {
+                throw std::invalid_argument("Invalid component");
+            }
             ++it;
         }
 
@@ -35,7 +40,7 @@ DerivationPath::DerivationPath(const std::string& string) {
         if (hardened) {
             ++it;
         }
-        indices.emplace_back(value, hardened);
+        indices.emplace_back(static_cast<uint32_t>(value), hardened);
 
         if (it == end) {
             break;
@@ -9,9 +9,12 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <array>
 #include <cstdint>
 #include <initializer_list>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TW {
@@ -20,12 +23,12 @@ struct DerivationPathIndex {
     uint32_t value = 0;
     bool hardened = true;
 
-    DerivationPathIndex() = default;
-    DerivationPathIndex(uint32_t value, bool hardened = true)
+    constexpr DerivationPathIndex() = default;
+    constexpr DerivationPathIndex(uint32_t value, bool hardened = true)
         : value(value), hardened(hardened) {}
 
     /// The derivation index.
-    uint32_t derivationIndex() const {
+    constexpr uint32_t derivationIndex() const {
         if (hardened) {
             return value | 0x80000000;
         } else {
@@ -42,9 +45,89 @@ struct DerivationPathIndex {
     }
 };
 
+/// The indices of a derivation path, stored inline, without heap allocation.
+/// Holds at most `maxDepth` indices, which all registered derivations fit in.
+class DerivationPathIndices {
+public:
+    static constexpr std::size_t maxDepth = 8;
+
+    using value_type = DerivationPathIndex;
+    using iterator = DerivationPathIndex*;
+    using const_iterator = const DerivationPathIndex*;
+
+    constexpr DerivationPathIndices() = default;
+
+    /// \throws std::invalid_argument if there are more than `maxDepth` indices.
+    constexpr DerivationPathIndices(std::initializer_list<DerivationPathIndex> list)
+        : DerivationPathIndices(list.begin(), list.end()) {}
+
+    /// \throws std::invalid_argument if there are more than `maxDepth` indices.
+    template <typename Iter>
+    constexpr DerivationPathIndices(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    /// `count` default (hardened 0) indices.
+    ///
+    /// \throws std::invalid_argument if `count` exceeds `maxDepth`.
+    constexpr explicit DerivationPathIndices(std::size_t count) { resize(count); }
+
+    constexpr std::size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    static constexpr std::size_t capacity() { return maxDepth; }
+
+    constexpr DerivationPathIndex& operator[](std::size_t i) { return items[i]; }
+    constexpr const DerivationPathIndex& operator[](std::size_t i) const { return items[i]; }
+    constexpr DerivationPathIndex& front() { return items[0]; }
+    constexpr const DerivationPathIndex& front() const { return items[0]; }
+    constexpr DerivationPathIndex& back() { return items[count - 1]; }
+    constexpr const DerivationPathIndex& back() const { return items[count - 1]; }
+
+    constexpr iterator begin() { return items.data(); }
+    constexpr iterator end() { return items.data() + count; }
+    constexpr const_iterator begin() const { return items.data(); }
+    constexpr const_iterator end() const { return items.data() + count; }
+
+    /// \throws std::invalid_argument if the path is already `maxDepth` deep.
+    constexpr void push_back(const DerivationPathIndex& index) {
+        if (count == maxDepth) {
+            throw std::invalid_argument("Derivation path too deep");
+        }
+        items[count++] = index;
+    }
+
+    /// \throws std::invalid_argument if the path is already `maxDepth` deep.
+    template <typename... Args>
+    constexpr DerivationPathIndex& emplace_back(Args&&... args) {
+        push_back(DerivationPathIndex(std::forward<Args>(args)...));
+        return back();
+    }
+
+    constexpr void pop_back() { items[--count] = DerivationPathIndex(); }
+
+    /// \throws std::invalid_argument if `size` exceeds `maxDepth`.
+    constexpr void resize(std::size_t size) {
+        if (size > maxDepth) {
+            throw std::invalid_argument("Derivation path too deep");
+        }
+        for (auto i = size; i < count; ++i) {
+            items[i] = DerivationPathIndex();
+        }
+        count = static_cast<uint8_t>(size);
+    }
+
+    constexpr void clear() { resize(0); }
+
+private:
+    std::array<DerivationPathIndex, maxDepth> items{};
+    uint8_t count = 0;
+};
+
 /// A BIP32 HD wallet derivation path.
 struct DerivationPath {
-    std::vector<DerivationPathIndex> indices;
+    DerivationPathIndices indices;
 
     TWPurpose purpose() const {
         if (indices.size() == 0) {
@@ -116,16 +199,18 @@ struct DerivationPath {
         indices[4] = DerivationPathIndex(v, /* hardened: */ false);
     }
 
-    DerivationPath() = default;
-    explicit DerivationPath(std::initializer_list<DerivationPathIndex> l)
+    constexpr DerivationPath() = default;
+    constexpr explicit DerivationPath(std::initializer_list<DerivationPathIndex> l)
         : indices(l) {}
-    explicit DerivationPath(std::vector<DerivationPathIndex> indices)
-        : indices(std::move(indices)) {}
+    explicit DerivationPath(const std::vector<DerivationPathIndex>& indices)
+        : indices(indices.begin(), indices.end()) {}
+    constexpr explicit DerivationPath(DerivationPathIndices indices)
+        : indices(indices) {}
 
     /// Creates a `DerivationPath` by BIP44 components.
     DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
                    uint32_t address)
-        : indices(std::vector<DerivationPathIndex>(5)) {
+        : indices(5) {
         setPurpose(purpose);
         setCoin(coin);
         setAccount(account);
@@ -29,6 +29,11 @@ void Action::serialize(Data& o) const {
     append(o, data);
 }
 
+std::size_t Action::serializedSize() const noexcept {
+    return 2 * sizeof(uint64_t) + varIntSize(authorization.size()) + authorization.size() * PermissionLevel::serializedSize() +
+           varIntSize(data.size()) + data.size();
+}
+
 json Action::serialize() const noexcept {
     json obj;
     obj["account"] = account.string();
@@ -55,6 +60,7 @@ void TransferAction::setData(const std::string& from, const std::string& to, con
         throw std::invalid_argument("Amount in a transfer action must be greater than zero.");
     }
 
+    data.reserve(2 * sizeof(uint64_t) + 2 * sizeof(uint64_t) + varIntSize(memo.size()) + memo.size());
     Name(from).serialize(data);
     Name(to).serialize(data);
     asset.serialize(data);
@@ -23,6 +23,7 @@ class PermissionLevel {
 
     void serialize(Data& o) const;
     nlohmann::json serialize() const noexcept;
+    static constexpr std::size_t serializedSize() noexcept { return 2 * sizeof(uint64_t); }
 };
 
 class Action {
@@ -35,6 +36,8 @@ class Action {
 
     virtual void serialize(Data& o) const;
     virtual nlohmann::json serialize() const noexcept;
+    /// Size of the binary serialization.
+    std::size_t serializedSize() const noexcept;
 };
 
 class TransferAction: public Action {
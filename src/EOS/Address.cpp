@@ -127,7 +127,7 @@ Address::Address(const PublicKey& publicKey, Type type)
     assert(PublicKeyDataSize == TW::PublicKey::secp256k1Size);
 
     // copy the raw, compressed key data
-    keyData = publicKey.compressed().bytes;
+    keyData = Data(publicKey.compressed().bytes);
 
     // append the checksum
     uint32_t checksum = createChecksum(keyData, type);
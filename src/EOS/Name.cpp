@@ -7,53 +7,63 @@
 #include "../BinaryCoding.h"
 #include "Name.h"
 
-#include <boost/algorithm/string/trim.hpp>
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 
 namespace TW::EOS {
 
+namespace {
+
+constexpr const char* charMap = ".12345abcdefghijklmnopqrstuvwxyz";
+
+/// 5-bit symbol of each character, 0 ('.') for characters outside the name alphabet.
+constexpr std::array<uint8_t, 256> symbolTable = [] {
+    std::array<uint8_t, 256> table{};
+    for (uint8_t symbol = 1; symbol < 32; ++symbol) {
+        table[static_cast<uint8_t>(charMap[symbol])] = symbol;
+    }
+    return table;
+}();
+
+} // namespace
+
 Name::Name(const std::string& str) {
     if (str.size() > 13) {
         throw std::invalid_argument(str + ": size too long!");
     }
 
-    std::size_t i = 0;
-    while (i < std::min(size_t(12), str.size())) {
-        value |= (toSymbol(str[i]) & 0x1f) << (64 - (5 * (i + 1)));
-        i++;
+    const auto count = std::min(size_t(12), str.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        value |= toSymbol(str[i]) << (64 - (5 * (i + 1)));
     }
 
-    if (i == 12)
-        value |= (toSymbol(str[i]) & 0x0f);
+    if (str.size() == 13)
+        value |= (toSymbol(str[12]) & 0x0f);
 }
 
 uint64_t Name::toSymbol(char c) noexcept {
-    if (c >= 'a' && c <= 'z')
-        return c - 'a' + 6;
-
-    if (c >= '1' && c <= '5')
-        return c - '1' + 1;
-
-    return 0;
+    return symbolTable[static_cast<uint8_t>(c)];
 }
 
 std::string Name::string() const noexcept {
-    static const char* charMap = ".12345abcdefghijklmnopqrstuvwxyz";
-
-    std::string str(13, '.');
+    char str[13];
 
     uint64_t tmp = value;
     str[12] = charMap[tmp & 0x0f];
     tmp >>= 4;
 
     for (uint32_t i = 1; i <= 12; ++i) {
-        char c = charMap[tmp & 0x1f];
-        str[12 - i] = c;
+        str[12 - i] = charMap[tmp & 0x1f];
         tmp >>= 5;
     }
 
-    boost::algorithm::trim_right_if(str, [](char c) { return c == '.'; });
-    return str;
+    // trailing dots are not part of the name
+    std::size_t size = 13;
+    while (size > 0 && str[size - 1] == '.') {
+        --size;
+    }
+    return {str, size};
 }
 
 void Name::serialize(Data& o) const noexcept {
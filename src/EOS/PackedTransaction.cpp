@@ -16,6 +16,7 @@ PackedTransaction::PackedTransaction(const Transaction& transaction, Compression
     const Data& cfd = transaction.contextFreeData;
 
     if (!cfd.empty()) {
+        packedCFD.reserve(1 + varIntSize(cfd.size()) + cfd.size());
         packedCFD.push_back(1);
         encodeVarInt64(cfd.size(), packedCFD);
         append(packedCFD, cfd);
@@ -24,7 +25,17 @@ PackedTransaction::PackedTransaction(const Transaction& transaction, Compression
     signatures = transaction.signatures;
 }
 
+std::size_t PackedTransaction::serializedSize() const noexcept {
+    std::size_t size = varIntSize(signatures.size()) + 1 + varIntSize(packedCFD.size()) + packedCFD.size() +
+                       varIntSize(packedTrx.size()) + packedTrx.size();
+    for (const auto& signature : signatures) {
+        size += signature.serializedSize();
+    }
+    return size;
+}
+
 void PackedTransaction::serialize(Data& os) const noexcept {
+    os.reserve(os.size() + serializedSize());
     encodeCollection(signatures, os);
     os.push_back(static_cast<uint8_t>(compression));
     encodeVarInt64(packedCFD.size(), os);
@@ -29,6 +29,8 @@ public:
 
     void serialize(Data& os) const noexcept;
     nlohmann::json serialize() const noexcept;
+    /// Size of the binary serialization, to reserve buffers before serializing.
+    std::size_t serializedSize() const noexcept;
 };
 
 } // namespace TW::EOS
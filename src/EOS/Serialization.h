@@ -15,22 +15,24 @@ inline void encodeVarInt64(uint64_t x, Data& os) {
     static const int maxBytes = 10;
     uint8_t bytes[maxBytes];
 
-    int lastNonZeroByte = 0;
-    for (int i = 0; i < maxBytes; ++i) {
-        bytes[i] = (x & 0x7F);
-        if (bytes[i]) {
-            lastNonZeroByte = i;
-        }
-
-        // set the first bit
-        bytes[i] |= 0x80;
+    int size = 0;
+    while (x >= 0x80) {
+        bytes[size++] = static_cast<uint8_t>(x | 0x80);
         x >>= 7;
     }
+    bytes[size++] = static_cast<uint8_t>(x);
 
-    // unset the first bit of the last byte
-    bytes[lastNonZeroByte] &= 0x7F;
+    os.insert(os.end(), bytes, bytes + size);
+}
 
-    os.insert(os.end(), bytes, bytes + lastNonZeroByte + 1);
+/// Number of bytes of `x` encoded as a varint.
+inline std::size_t varIntSize(uint64_t x) noexcept {
+    std::size_t size = 1;
+    while (x >= 0x80) {
+        ++size;
+        x >>= 7;
+    }
+    return size;
 }
 
 inline void encodeVarInt32(uint32_t x, Data& os) {
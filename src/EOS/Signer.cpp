@@ -84,7 +84,9 @@ void Signer::sign(const PrivateKey& privateKey, Type type, Transaction& transact
 }
 
 TW::Data Signer::hash(const Transaction& transaction) const noexcept {
-    Data hashInput(chainID);
+    Data hashInput;
+    hashInput.reserve(chainID.size() + transaction.serializedSize() + Hash::sha256Size);
+    append(hashInput, chainID);
     transaction.serialize(hashInput);
 
     Data cfdHash(Hash::sha256Size); // default value for empty cfd
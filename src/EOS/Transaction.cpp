@@ -84,7 +84,26 @@ void Transaction::setReferenceBlock(const Data& refBlockId) {
     refBlockPrefix = decode32LE(refBlockId.data() + 8);
 }
 
+namespace {
+
+template <typename Collection>
+std::size_t collectionSize(const Collection& collection) noexcept {
+    std::size_t size = varIntSize(std::size(collection));
+    for (const auto& item : collection) {
+        size += item.serializedSize();
+    }
+    return size;
+}
+
+} // namespace
+
+std::size_t Transaction::serializedSize() const noexcept {
+    return 4 + 2 + 4 + varIntSize(maxNetUsageWords) + 1 + varIntSize(delaySeconds) +
+           collectionSize(contextFreeActions) + collectionSize(actions) + collectionSize(transactionExtensions);
+}
+
 void Transaction::serialize(Data& os) const noexcept {
+    os.reserve(os.size() + serializedSize());
 
     encode32LE(expiration, os);
     encode16LE(refBlockNumber, os);
@@ -28,6 +28,7 @@ public:
     Signature(const Data& sig, Type type);
     virtual ~Signature() { }
     void serialize(Data& os) const noexcept;
+    std::size_t serializedSize() const noexcept { return 1 + data.size(); }
     std::string string() const noexcept;
 };
 
@@ -40,6 +41,7 @@ public:
     virtual ~Extension() { }
     void serialize(Data& os) const noexcept;
     nlohmann::json serialize() const noexcept;
+    std::size_t serializedSize() const noexcept { return 2 + varIntSize(buffer.size()) + buffer.size(); }
 };
 
 class Transaction {
@@ -48,6 +50,8 @@ public:
 
     void serialize(Data& os) const noexcept;
     nlohmann::json serialize() const;
+    /// Size of the binary serialization, to reserve buffers before serializing.
+    std::size_t serializedSize() const noexcept;
 
     inline bool isValid() { return maxNetUsageWords < UINT32_MAX / 8UL; }
 
@@ -7,12 +7,479 @@
 #include "Encrypt.h"
 #include "Data.h"
 #include <TrezorCrypto/aes.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstring>
+#include <optional>
 #include <stdexcept>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define TW_AES_NI 1
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define TW_AES_ARMV8 1
+#endif
+
 namespace TW::Encrypt {
 
+namespace {
+
+constexpr size_t blockSize = AES_BLOCK_SIZE;
+constexpr int maxRounds = 14;
+
+using Block = std::array<byte, blockSize>;
+
+constexpr uint8_t rotateLeft(uint8_t value, int shift) {
+    return static_cast<uint8_t>((value << shift) | (value >> (8 - shift)));
+}
+
+/// The AES S-box, only used to expand keys for the hardware paths.
+constexpr std::array<uint8_t, 256> sbox = [] {
+    std::array<uint8_t, 256> box{};
+    // p runs through all non-zero field elements as powers of 3, q through their inverses.
+    uint8_t p = 1;
+    uint8_t q = 1;
+    do {
+        p = static_cast<uint8_t>(p ^ (p << 1) ^ ((p & 0x80) ? 0x1b : 0));
+        q = static_cast<uint8_t>(q ^ (q << 1));
+        q = static_cast<uint8_t>(q ^ (q << 2));
+        q = static_cast<uint8_t>(q ^ (q << 4));
+        if (q & 0x80) {
+            q ^= 0x09;
+        }
+        box[p] = static_cast<uint8_t>(q ^ rotateLeft(q, 1) ^ rotateLeft(q, 2) ^ rotateLeft(q, 3) ^ rotateLeft(q, 4) ^ 0x63);
+    } while (p != 1);
+    box[0] = 0x63;
+    return box;
+}();
+
+/// Returns the AES key size for the key lengths accepted by trezor-crypto (bytes or bits), or 0.
+size_t keySize(size_t length) {
+    switch (length) {
+    case 16:
+    case 128:
+        return 16;
+    case 24:
+    case 192:
+        return 24;
+    case 32:
+    case 256:
+        return 32;
+    default:
+        return 0;
+    }
+}
+
+/// Expands a key into `rounds + 1` round keys as specified in FIPS-197, section 5.2.
+void expandKey(const byte* key, size_t size, byte* roundKeys, int rounds) {
+    const size_t words = size / 4;
+    const size_t total = 4 * (rounds + 1);
+    std::memcpy(roundKeys, key, size);
+    uint8_t rcon = 1;
+    for (size_t i = words; i < total; ++i) {
+        std::array<uint8_t, 4> temp;
+        std::memcpy(temp.data(), roundKeys + 4 * (i - 1), 4);
+        if (i % words == 0) {
+            temp = {static_cast<uint8_t>(sbox[temp[1]] ^ rcon), sbox[temp[2]], sbox[temp[3]], sbox[temp[0]]};
+            rcon = static_cast<uint8_t>((rcon << 1) ^ ((rcon & 0x80) ? 0x1b : 0));
+        } else if (words > 6 && i % words == 4) {
+            temp = {sbox[temp[0]], sbox[temp[1]], sbox[temp[2]], sbox[temp[3]]};
+        }
+        for (size_t j = 0; j < 4; ++j) {
+            roundKeys[4 * i + j] = roundKeys[4 * (i - words) + j] ^ temp[j];
+        }
+    }
+}
+
+#if defined(TW_AES_NI)
+
+#define TW_AES_TARGET __attribute__((target("aes")))
+
+bool detectHardware() noexcept {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_AES) != 0;
+}
+
+inline __m128i load(const byte* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+inline void store(byte* data, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+/// Derives the round keys of the equivalent inverse cipher, for AESDEC.
+TW_AES_TARGET void invertKeys(const byte* keys, byte* inverse, int rounds) {
+    store(inverse, load(keys + blockSize * rounds));
+    for (int i = 1; i < rounds; ++i) {
+        store(inverse + blockSize * i, _mm_aesimc_si128(load(keys + blockSize * (rounds - i))));
+    }
+    store(inverse + blockSize * rounds, load(keys));
+}
+
+TW_AES_TARGET inline __m128i encryptBlock(const __m128i* keys, int rounds, __m128i block) {
+    block = _mm_xor_si128(block, keys[0]);
+    for (int r = 1; r < rounds; ++r) {
+        block = _mm_aesenc_si128(block, keys[r]);
+    }
+    return _mm_aesenclast_si128(block, keys[rounds]);
+}
+
+TW_AES_TARGET void encryptBlocks(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks) {
+    __m128i keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = load(roundKeys + blockSize * r);
+    }
+    size_t i = 0;
+    // Four independent blocks keep the AES unit's pipeline busy.
+    for (; i + 4 <= blocks; i += 4) {
+        auto b0 = _mm_xor_si128(load(in + blockSize * i), keys[0]);
+        auto b1 = _mm_xor_si128(load(in + blockSize * (i + 1)), keys[0]);
+        auto b2 = _mm_xor_si128(load(in + blockSize * (i + 2)), keys[0]);
+        auto b3 = _mm_xor_si128(load(in + blockSize * (i + 3)), keys[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b0 = _mm_aesenc_si128(b0, keys[r]);
+            b1 = _mm_aesenc_si128(b1, keys[r]);
+            b2 = _mm_aesenc_si128(b2, keys[r]);
+            b3 = _mm_aesenc_si128(b3, keys[r]);
+        }
+        store(out + blockSize * i, _mm_aesenclast_si128(b0, keys[rounds]));
+        store(out + blockSize * (i + 1), _mm_aesenclast_si128(b1, keys[rounds]));
+        store(out + blockSize * (i + 2), _mm_aesenclast_si128(b2, keys[rounds]));
+        store(out + blockSize * (i + 3), _mm_aesenclast_si128(b3, keys[rounds]));
+    }
+    for (; i < blocks; ++i) {
+        store(out + blockSize * i, encryptBlock(keys, rounds, load(in + blockSize * i)));
+    }
+}
+
+TW_AES_TARGET void decryptBlocks(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks) {
+    __m128i keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = load(roundKeys + blockSize * r);
+    }
+    size_t i = 0;
+    for (; i + 4 <= blocks; i += 4) {
+        auto b0 = _mm_xor_si128(load(in + blockSize * i), keys[0]);
+        auto b1 = _mm_xor_si128(load(in + blockSize * (i + 1)), keys[0]);
+        auto b2 = _mm_xor_si128(load(in + blockSize * (i + 2)), keys[0]);
+        auto b3 = _mm_xor_si128(load(in + blockSize * (i + 3)), keys[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b0 = _mm_aesdec_si128(b0, keys[r]);
+            b1 = _mm_aesdec_si128(b1, keys[r]);
+            b2 = _mm_aesdec_si128(b2, keys[r]);
+            b3 = _mm_aesdec_si128(b3, keys[r]);
+        }
+        store(out + blockSize * i, _mm_aesdeclast_si128(b0, keys[rounds]));
+        store(out + blockSize * (i + 1), _mm_aesdeclast_si128(b1, keys[rounds]));
+        store(out + blockSize * (i + 2), _mm_aesdeclast_si128(b2, keys[rounds]));
+        store(out + blockSize * (i + 3), _mm_aesdeclast_si128(b3, keys[rounds]));
+    }
+    for (; i < blocks; ++i) {
+        auto block = _mm_xor_si128(load(in + blockSize * i), keys[0]);
+        for (int r = 1; r < rounds; ++r) {
+            block = _mm_aesdec_si128(block, keys[r]);
+        }
+        store(out + blockSize * i, _mm_aesdeclast_si128(block, keys[rounds]));
+    }
+}
+
+TW_AES_TARGET void encryptChained(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks, byte* iv) {
+    __m128i keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = load(roundKeys + blockSize * r);
+    }
+    auto state = load(iv);
+    for (size_t i = 0; i < blocks; ++i) {
+        state = encryptBlock(keys, rounds, _mm_xor_si128(load(in + blockSize * i), state));
+        store(out + blockSize * i, state);
+    }
+    store(iv, state);
+}
+
+#elif defined(TW_AES_ARMV8)
+
+bool detectHardware() noexcept {
+    return true;
+}
+
+/// Derives the round keys of the equivalent inverse cipher, for AESD.
+void invertKeys(const byte* keys, byte* inverse, int rounds) {
+    vst1q_u8(inverse, vld1q_u8(keys + blockSize * rounds));
+    for (int i = 1; i < rounds; ++i) {
+        vst1q_u8(inverse + blockSize * i, vaesimcq_u8(vld1q_u8(keys + blockSize * (rounds - i))));
+    }
+    vst1q_u8(inverse + blockSize * rounds, vld1q_u8(keys));
+}
+
+inline uint8x16_t encryptBlock(const uint8x16_t* keys, int rounds, uint8x16_t block) {
+    for (int r = 0; r < rounds - 1; ++r) {
+        block = vaesmcq_u8(vaeseq_u8(block, keys[r]));
+    }
+    return veorq_u8(vaeseq_u8(block, keys[rounds - 1]), keys[rounds]);
+}
+
+inline uint8x16_t decryptBlock(const uint8x16_t* keys, int rounds, uint8x16_t block) {
+    for (int r = 0; r < rounds - 1; ++r) {
+        block = vaesimcq_u8(vaesdq_u8(block, keys[r]));
+    }
+    return veorq_u8(vaesdq_u8(block, keys[rounds - 1]), keys[rounds]);
+}
+
+void encryptBlocks(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks) {
+    uint8x16_t keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = vld1q_u8(roundKeys + blockSize * r);
+    }
+    for (size_t i = 0; i < blocks; ++i) {
+        vst1q_u8(out + blockSize * i, encryptBlock(keys, rounds, vld1q_u8(in + blockSize * i)));
+    }
+}
+
+void decryptBlocks(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks) {
+    uint8x16_t keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = vld1q_u8(roundKeys + blockSize * r);
+    }
+    for (size_t i = 0; i < blocks; ++i) {
+        vst1q_u8(out + blockSize * i, decryptBlock(keys, rounds, vld1q_u8(in + blockSize * i)));
+    }
+}
+
+void encryptChained(const byte* roundKeys, int rounds, const byte* in, byte* out, size_t blocks, byte* iv) {
+    uint8x16_t keys[maxRounds + 1];
+    for (int r = 0; r <= rounds; ++r) {
+        keys[r] = vld1q_u8(roundKeys + blockSize * r);
+    }
+    auto state = vld1q_u8(iv);
+    for (size_t i = 0; i < blocks; ++i) {
+        state = encryptBlock(keys, rounds, veorq_u8(vld1q_u8(in + blockSize * i), state));
+        vst1q_u8(out + blockSize * i, state);
+    }
+    vst1q_u8(iv, state);
+}
+
+#else
+
+bool detectHardware() noexcept {
+    return false;
+}
+
+void invertKeys(const byte*, byte*, int) {}
+void encryptBlocks(const byte*, int, const byte*, byte*, size_t) {}
+void decryptBlocks(const byte*, int, const byte*, byte*, size_t) {}
+void encryptChained(const byte*, int, const byte*, byte*, size_t, byte*) {}
+
+#endif
+
+/// AES with a key schedule for either direction, on the CPU's AES instructions when available.
+class BlockCipher {
+public:
+    /// \throws std::invalid_argument if the key size is not supported.
+    BlockCipher(const Data& key, bool decryption) {
+        const auto size = keySize(key.size());
+        if (size == 0) {
+            throw std::invalid_argument("Invalid key");
+        }
+        hardware = hasHardwareAES();
+        if (!hardware) {
+            const auto result = decryption
+                ? aes_decrypt_key(key.data(), static_cast<int>(key.size()), &decryptContext)
+                : aes_encrypt_key(key.data(), static_cast<int>(key.size()), &encryptContext);
+            if (result != EXIT_SUCCESS) {
+                throw std::invalid_argument("Invalid key");
+            }
+            return;
+        }
+        rounds = static_cast<int>(size / 4 + 6);
+        expandKey(key.data(), size, roundKeys.data(), rounds);
+        if (decryption) {
+            auto expanded = roundKeys;
+            invertKeys(expanded.data(), roundKeys.data(), rounds);
+            std::memset(expanded.data(), 0, expanded.size());
+        }
+    }
+
+    ~BlockCipher() {
+        std::memset(roundKeys.data(), 0, roundKeys.size());
+    }
+
+    BlockCipher(const BlockCipher&) = delete;
+    BlockCipher& operator=(const BlockCipher&) = delete;
+
+    /// Encrypts `blocks` independent blocks; `in` and `out` may be the same.
+    void encrypt(const byte* in, byte* out, size_t blocks) const {
+        if (hardware) {
+            encryptBlocks(roundKeys.data(), rounds, in, out, blocks);
+        } else {
+            aes_ecb_encrypt(in, out, static_cast<int>(blocks * blockSize), &encryptContext);
+        }
+    }
+
+    /// Decrypts `blocks` independent blocks; requires a decryption key schedule.
+    void decrypt(const byte* in, byte* out, size_t blocks) const {
+        if (hardware) {
+            decryptBlocks(roundKeys.data(), rounds, in, out, blocks);
+        } else {
+            aes_ecb_decrypt(in, out, static_cast<int>(blocks * blockSize), &decryptContext);
+        }
+    }
+
+    /// Encrypts `blocks` blocks in CBC mode, leaving the last ciphertext block in `iv`.
+    void encryptCBC(const byte* in, byte* out, size_t blocks, byte* iv) const {
+        if (hardware) {
+            encryptChained(roundKeys.data(), rounds, in, out, blocks, iv);
+        } else {
+            aes_cbc_encrypt(in, out, static_cast<int>(blocks * blockSize), iv, &encryptContext);
+        }
+    }
+
+private:
+    bool hardware = false;
+    int rounds = 0;
+    alignas(16) std::array<byte, blockSize * (maxRounds + 1)> roundKeys{};
+    aes_encrypt_ctx encryptContext;
+    aes_decrypt_ctx decryptContext;
+};
+
+/// Increments the whole block as a big-endian counter, like `aes_ctr_cbuf_inc`.
+void increment128(byte* counter) {
+    for (int i = blockSize - 1; i >= 0; --i) {
+        if (++counter[i] != 0) {
+            return;
+        }
+    }
+}
+
+/// Increments the last 32 bits of the block as a big-endian counter, as GCM does.
+void increment32(byte* counter) {
+    for (int i = blockSize - 1; i >= static_cast<int>(blockSize) - 4; --i) {
+        if (++counter[i] != 0) {
+            return;
+        }
+    }
+}
+
+/// Applies the key stream of counter mode to `size` bytes.
+/// The counter is advanced past every full block, so a trailing partial block leaves it on that block.
+template <typename Increment>
+void counterMode(const BlockCipher& cipher, const byte* in, byte* out, size_t size, byte* counter, Increment increment) {
+    constexpr size_t batchBlocks = 8;
+    std::array<byte, batchBlocks * blockSize> stream;
+    while (size > 0) {
+        const auto blocks = std::min(batchBlocks, (size + blockSize - 1) / blockSize);
+        for (size_t i = 0; i < blocks; ++i) {
+            std::memcpy(stream.data() + blockSize * i, counter, blockSize);
+            if (blockSize * (i + 1) <= size) {
+                increment(counter);
+            }
+        }
+        cipher.encrypt(stream.data(), stream.data(), blocks);
+        const auto count = std::min(size, blocks * blockSize);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = in[i] ^ stream[i];
+        }
+        in += count;
+        out += count;
+        size -= count;
+    }
+    std::memset(stream.data(), 0, stream.size());
+}
+
+/// GHASH of GCM, multiplying by H with 4-bit tables (Shoup's method).
+class GHash {
+public:
+    explicit GHash(const Block& h) {
+        uint64_t high = load64(h.data());
+        uint64_t low = load64(h.data() + 8);
+        tableHigh[8] = high;
+        tableLow[8] = low;
+        for (int i = 4; i > 0; i >>= 1) {
+            const uint64_t reduce = (low & 1) ? 0xe100000000000000ull : 0;
+            low = (high << 63) | (low >> 1);
+            high = (high >> 1) ^ reduce;
+            tableHigh[i] = high;
+            tableLow[i] = low;
+        }
+        for (int i = 2; i <= 8; i *= 2) {
+            for (int j = 1; j < i; ++j) {
+                tableHigh[i + j] = tableHigh[i] ^ tableHigh[j];
+                tableLow[i + j] = tableLow[i] ^ tableLow[j];
+            }
+        }
+    }
+
+    /// Absorbs `size` bytes, zero-padding the last partial block.
+    void update(const byte* data, size_t size) {
+        for (size_t i = 0; i < size; i += blockSize) {
+            const auto count = std::min(blockSize, size - i);
+            for (size_t j = 0; j < count; ++j) {
+                state[j] ^= data[i + j];
+            }
+            multiply();
+        }
+    }
+
+    /// Absorbs the bit lengths of the two inputs and writes the digest.
+    void finish(uint64_t firstBits, uint64_t secondBits, byte* out) {
+        Block lengths;
+        store64(lengths.data(), firstBits);
+        store64(lengths.data() + 8, secondBits);
+        update(lengths.data(), lengths.size());
+        std::memcpy(out, state.data(), blockSize);
+    }
+
+private:
+    static uint64_t load64(const byte* data) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    static void store64(byte* data, uint64_t value) {
+        for (int i = 7; i >= 0; --i) {
+            data[i] = static_cast<byte>(value);
+            value >>= 8;
+        }
+    }
+
+    /// Multiplies the state by H, processing its nibbles from the last one.
+    void multiply() {
+        static constexpr uint64_t remainders[16] = {
+            0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+            0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+        };
+        uint64_t high = 0;
+        uint64_t low = 0;
+        for (int i = blockSize - 1; i >= 0; --i) {
+            for (const auto nibble : {state[i] & 0x0f, state[i] >> 4}) {
+                const auto remainder = low & 0x0f;
+                low = (high << 60) | (low >> 4);
+                high = (high >> 4) ^ (remainders[remainder] << 48) ^ tableHigh[nibble];
+                low ^= tableLow[nibble];
+            }
+        }
+        store64(state.data(), high);
+        store64(state.data() + 8, low);
+    }
+
+    std::array<uint64_t, 16> tableHigh{};
+    std::array<uint64_t, 16> tableLow{};
+    Block state{};
+};
+
+} // namespace
+
+bool hasHardwareAES() noexcept {
+    static const bool available = detectHardware();
+    return available;
+}
+
 size_t paddingSize(size_t origSize, size_t blockSize, TWAESPaddingMode paddingMode) {
     if (origSize % blockSize == 0) {
         // even blocks
@@ -26,48 +493,45 @@ size_t paddingSize(size_t origSize, size_t blockSize, TWAESPaddingMode paddingMo
 }
 
 Data AESCBCEncrypt(const Data& key, const Data& data, Data& iv, TWAESPaddingMode paddingMode) {
-    aes_encrypt_ctx ctx;
-    if (aes_encrypt_key(key.data(), static_cast<int>(key.size()), &ctx) == EXIT_FAILURE) {
-        throw std::invalid_argument("Invalid key");
-    }
+    const BlockCipher cipher(key, false);
 
     // Message is padded to round block size, or by a full padding block if even
-    const size_t blockSize = AES_BLOCK_SIZE;
     const auto padding = paddingSize(data.size(), blockSize, paddingMode);
     const auto resultSize = data.size() + padding;
     Data result(resultSize);
-    size_t idx;
-    for (idx = 0; idx < resultSize - blockSize; idx += blockSize) {
-        aes_cbc_encrypt(data.data() + idx, result.data() + idx, blockSize, iv.data(), &ctx);
-    }
+    const auto fullBlocks = data.size() / blockSize;
+    cipher.encryptCBC(data.data(), result.data(), fullBlocks, iv.data());
     // last block
+    const auto idx = fullBlocks * blockSize;
     if (idx < resultSize) {
         uint8_t padded[blockSize] = {0};
         if (paddingMode == TWAESPaddingModePKCS7) {
             std::memset(padded, static_cast<int>(padding), blockSize);
         }
         std::memcpy(padded, data.data() + idx, data.size() - idx);
-        aes_cbc_encrypt(padded, result.data() + idx, blockSize, iv.data(), &ctx);
+        cipher.encryptCBC(padded, result.data() + idx, 1, iv.data());
     }
 
     return result;
 }
 
 Data AESCBCDecrypt(const Data& key, const Data& data, Data& iv, TWAESPaddingMode paddingMode) {
-    const size_t blockSize = AES_BLOCK_SIZE;
     if (data.size() % blockSize != 0) {
         throw std::invalid_argument("Invalid data size");
     }
     assert((data.size() % blockSize) == 0);
 
-    aes_decrypt_ctx ctx;
-    if (aes_decrypt_key(key.data(), static_cast<int>(key.size()), &ctx) != EXIT_SUCCESS) {
-        throw std::invalid_argument("Invalid key");
-    }
+    const BlockCipher cipher(key, true);
 
+    // Blocks are decrypted independently, then chained with the preceding ciphertext.
     Data result(data.size());
-    for (std::size_t i = 0; i < data.size(); i += blockSize) {
-        aes_cbc_decrypt(data.data() + i, result.data() + i, blockSize, iv.data(), &ctx);
+    const auto blocks = data.size() / blockSize;
+    cipher.decrypt(data.data(), result.data(), blocks);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        result[i] ^= i < blockSize ? iv[i] : data[i - blockSize];
+    }
+    if (blocks > 0) {
+        std::memcpy(iv.data(), data.data() + data.size() - blockSize, blockSize);
     }
 
     if (paddingMode == TWAESPaddingModePKCS7 && result.size() > 0) {
@@ -85,24 +549,350 @@ Data AESCBCDecrypt(const Data& key, const Data& data, Data& iv, TWAESPaddingMode
 }
 
 Data AESCTREncrypt(const Data& key, const Data& data, Data& iv) {
-	aes_encrypt_ctx ctx;
-    if (aes_encrypt_key(key.data(), static_cast<int>(key.size()), &ctx) != EXIT_SUCCESS) {
-        throw std::invalid_argument("Invalid key");
-    }
-
+    const BlockCipher cipher(key, false);
     Data result(data.size());
-    aes_ctr_encrypt(data.data(), result.data(), static_cast<int>(data.size()), iv.data(), aes_ctr_cbuf_inc, &ctx);
+    counterMode(cipher, data.data(), result.data(), data.size(), iv.data(), increment128);
     return result;
 }
 
 Data AESCTRDecrypt(const Data& key, const Data& data, Data& iv) {
-    aes_encrypt_ctx ctx;
-    if (aes_encrypt_key(key.data(), static_cast<int>(key.size()), &ctx) != EXIT_SUCCESS) {
-        throw std::invalid_argument("Invalid key");
+    // Counter mode is symmetric.
+    return AESCTREncrypt(key, data, iv);
+}
+
+namespace {
+
+/// Derives the pre-counter block J0 of GCM from the IV.
+Block gcmInitialCounter(const Block& h, const Data& iv) {
+    if (iv.empty()) {
+        throw std::invalid_argument("Invalid iv");
+    }
+    Block counter{};
+    if (iv.size() == 12) {
+        std::memcpy(counter.data(), iv.data(), iv.size());
+        counter[blockSize - 1] = 1;
+    } else {
+        GHash ghash(h);
+        ghash.update(iv.data(), iv.size());
+        ghash.finish(0, uint64_t(iv.size()) * 8, counter.data());
     }
+    return counter;
+}
 
-    Data result(data.size());
-    aes_ctr_decrypt(data.data(), result.data(), static_cast<int>(data.size()), iv.data(), aes_ctr_cbuf_inc, &ctx);
+/// Computes the GCM tag of `ciphertext` into `tag`.
+void gcmTag(const BlockCipher& cipher, const Block& h, const Block& initialCounter, const Data& aad, const byte* ciphertext, size_t size, byte* tag) {
+    GHash ghash(h);
+    ghash.update(aad.data(), aad.size());
+    ghash.update(ciphertext, size);
+    Block digest;
+    ghash.finish(uint64_t(aad.size()) * 8, uint64_t(size) * 8, digest.data());
+    Block mask;
+    cipher.encrypt(initialCounter.data(), mask.data(), 1);
+    for (size_t i = 0; i < AESGCMTagSize; ++i) {
+        tag[i] = digest[i] ^ mask[i];
+    }
+}
+
+} // namespace
+
+Data AESGCMEncrypt(const Data& key, const Data& data, const Data& iv, const Data& aad) {
+    const BlockCipher cipher(key, false);
+    Block h{};
+    cipher.encrypt(h.data(), h.data(), 1);
+    const auto initialCounter = gcmInitialCounter(h, iv);
+
+    Data result(data.size() + AESGCMTagSize);
+    auto counter = initialCounter;
+    increment32(counter.data());
+    counterMode(cipher, data.data(), result.data(), data.size(), counter.data(), increment32);
+    gcmTag(cipher, h, initialCounter, aad, result.data(), data.size(), result.data() + data.size());
+    return result;
+}
+
+Data AESGCMDecrypt(const Data& key, const Data& data, const Data& iv, const Data& aad) {
+    if (data.size() < AESGCMTagSize) {
+        throw std::invalid_argument("Invalid data size");
+    }
+    const BlockCipher cipher(key, false);
+    Block h{};
+    cipher.encrypt(h.data(), h.data(), 1);
+    const auto initialCounter = gcmInitialCounter(h, iv);
+
+    const auto size = data.size() - AESGCMTagSize;
+    Block tag;
+    gcmTag(cipher, h, initialCounter, aad, data.data(), size, tag.data());
+    // Constant-time comparison, the tag must not leak through timing.
+    byte difference = 0;
+    for (size_t i = 0; i < AESGCMTagSize; ++i) {
+        difference |= tag[i] ^ data[size + i];
+    }
+    if (difference != 0) {
+        throw std::invalid_argument("Invalid tag");
+    }
+
+    Data result(size);
+    auto counter = initialCounter;
+    increment32(counter.data());
+    counterMode(cipher, data.data(), result.data(), size, counter.data(), increment32);
+    return result;
+}
+
+struct AESStream::State {
+    State(Mode mode, bool decrypt, const Data& key, TWAESPaddingMode paddingMode)
+        // CBC decryption is the only use of the inverse cipher
+        : cipher(key, decrypt && mode == Mode::CBC), mode(mode), decrypt(decrypt), paddingMode(paddingMode) {}
+
+    ~State() {
+        std::memset(chain.data(), 0, chain.size());
+        std::memset(buffer.data(), 0, buffer.size());
+        std::memset(tail.data(), 0, tail.size());
+    }
+
+    /// Encrypts or decrypts `size` bytes, buffering partial CBC blocks.
+    size_t process(const byte* in, size_t size, byte* out) {
+        switch (mode) {
+        case Mode::CBC:
+            return chained(in, size, out);
+        case Mode::CTR:
+            counter(in, size, out, increment128);
+            return size;
+        case Mode::GCM:
+            if (decrypt) {
+                absorb(in, size);
+                counter(in, size, out, increment32);
+            } else {
+                counter(in, size, out, increment32);
+                absorb(out, size);
+            }
+            textSize += size;
+            return size;
+        }
+        return 0;
+    }
+
+    /// CBC over whole blocks, the partial block kept in `buffer`.
+    size_t chained(const byte* in, size_t size, byte* out) {
+        size_t written = 0;
+        if (buffered > 0) {
+            const auto count = std::min(blockSize - buffered, size);
+            std::memcpy(buffer.data() + buffered, in, count);
+            buffered += count;
+            in += count;
+            size -= count;
+            if (buffered < blockSize) {
+                return 0;
+            }
+            chainBlocks(buffer.data(), out, 1);
+            buffered = 0;
+            written += blockSize;
+        }
+        const auto blocks = size / blockSize;
+        chainBlocks(in, out + written, blocks);
+        written += blocks * blockSize;
+        buffered = size - blocks * blockSize;
+        std::memcpy(buffer.data(), in + blocks * blockSize, buffered);
+        return written;
+    }
+
+    void chainBlocks(const byte* in, byte* out, size_t blocks) {
+        if (blocks == 0) {
+            return;
+        }
+        if (!decrypt) {
+            cipher.encryptCBC(in, out, blocks, chain.data());
+            return;
+        }
+        cipher.decrypt(in, out, blocks);
+        for (size_t i = 0; i < blocks * blockSize; ++i) {
+            out[i] ^= i < blockSize ? chain[i] : in[i - blockSize];
+        }
+        std::memcpy(chain.data(), in + (blocks - 1) * blockSize, blockSize);
+        outputSize += blocks * blockSize;
+    }
+
+    /// Counter mode, the unused key stream of the last block kept in `buffer`.
+    template <typename Increment>
+    void counter(const byte* in, size_t size, byte* out, Increment increment) {
+        while (size > 0 && buffered < blockSize) {
+            *out++ = *in++ ^ buffer[buffered++];
+            --size;
+        }
+        const auto whole = size - size % blockSize;
+        counterMode(cipher, in, out, whole, chain.data(), increment);
+        if (whole < size) {
+            cipher.encrypt(chain.data(), buffer.data(), 1);
+            increment(chain.data());
+            buffered = 0;
+            for (size_t i = whole; i < size; ++i) {
+                out[i] = in[i] ^ buffer[buffered++];
+            }
+        }
+    }
+
+    /// Absorbs GCM ciphertext into GHASH by whole blocks.
+    void absorb(const byte* data, size_t size) {
+        while (size > 0) {
+            const auto count = std::min(blockSize - hashBuffered, size);
+            std::memcpy(hashBuffer.data() + hashBuffered, data, count);
+            hashBuffered += count;
+            data += count;
+            size -= count;
+            if (hashBuffered == blockSize) {
+                ghash->update(hashBuffer.data(), blockSize);
+                hashBuffered = 0;
+            }
+        }
+    }
+
+    /// Computes the GCM tag once all the ciphertext is absorbed.
+    Block tag() {
+        ghash->update(hashBuffer.data(), hashBuffered);
+        Block digest;
+        ghash->finish(aadSize * 8, textSize * 8, digest.data());
+        Block mask;
+        cipher.encrypt(initialCounter.data(), mask.data(), 1);
+        for (size_t i = 0; i < blockSize; ++i) {
+            digest[i] ^= mask[i];
+        }
+        return digest;
+    }
+
+    BlockCipher cipher;
+    const Mode mode;
+    const bool decrypt;
+    const TWAESPaddingMode paddingMode;
+    /// CBC chaining value, or counter block.
+    Block chain{};
+    /// CBC partial block, or counter mode key stream with its first `buffered` bytes used.
+    Block buffer{};
+    size_t buffered = 0;
+    /// Input held back when decrypting: the last CBC block or the GCM tag.
+    Block tail{};
+    size_t tailSize = 0;
+    /// Decrypted CBC bytes, for removing the padding like `AESCBCDecrypt`.
+    uint64_t outputSize = 0;
+
+    std::optional<GHash> ghash;
+    Block hashBuffer{};
+    size_t hashBuffered = 0;
+    Block initialCounter{};
+    uint64_t aadSize = 0;
+    uint64_t textSize = 0;
+};
+
+AESStream::AESStream(Mode mode, bool decrypt, const Data& key, const Data& iv, TWAESPaddingMode paddingMode, const Data& aad)
+    : state(std::make_unique<State>(mode, decrypt, key, paddingMode)) {
+    if (mode == Mode::GCM) {
+        Block h{};
+        state->cipher.encrypt(h.data(), h.data(), 1);
+        state->initialCounter = gcmInitialCounter(h, iv);
+        state->chain = state->initialCounter;
+        increment32(state->chain.data());
+        state->ghash.emplace(h);
+        state->ghash->update(aad.data(), aad.size());
+        state->aadSize = aad.size();
+    } else {
+        if (iv.size() != blockSize) {
+            throw std::invalid_argument("Invalid iv");
+        }
+        std::memcpy(state->chain.data(), iv.data(), blockSize);
+    }
+    if (mode != Mode::CBC) {
+        // no key stream yet
+        state->buffered = blockSize;
+    }
+}
+
+AESStream::~AESStream() = default;
+AESStream::AESStream(AESStream&&) noexcept = default;
+AESStream& AESStream::operator=(AESStream&&) noexcept = default;
+
+size_t AESStream::update(const byte* in, size_t size, byte* out) {
+    auto& s = *state;
+    const size_t keep = s.decrypt && s.mode != Mode::CTR ? blockSize : 0;
+    if (s.tailSize + size <= keep) {
+        std::memcpy(s.tail.data() + s.tailSize, in, size);
+        s.tailSize += size;
+        return 0;
+    }
+    // everything but the last `keep` bytes of the held back and the new input
+    const auto release = s.tailSize + size - keep;
+    const auto fromTail = std::min(release, s.tailSize);
+    auto written = s.process(s.tail.data(), fromTail, out);
+    std::memmove(s.tail.data(), s.tail.data() + fromTail, s.tailSize - fromTail);
+    s.tailSize -= fromTail;
+    const auto fromInput = release - fromTail;
+    written += s.process(in, fromInput, out + written);
+    std::memcpy(s.tail.data() + s.tailSize, in + fromInput, size - fromInput);
+    s.tailSize += size - fromInput;
+    return written;
+}
+
+size_t AESStream::finish(byte* out) {
+    auto& s = *state;
+    switch (s.mode) {
+    case Mode::CTR:
+        return 0;
+    case Mode::CBC:
+        if (!s.decrypt) {
+            const auto padding = paddingSize(s.buffered, blockSize, s.paddingMode);
+            if (s.buffered == 0 && padding == 0) {
+                return 0;
+            }
+            std::memset(s.buffer.data() + s.buffered, s.paddingMode == TWAESPaddingModePKCS7 ? static_cast<int>(padding) : 0, blockSize - s.buffered);
+            s.chainBlocks(s.buffer.data(), out, 1);
+            s.buffered = 0;
+            return blockSize;
+        }
+        if (s.buffered != 0 || (s.tailSize != 0 && s.tailSize != blockSize)) {
+            throw std::invalid_argument("Invalid data size");
+        }
+        if (s.tailSize == 0) {
+            return 0;
+        }
+        s.chainBlocks(s.tail.data(), out, 1);
+        s.tailSize = 0;
+        if (s.paddingMode == TWAESPaddingModePKCS7) {
+            const byte padding = out[blockSize - 1];
+            if (padding <= blockSize && padding <= s.outputSize) {
+                return blockSize - padding;
+            }
+        }
+        return blockSize;
+    case Mode::GCM:
+        if (!s.decrypt) {
+            const auto tag = s.tag();
+            std::memcpy(out, tag.data(), AESGCMTagSize);
+            return AESGCMTagSize;
+        }
+        if (s.tailSize != AESGCMTagSize) {
+            throw std::invalid_argument("Invalid data size");
+        }
+        {
+            const auto tag = s.tag();
+            // Constant-time comparison, the tag must not leak through timing.
+            byte difference = 0;
+            for (size_t i = 0; i < AESGCMTagSize; ++i) {
+                difference |= tag[i] ^ s.tail[i];
+            }
+            if (difference != 0) {
+                throw std::invalid_argument("Invalid tag");
+            }
+        }
+        return 0;
+    }
+    return 0;
+}
+
+Data AESStream::update(const Data& data) {
+    Data result(data.size() + overhead);
+    result.resize(update(data.data(), data.size(), result.data()));
+    return result;
+}
+
+Data AESStream::finish() {
+    Data result(overhead);
+    result.resize(finish(result.data()));
     return result;
 }
 
@@ -9,8 +9,13 @@
 #include <TrustWalletCore/TWAESPaddingMode.h>
 #include "Data.h"
 
+#include <memory>
+
 namespace TW::Encrypt {
 
+/// All AES functions below use AES-NI (detected at runtime) on x86-64 and the ARMv8 Crypto
+/// Extensions on arm64 targets built with them, falling back to a portable implementation.
+
 /// Determined needed padding size (used internally)
 size_t paddingSize(size_t origSize, size_t blockSize, TWAESPaddingMode paddingMode);
 
@@ -46,4 +51,75 @@ Data AESCTREncrypt(const Data& key, const Data& data, Data& iv);
 /// \param iv initialization vector.
 Data AESCTRDecrypt(const Data& key, const Data& data, Data& iv);
 
+/// Size of the authentication tag produced by AES-GCM.
+static constexpr size_t AESGCMTagSize = 16;
+
+/// Encrypts and authenticates a block of data using AES in Galois/Counter (GCM) mode.
+///
+/// \param key encryption key, must be 16, 24, or 32 bytes long.
+/// \param data data to encrypt.
+/// \param iv initialization vector (nonce), 12 bytes recommended; must not be reused with the same key.
+/// \param aad additional data that is authenticated but not encrypted.
+/// \returns the ciphertext followed by the 16-byte authentication tag.
+Data AESGCMEncrypt(const Data& key, const Data& data, const Data& iv, const Data& aad = {});
+
+/// Verifies and decrypts a block of data using AES in Galois/Counter (GCM) mode.
+///
+/// \param key decryption key, must be 16, 24, or 32 bytes long.
+/// \param data ciphertext followed by the 16-byte authentication tag.
+/// \param iv initialization vector (nonce) used for encryption.
+/// \param aad additional data that was authenticated with the ciphertext.
+/// \throws std::invalid_argument if the tag does not match.
+Data AESGCMDecrypt(const Data& key, const Data& data, const Data& iv, const Data& aad = {});
+
+/// Whether the AES functions use the CPU's AES instructions (AES-NI or ARMv8 Crypto Extensions).
+bool hasHardwareAES() noexcept;
+
+/// Incremental AES encryption or decryption, for inputs too large to be held in memory: the input is given in chunks
+/// of any size and the output written to caller-provided buffers, with the same result as the functions above.
+/// GCM output is the ciphertext followed by the tag, and GCM input of decryption is expected in the same form.
+class AESStream {
+public:
+    enum class Mode {
+        CBC,
+        CTR,
+        GCM,
+    };
+
+    /// Extra room the output buffers need beyond the input size: CBC buffers a partial block, and decryption holds
+    /// back the last CBC block or the GCM tag until the next call.
+    static constexpr size_t overhead = 16;
+
+    /// \param key key, must be 16, 24, or 32 bytes long.
+    /// \param iv initialization vector, 16 bytes for CBC and CTR; the nonce for GCM, 12 bytes recommended.
+    /// \param paddingMode CBC padding, as for `AESCBCEncrypt` and `AESCBCDecrypt`.
+    /// \param aad GCM additional data, authenticated but not encrypted.
+    /// \throws std::invalid_argument if the key or the iv is invalid.
+    AESStream(Mode mode, bool decrypt, const Data& key, const Data& iv, TWAESPaddingMode paddingMode = TWAESPaddingModeZero, const Data& aad = {});
+    ~AESStream();
+
+    AESStream(AESStream&&) noexcept;
+    AESStream& operator=(AESStream&&) noexcept;
+
+    /// Processes the next `size` bytes of input into `out`, which must have room for `size + overhead` bytes and
+    /// must not overlap `in`.
+    /// Decrypted GCM output must not be trusted before `finish` verified the tag.
+    /// \returns the number of bytes written.
+    size_t update(const byte* in, size_t size, byte* out);
+
+    /// Writes the end of the output into `out`, which must have room for `overhead` bytes: the last CBC block, with
+    /// its padding removed when decrypting with PKCS7 (a padding value larger than a block is left in place), or
+    /// the GCM tag when encrypting. The stream can't be used afterwards.
+    /// \returns the number of bytes written.
+    /// \throws std::invalid_argument if the CBC input is not a whole number of blocks or the GCM tag doesn't match.
+    size_t finish(byte* out);
+
+    Data update(const Data& data);
+    Data finish();
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
 } // namespace TW::Encrypt
@@ -53,7 +53,7 @@ size_t ParamArray::getSize() const {
 
 void ParamArray::encode(Data& data) const {
     size_t n = _params.getCount();
-    ValueEncoder::encodeUInt256(uint256_t(n), data);
+    ValueEncoder::encodeUInt256(FixedUint256(n), data);
     _params.encode(data);
 }
 
@@ -15,7 +15,7 @@
 namespace TW::Ethereum::ABI {
 
 void ParamByteArray::encodeBytes(const Data& bytes, Data& data) {
-    ValueEncoder::encodeUInt256(uint256_t(bytes.size()), data);
+    ValueEncoder::encodeUInt256(FixedUint256(bytes.size()), data);
 
     const auto count = bytes.size();
     const auto padding = ValueEncoder::padNeeded32(count);
@@ -5,16 +5,14 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Function.h"
+#include "FunctionCache.h"
 
 #include <string>
 
 namespace TW::Ethereum::ABI {
 
 Data Function::getSignature() const {
-    auto typ = getType();
-    auto hash = Hash::keccak256(Data(typ.begin(), typ.end()));
-    auto signature = Data(hash.begin(), hash.begin() + 4);
-    return signature;
+    return functionSelector(getType());
 }
 
 void Function::encode(Data& data) const {
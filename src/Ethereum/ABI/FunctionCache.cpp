@@ -0,0 +1,304 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "FunctionCache.h"
+
+#include "../../Hash.h"
+#include "../../HexCoding.h"
+#include "../../memory/memory_stats.h"
+
+#include <algorithm>
+#include <charconv>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace TW::Ethereum::ABI {
+
+/// Limit of cached selectors; signatures may come from user provided ABIs.
+static constexpr std::size_t maxCachedSelectors = 1024;
+
+namespace {
+
+template <typename T>
+using SelectorAllocator = MemoryStats::CountingAllocator<T, TWMemoryCacheFunctionSelector>;
+
+using SelectorKey = MemoryStats::CountedString<TWMemoryCacheFunctionSelector>;
+
+/// Selectors by function type signature.
+struct SelectorCache {
+    std::mutex mutex;
+    std::map<SelectorKey, std::array<byte, 4>, MemoryStats::SequenceLess, SelectorAllocator<std::pair<const SelectorKey, std::array<byte, 4>>>> selectors;
+
+    SelectorCache() {
+        MemoryStats::registerCache(TWMemoryCacheFunctionSelector, {functionSelectorCacheSize, trimFunctionSelectorCache});
+    }
+
+    static SelectorCache& shared() {
+        static SelectorCache cache;
+        return cache;
+    }
+};
+
+} // namespace
+
+Data functionSelector(const std::string& type) {
+    auto& cache = SelectorCache::shared();
+    {
+        const std::lock_guard lock(cache.mutex);
+        if (const auto it = cache.selectors.find(type); it != cache.selectors.end()) {
+            return Data(it->second.begin(), it->second.end());
+        }
+    }
+    const auto hash = Hash::keccak256(Data(type.begin(), type.end()));
+    std::array<byte, 4> selector;
+    std::copy_n(hash.begin(), selector.size(), selector.begin());
+
+    const std::lock_guard lock(cache.mutex);
+    if (cache.selectors.size() >= maxCachedSelectors) {
+        cache.selectors.clear();
+    }
+    cache.selectors.emplace(SelectorKey(type.begin(), type.end()), selector);
+    return Data(selector.begin(), selector.end());
+}
+
+std::size_t functionSelectorCacheSize() {
+    auto& cache = SelectorCache::shared();
+    const std::lock_guard lock(cache.mutex);
+    return cache.selectors.size();
+}
+
+void trimFunctionSelectorCache(std::size_t count) {
+    auto& cache = SelectorCache::shared();
+    const std::lock_guard lock(cache.mutex);
+    // selectors don't track use, the first ones in signature order go
+    while (cache.selectors.size() > count) {
+        cache.selectors.erase(cache.selectors.begin());
+    }
+}
+
+static std::size_t typeSize(std::string_view suffix) {
+    std::size_t size = 0;
+    const auto* end = suffix.data() + suffix.size();
+    const auto [ptr, error] = std::from_chars(suffix.data(), end, size);
+    if (error != std::errc() || ptr != end || suffix.front() == '0') {
+        return 0;
+    }
+    return size;
+}
+
+static std::pair<StaticFunction::ParamKind, std::size_t> parseParam(std::string_view param) {
+    using ParamKind = StaticFunction::ParamKind;
+    if (param == "address") {
+        return {ParamKind::Address, 160};
+    }
+    if (param == "bool") {
+        return {ParamKind::Bool, 8};
+    }
+    if (param.starts_with("uint")) {
+        const auto bits = param.size() == 4 ? 256 : typeSize(param.substr(4));
+        if (bits >= 8 && bits <= 256 && bits % 8 == 0) {
+            return {ParamKind::UInt, bits};
+        }
+    } else if (param.starts_with("bytes") && param.size() > 5) {
+        const auto bytes = typeSize(param.substr(5));
+        if (bytes >= 1 && bytes <= 32) {
+            return {ParamKind::FixedBytes, bytes};
+        }
+    }
+    throw std::invalid_argument("Unsupported static parameter type: " + std::string(param));
+}
+
+/// Size of a packed value, which is right-aligned in its word except for bytesN.
+static std::size_t packedWidth(StaticFunction::ParamKind kind, std::size_t size) {
+    return kind == StaticFunction::ParamKind::FixedBytes ? size : size / 8;
+}
+
+StaticFunction::StaticFunction(const std::string& type) : _type(type) {
+    const auto open = type.find('(');
+    if (open == 0 || open == std::string::npos || type.back() != ')') {
+        throw std::invalid_argument("Invalid function signature: " + type);
+    }
+    auto params = std::string_view(type).substr(open + 1, type.size() - open - 2);
+    while (!params.empty()) {
+        const auto comma = params.find(',');
+        _params.push_back(parseParam(params.substr(0, comma)));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        params.remove_prefix(comma + 1);
+        if (params.empty()) {
+            throw std::invalid_argument("Invalid function signature: " + type);
+        }
+    }
+    for (const auto& [kind, size] : _params) {
+        _packedSize += packedWidth(kind, size);
+    }
+    const auto selector = functionSelector(type);
+    std::copy(selector.begin(), selector.end(), _selector.begin());
+}
+
+const StaticFunction& StaticFunction::get(const std::string& type) {
+    static std::mutex mutex;
+    // elements are never erased, references stay valid
+    static std::unordered_map<std::string, StaticFunction> functions;
+    const std::lock_guard lock(mutex);
+    if (const auto it = functions.find(type); it != functions.end()) {
+        return it->second;
+    }
+    return functions.emplace(type, StaticFunction(type)).first->second;
+}
+
+/// Writes the low `bits` of `value` as a big endian 32-byte word at `word`.
+static void writeWord(byte* word, uint256_t value, std::size_t bits) {
+    if (bits < 256) {
+        value &= (uint256_t(1) << bits) - 1;
+    }
+    for (auto i = 31; i >= 0 && value != 0; --i) {
+        word[i] = static_cast<byte>(value & 0xff);
+        value >>= 8;
+    }
+}
+
+Data StaticFunction::encode(const std::vector<Value>& values) const {
+    if (values.size() != _params.size()) {
+        throw std::invalid_argument("Invalid number of parameters for " + _type);
+    }
+    Data data(encodedSize());
+    std::copy(_selector.begin(), _selector.end(), data.begin());
+    for (std::size_t i = 0; i < _params.size(); ++i) {
+        const auto [kind, size] = _params[i];
+        auto* word = data.data() + 4 + 32 * i;
+        const auto* number = std::get_if<uint256_t>(&values[i]);
+        const auto* bytes = std::get_if<Data>(&values[i]);
+        switch (kind) {
+        case ParamKind::Address:
+            // like `ParamAddress`, the rightmost bytes are taken
+            writeWord(word, number != nullptr ? *number : load(*bytes), size);
+            break;
+        case ParamKind::Bool:
+            if (number == nullptr) {
+                throw std::invalid_argument("Invalid bool parameter for " + _type);
+            }
+            word[31] = *number != 0 ? 1 : 0;
+            break;
+        case ParamKind::UInt:
+            if (number == nullptr) {
+                throw std::invalid_argument("Invalid number parameter for " + _type);
+            }
+            writeWord(word, *number, size);
+            break;
+        case ParamKind::FixedBytes:
+            if (bytes == nullptr) {
+                throw std::invalid_argument("Invalid bytes parameter for " + _type);
+            }
+            // like `ParamByteArrayFix`, cropped or padded on the right
+            std::copy_n(bytes->begin(), std::min(bytes->size(), size), word);
+            break;
+        }
+    }
+    return data;
+}
+
+Data StaticFunction::encodePacked(std::span<const byte> packed) const {
+    if (packed.size() != _packedSize) {
+        throw std::invalid_argument("Invalid packed parameters size for " + _type);
+    }
+    Data data(encodedSize());
+    std::copy(_selector.begin(), _selector.end(), data.begin());
+    auto* word = data.data() + 4;
+    for (const auto& [kind, size] : _params) {
+        const auto width = packedWidth(kind, size);
+        const auto offset = kind == ParamKind::FixedBytes ? 0 : 32 - width;
+        std::copy_n(packed.begin(), width, word + offset);
+        if (kind == ParamKind::Bool) {
+            word[31] = word[31] != 0 ? 1 : 0;
+        }
+        packed = packed.subspan(width);
+        word += 32;
+    }
+    return data;
+}
+
+/// Reads a JSON number, or a decimal or 0x-prefixed hex string.
+static uint256_t jsonNumber(const nlohmann::json& value) {
+    if (value.is_number_unsigned()) {
+        return value.get<uint64_t>();
+    }
+    if (value.is_string()) {
+        const auto& string = value.get_ref<const std::string&>();
+        if (string.starts_with("0x")) {
+            return load(parse_hex(string));
+        }
+        if (!string.empty() && std::all_of(string.begin(), string.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            return uint256_t(string);
+        }
+    }
+    throw std::invalid_argument("Invalid number: " + value.dump());
+}
+
+Data StaticFunction::encodeJson(const nlohmann::json& values) const {
+    if (!values.is_array()) {
+        throw std::invalid_argument("Parameters of " + _type + " are not an array");
+    }
+    std::vector<Value> converted;
+    converted.reserve(values.size());
+    for (std::size_t i = 0; i < values.size() && i < _params.size(); ++i) {
+        const auto& value = values[i];
+        switch (_params[i].first) {
+        case ParamKind::Address:
+        case ParamKind::FixedBytes:
+            if (!value.is_string()) {
+                throw std::invalid_argument("Invalid bytes parameter for " + _type);
+            }
+            converted.emplace_back(parse_hex(value.get_ref<const std::string&>()));
+            break;
+        case ParamKind::Bool:
+            if (!value.is_boolean()) {
+                throw std::invalid_argument("Invalid bool parameter for " + _type);
+            }
+            converted.emplace_back(uint256_t(value.get<bool>() ? 1 : 0));
+            break;
+        case ParamKind::UInt:
+            converted.emplace_back(jsonNumber(value));
+            break;
+        }
+    }
+    if (values.size() != _params.size()) {
+        throw std::invalid_argument("Invalid number of parameters for " + _type);
+    }
+    return encode(converted);
+}
+
+Data StaticFunction::decodePacked(std::span<const byte> encoded) const {
+    if (encoded.size() == encodedSize()) {
+        if (!std::equal(_selector.begin(), _selector.end(), encoded.begin())) {
+            throw std::invalid_argument("Invalid selector for " + _type);
+        }
+        encoded = encoded.subspan(4);
+    } else if (encoded.size() != 32 * _params.size()) {
+        throw std::invalid_argument("Invalid encoded size for " + _type);
+    }
+    Data packed(_packedSize);
+    auto* out = packed.data();
+    for (const auto& [kind, size] : _params) {
+        const auto width = packedWidth(kind, size);
+        const auto offset = kind == ParamKind::FixedBytes ? 0 : 32 - width;
+        const auto* word = encoded.data();
+        const auto isZero = [](byte b) { return b == 0; };
+        if (!std::all_of(word, word + offset, isZero) || !std::all_of(word + offset + width, word + 32, isZero) ||
+            (kind == ParamKind::Bool && word[31] > 1)) {
+            throw std::invalid_argument("Invalid encoded parameter for " + _type);
+        }
+        out = std::copy_n(word + offset, width, out);
+        encoded = encoded.subspan(32);
+    }
+    return packed;
+}
+
+} // namespace TW::Ethereum::ABI
@@ -0,0 +1,100 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "../../uint256.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// Returns the 4-byte selector of a function type signature, like "transfer(address,uint256)".
+/// Selectors are cached, so the keccak256 of a signature is computed once.
+Data functionSelector(const std::string& type);
+
+/// Number of cached selectors.
+std::size_t functionSelectorCacheSize();
+
+/// Removes cached selectors, keeping at most `count`.
+void trimFunctionSelectorCache(std::size_t count);
+
+/// A function with static parameters only, compiled once: its selector and the layout of its parameter words.
+/// Encoding a call writes the selector and one 32-byte word per parameter into a single buffer,
+/// without building a parameter tree.
+class StaticFunction {
+public:
+    /// Supported parameter types.
+    enum class ParamKind {
+        Address,
+        Bool,
+        UInt,       // uint8 ... uint256
+        FixedBytes, // bytes1 ... bytes32
+    };
+
+    /// A parameter value: a number (address, bool, uint), or bytes (address, bytesN).
+    using Value = std::variant<uint256_t, Data>;
+
+    /// Compiles a function type signature, like "transfer(address,uint256)".
+    ///
+    /// \throws std::invalid_argument if the signature is malformed or has a dynamic, signed or composite parameter.
+    explicit StaticFunction(const std::string& type);
+
+    /// Returns the compiled function for `type`, compiling it on first use.
+    ///
+    /// \throws std::invalid_argument like the constructor.
+    static const StaticFunction& get(const std::string& type);
+
+    const std::string& type() const noexcept { return _type; }
+    const std::array<byte, 4>& selector() const noexcept { return _selector; }
+    const std::vector<std::pair<ParamKind, std::size_t>>& params() const noexcept { return _params; }
+
+    /// Size of an encoded call.
+    std::size_t encodedSize() const noexcept { return 4 + 32 * _params.size(); }
+
+    /// Encodes a call with the given parameter values, same encoding as `Function::encode`.
+    ///
+    /// \throws std::invalid_argument if the number or the kinds of the values do not match.
+    Data encode(const std::vector<Value>& values) const;
+
+    /// Size of packed parameter values, see `encodePacked`.
+    std::size_t packedSize() const noexcept { return _packedSize; }
+
+    /// Encodes a call from packed parameter values: the values concatenated, each big endian in its natural size
+    /// (20 bytes for address, 1 for bool, N/8 for uintN, N for bytesN).
+    ///
+    /// \throws std::invalid_argument if the size of `packed` is not `packedSize()`.
+    Data encodePacked(std::span<const byte> packed) const;
+
+    /// Encodes a call from a JSON array of parameter values: numbers as JSON numbers or decimal or
+    /// 0x-prefixed hex strings, bools as JSON booleans, addresses and bytesN as hex strings.
+    ///
+    /// \throws std::invalid_argument if the values do not match the parameters.
+    Data encodeJson(const nlohmann::json& values) const;
+
+    /// Decodes call data (with the selector) or return data (without) into packed parameter values,
+    /// the inverse of `encodePacked`.
+    ///
+    /// \throws std::invalid_argument if the size or the selector do not match, a word has non-zero padding,
+    /// or a bool is neither 0 nor 1.
+    Data decodePacked(std::span<const byte> encoded) const;
+
+private:
+    std::string _type;
+    std::array<byte, 4> _selector;
+    /// Kind and size (bits for numbers, bytes for bytesN) of each parameter.
+    std::vector<std::pair<ParamKind, std::size_t>> _params;
+    std::size_t _packedSize = 0;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -15,6 +15,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include <string>
+#include <type_traits>
 
 namespace TW::Ethereum::ABI {
 
@@ -44,7 +45,11 @@ public:
     virtual bool isDynamic() const { return false; }
     virtual void encode(Data& data) const {
         // cast up
-        ValueEncoder::encodeUInt256(static_cast<uint256_t>(_val), data);
+        if constexpr (std::is_unsigned_v<T>) {
+            ValueEncoder::encodeUInt256(FixedUint256(_val), data);
+        } else {
+            ValueEncoder::encodeUInt256(static_cast<uint256_t>(_val), data);
+        }
     }
     static bool decodeNumber(const Data& encoded, T& decoded, size_t& offset_inout) {
         uint256_t val256;
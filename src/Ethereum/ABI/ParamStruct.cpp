@@ -9,9 +9,12 @@
 #include "ParamFactory.h"
 #include <Hash.h>
 #include <HexCoding.h>
+#include "algorithm/parallel.h"
 
 #include <algorithm>
+#include <map>
 #include <nlohmann/json.hpp>
+#include <set>
 
 #include <cassert>
 #include <string>
@@ -105,27 +108,40 @@ std::shared_ptr<ParamNamed> ParamSetNamed::findParamByName(const std::string& na
 }
 
 Data ParamStruct::hashType() const {
-    return Hash::keccak256(TW::data(encodeType()));
+    if (_typeHash != nullptr && !_typeHash->empty()) {
+        return *_typeHash;
+    }
+    auto hash = Hash::keccak256(TW::data(encodeType()));
+    if (_typeHash != nullptr) {
+        *_typeHash = hash;
+    }
+    return hash;
 }
 
 Data ParamStruct::encodeHashes() const {
     Data hashes;
     Data paramsHashes = _params.encodeHashes();
     if (paramsHashes.size() > 0) {
-        auto fullType = encodeType();
-        hashes = Hash::keccak256(TW::data(fullType));
+        hashes = hashType();
         append(hashes, paramsHashes);
     }
     return hashes;
 }
 
 Data ParamStruct::hashStruct() const {
-    Data hash(32);
-    Data hashes = encodeHashes();
-    if (hashes.size() > 0) {
-        hash = Hash::keccak256(hashes);
+    // Equivalent to keccak256(encodeHashes()), streamed without the intermediate buffer.
+    auto hasher = Hash::StreamHasher(Hash::HasherKeccak256);
+    hasher.update(hashType());
+    bool hasParamsHashes = false;
+    for (size_t i = 0; i < _params.getCount(); ++i) {
+        const auto paramHash = _params.getParam(static_cast<int>(i))->hashStruct();
+        hasParamsHashes = hasParamsHashes || !paramHash.empty();
+        hasher.update(paramHash);
     }
-    return hash;
+    if (!hasParamsHashes) {
+        return Data(32);
+    }
+    return hasher.finalize();
 }
 
 std::string ParamStruct::getExtraTypes(std::vector<std::string>& ignoreList) const {
@@ -138,41 +154,158 @@ std::string ParamStruct::getExtraTypes(std::vector<std::string>& ignoreList) con
     return types;
 }
 
-Data ParamStruct::hashStructJson(const std::string& messageJson) {
-    auto message = json::parse(messageJson, nullptr, false);
-    if (message.is_discarded()) {
+std::shared_ptr<ParamStruct> findType(const std::string& typeName, const std::vector<std::shared_ptr<ParamStruct>>& types) {
+    for (auto& t : types) {
+        if (t->getType() == typeName) {
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+/// Makes a named struct from its parsed values, see makeStruct.
+/// Structs of the same type share their type hash in `typeHashes`, so it is computed once.
+/// A struct with a missing sub-struct value holds an empty sub-struct and has a different full type;
+/// it is reported as not `complete` and gets its own type hash.
+static std::shared_ptr<ParamStruct> makeStructFromValues(const std::string& structType, const json& values, const std::vector<std::shared_ptr<ParamStruct>>& types, TypeHashes& typeHashes, bool& complete) {
+    complete = true;
+    // find type info
+    auto typeInfo = findType(structType, types);
+    if (!typeInfo) {
+        throw std::invalid_argument("Type not found, " + structType);
+    }
+    if (values.is_discarded()) {
+        throw std::invalid_argument("Could not parse value Json");
+    }
+    if (!values.is_object()) {
+        throw std::invalid_argument("Expecting object");
+    }
+    std::vector<std::shared_ptr<ParamNamed>> params;
+    const auto& typeParams = typeInfo->getParams();
+    // iterate through the type; order is important and field order in the value json is not defined
+    for (auto i = 0ul; i < typeParams.getCount(); ++i) {
+        auto name = typeParams.getParam(static_cast<int>(i))->getName();
+        auto type = typeParams.getParam(static_cast<int>(i))->getParam()->getType();
+        // look for it in value
+        const auto value = values.contains(name) ? values[name] : json();
+        // first try simple params
+        auto paramVal = ParamFactory::make(type);
+        if (paramVal) {
+            std::string valueString = value.is_string() ? value.get<std::string>() : value.dump();
+            if (!paramVal->setValueJson(valueString)) {
+                throw std::invalid_argument("Could not set type for param " + name);
+            }
+            params.push_back(std::make_shared<ParamNamed>(name, paramVal));
+        } else if (type.length() >= 2 && type.substr(type.length() - 2, 2) == "[]") {
+            // array of struct
+            auto arrayType = type.substr(0, type.length() - 2);
+            auto subTypeInfo = findType(arrayType, types);
+            if (!subTypeInfo) {
+                throw std::invalid_argument("Could not find type for array sub-struct " + arrayType);
+            }
+            if (!value.is_array()) {
+                throw std::invalid_argument("Value must be array for type " + type);
+            }
+            std::vector<std::shared_ptr<ParamBase>> paramsArray;
+            bool subComplete = true;
+            if (value.size() == 0) {
+                // empty array
+                auto subStruct = makeStructFromValues(arrayType, json::object(), types, typeHashes, subComplete);
+                complete = complete && subComplete;
+                auto tmp = std::make_shared<ParamArray>(paramsArray);
+                tmp->setProto(subStruct);
+                params.push_back(std::make_shared<ParamNamed>(name, tmp));
+            } else {
+                for (const auto& e : value) {
+                    paramsArray.push_back(makeStructFromValues(arrayType, e, types, typeHashes, subComplete));
+                    complete = complete && subComplete;
+                }
+                params.push_back(std::make_shared<ParamNamed>(name, std::make_shared<ParamArray>(paramsArray)));
+            }
+        } else {
+            // try if sub struct
+            auto subTypeInfo = findType(type, types);
+            if (!subTypeInfo) {
+                throw std::invalid_argument("Could not find type for sub-struct " + type);
+            }
+            if (value.is_null()) {
+                params.push_back(std::make_shared<ParamNamed>(name, std::make_shared<ParamStruct>(type, std::vector<std::shared_ptr<ParamNamed>>{})));
+                complete = false;
+            } else {
+                bool subComplete = true;
+                params.push_back(std::make_shared<ParamNamed>(name, makeStructFromValues(type, value, types, typeHashes, subComplete)));
+                complete = complete && subComplete;
+            }
+        }
+    }
+    if (!complete) {
+        return std::make_shared<ParamStruct>(structType, params);
+    }
+    auto& typeHash = typeHashes[structType];
+    if (typeHash == nullptr) {
+        typeHash = std::make_shared<Data>();
+    }
+    return std::make_shared<ParamStruct>(structType, params, typeHash);
+}
+
+static std::shared_ptr<ParamStruct> makeStructFromValues(const std::string& structType, const json& values, const std::vector<std::shared_ptr<ParamStruct>>& types, TypeHashes& typeHashes) {
+    try {
+        bool complete = true;
+        return makeStructFromValues(structType, values, types, typeHashes, complete);
+    } catch (const std::invalid_argument& ex) {
+        throw;
+    } catch (const std::exception& ex) {
+        throw std::invalid_argument(std::string("Could not process Json: ") + ex.what());
+    } catch (...) {
+        throw std::invalid_argument("Could not process Json");
+    }
+}
+
+/// Parses typed data and checks its top-level fields, see hashStructJson; the message is optional for a domain.
+static json parseTypedData(const std::string& typedDataJson, bool requireMessage) {
+    auto typedData = json::parse(typedDataJson, nullptr, false);
+    if (typedData.is_discarded()) {
         throw std::invalid_argument("Could not parse Json");
     }
-    if (!message.is_object()) {
+    if (!typedData.is_object()) {
         throw std::invalid_argument("Expecting Json object");
     }
-    if (!message.contains("primaryType") || !message["primaryType"].is_string()) {
+    if (!typedData.contains("primaryType") || !typedData["primaryType"].is_string()) {
         throw std::invalid_argument("Top-level string field 'primaryType' missing");
     }
-    if (!message.contains("domain") || !message["domain"].is_object()) {
+    if (!typedData.contains("domain") || !typedData["domain"].is_object()) {
         throw std::invalid_argument("Top-level object field 'domain' missing");
     }
-    if (!message.contains("message") || !message["message"].is_object()) {
+    if (requireMessage && (!typedData.contains("message") || !typedData["message"].is_object())) {
         throw std::invalid_argument("Top-level object field 'message' missing");
     }
-    if (!message.contains("types") || !message["types"].is_object()) {
+    if (!typedData.contains("types") || !typedData["types"].is_object()) {
         throw std::invalid_argument("Top-level object field 'types' missing");
     }
+    return typedData;
+}
+
+/// keccak256(0x1901 || domainSeparator || hashStruct(message)), the hash signed for a typed message.
+static Data signingHash(const Data& domainSeparator, const Data& messageHash) {
+    auto hasher = Hash::StreamHasher(Hash::HasherKeccak256);
+    hasher.update(EipStructPrefix).update(domainSeparator).update(messageHash);
+    return hasher.finalize();
+}
+
+Data ParamStruct::hashStructJson(const std::string& messageJson) {
+    auto message = parseTypedData(messageJson, true);
 
     // concatenate hashes
     Data hashes = EipStructPrefix;
 
-    auto domainStruct = makeStruct(
-        Eip712Domain,
-        message["domain"].dump(),
-        message["types"].dump());
+    // the types are parsed once, and the type hashes are shared by the domain and the message
+    const auto types = makeTypes(message["types"].dump());
+    TypeHashes typeHashes;
+    auto domainStruct = makeStructFromValues(Eip712Domain, message["domain"], types, typeHashes);
     if (domainStruct) {
         TW::append(hashes, domainStruct->hashStruct());
 
-        auto messageStruct = makeStruct(
-            message["primaryType"].get<std::string>(),
-            message["message"].dump(),
-            message["types"].dump());
+        auto messageStruct = makeStructFromValues(message["primaryType"].get<std::string>(), message["message"], types, typeHashes);
         if (messageStruct) {
             const auto messageHash = messageStruct->hashStruct();
             TW::append(hashes, messageHash);
@@ -182,100 +315,13 @@ Data ParamStruct::hashStructJson(const std::string& messageJson) {
     return {}; // fallback
 }
 
-std::shared_ptr<ParamStruct> findType(const std::string& typeName, const std::vector<std::shared_ptr<ParamStruct>>& types) {
-    for (auto& t : types) {
-        if (t->getType() == typeName) {
-            return t;
-        }
-    }
-    return nullptr;
-}
-
 std::shared_ptr<ParamStruct> ParamStruct::makeStruct(const std::string& structType, const std::string& valueJson, const std::string& typesJson) {
     try {
         // parse types
-        auto types = makeTypes(typesJson);
-        // find type info
-        auto typeInfo = findType(structType, types);
-        if (!typeInfo) {
-            throw std::invalid_argument("Type not found, " + structType);
-        }
-        auto values = json::parse(valueJson, nullptr, false);
-        if (values.is_discarded()) {
-            throw std::invalid_argument("Could not parse value Json");
-        }
-        if (!values.is_object()) {
-            throw std::invalid_argument("Expecting object");
-        }
-        std::vector<std::shared_ptr<ParamNamed>> params;
-        const auto& typeParams = typeInfo->getParams();
-        // iterate through the type; order is important and field order in the value json is not defined
-        for (auto i = 0ul; i < typeParams.getCount(); ++i) {
-            auto name = typeParams.getParam(static_cast<int>(i))->getName();
-            auto type = typeParams.getParam(static_cast<int>(i))->getParam()->getType();
-            // look for it in value (may throw)
-            auto value = values[name];
-            // first try simple params
-            auto paramVal = ParamFactory::make(type);
-            if (paramVal) {
-                if (!values.is_null()) {
-                    std::string valueString = value.is_string() ? value.get<std::string>() : value.dump();
-                    if (!paramVal->setValueJson(valueString)) {
-                        throw std::invalid_argument("Could not set type for param " + name);
-                    }
-                }
-                params.push_back(std::make_shared<ParamNamed>(name, paramVal));
-            } else if (type.length() >= 2 && type.substr(type.length() - 2, 2) == "[]") {
-                // array of struct
-                auto arrayType = type.substr(0, type.length() - 2);
-                auto subTypeInfo = findType(arrayType, types);
-                if (!subTypeInfo) {
-                    throw std::invalid_argument("Could not find type for array sub-struct " + arrayType);
-                }
-                if (!value.is_array()) {
-                    throw std::invalid_argument("Value must be array for type " + type);
-                }
-                std::vector<std::shared_ptr<ParamBase>> paramsArray;
-                if (value.size() == 0) {
-                    // empty array
-                    auto subStruct = makeStruct(arrayType, "{}", typesJson);
-                    if (!subStruct) {
-                        throw std::invalid_argument("Could not process array sub-struct " + arrayType + " " + "{}");
-                    }
-                    assert(subStruct);
-                    auto tmp = std::make_shared<ParamArray>(paramsArray);
-                    tmp->setProto(subStruct);
-                    params.push_back(std::make_shared<ParamNamed>(name, tmp));
-                } else {
-                    for (const auto& e : value) {
-                        auto subStruct = makeStruct(arrayType, e.dump(), typesJson);
-                        if (!subStruct) {
-                            throw std::invalid_argument("Could not process array sub-struct " + arrayType + " " + e.dump());
-                        }
-                        assert(subStruct);
-                        paramsArray.push_back(subStruct);
-                    }
-                    params.push_back(std::make_shared<ParamNamed>(name, std::make_shared<ParamArray>(paramsArray)));
-                }
-            } else {
-                // try if sub struct
-                auto subTypeInfo = findType(type, types);
-                if (!subTypeInfo) {
-                    throw std::invalid_argument("Could not find type for sub-struct " + type);
-                }
-                if (value.is_null()) {
-                    params.push_back(std::make_shared<ParamNamed>(name, std::make_shared<ParamStruct>(type, std::vector<std::shared_ptr<ParamNamed>>{})));
-                } else {
-                    auto subStruct = makeStruct(type, value.dump(), typesJson);
-                    if (!subStruct) {
-                        throw std::invalid_argument("Could not process sub-struct " + type);
-                    }
-                    assert(subStruct);
-                    params.push_back(std::make_shared<ParamNamed>(name, subStruct));
-                }
-            }
-        }
-        return std::make_shared<ParamStruct>(structType, params);
+        const auto types = makeTypes(typesJson);
+        const auto values = json::parse(valueJson, nullptr, false);
+        TypeHashes typeHashes;
+        return makeStructFromValues(structType, values, types, typeHashes);
     } catch (const std::invalid_argument& ex) {
         throw;
     } catch (const std::exception& ex) {
@@ -382,4 +428,126 @@ std::vector<std::shared_ptr<ParamStruct>> ParamStruct::makeTypes(const std::stri
     }
 }
 
+/// Collects the struct types referenced by `type`, directly or not, including itself.
+static void collectTypes(const std::string& type, const json& types, std::set<std::string>& found) {
+    if (found.count(type) != 0 || !types.contains(type) || !types[type].is_array()) {
+        return;
+    }
+    found.insert(type);
+    for (const auto& member : types[type]) {
+        const auto memberType = member["type"].get<std::string>();
+        collectTypes(memberType.substr(0, memberType.find('[')), types, found);
+    }
+}
+
+/// EIP712 encodeType of a struct type: its definition followed by the ones of the types it references, sorted by name.
+static std::string encodeTypeJson(const std::string& type, const json& types) {
+    std::set<std::string> referenced;
+    collectTypes(type, types, referenced);
+    referenced.erase(type);
+
+    std::string encoded;
+    const auto appendType = [&](const std::string& name) {
+        encoded += name + "(";
+        for (const auto& member : types[name]) {
+            if (encoded.back() != '(') {
+                encoded += ",";
+            }
+            encoded += member["type"].get<std::string>() + " " + member["name"].get<std::string>();
+        }
+        encoded += ")";
+    };
+    appendType(type);
+    for (const auto& name : referenced) {
+        appendType(name);
+    }
+    return encoded;
+}
+
+TypedDataDomain::TypedDataDomain(const std::string& typedDataJson) {
+    try {
+        const auto typedData = parseTypedData(typedDataJson, false);
+        const auto& typesJson = typedData["types"];
+        _types = ParamStruct::makeTypes(typesJson.dump());
+        _primaryType = typedData["primaryType"].get<std::string>();
+        const auto primary = findType(_primaryType, _types);
+        if (!primary) {
+            throw std::invalid_argument("Type not found, " + _primaryType);
+        }
+        _memberCount = primary->getParams().getCount();
+        _typeHash = Hash::keccak256(TW::data(encodeTypeJson(_primaryType, typesJson)));
+
+        const auto& domain = typedData["domain"];
+        _domainSeparator = makeStructFromValues(Eip712Domain, domain, _types, _typeHashes)->hashStruct();
+        if (domain.contains("chainId") && domain["chainId"].is_number_unsigned()) {
+            _chainId = domain["chainId"].get<uint64_t>();
+        }
+    } catch (const std::invalid_argument&) {
+        throw;
+    } catch (const std::exception& ex) {
+        throw std::invalid_argument(std::string("Could not process Json: ") + ex.what());
+    }
+}
+
+TypeHashes TypedDataDomain::copyTypeHashes() const {
+    std::lock_guard lock(_mutex);
+    TypeHashes copy;
+    for (const auto& [name, hash] : _typeHashes) {
+        copy.emplace(name, std::make_shared<Data>(*hash));
+    }
+    return copy;
+}
+
+void TypedDataDomain::mergeTypeHashes(const TypeHashes& typeHashes) const {
+    std::lock_guard lock(_mutex);
+    for (const auto& [name, hash] : typeHashes) {
+        auto& cached = _typeHashes[name];
+        if (cached == nullptr) {
+            cached = std::make_shared<Data>(*hash);
+        } else if (cached->empty()) {
+            *cached = *hash;
+        }
+    }
+}
+
+Data TypedDataDomain::hashMessageJson(const std::string& messageJson) const {
+    const auto message = json::parse(messageJson, nullptr, false);
+    std::lock_guard lock(_mutex);
+    return signingHash(_domainSeparator, makeStructFromValues(_primaryType, message, _types, _typeHashes)->hashStruct());
+}
+
+Data TypedDataDomain::hashMessageEncoded(const Data& encodedData) const {
+    if (encodedData.size() != 32 * _memberCount) {
+        throw std::invalid_argument("Expecting " + std::to_string(_memberCount) + " encoded members of " + _primaryType);
+    }
+    auto hasher = Hash::StreamHasher(Hash::HasherKeccak256);
+    hasher.update(_typeHash).update(encodedData);
+    return signingHash(_domainSeparator, hasher.finalize());
+}
+
+std::vector<Data> TypedDataDomain::hashMessagesJson(std::span<const std::string> messagesJson, std::size_t threads) const {
+    // Chunks of messages share a copy of the type hashes, new ones are cached at the end of the chunk.
+    constexpr std::size_t chunkSize = 64;
+    std::vector<Data> hashes(messagesJson.size());
+    parallelFor((messagesJson.size() + chunkSize - 1) / chunkSize, threads, [&](std::size_t chunk) {
+        auto typeHashes = copyTypeHashes();
+        const auto end = std::min(messagesJson.size(), (chunk + 1) * chunkSize);
+        for (auto i = chunk * chunkSize; i < end; ++i) {
+            const auto message = json::parse(messagesJson[i], nullptr, false);
+            hashes[i] = signingHash(_domainSeparator, makeStructFromValues(_primaryType, message, _types, typeHashes)->hashStruct());
+        }
+        mergeTypeHashes(typeHashes);
+    });
+    return hashes;
+}
+
+std::vector<Data> TypedDataDomain::hashMessagesEncoded(std::span<const Data> encodedMessages) const {
+    std::vector<Data> hashes;
+    hashes.reserve(encodedMessages.size());
+    for (const auto& encoded : encodedMessages) {
+        hashes.push_back(hashMessageEncoded(encoded));
+    }
+    return hashes;
+}
+
 } // namespace TW::Ethereum::ABI
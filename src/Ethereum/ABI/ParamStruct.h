@@ -10,7 +10,11 @@
 
 #include <vector>
 #include <string>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 
 namespace TW::Ethereum::ABI {
 
@@ -64,10 +68,14 @@ class ParamStruct: public ParamCollection
 private:
     std::string _name;
     ParamSetNamed _params;
+    /// Memoized type hash, shared by the structs of the same type made together by makeStruct (empty until computed); may be null.
+    std::shared_ptr<Data> _typeHash;
 
 public:
     ParamStruct() = default;
     ParamStruct(const std::string& name, const std::vector<std::shared_ptr<ParamNamed>>& params) : ParamCollection(), _name(name), _params(ParamSetNamed(params)) {}
+    ParamStruct(const std::string& name, const std::vector<std::shared_ptr<ParamNamed>>& params, std::shared_ptr<Data> typeHash)
+        : ParamCollection(), _name(name), _params(ParamSetNamed(params)), _typeHash(std::move(typeHash)) {}
 
     std::string getType() const { return _name; }
     const ParamSetNamed& getParams() const { return _params; }
@@ -79,7 +87,7 @@ public:
         std::vector<std::string> ignoreList;
         return getExtraTypes(ignoreList);
     }
-    /// Get the hash of the full type.
+    /// Get the hash of the full type; computed once if the type hash is shared.
     Data hashType() const;
 
     virtual size_t getSize() const { return _params.getCount(); }
@@ -144,4 +152,58 @@ public:
     static std::shared_ptr<ParamStruct> makeType(const std::string& structName, const std::string& structJson, const std::vector<std::shared_ptr<ParamStruct>>& extraTypes = {}, bool ignoreMissingType = false);
 };
 
+/// Type hashes of the structs made from the same types, by type name.
+using TypeHashes = std::map<std::string, std::shared_ptr<Data>>;
+
+/// EIP712 domain and primary type, prepared for hashing many messages, e.g. off-chain orders.
+/// The types are parsed and the domain separator is computed once; the type hashes are computed once and cached.
+/// Hashing is thread-safe.
+class TypedDataDomain {
+public:
+    /// Prepares the domain of typed data, as given to `ParamStruct::hashStructJson`; its "message" is ignored and may be missing.
+    /// Throws on error.
+    explicit TypedDataDomain(const std::string& typedDataJson);
+
+    const std::string& primaryType() const noexcept { return _primaryType; }
+
+    /// Hash of the domain struct.
+    const Data& domainSeparator() const noexcept { return _domainSeparator; }
+
+    /// Hash of the full type of the primary type, e.g. keccak256 of 'Mail(Person from,Person to,string contents)Person(string name,address wallet)'.
+    const Data& typeHash() const noexcept { return _typeHash; }
+
+    /// The "chainId" of the domain, if it has a numeric one.
+    std::optional<uint64_t> chainId() const noexcept { return _chainId; }
+
+    /// Signing hash of a message of the primary type (Json object), as `ParamStruct::hashStructJson` of the typed data with this message.
+    /// Throws on error.
+    Data hashMessageJson(const std::string& messageJson) const;
+
+    /// Signing hash of a message of the primary type given as its EIP712 `encodeData`: the 32-byte encoding of each member
+    /// in order, with dynamic and struct members already hashed. Throws if the size does not match the primary type.
+    Data hashMessageEncoded(const Data& encodedData) const;
+
+    /// Signing hashes of many messages, see `hashMessageJson`, on `threads` workers (0: hardware concurrency).
+    /// Throws on error.
+    std::vector<Data> hashMessagesJson(std::span<const std::string> messagesJson, std::size_t threads = 0) const;
+
+    /// Signing hashes of many encoded messages, see `hashMessageEncoded`. Throws on error.
+    std::vector<Data> hashMessagesEncoded(std::span<const Data> encodedMessages) const;
+
+private:
+    /// Copy of the cached type hashes, for hashing without holding the lock.
+    TypeHashes copyTypeHashes() const;
+    /// Caches the type hashes computed with a copy.
+    void mergeTypeHashes(const TypeHashes& typeHashes) const;
+
+    std::vector<std::shared_ptr<ParamStruct>> _types;
+    std::string _primaryType;
+    std::size_t _memberCount = 0;
+    Data _domainSeparator;
+    Data _typeHash;
+    std::optional<uint64_t> _chainId;
+    mutable std::mutex _mutex;
+    mutable TypeHashes _typeHashes;
+};
+
 } // namespace TW::Ethereum::ABI
@@ -10,9 +10,37 @@
 
 #include <cassert>
 #include <string>
+#include <unordered_map>
 
 namespace TW::Ethereum::ABI {
 
+/// Sizings of the parameter sets memoized by the outermost sizing or encoding in progress on this thread, if any.
+/// Each set needs the size of its elements, which recurse into their whole subtree: without the memo, nested
+/// arrays and tuples would be sized again at every level, making the cost exponential in the nesting depth.
+/// The parameters cannot change during the call.
+thread_local std::unordered_map<const ParamSet*, ParamSet::Sizing>* ParamSet::memoizedSizings = nullptr;
+
+/// Memoizes the sizings for its lifetime, unless an enclosing call already does.
+class ParamSet::SizingScope {
+public:
+    SizingScope() : outermost(memoizedSizings == nullptr) {
+        if (outermost) {
+            memoizedSizings = &sizings;
+        }
+    }
+    ~SizingScope() {
+        if (outermost) {
+            memoizedSizings = nullptr;
+        }
+    }
+    SizingScope(const SizingScope&) = delete;
+    SizingScope& operator=(const SizingScope&) = delete;
+
+private:
+    bool outermost;
+    std::unordered_map<const ParamSet*, Sizing> sizings;
+};
+
 ParamSet::~ParamSet() {
     _params.clear();
 }
@@ -68,61 +96,72 @@ std::string ParamSet::getType() const {
 }
 
 bool ParamSet::isDynamic() const {
-    for (const auto& p : _params) {
-        if (p->isDynamic()) {
-            return true;
-        }
-    }
-    return false;
+    const auto scope = SizingScope();
+    return sizing().dynamic;
 }
 
 size_t ParamSet::getSize() const {
-    // 2-pass encoding
-    size_t s = 0;
-    for (auto p : _params) {
-        if (p->isDynamic() || p->getSize() > ValueEncoder::encodedIntSize) {
-            // offset used
-            s += 32;
-        }
-        s += p->getSize();
-    }
-    return ValueEncoder::paddedTo32(s);
+    const auto scope = SizingScope();
+    return sizing().size;
 }
 
-size_t ParamSet::getHeadSize() const {
-    size_t s = 0;
-    for (auto p : _params) {
-        if (p->isDynamic()) {
-            s += 32;
-        } else {
-            s += p->getSize();
+ParamSet::Sizing ParamSet::sizing() const {
+    if (const auto found = memoizedSizings->find(this); found != memoizedSizings->end()) {
+        return found->second;
+    }
+    // 2-pass encoding
+    Sizing result{0, false};
+    for (const auto& p : _params) {
+        const auto dynamic = p->isDynamic();
+        const auto size = p->getSize();
+        if (dynamic || size > ValueEncoder::encodedIntSize) {
+            // offset used
+            result.size += 32;
         }
+        result.size += size;
+        result.dynamic = result.dynamic || dynamic;
     }
-    return s;
+    result.size = ValueEncoder::paddedTo32(result.size);
+    memoizedSizings->emplace(this, result);
+    return result;
 }
 
 void ParamSet::encode(Data& data) const {
+    // the outermost call sizes the whole tree once, and reserves the output
+    const auto scope = SizingScope();
+    data.reserve(data.size() + getSize());
+
     // 2-pass encoding
-    size_t headSize = getHeadSize();
+    std::vector<bool> tail;
+    std::vector<size_t> sizes;
+    tail.reserve(_params.size());
+    sizes.reserve(_params.size());
+    size_t headSize = 0;
+    for (const auto& p : _params) {
+        const auto dynamic = p->isDynamic();
+        sizes.push_back(p->getSize());
+        tail.push_back(dynamic || sizes.back() > ValueEncoder::encodedIntSize);
+        headSize += dynamic ? 32 : sizes.back();
+    }
     size_t dynamicOffset = 0;
 
     // pass 1: small values or indices
-    for (auto p : _params) {
-        if (p->isDynamic() || p->getSize() > ValueEncoder::encodedIntSize) {
+    for (size_t i = 0; i < _params.size(); ++i) {
+        if (tail[i]) {
             // include only offset
-            ValueEncoder::encodeUInt256(uint256_t(headSize + dynamicOffset), data);
-            dynamicOffset += p->getSize();
+            ValueEncoder::encodeUInt256(FixedUint256(headSize + dynamicOffset), data);
+            dynamicOffset += sizes[i];
         } else {
             // encode small data
-            p->encode(data);
+            _params[i]->encode(data);
         }
     }
 
     // pass 2: dynamic values
-    for (auto p : _params) {
-        if (p->isDynamic() || p->getSize() > ValueEncoder::encodedIntSize) {
+    for (size_t i = 0; i < _params.size(); ++i) {
+        if (tail[i]) {
             // encode large data
-            p->encode(data);
+            _params[i]->encode(data);
         }
     }
 }
@@ -12,6 +12,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace TW::Ethereum::ABI {
 
@@ -42,7 +43,17 @@ public:
     Data encodeHashes() const;
 
 private:
-    size_t getHeadSize() const;
+    struct Sizing {
+        size_t size;
+        bool dynamic;
+    };
+    class SizingScope;
+
+    /// Encoded size and dynamic flag, computed in one pass over the elements, memoized by the enclosing scope.
+    Sizing sizing() const;
+
+    /// Sizings memoized by the outermost sizing or encoding in progress on this thread.
+    static thread_local std::unordered_map<const ParamSet*, Sizing>* memoizedSizings;
 };
 
 /// Collection of different parameters, dynamic length, "(<par1>,<par2>,...)".
@@ -7,6 +7,9 @@
 #include "ValueDecoder.h"
 #include "Array.h"
 #include "ParamFactory.h"
+#include "ValueReader.h"
+
+#include <HexCoding.h>
 
 namespace TW::Ethereum::ABI {
 
@@ -29,7 +32,32 @@ std::string ValueDecoder::decodeValue(const Data& data, const std::string& type)
     return ParamFactory::getValue(param, param->getType());
 }
 
+/// Decodes arrays of uint256 and address elements without building a parameter per element.
+static std::optional<std::vector<std::string>> decodeWordArray(const Data& data, const std::string& type) {
+    const bool isAddress = type == "address[]";
+    if (!isAddress && type != "uint256[]" && type != "uint[]") {
+        return std::nullopt;
+    }
+    const auto array = ValueReader(data).arrayAt(0);
+    if (!array.has_value()) {
+        return std::vector<std::string>{};
+    }
+    std::vector<std::string> values;
+    values.reserve(array->count);
+    for (auto i = 0ul; i < array->count; ++i) {
+        if (isAddress) {
+            values.push_back(hexEncoded(*array->elements.address(i)));
+        } else {
+            values.push_back(toString(*array->elements.uint256(i)));
+        }
+    }
+    return values;
+}
+
 std::vector<std::string> ValueDecoder::decodeArray(const Data& data, const std::string& type) {
+    if (auto values = decodeWordArray(data, type); values.has_value()) {
+        return *values;
+    }
     auto param = ParamFactory::make(type);
     if (!param) {
         return std::vector<std::string>{};
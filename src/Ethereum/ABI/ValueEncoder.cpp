@@ -29,7 +29,7 @@ void ValueEncoder::encodeInt32(int32_t value, Data& inout) {
 
 void ValueEncoder::encodeUInt32(uint32_t value, Data& inout) {
     // cast up
-    encodeUInt256(static_cast<uint256_t>(value), inout);
+    encodeUInt256(FixedUint256(value), inout);
 }
 
 void ValueEncoder::encodeInt256(const int256_t& value, Data& inout) {
@@ -46,7 +46,13 @@ inline Data paddedOnLeft(const Data& inout) {
 }
 
 void ValueEncoder::encodeUInt256(const uint256_t& value, Data& inout) {
-    append(inout, store(value, 32));
+    encodeUInt256(toFixed(value), inout);
+}
+
+void ValueEncoder::encodeUInt256(const FixedUint256& value, Data& inout) {
+    const auto offset = inout.size();
+    inout.resize(offset + encodedIntSize);
+    value.storeBE(std::span<byte, encodedIntSize>(inout.data() + offset, encodedIntSize));
 }
 
 /// Encoding primitive: encode a number of bytes by taking hash
@@ -26,6 +26,7 @@ public:
     static void encodeUInt32(uint32_t value, Data& inout);
     static void encodeInt256(const int256_t& value, Data& inout);
     static void encodeUInt256(const uint256_t& value, Data& inout);
+    static void encodeUInt256(const FixedUint256& value, Data& inout);
     /// Encode the 20 bytes of an address
     static void encodeAddress(const Data& value, Data& inout);
     /// Encode a string by encoding its hash
@@ -0,0 +1,142 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ValueReader.h"
+#include "ValueEncoder.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace TW::Ethereum::ABI {
+
+static constexpr std::size_t WordSize = ValueEncoder::encodedIntSize;
+
+/// Reads a word as a size, if it fits; sizes are bounded by the data size anyway.
+static std::optional<std::size_t> readSize(ValueReader::Bytes word) noexcept {
+    if (std::any_of(word.begin(), word.end() - sizeof(uint64_t), [](byte b) { return b != 0; })) {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    for (auto i = WordSize - sizeof(uint64_t); i < WordSize; ++i) {
+        value = (value << 8) | word[i];
+    }
+    if (value > std::numeric_limits<std::size_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(value);
+}
+
+std::optional<ValueReader::Bytes> ValueReader::word(std::size_t slot) const noexcept {
+    if (slot >= data.size() / WordSize) {
+        return std::nullopt;
+    }
+    return data.subspan(slot * WordSize, WordSize);
+}
+
+std::optional<uint256_t> ValueReader::uint256(std::size_t slot) const noexcept {
+    const auto bytes = word(slot);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    uint256_t value;
+    import_bits(value, bytes->begin(), bytes->end());
+    return value;
+}
+
+std::optional<ValueReader::Bytes> ValueReader::address(std::size_t slot) const noexcept {
+    const auto bytes = word(slot);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    return bytes->last(20);
+}
+
+std::optional<bool> ValueReader::boolean(std::size_t slot) const noexcept {
+    const auto bytes = word(slot);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    return std::any_of(bytes->begin(), bytes->end(), [](byte b) { return b != 0; });
+}
+
+std::optional<ValueReader::Bytes> ValueReader::fixedBytes(std::size_t slot, std::size_t size) const noexcept {
+    const auto bytes = word(slot);
+    if (!bytes.has_value() || size > WordSize) {
+        return std::nullopt;
+    }
+    return bytes->first(size);
+}
+
+std::optional<ValueReader::Bytes> ValueReader::dynamicBytes(std::size_t slot) const noexcept {
+    const auto start = offset(slot);
+    if (!start.has_value()) {
+        return std::nullopt;
+    }
+    const auto length = lengthAt(*start, 1);
+    if (!length.has_value()) {
+        return std::nullopt;
+    }
+    return data.subspan(*start + WordSize, *length);
+}
+
+std::optional<std::string_view> ValueReader::string(std::size_t slot) const noexcept {
+    const auto bytes = dynamicBytes(slot);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    return std::string_view(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+}
+
+std::optional<ValueReader> ValueReader::tuple(std::size_t slot) const noexcept {
+    const auto start = offset(slot);
+    if (!start.has_value()) {
+        return std::nullopt;
+    }
+    return ValueReader(data.subspan(*start));
+}
+
+std::optional<ArrayView> ValueReader::array(std::size_t slot) const noexcept {
+    const auto start = offset(slot);
+    if (!start.has_value()) {
+        return std::nullopt;
+    }
+    return arrayAt(*start);
+}
+
+std::optional<ArrayView> ValueReader::arrayAt(std::size_t offset) const noexcept {
+    // every element takes at least one word in the array head
+    const auto count = lengthAt(offset, WordSize);
+    if (!count.has_value()) {
+        return std::nullopt;
+    }
+    return ArrayView{*count, ValueReader(data.subspan(offset + WordSize))};
+}
+
+std::optional<std::size_t> ValueReader::offset(std::size_t slot) const noexcept {
+    const auto bytes = word(slot);
+    if (!bytes.has_value()) {
+        return std::nullopt;
+    }
+    const auto value = readSize(*bytes);
+    if (!value.has_value() || *value > data.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::size_t> ValueReader::lengthAt(std::size_t offset, std::size_t unit) const noexcept {
+    if (offset > data.size() || data.size() - offset < WordSize) {
+        return std::nullopt;
+    }
+    const auto length = readSize(data.subspan(offset, WordSize));
+    const auto available = data.size() - offset - WordSize;
+    if (!length.has_value() || *length > available / unit) {
+        return std::nullopt;
+    }
+    return length;
+}
+
+} // namespace TW::Ethereum::ABI
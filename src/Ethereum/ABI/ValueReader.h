@@ -0,0 +1,78 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <Data.h>
+#include <uint256.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace TW::Ethereum::ABI {
+
+struct ArrayView;
+
+/// Lazy, non-owning reader of ABI encoded values, like `eth_call` results or log data.
+/// A reader views one tuple encoding: function parameters, a dynamic tuple, or the elements of an array.
+/// Values are read by their head slot (32-byte word index); dynamic values are followed through their offset,
+/// relative to the start of the tuple.  Nothing is decoded ahead, and bytes and strings are returned as views
+/// into the encoded data, which must outlive the reader and its results.
+/// Reads return nullopt on truncated or malformed data.
+class ValueReader {
+public:
+    using Bytes = std::span<const byte>;
+
+    ValueReader() noexcept = default;
+    ValueReader(Bytes data) noexcept : data(data) {}
+    ValueReader(const Data& data) noexcept : data(data) {}
+    ValueReader(const byte* data, std::size_t size) noexcept : data(data, size) {}
+
+    /// The viewed bytes, from the start of the tuple.
+    Bytes bytes() const noexcept { return data; }
+
+    /// The 32-byte word at `slot`.
+    std::optional<Bytes> word(std::size_t slot) const noexcept;
+    /// uint256 (or any uintN) at `slot`.
+    std::optional<uint256_t> uint256(std::size_t slot) const noexcept;
+    /// The 20 bytes of the address at `slot`.
+    std::optional<Bytes> address(std::size_t slot) const noexcept;
+    std::optional<bool> boolean(std::size_t slot) const noexcept;
+    /// The first `size` bytes of the bytesN value at `slot`.
+    std::optional<Bytes> fixedBytes(std::size_t slot, std::size_t size) const noexcept;
+
+    /// Dynamic `bytes` value, whose offset is at `slot`.
+    std::optional<Bytes> dynamicBytes(std::size_t slot) const noexcept;
+    /// Dynamic `string` value, whose offset is at `slot`.
+    std::optional<std::string_view> string(std::size_t slot) const noexcept;
+    /// Dynamic tuple (or dynamic fixed-size array), whose offset is at `slot`.
+    std::optional<ValueReader> tuple(std::size_t slot) const noexcept;
+    /// Dynamic array `T[]`, whose offset is at `slot`.
+    std::optional<ArrayView> array(std::size_t slot) const noexcept;
+
+    /// Dynamic array `T[]` encoded at byte `offset`: its length, followed by its elements.
+    std::optional<ArrayView> arrayAt(std::size_t offset) const noexcept;
+
+private:
+    /// Reads the offset at `slot`, checked against the data size.
+    std::optional<std::size_t> offset(std::size_t slot) const noexcept;
+    /// Reads the length word at byte `offset`, and checks that `length * unit` bytes follow it.
+    std::optional<std::size_t> lengthAt(std::size_t offset, std::size_t unit) const noexcept;
+
+    Bytes data;
+};
+
+/// Elements of a dynamic array, read on demand.
+/// Element `i` of a static type of `n` words is at slot `i * n` of `elements`;
+/// the slot `i` of a dynamic element type holds its offset.
+struct ArrayView {
+    std::size_t count = 0;
+    ValueReader elements;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -6,24 +6,48 @@
 
 #include "Address.h"
 #include "AddressChecksum.h"
-#include "../HexCoding.h"
+#include "../Hash.h"
 
 namespace TW::Ethereum {
 
-bool Address::isValid(const std::string& string) {
-    if (string.size() != 42 || string[0] != '0' || string[1] != 'x') {
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/// Decodes a 0x-prefixed address string, without intermediate allocations.
+static bool decodeAddress(const std::string& string, std::array<uint8_t, Address::size>& bytes) {
+    if (string.size() != 2 + 2 * Address::size || string[0] != '0' || string[1] != 'x') {
         return false;
     }
-    const auto data = parse_hex(string);
-    return Address::isValid(data);
+    for (auto i = 0ul; i < Address::size; ++i) {
+        const auto high = hexValue(string[2 + 2 * i]);
+        const auto low = hexValue(string[2 + 2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        bytes[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+bool Address::isValid(const std::string& string) {
+    std::array<uint8_t, size> bytes;
+    return decodeAddress(string, bytes);
 }
 
 Address::Address(const std::string& string) {
-    if (!isValid(string)) {
+    if (!decodeAddress(string, bytes)) {
         throw std::invalid_argument("Invalid address data");
     }
-    const auto data = parse_hex(string);
-    std::copy(data.begin(), data.end(), bytes.begin());
 }
 
 Address::Address(const Data& data) {
@@ -37,10 +61,35 @@ Address::Address(const PublicKey& publicKey) {
     if (publicKey.type != TWPublicKeyTypeSECP256k1Extended) {
         throw std::invalid_argument("Ethereum::Address needs an extended SECP256k1 public key.");
     }
-    const auto data = publicKey.hash({}, Hash::HasherKeccak256, true);
+    const auto data = publicKey.hash<Hash::HasherKeccak256>(true);
     std::copy(data.end() - Address::size, data.end(), bytes.begin());
 }
 
+std::vector<Address> Address::fromPublicKeys(const std::vector<PublicKey>& publicKeys) {
+    // the keys without their type byte
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(publicKeys.size());
+    sizes.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        if (publicKey.type != TWPublicKeyTypeSECP256k1Extended) {
+            throw std::invalid_argument("Ethereum::Address needs an extended SECP256k1 public key.");
+        }
+        pointers.push_back(publicKey.bytes.data() + 1);
+        sizes.push_back(publicKey.bytes.size() - 1);
+    }
+    Data hashes(publicKeys.size() * std::tuple_size_v<Hash::Digest32>);
+    Hash::keccak256BatchInto(pointers.data(), sizes.data(), publicKeys.size(), hashes.data());
+
+    std::vector<Address> addresses;
+    addresses.reserve(publicKeys.size());
+    for (size_t i = 0; i < publicKeys.size(); ++i) {
+        const auto hashEnd = hashes.begin() + (i + 1) * std::tuple_size_v<Hash::Digest32>;
+        addresses.emplace_back(Data(hashEnd - Address::size, hashEnd));
+    }
+    return addresses;
+}
+
 std::string Address::string() const {
     return checksumed(*this);
 }
@@ -38,6 +38,9 @@ class Address {
     /// Initializes an address with a public key.
     explicit Address(const PublicKey& publicKey);
 
+    /// Initializes the addresses of many public keys, hashing the keys as a batch.
+    static std::vector<Address> fromPublicKeys(const std::vector<PublicKey>& publicKeys);
+
     /// Returns a string representation of the address.
     std::string string() const;
   protected:
@@ -6,29 +6,69 @@
 
 #include "AddressChecksum.h"
 
-#include "../HexCoding.h"
-#include <cctype>
+#include "../Hash.h"
 
 namespace TW::Ethereum {
 
-std::string checksumed(const Address& address) {
-    const auto addressString = hex(address.bytes);
-    const auto hash = hex(Hash::keccak256(addressString));
-
-    std::string string = "0x";
-    for (auto i = 0ul; i < std::min(addressString.size(), hash.size()); i += 1) {
-        const auto a = addressString[i];
-        const auto h = hash[i];
-        if (a >= '0' && a <= '9') {
-            string.push_back(a);
-        } else if ((h >= '8' && h <= '9') || (h >= 'a' && h <= 'f')) {
-            string.push_back(static_cast<char>(toupper(a)));
-        } else {
-            string.push_back(static_cast<char>(tolower(a)));
-        }
+namespace {
+
+constexpr char lower[] = "0123456789abcdef";
+constexpr char upper[] = "0123456789ABCDEF";
+constexpr std::size_t hashSize = std::tuple_size_v<Hash::Digest32>;
+
+/// Writes the lowercase hex of the address, `2 * Address::size` characters, at `out`.
+void lowercaseInto(const Address& address, char* out) {
+    for (auto i = 0ul; i < Address::size; i += 1) {
+        out[2 * i] = lower[address.bytes[i] >> 4];
+        out[2 * i + 1] = lower[address.bytes[i] & 0x0f];
+    }
+}
+
+/// Writes the checksummed address given the Keccak hash of its lowercase hex.
+void checksumedInto(const Address& address, const byte* hash, char* out) {
+    out[0] = '0';
+    out[1] = 'x';
+    for (auto i = 0ul; i < 2 * Address::size; i += 1) {
+        // a hash nibble of 8 or more uppercases the letter
+        const auto nibble = (i % 2 == 0) ? (hash[i / 2] >> 4) : (hash[i / 2] & 0x0f);
+        const auto value = (i % 2 == 0) ? (address.bytes[i / 2] >> 4) : (address.bytes[i / 2] & 0x0f);
+        out[2 + i] = nibble >= 8 ? upper[value] : lower[value];
     }
+}
+
+} // namespace
 
+void checksumedInto(const Address& address, char* out) {
+    std::array<char, 2 * Address::size> addressString;
+    lowercaseInto(address, addressString.data());
+    Hash::Digest32 hash;
+    Hash::keccak256Into(reinterpret_cast<const byte*>(addressString.data()), addressString.size(), hash);
+    checksumedInto(address, hash.data(), out);
+}
+
+std::string checksumed(const Address& address) {
+    std::string string(checksumedSize, '\0');
+    checksumedInto(address, string.data());
     return string;
 }
 
+std::string checksumBatch(const std::vector<Address>& addresses) {
+    // the lowercase hex strings all have the same size, their hashes are computed as a batch
+    std::string lowercase(addresses.size() * 2 * Address::size, '\0');
+    std::vector<const byte*> pointers(addresses.size());
+    const std::vector<size_t> sizes(addresses.size(), 2 * Address::size);
+    for (auto i = 0ul; i < addresses.size(); i += 1) {
+        lowercaseInto(addresses[i], lowercase.data() + i * 2 * Address::size);
+        pointers[i] = reinterpret_cast<const byte*>(lowercase.data()) + i * 2 * Address::size;
+    }
+    Data hashes(addresses.size() * hashSize);
+    Hash::keccak256BatchInto(pointers.data(), sizes.data(), addresses.size(), hashes.data());
+
+    std::string arena(addresses.size() * checksumedSize, '\0');
+    for (auto i = 0ul; i < addresses.size(); i += 1) {
+        checksumedInto(addresses[i], hashes.data() + i * hashSize, arena.data() + i * checksumedSize);
+    }
+    return arena;
+}
+
 } // namespace TW::Ethereum
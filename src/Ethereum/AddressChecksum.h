@@ -8,9 +8,19 @@
 
 #include "Address.h"
 #include <string>
+#include <vector>
 
 namespace TW::Ethereum {
 
+/// Number of characters of an EIP-55 checksummed address, with the 0x prefix.
+static constexpr std::size_t checksumedSize = 2 + 2 * Address::size;
+
+/// Writes the EIP-55 checksummed address, `checksumedSize` characters without terminator, at `out`.
+void checksumedInto(const Address& address, char* out);
+
 std::string checksumed(const Address& address);
 
+/// Checksums many addresses into one preallocated string; address `i` is at offset `i * checksumedSize`.
+std::string checksumBatch(const std::vector<Address>& addresses);
+
 } // namespace TW::Ethereum
@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Barz.h"
 #include "ABI.h"
 #include "AddressChecksum.h"
 #include "EIP1014.h"
@@ -19,6 +20,10 @@ using ParamBasePtr = std::shared_ptr<Ethereum::ABI::ParamBase>;
 using ParamCollection = std::vector<ParamBasePtr>;
 
 std::string getCounterfactualAddress(const Proto::ContractAddressInput input) {
+    return getCounterfactualAddresses(input, {input.owner()}).front();
+}
+
+std::vector<std::string> getCounterfactualAddresses(const Proto::ContractAddressInput& input, const std::vector<Proto::ContractOwner>& owners) {
     auto params = Ethereum::ABI::ParamTuple();
     params.addParam(std::make_shared<Ethereum::ABI::ParamAddress>(parse_hex(input.diamond_cut_facet())));
     params.addParam(std::make_shared<Ethereum::ABI::ParamAddress>(parse_hex(input.account_facet())));
@@ -27,30 +32,51 @@ std::string getCounterfactualAddress(const Proto::ContractAddressInput input) {
     params.addParam(std::make_shared<Ethereum::ABI::ParamAddress>(parse_hex(input.diamond_loupe_facet())));
     params.addParam(std::make_shared<Ethereum::ABI::ParamAddress>(parse_hex(input.diamond_init())));
     params.addParam(std::make_shared<Ethereum::ABI::ParamAddress>(parse_hex(input.facet_registry())));
+    params.addParam(std::make_shared<Ethereum::ABI::ParamByteArray>(Data()));
 
-    Data publicKey;
-    switch (input.owner().kind_case()) {
-    case Proto::ContractOwner::KindCase::KIND_NOT_SET:
-        return "";
-    case Proto::ContractOwner::KindCase::kPublicKey:
-        publicKey = parse_hex(input.owner().public_key());
-        break;
-    case Proto::ContractOwner::KindCase::kAttestationObject:
-        const auto attestationObject = parse_hex(input.owner().attestation_object());
-        publicKey = subData(WebAuthn::getPublicKey(attestationObject)->bytes, 1); // Drop the first byte which corresponds to the public key type
-        break;
-    }
-    params.addParam(std::make_shared<Ethereum::ABI::ParamByteArray>(publicKey));
-
+    // The init code is the bytecode followed by the encoded tuple, whose head doesn't depend on the owner:
+    // it is hashed once, and only the encoded public key is hashed for each owner.
     Data encoded;
     params.encode(encoded);
+    const auto headSize = params.getCount() * 32;
+    auto prefixHasher = Hash::StreamHasher(Hash::HasherKeccak256);
+    prefixHasher.update(parse_hex(input.bytecode())).update(encoded.data(), headSize);
+
+    std::vector<Data> initCodeHashes;
+    std::vector<size_t> indices;
+    initCodeHashes.reserve(owners.size());
+    indices.reserve(owners.size());
+    for (size_t i = 0; i < owners.size(); ++i) {
+        Data publicKey;
+        switch (owners[i].kind_case()) {
+        case Proto::ContractOwner::KindCase::KIND_NOT_SET:
+            continue;
+        case Proto::ContractOwner::KindCase::kPublicKey:
+            publicKey = parse_hex(owners[i].public_key());
+            break;
+        case Proto::ContractOwner::KindCase::kAttestationObject:
+            const auto attestationObject = parse_hex(owners[i].attestation_object());
+            publicKey = subData(WebAuthn::getPublicKey(attestationObject)->bytes, 1); // Drop the first byte which corresponds to the public key type
+            break;
+        }
+        Data tail;
+        Ethereum::ABI::ParamByteArray(publicKey).encode(tail);
+        auto hasher = prefixHasher;
+        initCodeHashes.push_back(hasher.update(tail).finalize());
+        indices.push_back(i);
+    }
+    if (initCodeHashes.empty()) {
+        return std::vector<std::string>(owners.size());
+    }
 
-    Data initCode = parse_hex(input.bytecode());
-    append(initCode, encoded);
-
-    const Data initCodeHash = Hash::keccak256(initCode);
-    const Data salt(32, 0);
-    return Ethereum::checksumed(Ethereum::Address(hexEncoded(Ethereum::create2Address(input.factory(), salt, initCodeHash))));
+    const std::vector<Data> salts(initCodeHashes.size(), Data(32, 0));
+    const auto addresses = Ethereum::create2Addresses(Ethereum::Address(parse_hex(input.factory())), salts, initCodeHashes);
+    const auto strings = Ethereum::checksumBatch(addresses);
+    std::vector<std::string> result(owners.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        result[indices[i]] = strings.substr(i * Ethereum::checksumedSize, Ethereum::checksumedSize);
+    }
+    return result;
 }
 
 Data getInitCodeFromPublicKey(const std::string& factoryAddress, const std::string& publicKey, const std::string& verificationFacet) {
@@ -76,17 +102,18 @@ Data getFormattedSignature(const Data& signature, const Data& authenticatorData,
     const std::string clientDataJSONPre = "{\"type\":\"webauthn.get\",\"challenge\":\"";
     const std::string clientDataJSONPost = "\",\"origin\":\"" + origin + "\"}";
 
-    const auto parsedSignatureOptional = ASN::AsnParser::ecdsa_signature_from_der(signature);
-    if (!parsedSignatureOptional.has_value()) {
+    ASN::AsnParser::EcdsaSignature parsedSignature;
+    if (!ASN::AsnParser::ecdsa_signature_from_der(signature.data(), signature.size(), parsedSignature)) {
         return Data();
     }
-    const Data parsedSignature = parsedSignatureOptional.value();
-    const Data rValue = subData(parsedSignature, 0, 32);
-    const Data sValue = subData(parsedSignature, 32, 64);
+    uint256_t rValue;
+    uint256_t sValue;
+    import_bits(rValue, parsedSignature.begin(), parsedSignature.begin() + 32);
+    import_bits(sValue, parsedSignature.begin() + 32, parsedSignature.end());
 
     auto params = Ethereum::ABI::ParamTuple();
-    params.addParam(std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(hexEncoded(rValue))));
-    params.addParam(std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(hexEncoded(sValue))));
+    params.addParam(std::make_shared<Ethereum::ABI::ParamUInt256>(rValue));
+    params.addParam(std::make_shared<Ethereum::ABI::ParamUInt256>(sValue));
     params.addParam(std::make_shared<Ethereum::ABI::ParamByteArray>(authenticatorData));
     params.addParam(std::make_shared<Ethereum::ABI::ParamString>(clientDataJSONPre));
     params.addParam(std::make_shared<Ethereum::ABI::ParamString>(clientDataJSONPost));
@@ -10,9 +10,15 @@
 #include "uint256.h"
 #include "../proto/Barz.pb.h"
 
+#include <string>
+#include <vector>
+
 namespace TW::Barz {
 
 std::string getCounterfactualAddress(const Proto::ContractAddressInput input);
+/// Computes the counterfactual addresses of the accounts of many owners with the same contracts, the factory and
+/// bytecode of `input`, its owner being ignored. The address of an owner without a key is empty.
+std::vector<std::string> getCounterfactualAddresses(const Proto::ContractAddressInput& input, const std::vector<Proto::ContractOwner>& owners);
 Data getInitCodeFromPublicKey(const std::string& factoryAddress, const std::string& owner, const std::string& verificationFacet);
 Data getInitCodeFromAttestationObject(const std::string& factoryAddress, const std::string& attestationObject, const std::string& verificationFacet);
 Data getFormattedSignature(const Data& signature, const Data& authenticatorData, const std::string& origin);
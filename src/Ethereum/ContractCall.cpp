@@ -6,9 +6,12 @@
 
 #include "ContractCall.h"
 #include "ABI.h"
+#include "ABI/FunctionCache.h"
+#include "BinaryCoding.h"
 #include "HexCoding.h"
 #include "uint256.h"
 #include <boost/algorithm/string/predicate.hpp>
+#include <stdexcept>
 
 using namespace std;
 using json = nlohmann::json;
@@ -96,20 +99,9 @@ void fillTuple(ParamSet& paramSet, const json& jsonSet) {
     paramSet.addParam(param);
 }
 
-optional<string> decodeCall(const Data& call, const json& abi) {
-    // check bytes length
-    if (call.size() <= 4) {
-        return {};
-    }
-
-    auto methodId = hex(Data(call.begin(), call.begin() + 4));
-
-    if (abi.find(methodId) == abi.end()) {
-        return {};
-    }
-
+/// Decodes a call with the description of its function.
+static optional<string> decodeFunction(const Data& call, const json& registry) {
     // build Function with types
-    const auto registry = abi[methodId];
     auto func = Function(registry["name"]);
     decodeParamSet(func._inParams, registry["inputs"]);
 
@@ -128,4 +120,79 @@ optional<string> decodeCall(const Data& call, const json& abi) {
     return decoded.dump();
 }
 
+optional<string> decodeCall(const Data& call, const json& abi) {
+    // check bytes length
+    if (call.size() <= 4) {
+        return {};
+    }
+
+    auto methodId = hex(Data(call.begin(), call.begin() + 4));
+
+    if (abi.find(methodId) == abi.end()) {
+        return {};
+    }
+    return decodeFunction(call, abi[methodId]);
+}
+
+/// Canonical type of a parameter in a function signature, tuples as their component types.
+static string canonicalType(const json& param) {
+    const auto& type = param.at("type").get_ref<const string&>();
+    if (!boost::algorithm::starts_with(type, "tuple")) {
+        return type;
+    }
+    string result = "(";
+    for (const auto& component : param.at("components")) {
+        if (result.size() > 1) {
+            result += ",";
+        }
+        result += canonicalType(component);
+    }
+    return result + ")" + type.substr(5);
+}
+
+void CallDecoder::add(const json& abi) {
+    try {
+        if (abi.is_object()) {
+            for (const auto& [methodId, registry] : abi.items()) {
+                const auto selector = parse_hex(methodId);
+                if (selector.size() != 4) {
+                    throw invalid_argument("Invalid selector: " + methodId);
+                }
+                functions[decode32BE(selector.data())] = registry;
+            }
+        } else if (abi.is_array()) {
+            for (const auto& registry : abi) {
+                if (registry.value("type", "function") != "function") {
+                    continue;
+                }
+                auto signature = registry.at("name").get<string>() + "(";
+                for (const auto& input : registry.at("inputs")) {
+                    signature += (signature.back() == '(' ? "" : ",") + canonicalType(input);
+                }
+                const auto selector = functionSelector(signature + ")");
+                functions[decode32BE(selector.data())] = registry;
+            }
+        } else {
+            throw invalid_argument("Invalid ABI");
+        }
+    } catch (const json::exception& error) {
+        throw invalid_argument(error.what());
+    }
+}
+
+optional<string> CallDecoder::decode(const Data& call) const {
+    if (call.size() <= 4) {
+        return {};
+    }
+    const auto it = functions.find(decode32BE(call.data()));
+    if (it == functions.end()) {
+        return {};
+    }
+    try {
+        return decodeFunction(call, it->second);
+    } catch (...) {
+        return {};
+    }
+}
+
 } // namespace TW::Ethereum::ABI
@@ -8,9 +8,38 @@
 
 #include "Data.h"
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace TW::Ethereum::ABI {
     std::optional<std::string> decodeCall(const Data& call, const nlohmann::json& abi);
+
+    /// Index of functions by selector, built once from ABI documents and reused to decode calls
+    /// without parsing the ABI again: decoding looks up the first 4 bytes of the call.
+    /// `decode` doesn't modify the index, and can be called concurrently.
+    class CallDecoder {
+    public:
+        /// Adds the functions of an ABI document, replacing functions of the same selector. The document is either
+        /// an object of function descriptions keyed by hex selector, like the ABI of `decodeCall`,
+        /// or a standard ABI array, whose function selectors are computed from their signatures.
+        ///
+        /// \throws std::invalid_argument if the document is malformed.
+        void add(const nlohmann::json& abi);
+
+        /// Number of indexed functions.
+        std::size_t size() const noexcept { return functions.size(); }
+
+        /// Decodes call data to the JSON of `decodeCall`; nothing if its selector is unknown or it is invalid.
+        std::optional<std::string> decode(const Data& call) const;
+
+    private:
+        std::unordered_map<uint32_t, nlohmann::json> functions;
+    };
 } // namespace TW::Ethereum::ABI
+
+/// Wrapper for C interface.
+struct TWEthereumAbiCallDecoder {
+    TW::Ethereum::ABI::CallDecoder impl;
+};
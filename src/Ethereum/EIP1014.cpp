@@ -26,4 +26,41 @@ Data create2Address(const std::string& from, const Data& salt, const Data& initC
     return Data(hash.end() - 20, hash.end());
 }
 
+std::vector<Address> create2Addresses(const Address& from, const std::vector<Data>& salts, const std::vector<Data>& initCodeHashes) {
+    if (initCodeHashes.size() != salts.size() && initCodeHashes.size() != 1) {
+        throw std::runtime_error("Error: expecting one initCodeHash per salt, or a single one.");
+    }
+    // 0xff || from || salt || initCodeHash, one after the other
+    constexpr size_t inputSize = 1 + Address::size + 32 + 32;
+    Data inputs(salts.size() * inputSize);
+    std::vector<const byte*> pointers;
+    pointers.reserve(salts.size());
+    for (size_t i = 0; i < salts.size(); ++i) {
+        const auto& initCodeHash = initCodeHashes.size() == 1 ? initCodeHashes.front() : initCodeHashes[i];
+        if (salts[i].size() != 32) {
+            throw std::runtime_error("Error: salt must be 32 bytes.");
+        }
+        if (initCodeHash.size() != 32) {
+            throw std::runtime_error("Error: initCodeHash must be 32 bytes.");
+        }
+        auto* input = inputs.data() + i * inputSize;
+        input[0] = 0xff;
+        std::copy(from.bytes.begin(), from.bytes.end(), input + 1);
+        std::copy(salts[i].begin(), salts[i].end(), input + 1 + Address::size);
+        std::copy(initCodeHash.begin(), initCodeHash.end(), input + 1 + Address::size + 32);
+        pointers.push_back(input);
+    }
+    const std::vector<size_t> sizes(salts.size(), inputSize);
+    Data hashes(salts.size() * std::tuple_size_v<Hash::Digest32>);
+    Hash::keccak256BatchInto(pointers.data(), sizes.data(), salts.size(), hashes.data());
+
+    std::vector<Address> addresses;
+    addresses.reserve(salts.size());
+    for (size_t i = 0; i < salts.size(); ++i) {
+        const auto hashEnd = hashes.begin() + static_cast<std::ptrdiff_t>((i + 1) * std::tuple_size_v<Hash::Digest32>);
+        addresses.emplace_back(Data(hashEnd - Address::size, hashEnd));
+    }
+    return addresses;
+}
+
 } // namespace TW::Ethereum
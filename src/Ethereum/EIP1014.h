@@ -6,10 +6,17 @@
 
 #pragma once
 
+#include "Address.h"
 #include "Data.h"
 
+#include <vector>
+
 namespace TW::Ethereum {
 
 Data create2Address(const std::string& from, const Data& salt, const Data& initCodeHash);
 
+/// Computes the CREATE2 addresses of many deployments by the deployer `from`, hashing them as a batch.
+/// `initCodeHashes` has one hash per salt, or a single hash shared by all the deployments.
+std::vector<Address> create2Addresses(const Address& from, const std::vector<Data>& salts, const std::vector<Data>& initCodeHashes);
+
 }
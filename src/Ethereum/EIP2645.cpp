@@ -19,6 +19,15 @@ static std::string getIntFromBits(const std::string& hexString, std::size_t from
     return std::to_string(std::stoll(sub, nullptr, 2));
 }
 
+/// Low 31 bits of the big-endian 64-bit value ending at `end`, shifted right by `shift` bits.
+static uint32_t getBits(const byte* end, std::size_t shift) {
+    uint64_t value = 0;
+    for (auto i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(*(end - 1 - i)) << (8 * i);
+    }
+    return static_cast<uint32_t>((value >> shift) & 0x7fffffff);
+}
+
 } // namespace TW::Ethereum::internal
 
 namespace TW::Ethereum {
@@ -35,4 +44,27 @@ std::string accountPathFromAddress(const std::string& ethAddress, const std::str
     return out.str();
 }
 
+static constexpr uint32_t eip2645Purpose = 2645;
+
+AccountPathBuilder::AccountPathBuilder(const std::string& layer, const std::string& application) {
+    using namespace internal;
+    const auto layerHash = Hash::sha256(data(layer));
+    const auto applicationHash = Hash::sha256(data(application));
+    layerComponent = getBits(layerHash.data() + layerHash.size(), 0);
+    applicationComponent = getBits(applicationHash.data() + applicationHash.size(), 0);
+}
+
+DerivationPath AccountPathBuilder::path(const Address& address, uint32_t index) const {
+    using namespace internal;
+    const auto* end = address.bytes.data() + address.bytes.size();
+    return DerivationPath({
+        DerivationPathIndex(eip2645Purpose, true),
+        DerivationPathIndex(layerComponent, true),
+        DerivationPathIndex(applicationComponent, true),
+        DerivationPathIndex(getBits(end, 0), true),
+        DerivationPathIndex(getBits(end, 31), true),
+        DerivationPathIndex(index, false),
+    });
+}
+
 } // namespace TW::Ethereum
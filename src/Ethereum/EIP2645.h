@@ -6,10 +6,32 @@
 
 #pragma once
 
+#include "Address.h"
+#include "DerivationPath.h"
+
+#include <cstdint>
 #include <string>
 
 namespace TW::Ethereum {
 
 std::string accountPathFromAddress(const std::string& ethAddress, const std::string& layer, const std::string& application, const std::string& index) noexcept;;
 
+/// EIP-2645 account paths of one layer and application, whose hashed components are computed once.
+/// Gives the same paths as `accountPathFromAddress`, as `DerivationPath` values.
+class AccountPathBuilder {
+public:
+    AccountPathBuilder(const std::string& layer, const std::string& application);
+
+    /// Returns the path "m/2645'/layer'/application'/address1'/address2'/index" of the account of `address`:
+    /// the low 31 bits of the layer and application hashes, and the low two groups of 31 bits of the address.
+    DerivationPath path(const Address& address, uint32_t index) const;
+
+    uint32_t layer() const { return layerComponent; }
+    uint32_t application() const { return applicationComponent; }
+
+private:
+    uint32_t layerComponent;
+    uint32_t applicationComponent;
+};
+
 } // namespace TW::Ethereum
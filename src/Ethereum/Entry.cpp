@@ -7,6 +7,7 @@
 #include "Entry.h"
 
 #include "Address.h"
+#include "AddressChecksum.h"
 #include "Signer.h"
 
 #include "proto/TransactionCompiler.pb.h"
@@ -28,6 +29,17 @@ std::string Entry::deriveAddress([[maybe_unused]] TWCoinType coin, const PublicK
     return Address(publicKey).string();
 }
 
+std::vector<std::string> Entry::deriveAddresses([[maybe_unused]] TWCoinType coin, const std::vector<PublicKey>& publicKeys, [[maybe_unused]] TWDerivation derivation, [[maybe_unused]] const PrefixVariant& addressPrefix) const {
+    // keys and checksums are hashed together
+    const auto checksumed = checksumBatch(Address::fromPublicKeys(publicKeys));
+    std::vector<std::string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (std::size_t i = 0; i < publicKeys.size(); ++i) {
+        addresses.push_back(checksumed.substr(i * checksumedSize, checksumedSize));
+    }
+    return addresses;
+}
+
 Data Entry::addressToData([[maybe_unused]] TWCoinType coin, const std::string& address) const {
     const auto addr = Address(address);
     return {addr.bytes.begin(), addr.bytes.end()};
@@ -17,6 +17,7 @@ public:
     bool validateAddress(TWCoinType coin, const std::string& address, const PrefixVariant& addressPrefix) const final;
      std::string normalizeAddress(TWCoinType coin, const std::string& address) const final;
      std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation, const PrefixVariant& addressPrefix) const final;
+     std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation, const PrefixVariant& addressPrefix) const final;
      Data addressToData(TWCoinType coin, const std::string& address) const final;
      void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const override;
      bool supportsJSONSigning() const final { return true; }
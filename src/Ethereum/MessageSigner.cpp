@@ -6,9 +6,9 @@
 
 #include "HexCoding.h"
 #include "MessageSigner.h"
+#include "algorithm/parallel.h"
 #include <Ethereum/ABI/ParamStruct.h>
 #include <nlohmann/json.hpp>
-#include <sstream>
 
 namespace TW::Ethereum::internal {
 
@@ -28,16 +28,31 @@ std::string commonSign(const PrivateKey& privateKey, const Data& signableMessage
     return hex(data);
 }
 
+/// Signs each of the hashes, on `threads` workers.
+std::vector<std::string> commonSignBatch(const PrivateKey& privateKey, const std::vector<Data>& signableMessages, MessageType msgType, TW::Ethereum::MessageSigner::MaybeChainId chainId, std::size_t threads) {
+    std::vector<std::string> signatures(signableMessages.size());
+    parallelFor(signableMessages.size(), threads, [&](std::size_t i) {
+        signatures[i] = commonSign(privateKey, signableMessages[i], msgType, chainId);
+    });
+    return signatures;
+}
+
+void checkDomainChainId(const ABI::TypedDataDomain& domain, MessageType msgType, TW::Ethereum::MessageSigner::MaybeChainId chainId) {
+    if (msgType == MessageType::Eip155 && domain.chainId().has_value() && *domain.chainId() != chainId.value_or(0)) {
+        throw std::invalid_argument("EIP712 chainId is different than the current chainID.");
+    }
+}
+
 } // namespace TW::Ethereum::internal
 
 namespace TW::Ethereum {
 
 Data MessageSigner::generateMessage(const std::string& message) {
-    std::string prefix(1, MessageSigner::EthereumPrefix);
-    std::stringstream ss;
-    ss << prefix << MessageSigner::MessagePrefix << std::to_string(message.size()) << message;
-    Data signableMessage = Hash::keccak256(data(ss.str()));
-    return signableMessage;
+    // keccak256 of 0x19, the prefix, the decimal message length and the message, hashed as it is written
+    const auto prefix = std::string(1, static_cast<char>(MessageSigner::EthereumPrefix)) + MessageSigner::MessagePrefix + std::to_string(message.size());
+    auto hasher = Hash::StreamHasher(Hash::HasherKeccak256);
+    hasher.update(prefix).update(message);
+    return hasher.finalize();
 }
 
 std::string MessageSigner::signMessage(const PrivateKey& privateKey, const std::string& message, MessageType msgType, MaybeChainId chainId) {
@@ -58,6 +73,24 @@ std::string MessageSigner::signTypedData(const PrivateKey& privateKey, const std
     return internal::commonSign(privateKey, signableMessage, msgType, chainId);
 }
 
+std::vector<std::string> MessageSigner::signMessageBatch(const PrivateKey& privateKey, std::span<const std::string> messages, MessageType msgType, MaybeChainId chainId, std::size_t threads) {
+    std::vector<Data> signableMessages(messages.size());
+    parallelFor(messages.size(), threads, [&](std::size_t i) {
+        signableMessages[i] = generateMessage(messages[i]);
+    });
+    return internal::commonSignBatch(privateKey, signableMessages, msgType, chainId, threads);
+}
+
+std::vector<std::string> MessageSigner::signTypedDataBatch(const PrivateKey& privateKey, const ABI::TypedDataDomain& domain, std::span<const std::string> messages, MessageType msgType, MaybeChainId chainId, std::size_t threads) {
+    internal::checkDomainChainId(domain, msgType, chainId);
+    return internal::commonSignBatch(privateKey, domain.hashMessagesJson(messages, threads), msgType, chainId, threads);
+}
+
+std::vector<std::string> MessageSigner::signTypedDataEncodedBatch(const PrivateKey& privateKey, const ABI::TypedDataDomain& domain, std::span<const Data> encodedMessages, MessageType msgType, MaybeChainId chainId, std::size_t threads) {
+    internal::checkDomainChainId(domain, msgType, chainId);
+    return internal::commonSignBatch(privateKey, domain.hashMessagesEncoded(encodedMessages), msgType, chainId, threads);
+}
+
 bool MessageSigner::verifyMessage(const PublicKey& publicKey, const std::string& message, const std::string& signature) noexcept {
     Data msg = generateMessage(message);
     //! If it's json && EIP712Domain then we hash the struct
@@ -72,4 +105,21 @@ bool MessageSigner::verifyMessage(const PublicKey& publicKey, const std::string&
     return recovered == publicKey && publicKey.verify(rawSignature, msg);
 }
 
+std::vector<std::optional<Address>> MessageSigner::recoverAddresses(std::span<const Data> signatures, std::span<const Data> digests, std::size_t threads) {
+    Data keys(signatures.size() * PublicKey::secp256k1ExtendedSize);
+    const auto valid = PublicKey::recoverBatch(signatures, digests, keys.data(), threads);
+
+    std::vector<std::optional<Address>> addresses(signatures.size());
+    for (std::size_t i = 0; i < signatures.size(); ++i) {
+        if (!valid[i]) {
+            continue;
+        }
+        // Address is the last 20 bytes of the Keccak-256 hash of the key without its 0x04 prefix.
+        const auto* key = keys.data() + i * PublicKey::secp256k1ExtendedSize;
+        const auto hash = Hash::keccak256Into(key + 1, PublicKey::secp256k1ExtendedSize - 1);
+        addresses[i].emplace(Data(hash.end() - Address::size, hash.end()));
+    }
+    return addresses;
+}
+
 } // namespace TW::Ethereum
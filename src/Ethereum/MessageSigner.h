@@ -6,9 +6,14 @@
 
 #pragma once
 
+#include "Address.h"
+#include "ABI/ParamStruct.h"
+
 #include <PrivateKey.h>
+#include <span>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace TW::Ethereum {
 
@@ -37,12 +42,37 @@ public:
     /// \return hex signed message
     static std::string signTypedData(const PrivateKey& privateKey, const std::string& data, MessageType msgType, MaybeChainId chainId = std::nullopt);
 
+    /// Sign many messages following EIP-191 with the same key
+    /// \param threads number of worker threads, 0 uses the hardware concurrency
+    /// \return hex signed messages, in order, as signMessage
+    static std::vector<std::string> signMessageBatch(const PrivateKey& privateKey, std::span<const std::string> messages, MessageType msgType, MaybeChainId chainId = std::nullopt, std::size_t threads = 0);
+
+    /// Sign many typed messages of the same EIP-712 domain and primary type with the same key, e.g. off-chain orders
+    /// \param domain the prepared domain
+    /// \param messages the messages of the primary type, as Json objects
+    /// \param threads number of worker threads, 0 uses the hardware concurrency
+    /// \return hex signed messages, in order, as signTypedData of the typed data with each message
+    /// Throws on invalid messages, or if msgType is eip155 and the domain chainId is different
+    static std::vector<std::string> signTypedDataBatch(const PrivateKey& privateKey, const ABI::TypedDataDomain& domain, std::span<const std::string> messages, MessageType msgType, MaybeChainId chainId = std::nullopt, std::size_t threads = 0);
+
+    /// Sign many typed messages given as their EIP-712 encodeData (32 bytes per member), see `ABI::TypedDataDomain::hashMessageEncoded`
+    /// Throws on invalid messages, or if msgType is eip155 and the domain chainId is different
+    static std::vector<std::string> signTypedDataEncodedBatch(const PrivateKey& privateKey, const ABI::TypedDataDomain& domain, std::span<const Data> encodedMessages, MessageType msgType, MaybeChainId chainId = std::nullopt, std::size_t threads = 0);
+
     /// Verify a message following EIP-191
     /// \param publicKey publickey to verify the signed message
     /// \param message message to be verified as a string
     /// \param signature signature to verify the message against
     /// \return true if the message match the signature, false otherwise
     static bool verifyMessage(const PublicKey& publicKey, const std::string& message, const std::string& signature) noexcept;
+
+    /// Recovers the signer addresses of many signed hashes at once, e.g. EIP-191 or EIP-712 message hashes
+    /// or transaction signing hashes, without creating intermediate public keys
+    /// \param signatures 65-byte signatures (R, S, V)
+    /// \param digests the signed 32-byte hashes, one per signature
+    /// \param threads number of worker threads, 0 uses the hardware concurrency
+    /// \return the signer address of every signature, or nullopt if none can be recovered
+    static std::vector<std::optional<Address>> recoverAddresses(std::span<const Data> signatures, std::span<const Data> digests, std::size_t threads = 0);
     static constexpr auto MessagePrefix = "Ethereum Signed Message:\n";
     static constexpr std::uint8_t EthereumPrefix{0x19};
     static Data generateMessage(const std::string& message);
@@ -9,39 +9,125 @@
 #include "../BinaryCoding.h"
 #include "../Numeric.h"
 
+#include <limits>
+#include <stdexcept>
 #include <tuple>
 
 namespace TW::Ethereum {
 
-Data RLP::encode(const uint256_t& value) noexcept {
-    using boost::multiprecision::cpp_int;
-
-    Data bytes;
-    export_bits(value, std::back_inserter(bytes), 8);
-
-    if (bytes.empty() || (bytes.size() == 1 && bytes[0] == 0)) {
-        return {0x80};
+/// Number of bytes of the big endian representation of a non-zero value.
+static std::size_t byteLength(uint64_t value) noexcept {
+    std::size_t length = 0;
+    for (; value != 0; value >>= 8) {
+        ++length;
     }
+    return length;
+}
 
-    return encode(bytes);
+static std::size_t headerSize(uint64_t size) noexcept {
+    return size < 56 ? 1 : 1 + byteLength(size);
 }
 
-Data RLP::encodeList(const Data& encoded) noexcept {
-    auto result = encodeHeader(encoded.size(), 0xc0, 0xf7);
-    result.reserve(result.size() + encoded.size());
-    result.insert(result.end(), encoded.begin(), encoded.end());
-    return result;
+RLP::Writer::Writer(Writer&& measure)
+    : measuring(false), size(measure.size), listSizes(std::move(measure.listSizes)) {
+    assert(measure.openLists.empty());
+    buffer.reserve(size);
 }
 
-Data RLP::encode(const Data& data) noexcept {
+void RLP::Writer::append(const FixedUint256& number) {
+    if (number <= FixedUint256(0x7f)) {
+        // Zero is the empty string, other values up to 0x7f fit in a single byte without header
+        appendByte(number.isZero() ? 0x80 : number.byteAt(0));
+        return;
+    }
+    const auto length = number.byteLength();
+    if (measuring) {
+        size += 1 + length;
+        return;
+    }
+    buffer.push_back(static_cast<uint8_t>(0x80 + length));
+    for (auto i = length; i > 0; --i) {
+        buffer.push_back(number.byteAt(i - 1));
+    }
+}
+
+void RLP::Writer::append(std::span<const uint8_t> data) {
     if (data.size() == 1 && data[0] <= 0x7f) {
         // Fits in single byte, no header
-        return data;
+        appendByte(data[0]);
+        return;
+    }
+    if (measuring) {
+        size += headerSize(data.size()) + data.size();
+        return;
+    }
+    writeHeader(data.size(), 0x80, 0xb7);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+}
+
+void RLP::Writer::appendByte(uint8_t byte) {
+    if (measuring) {
+        size += 1;
+        return;
+    }
+    buffer.push_back(byte);
+}
+
+void RLP::Writer::appendEncoded(std::span<const uint8_t> encoded) {
+    if (measuring) {
+        size += encoded.size();
+        return;
+    }
+    buffer.insert(buffer.end(), encoded.begin(), encoded.end());
+}
+
+void RLP::Writer::beginList() {
+    if (measuring) {
+        openLists.emplace_back(listSizes.size(), size);
+        listSizes.push_back(0);
+        return;
+    }
+    assert(nextList < listSizes.size());
+    writeHeader(listSizes[nextList++], 0xc0, 0xf7);
+}
+
+void RLP::Writer::endList() {
+    if (!measuring) {
+        return;
+    }
+    assert(!openLists.empty());
+    const auto [index, start] = openLists.back();
+    openLists.pop_back();
+    listSizes[index] = size - start;
+    size += headerSize(listSizes[index]);
+}
+
+void RLP::Writer::writeHeader(uint64_t length, uint8_t smallTag, uint8_t largeTag) {
+    if (length < 56) {
+        buffer.push_back(static_cast<uint8_t>(smallTag + length));
+        return;
+    }
+    const auto sizeLength = byteLength(length);
+    buffer.push_back(static_cast<uint8_t>(largeTag + sizeLength));
+    for (auto i = sizeLength; i > 0; --i) {
+        buffer.push_back(static_cast<uint8_t>(length >> (8 * (i - 1))));
     }
+}
+
+Data RLP::encode(const FixedUint256& value) noexcept {
+    return encodeWith([&value](Writer& writer) { writer.append(value); });
+}
+
+Data RLP::encodeList(const Data& encoded) noexcept {
+    return encodeWith([&encoded](Writer& writer) {
+        writer.beginList();
+        writer.appendEncoded(encoded);
+        writer.endList();
+    });
+}
 
-    auto encoded = encodeHeader(data.size(), 0x80, 0xb7);
-    encoded.insert(encoded.end(), data.begin(), data.end());
-    return encoded;
+Data RLP::encode(const Data& data) noexcept {
+    return encodeWith([&data](Writer& writer) { writer.append(data); });
 }
 
 Data RLP::encodeHeader(uint64_t size, uint8_t smallTag, uint8_t largeTag) noexcept {
@@ -198,4 +284,153 @@ RLP::DecodedItem RLP::decode(const Data& input) {
     return item;
 }
 
+/// Parses the length of a long string or list, in the `lengthSize` bytes after the prefix of `input`.
+static std::size_t parseLongLength(std::span<const uint8_t> input, std::size_t lengthSize) {
+    if (input.size() < 1 + lengthSize) {
+        throw std::invalid_argument("Not enough data for rlp length");
+    }
+    if (input[1] == 0) {
+        throw std::invalid_argument("multi-byte length must have no leading zero");
+    }
+    uint64_t length = 0;
+    for (std::size_t i = 1; i <= lengthSize; ++i) {
+        length = (length << 8) | input[i];
+    }
+    if (length < 56) {
+        throw std::invalid_argument("length below 56 must be encoded in one byte");
+    }
+    if (length > std::numeric_limits<std::size_t>::max()) {
+        throw std::invalid_argument("rlp length overflow");
+    }
+    return static_cast<std::size_t>(length);
+}
+
+RLP::ItemView RLP::decodeItem(std::span<const uint8_t> input, std::span<const uint8_t>& remainder) {
+    if (input.empty()) {
+        throw std::invalid_argument("can't decode empty rlp data");
+    }
+    ItemView item;
+    const auto prefix = input[0];
+    if (prefix <= 0x7f) {
+        // a single byte is its own encoding
+        item.itemPayload = input.first(1);
+        item.itemEncoded = item.itemPayload;
+        remainder = input.subspan(1);
+        return item;
+    }
+
+    std::size_t headerSize = 1;
+    std::size_t length = 0;
+    if (prefix <= 0xb7) {
+        length = prefix - 0x80;
+    } else if (prefix <= 0xbf) {
+        headerSize += prefix - 0xb7;
+        length = parseLongLength(input, prefix - 0xb7);
+    } else if (prefix <= 0xf7) {
+        item.list = true;
+        length = prefix - 0xc0;
+    } else {
+        item.list = true;
+        headerSize += prefix - 0xf7;
+        length = parseLongLength(input, prefix - 0xf7);
+    }
+    if (input.size() < headerSize || input.size() - headerSize < length) {
+        throw std::invalid_argument(std::string("Invalid rlp length, length ") + std::to_string(length));
+    }
+    item.itemPayload = input.subspan(headerSize, length);
+    item.itemEncoded = input.first(headerSize + length);
+    if (!item.list && length == 1 && item.itemPayload[0] <= 0x7f) {
+        throw std::invalid_argument("single byte below 128 must be encoded as itself");
+    }
+    remainder = input.subspan(headerSize + length);
+    return item;
+}
+
+RLP::ItemView RLP::decodeView(std::span<const uint8_t> input) {
+    std::span<const uint8_t> remainder;
+    const auto root = decodeItem(input, remainder);
+    if (!remainder.empty()) {
+        throw std::invalid_argument("Trailing data after rlp item");
+    }
+    // check the nested items depth first, without recursion
+    std::vector<std::span<const uint8_t>> pending;
+    if (root.isList()) {
+        pending.push_back(root.payload());
+    }
+    while (!pending.empty()) {
+        auto payload = pending.back();
+        pending.pop_back();
+        while (!payload.empty()) {
+            const auto item = decodeItem(payload, payload);
+            if (item.isList() && !item.payload().empty()) {
+                pending.push_back(item.payload());
+            }
+        }
+    }
+    return root;
+}
+
+Data RLP::ItemView::data() const {
+    if (list) {
+        throw std::invalid_argument("rlp item is a list");
+    }
+    return Data(itemPayload.begin(), itemPayload.end());
+}
+
+FixedUint256 RLP::ItemView::toUint() const {
+    if (list) {
+        throw std::invalid_argument("rlp item is a list");
+    }
+    if (itemPayload.size() > 32) {
+        throw std::invalid_argument("rlp integer longer than 32 bytes");
+    }
+    if (!itemPayload.empty() && itemPayload[0] == 0) {
+        throw std::invalid_argument("rlp integer must have no leading zero");
+    }
+    return FixedUint256::loadBE(itemPayload);
+}
+
+RLP::ItemView::Iterator RLP::ItemView::begin() const {
+    if (!list) {
+        throw std::invalid_argument("rlp item is not a list");
+    }
+    return Iterator(itemPayload);
+}
+
+RLP::ItemView::Iterator RLP::ItemView::end() const {
+    if (!list) {
+        throw std::invalid_argument("rlp item is not a list");
+    }
+    return Iterator(itemPayload.subspan(itemPayload.size()));
+}
+
+std::size_t RLP::ItemView::size() const {
+    std::size_t count = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        ++count;
+    }
+    return count;
+}
+
+RLP::ItemView RLP::ItemView::operator[](std::size_t index) const {
+    auto it = begin();
+    for (std::size_t i = 0; i < index && it != end(); ++i) {
+        ++it;
+    }
+    if (it == end()) {
+        throw std::out_of_range("rlp list index out of range");
+    }
+    return *it;
+}
+
+RLP::ItemView RLP::ItemView::Iterator::operator*() const {
+    std::span<const uint8_t> next;
+    return decodeItem(rest, next);
+}
+
+RLP::ItemView::Iterator& RLP::ItemView::Iterator::operator++() {
+    decodeItem(rest, rest);
+    return *this;
+}
+
 } // namespace TW::Ethereum
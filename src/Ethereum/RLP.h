@@ -10,8 +10,11 @@
 #include "Data.h"
 #include "../uint256.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TW::Ethereum {
@@ -20,14 +23,67 @@ namespace TW::Ethereum {
 ///
 /// - SeeAlso: https://github.com/ethereum/wiki/wiki/RLP
 struct RLP {
+    /// Two-pass RLP writer.
+    ///
+    /// The same sequence of calls is made twice (see `encodeWith`): the first pass only measures the items and
+    /// the list payloads, the second one writes everything into a buffer reserved once, without intermediate copies.
+    class Writer {
+    public:
+        /// Appends an integer.
+        void append(const FixedUint256& number);
+        void append(const uint256_t& number) { append(toFixed(number)); }
+
+        /// Appends a byte string.
+        void append(std::span<const uint8_t> data);
+        void append(const Data& data) { append(std::span<const uint8_t>(data)); }
+
+        /// Appends bytes as is, e.g. an already encoded item.
+        void appendEncoded(std::span<const uint8_t> encoded);
+
+        /// Starts a list; items appended until the matching `endList` are its elements.
+        void beginList();
+        void endList();
+
+    private:
+        friend struct RLP;
+
+        Writer() = default;
+        /// Writing pass, with the sizes measured by `measure`.
+        explicit Writer(Writer&& measure);
+
+        void appendByte(uint8_t byte);
+        void writeHeader(uint64_t size, uint8_t smallTag, uint8_t largeTag);
+
+        bool measuring = true;
+        /// Total size, measured in the first pass.
+        std::size_t size = 0;
+        /// Payload sizes of the lists, in the order of their `beginList`.
+        std::vector<std::size_t> listSizes;
+        /// Open lists in the first pass: index in `listSizes` and size before the list.
+        std::vector<std::pair<std::size_t, std::size_t>> openLists;
+        /// Next list to write in the second pass.
+        std::size_t nextList = 0;
+        Data buffer;
+    };
+
+    /// Encodes with a two-pass `Writer`; `write` is called twice with the same sequence of writer calls.
+    template <typename Write>
+    static Data encodeWith(Write&& write) {
+        Writer measure;
+        write(measure);
+        Writer writer(std::move(measure));
+        write(writer);
+        return std::move(writer.buffer);
+    }
+
     /// Encodes a string;
     static Data encode(const std::string& string) noexcept {
         return encode(Data(string.begin(), string.end()));
     }
 
-    static Data encode(uint8_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint8_t number) noexcept { return encode(FixedUint256(number)); }
 
-    static Data encode(uint16_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint16_t number) noexcept { return encode(FixedUint256(number)); }
 
     static Data encode(int32_t number) noexcept {
         if (number < 0) {
@@ -36,7 +92,7 @@ struct RLP {
         return encode(static_cast<uint32_t>(number));
     }
 
-    static Data encode(uint32_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint32_t number) noexcept { return encode(FixedUint256(number)); }
 
     static Data encode(int64_t number) noexcept {
         if (number < 0) {
@@ -45,9 +101,10 @@ struct RLP {
         return encode(static_cast<uint64_t>(number));
     }
 
-    static Data encode(uint64_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint64_t number) noexcept { return encode(FixedUint256(number)); }
 
-    static Data encode(const uint256_t& number) noexcept;
+    static Data encode(const FixedUint256& number) noexcept;
+    static Data encode(const uint256_t& number) noexcept { return encode(toFixed(number)); }
 
     /// Wraps encoded data as a list.
     static Data encodeList(const Data& encoded) noexcept;
@@ -93,6 +150,79 @@ struct RLP {
         Data remainder;
     };
 
+    /// An item of an RLP encoding, viewed in place: its spans point into the encoded buffer, which must outlive
+    /// the view. The items of a list are decoded lazily, while iterating.
+    class ItemView {
+    public:
+        /// Iterates the items of a list.
+        class Iterator {
+        public:
+            using value_type = ItemView;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            ItemView operator*() const;
+            Iterator& operator++();
+            Iterator operator++(int) {
+                auto previous = *this;
+                ++*this;
+                return previous;
+            }
+            bool operator==(const Iterator& other) const { return rest.data() == other.rest.data(); }
+
+        private:
+            friend class ItemView;
+            explicit Iterator(std::span<const uint8_t> rest) : rest(rest) {}
+
+            /// Encoding of the current item and the ones after it in the list.
+            std::span<const uint8_t> rest;
+        };
+
+        ItemView() = default;
+
+        bool isList() const { return list; }
+
+        /// Bytes of a string, or the encoded items of a list.
+        std::span<const uint8_t> payload() const { return itemPayload; }
+
+        /// The whole encoded item, header included.
+        std::span<const uint8_t> encoded() const { return itemEncoded; }
+
+        /// Copy of the bytes of a string. Throws std::invalid_argument for a list.
+        Data data() const;
+
+        /// Value of a string encoding an integer. Throws std::invalid_argument for a list, a string longer than
+        /// 32 bytes or with a leading zero.
+        FixedUint256 toUint() const;
+
+        /// Items of a list. Throws std::invalid_argument for a string.
+        Iterator begin() const;
+        Iterator end() const;
+
+        /// Number of items of a list, walking it.
+        std::size_t size() const;
+
+        /// Item `index` of a list, walking to it. Throws std::out_of_range if the list is shorter.
+        ItemView operator[](std::size_t index) const;
+
+    private:
+        friend struct RLP;
+
+        bool list = false;
+        std::span<const uint8_t> itemPayload;
+        std::span<const uint8_t> itemEncoded;
+    };
+
+    /// Decodes the first item of `input`, and sets `remainder` to the bytes after it (`remainder` may be `input`).
+    /// Checks that the header is canonical and the item fits in `input`, not its nested items.
+    /// Throws std::invalid_argument if it is invalid.
+    static ItemView decodeItem(std::span<const uint8_t> input, std::span<const uint8_t>& remainder);
+
+    /// Decodes `input` as exactly one item without copying it, checking the canonical encoding of all nested items
+    /// in one pass. Throws std::invalid_argument if the encoding is invalid or not canonical.
+    static ItemView decodeView(std::span<const uint8_t> input);
+
     static DecodedItem decodeList(const Data& input);
     /// Decodes data, remainder from RLP encoded data
     static DecodedItem decode(const Data& data);
@@ -7,8 +7,10 @@
 #include "Signer.h"
 #include "HexCoding.h"
 #include "Coin.h"
+#include "SigningContext.h"
+#include "algorithm/parallel.h"
+#include "../proto/Ethereum.json.pb.h"
 #include <TrustWalletCore/TWCoinType.h>
-#include <google/protobuf/util/json_util.h>
 
 namespace TW::Ethereum {
 
@@ -45,7 +47,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return hex(output.encoded());
@@ -391,4 +393,19 @@ Signature Signer::sign(const PrivateKey& privateKey, const uint256_t& chainID, s
     return Signer::sign(privateKey, preHash, transaction->usesReplayProtection(), chainID);
 }
 
+std::vector<Signature> Signer::signUserOperations(const PrivateKey& privateKey, const uint256_t& chainID, const std::vector<std::shared_ptr<UserOperation>>& operations, std::size_t threads) {
+    if (operations.empty()) {
+        return {};
+    }
+    const auto hasher = UserOperationHasher(operations.front()->entryPoint, chainID);
+    const auto context = SigningContext(privateKey, TWCurveSECP256k1);
+    std::vector<Signature> signatures(operations.size());
+    parallelFor(operations.size(), threads, [&](std::size_t i) {
+        const auto preHash = hasher.preHash(*operations[i]);
+        // UserOperations are signed without replay protection, see `UserOperation::usesReplayProtection`
+        signatures[i] = signatureDataToStruct(context.sign(preHash), false, chainID);
+    });
+    return signatures;
+}
+
 } // namespace TW::Ethereum
@@ -34,6 +34,11 @@ class Signer {
 
     /// Signs the given transaction.
     static Signature sign(const PrivateKey& privateKey, const uint256_t& chainID, std::shared_ptr<TransactionBase> transaction) noexcept;
+    /// Signs UserOperations of the same entry point, with one shared hasher and signing context,
+    /// on `threads` worker threads (see `parallelFor`).
+    /// Same signatures as `sign(privateKey, chainID, operation)` for each operation, in order.
+    /// Throws std::invalid_argument if the operations have different entry points, or the private key is invalid.
+    static std::vector<Signature> signUserOperations(const PrivateKey& privateKey, const uint256_t& chainID, const std::vector<std::shared_ptr<UserOperation>>& operations, std::size_t threads = 1);
     /// Compiles a Proto::SigningInput transaction, with external signature
     static Proto::SigningOutput compile(const Proto::SigningInput& input, const Data& signature) noexcept;
 
@@ -6,7 +6,9 @@
 
 #include "Transaction.h"
 #include "Ethereum/ABI.h"
+#include "Ethereum/ABI/FunctionCache.h"
 #include "HexCoding.h"
+#include "algorithm/parallel.h"
 #include "RLP.h"
 #include "Signer.h"
 #include <Ethereum/ERC4337.h>
@@ -22,6 +24,29 @@ using UserOperationPtr = std::shared_ptr<UserOperation>;
 
 static const Data EmptyListEncoded = parse_hex("c0");
 
+/// Fields common to the signing pre-image and the signed encoding.
+static void writeFields(RLP::Writer& writer, const TransactionNonTyped& transaction) {
+    writer.append(transaction.nonce);
+    writer.append(transaction.gasPrice);
+    writer.append(transaction.gasLimit);
+    writer.append(transaction.to);
+    writer.append(transaction.amount);
+    writer.append(transaction.payload);
+}
+
+/// Fields common to the signing pre-image and the signed encoding.
+static void writeFields(RLP::Writer& writer, const TransactionEip1559& transaction, const uint256_t& chainID) {
+    writer.append(chainID);
+    writer.append(transaction.nonce);
+    writer.append(transaction.maxInclusionFeePerGas);
+    writer.append(transaction.maxFeePerGas);
+    writer.append(transaction.gasLimit);
+    writer.append(transaction.to);
+    writer.append(transaction.amount);
+    writer.append(transaction.payload);
+    writer.appendEncoded(EmptyListEncoded); // empty accessList
+}
+
 /// TransactionNonTyped
 std::shared_ptr<TransactionNonTyped>
 TransactionNonTyped::buildNativeTransfer(const uint256_t& nonce,
@@ -63,68 +88,40 @@ Data TransactionNonTyped::preHash(const uint256_t chainID) const {
 }
 
 Data TransactionNonTyped::serialize(const uint256_t chainID) const {
-    Data encoded;
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(gasPrice));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to));
-    append(encoded, RLP::encode(amount));
-    append(encoded, RLP::encode(payload));
-    append(encoded, RLP::encode(chainID));
-    append(encoded, RLP::encode(0));
-    append(encoded, RLP::encode(0));
-    return RLP::encodeList(encoded);
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writeFields(writer, *this);
+        writer.append(chainID);
+        writer.append(0);
+        writer.append(0);
+        writer.endList();
+    });
 }
 
 Data TransactionNonTyped::encoded(const Signature& signature, [[maybe_unused]] const uint256_t chainID) const {
-    Data encoded;
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(gasPrice));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to));
-    append(encoded, RLP::encode(amount));
-    append(encoded, RLP::encode(payload));
-    append(encoded, RLP::encode(signature.v));
-    append(encoded, RLP::encode(signature.r));
-    append(encoded, RLP::encode(signature.s));
-    return RLP::encodeList(encoded);
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writeFields(writer, *this);
+        writer.append(signature.v);
+        writer.append(signature.r);
+        writer.append(signature.s);
+        writer.endList();
+    });
 }
 
 Data TransactionNonTyped::buildERC20TransferCall(const Data& to, const uint256_t& amount) {
-    // clang-format off
-    auto func = ABI::Function("transfer", ParamCollection{
-        std::make_shared<ABI::ParamAddress>(to),
-        std::make_shared<ABI::ParamUInt256>(amount)
-    });
-    // clang-format on
-    Data payload;
-    func.encode(payload);
-    return payload;
+    static const auto& func = ABI::StaticFunction::get("transfer(address,uint256)");
+    return func.encode({to, amount});
 }
 
 Data TransactionNonTyped::buildERC20ApproveCall(const Data& spender, const uint256_t& amount) {
-    // clang-format off
-    auto func = ABI::Function("approve", ParamCollection{
-        std::make_shared<ABI::ParamAddress>(spender),
-        std::make_shared<ABI::ParamUInt256>(amount)
-    });
-    // clang-format on
-    Data payload;
-    func.encode(payload);
-    return payload;
+    static const auto& func = ABI::StaticFunction::get("approve(address,uint256)");
+    return func.encode({spender, amount});
 }
 
 Data TransactionNonTyped::buildERC721TransferFromCall(const Data& from, const Data& to, const uint256_t& tokenId) {
-    // clang-format off
-    auto func = ABI::Function("transferFrom", ParamCollection{
-        std::make_shared<ABI::ParamAddress>(from),
-        std::make_shared<ABI::ParamAddress>(to),
-        std::make_shared<ABI::ParamUInt256>(tokenId)
-    });
-    // clang-format on
-    Data payload;
-    func.encode(payload);
-    return payload;
+    static const auto& func = ABI::StaticFunction::get("transferFrom(address,address,uint256)");
+    return func.encode({from, to, tokenId});
 }
 
 Data TransactionNonTyped::buildERC1155TransferFromCall(const Data& from, const Data& to, const uint256_t& tokenId, const uint256_t& value, const Data& data) {
@@ -148,42 +145,26 @@ Data TransactionEip1559::preHash(const uint256_t chainID) const {
 }
 
 Data TransactionEip1559::serialize(const uint256_t chainID) const {
-    Data encoded;
-    append(encoded, RLP::encode(chainID));
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(maxInclusionFeePerGas));
-    append(encoded, RLP::encode(maxFeePerGas));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to));
-    append(encoded, RLP::encode(amount));
-    append(encoded, RLP::encode(payload));
-    append(encoded, EmptyListEncoded); // empty accessList
-
-    Data envelope;
-    append(envelope, static_cast<uint8_t>(type));
-    append(envelope, RLP::encodeList(encoded));
-    return envelope;
+    const auto typePrefix = static_cast<uint8_t>(type);
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.appendEncoded(std::span<const uint8_t>(&typePrefix, 1));
+        writer.beginList();
+        writeFields(writer, *this, chainID);
+        writer.endList();
+    });
 }
 
 Data TransactionEip1559::encoded(const Signature& signature, const uint256_t chainID) const {
-    Data encoded;
-    append(encoded, RLP::encode(chainID));
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(maxInclusionFeePerGas));
-    append(encoded, RLP::encode(maxFeePerGas));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to));
-    append(encoded, RLP::encode(amount));
-    append(encoded, RLP::encode(payload));
-    append(encoded, EmptyListEncoded); // empty accessList
-    append(encoded, RLP::encode(signature.v));
-    append(encoded, RLP::encode(signature.r));
-    append(encoded, RLP::encode(signature.s));
-
-    Data envelope;
-    append(envelope, static_cast<uint8_t>(type));
-    append(envelope, RLP::encodeList(encoded));
-    return envelope;
+    const auto typePrefix = static_cast<uint8_t>(type);
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.appendEncoded(std::span<const uint8_t>(&typePrefix, 1));
+        writer.beginList();
+        writeFields(writer, *this, chainID);
+        writer.append(signature.v);
+        writer.append(signature.r);
+        writer.append(signature.s);
+        writer.endList();
+    });
 }
 
 std::shared_ptr<TransactionEip1559>
@@ -223,33 +204,11 @@ TransactionEip1559::buildERC1155Transfer(const uint256_t& nonce,
 
 /// UserOperation
 Data UserOperation::preHash(const uint256_t chainID) const {
-    auto params = ABI::ParamTuple(ParamCollection{
-        std::make_shared<ABI::ParamByteArrayFix>(32, Hash::keccak256(serialize(chainID))),
-        std::make_shared<ABI::ParamAddress>(entryPoint),
-        std::make_shared<ABI::ParamUInt256>(chainID)});
-    Data encoded;
-    params.encode(encoded);
-    const auto hash = Hash::keccak256(encoded);
-    const auto hashStr = std::string(hash.begin(), hash.end());
-    return MessageSigner::generateMessage(hashStr);
+    return UserOperationHasher(entryPoint, chainID).preHash(*this);
 }
 
 Data UserOperation::serialize([[maybe_unused]] const uint256_t chainID) const {
-    auto params = ABI::ParamTuple(ParamCollection{
-        std::make_shared<ABI::ParamAddress>(sender),
-        std::make_shared<ABI::ParamUInt256>(nonce),
-        std::make_shared<ABI::ParamByteArrayFix>(32, Hash::keccak256(initCode)),
-        std::make_shared<ABI::ParamByteArrayFix>(32, Hash::keccak256(payload)),
-        std::make_shared<ABI::ParamUInt256>(gasLimit),
-        std::make_shared<ABI::ParamUInt256>(verificationGasLimit),
-        std::make_shared<ABI::ParamUInt256>(preVerificationGas),
-        std::make_shared<ABI::ParamUInt256>(maxFeePerGas),
-        std::make_shared<ABI::ParamUInt256>(maxInclusionFeePerGas),
-        std::make_shared<ABI::ParamByteArrayFix>(32, Hash::keccak256(paymasterAndData))});
-    Data serialized;
-    params.encode(serialized);
-
-    return serialized;
+    return UserOperationHasher::serialize(*this);
 }
 
 Data UserOperation::encoded(const Signature& signature, [[maybe_unused]] const uint256_t chainID) const {
@@ -367,4 +326,54 @@ UserOperation::buildERC1155Transfer(const Data& entryPointAddress, const Data& s
         paymasterAndData);
 }
 
-} // namespace TW::Ethereum
\ No newline at end of file
+/// UserOperationHasher
+static const auto AddressMask = (uint256_t(1) << 160) - 1;
+
+static void appendHash(const Data& data, Data& out) {
+    // hashed on first use rather than when the library is loaded
+    static const auto emptyDataHash = Hash::keccak256(Data());
+    append(out, data.empty() ? emptyDataHash : Hash::keccak256(data));
+}
+
+UserOperationHasher::UserOperationHasher(const Data& entryPoint, const uint256_t& chainID)
+    : entryPoint(entryPoint) {
+    suffix.reserve(2 * ABI::ValueEncoder::encodedIntSize);
+    ABI::ValueEncoder::encodeUInt256(load(entryPoint) & AddressMask, suffix);
+    ABI::ValueEncoder::encodeUInt256(chainID, suffix);
+}
+
+Data UserOperationHasher::serialize(const UserOperation& operation) {
+    Data serialized;
+    serialized.reserve(10 * ABI::ValueEncoder::encodedIntSize);
+    ABI::ValueEncoder::encodeUInt256(load(operation.sender) & AddressMask, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.nonce, serialized);
+    appendHash(operation.initCode, serialized);
+    appendHash(operation.payload, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.gasLimit, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.verificationGasLimit, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.preVerificationGas, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.maxFeePerGas, serialized);
+    ABI::ValueEncoder::encodeUInt256(operation.maxInclusionFeePerGas, serialized);
+    appendHash(operation.paymasterAndData, serialized);
+    return serialized;
+}
+
+Data UserOperationHasher::preHash(const UserOperation& operation) const {
+    if (operation.entryPoint != entryPoint) {
+        throw std::invalid_argument("UserOperation entry point differs from the hasher one");
+    }
+    auto encoded = Hash::keccak256(serialize(operation));
+    append(encoded, suffix);
+    const auto hash = Hash::keccak256(encoded);
+    return MessageSigner::generateMessage(std::string(hash.begin(), hash.end()));
+}
+
+std::vector<Data> UserOperationHasher::preHashes(const std::vector<std::shared_ptr<UserOperation>>& operations, std::size_t threads) const {
+    std::vector<Data> hashes(operations.size());
+    parallelFor(operations.size(), threads, [&](std::size_t i) {
+        hashes[i] = preHash(*operations[i]);
+    });
+    return hashes;
+}
+
+} // namespace TW::Ethereum
@@ -10,6 +10,7 @@
 #include "../uint256.h"
 
 #include <memory>
+#include <vector>
 
 namespace TW::Ethereum {
 
@@ -232,4 +233,28 @@ public:
         , paymasterAndData(std::move(paymasterAndData)) {}
 };
 
+/// Computes the `preHash` of many UserOperations of the same entry point and chain.
+/// The entry point and chain ID words, and the hash of empty init code and paymaster data, are encoded once;
+/// each operation is then hashed straight from its fields.
+class UserOperationHasher {
+public:
+    UserOperationHasher(const Data& entryPoint, const uint256_t& chainID);
+
+    /// Same as `operation.preHash(chainID)`.
+    /// Throws std::invalid_argument if the operation has a different entry point.
+    Data preHash(const UserOperation& operation) const;
+
+    /// The `preHash` of every operation, in order, computed on `threads` worker threads (see `parallelFor`).
+    /// Throws std::invalid_argument if an operation has a different entry point.
+    std::vector<Data> preHashes(const std::vector<std::shared_ptr<UserOperation>>& operations, std::size_t threads = 1) const;
+
+    /// The ABI encoding hashed for the operation, same as `operation.serialize(chainID)`.
+    static Data serialize(const UserOperation& operation);
+
+private:
+    Data entryPoint;
+    /// Encoded entry point and chain ID words, following the operation hash.
+    Data suffix;
+};
+
 } // namespace TW::Ethereum
@@ -0,0 +1,112 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TransferTemplate.h"
+#include "Address.h"
+#include "RLP.h"
+#include "Transaction.h"
+#include "../Hash.h"
+#include "../algorithm/parallel.h"
+
+#include <array>
+#include <span>
+#include <stdexcept>
+
+namespace TW::Ethereum {
+
+/// Bytes of the ERC20 `transfer` payload before the recipient: selector and address padding.
+static constexpr std::size_t callPrefixSize = 4 + 12;
+
+static void checkAddress(const Data& address) {
+    if (!Address::isValid(address)) {
+        throw std::invalid_argument("Invalid address");
+    }
+}
+
+TransferTemplate::TransferTemplate(const PrivateKey& privateKey, const uint256_t& chainID, const uint256_t& maxInclusionFeePerGas,
+                                   const uint256_t& maxFeePerGas, const uint256_t& gasLimit, const Data& tokenContract)
+    : context(privateKey, TWCurveSECP256k1), tokenTransfer(!tokenContract.empty()) {
+    chainIDEncoded = RLP::encode(chainID);
+    if (tokenTransfer) {
+        checkAddress(tokenContract);
+    }
+    const auto call = tokenTransfer ? TransactionNonTyped::buildERC20TransferCall(Data(Address::size), 0) : Data();
+    feesEncoded = RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.append(maxInclusionFeePerGas);
+        writer.append(maxFeePerGas);
+        writer.append(gasLimit);
+        if (tokenTransfer) {
+            writer.append(tokenContract);
+            writer.append(uint256_t(0));
+            // header of the whole payload, then its constant start
+            const auto header = RLP::encodeHeader(call.size(), 0x80, 0xb7);
+            writer.appendEncoded(header);
+            writer.appendEncoded(std::span<const uint8_t>(call.data(), callPrefixSize));
+        }
+    });
+}
+
+Data TransferTemplate::encode(const FixedUint256& nonce, const Data& to, const FixedUint256& amount, const byte* signature) const {
+    static const uint8_t typePrefix = TxType_Eip1559;
+    static const uint8_t emptyEncoded = 0x80;
+    static const uint8_t emptyListEncoded = 0xc0;
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.appendEncoded(std::span<const uint8_t>(&typePrefix, 1));
+        writer.beginList();
+        writer.appendEncoded(chainIDEncoded);
+        writer.append(nonce);
+        writer.appendEncoded(feesEncoded);
+        if (tokenTransfer) {
+            // the recipient and amount slots of the payload
+            std::array<uint8_t, 32> amountSlot;
+            amount.storeBE(amountSlot);
+            writer.appendEncoded(to);
+            writer.appendEncoded(amountSlot);
+        } else {
+            writer.append(to);
+            writer.append(amount);
+            writer.appendEncoded(std::span<const uint8_t>(&emptyEncoded, 1)); // empty payload
+        }
+        writer.appendEncoded(std::span<const uint8_t>(&emptyListEncoded, 1)); // empty accessList
+        if (signature != nullptr) {
+            writer.append(FixedUint256(signature[64]));
+            writer.append(FixedUint256::loadBE(std::span<const byte>(signature, 32)));
+            writer.append(FixedUint256::loadBE(std::span<const byte>(signature + 32, 32)));
+        }
+        writer.endList();
+    });
+}
+
+Data TransferTemplate::preHash(const uint256_t& nonce, const Data& to, const uint256_t& amount) const {
+    if (tokenTransfer) {
+        checkAddress(to);
+    }
+    return Hash::keccak256(encode(toFixed(nonce), to, toFixed(amount), nullptr));
+}
+
+Data TransferTemplate::sign(const uint256_t& nonce, const Data& to, const uint256_t& amount) const {
+    if (tokenTransfer) {
+        checkAddress(to);
+    }
+    const auto fixedNonce = toFixed(nonce);
+    const auto fixedAmount = toFixed(amount);
+    const auto hash = Hash::keccak256Into(encode(fixedNonce, to, fixedAmount, nullptr));
+    SigningContext::Signature signature;
+    if (!context.sign(hash, signature)) {
+        throw std::runtime_error("Signing failed");
+    }
+    return encode(fixedNonce, to, fixedAmount, signature.data());
+}
+
+std::vector<Data> TransferTemplate::sign(const uint256_t& firstNonce, const std::vector<Transfer>& transfers, std::size_t threads) const {
+    std::vector<Data> encoded(transfers.size());
+    parallelFor(transfers.size(), threads, [&](std::size_t i) {
+        encoded[i] = sign(firstNonce + i, transfers[i].to, transfers[i].amount);
+    });
+    return encoded;
+}
+
+} // namespace TW::Ethereum
@@ -0,0 +1,68 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "../FixedUint256.h"
+#include "../PrivateKey.h"
+#include "../SigningContext.h"
+#include "../uint256.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace TW::Ethereum {
+
+/// Signs EIP1559 transfers from one key which differ only by nonce, recipient and amount: native transfers, or
+/// ERC20 `transfer` calls of one token contract.
+///
+/// The constant fields (chain ID, fees, gas limit, token contract, function selector) are RLP encoded once;
+/// a transfer only encodes its nonce, recipient and amount between them, then hashes and signs with a
+/// `SigningContext`. Pre-hashes and encodings are the same as the transactions of
+/// `TransactionEip1559::buildNativeTransfer` and `TransactionEip1559::buildERC20Transfer`.
+class TransferTemplate {
+public:
+    /// A recipient (address bytes) and an amount, in wei or token units.
+    struct Transfer {
+        Data to;
+        uint256_t amount;
+    };
+
+    /// Native transfers if `tokenContract` is empty, ERC20 transfers otherwise.
+    /// Throws std::invalid_argument if the private key is not valid, or a token contract is not an address.
+    TransferTemplate(const PrivateKey& privateKey, const uint256_t& chainID, const uint256_t& maxInclusionFeePerGas,
+                     const uint256_t& maxFeePerGas, const uint256_t& gasLimit, const Data& tokenContract = {});
+
+    TransferTemplate(const TransferTemplate&) = delete;
+    TransferTemplate& operator=(const TransferTemplate&) = delete;
+
+    /// Pre-sign hash of a transfer, for signing.
+    /// Throws std::invalid_argument if an ERC20 recipient is not an address.
+    Data preHash(const uint256_t& nonce, const Data& to, const uint256_t& amount) const;
+
+    /// Signed and encoded transfer, ready to broadcast.
+    /// Throws std::invalid_argument if an ERC20 recipient is not an address, std::runtime_error if signing fails.
+    Data sign(const uint256_t& nonce, const Data& to, const uint256_t& amount) const;
+
+    /// Signs transfers with consecutive nonces from `firstNonce` on `threads` worker threads (see `parallelFor`);
+    /// same encodings as `sign` for each transfer, in order.
+    std::vector<Data> sign(const uint256_t& firstNonce, const std::vector<Transfer>& transfers, std::size_t threads = 1) const;
+
+private:
+    /// Encodes the transaction, unsigned if `signature` (r | s | v) is null.
+    Data encode(const FixedUint256& nonce, const Data& to, const FixedUint256& amount, const byte* signature) const;
+
+    SigningContext context;
+    bool tokenTransfer;
+    /// RLP of the chain ID.
+    Data chainIDEncoded;
+    /// RLP of the fees and gas limit and, for token transfers, of the contract, the zero value, and the payload
+    /// header, selector and recipient padding.
+    Data feesEncoded;
+};
+
+} // namespace TW::Ethereum
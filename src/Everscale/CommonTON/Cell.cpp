@@ -7,11 +7,12 @@
 #include "Cell.h"
 
 #include <cassert>
-#include <map>
+#include <cstring>
 #include <optional>
 #include <unordered_map>
 
 #include "BinaryCoding.h"
+#include "Crc.h"
 
 #include <boost/archive/iterators/binary_from_base64.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
@@ -88,6 +89,15 @@ struct Reader {
     }
 };
 
+// Cell hashes are SHA-256 digests, their leading bytes are already uniformly distributed
+struct CellHashHasher {
+    size_t operator()(const Cell::CellHash& hash) const noexcept {
+        size_t result = 0;
+        std::memcpy(&result, hash.data(), sizeof(result));
+        return result;
+    }
+};
+
 std::shared_ptr<Cell> Cell::fromBase64(const std::string& encoded) {
     // `Hash::base64` trims \0 bytes from the end of the _decoded_ data, so
     // raw transform is used here
@@ -121,6 +131,16 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
     const auto offsetSize = reader.data()[1];
     reader.advance(2);
 
+    // Verify and exclude the trailing CRC32C (little endian)
+    if (flags.hasCrc) {
+        reader.require(sizeof(uint32_t));
+        const auto crcOffset = len - sizeof(uint32_t);
+        if (Crc::crc32c(data, crcOffset) != decode32LE(data + crcOffset)) {
+            throw std::runtime_error("crc mismatch");
+        }
+        reader.bufferLen = crcOffset;
+    }
+
     // 3. Counters and root index
     reader.require(refSize * 3 + offsetSize + refSize);
     const auto cellCount = reader.readNextUint(refSize);
@@ -214,7 +234,11 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
             });
     }
 
-    std::unordered_map<size_t, Cell::Ref> doneCells{};
+    // Cells only refer to cells with larger indices, build them from the end.
+    // Identical subtrees (same hash) are represented by a single shared cell.
+    std::vector<Cell::Ref> doneCells(cellCount);
+    std::unordered_map<Cell::CellHash, Cell::Ref, CellHashHasher> uniqueCells{};
+    uniqueCells.reserve(cellCount);
 
     size_t index = cellCount;
     for (auto it = intermediate.rbegin(); it != intermediate.rend(); ++it, --index) {
@@ -222,23 +246,23 @@ std::shared_ptr<Cell> Cell::deserialize(const uint8_t* _Nonnull data, size_t len
 
         Cell::Refs references{};
         for (size_t r = 0; r < raw.references.size(); ++r) {
-            const auto child = doneCells.find(raw.references[r]);
-            if (child == doneCells.end()) {
+            const auto childIndex = raw.references[r];
+            if (childIndex >= cellCount || doneCells[childIndex] == nullptr) {
                 throw std::runtime_error("child cell not found");
             }
-            references[r] = child->second;
+            references[r] = doneCells[childIndex];
         }
 
         auto cell = std::make_shared<Cell>(raw.bitLen, std::move(raw.data), raw.references.size(), std::move(references));
         cell->finalize();
-        doneCells.emplace(index - 1, cell);
+        const auto [unique, _] = uniqueCells.emplace(cell->hash, std::move(cell));
+        doneCells[index - 1] = unique->second;
     }
 
-    const auto root = doneCells.find(rootIndex);
-    if (root == doneCells.end()) {
+    if (rootIndex >= cellCount || doneCells[rootIndex] == nullptr) {
         throw std::runtime_error("root cell not found");
     }
-    return std::move(root->second);
+    return std::move(doneCells[rootIndex]);
 }
 
 class SerializationContext {
@@ -249,14 +273,15 @@ public:
         return ctx;
     }
 
-    void encode(Data& os) const {
-        os.reserve(os.size() + HEADER_SIZE + cellsSize);
+    void encode(Data& os, bool withCrc) const {
+        const auto start = os.size();
+        os.reserve(start + HEADER_SIZE + cellsSize + (withCrc ? sizeof(uint32_t) : 0));
 
         const auto cellCount = static_cast<ref_t>(reversedCells.size());
 
         // Write header
         encode32BE(BOC_MAGIC, os);
-        os.push_back(REF_SIZE);
+        os.push_back(REF_SIZE | (withCrc ? HAS_CRC_FLAG : 0));
         os.push_back(OFFSET_SIZE);
         encode16BE(static_cast<ref_t>(cellCount), os);
         encode16BE(1, os); // root count
@@ -294,6 +319,10 @@ public:
                 --i;
             }
         }
+
+        if (withCrc) {
+            encode32LE(Crc::crc32c(os.data() + start, os.size() - start), os);
+        }
     }
 
 private:
@@ -302,6 +331,7 @@ private:
     using offset_t = uint16_t;
 
     constexpr static uint8_t REF_SIZE = sizeof(ref_t);
+    constexpr static uint8_t HAS_CRC_FLAG = 0b01000000;
     constexpr static uint8_t OFFSET_SIZE = sizeof(offset_t);
     constexpr static size_t HEADER_SIZE =
         /*magic*/ sizeof(BOC_MAGIC) +
@@ -315,31 +345,46 @@ private:
 
     size_t cellsSize = 0;
     ref_t index = 0;
-    std::map<Cell::CellHash, ref_t> indices{};
+    std::unordered_map<Cell::CellHash, ref_t, CellHashHasher> indices{};
     std::vector<const Cell* _Nonnull> reversedCells{};
 
-    static void fillContext(const Cell& cell, SerializationContext& ctx) {
-        if (ctx.indices.find(cell.hash) != ctx.indices.end()) {
-            return;
-        }
+    // Collects cells in post-order (children before parents), each distinct cell once.
+    // Iterative, with an explicit stack, so deep cell trees do not grow the call stack.
+    static void fillContext(const Cell& root, SerializationContext& ctx) {
+        struct Frame {
+            const Cell* _Nonnull cell;
+            uint8_t nextRef;
+        };
+        std::vector<Frame> stack{};
+        stack.push_back(Frame{&root, 0});
+
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            const auto& cell = *frame.cell;
+            if (frame.nextRef == 0 && ctx.indices.contains(cell.hash)) {
+                stack.pop_back();
+                continue;
+            }
 
-        for (const auto& ref : cell.references) {
-            if (ref == nullptr) {
-                break;
+            if (frame.nextRef < cell.references.size() && cell.references[frame.nextRef] != nullptr) {
+                const auto* child = cell.references[frame.nextRef].get();
+                ++frame.nextRef;
+                stack.push_back(Frame{child, 0});
+                continue;
             }
-            fillContext(*ref, ctx);
-        }
 
-        ctx.indices.insert(std::make_pair(cell.hash, ctx.index++));
-        ctx.reversedCells.emplace_back(&cell);
-        ctx.cellsSize += cell.serializedSize(REF_SIZE);
+            ctx.indices.insert(std::make_pair(cell.hash, ctx.index++));
+            ctx.reversedCells.emplace_back(&cell);
+            ctx.cellsSize += cell.serializedSize(REF_SIZE);
+            stack.pop_back();
+        }
     }
 };
 
-void Cell::serialize(Data& os) const {
+void Cell::serialize(Data& os, bool withCrc) const {
     assert(finalized);
     const auto ctx = SerializationContext::build(*this);
-    ctx.encode(os);
+    ctx.encode(os, withCrc);
 }
 
 void Cell::finalize() {
@@ -361,24 +406,26 @@ void Cell::finalize() {
         depth = std::max(depth, static_cast<uint16_t>(ref->depth + 1));
     }
 
-    // Compute cell hash
+    // Compute cell hash, over a stack buffer large enough for any valid cell
     const auto dataSize = std::min(data.size(), static_cast<size_t>((bitLen + 7) / 8));
 
-    Data normalized{};
-    normalized.reserve(/* descriptor bytes */ 2 + dataSize + refCount * (sizeof(uint16_t) + Hash::sha256Size));
+    std::array<uint8_t, /* descriptor bytes */ 2 + (Cell::MAX_BITS + 7) / 8 + Cell::MAX_REFS * (sizeof(uint16_t) + Hash::sha256Size)> normalized{};
+    size_t normalizedLen = 0;
 
     // Write descriptor bytes
     const auto [d1, d2] = getDescriptorBytes();
-    normalized.push_back(d1);
-    normalized.push_back(d2);
-    std::copy(data.begin(), std::next(data.begin(), static_cast<ssize_t>(dataSize)), std::back_inserter(normalized));
+    normalized[normalizedLen++] = d1;
+    normalized[normalizedLen++] = d2;
+    std::copy(data.begin(), std::next(data.begin(), static_cast<ssize_t>(dataSize)), normalized.begin() + normalizedLen);
+    normalizedLen += dataSize;
 
     // Write all children depths
     for (const auto& ref : references) {
         if (ref == nullptr) {
             break;
         }
-        encode16BE(ref->depth, normalized);
+        normalized[normalizedLen++] = static_cast<uint8_t>(ref->depth >> 8);
+        normalized[normalizedLen++] = static_cast<uint8_t>(ref->depth);
     }
 
     // Write all children hashes
@@ -386,14 +433,12 @@ void Cell::finalize() {
         if (ref == nullptr) {
             break;
         }
-        std::copy(ref->hash.begin(), ref->hash.end(), std::back_inserter(normalized));
+        std::copy(ref->hash.begin(), ref->hash.end(), normalized.begin() + normalizedLen);
+        normalizedLen += ref->hash.size();
     }
 
     // Done
-    const auto computedHash = Hash::sha256(normalized);
-    assert(computedHash.size() == Hash::sha256Size);
-
-    std::copy(computedHash.begin(), computedHash.end(), hash.begin());
+    Hash::sha256Into(normalized.data(), normalizedLen, hash);
     finalized = true;
 }
 
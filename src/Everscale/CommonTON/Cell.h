@@ -46,8 +46,8 @@ public:
     // Deserialize from BOC representation
     static std::shared_ptr<Cell> deserialize(const uint8_t* _Nonnull data, size_t len);
 
-    // Serialize to binary stream
-    void serialize(Data& os) const;
+    // Serialize to binary stream, optionally with a trailing CRC32C of the BOC
+    void serialize(Data& os, bool withCrc = false) const;
 
     // Compute cell depth and hash
     void finalize();
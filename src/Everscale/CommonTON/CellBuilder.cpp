@@ -7,8 +7,10 @@
 #include "CellBuilder.h"
 #include "Cell.h"
 
+#include <array>
 #include <bit>
 #include <cassert>
+#include <span>
 #include <vector>
 
 #include "BinaryCoding.h"
@@ -17,6 +19,12 @@ using namespace TW;
 
 namespace TW::CommonTON {
 
+CellBuilder::CellBuilder() {
+    // a cell never grows beyond these, reserve once
+    data.reserve((Cell::MAX_BITS + 7) / 8);
+    references.reserve(Cell::MAX_REFS);
+}
+
 CellBuilder::CellBuilder(Data& appendedData, uint16_t bits) {
     assert(bits <= appendedData.size() * 8);
     assert(bits < Cell::MAX_BITS);
@@ -24,48 +32,45 @@ CellBuilder::CellBuilder(Data& appendedData, uint16_t bits) {
 
     appendedData.resize(bits / 8);
 
+    data.reserve((Cell::MAX_BITS + 7) / 8);
     data = appendedData;
     bitLen = bits;
     references = {};
 }
 
 void CellBuilder::appendBitZero() {
-    Data appendedData{0x00};
-    appendRaw(appendedData, 1);
+    const uint8_t appendedData = 0x00;
+    appendRaw(&appendedData, 1, 1);
 }
 
 void CellBuilder::appendBitOne() {
-    Data appendedData{0xFF};
-    appendRaw(appendedData, 1);
+    const uint8_t appendedData = 0xFF;
+    appendRaw(&appendedData, 1, 1);
 }
 
 void CellBuilder::appendBitBool(bool bit) {
-    auto getAppendedData = [](bool bit) {
-        if (bit) {
-            return Data{0xFF};
-        } else {
-            return Data{0x00};
-        }
-    };
-    auto appendedData = getAppendedData(bit);
-    appendRaw(appendedData, 1);
+    const uint8_t appendedData = bit ? 0xFF : 0x00;
+    appendRaw(&appendedData, 1, 1);
 }
 
 void CellBuilder::appendU8(uint8_t value) {
-    Data appendedData{value};
-    appendRaw(appendedData, 8);
+    appendRaw(&value, 1, 8);
 }
 
 void CellBuilder::appendU32(uint32_t value) {
-    Data appendedData;
-    encode32BE(value, appendedData);
-    appendRaw(appendedData, 32);
+    std::array<uint8_t, sizeof(uint32_t)> appendedData{};
+    for (auto i = appendedData.size(); i > 0; --i, value >>= 8) {
+        appendedData[i - 1] = static_cast<uint8_t>(value);
+    }
+    appendRaw(appendedData.data(), appendedData.size(), 32);
 }
 
 void CellBuilder::appendU64(uint64_t value) {
-    Data appendedData;
-    encode64BE(value, appendedData);
-    appendRaw(appendedData, 64);
+    std::array<uint8_t, sizeof(uint64_t)> appendedData{};
+    for (auto i = appendedData.size(); i > 0; --i, value >>= 8) {
+        appendedData[i - 1] = static_cast<uint8_t>(value);
+    }
+    appendRaw(appendedData.data(), appendedData.size(), 64);
 }
 
 void CellBuilder::appendU128(const uint128_t& value) {
@@ -75,44 +80,43 @@ void CellBuilder::appendU128(const uint128_t& value) {
     appendBits(bytes, bits);
 
     Data encodedValue;
+    encodedValue.reserve(16);
     encode128BE(value, encodedValue);
 
     auto offset = static_cast<uint32_t>(encodedValue.size() - bytes);
-
-    Data appendedData(encodedValue.begin() + offset, encodedValue.end());
-    appendRaw(appendedData, bytes * 8);
+    appendRaw(encodedValue.data() + offset, bytes, bytes * 8);
 }
 
 void CellBuilder::appendI8(int8_t value) {
-    Data appendedData{static_cast<uint8_t>(value)};
-    appendRaw(appendedData, 8);
+    const auto appendedData = static_cast<uint8_t>(value);
+    appendRaw(&appendedData, 1, 8);
 }
 
 void CellBuilder::appendBits(uint64_t value, uint8_t bits) {
     assert(bits >= 1 && bits <= 7);
 
-    Data appendedData;
-
-    auto val = static_cast<uint8_t>(value << (8 - bits));
-    appendedData.push_back(val);
-
-    appendRaw(appendedData, bits);
+    const auto appendedData = static_cast<uint8_t>(value << (8 - bits));
+    appendRaw(&appendedData, 1, bits);
 }
 
 void CellBuilder::appendRaw(const Data& appendedData, uint16_t bits) {
-    if (appendedData.size() * 8 < bits) {
+    appendRaw(appendedData.data(), appendedData.size(), bits);
+}
+
+void CellBuilder::appendRaw(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits) {
+    if (size * 8 < bits) {
         throw std::invalid_argument("invalid builder data");
     } else if (bitLen + bits > Cell::MAX_BITS) {
         throw std::runtime_error("cell data overflow");
     } else if (bits != 0) {
         if ((bitLen % 8) == 0) {
             if ((bits % 8) == 0) {
-                appendWithoutShifting(appendedData, bits);
+                appendWithoutShifting(appendedData, size, bits);
             } else {
-                appendWithSliceShifting(appendedData, bits);
+                appendWithSliceShifting(appendedData, size, bits);
             }
         } else {
-            appendWithDoubleShifting(appendedData, bits);
+            appendWithDoubleShifting(appendedData, size, bits);
         }
     }
     assert(bitLen <= Cell::MAX_BITS);
@@ -146,8 +150,7 @@ void CellBuilder::appendBuilder(const CellBuilder& builder) {
 }
 
 void CellBuilder::appendCellSlice(const CellSlice& other) {
-    Data appendedData(other.cell->data);
-    appendRaw(appendedData, other.cell->bitLen);
+    appendRaw(other.cell->data, other.cell->bitLen);
 
     for (const auto& cell : other.cell->references) {
         appendReferenceCell(cell);
@@ -176,29 +179,29 @@ Cell::Ref CellBuilder::intoCell() {
     return cell;
 }
 
-void CellBuilder::appendWithoutShifting(const Data& appendedData, uint16_t bits) {
+void CellBuilder::appendWithoutShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits) {
     assert(bits % 8 == 0);
     assert(bitLen % 8 == 0);
 
     data.resize(bitLen / 8);
-    data.insert(data.end(), appendedData.begin(), appendedData.end());
+    data.insert(data.end(), appendedData, appendedData + size);
     bitLen += bits;
     data.resize(bitLen / 8);
 }
 
-void CellBuilder::appendWithSliceShifting(const Data& appendedData, uint16_t bits) {
+void CellBuilder::appendWithSliceShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits) {
     assert(bits % 8 != 0);
     assert(bitLen % 8 == 0);
 
     data.resize(bitLen / 8);
-    data.insert(data.end(), appendedData.begin(), appendedData.end());
+    data.insert(data.end(), appendedData, appendedData + size);
     bitLen += bits;
     data.resize(1 + bitLen / 8);
 
     data.back() &= ~static_cast<uint8_t>(0xff >> (bits % 8));
 }
 
-void CellBuilder::appendWithDoubleShifting(const Data& appendedData, uint16_t bits) {
+void CellBuilder::appendWithDoubleShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits) {
     auto selfShift = bitLen % 8;
     data.resize(1 + bitLen / 8);
     bitLen += bits;
@@ -207,7 +210,7 @@ void CellBuilder::appendWithDoubleShifting(const Data& appendedData, uint16_t bi
     auto y = static_cast<uint16_t>(data.back() >> (8 - selfShift));
     data.pop_back();
 
-    for (const auto x : appendedData) {
+    for (const auto x : std::span(appendedData, size)) {
         // 00000000 000yyyyy -> 000yyyyy xxxxxxxx
         y = static_cast<uint16_t>(y << 8) | x;
         // 000yyyyy xxxxxxxx -> 00000000 yyyyyxxx
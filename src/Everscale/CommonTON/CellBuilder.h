@@ -23,7 +23,7 @@ class CellBuilder {
 public:
     using uint128_t = boost::multiprecision::uint128_t;
 
-    CellBuilder() = default;
+    CellBuilder();
     CellBuilder(Data& appendedData, uint16_t bits);
 
     void appendBitZero();
@@ -44,9 +44,11 @@ public:
     Cell::Ref intoCell();
 
 private:
-    void appendWithoutShifting(const Data& data, uint16_t bits);
-    void appendWithSliceShifting(const Data& data, uint16_t bits);
-    void appendWithDoubleShifting(const Data& data, uint16_t bits);
+    // Appends `bits` bits of `size` bytes, without a temporary `Data` for fixed-width values
+    void appendRaw(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits);
+    void appendWithoutShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits);
+    void appendWithSliceShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits);
+    void appendWithDoubleShifting(const uint8_t* _Nonnull appendedData, size_t size, uint16_t bits);
 
     static uint8_t clzU128(const uint128_t& u);
     static void encode128BE(const uint128_t& value, Data& data);
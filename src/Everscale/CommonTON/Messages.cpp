@@ -1,5 +1,9 @@
 #include "Messages.h"
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
 namespace TW::CommonTON {
 
 void ExternalInboundMessageHeader::writeTo(CellBuilder& builder) const {
@@ -73,4 +77,33 @@ CellBuilder StateInit::writeTo() const {
     return builder;
 }
 
+StateInitTemplate::StateInitTemplate(const uint8_t* _Nonnull code, size_t len)
+    : _code(Cell::deserialize(code, len)) {
+    // The representation layout of the StateInit cell, with an empty data cell in place
+    const auto cell = withData(CellBuilder().intoCell()).writeTo().intoCell();
+    if (cell->refCount != 2 || cell->data.size() != 1) {
+        throw std::runtime_error("unexpected StateInit layout");
+    }
+
+    const auto [d1, d2] = cell->getDescriptorBytes();
+    _representation[0] = d1;
+    _representation[1] = d2;
+    _representation[2] = cell->data[0];
+    _representation[3] = static_cast<uint8_t>(_code->depth >> 8);
+    _representation[4] = static_cast<uint8_t>(_code->depth);
+    std::copy(_code->hash.begin(), _code->hash.end(), _representation.begin() + dataDepthOffset + sizeof(uint16_t));
+}
+
+Cell::CellHash StateInitTemplate::hash(const Cell& data) const {
+    assert(data.finalized);
+    auto representation = _representation;
+    representation[dataDepthOffset] = static_cast<uint8_t>(data.depth >> 8);
+    representation[dataDepthOffset + 1] = static_cast<uint8_t>(data.depth);
+    std::copy(data.hash.begin(), data.hash.end(), representation.begin() + dataHashOffset);
+
+    Cell::CellHash result;
+    Hash::sha256Into(representation.data(), representation.size(), result);
+    return result;
+}
+
 } // namespace TW::CommonTON
\ No newline at end of file
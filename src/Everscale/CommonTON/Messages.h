@@ -65,6 +65,33 @@ public:
     [[nodiscard]] CellBuilder writeTo() const;
 };
 
+/// StateInit of one contract code with any data cell.  The code cell is deserialized once and shared,
+/// and its part of the StateInit cell representation is precomputed, so that the hash of a StateInit
+/// (i.e. the contract address) costs a single SHA256 over the data cell hash.
+class StateInitTemplate {
+public:
+    /// Deserializes the contract code from its BOC representation.
+    StateInitTemplate(const uint8_t* _Nonnull code, size_t len);
+
+    [[nodiscard]] const Cell::Ref& code() const noexcept { return _code; }
+
+    [[nodiscard]] StateInit withData(Cell::Ref data) const { return StateInit{_code, std::move(data)}; }
+
+    /// Hash of the StateInit cell with the given finalized data cell,
+    /// same as `withData(data).writeTo().intoCell()->hash` without building the cell.
+    [[nodiscard]] Cell::CellHash hash(const Cell& data) const;
+
+private:
+    // descriptor bytes, data byte, depths of code and data, hashes of code and data
+    static constexpr size_t dataDepthOffset = 2 + 1 + sizeof(uint16_t);
+    static constexpr size_t dataHashOffset = dataDepthOffset + sizeof(uint16_t) + Hash::sha256Size;
+    using Representation = std::array<uint8_t, dataHashOffset + Hash::sha256Size>;
+
+    Cell::Ref _code;
+    /// Representation of the StateInit cell, with the data cell depth and hash left to fill in.
+    Representation _representation{};
+};
+
 struct MessageData {
     std::shared_ptr<CommonMsgInfo> header;
     std::optional<StateInit> init{};
@@ -19,28 +19,23 @@ CellBuilder InitData::writeTo() const {
 
     builder.appendU32(_seqno);
     builder.appendU32(_walletId);
-    builder.appendRaw(_publicKey.bytes, 256);
+    builder.appendRaw(Data(_publicKey.bytes), 256);
 
     return builder;
 }
 
-AddressData InitData::computeAddr(int8_t workchainId) const {
-    auto builder = this->writeTo();
+const StateInitTemplate& Wallet::stateInitTemplate() {
+    static const StateInitTemplate stateInit(code.data(), code.size());
+    return stateInit;
+}
 
-    StateInit stateInit{
-        .code = Cell::deserialize(Wallet::code.data(), Wallet::code.size()),
-        .data = builder.intoCell(),
-    };
-    return AddressData(workchainId, stateInit.writeTo().intoCell()->hash);
+AddressData InitData::computeAddr(int8_t workchainId) const {
+    const auto data = this->writeTo().intoCell();
+    return AddressData(workchainId, Wallet::stateInitTemplate().hash(*data));
 }
 
 StateInit InitData::makeStateInit() const {
-    auto builder = this->writeTo();
-
-    return StateInit{
-        .code = Cell::deserialize(Wallet::code.data(), Wallet::code.size()),
-        .data = builder.intoCell(),
-    };
+    return Wallet::stateInitTemplate().withData(this->writeTo().intoCell());
 }
 
 CellBuilder InitData::makeTransferPayload(uint32_t expireAt, const Wallet::Gift& gift) const {
@@ -50,6 +50,9 @@ public:
         MessageFlags::AttachAllBalance | MessageFlags::IgnoreActionPhaseErrors;
 
     static const Data code;
+
+    /// StateInit of the wallet code, deserialized once.
+    static const StateInitTemplate& stateInitTemplate();
 };
 
 class InitData {
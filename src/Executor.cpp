@@ -0,0 +1,235 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Executor.h"
+
+#include <algorithm>
+#include <system_error>
+#include <thread>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define TW_EXECUTOR_INLINE 1
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#endif
+
+namespace TW {
+
+namespace {
+
+/// The executor and the worker index of the current thread, if it is a worker.
+thread_local Executor* currentExecutor = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+std::size_t hardwareThreads() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, Executor::maxThreads);
+}
+
+/// Applies the CPU affinity and the priority to the calling thread, on a best effort basis.
+void applyThreadSettings([[maybe_unused]] uint64_t affinityMask, [[maybe_unused]] int priority) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (affinityMask == 0) {
+        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &set);
+        }
+    } else {
+        for (std::size_t cpu = 0; cpu < 64; ++cpu) {
+            if ((affinityMask >> cpu) & 1) {
+                CPU_SET(cpu, &set);
+            }
+        }
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+    // On Linux the nice value is per thread.
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), priority);
+#elif defined(__APPLE__)
+    // No affinity API; the priority maps to a quality of service class.
+    auto qos = QOS_CLASS_DEFAULT;
+    if (priority >= 10) {
+        qos = QOS_CLASS_BACKGROUND;
+    } else if (priority > 0) {
+        qos = QOS_CLASS_UTILITY;
+    } else if (priority < 0) {
+        qos = QOS_CLASS_USER_INITIATED;
+    }
+    pthread_set_qos_class_self_np(qos, 0);
+#endif
+}
+
+} // namespace
+
+Executor& Executor::shared() {
+    static auto* executor = new Executor(hardwareThreads());
+    return *executor;
+}
+
+Executor::Executor(std::size_t threads) : threads(threads) {}
+
+void Executor::configure(std::size_t threads, uint64_t affinityMask, int priority) {
+    {
+        std::lock_guard lock(mutex);
+        this->threads = threads == 0 ? hardwareThreads() : std::min(threads, maxThreads);
+        this->affinityMask = affinityMask;
+        this->priority = priority;
+        ++generation;
+        if (queued.load() > 0) {
+            startWorkers();
+        }
+    }
+    available.notify_all();
+}
+
+void Executor::setHost(Host host) {
+    std::lock_guard lock(mutex);
+    this->host = std::move(host);
+}
+
+void Executor::runHostJob(Job* job) {
+    (*job)();
+    delete job;
+}
+
+void Executor::submit(Job job) {
+#ifdef TW_EXECUTOR_INLINE
+    job();
+#else
+    std::unique_lock lock(mutex);
+    if (host) {
+        const auto callback = host;
+        lock.unlock();
+        callback(new Job(std::move(job)));
+        return;
+    }
+    if (!startWorkers()) {
+        lock.unlock();
+        job();
+        return;
+    }
+    queued.fetch_add(1);
+    if (currentExecutor == this && currentWorker < threads) {
+        // Kept local, idle workers steal it.
+        auto& worker = workers[currentWorker];
+        std::lock_guard local(worker.mutex);
+        worker.jobs.push_back(std::move(job));
+    } else {
+        injected.push_back(std::move(job));
+    }
+    lock.unlock();
+    available.notify_one();
+#endif
+}
+
+bool Executor::startWorkers() {
+    const auto count = threads.load();
+    for (std::size_t index = 0; index < count && running < count; ++index) {
+        if (workers[index].running) {
+            continue;
+        }
+        try {
+            std::thread([this, index] { work(index); }).detach();
+        } catch (const std::system_error&) {
+            break;
+        }
+        workers[index].running = true;
+        ++running;
+        if (slots.load() <= index) {
+            slots = index + 1;
+        }
+    }
+    return running > 0;
+}
+
+bool Executor::pop(std::size_t index, Job& job) {
+    auto take = [&](std::deque<Job>& jobs, bool newest) {
+        if (jobs.empty()) {
+            return false;
+        }
+        job = std::move(newest ? jobs.back() : jobs.front());
+        newest ? jobs.pop_back() : jobs.pop_front();
+        queued.fetch_sub(1);
+        return true;
+    };
+    {
+        std::lock_guard lock(workers[index].mutex);
+        if (take(workers[index].jobs, true)) {
+            return true;
+        }
+    }
+    {
+        std::lock_guard lock(mutex);
+        if (take(injected, false)) {
+            return true;
+        }
+    }
+    const auto count = slots.load();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        auto& victim = workers[(index + offset) % count];
+        std::lock_guard lock(victim.mutex);
+        if (take(victim.jobs, false)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Executor::work(std::size_t index) {
+    currentExecutor = this;
+    currentWorker = index;
+    uint32_t applied = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        if (index >= threads) {
+            // Retired by a configuration: hand the queue over.
+            {
+                std::lock_guard local(workers[index].mutex);
+                for (auto& job : workers[index].jobs) {
+                    injected.push_back(std::move(job));
+                }
+                workers[index].jobs.clear();
+            }
+            workers[index].running = false;
+            --running;
+            lock.unlock();
+            available.notify_all();
+            return;
+        }
+        if (applied != generation) {
+            applied = generation;
+            const auto mask = affinityMask;
+            const auto nice = priority;
+            lock.unlock();
+            applyThreadSettings(mask, nice);
+            lock.lock();
+            continue;
+        }
+        if (queued.load() == 0) {
+            available.wait(lock);
+            continue;
+        }
+        lock.unlock();
+        Job job;
+        if (pop(index, job)) {
+            job();
+            job = nullptr;
+        } else {
+            // Counted but not pushed yet.
+            std::this_thread::yield();
+        }
+        lock.lock();
+    }
+}
+
+} // namespace TW
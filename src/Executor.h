@@ -0,0 +1,99 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace TW {
+
+/// Work-stealing pool of worker threads running all the parallel work of the library: the helpers of `parallelFor`
+/// and the `TWAsyncTask` operations, so that the number of threads stays bounded whatever the number of callers.
+///
+/// Each worker has its own queue: jobs submitted by a worker are pushed to its queue and popped back in LIFO order,
+/// idle workers steal the oldest jobs of the others. Jobs submitted from other threads go to a shared queue.
+/// Workers are started on first use and can be reconfigured at any time, or the jobs can be handed to an executor
+/// of the host application instead. Without thread support (wasm built without pthreads) jobs run in the submitting
+/// call.
+class Executor {
+public:
+    using Job = std::function<void()>;
+    /// Host executor: must run the job with `runHostJob`, exactly once, on any thread.
+    using Host = std::function<void(Job* job)>;
+
+    /// Maximum number of worker threads.
+    static constexpr std::size_t maxThreads = 256;
+
+    /// The executor of the library, with one worker per hardware thread. Never destroyed, so that detached workers
+    /// can outlive static destruction.
+    static Executor& shared();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /// Sets the number of worker threads, 0 for the hardware concurrency, the CPUs they may run on, as a bit mask
+    /// of CPU indices with 0 for no restriction, and their scheduling priority, as a nice value where 0 is the
+    /// default and greater values are lower priorities.
+    /// Extra workers exit after their current job, handing their queue over; affinity and priority are applied
+    /// where the platform supports it, and are otherwise ignored.
+    void configure(std::size_t threads, uint64_t affinityMask, int priority);
+
+    /// Hands the jobs submitted from now on to `host`, or back to the workers if empty.
+    void setHost(Host host);
+
+    /// Runs and frees a job given to the host executor.
+    static void runHostJob(Job* job);
+
+    /// Number of worker threads, or of threads the host executor is expected to use.
+    std::size_t threadCount() const noexcept { return threads.load(std::memory_order_relaxed); }
+
+    /// Queues `job`, starting the workers on first use. Runs it in the calling thread if no worker could be started.
+    /// `job` must not throw.
+    void submit(Job job);
+
+    /// Number of jobs queued and not yet started by a worker.
+    std::size_t pending() const noexcept { return queued.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        bool running = false;
+    };
+
+    explicit Executor(std::size_t threads);
+
+    /// Pops the next job of worker `index`: its own newest job, the oldest shared one, or the oldest job of another.
+    bool pop(std::size_t index, Job& job);
+    void work(std::size_t index);
+    /// Starts the missing workers, the mutex held. Returns whether any worker is running.
+    bool startWorkers();
+
+    std::array<Worker, maxThreads> workers;
+    /// Number of worker slots ever used, the range thieves look into.
+    std::atomic<std::size_t> slots{0};
+    std::atomic<std::size_t> threads;
+    std::atomic<std::size_t> queued{0};
+
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::deque<Job> injected;
+    std::size_t running = 0;
+    uint64_t affinityMask = 0;
+    int priority = 0;
+    /// Incremented on each configuration, for the workers to apply it.
+    uint32_t generation = 0;
+    Host host;
+};
+
+} // namespace TW
@@ -0,0 +1,133 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ExtendedPublicKey.h"
+
+#include "Base58.h"
+#include "BinaryCoding.h"
+#include "Coin.h"
+
+#include <TrustWalletCore/TWHDVersion.h>
+#include <TrezorCrypto/bip32.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+constexpr uint32_t hardenedIndex = 0x80000000;
+constexpr size_t extendedKeySize = 78;
+
+} // namespace
+
+std::optional<ExtendedPublicKey> ExtendedPublicKey::parse(const std::string& extended, TWCoinType coin) {
+    ExtendedPublicKey key;
+    key.coinType = coin;
+    key.curve = TW::curve(coin);
+    switch (key.curve) {
+    case TWCurveSECP256k1:
+        key.params = &secp256k1;
+        break;
+    case TWCurveNIST256p1:
+        key.params = &nist256p1;
+        break;
+    default:
+        return {};
+    }
+
+    const auto nodeData = Base58::decodeCheck(extended, Rust::Base58Alphabet::Bitcoin, TW::base58Hasher(coin));
+    if (nodeData.size() != extendedKeySize) {
+        return {};
+    }
+    const auto version = decode32BE(nodeData.data());
+    if (!TWHDVersionIsPublic(static_cast<TWHDVersion>(version))) {
+        return {};
+    }
+    if (ecdsa_read_pubkey(key.params, nodeData.data() + 45, &key.point) == 0) {
+        return {};
+    }
+    key.nodeDepth = nodeData[4];
+    key.nodeChildNumber = decode32BE(nodeData.data() + 9);
+    std::copy(nodeData.begin() + 13, nodeData.begin() + 13 + 32, key.chainCode.begin());
+    return key;
+}
+
+std::optional<ExtendedPublicKey> ExtendedPublicKey::derive(uint32_t index) const {
+    if ((index & hardenedIndex) != 0) {
+        return {};
+    }
+    ExtendedPublicKey child = *this;
+    if (hdnode_public_ckd_cp(params, &point, chainCode.data(), index, &child.point, child.chainCode.data()) == 0) {
+        return {};
+    }
+    child.nodeDepth = nodeDepth + 1;
+    child.nodeChildNumber = index;
+    return child;
+}
+
+std::optional<ExtendedPublicKey> ExtendedPublicKey::derive(uint32_t change, uint32_t index) const {
+    const auto branch = derive(change);
+    if (!branch) {
+        return {};
+    }
+    return branch->derive(index);
+}
+
+Data ExtendedPublicKey::compressed() const {
+    Data bytes(PublicKey::secp256k1Size);
+    compress_coords(&point, bytes.data());
+    return bytes;
+}
+
+PublicKey ExtendedPublicKey::publicKey() const {
+    const auto baseType = curve == TWCurveSECP256k1 ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeNIST256p1;
+    auto key = PublicKey(compressed(), baseType);
+    const auto keyType = TW::publicKeyType(coinType);
+    if (keyType == TWPublicKeyTypeSECP256k1Extended || keyType == TWPublicKeyTypeNIST256p1Extended) {
+        return key.extended();
+    }
+    return key;
+}
+
+std::string ExtendedPublicKey::address(TWDerivation derivation) const {
+    return TW::deriveAddress(coinType, publicKey(), derivation);
+}
+
+ExtendedPublicKey::AddressIterator ExtendedPublicKey::addresses(uint32_t change, uint32_t start, TWDerivation derivation) const {
+    const auto branch = derive(change);
+    if (!branch || (start & hardenedIndex) != 0) {
+        throw std::invalid_argument("Invalid change or start index");
+    }
+    return AddressIterator(*branch, start, derivation);
+}
+
+std::vector<std::string> ExtendedPublicKey::range(uint32_t change, uint32_t start, uint32_t count, TWDerivation derivation) const {
+    if (static_cast<uint64_t>(start) + count > hardenedIndex) {
+        throw std::invalid_argument("Address index out of range");
+    }
+    auto iterator = addresses(change, start, derivation);
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        result.push_back(iterator.next());
+    }
+    return result;
+}
+
+std::string ExtendedPublicKey::AddressIterator::next() {
+    if ((current & hardenedIndex) != 0) {
+        throw std::out_of_range("No more non-hardened addresses");
+    }
+    const auto child = parent.derive(current);
+    if (!child) {
+        throw std::runtime_error("Child derivation failed");
+    }
+    ++current;
+    return child->address(derivation);
+}
@@ -0,0 +1,94 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWCurve.h>
+#include <TrustWalletCore/TWDerivation.h>
+#include <TrezorCrypto/ecdsa.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// A decoded BIP32 extended public key (xpub, ypub, zpub, ...) for a coin, supporting non-hardened
+/// child derivation and address generation without any private key material.
+/// Only secp256k1 and nist256p1 coins are supported.
+class ExtendedPublicKey {
+public:
+    class AddressIterator;
+
+    /// Parses an extended public key for the given coin.
+    /// Returns nullopt on invalid input or if the coin's curve doesn't support public derivation.
+    static std::optional<ExtendedPublicKey> parse(const std::string& extended, TWCoinType coin);
+
+    TWCoinType coin() const { return coinType; }
+    uint32_t depth() const { return nodeDepth; }
+    uint32_t childNumber() const { return nodeChildNumber; }
+
+    /// Derives the non-hardened child at `index`; returns nullopt for hardened indices.
+    std::optional<ExtendedPublicKey> derive(uint32_t index) const;
+
+    /// Derives the child at `change/index`, the usual layout below an account-level key.
+    std::optional<ExtendedPublicKey> derive(uint32_t change, uint32_t index) const;
+
+    /// Returns the public key, in the representation used by the coin (compressed or extended).
+    PublicKey publicKey() const;
+
+    /// Returns the coin address of this key.
+    std::string address(TWDerivation derivation = TWDerivationDefault) const;
+
+    /// Returns an iterator over the addresses of the `change` branch, starting at address index `start`.
+    /// Throws std::invalid_argument if `change` is a hardened index.
+    AddressIterator addresses(uint32_t change, uint32_t start = 0, TWDerivation derivation = TWDerivationDefault) const;
+
+    /// Returns the addresses `change/start` ..< `change/(start + count)`.
+    /// Throws std::invalid_argument if the range touches hardened indices.
+    std::vector<std::string> range(uint32_t change, uint32_t start, uint32_t count, TWDerivation derivation = TWDerivationDefault) const;
+
+private:
+    ExtendedPublicKey() = default;
+
+    Data compressed() const;
+
+    TWCoinType coinType = TWCoinTypeBitcoin;
+    TWCurve curve = TWCurveSECP256k1;
+    const ecdsa_curve* params = nullptr;
+    curve_point point{};
+    std::array<uint8_t, 32> chainCode{};
+    uint32_t nodeDepth = 0;
+    uint32_t nodeChildNumber = 0;
+};
+
+/// Sequential address generator over the children of an extended public key.
+class ExtendedPublicKey::AddressIterator {
+public:
+    /// Returns the address at the current index and advances to the next one.
+    /// Throws std::out_of_range once the non-hardened index space is exhausted.
+    std::string next();
+
+    /// Returns the index of the address returned by the next call to `next()`.
+    uint32_t index() const { return current; }
+
+private:
+    friend class ExtendedPublicKey;
+    AddressIterator(const ExtendedPublicKey& parent, uint32_t start, TWDerivation derivation)
+        : parent(parent), current(start), derivation(derivation) {}
+
+    ExtendedPublicKey parent;
+    uint32_t current;
+    TWDerivation derivation;
+};
+
+} // namespace TW
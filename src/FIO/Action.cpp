@@ -28,12 +28,26 @@ uint8_t encodeVarInt(uint64_t num, Data& data) {
     return count;
 }
 
+std::size_t varIntSize(uint64_t num) noexcept {
+    std::size_t size = 1;
+    while (num >> 7) {
+        ++size;
+        num >>= 7;
+    }
+    return size;
+}
+
 void encodeString(const string& str, vector<uint8_t>& data) {
     size_t size = str.size();
     encodeVarInt(size, data);
     data.insert(data.end(), str.data(), str.data() + size);
 }
 
+std::size_t Action::serializedSize() const noexcept {
+    return 2 * sizeof(uint64_t) + varIntSize(auth.authArray.size()) + auth.authArray.size() * 2 * sizeof(uint64_t) +
+           varIntSize(actionDataSer.size()) + actionDataSer.size() + 1;
+}
+
 void Action::serialize(Data& out) const {
     EOS::Name(account).serialize(out);
     EOS::Name(name).serialize(out);
@@ -19,6 +19,9 @@ namespace TW::FIO {
 /// \returns the number of bytes written.
 uint8_t encodeVarInt(uint64_t num, Data& data);
 
+/// Number of bytes of a value encoded as a variable-length integer.
+std::size_t varIntSize(uint64_t num) noexcept;
+
 /// Encodes an ASCII string prefixed by the length (varInt)
 void encodeString(const std::string& str, std::vector<uint8_t>& data);
 
@@ -81,6 +84,8 @@ public:
     Data actionDataSer;
 
     void serialize(Data& out) const;
+    /// Size of the binary serialization.
+    std::size_t serializedSize() const noexcept;
 };
 
 /// AddPubAddress action data part.
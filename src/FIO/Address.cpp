@@ -81,7 +81,7 @@ Address::Address(const std::string& string) {
 /// Initializes a FIO address from a public key.
 Address::Address(const PublicKey& publicKey) {
     // copy the raw, compressed key data
-    Data data = publicKey.compressed().bytes;
+    auto data = Data(publicKey.compressed().bytes);
 
     // append the checksum
     uint32_t checksum = createChecksum(data);
@@ -12,13 +12,15 @@
 #include "../HexCoding.h"
 #include "../PrivateKey.h"
 #include "../PublicKey.h"
+#include "../Random.h"
 
-#include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/secp256k1.h>
 #include <TrustWalletCore/TWAESPaddingMode.h>
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace TW::FIO {
 
@@ -26,65 +28,60 @@ using namespace std;
 
 const uint8_t IvSize = 16;
 
-Data Encryption::checkEncrypt(const Data& secret, const Data& message, Data& iv) {
+const size_t MacSize = 32;
+
+/// Splits the 64-byte hash of the secret into the encryption key and the MAC key.
+static std::pair<Data, Data> keysFromSecret(const Data& secret) {
     const Data K = Hash::sha512(secret);
     assert(K.size() == 64);
-    const Data Ke = subData(K, 0, 32); // Encryption key
-    const Data Km = subData(K, 32, 32); // MAC key
+    return {Data(K.begin(), K.begin() + 32), Data(K.begin() + 32, K.end())};
+}
+
+Data Encryption::checkEncrypt(const Data& secret, const Data& message, Data& iv) {
+    const auto [Ke, Km] = keysFromSecret(secret); // Encryption key, MAC key
     if (iv.size() == 0) {
         // fill iv with strong random value
         iv = Data(IvSize);
-        random_buffer(iv.data(), iv.size());
+        Random::fill(iv.data(), iv.size());
     } else {
         if (iv.size() != IvSize) {
             throw std::invalid_argument("invalid IV size");
         }
     }
     assert(iv.size() == IvSize);
-    Data ivOrig(0); // writeable copy
-    TW::append(ivOrig, iv);
+
+    // iv + C + M, the iv is taken before the cipher advances it
+    Data result;
+    result.reserve(IvSize + message.size() + 16 + MacSize);
+    append(result, iv);
 
     // Encrypt. Padding is done (PKCS#7)
-    const Data C = Encrypt::AESCBCEncrypt(Ke, message, iv, TWAESPaddingModePKCS7);
+    append(result, Encrypt::AESCBCEncrypt(Ke, message, iv, TWAESPaddingModePKCS7));
 
     // HMAC. Include in the HMAC input everything that impacts the decryption.
-    Data hmacIn(0);
-    TW::append(hmacIn, ivOrig);
-    TW::append(hmacIn, C);
-    Data M = Hash::hmac256(Km, hmacIn);
-
-    Data result(0); // iv + C + M
-    TW::append(result, hmacIn);
-    TW::append(result, M);
+    append(result, Hash::hmac256(Km, result));
     return result;
 }
 
 Data Encryption::checkDecrypt(const Data& secret, const Data& message) {
-    const Data K = Hash::sha512(secret);
-    assert(K.size() == 64);
-    const Data Ke = subData(K, 0, 32); // Encryption key
-    const Data Km = subData(K, 32, 32); // MAC key
+    const auto [Ke, Km] = keysFromSecret(secret); // Encryption key, MAC key
 
-    if (message.size() < IvSize + 16 + 32) {
+    if (message.size() < IvSize + 16 + MacSize) {
         // minimum size: 16 for iv, 16 for message (padded), 32 for HMAC
         throw std::invalid_argument("Message too short");
     }
-    Data iv = subData(message, 0, IvSize);
-    const Data C = subData(message, IvSize, message.size() - IvSize - 32);
-    const Data M = subData(message, message.size() - 32, 32);
+    const auto macStart = message.end() - MacSize;
 
     // Side-channel attack protection: First verify the HMAC, then and only then proceed to the decryption step
-    Data hmacInput(0);
-    TW::append(hmacInput, iv);
-    TW::append(hmacInput, C);
-    const Data Mc = Hash::hmac256(Km, hmacInput);
-    if (M != Mc) {
+    const Data Mc = Hash::hmac256(Km, Data(message.begin(), macStart));
+    if (!std::equal(Mc.begin(), Mc.end(), macStart)) {
         throw std::invalid_argument("Decrypt failed, HMAC mismatch");
     }
 
     // Decrypt, unpadding is done
-    const Data unencrypted = Encrypt::AESCBCDecrypt(Ke, C, iv, TWAESPaddingModePKCS7);
-    return unencrypted;
+    Data iv(message.begin(), message.begin() + IvSize);
+    const Data C(message.begin() + IvSize, macStart);
+    return Encrypt::AESCBCDecrypt(Ke, C, iv, TWAESPaddingModePKCS7);
 }
 
 Data Encryption::getSharedSecret(const PrivateKey& privateKey1, const PublicKey& publicKey2) {
@@ -108,9 +105,8 @@ Data Encryption::getSharedSecret(const PrivateKey& privateKey1, const PublicKey&
 }
 
 Data Encryption::encrypt(const PrivateKey& privateKey1, const PublicKey& publicKey2, const Data& message, const Data& iv) {
-    const Data sharedSecret = getSharedSecret(privateKey1, publicKey2);
     Data ivCopy(iv); // writeably copy
-    return checkEncrypt(sharedSecret, message, ivCopy);
+    return checkEncrypt(getSharedSecret(privateKey1, publicKey2), message, ivCopy);
 }
 
 Data Encryption::decrypt(const PrivateKey& privateKey1, const PublicKey& publicKey2, const Data& encrypted) {
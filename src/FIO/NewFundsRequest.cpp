@@ -14,6 +14,9 @@ namespace TW::FIO {
 using namespace std;
 
 void NewFundsContent::serialize(Data& out) const {
+    // five empty future_use strings take one byte each
+    out.reserve(out.size() + payeePublicAddress.size() + amount.size() + chainCode.size() + coinSymbol.size() + memo.size() +
+                hash.size() + offlineUrl.size() + 7 * 2 + 5);
     encodeString(payeePublicAddress, out);
     encodeString(amount, out);
     encodeString(chainCode, out);
@@ -16,7 +16,16 @@ void Transaction::set(uint32_t expiryTime, const ChainParams& chainParams) {
     refBlockPrefix = static_cast<uint32_t>(chainParams.refBlockPrefix & 0xffffffff);
 }
 
+std::size_t Transaction::serializedSize() const noexcept {
+    std::size_t size = 4 + 2 + 4 + 4 + varIntSize(actions.size());
+    for (const auto& item : actions) {
+        size += item.serializedSize();
+    }
+    return size;
+}
+
 void Transaction::serialize(Data& out) const {
+    out.reserve(out.size() + serializedSize());
     encode32LE(expiration, out);
     encode16LE(refBlockNumber, out);
     encode32LE(refBlockPrefix, out);
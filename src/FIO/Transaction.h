@@ -27,6 +27,8 @@ public:
     void set(uint32_t expiryTime, const ChainParams& chainParams);
     // Serailize to binary stream
     void serialize(Data& os) const;
+    /// Size of the binary serialization
+    std::size_t serializedSize() const noexcept;
 };
 
 } // namespace TW::FIO
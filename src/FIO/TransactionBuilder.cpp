@@ -201,43 +201,59 @@ string TransactionBuilder::createNewFundsRequest(const Address& address, const P
         const ChainParams& chainParams, uint64_t fee, const string& walletTpId, uint32_t expiryTime,
         const Data& iv) {
 
-    const auto* const apiName = "newfundsreq";
-
     // use coinSymbol for chainCode as well
-    NewFundsContent newFundsContent { payeePublicAddress, amount, coinSymbol, coinSymbol, memo, hash, offlineUrl };
-    // serialize and encrypt
-    Data serContent;
-    newFundsContent.serialize(serContent);
+    const NewFundsContent newFundsContent { payeePublicAddress, amount, coinSymbol, coinSymbol, memo, hash, offlineUrl };
+    return createNewFundsRequests(address, privateKey, payerFioName, payerFioAddress, payeeFioName, {newFundsContent},
+        chainParams, fee, walletTpId, expiryTime, iv).front();
+}
 
-    Address payerAddress(payerFioAddress);
-    PublicKey payerPublicKey = payerAddress.publicKey();
-    // encrypt and encode
-    const string encodedEncryptedContent = Encryption::encode(Encryption::encrypt(privateKey, payerPublicKey, serContent, iv));
+vector<string> TransactionBuilder::createNewFundsRequests(const Address& address, const PrivateKey& privateKey,
+        const string& payerFioName, const string& payerFioAddress, const string& payeeFioName, const vector<NewFundsContent>& contents,
+        const ChainParams& chainParams, uint64_t fee, const string& walletTpId, uint32_t expiryTime,
+        const Data& iv) {
 
-    string actor = Actor::actor(address);
-    NewFundsRequestData nfData(payerFioName, payeeFioName, encodedEncryptedContent, fee, walletTpId, actor);
-    Data serData;
-    nfData.serialize(serData);
-    
-    Action action;
-    action.account = ContractPayRequest;
-    action.name = apiName;
-    action.actionDataSer = serData;
-    action.auth.authArray.push_back(Authorization{actor, AuthrizationActive});
+    const auto* const apiName = "newfundsreq";
 
-    Transaction tx;
+    // the shared secret (an EC point multiplication) is the same for all requests to the payer
+    Address payerAddress(payerFioAddress);
+    const Data sharedSecret = Encryption::getSharedSecret(privateKey, payerAddress.publicKey());
+
+    const string actor = Actor::actor(address);
     expirySetDefaultIfNeeded(expiryTime);
-    tx.set(expiryTime, chainParams);
-    tx.actions.push_back(action);
-    Data serTx;
-    tx.serialize(serTx);
 
-    return signAdnBuildTx(chainParams.chainId, serTx, privateKey);
+    vector<string> result;
+    result.reserve(contents.size());
+    Data serContent;
+    for (const auto& content : contents) {
+        // serialize and encrypt
+        serContent.clear();
+        content.serialize(serContent);
+        Data ivCopy(iv); // writeable copy
+        const string encodedEncryptedContent = Encryption::encode(Encryption::checkEncrypt(sharedSecret, serContent, ivCopy));
+
+        NewFundsRequestData nfData(payerFioName, payeeFioName, encodedEncryptedContent, fee, walletTpId, actor);
+        Action action;
+        action.account = ContractPayRequest;
+        action.name = apiName;
+        nfData.serialize(action.actionDataSer);
+        action.auth.authArray.push_back(Authorization{actor, AuthrizationActive});
+
+        Transaction tx;
+        tx.set(expiryTime, chainParams);
+        tx.actions.push_back(std::move(action));
+        Data serTx;
+        tx.serialize(serTx);
+
+        result.push_back(signAdnBuildTx(chainParams.chainId, serTx, privateKey));
+    }
+    return result;
 }
 
 string TransactionBuilder::signAdnBuildTx(const Data& chainId, const Data& packedTx, const PrivateKey& privateKey) {
     // create signature
-    Data sigBuf(chainId);
+    Data sigBuf;
+    sigBuf.reserve(chainId.size() + packedTx.size() + 32);
+    append(sigBuf, chainId);
     append(sigBuf, packedTx);
     append(sigBuf, TW::Data(32)); // context_free
     string signature = Signer::signatureToBase58(Signer::signData(privateKey, sigBuf));
@@ -8,6 +8,7 @@
 
 #include "Transaction.h"
 #include "Address.h"
+#include "NewFundsRequest.h"
 #include "../proto/FIO.pb.h"
 
 #include "Data.h"
@@ -115,6 +116,16 @@ public:
         const ChainParams& chainParams, uint64_t fee, const std::string& walletTpId, uint32_t expiryTime,
         const Data& iv);
 
+    /// Create several signed NewFundsRequest transactions from the same payee to the same payer, returned as json strings
+    /// in the order of the contents.  The encryption key is derived once for all requests.
+    /// Parameters are as in createNewFundsRequest; each content is sent as is (chainCode is not filled from coinSymbol).
+    /// @expiryTime Expiry for all the messages, can be 0, then it is taken from current time with default expiry
+    static std::vector<std::string> createNewFundsRequests(const Address& address, const PrivateKey& privateKey,
+        const std::string& payerFioName, const std::string& payerFioAddress, const std::string& payeeFioName,
+        const std::vector<NewFundsContent>& contents,
+        const ChainParams& chainParams, uint64_t fee, const std::string& walletTpId, uint32_t expiryTime,
+        const Data& iv);
+
     /// Used internally.  Creates signatures and json with transaction.
     static std::string signAdnBuildTx(const Data& chainId, const Data& packedTx, const PrivateKey& privateKey);
 
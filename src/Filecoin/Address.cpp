@@ -9,14 +9,32 @@
 #include <climits>
 
 #include "../Base32.h"
+#include "../Hash.h"
 
 namespace TW::Filecoin {
 
-static const char BASE32_ALPHABET_FILECOIN[] = "abcdefghijklmnopqrstuvwxyz234567";
+static constexpr Base32::Alphabet BASE32_ALPHABET_FILECOIN{"abcdefghijklmnopqrstuvwxyz234567"};
 static constexpr std::size_t checksumSize = 4;
 
 static constexpr uint64_t charMask = 0x80;
 
+/// Appends the unpadded base32 encoding of `data` (in the Filecoin alphabet) to `out`.
+static void appendBase32(std::string& out, const Data& data) {
+    const auto offset = out.size();
+    out.resize(offset + Base32::encodedSize(data.size()));
+    Base32::encodeInto(data, out.data() + offset, BASE32_ALPHABET_FILECOIN);
+}
+
+/// Decodes the unpadded base32 (in the Filecoin alphabet) `string` from position `pos`.
+static bool decodeBase32(const std::string& string, std::size_t pos, Data& decoded) {
+    const auto encoded = std::string_view(string).substr(pos);
+    if (encoded.empty()) {
+        return false;
+    }
+    decoded.resize(Base32::decodedSize(encoded.size()));
+    return Base32::decodeInto(encoded, decoded.data(), BASE32_ALPHABET_FILECOIN);
+}
+
 /// Parses the given `string` as an ActorID.
 /// Please note `string` must not contain any prefixes.
 static bool parseActorID(const std::string& string, uint64_t& actorID) {
@@ -195,7 +213,7 @@ MaybeAddress Address::fromString(const std::string& string) {
     }
 
     Data decoded;
-    if (!Base32::decode(string.substr(payloadPos), decoded, BASE32_ALPHABET_FILECOIN)) {
+    if (!decodeBase32(string, payloadPos, decoded)) {
         return std::nullopt;
     }
     if (decoded.size() < checksumSize) {
@@ -234,7 +252,7 @@ Address Address::delegatedAddress(const PublicKey& publicKey) {
         throw std::invalid_argument("Ethereum::Address needs an extended SECP256k1 public key.");
     }
 
-    const auto data = publicKey.hash({}, Hash::HasherKeccak256, true);
+    const auto data = publicKey.hash<Hash::HasherKeccak256>(true);
     Data payload(data.end() - 20, data.end());
 
     return Address(Type::DELEGATED, ETHEREUM_ADDRESS_MANAGER_ACTOR_ID, std::move(payload));
@@ -301,10 +319,12 @@ std::string Address::string() const {
     // Append Blake2b checksum
     Data checksum = calculateChecksum(type, actorID, payload);
 
-    Data toEncode = payload;
+    Data toEncode;
+    toEncode.reserve(payload.size() + checksum.size());
+    append(toEncode, payload);
     append(toEncode, checksum);
 
-    s.append(Base32::encode(toEncode, BASE32_ALPHABET_FILECOIN));
+    appendBase32(s, toEncode);
     return s;
 }
 
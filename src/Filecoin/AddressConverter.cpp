@@ -26,17 +26,13 @@ MaybeAddressString AddressConverter::convertToEthereumString(const std::string&
 MaybeEthAddress AddressConverter::convertToEthereum(const Address& filecoinAddress) {
     switch (filecoinAddress.type) {
         case Address::Type::ID: {
-            Data payload(Ethereum::Address::size - ACTOR_ID_ENCODED_LEN, 0);
+            // 0xff, zeros, and the big endian actor ID
+            Data payload(Ethereum::Address::size, 0);
             payload[0] = 0xFF;
-
-            Data encodedActorID;
-            encodedActorID.reserve(ACTOR_ID_ENCODED_LEN);
-            encode64BE(filecoinAddress.actorID, encodedActorID);
-
-            append(payload, encodedActorID);
-
-            Ethereum::Address ethAddr(payload);
-            return ethAddr;
+            for (std::size_t i = 0; i < ACTOR_ID_ENCODED_LEN; ++i) {
+                payload[Ethereum::Address::size - 1 - i] = static_cast<byte>(filecoinAddress.actorID >> (8 * i));
+            }
+            return Ethereum::Address(payload);
         }
         case Address::Type::DELEGATED: {
             if (filecoinAddress.actorID != Address::ETHEREUM_ADDRESS_MANAGER_ACTOR_ID) {
@@ -47,8 +43,7 @@ MaybeEthAddress AddressConverter::convertToEthereum(const Address& filecoinAddre
                 return std::nullopt;
             }
 
-            Ethereum::Address ethAddr(filecoinAddress.payload);
-            return ethAddr;
+            return Ethereum::Address(filecoinAddress.payload);
         }
         default:
             return std::nullopt;
@@ -4,11 +4,10 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-#include <google/protobuf/util/json_util.h>
-
 #include "AddressConverter.h"
 #include "Ethereum/Transaction.h"
 #include "Signer.h"
+#include "../proto/Filecoin.json.pb.h"
 
 namespace TW::Filecoin {
 
@@ -38,14 +37,13 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 }
 
 Data Signer::sign(const PrivateKey& privateKey, Transaction& transaction) noexcept {
-    Data toSign = Hash::blake2b(transaction.cid(), 32);
-    auto signature = privateKey.sign(toSign, TWCurveSECP256k1);
+    auto signature = privateKey.sign(transaction.preHash(), TWCurveSECP256k1);
     return Data(signature.begin(), signature.end());
 }
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return output.json();
@@ -8,6 +8,8 @@
 #include <nlohmann/json.hpp>
 #include "Base64.h"
 
+#include <array>
+
 namespace TW::Filecoin {
 
 using json = nlohmann::json;
@@ -24,7 +26,7 @@ Data encodeBigInt(const uint256_t& value) {
 }
 
 // cidPrefix is the CID + Multihash prefix of transaction CIDs.
-const Data cidPrefix = {
+static constexpr std::array<byte, 6> cidPrefix = {
     // CIDv1 with CBOR codec
     0x01,
     0x71,
@@ -35,32 +37,57 @@ const Data cidPrefix = {
     0x20,
 };
 
+static constexpr std::size_t cidHashSize = 32;
+
 Cbor::Encode Transaction::message() const {
-    Cbor::Encode cborGasLimit = gasLimit >= 0 ? Cbor::Encode::uint((uint64_t)gasLimit)
-                                              : Cbor::Encode::negInt((uint64_t)(-gasLimit - 1));
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(0),                             // version
-        Cbor::Encode::bytes(to.toBytes()),                   // to address
-        Cbor::Encode::bytes(from.toBytes()),                 // from address
-        Cbor::Encode::uint(nonce),                         // nonce
-        Cbor::Encode::bytes(encodeBigInt(value)),            // value
-        cborGasLimit,                                            // gas limit
-        Cbor::Encode::bytes(encodeBigInt(gasFeeCap)),  // gas fee cap
-        Cbor::Encode::bytes(encodeBigInt(gasPremium)), // gas premium
-        Cbor::Encode::uint(method),                        // abi.MethodNum
-        Cbor::Encode::bytes(params)                          // params
-    });
+    return Cbor::Encode::fromRaw(encoded());
+}
+
+Data Transaction::encoded() const {
+    const auto toBytes = to.toBytes();
+    const auto fromBytes = from.toBytes();
+    const auto valueBytes = encodeBigInt(value);
+    const auto gasFeeCapBytes = encodeBigInt(gasFeeCap);
+    const auto gasPremiumBytes = encodeBigInt(gasPremium);
+    // a negative gas limit is written with negInt(-gasLimit - 1)
+    const auto gasLimitValue = gasLimit >= 0 ? static_cast<uint64_t>(gasLimit) : static_cast<uint64_t>(-(gasLimit + 1));
+
+    const auto bytesSize = [](const Data& data) { return Cbor::Writer::headerSize(data.size()) + data.size(); };
+    const auto size = 1 + 1 + bytesSize(toBytes) + bytesSize(fromBytes) + Cbor::Writer::headerSize(nonce) +
+                      bytesSize(valueBytes) + Cbor::Writer::headerSize(gasLimitValue) + bytesSize(gasFeeCapBytes) +
+                      bytesSize(gasPremiumBytes) + Cbor::Writer::headerSize(method) + bytesSize(params);
+
+    auto writer = Cbor::Writer(size);
+    writer.array(10)
+        .uint(0)            // version
+        .bytes(toBytes)     // to address
+        .bytes(fromBytes)   // from address
+        .uint(nonce)        // nonce
+        .bytes(valueBytes); // value
+    if (gasLimit >= 0) {
+        writer.uint(gasLimitValue);
+    } else {
+        writer.negInt(gasLimitValue);
+    }
+    writer.bytes(gasFeeCapBytes) // gas fee cap
+        .bytes(gasPremiumBytes)  // gas premium
+        .uint(method)            // abi.MethodNum
+        .bytes(params);          // params
+    return writer.release();
 }
 
 Data Transaction::cid() const {
     Data cid;
-    cid.reserve(cidPrefix.size() + 32);
+    cid.reserve(cidPrefix.size() + cidHashSize);
     cid.insert(cid.end(), cidPrefix.begin(), cidPrefix.end());
-    Data hash = Hash::blake2b(message().encoded(), 32);
-    cid.insert(cid.end(), hash.begin(), hash.end());
+    append(cid, Hash::blake2b(encoded(), cidHashSize));
     return cid;
 }
 
+Data Transaction::preHash() const {
+    return Hash::blake2b(cid(), cidHashSize);
+}
+
 std::string Transaction::serialize(SignatureType signatureType, Data& signature) const {
     // clang-format off
     json message = {
@@ -66,9 +66,15 @@ class Transaction {
     // message returns the CBOR encoding of the Filecoin Message to be signed.
     Cbor::Encode message() const;
 
+    // encoded returns the CBOR encoded bytes of the Filecoin Message, written in one pass.
+    Data encoded() const;
+
     // cid returns the raw Filecoin message CID (excluding the signature).
     Data cid() const;
 
+    // preHash returns the hash of the CID, to be signed.
+    Data preHash() const;
+
     // serialize returns json ready for MpoolPush rpc
     std::string serialize(SignatureType signatureType, Data& signature) const;
 };
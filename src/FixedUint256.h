@@ -0,0 +1,258 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace TW {
+
+/// Unsigned 256-bit integer held in four 64-bit limbs.
+///
+/// Trivially copyable, with constexpr arithmetic modulo 2^256 and big endian loads and stores straight from and
+/// into byte spans, for encoding hot paths. `uint256_t` stays the type of public APIs; `toFixed` and `toBoost`
+/// in uint256.h convert at the boundaries.
+class FixedUint256 {
+public:
+    /// Limbs in little endian order: `limbs[0]` holds the least significant 64 bits.
+    std::array<uint64_t, 4> limbs{};
+
+    constexpr FixedUint256() noexcept = default;
+    constexpr explicit FixedUint256(uint64_t value) noexcept : limbs{value, 0, 0, 0} {}
+
+    /// Loads a big endian number. Of a longer input only the rightmost 32 bytes are used, like `load`.
+    static constexpr FixedUint256 loadBE(std::span<const byte> bytes) noexcept {
+        if (bytes.size() > 32) {
+            bytes = bytes.subspan(bytes.size() - 32);
+        }
+        FixedUint256 result;
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            const auto position = bytes.size() - 1 - i;
+            result.limbs[position / 8] |= uint64_t(bytes[i]) << (8 * (position % 8));
+        }
+        return result;
+    }
+
+    /// Writes the 32-byte big endian representation.
+    constexpr void storeBE(std::span<byte, 32> out) const noexcept {
+        for (std::size_t i = 0; i < 32; ++i) {
+            out[31 - i] = byteAt(i);
+        }
+    }
+
+    /// Appends the minimal big endian representation, left padded with zeros to `minLength` bytes, like `store`.
+    void appendBE(Data& out, std::size_t minLength = 0) const {
+        const auto length = std::max(byteLength(), minLength);
+        const auto offset = out.size();
+        out.resize(offset + length, 0);
+        for (std::size_t i = 0; i < std::min<std::size_t>(length, 32); ++i) {
+            out[offset + length - 1 - i] = byteAt(i);
+        }
+    }
+
+    /// Returns the byte at `index`, counted from the least significant one.
+    constexpr byte byteAt(std::size_t index) const noexcept {
+        return static_cast<byte>(limbs[index / 8] >> (8 * (index % 8)));
+    }
+
+    constexpr bool isZero() const noexcept {
+        return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0;
+    }
+
+    /// Number of significant bits, 0 for zero.
+    constexpr std::size_t bitLength() const noexcept {
+        for (std::size_t i = limbs.size(); i > 0; --i) {
+            if (limbs[i - 1] != 0) {
+                return 64 * i - static_cast<std::size_t>(std::countl_zero(limbs[i - 1]));
+            }
+        }
+        return 0;
+    }
+
+    /// Number of bytes of the minimal big endian representation, 0 for zero.
+    constexpr std::size_t byteLength() const noexcept {
+        return (bitLength() + 7) / 8;
+    }
+
+    /// Divides by `divisor` in place and returns the remainder.
+    constexpr uint32_t divideBy(uint32_t divisor) noexcept {
+        uint64_t remainder = 0;
+        for (std::size_t i = limbs.size(); i > 0; --i) {
+            auto& limb = limbs[i - 1];
+            const uint64_t high = (remainder << 32) | (limb >> 32);
+            remainder = high % divisor;
+            const uint64_t low = (remainder << 32) | (limb & 0xffffffff);
+            remainder = low % divisor;
+            limb = ((high / divisor) << 32) | (low / divisor);
+        }
+        return static_cast<uint32_t>(remainder);
+    }
+
+    /// Decimal representation.
+    std::string toString() const {
+        if (isZero()) {
+            return "0";
+        }
+        // Nine digits at a time; 2^256 has 78 digits.
+        std::array<char, 81> digits{};
+        auto position = digits.size();
+        auto value = *this;
+        while (!value.isZero()) {
+            auto chunk = value.divideBy(1000000000);
+            for (int i = 0; i < 9; ++i) {
+                digits[--position] = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        const auto first = std::find_if(digits.begin() + position, digits.end(), [](char c) { return c != '0'; });
+        return {first, digits.end()};
+    }
+
+    friend constexpr bool operator==(const FixedUint256&, const FixedUint256&) noexcept = default;
+
+    friend constexpr std::strong_ordering operator<=>(const FixedUint256& lhs, const FixedUint256& rhs) noexcept {
+        for (std::size_t i = lhs.limbs.size(); i > 0; --i) {
+            if (lhs.limbs[i - 1] != rhs.limbs[i - 1]) {
+                return lhs.limbs[i - 1] <=> rhs.limbs[i - 1];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+    friend constexpr FixedUint256 operator+(const FixedUint256& lhs, const FixedUint256& rhs) noexcept {
+        FixedUint256 result;
+        uint64_t carry = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            const auto sum = lhs.limbs[i] + rhs.limbs[i];
+            result.limbs[i] = sum + carry;
+            carry = uint64_t(sum < lhs.limbs[i]) | uint64_t(result.limbs[i] < sum);
+        }
+        return result;
+    }
+
+    friend constexpr FixedUint256 operator-(const FixedUint256& lhs, const FixedUint256& rhs) noexcept {
+        FixedUint256 result;
+        uint64_t borrow = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            const auto difference = lhs.limbs[i] - rhs.limbs[i];
+            result.limbs[i] = difference - borrow;
+            borrow = uint64_t(lhs.limbs[i] < rhs.limbs[i]) | uint64_t(difference < borrow);
+        }
+        return result;
+    }
+
+    friend constexpr FixedUint256 operator*(const FixedUint256& lhs, const FixedUint256& rhs) noexcept {
+        FixedUint256 result;
+        for (std::size_t i = 0; i < 4; ++i) {
+            uint64_t carry = 0;
+            for (std::size_t j = 0; i + j < 4; ++j) {
+                uint64_t high = 0;
+                const auto low = multiply(lhs.limbs[i], rhs.limbs[j], high);
+                auto sum = result.limbs[i + j] + low;
+                high += sum < low;
+                sum += carry;
+                high += sum < carry;
+                result.limbs[i + j] = sum;
+                carry = high;
+            }
+        }
+        return result;
+    }
+
+    friend constexpr FixedUint256 operator<<(const FixedUint256& value, unsigned shift) noexcept {
+        FixedUint256 result;
+        if (shift >= 256) {
+            return result;
+        }
+        const auto limbShift = shift / 64;
+        const auto bitShift = shift % 64;
+        for (std::size_t i = 4; i-- > limbShift;) {
+            result.limbs[i] = value.limbs[i - limbShift] << bitShift;
+            if (bitShift != 0 && i > limbShift) {
+                result.limbs[i] |= value.limbs[i - limbShift - 1] >> (64 - bitShift);
+            }
+        }
+        return result;
+    }
+
+    friend constexpr FixedUint256 operator>>(const FixedUint256& value, unsigned shift) noexcept {
+        FixedUint256 result;
+        if (shift >= 256) {
+            return result;
+        }
+        const auto limbShift = shift / 64;
+        const auto bitShift = shift % 64;
+        for (std::size_t i = 0; i + limbShift < 4; ++i) {
+            result.limbs[i] = value.limbs[i + limbShift] >> bitShift;
+            if (bitShift != 0 && i + limbShift + 1 < 4) {
+                result.limbs[i] |= value.limbs[i + limbShift + 1] << (64 - bitShift);
+            }
+        }
+        return result;
+    }
+
+    friend constexpr FixedUint256 operator&(FixedUint256 lhs, const FixedUint256& rhs) noexcept {
+        for (std::size_t i = 0; i < 4; ++i) {
+            lhs.limbs[i] &= rhs.limbs[i];
+        }
+        return lhs;
+    }
+
+    friend constexpr FixedUint256 operator|(FixedUint256 lhs, const FixedUint256& rhs) noexcept {
+        for (std::size_t i = 0; i < 4; ++i) {
+            lhs.limbs[i] |= rhs.limbs[i];
+        }
+        return lhs;
+    }
+
+    friend constexpr FixedUint256 operator^(FixedUint256 lhs, const FixedUint256& rhs) noexcept {
+        for (std::size_t i = 0; i < 4; ++i) {
+            lhs.limbs[i] ^= rhs.limbs[i];
+        }
+        return lhs;
+    }
+
+    friend constexpr FixedUint256 operator~(FixedUint256 value) noexcept {
+        for (auto& limb : value.limbs) {
+            limb = ~limb;
+        }
+        return value;
+    }
+
+    constexpr FixedUint256& operator+=(const FixedUint256& other) noexcept { return *this = *this + other; }
+    constexpr FixedUint256& operator-=(const FixedUint256& other) noexcept { return *this = *this - other; }
+    constexpr FixedUint256& operator*=(const FixedUint256& other) noexcept { return *this = *this * other; }
+    constexpr FixedUint256& operator<<=(unsigned shift) noexcept { return *this = *this << shift; }
+    constexpr FixedUint256& operator>>=(unsigned shift) noexcept { return *this = *this >> shift; }
+
+private:
+    /// Full 64 x 64 -> 128 bit product, in 32-bit halves so that it stays portable and constexpr.
+    static constexpr uint64_t multiply(uint64_t a, uint64_t b, uint64_t& high) noexcept {
+        const uint64_t aLow = a & 0xffffffff, aHigh = a >> 32;
+        const uint64_t bLow = b & 0xffffffff, bHigh = b >> 32;
+        const auto lowLow = aLow * bLow;
+        const auto lowHigh = aLow * bHigh;
+        const auto highLow = aHigh * bLow;
+        const auto middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+        high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+        return (middle << 32) | (lowLow & 0xffffffff);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<FixedUint256>);
+static_assert(sizeof(FixedUint256) == 32);
+
+} // namespace TW
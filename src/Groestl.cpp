@@ -0,0 +1,266 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Groestl.h"
+#include "CpuFeatures.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#define TW_GROESTL_AES_NI 1
+#endif
+
+namespace TW::Groestl {
+
+#if defined(TW_GROESTL_AES_NI)
+
+namespace {
+
+// Groestl-512 works on a state of 8 rows by 16 columns of bytes, serialized column by column.
+// Each row is kept in a register: the S-box is AES's, computed by AESENCLAST with a zero key,
+// and its AES ShiftRows is undone in the same byte shuffle as the Groestl ShiftBytes of the row.
+
+#define TW_GROESTL_TARGET __attribute__((target("aes,ssse3")))
+
+constexpr std::size_t blockSize = 128;
+constexpr int rounds = 14;
+
+/// The 8 rows of a state, one per register.
+struct Rows {
+    __m128i rows[8];
+
+    __m128i& operator[](std::size_t i) noexcept { return rows[i]; }
+    const __m128i& operator[](std::size_t i) const noexcept { return rows[i]; }
+};
+using Shuffle = std::array<byte, 16>;
+
+/// Position of byte `index` of an AES state after ShiftRows.
+constexpr std::size_t aesShiftRowsPosition(std::size_t index) {
+    const auto row = index % 4;
+    return 4 * ((index / 4 + 4 - row) % 4) + row;
+}
+
+/// Shuffles of AESENCLAST output rows: undoes ShiftRows and rotates the row left by `shifts[row]`.
+constexpr std::array<Shuffle, 8> rowShuffles(const std::array<std::size_t, 8>& shifts) {
+    std::array<Shuffle, 8> shuffles{};
+    for (std::size_t row = 0; row < 8; ++row) {
+        for (std::size_t column = 0; column < 16; ++column) {
+            shuffles[row][column] = static_cast<byte>(aesShiftRowsPosition((column + shifts[row]) % 16));
+        }
+    }
+    return shuffles;
+}
+
+alignas(16) constexpr auto shuffleP = rowShuffles({0, 1, 2, 3, 4, 5, 6, 11});
+alignas(16) constexpr auto shuffleQ = rowShuffles({1, 3, 5, 11, 0, 2, 4, 6});
+
+TW_GROESTL_TARGET inline __m128i loadShuffle(const Shuffle& shuffle) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle.data()));
+}
+
+/// Multiplication by 2 in GF(2^8) of every byte.
+TW_GROESTL_TARGET inline __m128i times2(__m128i x) {
+    const auto overflow = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+    return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(overflow, _mm_set1_epi8(0x1b)));
+}
+
+/// MixBytes, b[i] = 2a[i] + 2a[i+1] + 3a[i+2] + 4a[i+3] + 5a[i+4] + 3a[i+5] + 5a[i+6] + 7a[i+7],
+/// split as the sum of the terms with factors 1, 2 and 4.
+TW_GROESTL_TARGET inline void mixBytes(Rows& a) {
+    Rows b;
+    for (std::size_t i = 0; i < 8; ++i) {
+        const auto& a0 = a[i];
+        const auto& a1 = a[(i + 1) % 8];
+        const auto& a2 = a[(i + 2) % 8];
+        const auto& a3 = a[(i + 3) % 8];
+        const auto& a4 = a[(i + 4) % 8];
+        const auto& a5 = a[(i + 5) % 8];
+        const auto& a6 = a[(i + 6) % 8];
+        const auto& a7 = a[(i + 7) % 8];
+        const auto a57 = _mm_xor_si128(a5, a7);
+        const auto a47 = _mm_xor_si128(a4, a7);
+        const auto by1 = _mm_xor_si128(_mm_xor_si128(a2, a6), _mm_xor_si128(a4, a57));
+        const auto by2 = _mm_xor_si128(_mm_xor_si128(a0, a1), _mm_xor_si128(a2, a57));
+        const auto by4 = _mm_xor_si128(_mm_xor_si128(a3, a6), a47);
+        b[i] = _mm_xor_si128(by1, times2(_mm_xor_si128(by2, times2(by4))));
+    }
+    a = b;
+}
+
+/// One round of P or Q: AddRoundConstant, SubBytes, ShiftBytes and MixBytes.
+TW_GROESTL_TARGET inline void round(Rows& state, const Rows& constants, const std::array<Shuffle, 8>& shuffles) {
+    const auto zero = _mm_setzero_si128();
+    for (std::size_t i = 0; i < 8; ++i) {
+        const auto substituted = _mm_aesenclast_si128(_mm_xor_si128(state[i], constants[i]), zero);
+        state[i] = _mm_shuffle_epi8(substituted, loadShuffle(shuffles[i]));
+    }
+    mixBytes(state);
+}
+
+/// Round constants of P (row 0) and Q (all rows, row 7 with the column numbers).
+struct RoundConstants {
+    std::array<Rows, rounds> p;
+    std::array<Rows, rounds> q;
+};
+
+TW_GROESTL_TARGET RoundConstants makeRoundConstants() {
+    RoundConstants constants;
+    const auto columns = _mm_setr_epi8(0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, char(0x80), char(0x90), char(0xa0), char(0xb0), char(0xc0), char(0xd0), char(0xe0), char(0xf0));
+    const auto ones = _mm_set1_epi8(char(0xff));
+    for (int r = 0; r < rounds; ++r) {
+        const auto roundColumns = _mm_xor_si128(columns, _mm_set1_epi8(static_cast<char>(r)));
+        for (std::size_t i = 0; i < 8; ++i) {
+            constants.p[r][i] = _mm_setzero_si128();
+            constants.q[r][i] = ones;
+        }
+        constants.p[r][0] = roundColumns;
+        constants.q[r][7] = _mm_xor_si128(roundColumns, ones);
+    }
+    return constants;
+}
+
+const RoundConstants& roundConstants() {
+    static const RoundConstants constants = makeRoundConstants();
+    return constants;
+}
+
+/// Transposes 8 registers of 8 16-bit words.
+TW_GROESTL_TARGET inline void transpose16(Rows& x) {
+    const auto a0 = _mm_unpacklo_epi16(x[0], x[1]);
+    const auto a1 = _mm_unpackhi_epi16(x[0], x[1]);
+    const auto a2 = _mm_unpacklo_epi16(x[2], x[3]);
+    const auto a3 = _mm_unpackhi_epi16(x[2], x[3]);
+    const auto a4 = _mm_unpacklo_epi16(x[4], x[5]);
+    const auto a5 = _mm_unpackhi_epi16(x[4], x[5]);
+    const auto a6 = _mm_unpacklo_epi16(x[6], x[7]);
+    const auto a7 = _mm_unpackhi_epi16(x[6], x[7]);
+    const auto b0 = _mm_unpacklo_epi32(a0, a2);
+    const auto b1 = _mm_unpackhi_epi32(a0, a2);
+    const auto b2 = _mm_unpacklo_epi32(a1, a3);
+    const auto b3 = _mm_unpackhi_epi32(a1, a3);
+    const auto b4 = _mm_unpacklo_epi32(a4, a6);
+    const auto b5 = _mm_unpackhi_epi32(a4, a6);
+    const auto b6 = _mm_unpacklo_epi32(a5, a7);
+    const auto b7 = _mm_unpackhi_epi32(a5, a7);
+    x[0] = _mm_unpacklo_epi64(b0, b4);
+    x[1] = _mm_unpackhi_epi64(b0, b4);
+    x[2] = _mm_unpacklo_epi64(b1, b5);
+    x[3] = _mm_unpackhi_epi64(b1, b5);
+    x[4] = _mm_unpacklo_epi64(b2, b6);
+    x[5] = _mm_unpackhi_epi64(b2, b6);
+    x[6] = _mm_unpacklo_epi64(b3, b7);
+    x[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/// Reads a serialized block into rows. Each 16-byte load holds two columns; interleaving them makes
+/// every 16-bit word one row of the two columns, and the word transpose gathers the rows.
+TW_GROESTL_TARGET inline Rows loadRows(const byte* block) {
+    const auto interleave = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+    Rows rows;
+    for (std::size_t i = 0; i < 8; ++i) {
+        rows[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i)), interleave);
+    }
+    transpose16(rows);
+    return rows;
+}
+
+/// Serializes rows, the inverse of `loadRows`.
+TW_GROESTL_TARGET inline void storeRows(Rows rows, byte* block) {
+    const auto deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    transpose16(rows);
+    for (std::size_t i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(block + 16 * i), _mm_shuffle_epi8(rows[i], deinterleave));
+    }
+}
+
+/// Compression function, h = P(h + m) + Q(m) + h. P and Q are interleaved, as they are independent.
+TW_GROESTL_TARGET void compress(Rows& h, const byte* block, const RoundConstants& constants) {
+    auto q = loadRows(block);
+    Rows p;
+    for (std::size_t i = 0; i < 8; ++i) {
+        p[i] = _mm_xor_si128(h[i], q[i]);
+    }
+    for (int r = 0; r < rounds; ++r) {
+        round(p, constants.p[r], shuffleP);
+        round(q, constants.q[r], shuffleQ);
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = _mm_xor_si128(h[i], _mm_xor_si128(p[i], q[i]));
+    }
+}
+
+TW_GROESTL_TARGET void hashBlocks(const byte* data, std::size_t size, byte* out) {
+    const auto& constants = roundConstants();
+
+    // the initial value is the digest size in bits, in the last bytes of the serialized state
+    Rows h;
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = _mm_setzero_si128();
+    }
+    h[6] = _mm_insert_epi16(h[6], 8 * digest512Size, 7);
+
+    const auto blocks = size / blockSize;
+    for (std::size_t i = 0; i < blocks; ++i) {
+        compress(h, data + blockSize * i, constants);
+    }
+
+    // padding: 0x80, zeros and the number of blocks as a big endian 64-bit number, in one or two blocks
+    std::array<byte, 2 * blockSize> last{};
+    const auto remaining = size - blockSize * blocks;
+    std::memcpy(last.data(), data + blockSize * blocks, remaining);
+    last[remaining] = 0x80;
+    const std::size_t lastBlocks = remaining < blockSize - 8 ? 1 : 2;
+    auto count = static_cast<uint64_t>(blocks + lastBlocks);
+    for (auto i = blockSize * lastBlocks - 1; count != 0; --i, count >>= 8) {
+        last[i] = static_cast<byte>(count);
+    }
+    for (std::size_t i = 0; i < lastBlocks; ++i) {
+        compress(h, last.data() + blockSize * i, constants);
+    }
+
+    // output transformation P(h) + h, truncated to its last bytes
+    auto p = h;
+    for (int r = 0; r < rounds; ++r) {
+        round(p, constants.p[r], shuffleP);
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        h[i] = _mm_xor_si128(h[i], p[i]);
+    }
+    std::array<byte, blockSize> state;
+    storeRows(h, state.data());
+    std::memcpy(out, state.data() + blockSize - digest512Size, digest512Size);
+}
+
+} // namespace
+
+bool hardwareSupported() noexcept {
+    return CpuFeatures::aesni();
+}
+
+bool hash512(const byte* data, std::size_t size, byte* out) noexcept {
+    if (!hardwareSupported()) {
+        return false;
+    }
+    hashBlocks(data, size, out);
+    return true;
+}
+
+#else
+
+bool hardwareSupported() noexcept {
+    return false;
+}
+
+bool hash512([[maybe_unused]] const byte* data, [[maybe_unused]] std::size_t size, [[maybe_unused]] byte* out) noexcept {
+    return false;
+}
+
+#endif
+
+} // namespace TW::Groestl
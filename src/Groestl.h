@@ -0,0 +1,26 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+
+namespace TW::Groestl {
+
+/// Size of a Groestl-512 digest.
+static constexpr std::size_t digest512Size = 64;
+
+/// Whether the CPU runs the AES-NI implementation of Groestl-512 (AES-NI and SSSE3), checked once.
+bool hardwareSupported() noexcept;
+
+/// Computes the Groestl-512 hash of `data` into `out` (`digest512Size` bytes) with the AES-NI implementation.
+/// Returns false, leaving `out` untouched, if the CPU doesn't support it; `Hash::groestl512` then falls back
+/// to the portable implementation.
+bool hash512(const byte* data, std::size_t size, byte* out) noexcept;
+
+} // namespace TW::Groestl
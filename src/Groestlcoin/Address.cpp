@@ -12,7 +12,7 @@
 namespace TW::Groestlcoin {
 
 bool Address::isValid(const std::string& string) {
-    const auto decoded = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherGroestl512d);
+    const auto decoded = Base58::decodeCheck<Hash::HasherGroestl512d>(string);
     if (decoded.size() != Address::size) {
         return false;
     }
@@ -20,7 +20,7 @@ bool Address::isValid(const std::string& string) {
 }
 
 bool Address::isValid(const std::string& string, const std::vector<byte>& validPrefixes) {
-    const auto decoded = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherGroestl512d);
+    const auto decoded = Base58::decodeCheck<Hash::HasherGroestl512d>(string);
     if (decoded.size() != Address::size) {
         return false;
     }
@@ -31,7 +31,7 @@ bool Address::isValid(const std::string& string, const std::vector<byte>& validP
 }
 
 Address::Address(const std::string& string) {
-    const auto decoded = Base58::decodeCheck(string, Rust::Base58Alphabet::Bitcoin, Hash::HasherGroestl512d);
+    const auto decoded = Base58::decodeCheck<Hash::HasherGroestl512d>(string);
     if (decoded.size() != Address::size) {
         throw std::invalid_argument("Invalid address string");
     }
@@ -55,7 +55,7 @@ Address::Address(const PublicKey& publicKey, uint8_t prefix) {
 }
 
 std::string Address::string() const {
-    return Base58::encodeCheck(bytes, Rust::Base58Alphabet::Bitcoin, Hash::HasherGroestl512d);
+    return Base58::encodeCheck<Hash::HasherGroestl512d>(bytes);
 }
 
 } // namespace TW::Groestlcoin
@@ -0,0 +1,124 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HDNodeCache.h"
+
+#include "memory/memzero_wrapper.h"
+
+#include <algorithm>
+#include <set>
+
+using namespace TW;
+
+namespace {
+
+/// The live caches, for the statistics and controls over all of them.
+std::mutex instancesMutex;
+std::set<HDNodeCache*> instances;
+
+} // namespace
+
+HDNodeCache::HDNodeCache(std::size_t capacity)
+    : maxEntries(std::max<std::size_t>(capacity, 1)) {
+    const std::lock_guard lock(instancesMutex);
+    instances.insert(this);
+}
+
+HDNodeCache::~HDNodeCache() {
+    {
+        const std::lock_guard lock(instancesMutex);
+        instances.erase(this);
+    }
+    clear();
+}
+
+std::size_t HDNodeCache::find(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t maxLength, HDNode& node) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.empty()) {
+        return 0;
+    }
+    auto key = Key(curve, Indices(indices.begin(), indices.begin() + std::min(maxLength, indices.size())));
+    while (!key.second.empty()) {
+        auto it = lookup.find(key);
+        if (it != lookup.end()) {
+            // mark as most recently used
+            entries.splice(entries.begin(), entries, it->second);
+            node = it->second->node;
+            return key.second.size();
+        }
+        key.second.pop_back();
+    }
+    return 0;
+}
+
+void HDNodeCache::insert(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t length, const HDNode& node) {
+    if (length == 0 || length > indices.size()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = Key(curve, Indices(indices.begin(), indices.begin() + length));
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    if (entries.size() >= maxEntries) {
+        auto& last = entries.back();
+        lookup.erase(last.key);
+        wipe(last);
+        entries.pop_back();
+    }
+    entries.push_front(Entry{key, node});
+    lookup.emplace(std::move(key), entries.begin());
+}
+
+void HDNodeCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) {
+        wipe(entry);
+    }
+    lookup.clear();
+    entries.clear();
+}
+
+void HDNodeCache::trim(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (entries.size() > count) {
+        auto& last = entries.back();
+        lookup.erase(last.key);
+        wipe(last);
+        entries.pop_back();
+    }
+}
+
+std::size_t HDNodeCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t HDNodeCache::sizeOfAll() {
+    const std::lock_guard lock(instancesMutex);
+    std::size_t total = 0;
+    for (const auto* cache : instances) {
+        total += cache->size();
+    }
+    return total;
+}
+
+void HDNodeCache::trimAll(std::size_t count) {
+    const std::lock_guard lock(instancesMutex);
+    for (auto* cache : instances) {
+        cache->trim(count);
+    }
+}
+
+void HDNodeCache::clearAll() {
+    trimAll(0);
+}
+
+void HDNodeCache::wipe(Entry& entry) {
+    TW::memzero(&entry.node);
+}
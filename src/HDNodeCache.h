@@ -0,0 +1,83 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "memory/memory_stats.h"
+
+#include <TrustWalletCore/TWCurve.h>
+#include <TrezorCrypto/bip32.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace TW {
+
+/// Thread-safe LRU cache of intermediate BIP32 nodes, keyed by curve and derivation path prefix.
+/// Cached nodes contain private key material; they are wiped when evicted, cleared or destroyed.
+class HDNodeCache {
+public:
+    /// Creates a cache holding at most `capacity` nodes.
+    explicit HDNodeCache(std::size_t capacity);
+    ~HDNodeCache();
+
+    HDNodeCache(const HDNodeCache&) = delete;
+    HDNodeCache& operator=(const HDNodeCache&) = delete;
+
+    /// Looks up the longest cached prefix of `indices` of at most `maxLength` indices.
+    /// On a hit copies the cached node into `node` and returns the prefix length, otherwise returns 0.
+    std::size_t find(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t maxLength, HDNode& node);
+
+    /// Stores the node derived for the first `length` indices, evicting the least recently used entry if full.
+    void insert(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t length, const HDNode& node);
+
+    /// Wipes and removes all cached nodes.
+    void clear();
+
+    /// Wipes and removes the least recently used nodes, keeping at most `count`.
+    void trim(std::size_t count);
+
+    std::size_t size() const;
+    std::size_t capacity() const { return maxEntries; }
+
+    /// Number of nodes of all the live caches.
+    static std::size_t sizeOfAll();
+
+    /// Trims all the live caches to at most `count` nodes each.
+    static void trimAll(std::size_t count);
+
+    /// Clears all the live caches.
+    static void clearAll();
+
+private:
+    template <typename T>
+    using Allocator = MemoryStats::CountingAllocator<T, TWMemoryCacheHDNode>;
+
+    using Indices = std::vector<uint32_t, Allocator<uint32_t>>;
+    using Key = std::pair<TWCurve, Indices>;
+
+    struct Entry {
+        Key key;
+        HDNode node;
+    };
+
+    using Entries = std::list<Entry, Allocator<Entry>>;
+
+    static void wipe(Entry& entry);
+
+    std::size_t maxEntries;
+    /// Most recently used first.
+    Entries entries;
+    std::map<Key, Entries::iterator, std::less<Key>, Allocator<std::pair<const Key, Entries::iterator>>> lookup;
+    mutable std::mutex mutex;
+};
+
+} // namespace TW
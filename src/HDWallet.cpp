@@ -11,8 +11,12 @@
 #include "Bitcoin/CashAddress.h"
 #include "Bitcoin/SegwitAddress.h"
 #include "Coin.h"
+#include "CryptoBackend.h"
+#include "HDNodeCache.h"
 #include "ImmutableX/StarkKey.h"
 #include "Mnemonic.h"
+#include "Random.h"
+#include "algorithm/parallel.h"
 #include "memory/memzero_wrapper.h"
 
 #include <TrustWalletCore/TWHRP.h>
@@ -24,8 +28,12 @@
 #include <TrezorCrypto/bip39.h>
 #include <TrezorCrypto/cardano.h>
 #include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/sha2.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 
 using namespace TW;
@@ -38,6 +46,35 @@ bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher
 const char* curveName(TWCurve curve);
 } // namespace
 
+namespace {
+
+/// Capacity of the per-thread node caches, see `setThreadNodeCacheCapacity`.
+std::atomic<std::size_t> threadNodeCacheCapacity{0};
+
+/// Per-thread cache of BIP32 parent nodes, shared by the wallets used on the thread and wiped when it exits.
+struct ThreadNodeCache {
+    bip32_cache cache;
+
+    ThreadNodeCache() { bip32_cache_init(&cache, 0); }
+    ~ThreadNodeCache() { bip32_cache_wipe(&cache); }
+
+    /// Returns the cache of the calling thread, or nullptr if disabled.
+    /// A cache whose capacity was changed in the meantime is wiped first.
+    static bip32_cache* get() {
+        thread_local ThreadNodeCache instance;
+        const auto capacity = std::min<std::size_t>(threadNodeCacheCapacity.load(std::memory_order_relaxed), BIP32_CACHE_SIZE);
+        if (instance.cache.capacity != capacity) {
+            bip32_cache_init(&instance.cache, capacity);
+        }
+        return capacity == 0 ? nullptr : &instance.cache;
+    }
+};
+
+} // namespace
+
+/// Largest number of public keys `deriveAddresses` turns into addresses at once.
+constexpr std::size_t addressBatchSize = 64;
+
 const int MnemonicBufLength = Mnemonic::MaxWords * (BIP39_MAX_WORD_LENGTH + 3) + 20; // some extra slack
 
 template <std::size_t seedSize>
@@ -52,20 +89,32 @@ void HDWallet<seedSize>::updateSeedAndEntropy(bool check) {
     // generate seed from mnemonic
     mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
 
+    updateEntropy(check);
+}
+
+template <std::size_t seedSize>
+void HDWallet<seedSize>::updateEntropy(bool check) {
     // generate entropy bits from mnemonic
-    Data entropyRaw((Mnemonic::MaxWords * Mnemonic::BitsPerWord) / 8);
+    Mnemonic::Bits entropyRaw;
     // entropy is truncated to fully bytes, 4 bytes for each 3 words (=33 bits)
-    auto entropyBytes = mnemonic_to_bits(mnemonic.c_str(), entropyRaw.data()) / 33 * 4;
+    auto entropyBytes = Mnemonic::toBits(mnemonic, entropyRaw) / 33 * 4;
     // copy to truncate
-    entropy = data(entropyRaw.data(), entropyBytes);
+    entropy.assign(entropyRaw.data(), entropyRaw.data() + entropyBytes);
+    TW::memzero(entropyRaw.data(), entropyRaw.size());
     assert(!check || entropy.size() > 10);
 }
 
 template <std::size_t seedSize>
 HDWallet<seedSize>::HDWallet(int strength, const std::string& passphrase)
     : passphrase(passphrase) {
+    if (strength % 32 != 0 || strength < 128 || strength > 256) {
+        throw std::invalid_argument("Invalid strength");
+    }
+    std::array<byte, 32> entropy;
+    Random::fill(entropy.data(), strength / 8);
     char buf[MnemonicBufLength];
-    const char* mnemonic_chars = mnemonic_generate(strength, buf, MnemonicBufLength);
+    const char* mnemonic_chars = mnemonic_from_data(entropy.data(), strength / 8, buf, MnemonicBufLength);
+    TW::memzero(entropy.data(), entropy.size());
     if (mnemonic_chars == nullptr) {
         throw std::invalid_argument("Invalid strength");
     }
@@ -75,7 +124,7 @@ HDWallet<seedSize>::HDWallet(int strength, const std::string& passphrase)
 }
 
 template <std::size_t seedSize>
-HDWallet<seedSize>::HDWallet(const std::string& mnemonic, const std::string& passphrase, const bool check)
+HDWallet<seedSize>::HDWallet(std::string_view mnemonic, std::string_view passphrase, const bool check)
     : mnemonic(mnemonic), passphrase(passphrase) {
     if (mnemonic.length() == 0 ||
         (check && !Mnemonic::isValid(mnemonic))) {
@@ -85,7 +134,54 @@ HDWallet<seedSize>::HDWallet(const std::string& mnemonic, const std::string& pas
 }
 
 template <std::size_t seedSize>
-HDWallet<seedSize>::HDWallet(const Data& entropy, const std::string& passphrase)
+HDWallet<seedSize>::HDWallet(const std::string& mnemonic, const std::string& passphrase, const byte* seed, bool check)
+    : mnemonic(mnemonic), passphrase(passphrase) {
+    std::copy_n(seed, seedSize, this->seed.begin());
+    updateEntropy(check);
+}
+
+template <std::size_t seedSize>
+std::vector<HDWallet<seedSize>> HDWallet<seedSize>::createBatch(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases,
+                                                                bool check, size_t threads) {
+    const auto count = std::max(mnemonics.size(), passphrases.size());
+    if ((mnemonics.size() != count && mnemonics.size() != 1) || (passphrases.size() != count && passphrases.size() != 1)) {
+        throw std::invalid_argument("Mismatched mnemonic and passphrase counts");
+    }
+    const auto mnemonicAt = [&](size_t i) -> const std::string& { return mnemonics[mnemonics.size() == 1 ? 0 : i]; };
+    const auto passphraseAt = [&](size_t i) -> const std::string& { return passphrases[passphrases.size() == 1 ? 0 : i]; };
+    for (size_t i = 0; i < mnemonics.size(); ++i) {
+        if (mnemonics[i].length() == 0 || (check && !Mnemonic::isValid(mnemonics[i]))) {
+            throw std::invalid_argument("Invalid mnemonic");
+        }
+    }
+
+    std::vector<std::array<byte, 64>> seeds(count);
+    const size_t lanes = SHA512_LANES;
+    parallelFor((count + lanes - 1) / lanes, threads, [&](size_t group) {
+        const char* groupMnemonics[SHA512_LANES];
+        const char* groupPassphrases[SHA512_LANES];
+        uint8_t* groupSeeds[SHA512_LANES];
+        const auto first = group * lanes;
+        const auto size = std::min(lanes, count - first);
+        for (size_t l = 0; l < size; ++l) {
+            groupMnemonics[l] = mnemonicAt(first + l).c_str();
+            groupPassphrases[l] = passphraseAt(first + l).c_str();
+            groupSeeds[l] = seeds[first + l].data();
+        }
+        mnemonic_to_seed_lanes(groupMnemonics, groupPassphrases, groupSeeds, static_cast<int>(size));
+    });
+
+    std::vector<HDWallet> wallets;
+    wallets.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        wallets.push_back(HDWallet(mnemonicAt(i), passphraseAt(i), seeds[i].data(), check));
+        TW::memzero(seeds[i].data(), seeds[i].size());
+    }
+    return wallets;
+}
+
+template <std::size_t seedSize>
+HDWallet<seedSize>::HDWallet(std::span<const byte> entropy, const std::string& passphrase)
     : passphrase(passphrase) {
     char buf[MnemonicBufLength];
     const char* mnemonic_chars = mnemonic_from_data(entropy.data(), static_cast<int>(entropy.size()), buf, MnemonicBufLength);
@@ -97,11 +193,57 @@ HDWallet<seedSize>::HDWallet(const Data& entropy, const std::string& passphrase)
     updateSeedAndEntropy();
 }
 
+template <std::size_t seedSize>
+HDWallet<seedSize>::HDWallet(const HDWallet& other)
+    : seed(other.seed), mnemonic(other.mnemonic), passphrase(other.passphrase), entropy(other.entropy) {
+    if (other.nodeCache) {
+        enableNodeCache(other.nodeCache->capacity());
+    }
+}
+
+template <std::size_t seedSize>
+HDWallet<seedSize>::HDWallet(HDWallet&& other) noexcept = default;
+
+template <std::size_t seedSize>
+HDWallet<seedSize>& HDWallet<seedSize>::operator=(const HDWallet& other) {
+    if (this != &other) {
+        seed = other.seed;
+        mnemonic = other.mnemonic;
+        passphrase = other.passphrase;
+        entropy = other.entropy;
+        disableNodeCache();
+        if (other.nodeCache) {
+            enableNodeCache(other.nodeCache->capacity());
+        }
+    }
+    return *this;
+}
+
+template <std::size_t seedSize>
+HDWallet<seedSize>& HDWallet<seedSize>::operator=(HDWallet&& other) noexcept = default;
+
 template <std::size_t seedSize>
 HDWallet<seedSize>::~HDWallet() {
     std::fill(seed.begin(), seed.end(), 0);
     std::fill(mnemonic.begin(), mnemonic.end(), 0);
     std::fill(passphrase.begin(), passphrase.end(), 0);
+    // wipes the cached nodes
+    nodeCache.reset();
+}
+
+template <std::size_t seedSize>
+void HDWallet<seedSize>::enableNodeCache(size_t capacity) {
+    nodeCache = std::make_unique<HDNodeCache>(capacity);
+}
+
+template <std::size_t seedSize>
+void HDWallet<seedSize>::disableNodeCache() {
+    nodeCache.reset();
+}
+
+template <std::size_t seedSize>
+void HDWallet<seedSize>::setThreadNodeCacheCapacity(size_t capacity) {
+    threadNodeCacheCapacity.store(capacity, std::memory_order_relaxed);
 }
 
 template <size_t seedSize>
@@ -127,20 +269,57 @@ static HDNode getMasterNode(const HDWallet<seedSize>& wallet, TWCurve curve) {
     return node;
 }
 
+/// Derives the node at `derivationPath`, through the node cache of the wallet if it has one,
+/// or else the node cache of the thread if enabled.
+/// The leaf node is cached too if `cacheLeaf` is set, for nodes that are the parent of many derivations.
 template <size_t seedSize>
-static HDNode getNode(const HDWallet<seedSize>& wallet, TWCurve curve, const DerivationPath& derivationPath) {
+static HDNode getNode(const HDWallet<seedSize>& wallet, TWCurve curve, const DerivationPath& derivationPath, bool cacheLeaf = false) {
     const auto privateKeyType = PrivateKey::getType(curve);
-    auto node = getMasterNode<seedSize>(wallet, curve);
-    for (auto& index : derivationPath.indices) {
+    const auto& indices = derivationPath.indices;
+    auto* cache = wallet.getNodeCache();
+
+    HDNode node;
+    if (cache == nullptr && !cacheLeaf && privateKeyType == TWPrivateKeyTypeDefault && !indices.empty()) {
+        if (auto* threadCache = ThreadNodeCache::get(); threadCache != nullptr) {
+            std::vector<uint32_t> path;
+            path.reserve(indices.size());
+            for (auto& index : indices) {
+                path.push_back(index.derivationIndex());
+            }
+            node = getMasterNode<seedSize>(wallet, curve);
+            hdnode_private_ckd_with_cache(threadCache, &node, path.data(), path.size(), nullptr);
+            return node;
+        }
+    }
+
+    std::size_t start = 0;
+    std::vector<uint32_t> path;
+    // Unless asked for, only the ancestors are cached, the leaf differs from call to call
+    const auto cachedLength = cacheLeaf ? indices.size() : indices.size() - 1;
+    if (cache != nullptr && !indices.empty() && cachedLength > 0) {
+        path.reserve(indices.size());
+        for (auto& index : indices) {
+            path.push_back(index.derivationIndex());
+        }
+        start = cache->find(curve, path, cachedLength, node);
+    }
+    if (start == 0) {
+        node = getMasterNode<seedSize>(wallet, curve);
+    }
+
+    for (auto i = start; i < indices.size(); ++i) {
         switch (privateKeyType) {
         case TWPrivateKeyTypeCardano:
-            hdnode_private_ckd_cardano(&node, index.derivationIndex());
+            hdnode_private_ckd_cardano(&node, indices[i].derivationIndex());
             break;
         case TWPrivateKeyTypeDefault:
         default:
-            hdnode_private_ckd(&node, index.derivationIndex());
+            hdnode_private_ckd(&node, indices[i].derivationIndex());
             break;
         }
+        if (!path.empty() && i + 1 <= cachedLength) {
+            cache->insert(curve, path, i + 1, node);
+        }
     }
     return node;
 }
@@ -162,39 +341,68 @@ PrivateKey HDWallet<seedSize>::getMasterKeyExtension(TWCurve curve) const {
 template <std::size_t seedSize>
 DerivationPath HDWallet<seedSize>::cardanoStakingDerivationPath(const DerivationPath& path) {
     DerivationPath stakingPath = path;
-    stakingPath.indices[3].value = 2;
-    stakingPath.indices[4].value = 0;
+    if (stakingPath.indices.size() > 3) {
+        stakingPath.indices[3].value = 2;
+    }
+    if (stakingPath.indices.size() > 4) {
+        stakingPath.indices[4].value = 0;
+    }
     return stakingPath;
 }
 
+/// Derives the nodes below a Cardano account node, from the account level (the first 3 indices) on.
+static void deriveCardanoChildren(HDNode& node, const DerivationPath& path) {
+    for (std::size_t i = 3; i < path.indices.size(); ++i) {
+        hdnode_private_ckd_cardano(&node, path.indices[i].derivationIndex());
+    }
+}
+
+/// Derives the account node of a Cardano path (m/1852'/1815'/account'), caching it if the wallet has a node cache,
+/// as the spending and staking keys of all the addresses of the account derive from it.
+template <size_t seedSize>
+static HDNode getCardanoAccountNode(const HDWallet<seedSize>& wallet, TWCurve curve, const DerivationPath& path) {
+    const auto accountPath = DerivationPath(DerivationPathIndices(path.indices.begin(), path.indices.begin() + 3));
+    return getNode(wallet, curve, accountPath, /* cacheLeaf: */ true);
+}
+
+/// The double extended key of a spending and a staking node: key+extension+chainCode of each.
+static PrivateKey cardanoPrivateKey(const HDNode& spending, const HDNode& staking) {
+    std::array<byte, PrivateKey::cardanoKeySize> buffer;
+    auto it = buffer.begin();
+    for (const auto* node : {&spending, &staking}) {
+        it = std::copy_n(node->private_key, PrivateKey::_size, it);
+        it = std::copy_n(node->private_key_extension, PrivateKey::_size, it);
+        it = std::copy_n(node->chain_code, PrivateKey::_size, it);
+    }
+    auto key = PrivateKey(buffer.data(), buffer.size());
+    TW::memzero(buffer.data(), buffer.size());
+    return key;
+}
+
 template <std::size_t seedSize>
 PrivateKey HDWallet<seedSize>::getKeyByCurve(TWCurve curve, const DerivationPath& derivationPath) const {
     const auto privateKeyType = PrivateKey::getType(curve);
-    auto node = getNode<seedSize>(*this, curve, derivationPath);
     switch (privateKeyType) {
     case TWPrivateKeyTypeCardano: {
         if (derivationPath.indices.size() < 4 || derivationPath.indices[3].value > 1) {
             // invalid derivation path
             return PrivateKey(Data(PrivateKey::cardanoKeySize));
         }
-        const DerivationPath stakingPath = cardanoStakingDerivationPath(derivationPath);
-
-        auto pkData = Data(node.private_key, node.private_key + PrivateKey::_size);
-        auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::_size);
-        auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::_size);
-
-        // repeat with staking path
-        const auto node2 = getNode(*this, curve, stakingPath);
-        auto pkData2 = Data(node2.private_key, node2.private_key + PrivateKey::_size);
-        auto extData2 = Data(node2.private_key_extension, node2.private_key_extension + PrivateKey::_size);
-        auto chainCode2 = Data(node2.chain_code, node2.chain_code + PrivateKey::_size);
-
-        TW::memzero(&node);
-        return PrivateKey(pkData, extData, chainCode, pkData2, extData2, chainCode2);
+        // spending key at the path, staking key at account/2/0, both from one account node
+        auto spending = getCardanoAccountNode(*this, curve, derivationPath);
+        auto staking = spending;
+        deriveCardanoChildren(spending, derivationPath);
+        deriveCardanoChildren(staking, cardanoStakingDerivationPath(derivationPath));
+
+        auto key = cardanoPrivateKey(spending, staking);
+        TW::memzero(&spending);
+        TW::memzero(&staking);
+        return key;
     }
     case TWPrivateKeyTypeDefault:
     default:
         // default path
+        auto node = getNode<seedSize>(*this, curve, derivationPath);
         auto data = Data(node.private_key, node.private_key + PrivateKey::_size);
         TW::memzero(&node);
         if (curve == TWCurveStarkex) {
@@ -234,6 +442,139 @@ std::string HDWallet<seedSize>::deriveAddress(TWCoinType coin) const {
     return deriveAddress(coin, TWDerivationDefault);
 }
 
+template <std::size_t seedSize>
+std::vector<std::string> HDWallet<seedSize>::deriveAddresses(TWCoinType coin, TWDerivation derivation, uint32_t account, uint32_t change,
+                                                             uint32_t startIndex, uint32_t count, size_t threads) const {
+    auto path = TW::derivationPath(coin, derivation);
+    if (path.indices.size() != 5) {
+        throw std::invalid_argument("Derivation path has no account, change and address levels");
+    }
+    if (static_cast<uint64_t>(startIndex) + count > 0x80000000) {
+        throw std::invalid_argument("Address index out of range");
+    }
+    // keep the hardened flags of the coin's derivation path
+    path.indices[2].value = account;
+    path.indices[3].value = change;
+
+    std::vector<std::string> addresses(count);
+    if (count == 0) {
+        return addresses;
+    }
+
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto parentPath = DerivationPath(std::vector<DerivationPathIndex>(path.indices.begin(), path.indices.begin() + 4));
+    const auto addressHardened = path.indices[4].hardened;
+
+    // The keys are derived and turned into addresses in batches, so that chains can hash them together;
+    // batches are smaller than addressBatchSize when needed to keep all the threads busy.
+    const auto workers = parallelWorkerCount(count, threads);
+    const auto batchSize = std::clamp<std::size_t>((count + workers - 1) / workers, 1, addressBatchSize);
+    const auto batches = (count + batchSize - 1) / batchSize;
+    const auto deriveBatches = [&](auto&& publicKey) {
+        parallelFor(batches, threads, [&](std::size_t batch) {
+            const auto begin = batch * batchSize;
+            const auto size = std::min(batchSize, count - begin);
+            std::vector<PublicKey> publicKeys;
+            publicKeys.reserve(size);
+            for (std::size_t i = begin; i < begin + size; ++i) {
+                publicKeys.push_back(publicKey(i));
+            }
+            auto batchAddresses = TW::deriveAddresses(coin, publicKeys, derivation);
+            std::move(batchAddresses.begin(), batchAddresses.end(), addresses.begin() + begin);
+        });
+    };
+
+    if ((curve == TWCurveSECP256k1 || curve == TWCurveNIST256p1) && !addressHardened) {
+        // Public derivation from the change-level node
+        auto node = getNode(*this, curve, parentPath);
+        hdnode_fill_public_key(&node);
+        const auto* params = node.curve->params;
+        curve_point parent;
+        std::array<uint8_t, 32> chainCode;
+        std::copy(node.chain_code, node.chain_code + 32, chainCode.begin());
+        const auto parsed = ecdsa_read_pubkey(params, node.public_key, &parent);
+        TW::memzero(&node);
+        if (parsed == 0) {
+            throw std::invalid_argument("Invalid public key");
+        }
+
+        const auto keyType = TW::publicKeyType(coin);
+        const auto extended = keyType == TWPublicKeyTypeSECP256k1Extended || keyType == TWPublicKeyTypeNIST256p1Extended;
+        const auto baseType = curve == TWCurveSECP256k1 ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeNIST256p1;
+        deriveBatches([&](std::size_t i) {
+            curve_point child;
+            hdnode_public_ckd_cp(params, &parent, chainCode.data(), startIndex + static_cast<uint32_t>(i), &child, nullptr);
+            // the derived point is valid, the key is created without checking it again
+            if (extended) {
+                // uncompressed directly, instead of decompressing
+                std::array<byte, PublicKey::secp256k1ExtendedSize> uncompressed;
+                uncompressed[0] = 0x04;
+                bn_write_be(&child.x, uncompressed.data() + 1);
+                bn_write_be(&child.y, uncompressed.data() + 1 + 32);
+                return PublicKey::fromTrusted(uncompressed.data(), uncompressed.size(), keyType);
+            }
+            std::array<byte, PublicKey::secp256k1Size> compressed;
+            compress_coords(&child, compressed.data());
+            return PublicKey::fromTrusted(compressed.data(), compressed.size(), baseType);
+        });
+        return addresses;
+    }
+
+    if (PrivateKey::getType(curve) == TWPrivateKeyTypeDefault && curve != TWCurveStarkex) {
+        // Private derivation from the change-level node
+        auto parent = getNode(*this, curve, parentPath);
+        const auto keyType = TW::publicKeyType(coin);
+        deriveBatches([&](std::size_t i) {
+            auto node = parent;
+            hdnode_private_ckd(&node, DerivationPathIndex(startIndex + static_cast<uint32_t>(i), addressHardened).derivationIndex());
+            const auto privateKey = PrivateKey(Data(node.private_key, node.private_key + PrivateKey::_size));
+            TW::memzero(&node);
+            return privateKey.getPublicKey(keyType);
+        });
+        TW::memzero(&parent);
+        return addresses;
+    }
+
+    if (PrivateKey::getType(curve) == TWPrivateKeyTypeCardano && change <= 1) {
+        // Spending keys from the change-level node; the staking key (account/2/0) is shared by all addresses
+        auto account = getCardanoAccountNode(*this, curve, path);
+        auto parent = account;
+        auto staking = account;
+        hdnode_private_ckd_cardano(&parent, path.indices[3].derivationIndex());
+        deriveCardanoChildren(staking, cardanoStakingDerivationPath(path));
+        TW::memzero(&account);
+
+        const auto& backend = CryptoBackend::current();
+        std::array<byte, 2 * PublicKey::ed25519Size> stakingPart;
+        backend.eddsaGetPublicKey(curve, staking.private_key, stakingPart.data());
+        std::copy_n(staking.chain_code, PublicKey::ed25519Size, stakingPart.begin() + PublicKey::ed25519Size);
+        TW::memzero(&staking);
+
+        deriveBatches([&](std::size_t i) {
+            auto node = parent;
+            hdnode_private_ckd_cardano(&node, DerivationPathIndex(startIndex + static_cast<uint32_t>(i), addressHardened).derivationIndex());
+            // spending public key + chain code, then staking public key + chain code
+            std::array<byte, PublicKey::cardanoKeySize> publicKey;
+            backend.eddsaGetPublicKey(curve, node.private_key, publicKey.data());
+            std::copy_n(node.chain_code, PublicKey::ed25519Size, publicKey.begin() + PublicKey::ed25519Size);
+            std::copy(stakingPart.begin(), stakingPart.end(), publicKey.begin() + 2 * PublicKey::ed25519Size);
+            TW::memzero(&node);
+            return PublicKey::fromTrusted(publicKey.data(), publicKey.size(), TWPublicKeyTypeED25519Cardano);
+        });
+        TW::memzero(&parent);
+        return addresses;
+    }
+
+    // Key types with extra derivation steps (e.g. Starkex)
+    const auto keyType = TW::publicKeyType(coin);
+    deriveBatches([&](std::size_t i) {
+        auto childPath = path;
+        childPath.indices[4].value = startIndex + static_cast<uint32_t>(i);
+        return getKey(coin, childPath).getPublicKey(keyType);
+    });
+    return addresses;
+}
+
 template <std::size_t seedSize>
 std::string HDWallet<seedSize>::getExtendedPrivateKeyAccount(TWPurpose purpose, TWCoinType coin, TWDerivation derivation, TWHDVersion version, uint32_t account) const {
     if (version == TWHDVersionNone) {
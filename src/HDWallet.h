@@ -11,6 +11,7 @@
 #include "Hash.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
+#include "memory/secure_allocator.h"
 
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWCurve.h>
@@ -19,36 +20,45 @@
 #include <TrustWalletCore/TWDerivation.h>
 
 #include <array>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace TW {
 
+class HDNodeCache;
+
 template<size_t seedSize = 64>
 class HDWallet {
   public:
     static constexpr size_t mSeedSize = seedSize;
     static constexpr size_t maxMnemomincSize = 240;
     static constexpr size_t maxExtendedKeySize = 128;
+    static constexpr size_t defaultNodeCacheSize = 16;
 
   private:
     /// Wallet seed, derived one-way from the mnemonic and passphrase
     std::array<byte, seedSize> seed;
 
-    /// Mnemonic word list (aka. recovery phrase).
-    std::string mnemonic;
+    /// Mnemonic word list (aka. recovery phrase), in locked memory.
+    SecureString mnemonic;
 
-    /// Passphrase for mnemonic encryption.
-    std::string passphrase;
+    /// Passphrase for mnemonic encryption, in locked memory.
+    SecureString passphrase;
 
     /// Entropy is the binary 1-to-1 representation of the mnemonic (11 bits from each word)
-    TW::Data entropy;
+    SecureData entropy;
+
+    /// Optional cache of intermediate derivation nodes, see `enableNodeCache`.
+    std::unique_ptr<HDNodeCache> nodeCache;
 
 public:
     const std::array<byte, seedSize>& getSeed() const { return seed; }
-    const std::string& getMnemonic() const { return mnemonic; }
-    const std::string& getPassphrase() const { return passphrase; }
-    const TW::Data& getEntropy() const { return entropy; }
+    const SecureString& getMnemonic() const { return mnemonic; }
+    const SecureString& getPassphrase() const { return passphrase; }
+    const SecureData& getEntropy() const { return entropy; }
 
   public:
     /// Initializes an HDWallet from given seed.
@@ -60,19 +70,46 @@ public:
 
     /// Initializes an HDWallet from a BIP39 mnemonic and a passphrase, check English dict by default.
     /// Throws on invalid mnemonic.
-    HDWallet(const std::string& mnemonic, const std::string& passphrase, const bool check = true);
+    HDWallet(std::string_view mnemonic, std::string_view passphrase, const bool check = true);
 
     /// Initializes an HDWallet from an entropy.
     /// Throws on invalid data.
-    HDWallet(const Data& entropy, const std::string& passphrase);
-
-    HDWallet(const HDWallet& other) = default;
-    HDWallet(HDWallet&& other) = default;
-    HDWallet& operator=(const HDWallet& other) = default;
-    HDWallet& operator=(HDWallet&& other) = default;
+    HDWallet(std::span<const byte> entropy, const std::string& passphrase);
+
+    /// Initializes HDWallets from BIP39 mnemonics and passphrases, the same as the mnemonic constructor for each pair.
+    /// Either list may have a single entry, shared by all wallets (e.g. one mnemonic with many passphrases).
+    /// The seeds are computed `SHA512_LANES` at a time in SIMD lanes, spread over `threads` threads
+    /// (0 means hardware concurrency, 1 runs in the calling thread).
+    /// Throws std::invalid_argument on an invalid mnemonic or mismatched list sizes.
+    static std::vector<HDWallet> createBatch(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases,
+                                             bool check = true, size_t threads = 0);
+
+    /// Copies get their own, empty node cache (if the source has one enabled).
+    HDWallet(const HDWallet& other);
+    HDWallet(HDWallet&& other) noexcept;
+    HDWallet& operator=(const HDWallet& other);
+    HDWallet& operator=(HDWallet&& other) noexcept;
 
     virtual ~HDWallet();
 
+    /// Enables an LRU cache of intermediate derivation nodes, keyed by curve and path prefix.
+    /// Repeated derivations sharing a prefix (e.g. m/44'/60'/0'/0/i) then skip the common part.
+    /// The cache is thread-safe; enabling or disabling it must not race with derivations.
+    void enableNodeCache(size_t capacity = defaultNodeCacheSize);
+
+    /// Disables the node cache, wiping the cached nodes.
+    void disableNodeCache();
+
+    /// Returns the node cache, or nullptr if it is not enabled.
+    HDNodeCache* getNodeCache() const { return nodeCache.get(); }
+
+    /// Sets the capacity of the per-thread caches of BIP32 parent nodes (e.g. m/44'/60'/0'/0), 0 to disable them,
+    /// at most BIP32_CACHE_SIZE. Each thread has its own cache, shared by the wallets without a node cache of
+    /// their own and by `bip32DeriveRawSeed`, so derivations on different threads don't contend.
+    /// Disabled by default. A thread's cache is wiped when the thread exits, or at its next derivation after the
+    /// capacity changed.
+    static void setThreadNodeCacheCapacity(size_t capacity);
+
     /// Returns master key.
     PrivateKey getMasterKey(TWCurve curve) const;
 
@@ -94,6 +131,16 @@ public:
     /// Derives the address for a coin with given derivation.
     std::string deriveAddress(TWCoinType coin, TWDerivation derivation) const;
 
+    /// Derives the addresses at `count` consecutive address indices starting at `startIndex`, for the given
+    /// account and change of the coin's derivation path (which must have the 5 BIP44 levels).
+    /// The change-level node is derived once; for secp256k1 and nist256p1 with a non-hardened address level
+    /// the children are derived by public derivation only. For Cardano the staking key is derived once per call,
+    /// and the base addresses are built from the spending and staking public keys, without assembling private keys.
+    /// `threads` splits the index range: 0 means hardware concurrency, 1 runs in the calling thread.
+    /// Throws std::invalid_argument on an unsupported derivation path or an out of range index range.
+    std::vector<std::string> deriveAddresses(TWCoinType coin, TWDerivation derivation, uint32_t account, uint32_t change,
+                                             uint32_t startIndex, uint32_t count, size_t threads = 1) const;
+
     /// Returns the extended private key for default 0 account with the given derivation.
     std::string getExtendedPrivateKeyDerivation(TWPurpose purpose, TWCoinType coin, TWDerivation derivation, TWHDVersion version) const {
         return getExtendedPrivateKeyAccount(purpose, coin, derivation, version, 0);
@@ -137,8 +184,13 @@ public:
     static PrivateKey bip32DeriveRawSeed(TWCoinType coin, const Data& seed, const DerivationPath& path);
 
   private:
+    /// Initializes an HDWallet from a mnemonic with its already computed 64-byte seed.
+    HDWallet(const std::string& mnemonic, const std::string& passphrase, const byte* seed, bool check);
+
     void updateSeedAndEntropy(bool check = true);
 
+    void updateEntropy(bool check);
+
     // For Cardano, derive 2nd staking derivation path from the primary one
     static DerivationPath cardanoStakingDerivationPath(const DerivationPath& path);
 };
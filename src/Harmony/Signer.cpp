@@ -5,12 +5,15 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
-#include "../Ethereum/RLP.h"
 #include "../HexCoding.h"
-#include <google/protobuf/util/json_util.h>
+#include "../proto/Harmony.json.pb.h"
+
+#include <span>
 
 namespace TW::Harmony {
 
+using RLP = Ethereum::RLP;
+
 std::tuple<uint256_t, uint256_t, uint256_t> Signer::values(const uint256_t& chainID,
                                                            const Data& signature) noexcept {
     auto r = load(Data(signature.begin(), signature.begin() + 32));
@@ -69,7 +72,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     return hex(Signer::sign(input).encoded());
 }
@@ -102,8 +105,24 @@ Proto::SigningOutput Signer::signTransaction(const Proto::SigningInput& input) n
     return prepareOutput<Transaction>(encoded, transaction);
 }
 
-Proto::SigningOutput Signer::signCreateValidator(const Proto::SigningInput& input) noexcept {
+template <typename Directive>
+Proto::SigningOutput Signer::signStaking(const Proto::SigningInput& input, uint8_t directive,
+                                         Directive stakeMsg) noexcept {
     auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto stakingTx = Staking<Directive>(
+        directive, std::move(stakeMsg), load(input.staking_message().nonce()),
+        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
+        load(input.chain_id()), 0, 0);
+
+    auto signer = Signer(uint256_t(load(input.chain_id())));
+    auto hash = signer.hash<Directive>(stakingTx);
+    signer.sign(key, hash, stakingTx);
+    auto encoded = signer.rlpNoHash<Directive>(stakingTx, true);
+
+    return prepareOutput<Staking<Directive>>(encoded, stakingTx);
+}
+
+Proto::SigningOutput Signer::signCreateValidator(const Proto::SigningInput& input) noexcept {
     auto description = Description(
         /* name */ input.staking_message().create_validator_message().description().name(),
         /* identity */ input.staking_message().create_validator_message().description().identity(),
@@ -171,22 +190,10 @@ Proto::SigningOutput Signer::signCreateValidator(const Proto::SigningInput& inpu
         /* BlsSig */ slotKeySigs,
         /* Amount */ load(input.staking_message().create_validator_message().amount()));
 
-    auto stakingTx = Staking<CreateValidator>(
-        DirectiveCreateValidator, createValidator, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<CreateValidator>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<CreateValidator>(stakingTx, true);
-
-    return prepareOutput<Staking<CreateValidator>>(encoded, stakingTx);
+    return signStaking(input, DirectiveCreateValidator, std::move(createValidator));
 }
 
 Proto::SigningOutput Signer::signEditValidator(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
     auto description = Description(
         /* name */ input.staking_message().edit_validator_message().description().name(),
         /* identity */ input.staking_message().edit_validator_message().description().identity(),
@@ -230,22 +237,10 @@ Proto::SigningOutput Signer::signEditValidator(const Proto::SigningInput& input)
         /* Active */
         load(input.staking_message().edit_validator_message().active()));
 
-    auto stakingTx = Staking<EditValidator>(
-        DirectiveEditValidator, editValidator, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<EditValidator>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<EditValidator>(stakingTx, true);
-
-    return prepareOutput<Staking<EditValidator>>(encoded, stakingTx);
+    return signStaking(input, DirectiveEditValidator, std::move(editValidator));
 }
 
 Proto::SigningOutput Signer::signDelegate(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
     Address delegatorAddr;
     if (!Address::decode(input.staking_message().delegate_message().delegator_address(),
                          delegatorAddr)) {
@@ -260,22 +255,10 @@ Proto::SigningOutput Signer::signDelegate(const Proto::SigningInput& input) noex
     }
     auto delegate = Delegate(delegatorAddr, validatorAddr,
                              load(input.staking_message().delegate_message().amount()));
-    auto stakingTx =
-        Staking<Delegate>(DirectiveDelegate, delegate, load(input.staking_message().nonce()),
-                          load(input.staking_message().gas_price()),
-                          load(input.staking_message().gas_limit()), load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<Delegate>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<Delegate>(stakingTx, true);
-
-    return prepareOutput<Staking<Delegate>>(encoded, stakingTx);
+    return signStaking(input, DirectiveDelegate, std::move(delegate));
 }
 
 Proto::SigningOutput Signer::signUndelegate(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
     Address delegatorAddr;
     if (!Address::decode(input.staking_message().undelegate_message().delegator_address(),
                          delegatorAddr)) {
@@ -290,22 +273,10 @@ Proto::SigningOutput Signer::signUndelegate(const Proto::SigningInput& input) no
     }
     auto undelegate = Undelegate(delegatorAddr, validatorAddr,
                                  load(input.staking_message().undelegate_message().amount()));
-    auto stakingTx = Staking<Undelegate>(
-        DirectiveUndelegate, undelegate, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<Undelegate>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<Undelegate>(stakingTx, true);
-
-    return prepareOutput<Staking<Undelegate>>(encoded, stakingTx);
+    return signStaking(input, DirectiveUndelegate, std::move(undelegate));
 }
 
 Proto::SigningOutput Signer::signCollectRewards(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
     Address delegatorAddr;
     if (!Address::decode(input.staking_message().collect_rewards().delegator_address(),
                          delegatorAddr)) {
@@ -313,17 +284,7 @@ Proto::SigningOutput Signer::signCollectRewards(const Proto::SigningInput& input
         return Proto::SigningOutput();
     }
     auto collectRewards = CollectRewards(delegatorAddr);
-    auto stakingTx = Staking<CollectRewards>(
-        DirectiveCollectRewards, collectRewards, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<CollectRewards>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<CollectRewards>(stakingTx, true);
-
-    return prepareOutput<Staking<CollectRewards>>(encoded, stakingTx);
+    return signStaking(input, DirectiveCollectRewards, std::move(collectRewards));
 }
 
 template <typename T>
@@ -334,160 +295,143 @@ void Signer::sign(const PrivateKey& privateKey, const Data& hash, T& transaction
     transaction.v = std::get<2>(tuple);
 }
 
-Data Signer::rlpNoHash(const Transaction& transaction, const bool include_vrs) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-    append(encoded, RLP::encode(transaction.nonce));
-    append(encoded, RLP::encode(transaction.gasPrice));
-    append(encoded, RLP::encode(transaction.gasLimit));
-    append(encoded, RLP::encode(transaction.fromShardID));
-    append(encoded, RLP::encode(transaction.toShardID));
-    append(encoded, RLP::encode(transaction.to.getKeyHash()));
-    append(encoded, RLP::encode(transaction.amount));
-    append(encoded, RLP::encode(transaction.payload));
+void Signer::writeSignature(RLP::Writer& writer, const uint256_t& v, const uint256_t& r,
+                            const uint256_t& s, const bool include_vrs) const noexcept {
     if (include_vrs) {
-        append(encoded, RLP::encode(transaction.v));
-        append(encoded, RLP::encode(transaction.r));
-        append(encoded, RLP::encode(transaction.s));
+        writer.append(v);
+        writer.append(r);
+        writer.append(s);
     } else {
-        append(encoded, RLP::encode(chainID));
-        append(encoded, RLP::encode(0));
-        append(encoded, RLP::encode(0));
+        writer.append(chainID);
+        writer.append(0);
+        writer.append(0);
     }
-    return RLP::encodeList(encoded);
+}
+
+Data Signer::rlpNoHash(const Transaction& transaction, const bool include_vrs) const noexcept {
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writer.append(transaction.nonce);
+        writer.append(transaction.gasPrice);
+        writer.append(transaction.gasLimit);
+        writer.append(transaction.fromShardID);
+        writer.append(transaction.toShardID);
+        writer.append(transaction.to.getKeyHash());
+        writer.append(transaction.amount);
+        writer.append(transaction.payload);
+        writeSignature(writer, transaction.v, transaction.r, transaction.s, include_vrs);
+        writer.endList();
+    });
 }
 
 template <typename Directive>
 Data Signer::rlpNoHash(const Staking<Directive>& transaction, const bool include_vrs) const
     noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-
-    append(encoded, RLP::encode(transaction.directive));
-    append(encoded, rlpNoHashDirective(transaction));
-
-    append(encoded, RLP::encode(transaction.nonce));
-    append(encoded, RLP::encode(transaction.gasPrice));
-    append(encoded, RLP::encode(transaction.gasLimit));
-    if (include_vrs) {
-        append(encoded, RLP::encode(transaction.v));
-        append(encoded, RLP::encode(transaction.r));
-        append(encoded, RLP::encode(transaction.s));
-    } else {
-        append(encoded, RLP::encode(chainID));
-        append(encoded, RLP::encode(0));
-        append(encoded, RLP::encode(0));
-    }
-    return RLP::encodeList(encoded);
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writer.append(FixedUint256(transaction.directive));
+        writeDirective(writer, transaction.stakeMsg);
+        writer.append(transaction.nonce);
+        writer.append(transaction.gasPrice);
+        writer.append(transaction.gasLimit);
+        writeSignature(writer, transaction.v, transaction.r, transaction.s, include_vrs);
+        writer.endList();
+    });
 }
 
-Data Signer::rlpNoHashDirective(const Staking<CreateValidator>& transaction) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-
-    auto descriptionEncoded = Data();
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.name));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.identity));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.website));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.securityContact));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.details));
-    append(encoded, RLP::encodeList(descriptionEncoded));
-
-    auto commissionEncoded = Data();
+static void writeString(RLP::Writer& writer, const std::string& string) {
+    writer.append(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(string.data()), string.size()));
+}
 
-    auto rateEncoded = Data();
-    append(rateEncoded, RLP::encode(transaction.stakeMsg.commissionRates.rate.value));
-    append(commissionEncoded, RLP::encodeList(rateEncoded));
+static void writeDescription(RLP::Writer& writer, const Description& description) {
+    writer.beginList();
+    writeString(writer, description.name);
+    writeString(writer, description.identity);
+    writeString(writer, description.website);
+    writeString(writer, description.securityContact);
+    writeString(writer, description.details);
+    writer.endList();
+}
 
-    auto maxRateEncoded = Data();
-    append(maxRateEncoded, RLP::encode(transaction.stakeMsg.commissionRates.maxRate.value));
-    append(commissionEncoded, RLP::encodeList(maxRateEncoded));
+static void writeDecimal(RLP::Writer& writer, const Decimal& decimal) {
+    writer.beginList();
+    writer.append(decimal.value);
+    writer.endList();
+}
 
-    auto maxChangeRateEncoded = Data();
-    append(maxChangeRateEncoded,
-           RLP::encode(transaction.stakeMsg.commissionRates.maxChangeRate.value));
-    append(commissionEncoded, RLP::encodeList(maxChangeRateEncoded));
+void Signer::writeDirective(RLP::Writer& writer, const CreateValidator& stakeMsg) noexcept {
+    writer.beginList();
+    writer.append(stakeMsg.validatorAddress.getKeyHash());
+    writeDescription(writer, stakeMsg.description);
 
-    append(encoded, RLP::encodeList(commissionEncoded));
+    writer.beginList();
+    writeDecimal(writer, stakeMsg.commissionRates.rate);
+    writeDecimal(writer, stakeMsg.commissionRates.maxRate);
+    writeDecimal(writer, stakeMsg.commissionRates.maxChangeRate);
+    writer.endList();
 
-    append(encoded, RLP::encode(transaction.stakeMsg.minSelfDelegation));
-    append(encoded, RLP::encode(transaction.stakeMsg.maxTotalDelegation));
+    writer.append(stakeMsg.minSelfDelegation);
+    writer.append(stakeMsg.maxTotalDelegation);
 
-    auto slotPubKeysEncoded = Data();
-    for (auto pk : transaction.stakeMsg.slotPubKeys) {
-        append(slotPubKeysEncoded, RLP::encode(pk));
+    writer.beginList();
+    for (const auto& pk : stakeMsg.slotPubKeys) {
+        writer.append(pk);
     }
-    append(encoded, RLP::encodeList(slotPubKeysEncoded));
+    writer.endList();
 
-    auto slotBlsSigsEncoded = Data();
-    for (auto sig : transaction.stakeMsg.slotKeySigs) {
-        append(slotBlsSigsEncoded, RLP::encode(sig));
+    writer.beginList();
+    for (const auto& sig : stakeMsg.slotKeySigs) {
+        writer.append(sig);
     }
-    append(encoded, RLP::encodeList(slotBlsSigsEncoded));
+    writer.endList();
 
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-
-    return RLP::encodeList(encoded);
+    writer.append(stakeMsg.amount);
+    writer.endList();
 }
 
-Data Signer::rlpNoHashDirective(const Staking<EditValidator>& transaction) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
+void Signer::writeDirective(RLP::Writer& writer, const EditValidator& stakeMsg) noexcept {
+    writer.beginList();
+    writer.append(stakeMsg.validatorAddress.getKeyHash());
+    writeDescription(writer, stakeMsg.description);
 
-    auto descriptionEncoded = Data();
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.name));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.identity));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.website));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.securityContact));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.details));
-    append(encoded, RLP::encodeList(descriptionEncoded));
-
-    auto decEncoded = Data();
-    if (transaction.stakeMsg.commissionRate.has_value()) {
+    writer.beginList();
+    if (stakeMsg.commissionRate.has_value()) {
         // Note: std::optional.value() is not available in XCode with target < iOS 12; using '*'
-        append(decEncoded, RLP::encode((*transaction.stakeMsg.commissionRate).value));
+        writer.append((*stakeMsg.commissionRate).value);
     }
-    append(encoded, RLP::encodeList(decEncoded));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.minSelfDelegation));
-    append(encoded, RLP::encode(transaction.stakeMsg.maxTotalDelegation));
+    writer.endList();
 
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToRemove));
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToAdd));
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToAddSig));
+    writer.append(stakeMsg.minSelfDelegation);
+    writer.append(stakeMsg.maxTotalDelegation);
 
-    append(encoded, RLP::encode(transaction.stakeMsg.active));
+    writer.append(stakeMsg.slotKeyToRemove);
+    writer.append(stakeMsg.slotKeyToAdd);
+    writer.append(stakeMsg.slotKeyToAddSig);
 
-    return RLP::encodeList(encoded);
+    writer.append(stakeMsg.active);
+    writer.endList();
 }
 
-Data Signer::rlpNoHashDirective(const Staking<Delegate>& transaction) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-    return RLP::encodeList(encoded);
+void Signer::writeDirective(RLP::Writer& writer, const Delegate& stakeMsg) noexcept {
+    writer.beginList();
+    writer.append(stakeMsg.delegatorAddress.getKeyHash());
+    writer.append(stakeMsg.validatorAddress.getKeyHash());
+    writer.append(stakeMsg.amount);
+    writer.endList();
 }
 
-Data Signer::rlpNoHashDirective(const Staking<Undelegate>& transaction) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-    return RLP::encodeList(encoded);
+void Signer::writeDirective(RLP::Writer& writer, const Undelegate& stakeMsg) noexcept {
+    writer.beginList();
+    writer.append(stakeMsg.delegatorAddress.getKeyHash());
+    writer.append(stakeMsg.validatorAddress.getKeyHash());
+    writer.append(stakeMsg.amount);
+    writer.endList();
 }
 
-Data Signer::rlpNoHashDirective(const Staking<CollectRewards>& transaction) const noexcept {
-    auto encoded = Data();
-    using RLP = TW::Ethereum::RLP;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    return RLP::encodeList(encoded);
+void Signer::writeDirective(RLP::Writer& writer, const CollectRewards& stakeMsg) noexcept {
+    writer.beginList();
+    writer.append(stakeMsg.delegatorAddress.getKeyHash());
+    writer.endList();
 }
 
 std::string Signer::txnAsRLPHex(Transaction& transaction) const noexcept {
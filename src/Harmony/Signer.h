@@ -9,6 +9,7 @@
 #include "Staking.h"
 #include "Transaction.h"
 #include "Data.h"
+#include "../Ethereum/RLP.h"
 #include "../Hash.h"
 #include "../PrivateKey.h"
 #include "../proto/Harmony.pb.h"
@@ -47,6 +48,11 @@ class Signer {
     static Proto::SigningOutput
     signCollectRewards(const Proto::SigningInput &input) noexcept;
 
+    /// Signs a staking transaction with the given directive, common to all the staking messages.
+    template <typename Directive>
+    static Proto::SigningOutput
+    signStaking(const Proto::SigningInput &input, uint8_t directive, Directive stakeMsg) noexcept;
+
   public:
     uint256_t chainID;
 
@@ -89,11 +95,15 @@ class Signer {
     template <typename Directive>
     Data rlpNoHash(const Staking<Directive> &transaction, const bool) const noexcept;
 
-    Data rlpNoHashDirective(const Staking<CreateValidator> &transaction) const noexcept;
-    Data rlpNoHashDirective(const Staking<EditValidator> &transaction) const noexcept;
-    Data rlpNoHashDirective(const Staking<Delegate> &transaction) const noexcept;
-    Data rlpNoHashDirective(const Staking<Undelegate> &transaction) const noexcept;
-    Data rlpNoHashDirective(const Staking<CollectRewards> &transaction) const noexcept;
+    /// Appends the signature values, or the chain identifier and two zeros for the signing pre-image.
+    void writeSignature(Ethereum::RLP::Writer &writer, const uint256_t &v, const uint256_t &r,
+                        const uint256_t &s, const bool include_vrs) const noexcept;
+
+    static void writeDirective(Ethereum::RLP::Writer &writer, const CreateValidator &stakeMsg) noexcept;
+    static void writeDirective(Ethereum::RLP::Writer &writer, const EditValidator &stakeMsg) noexcept;
+    static void writeDirective(Ethereum::RLP::Writer &writer, const Delegate &stakeMsg) noexcept;
+    static void writeDirective(Ethereum::RLP::Writer &writer, const Undelegate &stakeMsg) noexcept;
+    static void writeDirective(Ethereum::RLP::Writer &writer, const CollectRewards &stakeMsg) noexcept;
 };
 
 } // namespace TW::Harmony
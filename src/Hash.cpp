@@ -5,9 +5,16 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Hash.h"
+#include "Groestl.h"
+#include "Keccak.h"
+#include "Sha256.h"
 
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 #include "rust/Wrapper.h"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
 #include <string>
 
 using namespace TW;
@@ -59,6 +66,10 @@ Data Hash::sha1(const byte* data, size_t size) {
 }
 
 Data Hash::sha256(const byte* data, size_t size) {
+    Data digest(Sha256::digestSize);
+    if (Sha256::hash(data, size, digest.data())) {
+        return digest;
+    }
     return Rust::CByteArrayWrapper(Rust::sha256(data, size)).data;
 }
 
@@ -108,10 +119,386 @@ Data Hash::blake2b(const byte* data, size_t dataSize, size_t hashSize, const Dat
 }
 
 Data Hash::groestl512(const byte* data, size_t size) {
+    Data digest(Groestl::digest512Size);
+    if (Groestl::hash512(data, size, digest.data())) {
+        return digest;
+    }
     return Rust::CByteArrayWrapper(Rust::groestl_512(data, size)).data;
 }
 
+namespace {
+
+/// The Rust `*_into` functions return false, without writing the digest, for an unsupported output size.
+void checkWritten(bool written) {
+    if (!written) {
+        throw std::invalid_argument("Invalid hash output size");
+    }
+}
+
+} // namespace
+
+void Hash::sha1Into(const byte* data, size_t size, Digest20& out) {
+    checkWritten(Rust::sha1_into(data, size, out.data(), out.size()));
+}
+
+void Hash::sha256Into(const byte* data, size_t size, Digest32& out) {
+    if (!Sha256::hash(data, size, out.data())) {
+        checkWritten(Rust::sha256_into(data, size, out.data(), out.size()));
+    }
+}
+
+void Hash::sha512Into(const byte* data, size_t size, Digest64& out) {
+    checkWritten(Rust::sha512_into(data, size, out.data(), out.size()));
+}
+
+void Hash::sha512_256Into(const byte* data, size_t size, Digest32& out) {
+    checkWritten(Rust::sha512_256_into(data, size, out.data(), out.size()));
+}
+
+void Hash::keccak256Into(const byte* data, size_t size, Digest32& out) {
+    checkWritten(Rust::keccak256_into(data, size, out.data(), out.size()));
+}
+
+void Hash::keccak512Into(const byte* data, size_t size, Digest64& out) {
+    checkWritten(Rust::keccak512_into(data, size, out.data(), out.size()));
+}
+
+void Hash::sha3_256Into(const byte* data, size_t size, Digest32& out) {
+    checkWritten(Rust::sha3__256_into(data, size, out.data(), out.size()));
+}
+
+void Hash::sha3_512Into(const byte* data, size_t size, Digest64& out) {
+    checkWritten(Rust::sha3__512_into(data, size, out.data(), out.size()));
+}
+
+void Hash::ripemdInto(const byte* data, size_t size, Digest20& out) {
+    checkWritten(Rust::ripemd_160_into(data, size, out.data(), out.size()));
+}
+
+void Hash::blake256Into(const byte* data, size_t size, Digest32& out) {
+    checkWritten(Rust::blake_256_into(data, size, out.data(), out.size()));
+}
+
+void Hash::blake2bInto(const byte* data, size_t dataSize, byte* out, size_t hashSize) {
+    checkWritten(Rust::blake2_b_into(data, dataSize, out, hashSize));
+}
+
+void Hash::groestl512Into(const byte* data, size_t size, Digest64& out) {
+    if (!Groestl::hash512(data, size, out.data())) {
+        checkWritten(Rust::groestl_512_into(data, size, out.data(), out.size()));
+    }
+}
+
+namespace {
+
+struct BatchHasher {
+    Rust::CHashType type;
+    size_t digestSize;
+};
+
+/// The Rust hash function and digest size of the fixed-size, single round hashers.
+std::optional<BatchHasher> batchHasher(Hash::Hasher hasher) {
+    using Type = Rust::CHashType;
+    switch (hasher) {
+    case Hash::HasherSha1:
+        return BatchHasher{Type::Sha1, 20};
+    case Hash::HasherSha256:
+        return BatchHasher{Type::Sha256, 32};
+    case Hash::HasherSha512:
+        return BatchHasher{Type::Sha512, 64};
+    case Hash::HasherSha512_256:
+        return BatchHasher{Type::Sha512_256, 32};
+    case Hash::HasherKeccak256:
+        return BatchHasher{Type::Keccak256, 32};
+    case Hash::HasherKeccak512:
+        return BatchHasher{Type::Keccak512, 64};
+    case Hash::HasherSha3_256:
+        return BatchHasher{Type::Sha3_256, 32};
+    case Hash::HasherSha3_512:
+        return BatchHasher{Type::Sha3_512, 64};
+    case Hash::HasherRipemd:
+        return BatchHasher{Type::Ripemd160, 20};
+    case Hash::HasherBlake256:
+        return BatchHasher{Type::Blake256, 32};
+    case Hash::HasherGroestl512:
+        return BatchHasher{Type::Groestl512, 64};
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+bool Hash::hashBatchInto(Hasher hasher, const std::vector<Data>& inputs, byte* out, size_t outSize) {
+    const auto batch = batchHasher(hasher);
+    if (!batch.has_value()) {
+        return false;
+    }
+    std::vector<const uint8_t*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(inputs.size());
+    sizes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        pointers.push_back(input.data());
+        sizes.push_back(input.size());
+    }
+    const auto accelerated = (hasher == HasherKeccak256 && Keccak::avx2Supported()) ||
+                             (hasher == HasherSha256 && (Sha256::shaniSupported() || Sha256::avx2Supported()));
+    if (accelerated) {
+        if (outSize != inputs.size() * batch->digestSize) {
+            return false;
+        }
+        if (hasher == HasherKeccak256) {
+            keccak256BatchInto(pointers.data(), sizes.data(), inputs.size(), out);
+        } else {
+            sha256BatchInto(pointers.data(), sizes.data(), inputs.size(), out);
+        }
+        return true;
+    }
+    return Rust::hash_batch_into(batch->type, pointers.data(), sizes.data(), inputs.size(), out, outSize);
+}
+
+Data Hash::hashBatch(Hasher hasher, const std::vector<Data>& inputs) {
+    const auto batch = batchHasher(hasher);
+    if (!batch.has_value()) {
+        return {};
+    }
+    Data digests(inputs.size() * batch->digestSize);
+    if (!hashBatchInto(hasher, inputs, digests.data(), digests.size())) {
+        return {};
+    }
+    return digests;
+}
+
+void Hash::keccak256BatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out) {
+    size_t i = 0;
+    while (i < count) {
+        if (i + Keccak::lanes <= count && std::all_of(sizes + i + 1, sizes + i + Keccak::lanes, [&](size_t size) { return size == sizes[i]; }) &&
+            Keccak::hash256x4({data[i], data[i + 1], data[i + 2], data[i + 3]}, sizes[i], out + i * Keccak::digest256Size)) {
+            i += Keccak::lanes;
+            continue;
+        }
+        checkWritten(Rust::keccak256_into(data[i], sizes[i], out + i * Keccak::digest256Size, Keccak::digest256Size));
+        ++i;
+    }
+}
+
+void Hash::sha256BatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out) {
+    size_t i = 0;
+    // SHA-NI hashes a single message about as fast as AVX2 hashes eight
+    while (i < count && !Sha256::shaniSupported()) {
+        if (i + Sha256::lanes > count || !std::all_of(sizes + i + 1, sizes + i + Sha256::lanes, [&](size_t size) { return size == sizes[i]; })) {
+            checkWritten(Rust::sha256_into(data[i], sizes[i], out + i * Sha256::digestSize, Sha256::digestSize));
+            ++i;
+            continue;
+        }
+        const std::array<const byte*, Sha256::lanes> messages = {data[i], data[i + 1], data[i + 2], data[i + 3], data[i + 4], data[i + 5], data[i + 6], data[i + 7]};
+        if (!Sha256::hash8(messages, sizes[i], out + i * Sha256::digestSize)) {
+            break;
+        }
+        i += Sha256::lanes;
+    }
+    for (; i < count; ++i) {
+        Digest32 digest;
+        sha256Into(data[i], sizes[i], digest);
+        std::copy(digest.begin(), digest.end(), out + i * Sha256::digestSize);
+    }
+}
+
+void Hash::sha256dBatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out) {
+    Data first(count * Sha256::digestSize);
+    sha256BatchInto(data, sizes, count, first.data());
+    std::vector<const byte*> pointers(count);
+    for (size_t i = 0; i < count; ++i) {
+        pointers[i] = first.data() + i * Sha256::digestSize;
+    }
+    const std::vector<size_t> firstSizes(count, Sha256::digestSize);
+    sha256BatchInto(pointers.data(), firstSizes.data(), count, out);
+}
+
+void Hash::sha256ripemdBatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out) {
+    Data first(count * Sha256::digestSize);
+    sha256BatchInto(data, sizes, count, first.data());
+    for (size_t i = 0; i < count; ++i) {
+        checkWritten(Rust::ripemd_160_into(first.data() + i * Sha256::digestSize, Sha256::digestSize, out + i * std::tuple_size_v<Digest20>, std::tuple_size_v<Digest20>));
+    }
+}
+
+namespace {
+
+/// Hashes every input with `batchInto` into an array of `N`-byte digests.
+template <std::size_t N>
+std::vector<std::array<byte, N>> batchDigests(const std::vector<Data>& inputs, void (*batchInto)(const byte* const*, const size_t*, size_t, byte*)) {
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(inputs.size());
+    sizes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        pointers.push_back(input.data());
+        sizes.push_back(input.size());
+    }
+    Data out(inputs.size() * N);
+    batchInto(pointers.data(), sizes.data(), inputs.size(), out.data());
+    std::vector<std::array<byte, N>> digests(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::copy_n(out.begin() + i * N, N, digests[i].begin());
+    }
+    return digests;
+}
+
+} // namespace
+
+std::vector<Hash::Digest32> Hash::sha256dBatch(const std::vector<Data>& inputs) {
+    return batchDigests<32>(inputs, sha256dBatchInto);
+}
+
+std::vector<Hash::Digest20> Hash::sha256ripemdBatch(const std::vector<Data>& inputs) {
+    return batchDigests<20>(inputs, sha256ripemdBatchInto);
+}
+
+std::vector<Hash::Digest32> Hash::keccak256Batch(const std::vector<Data>& inputs) {
+    return batchDigests<32>(inputs, keccak256BatchInto);
+}
+
 Data Hash::hmac256(const Data& key, const Data& message) {
     Rust::CByteArrayWrapper res = Rust::hmac__sha256(key.data(), key.size(), message.data(), message.size());
     return res.data;
 }
+
+Hash::StreamHasher::StreamHasher(Hasher hasher) {
+    using Type = Rust::CStreamHasherType;
+    auto streamed = [this](Type type, HasherSimpleType post = nullptr) {
+        context = Rust::stream_hasher_new(type);
+        postHasher = post;
+    };
+
+    switch (hasher) {
+    case HasherSha256:
+        streamed(Type::Sha256);
+        break;
+    case HasherSha256d:
+        streamed(Type::Sha256, Hash::sha256);
+        break;
+    case HasherSha256ripemd:
+        streamed(Type::Sha256, Hash::ripemd);
+        break;
+    case HasherSha512:
+        streamed(Type::Sha512);
+        break;
+    case HasherSha512_256:
+        streamed(Type::Sha512_256);
+        break;
+    case HasherKeccak256:
+        streamed(Type::Keccak256);
+        break;
+    case HasherSha3_256:
+        streamed(Type::Sha3_256);
+        break;
+    case HasherSha3_256ripemd:
+        streamed(Type::Sha3_256, Hash::ripemd);
+        break;
+    case HasherBlake256:
+        streamed(Type::Blake256);
+        break;
+    case HasherBlake256d:
+        streamed(Type::Blake256, Hash::blake256);
+        break;
+    case HasherBlake256ripemd:
+        streamed(Type::Blake256, Hash::ripemd);
+        break;
+    case HasherGroestl512:
+        streamed(Type::Groestl512);
+        break;
+    case HasherGroestl512d:
+        streamed(Type::Groestl512, Hash::groestl512);
+        break;
+    case HasherBlake2b:
+        context = Rust::stream_hasher_new_blake2b(32, nullptr, 0);
+        break;
+    default:
+        bufferedHasher = functionPointerFromEnum(hasher);
+        break;
+    }
+}
+
+Hash::StreamHasher Hash::StreamHasher::blake2b(size_t hashSize, const Data& personal) {
+    StreamHasher result;
+    result.context = Rust::stream_hasher_new_blake2b(hashSize, personal.data(), personal.size());
+    if (result.context == nullptr) {
+        throw std::invalid_argument("Invalid Blake2b parameters");
+    }
+    return result;
+}
+
+Hash::StreamHasher::StreamHasher(const StreamHasher& other)
+    : context(other.context != nullptr ? Rust::stream_hasher_clone(other.context) : nullptr),
+      postHasher(other.postHasher),
+      bufferedHasher(other.bufferedHasher),
+      buffer(other.buffer),
+      finalized(other.finalized) {
+}
+
+Hash::StreamHasher::StreamHasher(StreamHasher&& other) noexcept
+    : context(other.context),
+      postHasher(other.postHasher),
+      bufferedHasher(other.bufferedHasher),
+      buffer(std::move(other.buffer)),
+      finalized(other.finalized) {
+    other.context = nullptr;
+    other.finalized = true;
+}
+
+Hash::StreamHasher& Hash::StreamHasher::operator=(const StreamHasher& other) {
+    if (this != &other) {
+        *this = StreamHasher(other);
+    }
+    return *this;
+}
+
+Hash::StreamHasher& Hash::StreamHasher::operator=(StreamHasher&& other) noexcept {
+    if (this != &other) {
+        Rust::stream_hasher_free(context);
+        context = other.context;
+        postHasher = other.postHasher;
+        bufferedHasher = other.bufferedHasher;
+        buffer = std::move(other.buffer);
+        finalized = other.finalized;
+        other.context = nullptr;
+        other.finalized = true;
+    }
+    return *this;
+}
+
+Hash::StreamHasher::~StreamHasher() {
+    Rust::stream_hasher_free(context);
+}
+
+Hash::StreamHasher& Hash::StreamHasher::update(const byte* data, size_t size) {
+    if (finalized) {
+        throw std::logic_error("StreamHasher has been finalized already");
+    }
+    if (context != nullptr) {
+        Rust::stream_hasher_update(context, data, size);
+    } else {
+        buffer.insert(buffer.end(), data, data + size);
+    }
+    return *this;
+}
+
+Data Hash::StreamHasher::finalize() {
+    if (finalized) {
+        throw std::logic_error("StreamHasher has been finalized already");
+    }
+    finalized = true;
+
+    if (context == nullptr) {
+        return bufferedHasher(buffer.data(), buffer.size());
+    }
+    // `stream_hasher_finalize` consumes the context.
+    Data digest = Rust::CByteArrayWrapper(Rust::stream_hasher_finalize(context)).data;
+    context = nullptr;
+    if (postHasher != nullptr) {
+        return postHasher(digest.data(), digest.size());
+    }
+    return digest;
+}
@@ -8,7 +8,14 @@
 
 #include "Data.h"
 
+#include <array>
 #include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace TW::Rust {
+struct StreamHasher;
+} // namespace TW::Rust
 
 namespace TW::Hash {
 
@@ -53,6 +60,11 @@ static const size_t sha512Size = 64;
 /// Number of bytes in a RIPEMD160 hash.
 static const size_t ripemdSize = 20;
 
+/// Fixed-size digests, used by the allocation-free hashing functions.
+using Digest20 = std::array<byte, 20>;
+using Digest32 = std::array<byte, 32>;
+using Digest64 = std::array<byte, 64>;
+
 /// Computes the SHA1 hash.
 Data sha1(const byte* data, size_t size);
 
@@ -216,7 +228,323 @@ inline Data groestl512d(const byte* data, size_t size) {
     return groestl512(groestl512(data, size));
 }
 
+// Allocation-free versions, writing the digest into a caller-provided fixed-size buffer.
+// They throw std::invalid_argument if the digest can't be written, such as for an unsupported Blake2b size.
+
+/// Computes the SHA1 hash into `out`.
+void sha1Into(const byte* data, size_t size, Digest20& out);
+
+/// Computes the SHA256 hash into `out`.
+void sha256Into(const byte* data, size_t size, Digest32& out);
+
+/// Computes the SHA512 hash into `out`.
+void sha512Into(const byte* data, size_t size, Digest64& out);
+
+/// Computes the SHA512/256 hash into `out`.
+void sha512_256Into(const byte* data, size_t size, Digest32& out);
+
+/// Computes the Keccak SHA256 hash into `out`.
+void keccak256Into(const byte* data, size_t size, Digest32& out);
+
+/// Computes the Keccak SHA512 hash into `out`.
+void keccak512Into(const byte* data, size_t size, Digest64& out);
+
+/// Computes the version 3 SHA256 hash into `out`.
+void sha3_256Into(const byte* data, size_t size, Digest32& out);
+
+/// Computes the version 3 SHA512 hash into `out`.
+void sha3_512Into(const byte* data, size_t size, Digest64& out);
+
+/// Computes the RIPEMD160 hash into `out`.
+void ripemdInto(const byte* data, size_t size, Digest20& out);
+
+/// Computes the Blake256 hash into `out`.
+void blake256Into(const byte* data, size_t size, Digest32& out);
+
+/// Computes the Blake2b hash of `hashSize` bytes into `out`.
+void blake2bInto(const byte* data, size_t dataSize, byte* out, size_t hashSize);
+
+/// Computes the Blake2b hash into `out`, the hash size is the size of `out`.
+template <std::size_t N>
+void blake2bInto(const byte* data, size_t dataSize, std::array<byte, N>& out) {
+    blake2bInto(data, dataSize, out.data(), out.size());
+}
+
+/// Computes the Groestl 512 hash into `out`.
+void groestl512Into(const byte* data, size_t size, Digest64& out);
+
+/// Computes the SHA256 hash of the SHA256 hash into `out`.
+inline void sha256dInto(const byte* data, size_t size, Digest32& out) {
+    Digest32 first;
+    sha256Into(data, size, first);
+    sha256Into(first.data(), first.size(), out);
+}
+
+/// Computes the ripemd hash of the SHA256 hash into `out`.
+inline void sha256ripemdInto(const byte* data, size_t size, Digest20& out) {
+    Digest32 first;
+    sha256Into(data, size, first);
+    ripemdInto(first.data(), first.size(), out);
+}
+
+/// Computes the Blake256 hash of the Blake256 hash into `out`.
+inline void blake256dInto(const byte* data, size_t size, Digest32& out) {
+    Digest32 first;
+    blake256Into(data, size, first);
+    blake256Into(first.data(), first.size(), out);
+}
+
+/// Computes the ripemd hash of the Blake256 hash into `out`.
+inline void blake256ripemdInto(const byte* data, size_t size, Digest20& out) {
+    Digest32 first;
+    blake256Into(data, size, first);
+    ripemdInto(first.data(), first.size(), out);
+}
+
+/// Computes the SHA256 hash and returns it as a fixed-size array.
+inline Digest32 sha256Into(const byte* data, size_t size) {
+    Digest32 out;
+    sha256Into(data, size, out);
+    return out;
+}
+
+/// Computes the Keccak SHA256 hash and returns it as a fixed-size array.
+inline Digest32 keccak256Into(const byte* data, size_t size) {
+    Digest32 out;
+    keccak256Into(data, size, out);
+    return out;
+}
+
+/// Computes the SHA256 hash of the SHA256 hash and returns it as a fixed-size array.
+inline Digest32 sha256dInto(const byte* data, size_t size) {
+    Digest32 out;
+    sha256dInto(data, size, out);
+    return out;
+}
+
+/// Computes the ripemd hash of the SHA256 hash and returns it as a fixed-size array.
+inline Digest20 sha256ripemdInto(const byte* data, size_t size) {
+    Digest20 out;
+    sha256ripemdInto(data, size, out);
+    return out;
+}
+
+/// Computes the Blake256 hash and returns it as a fixed-size array.
+inline Digest32 blake256Into(const byte* data, size_t size) {
+    Digest32 out;
+    blake256Into(data, size, out);
+    return out;
+}
+
+/// Computes the SHA256 hash of any type with data() and size() and returns it as a fixed-size array.
+template <typename T>
+Digest32 sha256Into(const T& data) {
+    return sha256Into(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
+/// Computes the Keccak SHA256 hash of any type with data() and size() and returns it as a fixed-size array.
+template <typename T>
+Digest32 keccak256Into(const T& data) {
+    return keccak256Into(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
+/// Computes the ripemd hash of the SHA256 hash of any type with data() and size() and returns it as a fixed-size array.
+template <typename T>
+Digest20 sha256ripemdInto(const T& data) {
+    return sha256ripemdInto(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
+// Compile-time hasher selection: the hash function is resolved at compile time and hashes into a fixed-size
+// digest, so that callers with a fixed hasher get direct, allocation-free calls instead of `functionPointerFromEnum`.
+
+/// Number of bytes in the digest of a hasher (Blake2b with its default size).
+constexpr std::size_t digestSize(Hasher hasher) noexcept {
+    switch (hasher) {
+    case HasherSha1:
+    case HasherRipemd:
+    case HasherSha256ripemd:
+    case HasherSha3_256ripemd:
+    case HasherBlake256ripemd:
+        return 20;
+    case HasherSha512:
+    case HasherKeccak512:
+    case HasherSha3_512:
+    case HasherGroestl512:
+    case HasherGroestl512d:
+        return 64;
+    default:
+        return 32;
+    }
+}
+
+/// Fixed-size digest of a hasher.
+template <Hasher H>
+using Digest = std::array<byte, digestSize(H)>;
+
+/// Selects a hasher at compile time where template arguments can't be given explicitly, e.g. in a constructor.
+template <Hasher H>
+using HasherConstant = std::integral_constant<Hasher, H>;
+
+/// Computes the hash of a hasher known at compile time into a fixed-size digest.
+template <Hasher H>
+Digest<H> hashInto(const byte* data, size_t size) {
+    Digest<H> out;
+    if constexpr (H == HasherSha1) {
+        sha1Into(data, size, out);
+    } else if constexpr (H == HasherSha512) {
+        sha512Into(data, size, out);
+    } else if constexpr (H == HasherSha512_256) {
+        sha512_256Into(data, size, out);
+    } else if constexpr (H == HasherKeccak256) {
+        keccak256Into(data, size, out);
+    } else if constexpr (H == HasherKeccak512) {
+        keccak512Into(data, size, out);
+    } else if constexpr (H == HasherSha3_256) {
+        sha3_256Into(data, size, out);
+    } else if constexpr (H == HasherSha3_512) {
+        sha3_512Into(data, size, out);
+    } else if constexpr (H == HasherRipemd) {
+        ripemdInto(data, size, out);
+    } else if constexpr (H == HasherBlake2b) {
+        blake2bInto(data, size, out);
+    } else if constexpr (H == HasherBlake256) {
+        blake256Into(data, size, out);
+    } else if constexpr (H == HasherGroestl512) {
+        groestl512Into(data, size, out);
+    } else if constexpr (H == HasherSha256d) {
+        sha256dInto(data, size, out);
+    } else if constexpr (H == HasherSha256ripemd) {
+        sha256ripemdInto(data, size, out);
+    } else if constexpr (H == HasherSha3_256ripemd) {
+        Digest32 first;
+        sha3_256Into(data, size, first);
+        ripemdInto(first.data(), first.size(), out);
+    } else if constexpr (H == HasherBlake256d) {
+        blake256dInto(data, size, out);
+    } else if constexpr (H == HasherBlake256ripemd) {
+        blake256ripemdInto(data, size, out);
+    } else if constexpr (H == HasherGroestl512d) {
+        Digest64 first;
+        groestl512Into(data, size, first);
+        groestl512Into(first.data(), first.size(), out);
+    } else {
+        sha256Into(data, size, out);
+    }
+    return out;
+}
+
+/// Computes the hash of a hasher known at compile time of any type with data() and size().
+template <Hasher H, typename T>
+Digest<H> hashInto(const T& data) {
+    return hashInto<H>(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
+/// Calls `f` with the `HasherConstant` of a hasher selected at runtime, resolving the selection once into the
+/// compile-time versions. Unknown values select SHA256, as `functionPointerFromEnum` does.
+template <typename F>
+decltype(auto) withHasher(Hasher hasher, F&& f) {
+    switch (hasher) {
+    case HasherSha1: return f(HasherConstant<HasherSha1>{});
+    case HasherSha512: return f(HasherConstant<HasherSha512>{});
+    case HasherSha512_256: return f(HasherConstant<HasherSha512_256>{});
+    case HasherKeccak256: return f(HasherConstant<HasherKeccak256>{});
+    case HasherKeccak512: return f(HasherConstant<HasherKeccak512>{});
+    case HasherSha3_256: return f(HasherConstant<HasherSha3_256>{});
+    case HasherSha3_512: return f(HasherConstant<HasherSha3_512>{});
+    case HasherRipemd: return f(HasherConstant<HasherRipemd>{});
+    case HasherBlake2b: return f(HasherConstant<HasherBlake2b>{});
+    case HasherBlake256: return f(HasherConstant<HasherBlake256>{});
+    case HasherGroestl512: return f(HasherConstant<HasherGroestl512>{});
+    case HasherSha256d: return f(HasherConstant<HasherSha256d>{});
+    case HasherSha256ripemd: return f(HasherConstant<HasherSha256ripemd>{});
+    case HasherSha3_256ripemd: return f(HasherConstant<HasherSha3_256ripemd>{});
+    case HasherBlake256d: return f(HasherConstant<HasherBlake256d>{});
+    case HasherBlake256ripemd: return f(HasherConstant<HasherBlake256ripemd>{});
+    case HasherGroestl512d: return f(HasherConstant<HasherGroestl512d>{});
+    case HasherSha256:
+    default:
+        return f(HasherConstant<HasherSha256>{});
+    }
+}
+
+// Batch versions, hashing many inputs in a single call into the Rust library.
+
+/// Hashes every input, writing the digests one after the other into `out`.
+/// Supports the fixed-size, single round hashers (SHA1 to Groestl512 except Blake2b).
+/// \returns false for other hashers, or if `outSize` is not `inputs.size()` digests.
+bool hashBatchInto(Hasher hasher, const std::vector<Data>& inputs, byte* out, size_t outSize);
+
+/// Hashes every input, returns the concatenated digests, or empty data for an unsupported hasher.
+Data hashBatch(Hasher hasher, const std::vector<Data>& inputs);
+
+/// Computes the Keccak SHA256 hash of `count` inputs of `sizes[i]` bytes at `data[i]`, writing the digests one after
+/// the other into `out`. Runs of four inputs of the same size are hashed together with AVX2 when the CPU supports it.
+void keccak256BatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out);
+
+/// Computes the Keccak SHA256 hash of every input, see `keccak256BatchInto`.
+std::vector<Digest32> keccak256Batch(const std::vector<Data>& inputs);
+
+/// Computes the SHA256 hash of `count` inputs of `sizes[i]` bytes at `data[i]`, writing the digests one after the other
+/// into `out`. Uses SHA-NI when the CPU supports it, otherwise hashes runs of eight inputs of the same size together with AVX2.
+void sha256BatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out);
+
+/// Computes the SHA256 hash of the SHA256 hash of `count` inputs, see `sha256BatchInto`.
+void sha256dBatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out);
+
+/// Computes the ripemd hash of the SHA256 hash (hash160) of `count` inputs, 20-byte digests, see `sha256BatchInto`.
+void sha256ripemdBatchInto(const byte* const* data, const size_t* sizes, size_t count, byte* out);
+
+/// Computes the SHA256 hash of the SHA256 hash of every input.
+std::vector<Digest32> sha256dBatch(const std::vector<Data>& inputs);
+
+/// Computes the ripemd hash of the SHA256 hash of every input.
+std::vector<Digest20> sha256ripemdBatch(const std::vector<Data>& inputs);
+
 /// Compute the SHA256-based HMAC of a message
 Data hmac256(const Data& key, const Data& message);
 
+/// Incremental (init/update/finalize) hasher, allows to feed the data in chunks
+/// instead of concatenating it into an intermediate buffer first.
+/// SHA256, SHA512, SHA512/256, Keccak256, SHA3-256, Blake256, Groestl512 and Blake2b (including their double/ripemd
+/// combinations) are streamed natively, other hash functions buffer the input internally.
+/// The hasher can't be updated after `finalize()`.
+class StreamHasher {
+public:
+    /// Creates a hasher for the given hash function.
+    explicit StreamHasher(Hasher hasher);
+
+    /// Creates a Blake2b hasher with an optional personalization (up to 16 bytes).
+    /// Throws `std::invalid_argument` if the parameters are invalid.
+    static StreamHasher blake2b(size_t hashSize, const Data& personal = {});
+
+    StreamHasher(const StreamHasher& other);
+    StreamHasher(StreamHasher&& other) noexcept;
+    StreamHasher& operator=(const StreamHasher& other);
+    StreamHasher& operator=(StreamHasher&& other) noexcept;
+    ~StreamHasher();
+
+    /// Feeds the data into the hasher.
+    StreamHasher& update(const byte* data, size_t size);
+
+    /// Feeds the data of any type with data() and size() into the hasher.
+    template <typename T>
+    StreamHasher& update(const T& data) {
+        return update(reinterpret_cast<const byte*>(data.data()), data.size());
+    }
+
+    /// Computes the resulting digest.
+    Data finalize();
+
+private:
+    StreamHasher() = default;
+
+    Rust::StreamHasher* context = nullptr;
+    /// Hash function applied to the streamed digest, e.g. the second round of SHA256d.
+    HasherSimpleType postHasher = nullptr;
+    /// Hash function used for the buffered input, when native streaming isn't supported.
+    HasherSimpleType bufferedHasher = nullptr;
+    Data buffer;
+    bool finalized = false;
+};
+
 } // namespace TW::Hash
@@ -19,16 +19,11 @@ namespace TW::Hedera::internal {
 namespace TW::Hedera {
 
 
-Alias::Alias(std::optional<PublicKey> alias) noexcept : mPubKey(std::move(alias)) {
-
-}
-
-std::string Alias::string() const noexcept {
-    std::string pubkeyBytes = "";
+Alias::Alias(std::optional<PublicKey> alias) noexcept
+    : mPubKey(std::move(alias)), mDer(gHederaDerPrefixPublic) {
     if (mPubKey.has_value()) {
-        pubkeyBytes = hex(mPubKey.value().bytes);
+        mDer += hex(mPubKey.value().bytes);
     }
-    return gHederaDerPrefixPublic + pubkeyBytes;
 }
 
 bool Address::isValid(const std::string& string) {
@@ -16,8 +16,12 @@ namespace TW::Hedera {
 
 struct Alias {
     explicit Alias(std::optional<PublicKey> alias = std::nullopt) noexcept;
-    std::string string() const noexcept;
+    /// Hex of the DER encoding of the public key, encoded once at construction.
+    const std::string& string() const noexcept { return mDer; }
     std::optional<PublicKey> mPubKey{std::nullopt};
+
+private:
+    std::string mDer;
 };
 
 class Address {
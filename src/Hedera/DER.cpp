@@ -8,11 +8,14 @@
 #include "PublicKey.h"
 #include "HexCoding.h"
 
+#include <string_view>
+
 namespace TW::Hedera {
 
 bool hasDerPrefix(const std::string& input) noexcept {
-    if (std::size_t pos = input.find(gHederaDerPrefixPublic); pos != std::string::npos) {
-        return PublicKey::isValid(parse_hex(input.substr(pos + std::string(gHederaDerPrefixPublic).size())), TWPublicKeyTypeED25519);
+    static constexpr std::string_view prefix = gHederaDerPrefixPublic;
+    if (std::size_t pos = input.find(prefix); pos != std::string::npos) {
+        return PublicKey::isValid(parse_hex(input.substr(pos + prefix.size())), TWPublicKeyTypeED25519);
     }
     return false;
 }
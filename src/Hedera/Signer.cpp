@@ -9,6 +9,7 @@
 #include "HexCoding.h"
 #include "Protobuf/transaction_body.pb.h"
 #include "Protobuf/transaction_contents.pb.h"
+#include "../CryptoBackend.h"
 #include "../PublicKey.h"
 
 namespace TW::Hedera::internals {
@@ -28,58 +29,74 @@ static inline proto::Timestamp timestampFromTWProto(const Proto::Timestamp& inpu
     return timestamp;
 }
 
-static inline proto::TransactionID transactionIDFromSigningInput(const Proto::SigningInput& input) {
+static inline proto::TransactionID transactionIDFromSigningInput(const Proto::TransactionBody& input) {
     auto transactionID = proto::TransactionID();
-    *transactionID.mutable_transactionvalidstart() = timestampFromTWProto(input.body().transactionid().transactionvalidstart());
-    *transactionID.mutable_accountid() = accountIDfromStr(input.body().transactionid().accountid());
+    *transactionID.mutable_transactionvalidstart() = timestampFromTWProto(input.transactionid().transactionvalidstart());
+    *transactionID.mutable_accountid() = accountIDfromStr(input.transactionid().accountid());
     return transactionID;
 }
 
-static inline proto::TransactionBody transactionBodyPrerequisites(const Proto::SigningInput& input) {
+static inline proto::TransactionBody transactionBodyPrerequisites(const Proto::TransactionBody& input) {
     auto body = proto::TransactionBody();
-    body.set_memo(input.body().memo());
-    body.set_transactionfee(input.body().transactionfee());
-    *body.mutable_nodeaccountid() = accountIDfromStr(input.body().nodeaccountid());
-    body.mutable_transactionvalidduration()->set_seconds(input.body().transactionvalidduration());
+    body.set_memo(input.memo());
+    body.set_transactionfee(input.transactionfee());
+    *body.mutable_nodeaccountid() = accountIDfromStr(input.nodeaccountid());
+    body.mutable_transactionvalidduration()->set_seconds(input.transactionvalidduration());
     *body.mutable_transactionid() = transactionIDFromSigningInput(input);
     return body;
 }
 
-static inline proto::TransferList transferListFromInput(const Proto::SigningInput& input) {
+static inline proto::TransferList transferListFromInput(const Proto::TransactionBody& input) {
     auto transferList = proto::TransferList();
-    auto fromAccountID = accountIDfromStr(input.body().transfer().from());
-    auto amount = input.body().transfer().amount();
+    auto fromAccountID = accountIDfromStr(input.transfer().from());
+    auto amount = input.transfer().amount();
     auto* to = transferList.add_accountamounts();
     to->set_amount(amount);
-    *to->mutable_accountid() = accountIDfromStr(input.body().transfer().to());
+    *to->mutable_accountid() = accountIDfromStr(input.transfer().to());
     auto* from = transferList.add_accountamounts();
     from->set_amount(-amount);
     *from->mutable_accountid() = fromAccountID;
     return transferList;
 }
 
-static inline proto::CryptoTransferTransactionBody cryptoTransferFromInput(const Proto::SigningInput& input) {
+static inline proto::CryptoTransferTransactionBody cryptoTransferFromInput(const Proto::TransactionBody& input) {
     auto transferList = transferListFromInput(input);
     auto cryptoTransfer = proto::CryptoTransferTransactionBody();
     *cryptoTransfer.mutable_transfers() = transferList;
     return cryptoTransfer;
 }
 
-static inline Proto::SigningOutput sign(const proto::TransactionBody& body, const PrivateKey& privateKey) {
+static inline proto::TransactionBody transactionBodyFromInput(const Proto::TransactionBody& input) {
+    auto body = transactionBodyPrerequisites(input);
+    switch (input.data_case()) {
+    case Proto::TransactionBody::kTransfer: {
+        *body.mutable_cryptotransfer() = cryptoTransferFromInput(input);
+        break;
+    }
+    case Proto::TransactionBody::DATA_NOT_SET:
+        break;
+    default:
+        break;
+    }
+    return body;
+}
+
+/// Signs `body` into a `SignedTransaction`. The body is serialized once, straight into the body bytes of
+/// the signed transaction, and the signature and public key are written into their fields in place.
+static inline Proto::SigningOutput sign(const proto::TransactionBody& body, const PrivateKey& privateKey, const Data& publicKey) {
     auto protoOutput = Proto::SigningOutput();
-    Data encoded;
-    auto encodedBody = data(body.SerializeAsString());
-    auto signedBody = privateKey.sign(encodedBody, TWCurveED25519);
-    auto sigMap = proto::SignatureMap();
-    auto* sigPair = sigMap.add_sigpair();
-    sigPair->set_ed25519(signedBody.data(), signedBody.size());
-    auto pubKey = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
-    sigPair->set_pubkeyprefix(pubKey.data(), pubKey.size());
     auto signedTx = proto::SignedTransaction();
-    signedTx.set_bodybytes(encodedBody.data(), encodedBody.size());
-    *signedTx.mutable_sigmap() = sigMap;
-    encoded = data(signedTx.SerializeAsString());
-    protoOutput.set_encoded(encoded.data(), encoded.size());
+    auto& encodedBody = *signedTx.mutable_bodybytes();
+    body.SerializeToString(&encodedBody);
+
+    auto* sigPair = signedTx.mutable_sigmap()->add_sigpair();
+    auto& signature = *sigPair->mutable_ed25519();
+    signature.resize(64);
+    CryptoBackend::current().eddsaSign(TWCurveED25519, privateKey.key().data(), nullptr, reinterpret_cast<const byte*>(encodedBody.data()),
+                                       encodedBody.size(), reinterpret_cast<byte*>(signature.data()));
+    sigPair->set_pubkeyprefix(publicKey.data(), publicKey.size());
+
+    signedTx.SerializeToString(protoOutput.mutable_encoded());
     return protoOutput;
 }
 
@@ -89,19 +106,18 @@ namespace TW::Hedera {
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto body = internals::transactionBodyPrerequisites(input);
+    const Data publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
+    return internals::sign(internals::transactionBodyFromInput(input.body()), privateKey, publicKey);
+}
 
-    switch (input.body().data_case()) {
-    case Proto::TransactionBody::kTransfer: {
-        *body.mutable_cryptotransfer() = internals::cryptoTransferFromInput(input);
-        break;
-    }
-    case Proto::TransactionBody::DATA_NOT_SET:
-        break;
-    default:
-        break;
+std::vector<Proto::SigningOutput> Signer::signBatch(const PrivateKey& privateKey, const std::vector<Proto::TransactionBody>& bodies) {
+    const Data publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(bodies.size());
+    for (const auto& body : bodies) {
+        outputs.emplace_back(internals::sign(internals::transactionBodyFromInput(body), privateKey, publicKey));
     }
-    return internals::sign(body, privateKey);
+    return outputs;
 }
 
 } // namespace TW::Hedera
@@ -10,6 +10,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Hedera.pb.h"
 
+#include <vector>
+
 namespace TW::Hedera {
 
 /// Helper class that performs Hedera transaction signing.
@@ -20,6 +22,9 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many transactions with the same key, computing its public key once.
+    static std::vector<Proto::SigningOutput> signBatch(const PrivateKey& privateKey, const std::vector<Proto::TransactionBody>& bodies);
 };
 
 } // namespace TW::Hedera
@@ -0,0 +1,202 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+
+#include <array>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace TW {
+
+namespace {
+
+constexpr char hexDigits[] = "0123456789abcdef";
+
+constexpr uint8_t invalidNibble = 0xff;
+
+/// Maps an ASCII character to its hexadecimal value, or `invalidNibble`.
+constexpr std::array<uint8_t, 256> nibbleTable = [] {
+    std::array<uint8_t, 256> table{};
+    table.fill(invalidNibble);
+    for (uint8_t i = 0; i < 10; ++i) {
+        table['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; ++i) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+    return table;
+}();
+
+void encodeScalar(const byte* data, std::size_t size, char* out) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        out[2 * i] = hexDigits[data[i] >> 4];
+        out[2 * i + 1] = hexDigits[data[i] & 0x0f];
+    }
+}
+
+bool decodeScalar(const char* hex, std::size_t size, byte* out) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto high = nibbleTable[static_cast<uint8_t>(hex[2 * i])];
+        const auto low = nibbleTable[static_cast<uint8_t>(hex[2 * i + 1])];
+        if ((high | low) > 0x0f) {
+            return false;
+        }
+        out[i] = static_cast<byte>((high << 4) | low);
+    }
+    return true;
+}
+
+#if defined(__SSE2__)
+
+/// Converts 16 nibbles to their lowercase hexadecimal characters.
+inline __m128i nibblesToChars(__m128i nibbles) {
+    const auto letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+/// Unsigned `value <= limit` per byte.
+inline __m128i lessOrEqual(__m128i value, __m128i limit) {
+    return _mm_cmpeq_epi8(_mm_min_epu8(value, limit), value);
+}
+
+/// Converts 16 hexadecimal characters to nibbles; clears `valid` if any of them is not a hex digit.
+inline __m128i charsToNibbles(__m128i chars, bool& valid) {
+    const auto digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const auto letters = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const auto isDigit = lessOrEqual(digits, _mm_set1_epi8(9));
+    const auto isLetter = lessOrEqual(letters, _mm_set1_epi8(5));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff) {
+        valid = false;
+    }
+    const auto letterValues = _mm_add_epi8(letters, _mm_set1_epi8(10));
+    return _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_andnot_si128(isDigit, letterValues));
+}
+
+/// Packs 16 nibbles (high, low, high, low, ...) into 8 bytes, in the low half of every 16-bit lane.
+inline __m128i packNibbles(__m128i nibbles) {
+    const auto high = _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00f0));
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+
+std::size_t encodeBlocks(const byte* data, std::size_t size, char* out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto high = nibblesToChars(_mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0f)));
+        const auto low = nibblesToChars(_mm_and_si128(bytes, _mm_set1_epi8(0x0f)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+std::size_t decodeBlocks(const char* hex, std::size_t size, byte* out, bool& valid) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size && valid; i += 16) {
+        const auto first = charsToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i)), valid);
+        const auto second = charsToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 2 * i + 16)), valid);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(packNibbles(first), packNibbles(second)));
+    }
+    return i;
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+/// Converts 16 nibbles to their lowercase hexadecimal characters.
+inline uint8x16_t nibblesToChars(uint8x16_t nibbles) {
+    const auto letters = vandq_u8(vcgtq_u8(nibbles, vdupq_n_u8(9)), vdupq_n_u8('a' - '0' - 10));
+    return vaddq_u8(vaddq_u8(nibbles, vdupq_n_u8('0')), letters);
+}
+
+/// Converts 16 hexadecimal characters to nibbles; clears `valid` if any of them is not a hex digit.
+inline uint8x16_t charsToNibbles(uint8x16_t chars, bool& valid) {
+    const auto digits = vsubq_u8(chars, vdupq_n_u8('0'));
+    const auto letters = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const auto isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+    const auto isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+    if (vminvq_u8(vorrq_u8(isDigit, isLetter)) == 0) {
+        valid = false;
+    }
+    return vbslq_u8(isDigit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+}
+
+std::size_t encodeBlocks(const byte* data, std::size_t size, char* out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto bytes = vld1q_u8(data + i);
+        uint8x16x2_t chars;
+        chars.val[0] = nibblesToChars(vshrq_n_u8(bytes, 4));
+        chars.val[1] = nibblesToChars(vandq_u8(bytes, vdupq_n_u8(0x0f)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), chars);
+    }
+    return i;
+}
+
+std::size_t decodeBlocks(const char* hex, std::size_t size, byte* out, bool& valid) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size && valid; i += 16) {
+        const auto chars = vld2q_u8(reinterpret_cast<const uint8_t*>(hex + 2 * i));
+        const auto high = charsToNibbles(chars.val[0], valid);
+        const auto low = charsToNibbles(chars.val[1], valid);
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return i;
+}
+
+#else
+
+std::size_t encodeBlocks(const byte*, std::size_t, char*) noexcept {
+    return 0;
+}
+
+std::size_t decodeBlocks(const char*, std::size_t, byte*, bool&) noexcept {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+void encodeHex(const byte* data, std::size_t size, char* out) noexcept {
+    const auto done = encodeBlocks(data, size, out);
+    encodeScalar(data + done, size - done, out + 2 * done);
+}
+
+bool decodeHex(const char* hex, std::size_t size, byte* out) noexcept {
+    bool valid = true;
+    const auto done = decodeBlocks(hex, size, out, valid);
+    return valid && decodeScalar(hex + 2 * done, size - done, out + done);
+}
+
+void appendHex(const byte* data, std::size_t size, std::string& out) {
+    const auto offset = out.size();
+    out.resize(offset + 2 * size);
+    encodeHex(data, size, out.data() + offset);
+}
+
+bool appendParsedHex(std::string_view hex, Data& out) {
+    while (hex.starts_with("0x")) {
+        hex.remove_prefix(2);
+    }
+    if (hex.size() % 2 != 0) {
+        return false;
+    }
+    const auto offset = out.size();
+    out.resize(offset + hex.size() / 2);
+    if (!decodeHex(hex.data(), hex.size() / 2, out.data() + offset)) {
+        out.resize(offset);
+        return false;
+    }
+    return true;
+}
+
+} // namespace TW
@@ -14,21 +14,44 @@
 #include <array>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 
+namespace TW {
+
+/// Writes the lowercase hexadecimal representation of `size` bytes to `out`,
+/// which must have room for `2 * size` characters.
+/// Uses SSE2 on x86-64 and NEON on arm64, with a scalar fallback elsewhere.
+void encodeHex(const byte* data, std::size_t size, char* out) noexcept;
+
+/// Decodes `2 * size` hexadecimal characters (either case) into `size` bytes at `out`.
+/// \returns false if any character is not a hexadecimal digit; `out` is then unspecified.
+bool decodeHex(const char* hex, std::size_t size, byte* out) noexcept;
+
+/// Appends the lowercase hexadecimal representation of `size` bytes to `out`.
+void appendHex(const byte* data, std::size_t size, std::string& out);
+
+/// Appends the bytes of a hexadecimal string, optionally `0x` prefixed, to `out`.
+/// \returns false and leaves `out` unchanged if the string is not valid hexadecimal.
+bool appendParsedHex(std::string_view hex, Data& out);
+
+} // namespace TW
+
 namespace TW::internal {
 /// Parses a string of hexadecimal values.
 ///
 /// \returns the array or parsed bytes or an empty array if the string is not
 /// valid hexadecimal.
 inline Data parse_hex(const std::string& input) {
-    if (input.empty()) {
+    Data out;
+    // Read up to the first NUL, like a C string.
+    const std::string_view hex(input.c_str());
+    out.reserve(hex.size() / 2);
+    if (!appendParsedHex(hex, out)) {
         return {};
     }
-
-    Rust::CByteArrayResultWrapper res = Rust::decode_hex(input.c_str());
-    return res.unwrap_or_default().data;
+    return out;
 }
 }
 
@@ -46,20 +69,21 @@ inline bool is_hex_encoded(const std::string& s)
 /// Converts a collection of bytes to a hexadecimal string representation.
 template <typename T>
 inline std::string hex(const T& collection, bool prefixed = false) {
-    auto rust_functor = [prefixed](auto&& collection){
-        auto res = Rust::encode_hex(collection.data(), collection.size(), prefixed);
-        std::string encoded_str(res);
-        Rust::free_string(res);
-        return encoded_str;
+    auto encode = [prefixed](const auto* bytes, std::size_t size) {
+        std::string encoded;
+        encoded.reserve((prefixed ? 2 : 0) + 2 * size);
+        if (prefixed) {
+            encoded.append("0x");
+        }
+        appendHex(reinterpret_cast<const byte*>(bytes), size, encoded);
+        return encoded;
     };
-    if constexpr (std::is_same_v<T, Data>) {
-        return rust_functor(collection);
-    }
-    else if constexpr (std::is_same_v<T, std::string>) {
-        return rust_functor(data(collection));
+    if constexpr (std::is_same_v<T, Data> || std::is_same_v<T, std::string>) {
+        return encode(collection.data(), collection.size());
     }
     else {
-        return rust_functor(data_from(collection));
+        const auto bytes = data_from(collection);
+        return encode(bytes.data(), bytes.size());
     }
 }
 
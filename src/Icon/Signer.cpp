@@ -11,63 +11,137 @@
 #include "../HexCoding.h"
 #include "../PrivateKey.h"
 
-#include <boost/multiprecision/cpp_int.hpp>
-#include <nlohmann/json.hpp>
-
-#include <algorithm>
-#include <sstream>
+#include <array>
+#include <charconv>
+#include <string_view>
 
 namespace TW::Icon {
 
-std::string to_hex(int64_t i) {
-    std::stringstream ss;
-    ss << "0x" << std::hex << i;
-    return ss.str();
+namespace {
+
+constexpr std::string_view gMethod = "icx_sendTransaction";
+constexpr std::string_view gSeparator = ".";
+
+/// Keys of the signed fields, sorted as the pre-image and the JSON output require.
+constexpr std::array<std::string_view, 8> gKeys{"from", "nid", "nonce", "stepLimit", "timestamp", "to", "value", "version"};
+
+/// Position of the "signature" key among the sorted keys of the JSON output.
+constexpr std::size_t gSignaturePosition = 3;
+
+/// Appends `0x` and the hexadecimal digits of `value` without leading zeros, as ICON quantities are written.
+void appendQuantity(std::string& out, uint64_t value) {
+    std::array<char, 16> digits;
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value, 16).ptr;
+    out += "0x";
+    out.append(digits.data(), end);
 }
 
-std::string to_hex(const std::string& n) {
-    auto s = hex(n);
-    auto start = std::find_if(s.begin(), s.end(), [](auto c) { return c != '0'; });
-    if (start == s.end()) {
-        return "0x0";
+/// Appends `0x` and the hexadecimal digits of the big-endian `value` without leading zeros.
+void appendQuantity(std::string& out, const std::string& value) {
+    out += "0x";
+    const auto start = out.size();
+    appendHex(reinterpret_cast<const byte*>(value.data()), value.size(), out);
+    const auto digits = out.find_first_not_of('0', start);
+    out.erase(start, (digits == std::string::npos ? out.size() : digits) - start);
+    if (out.size() == start) {
+        out += '0';
     }
-    return "0x" + std::string(start, s.end());
 }
 
-std::map<std::string, std::string> Signer::parameters() const noexcept {
-    auto params = std::map<std::string, std::string>();
-    params["from"] = input.from_address();
-    params["to"] = input.to_address();
-    params["timestamp"] = to_hex(input.timestamp());
-    params["nonce"] = to_hex(input.nonce());
-    params["stepLimit"] = to_hex(input.step_limit());
-    params["value"] = to_hex(input.value());
-    params["nid"] = to_hex(input.network_id());
-    params["version"] = "0x3";
-    return params;
+/// Appends `value` as a quoted JSON string.
+void appendJsonString(std::string& out, std::string_view value) {
+    static constexpr char digits[] = "0123456789abcdef";
+    out += '"';
+    for (const auto c : value) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += digits[c >> 4];
+                out += digits[c & 0x0f];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+/// Values of the signed fields in the order of `gKeys`, formatted once into a single buffer.
+class Fields {
+public:
+    explicit Fields(const Proto::SigningInput& input) {
+        values.reserve(input.from_address().size() + input.to_address().size() + 128);
+        add(input.from_address());
+        addQuantity(input.network_id());
+        addQuantity(input.nonce());
+        addQuantity(input.step_limit());
+        addQuantity(static_cast<uint64_t>(input.timestamp()));
+        add(input.to_address());
+        addQuantity(input.value());
+        add("0x3");
+    }
+
+    std::string_view operator[](std::size_t index) const noexcept {
+        return std::string_view(values).substr(offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+private:
+    void add(std::string_view value) {
+        values += value;
+        offsets[++count] = values.size();
+    }
+
+    template <typename T>
+    void addQuantity(const T& value) {
+        appendQuantity(values, value);
+        offsets[++count] = values.size();
+    }
+
+    std::string values;
+    std::array<std::size_t, gKeys.size() + 1> offsets{};
+    std::size_t count = 0;
+};
+
+/// JSON object of the signed transaction, with sorted keys.
+std::string encodeJson(const Fields& fields, const Data& signature) {
+    std::string json;
+    json.reserve(384);
+    json += '{';
+    for (std::size_t i = 0; i < gKeys.size(); ++i) {
+        if (i == gSignaturePosition) {
+            json += "\"signature\":\"";
+            Base64::encodeInto(signature, json);
+            json += "\",";
+        }
+        appendJsonString(json, gKeys[i]);
+        json += ':';
+        appendJsonString(json, fields[i]);
+        json += i + 1 < gKeys.size() ? ',' : '}';
+    }
+    return json;
 }
 
+} // namespace
+
 std::string Signer::preImage() const noexcept {
-    std::string txHash = "icx_sendTransaction";
-    const auto params = parameters();
-    for (auto [key, value] : params) {
-        txHash += "." + key + "." + value;
+    const Fields fields(input);
+    std::string result(gMethod);
+    for (std::size_t i = 0; i < gKeys.size(); ++i) {
+        result.append(gSeparator).append(gKeys[i]).append(gSeparator).append(fields[i]);
     }
-    return txHash;
+    return result;
 }
 
 std::string Signer::encode(const Data& signature) const noexcept {
-    auto json = nlohmann::json();
-    json["from"] = input.from_address();
-    json["to"] = input.to_address();
-    json["timestamp"] = to_hex(input.timestamp());
-    json["nonce"] = to_hex(input.nonce());
-    json["stepLimit"] = to_hex(input.step_limit());
-    json["value"] = to_hex(input.value());
-    json["nid"] = to_hex(input.network_id());
-    json["version"] = "0x3";
-    json["signature"] = Base64::encode(signature);
-    return json.dump();
+    return encodeJson(Fields(input), signature);
 }
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
@@ -76,16 +150,21 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 }
 
 Proto::SigningOutput Signer::sign() const noexcept {
-    const auto hash = Hash::sha3_256(Signer::preImage());
+    // sha3-256 of the pre-image, hashed as it is written
+    const Fields fields(input);
+    auto hasher = Hash::StreamHasher(Hash::HasherSha3_256);
+    hasher.update(gMethod);
+    for (std::size_t i = 0; i < gKeys.size(); ++i) {
+        hasher.update(gSeparator).update(gKeys[i]).update(gSeparator).update(fields[i]);
+    }
+    const auto hash = hasher.finalize();
 
     const auto key = PrivateKey(input.private_key());
     const auto signature = key.sign(hash, TWCurveSECP256k1);
 
     auto output = Proto::SigningOutput();
     output.set_signature(signature.data(), signature.size());
-
-    auto encoded = encode(Data(signature.begin(), signature.end()));
-    output.set_encoded(encoded.data(), encoded.size());
+    output.set_encoded(encodeJson(fields, signature));
 
     return output;
 }
@@ -9,7 +9,6 @@
 #include "Data.h"
 #include "../proto/Icon.pb.h"
 
-#include <map>
 #include <string>
 
 namespace TW::Icon {
@@ -31,9 +30,6 @@ class Signer {
 
     /// Encodes a signed transaction as JSON.
     std::string encode(const Data& signature) const noexcept;
-
-  private:
-    std::map<std::string, std::string> parameters() const noexcept;
 };
 
 } // namespace TW::Icon
@@ -4,14 +4,19 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-#include <Ethereum/EIP2645.h>
-#include <Ethereum/Signer.h>
 #include <HDWallet.h>
+#include <algorithm/parallel.h>
 #include <Hash.h>
 #include <HexCoding.h>
 #include <ImmutableX/Constants.h>
 #include <ImmutableX/StarkKey.h>
-#include <rust/bindgen/WalletCoreRSBindgen.h>
+#include <memory/memzero_wrapper.h>
+#include <rust/Wrapper.h>
+
+#include <TrezorCrypto/sha2.h>
+
+#include <algorithm>
+#include <array>
 
 namespace TW::ImmutableX {
 
@@ -22,34 +27,85 @@ uint256_t hashKeyWithIndex(const Data& seed, std::size_t index) {
     return load(out);
 }
 
+namespace {
+
+/// Stark keys are ground from the secp256k1 keys Ethereum derives
+constexpr TWCurve gEthereumCurve = TWCurveSECP256k1;
+
+using Bytes32 = std::array<byte, 32>;
+
+/// SHA-256 of `data` followed by the index byte, as `hashKeyWithIndex`, into `out`.
+void hashWithIndex(const byte* data, std::size_t size, std::size_t index, Bytes32& out) {
+    SHA256_CTX context;
+    sha256_Init(&context);
+    sha256_Update(&context, data, size);
+    const auto indexByte = static_cast<byte>(index);
+    sha256_Update(&context, &indexByte, 1);
+    sha256_Final(&context, out.data());
+    TW::memzero(&context);
+}
+
+} // namespace
+
 std::string grindKey(const Data& seed) {
+    // Big-endian keys compare as byte strings
+    static const auto bias = [] {
+        Bytes32 bytes;
+        const auto data = store(uint256_t(internal::gStarkDeriveBias), 32);
+        std::copy(data.begin(), data.end(), bytes.begin());
+        return bytes;
+    }();
+
     std::size_t index{0};
-    int256_t key = hashKeyWithIndex(seed, index);
-    while (key >= internal::gStarkDeriveBias) {
-        key = hashKeyWithIndex(store(uint256_t(key)), index);
+    Bytes32 key;
+    Bytes32 previous;
+    hashWithIndex(seed.data(), seed.size(), index, key);
+    while (key >= bias) {
+        // The key is rehashed in its minimal encoding, as `store` gives it (at least one byte)
+        const auto leadingZeros = std::min<std::size_t>(
+            std::distance(key.begin(), std::find_if(key.begin(), key.end(), [](byte b) { return b != 0; })), key.size() - 1);
+        previous = key;
+        hashWithIndex(previous.data() + leadingZeros, previous.size() - leadingZeros, index, key);
         index += 1;
     }
-    auto finalKey = key % internal::gStarkCurveN;
+    auto finalKey = int256_t(load(Data(key.begin(), key.end()))) % internal::gStarkCurveN;
+    TW::memzero(key.data(), key.size());
+    TW::memzero(previous.data(), previous.size());
     std::stringstream ss;
     ss << std::hex << finalKey;
     return ss.str();
 }
 
 PrivateKey getPrivateKeyFromSeed(const Data& seed, const DerivationPath& path) {
-    auto key = HDWallet<32>::bip32DeriveRawSeed(TWCoinTypeEthereum, seed, path);
-    auto data = parse_hex(grindKey(key.bytes), true);
+    auto key = HDWallet<32>(seed).getKeyByCurve(gEthereumCurve, path);
+    auto data = parse_hex(grindKey(Data(key.bytes)), true);
     return PrivateKey(data);
 }
 
+std::vector<PrivateKey> getPrivateKeysFromSeed(const Data& seed, const std::vector<DerivationPath>& paths, std::size_t threads) {
+    auto wallet = HDWallet<32>(seed);
+    wallet.enableNodeCache();
+    std::vector<Data> keys(paths.size());
+    parallelFor(paths.size(), threads, [&](std::size_t i) {
+        const auto key = wallet.getKeyByCurve(gEthereumCurve, paths[i]);
+        keys[i] = parse_hex(grindKey(Data(key.bytes)), true);
+    });
+    std::vector<PrivateKey> privateKeys;
+    privateKeys.reserve(keys.size());
+    for (auto& key : keys) {
+        privateKeys.emplace_back(key);
+        TW::memzero(key.data(), key.size());
+    }
+    return privateKeys;
+}
+
 PrivateKey getPrivateKeyFromEthPrivKey(const PrivateKey& ethPrivKey) {
-    return PrivateKey(parse_hex(ImmutableX::grindKey(ethPrivKey.bytes), true));
+    return PrivateKey(parse_hex(ImmutableX::grindKey(Data(ethPrivKey.bytes)), true));
 }
 
 PrivateKey getPrivateKeyFromRawSignature(const Data& signature, const DerivationPath& derivationPath) {
-    using namespace internal;
-    //auto data = parse_hex(signature);
-    auto ethSignature = Ethereum::Signer::signatureDataToStructSimple(signature);
-    auto seed = store(ethSignature.s);
+    // The seed is the S value of the r || s || v signature, in its minimal encoding
+    auto seed = store(load(subData(signature, 32, 32)));
     return getPrivateKeyFromSeed(seed, derivationPath);
 }
 
@@ -64,27 +120,82 @@ Data getPublicKeyFromPrivateKey(const Data& privateKey) {
 }
 
 Data sign(const Data& privateKey, const Data& digest) {
-    auto privKeyStr = hex(privateKey);
-    auto hexDigest = hex(digest);
-    auto resultSignature = Rust::starknet_sign(privKeyStr.c_str(), hexDigest.c_str());
-    if (resultSignature.code != Rust::OK_CODE) {
+    auto signatures = signBatch(privateKey, {digest});
+    return signatures.empty() ? Data() : std::move(signatures.front());
+}
+
+bool verify(const Data& pubKey, const Data& signature, const Data& digest) {
+    const auto results = verifyBatch(pubKey, {signature}, {digest});
+    return !results.empty() && results.front();
+}
+
+namespace {
+
+/// Concatenates `digests`, each left-padded to 32 bytes. Returns false if one is longer.
+bool concatDigests(const std::vector<Data>& digests, Data& out) {
+    out.assign(digests.size() * starkDigestSize, 0);
+    for (std::size_t i = 0; i < digests.size(); ++i) {
+        const auto& digest = digests[i];
+        if (digest.size() > starkDigestSize) {
+            return false;
+        }
+        std::copy(digest.begin(), digest.end(), out.begin() + static_cast<std::ptrdiff_t>((i + 1) * starkDigestSize - digest.size()));
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<Data> signBatch(const Data& privateKey, const std::vector<Data>& digests) {
+    Data hashes;
+    if (digests.empty() || !concatDigests(digests, hashes)) {
         return {};
     }
-    auto toReturn = parse_hex(resultSignature.result);
-    Rust::free_string(resultSignature.result);
-    return toReturn;
+    Rust::CByteArrayResultWrapper res = Rust::starknet_sign_batch(privateKey.data(), privateKey.size(), hashes.data(), hashes.size());
+    if (!res.isOk()) {
+        return {};
+    }
+    const auto raw = res.unwrap().data;
+    if (raw.size() != digests.size() * starkSignatureSize) {
+        return {};
+    }
+    std::vector<Data> signatures;
+    signatures.reserve(digests.size());
+    for (auto it = raw.begin(); it != raw.end(); it += starkSignatureSize) {
+        signatures.emplace_back(it, it + starkSignatureSize);
+    }
+    return signatures;
 }
 
-bool verify(const Data& pubKey, const Data& signature, const Data& digest) {
-    if (signature.size() != 64) {
-        return false;
+std::vector<bool> verifyBatch(const Data& pubKey, const std::vector<Data>& signatures, const std::vector<Data>& digests) {
+    std::vector<bool> results(digests.size(), false);
+    if (digests.empty() || signatures.size() != digests.size()) {
+        return results;
+    }
+    Data hashes;
+    if (!concatDigests(digests, hashes)) {
+        return results;
+    }
+    // Signatures of the wrong size are not valid, they are checked with a zero signature to keep the batch aligned
+    Data rawSignatures(signatures.size() * starkSignatureSize, 0);
+    for (std::size_t i = 0; i < signatures.size(); ++i) {
+        if (signatures[i].size() == starkSignatureSize) {
+            std::copy(signatures[i].begin(), signatures[i].end(), rawSignatures.begin() + static_cast<std::ptrdiff_t>(i * starkSignatureSize));
+        }
+    }
+    Rust::CByteArrayResultWrapper res = Rust::starknet_verify_batch(pubKey.data(), pubKey.size(), hashes.data(), hashes.size(),
+                                                                    rawSignatures.data(), rawSignatures.size());
+    if (!res.isOk()) {
+        return results;
+    }
+    const auto valid = res.unwrap().data;
+    if (valid.size() != digests.size()) {
+        return results;
+    }
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        results[i] = valid[i] == 1 && signatures[i].size() == starkSignatureSize;
     }
-    auto r = hex(subData(signature, 0, 32));
-    auto s = hex(subData(signature, 32));
-    auto pubKeyStr = hex(pubKey);
-    auto digestStr = hex(digest);
-    const auto res = Rust::starknet_verify(pubKeyStr.c_str(), digestStr.c_str(), r.c_str(), s.c_str());
-    return res.code == Rust::OK_CODE && res.result;
+    return results;
 }
 
 } // namespace TW::ImmutableX
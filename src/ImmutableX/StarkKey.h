@@ -10,6 +10,7 @@
 #include <PrivateKey.h>
 #include <DerivationPath.h>
 #include <string>
+#include <vector>
 
 namespace TW::ImmutableX {
 
@@ -17,7 +18,12 @@ uint256_t hashKeyWithIndex(const Data& seed, std::size_t index);
 
 std::string grindKey(const Data& seed);
 
-PrivateKey getPrivateKeyFromSeed(const std::string& seed, const DerivationPath& path);
+PrivateKey getPrivateKeyFromSeed(const Data& seed, const DerivationPath& path);
+
+/// Derives the Stark private keys of many paths from one seed, the same as `getPrivateKeyFromSeed` for each path.
+/// The BIP32 nodes of the prefixes shared by the paths (e.g. m/2645'/layer'/application') are derived once, and the
+/// keys are derived and ground with up to `threads` threads, 0 for the threads of the shared executor.
+std::vector<PrivateKey> getPrivateKeysFromSeed(const Data& seed, const std::vector<DerivationPath>& paths, std::size_t threads = 1);
 
 PrivateKey getPrivateKeyFromEthPrivKey(const PrivateKey& ethPrivKey);
 
@@ -25,8 +31,22 @@ PrivateKey getPrivateKeyFromRawSignature(const Data& signature, const Derivation
 
 Data getPublicKeyFromPrivateKey(const Data& privateKey);
 
+/// Size of a Stark digest, digests may be shorter (they are left-padded).
+inline constexpr std::size_t starkDigestSize = 32;
+/// Size of a raw Stark signature, `r || s`.
+inline constexpr std::size_t starkSignatureSize = 64;
+
 Data sign(const Data &privateKey, const Data& digest);
 
 bool verify(const Data &pubKey, const Data& signature, const Data& digest);
 
+/// Signs many digests with one private key in a single call to the Stark backend, exchanging raw bytes.
+/// Returns the 64-byte signatures in the order of `digests`, or an empty list if a digest is longer than 32 bytes
+/// or the key is invalid.
+std::vector<Data> signBatch(const Data& privateKey, const std::vector<Data>& digests);
+
+/// Verifies `signatures[i]` over `digests[i]` with one public key in a single call to the Stark backend.
+/// Returns whether each signature is valid; all false if the lists differ in size, or on an invalid key or digest.
+std::vector<bool> verifyBatch(const Data& pubKey, const std::vector<Data>& signatures, const std::vector<Data>& digests);
+
 } // namespace TW::ImmutableX
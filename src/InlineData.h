@@ -0,0 +1,136 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "memory/memzero_wrapper.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace TW {
+
+/// Default storage of `InlineData`: the bytes are a member array, no heap allocation.
+template <std::size_t Capacity>
+struct InlineStorage {
+    std::array<byte, Capacity> bytes{};
+
+    byte* get() noexcept { return bytes.data(); }
+    const byte* get() const noexcept { return bytes.data(); }
+};
+
+/// Variable length byte buffer with a fixed capacity, stored inline (no heap allocation) by default.
+/// Mirrors the read-only part of the `Data` interface and converts implicitly from `Data`,
+/// so it can replace `Data` members that hold small, bounded values such as keys.
+/// Copies into `Data` are explicit; `view()` and `data()` read the bytes in place.
+/// `Storage` provides `Capacity` zero-initialized bytes through `get()`, or null once moved from; see `SecureStorage` for key material.
+template <std::size_t Capacity, typename Storage = InlineStorage<Capacity>>
+class InlineData {
+public:
+    using value_type = byte;
+    using size_type = std::size_t;
+    using reference = byte&;
+    using const_reference = const byte&;
+    using iterator = byte*;
+    using const_iterator = const byte*;
+
+    InlineData() = default;
+
+    /// Throws std::invalid_argument if `size` exceeds the capacity.
+    InlineData(const byte* data, std::size_t size) { assign(data, size); }
+
+    InlineData(const Data& data) : InlineData(data.data(), data.size()) {}
+
+    InlineData(const InlineData& other) = default;
+    InlineData& operator=(const InlineData& other) = default;
+
+    /// Moves leave `other` empty; a `SecureStorage` block is taken over, not copied.
+    InlineData(InlineData&& other) noexcept : buffer(std::move(other.buffer)), length(std::exchange(other.length, 0)) {}
+    InlineData& operator=(InlineData&& other) noexcept {
+        buffer = std::move(other.buffer);
+        length = std::exchange(other.length, 0);
+        return *this;
+    }
+
+    InlineData& operator=(const Data& data) {
+        assign(data.data(), data.size());
+        return *this;
+    }
+
+    /// Replaces the contents; throws std::invalid_argument if `size` exceeds the capacity.
+    void assign(const byte* data, std::size_t size) {
+        if (size > Capacity) {
+            throw std::invalid_argument("Data exceeds inline capacity");
+        }
+        if (buffer.get() == nullptr) {
+            // moved-from storage
+            buffer = Storage();
+        }
+        std::copy_n(data, size, buffer.get());
+        if (size < length) {
+            TW::memzero(buffer.get() + size, length - size);
+        }
+        length = size;
+    }
+
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+    std::size_t size() const noexcept { return length; }
+    bool empty() const noexcept { return length == 0; }
+
+    byte* data() noexcept { return buffer.get(); }
+    const byte* data() const noexcept { return buffer.get(); }
+
+    iterator begin() noexcept { return buffer.get(); }
+    iterator end() noexcept { return buffer.get() + length; }
+    const_iterator begin() const noexcept { return buffer.get(); }
+    const_iterator end() const noexcept { return buffer.get() + length; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    byte& operator[](std::size_t index) noexcept { return buffer.get()[index]; }
+    const byte& operator[](std::size_t index) const noexcept { return buffer.get()[index]; }
+
+    /// Returns a non-owning view of (at most) `count` bytes starting at `offset`; empty if out of range.
+    std::span<const byte> view(std::size_t offset, std::size_t count) const noexcept {
+        if (offset >= length) {
+            return {};
+        }
+        return {buffer.get() + offset, std::min(count, length - offset)};
+    }
+
+    std::span<const byte> view() const noexcept { return {buffer.get(), length}; }
+
+    /// Copies the contents into a heap allocated `Data`.
+    explicit operator Data() const { return Data(begin(), end()); }
+
+    /// Overwrites the whole buffer with zeros; the size is kept.
+    void wipe() noexcept {
+        if (buffer.get() != nullptr) {
+            TW::memzero(buffer.get(), Capacity);
+        }
+    }
+
+private:
+    Storage buffer;
+    std::size_t length = 0;
+};
+
+template <std::size_t Capacity, typename Storage>
+inline bool operator==(const InlineData<Capacity, Storage>& lhs, const InlineData<Capacity, Storage>& rhs) noexcept {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <std::size_t Capacity, typename Storage>
+inline bool operator==(const InlineData<Capacity, Storage>& lhs, const Data& rhs) noexcept {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+} // namespace TW
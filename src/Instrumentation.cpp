@@ -0,0 +1,75 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Instrumentation.h"
+#include "memory/memory_stats.h"
+
+#include <mutex>
+
+namespace TW::Instrumentation {
+
+namespace {
+
+/// The installed callbacks, read once per operation while enabled.
+struct Hooks {
+    TWInstrumentationCallback callback = nullptr;
+    void* callbackContext = nullptr;
+    TWInstrumentationAllocationCounter counter = nullptr;
+    void* counterContext = nullptr;
+};
+
+std::mutex hooksMutex;
+Hooks hooks;
+
+} // namespace
+
+void setCallback(TWInstrumentationCallback callback, void* context) noexcept {
+    const std::lock_guard lock(hooksMutex);
+    hooks.callback = callback;
+    hooks.callbackContext = context;
+    enabled.store(callback != nullptr, std::memory_order_relaxed);
+}
+
+void setAllocationCounter(TWInstrumentationAllocationCounter counter, void* context) noexcept {
+    const std::lock_guard lock(hooksMutex);
+    hooks.counter = counter;
+    hooks.counterContext = context;
+}
+
+void Operation::begin(TWCoinType coin, TWInstrumentationOperation operation, std::size_t bytesIn) noexcept {
+    {
+        const std::lock_guard lock(hooksMutex);
+        callback = hooks.callback;
+        callbackContext = hooks.callbackContext;
+        counter = hooks.counter;
+        counterContext = hooks.counterContext;
+    }
+    if (callback == nullptr) {
+        return;
+    }
+    active = true;
+    span.coin = coin;
+    span.operation = operation;
+    span.bytesIn = bytesIn;
+    outer = currentSpan;
+    currentSpan = &span;
+    if (counter != nullptr) {
+        allocationsAtStart = counter(counterContext);
+    }
+    start = std::chrono::steady_clock::now();
+}
+
+void Operation::end() noexcept {
+    span.totalNanos = nanosSince(start);
+    if (counter != nullptr) {
+        span.allocations = counter(counterContext) - allocationsAtStart;
+    }
+    currentSpan = outer;
+    MemoryStats::recordOperation(span.operation);
+    callback(&span, callbackContext);
+}
+
+} // namespace TW::Instrumentation
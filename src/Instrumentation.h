@@ -0,0 +1,89 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWInstrumentation.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace TW::Instrumentation {
+
+/// Set while a span callback is installed.
+inline std::atomic<bool> enabled{false};
+
+/// The span of the innermost operation running on this thread, if the instrumentation is enabled.
+inline thread_local TWInstrumentationSpan* currentSpan = nullptr;
+
+void setCallback(TWInstrumentationCallback callback, void* context) noexcept;
+void setAllocationCounter(TWInstrumentationAllocationCounter counter, void* context) noexcept;
+
+inline uint64_t nanosSince(std::chrono::steady_clock::time_point start) noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/// Measures an operation and reports its span when it goes out of scope.
+/// Does nothing but check `enabled` if the instrumentation is disabled.
+class Operation {
+public:
+    Operation(TWCoinType coin, TWInstrumentationOperation operation, std::size_t bytesIn) noexcept {
+        if (enabled.load(std::memory_order_relaxed)) {
+            begin(coin, operation, bytesIn);
+        }
+    }
+    ~Operation() {
+        if (active) {
+            end();
+        }
+    }
+
+    Operation(const Operation&) = delete;
+    Operation& operator=(const Operation&) = delete;
+
+    void setBytesOut(std::size_t bytesOut) noexcept { span.bytesOut = bytesOut; }
+
+private:
+    void begin(TWCoinType coin, TWInstrumentationOperation operation, std::size_t bytesIn) noexcept;
+    void end() noexcept;
+
+    bool active = false;
+    TWInstrumentationSpan span{};
+    TWInstrumentationSpan* outer = nullptr;
+    TWInstrumentationCallback callback = nullptr;
+    void* callbackContext = nullptr;
+    TWInstrumentationAllocationCounter counter = nullptr;
+    void* counterContext = nullptr;
+    uint64_t allocationsAtStart = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// Adds the time until it goes out of scope to a phase of the current operation's span, if any.
+class Phase {
+public:
+    explicit Phase(uint64_t TWInstrumentationSpan::*field) noexcept : span(currentSpan), field(field) {
+        if (span != nullptr) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    ~Phase() {
+        if (span != nullptr) {
+            span->*field += nanosSince(start);
+        }
+    }
+
+    Phase(const Phase&) = delete;
+    Phase& operator=(const Phase&) = delete;
+
+private:
+    TWInstrumentationSpan* span;
+    uint64_t TWInstrumentationSpan::*field;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace TW::Instrumentation
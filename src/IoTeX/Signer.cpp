@@ -8,13 +8,87 @@
 #include "Hash.h"
 #include "PrivateKey.h"
 
+#include <optional>
+
 using namespace TW;
 
 namespace TW::IoTeX {
 
+/// Serializes `message` directly into the returned bytes.
+static Data serialize(const google::protobuf::MessageLite& message) {
+    Data serialized(message.ByteSizeLong());
+    message.SerializeWithCachedSizesToArray(serialized.data());
+    return serialized;
+}
+
+/// Serializes the action core of `input`, which has the same field numbers except for the private key;
+/// the core is parsed on `arena`.
+static Data serializeCore(const Proto::SigningInput& input, google::protobuf::Arena& arena) {
+    const auto serializedInput = serialize(input);
+    auto& action = *google::protobuf::Arena::CreateMessage<Proto::ActionCore>(&arena);
+    action.ParseFromArray(serializedInput.data(), static_cast<int>(serializedInput.size()));
+    action.DiscardUnknownFields();
+    return serialize(action);
+}
+
+/// Appends a length-delimited field, omitted when empty as proto3 does for bytes.
+static void appendField(Data& out, uint32_t number, const Data& value, bool always = false) {
+    if (value.empty() && !always) {
+        return;
+    }
+    out.push_back(static_cast<byte>(number << 3 | 2));
+    for (auto size = value.size(); ; size >>= 7) {
+        if (size < 0x80) {
+            out.push_back(static_cast<byte>(size));
+            break;
+        }
+        out.push_back(static_cast<byte>(size | 0x80));
+    }
+    append(out, value);
+}
+
+/// Signs the serialized action core and encodes the signed Action around it, without copying the core message.
+static Proto::SigningOutput buildSigned(const Data& core, const PrivateKey& key, const Data& publicKey) {
+    const auto signature = key.sign(Hash::keccak256(core), TWCurveSECP256k1);
+
+    // Action: core = 1, senderPubKey = 2, signature = 3
+    Data encoded;
+    encoded.reserve(core.size() + publicKey.size() + signature.size() + 12);
+    appendField(encoded, 1, core, true);
+    appendField(encoded, 2, publicKey);
+    appendField(encoded, 3, signature);
+
+    auto output = Proto::SigningOutput();
+    output.set_encoded(encoded.data(), encoded.size());
+    const auto hash = Hash::keccak256(encoded);
+    output.set_hash(hash.data(), hash.size());
+    return output;
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto signer = Signer(input);
-    return signer.build();
+    const auto key = PrivateKey(input.privatekey());
+    const auto publicKey = Data(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes);
+    google::protobuf::Arena arena;
+    return buildSigned(serializeCore(input, arena), key, publicKey);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs) noexcept {
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(inputs.size());
+    google::protobuf::Arena arena;
+    std::optional<PrivateKey> key;
+    Data publicKey;
+    for (const auto& input : inputs) {
+        // staking operations usually come from one account: derive its public key once
+        const auto keyData = Data(input.privatekey().begin(), input.privatekey().end());
+        if (!key.has_value() || key->bytes != keyData) {
+            key.emplace(keyData);
+            publicKey = Data(key->getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes);
+        }
+        outputs.push_back(buildSigned(serializeCore(input, arena), *key, publicKey));
+        arena.Reset();
+    }
+    return outputs;
 }
 
 Data Signer::sign() const {
@@ -23,28 +97,17 @@ Data Signer::sign() const {
 }
 
 Proto::SigningOutput Signer::build() const {
-    auto signedAction = Proto::Action();
-    signedAction.mutable_core()->MergeFrom(action);
-    auto key = PrivateKey(input.privatekey());
-    auto pk = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes;
-    signedAction.set_senderpubkey(pk.data(), pk.size());
-    auto sig = key.sign(hash(), TWCurveSECP256k1);
-    signedAction.set_signature(sig.data(), sig.size());
-
-    auto output = Proto::SigningOutput();
-    auto serialized = signedAction.SerializeAsString();
-    output.set_encoded(serialized);
-    auto h = Hash::keccak256(serialized);
-    output.set_hash(h.data(), h.size());
-    return output;
+    const auto key = PrivateKey(input.privatekey());
+    return buildSigned(serialize(action), key, Data(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes));
 }
 
 Data Signer::hash() const {
-    return Hash::keccak256(action.SerializeAsString());
+    return Hash::keccak256(serialize(action));
 }
 
 void Signer::toActionCore() {
-    action.ParseFromString(input.SerializeAsString());
+    const auto serializedInput = serialize(input);
+    action.ParseFromArray(serializedInput.data(), static_cast<int>(serializedInput.size()));
     action.DiscardUnknownFields();
 }
 
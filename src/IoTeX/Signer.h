@@ -10,6 +10,8 @@
 
 #include "proto/IoTeX.pb.h"
 
+#include <vector>
+
 namespace TW::IoTeX {
 
 /// Helper class that performs IoTeX transaction signing
@@ -17,6 +19,10 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs the given inputs, e.g. several staking operations; the public key derivation is shared by
+    /// consecutive inputs with the same private key. Outputs are the same as `sign` on each input.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs) noexcept;
   public:
     Proto::SigningInput input;
     Proto::ActionCore action;
@@ -0,0 +1,185 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keccak.h"
+#include "CpuFeatures.h"
+
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TW_KECCAK_AVX2 1
+#endif
+
+namespace TW::Keccak {
+
+namespace {
+
+#if defined(TW_KECCAK_AVX2)
+
+#define TW_KECCAK_TARGET __attribute__((target("avx2")))
+
+/// Bytes absorbed per permutation by Keccak-256.
+constexpr std::size_t rate = 136;
+constexpr std::size_t rateWords = rate / 8;
+
+constexpr std::array<uint64_t, 24> roundConstants = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+/// Rotation of lane `x + 5 * y`.
+constexpr std::array<int, 25> rotations = {
+    0, 1, 62, 28, 27,
+    36, 44, 6, 55, 20,
+    3, 10, 43, 25, 39,
+    41, 45, 15, 21, 8,
+    18, 2, 61, 56, 14,
+};
+
+/// Destination of lane `x + 5 * y` after the pi step: `y + 5 * ((2 * x + 3 * y) % 5)`.
+constexpr std::array<int, 25> piDestinations = [] {
+    std::array<int, 25> destinations{};
+    for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+            destinations[x + 5 * y] = y + 5 * ((2 * x + 3 * y) % 5);
+        }
+    }
+    return destinations;
+}();
+
+/// One 64-bit lane of each of the four states.
+using Words = __m256i;
+
+template <int n>
+TW_KECCAK_TARGET inline Words rotl(Words x) {
+    if constexpr (n == 0) {
+        return x;
+    } else {
+        return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+    }
+}
+
+/// Theta of columns `x...`.
+template <std::size_t... x>
+TW_KECCAK_TARGET inline void theta(Words (&a)[25], std::index_sequence<x...>) {
+    Words c[5];
+    ((c[x] = _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]), _mm256_xor_si256(_mm256_xor_si256(a[x + 10], a[x + 15]), a[x + 20]))), ...);
+    Words d[5];
+    ((d[x] = _mm256_xor_si256(c[(x + 4) % 5], rotl<1>(c[(x + 1) % 5]))), ...);
+    ((a[x] = _mm256_xor_si256(a[x], d[x % 5])), ...);
+    ((a[x + 5] = _mm256_xor_si256(a[x + 5], d[x % 5])), ...);
+    ((a[x + 10] = _mm256_xor_si256(a[x + 10], d[x % 5])), ...);
+    ((a[x + 15] = _mm256_xor_si256(a[x + 15], d[x % 5])), ...);
+    ((a[x + 20] = _mm256_xor_si256(a[x + 20], d[x % 5])), ...);
+}
+
+/// Rho and pi of lanes `i...`, so that the rotations are immediates.
+template <std::size_t... i>
+TW_KECCAK_TARGET inline void rhoPi(const Words (&a)[25], Words (&b)[25], std::index_sequence<i...>) {
+    ((b[piDestinations[i]] = rotl<rotations[i]>(a[i])), ...);
+}
+
+/// Chi of lanes `i...`.
+template <std::size_t... i>
+TW_KECCAK_TARGET inline void chi(Words (&a)[25], const Words (&b)[25], std::index_sequence<i...>) {
+    ((a[i] = _mm256_xor_si256(b[i], _mm256_andnot_si256(b[(i + 1) % 5 + i / 5 * 5], b[(i + 2) % 5 + i / 5 * 5]))), ...);
+}
+
+TW_KECCAK_TARGET void permute(Words (&a)[25]) {
+    // each step is unrolled, -O2 leaves loops over the lanes rolled
+    for (const auto constant : roundConstants) {
+        theta(a, std::make_index_sequence<5>());
+        Words b[25];
+        rhoPi(a, b, std::make_index_sequence<25>());
+        chi(a, b, std::make_index_sequence<25>());
+        // iota
+        a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(constant)));
+    }
+}
+
+inline uint64_t load64(const byte* data) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+/// XORs one block of each message into the state.
+TW_KECCAK_TARGET inline void absorb(Words (&a)[25], const std::array<const byte*, lanes>& blocks) {
+    for (std::size_t i = 0; i < rateWords; ++i) {
+        const auto offset = 8 * i;
+        const auto words = _mm256_set_epi64x(static_cast<long long>(load64(blocks[3] + offset)), static_cast<long long>(load64(blocks[2] + offset)),
+                                             static_cast<long long>(load64(blocks[1] + offset)), static_cast<long long>(load64(blocks[0] + offset)));
+        a[i] = _mm256_xor_si256(a[i], words);
+    }
+}
+
+TW_KECCAK_TARGET void hash4(const std::array<const byte*, lanes>& messages, std::size_t size, byte* out) {
+    Words a[25];
+    for (auto& lane : a) {
+        lane = _mm256_setzero_si256();
+    }
+    std::size_t offset = 0;
+    for (; size - offset >= rate; offset += rate) {
+        std::array<const byte*, lanes> blocks;
+        for (std::size_t l = 0; l < lanes; ++l) {
+            blocks[l] = messages[l] + offset;
+        }
+        absorb(a, blocks);
+        permute(a);
+    }
+    // last block with the original Keccak padding (not the SHA-3 domain byte)
+    std::array<std::array<byte, rate>, lanes> padded{};
+    std::array<const byte*, lanes> blocks;
+    for (std::size_t l = 0; l < lanes; ++l) {
+        if (size > offset) {
+            std::memcpy(padded[l].data(), messages[l] + offset, size - offset);
+        }
+        padded[l][size - offset] ^= 0x01;
+        padded[l][rate - 1] ^= 0x80;
+        blocks[l] = padded[l].data();
+    }
+    absorb(a, blocks);
+    permute(a);
+
+    alignas(32) std::array<std::array<uint64_t, lanes>, digest256Size / 8> words;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i].data()), a[i]);
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            // little endian words
+            for (std::size_t b = 0; b < 8; ++b) {
+                out[l * digest256Size + 8 * i + b] = static_cast<byte>(words[i][l] >> (8 * b));
+            }
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+bool avx2Supported() noexcept {
+    return CpuFeatures::avx2();
+}
+
+bool hash256x4([[maybe_unused]] const std::array<const byte*, lanes>& messages, [[maybe_unused]] std::size_t size, [[maybe_unused]] byte* out) noexcept {
+#if defined(TW_KECCAK_AVX2)
+    if (avx2Supported()) {
+        hash4(messages, size, out);
+        return true;
+    }
+#endif
+    return false;
+}
+
+} // namespace TW::Keccak
@@ -0,0 +1,30 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <cstddef>
+
+namespace TW::Keccak {
+
+/// Number of messages hashed together by `hash256x4`.
+static constexpr std::size_t lanes = 4;
+
+/// Size of a Keccak-256 digest.
+static constexpr std::size_t digest256Size = 32;
+
+/// Whether the CPU runs the AVX2 implementation of `hash256x4`, checked once.
+bool avx2Supported() noexcept;
+
+/// Computes the Keccak-256 hashes of four messages of `size` bytes each into `out`, one digest after the other,
+/// with AVX2. Returns false, leaving `out` untouched, if the CPU doesn't support it; `Hash::keccak256BatchInto`
+/// then hashes the messages one at a time.
+bool hash256x4(const std::array<const byte*, lanes>& messages, std::size_t size, byte* out) noexcept;
+
+} // namespace TW::Keccak
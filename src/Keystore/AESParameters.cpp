@@ -7,8 +7,7 @@
 #include "AESParameters.h"
 
 #include "../HexCoding.h"
-
-#include <TrezorCrypto/rand.h>
+#include "../Random.h"
 
 using namespace TW;
 
@@ -16,7 +15,7 @@ namespace {
 
 Data generateIv(std::size_t blockSize = TW::Keystore::gBlockSize) {
     auto iv = Data(blockSize, 0);
-    random_buffer(iv.data(), blockSize);
+    Random::fill(iv.data(), blockSize);
     return iv;
 }
 
@@ -45,11 +44,16 @@ namespace CodingKeys {
 static const auto iv = "iv";
 } // namespace CodingKeys
 
+/// Initializes `AESParameters` with a cipher name and an initialization vector.
+AESParameters AESParameters::AESParametersFromCipher(const std::string& cipher, Data iv) {
+    auto parameters = gEncryptionRegistry.at(getCipher(cipher));
+    parameters.iv = std::move(iv);
+    return parameters;
+}
+
 /// Initializes `AESParameters` with a JSON object.
 AESParameters AESParameters::AESParametersFromJson(const nlohmann::json& json, const std::string& cipher) {
-    auto parameters = AESParameters::AESParametersFromEncryption(getCipher(cipher));
-    parameters.iv = parse_hex(json[CodingKeys::iv].get<std::string>());
-    return parameters;
+    return AESParametersFromCipher(cipher, parse_hex(json[CodingKeys::iv].get<std::string>()));
 }
 
 /// Saves `this` as a JSON object.
@@ -38,6 +38,9 @@ struct AESParameters {
     /// Initializes `AESParameters` with a encryption cipher.
     static AESParameters AESParametersFromEncryption(TWStoredKeyEncryption encryption);;
 
+    /// Initializes `AESParameters` with a cipher name and an initialization vector.
+    static AESParameters AESParametersFromCipher(const std::string& cipher, Data iv);
+
     /// Initializes `AESParameters` with a JSON object.
     static AESParameters AESParametersFromJson(const nlohmann::json& json, const std::string& cipher);
 
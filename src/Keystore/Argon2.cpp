@@ -0,0 +1,312 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Argon2.h"
+#include "Scrypt.h"
+
+#include "algorithm/parallel.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/blake2b.h>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace TW::Keystore {
+
+namespace {
+
+constexpr uint32_t version = 0x13;
+constexpr uint32_t typeId = 2; // Argon2id
+constexpr std::size_t blockWords = 128;
+constexpr std::size_t blockBytes = blockWords * 8;
+constexpr uint32_t syncPoints = 4;
+constexpr std::size_t addressesPerBlock = blockWords;
+
+struct Block {
+    std::array<uint64_t, blockWords> v;
+};
+
+void storeLE32(blake2b_state& state, uint32_t value) {
+    const uint8_t bytes[4] = {uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24)};
+    blake2b_Update(&state, bytes, sizeof(bytes));
+}
+
+/// The variable-length hash function H' of RFC 9106 section 3.3.
+void hashLong(const byte* input, std::size_t inputSize, byte* out, std::size_t outSize) {
+    blake2b_state state;
+    if (outSize <= BLAKE2B_OUTBYTES) {
+        blake2b_Init(&state, outSize);
+        storeLE32(state, static_cast<uint32_t>(outSize));
+        blake2b_Update(&state, input, inputSize);
+        blake2b_Final(&state, out, outSize);
+        return;
+    }
+
+    byte v[BLAKE2B_OUTBYTES];
+    blake2b_Init(&state, BLAKE2B_OUTBYTES);
+    storeLE32(state, static_cast<uint32_t>(outSize));
+    blake2b_Update(&state, input, inputSize);
+    blake2b_Final(&state, v, BLAKE2B_OUTBYTES);
+    std::memcpy(out, v, BLAKE2B_OUTBYTES / 2);
+    out += BLAKE2B_OUTBYTES / 2;
+    auto remaining = outSize - BLAKE2B_OUTBYTES / 2;
+    while (remaining > BLAKE2B_OUTBYTES) {
+        blake2b(v, BLAKE2B_OUTBYTES, v, BLAKE2B_OUTBYTES);
+        std::memcpy(out, v, BLAKE2B_OUTBYTES / 2);
+        out += BLAKE2B_OUTBYTES / 2;
+        remaining -= BLAKE2B_OUTBYTES / 2;
+    }
+    blake2b(v, BLAKE2B_OUTBYTES, out, remaining);
+    memzero(v, sizeof(v));
+}
+
+inline uint64_t rotr64(uint64_t x, unsigned n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+inline uint64_t blaMka(uint64_t x, uint64_t y) {
+    return x + y + 2 * (x & 0xffffffff) * (y & 0xffffffff);
+}
+
+inline void gb(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d) {
+    a = blaMka(a, b);
+    d = rotr64(d ^ a, 32);
+    c = blaMka(c, d);
+    b = rotr64(b ^ c, 24);
+    a = blaMka(a, b);
+    d = rotr64(d ^ a, 16);
+    c = blaMka(c, d);
+    b = rotr64(b ^ c, 63);
+}
+
+/// The permutation P on 16 words.
+inline void permute(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3, uint64_t& v4, uint64_t& v5, uint64_t& v6, uint64_t& v7,
+                    uint64_t& v8, uint64_t& v9, uint64_t& v10, uint64_t& v11, uint64_t& v12, uint64_t& v13, uint64_t& v14, uint64_t& v15) {
+    gb(v0, v4, v8, v12);
+    gb(v1, v5, v9, v13);
+    gb(v2, v6, v10, v14);
+    gb(v3, v7, v11, v15);
+    gb(v0, v5, v10, v15);
+    gb(v1, v6, v11, v12);
+    gb(v2, v7, v8, v13);
+    gb(v3, v4, v9, v14);
+}
+
+/// The compression function G: next = P(prev ^ ref) ^ prev ^ ref, XORed into the previous content of `next` if `withXor`.
+void fillBlock(const Block& prev, const Block& ref, Block& next, bool withXor) {
+    Block r;
+    Block tmp;
+    for (std::size_t i = 0; i < blockWords; ++i) {
+        r.v[i] = prev.v[i] ^ ref.v[i];
+        tmp.v[i] = withXor ? r.v[i] ^ next.v[i] : r.v[i];
+    }
+    auto& v = r.v;
+    // rows of 16 words
+    for (std::size_t i = 0; i < 8; ++i) {
+        permute(v[16 * i], v[16 * i + 1], v[16 * i + 2], v[16 * i + 3], v[16 * i + 4], v[16 * i + 5], v[16 * i + 6], v[16 * i + 7],
+                v[16 * i + 8], v[16 * i + 9], v[16 * i + 10], v[16 * i + 11], v[16 * i + 12], v[16 * i + 13], v[16 * i + 14], v[16 * i + 15]);
+    }
+    // columns of 2 words in each row
+    for (std::size_t i = 0; i < 8; ++i) {
+        permute(v[2 * i], v[2 * i + 1], v[2 * i + 16], v[2 * i + 17], v[2 * i + 32], v[2 * i + 33], v[2 * i + 48], v[2 * i + 49],
+                v[2 * i + 64], v[2 * i + 65], v[2 * i + 80], v[2 * i + 81], v[2 * i + 96], v[2 * i + 97], v[2 * i + 112], v[2 * i + 113]);
+    }
+    for (std::size_t i = 0; i < blockWords; ++i) {
+        next.v[i] = tmp.v[i] ^ r.v[i];
+    }
+}
+
+void loadBlock(Block& block, const byte* bytes) {
+    for (std::size_t i = 0; i < blockWords; ++i) {
+        uint64_t word = 0;
+        for (std::size_t k = 0; k < 8; ++k) {
+            word |= uint64_t(bytes[8 * i + k]) << (8 * k);
+        }
+        block.v[i] = word;
+    }
+}
+
+void storeBlock(byte* bytes, const Block& block) {
+    for (std::size_t i = 0; i < blockWords; ++i) {
+        for (std::size_t k = 0; k < 8; ++k) {
+            bytes[8 * i + k] = byte(block.v[i] >> (8 * k));
+        }
+    }
+}
+
+struct Instance {
+    std::vector<Block>& memory;
+    uint32_t passes;
+    uint32_t lanes;
+    uint32_t laneLength;
+    uint32_t segmentLength;
+    uint32_t memoryBlocks;
+};
+
+/// Position of the reference block in its lane, RFC 9106 section 3.4.1.2.
+uint32_t referenceIndex(const Instance& instance, uint32_t pass, uint32_t slice, uint32_t index, uint32_t pseudoRandom, bool sameLane) {
+    uint32_t areaSize;
+    if (pass == 0) {
+        if (slice == 0) {
+            areaSize = index - 1;
+        } else if (sameLane) {
+            areaSize = slice * instance.segmentLength + index - 1;
+        } else {
+            areaSize = slice * instance.segmentLength - (index == 0 ? 1 : 0);
+        }
+    } else if (sameLane) {
+        areaSize = instance.laneLength - instance.segmentLength + index - 1;
+    } else {
+        areaSize = instance.laneLength - instance.segmentLength - (index == 0 ? 1 : 0);
+    }
+
+    uint64_t relative = pseudoRandom;
+    relative = (relative * relative) >> 32;
+    relative = areaSize - 1 - ((areaSize * relative) >> 32);
+    const uint32_t start = (pass != 0 && slice != syncPoints - 1) ? (slice + 1) * instance.segmentLength : 0;
+    return static_cast<uint32_t>((start + relative) % instance.laneLength);
+}
+
+void fillSegment(const Instance& instance, uint32_t pass, uint32_t lane, uint32_t slice) {
+    // Argon2id uses data-independent addressing in the first half of the first pass.
+    const bool independent = pass == 0 && slice < syncPoints / 2;
+    Block zero{};
+    Block input{};
+    Block addresses{};
+    if (independent) {
+        input.v[0] = pass;
+        input.v[1] = lane;
+        input.v[2] = slice;
+        input.v[3] = instance.memoryBlocks;
+        input.v[4] = instance.passes;
+        input.v[5] = typeId;
+    }
+    const auto nextAddresses = [&] {
+        ++input.v[6];
+        fillBlock(zero, input, addresses, false);
+        fillBlock(zero, addresses, addresses, false);
+    };
+
+    uint32_t start = 0;
+    if (pass == 0 && slice == 0) {
+        // The first two blocks of each lane are computed from H0.
+        start = 2;
+        if (independent) {
+            nextAddresses();
+        }
+    }
+
+    auto& memory = instance.memory;
+    uint32_t current = lane * instance.laneLength + slice * instance.segmentLength + start;
+    uint32_t previous = (current % instance.laneLength == 0) ? current + instance.laneLength - 1 : current - 1;
+    for (uint32_t i = start; i < instance.segmentLength; ++i, ++current, ++previous) {
+        if (current % instance.laneLength == 1) {
+            previous = current - 1;
+        }
+        uint64_t pseudoRandom;
+        if (independent) {
+            if (i % addressesPerBlock == 0) {
+                nextAddresses();
+            }
+            pseudoRandom = addresses.v[i % addressesPerBlock];
+        } else {
+            pseudoRandom = memory[previous].v[0];
+        }
+
+        auto referenceLane = static_cast<uint32_t>((pseudoRandom >> 32) % instance.lanes);
+        if (pass == 0 && slice == 0) {
+            referenceLane = lane;
+        }
+        const auto index = referenceIndex(instance, pass, slice, i, static_cast<uint32_t>(pseudoRandom), referenceLane == lane);
+        const auto& reference = memory[std::size_t(instance.laneLength) * referenceLane + index];
+        fillBlock(memory[previous], reference, memory[current], pass != 0);
+    }
+    memzero(&input);
+    memzero(&addresses);
+}
+
+} // namespace
+
+void argon2id(std::span<const byte> password, std::span<const byte> salt, uint32_t iterations, uint32_t memoryKiB, uint32_t lanes,
+              byte* derivedKey, std::size_t derivedKeySize, std::size_t threads,
+              std::span<const byte> secret, std::span<const byte> associatedData) {
+    if (lanes == 0 || iterations == 0 || memoryKiB < 8 * lanes || derivedKeySize < 4 || derivedKeySize > UINT32_MAX) {
+        throw std::invalid_argument("Invalid Argon2 parameters");
+    }
+    const uint32_t segmentLength = memoryKiB / (syncPoints * lanes);
+    const uint32_t memoryBlocks = segmentLength * syncPoints * lanes;
+    const uint32_t laneLength = segmentLength * syncPoints;
+
+    // H0, RFC 9106 section 3.2
+    byte h0[BLAKE2B_OUTBYTES + 8];
+    {
+        blake2b_state state;
+        blake2b_Init(&state, BLAKE2B_OUTBYTES);
+        storeLE32(state, lanes);
+        storeLE32(state, static_cast<uint32_t>(derivedKeySize));
+        storeLE32(state, memoryKiB);
+        storeLE32(state, iterations);
+        storeLE32(state, version);
+        storeLE32(state, typeId);
+        for (const auto& input : {password, salt, secret, associatedData}) {
+            storeLE32(state, static_cast<uint32_t>(input.size()));
+            blake2b_Update(&state, input.data(), input.size());
+        }
+        blake2b_Final(&state, h0, BLAKE2B_OUTBYTES);
+        memzero(&state);
+    }
+
+    ScryptMemoryBudget::Reservation reservation(std::size_t(memoryBlocks) * blockBytes);
+    std::vector<Block> memory(memoryBlocks);
+    byte blockBytesBuffer[blockBytes];
+    for (uint32_t lane = 0; lane < lanes; ++lane) {
+        for (uint32_t column = 0; column < 2; ++column) {
+            const uint32_t suffix[2] = {column, lane};
+            for (std::size_t k = 0; k < 8; ++k) {
+                h0[BLAKE2B_OUTBYTES + k] = byte(suffix[k / 4] >> (8 * (k % 4)));
+            }
+            hashLong(h0, sizeof(h0), blockBytesBuffer, blockBytes);
+            loadBlock(memory[std::size_t(lane) * laneLength + column], blockBytesBuffer);
+        }
+    }
+
+    const Instance instance{memory, iterations, lanes, laneLength, segmentLength, memoryBlocks};
+    // The segments of a slice only reference the previous slices, so the lanes of a slice are filled in parallel.
+    for (uint32_t pass = 0; pass < iterations; ++pass) {
+        for (uint32_t slice = 0; slice < syncPoints; ++slice) {
+            parallelFor(lanes, threads, [&](std::size_t lane) {
+                fillSegment(instance, pass, static_cast<uint32_t>(lane), slice);
+            });
+        }
+    }
+
+    // The final block is the XOR of the last blocks of the lanes.
+    Block lastBlocks = memory[laneLength - 1];
+    for (uint32_t lane = 1; lane < lanes; ++lane) {
+        const auto& last = memory[std::size_t(lane) * laneLength + laneLength - 1];
+        for (std::size_t i = 0; i < blockWords; ++i) {
+            lastBlocks.v[i] ^= last.v[i];
+        }
+    }
+    storeBlock(blockBytesBuffer, lastBlocks);
+    hashLong(blockBytesBuffer, blockBytes, derivedKey, derivedKeySize);
+
+    memzero(memory.data(), memory.size() * sizeof(Block));
+    memzero(&lastBlocks);
+    memzero(blockBytesBuffer, sizeof(blockBytesBuffer));
+    memzero(h0, sizeof(h0));
+}
+
+Data argon2id(const Data& password, const Data& salt, uint32_t iterations, uint32_t memoryKiB, uint32_t lanes, std::size_t derivedKeySize, std::size_t threads) {
+    Data derivedKey(derivedKeySize);
+    argon2id(password, salt, iterations, memoryKiB, lanes, derivedKey.data(), derivedKey.size(), threads);
+    return derivedKey;
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,29 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace TW::Keystore {
+
+/// Computes Argon2id (RFC 9106, version 0x13) of `password` and `salt` into `derivedKey`, with `iterations` passes over
+/// `memoryKiB` KiB of memory split in `lanes` lanes. The lanes of a slice are filled on up to `threads` threads
+/// (0 selects the hardware concurrency), and the memory is reserved in the `ScryptMemoryBudget`.
+/// `secret` and `associatedData` are the optional K and X inputs. Parameters must have been validated
+/// (see `Argon2Parameters::validate`); throws std::invalid_argument otherwise.
+void argon2id(std::span<const byte> password, std::span<const byte> salt, uint32_t iterations, uint32_t memoryKiB, uint32_t lanes,
+              byte* derivedKey, std::size_t derivedKeySize, std::size_t threads = 0,
+              std::span<const byte> secret = {}, std::span<const byte> associatedData = {});
+
+/// Convenience overload returning a key of `derivedKeySize` bytes.
+Data argon2id(const Data& password, const Data& salt, uint32_t iterations, uint32_t memoryKiB, uint32_t lanes, std::size_t derivedKeySize, std::size_t threads = 0);
+
+} // namespace TW::Keystore
@@ -0,0 +1,80 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Argon2Parameters.h"
+#include "../Random.h"
+
+#include <limits>
+
+using namespace TW;
+
+namespace TW::Keystore {
+
+Argon2Parameters Argon2Parameters::Minimal = Argon2Parameters(Data(), minimalMemoryKiB, minimalIterations, defaultLanes, defaultDesiredKeyLength);
+Argon2Parameters Argon2Parameters::Weak = Argon2Parameters(Data(), weakMemoryKiB, weakIterations, defaultLanes, defaultDesiredKeyLength);
+Argon2Parameters Argon2Parameters::Standard = Argon2Parameters(Data(), standardMemoryKiB, standardIterations, defaultLanes, defaultDesiredKeyLength);
+
+Argon2Parameters::Argon2Parameters()
+    : salt(32) {
+    Random::fill(salt.data(), salt.size());
+}
+
+std::optional<Argon2ValidationError> Argon2Parameters::validate() const {
+    if (desiredKeyLength < 4 || desiredKeyLength > std::numeric_limits<uint32_t>::max()) {
+        return Argon2ValidationError::desiredKeyLengthTooSmall;
+    }
+    if (!salt.empty() && salt.size() < 8) {
+        return Argon2ValidationError::saltTooShort;
+    }
+    if (lanes == 0 || lanes > 0xffffff) {
+        return Argon2ValidationError::invalidLanes;
+    }
+    if (iterations == 0) {
+        return Argon2ValidationError::invalidIterations;
+    }
+    if (memoryKiB < 8 * lanes) {
+        return Argon2ValidationError::memoryTooSmall;
+    }
+    return {};
+}
+
+// -----------------
+// Encoding/Decoding
+// -----------------
+
+namespace CodingKeys::A2P {
+
+static const auto salt = "salt";
+static const auto desiredKeyLength = "dklen";
+static const auto memory = "m";
+static const auto iterations = "t";
+static const auto lanes = "p";
+
+} // namespace CodingKeys::A2P
+
+Argon2Parameters::Argon2Parameters(const nlohmann::json& json) {
+    salt = parse_hex(json[CodingKeys::A2P::salt].get<std::string>());
+    desiredKeyLength = json[CodingKeys::A2P::desiredKeyLength];
+    if (json.count(CodingKeys::A2P::memory) != 0)
+        memoryKiB = json[CodingKeys::A2P::memory];
+    if (json.count(CodingKeys::A2P::iterations) != 0)
+        iterations = json[CodingKeys::A2P::iterations];
+    if (json.count(CodingKeys::A2P::lanes) != 0)
+        lanes = json[CodingKeys::A2P::lanes];
+}
+
+/// Saves `this` as a JSON object.
+nlohmann::json Argon2Parameters::json() const {
+    nlohmann::json j;
+    j[CodingKeys::A2P::salt] = hex(salt);
+    j[CodingKeys::A2P::desiredKeyLength] = desiredKeyLength;
+    j[CodingKeys::A2P::memory] = memoryKiB;
+    j[CodingKeys::A2P::iterations] = iterations;
+    j[CodingKeys::A2P::lanes] = lanes;
+    return j;
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,89 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "../HexCoding.h"
+
+#include <nlohmann/json.hpp>
+#include <optional>
+
+namespace TW::Keystore {
+
+enum class Argon2ValidationError {
+    desiredKeyLengthTooSmall,
+    saltTooShort,
+    invalidLanes,
+    invalidIterations,
+    memoryTooSmall,
+};
+
+/// Argon2id function parameters (RFC 9106, version 0x13), stored as kdf "argon2id".
+/// Lanes are filled in parallel, so more lanes lower the unlock time on multi-core devices for the same memory cost.
+struct Argon2Parameters {
+    static Argon2Parameters Minimal;
+    static Argon2Parameters Weak;
+    static Argon2Parameters Standard;
+
+    /// 64MB of memory and 3 passes, the second recommended option of RFC 9106.
+    static const uint32_t standardMemoryKiB = 1 << 16;
+    static const uint32_t standardIterations = 3;
+
+    static const uint32_t weakMemoryKiB = 1 << 15;
+    static const uint32_t weakIterations = 2;
+
+    static const uint32_t minimalMemoryKiB = 1 << 14;
+    static const uint32_t minimalIterations = 2;
+
+    /// Default number of lanes, computed in parallel.
+    static const uint32_t defaultLanes = 4;
+
+    /// Default desired key length.
+    static const std::size_t defaultDesiredKeyLength = 32;
+
+    /// Random salt.
+    Data salt;
+
+    /// Desired key length in bytes.
+    std::size_t desiredKeyLength = defaultDesiredKeyLength;
+
+    /// Memory cost in KiB, at least 8 per lane.
+    uint32_t memoryKiB = minimalMemoryKiB;
+
+    /// Number of passes over the memory.
+    uint32_t iterations = minimalIterations;
+
+    /// Degree of parallelism.
+    uint32_t lanes = defaultLanes;
+
+    /// Initializes with default parameters and a random salt.
+    Argon2Parameters();
+
+    /// Initializes `Argon2Parameters` with all values.
+    ///
+    /// @throws Argon2ValidationError if the parameters are invalid.
+    Argon2Parameters(const Data& salt, uint32_t memoryKiB, uint32_t iterations, uint32_t lanes, std::size_t desiredKeyLength)
+        : salt(std::move(salt)), desiredKeyLength(desiredKeyLength), memoryKiB(memoryKiB), iterations(iterations), lanes(lanes) {
+        auto error = validate();
+        if (error) {
+            throw *error;
+        }
+    }
+
+    /// Validates the parameters, the salt only if not empty (as for the presets).
+    ///
+    /// - Returns: a `ValidationError` or `nil` if the parameters are valid.
+    std::optional<Argon2ValidationError> validate() const;
+
+    /// Initializes `Argon2Parameters` with a JSON object.
+    Argon2Parameters(const nlohmann::json& json);
+
+    /// Saves `this` as a JSON object.
+    nlohmann::json json() const;
+};
+
+} // namespace TW::Keystore
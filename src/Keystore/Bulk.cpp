@@ -0,0 +1,196 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bulk.h"
+
+#include "algorithm/parallel.h"
+#include "memory/memzero_wrapper.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace TW::Keystore::Bulk {
+
+namespace {
+
+/// Message of the exception being handled.
+std::string currentErrorMessage() {
+    try {
+        throw;
+    } catch (const DecryptionError& error) {
+        switch (error) {
+        case DecryptionError::unsupportedKDF: return "unsupported KDF";
+        case DecryptionError::unsupportedCipher: return "unsupported cipher";
+        case DecryptionError::unsupportedCoin: return "unsupported coin";
+        case DecryptionError::invalidKeyFile: return "invalid key file";
+        case DecryptionError::invalidCipher: return "invalid cipher";
+        case DecryptionError::invalidPassword: return "invalid password";
+        }
+        return "decryption error";
+    } catch (const ScryptValidationError&) {
+        return "invalid scrypt parameters";
+    } catch (const std::exception& error) {
+        return error.what();
+    } catch (...) {
+        return "unknown error";
+    }
+}
+
+void import(std::string_view text, const std::optional<Data>& password, ImportResult& result) {
+    try {
+        auto key = StoredKey::createWithJsonText(text);
+        if (password.has_value()) {
+            auto secret = key.payload.decrypt(*password);
+            TW::memzero(secret.data(), secret.size());
+        }
+        result.key.emplace(std::move(key));
+    } catch (...) {
+        result.error = currentErrorMessage();
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) {
+        throw std::invalid_argument("Can't open file");
+    }
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+std::vector<ImportResult> importTexts(const std::vector<std::string>& texts, std::size_t threads, const std::optional<Data>& password) {
+    std::vector<ImportResult> results(texts.size());
+    parallelFor(texts.size(), threads, [&](std::size_t i) {
+        results[i].source = std::to_string(i);
+        import(texts[i], password, results[i]);
+    });
+    return results;
+}
+
+std::vector<DecryptResult> decryptTexts(const std::vector<std::string>& texts, const Data& password, std::size_t threads) {
+    std::vector<DecryptResult> results(texts.size());
+    parallelFor(texts.size(), threads, [&](std::size_t i) {
+        try {
+            const auto key = StoredKey::createWithJsonText(texts[i]);
+            results[i].secret = key.payload.decrypt(password);
+        } catch (...) {
+            results[i].error = currentErrorMessage();
+        }
+    });
+    return results;
+}
+
+std::vector<ImportResult> createWithMnemonics(const std::vector<std::string>& mnemonics, const std::vector<std::string>& names, const Data& password,
+                                              TWCoinType coin, TWStoredKeyEncryption encryption, std::size_t threads) {
+    if (names.size() != mnemonics.size()) {
+        throw std::invalid_argument("Expecting one name per mnemonic");
+    }
+    std::vector<ImportResult> results(mnemonics.size());
+    parallelFor(mnemonics.size(), threads, [&](std::size_t i) {
+        results[i].source = std::to_string(i);
+        try {
+            auto key = StoredKey::createWithMnemonic(names[i], password, mnemonics[i], TWStoredKeyEncryptionLevelDefault, encryption);
+            // the same as createWithMnemonicAddDefaultAddress, without decrypting the new key again for its wallet
+            const auto wallet = HDWallet<>(mnemonics[i], "");
+            key.account(coin, &wallet);
+            results[i].key.emplace(std::move(key));
+        } catch (...) {
+            results[i].error = currentErrorMessage();
+        }
+    });
+    return results;
+}
+
+std::vector<ImportResult> importDirectory(const std::string& directory, std::size_t threads, const std::optional<Data>& password) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (auto it = std::filesystem::directory_iterator(directory, error); !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".json") {
+            paths.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        throw std::invalid_argument("Can't list directory");
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<ImportResult> results(paths.size());
+    parallelFor(paths.size(), threads, [&](std::size_t i) {
+        auto& result = results[i];
+        result.source = paths[i];
+        try {
+            import(readFile(paths[i]), password, result);
+        } catch (...) {
+            result.error = currentErrorMessage();
+        }
+    });
+    return results;
+}
+
+std::vector<ImportResult> importStream(std::istream& stream, std::size_t threads, const std::optional<Data>& password) {
+    std::vector<std::string> lines;
+    std::vector<std::size_t> lineNumbers;
+    std::string line;
+    for (std::size_t number = 1; std::getline(stream, line); ++number) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        lines.push_back(std::move(line));
+        lineNumbers.push_back(number);
+    }
+
+    auto results = importTexts(lines, threads, password);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        results[i].source = std::to_string(lineNumbers[i]);
+    }
+    return results;
+}
+
+std::vector<std::string> exportDirectory(const std::vector<StoredKey>& keys, const std::string& directory, std::size_t threads) {
+    std::vector<std::string> paths(keys.size());
+    parallelFor(keys.size(), threads, [&](std::size_t i) {
+        const auto& key = keys[i];
+        const auto fileName = (key.id.has_value() ? *key.id : std::to_string(i)) + ".json";
+        paths[i] = (std::filesystem::path(directory) / fileName).string();
+
+        std::string text;
+        key.writeJson(text);
+        std::ofstream stream(paths[i], std::ios::binary);
+        stream << text;
+        if (!stream) {
+            throw std::invalid_argument("Can't write file " + paths[i]);
+        }
+    });
+    return paths;
+}
+
+void exportStream(const std::vector<StoredKey>& keys, std::ostream& stream, std::size_t threads) {
+    std::vector<std::string> texts(keys.size());
+    parallelFor(keys.size(), threads, [&](std::size_t i) {
+        keys[i].writeJson(texts[i]);
+    });
+    for (const auto& text : texts) {
+        stream << text << '\n';
+    }
+}
+
+std::vector<std::string> updateEncryptionParameters(std::vector<StoredKey>& keys, const Data& password, const EncryptionParameters& params, std::size_t threads) {
+    std::vector<std::string> errors(keys.size());
+    parallelFor(keys.size(), threads, [&](std::size_t i) {
+        try {
+            keys[i].updateEncryptionParameters(password, params);
+        } catch (...) {
+            errors[i] = currentErrorMessage();
+        }
+    });
+    return errors;
+}
+
+} // namespace TW::Keystore::Bulk
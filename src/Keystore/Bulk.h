@@ -0,0 +1,80 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "StoredKey.h"
+#include "Data.h"
+
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Import and export of many key files at once, for migrations and backups.
+/// The work is spread over `threads` worker threads (see `parallelFor`); 0 uses the hardware concurrency.
+namespace TW::Keystore::Bulk {
+
+/// Outcome of importing one key file.
+struct ImportResult {
+    /// File path, or line number in a stream, of the key file.
+    std::string source;
+
+    /// The key, if it could be parsed and, with a password, decrypted.
+    std::optional<StoredKey> key;
+
+    /// Why the key could not be imported; empty on success.
+    std::string error;
+};
+
+/// Outcome of decrypting one key file.
+struct DecryptResult {
+    /// The decrypted payload, a mnemonic or a private key; empty on failure.
+    SecureData secret;
+
+    /// Why the key could not be decrypted; empty on success.
+    std::string error;
+};
+
+/// Imports key files given as JSON texts; results are in input order, failures are reported per key.
+/// With a password every key is also decrypted, to verify it; the key derivation work is bounded by the threads.
+std::vector<ImportResult> importTexts(const std::vector<std::string>& texts, std::size_t threads = 0, const std::optional<Data>& password = std::nullopt);
+
+/// Decrypts the payloads of key files given as JSON texts, sharing a password; results are in input order, failures
+/// are reported per key.
+std::vector<DecryptResult> decryptTexts(const std::vector<std::string>& texts, const Data& password, std::size_t threads = 0);
+
+/// Creates the keys of HD wallets sharing a password, as `StoredKey::createWithMnemonicAddDefaultAddress` with
+/// `names[i]` for `mnemonics[i]` but encrypting each key only once; results are in input order, failures (e.g. an invalid mnemonic) are reported per key.
+///
+/// @throws std::invalid_argument if there isn't one name per mnemonic.
+std::vector<ImportResult> createWithMnemonics(const std::vector<std::string>& mnemonics, const std::vector<std::string>& names, const Data& password,
+                                              TWCoinType coin, TWStoredKeyEncryption encryption, std::size_t threads = 0);
+
+/// Imports the `.json` files of a directory, in file name order.
+///
+/// @throws std::invalid_argument if the directory can't be listed.
+std::vector<ImportResult> importDirectory(const std::string& directory, std::size_t threads = 0, const std::optional<Data>& password = std::nullopt);
+
+/// Imports a stream of key files, one JSON text per line; empty lines are skipped.
+std::vector<ImportResult> importStream(std::istream& stream, std::size_t threads = 0, const std::optional<Data>& password = std::nullopt);
+
+/// Writes keys into a directory, as `<id>.json` files, or `<index>.json` for keys without an id.
+/// Returns the paths written, in key order.
+///
+/// @throws std::invalid_argument if a file can't be written.
+std::vector<std::string> exportDirectory(const std::vector<StoredKey>& keys, const std::string& directory, std::size_t threads = 0);
+
+/// Writes keys to a stream, one JSON text per line, in key order.
+void exportStream(const std::vector<StoredKey>& keys, std::ostream& stream, std::size_t threads = 0);
+
+/// Re-encrypts keys sharing a password with new encryption parameters (see `StoredKey::updateEncryptionParameters`),
+/// e.g. to migrate them to tuned parameters in the background.
+/// Returns why each key could not be updated, in key order; empty for updated keys, failed keys are left unchanged.
+std::vector<std::string> updateEncryptionParameters(std::vector<StoredKey>& keys, const Data& password, const EncryptionParameters& params, std::size_t threads = 0);
+
+} // namespace TW::Keystore::Bulk
@@ -5,12 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "EncryptionParameters.h"
+#include "Argon2.h"
+#include "Scrypt.h"
 
 #include "../Hash.h"
 
 #include <TrezorCrypto/aes.h>
 #include <TrezorCrypto/pbkdf2.h>
-#include <TrezorCrypto/scrypt.h>
 #include <cassert>
 
 using namespace TW;
@@ -48,6 +49,8 @@ EncryptionParameters::EncryptionParameters(const nlohmann::json& json) {
         kdfParams = ScryptParameters(json[CodingKeys::kdfParams]);
     } else if (kdf == "pbkdf2") {
         kdfParams = PBKDF2Parameters(json[CodingKeys::kdfParams]);
+    } else if (kdf == "argon2id") {
+        kdfParams = Argon2Parameters(json[CodingKeys::kdfParams]);
     }
 }
 
@@ -62,18 +65,32 @@ nlohmann::json EncryptionParameters::json() const {
     } else if (auto* pbkdf2Params = std::get_if<PBKDF2Parameters>(&kdfParams); pbkdf2Params) {
         j[CodingKeys::kdf] = "pbkdf2";
         j[CodingKeys::kdfParams] = pbkdf2Params->json();
+    } else if (auto* argon2Params = std::get_if<Argon2Parameters>(&kdfParams); argon2Params) {
+        j[CodingKeys::kdf] = "argon2id";
+        j[CodingKeys::kdfParams] = argon2Params->json();
     }
 
     return j;
 }
 
-EncryptedPayload::EncryptedPayload(const Data& password, const Data& data, const EncryptionParameters& params)
+EncryptedPayload::EncryptedPayload(const Data& password, std::span<const byte> data, const EncryptionParameters& params)
     : params(std::move(params)), _mac() {
-    auto scryptParams = std::get<ScryptParameters>(this->params.kdfParams);
-    auto derivedKey = Data(scryptParams.desiredKeyLength);
-    scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams.salt.data(),
-           scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-           scryptParams.desiredKeyLength);
+    auto derivedKey = SecureData();
+    if (auto* scryptParams = std::get_if<ScryptParameters>(&this->params.kdfParams); scryptParams) {
+        derivedKey.resize(scryptParams->desiredKeyLength);
+        scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams->salt.data(),
+               scryptParams->salt.size(), scryptParams->n, scryptParams->r, scryptParams->p, derivedKey.data(),
+               scryptParams->desiredKeyLength);
+    } else if (auto* pbkdf2Params = std::get_if<PBKDF2Parameters>(&this->params.kdfParams); pbkdf2Params) {
+        derivedKey.resize(pbkdf2Params->desiredKeyLength);
+        pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), pbkdf2Params->salt.data(),
+                           static_cast<int>(pbkdf2Params->salt.size()), pbkdf2Params->iterations, derivedKey.data(),
+                           static_cast<int>(pbkdf2Params->desiredKeyLength));
+    } else if (auto* argon2Params = std::get_if<Argon2Parameters>(&this->params.kdfParams); argon2Params) {
+        derivedKey.resize(argon2Params->desiredKeyLength);
+        argon2id(password, argon2Params->salt, argon2Params->iterations, argon2Params->memoryKiB, argon2Params->lanes,
+                 derivedKey.data(), argon2Params->desiredKeyLength);
+    }
 
     aes_encrypt_ctx ctx;
     auto result = 0;
@@ -103,8 +120,8 @@ EncryptedPayload::~EncryptedPayload() {
     std::fill(_mac.begin(), _mac.end(), 0);
 }
 
-Data EncryptedPayload::decrypt(const Data& password) const {
-    auto derivedKey = Data();
+SecureData EncryptedPayload::decrypt(const Data& password) const {
+    auto derivedKey = SecureData();
     auto mac = Data();
 
     if (auto* scryptParams = std::get_if<ScryptParameters>(&params.kdfParams); scryptParams) {
@@ -119,6 +136,11 @@ Data EncryptedPayload::decrypt(const Data& password) const {
                            static_cast<int>(pbkdf2Params->salt.size()), pbkdf2Params->iterations, derivedKey.data(),
                            pbkdf2Params->defaultDesiredKeyLength);
         mac = computeMAC(derivedKey.end() - params.getKeyBytesSize(), derivedKey.end(), encrypted);
+    } else if (auto* argon2Params = std::get_if<Argon2Parameters>(&params.kdfParams); argon2Params) {
+        derivedKey.resize(argon2Params->defaultDesiredKeyLength);
+        argon2id(password, argon2Params->salt, argon2Params->iterations, argon2Params->memoryKiB, argon2Params->lanes,
+                 derivedKey.data(), argon2Params->defaultDesiredKeyLength);
+        mac = computeMAC(derivedKey.end() - params.getKeyBytesSize(), derivedKey.end(), encrypted);
     } else {
         throw DecryptionError::unsupportedKDF;
     }
@@ -127,7 +149,7 @@ Data EncryptedPayload::decrypt(const Data& password) const {
         throw DecryptionError::invalidPassword;
     }
 
-    Data decrypted(encrypted.size());
+    SecureData decrypted(encrypted.size());
     Data iv = params.cipherParams.iv;
     const auto encryption = params.cipherParams.mCipherEncryption;
     if (encryption == TWStoredKeyEncryptionAes128Ctr || encryption == TWStoredKeyEncryptionAes256Ctr) {
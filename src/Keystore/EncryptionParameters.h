@@ -7,13 +7,16 @@
 #pragma once
 
 #include "AESParameters.h"
+#include "Argon2Parameters.h"
 #include "Data.h"
 #include "PBKDF2Parameters.h"
 #include "ScryptParameters.h"
+#include "memory/secure_allocator.h"
 #include <TrustWalletCore/TWStoredKeyEncryption.h>
 #include <TrustWalletCore/TWStoredKeyEncryptionLevel.h>
 
 #include <nlohmann/json.hpp>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -46,12 +49,12 @@ struct EncryptionParameters {
     AESParameters cipherParams = AESParameters();
 
     /// Key derivation function parameters.
-    std::variant<ScryptParameters, PBKDF2Parameters> kdfParams = ScryptParameters();
+    std::variant<ScryptParameters, PBKDF2Parameters, Argon2Parameters> kdfParams = ScryptParameters();
 
     EncryptionParameters() = default;
 
     /// Initializes with standard values.
-    EncryptionParameters(AESParameters cipherParams, std::variant<ScryptParameters, PBKDF2Parameters> kdfParams)
+    EncryptionParameters(AESParameters cipherParams, std::variant<ScryptParameters, PBKDF2Parameters, Argon2Parameters> kdfParams)
         : cipherParams(std::move(cipherParams)), kdfParams(std::move(kdfParams)) {
     }
 
@@ -100,13 +103,13 @@ public:
 
     /// Initializes by encrypting data with a password
     /// using standard values.
-    EncryptedPayload(const Data& password, const Data& data, const EncryptionParameters& params);
+    EncryptedPayload(const Data& password, std::span<const byte> data, const EncryptionParameters& params);
 
     /// Initializes with a JSON object.
     EncryptedPayload(const nlohmann::json& json);
 
-    /// Decrypts the payload with the given password.
-    Data decrypt(const Data& password) const;
+    /// Decrypts the payload with the given password, into locked memory wiped on release.
+    SecureData decrypt(const Data& password) const;
 
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
@@ -0,0 +1,116 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "KdfTuning.h"
+#include "Scrypt.h"
+
+#include <TrezorCrypto/pbkdf2.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace TW::Keystore::KdfTuning {
+
+namespace {
+
+/// PBKDF2 iterations of the first measurement, and lower bound of tuned iterations.
+const uint32_t minimalIterations = 1 << 12;
+
+/// Upper bound of the tuned scrypt parallelization factor.
+const uint32_t maxP = 1 << 8;
+
+const auto benchmarkPassword = TW::data(std::string("benchmark password"));
+
+template <typename Func>
+std::chrono::nanoseconds measure(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::max(std::chrono::steady_clock::now() - start, std::chrono::steady_clock::duration(1));
+}
+
+} // namespace
+
+std::chrono::nanoseconds benchmark(const ScryptParameters& params) {
+    Data derivedKey(params.desiredKeyLength);
+    return measure([&] {
+        scrypt(benchmarkPassword.data(), benchmarkPassword.size(), params.salt.data(), params.salt.size(),
+               params.n, params.r, params.p, derivedKey.data(), derivedKey.size());
+    });
+}
+
+std::chrono::nanoseconds benchmark(const PBKDF2Parameters& params) {
+    Data derivedKey(params.desiredKeyLength);
+    return measure([&] {
+        pbkdf2_hmac_sha256(benchmarkPassword.data(), static_cast<int>(benchmarkPassword.size()), params.salt.data(),
+                           static_cast<int>(params.salt.size()), params.iterations, derivedKey.data(),
+                           static_cast<int>(derivedKey.size()));
+    });
+}
+
+std::chrono::milliseconds targetTime(TWStoredKeyEncryptionLevel level) {
+    switch (level) {
+    case TWStoredKeyEncryptionLevelMinimal:
+        return std::chrono::milliseconds(100);
+    case TWStoredKeyEncryptionLevelWeak:
+    case TWStoredKeyEncryptionLevelDefault:
+    default:
+        return std::chrono::milliseconds(250);
+    case TWStoredKeyEncryptionLevelStandard:
+        return std::chrono::milliseconds(1000);
+    }
+}
+
+ScryptParameters tuneScrypt(std::chrono::milliseconds target, std::size_t maxMemory) {
+    ScryptParameters params;
+    params.r = ScryptParameters::defaultR;
+    params.p = 1;
+    params.n = ScryptParameters::minimalN;
+    const auto maxN = std::max<std::size_t>(std::bit_floor(maxMemory / (std::size_t(128) * params.r)), params.n);
+
+    // Cost grows linearly with n, so doubling n while the last run took at most half the target
+    // ends with the largest n within it; the runs add up to about twice the target.
+    auto elapsed = benchmark(params);
+    while (params.n < maxN && elapsed * 2 <= target) {
+        params.n *= 2;
+        elapsed = benchmark(params);
+    }
+    // Lanes of p run in parallel (see `scrypt`), so their cost is measured rather than extrapolated.
+    while (params.n == maxN && params.p < maxP && elapsed * 2 <= target) {
+        params.p *= 2;
+        elapsed = benchmark(params);
+    }
+    if (auto error = params.validate(); error) {
+        throw *error;
+    }
+    return params;
+}
+
+PBKDF2Parameters tunePBKDF2(std::chrono::milliseconds target) {
+    PBKDF2Parameters params;
+    params.iterations = minimalIterations;
+
+    // Measure a run long enough to be accurate, then scale the iterations linearly.
+    const auto maxIterations = std::numeric_limits<uint32_t>::max() / 2;
+    auto elapsed = benchmark(params);
+    while (elapsed * 8 < target && params.iterations <= maxIterations / 2) {
+        params.iterations *= 2;
+        elapsed = benchmark(params);
+    }
+    const auto scale = std::chrono::duration<double>(target) / elapsed;
+    params.iterations = static_cast<uint32_t>(std::clamp<double>(params.iterations * scale, minimalIterations, maxIterations));
+    return params;
+}
+
+EncryptionParameters tune(std::chrono::milliseconds target, TWStoredKeyEncryption encryption) {
+    return EncryptionParameters(AESParameters::AESParametersFromEncryption(encryption), tuneScrypt(target));
+}
+
+EncryptionParameters tune(TWStoredKeyEncryptionLevel level, TWStoredKeyEncryption encryption) {
+    return tune(targetTime(level), encryption);
+}
+
+} // namespace TW::Keystore::KdfTuning
@@ -0,0 +1,49 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "EncryptionParameters.h"
+#include "PBKDF2Parameters.h"
+#include "ScryptParameters.h"
+
+#include <chrono>
+#include <cstddef>
+
+/// Key derivation parameters tuned to the current device, instead of the fixed presets.
+/// Tuning runs the key derivation function a few times and takes about twice the target time,
+/// so it is best done once, off the UI thread, and the result kept with the app settings.
+namespace TW::Keystore::KdfTuning {
+
+/// Default memory limit of tuned scrypt parameters, 256MB as for the standard preset.
+static const std::size_t defaultMaxMemory = std::size_t(128) * ScryptParameters::defaultR * ScryptParameters::standardN;
+
+/// Time deriving a key with `params` takes on this device.
+std::chrono::nanoseconds benchmark(const ScryptParameters& params);
+
+/// Time deriving a key with `params` takes on this device.
+std::chrono::nanoseconds benchmark(const PBKDF2Parameters& params);
+
+/// Unlock time aimed at for an encryption level: 100ms for minimal, 250ms for weak (and default), 1s for standard.
+std::chrono::milliseconds targetTime(TWStoredKeyEncryptionLevel level);
+
+/// Scrypt parameters with a random salt, taking at most `target` to derive a key on this device.
+/// `n` is the largest power of two within the target and within `maxMemory` (128 * r * n bytes), with `r` = 8;
+/// once the memory limit is reached the remaining time goes into `p` (at most 256).
+/// `n` is never below `ScryptParameters::minimalN`, even on devices too slow for the target.
+ScryptParameters tuneScrypt(std::chrono::milliseconds target, std::size_t maxMemory = defaultMaxMemory);
+
+/// PBKDF2 parameters with a random salt, taking about `target` to derive a key on this device.
+/// The iteration count is never below 4096.
+PBKDF2Parameters tunePBKDF2(std::chrono::milliseconds target);
+
+/// Encryption parameters using tuned scrypt parameters and a random IV.
+EncryptionParameters tune(std::chrono::milliseconds target, TWStoredKeyEncryption encryption = TWStoredKeyEncryptionAes128Ctr);
+
+/// Encryption parameters using scrypt parameters tuned to the target time of `level`.
+EncryptionParameters tune(TWStoredKeyEncryptionLevel level, TWStoredKeyEncryption encryption = TWStoredKeyEncryptionAes128Ctr);
+
+} // namespace TW::Keystore::KdfTuning
@@ -5,8 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PBKDF2Parameters.h"
-
-#include <TrezorCrypto/rand.h>
+#include "../Random.h"
 
 using namespace TW;
 
@@ -14,7 +13,7 @@ namespace TW::Keystore {
 
 PBKDF2Parameters::PBKDF2Parameters()
     : salt(32) {
-    random_buffer(salt.data(), salt.size());
+    Random::fill(salt.data(), salt.size());
 }
 
 // -----------------
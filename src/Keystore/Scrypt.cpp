@@ -0,0 +1,277 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Scrypt.h"
+
+#include "algorithm/parallel.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/pbkdf2.h>
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace TW::Keystore {
+
+std::mutex ScryptMemoryBudget::mutex;
+std::condition_variable ScryptMemoryBudget::released;
+std::size_t ScryptMemoryBudget::limitBytes = 0;
+std::size_t ScryptMemoryBudget::usedBytes = 0;
+
+void ScryptMemoryBudget::setLimit(std::size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        limitBytes = bytes;
+    }
+    released.notify_all();
+}
+
+std::size_t ScryptMemoryBudget::limit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return limitBytes;
+}
+
+std::size_t ScryptMemoryBudget::used() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::size_t ScryptMemoryBudget::lanesWithinLimit(std::size_t lanes, std::size_t laneBytes) {
+    const auto budget = limit();
+    if (budget == 0 || laneBytes == 0) {
+        return std::max<std::size_t>(lanes, 1);
+    }
+    return std::clamp<std::size_t>(budget / laneBytes, 1, std::max<std::size_t>(lanes, 1));
+}
+
+ScryptMemoryBudget::Reservation::Reservation(std::size_t bytes) : bytes(bytes) {
+    std::unique_lock<std::mutex> lock(mutex);
+    released.wait(lock, [bytes] {
+        return limitBytes == 0 || usedBytes == 0 || usedBytes + bytes <= limitBytes;
+    });
+    usedBytes += bytes;
+}
+
+ScryptMemoryBudget::Reservation::~Reservation() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        usedBytes -= bytes;
+    }
+    released.notify_all();
+}
+
+namespace {
+
+// Salsa20/8 core and BlockMix / ROMix (smix) following trezor-crypto's scrypt.c (Colin Percival's reference).
+// With SSE2 the words of each 64-byte block are kept in diagonal order, so the core works on whole rows.
+
+#if defined(__SSE2__)
+
+constexpr bool diagonalLayout = true;
+
+inline __m128i rotate(__m128i value, int bits) {
+    return _mm_or_si128(_mm_slli_epi32(value, bits), _mm_srli_epi32(value, 32 - bits));
+}
+
+void salsa20_8(uint32_t block[16]) {
+    auto* rows = reinterpret_cast<__m128i*>(block);
+    const __m128i b0 = _mm_loadu_si128(rows + 0);
+    const __m128i b1 = _mm_loadu_si128(rows + 1);
+    const __m128i b2 = _mm_loadu_si128(rows + 2);
+    const __m128i b3 = _mm_loadu_si128(rows + 3);
+    __m128i x0 = b0, x1 = b1, x2 = b2, x3 = b3;
+
+    for (int i = 0; i < 8; i += 2) {
+        // columns
+        x1 = _mm_xor_si128(x1, rotate(_mm_add_epi32(x0, x3), 7));
+        x2 = _mm_xor_si128(x2, rotate(_mm_add_epi32(x1, x0), 9));
+        x3 = _mm_xor_si128(x3, rotate(_mm_add_epi32(x2, x1), 13));
+        x0 = _mm_xor_si128(x0, rotate(_mm_add_epi32(x3, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x93);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x39);
+        // rows
+        x3 = _mm_xor_si128(x3, rotate(_mm_add_epi32(x0, x1), 7));
+        x2 = _mm_xor_si128(x2, rotate(_mm_add_epi32(x3, x0), 9));
+        x1 = _mm_xor_si128(x1, rotate(_mm_add_epi32(x2, x3), 13));
+        x0 = _mm_xor_si128(x0, rotate(_mm_add_epi32(x1, x2), 18));
+        x1 = _mm_shuffle_epi32(x1, 0x39);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+
+    _mm_storeu_si128(rows + 0, _mm_add_epi32(b0, x0));
+    _mm_storeu_si128(rows + 1, _mm_add_epi32(b1, x1));
+    _mm_storeu_si128(rows + 2, _mm_add_epi32(b2, x2));
+    _mm_storeu_si128(rows + 3, _mm_add_epi32(b3, x3));
+}
+
+#else
+
+constexpr bool diagonalLayout = false;
+
+inline uint32_t rotate(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+void salsa20_8(uint32_t block[16]) {
+    uint32_t x[16];
+    std::memcpy(x, block, sizeof(x));
+    for (int i = 0; i < 8; i += 2) {
+        // columns
+        x[4] ^= rotate(x[0] + x[12], 7);   x[8] ^= rotate(x[4] + x[0], 9);
+        x[12] ^= rotate(x[8] + x[4], 13);  x[0] ^= rotate(x[12] + x[8], 18);
+        x[9] ^= rotate(x[5] + x[1], 7);    x[13] ^= rotate(x[9] + x[5], 9);
+        x[1] ^= rotate(x[13] + x[9], 13);  x[5] ^= rotate(x[1] + x[13], 18);
+        x[14] ^= rotate(x[10] + x[6], 7);  x[2] ^= rotate(x[14] + x[10], 9);
+        x[6] ^= rotate(x[2] + x[14], 13);  x[10] ^= rotate(x[6] + x[2], 18);
+        x[3] ^= rotate(x[15] + x[11], 7);  x[7] ^= rotate(x[3] + x[15], 9);
+        x[11] ^= rotate(x[7] + x[3], 13);  x[15] ^= rotate(x[11] + x[7], 18);
+        // rows
+        x[1] ^= rotate(x[0] + x[3], 7);    x[2] ^= rotate(x[1] + x[0], 9);
+        x[3] ^= rotate(x[2] + x[1], 13);   x[0] ^= rotate(x[3] + x[2], 18);
+        x[6] ^= rotate(x[5] + x[4], 7);    x[7] ^= rotate(x[6] + x[5], 9);
+        x[4] ^= rotate(x[7] + x[6], 13);   x[5] ^= rotate(x[4] + x[7], 18);
+        x[11] ^= rotate(x[10] + x[9], 7);  x[8] ^= rotate(x[11] + x[10], 9);
+        x[9] ^= rotate(x[8] + x[11], 13);  x[10] ^= rotate(x[9] + x[8], 18);
+        x[12] ^= rotate(x[15] + x[14], 7); x[13] ^= rotate(x[12] + x[15], 9);
+        x[14] ^= rotate(x[13] + x[12], 13); x[15] ^= rotate(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; ++i) {
+        block[i] += x[i];
+    }
+}
+
+#endif
+
+/// Position of word `i` of a 64-byte block in the working layout.
+constexpr std::size_t wordIndex(std::size_t i) {
+    return diagonalLayout ? (i * 13) % 16 : i;
+}
+
+inline void blockXor(uint32_t* dest, const uint32_t* src, std::size_t words) {
+    for (std::size_t i = 0; i < words; ++i) {
+        dest[i] ^= src[i];
+    }
+}
+
+void blockMix(const uint32_t* in, uint32_t* out, uint32_t* x, std::size_t r) {
+    std::memcpy(x, &in[(2 * r - 1) * 16], 64);
+    for (std::size_t i = 0; i < 2 * r; i += 2) {
+        blockXor(x, &in[i * 16], 16);
+        salsa20_8(x);
+        std::memcpy(&out[i * 8], x, 64);
+
+        blockXor(x, &in[i * 16 + 16], 16);
+        salsa20_8(x);
+        std::memcpy(&out[i * 8 + r * 16], x, 64);
+    }
+}
+
+inline uint64_t integerify(const uint32_t* block, std::size_t r) {
+    const uint32_t* last = &block[(2 * r - 1) * 16];
+    return (static_cast<uint64_t>(last[wordIndex(1)]) << 32) + last[wordIndex(0)];
+}
+
+inline uint32_t decode32LE(const byte* src) {
+    return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+}
+
+inline void encode32LE(uint32_t value, byte* dest) {
+    dest[0] = static_cast<byte>(value);
+    dest[1] = static_cast<byte>(value >> 8);
+    dest[2] = static_cast<byte>(value >> 16);
+    dest[3] = static_cast<byte>(value >> 24);
+}
+
+/// ROMix of one 128 * r byte lane, in place; `v` holds 32 * r * n words, `xy` 64 * r + 16 words.
+void smix(byte* lane, std::size_t r, uint64_t n, uint32_t* v, uint32_t* xy) {
+    const std::size_t words = 32 * r;
+    uint32_t* x = xy;
+    uint32_t* y = &xy[words];
+    uint32_t* z = &xy[2 * words];
+
+    for (std::size_t k = 0; k < words; k += 16) {
+        for (std::size_t i = 0; i < 16; ++i) {
+            x[k + wordIndex(i)] = decode32LE(&lane[4 * (k + i)]);
+        }
+    }
+
+    for (uint64_t i = 0; i < n; i += 2) {
+        std::memcpy(&v[i * words], x, 4 * words);
+        blockMix(x, y, z, r);
+        std::memcpy(&v[(i + 1) * words], y, 4 * words);
+        blockMix(y, x, z, r);
+    }
+
+    for (uint64_t i = 0; i < n; i += 2) {
+        auto j = integerify(x, r) & (n - 1);
+        blockXor(x, &v[j * words], words);
+        blockMix(x, y, z, r);
+
+        j = integerify(y, r) & (n - 1);
+        blockXor(y, &v[j * words], words);
+        blockMix(y, x, z, r);
+    }
+
+    for (std::size_t k = 0; k < words; k += 16) {
+        for (std::size_t i = 0; i < 16; ++i) {
+            encode32LE(x[k + wordIndex(i)], &lane[4 * (k + i)]);
+        }
+    }
+}
+
+} // namespace
+
+void scrypt(const byte* password, std::size_t passwordSize, const byte* salt, std::size_t saltSize,
+            uint64_t n, uint32_t r, uint32_t p, byte* derivedKey, std::size_t derivedKeySize, std::size_t threads) {
+    if (r == 0 || p == 0 || n < 2 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("Invalid scrypt parameters");
+    }
+    if (static_cast<uint64_t>(r) * p >= (1 << 30) || r > std::numeric_limits<std::size_t>::max() / 256 / p ||
+        n > std::numeric_limits<std::size_t>::max() / 128 / r) {
+        throw std::invalid_argument("Scrypt parameters too large");
+    }
+
+    const std::size_t laneSize = 128 * static_cast<std::size_t>(r);
+    const std::size_t laneMemory = laneSize * static_cast<std::size_t>(n) + 4 * (64 * r + 16);
+    const auto workers = parallelWorkerCount(ScryptMemoryBudget::lanesWithinLimit(p, laneMemory), threads);
+
+    Data blocks(laneSize * p);
+    pbkdf2_hmac_sha256(password, static_cast<int>(passwordSize), salt, static_cast<int>(saltSize), 1,
+                       blocks.data(), static_cast<int>(blocks.size()));
+    {
+        ScryptMemoryBudget::Reservation reservation(workers * laneMemory);
+        // worker `w` processes lanes w, w + workers, ..., with its own scratch memory
+        parallelFor(workers, workers, [&](std::size_t w) {
+            std::vector<uint32_t> v(32 * r * static_cast<std::size_t>(n));
+            std::vector<uint32_t> xy(64 * r + 16);
+            for (std::size_t lane = w; lane < p; lane += workers) {
+                smix(&blocks[lane * laneSize], r, n, v.data(), xy.data());
+            }
+            memzero(v.data(), v.size() * sizeof(uint32_t));
+            memzero(xy.data(), xy.size() * sizeof(uint32_t));
+        });
+    }
+    pbkdf2_hmac_sha256(password, static_cast<int>(passwordSize), blocks.data(), static_cast<int>(blocks.size()), 1,
+                       derivedKey, static_cast<int>(derivedKeySize));
+    memzero(blocks.data(), blocks.size());
+}
+
+Data scrypt(const Data& password, const Data& salt, uint64_t n, uint32_t r, uint32_t p, std::size_t derivedKeySize, std::size_t threads) {
+    Data derivedKey(derivedKeySize);
+    scrypt(password.data(), password.size(), salt.data(), salt.size(), n, r, p, derivedKey.data(), derivedKeySize, threads);
+    return derivedKey;
+}
+
+} // namespace TW::Keystore
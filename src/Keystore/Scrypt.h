@@ -0,0 +1,65 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace TW::Keystore {
+
+/// Process-wide budget for the memory used by concurrent scrypt computations.
+/// Each computation reserves the memory of its lanes before allocating it and waits while the budget is exhausted,
+/// so concurrent key decryptions queue up instead of running out of memory.
+class ScryptMemoryBudget {
+public:
+    /// Sets the budget in bytes; 0 (the default) means unlimited.
+    static void setLimit(std::size_t bytes);
+    static std::size_t limit();
+
+    /// Bytes currently reserved by running computations.
+    static std::size_t used();
+
+    /// RAII reservation of part of the budget.
+    class Reservation {
+    public:
+        /// Reserves `bytes`, blocking until they are available.
+        /// A request larger than the whole budget waits until no other reservation is held.
+        explicit Reservation(std::size_t bytes);
+        ~Reservation();
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+    private:
+        std::size_t bytes;
+    };
+
+    /// Returns how many of `lanes` lanes of `laneBytes` each fit in the budget, at least 1.
+    static std::size_t lanesWithinLimit(std::size_t lanes, std::size_t laneBytes);
+
+private:
+    static std::mutex mutex;
+    static std::condition_variable released;
+    static std::size_t limitBytes;
+    static std::size_t usedBytes;
+};
+
+/// Computes scrypt(password, salt, N, r, p) into `derivedKey`, computing the `p` independent lanes
+/// on up to `threads` threads (0 selects the hardware concurrency), within the `ScryptMemoryBudget`.
+/// The result is identical to trezor-crypto's `scrypt`. Parameters must have been validated
+/// (see `ScryptParameters::validate`); throws std::invalid_argument otherwise.
+void scrypt(const byte* password, std::size_t passwordSize, const byte* salt, std::size_t saltSize,
+            uint64_t n, uint32_t r, uint32_t p, byte* derivedKey, std::size_t derivedKeySize, std::size_t threads = 0);
+
+/// Convenience overload returning a key of `derivedKeySize` bytes.
+Data scrypt(const Data& password, const Data& salt, uint64_t n, uint32_t r, uint32_t p, std::size_t derivedKeySize, std::size_t threads = 0);
+
+} // namespace TW::Keystore
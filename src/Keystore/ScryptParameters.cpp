@@ -5,8 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ScryptParameters.h"
+#include "../Random.h"
 
-#include <TrezorCrypto/rand.h>
 #include <limits>
 
 using namespace TW;
@@ -19,7 +19,7 @@ ScryptParameters ScryptParameters::Standard = ScryptParameters(Data(), standardN
 
 ScryptParameters::ScryptParameters()
     : salt(32) {
-    random_buffer(salt.data(), salt.size());
+    Random::fill(salt.data(), salt.size());
 }
 
 #pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
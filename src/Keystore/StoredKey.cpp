@@ -10,6 +10,7 @@
 #include "HexCoding.h"
 #include "Mnemonic.h"
 #include "PrivateKey.h"
+#include "memory/memzero_wrapper.h"
 
 #define BOOST_UUID_RANDOM_PROVIDER_FORCE_POSIX 1
 
@@ -20,12 +21,45 @@
 
 #include <cassert>
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
 
 using namespace TW;
 
 namespace TW::Keystore {
 
+DecryptedKey::DecryptedKey(StoredKeyType type, SecureData&& secret)
+    : keyType(type), secret(std::move(secret)) {
+    if (keyType == StoredKeyType::mnemonicPhrase) {
+        auto mnemonic = SecureString(reinterpret_cast<const char*>(this->secret.data()), this->secret.size());
+        // the wallet keeps its own copy of the mnemonic
+        TW::memzero(this->secret.data(), this->secret.size());
+        this->secret.clear();
+        hdWallet.emplace(mnemonic, "");
+        TW::memzero(mnemonic.data(), mnemonic.size());
+    }
+}
+
+const HDWallet<>& DecryptedKey::wallet() const {
+    if (!hdWallet.has_value()) {
+        throw std::invalid_argument("Invalid account requested.");
+    }
+    return *hdWallet;
+}
+
+PrivateKey DecryptedKey::privateKey() const {
+    if (keyType != StoredKeyType::privateKey || secret.empty()) {
+        throw std::invalid_argument("Invalid key requested.");
+    }
+    return PrivateKey(secret.data(), secret.size());
+}
+
+void DecryptedKey::wipe() {
+    TW::memzero(secret.data(), secret.size());
+    secret.clear();
+    hdWallet.reset();
+}
+
 StoredKey StoredKey::createWithMnemonic(const std::string& name, const Data& password, const std::string& mnemonic, TWStoredKeyEncryptionLevel encryptionLevel, TWStoredKeyEncryption encryption) {
     if (!Mnemonic::isValid(mnemonic)) {
         throw std::invalid_argument("Invalid mnemonic");
@@ -82,15 +116,52 @@ const HDWallet<> StoredKey::wallet(const Data& password) const {
         throw std::invalid_argument("Invalid account requested.");
     }
     const auto data = payload.decrypt(password);
-    const auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+    const auto mnemonic = std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
     return HDWallet<>(mnemonic, "");
 }
 
+DecryptedKey StoredKey::decrypt(const Data& password) const {
+    return DecryptedKey(type, payload.decrypt(password));
+}
+
+void StoredKey::AccountIndex::add(std::size_t position, const Account& account) {
+    byCoin[account.coin].push_back(position);
+    byAddress.try_emplace({account.coin, account.address}, position);
+    byDerivation.try_emplace({account.coin, account.derivation}, position);
+}
+
+const StoredKey::AccountIndex& StoredKey::accountIndex() const {
+    if (index.valid && index.storage == accounts.data() && index.size == accounts.size()) {
+        return index;
+    }
+    index.byCoin.clear();
+    index.byAddress.clear();
+    index.byDerivation.clear();
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        index.add(i, accounts[i]);
+    }
+    index.storage = accounts.data();
+    index.size = accounts.size();
+    index.valid = true;
+    return index;
+}
+
+void StoredKey::appendAccount(Account account) {
+    // bring the index up to date before the vector changes, then extend it
+    accountIndex();
+    accounts.push_back(std::move(account));
+    index.add(accounts.size() - 1, accounts.back());
+    index.storage = accounts.data();
+    index.size = accounts.size();
+}
+
 std::vector<Account> StoredKey::getAccounts(TWCoinType coin) const {
     std::vector<Account> result;
-    for (auto& account : accounts) {
-        if (account.coin == coin) {
-            result.push_back(account);
+    const auto& positions = accountIndex().byCoin;
+    if (const auto found = positions.find(coin); found != positions.end()) {
+        result.reserve(found->second.size());
+        for (const auto position : found->second) {
+            result.push_back(accounts[position]);
         }
     }
     return result;
@@ -106,11 +177,9 @@ std::optional<Account> StoredKey::getDefaultAccount(TWCoinType coin, const HDWal
         }
     }
     // no wallet or not found, rely on derivation=0 condition
-    const auto coinAccounts = getAccounts(coin);
-    for (auto& account : coinAccounts) {
-        if (account.derivation == TWDerivationDefault) {
-            return account;
-        }
+    const auto& positions = accountIndex().byDerivation;
+    if (const auto found = positions.find({coin, TWDerivationDefault}); found != positions.end()) {
+        return accounts[found->second];
     }
     return std::nullopt;
 }
@@ -121,18 +190,17 @@ std::optional<Account> StoredKey::getDefaultAccountOrAny(TWCoinType coin, const
         return defaultAccount;
     }
     // return any
-    const auto coinAccounts = getAccounts(coin);
-    if (coinAccounts.size() > 0) {
-        return coinAccounts[0];
+    const auto& positions = accountIndex().byCoin;
+    if (const auto found = positions.find(coin); found != positions.end()) {
+        return accounts[found->second.front()];
     }
     return std::nullopt;
 }
 
 std::optional<Account> StoredKey::getAccount(TWCoinType coin, const std::string& address) const {
-    for (auto& account : accounts) {
-        if (account.coin == coin && account.address == address) {
-            return account;
-        }
+    const auto& positions = accountIndex().byAddress;
+    if (const auto found = positions.find({coin, address}); found != positions.end()) {
+        return accounts[found->second];
     }
     return std::nullopt;
 }
@@ -219,13 +287,14 @@ void StoredKey::addAccount(
         // address already present
         return;
     }
-    accounts.emplace_back(address, coin, derivation, derivationPath, publicKey, extendedPublicKey);
+    appendAccount(Account(address, coin, derivation, derivationPath, publicKey, extendedPublicKey));
 }
 
 void StoredKey::removeAccount(TWCoinType coin) {
     accounts.erase(
         std::remove_if(accounts.begin(), accounts.end(), [coin](Account& account) -> bool { return account.coin == coin; }),
         accounts.end());
+    reindexAccounts();
 }
 
 void StoredKey::removeAccount(TWCoinType coin, TWDerivation derivation) {
@@ -234,6 +303,7 @@ void StoredKey::removeAccount(TWCoinType coin, TWDerivation derivation) {
             return account.coin == coin && account.derivation == derivation;
         }),
         accounts.end());
+    reindexAccounts();
 }
 
 void StoredKey::removeAccount(TWCoinType coin, DerivationPath derivationPath) {
@@ -242,26 +312,51 @@ void StoredKey::removeAccount(TWCoinType coin, DerivationPath derivationPath) {
             return account.coin == coin && account.derivationPath == derivationPath;
         }),
         accounts.end());
+    reindexAccounts();
 }
 
 const PrivateKey StoredKey::privateKey(TWCoinType coin, const Data& password) {
     return privateKey(coin, TWDerivationDefault, password);
 }
 
-const PrivateKey StoredKey::privateKey(TWCoinType coin, [[maybe_unused]] TWDerivation derivation, const Data& password) {
+const PrivateKey StoredKey::privateKey(TWCoinType coin, TWDerivation derivation, const Data& password) {
+    return privateKey(coin, derivation, decrypt(password));
+}
+
+const PrivateKey StoredKey::privateKey(TWCoinType coin, [[maybe_unused]] TWDerivation derivation, const DecryptedKey& decryptedKey) {
     if (type == StoredKeyType::mnemonicPhrase) {
-        const auto wallet = this->wallet(password);
+        const auto& wallet = decryptedKey.wallet();
         const Account& account = this->account(coin, derivation, wallet);
         return wallet.getKey(coin, account.derivationPath);
     }
     // type == StoredKeyType::privateKey
-    return PrivateKey(payload.decrypt(password));
+    return decryptedKey.privateKey();
+}
+
+void StoredKey::updateEncryptionParameters(const Data& password, const EncryptionParameters& params) {
+    auto fresh = params;
+    fresh.cipherParams = AESParameters::AESParametersFromEncryption(params.cipherParams.mCipherEncryption);
+    if (auto* scryptParams = std::get_if<ScryptParameters>(&fresh.kdfParams); scryptParams) {
+        scryptParams->salt = ScryptParameters().salt;
+    } else if (auto* pbkdf2Params = std::get_if<PBKDF2Parameters>(&fresh.kdfParams); pbkdf2Params) {
+        pbkdf2Params->salt = PBKDF2Parameters().salt;
+    } else if (auto* argon2Params = std::get_if<Argon2Parameters>(&fresh.kdfParams); argon2Params) {
+        argon2Params->salt = Argon2Parameters().salt;
+    }
+
+    auto secret = payload.decrypt(password);
+    payload = EncryptedPayload(password, secret, fresh);
+    TW::memzero(secret.data(), secret.size());
 }
 
 void StoredKey::fixAddresses(const Data& password) {
+    fixAddresses(decrypt(password));
+}
+
+void StoredKey::fixAddresses(const DecryptedKey& decryptedKey) {
     switch (type) {
     case StoredKeyType::mnemonicPhrase: {
-        const auto wallet = this->wallet(password);
+        const auto& wallet = decryptedKey.wallet();
         for (auto& account : accounts) {
             if (!account.address.empty() && !account.publicKey.empty() &&
                 TW::validateAddress(account.coin, account.address)) {
@@ -276,7 +371,7 @@ void StoredKey::fixAddresses(const Data& password) {
     } break;
 
     case StoredKeyType::privateKey: {
-        auto key = PrivateKey(payload.decrypt(password));
+        const auto key = decryptedKey.privateKey();
         for (auto& account : accounts) {
             if (!account.address.empty() && !account.publicKey.empty() &&
                 TW::validateAddress(account.coin, account.address)) {
@@ -288,6 +383,7 @@ void StoredKey::fixAddresses(const Data& password) {
         }
     } break;
     }
+    reindexAccounts();
 }
 
 // -----------------
@@ -397,8 +493,10 @@ nlohmann::json StoredKey::json() const {
 // File operations
 
 void StoredKey::store(const std::string& path) {
+    std::string text;
+    writeJson(text);
     auto stream = std::ofstream(path);
-    stream << json();
+    stream << text;
 }
 
 StoredKey StoredKey::load(const std::string& path) {
@@ -406,10 +504,8 @@ StoredKey StoredKey::load(const std::string& path) {
     if (!stream.is_open()) {
         throw std::invalid_argument("Can't open file");
     }
-    nlohmann::json j;
-    stream >> j;
-
-    return createWithJson(j);
+    const auto text = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    return createWithJsonText(text);
 }
 
 } // namespace TW::Keystore
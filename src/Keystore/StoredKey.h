@@ -16,8 +16,11 @@
 #include <TrustWalletCore/TWStoredKeyEncryption.h>
 #include <nlohmann/json.hpp>
 
+#include <map>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace TW::Keystore {
@@ -26,6 +29,45 @@ namespace TW::Keystore {
 /// wallet.
 enum class StoredKeyType { privateKey, mnemonicPhrase };
 
+/// Decrypted secret of a stored key, obtained with `StoredKey::decrypt`.
+///
+/// Lets several account, address or key derivations share one evaluation of the key derivation function.
+/// The secret is wiped by `wipe` or on destruction; keep it no longer than needed.
+class DecryptedKey {
+public:
+    DecryptedKey(const DecryptedKey&) = delete;
+    DecryptedKey& operator=(const DecryptedKey&) = delete;
+    ~DecryptedKey() { wipe(); }
+
+    /// Type of the key it was decrypted from.
+    StoredKeyType type() const { return keyType; }
+
+    /// Returns the HD wallet of a decrypted mnemonic phrase.
+    ///
+    /// @throws std::invalid_argument if the key is of a type other than `mnemonicPhrase`, or wiped.
+    const HDWallet<>& wallet() const;
+
+    /// Returns a decrypted private key.
+    ///
+    /// @throws std::invalid_argument if the key is of a type other than `privateKey`, or wiped.
+    PrivateKey privateKey() const;
+
+    /// Wipes the secret from memory; the key can't be used afterwards.
+    void wipe();
+
+    bool isWiped() const { return secret.empty() && !hdWallet.has_value(); }
+
+private:
+    friend class StoredKey;
+
+    /// Takes over the decrypted payload of a stored key.
+    DecryptedKey(StoredKeyType type, SecureData&& secret);
+
+    StoredKeyType keyType;
+    SecureData secret;
+    std::optional<HDWallet<>> hdWallet;
+};
+
 /// Represents a key stored as an encrypted file.
 class StoredKey {
 public:
@@ -42,6 +84,9 @@ public:
     EncryptedPayload payload;
 
     /// Active accounts.  Address should be unique.
+    ///
+    /// Lookups go through an index rebuilt when the accounts are added or removed; after changing the coin,
+    /// address or derivation of an element in place, call `reindexAccounts`.
     std::vector<Account> accounts;
 
     /// Create a new StoredKey, with the given name, mnemonic and password.
@@ -67,11 +112,22 @@ public:
     /// Create a StoredKey from a JSON object.
     static StoredKey createWithJson(const nlohmann::json& json);
 
+    /// Create a StoredKey from JSON text, in a single pass without building a JSON object.
+    /// The key is the same as `createWithJson(nlohmann::json::parse(json))`.
+    ///
+    /// @throws std::invalid_argument or nlohmann::json::exception if the text is not a valid key file.
+    static StoredKey createWithJsonText(std::string_view json);
+
     /// Returns the HDWallet for this key.
     ///
     /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
     const HDWallet<> wallet(const Data& password) const;
 
+    /// Decrypts the key once, for deriving several accounts or keys from it.
+    ///
+    /// @throws DecryptionError if the password is invalid.
+    DecryptedKey decrypt(const Data& password) const;
+
     /// Returns all the accounts for a specific coin: 0, 1, or more.
     std::vector<Account> getAccounts(TWCoinType coin) const;
 
@@ -122,6 +178,12 @@ public:
     /// `mnemonicPhrase` and a coin other than the default is requested.
     const PrivateKey privateKey(TWCoinType coin, TWDerivation derivation, const Data& password);
 
+    /// Returns the private key for a specific coin from a decrypted key of this stored key, creating an account if necessary.
+    ///
+    /// \throws std::invalid_argument if this key is of a type other than
+    /// `mnemonicPhrase` and a coin other than the default is requested.
+    const PrivateKey privateKey(TWCoinType coin, TWDerivation derivation, const DecryptedKey& decryptedKey);
+
     /// Loads and decrypts a stored key from a file.
     ///
     /// \param path file path to load from.
@@ -140,13 +202,53 @@ public:
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
 
+    /// Appends `this` as compact JSON text, the same as `json().dump()`, without building a JSON object.
+    void writeJson(std::string& out) const;
+
     /// Fills in all empty or invalid addresses and public keys.
     ///
     /// Use to fix legacy wallets with invalid address data. This method needs
     /// the encryption password to re-derive addresses from private keys.
     void fixAddresses(const Data& password);
 
+    /// Fills in all empty or invalid addresses and public keys, from a decrypted key of this stored key.
+    void fixAddresses(const DecryptedKey& decryptedKey);
+
+    /// Re-encrypts the payload with new encryption parameters, e.g. tuned ones (see `KdfTuning`).
+    /// A fresh salt and IV are generated, so the same parameters can be applied to many keys.
+    ///
+    /// \throws DecryptionError if the password is incorrect.
+    void updateEncryptionParameters(const Data& password, const EncryptionParameters& params);
+
+    /// Rebuilds the account index, after modifying elements of `accounts` in place.
+    void reindexAccounts() { index.valid = false; }
+
 private:
+    /// Positions in `accounts`, for lookups by coin, address and derivation.
+    struct AccountIndex {
+        /// Vector storage and size the index was built for; a different one means it is stale.
+        const Account* storage = nullptr;
+        std::size_t size = 0;
+        bool valid = false;
+
+        /// Positions of the accounts of each coin, in order.
+        std::map<TWCoinType, std::vector<std::size_t>> byCoin;
+        /// Position of the first account for each coin and address.
+        std::map<std::pair<TWCoinType, std::string>, std::size_t> byAddress;
+        /// Position of the first account for each coin and derivation.
+        std::map<std::pair<TWCoinType, TWDerivation>, std::size_t> byDerivation;
+
+        void add(std::size_t position, const Account& account);
+    };
+
+    mutable AccountIndex index;
+
+    /// Returns the account index, rebuilding it if stale.
+    const AccountIndex& accountIndex() const;
+
+    /// Appends an account and adds it to the index.
+    void appendAccount(Account account);
+
     /// Default constructor, private
     StoredKey() : type(StoredKeyType::mnemonicPhrase) {}
 
@@ -0,0 +1,490 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StoredKey.h"
+
+#include "HexCoding.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+// Single pass reading and writing of key files in the Web3 Secret Storage format, equivalent to
+// `StoredKey::loadJson` and `StoredKey::json` with the `nlohmann::json` objects of their parts.
+
+namespace TW::Keystore {
+
+namespace {
+
+using json = nlohmann::json;
+
+[[noreturn]] void invalidField(const std::string& field) {
+    throw std::invalid_argument("Invalid key file field " + field);
+}
+
+template <typename T>
+const T& required(const std::optional<T>& value, const char* field) {
+    if (!value.has_value()) {
+        invalidField(field);
+    }
+    return *value;
+}
+
+/// Fields of an encrypted payload, in whatever order they appear.
+struct PayloadFields {
+    bool present = false;
+    std::optional<std::string> cipher;
+    std::optional<std::string> ciphertext;
+    std::optional<std::string> iv;
+    std::optional<std::string> kdf;
+    std::optional<std::string> mac;
+    std::optional<std::string> salt;
+    std::optional<uint64_t> dklen;
+    std::optional<uint64_t> n;
+    std::optional<uint64_t> p;
+    std::optional<uint64_t> r;
+    std::optional<uint64_t> c;
+    std::optional<uint64_t> m;
+    std::optional<uint64_t> t;
+
+    std::variant<ScryptParameters, PBKDF2Parameters, Argon2Parameters> kdfParams() const {
+        const auto& name = required(kdf, "kdf");
+        if (name == "scrypt") {
+            // not validated, like the JSON object constructor; Minimal has its default values and no salt
+            auto params = ScryptParameters::Minimal;
+            params.salt = parse_hex(required(salt, "salt"));
+            params.desiredKeyLength = required(dklen, "dklen");
+            if (n.has_value()) {
+                params.n = static_cast<uint32_t>(*n);
+                params.p = p.has_value() ? static_cast<uint32_t>(*p) : params.p;
+                params.r = r.has_value() ? static_cast<uint32_t>(*r) : params.r;
+            }
+            return params;
+        }
+        if (name == "pbkdf2") {
+            const auto iterations = c.has_value() ? static_cast<uint32_t>(*c) : PBKDF2Parameters::defaultIterations;
+            return PBKDF2Parameters(parse_hex(required(salt, "salt")), iterations, required(dklen, "dklen"));
+        }
+        if (name == "argon2id") {
+            // not validated either, Argon2id itself rejects invalid parameters
+            auto params = Argon2Parameters::Minimal;
+            params.salt = parse_hex(required(salt, "salt"));
+            params.desiredKeyLength = required(dklen, "dklen");
+            params.memoryKiB = m.has_value() ? static_cast<uint32_t>(*m) : params.memoryKiB;
+            params.iterations = t.has_value() ? static_cast<uint32_t>(*t) : params.iterations;
+            params.lanes = p.has_value() ? static_cast<uint32_t>(*p) : params.lanes;
+            return params;
+        }
+        return ScryptParameters();
+    }
+
+    EncryptedPayload payload() const {
+        auto cipherParams = AESParameters::AESParametersFromCipher(required(cipher, "cipher"), parse_hex(required(iv, "iv")));
+        return EncryptedPayload(EncryptionParameters(std::move(cipherParams), kdfParams()),
+                                parse_hex(required(ciphertext, "ciphertext")), parse_hex(required(mac, "mac")));
+    }
+};
+
+/// Fields of an account, in whatever order they appear.
+struct AccountFields {
+    std::optional<uint64_t> derivation;
+    std::optional<uint64_t> coin;
+    DerivationPath derivationPath;
+    std::string address;
+    std::string extendedPublicKey;
+    std::string publicKey;
+    std::optional<uint64_t> indexValue;
+    std::optional<bool> indexHardened;
+
+    Account account() {
+        if (!coin.has_value()) {
+            // legacy format, get coin from derivation path
+            if (derivationPath.indices.size() < 2) {
+                invalidField("coin");
+            }
+            coin = derivationPath.indices[1].value;
+        }
+        const auto accountDerivation = derivation.has_value() ? TWDerivation(static_cast<uint32_t>(*derivation)) : TWDerivationDefault;
+        return Account(std::move(address), TWCoinType(static_cast<uint32_t>(*coin)), accountDerivation, std::move(derivationPath),
+                       std::move(publicKey), std::move(extendedPublicKey));
+    }
+};
+
+/// SAX handler filling a `StoredKey` from the events of its JSON text.
+class StoredKeyHandler {
+public:
+    explicit StoredKeyHandler(StoredKey& storedKey) : storedKey(storedKey) {}
+
+    bool null() { return other(); }
+
+    bool boolean(bool value) {
+        if (top() == Context::index && currentKey == "hardened") {
+            account.indexHardened = value;
+            return true;
+        }
+        return other();
+    }
+
+    bool number_integer(json::number_integer_t value) { return number(static_cast<uint64_t>(value)); }
+    bool number_unsigned(json::number_unsigned_t value) { return number(value); }
+    bool number_float(json::number_float_t value, const json::string_t&) { return number(static_cast<uint64_t>(static_cast<int64_t>(value))); }
+    bool binary(json::binary_t&) { return other(); }
+
+    bool string(json::string_t& value) {
+        switch (top()) {
+        case Context::root:
+            if (currentKey == "type") {
+                typeName = std::move(value);
+            } else if (currentKey == "name") {
+                storedKey.name = std::move(value);
+            } else if (currentKey == "id") {
+                storedKey.id = std::move(value);
+            } else if (currentKey == "address") {
+                legacyAddress = std::move(value);
+            } else {
+                return other();
+            }
+            return true;
+        case Context::crypto:
+            return assignIf(payload->cipher, "cipher", value) || assignIf(payload->ciphertext, "ciphertext", value) ||
+                   assignIf(payload->kdf, "kdf", value) || assignIf(payload->mac, "mac", value) || other();
+        case Context::cipherParams:
+            return assignIf(payload->iv, "iv", value) || other();
+        case Context::kdfParams:
+            return assignIf(payload->salt, "salt", value) || other();
+        case Context::account:
+            if (currentKey == "address") {
+                account.address = std::move(value);
+            } else if (currentKey == "extendedPublicKey") {
+                account.extendedPublicKey = std::move(value);
+            } else if (currentKey == "publicKey") {
+                account.publicKey = std::move(value);
+            } else if (currentKey == "derivationPath") {
+                account.derivationPath = DerivationPath(value);
+            } else {
+                return other();
+            }
+            return true;
+        default:
+            return other();
+        }
+    }
+
+    bool key(json::string_t& value) {
+        currentKey = std::move(value);
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        switch (top()) {
+        case Context::none:
+            return push(contexts.empty() ? Context::root : Context::skip);
+        case Context::root:
+            if (currentKey == "crypto" || currentKey == "Crypto") {
+                payload = currentKey == "crypto" ? &lowercasePayload : &uppercasePayload;
+                *payload = PayloadFields{.present = true};
+                return push(Context::crypto);
+            }
+            break;
+        case Context::crypto:
+            if (currentKey == "cipherparams") {
+                return push(Context::cipherParams);
+            }
+            if (currentKey == "kdfparams") {
+                return push(Context::kdfParams);
+            }
+            break;
+        case Context::accounts:
+            account = AccountFields();
+            return push(Context::account);
+        case Context::account:
+            if (currentKey == "derivationPath") {
+                account.derivationPath = DerivationPath();
+                return push(Context::derivationPath);
+            }
+            break;
+        case Context::indices:
+            account.indexValue.reset();
+            account.indexHardened.reset();
+            return push(Context::index);
+        default:
+            break;
+        }
+        other();
+        return push(Context::skip);
+    }
+
+    bool end_object() {
+        const auto context = pop();
+        if (context == Context::account) {
+            storedKey.accounts.push_back(account.account());
+        } else if (context == Context::index) {
+            account.derivationPath.indices.emplace_back(static_cast<uint32_t>(required(account.indexValue, "value")),
+                                                        required(account.indexHardened, "hardened"));
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (top() == Context::root && currentKey == "activeAccounts") {
+            return push(Context::accounts);
+        }
+        if (top() == Context::derivationPath && currentKey == "indices") {
+            return push(Context::indices);
+        }
+        other();
+        return push(Context::skip);
+    }
+
+    bool end_array() {
+        pop();
+        return true;
+    }
+
+    template <typename Exception>
+    bool parse_error(std::size_t, const std::string&, const Exception& error) {
+        throw error;
+    }
+
+    /// Completes the key once the whole text has been parsed.
+    void finish() {
+        storedKey.type = typeName == "mnemonic" ? StoredKeyType::mnemonicPhrase : StoredKeyType::privateKey;
+        if (lowercasePayload.present) {
+            storedKey.payload = lowercasePayload.payload();
+        } else if (uppercasePayload.present) {
+            // Workaround for myEtherWallet files
+            storedKey.payload = uppercasePayload.payload();
+        } else {
+            throw DecryptionError::invalidKeyFile;
+        }
+
+        if (storedKey.accounts.empty() && legacyAddress.has_value()) {
+            const auto coin = legacyCoin.has_value() ? TWCoinType(static_cast<uint32_t>(*legacyCoin)) : TWCoinTypeEthereum;
+            storedKey.accounts.emplace_back(*legacyAddress, coin, TWDerivationDefault, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0), "", "");
+        }
+    }
+
+private:
+    /// The object or array being parsed.
+    enum class Context { none, root, crypto, cipherParams, kdfParams, accounts, account, derivationPath, indices, index, skip };
+
+    Context top() const { return contexts.empty() ? Context::none : contexts.back(); }
+
+    bool push(Context context) {
+        contexts.push_back(context);
+        return true;
+    }
+
+    Context pop() {
+        const auto context = top();
+        contexts.pop_back();
+        return context;
+    }
+
+    static constexpr std::pair<const char*, std::optional<uint64_t> PayloadFields::*> kdfNumbers[] = {
+        {"dklen", &PayloadFields::dklen}, {"n", &PayloadFields::n}, {"p", &PayloadFields::p}, {"r", &PayloadFields::r}, {"c", &PayloadFields::c},
+        {"m", &PayloadFields::m}, {"t", &PayloadFields::t},
+    };
+
+    bool number(uint64_t value) {
+        switch (top()) {
+        case Context::root:
+            if (currentKey == "coin") {
+                legacyCoin = value;
+                return true;
+            }
+            break;
+        case Context::kdfParams:
+            for (const auto& [name, field] : kdfNumbers) {
+                if (currentKey == name) {
+                    payload->*field = value;
+                    return true;
+                }
+            }
+            break;
+        case Context::account:
+            if (currentKey == "derivation") {
+                account.derivation = value;
+                return true;
+            }
+            if (currentKey == "coin") {
+                account.coin = value;
+                return true;
+            }
+            break;
+        case Context::index:
+            if (currentKey == "value") {
+                account.indexValue = value;
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        return other();
+    }
+
+    bool assignIf(std::optional<std::string>& field, const char* name, std::string& value) {
+        if (currentKey != name) {
+            return false;
+        }
+        field = std::move(value);
+        return true;
+    }
+
+    /// Handles a value not consumed as a field: ignored, unless its field requires another type.
+    bool other() const {
+        static const auto strictFields = std::vector<std::pair<Context, std::vector<std::string>>>{
+            {Context::root, {"type", "name", "id", "crypto", "Crypto"}},
+            {Context::crypto, {"cipher", "ciphertext", "kdf", "mac", "cipherparams", "kdfparams"}},
+            {Context::cipherParams, {"iv"}},
+            {Context::kdfParams, {"salt", "dklen", "n", "p", "r", "c", "m", "t"}},
+            {Context::account, {"derivation", "derivationPath", "coin"}},
+            {Context::derivationPath, {"indices"}},
+            {Context::index, {"value", "hardened"}},
+        };
+        const auto context = top();
+        if (context == Context::accounts || context == Context::indices) {
+            invalidField(context == Context::accounts ? "activeAccounts" : "indices");
+        }
+        for (const auto& [strictContext, fields] : strictFields) {
+            if (strictContext == context && std::find(fields.begin(), fields.end(), currentKey) != fields.end()) {
+                invalidField(currentKey);
+            }
+        }
+        return true;
+    }
+
+    StoredKey& storedKey;
+    std::vector<Context> contexts;
+    std::string currentKey;
+    std::string typeName;
+    std::optional<std::string> legacyAddress;
+    std::optional<uint64_t> legacyCoin;
+    PayloadFields lowercasePayload;
+    PayloadFields uppercasePayload;
+    PayloadFields* payload = &lowercasePayload;
+    AccountFields account;
+};
+
+void writeString(std::string& out, const std::string& value) {
+    const auto plain = std::all_of(value.begin(), value.end(), [](char c) { return c >= 0x20 && c < 0x7f && c != '"' && c != '\\'; });
+    if (!plain) {
+        // escapes and UTF-8 checks as in dump()
+        out += json(value).dump();
+        return;
+    }
+    out += '"';
+    out += value;
+    out += '"';
+}
+
+void writeHexString(std::string& out, const Data& value) {
+    out += '"';
+    out += hex(value);
+    out += '"';
+}
+
+/// Keys are written in the sorted order of `nlohmann::json` objects.
+void writeAccount(std::string& out, const Account& account) {
+    out += "{\"address\":";
+    writeString(out, account.address);
+    out += ",\"coin\":";
+    out += std::to_string(static_cast<uint32_t>(account.coin));
+    if (account.derivation != TWDerivationDefault) {
+        out += ",\"derivation\":";
+        out += std::to_string(static_cast<int>(account.derivation));
+    }
+    out += ",\"derivationPath\":";
+    writeString(out, account.derivationPath.string());
+    if (!account.extendedPublicKey.empty()) {
+        out += ",\"extendedPublicKey\":";
+        writeString(out, account.extendedPublicKey);
+    }
+    if (!account.publicKey.empty()) {
+        out += ",\"publicKey\":";
+        writeString(out, account.publicKey);
+    }
+    out += '}';
+}
+
+void writePayload(std::string& out, const EncryptedPayload& payload) {
+    out += "{\"cipher\":";
+    writeString(out, payload.params.cipher());
+    out += ",\"cipherparams\":{\"iv\":";
+    writeHexString(out, payload.params.cipherParams.iv);
+    out += "},\"ciphertext\":";
+    writeHexString(out, payload.encrypted);
+    if (const auto* scrypt = std::get_if<ScryptParameters>(&payload.params.kdfParams); scrypt) {
+        out += ",\"kdf\":\"scrypt\",\"kdfparams\":{\"dklen\":";
+        out += std::to_string(scrypt->desiredKeyLength);
+        out += ",\"n\":";
+        out += std::to_string(scrypt->n);
+        out += ",\"p\":";
+        out += std::to_string(scrypt->p);
+        out += ",\"r\":";
+        out += std::to_string(scrypt->r);
+        out += ",\"salt\":";
+        writeHexString(out, scrypt->salt);
+        out += '}';
+    } else if (const auto* pbkdf2 = std::get_if<PBKDF2Parameters>(&payload.params.kdfParams); pbkdf2) {
+        out += ",\"kdf\":\"pbkdf2\",\"kdfparams\":{\"c\":";
+        out += std::to_string(pbkdf2->iterations);
+        out += ",\"dklen\":";
+        out += std::to_string(pbkdf2->desiredKeyLength);
+        out += ",\"salt\":";
+        writeHexString(out, pbkdf2->salt);
+        out += '}';
+    } else if (const auto* argon2 = std::get_if<Argon2Parameters>(&payload.params.kdfParams); argon2) {
+        out += ",\"kdf\":\"argon2id\",\"kdfparams\":{\"dklen\":";
+        out += std::to_string(argon2->desiredKeyLength);
+        out += ",\"m\":";
+        out += std::to_string(argon2->memoryKiB);
+        out += ",\"p\":";
+        out += std::to_string(argon2->lanes);
+        out += ",\"salt\":";
+        writeHexString(out, argon2->salt);
+        out += ",\"t\":";
+        out += std::to_string(argon2->iterations);
+        out += '}';
+    }
+    out += ",\"mac\":";
+    writeHexString(out, payload._mac);
+    out += '}';
+}
+
+} // namespace
+
+StoredKey StoredKey::createWithJsonText(std::string_view text) {
+    StoredKey storedKey;
+    StoredKeyHandler handler(storedKey);
+    json::sax_parse(text.begin(), text.end(), &handler);
+    handler.finish();
+    return storedKey;
+}
+
+void StoredKey::writeJson(std::string& out) const {
+    out += "{\"activeAccounts\":[";
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        writeAccount(out, accounts[i]);
+    }
+    out += "],\"crypto\":";
+    writePayload(out, payload);
+    if (id) {
+        out += ",\"id\":";
+        writeString(out, *id);
+    }
+    out += ",\"name\":";
+    writeString(out, name);
+    out += type == StoredKeyType::mnemonicPhrase ? ",\"type\":\"mnemonic\"" : ",\"type\":\"private-key\"";
+    out += ",\"version\":3}";
+}
+
+} // namespace TW::Keystore
@@ -21,6 +21,11 @@ std::string Entry::deriveAddress([[maybe_unused]] TWCoinType coin, const PublicK
     return Address(publicKey).string();
 }
 
+std::vector<std::string> Entry::deriveAddresses([[maybe_unused]] TWCoinType coin, const std::vector<PublicKey>& publicKeys, [[maybe_unused]] TWDerivation derivation, [[maybe_unused]] const PrefixVariant& addressPrefix) const {
+    const auto networks = std::vector<uint32_t>(publicKeys.size(), TWSS58AddressTypeKusama);
+    return SS58Address::encodeBatch(publicKeys, networks);
+}
+
 Data Entry::addressToData([[maybe_unused]] TWCoinType coin, const std::string& address) const {
     const auto addr = Address(address);
     return {addr.bytes.begin() + 1, addr.bytes.end()};
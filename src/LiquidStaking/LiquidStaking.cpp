@@ -17,6 +17,7 @@
 #include "Ethereum/ABI/Function.h"
 #include "Ethereum/ABI/ParamAddress.h"
 #include "Ethereum/ABI/ParamBase.h"
+#include "Ethereum/ABI/ValueEncoder.h"
 #include "Ethereum/Address.h"
 #include "proto/Ethereum.pb.h"
 #include "uint256.h"
@@ -54,6 +55,42 @@ static const EVMLiquidStakingRegistry gEVMLiquidStakingRegistry = {
     {Proto::Protocol::Lido, gLidoFunctionRegistry},
 };
 
+/// Call data of a protocol action encoded up front: the selector and the static arguments.
+/// The action value, if any (unstake amount, withdraw index), is appended as a uint256.
+struct CallTemplate {
+    Data head;
+    bool appendsValue;
+};
+
+using EVMCallTemplateRegistry = std::unordered_map<BlockchainActionEnumPair, CallTemplate, PairHash>;
+using EVMCallTemplates = std::unordered_map<Proto::Protocol, EVMCallTemplateRegistry>;
+
+static const EVMCallTemplates& evmCallTemplates() {
+    static const EVMCallTemplates templates = [] {
+        EVMCallTemplates result;
+        for (const auto& [protocol, functions] : gEVMLiquidStakingRegistry) {
+            for (const auto& [key, functionName] : functions) {
+                Params params;
+                if (protocol == Proto::Lido) {
+                    params.emplace_back(std::make_shared<Ethereum::ABI::ParamAddress>());
+                }
+                const bool appendsValue = key.second != Action::Stake;
+                if (appendsValue) {
+                    params.emplace_back(std::make_shared<Ethereum::ABI::ParamUInt256>());
+                }
+                Data head;
+                Ethereum::ABI::Function(functionName, params).encode(head);
+                if (appendsValue) {
+                    head.resize(head.size() - Ethereum::ABI::ValueEncoder::encodedIntSize);
+                }
+                result[protocol].emplace(key, CallTemplate{std::move(head), appendsValue});
+            }
+        }
+        return result;
+    }();
+    return templates;
+}
+
 namespace internal {
     void setTransferDataAndAmount(Ethereum::Proto::Transaction::ContractGeneric& transfer, const Data& payload, const uint256_t& amount) {
         transfer.set_data(payload.data(), payload.size());
@@ -61,30 +98,28 @@ namespace internal {
         transfer.set_amount(amountData.data(), amountData.size());
     }
 
-    void handleStake(const Proto::Stake& stake, const Proto::Blockchain& blockchain, Data& payload, uint256_t& amount, const Proto::Protocol protocol) {
-        Params params;
-        if (protocol == Proto::Lido) {
-            params.emplace_back(std::make_shared<Ethereum::ABI::ParamAddress>());
+    Data encodeCall(Proto::Protocol protocol, const Proto::Blockchain& blockchain, Action action, const std::string& value = "") {
+        const auto& callTemplate = evmCallTemplates().at(protocol).at({blockchain, action});
+        Data payload;
+        payload.reserve(callTemplate.head.size() + Ethereum::ABI::ValueEncoder::encodedIntSize);
+        append(payload, callTemplate.head);
+        if (callTemplate.appendsValue) {
+            Ethereum::ABI::ValueEncoder::encodeUInt256(uint256_t(value), payload);
         }
-        auto func = Ethereum::ABI::Function(gEVMLiquidStakingRegistry.at(protocol).at({blockchain, Action::Stake}), params);
-        func.encode(payload);
+        return payload;
+    }
+
+    void handleStake(const Proto::Stake& stake, const Proto::Blockchain& blockchain, Data& payload, uint256_t& amount, const Proto::Protocol protocol) {
+        payload = encodeCall(protocol, blockchain, Action::Stake);
         amount = uint256_t(stake.amount());
     }
 
     void handleUnstake(const Proto::Unstake& unstake, const Proto::Blockchain& blockchain, Data& payload) {
-        Params params;
-        params.emplace_back(std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(unstake.amount())));
-        auto functionName = gStraderFunctionRegistry.at({blockchain, Action::Unstake});
-        auto func = Ethereum::ABI::Function(functionName, params);
-        func.encode(payload);
+        payload = encodeCall(Proto::Strader, blockchain, Action::Unstake, unstake.amount());
     }
 
     void handleWithdraw(const Proto::Withdraw& withdraw, const Proto::Blockchain& blockchain, Data& payload) {
-        Params params;
-        params.emplace_back(std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(withdraw.idx())));
-        auto functionName = gStraderFunctionRegistry.at({blockchain, Action::Withdraw});
-        auto func = Ethereum::ABI::Function(functionName, params);
-        func.encode(payload);
+        payload = encodeCall(Proto::Strader, blockchain, Action::Withdraw, withdraw.idx());
     }
 }
 
@@ -267,4 +302,13 @@ Proto::Output Builder::build() const {
     }
 }
 
+std::vector<Proto::Output> buildBatch(const std::vector<Proto::Input>& inputs) {
+    std::vector<Proto::Output> outputs;
+    outputs.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        outputs.emplace_back(build(input));
+    }
+    return outputs;
+}
+
 } // namespace TW::LiquidStaking
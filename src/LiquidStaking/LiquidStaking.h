@@ -10,6 +10,7 @@
 #include "TrustWalletCore/TWBlockchain.h"
 #include <variant>
 #include <optional>
+#include <vector>
 
 namespace TW::LiquidStaking {
 using TAction = std::variant<Proto::Stake, Proto::Unstake, Proto::Withdraw>;
@@ -109,4 +110,8 @@ static inline Proto::Output build(const Proto::Input& input) {
 
     return Builder::builder().action(action).protocol(input.protocol()).smartContractAddress(input.smart_contract_address()).blockchain(input.blockchain()).build();
 }
+
+/// Builds the outputs of many inputs (e.g. simulated stake and unstake actions) in one call, in order.
+/// EVM call data is encoded from per-protocol, per-action templates prepared once.
+std::vector<Proto::Output> buildBatch(const std::vector<Proto::Input>& inputs);
 } // namespace TW::LiquidStaking
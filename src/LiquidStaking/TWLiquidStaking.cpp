@@ -25,3 +25,22 @@ TWData *_Nonnull TWLiquidStakingBuildRequest(TWData *_Nonnull input) {
     auto outputData = TW::data(outputProto.SerializeAsString());
     return TWDataCreateWithBytes(outputData.data(), outputData.size());
 }
+
+TWData *_Nonnull TWLiquidStakingBuildRequests(TWData *_Nonnull input) {
+    LiquidStaking::Proto::InputBatch inputProto;
+    LiquidStaking::Proto::OutputBatch outputProto;
+
+    if (!inputProto.ParseFromArray(TWDataBytes(input), static_cast<int>(TWDataSize(input)))) {
+        *outputProto.mutable_status() = LiquidStaking::generateError(LiquidStaking::Proto::ERROR_INPUT_PROTO_DESERIALIZATION);
+        auto outputData = TW::data(outputProto.SerializeAsString());
+        return TWDataCreateWithBytes(outputData.data(), outputData.size());
+    }
+
+    auto outputs = LiquidStaking::buildBatch({inputProto.inputs().begin(), inputProto.inputs().end()});
+    outputProto.mutable_outputs()->Reserve(static_cast<int>(outputs.size()));
+    for (auto& output : outputs) {
+        *outputProto.add_outputs() = std::move(output);
+    }
+    auto outputData = TW::data(outputProto.SerializeAsString());
+    return TWDataCreateWithBytes(outputData.data(), outputData.size());
+}
@@ -8,6 +8,8 @@
 
 #include <TrezorCrypto/bip39_english.h>
 #include <TrezorCrypto/bip39.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/sha2.h>
 
 #include <algorithm>
 #include <string>
@@ -19,24 +21,139 @@ namespace TW {
 
 const int Mnemonic::SuggestMaxCount = 10;
 
-bool Mnemonic::isValid(const std::string& mnemonic) {
-    return mnemonic_check(mnemonic.c_str()) != 0;
+inline const char* const* mnemonicWordlist() { return wordlist; }
+
+namespace {
+
+constexpr std::size_t Letters = 26;
+
+/// Index over the sorted wordlist: the words starting with each pair of letters form a contiguous range.
+/// Every BIP39 English word has at least 3 letters, so a bucket narrows a lookup to a handful of words.
+struct WordBuckets {
+    /// `start[b]` is the first word in bucket `b` or later; bucket `b` is `[start[b], start[b + 1])`.
+    std::array<uint16_t, Letters * Letters + 1> start{};
+
+    WordBuckets() {
+        std::size_t word = 0;
+        for (std::size_t bucket = 0; bucket < Letters * Letters; ++bucket) {
+            start[bucket] = static_cast<uint16_t>(word);
+            while (word < BIP39_WORD_COUNT && bucketOf(mnemonicWordlist()[word]) == bucket) {
+                ++word;
+            }
+        }
+        start[Letters * Letters] = static_cast<uint16_t>(word);
+        assert(word == BIP39_WORD_COUNT);
+    }
+
+    static std::size_t bucketOf(const char* word) {
+        return std::size_t(word[0] - 'a') * Letters + std::size_t(word[1] - 'a');
+    }
+};
+
+const WordBuckets& wordBuckets() {
+    static const WordBuckets buckets;
+    return buckets;
 }
 
-inline const char* const* mnemonicWordlist() { return wordlist; }
+inline bool isLowerLetter(char c) {
+    return c >= 'a' && c <= 'z';
+}
 
-bool Mnemonic::isValidWord(const std::string& word) {
-    const char* wordC = word.c_str();
-    const auto len = word.length();
-    // Although this operation is not security-critical, we aim for constant-time operation here as well
-    // (i.e., no early exit on match)
-    auto found = false;
-    for (const char* const* w = mnemonicWordlist(); *w != nullptr; ++w) {
-        if (std::string(*w).size() == len && strncmp(*w, wordC, len) == 0) {
-            found = true;
+/// Range of words starting with a lowercase prefix, as `[first, last)` indices.
+std::pair<std::size_t, std::size_t> prefixRange(std::string_view prefix) {
+    if (prefix.empty() || !isLowerLetter(prefix[0])) {
+        return {0, 0};
+    }
+    const auto& start = wordBuckets().start;
+    const auto first = std::size_t(prefix[0] - 'a') * Letters;
+    if (prefix.size() == 1) {
+        return {start[first], start[first + Letters]};
+    }
+    if (!isLowerLetter(prefix[1])) {
+        return {0, 0};
+    }
+    const auto bucket = first + std::size_t(prefix[1] - 'a');
+    const auto* words = mnemonicWordlist();
+    const auto* begin = words + start[bucket];
+    const auto* end = words + start[bucket + 1];
+    const auto* lower = std::lower_bound(begin, end, prefix, [](const char* word, std::string_view p) {
+        return std::string_view(word) < p;
+    });
+    const auto* upper = std::find_if(lower, end, [&prefix](const char* word) {
+        return !std::string_view(word).starts_with(prefix);
+    });
+    return {std::size_t(lower - words), std::size_t(upper - words)};
+}
+
+} // namespace
+
+int Mnemonic::wordIndex(std::string_view word) {
+    if (word.size() < 2 || word.size() > BIP39_MAX_WORD_LENGTH) {
+        return -1;
+    }
+    const auto [first, last] = prefixRange(word.substr(0, 2));
+    const auto* words = mnemonicWordlist();
+    const auto* found = std::lower_bound(words + first, words + last, word, [](const char* w, std::string_view p) {
+        return std::string_view(w) < p;
+    });
+    if (found == words + last || std::string_view(*found) != word) {
+        return -1;
+    }
+    return static_cast<int>(found - words);
+}
+
+int Mnemonic::toBits(std::string_view mnemonic, Bits& bits) {
+    bits.fill(0);
+    // Words are separated by single spaces; read up to the first NUL, like a C string.
+    const auto phrase = mnemonic.substr(0, mnemonic.find('\0'));
+    const auto words = std::count(phrase.begin(), phrase.end(), ' ') + 1;
+    if (words != 12 && words != 15 && words != 18 && words != 21 && words != 24) {
+        return 0;
+    }
+
+    std::size_t bit = 0;
+    std::size_t begin = 0;
+    while (begin <= phrase.size()) {
+        auto end = phrase.find(' ', begin);
+        if (end == std::string_view::npos) {
+            end = phrase.size();
+        }
+        const auto index = wordIndex(phrase.substr(begin, end - begin));
+        if (index < 0) {
+            bits.fill(0);
+            return 0;
         }
+        for (int i = BitsPerWord - 1; i >= 0; --i, ++bit) {
+            if ((index >> i) & 1) {
+                bits[bit / 8] |= static_cast<uint8_t>(1 << (7 - bit % 8));
+            }
+        }
+        begin = end + 1;
     }
-    return found;
+    return static_cast<int>(bit);
+}
+
+bool Mnemonic::isValid(std::string_view mnemonic) {
+    Bits bits;
+    const auto bitCount = toBits(mnemonic, bits);
+    if (bitCount == 0) {
+        return false;
+    }
+    // Each 3 words carry 32 bits of entropy and 1 bit of checksum.
+    const auto words = bitCount / BitsPerWord;
+    const auto entropyBytes = static_cast<std::size_t>(words * 4 / 3);
+    const auto checksumBits = words / 3;
+    const uint8_t mask = static_cast<uint8_t>(0xff << (8 - checksumBits));
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    sha256_Raw(bits.data(), entropyBytes, hash);
+    const auto valid = (hash[0] & mask) == (bits[entropyBytes] & mask);
+    memzero(bits.data(), bits.size());
+    memzero(hash, sizeof(hash));
+    return valid;
+}
+
+bool Mnemonic::isValidWord(const std::string& word) {
+    return wordIndex(word) >= 0;
 }
 
 std::string Mnemonic::suggest(const std::string& prefix) {
@@ -48,29 +165,17 @@ std::string Mnemonic::suggest(const std::string& prefix) {
     std::string prefixLo = prefix;
     std::transform(prefixLo.begin(), prefixLo.end(), prefixLo.begin(),
         [](unsigned char c){ return std::tolower(c); });
-    const char* prefixLoC = prefixLo.c_str();
-
-    std::vector<std::string> result;
-    for (const char* const* word = mnemonicWordlist(); *word != nullptr; ++word) {
-        // check first letter match (optimization)
-        if ((*word)[0] == prefixLo[0]) {
-            if (strncmp(*word, prefixLoC, prefixLo.length()) == 0) {
-                // we have a match
-                result.emplace_back(*word);
-                if (result.size() >= SuggestMaxCount) {
-                    break; // enough results
-                }
-            }
-        }
-    }
+
+    auto [first, last] = prefixRange(prefixLo);
+    last = std::min<std::size_t>(last, first + SuggestMaxCount);
 
     // convert results to one string
     std::string resultString;
-    for (auto& word: result) {
+    for (auto i = first; i < last; ++i) {
         if (resultString.length() > 0) {
             resultString += " ";
         }
-        resultString += word;
+        resultString += mnemonicWordlist()[i];
     }
     return resultString;
 }
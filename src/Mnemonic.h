@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace TW {
 
@@ -20,7 +23,7 @@ public:
 public:
     /// Determines whether a BIP39 English mnemonic phrase is valid.
     // E.g. for a valid mnemonic: "credit expect life fade cover suit response wash pear what skull force"
-    static bool isValid(const std::string& mnemonic);
+    static bool isValid(std::string_view mnemonic);
 
     /// Determines whether word is a valid BIP39 English menemonic word.
     static bool isValidWord(const std::string& word);
@@ -41,6 +44,17 @@ public:
     static std::string suggest(const std::string& prefix);
 
     static const int SuggestMaxCount;
+
+    /// Returns the index of a lowercase BIP39 English word in the wordlist, or -1 if it is not a word.
+    static int wordIndex(std::string_view word);
+
+    /// Bits of a mnemonic of MaxWords words, entropy followed by checksum.
+    using Bits = std::array<std::uint8_t, (MaxWords * BitsPerWord + 7) / 8>;
+
+    /// Decodes a mnemonic into its entropy and checksum bits, 11 bits per word in order.
+    /// \returns the number of bits, or 0 if the word count is not supported or a word is invalid.
+    /// The checksum is not verified.
+    static int toBits(std::string_view mnemonic, Bits& bits);
 };
 
 } // namespace TW
@@ -31,7 +31,7 @@ public:
 
     /// Initializes an address with a public key.
     Address(const PublicKey& publicKey)
-        : Bech32Address(hrp, publicKey.bytes) {}
+        : Bech32Address(hrp, Data(publicKey.bytes)) {}
 
     static bool decode(const std::string& addr, Address& obj_out) {
         return Bech32Address::decode(addr, obj_out, hrp);
@@ -9,15 +9,19 @@
 #include "HexCoding.h"
 #include "uint256.h"
 
+#include <array>
+
 namespace TW::MultiversX {
 
 std::string Codec::encodeString(const std::string& value) {
-    std::string encoded = hex(TW::data(value));
+    std::string encoded;
+    appendString(encoded, value);
     return encoded;
 }
 
 std::string Codec::encodeUint64(uint64_t value) {
-    std::string encoded = hex(store(uint256_t(value)));
+    std::string encoded;
+    appendUint64(encoded, value);
     return encoded;
 }
 
@@ -27,19 +31,52 @@ std::string Codec::encodeBigInt(const std::string& value) {
 
 // For reference, see https://docs.multiversx.com/developers/developer-reference/serialization-format#arbitrary-width-big-numbers.
 std::string Codec::encodeBigInt(uint256_t value) {
-    std::string encoded = hex(store(value));
+    std::string encoded;
+    appendBigInt(encoded, value);
     return encoded;
 }
 
 std::string Codec::encodeAddress(const std::string& bech32Address) {
-    Address address;
-    Address::decode(bech32Address, address);
-    return encodeAddress(address);
+    std::string encoded;
+    appendAddress(encoded, bech32Address);
+    return encoded;
 }
 
 std::string Codec::encodeAddress(const Address& address) {
-    std::string encoded = hex(address.getKeyHash());
+    std::string encoded;
+    appendAddress(encoded, address);
     return encoded;
 }
 
+void Codec::appendString(std::string& out, const std::string& value) {
+    appendHex(reinterpret_cast<const byte*>(value.data()), value.size(), out);
+}
+
+void Codec::appendUint64(std::string& out, uint64_t value) {
+    // big endian, without leading zeros; zero is a single byte
+    std::array<byte, sizeof(uint64_t)> bytes;
+    std::size_t start = bytes.size();
+    do {
+        bytes[--start] = static_cast<byte>(value);
+        value >>= 8;
+    } while (value != 0);
+    appendHex(bytes.data() + start, bytes.size() - start, out);
+}
+
+void Codec::appendBigInt(std::string& out, const uint256_t& value) {
+    const auto bytes = store(value);
+    appendHex(bytes.data(), bytes.size(), out);
+}
+
+void Codec::appendAddress(std::string& out, const std::string& bech32Address) {
+    Address address;
+    Address::decode(bech32Address, address);
+    appendAddress(out, address);
+}
+
+void Codec::appendAddress(std::string& out, const Address& address) {
+    const auto& keyHash = address.getKeyHash();
+    appendHex(keyHash.data(), keyHash.size(), out);
+}
+
 } // namespace TW::MultiversX
@@ -24,6 +24,13 @@ public:
     static std::string encodeBigInt(TW::uint256_t value);
     static std::string encodeAddress(const std::string& bech32Address);
     static std::string encodeAddress(const Address& address);
+
+    /// Append the same hex encodings to `out`, e.g. to write the arguments of a function call in place.
+    static void appendString(std::string& out, const std::string& value);
+    static void appendUint64(std::string& out, uint64_t value);
+    static void appendBigInt(std::string& out, const TW::uint256_t& value);
+    static void appendAddress(std::string& out, const std::string& bech32Address);
+    static void appendAddress(std::string& out, const Address& address);
 };
 
 } // namespace TW::MultiversX
@@ -11,76 +11,115 @@
 
 using namespace TW;
 
-std::map<std::string, int> fields_order{
-    {"nonce", 1},
-    {"value", 2},
-    {"receiver", 3},
-    {"sender", 4},
-    {"senderUsername", 5},
-    {"receiverUsername", 6},
-    {"gasPrice", 7},
-    {"gasLimit", 8},
-    {"data", 9},
-    {"chainID", 10},
-    {"version", 11},
-    {"signature", 12},
-    {"options", 13},
-    {"guardian", 14}};
-
-struct FieldsSorter {
-    bool operator()(const std::string& lhs, const std::string& rhs) const {
-        return fields_order[lhs] < fields_order[rhs];
+namespace {
+
+/// Appends `value` as a JSON string, escaped as `nlohmann::json::dump` does.
+void appendJSONString(std::string& out, const std::string& value) {
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    out.push_back('"');
+    for (const char c : value) {
+        switch (c) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\b': out.append("\\b"); break;
+        case '\f': out.append("\\f"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out.append("\\u00");
+                out.push_back(hexDigits[c >> 4]);
+                out.push_back(hexDigits[c & 0x0f]);
+            } else {
+                out.push_back(c);
+            }
+        }
     }
-};
+    out.push_back('"');
+}
 
-template <class Key, class T, class Compare, class Allocator>
-using sorted_map = std::map<Key, T, FieldsSorter, Allocator>;
-using sorted_json = nlohmann::basic_json<sorted_map>;
-
-sorted_json preparePayload(const MultiversX::Transaction& transaction) {
-    using namespace nlohmann;
-    sorted_json payload{
-        {"nonce", json(transaction.nonce)},
-        {"value", json(transaction.value)},
-        {"receiver", json(transaction.receiver)},
-        {"sender", json(transaction.sender)},
-        {"gasPrice", json(transaction.gasPrice)},
-        {"gasLimit", json(transaction.gasLimit)},
-    };
+/// Writes the fields of a transaction as a JSON object, directly in the order the protocol expects.
+class PayloadWriter {
+public:
+    explicit PayloadWriter(std::size_t capacity) {
+        out.reserve(capacity);
+        out.push_back('{');
+    }
 
-    if (!transaction.senderUsername.empty()) {
-        payload["senderUsername"] = json(Base64::encode(data(transaction.senderUsername)));
+    void field(const char* name, const std::string& value) {
+        key(name);
+        appendJSONString(out, value);
     }
 
-    if (!transaction.receiverUsername.empty()) {
-        payload["receiverUsername"] = json(Base64::encode(data(transaction.receiverUsername)));
+    void field(const char* name, uint64_t value) {
+        key(name);
+        out.append(std::to_string(value));
     }
 
-    if (!transaction.data.empty()) {
-        payload["data"] = json(Base64::encode(data(transaction.data)));
+    std::string finish() {
+        out.push_back('}');
+        return std::move(out);
     }
 
-    payload["chainID"] = json(transaction.chainID);
-    payload["version"] = json(transaction.version);
+private:
+    void key(const char* name) {
+        if (out.size() > 1) {
+            out.push_back(',');
+        }
+        out.push_back('"');
+        out.append(name);
+        out.append("\":");
+    }
 
+    std::string out;
+};
+
+/// Serializes the transaction fields in order: nonce, value, receiver, sender, senderUsername, receiverUsername,
+/// gasPrice, gasLimit, data, chainID, version, signature, options, guardian. Empty optional fields are omitted.
+std::string serialize(const MultiversX::Transaction& transaction, const std::string* signature) {
+    const auto base64Size = [](const std::string& value) { return (value.size() + 2) / 3 * 4; };
+    const auto capacity = 256 + transaction.value.size() + transaction.receiver.size() + transaction.sender.size() +
+                          base64Size(transaction.senderUsername) + base64Size(transaction.receiverUsername) +
+                          base64Size(transaction.data) + transaction.chainID.size() + transaction.guardian.size() +
+                          (signature != nullptr ? signature->size() : 0);
+
+    PayloadWriter writer(capacity);
+    writer.field("nonce", transaction.nonce);
+    writer.field("value", transaction.value);
+    writer.field("receiver", transaction.receiver);
+    writer.field("sender", transaction.sender);
+    if (!transaction.senderUsername.empty()) {
+        writer.field("senderUsername", Base64::encode(data(transaction.senderUsername)));
+    }
+    if (!transaction.receiverUsername.empty()) {
+        writer.field("receiverUsername", Base64::encode(data(transaction.receiverUsername)));
+    }
+    writer.field("gasPrice", transaction.gasPrice);
+    writer.field("gasLimit", transaction.gasLimit);
+    if (!transaction.data.empty()) {
+        writer.field("data", Base64::encode(data(transaction.data)));
+    }
+    writer.field("chainID", transaction.chainID);
+    writer.field("version", transaction.version);
+    if (signature != nullptr) {
+        writer.field("signature", *signature);
+    }
     if (transaction.options != 0) {
-        payload["options"] = json(transaction.options);
+        writer.field("options", transaction.options);
     }
-
     if (!transaction.guardian.empty()) {
-        payload["guardian"] = json(transaction.guardian);
+        writer.field("guardian", transaction.guardian);
     }
-
-    return payload;
+    return writer.finish();
 }
 
+} // namespace
+
 std::string MultiversX::serializeTransaction(const MultiversX::Transaction& transaction) {
-    sorted_json payload = preparePayload(transaction);
-    return payload.dump();
+    return serialize(transaction, nullptr);
 }
 
 std::string MultiversX::serializeSignedTransaction(const MultiversX::Transaction& transaction, std::string signature) {
-    sorted_json payload = preparePayload(transaction);
-    payload["signature"] = nlohmann::json(signature);
-    return payload.dump();
+    return serialize(transaction, &signature);
 }
@@ -9,8 +9,7 @@
 #include "HexCoding.h"
 #include "Serialization.h"
 #include "TransactionFactory.h"
-
-#include <google/protobuf/util/json_util.h>
+#include "../proto/MultiversX.json.pb.h"
 
 namespace TW::MultiversX {
 
@@ -33,7 +32,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = sign(input);
     return output.encoded();
@@ -11,6 +11,10 @@
 namespace TW::MultiversX {
 
 const int TX_VERSION = 2;
+const char ARGUMENTS_SEPARATOR = '@';
+/// Hex encoded sizes of the largest (uint256) numeric argument, and of an address argument.
+const std::size_t MAX_NUMBER_ARGUMENT_SIZE = 64;
+const std::size_t ADDRESS_ARGUMENT_SIZE = 64;
 
 TransactionFactory::TransactionFactory()
     : TransactionFactory(TransactionFactoryConfig::GetDefault()) {
@@ -80,9 +84,14 @@ Transaction TransactionFactory::fromEGLDTransfer(const Proto::SigningInput& inpu
 Transaction TransactionFactory::fromESDTTransfer(const Proto::SigningInput& input) {
     auto transfer = input.esdt_transfer();
 
-    std::string encodedTokenIdentifier = Codec::encodeString(transfer.token_identifier());
-    std::string encodedAmount = Codec::encodeBigInt(transfer.amount());
-    std::string data = prepareFunctionCall("ESDTTransfer", {encodedTokenIdentifier, encodedAmount});
+    const std::string function = "ESDTTransfer";
+    std::string data;
+    data.reserve(function.size() + 2 + 2 * transfer.token_identifier().size() + MAX_NUMBER_ARGUMENT_SIZE);
+    data.append(function);
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendString(data, transfer.token_identifier());
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendBigInt(data, uint256_t(transfer.amount()));
 
     Transaction transaction;
     transaction.nonce = transfer.accounts().sender_nonce();
@@ -109,11 +118,18 @@ Transaction TransactionFactory::fromESDTTransfer(const Proto::SigningInput& inpu
 Transaction TransactionFactory::fromESDTNFTTransfer(const Proto::SigningInput& input) {
     auto transfer = input.esdtnft_transfer();
 
-    std::string encodedCollection = Codec::encodeString(transfer.token_collection());
-    std::string encodedNonce = Codec::encodeUint64(transfer.token_nonce());
-    std::string encodedQuantity = Codec::encodeBigInt(transfer.amount());
-    std::string encodedReceiver = Codec::encodeAddress(transfer.accounts().receiver());
-    std::string data = prepareFunctionCall("ESDTNFTTransfer", {encodedCollection, encodedNonce, encodedQuantity, encodedReceiver});
+    const std::string function = "ESDTNFTTransfer";
+    std::string data;
+    data.reserve(function.size() + 4 + 2 * transfer.token_collection().size() + 2 * sizeof(uint64_t) + MAX_NUMBER_ARGUMENT_SIZE + ADDRESS_ARGUMENT_SIZE);
+    data.append(function);
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendString(data, transfer.token_collection());
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendUint64(data, transfer.token_nonce());
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendBigInt(data, uint256_t(transfer.amount()));
+    data.push_back(ARGUMENTS_SEPARATOR);
+    Codec::appendAddress(data, transfer.accounts().receiver());
 
     Transaction transaction;
     transaction.nonce = transfer.accounts().sender_nonce();
@@ -169,18 +185,4 @@ TransactionOptions TransactionFactory::decideOptions(const Transaction& transact
     return options;
 }
 
-std::string TransactionFactory::prepareFunctionCall(const std::string& function, std::initializer_list<const std::string> arguments) {
-    const auto ARGUMENTS_SEPARATOR = "@";
-    std::string result;
-
-    result.append(function);
-
-    for (auto argument : arguments) {
-        result.append(ARGUMENTS_SEPARATOR);
-        result.append(argument);
-    }
-
-    return result;
-}
-
 } // namespace TW::MultiversX
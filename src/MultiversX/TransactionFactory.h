@@ -53,7 +53,6 @@ private:
     uint64_t coalesceGasPrice(uint64_t gasPrice);
     std::string coalesceChainId(std::string chainID);
     TransactionOptions decideOptions(const Transaction& transaction);
-    std::string prepareFunctionCall(const std::string& function, std::initializer_list<const std::string> arguments);
 };
 
 } // namespace TW::MultiversX
@@ -17,102 +17,127 @@ using json = nlohmann::json;
 
 static constexpr auto tokenTransferMethodName = "ft_transfer";
 
-static void writeU8(Data& data, uint8_t number) {
-    data.push_back(number);
-}
+/// Borsh writer. Without a buffer it only counts the bytes it would write, so that the exact size
+/// of a transaction is known before it is written into a single buffer by the same code.
+class BorshWriter {
+public:
+    BorshWriter() = default;
+    explicit BorshWriter(Data& data) : data(&data) {}
+
+    std::size_t size() const { return count; }
+
+    void u8(uint8_t number) {
+        if (data != nullptr) {
+            data->push_back(number);
+        }
+        ++count;
+    }
 
-static void writeU32(Data& data, uint32_t number) {
-    encode32LE(number, data);
-}
+    void u32(uint32_t number) {
+        if (data != nullptr) {
+            encode32LE(number, *data);
+        }
+        count += sizeof(uint32_t);
+    }
 
-static void writeU64(Data& data, uint64_t number) {
-    encode64LE(number, data);
-}
+    void u64(uint64_t number) {
+        if (data != nullptr) {
+            encode64LE(number, *data);
+        }
+        count += sizeof(uint64_t);
+    }
 
-static void writeU128(Data& data, const std::string& numberData) {
-    assert(numberData.size() == 16 && "U128 number should be 16 bytes long");
-    data.insert(std::end(data), std::begin(numberData), std::end(numberData));
-}
+    void u128(const std::string& numberData) {
+        assert(numberData.size() == 16 && "U128 number should be 16 bytes long");
+        raw(numberData);
+    }
 
-template <class T>
-static void writeRawBuffer(Data& data, const T& buf) {
-    data.insert(std::end(data), std::begin(buf), std::end(buf));
-}
+    template <class T>
+    void raw(const T& buf) {
+        if (data != nullptr) {
+            data->insert(std::end(*data), std::begin(buf), std::end(buf));
+        }
+        count += std::size(buf);
+    }
 
-static void writeString(Data& data, const std::string& str) {
-    writeU32(data, static_cast<uint32_t>(str.length()));
-    writeRawBuffer(data, str);
-}
+    void string(const std::string& str) {
+        u32(static_cast<uint32_t>(str.length()));
+        raw(str);
+    }
+
+private:
+    Data* data = nullptr;
+    std::size_t count = 0;
+};
 
-static void writePublicKey(Data& data, const Proto::PublicKey& publicKey) {
-    writeU8(data, static_cast<uint8_t>(publicKey.key_type()));
-    const auto& keyData = publicKey.data();
-    writeRawBuffer(data, keyData);
+static void writePublicKey(BorshWriter& writer, const Proto::PublicKey& publicKey) {
+    writer.u8(static_cast<uint8_t>(publicKey.key_type()));
+    writer.raw(publicKey.data());
 }
 
-static void writeTransfer(Data& data, const Proto::Transfer& transfer) {
-    writeU128(data, transfer.deposit());
+static void writeTransfer(BorshWriter& writer, const Proto::Transfer& transfer) {
+    writer.u128(transfer.deposit());
 }
 
-static void writeFunctionCall(Data& data, const Proto::FunctionCall& functionCall) {
-    writeString(data, functionCall.method_name());
+static void writeFunctionCall(BorshWriter& writer, const Proto::FunctionCall& functionCall) {
+    writer.string(functionCall.method_name());
 
-    writeU32(data, static_cast<uint32_t>(functionCall.args().size()));
-    writeRawBuffer(data, functionCall.args());
+    writer.u32(static_cast<uint32_t>(functionCall.args().size()));
+    writer.raw(functionCall.args());
 
-    writeU64(data, functionCall.gas());
-    writeU128(data, functionCall.deposit());
+    writer.u64(functionCall.gas());
+    writer.u128(functionCall.deposit());
 }
 
-static void writeStake(Data& data, const Proto::Stake& stake) {
-    writeU128(data, stake.stake());
-    writePublicKey(data, stake.public_key());
+static void writeStake(BorshWriter& writer, const Proto::Stake& stake) {
+    writer.u128(stake.stake());
+    writePublicKey(writer, stake.public_key());
 }
 
-static void writeFunctionCallPermission(Data& data, const Proto::FunctionCallPermission& functionCallPermission) {
+static void writeFunctionCallPermission(BorshWriter& writer, const Proto::FunctionCallPermission& functionCallPermission) {
     if (functionCallPermission.allowance().empty()) {
-        writeU8(data, 0);
+        writer.u8(0);
     } else {
-        writeU8(data, 1);
-        writeU128(data, functionCallPermission.allowance());
+        writer.u8(1);
+        writer.u128(functionCallPermission.allowance());
     }
-    writeString(data, functionCallPermission.receiver_id());
-    writeU32(data, static_cast<uint32_t>(functionCallPermission.method_names().size()));
+    writer.string(functionCallPermission.receiver_id());
+    writer.u32(static_cast<uint32_t>(functionCallPermission.method_names().size()));
     for (auto&& methodName : functionCallPermission.method_names()) {
-        writeString(data, methodName);
+        writer.string(methodName);
     }
 }
 
-static void writeAccessKey(Data& data, const Proto::AccessKey& accessKey) {
-    writeU64(data, accessKey.nonce());
+static void writeAccessKey(BorshWriter& writer, const Proto::AccessKey& accessKey) {
+    writer.u64(accessKey.nonce());
     switch (accessKey.permission_case()) {
     case Proto::AccessKey::kFunctionCall:
-        writeU8(data, 0);
-        writeFunctionCallPermission(data, accessKey.function_call());
+        writer.u8(0);
+        writeFunctionCallPermission(writer, accessKey.function_call());
         break;
     case Proto::AccessKey::kFullAccess:
-        writeU8(data, 1);
+        writer.u8(1);
         break;
     case Proto::AccessKey::PERMISSION_NOT_SET:
         break;
     }
 }
 
-static void writeAddKey(Data& data, const Proto::AddKey& addKey) {
-    writePublicKey(data, addKey.public_key());
-    writeAccessKey(data, addKey.access_key());
+static void writeAddKey(BorshWriter& writer, const Proto::AddKey& addKey) {
+    writePublicKey(writer, addKey.public_key());
+    writeAccessKey(writer, addKey.access_key());
 }
 
-static void writeDeleteKey(Data& data, const Proto::DeleteKey& deleteKey) {
-    writePublicKey(data, deleteKey.public_key());
+static void writeDeleteKey(BorshWriter& writer, const Proto::DeleteKey& deleteKey) {
+    writePublicKey(writer, deleteKey.public_key());
 }
 
-static void writeDeleteAccount(Data& data, const Proto::DeleteAccount& deleteAccount) {
-    writeString(data, deleteAccount.beneficiary_id());
+static void writeDeleteAccount(BorshWriter& writer, const Proto::DeleteAccount& deleteAccount) {
+    writer.string(deleteAccount.beneficiary_id());
 }
 
-static void writeTokenTransfer(Data& data, const Proto::TokenTransfer& tokenTransfer) {
-    writeString(data, tokenTransferMethodName);
+static void writeTokenTransfer(BorshWriter& writer, const Proto::TokenTransfer& tokenTransfer) {
+    writer.string(tokenTransferMethodName);
 
     json functionCallArgs = {
         {"amount", tokenTransfer.token_amount()},
@@ -120,14 +145,14 @@ static void writeTokenTransfer(Data& data, const Proto::TokenTransfer& tokenTran
     };
     auto functionCallArgsStr = functionCallArgs.dump();
 
-    writeU32(data, static_cast<uint32_t>(functionCallArgsStr.size()));
-    writeRawBuffer(data, functionCallArgsStr);
+    writer.u32(static_cast<uint32_t>(functionCallArgsStr.size()));
+    writer.raw(functionCallArgsStr);
 
-    writeU64(data, tokenTransfer.gas());
-    writeU128(data, tokenTransfer.deposit());
+    writer.u64(tokenTransfer.gas());
+    writer.u128(tokenTransfer.deposit());
 }
 
-static void writeAction(Data& data, const Proto::Action& action) {
+static void writeAction(BorshWriter& writer, const Proto::Action& action) {
     uint8_t actionByte = action.payload_case() - Proto::Action::kCreateAccount;
     // `TokenTransfer` action is actually a `FunctionCall`,
     // so we need to set the actionByte to the proper value.
@@ -135,58 +160,76 @@ static void writeAction(Data& data, const Proto::Action& action) {
         actionByte = Proto::Action::kFunctionCall - Proto::Action::kCreateAccount;
     }
 
-    writeU8(data, actionByte);
+    writer.u8(actionByte);
     switch (action.payload_case()) {
     case Proto::Action::kFunctionCall:
-        writeFunctionCall(data, action.function_call());
+        writeFunctionCall(writer, action.function_call());
         return;
     case Proto::Action::kTransfer:
-        writeTransfer(data, action.transfer());
+        writeTransfer(writer, action.transfer());
         return;
     case Proto::Action::kStake:
-        writeStake(data, action.stake());
+        writeStake(writer, action.stake());
         return;
     case Proto::Action::kAddKey:
-        writeAddKey(data, action.add_key());
+        writeAddKey(writer, action.add_key());
         return;
     case Proto::Action::kDeleteKey:
-        writeDeleteKey(data, action.delete_key());
+        writeDeleteKey(writer, action.delete_key());
         return;
     case Proto::Action::kDeleteAccount:
-        writeDeleteAccount(data, action.delete_account());
+        writeDeleteAccount(writer, action.delete_account());
         return;
     case Proto::Action::kTokenTransfer:
-        writeTokenTransfer(data, action.token_transfer());
+        writeTokenTransfer(writer, action.token_transfer());
         return;
     default:
         return;
     }
 }
 
-Data transactionData(const Proto::SigningInput& input) {
-    Data data;
-    writeString(data, input.signer_id());
-    auto key = PrivateKey(input.private_key());
-    auto public_key = key.getPublicKey(TWPublicKeyTypeED25519);
-    auto public_key_proto = Proto::PublicKey();
-    public_key_proto.set_data(public_key.bytes.data(), public_key.bytes.size());
-    writePublicKey(data, public_key_proto);
-    writeU64(data, input.nonce());
-    writeString(data, input.receiver_id());
-    const auto& block_hash = input.block_hash();
-    writeRawBuffer(data, block_hash);
-    writeU32(data, input.actions_size());
+static void writeTransaction(BorshWriter& writer, const Proto::SigningInput& input, const PublicKey& publicKey) {
+    writer.string(input.signer_id());
+    // signer public key, ED25519 key type
+    writer.u8(0);
+    writer.raw(publicKey.bytes);
+    writer.u64(input.nonce());
+    writer.string(input.receiver_id());
+    writer.raw(input.block_hash());
+    writer.u32(input.actions_size());
     for (const auto& action : input.actions()) {
-        writeAction(data, action);
+        writeAction(writer, action);
     }
+}
+
+Data transactionData(const Proto::SigningInput& input) {
+    auto key = PrivateKey(input.private_key());
+    return transactionData(input, key.getPublicKey(TWPublicKeyTypeED25519));
+}
+
+Data transactionData(const Proto::SigningInput& input, const PublicKey& publicKey, std::size_t extraCapacity) {
+    BorshWriter counter;
+    writeTransaction(counter, input, publicKey);
+
+    Data data;
+    data.reserve(counter.size() + extraCapacity);
+    BorshWriter writer(data);
+    writeTransaction(writer, input, publicKey);
+    assert(data.size() == counter.size());
     return data;
 }
 
+void appendSignature(Data& transactionData, const Data& signatureData) {
+    // ED25519 signature type
+    transactionData.push_back(0);
+    append(transactionData, signatureData);
+}
+
 Data signedTransactionData(const Data& transactionData, const Data& signatureData) {
     Data data;
-    writeRawBuffer(data, transactionData);
-    writeU8(data, 0);
-    writeRawBuffer(data, signatureData);
+    data.reserve(transactionData.size() + 1 + signatureData.size());
+    append(data, transactionData);
+    appendSignature(data, signatureData);
     return data;
 }
 
@@ -8,10 +8,15 @@
 
 #include "../proto/NEAR.pb.h"
 #include "Data.h"
+#include "../PublicKey.h"
 
 namespace TW::NEAR {
 
 Data transactionData(const Proto::SigningInput& input);
+/// Serializes the transaction signed by `publicKey` into a buffer of the exact size, plus `extraCapacity` reserved bytes.
+Data transactionData(const Proto::SigningInput& input, const PublicKey& publicKey, std::size_t extraCapacity = 0);
 Data signedTransactionData(const Data& transactionData, const Data& signatureData);
+/// Turns serialized transaction data into signed transaction data in place.
+void appendSignature(Data& transactionData, const Data& signatureData);
 
 } // namespace TW::NEAR
@@ -12,14 +12,17 @@
 
 namespace TW::NEAR {
 
+static constexpr std::size_t signatureSize = 64;
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto transaction = transactionData(input);
     auto key = PrivateKey(input.private_key());
+    // room for the signature type and the signature, appended once signed
+    auto transaction = transactionData(input, key.getPublicKey(TWPublicKeyTypeED25519), 1 + signatureSize);
     auto hash = Hash::sha256(transaction);
     auto signature = key.sign(hash, TWCurveED25519);
     auto output = Proto::SigningOutput();
-    auto signedTransaction = signedTransactionData(transaction, signature);
-    output.set_signed_transaction(signedTransaction.data(), signedTransaction.size());
+    appendSignature(transaction, signature);
+    output.set_signed_transaction(transaction.data(), transaction.size());
     output.set_hash(hash.data(), hash.size());
     return output;
 }
@@ -26,6 +26,8 @@ class CoinReference final: public Serializable {
 
     ~CoinReference() override = default;
 
+    using Serializable::serialize;
+
     size_t size() const override {
         return Hash::sha256Size + prevIndexSize;
     }
@@ -38,10 +40,9 @@ class CoinReference final: public Serializable {
         prevIndex = decode16LE(data.data() + initial_pos + Hash::sha256Size);
     }
 
-    Data serialize() const override {
-        auto resp = store(prevHash, prevHashSize);
-        encode16LE(prevIndex, resp);
-        return resp;
+    void serialize(Data& out) const override {
+        append(out, store(prevHash, prevHashSize));
+        encode16LE(prevIndex, out);
     }
 
     bool operator==(const CoinReference &other) const {
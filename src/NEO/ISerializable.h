@@ -15,9 +15,19 @@ namespace TW::NEO {
 class ISerializable {
 public:
     virtual ~ISerializable() = default;
+    /// Size of the serialization in bytes.
     virtual size_t size() const = 0;
-    virtual Data serialize() const = 0;
+    /// Appends the serialization to `out`.
+    virtual void serialize(Data& out) const = 0;
     virtual void deserialize(const Data& data, size_t initial_pos) = 0;
+
+    /// Returns the serialization.
+    Data serialize() const {
+        Data out;
+        out.reserve(size());
+        serialize(out);
+        return out;
+    }
 };
 
 } // namespace TW::NEO
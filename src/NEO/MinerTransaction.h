@@ -20,10 +20,10 @@ class MinerTransaction final: public Transaction {
         return initial_pos + 4;
     }
 
-    Data serializeExclusiveData() const override {
-        auto resp = Data();
-        encode32LE(nonce, resp);
-        return resp;
+    size_t exclusiveDataSize() const override { return 4; }
+
+    void serializeExclusiveData(Data& out) const override {
+        encode32LE(nonce, out);
     }
 
     bool operator==(const MinerTransaction &other) const {
@@ -12,22 +12,41 @@ namespace TW::NEO {
 
 class Serializable : public ISerializable {
   public:
+    using ISerializable::serialize;
+
     template<class T>
     static inline Data serialize(const std::vector <T> &data) {
         Data resp;
-        encodeVarInt(data.size(), resp);
-        for (auto it = data.begin(); it < data.end(); ++it) {
-            append(resp, it->serialize());
-        }
+        resp.reserve(serializedSize(data));
+        serialize(data, resp);
         return resp;
     }
 
+    /// Appends the size-prefixed serialization of the items to `out`.
+    template<class T>
+    static inline void serialize(const std::vector <T> &data, Data& out) {
+        encodeVarInt(data.size(), out);
+        for (const auto& item : data) {
+            item.serialize(out);
+        }
+    }
+
+    /// Size of the size-prefixed serialization of the items.
+    template<class T>
+    static inline size_t serializedSize(const std::vector <T> &data) {
+        size_t size = varIntSize(data.size());
+        for (const auto& item : data) {
+            size += item.size();
+        }
+        return size;
+    }
+
     template<class T>
     static inline Data serialize(const T *data, size_t size) {
         Data resp;
         encodeVarInt(uint64_t(size), resp);
         for (size_t i = 0; i < size; ++i) {
-            append(resp, data[i].serialize());
+            data[i].serialize(resp);
         }
         return resp;
     }
@@ -38,7 +57,7 @@ class Serializable : public ISerializable {
         Data resp;
         encodeVarInt(uint64_t(end - begin), resp);
         for (auto it = begin; it < end; ++it) {
-            append(resp, it->serialize());
+            it->serialize(resp);
         }
         return resp;
     }
@@ -8,6 +8,8 @@
 #include "Script.h"
 #include "../HexCoding.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace TW;
 
@@ -16,7 +18,7 @@ namespace TW::NEO {
 Signer::Signer(const PrivateKey& priKey)
     : privateKey(std::move(priKey)) {
     auto pub = privateKey.getPublicKey(TWPublicKeyTypeNIST256p1);
-    publicKey = pub.bytes;
+    publicKey = Data(pub.bytes);
     address = Address(pub);
 }
 
@@ -48,29 +50,70 @@ Data Signer::sign(const Data& data) const {
     return signature;
 }
 
+namespace {
+
+/// Sorted asset ids of the inputs and outputs, with the available and required amount of each.
+class AssetIndex {
+  public:
+    explicit AssetIndex(const Proto::SigningInput& input) {
+        ids.reserve(input.inputs_size() + input.outputs_size());
+        for (const auto& in : input.inputs()) {
+            ids.push_back(in.asset_id());
+        }
+        for (const auto& out : input.outputs()) {
+            ids.push_back(out.asset_id());
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        available.assign(ids.size(), 0);
+        required.assign(ids.size(), 0);
+        hasInput.assign(ids.size(), false);
+    }
+
+    /// Position of an asset id, or `ids.size()` if unknown.
+    size_t find(const std::string& assetId) const {
+        const auto it = std::lower_bound(ids.begin(), ids.end(), assetId);
+        return it != ids.end() && *it == assetId ? static_cast<size_t>(it - ids.begin()) : ids.size();
+    }
+
+    /// Whether some input of the asset is selected.
+    bool isAvailable(const std::string& assetId) const {
+        const auto i = find(assetId);
+        return i < ids.size() && hasInput[i];
+    }
+
+    std::vector<std::string> ids;
+    std::vector<int64_t> available;
+    std::vector<int64_t> required;
+    std::vector<bool> hasInput;
+};
+
+} // namespace
+
 Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
     Proto::TransactionPlan plan;
     try {
-        std::map<std::string, int64_t> available;
-        std::map<std::string, int64_t> required;
+        AssetIndex assets(input);
 
         for (int i = 0; i < input.outputs_size(); i++) {
-            required[input.outputs(i).asset_id()] = input.outputs(i).amount();
+            assets.required[assets.find(input.outputs(i).asset_id())] = input.outputs(i).amount();
         }
 
         for (int i = 0; i < input.inputs_size(); i++) {
-            if (available.find(input.inputs(i).asset_id()) == available.end()) {
-                available[input.inputs(i).asset_id()] = input.inputs(i).value();
+            const auto asset = assets.find(input.inputs(i).asset_id());
+            if (!assets.hasInput[asset]) {
+                assets.hasInput[asset] = true;
+                assets.available[asset] = input.inputs(i).value();
                 plan.add_inputs()->MergeFrom(input.inputs(i));
                 continue;
             }
 
             if (input.inputs(i).asset_id() != input.gas_asset_id() &&
-                required[input.inputs(i).asset_id()] < available[input.inputs(i).asset_id()]) {
+                assets.required[asset] < assets.available[asset]) {
                 continue;
             }
 
-            available[input.inputs(i).asset_id()] += input.inputs(i).value();
+            assets.available[asset] += input.inputs(i).value();
             plan.add_inputs()->MergeFrom(input.inputs(i));
         }
 
@@ -78,8 +121,8 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
         for (int i = 0; i < input.outputs_size(); i++) {
             auto* outputPlan = plan.add_outputs();
 
-            if (available.find(input.outputs(i).asset_id()) == available.end() ||
-                available[input.outputs(i).asset_id()] < input.outputs(i).amount()) {
+            const auto asset = assets.find(input.outputs(i).asset_id());
+            if (!assets.hasInput[asset] || assets.available[asset] < input.outputs(i).amount()) {
                 throw Common::Proto::SigningError(Common::Proto::Error_low_balance);
             }
 
@@ -87,7 +130,7 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
                 existGASTransfer = i;
             }
 
-            int64_t availableAmount = available[input.outputs(i).asset_id()];
+            int64_t availableAmount = assets.available[asset];
             outputPlan->set_available_amount(availableAmount);
             outputPlan->set_amount(input.outputs(i).amount());
             outputPlan->set_change(availableAmount - input.outputs(i).amount());
@@ -99,7 +142,7 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
 
         const int64_t SIGNATURE_SIZE = 103;
         int64_t transactionSize =
-            prepareUnsignedTransaction(input, plan, false).serialize().size() + SIGNATURE_SIZE;
+            prepareUnsignedTransaction(input, plan, false).size() + SIGNATURE_SIZE;
 
         const int64_t LARGE_TX_SIZE = 1024;
         const int64_t MIN_FEE_FOR_LARGE_TX = 100000;
@@ -113,12 +156,12 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
             auto* outputPlan = plan.add_outputs();
             existGASTransfer = plan.outputs_size() - 1;
 
-            if (available.find(input.gas_asset_id()) == available.end() ||
-                available[input.gas_asset_id()] < 1024) {
+            if (!assets.isAvailable(input.gas_asset_id()) ||
+                assets.available[assets.find(input.gas_asset_id())] < 1024) {
                 throw Common::Proto::SigningError(Common::Proto::Error_tx_too_big);
             }
 
-            int64_t availableAmount = available[input.gas_asset_id()];
+            int64_t availableAmount = assets.available[assets.find(input.gas_asset_id())];
             outputPlan->set_available_amount(availableAmount);
             outputPlan->set_amount(0);
             outputPlan->set_change(availableAmount);
@@ -130,7 +173,7 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& input) {
 
         if (feeNeed) {
             transactionSize =
-                prepareUnsignedTransaction(input, plan, false).serialize().size() + SIGNATURE_SIZE;
+                prepareUnsignedTransaction(input, plan, false).size() + SIGNATURE_SIZE;
             int64_t fee = 0;
             if (transactionSize >= LARGE_TX_SIZE) {
                 fee = MIN_FEE_FOR_LARGE_TX;
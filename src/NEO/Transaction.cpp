@@ -15,7 +15,15 @@ using namespace TW;
 namespace TW::NEO {
 
 size_t Transaction::size() const {
-    return serialize().size();
+    size_t size = 2 + exclusiveDataSize() + Serializable::serializedSize(attributes) +
+                  Serializable::serializedSize(inInputs) + Serializable::serializedSize(outputs);
+    if (!witnesses.empty()) {
+        size += 1;
+        for (const auto& witness : witnesses) {
+            size += witness.size();
+        }
+    }
+    return size;
 }
 
 void Transaction::deserialize(const Data& data, size_t initial_pos) {
@@ -44,22 +52,19 @@ Transaction* Transaction::deserializeFrom(const Data& data, size_t initial_pos)
     return resp;
 }
 
-Data Transaction::serialize() const {
-    Data resp;
-    resp.push_back((byte)type);
-    resp.push_back(version);
-    append(resp, serializeExclusiveData());
+void Transaction::serialize(Data& out) const {
+    out.push_back((byte)type);
+    out.push_back(version);
+    serializeExclusiveData(out);
 
-    append(resp, Serializable::serialize(attributes));
-    append(resp, Serializable::serialize(inInputs));
-    append(resp, Serializable::serialize(outputs));
+    Serializable::serialize(attributes, out);
+    Serializable::serialize(inInputs, out);
+    Serializable::serialize(outputs, out);
     if (witnesses.size()) {
-        resp.push_back((byte)witnesses.size());
+        out.push_back((byte)witnesses.size());
         for (const auto& witnesse : witnesses)
-            append(resp, witnesse.serialize());
+            witnesse.serialize(out);
     }
-
-    return resp;
 }
 
 bool Transaction::operator==(const Transaction& other) const {
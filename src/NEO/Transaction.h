@@ -27,14 +27,18 @@ public:
     std::vector<Witness> witnesses;
 
     ~Transaction() override = default;
+
+    using Serializable::serialize;
+
     size_t size() const override;
     void deserialize(const Data& data, size_t initial_pos = 0) override;
-    Data serialize() const override;
+    void serialize(Data& out) const override;
 
     bool operator==(const Transaction &other) const;
 
     virtual size_t deserializeExclusiveData([[maybe_unused]] const Data& data, size_t initial_pos) { return initial_pos; }
-    virtual Data serializeExclusiveData() const { return {}; }
+    virtual size_t exclusiveDataSize() const { return 0; }
+    virtual void serializeExclusiveData([[maybe_unused]] Data& out) const {}
 
     Data getHash() const;
     uint256_t getHashUInt256() const;
@@ -21,6 +21,8 @@ public:
 
     ~TransactionAttribute() override = default;
 
+    using Serializable::serialize;
+
     size_t size() const override {
         switch (usage) {
         case TransactionAttributeUsage::TAU_ContractHash:
@@ -76,26 +78,21 @@ public:
         }
     }
 
-    Data serialize() const override {
-        Data result;
-        result.push_back((TW::byte)usage);
+    void serialize(Data& out) const override {
+        out.push_back((TW::byte)usage);
 
         // see: https://github.com/neo-project/neo/blob/v2.12.0/neo/Network/P2P/Payloads/TransactionAttribute.cs#L49
         if (usage == TransactionAttributeUsage::TAU_DescriptionUrl ||
             usage == TransactionAttributeUsage::TAU_Description ||
             usage >= TransactionAttributeUsage::TAU_Remark) {
-            Data resp;
-            encodeVarInt((uint64_t)_data.size(), resp);
-            result.insert(result.end(), resp.begin(), resp.end());
+            encodeVarInt((uint64_t)_data.size(), out);
         }
         if (usage == TransactionAttributeUsage::TAU_ECDH02 ||
             usage == TransactionAttributeUsage::TAU_ECDH03) {
-            result.insert(result.end(), _data.begin() + 1, _data.begin() + 1 + contractHashSize);
+            out.insert(out.end(), _data.begin() + 1, _data.begin() + 1 + contractHashSize);
         } else {
-            result.insert(result.end(), _data.begin(), _data.end());
+            out.insert(out.end(), _data.begin(), _data.end());
         }
-
-        return result;
     }
 
     bool operator==(const TransactionAttribute &other) const {
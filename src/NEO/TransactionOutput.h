@@ -24,6 +24,8 @@ class TransactionOutput final: public Serializable {
 
     ~TransactionOutput() override = default;
 
+    using Serializable::serialize;
+
     size_t size() const override {
         return assetIdSize + valueSize + scriptHashSize;
     }
@@ -38,10 +40,10 @@ class TransactionOutput final: public Serializable {
         scriptHash = load(readBytes(data, scriptHashSize, initial_pos + assetIdSize + valueSize));
     }
 
-    Data serialize() const override {
-        auto resp = store(assetId, assetIdSize);
-        encode64LE(value, resp);
-        return concat(resp, store(scriptHash, scriptHashSize));
+    void serialize(Data& out) const override {
+        append(out, store(assetId, assetIdSize));
+        encode64LE(value, out);
+        append(out, store(scriptHash, scriptHashSize));
     }
 
     bool operator==(const TransactionOutput &other) const {
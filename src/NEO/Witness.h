@@ -19,8 +19,11 @@ class Witness final: public Serializable {
 
     ~Witness() override = default;
 
+    using Serializable::serialize;
+
     size_t size() const override {
-        return invocationScript.size() + verificationScript.size();
+        return varIntSize(invocationScript.size()) + invocationScript.size() +
+               varIntSize(verificationScript.size()) + verificationScript.size();
     }
 
     void deserialize(const Data& data, size_t initial_pos = 0) override {
@@ -29,8 +32,11 @@ class Witness final: public Serializable {
         verificationScript = readVarBytes(data, initial_pos + static_cast<size_t>(size));
     }
 
-    Data serialize() const override {
-        return concat(writeVarBytes(invocationScript), writeVarBytes(verificationScript));
+    void serialize(Data& out) const override {
+        encodeVarInt(invocationScript.size(), out);
+        append(out, invocationScript);
+        encodeVarInt(verificationScript.size(), out);
+        append(out, verificationScript);
     }
 
     bool operator==(const Witness &other) const {
@@ -9,10 +9,14 @@
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
+#include "../Random.h"
+#include "../algorithm/parallel.h"
+#include "../proto/Nano.json.pb.h"
 #include <nlohmann/json.hpp>
 
+#include <TrezorCrypto/blake2b.h>
+#include <limits>
 #include <boost/multiprecision/cpp_int.hpp>
-#include <google/protobuf/util/json_util.h>
 
 using namespace TW;
 
@@ -28,21 +32,19 @@ const std::array<byte, 32> kBlockHashPreamble{
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06,
 };
 
-std::array<byte, 16> store(const uint128_t& value) {
-    using boost::multiprecision::cpp_int;
-
-    Data buf;
-    buf.reserve(16);
-    export_bits(value, std::back_inserter(buf), 8);
-
-    // Zero-pad the bytes
-    while (buf.size() < 16) {
-        buf.insert(buf.begin(), 0);
+/// Writes the 8-byte little-endian representation of `value` to `out`.
+void store64LE(uint64_t value, byte* out) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<byte>(value >> (8 * i));
     }
+}
 
-    std::array<byte, 16> arr = {0};
-    std::copy_n(buf.begin(), arr.size(), arr.begin());
-    return arr;
+/// Writes the 16-byte big-endian representation of `value` to `out`.
+void store(uint128_t value, byte* out) {
+    for (int i = 15; i >= 0; --i) {
+        out[i] = static_cast<byte>(value & 0xff);
+        value >>= 8;
+    }
 }
 
 std::array<byte, 32> previousFromInput(const Proto::SigningInput& input) {
@@ -93,7 +95,6 @@ std::array<byte, 32> hashBlockData(const PublicKey& publicKey, const Proto::Sign
         throw std::invalid_argument("Invalid balance");
     }
     bool zeroBalance = balance_uint == uint128_t(0);
-    std::array<byte, 16> balance = store(balance_uint);
     if (emptyParentHash && zeroBalance) {
         throw std::invalid_argument("Invalid balance");
     }
@@ -104,18 +105,17 @@ std::array<byte, 32> hashBlockData(const PublicKey& publicKey, const Proto::Sign
         throw std::invalid_argument("Missing link block hash");
     }
 
-    auto msg = Data();
-    msg.insert(msg.end(), kBlockHashPreamble.begin(), kBlockHashPreamble.end());
-    msg.insert(msg.end(), publicKey.bytes.begin(), publicKey.bytes.end());
-    msg.insert(msg.end(), parentHash.begin(), parentHash.end());
-    msg.insert(msg.end(), repPublicKey.begin(), repPublicKey.end());
-    msg.insert(msg.end(), balance.begin(), balance.end());
-    msg.insert(msg.end(), link.begin(), link.end());
-
-    std::array<byte, 32> blockHash = {0};
-    auto digest = Hash::blake2b(msg, blockHash.size());
-    std::copy_n(digest.begin(), blockHash.size(), blockHash.begin());
+    // preamble, account, previous, representative, balance, link
+    std::array<byte, 32 * 5 + 16> msg;
+    auto it = std::copy(kBlockHashPreamble.begin(), kBlockHashPreamble.end(), msg.begin());
+    it = std::copy_n(publicKey.bytes.begin(), 32, it);
+    it = std::copy(parentHash.begin(), parentHash.end(), it);
+    it = std::copy(repPublicKey.begin(), repPublicKey.end(), it);
+    store(balance_uint, &*it);
+    std::copy(link.begin(), link.end(), it + 16);
 
+    std::array<byte, 32> blockHash;
+    Hash::blake2bInto(msg.data(), msg.size(), blockHash);
     return blockHash;
 }
 
@@ -140,7 +140,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return output.json();
@@ -155,6 +155,78 @@ std::array<byte, 64> Signer::sign() const noexcept {
     return signature;
 }
 
+std::array<byte, 32> Signer::workRoot() const noexcept {
+    const bool emptyPrevious = std::all_of(previous.begin(), previous.end(), [](auto b) { return b == 0; });
+    if (!emptyPrevious) {
+        return previous;
+    }
+    // the first block of an account is rooted at the account
+    std::array<byte, 32> root;
+    std::copy_n(publicKey.bytes.begin(), root.size(), root.begin());
+    return root;
+}
+
+uint64_t Signer::workValue(const std::array<byte, 32>& root, uint64_t work) noexcept {
+    std::array<byte, 8 + 32> msg;
+    store64LE(work, msg.data());
+    std::copy(root.begin(), root.end(), msg.begin() + 8);
+    std::array<byte, 8> digest;
+    blake2b(msg.data(), static_cast<uint32_t>(msg.size()), digest.data(), digest.size());
+    return decode64LE(digest.data());
+}
+
+bool Signer::validateWork(const std::array<byte, 32>& root, uint64_t work, uint64_t threshold) noexcept {
+    return workValue(root, work) >= threshold;
+}
+
+std::optional<uint64_t> Signer::generateWork(const std::array<byte, 32>& root, uint64_t threshold, std::size_t threads, const std::atomic<bool>* cancel) {
+    std::array<byte, 8> seed;
+    Random::fill(seed.data(), seed.size());
+    const uint64_t start = decode64LE(seed.data());
+
+    // one job per worker, each worker tries every `workers`-th nonce
+    const auto workers = parallelWorkerCount(std::numeric_limits<std::size_t>::max(), threads);
+    std::atomic<bool> found{false};
+    std::atomic<uint64_t> result{0};
+    parallelFor(workers, workers, [&](std::size_t worker) {
+        blake2b_state initial;
+        blake2b_Init(&initial, 8);
+        std::array<byte, 8 + 32> msg;
+        std::copy(root.begin(), root.end(), msg.begin() + 8);
+        std::array<byte, 8> digest;
+
+        uint64_t work = start + worker;
+        for (uint32_t attempt = 0; ; ++attempt, work += workers) {
+            // the flags are checked every few thousand attempts, not on each one
+            if (attempt % 4096 == 0 &&
+                (found.load(std::memory_order_relaxed) || (cancel != nullptr && cancel->load(std::memory_order_relaxed)))) {
+                return;
+            }
+            store64LE(work, msg.data());
+            blake2b_state state = initial;
+            blake2b_Update(&state, msg.data(), msg.size());
+            blake2b_Final(&state, digest.data(), digest.size());
+            if (decode64LE(digest.data()) >= threshold) {
+                if (!found.exchange(true)) {
+                    result = work;
+                }
+                return;
+            }
+        }
+    });
+
+    if (!found) {
+        return std::nullopt;
+    }
+    return result.load();
+}
+
+std::string Signer::workString(uint64_t work) {
+    Data bytes;
+    encode64BE(work, bytes);
+    return hex(bytes);
+}
+
 Proto::SigningOutput Signer::build() const {
     auto output = Proto::SigningOutput();
     const auto signature = sign();
@@ -11,6 +11,9 @@
 #include "../PrivateKey.h"
 #include <proto/Nano.pb.h>
 
+#include <atomic>
+#include <optional>
+
 namespace TW::Nano {
 /// Helper class that performs Ripple transaction signing.
 class Signer {
@@ -19,6 +22,27 @@ class Signer {
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
+
+    /// Minimum work value of send and change blocks; also valid for any other block.
+    static constexpr uint64_t workThresholdSend = 0xfffffff800000000;
+    /// Minimum work value of receive, open and epoch blocks.
+    static constexpr uint64_t workThresholdReceive = 0xfffffe0000000000;
+
+    /// Value of the proof-of-work `work` for a block with the given root: the 8-byte blake2b hash of work and root,
+    /// as a little-endian number.
+    static uint64_t workValue(const std::array<byte, 32>& root, uint64_t work) noexcept;
+
+    /// Whether `work` is valid proof-of-work for a block with the given root.
+    static bool validateWork(const std::array<byte, 32>& root, uint64_t work, uint64_t threshold = workThresholdSend) noexcept;
+
+    /// Searches proof-of-work for a block with the given root, from a random starting nonce, on `threads` threads
+    /// (0 for the hardware concurrency).
+    /// Returns nullopt when stopped by setting `cancel`.
+    static std::optional<uint64_t> generateWork(const std::array<byte, 32>& root, uint64_t threshold = workThresholdSend,
+                                                std::size_t threads = 0, const std::atomic<bool>* cancel = nullptr);
+
+    /// Work as set in the `work` field of the input and the json: 16 hex digits, big-endian.
+    static std::string workString(uint64_t work);
   public:
     const PrivateKey privateKey;
     const PublicKey publicKey;
@@ -32,6 +56,9 @@ class Signer {
     /// Signs the blockHash, returns signature bytes
     std::array<byte, 64> sign() const noexcept;
 
+    /// The root the proof-of-work of the block is computed over: the previous block, or the account for the first block.
+    std::array<byte, 32> workRoot() const noexcept;
+
     /// Builds signed transaction, incl. signature, and json format
     Proto::SigningOutput build() const;
 };
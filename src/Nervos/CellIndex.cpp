@@ -0,0 +1,64 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CellIndex.h"
+#include "Serialization.h"
+
+#include <algorithm>
+
+namespace TW::Nervos {
+
+namespace {
+
+Cells cellsOf(const Proto::SigningInput& signingInput) {
+    Cells cells;
+    cells.reserve(signingInput.cell_size());
+    for (auto&& cell : signingInput.cell()) {
+        cells.emplace_back(cell);
+    }
+    return cells;
+}
+
+} // namespace
+
+CellIndex::CellIndex(const Proto::SigningInput& signingInput)
+    : CellIndex(cellsOf(signingInput)) {}
+
+CellIndex::CellIndex(Cells cells)
+    : m_cells(std::move(cells)) {
+    m_amounts.reserve(m_cells.size());
+    for (size_t i = 0; i < m_cells.size(); i++) {
+        const auto& cell = m_cells[i];
+        if (cell.type.empty()) {
+            m_amounts.emplace_back(0);
+            m_byCapacity.emplace_back(i);
+            continue;
+        }
+        m_amounts.emplace_back(Serialization::decodeUint256(cell.data));
+        Data type;
+        cell.type.encode(type);
+        m_byType[type].emplace_back(i);
+    }
+
+    std::stable_sort(m_byCapacity.begin(), m_byCapacity.end(), [this](size_t lhs, size_t rhs) {
+        return m_cells[lhs].capacity < m_cells[rhs].capacity;
+    });
+    for (auto& [type, positions] : m_byType) {
+        std::stable_sort(positions.begin(), positions.end(), [this](size_t lhs, size_t rhs) {
+            return m_amounts[lhs] < m_amounts[rhs];
+        });
+    }
+}
+
+const std::vector<size_t>& CellIndex::byAmount(const Script& type) const {
+    static const std::vector<size_t> none;
+    Data encoded;
+    type.encode(encoded);
+    const auto it = m_byType.find(encoded);
+    return it != m_byType.end() ? it->second : none;
+}
+
+} // namespace TW::Nervos
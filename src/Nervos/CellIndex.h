@@ -0,0 +1,51 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Cell.h"
+#include "../uint256.h"
+#include "../proto/Nervos.pb.h"
+
+#include <map>
+#include <vector>
+
+namespace TW::Nervos {
+
+/// Live cells sorted once for cell selection, reusable across transaction plans.
+///
+/// Cells without a type script are ordered by capacity, typed cells are grouped by their type script
+/// and ordered by their SUDT amount, decoded once.
+/// Orders are stable, so equal cells keep the order they were given in.
+class CellIndex {
+public:
+    /// Indexes the given cells.
+    explicit CellIndex(Cells cells);
+
+    /// Indexes the cells of a signing input.
+    explicit CellIndex(const Proto::SigningInput& signingInput);
+
+    /// The cells, in the order they were given.
+    const Cells& cells() const noexcept { return m_cells; }
+
+    /// Positions of the cells without a type script, by increasing capacity.
+    const std::vector<size_t>& byCapacity() const noexcept { return m_byCapacity; }
+
+    /// Positions of the cells with the given type script, by increasing SUDT amount.
+    const std::vector<size_t>& byAmount(const Script& type) const;
+
+    /// SUDT amount of the cell at the given position, zero for cells without a type script.
+    const uint256_t& amount(size_t position) const { return m_amounts[position]; }
+
+private:
+    Cells m_cells;
+    std::vector<size_t> m_byCapacity;
+    /// Typed cells by the encoding of their type script.
+    std::map<Data, std::vector<size_t>> m_byType;
+    std::vector<uint256_t> m_amounts;
+};
+
+} // namespace TW::Nervos
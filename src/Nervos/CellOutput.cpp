@@ -10,13 +10,14 @@
 namespace TW::Nervos {
 
 void CellOutput::encode(Data& data) const {
-    Data capacityData;
-    Data lockData;
-    Data typeData;
-    encode64LE(capacity, capacityData);
-    lock.encode(lockData);
-    type.encode(typeData);
-    Serialization::encodeDataArray(std::vector<Data>{capacityData, lockData, typeData}, data);
+    TableWriter table(data, 3);
+    table.field();
+    encode64LE(capacity, data);
+    table.field();
+    lock.encode(data);
+    table.field();
+    type.encode(data);
+    table.finish();
 }
 
 nlohmann::json CellOutput::json() const {
@@ -25,15 +25,18 @@ Data Script::hash() const {
 }
 
 void Script::encode(Data& data) const {
-    Data hashTypeData(1);
-    Data argsData;
     if (empty()) {
         return;
     }
-    hashTypeData[0] = hashType;
-    encode32LE(uint32_t(args.size()), argsData);
-    argsData.insert(argsData.end(), args.begin(), args.end());
-    Serialization::encodeDataArray(std::vector<Data>{codeHash, hashTypeData, argsData}, data);
+    TableWriter table(data, 3);
+    table.field();
+    data.insert(data.end(), codeHash.begin(), codeHash.end());
+    table.field();
+    data.push_back(hashType);
+    table.field();
+    encode32LE(uint32_t(args.size()), data);
+    data.insert(data.end(), args.begin(), args.end());
+    table.finish();
 }
 
 nlohmann::json Script::json() const {
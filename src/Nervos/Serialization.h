@@ -16,6 +16,33 @@
 
 namespace TW::Nervos {
 
+/// Writes a molecule table (or dynvec) directly into the output: the header is reserved up front,
+/// each field is appended after `field()` and the sizes are filled in by `finish()`.
+class TableWriter {
+public:
+    TableWriter(Data& data, uint32_t fieldCount)
+        : data(data), start(data.size()) {
+        data.resize(start + 4 + 4 * size_t(fieldCount));
+    }
+
+    /// Marks the start of the next field.
+    void field() { write32LE(start + 4 + 4 * index++, data.size() - start); }
+
+    /// Writes the total size, once all the fields are appended.
+    void finish() { write32LE(start, data.size() - start); }
+
+private:
+    void write32LE(size_t offset, size_t value) {
+        for (size_t i = 0; i < 4; i++) {
+            data[offset + i] = static_cast<byte>(value >> (8 * i));
+        }
+    }
+
+    Data& data;
+    size_t start;
+    size_t index = 0;
+};
+
 struct Serialization {
     static void encodeDataArray(const std::vector<Data>& dataArray, Data& data) {
         uint32_t dataLength = std::accumulate(dataArray.begin(), dataArray.end(), uint32_t(0),
@@ -16,6 +16,13 @@ Proto::TransactionPlan Signer::plan(const Proto::SigningInput& signingInput) noe
     return txPlan.proto();
 }
 
+Proto::TransactionPlan Signer::plan(const Proto::SigningInput& signingInput,
+                                    const CellIndex& cellIndex) noexcept {
+    TransactionPlan txPlan;
+    txPlan.plan(signingInput, cellIndex);
+    return txPlan.proto();
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& signingInput) noexcept {
     Proto::SigningOutput output;
 
@@ -38,7 +45,8 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& signingInput) noexc
     for (auto&& privateKey : signingInput.private_key()) {
         privateKeys.emplace_back(privateKey);
     }
-    auto error = tx.sign(privateKeys);
+    const auto txHash = tx.hash();
+    auto error = tx.sign(privateKeys, txHash);
     if (error != Common::Proto::OK) {
         // Signing failed
         output.set_error(error);
@@ -46,7 +54,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& signingInput) noexc
     }
 
     output.set_transaction_json(tx.json().dump());
-    output.set_transaction_id(hexEncoded(tx.hash()));
+    output.set_transaction_id(hexEncoded(txHash));
     output.set_error(Common::Proto::OK);
 
     return output;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "CellIndex.h"
 #include "CoinEntry.h"
 #include "Data.h"
 #include "../proto/Nervos.pb.h"
@@ -19,6 +20,10 @@ public:
     /// Returns a transaction plan (utxo selection, fee estimation)
     static Proto::TransactionPlan plan(const Proto::SigningInput& signingInputProto) noexcept;
 
+    /// Returns a transaction plan selecting from an indexed cell set instead of the input cells
+    static Proto::TransactionPlan plan(const Proto::SigningInput& signingInputProto,
+                                       const CellIndex& cellIndex) noexcept;
+
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& signingInputProto) noexcept;
 };
@@ -10,74 +10,68 @@
 
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWHRP.h>
+#include <algorithm>
 #include <cstddef>
+#include <map>
 #include <nlohmann/json.hpp>
 
 #include <vector>
 
 namespace TW::Nervos {
 
-Data Transaction::hash() const {
-    Data data;
-    std::vector<Data> dataArray;
-    dataArray.reserve(6);
+void Transaction::encode(Data& data) const {
+    TableWriter rawTransaction(data, 6);
 
     // version
-    Data versionData;
-    encode32LE(version, versionData);
-    dataArray.emplace_back(versionData);
+    rawTransaction.field();
+    encode32LE(version, data);
 
     // cell deps
-    Data cellDepsData;
-    encode32LE(uint32_t(cellDeps.size()), cellDepsData);
+    rawTransaction.field();
+    encode32LE(uint32_t(cellDeps.size()), data);
     for (auto&& cellDep : cellDeps) {
-        cellDep.encode(cellDepsData);
+        cellDep.encode(data);
     }
-    dataArray.emplace_back(cellDepsData);
 
     // header deps
-    Data headerDepsData;
-    encode32LE(uint32_t(headerDeps.size()), headerDepsData);
+    rawTransaction.field();
+    encode32LE(uint32_t(headerDeps.size()), data);
     for (auto&& headerDep : headerDeps) {
-        headerDepsData.insert(headerDepsData.end(), headerDep.begin(), headerDep.end());
+        data.insert(data.end(), headerDep.begin(), headerDep.end());
     }
-    dataArray.emplace_back(headerDepsData);
 
     // inputs
-    Data inputsData;
-    encode32LE(uint32_t(inputs.size()), inputsData);
+    rawTransaction.field();
+    encode32LE(uint32_t(inputs.size()), data);
     for (auto&& input : inputs) {
-        input.encode(inputsData);
+        input.encode(data);
     }
-    dataArray.emplace_back(inputsData);
 
     // outputs
-    Data outputsData1;
-    std::vector<Data> outputsData1Array;
-    outputsData1Array.reserve(outputs.size());
+    rawTransaction.field();
+    TableWriter outputsVector(data, uint32_t(outputs.size()));
     for (auto&& output : outputs) {
-        Data outputData1;
-        output.encode(outputData1);
-        outputsData1Array.emplace_back(outputData1);
+        outputsVector.field();
+        output.encode(data);
     }
-    Serialization::encodeDataArray(outputsData1Array, outputsData1);
-    dataArray.emplace_back(outputsData1);
+    outputsVector.finish();
 
     // outputs data
-    Data outputsData2;
-    std::vector<Data> outputsData2Array;
-    outputsData2Array.reserve(outputsData.size());
+    rawTransaction.field();
+    TableWriter outputsDataVector(data, uint32_t(outputsData.size()));
     for (auto&& outputData : outputsData) {
-        Data outputData2;
-        encode32LE(uint32_t(outputData.size()), outputData2);
-        outputData2.insert(outputData2.end(), outputData.begin(), outputData.end());
-        outputsData2Array.emplace_back(outputData2);
+        outputsDataVector.field();
+        encode32LE(uint32_t(outputData.size()), data);
+        data.insert(data.end(), outputData.begin(), outputData.end());
     }
-    Serialization::encodeDataArray(outputsData2Array, outputsData2);
-    dataArray.emplace_back(outputsData2);
+    outputsDataVector.finish();
 
-    Serialization::encodeDataArray(dataArray, data);
+    rawTransaction.finish();
+}
 
+Data Transaction::hash() const {
+    Data data;
+    encode(data);
     return Hash::blake2b(data, 32, Constants::gHashPersonalization);
 }
 
@@ -129,53 +123,52 @@ void Transaction::build(const TransactionPlan& txPlan) {
 }
 
 Common::Proto::SigningError Transaction::sign(const std::vector<PrivateKey>& privateKeys) {
+    return sign(privateKeys, hash());
+}
+
+Common::Proto::SigningError Transaction::sign(const std::vector<PrivateKey>& privateKeys,
+                                              const Data& txHash) {
     formGroups();
-    return signGroups(privateKeys);
+    return signGroups(privateKeys, txHash);
 }
 
 void Transaction::formGroups() {
+    std::map<Data, size_t> lockHashToGroupNum;
     for (size_t index = 0; index < selectedCells.size(); index++) {
         auto&& cell = selectedCells[index];
-        auto lockHash = cell.lock.hash();
-        int groupNum = -1;
-        for (size_t groupNum1 = 0; groupNum1 < m_groupNumToLockHash.size(); groupNum1++) {
-            if (lockHash == m_groupNumToLockHash[groupNum1]) {
-                // Group found. Add to existing group.
-                groupNum = int(groupNum1);
-                break;
-            }
-        }
-        if (groupNum == -1) {
+        const auto [group, inserted] =
+            lockHashToGroupNum.emplace(cell.lock.hash(), m_groupNumToLockHash.size());
+        if (inserted) {
             // Group not found. Create new group.
-            groupNum = int(m_groupNumToLockHash.size());
-            m_groupNumToLockHash.emplace_back(lockHash);
+            m_groupNumToLockHash.emplace_back(group->first);
             m_groupNumToInputIndices.emplace_back();
             m_groupNumToWitnesses.emplace_back();
         }
-        m_groupNumToInputIndices[groupNum].emplace_back(index);
+        const auto groupNum = group->second;
+        m_groupNumToInputIndices[groupNum].emplace_back(int(index));
         m_groupNumToWitnesses[groupNum].emplace_back(Data(), cell.inputType, cell.outputType);
         serializedWitnesses.emplace_back();
     }
 }
 
-Common::Proto::SigningError Transaction::signGroups(const std::vector<PrivateKey>& privateKeys) {
-    const Data txHash = hash();
+Common::Proto::SigningError Transaction::signGroups(const std::vector<PrivateKey>& privateKeys,
+                                                    const Data& txHash) {
+    // the lock script of each key, derived once for all the groups
+    std::vector<Script> keyScripts;
+    keyScripts.reserve(privateKeys.size());
+    for (auto&& privateKey : privateKeys) {
+        keyScripts.emplace_back(Address(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1), HRP_NERVOS));
+    }
+
+    Data serializedWitness;
     for (size_t groupNum = 0; groupNum < m_groupNumToLockHash.size(); groupNum++) {
         auto&& cell = selectedCells[m_groupNumToInputIndices[groupNum][0]];
-        const PrivateKey* privateKey = nullptr;
-        for (auto&& privateKey1 : privateKeys) {
-            auto publicKey1 = privateKey1.getPublicKey(TWPublicKeyTypeSECP256k1);
-            auto address = Address(publicKey1, HRP_NERVOS);
-            auto script = Script(address);
-            if (script == cell.lock) {
-                privateKey = &privateKey1;
-                break;
-            }
-        }
-        if (!privateKey) {
+        const auto key = std::find(keyScripts.begin(), keyScripts.end(), cell.lock);
+        if (key == keyScripts.end()) {
             return Common::Proto::Error_missing_private_key;
         }
-        auto result = signWitnesses(*privateKey, txHash, m_groupNumToWitnesses[groupNum]);
+        const auto& privateKey = privateKeys[key - keyScripts.begin()];
+        auto result = signWitnesses(privateKey, txHash, m_groupNumToWitnesses[groupNum], serializedWitness);
         if (result != Common::Proto::OK) {
             return result;
         }
@@ -185,20 +178,23 @@ Common::Proto::SigningError Transaction::signGroups(const std::vector<PrivateKey
 }
 
 Common::Proto::SigningError Transaction::signWitnesses(const PrivateKey& privateKey,
-                                                       const Data& txHash, Witnesses& witnesses) {
-    Data message;
-    message.insert(message.end(), txHash.begin(), txHash.end());
+                                                       const Data& txHash, Witnesses& witnesses,
+                                                       Data& serializedWitness) {
+    auto hasher = Hash::StreamHasher::blake2b(32, Constants::gHashPersonalization);
+    hasher.update(txHash);
 
     witnesses[0].lock = Data(Constants::gBlankWitnessBytes, 0);
 
+    Data length;
     for (auto&& witness : witnesses) {
-        Data serializedWitness;
+        serializedWitness.clear();
         witness.encode(serializedWitness);
-        encode64LE(serializedWitness.size(), message);
-        message.insert(message.end(), serializedWitness.begin(), serializedWitness.end());
+        length.clear();
+        encode64LE(serializedWitness.size(), length);
+        hasher.update(length).update(serializedWitness);
     }
 
-    auto messageHash = Hash::blake2b(message, 32, Constants::gHashPersonalization);
+    auto messageHash = hasher.finalize();
     auto signature = privateKey.sign(messageHash, TWCurveSECP256k1);
     if (signature.empty()) {
         // Error: Failed to sign
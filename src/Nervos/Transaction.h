@@ -57,10 +57,14 @@ public:
 
     Transaction() = default;
 
+    /// Encodes the raw transaction (without the witnesses) into the provided buffer.
+    void encode(Data& data) const;
     Data hash() const;
     nlohmann::json json() const;
     void build(const TransactionPlan& txPlan);
     Common::Proto::SigningError sign(const std::vector<PrivateKey>& privateKeys);
+    /// Signs with the already computed transaction hash, which signing doesn't change.
+    Common::Proto::SigningError sign(const std::vector<PrivateKey>& privateKeys, const Data& txHash);
 
 private:
     std::vector<Data> m_groupNumToLockHash;
@@ -68,9 +72,10 @@ private:
     std::vector<Witnesses> m_groupNumToWitnesses;
 
     void formGroups();
-    Common::Proto::SigningError signGroups(const std::vector<PrivateKey>& privateKeys);
+    Common::Proto::SigningError signGroups(const std::vector<PrivateKey>& privateKeys,
+                                           const Data& txHash);
     Common::Proto::SigningError signWitnesses(const PrivateKey& privateKey, const Data& txHash,
-                                              Witnesses& witnesses);
+                                              Witnesses& witnesses, Data& serializedWitness);
 };
 
 } // namespace TW::Nervos
@@ -21,17 +21,20 @@ using namespace TW;
 namespace TW::Nervos {
 
 void TransactionPlan::plan(const Proto::SigningInput& signingInput) {
+    plan(signingInput, CellIndex(signingInput));
+}
+
+void TransactionPlan::plan(const Proto::SigningInput& signingInput, const CellIndex& cellIndex) {
     error = Common::Proto::OK;
 
     m_byteFee = signingInput.byte_fee();
 
-    if (signingInput.cell_size() == 0) {
+    if (cellIndex.cells().empty()) {
         error = Common::Proto::Error_missing_input_utxos;
         return;
     }
-    for (auto&& cell : signingInput.cell()) {
-        m_availableCells.emplace_back(cell);
-    }
+    m_cellIndex = &cellIndex;
+    m_usedCells.assign(cellIndex.cells().size(), false);
 
     switch (signingInput.operation_oneof_case()) {
     case Proto::SigningInput::kNativeTransfer: {
@@ -58,6 +61,7 @@ void TransactionPlan::plan(const Proto::SigningInput& signingInput) {
         error = Common::Proto::Error_invalid_params;
     }
     }
+    m_cellIndex = nullptr;
 }
 
 void TransactionPlan::planNativeTransfer(const Proto::SigningInput& signingInput) {
@@ -125,9 +129,13 @@ void TransactionPlan::planDaoWithdrawPhase1(const Proto::SigningInput& signingIn
 
     auto depositCell = Cell(signingInput.dao_withdraw_phase1().deposit_cell());
     selectedCells.emplace_back(depositCell);
-    m_availableCells.erase(std::remove_if(
-        m_availableCells.begin(), m_availableCells.end(),
-        [&depositCell](const Cell& cell) { return cell.outPoint == depositCell.outPoint; }));
+    const auto& cells = m_cellIndex->cells();
+    const auto depositPosition =
+        std::find_if(cells.begin(), cells.end(),
+                     [&depositCell](const Cell& cell) { return cell.outPoint == depositCell.outPoint; });
+    if (depositPosition != cells.end()) {
+        m_usedCells[depositPosition - cells.begin()] = true;
+    }
 
     headerDeps.emplace_back(depositCell.blockHash);
 
@@ -158,17 +166,20 @@ void TransactionPlan::planDaoWithdrawPhase2(const Proto::SigningInput& signingIn
     outputs[0].capacity -= calculateFee();
 }
 
+void TransactionPlan::selectCell(size_t position) {
+    selectedCells.emplace_back(m_cellIndex->cells()[position]);
+    m_usedCells[position] = true;
+}
+
 void TransactionPlan::selectMaximumCapacity() {
-    uint64_t selectedCapacity =
-        std::accumulate(m_availableCells.begin(), m_availableCells.end(), uint64_t(0),
-                        [&](const uint64_t total, const Cell& cell) {
-                            if (cell.type.empty()) {
-                                selectedCells.emplace_back(cell);
-                                return total + cell.capacity;
-                            } else {
-                                return total;
-                            }
-                        });
+    uint64_t selectedCapacity = 0;
+    const auto& cells = m_cellIndex->cells();
+    for (size_t position = 0; position < cells.size(); position++) {
+        if (cells[position].type.empty() && !m_usedCells[position]) {
+            selectCell(position);
+            selectedCapacity += cells[position].capacity;
+        }
+    }
     uint64_t fee = calculateFee();
     outputs[0].capacity = selectedCapacity - fee;
 }
@@ -185,13 +196,13 @@ void TransactionPlan::selectRequiredCapacity(const Address& changeAddress) {
         outputsData.emplace_back();
         return;
     }
-    sortAccordingToCapacity();
     bool gotEnough = false;
-    for (auto&& cell : m_availableCells) {
-        if (!cell.type.empty()) {
+    for (auto position : m_cellIndex->byCapacity()) {
+        if (m_usedCells[position]) {
             continue;
         }
-        selectedCells.emplace_back(cell);
+        const auto& cell = m_cellIndex->cells()[position];
+        selectCell(position);
         selectedCapacity += cell.capacity;
         fee += sizeOfSingleInputAndWitness(cell.inputType, cell.outputType) * m_byteFee;
         if (selectedCapacity >= requiredCapacity + fee) {
@@ -218,17 +229,13 @@ void TransactionPlan::selectRequiredCapacity(const Address& changeAddress) {
 void TransactionPlan::selectSudtTokens(const bool useMaxAmount, const uint256_t amount,
                                        const Address& changeAddress) {
     uint256_t selectedSudtAmount = 0;
-    sortAccordingToTypeAndData(outputs[0].type);
     bool gotEnough = false;
-    auto cell = m_availableCells.begin();
-    while (cell != m_availableCells.end()) {
-        if (cell->type != outputs[0].type) {
-            cell++;
+    for (auto position : m_cellIndex->byAmount(outputs[0].type)) {
+        if (m_usedCells[position]) {
             continue;
         }
-        selectedCells.emplace_back(*cell);
-        selectedSudtAmount += Serialization::decodeUint256(cell->data);
-        cell = m_availableCells.erase(cell);
+        selectCell(position);
+        selectedSudtAmount += m_cellIndex->amount(position);
         if (useMaxAmount) {
             // Transfer maximum available tokens
             gotEnough = true;
@@ -298,20 +305,6 @@ uint64_t TransactionPlan::calculateFee() {
     return size * m_byteFee;
 }
 
-void TransactionPlan::sortAccordingToCapacity() {
-    std::sort(m_availableCells.begin(), m_availableCells.end(),
-              [](const Cell& lhs, const Cell& rhs) { return lhs.capacity < rhs.capacity; });
-}
-
-void TransactionPlan::sortAccordingToTypeAndData(const Script& type) {
-    std::sort(
-        m_availableCells.begin(), m_availableCells.end(), [&](const Cell& lhs, const Cell& rhs) {
-            uint256_t lhsAmount = (lhs.type == type) ? Serialization::decodeUint256(lhs.data) : 0;
-            uint256_t rhsAmount = (rhs.type == type) ? Serialization::decodeUint256(rhs.data) : 0;
-            return lhsAmount < rhsAmount;
-        });
-}
-
 uint64_t TransactionPlan::getRequiredCapacity() {
     return std::accumulate(outputs.begin(), outputs.end(), uint64_t(0),
                            [](const uint64_t total, const CellOutput& cellOutput) {
@@ -8,6 +8,7 @@
 
 #include "Address.h"
 #include "Cell.h"
+#include "CellIndex.h"
 #include "CellDep.h"
 #include "CellInput.h"
 #include "CellOutput.h"
@@ -97,9 +98,13 @@ public:
 
     void plan(const Proto::SigningInput& signingInput);
 
+    /// Plans selecting from the indexed cells, the cells of the signing input are ignored.
+    void plan(const Proto::SigningInput& signingInput, const CellIndex& cellIndex);
+
 private:
     uint64_t m_byteFee;
-    Cells m_availableCells;
+    const CellIndex* m_cellIndex = nullptr;
+    std::vector<bool> m_usedCells;
 
     void planNativeTransfer(const Proto::SigningInput& signingInput);
     void planSudtTransfer(const Proto::SigningInput& signingInput);
@@ -114,8 +119,7 @@ private:
     uint64_t sizeOfSingleInputAndWitness(const Data& inputType, const Data& outputType);
     uint64_t sizeOfSingleOutput(const Address& address);
     uint64_t calculateFee();
-    void sortAccordingToCapacity();
-    void sortAccordingToTypeAndData(const Script& type);
+    void selectCell(size_t position);
     uint64_t getRequiredCapacity();
     uint64_t getSelectedCapacity();
 };
@@ -13,17 +13,15 @@ void Witness::encode(Data& data) const {
     if ((lock.empty()) && (inputType.empty()) && (outputType.empty())) {
         return;
     }
-    std::vector<Data> dataArray;
-    dataArray.reserve(3);
-    for (auto&& data1 : std::vector<Data>({lock, inputType, outputType})) {
-        Data data2;
-        if (!data1.empty()) {
-            encode32LE(uint32_t(data1.size()), data2);
-            data2.insert(data2.end(), data1.begin(), data1.end());
+    TableWriter table(data, 3);
+    for (const Data* field : {&lock, &inputType, &outputType}) {
+        table.field();
+        if (!field->empty()) {
+            encode32LE(uint32_t(field->size()), data);
+            data.insert(data.end(), field->begin(), field->end());
         }
-        dataArray.emplace_back(data2);
     }
-    Serialization::encodeDataArray(dataArray, data);
+    table.finish();
 }
 
 } // namespace TW::Nervos
@@ -14,7 +14,7 @@
 
 namespace TW::Nimiq {
 
-static const char* BASE32_ALPHABET_NIMIQ = "0123456789ABCDEFGHJKLMNPQRSTUVXY";
+static constexpr Base32::Alphabet BASE32_ALPHABET_NIMIQ{"0123456789ABCDEFGHJKLMNPQRSTUVXY"};
 
 static int check_append(int, uint8_t);
 static inline int check_add(int, int);
@@ -33,8 +33,8 @@ bool Address::isValid(const std::string& stringPadded) {
         return false;
 
     // Check if valid Base32
-    Data hash;
-    if (!Base32::decode(string.data() + 4, hash, BASE32_ALPHABET_NIMIQ)) {
+    std::array<byte, size> decoded;
+    if (!Base32::decodeArray(std::string_view(string).substr(4), decoded, BASE32_ALPHABET_NIMIQ)) {
         return false;
     }
 
@@ -70,15 +70,9 @@ Address::Address(const std::string& stringPadded) {
     string.erase(std::remove(string.begin(), string.end(), ' '), string.end());
 
     // Decode address
-    auto base32 = string.substr(4, 32);
-    Data data;
-    if (!Base32::decode(base32, data, BASE32_ALPHABET_NIMIQ)) {
+    if (!Base32::decodeArray(std::string_view(string).substr(4, 32), bytes, BASE32_ALPHABET_NIMIQ)) {
         throw std::invalid_argument("Invalid address data");
     }
-    if (data.size() != size) {
-        throw std::invalid_argument("Invalid address data");
-    }
-    std::copy(data.begin(), data.end(), bytes.data());
 }
 
 Address::Address(const std::vector<uint8_t>& data) {
@@ -101,9 +95,7 @@ std::string Address::string() const {
     int check = 0;
 
     // Calculate Base32 sum
-    Data bytesAsData;
-    bytesAsData.assign(bytes.begin(), bytes.end());
-    auto base32 = Base32::encode(bytesAsData, BASE32_ALPHABET_NIMIQ);
+    const auto base32 = Base32::encodeArray(bytes, BASE32_ALPHABET_NIMIQ);
 
     for (auto i = 0; i < 32; i += 4) {
         // Add spaces to output
@@ -61,10 +61,10 @@ Data Signer::sign(Transaction& tx) const {
     auto privateKey = PrivateKey(input.private_key());
 
     // The use of this context thing is explained here --> https://docs.oasis.dev/oasis-core/common-functionality/crypto#domain-separation
-    auto encodedMessage = tx.encodeMessage().encoded();
-    Data dataToHash(tx.context.begin(), tx.context.end());
-    dataToHash.insert(dataToHash.end(), encodedMessage.begin(), encodedMessage.end());
-    auto hash = Hash::sha512_256(dataToHash);
+    auto hash = Hash::StreamHasher(Hash::HasherSha512_256)
+                    .update(tx.context)
+                    .update(tx.encodedMessage())
+                    .finalize();
 
     auto signature = privateKey.sign(hash, TWCurveED25519);
     return Data(signature.begin(), signature.end());
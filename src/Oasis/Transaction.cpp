@@ -6,6 +6,8 @@
 
 #include "Transaction.h"
 
+#include <string_view>
+
 using namespace TW;
 
 namespace TW::Oasis {
@@ -30,36 +32,67 @@ static Data encodeVaruint(const uint256_t& value) {
     return small;
 }
 
-Cbor::Encode Transaction::encodeMessage() const {
+// Map keys of the messages.  The entries are written in the canonical CBOR order of their encoded keys
+// (shorter first, then bytewise), the same order `Cbor::Encode::map` sorts them into.
+static constexpr std::string_view keyFee = "fee";
+static constexpr std::string_view keyGas = "gas";
+static constexpr std::string_view keyAmount = "amount";
+static constexpr std::string_view keyBody = "body";
+static constexpr std::string_view keyTo = "to";
+static constexpr std::string_view keyNonce = "nonce";
+static constexpr std::string_view keyMethod = "method";
+static constexpr std::string_view keySignature = "signature";
+static constexpr std::string_view keyPublicKey = "public_key";
+static constexpr std::string_view keyUntrustedRawValue = "untrusted_raw_value";
 
-    return Cbor::Encode::map({
-        { Cbor::Encode::string("nonce"), Cbor::Encode::uint(nonce) },
-        { Cbor::Encode::string("method"), Cbor::Encode::string(method) },
-        { Cbor::Encode::string("fee"), Cbor::Encode::map({
-                 { Cbor::Encode::string("gas"), Cbor::Encode::uint(gasPrice) },
-                 { Cbor::Encode::string("amount"), Cbor::Encode::bytes(encodeVaruint(gasAmount)) }
-             })
-        },
-        { Cbor::Encode::string("body"), Cbor::Encode::map({
-                  { Cbor::Encode::string("to"), Cbor::Encode::bytes(to.getKeyHash()) },
-                  { Cbor::Encode::string("amount"), Cbor::Encode::bytes(encodeVaruint(amount)) }
-              })
-        }
-    });
+static std::size_t stringSize(std::string_view str) {
+    return Cbor::Writer::headerSize(str.size()) + str.size();
 }
 
-Data Transaction::serialize(Data& signature, PublicKey& publicKey) const {
-    auto signedMessage = Cbor::Encode::map({
-            { Cbor::Encode::string("untrusted_raw_value"), Cbor::Encode::bytes(encodeMessage().encoded()) },
-            { Cbor::Encode::string("signature"), Cbor::Encode::map({
-                   { Cbor::Encode::string("public_key"), Cbor::Encode::bytes(publicKey.bytes) },
-                   { Cbor::Encode::string("signature"), Cbor::Encode::bytes(signature) }
-                })
-            }
-        });
-    return signedMessage.encoded();
+static std::size_t bytesSize(std::span<const byte> data) {
+    return Cbor::Writer::headerSize(data.size()) + data.size();
 }
 
-// clang-format on
+Cbor::Encode Transaction::encodeMessage() const {
+    return Cbor::Encode::fromRaw(encodedMessage());
+}
+
+Data Transaction::encodedMessage() const {
+    const auto gasAmountBytes = encodeVaruint(gasAmount);
+    const auto amountBytes = encodeVaruint(amount);
+    const auto& toBytes = to.getKeyHash();
+
+    const auto feeSize = 1 + stringSize(keyGas) + Cbor::Writer::headerSize(gasPrice) + stringSize(keyAmount) + bytesSize(gasAmountBytes);
+    const auto bodySize = 1 + stringSize(keyTo) + bytesSize(toBytes) + stringSize(keyAmount) + bytesSize(amountBytes);
+    const auto size = 1 + stringSize(keyFee) + feeSize + stringSize(keyBody) + bodySize + stringSize(keyNonce) +
+                      Cbor::Writer::headerSize(nonce) + stringSize(keyMethod) + stringSize(method);
+
+    auto writer = Cbor::Writer(size);
+    writer.map(4);
+    writer.string(keyFee).map(2)
+        .string(keyGas).uint(gasPrice)
+        .string(keyAmount).bytes(gasAmountBytes);
+    writer.string(keyBody).map(2)
+        .string(keyTo).bytes(toBytes)
+        .string(keyAmount).bytes(amountBytes);
+    writer.string(keyNonce).uint(nonce);
+    writer.string(keyMethod).string(method);
+    return writer.release();
+}
+
+Data Transaction::serialize(const Data& signature, const PublicKey& publicKey) const {
+    const auto message = encodedMessage();
+
+    const auto signatureSize = 1 + stringSize(keySignature) + bytesSize(signature) + stringSize(keyPublicKey) + bytesSize(publicKey.bytes.view());
+    const auto size = 1 + stringSize(keySignature) + signatureSize + stringSize(keyUntrustedRawValue) + bytesSize(message);
+
+    auto writer = Cbor::Writer(size);
+    writer.map(2);
+    writer.string(keySignature).map(2)
+        .string(keySignature).bytes(signature)
+        .string(keyPublicKey).bytes(Data(publicKey.bytes));
+    writer.string(keyUntrustedRawValue).bytes(message);
+    return writer.release();
+}
 
 } // namespace TW::Oasis
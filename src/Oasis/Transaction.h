@@ -45,8 +45,11 @@ class Transaction {
     // message returns the CBOR encoding of the Message to be signed.
     Cbor::Encode encodeMessage() const;
 
+    // encodedMessage returns the encoded bytes of the Message to be signed, written without intermediary CBOR objects.
+    Data encodedMessage() const;
+
     // serialize returns the CBOR encoding of the SignedMessage.
-    Data serialize(Data& signature, PublicKey& publicKey) const;
+    Data serialize(const Data& signature, const PublicKey& publicKey) const;
 };
 
 } // namespace TW::Oasis
@@ -18,6 +18,12 @@
 
 namespace TW::Ontology {
 
+/// Destination and amount of one transfer of a batch payout
+struct Payout {
+    Address to;
+    uint64_t amount;
+};
+
 class Asset {
 protected:
     const uint8_t txType = 0xD1;
@@ -29,6 +29,11 @@ class Ong : public Asset {
                          const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                          uint32_t nonce) override;
 
+    /// Transfers from `from` to all `payouts` in one transaction, signed once.
+    Transaction multiTransfer(const Signer &from, const std::vector<Payout> &payouts,
+                              const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
+                              uint32_t nonce);
+
     Transaction withdraw(const Signer &claimer, const Address &receiver, uint64_t amount,
                          const Signer &payer, uint64_t gasPrice, uint64_t gasLimit, uint32_t nonce);
 };
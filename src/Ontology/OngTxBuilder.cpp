@@ -41,10 +41,25 @@ Data OngTxBuilder::withdraw(const Ontology::Proto::SigningInput& input) {
     return encoded;
 }
 
+Data OngTxBuilder::multiTransfer(const Ontology::Proto::SigningInput& input) {
+    auto payerSigner = Signer(PrivateKey(input.payer_private_key()));
+    auto fromSigner = Signer(PrivateKey(input.owner_private_key()));
+    std::vector<Payout> payouts;
+    payouts.reserve(input.payouts_size());
+    for (const auto& payout : input.payouts()) {
+        payouts.push_back({Address(payout.to_address()), payout.amount()});
+    }
+    auto transferTx = Ong().multiTransfer(fromSigner, payouts, payerSigner,
+                                           input.gas_price(), input.gas_limit(), input.nonce());
+    return transferTx.serialize();
+}
+
 Data OngTxBuilder::build(const Ontology::Proto::SigningInput& input) {
     auto method = std::string(input.method().begin(), input.method().end());
     if (method == "transfer") {
         return OngTxBuilder::transfer(input);
+    } else if (method == "multiTransfer") {
+        return OngTxBuilder::multiTransfer(input);
     } else if (method == "balanceOf") {
         return OngTxBuilder::balanceOf(input);
     } else if (method == "decimals") {
@@ -23,6 +23,8 @@ class OngTxBuilder {
 
     static Data transfer(const Ontology::Proto::SigningInput& input);
 
+    static Data multiTransfer(const Ontology::Proto::SigningInput& input);
+
     static Data withdraw(const Ontology::Proto::SigningInput& input);
 
     static Data build(const Ontology::Proto::SigningInput& input);
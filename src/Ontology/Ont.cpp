@@ -30,15 +30,29 @@ Transaction Ont::balanceOf(const Address& address, uint32_t nonce) {
     return tx;
 }
 
+static const Data& transferInvokeSuffix() {
+    static const Data suffix = ParamsBuilder::buildNativeInvokeSuffix(Ont().contractAddress(), 0x00, "transfer");
+    return suffix;
+}
+
 Transaction Ont::transfer(const Signer& from, const Address& to, uint64_t amount,
                           const Signer& payer, uint64_t gasPrice, uint64_t gasLimit,
                           uint32_t nonce) {
-    NeoVmParamValue::ParamList transferParam{from.getAddress()._data, to._data, amount};
-    NeoVmParamValue::ParamArray args{transferParam};
-    auto invokeCode =
-        ParamsBuilder::buildNativeInvokeCode(contractAddress(), 0x00, "transfer", {args});
-    auto tx = Transaction(version, txType, nonce, gasPrice, gasLimit,
-                          payer.getAddress().string(), invokeCode);
+    return multiTransfer(from, {{to, amount}}, payer, gasPrice, gasLimit, nonce);
+}
+
+Transaction Ont::multiTransfer(const Signer& from, const std::vector<Payout>& payouts,
+                               const Signer& payer, uint64_t gasPrice, uint64_t gasLimit,
+                               uint32_t nonce) {
+    const auto fromAddress = from.getAddress();
+    std::vector<NativeTransfer> transfers;
+    transfers.reserve(payouts.size());
+    for (const auto& payout : payouts) {
+        transfers.push_back({fromAddress, payout.to, payout.amount});
+    }
+    auto invokeCode = ParamsBuilder::buildNativeTransferInvokeCode(transfers, transferInvokeSuffix());
+    auto tx = Transaction(version, txType, nonce, gasPrice, gasLimit, payer.getAddress().string(),
+                          std::move(invokeCode));
     from.sign(tx);
     payer.addSign(tx);
     return tx;
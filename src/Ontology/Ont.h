@@ -28,6 +28,11 @@ class Ont : public Asset {
     Transaction transfer(const Signer &from, const Address &to, uint64_t amount,
                          const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                          uint32_t nonce) override;
+
+    /// Transfers from `from` to all `payouts` in one transaction, signed once.
+    Transaction multiTransfer(const Signer &from, const std::vector<Payout> &payouts,
+                              const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
+                              uint32_t nonce);
 };
 
 } // namespace TW::Ontology
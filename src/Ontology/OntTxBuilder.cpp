@@ -31,10 +31,25 @@ Data OntTxBuilder::transfer(const Ontology::Proto::SigningInput& input) {
     return encoded;
 }
 
+Data OntTxBuilder::multiTransfer(const Ontology::Proto::SigningInput& input) {
+    auto payerSigner = Signer(PrivateKey(input.payer_private_key()));
+    auto fromSigner = Signer(PrivateKey(input.owner_private_key()));
+    std::vector<Payout> payouts;
+    payouts.reserve(input.payouts_size());
+    for (const auto& payout : input.payouts()) {
+        payouts.push_back({Address(payout.to_address()), payout.amount()});
+    }
+    auto transferTx = Ont().multiTransfer(fromSigner, payouts, payerSigner,
+                                           input.gas_price(), input.gas_limit(), input.nonce());
+    return transferTx.serialize();
+}
+
 Data OntTxBuilder::build(const Ontology::Proto::SigningInput& input) {
     auto method = std::string(input.method().begin(), input.method().end());
     if (method == "transfer") {
         return OntTxBuilder::transfer(input);
+    } else if (method == "multiTransfer") {
+        return OntTxBuilder::multiTransfer(input);
     } else if (method == "balanceOf") {
         return OntTxBuilder::balanceOf(input);
     } else if (method == "decimals") {
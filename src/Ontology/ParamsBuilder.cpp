@@ -89,15 +89,18 @@ void ParamsBuilder::pushVar(std::size_t value) {
 }
 
 void ParamsBuilder::push(const std::string& data) {
-    push(Data(data.begin(), data.end()));
+    push(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
 void ParamsBuilder::push(const std::array<uint8_t, 20>& data) {
-    push(Data(data.begin(), data.end()));
+    push(data.data(), data.size());
 }
 
 void ParamsBuilder::push(const Data& data) {
-    auto dataSize = data.size();
+    push(data.data(), data.size());
+}
+
+void ParamsBuilder::push(const uint8_t* data, std::size_t dataSize) {
     if (dataSize < 75) {
         bytes.push_back(static_cast<uint8_t>(dataSize));
     } else if (dataSize < 256) {
@@ -110,7 +113,7 @@ void ParamsBuilder::push(const Data& data) {
         bytes.push_back(PUSH_DATA4);
         encode32LE(static_cast<uint16_t>(dataSize), bytes);
     }
-    bytes.insert(bytes.end(), data.begin(), data.end());
+    bytes.insert(bytes.end(), data, data + dataSize);
 }
 
 void ParamsBuilder::push(uint64_t num, uint8_t len) {
@@ -188,14 +191,14 @@ Data ParamsBuilder::fromSigs(const std::vector<Data>& sigs) {
     for (auto const& sig : sigs) {
         builder.push(sig);
     }
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::fromPubkey(const Data& publicKey) {
     ParamsBuilder builder;
     builder.push(publicKey);
     builder.pushBack(CHECK_SIG);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::fromMultiPubkey(uint8_t m, const std::vector<Data>& pubKeys) {
@@ -223,32 +226,73 @@ Data ParamsBuilder::fromMultiPubkey(uint8_t m, const std::vector<Data>& pubKeys)
     }
     builder.push((uint8_t)sortedPubKeys.size());
     builder.pushBack(CHECK_MULTI_SIG);
-    return builder.getBytes();
+    return builder.takeBytes();
+}
+
+void ParamsBuilder::pushNativeTransfer(const NativeTransfer& transfer) {
+    pushBack(PUSH0);
+    pushBack(NEW_STRUCT);
+    pushBack(TO_ALT_STACK);
+    for (const auto* address : {&transfer.from._data, &transfer.to._data}) {
+        push(*address);
+        pushBack(DUP_FROM_ALT_STACK);
+        pushBack(SWAP);
+        pushBack(HAS_KEY);
+    }
+    push(transfer.amount);
+    pushBack(DUP_FROM_ALT_STACK);
+    pushBack(SWAP);
+    pushBack(HAS_KEY);
+    pushBack(FROM_ALT_STACK);
 }
 
 Data ParamsBuilder::buildNativeInvokeCode(const Data& contractAddress, uint8_t version,
                                           const std::string& method, const NeoVmParamValue& params) {
     ParamsBuilder builder;
     ParamsBuilder::buildNeoVmParam(builder, params);
-    builder.push(Data(method.begin(), method.end()));
+    builder.pushBack(buildNativeInvokeSuffix(contractAddress, version, method));
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildNativeInvokeSuffix(const Data& contractAddress, uint8_t version, const std::string& method) {
+    ParamsBuilder builder;
+    builder.push(method);
     builder.push(contractAddress);
     builder.push(version);
     builder.pushBack(SYS_CALL);
-    std::string nativeInvoke = "Ontology.Native.Invoke";
-    builder.push(Data(nativeInvoke.begin(), nativeInvoke.end()));
-    return builder.getBytes();
+    builder.push(std::string("Ontology.Native.Invoke"));
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildNativeTransferInvokeCode(const std::vector<NativeTransfer>& transfers, const Data& invokeSuffix) {
+    // per transfer: 3 opcodes, 2 pushed addresses, amount (up to 9 bytes), 3 opcodes per field, 1 opcode
+    static constexpr std::size_t transferSize = 3 + 2 * 21 + 9 + 3 * 3 + 1;
+    ParamsBuilder builder;
+    builder.reserve(transfers.size() * transferSize + 4 + invokeSuffix.size());
+    for (const auto& transfer : transfers) {
+        builder.pushNativeTransfer(transfer);
+    }
+    builder.push(static_cast<uint64_t>(transfers.size()));
+    builder.pushBack(PACK);
+    builder.pushBack(invokeSuffix);
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::buildOep4InvokeCode(const Address& contractAddress, const std::string& method, const NeoVmParamValue& params) {
     ParamsBuilder builder;
     ParamsBuilder::buildNeoVmParam(builder, params);
+    builder.pushBack(buildOep4InvokeSuffix(contractAddress, method));
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildOep4InvokeSuffix(const Address& contractAddress, const std::string& method) {
+    ParamsBuilder builder;
     builder.push(method);
     builder.pushBack(APP_CALL);
     Address clone = contractAddress;
     std::reverse(std::begin(clone._data), std::end(clone._data));
     builder.pushBack(clone._data);
-
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 } // namespace TW::Ontology
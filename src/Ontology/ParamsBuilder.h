@@ -30,16 +30,33 @@ struct NeoVmParamValue {
     ParamVariant params;
 };
 
+/// State of a native contract (ONT, ONG) transfer
+struct NativeTransfer {
+    Address from;
+    Address to;
+    uint64_t amount;
+};
+
+/// Builds NeoVM code and serialized data. A builder can be reused: `cleanUp` keeps its buffer,
+/// `reserve` sizes it up front and `takeBytes` moves the result out without a copy.
 class ParamsBuilder {
 
 private:
     std::vector<uint8_t> bytes;
 
+    void push(const uint8_t* data, std::size_t size);
+
 public:
     static const size_t MAX_PK_SIZE = 16;
 
     std::vector<uint8_t> getBytes() { return bytes; }
 
+    Data takeBytes() { return std::move(bytes); }
+
+    std::size_t size() const { return bytes.size(); }
+
+    void reserve(std::size_t capacity) { bytes.reserve(capacity); }
+
     void cleanUp() { bytes.clear(); }
 
     static Data fromSigs(const std::vector<Data>& sigs);
@@ -87,11 +104,25 @@ public:
         bytes.insert(bytes.end(), data.begin(), data.end());
     }
 
+    /// Pushes the struct of a native transfer, as buildNeoVmParam does for a {from, to, amount} list.
+    void pushNativeTransfer(const NativeTransfer& transfer);
+
     static std::vector<uint8_t> buildNativeInvokeCode(const std::vector<uint8_t>& contractAddress,
                                                       uint8_t version, const std::string& method,
                                                       const NeoVmParamValue& params);
 
+    /// The method call following the arguments in a native contract invoke code; the same for all
+    /// calls of a method, so it can be encoded once.
+    static Data buildNativeInvokeSuffix(const Data& contractAddress, uint8_t version, const std::string& method);
+
+    /// Invoke code of a native `transfer` of all `transfers` at once, with the method call
+    /// pre-encoded by buildNativeInvokeSuffix.
+    static Data buildNativeTransferInvokeCode(const std::vector<NativeTransfer>& transfers, const Data& invokeSuffix);
+
     static std::vector<uint8_t> buildOep4InvokeCode(const Address& contractAddress, const std::string& method, const NeoVmParamValue& params);
+
+    /// The method call following the arguments in an OEP-4 invoke code.
+    static Data buildOep4InvokeSuffix(const Address& contractAddress, const std::string& method);
 };
 
 } // namespace TW::Ontology
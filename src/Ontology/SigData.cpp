@@ -23,9 +23,10 @@ Data SigData::serialize() {
         verifyInfo = ParamsBuilder::fromMultiPubkey(m, pubKeys);
     }
     ParamsBuilder builder;
+    builder.reserve(sigInfo.size() + verifyInfo.size() + 2 * 9);
     builder.pushVar(sigInfo);
     builder.pushVar(verifyInfo);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 } // namespace TW::Ontology
@@ -40,7 +40,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 Signer::Signer(TW::PrivateKey priKey)
     : privKey(std::move(priKey)) {
     auto pubKey = privKey.getPublicKey(TWPublicKeyTypeNIST256p1);
-    publicKey = pubKey.bytes;
+    publicKey = Data(pubKey.bytes);
     address = Address(pubKey).string();
 }
 
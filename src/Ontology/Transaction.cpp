@@ -14,8 +14,7 @@ namespace TW::Ontology {
 
 const std::string Transaction::ZERO_PAYER = "AFmseVrdL9f9oyCzZefL9tG6UbvhPbdYzM";
 
-std::vector<uint8_t> Transaction::serializeUnsigned() {
-    ParamsBuilder builder;
+void Transaction::serializeUnsigned(ParamsBuilder& builder) {
     builder.pushBack(version);
     builder.pushBack(txType);
     builder.pushBack(nonce);
@@ -26,21 +25,25 @@ std::vector<uint8_t> Transaction::serializeUnsigned() {
         builder.pushVar(payload);
     }
     builder.pushBack((uint8_t)0x00);
-    return builder.getBytes();
+}
+
+std::vector<uint8_t> Transaction::serializeUnsigned() {
+    ParamsBuilder builder;
+    builder.reserve(unsignedHeaderSize + payload.size());
+    serializeUnsigned(builder);
+    return builder.takeBytes();
 }
 
 std::vector<uint8_t> Transaction::serialize() {
-    std::vector<uint8_t> txData;
-    auto unsignedData = serializeUnsigned();
-    txData.insert(txData.end(), unsignedData.begin(), unsignedData.end());
     ParamsBuilder builder;
+    // a signature data is about 140 bytes (signature, public key and their pushes)
+    builder.reserve(unsignedHeaderSize + payload.size() + 1 + sigVec.size() * 140);
+    serializeUnsigned(builder);
     builder.pushVar(sigVec.size());
-    for (auto sig : sigVec) {
+    for (auto& sig : sigVec) {
         builder.pushBack(sig.serialize());
     }
-    auto sigData = builder.getBytes();
-    txData.insert(txData.end(), sigData.begin(), sigData.end());
-    return txData;
+    return builder.takeBytes();
 }
 
 std::vector<uint8_t> Transaction::txHash() {
@@ -50,9 +53,9 @@ std::vector<uint8_t> Transaction::txHash() {
 
 std::vector<uint8_t> Transaction::serialize(const PublicKey& pk) {
     ParamsBuilder builder;
-    builder.push(pk.bytes);
+    builder.push(Data(pk.bytes));
     builder.pushBack((uint8_t)0xAC);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 } // namespace TW::Ontology
@@ -14,6 +14,8 @@
 
 namespace TW::Ontology {
 
+class ParamsBuilder;
+
 class Transaction {
 
   private:
@@ -35,6 +37,11 @@ class Transaction {
 
     static const std::string ZERO_PAYER;
 
+    /// version, type, nonce, gas price and limit, payer, payload length (up to 9 bytes), attributes
+    static const size_t unsignedHeaderSize = 1 + 1 + 4 + 8 + 8 + 20 + 9 + 1;
+
+    void serializeUnsigned(ParamsBuilder& builder);
+
   public:
     static const size_t sigVecLimit = 16;
 
@@ -27,6 +27,13 @@ std::string Entry::deriveAddress([[maybe_unused]] TWCoinType coin, const PublicK
     return Address(publicKey).string();
 }
 
+std::vector<std::string> Entry::deriveAddresses([[maybe_unused]] TWCoinType coin, const std::vector<PublicKey>& publicKeys, [[maybe_unused]] TWDerivation derivation, const PrefixVariant& addressPrefix) const {
+    const auto* ss58Prefix = std::get_if<SS58Prefix>(&addressPrefix);
+    const auto network = ss58Prefix ? *ss58Prefix : static_cast<uint32_t>(TWSS58AddressTypePolkadot);
+    const auto networks = std::vector<uint32_t>(publicKeys.size(), network);
+    return SS58Address::encodeBatch(publicKeys, networks);
+}
+
 Data Entry::addressToData([[maybe_unused]] TWCoinType coin, const std::string& address) const {
     const auto addr = Address(address);
     return {addr.bytes.begin() + 1, addr.bytes.end()};
@@ -6,6 +6,7 @@
 
 #include "Extrinsic.h"
 #include <TrustWalletCore/TWSS58AddressType.h>
+#include <cassert>
 #include <map>
 
 namespace TW::Polkadot {
@@ -48,7 +49,7 @@ static std::map<const std::string, Data> kusamaCallIndices = {
     {utilityBatch, Data{0x18, 0x02}},
 };
 
-static Data getCallIndex(TWSS58AddressType network, const std::string& key) {
+static const Data& getCallIndex(TWSS58AddressType network, const std::string& key) {
     if (network == TWSS58AddressTypePolkadot) {
         return polkadotCallIndices[key];
     }
@@ -64,15 +65,13 @@ bool Extrinsic::encodeRawAccount(TWSS58AddressType network, uint32_t specVersion
     return true;
 }
 
-Data Extrinsic::encodeEraNonceTip() const {
-    Data data;
+void Extrinsic::encodeEraNonceTip(Data& data) const {
     // era
     append(data, era);
     // nonce
-    append(data, encodeCompact(nonce));
+    encodeCompact(nonce, data);
     // tip
-    append(data, encodeCompact(tip));
-    return data;
+    encodeCompact(tip, data);
 }
 
 Data Extrinsic::encodeCall(const Proto::SigningInput& input) {
@@ -80,36 +79,32 @@ Data Extrinsic::encodeCall(const Proto::SigningInput& input) {
     Data data;
     auto network = TWSS58AddressType(input.network());
     if (input.has_balance_call()) {
-        data = encodeBalanceCall(input.balance_call(), network, input.spec_version());
+        encodeBalanceCall(input.balance_call(), network, input.spec_version(), data);
     } else if (input.has_staking_call()) {
-        data = encodeStakingCall(input.staking_call(), network, input.spec_version());
+        encodeStakingCall(input.staking_call(), network, input.spec_version(), data);
     }
     return data;
 }
 
-Data Extrinsic::encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion) {
-    Data data;
-    auto transfer = balance.transfer();
+void Extrinsic::encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion, Data& data) {
+    const auto& transfer = balance.transfer();
     auto address = SS58Address(transfer.to_address(), network);
     auto value = load(transfer.value());
     // call index
     append(data, getCallIndex(network, balanceTransfer));
     // destination
-    append(data, encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion)));
+    encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion), data);
     // value
-    append(data, encodeCompact(value));
-    return data;
+    encodeCompact(value, data);
 }
 
-Data Extrinsic::encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network) {
-    Data data;
+void Extrinsic::encodeBatchCallHeader(size_t callCount, TWSS58AddressType network, Data& data) {
     append(data, getCallIndex(network, utilityBatch));
-    append(data, encodeVector(calls));
-    return data;
+    // number of calls, encoded calls follow
+    encodeCompact(uint64_t(callCount), data);
 }
 
-Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion) {
-    Data data;
+void Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion, Data& data) {
     switch (staking.message_oneof_case()) {
     case Proto::Staking::kBond: {
         auto address = SS58Address(staking.bond().controller(), byte(network));
@@ -118,16 +113,17 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
         // call index
         append(data, getCallIndex(network, stakingBond));
         // controller
-        append(data, encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion)));
+        encodeAccountId(address.keyBytes(), encodeRawAccount(network, specVersion), data);
         // value
-        append(data, encodeCompact(value));
+        encodeCompact(value, data);
         // reward destination
         append(data, reward);
     } break;
 
     case Proto::Staking::kBondAndNominate: {
+        encodeBatchCallHeader(2, network, data);
+
         // encode call1
-        Data call1;
         {
             auto staking1 = Proto::Staking();
             auto* bond = staking1.mutable_bond();
@@ -135,11 +131,10 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
             bond->set_value(staking.bond_and_nominate().value());
             bond->set_reward_destination(staking.bond_and_nominate().reward_destination());
             // recursive call
-            call1 = encodeStakingCall(staking1, network, specVersion);
+            encodeStakingCall(staking1, network, specVersion, data);
         }
 
         // encode call2
-        Data call2;
         {
             auto staking2 = Proto::Staking();
             auto* nominate = staking2.mutable_nominate();
@@ -147,11 +142,8 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
                 nominate->add_nominators(staking.bond_and_nominate().nominators(i));
             }
             // recursive call
-            call2 = encodeStakingCall(staking2, network, specVersion);
+            encodeStakingCall(staking2, network, specVersion, data);
         }
-
-        auto calls = std::vector<Data>{call1, call2};
-        data = encodeBatchCall(calls, network);
     } break;
 
     case Proto::Staking::kBondExtra: {
@@ -159,7 +151,7 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
         // call index
         append(data, getCallIndex(network, stakingBondExtra));
         // value
-        append(data, encodeCompact(value));
+        encodeCompact(value, data);
     } break;
 
     case Proto::Staking::kUnbond: {
@@ -167,7 +159,7 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
         // call index
         append(data, getCallIndex(network, stakingUnbond));
         // value
-        append(data, encodeCompact(value));
+        encodeCompact(value, data);
     } break;
 
     case Proto::Staking::kWithdrawUnbonded: {
@@ -180,13 +172,14 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
 
     case Proto::Staking::kNominate: {
         std::vector<SS58Address> accountIds;
+        accountIds.reserve(staking.nominate().nominators_size());
         for (auto& n : staking.nominate().nominators()) {
             accountIds.emplace_back(SS58Address(n, network));
         }
         // call index
         append(data, getCallIndex(network, stakingNominate));
         // nominators
-        append(data, encodeAccountIds(accountIds, encodeRawAccount(network, specVersion)));
+        encodeAccountIds(accountIds, encodeRawAccount(network, specVersion), data);
     } break;
 
     case Proto::Staking::kChill:
@@ -195,41 +188,50 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
         break;
 
     case Proto::Staking::kChillAndUnbond: {
+        encodeBatchCallHeader(2, network, data);
+
         // encode call1
-        Data call1;
         {
             auto staking1 = Proto::Staking();
             staking1.mutable_chill();
             // recursive call
-            call1 = encodeStakingCall(staking1, network, specVersion);
+            encodeStakingCall(staking1, network, specVersion, data);
         }
 
         // encode call2
-        Data call2;
         {
             auto staking2 = Proto::Staking();
             auto* unbond = staking2.mutable_unbond();
             unbond->set_value(staking.chill_and_unbond().value());
             // recursive call
-            call2 = encodeStakingCall(staking2, network, specVersion);
+            encodeStakingCall(staking2, network, specVersion, data);
         }
-
-        auto calls = std::vector<Data>{call1, call2};
-        data = encodeBatchCall(calls, network);
     } break;
 
     default:
         break;
     }
-    return data;
 }
 
 Data Extrinsic::encodePayload() const {
+    return encodePayload(encodeAdditionalSigned());
+}
+
+Data Extrinsic::encodePayload(const Data& additionalSigned) const {
     Data data;
+    data.reserve(call.size() + era.size() + 2 * 17 + additionalSigned.size());
     // call
     append(data, call);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    encodeEraNonceTip(data);
+    // specVersion / transactionVersion / genesis hash / block hash
+    append(data, additionalSigned);
+    return data;
+}
+
+Data Extrinsic::encodeAdditionalSigned() const {
+    Data data;
+    data.reserve(2 * sizeof(uint32_t) + genesisHash.size() + blockHash.size());
     // specVersion
     encode32LE(specVersion, data);
     // transactionVersion
@@ -242,21 +244,28 @@ Data Extrinsic::encodePayload() const {
 }
 
 Data Extrinsic::encodeSignature(const PublicKey& signer, const Data& signature) const {
+    const auto rawAccount = encodeRawAccount(network, specVersion);
+    // length of the extrinsic, known upfront, so that the length prefix is written first
+    const size_t length = 1 + (rawAccount ? 0 : 1) + signer.bytes.size() + 1 + signature.size() +
+                          era.size() + compactSize(nonce) + compactSize(CompactInteger(tip)) + call.size();
+
     Data data;
+    data.reserve(compactSize(uint64_t(length)) + length);
+    // append length
+    encodeCompact(uint64_t(length), data);
     // version header
-    append(data, Data{extrinsicFormat | signedBit});
+    append(data, byte(extrinsicFormat | signedBit));
     // signer public key
-    append(data, encodeAccountId(signer.bytes, encodeRawAccount(network, specVersion)));
+    encodeAccountId(Data(signer.bytes), rawAccount, data);
     // signature type
     append(data, sigTypeEd25519);
     // signature
     append(data, signature);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    encodeEraNonceTip(data);
     // call
     append(data, call);
-    // append length
-    encodeLengthPrefix(data);
+    assert(data.size() == compactSize(uint64_t(length)) + length);
     return data;
 }
 
@@ -53,15 +53,20 @@ class Extrinsic {
     static Data encodeCall(const Proto::SigningInput& input);
     // Payload to sign.
     Data encodePayload() const;
+    // Payload to sign, with the additional signed data (versions and hashes) already encoded.
+    Data encodePayload(const Data& additionalSigned) const;
+    // Additional signed data, shared by all extrinsics of the same account and block.
+    Data encodeAdditionalSigned() const;
     // Encode final data with signer public key and signature.
     Data encodeSignature(const PublicKey& signer, const Data& signature) const;
 
   protected:
     static bool encodeRawAccount(TWSS58AddressType network, uint32_t specVersion);
-    static Data encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion);
-    static Data encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion);
-    static Data encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network);
-    Data encodeEraNonceTip() const;
+    // Encoders below append to `data`, so nested calls are written into a single buffer
+    static void encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion, Data& data);
+    static void encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion, Data& data);
+    static void encodeBatchCallHeader(size_t callCount, TWSS58AddressType network, Data& data);
+    void encodeEraNonceTip(Data& data) const;
 };
 
 } // namespace TW::Polkadot
@@ -5,41 +5,172 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "SS58Address.h"
+#include "../Blake2b.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
 
 using namespace TW;
-using namespace std;
 
-bool SS58Address::isValid(const std::string& string, uint32_t network) {
-    const auto decoded = Base58::decode(string);
+namespace {
+
+constexpr std::string_view gChecksumPrefix = "SS58PRE";
+constexpr std::size_t gMaxNetworkSize = 2;
+constexpr std::size_t gMaxPayloadSize = gMaxNetworkSize + PublicKey::ed25519Size;
+constexpr std::size_t gMaxAddressSize = gMaxPayloadSize + SS58Address::checksumSize;
+
+/// Checksum pre-image of an address: "SS58PRE", the network byte(s) and the public key.
+/// The prefix is written once into a constant template, so an address is hashed from a stack buffer.
+class Message {
+public:
+    /// Appends `size` payload bytes, false if they don't fit.
+    bool append(const byte* data, std::size_t size) noexcept {
+        if (size > bytes.size() - length) {
+            return false;
+        }
+        std::memcpy(bytes.data() + length, data, size);
+        length += size;
+        return true;
+    }
+
+    std::span<const byte> view() const noexcept { return {bytes.data(), length}; }
+    std::span<const byte> payload() const noexcept { return view().subspan(gChecksumPrefix.size()); }
+
+private:
+    static constexpr std::array<byte, gChecksumPrefix.size() + gMaxPayloadSize> prefixed() {
+        std::array<byte, gChecksumPrefix.size() + gMaxPayloadSize> result{};
+        std::copy(gChecksumPrefix.begin(), gChecksumPrefix.end(), result.begin());
+        return result;
+    }
+
+    std::array<byte, gChecksumPrefix.size() + gMaxPayloadSize> bytes = prefixed();
+    std::size_t length = gChecksumPrefix.size();
+};
+
+const Blake2b::Context& checksumHasher() {
+    static const Blake2b::Context hasher(64);
+    return hasher;
+}
+
+/// Writes the network byte(s) to `out`, returns their count or 0 if the network is not supported.
+std::size_t encodeNetworkInto(uint32_t network, byte* out) noexcept {
+    if (network < SS58Address::networkSimpleLimit) { // 0 -- 63
+        // Simple account/address/network
+        out[0] = (byte)network;
+        return 1;
+    }
+    if (network < 0x4000) { // 64 -- 16383
+        // Full address/address/network identifier.
+        out[0] = SS58Address::networkSimpleLimit + (byte)((network & 0b0000000011111100) >> 2);
+        out[1] = (byte)((network & 0b0011111100000000) >> 8) | (byte)((byte)(network & 0b0000000000000011) << 6);
+        return 2;
+    }
+    // not supported
+    return 0;
+}
+
+bool decodeNetworkFrom(const byte* data, std::size_t size, byte& networkSize, uint32_t& network) noexcept {
+    networkSize = 0;
+    network = 0;
+    if (size >= 1 && data[0] < SS58Address::networkSimpleLimit) { // 0 -- 63
+        networkSize = 1;
+        network = (uint32_t)(data[0]);
+        return true;
+    }
+    // src https://github.com/paritytech/substrate/blob/master/primitives/core/src/crypto.rs
+    if (size >= 2 && data[0] >= SS58Address::networkSimpleLimit && data[0] < SS58Address::networkFullLimit) { // 64 -- 127
+        networkSize = 2;
+        byte lower = (byte)((data[0] & 0b00111111) << 2) | (byte)((data[1] & 0b11000000) >> 6);
+        byte upper = data[1] & 0b00111111;
+        network = ((uint32_t)upper << 8) + lower;
+        return (network >= SS58Address::networkSimpleLimit);
+    }
+    return false;
+}
+
+/// Decodes `string` into `decoded` and its payload into `message` if it has the size and network of an address on `network`.
+/// The checksum is left unchecked, at the end of `decoded`.
+bool decodeCandidate(const std::string& string, uint32_t network, Data& decoded, Message& message) {
+    decoded.clear();
+    // Read up to the first NUL, like a C string.
+    if (!Base58::appendDecoded(string.c_str(), decoded)) {
+        return false;
+    }
     byte decodedNetworkSize = 0;
     uint32_t decodedNetwork = 0;
-    if (!decodeNetwork(decoded, decodedNetworkSize, decodedNetwork)) {
+    if (!decodeNetworkFrom(decoded.data(), decoded.size(), decodedNetworkSize, decodedNetwork)) {
         return false;
     }
     // check size
-    if ((decodedNetworkSize + PublicKey::ed25519Size + checksumSize) != decoded.size()) {
+    if ((decodedNetworkSize + PublicKey::ed25519Size + SS58Address::checksumSize) != decoded.size()) {
         return false;
     }
     // compare network
     if (decodedNetwork != network) {
         return false;
     }
-    auto checksum = computeChecksum(Data(decoded.begin(), decoded.end() - checksumSize));
-    // compare checksum
-    if (!std::equal(decoded.end() - checksumSize, decoded.end(), checksum.begin())) {
+    return message.append(decoded.data(), decoded.size() - SS58Address::checksumSize);
+}
+
+/// Checksum digests of the messages, hashed as a batch, `checksumHasher().hashSize()` bytes each.
+Data hashMessages(std::span<const Message> messages) {
+    const auto& hasher = checksumHasher();
+    std::vector<std::span<const byte>> views;
+    views.reserve(messages.size());
+    for (const auto& message : messages) {
+        views.push_back(message.view());
+    }
+    Data digests(messages.size() * hasher.hashSize());
+    hasher.hashBatch(views, digests.data());
+    return digests;
+}
+
+/// Base 58 strings of the message payloads followed by their checksums.
+std::vector<std::string> encodeMessages(std::span<const Message> messages) {
+    const auto digests = hashMessages(messages);
+    const auto digestSize = checksumHasher().hashSize();
+    std::vector<std::string> strings(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        const auto payload = messages[i].payload();
+        std::array<byte, gMaxAddressSize> address;
+        std::copy(payload.begin(), payload.end(), address.begin());
+        std::copy_n(digests.data() + i * digestSize, SS58Address::checksumSize, address.begin() + payload.size());
+        Base58::appendEncoded(address.data(), payload.size() + SS58Address::checksumSize, strings[i]);
+    }
+    return strings;
+}
+
+} // namespace
+
+bool SS58Address::isValid(const std::string& string, uint32_t network) {
+    Data decoded;
+    Message message;
+    if (!decodeCandidate(string, network, decoded, message)) {
         return false;
     }
-    return true;
+    std::array<byte, 64> hash;
+    checksumHasher().hash(message.view().data(), message.view().size(), hash.data());
+    // compare checksum
+    return std::equal(decoded.end() - checksumSize, decoded.end(), hash.begin());
 }
 
 template <typename T>
 Data SS58Address::computeChecksum(const T& data) {
-    auto prefix = Data(gSS58Prefix.begin(), gSS58Prefix.end());
-    append(prefix, Data(data.begin(), data.end()));
-    auto hash = Hash::blake2b(prefix, 64);
-    auto checksum = Data(checksumSize);
-    std::copy(hash.begin(), hash.begin() + checksumSize, checksum.data());
-    return checksum;
+    const auto& hasher = checksumHasher();
+    Message message;
+    if (!message.append(reinterpret_cast<const byte*>(data.data()), data.size())) {
+        // longer than any address, hashed from the heap
+        auto prefixed = Data(gSS58Prefix.begin(), gSS58Prefix.end());
+        append(prefixed, Data(data.begin(), data.end()));
+        const auto hash = hasher.hash(prefixed);
+        return Data(hash.begin(), hash.begin() + checksumSize);
+    }
+    std::array<byte, 64> hash;
+    hasher.hash(message.view().data(), message.view().size(), hash.data());
+    return Data(hash.begin(), hash.begin() + checksumSize);
 }
 
 /// Initializes an address with a string representation.
@@ -71,6 +202,70 @@ std::string SS58Address::string() const {
     return Base58::encode(result);
 }
 
+std::vector<std::string> SS58Address::strings(std::span<const SS58Address> addresses) {
+    std::vector<Message> messages(addresses.size());
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+        if (!messages[i].append(addresses[i].bytes.data(), addresses[i].bytes.size())) {
+            // not an address of this library, encoded alone
+            std::vector<std::string> result;
+            result.reserve(addresses.size());
+            for (const auto& address : addresses) {
+                result.push_back(address.string());
+            }
+            return result;
+        }
+    }
+    return encodeMessages(messages);
+}
+
+std::vector<std::string> SS58Address::encodeBatch(std::span<const PublicKey> publicKeys, std::span<const uint32_t> networks) {
+    if (publicKeys.size() != networks.size()) {
+        throw std::invalid_argument("SS58Address expects a network for each public key.");
+    }
+    std::vector<Message> messages(publicKeys.size());
+    for (std::size_t i = 0; i < publicKeys.size(); ++i) {
+        if (publicKeys[i].type != TWPublicKeyTypeED25519) {
+            throw std::invalid_argument("SS58Address expects an ed25519 public key.");
+        }
+        std::array<byte, gMaxNetworkSize> network;
+        const auto networkSize = encodeNetworkInto(networks[i], network.data());
+        if (networkSize == 0) {
+            throw std::invalid_argument(std::string("network out of range ") + std::to_string(networks[i]));
+        }
+        messages[i].append(network.data(), networkSize);
+        messages[i].append(publicKeys[i].bytes.data(), publicKeys[i].bytes.size());
+    }
+    return encodeMessages(messages);
+}
+
+std::vector<bool> SS58Address::validateBatch(std::span<const std::string> strings, std::span<const uint32_t> networks) {
+    if (strings.size() != networks.size()) {
+        throw std::invalid_argument("SS58Address expects a network for each string.");
+    }
+    std::vector<bool> result(strings.size());
+    // candidates that decode to an address on their network, and their checksums
+    std::vector<std::size_t> indices;
+    std::vector<Message> messages;
+    Data checksums;
+    Data decoded;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        Message message;
+        if (decodeCandidate(strings[i], networks[i], decoded, message)) {
+            indices.push_back(i);
+            messages.push_back(message);
+            checksums.insert(checksums.end(), decoded.end() - checksumSize, decoded.end());
+        }
+    }
+
+    const auto digests = hashMessages(messages);
+    const auto digestSize = checksumHasher().hashSize();
+    for (std::size_t j = 0; j < indices.size(); ++j) {
+        const auto* digest = digests.data() + j * digestSize;
+        result[indices[j]] = std::equal(digest, digest + checksumSize, checksums.begin() + j * checksumSize);
+    }
+    return result;
+}
+
 /// Returns public key bytes
 Data SS58Address::keyBytes() const {
     byte networkSize;
@@ -81,37 +276,15 @@ Data SS58Address::keyBytes() const {
 
 // Return true and the network size (1 or 2) and network if input is valid
 bool SS58Address::decodeNetwork(const Data& data, byte& networkSize, uint32_t& network) {
-    networkSize = 0;
-    network = 0;
-    if (data.size() >= 1 && data[0] < networkSimpleLimit) { // 0 -- 63
-        networkSize = 1;
-        network = (uint32_t)(data[0]);
-        return true;
-    }
-    // src https://github.com/paritytech/substrate/blob/master/primitives/core/src/crypto.rs
-    if (data.size() >= 2 && data[0] >= networkSimpleLimit && data[0] < networkFullLimit) { // 64 -- 127
-        networkSize = 2;
-        byte lower = (byte)((data[0] & 0b00111111) << 2) | (byte)((data[1] & 0b11000000) >> 6);
-        byte upper = data[1] & 0b00111111;
-        network = ((uint32_t)upper << 8) + lower;
-        return (network >= networkSimpleLimit);
-    }
-    return false;
+    return decodeNetworkFrom(data.data(), data.size(), networkSize, network);
 }
 
 bool SS58Address::encodeNetwork(uint32_t network, Data& data) {
-    if (network < networkSimpleLimit) { // 0 -- 63
-        // Simple account/address/network
-        data = {(byte)network};
-        return true;
-    }
-    if (network < 0x4000) { // 64 -- 16383
-        // Full address/address/network identifier.
-        byte first = networkSimpleLimit + (byte)((network & 0b0000000011111100) >> 2);
-        byte second = (byte)((network & 0b0011111100000000) >> 8) | (byte)((byte)(network & 0b0000000000000011) << 6);
-        data = {first, second};
-        return true;
+    std::array<byte, gMaxNetworkSize> bytes;
+    const auto size = encodeNetworkInto(network, bytes.data());
+    if (size == 0) {
+        return false;
     }
-    // not supported
-    return false;
+    data.assign(bytes.begin(), bytes.begin() + size);
+    return true;
 }
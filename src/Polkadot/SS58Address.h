@@ -10,7 +10,9 @@
 #include "Data.h"
 #include "PublicKey.h"
 
+#include <span>
 #include <string>
+#include <vector>
 
 inline const std::string gSS58Prefix{"SS58PRE"};
 
@@ -48,6 +50,17 @@ class SS58Address {
     /// Returns a string representation of the address.
     std::string string() const;
 
+    /// Returns the string representations of addresses, hashing their checksums as a batch.
+    static std::vector<std::string> strings(std::span<const SS58Address> addresses);
+
+    /// Returns the addresses of the pairs `(publicKeys[i], networks[i])`, hashing their checksums as a batch.
+    /// \throws std::invalid_argument if the spans differ in size, a key is not ed25519 or a network is out of range.
+    static std::vector<std::string> encodeBatch(std::span<const PublicKey> publicKeys, std::span<const uint32_t> networks);
+
+    /// Determines whether each `strings[i]` is a valid address on `networks[i]`, hashing their checksums as a batch.
+    /// \throws std::invalid_argument if the spans differ in size.
+    static std::vector<bool> validateBatch(std::span<const std::string> strings, std::span<const uint32_t> networks);
+
     /// Returns public key bytes
     Data keyBytes() const;
 
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <algorithm>
 #include <bitset>
+#include <limits>
 
 
 /// Reference https://github.com/soramitsu/kagome/blob/master/core/scale/scale_encoder_stream.cpp
@@ -25,6 +26,15 @@ static constexpr size_t kMinUint16 = (1ul << 6u);
 static constexpr size_t kMinUint32 = (1ul << 14u);
 static constexpr size_t kMinBigInteger = (1ul << 30u);
 
+inline size_t countBytes(uint64_t value) {
+    size_t size = 1;
+    while (value > 0xff) {
+        ++size;
+        value >>= 8;
+    }
+    return size;
+}
+
 inline size_t countBytes(CompactInteger value) {
     if (0 == value) {
         return 1;
@@ -39,33 +49,66 @@ inline size_t countBytes(CompactInteger value) {
     return size;
 }
 
-inline Data encodeCompact(CompactInteger value) {
-    auto data = Data{};
+/// Size of the compact encoding of `value` (0 if too big to encode)
+inline size_t compactSize(uint64_t value) {
+    if (value < kMinUint16) {
+        return 1;
+    } else if (value < kMinUint32) {
+        return 2;
+    } else if (value < kMinBigInteger) {
+        return 4;
+    }
+    return 1 + countBytes(value);
+}
 
+inline size_t compactSize(const CompactInteger& value) {
+    if (value < kMinBigInteger) {
+        return compactSize(value.convert_to<uint64_t>());
+    }
+    auto length = countBytes(value);
+    return length > 67 ? 0 : 1 + length;
+}
+
+/// Appends the compact encoding of `value` to `data`.
+/// Values that fit into 64 bits take this path, without multiprecision arithmetic.
+inline void encodeCompact(uint64_t value, Data& data) {
     if (value < kMinUint16) {
-        auto v = value.convert_to<uint8_t>() << 2u;
-        data.push_back(static_cast<uint8_t>(v));
-        return data;
+        data.push_back(static_cast<uint8_t>(value << 2u));
+        return;
     } else if (value < kMinUint32) {
-        auto v = (value.convert_to<uint16_t>() << 2u);
+        auto v = static_cast<uint16_t>(value << 2u);
         v += 0x01; // set 0b01 flag
-        auto minor_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(minor_byte);
-        v >>= 8u;
-        auto major_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(major_byte);
-        return data;
+        data.push_back(static_cast<uint8_t>(v & 0xffu));
+        data.push_back(static_cast<uint8_t>(v >> 8u));
+        return;
     } else if (value < kMinBigInteger) {
-        uint32_t v = (value.convert_to<uint32_t>() << 2u);
+        auto v = static_cast<uint32_t>(value << 2u);
         v += 0x02; // set 0b10 flag
         encode32LE(v, data);
-        return data;
+        return;
+    }
+
+    auto length = countBytes(value);
+    uint8_t header = (static_cast<uint8_t>(length) - 4) * 4;
+    header += 0x03; // set 0b11 flag;
+    data.push_back(header);
+    for (size_t i = 0; i < length; ++i) {
+        data.push_back(static_cast<uint8_t>(value & 0xff)); // push back least significant byte
+        value >>= 8;
+    }
+}
+
+/// Appends the compact encoding of `value` to `data`; nothing is appended if it is too big
+inline void encodeCompact(const CompactInteger& value, Data& data) {
+    if (value <= std::numeric_limits<uint64_t>::max()) {
+        encodeCompact(value.convert_to<uint64_t>(), data);
+        return;
     }
 
     auto length = countBytes(value);
     if (length > 67) {
         // too big
-        return data;
+        return;
     }
     uint8_t header = (static_cast<uint8_t>(length) - 4) * 4;
     header += 0x03; // set 0b11 flag;
@@ -76,6 +119,17 @@ inline Data encodeCompact(CompactInteger value) {
         data.push_back(static_cast<uint8_t>(v & 0xff)); // push back least significant byte
         v >>= 8;
     }
+}
+
+inline Data encodeCompact(uint64_t value) {
+    auto data = Data{};
+    encodeCompact(value, data);
+    return data;
+}
+
+inline Data encodeCompact(const CompactInteger& value) {
+    auto data = Data{};
+    encodeCompact(value, data);
     return data;
 }
 
@@ -90,31 +144,51 @@ inline Data encodeBool(bool value) {
     return Data{uint8_t(value ? 0x01 : 0x00)};
 }
 
-inline Data encodeVector(const std::vector<Data>& vec) {
-    auto data = encodeCompact(vec.size());
-    for (auto v : vec) {
+/// Appends the encoding of `vec` (length prefix and elements) to `data`, with a single reservation
+inline void encodeVector(const std::vector<Data>& vec, Data& data) {
+    size_t size = compactSize(uint64_t(vec.size()));
+    for (const auto& v : vec) {
+        size += v.size();
+    }
+    data.reserve(data.size() + size);
+    encodeCompact(uint64_t(vec.size()), data);
+    for (const auto& v : vec) {
         append(data, v);
     }
-    return data;
 }
 
-inline Data encodeAccountId(const Data& bytes, bool raw) {
+inline Data encodeVector(const std::vector<Data>& vec) {
     auto data = Data{};
+    encodeVector(vec, data);
+    return data;
+}
+
+inline void encodeAccountId(const Data& bytes, bool raw, Data& data) {
     if (!raw) {
         // MultiAddress::AccountId
         // https://github.com/paritytech/substrate/blob/master/primitives/runtime/src/multiaddress.rs#L28
         append(data, 0x00);
     }
     append(data, bytes);
+}
+
+inline Data encodeAccountId(const Data& bytes, bool raw) {
+    auto data = Data{};
+    encodeAccountId(bytes, raw, data);
     return data;
 }
 
-inline Data encodeAccountIds(const std::vector<SS58Address>& addresses, bool raw) {
-    std::vector<Data> vec;
-    for (auto addr : addresses) {
-        vec.push_back(encodeAccountId(addr.keyBytes(), raw));
+inline void encodeAccountIds(const std::vector<SS58Address>& addresses, bool raw, Data& data) {
+    encodeCompact(uint64_t(addresses.size()), data);
+    for (const auto& addr : addresses) {
+        encodeAccountId(addr.keyBytes(), raw, data);
     }
-    return encodeVector(vec);
+}
+
+inline Data encodeAccountIds(const std::vector<SS58Address>& addresses, bool raw) {
+    auto data = Data{};
+    encodeAccountIds(addresses, raw, data);
+    return data;
 }
 
 inline Data encodeEra(const uint64_t block, const uint64_t period) {
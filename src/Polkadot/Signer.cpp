@@ -13,12 +13,9 @@ namespace TW::Polkadot {
 
 static constexpr size_t hashTreshold = 256;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
-    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-    auto extrinsic = Extrinsic(input);
-    auto payload = extrinsic.encodePayload();
-    // check if need to hash
+static Proto::SigningOutput signExtrinsic(const Extrinsic& extrinsic, const Data& additionalSigned, const PrivateKey& privateKey, const PublicKey& publicKey) {
+    auto payload = extrinsic.encodePayload(additionalSigned);
+    // only payloads longer than the threshold are signed by their hash
     if (payload.size() > hashTreshold) {
         payload = Hash::blake2b(payload, 32);
     }
@@ -30,4 +27,27 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     return protoOutput;
 }
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
+    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    auto extrinsic = Extrinsic(input);
+    return signExtrinsic(extrinsic, extrinsic.encodeAdditionalSigned(), privateKey, publicKey);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const Proto::SigningInput& input, const std::vector<BatchCall>& calls) {
+    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    auto extrinsic = Extrinsic(input);
+    const auto additionalSigned = extrinsic.encodeAdditionalSigned();
+
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(calls.size());
+    for (const auto& batchCall : calls) {
+        extrinsic.call = batchCall.call;
+        extrinsic.nonce = batchCall.nonce;
+        outputs.emplace_back(signExtrinsic(extrinsic, additionalSigned, privateKey, publicKey));
+    }
+    return outputs;
+}
+
 } // namespace TW::Polkadot
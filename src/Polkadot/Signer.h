@@ -10,8 +10,17 @@
 #include "../PrivateKey.h"
 #include "../proto/Polkadot.pb.h"
 
+#include <vector>
+
 namespace TW::Polkadot {
 
+/// A call signed as part of a batch, see Signer::signBatch.
+struct BatchCall {
+    /// Encoded call, as produced by Extrinsic::encodeCall
+    Data call;
+    uint64_t nonce;
+};
+
 /// Helper class that performs Polkadot transaction signing.
 class Signer {
 public:
@@ -20,6 +29,10 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs several calls from the same account. Key, era, tip, versions and hashes are taken from
+    /// `input` and encoded once; call and nonce of `input` are replaced by those of each entry.
+    static std::vector<Proto::SigningOutput> signBatch(const Proto::SigningInput& input, const std::vector<BatchCall>& calls);
 };
 
 } // namespace TW::Polkadot
@@ -6,12 +6,16 @@
 
 #include "PrivateKey.h"
 
+#include "AsnParser.h"
+#include "CryptoBackend.h"
 #include "HexCoding.h"
 #include "PublicKey.h"
+#include "algorithm/parallel.h"
 
 #include <TrezorCrypto/bignum.h>
 #include <TrezorCrypto/curves.h>
 #include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/ed25519.h>
 #include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
 #include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/nist256p1.h>
@@ -21,18 +25,21 @@
 #include <TrezorCrypto/zilliqa.h>
 #include <ImmutableX/StarkKey.h>
 
+#include <array>
 #include <iterator>
 
 using namespace TW;
 
-bool PrivateKey::isValid(const Data& data) {
+namespace {
+
+bool isValidKeyData(const byte* data, size_t size) {
     // Check length
-    if (data.size() != _size && data.size() != cardanoKeySize) {
+    if (size != PrivateKey::_size && size != PrivateKey::cardanoKeySize) {
         return false;
     }
 
     // Check for zero address
-    for (size_t i = 0; i < _size; ++i) {
+    for (size_t i = 0; i < PrivateKey::_size; ++i) {
         if (data[i] != 0) {
             return true;
         }
@@ -41,6 +48,12 @@ bool PrivateKey::isValid(const Data& data) {
     return false;
 }
 
+} // namespace
+
+bool PrivateKey::isValid(const Data& data) {
+    return isValidKeyData(data.data(), data.size());
+}
+
 bool PrivateKey::isValid(const Data& data, TWCurve curve) {
     // check size
     bool valid = isValid(data);
@@ -93,6 +106,13 @@ PrivateKey::PrivateKey(const Data& data) {
     bytes = data;
 }
 
+PrivateKey::PrivateKey(const byte* data, std::size_t size) {
+    if (!isValidKeyData(data, size)) {
+        throw std::invalid_argument("Invalid private key data");
+    }
+    bytes.assign(data, size);
+}
+
 PrivateKey::PrivateKey(
     const Data& key1, const Data& extension1, const Data& chainCode1,
     const Data& key2, const Data& extension2, const Data& chainCode2) {
@@ -100,40 +120,42 @@ PrivateKey::PrivateKey(
         key2.size() != _size || extension2.size() != _size || chainCode2.size() != _size) {
         throw std::invalid_argument("Invalid private key or extended key data");
     }
-    bytes = key1;
-    append(bytes, extension1);
-    append(bytes, chainCode1);
-    append(bytes, key2);
-    append(bytes, extension2);
-    append(bytes, chainCode2);
+    std::array<byte, cardanoKeySize> buffer;
+    auto it = buffer.begin();
+    for (const auto* part : {&key1, &extension1, &chainCode1, &key2, &extension2, &chainCode2}) {
+        it = std::copy(part->begin(), part->end(), it);
+    }
+    bytes.assign(buffer.data(), buffer.size());
+    memzero(buffer.data(), buffer.size());
 }
 
 PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
+    const auto& backend = CryptoBackend::current();
     Data result;
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
         result.resize(PublicKey::secp256k1Size);
-        ecdsa_get_public_key33(&secp256k1, key().data(), result.data());
+        backend.ecdsaGetPublicKey(TWCurveSECP256k1, key().data(), true, result.data());
         break;
     case TWPublicKeyTypeSECP256k1Extended:
         result.resize(PublicKey::secp256k1ExtendedSize);
-        ecdsa_get_public_key65(&secp256k1, key().data(), result.data());
+        backend.ecdsaGetPublicKey(TWCurveSECP256k1, key().data(), false, result.data());
         break;
     case TWPublicKeyTypeNIST256p1:
         result.resize(PublicKey::secp256k1Size);
-        ecdsa_get_public_key33(&nist256p1, key().data(), result.data());
+        backend.ecdsaGetPublicKey(TWCurveNIST256p1, key().data(), true, result.data());
         break;
     case TWPublicKeyTypeNIST256p1Extended:
         result.resize(PublicKey::secp256k1ExtendedSize);
-        ecdsa_get_public_key65(&nist256p1, key().data(), result.data());
+        backend.ecdsaGetPublicKey(TWCurveNIST256p1, key().data(), false, result.data());
         break;
     case TWPublicKeyTypeED25519:
         result.resize(PublicKey::ed25519Size);
-        ed25519_publickey(key().data(), result.data());
+        backend.eddsaGetPublicKey(TWCurveED25519, key().data(), result.data());
         break;
     case TWPublicKeyTypeED25519Blake2b:
         result.resize(PublicKey::ed25519Size);
-        ed25519_publickey_blake2b(key().data(), result.data());
+        backend.eddsaGetPublicKey(TWCurveED25519Blake2bNano, key().data(), result.data());
         break;
     case TWPublicKeyTypeED25519Cardano: {
         // must be double extended key
@@ -142,16 +164,17 @@ PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
         }
         Data pubKey(PublicKey::ed25519Size);
 
+        result.reserve(PublicKey::cardanoKeySize);
         // first key
-        ed25519_publickey_ext(key().data(), pubKey.data());
+        backend.eddsaGetPublicKey(TWCurveED25519ExtendedCardano, key().data(), pubKey.data());
         append(result, pubKey);
         // copy chainCode
-        append(result, chainCode());
+        result.insert(result.end(), chainCode().begin(), chainCode().end());
 
         // second key
-        ed25519_publickey_ext(secondKey().data(), pubKey.data());
+        backend.eddsaGetPublicKey(TWCurveED25519ExtendedCardano, secondKey().data(), pubKey.data());
         append(result, pubKey);
-        append(result, secondChainCode());
+        result.insert(result.end(), secondChainCode().begin(), secondChainCode().end());
     } break;
 
     case TWPublicKeyTypeCURVE25519: {
@@ -162,7 +185,7 @@ PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
     }
 
     case TWPublicKeyTypeStarkex: {
-        result = ImmutableX::getPublicKeyFromPrivateKey(this->bytes);
+        result = ImmutableX::getPublicKeyFromPrivateKey(Data(this->bytes));
         if (result.size() == PublicKey::starkexSize - 1) {
             result.insert(result.begin(), 0);
         }
@@ -172,6 +195,135 @@ PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
     return PublicKey(result, type);
 }
 
+namespace {
+
+/// Number of keys handed to a worker at a time by `PrivateKey::getPublicKeys`.
+constexpr std::size_t publicKeyChunkSize = 64;
+
+constexpr int wideWindowBits = 8;
+
+/// Generator table with 8-bit windows for secp256k1 or nist256p1, built on first use.
+const curve_point* wideBaseTable(const ecdsa_curve* curve) {
+    auto build = [curve] {
+        std::vector<curve_point> table(ecdsa_base_table_size(wideWindowBits));
+        ecdsa_base_table_fill(curve, wideWindowBits, table.data());
+        return table;
+    };
+    if (curve == &secp256k1) {
+        static const auto table = build();
+        return table.data();
+    }
+    assert(curve == &nist256p1);
+    static const auto table = build();
+    return table.data();
+}
+
+} // namespace
+
+std::vector<PublicKey> PrivateKey::getPublicKeys(std::span<const PrivateKey> privateKeys, TWPublicKeyType type, std::size_t threads, unsigned windowBits) {
+    if (windowBits != 4 && windowBits != wideWindowBits) {
+        throw std::invalid_argument("Unsupported window size");
+    }
+
+    auto deriveEach = [&] {
+        std::vector<PublicKey> publicKeys;
+        publicKeys.reserve(privateKeys.size());
+        for (const auto& privateKey : privateKeys) {
+            publicKeys.push_back(privateKey.getPublicKey(type));
+        }
+        return publicKeys;
+    };
+    // The batch functions are trezor-crypto's; other backends derive key by key.
+    if (!CryptoBackend::isDefault()) {
+        return deriveEach();
+    }
+
+    const ecdsa_curve* curve = nullptr;
+    switch (type) {
+    case TWPublicKeyTypeSECP256k1:
+    case TWPublicKeyTypeSECP256k1Extended:
+        curve = &secp256k1;
+        break;
+    case TWPublicKeyTypeNIST256p1:
+    case TWPublicKeyTypeNIST256p1Extended:
+        curve = &nist256p1;
+        break;
+    case TWPublicKeyTypeED25519:
+    case TWPublicKeyTypeED25519Cardano:
+        break;
+    default:
+        return deriveEach();
+    }
+
+    // A Cardano key holds two ed25519 keys.
+    const std::size_t perKey = type == TWPublicKeyTypeED25519Cardano ? 2 : 1;
+    const auto count = privateKeys.size() * perKey;
+    const auto derivedSize = curve != nullptr ? PublicKey::secp256k1ExtendedSize : PublicKey::ed25519Size;
+    Data secrets(count * _size);
+    Data derived(count * derivedSize);
+    for (std::size_t i = 0; i < privateKeys.size(); ++i) {
+        const auto& privateKey = privateKeys[i];
+        auto* secret = secrets.data() + i * perKey * _size;
+        std::copy(privateKey.key().begin(), privateKey.key().end(), secret);
+        if (perKey == 2) {
+            if (privateKey.bytes.size() != cardanoKeySize) {
+                memzero(secrets.data(), secrets.size());
+                throw std::invalid_argument("Invalid extended key");
+            }
+            std::copy(privateKey.secondKey().begin(), privateKey.secondKey().end(), secret + _size);
+        }
+    }
+
+    const auto* table = curve != nullptr && windowBits == wideWindowBits ? wideBaseTable(curve) : nullptr;
+    const auto chunks = (count + publicKeyChunkSize - 1) / publicKeyChunkSize;
+    parallelFor(chunks, threads, [&](std::size_t chunk) {
+        const auto begin = chunk * publicKeyChunkSize;
+        const auto size = std::min(publicKeyChunkSize, count - begin);
+        const auto* secret = secrets.data() + begin * _size;
+        auto* out = derived.data() + begin * derivedSize;
+        if (curve != nullptr) {
+            // Invalid keys are left zeroed and rejected below, like in getPublicKey.
+            std::array<int, publicKeyChunkSize> results;
+            ecdsa_get_public_keys65(curve, table, static_cast<int>(windowBits), secret, out, results.data(), size);
+        } else if (type == TWPublicKeyTypeED25519) {
+            ed25519_publickey_batch(reinterpret_cast<const ed25519_secret_key*>(secret), reinterpret_cast<ed25519_public_key*>(out), size);
+        } else {
+            ed25519_publickey_ext_batch(reinterpret_cast<const ed25519_secret_key*>(secret), reinterpret_cast<ed25519_public_key*>(out), size);
+        }
+    });
+    memzero(secrets.data(), secrets.size());
+
+    std::vector<PublicKey> publicKeys;
+    publicKeys.reserve(privateKeys.size());
+    for (std::size_t i = 0; i < privateKeys.size(); ++i) {
+        const auto* key = derived.data() + i * perKey * derivedSize;
+        Data result;
+        switch (type) {
+        case TWPublicKeyTypeSECP256k1:
+        case TWPublicKeyTypeNIST256p1:
+            result.resize(PublicKey::secp256k1Size);
+            if (key[0] == 0x04) {
+                result[0] = 0x02 | (key[64] & 0x01);
+                std::copy(key + 1, key + PublicKey::secp256k1Size, result.begin() + 1);
+            }
+            break;
+        case TWPublicKeyTypeED25519Cardano: {
+            const auto& privateKey = privateKeys[i];
+            result.reserve(PublicKey::cardanoKeySize);
+            result.insert(result.end(), key, key + derivedSize);
+            result.insert(result.end(), privateKey.chainCode().begin(), privateKey.chainCode().end());
+            result.insert(result.end(), key + derivedSize, key + 2 * derivedSize);
+            result.insert(result.end(), privateKey.secondChainCode().begin(), privateKey.secondChainCode().end());
+        } break;
+        default:
+            result.assign(key, key + derivedSize);
+            break;
+        }
+        publicKeys.emplace_back(result, type);
+    }
+    return publicKeys;
+}
+
 Data PrivateKey::getSharedKey(const PublicKey& pubKey, TWCurve curve) const {
     if (curve != TWCurveSECP256k1) {
         return {};
@@ -190,12 +342,12 @@ Data PrivateKey::getSharedKey(const PublicKey& pubKey, TWCurve curve) const {
     return {};
 }
 
-int ecdsa_sign_digest_checked(const ecdsa_curve* curve, const uint8_t* priv_key, const uint8_t* digest, size_t digest_size, uint8_t* sig, uint8_t* pby, int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
+int ecdsa_sign_digest_checked(TWCurve curve, const uint8_t* priv_key, const uint8_t* digest, size_t digest_size, uint8_t* sig, uint8_t* pby, int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
     if (digest_size < 32) {
         return -1;
     }
     assert(digest_size >= 32);
-    return ecdsa_sign_digest(curve, priv_key, digest, sig, pby, is_canonical);
+    return CryptoBackend::current().ecdsaSign(curve, priv_key, digest, sig, pby, is_canonical) ? 0 : 1;
 }
 
 Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
@@ -204,38 +356,34 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
     switch (curve) {
     case TWCurveSECP256k1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&secp256k1, key().data(), digest.data(), digest.size(), result.data(), result.data() + 64, nullptr) == 0;
+        success = ecdsa_sign_digest_checked(TWCurveSECP256k1, key().data(), digest.data(), digest.size(), result.data(), result.data() + 64, nullptr) == 0;
     } break;
     case TWCurveED25519: {
         result.resize(64);
-        ed25519_sign(digest.data(), digest.size(), key().data(), result.data());
-        success = true;
+        success = CryptoBackend::current().eddsaSign(curve, key().data(), nullptr, digest.data(), digest.size(), result.data());
     } break;
     case TWCurveED25519Blake2bNano: {
         result.resize(64);
-        ed25519_sign_blake2b(digest.data(), digest.size(), key().data(), result.data());
-        success = true;
+        success = CryptoBackend::current().eddsaSign(curve, key().data(), nullptr, digest.data(), digest.size(), result.data());
     } break;
     case TWCurveED25519ExtendedCardano: {
         result.resize(64);
-        ed25519_sign_ext(digest.data(), digest.size(), key().data(), extension().data(), result.data());
-        success = true;
+        success = CryptoBackend::current().eddsaSign(curve, key().data(), extension().data(), digest.data(), digest.size(), result.data());
     } break;
     case TWCurveCurve25519: {
         result.resize(64);
         const auto publicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_sign(digest.data(), digest.size(), key().data(), result.data());
+        success = CryptoBackend::current().eddsaSign(TWCurveED25519, key().data(), nullptr, digest.data(), digest.size(), result.data());
         const auto sign_bit = publicKey.bytes[31] & 0x80;
         result[63] = result[63] & 127;
         result[63] |= sign_bit;
-        success = true;
     } break;
     case TWCurveNIST256p1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&nist256p1, key().data(), digest.data(), digest.size(), result.data(), result.data() + 64, nullptr) == 0;
+        success = ecdsa_sign_digest_checked(TWCurveNIST256p1, key().data(), digest.data(), digest.size(), result.data(), result.data() + 64, nullptr) == 0;
     } break;
     case TWCurveStarkex: {
-        result = ImmutableX::sign(this->bytes, digest);
+        result = ImmutableX::sign(Data(this->bytes), digest);
         success = true;
         break;
     }
@@ -256,7 +404,7 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int (*canonicalChecker)
     switch (curve) {
     case TWCurveSECP256k1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&secp256k1, key().data(), digest.data(), digest.size(), result.data() + 1, result.data(), canonicalChecker) == 0;
+        success = ecdsa_sign_digest_checked(TWCurveSECP256k1, key().data(), digest.data(), digest.size(), result.data() + 1, result.data(), canonicalChecker) == 0;
     } break;
     case TWCurveED25519:                // not supported
     case TWCurveED25519Blake2bNano:     // not supported
@@ -265,7 +413,7 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int (*canonicalChecker)
         break;
     case TWCurveNIST256p1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&nist256p1, key().data(), digest.data(), digest.size(), result.data() + 1, result.data(), canonicalChecker) == 0;
+        success = ecdsa_sign_digest_checked(TWCurveNIST256p1, key().data(), digest.data(), digest.size(), result.data() + 1, result.data(), canonicalChecker) == 0;
     } break;
     case TWCurveNone:
     default:
@@ -282,18 +430,14 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int (*canonicalChecker)
 }
 
 Data PrivateKey::signAsDER(const Data& digest) const {
-    Data sig(64);
-    bool success =
-        ecdsa_sign_digest(&secp256k1, key().data(), digest.data(), sig.data(), nullptr, nullptr) == 0;
+    ASN::AsnParser::EcdsaSignature sig;
+    bool success = CryptoBackend::current().ecdsaSign(TWCurveSECP256k1, key().data(), digest.data(), sig.data(), nullptr, nullptr);
     if (!success) {
         return {};
     }
 
-    Data resultBytes(72);
-    size_t size = ecdsa_sig_to_der(sig.data(), resultBytes.data());
-
-    auto result = Data{};
-    std::copy(resultBytes.begin(), resultBytes.begin() + size, std::back_inserter(result));
+    Data result(ASN::AsnParser::maxDerSignatureSize);
+    result.resize(ASN::AsnParser::ecdsa_signature_to_der(sig.data(), result.data()));
     return result;
 }
 
@@ -307,6 +451,17 @@ Data PrivateKey::signZilliqa(const Data& message) const {
     return sig;
 }
 
+Data PrivateKey::signZilliqa(const Data& message, const PublicKey& publicKey) const {
+    assert(publicKey.type == TWPublicKeyTypeSECP256k1);
+    Data sig(64);
+    bool success = zil_schnorr_sign_with_public_key(&secp256k1, key().data(), publicKey.bytes.data(), message.data(), static_cast<uint32_t>(message.size()), sig.data()) == 0;
+
+    if (!success) {
+        return {};
+    }
+    return sig;
+}
+
 void PrivateKey::cleanup() {
-    std::fill(bytes.begin(), bytes.end(), 0);
+    bytes.wipe();
 }
@@ -7,11 +7,16 @@
 #pragma once
 
 #include "Data.h"
+#include "InlineData.h"
 #include "PublicKey.h"
+#include "memory/secure_allocator.h"
 
 #include <TrustWalletCore/TWPrivateKeyType.h>
 #include <TrustWalletCore/TWCurve.h>
 
+#include <span>
+#include <vector>
+
 namespace TW {
 
 class PrivateKey {
@@ -24,15 +29,16 @@ class PrivateKey {
     /// The private key bytes:
     /// - common case: 'size' bytes
     /// - double extended case: 'cardanoKeySize' bytes, key+extension+chainCode+second+secondExtension+secondChainCode
-    Data bytes;
+    /// Stored in a locked block of `SecureArena`, wiped when released.
+    InlineData<cardanoKeySize, SecureStorage<cardanoKeySize>> bytes;
 
-    /// Optional members for extended keys and second extended keys
-    Data key() const { return subData(bytes, 0, 32); }
-    Data extension() const { return subData(bytes, 32, 32); }
-    Data chainCode() const { return subData(bytes, 2*32, 32); }
-    Data secondKey() const { return subData(bytes, 3*32, 32); }
-    Data secondExtension() const { return subData(bytes, 4*32, 32); }
-    Data secondChainCode() const { return subData(bytes, 5*32, 32); }
+    /// Optional members for extended keys and second extended keys; views into `bytes`, empty if not present
+    std::span<const byte> key() const { return bytes.view(0, 32); }
+    std::span<const byte> extension() const { return bytes.view(32, 32); }
+    std::span<const byte> chainCode() const { return bytes.view(2*32, 32); }
+    std::span<const byte> secondKey() const { return bytes.view(3*32, 32); }
+    std::span<const byte> secondExtension() const { return bytes.view(4*32, 32); }
+    std::span<const byte> secondChainCode() const { return bytes.view(5*32, 32); }
 
     /// Determines if a collection of bytes makes a valid private key.
     static bool isValid(const Data& data);
@@ -49,6 +55,9 @@ class PrivateKey {
     /// Initializes a private key from a string of bytes.
     explicit PrivateKey(const std::string& data) : PrivateKey(TW::data(data)) {}
 
+    /// Initializes a private key from a byte buffer, without an intermediate `Data`.  Size must be exact, as above.
+    PrivateKey(const byte* data, std::size_t size);
+
     /// Initializes a Cardano style key
     explicit PrivateKey(
         const Data& bytes1, const Data& extension1, const Data& chainCode1,
@@ -65,6 +74,17 @@ class PrivateKey {
     /// Returns the public key for this private key.
     PublicKey getPublicKey(enum TWPublicKeyType type) const;
 
+    /// Returns the public keys of many private keys at once, e.g. for bulk address derivation.
+    /// Groups of keys share their final field inversion and are spread over `threads` workers,
+    /// 0 uses the hardware concurrency. Types other than secp256k1, nist256p1, ed25519 and
+    /// Cardano fall back to `getPublicKey`.
+    /// \param windowBits width of the generator table windows for secp256k1 and nist256p1:
+    /// 4 uses the built-in tables, 8 builds a table of about 300 KB per curve on first use,
+    /// which halves the point additions.
+    /// \throws std::invalid_argument for an unsupported window width or an invalid key
+    static std::vector<PublicKey> getPublicKeys(std::span<const PrivateKey> privateKeys, enum TWPublicKeyType type,
+                                                std::size_t threads = 0, unsigned windowBits = 4);
+
     /// Computes an EC Diffie-Hellman secret in constant time
     /// Supported curves: secp256k1
     Data getSharedKey(const PublicKey& publicKey, TWCurve curve) const;
@@ -83,6 +103,9 @@ class PrivateKey {
     /// Signs a digest using given ECDSA curve, returns Zilliqa schnorr signature
     Data signZilliqa(const Data& message) const;
 
+    /// Same as signZilliqa(message), with the compressed secp256k1 public key of this key precomputed by the caller
+    Data signZilliqa(const Data& message, const PublicKey& publicKey) const;
+
     /// Cleanup contents (fill with 0s), called before destruction
     void cleanup();
 };
@@ -0,0 +1,420 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ProtoJson.h"
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+namespace TW::ProtoJson {
+
+namespace {
+
+/// Value of a base64 character of the standard or the URL-safe alphabet, -1 if it is not one.
+int base64Value(char c) noexcept {
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+' || c == '-') {
+        return 62;
+    }
+    if (c == '/' || c == '_') {
+        return 63;
+    }
+    return -1;
+}
+
+int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void appendUtf8(uint32_t codePoint, std::string& out) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    } else {
+        out.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+    }
+}
+
+/// Length of the valid UTF-8 sequence starting at `text[0]` (a non-ASCII byte), 0 if invalid.
+std::size_t utf8SequenceLength(std::string_view text) noexcept {
+    const auto lead = static_cast<uint8_t>(text[0]);
+    std::size_t length = 0;
+    uint32_t codePoint = 0;
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+        codePoint = lead & 0x1f;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        codePoint = lead & 0x0f;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        codePoint = lead & 0x07;
+    } else {
+        return 0;
+    }
+    if (text.size() < length) {
+        return 0;
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        const auto next = static_cast<uint8_t>(text[i]);
+        if ((next & 0xc0) != 0x80) {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (next & 0x3f);
+    }
+    // overlong encodings, surrogates and code points above U+10FFFF
+    const auto overlong = (length == 3 && codePoint < 0x800) || (length == 4 && codePoint < 0x10000);
+    if (overlong || (codePoint >= 0xd800 && codePoint <= 0xdfff) || codePoint > 0x10ffff) {
+        return 0;
+    }
+    return length;
+}
+
+} // namespace
+
+void Reader::skipWhitespace() noexcept {
+    while (position < json.size()) {
+        const auto c = json[position];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            break;
+        }
+        ++position;
+    }
+}
+
+bool Reader::consume(char c) noexcept {
+    skipWhitespace();
+    if (peek() != c) {
+        return false;
+    }
+    ++position;
+    return true;
+}
+
+bool Reader::consumeLiteral(std::string_view literal) noexcept {
+    skipWhitespace();
+    if (json.substr(position, literal.size()) != literal) {
+        return false;
+    }
+    position += literal.size();
+    return true;
+}
+
+bool Reader::beginObject() {
+    if (failed || hasItems.size() >= maxDepth || !consume('{')) {
+        return fail();
+    }
+    hasItems.push_back(false);
+    return true;
+}
+
+bool Reader::beginArray() {
+    if (failed || hasItems.size() >= maxDepth || !consume('[')) {
+        return fail();
+    }
+    hasItems.push_back(false);
+    return true;
+}
+
+bool Reader::nextItem(char close) {
+    if (failed || hasItems.empty()) {
+        return fail();
+    }
+    if (consume(close)) {
+        hasItems.pop_back();
+        return false;
+    }
+    if (hasItems.back() && !consume(',')) {
+        return fail();
+    }
+    hasItems.back() = true;
+    return true;
+}
+
+bool Reader::nextKey(std::string_view& key) {
+    if (!nextItem('}')) {
+        return false;
+    }
+    if (!consume('"')) {
+        return fail();
+    }
+    // keys are field names, usually without escapes
+    const auto start = position;
+    const auto end = json.find_first_of("\"\\", start);
+    if (end == std::string_view::npos) {
+        return fail();
+    }
+    if (json[end] == '"') {
+        key = json.substr(start, end - start);
+        position = end + 1;
+    } else {
+        keyBuffer.clear();
+        if (!readStringContent(keyBuffer)) {
+            return false;
+        }
+        key = keyBuffer;
+    }
+    return consume(':') || fail();
+}
+
+bool Reader::nextElement() {
+    return nextItem(']');
+}
+
+bool Reader::readNull() {
+    return !failed && consumeLiteral("null");
+}
+
+bool Reader::readStringContent(std::string& out) {
+    while (position < json.size()) {
+        const auto c = json[position];
+        if (c == '"') {
+            ++position;
+            return true;
+        }
+        if (static_cast<uint8_t>(c) < 0x20) {
+            return fail();
+        }
+        if (static_cast<uint8_t>(c) >= 0x80) {
+            const auto length = utf8SequenceLength(json.substr(position));
+            if (length == 0) {
+                return fail();
+            }
+            out.append(json.substr(position, length));
+            position += length;
+            continue;
+        }
+        if (c != '\\') {
+            out.push_back(c);
+            ++position;
+            continue;
+        }
+
+        if (++position >= json.size()) {
+            return fail();
+        }
+        const auto escaped = json[position++];
+        switch (escaped) {
+        case '"': out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/': out.push_back('/'); break;
+        case 'b': out.push_back('\b'); break;
+        case 'f': out.push_back('\f'); break;
+        case 'n': out.push_back('\n'); break;
+        case 'r': out.push_back('\r'); break;
+        case 't': out.push_back('\t'); break;
+        case 'u': {
+            const auto readUnit = [this](uint32_t& unit) {
+                if (json.size() - position < 4) {
+                    return false;
+                }
+                unit = 0;
+                for (auto i = 0; i < 4; ++i) {
+                    const auto digit = hexValue(json[position++]);
+                    if (digit < 0) {
+                        return false;
+                    }
+                    unit = (unit << 4) | static_cast<uint32_t>(digit);
+                }
+                return true;
+            };
+            uint32_t codePoint = 0;
+            if (!readUnit(codePoint) || (codePoint >= 0xdc00 && codePoint <= 0xdfff)) {
+                return fail();
+            }
+            if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+                // surrogate pair
+                uint32_t low = 0;
+                if (!consumeLiteral("\\u") || !readUnit(low) || low < 0xdc00 || low > 0xdfff) {
+                    return fail();
+                }
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+            }
+            appendUtf8(codePoint, out);
+            break;
+        }
+        default:
+            return fail();
+        }
+    }
+    return fail();
+}
+
+bool Reader::readString(std::string& out) {
+    if (failed || !consume('"')) {
+        return fail();
+    }
+    return readStringContent(out);
+}
+
+bool Reader::readBytes(std::string& out) {
+    std::string encoded;
+    if (!readString(encoded)) {
+        return false;
+    }
+    // padding is optional
+    while (!encoded.empty() && encoded.back() == '=') {
+        encoded.pop_back();
+    }
+    if (encoded.size() % 4 == 1) {
+        return fail();
+    }
+    out.reserve(out.size() + encoded.size() * 3 / 4);
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (const auto c : encoded) {
+        const auto value = base64Value(c);
+        if (value < 0) {
+            return fail();
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((buffer >> bits) & 0xff));
+        }
+    }
+    return true;
+}
+
+bool Reader::readBool(bool& value) {
+    if (failed) {
+        return false;
+    }
+    if (consumeLiteral("true")) {
+        value = true;
+        return true;
+    }
+    if (consumeLiteral("false")) {
+        value = false;
+        return true;
+    }
+    return fail();
+}
+
+bool Reader::readNumberToken(std::string_view& token, bool& quoted) {
+    if (failed) {
+        return false;
+    }
+    skipWhitespace();
+    quoted = peek() == '"';
+    if (quoted) {
+        ++position;
+        const auto end = json.find('"', position);
+        if (end == std::string_view::npos) {
+            return fail();
+        }
+        token = json.substr(position, end - position);
+        position = end + 1;
+        return true;
+    }
+    const auto start = position;
+    while (position < json.size()) {
+        const auto c = json[position];
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) {
+            break;
+        }
+        ++position;
+    }
+    token = json.substr(start, position - start);
+    return !token.empty() || fail();
+}
+
+template <typename Integer>
+bool Reader::readInteger(Integer& value) {
+    std::string_view token;
+    bool quoted = false;
+    if (!readNumberToken(token, quoted)) {
+        return false;
+    }
+    const auto end = token.data() + token.size();
+    const auto [next, error] = std::from_chars(token.data(), end, value);
+    // a fraction, an exponent or out of range
+    return (error == std::errc() && next == end) || fail();
+}
+
+bool Reader::readInt32(int32_t& value) {
+    return readInteger(value);
+}
+
+bool Reader::readUint32(uint32_t& value) {
+    return readInteger(value);
+}
+
+bool Reader::readInt64(int64_t& value) {
+    return readInteger(value);
+}
+
+bool Reader::readUint64(uint64_t& value) {
+    return readInteger(value);
+}
+
+bool Reader::readDouble(double& value) {
+    std::string_view token;
+    bool quoted = false;
+    if (!readNumberToken(token, quoted)) {
+        return false;
+    }
+    if (quoted) {
+        if (token == "NaN") {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        if (token == "Infinity" || token == "-Infinity") {
+            value = token[0] == '-' ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return true;
+        }
+    }
+    const auto end = token.data() + token.size();
+    const auto [next, error] = std::from_chars(token.data(), end, value);
+    return (error == std::errc() && next == end && std::isfinite(value)) || fail();
+}
+
+bool Reader::readFloat(float& value) {
+    double number = 0;
+    if (!readDouble(number)) {
+        return false;
+    }
+    if (std::isfinite(number) && std::fabs(number) > std::numeric_limits<float>::max()) {
+        return fail();
+    }
+    value = static_cast<float>(number);
+    return true;
+}
+
+bool Reader::finish() {
+    skipWhitespace();
+    return (!failed && hasItems.empty() && position == json.size()) || fail();
+}
+
+} // namespace TW::ProtoJson
@@ -0,0 +1,125 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <google/protobuf/util/json_util.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TW::ProtoJson {
+
+/// Pull reader of the proto3 JSON mapping, for the parsers generated by protoc-gen-cpp-json (`<File>.json.pb.h`).
+///
+/// Values are read in place from the input, without building a document, and without reflection. Any error makes
+/// the read fail, and so does what the generated parsers don't handle (unknown fields, map fields, numbers with a
+/// fraction or an exponent for integer fields, a second or null member of a oneof): `parse` then falls back to
+/// `JsonStringToMessage`.
+class Reader {
+public:
+    /// Nesting limit of objects and arrays, the recursion limit of the protobuf JSON parser.
+    static constexpr std::size_t maxDepth = 100;
+
+    explicit Reader(std::string_view json) noexcept : json(json) {}
+
+    /// Reads the `{` starting an object.
+    bool beginObject();
+    /// Reads the next key of the current object and the `:` after it; false at the end of the object, or on error.
+    bool nextKey(std::string_view& key);
+
+    /// Reads the `[` starting an array.
+    bool beginArray();
+    /// Moves to the next element of the current array; false at the end of the array, or on error.
+    bool nextElement();
+
+    /// Reads `null` if it is the next value; a null field keeps its default value.
+    bool readNull();
+
+    /// Reads a string, appended to `out`.
+    bool readString(std::string& out);
+    /// Reads a base64 (standard or URL-safe) string as bytes, appended to `out`.
+    bool readBytes(std::string& out);
+    bool readBool(bool& value);
+    /// Reads an integer, given as a number or a string.
+    bool readInt32(int32_t& value);
+    bool readUint32(uint32_t& value);
+    bool readInt64(int64_t& value);
+    bool readUint64(uint64_t& value);
+    /// Reads a number, given as a number or a string, "NaN", "Infinity" and "-Infinity" included.
+    bool readDouble(double& value);
+    bool readFloat(float& value);
+
+    /// Reads an enum value, given by name (see the generated `parseJsonEnum`) or number.
+    template <typename Enum>
+    bool readEnum(Enum& value) {
+        skipWhitespace();
+        if (peek() != '"') {
+            int32_t number = 0;
+            if (!readInt32(number)) {
+                return false;
+            }
+            value = static_cast<Enum>(number);
+            return true;
+        }
+        std::string name;
+        if (!readString(name)) {
+            return false;
+        }
+        return parseJsonEnum(name, value) || fail();
+    }
+
+    /// Checks that only whitespace is left after the top-level value.
+    bool finish();
+
+    /// Whether nothing failed so far.
+    bool ok() const noexcept { return !failed; }
+
+    /// Marks the read as failed, returns false.
+    bool fail() noexcept {
+        failed = true;
+        return false;
+    }
+
+private:
+    void skipWhitespace() noexcept;
+    char peek() const noexcept { return position < json.size() ? json[position] : '\0'; }
+    bool consume(char c) noexcept;
+    bool consumeLiteral(std::string_view literal) noexcept;
+    /// Reads the characters of a string after its opening quote, up to and including the closing quote.
+    bool readStringContent(std::string& out);
+    /// The characters of an unquoted number, or of a quoted one.
+    bool readNumberToken(std::string_view& token, bool& quoted);
+    template <typename Integer>
+    bool readInteger(Integer& value);
+    /// Before the next item of the innermost object or array: reads the `,` unless it is the first one.
+    bool nextItem(char close);
+
+    std::string_view json;
+    std::size_t position = 0;
+    bool failed = false;
+    /// Per open object or array, whether it has items already.
+    std::vector<bool> hasItems;
+    /// Unescaped key, when the key has escapes.
+    std::string keyBuffer;
+};
+
+/// Parses `json` into `message` with its generated parser when it supports the input, otherwise with
+/// `google::protobuf::util::JsonStringToMessage`. Returns false, with an empty message, if the JSON is invalid.
+template <typename Message>
+bool parse(const std::string& json, Message& message) {
+    Reader reader(json);
+    if (parseJson(reader, message) && reader.finish()) {
+        return true;
+    }
+    message.Clear();
+    return google::protobuf::util::JsonStringToMessage(json, &message).ok();
+}
+
+} // namespace TW::ProtoJson
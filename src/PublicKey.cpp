@@ -5,8 +5,11 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "PublicKey.h"
+#include "AsnParser.h"
+#include "CryptoBackend.h"
 #include "PrivateKey.h"
 #include "Data.h"
+#include "algorithm/parallel.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
@@ -17,13 +20,14 @@
 #include <TrezorCrypto/zilliqa.h>
 #include <ImmutableX/StarkKey.h>
 
+#include <array>
 #include <iterator>
 
 namespace TW {
 
 /// Determines if a collection of bytes makes a valid public key of the
 /// given type.
-bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
+bool PublicKey::isValid(std::span<const byte> data, enum TWPublicKeyType type) {
     const auto size = data.size();
     if (size == 0) {
         return false;
@@ -49,6 +53,52 @@ bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
     }
 }
 
+namespace {
+
+/// Whether the 32-byte encoding is a point of the ed25519 curve.
+bool isOnEd25519Curve(const byte* key) {
+    ge25519 point;
+    return ge25519_unpack_negative_vartime(&point, key) != 0;
+}
+
+} // namespace
+
+std::vector<bool> PublicKey::isValidBatch(std::span<const Data> keys, enum TWPublicKeyType type, std::size_t threads) {
+    std::vector<char> valid(keys.size(), 0);
+    parallelFor(keys.size(), threads, [&](std::size_t i) {
+        const auto& key = keys[i];
+        if (!isValid(key, type)) {
+            return;
+        }
+        curve_point point;
+        switch (type) {
+        case TWPublicKeyTypeSECP256k1:
+        case TWPublicKeyTypeSECP256k1Extended:
+            valid[i] = ecdsa_read_pubkey(&secp256k1, key.data(), &point) != 0;
+            break;
+        case TWPublicKeyTypeNIST256p1:
+        case TWPublicKeyTypeNIST256p1Extended:
+            valid[i] = ecdsa_read_pubkey(&nist256p1, key.data(), &point) != 0;
+            break;
+        case TWPublicKeyTypeED25519:
+            // the key follows the optional 0x01 prefix
+            valid[i] = isOnEd25519Curve(key.data() + key.size() - ed25519Size);
+            break;
+        case TWPublicKeyTypeED25519Blake2b:
+            valid[i] = isOnEd25519Curve(key.data());
+            break;
+        case TWPublicKeyTypeED25519Cardano:
+            // spending and staking keys, each followed by its chain code
+            valid[i] = isOnEd25519Curve(key.data()) && isOnEd25519Curve(key.data() + 2 * ed25519Size);
+            break;
+        default:
+            valid[i] = 1;
+            break;
+        }
+    });
+    return {valid.begin(), valid.end()};
+}
+
 /// Initializes a public key with a collection of bytes.
 ///
 /// \throws std::invalid_argument if the data is not a valid public key.
@@ -57,33 +107,11 @@ PublicKey::PublicKey(const Data& data, enum TWPublicKeyType type)
     if (!isValid(data, type)) {
         throw std::invalid_argument("Invalid public key data");
     }
-    switch (type) {
-    case TWPublicKeyTypeStarkex:
-    case TWPublicKeyTypeSECP256k1:
-    case TWPublicKeyTypeNIST256p1:
-    case TWPublicKeyTypeSECP256k1Extended:
-    case TWPublicKeyTypeNIST256p1Extended:
-        bytes.reserve(data.size());
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-
-    case TWPublicKeyTypeED25519:
-    case TWPublicKeyTypeCURVE25519:
-        bytes.reserve(ed25519Size);
-        if (data.size() == ed25519Size + 1) {
-            std::copy(std::begin(data) + 1, std::end(data), std::back_inserter(bytes));
-        } else {
-            std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        }
-        break;
-    case TWPublicKeyTypeED25519Blake2b:
-        bytes.reserve(ed25519Size);
-        assert(data.size() == ed25519Size); // ensured by isValid() above
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-    case TWPublicKeyTypeED25519Cardano:
-        bytes.reserve(cardanoKeySize);
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
+    if ((type == TWPublicKeyTypeED25519 || type == TWPublicKeyTypeCURVE25519) && data.size() == ed25519Size + 1) {
+        // skip the 0x01 prefix
+        bytes.assign(data.data() + 1, ed25519Size);
+    } else {
+        bytes.assign(data.data(), data.size());
     }
 }
 
@@ -92,34 +120,38 @@ PublicKey PublicKey::compressed() const {
         return *this;
     }
 
-    Data newBytes(secp256k1Size);
+    std::array<byte, secp256k1Size> newBytes;
     assert(bytes.size() >= 65);
     newBytes[0] = 0x02 | (bytes[64] & 0x01);
+    std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes.begin() + 1);
 
     assert(type == TWPublicKeyTypeSECP256k1Extended || type == TWPublicKeyTypeNIST256p1Extended);
     switch (type) {
     case TWPublicKeyTypeSECP256k1Extended:
-        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes.begin() + 1);
-        return PublicKey(newBytes, TWPublicKeyTypeSECP256k1);
+        return fromTrusted(newBytes.data(), newBytes.size(), TWPublicKeyTypeSECP256k1);
 
     case TWPublicKeyTypeNIST256p1Extended:
     default:
-        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes.begin() + 1);
-        return PublicKey(newBytes, TWPublicKeyTypeNIST256p1);
+        return fromTrusted(newBytes.data(), newBytes.size(), TWPublicKeyTypeNIST256p1);
     }
 }
 
 PublicKey PublicKey::extended() const {
-    Data newBytes(secp256k1ExtendedSize);
+    std::array<byte, secp256k1ExtendedSize> newBytes;
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
-        ecdsa_uncompress_pubkey(&secp256k1, bytes.data(), newBytes.data());
-        return PublicKey(newBytes, TWPublicKeyTypeSECP256k1Extended);
+        // the compressed key is only checked for its prefix, a point off the curve is rejected here
+        if (ecdsa_uncompress_pubkey(&secp256k1, bytes.data(), newBytes.data()) == 0) {
+            throw std::invalid_argument("Invalid public key data");
+        }
+        return fromTrusted(newBytes.data(), newBytes.size(), TWPublicKeyTypeSECP256k1Extended);
     case TWPublicKeyTypeSECP256k1Extended:
         return *this;
     case TWPublicKeyTypeNIST256p1:
-        ecdsa_uncompress_pubkey(&nist256p1, bytes.data(), newBytes.data());
-        return PublicKey(newBytes, TWPublicKeyTypeNIST256p1Extended);
+        if (ecdsa_uncompress_pubkey(&nist256p1, bytes.data(), newBytes.data()) == 0) {
+            throw std::invalid_argument("Invalid public key data");
+        }
+        return fromTrusted(newBytes.data(), newBytes.size(), TWPublicKeyTypeNIST256p1Extended);
     case TWPublicKeyTypeNIST256p1Extended:
         return *this;
     case TWPublicKeyTypeED25519:
@@ -133,21 +165,21 @@ PublicKey PublicKey::extended() const {
 }
 
 bool PublicKey::verify(const Data& signature, const Data& message) const {
+    const auto& backend = CryptoBackend::current();
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
     case TWPublicKeyTypeSECP256k1Extended:
-        return ecdsa_verify_digest(&secp256k1, bytes.data(), signature.data(), message.data()) == 0;
+        return backend.ecdsaVerify(TWCurveSECP256k1, bytes.data(), signature.data(), message.data());
     case TWPublicKeyTypeNIST256p1:
     case TWPublicKeyTypeNIST256p1Extended:
-        return ecdsa_verify_digest(&nist256p1, bytes.data(), signature.data(), message.data()) == 0;
+        return backend.ecdsaVerify(TWCurveNIST256p1, bytes.data(), signature.data(), message.data());
     case TWPublicKeyTypeED25519:
-        return ed25519_sign_open(message.data(), message.size(), bytes.data(), signature.data()) == 0;
+        return backend.eddsaVerify(TWCurveED25519, bytes.data(), message.data(), message.size(), signature.data());
     case TWPublicKeyTypeED25519Blake2b:
-        return ed25519_sign_open_blake2b(message.data(), message.size(), bytes.data(), signature.data()) == 0;
-    case TWPublicKeyTypeED25519Cardano: {
-        const auto key = subData(bytes, 0, ed25519Size);
-        return ed25519_sign_open(message.data(), message.size(), key.data(), signature.data()) == 0;
-    }
+        return backend.eddsaVerify(TWCurveED25519Blake2bNano, bytes.data(), message.data(), message.size(), signature.data());
+    case TWPublicKeyTypeED25519Cardano:
+        // the first ed25519Size bytes are the key
+        return backend.eddsaVerify(TWCurveED25519ExtendedCardano, bytes.data(), message.data(), message.size(), signature.data());
     case TWPublicKeyTypeCURVE25519: {
         auto ed25519PublicKey = Data();
         ed25519PublicKey.resize(PublicKey::ed25519Size);
@@ -160,25 +192,43 @@ bool PublicKey::verify(const Data& signature, const Data& message) const {
         auto verifyBuffer = Data();
         append(verifyBuffer, signature);
         verifyBuffer[63] &= 127;
-        return ed25519_sign_open(message.data(), message.size(), ed25519PublicKey.data(), verifyBuffer.data()) == 0;
+        return backend.eddsaVerify(TWCurveED25519, ed25519PublicKey.data(), message.data(), message.size(), verifyBuffer.data());
     }
     case TWPublicKeyTypeStarkex:
-        return ImmutableX::verify(this->bytes, signature, message);
+        return ImmutableX::verify(Data(this->bytes), signature, message);
     default:
         throw std::logic_error("Not yet implemented");
     }
 }
 
+std::vector<bool> PublicKey::verifyBatch(std::span<const PublicKey> publicKeys, std::span<const Data> signatures, std::span<const Data> messages, std::size_t threads) {
+    if (signatures.size() != publicKeys.size() || messages.size() != publicKeys.size()) {
+        throw std::invalid_argument("Mismatched batch sizes");
+    }
+    for (const auto& publicKey : publicKeys) {
+        if (publicKey.type != TWPublicKeyTypeED25519 && publicKey.type != TWPublicKeyTypeED25519Blake2b && publicKey.type != TWPublicKeyTypeED25519Cardano) {
+            throw std::invalid_argument("Unsupported public key type");
+        }
+    }
+
+    // One byte per item, as std::vector<bool> can't be written from several threads.
+    Data valid(publicKeys.size(), 0);
+    parallelFor(publicKeys.size(), threads, [&](std::size_t i) {
+        constexpr std::size_t signatureSize = 64;
+        valid[i] = signatures[i].size() == signatureSize && publicKeys[i].verify(signatures[i], messages[i]);
+    });
+    return {valid.begin(), valid.end()};
+}
+
 bool PublicKey::verifyAsDER(const Data& signature, const Data& message) const {
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
     case TWPublicKeyTypeSECP256k1Extended: {
-        Data sig(64);
-        int ret = ecdsa_sig_from_der(signature.data(), signature.size(), sig.data());
-        if (ret) {
+        ASN::AsnParser::EcdsaSignature sig;
+        if (!ASN::AsnParser::ecdsa_signature_from_der(signature.data(), signature.size(), sig)) {
             return false;
         }
-        return ecdsa_verify_digest(&secp256k1, bytes.data(), sig.data(), message.data()) == 0;
+        return CryptoBackend::current().ecdsaVerify(TWCurveSECP256k1, bytes.data(), sig.data(), message.data());
     }
 
     default:
@@ -204,13 +254,14 @@ bool PublicKey::verifyZilliqa(const Data& signature, const Data& message) const
 
 Data PublicKey::hash(const Data& prefix, Hash::Hasher hasher, bool skipTypeByte) const {
     const auto offset = std::size_t(skipTypeByte ? 1 : 0);
-    const auto hash = Hash::hash(hasher, bytes.data() + offset, bytes.size() - offset);
-
-    auto result = Data();
-    result.reserve(prefix.size() + hash.size());
-    append(result, prefix);
-    append(result, hash);
-    return result;
+    return Hash::withHasher(hasher, [&](auto selected) {
+        const auto hash = Hash::hashInto<decltype(selected)::value>(bytes.data() + offset, bytes.size() - offset);
+        auto result = Data();
+        result.reserve(prefix.size() + hash.size());
+        append(result, prefix);
+        result.insert(result.end(), hash.begin(), hash.end());
+        return result;
+    });
 }
 
 PublicKey PublicKey::recoverRaw(const Data& signatureRS, byte recId, const Data& messageDigest) {
@@ -223,11 +274,11 @@ PublicKey PublicKey::recoverRaw(const Data& signatureRS, byte recId, const Data&
     if (messageDigest.size() < PrivateKey::_size) {
         throw std::invalid_argument("digest too short");
     }
-    TW::Data result(secp256k1SignatureSize);
-    if (auto ret = ecdsa_recover_pub_from_sig(&secp256k1, result.data(), signatureRS.data(), messageDigest.data(), recId); ret != 0) {
+    std::array<byte, secp256k1ExtendedSize> result;
+    if (auto ret = CryptoBackend::current().ecdsaRecover(TWCurveSECP256k1, signatureRS.data(), recId, messageDigest.data(), result.data()); ret != 0) {
         throw std::invalid_argument("recover failed " + std::to_string(ret));
     }
-    return PublicKey(result, TWPublicKeyTypeSECP256k1Extended);
+    return fromTrusted(result.data(), result.size(), TWPublicKeyTypeSECP256k1Extended);
 }
 
 PublicKey PublicKey::recover(const Data& signature, const Data& messageDigest) {
@@ -242,6 +293,60 @@ PublicKey PublicKey::recover(const Data& signature, const Data& messageDigest) {
     return recoverRaw(signature, v, messageDigest);
 }
 
+std::vector<bool> PublicKey::recoverBatch(std::span<const Data> signatures, std::span<const Data> messageDigests, byte* out, std::size_t threads) {
+    if (messageDigests.size() != signatures.size()) {
+        throw std::invalid_argument("Mismatched batch sizes");
+    }
+    constexpr std::size_t rsSize = 2 * PrivateKey::_size;
+    const auto count = signatures.size();
+
+    // Malformed items keep an all-zero signature, which never recovers.
+    Data rs(count * rsSize, 0);
+    Data digests(count * PrivateKey::_size, 0);
+    Data recIds(count, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& signature = signatures[i];
+        if (signature.size() < secp256k1SignatureSize || messageDigests[i].size() < PrivateKey::_size) {
+            continue;
+        }
+        auto v = signature[secp256k1SignatureSize - 1];
+        if (v >= PublicKey::SignatureVOffset) {
+            v = !(v & 0x01);
+        }
+        if (v >= 4) {
+            continue;
+        }
+        std::copy(signature.begin(), signature.begin() + rsSize, rs.begin() + i * rsSize);
+        std::copy(messageDigests[i].begin(), messageDigests[i].begin() + PrivateKey::_size, digests.begin() + i * PrivateKey::_size);
+        recIds[i] = v;
+    }
+
+    // Chunks large enough to amortize the shared inversions, small enough to balance the threads.
+    constexpr std::size_t chunkSize = 64;
+    std::vector<int> results(count, 1);
+    parallelFor((count + chunkSize - 1) / chunkSize, threads, [&](std::size_t chunk) {
+        const auto offset = chunk * chunkSize;
+        const auto size = std::min(chunkSize, count - offset);
+        if (!CryptoBackend::isDefault()) {
+            // The batch function is trezor-crypto's; other backends recover one by one.
+            const auto& backend = CryptoBackend::current();
+            for (auto i = offset; i < offset + size; ++i) {
+                results[i] = backend.ecdsaRecover(TWCurveSECP256k1, rs.data() + i * rsSize, recIds[i], digests.data() + i * PrivateKey::_size,
+                                                  out + i * secp256k1ExtendedSize);
+            }
+            return;
+        }
+        ecdsa_recover_pub_from_sig_batch(&secp256k1, out + offset * secp256k1ExtendedSize, rs.data() + offset * rsSize,
+                                         digests.data() + offset * PrivateKey::_size, recIds.data() + offset, results.data() + offset, size);
+    });
+
+    std::vector<bool> valid(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        valid[i] = results[i] == 0;
+    }
+    return valid;
+}
+
 bool PublicKey::isValidED25519() const {
     if (type != TWPublicKeyTypeED25519) {
         return false;
@@ -8,10 +8,12 @@
 
 #include "Data.h"
 #include "Hash.h"
+#include "InlineData.h"
 
 #include <TrustWalletCore/TWPublicKeyType.h>
 
 #include <cassert>
+#include <span>
 #include <stdexcept>
 
 namespace TW {
@@ -39,8 +41,8 @@ class PublicKey {
     /// Magic number used in V compnent encoding
     static const byte SignatureVOffset = 27;
 
-    /// The public key bytes.
-    Data bytes;
+    /// The public key bytes, stored inline (large enough for the biggest, Cardano, key).
+    InlineData<cardanoKeySize> bytes;
 
     /// The type of the public key.
     ///
@@ -50,13 +52,28 @@ class PublicKey {
 
     /// Determines if a collection of bytes makes a valid public key of the
     /// given type.
-    static bool isValid(const Data& data, enum TWPublicKeyType type);
+    static bool isValid(std::span<const byte> data, enum TWPublicKeyType type);
+
+    /// Determines, for each of many untrusted keys, if it is a valid public key of the given type:
+    /// the checks of `isValid`, and that the point is on the curve for the secp256k1, nist256p1 and
+    /// ed25519-family types, spreading the work over `threads` worker threads; 0 uses the hardware concurrency.
+    /// Valid keys can then be created with `fromTrusted`.
+    ///
+    /// \returns the validity of every key, in order.
+    static std::vector<bool> isValidBatch(std::span<const Data> keys, enum TWPublicKeyType type, std::size_t threads = 0);
 
     /// Initializes a public key with a collection of bytes.
     ///
     /// \throws std::invalid_argument if the data is not a valid public key.
     explicit PublicKey(const Data& data, enum TWPublicKeyType type);
 
+    /// Initializes a public key with bytes known to be valid, such as a key just derived or recovered,
+    /// without checking them. The ed25519 0x01 prefix is not supported here.
+    static PublicKey fromTrusted(const byte* data, std::size_t size, enum TWPublicKeyType type) noexcept {
+        assert(isValid({data, size}, type) && !(type == TWPublicKeyTypeED25519 && size == ed25519Size + 1));
+        return PublicKey(data, size, type);
+    }
+
     /// Determines if this is a compressed public key.
     bool isCompressed() const {
         return type != TWPublicKeyTypeSECP256k1Extended && type != TWPublicKeyTypeNIST256p1Extended;
@@ -77,12 +94,26 @@ class PublicKey {
     /// Verifies a Zilliqa schnorr signature for the provided message.
     bool verifyZilliqa(const Data& signature, const Data& message) const;
 
+    /// Verifies a batch of Ed25519-family signatures (ED25519, ED25519Blake2b, ED25519Cardano),
+    /// spreading the work over `threads` worker threads; 0 uses the hardware concurrency.
+    ///
+    /// \returns the validity of every signature, in order.
+    /// \throws std::invalid_argument if the spans differ in size or a key is not of an Ed25519 type.
+    static std::vector<bool> verifyBatch(std::span<const PublicKey> publicKeys, std::span<const Data> signatures, std::span<const Data> messages, std::size_t threads = 0);
+
     /// Computes the public key hash.
     ///
     /// The public key hash is computed by applying the hasher to the public key
     /// bytes and then prepending the prefix.
     Data hash(const Data& prefix, Hash::Hasher hasher = Hash::HasherSha256ripemd, bool skipTypeByte = false) const;
 
+    /// Computes the public key hash with the hasher selected at compile time, without a prefix.
+    template <Hash::Hasher H>
+    Hash::Digest<H> hash(bool skipTypeByte = false) const {
+        const auto offset = std::size_t(skipTypeByte ? 1 : 0);
+        return Hash::hashInto<H>(bytes.data() + offset, bytes.size() - offset);
+    }
+
     /// Recover public key (SECP256k1Extended) from signature R, S, V values
     /// signatureRS: 2x32 bytes with the R and S values
     /// recId: the recovery ID, a.k.a. V value, 0 <= v < 4
@@ -97,8 +128,22 @@ class PublicKey {
     /// Naming is kept for backwards compatibility.
     static PublicKey recover(const Data& signature, const Data& messageDigest);
 
+    /// Recovers the public keys (SECP256k1Extended) of many signatures at once, like `recover`,
+    /// writing the 65-byte keys to `out`, which must have room for `65 * signatures.size()` bytes.
+    /// Modular inversions are shared within a batch and the point arithmetic is variable-time,
+    /// as signatures and digests are public.
+    /// \returns whether each key could be recovered; the bytes of the others are unspecified.
+    /// \throws std::invalid_argument if the spans differ in size.
+    static std::vector<bool> recoverBatch(std::span<const Data> signatures, std::span<const Data> messageDigests, byte* out, std::size_t threads = 0);
+
     /// Check if this key makes a valid ED25519 key (it is on the curve)
     bool isValidED25519() const;
+
+  private:
+    PublicKey(const byte* data, std::size_t size, enum TWPublicKeyType type) noexcept
+        : type(type) {
+        bytes.assign(data, size);
+    }
 };
 
 inline bool operator==(const PublicKey& lhs, const PublicKey& rhs) {
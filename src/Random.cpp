@@ -0,0 +1,112 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Random.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/chacha_drbg.h>
+#include <TrezorCrypto/rand.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define TW_RANDOM_FORK_HANDLER 1
+#endif
+
+namespace TW::Random {
+
+namespace {
+
+/// Entropy drawn from the platform per (re)seed, filling exactly one SHA-256 block of the derivation function.
+constexpr std::size_t entropySize = CHACHA_DRBG_OPTIMAL_RESEED_LENGTH(1);
+
+/// Largest output of one `chacha_drbg_generate` call, which is limited to 64 KiB.
+constexpr std::size_t maxChunkSize = 1 << 15;
+
+/// Number of forks of the process, incremented in the child: a child must not replay the stream of its parent.
+std::atomic<uint32_t> forks{0};
+
+void registerForkHandler() {
+#if defined(TW_RANDOM_FORK_HANDLER)
+    static const auto registered = pthread_atfork(nullptr, nullptr, [] { forks.fetch_add(1, std::memory_order_relaxed); });
+    (void)registered;
+#endif
+}
+
+class Generator {
+public:
+    ~Generator() { memzero(&context); }
+
+    void fill(byte* buffer, std::size_t size) {
+        while (size > 0) {
+            if (generated >= reseedInterval || !seeded || forkCount != forks.load(std::memory_order_relaxed)) {
+                reseed();
+            }
+            const auto chunk = std::min({size, maxChunkSize, reseedInterval - generated});
+            chacha_drbg_generate(&context, buffer, chunk);
+            generated += chunk;
+            buffer += chunk;
+            size -= chunk;
+        }
+    }
+
+private:
+    void reseed() {
+        std::array<byte, entropySize> entropy{};
+        random_buffer(entropy.data(), entropy.size());
+        if (std::all_of(entropy.begin(), entropy.end(), [](byte b) { return b == 0; })) {
+            // the platform source failed and left the buffer untouched; never expand a known seed
+            throw std::runtime_error("Random source failure");
+        }
+        forkCount = forks.load(std::memory_order_relaxed);
+        if (seeded) {
+            chacha_drbg_reseed(&context, entropy.data(), entropy.size(), nullptr, 0);
+        } else {
+            // the address of the context tells threads apart, on top of the entropy
+            const auto* self = this;
+            chacha_drbg_init(&context, entropy.data(), entropy.size(), reinterpret_cast<const byte*>(&self), sizeof(self));
+            seeded = true;
+            registerForkHandler();
+        }
+        memzero(entropy.data(), entropy.size());
+        generated = 0;
+    }
+
+    CHACHA_DRBG_CTX context{};
+    std::size_t generated = 0;
+    bool seeded = false;
+    /// Value of `forks` at the last reseed.
+    uint32_t forkCount = 0;
+};
+
+Generator& threadGenerator() {
+    thread_local Generator generator;
+    return generator;
+}
+
+} // namespace
+
+void fill(byte* buffer, std::size_t size) {
+    threadGenerator().fill(buffer, size);
+}
+
+Data generate(std::size_t size) {
+    Data result(size);
+    fill(result.data(), result.size());
+    return result;
+}
+
+uint32_t next32() {
+    uint32_t result;
+    fill(reinterpret_cast<byte*>(&result), sizeof(result));
+    return result;
+}
+
+} // namespace TW::Random
@@ -0,0 +1,35 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TW::Random {
+
+/// Fills `buffer` with `size` random bytes.
+///
+/// The bytes come from a ChaCha20 DRBG (trezor-crypto `chacha_drbg`) owned by the calling thread. It is seeded on
+/// first use, and reseeded after every `reseedInterval` bytes, from the platform entropy source `random_buffer`
+/// (`/dev/urandom`, `SecRandomCopyBytes`, Java `SecureRandom` or `crypto.getRandomValues`), so a request costs
+/// no system or JNI call. A forked child reseeds on its first request, so that it doesn't repeat its parent.
+///
+/// @throws std::runtime_error if the platform entropy source fails.
+void fill(byte* buffer, std::size_t size);
+
+/// Returns `size` random bytes, see `fill`.
+Data generate(std::size_t size);
+
+/// Returns a random 32-bit integer, see `fill`.
+uint32_t next32();
+
+/// Number of bytes generated by a thread between two reseeds.
+static constexpr std::size_t reseedInterval = 1 << 20;
+
+} // namespace TW::Random
@@ -0,0 +1,284 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Sha256.h"
+#include "CpuFeatures.h"
+
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TW_SHA256_X86 1
+#endif
+
+namespace TW::Sha256 {
+
+namespace {
+
+#if defined(TW_SHA256_X86)
+
+#define TW_SHA256_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#define TW_SHA256_AVX2_TARGET __attribute__((target("avx2")))
+
+constexpr std::size_t blockSize = 64;
+
+constexpr std::array<uint32_t, 64> k = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr std::array<uint32_t, 8> initialState = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+/// The last one or two blocks of a message: its remaining bytes, 0x80, zeros and the big endian bit length.
+struct Tail {
+    std::array<byte, 2 * blockSize> bytes{};
+    std::size_t blocks;
+
+    Tail(const byte* data, std::size_t size) {
+        const auto remaining = size % blockSize;
+        if (remaining > 0) {
+            std::memcpy(bytes.data(), data + size - remaining, remaining);
+        }
+        bytes[remaining] = 0x80;
+        blocks = remaining + 1 + 8 > blockSize ? 2 : 1;
+        const auto bits = static_cast<uint64_t>(size) * 8;
+        for (std::size_t i = 0; i < 8; ++i) {
+            bytes[blocks * blockSize - 1 - i] = static_cast<byte>(bits >> (8 * i));
+        }
+    }
+};
+
+inline void storeBigEndian(uint32_t value, byte* out) {
+    out[0] = static_cast<byte>(value >> 24);
+    out[1] = static_cast<byte>(value >> 16);
+    out[2] = static_cast<byte>(value >> 8);
+    out[3] = static_cast<byte>(value);
+}
+
+// SHA-NI: one message, the state kept as ABEF and CDGH
+
+/// Four rounds `4 * i` to `4 * i + 3`; `w[i % 4]` holds their message words, computed from the previous ones after the first 16 rounds.
+template <std::size_t i>
+TW_SHA256_SHANI_TARGET inline void rounds4(__m128i& abef, __m128i& cdgh, __m128i (&w)[4]) {
+    if constexpr (i >= 4) {
+        auto next = _mm_sha256msg1_epu32(w[i % 4], w[(i + 1) % 4]);
+        next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) % 4], w[(i + 2) % 4], 4));
+        w[i % 4] = _mm_sha256msg2_epu32(next, w[(i + 3) % 4]);
+    }
+    auto message = _mm_add_epi32(w[i % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(k.data() + 4 * i)));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+    message = _mm_shuffle_epi32(message, 0x0e);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, message);
+}
+
+template <std::size_t... i>
+TW_SHA256_SHANI_TARGET inline void rounds(__m128i& abef, __m128i& cdgh, __m128i (&w)[4], std::index_sequence<i...>) {
+    (rounds4<i>(abef, cdgh, w), ...);
+}
+
+TW_SHA256_SHANI_TARGET void compress(__m128i& abef, __m128i& cdgh, const byte* data, std::size_t blocks) {
+    const auto byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    for (; blocks > 0; --blocks, data += blockSize) {
+        const auto abefSaved = abef;
+        const auto cdghSaved = cdgh;
+        __m128i w[4];
+        for (std::size_t j = 0; j < 4; ++j) {
+            w[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * j)), byteSwap);
+        }
+        rounds(abef, cdgh, w, std::make_index_sequence<16>());
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+}
+
+TW_SHA256_SHANI_TARGET void hashShani(const byte* data, std::size_t size, byte* out) {
+    // ABCD EFGH to ABEF CDGH
+    const auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(initialState.data())), 0xb1);
+    const auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(initialState.data() + 4)), 0x1b);
+    auto abef = _mm_alignr_epi8(abcd, efgh, 8);
+    auto cdgh = _mm_blend_epi16(efgh, abcd, 0xf0);
+
+    compress(abef, cdgh, data, size / blockSize);
+    const auto tail = Tail(data, size);
+    compress(abef, cdgh, tail.bytes.data(), tail.blocks);
+
+    // back to ABCD EFGH, big endian
+    const auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    const auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    const auto byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(_mm_blend_epi16(feba, dchg, 0xf0), byteSwap));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_shuffle_epi8(_mm_alignr_epi8(dchg, feba, 8), byteSwap));
+}
+
+// AVX2: eight messages, one 32-bit word of each per register
+
+using Words = __m256i;
+
+template <int n>
+TW_SHA256_AVX2_TARGET inline Words rotr(Words x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+TW_SHA256_AVX2_TARGET inline Words add(Words a, Words b) {
+    return _mm256_add_epi32(a, b);
+}
+
+TW_SHA256_AVX2_TARGET inline Words xor3(Words a, Words b, Words c) {
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+/// Round `t`; `s[(j + 8 - t % 8) % 8]` holds the working variable `j` (a to h), so the variables don't move.
+template <std::size_t t>
+TW_SHA256_AVX2_TARGET inline void round(Words (&s)[8], Words (&w)[16]) {
+    if constexpr (t >= 16) {
+        const auto w15 = w[(t + 1) % 16];
+        const auto w2 = w[(t + 14) % 16];
+        const auto sigma0 = xor3(rotr<7>(w15), rotr<18>(w15), _mm256_srli_epi32(w15, 3));
+        const auto sigma1 = xor3(rotr<17>(w2), rotr<19>(w2), _mm256_srli_epi32(w2, 10));
+        w[t % 16] = add(add(w[t % 16], sigma0), add(w[(t + 9) % 16], sigma1));
+    }
+    constexpr auto at = [](std::size_t j) { return (j + 8 - t % 8) % 8; };
+    const auto a = s[at(0)], b = s[at(1)], c = s[at(2)], e = s[at(4)], f = s[at(5)], g = s[at(6)];
+    const auto sum1 = xor3(rotr<6>(e), rotr<11>(e), rotr<25>(e));
+    const auto choice = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+    const auto t1 = add(add(add(s[at(7)], sum1), add(choice, _mm256_set1_epi32(static_cast<int>(k[t])))), w[t % 16]);
+    const auto sum0 = xor3(rotr<2>(a), rotr<13>(a), rotr<22>(a));
+    const auto majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    s[at(3)] = add(s[at(3)], t1);
+    s[at(7)] = add(t1, add(sum0, majority));
+}
+
+template <std::size_t... t>
+TW_SHA256_AVX2_TARGET inline void rounds(Words (&s)[8], Words (&w)[16], std::index_sequence<t...>) {
+    (round<t>(s, w), ...);
+}
+
+/// Transposes eight rows of eight 32-bit words.
+TW_SHA256_AVX2_TARGET inline void transpose(Words (&rows)[8]) {
+    Words t[8];
+    for (std::size_t i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(rows[i], rows[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(rows[i], rows[i + 1]);
+    }
+    Words u[8];
+    for (std::size_t i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        rows[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        rows[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+/// Loads eight 32-byte rows, big endian words, as eight words of the eight messages.
+TW_SHA256_AVX2_TARGET inline void loadWords(const std::array<const byte*, lanes>& rows, std::size_t offset, Words* w) {
+    const auto byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    Words block[8];
+    for (std::size_t l = 0; l < lanes; ++l) {
+        block[l] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[l] + offset)), byteSwap);
+    }
+    transpose(block);
+    for (std::size_t i = 0; i < 8; ++i) {
+        w[i] = block[i];
+    }
+}
+
+TW_SHA256_AVX2_TARGET void compress8(Words (&state)[8], const std::array<const byte*, lanes>& blocks) {
+    Words w[16];
+    loadWords(blocks, 0, w);
+    loadWords(blocks, 32, w + 8);
+    Words s[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        s[i] = state[i];
+    }
+    rounds(s, w, std::make_index_sequence<64>());
+    for (std::size_t i = 0; i < 8; ++i) {
+        state[i] = add(state[i], s[i]);
+    }
+}
+
+TW_SHA256_AVX2_TARGET void hash8Avx2(const std::array<const byte*, lanes>& messages, std::size_t size, byte* out) {
+    Words state[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        state[i] = _mm256_set1_epi32(static_cast<int>(initialState[i]));
+    }
+    for (std::size_t offset = 0; offset + blockSize <= size; offset += blockSize) {
+        std::array<const byte*, lanes> blocks;
+        for (std::size_t l = 0; l < lanes; ++l) {
+            blocks[l] = messages[l] + offset;
+        }
+        compress8(state, blocks);
+    }
+    // the messages have the same size, so the same number of tail blocks
+    std::array<Tail, lanes> tails = {
+        Tail(messages[0], size), Tail(messages[1], size), Tail(messages[2], size), Tail(messages[3], size),
+        Tail(messages[4], size), Tail(messages[5], size), Tail(messages[6], size), Tail(messages[7], size),
+    };
+    for (std::size_t block = 0; block < tails[0].blocks; ++block) {
+        std::array<const byte*, lanes> blocks;
+        for (std::size_t l = 0; l < lanes; ++l) {
+            blocks[l] = tails[l].bytes.data() + block * blockSize;
+        }
+        compress8(state, blocks);
+    }
+
+    alignas(32) std::array<std::array<uint32_t, lanes>, 8> words;
+    for (std::size_t i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i].data()), state[i]);
+    }
+    for (std::size_t l = 0; l < lanes; ++l) {
+        for (std::size_t i = 0; i < 8; ++i) {
+            storeBigEndian(words[i][l], out + l * digestSize + 4 * i);
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+bool shaniSupported() noexcept {
+    return CpuFeatures::shani();
+}
+
+bool avx2Supported() noexcept {
+    return CpuFeatures::avx2();
+}
+
+bool hash([[maybe_unused]] const byte* data, [[maybe_unused]] std::size_t size, [[maybe_unused]] byte* out) noexcept {
+#if defined(TW_SHA256_X86)
+    if (shaniSupported()) {
+        hashShani(data, size, out);
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool hash8([[maybe_unused]] const std::array<const byte*, lanes>& messages, [[maybe_unused]] std::size_t size, [[maybe_unused]] byte* out) noexcept {
+#if defined(TW_SHA256_X86)
+    if (avx2Supported()) {
+        hash8Avx2(messages, size, out);
+        return true;
+    }
+#endif
+    return false;
+}
+
+} // namespace TW::Sha256
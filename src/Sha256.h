@@ -0,0 +1,37 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <cstddef>
+
+namespace TW::Sha256 {
+
+/// Size of a SHA-256 digest.
+static constexpr std::size_t digestSize = 32;
+
+/// Number of messages hashed together by `hash8`.
+static constexpr std::size_t lanes = 8;
+
+/// Whether the CPU runs the SHA-NI implementation of `hash`, checked once.
+bool shaniSupported() noexcept;
+
+/// Whether the CPU runs the AVX2 implementation of `hash8`, checked once.
+bool avx2Supported() noexcept;
+
+/// Computes the SHA-256 hash of `data` into `out` (`digestSize` bytes) with the SHA-NI instructions.
+/// Returns false, leaving `out` untouched, if the CPU doesn't support them; `Hash::sha256` then falls back
+/// to the portable implementation.
+bool hash(const byte* data, std::size_t size, byte* out) noexcept;
+
+/// Computes the SHA-256 hashes of eight messages of `size` bytes each into `out`, one digest after the other,
+/// with AVX2. Returns false, leaving `out` untouched, if the CPU doesn't support it.
+bool hash8(const std::array<const byte*, lanes>& messages, std::size_t size, byte* out) noexcept;
+
+} // namespace TW::Sha256
@@ -0,0 +1,90 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningCache.h"
+
+#include <TrezorCrypto/memzero.h>
+
+using namespace TW;
+
+SigningCache& SigningCache::shared() {
+    static SigningCache cache;
+    return cache;
+}
+
+SigningCache::~SigningCache() {
+    clear();
+}
+
+void SigningCache::configure(std::size_t capacity, Clock::duration ttl) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxEntries = capacity;
+    timeToLive = ttl;
+    while (entries.size() > maxEntries) {
+        erase(std::prev(entries.end()));
+    }
+    isEnabled.store(capacity > 0, std::memory_order_relaxed);
+}
+
+void SigningCache::trim(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (entries.size() > count) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+SigningCache::Key SigningCache::key(TWCoinType coin, Operation operation, const Data& input) {
+    return Key{coin, operation, Hash::sha256Into(input)};
+}
+
+bool SigningCache::find(const Key& key, Data& output) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = lookup.find(key);
+    if (it == lookup.end()) {
+        return false;
+    }
+    if (timeToLive != Clock::duration::zero() && Clock::now() - it->second->created >= timeToLive) {
+        erase(it->second);
+        return false;
+    }
+    // mark as most recently used
+    entries.splice(entries.begin(), entries, it->second);
+    output.assign(it->second->output.begin(), it->second->output.end());
+    return true;
+}
+
+void SigningCache::insert(const Key& key, const Data& output) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (maxEntries == 0) {
+        return;
+    }
+    if (auto it = lookup.find(key); it != lookup.end()) {
+        erase(it->second);
+    }
+    if (entries.size() >= maxEntries) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front(Entry{key, {output.begin(), output.end()}, Clock::now()});
+    lookup.emplace(key, entries.begin());
+}
+
+void SigningCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!entries.empty()) {
+        erase(entries.begin());
+    }
+}
+
+std::size_t SigningCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void SigningCache::erase(Entries::iterator it) {
+    lookup.erase(it->key);
+    ::memzero(it->output.data(), it->output.size());
+    entries.erase(it);
+}
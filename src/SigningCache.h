@@ -0,0 +1,117 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "Hash.h"
+#include "memory/memory_stats.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace TW {
+
+/// Thread-safe LRU cache of signing and planning outputs, keyed by coin, operation and SHA256 digest of the input.
+/// Entries expire after a time to live; outputs are wiped when evicted, expired, cleared or destroyed.
+class SigningCache {
+public:
+    enum class Operation : uint8_t {
+        Sign,
+        Plan,
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Key {
+        TWCoinType coin;
+        Operation operation;
+        Hash::Digest32 digest;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    /// The cache of `anyCoinSign`, `anyCoinSignBatch` and `anyCoinPlan`, configured by `TWSigningCacheConfigure`.
+    static SigningCache& shared();
+
+    /// Creates a disabled cache.
+    SigningCache() = default;
+    ~SigningCache();
+
+    SigningCache(const SigningCache&) = delete;
+    SigningCache& operator=(const SigningCache&) = delete;
+
+    /// Enables the cache for at most `capacity` outputs, reused for `ttl` (no limit if zero);
+    /// a zero `capacity` disables and clears it.
+    void configure(std::size_t capacity, Clock::duration ttl);
+
+    bool enabled() const noexcept { return isEnabled.load(std::memory_order_relaxed); }
+
+    static Key key(TWCoinType coin, Operation operation, const Data& input);
+
+    /// Copies the cached output of `key` into `output` if there is one which has not expired.
+    bool find(const Key& key, Data& output);
+
+    /// Stores the output of `key`, evicting the least recently used entry if full. Does nothing if disabled.
+    void insert(const Key& key, const Data& output);
+
+    /// Wipes and removes all entries.
+    void clear();
+
+    /// Wipes and removes the least recently used entries, keeping at most `count`.
+    void trim(std::size_t count);
+
+    std::size_t size() const;
+
+    /// Gets the output of `input` from the cache, or computes it with `compute()` into `output` and caches it.
+    /// Costs an atomic load if the cache is disabled.
+    template <typename Compute>
+    void getOrCompute(TWCoinType coin, Operation operation, const Data& input, Data& output, Compute&& compute) {
+        if (!enabled()) {
+            compute();
+            return;
+        }
+        const auto entryKey = key(coin, operation, input);
+        if (find(entryKey, output)) {
+            return;
+        }
+        compute();
+        insert(entryKey, output);
+    }
+
+private:
+    template <typename T>
+    using Allocator = MemoryStats::CountingAllocator<T, TWMemoryCacheSigning>;
+
+    struct Entry {
+        Key key;
+        MemoryStats::CountedData<TWMemoryCacheSigning> output;
+        Clock::time_point created;
+    };
+
+    using Entries = std::list<Entry, Allocator<Entry>>;
+
+    /// Wipes and removes `it`, with the lock held.
+    void erase(Entries::iterator it);
+
+    std::atomic<bool> isEnabled{false};
+    std::size_t maxEntries = 0;
+    Clock::duration timeToLive{};
+    /// Most recently used first.
+    Entries entries;
+    std::map<Key, Entries::iterator, std::less<Key>, Allocator<std::pair<const Key, Entries::iterator>>> lookup;
+    mutable std::mutex mutex;
+};
+
+} // namespace TW
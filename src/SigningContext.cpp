@@ -0,0 +1,85 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningContext.h"
+
+#include "CryptoBackend.h"
+#include "memory/memzero_wrapper.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+TWCurve checkedCurve(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        return curve;
+    default:
+        throw std::invalid_argument("Unsupported signing context curve");
+    }
+}
+
+PublicKey computePublicKey(TWCurve curve, const PrivateKey& privateKey) {
+    if (privateKey.bytes.size() != PrivateKey::_size) {
+        throw std::invalid_argument("Invalid private key size");
+    }
+    Data result(PublicKey::secp256k1ExtendedSize);
+    if (!CryptoBackend::current().ecdsaGetPublicKey(curve, privateKey.bytes.data(), false, result.data())) {
+        throw std::invalid_argument("Invalid private key");
+    }
+    const auto type = curve == TWCurveSECP256k1 ? TWPublicKeyTypeSECP256k1Extended : TWPublicKeyTypeNIST256p1Extended;
+    return PublicKey(result, type);
+}
+
+} // namespace
+
+SigningContext::SigningContext(const PrivateKey& privateKey, TWCurve curve)
+    : curveType(checkedCurve(curve))
+    , uncompressedPublicKey(computePublicKey(curveType, privateKey))
+    , compressedPublicKey(uncompressedPublicKey.compressed()) {
+    std::copy(privateKey.bytes.begin(), privateKey.bytes.end(), key.begin());
+}
+
+SigningContext::~SigningContext() {
+    memzero(key.data(), key.size());
+}
+
+bool SigningContext::signDigest(std::span<const byte> digest, byte* sig, byte* by, CanonicalChecker canonicalChecker) const {
+    if (digest.size() < 32) {
+        return false;
+    }
+    return CryptoBackend::current().ecdsaSign(curveType, key.data(), digest.data(), sig, by, canonicalChecker);
+}
+
+bool SigningContext::sign(std::span<const byte> digest, std::span<byte, signatureSize> signature) const {
+    if (!signDigest(digest, signature.data(), signature.data() + 64, nullptr)) {
+        std::fill(signature.begin(), signature.end(), 0);
+        return false;
+    }
+    return true;
+}
+
+bool SigningContext::signCanonical(std::span<const byte> digest, std::span<byte, signatureSize> signature, CanonicalChecker canonicalChecker) const {
+    if (!signDigest(digest, signature.data() + 1, signature.data(), canonicalChecker)) {
+        std::fill(signature.begin(), signature.end(), 0);
+        return false;
+    }
+    // graphene adds 31 to the recovery id
+    signature[0] += 31;
+    return true;
+}
+
+Data SigningContext::sign(const Data& digest) const {
+    Data result(signatureSize);
+    if (!sign(digest, std::span<byte, signatureSize>(result.data(), signatureSize))) {
+        return {};
+    }
+    return result;
+}
@@ -0,0 +1,65 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCurve.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace TW {
+
+/// ECDSA signing context bound to one private key and curve (secp256k1 or nist256p1).
+/// The key is validated and its public key computed once, signatures are written into caller-provided
+/// buffers; meant for hot paths signing many digests with the same key.
+/// Operations go through the installed `CryptoBackend`, nonces are RFC6979.
+class SigningContext {
+public:
+    static const size_t signatureSize = 65;
+
+    using Signature = std::array<byte, signatureSize>;
+    using CanonicalChecker = int (*)(uint8_t by, uint8_t sig[64]);
+
+    /// Throws std::invalid_argument if the curve is not an ECDSA curve or the key is not valid on it.
+    SigningContext(const PrivateKey& privateKey, TWCurve curve);
+    ~SigningContext();
+
+    SigningContext(const SigningContext&) = delete;
+    SigningContext& operator=(const SigningContext&) = delete;
+
+    TWCurve curve() const { return curveType; }
+
+    /// The public key, compressed or extended (uncompressed); computed at construction.
+    const PublicKey& publicKey() const { return compressedPublicKey; }
+    const PublicKey& extendedPublicKey() const { return uncompressedPublicKey; }
+
+    /// Signs a digest (at least 32 bytes, only the first 32 are used) into `signature`, as r | s | v like
+    /// `PrivateKey::sign(digest, curve)`. Returns false on failure, leaving `signature` zeroed.
+    bool sign(std::span<const byte> digest, std::span<byte, signatureSize> signature) const;
+
+    /// Signs until `canonicalChecker` accepts the signature, written as v | r | s with v + 31 (a la graphene),
+    /// like `PrivateKey::sign(digest, curve, canonicalChecker)`. Returns false on failure, leaving `signature` zeroed.
+    bool signCanonical(std::span<const byte> digest, std::span<byte, signatureSize> signature, CanonicalChecker canonicalChecker) const;
+
+    /// Allocating convenience variant of `sign`, returns empty on failure.
+    Data sign(const Data& digest) const;
+
+private:
+    bool signDigest(std::span<const byte> digest, byte* sig, byte* by, CanonicalChecker canonicalChecker) const;
+
+    TWCurve curveType;
+    std::array<byte, PrivateKey::_size> key;
+    PublicKey uncompressedPublicKey;
+    PublicKey compressedPublicKey;
+};
+
+} // namespace TW
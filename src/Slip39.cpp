@@ -0,0 +1,507 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Slip39.h"
+#include "Random.h"
+#include "algorithm/parallel.h"
+
+#include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/pbkdf2.h>
+#include <TrezorCrypto/shamir.h>
+#include <TrezorCrypto/slip39.h>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <stdexcept>
+
+namespace TW {
+
+namespace {
+
+constexpr std::size_t ChecksumWords = 3;
+constexpr std::size_t MetadataWords = 4 + ChecksumWords;
+constexpr std::size_t DigestSize = 4;
+constexpr uint8_t DigestIndex = 254;
+constexpr uint8_t SecretIndex = 255;
+constexpr uint32_t BaseIterationCount = 10000;
+constexpr uint8_t RoundCount = 4;
+constexpr uint16_t WordMask = (1 << Slip39::RadixBits) - 1;
+
+std::string_view customizationString(bool extendable) {
+    return extendable ? "shamir_extendable" : "shamir";
+}
+
+uint32_t rs1024Polymod(std::string_view customization, const std::vector<uint16_t>& words) {
+    static constexpr uint32_t generator[10] = {0xe0e040, 0x1c1c080, 0x3838100, 0x7070200, 0xe0e0009,
+                                               0x1c0c2412, 0x38086c24, 0x3090fc48, 0x21b1f890, 0x3f3f120};
+    uint32_t checksum = 1;
+    const auto step = [&checksum](uint32_t value) {
+        const auto top = checksum >> 20;
+        checksum = ((checksum & 0xfffff) << Slip39::RadixBits) ^ value;
+        for (auto i = 0; i < 10; ++i) {
+            if ((top >> i) & 1) {
+                checksum ^= generator[i];
+            }
+        }
+    };
+    for (const auto c : customization) {
+        step(static_cast<uint8_t>(c));
+    }
+    for (const auto word : words) {
+        step(word);
+    }
+    return checksum;
+}
+
+/// Evaluates at `x` the polynomial through the shares, SHAMIR_MAX_LEN bytes at a time.
+std::optional<SecureData> interpolate(const std::vector<uint8_t>& indices, const std::vector<const byte*>& values,
+                                      std::size_t size, uint8_t x) {
+    SecureData result(size);
+    std::vector<const byte*> chunk(values.size());
+    for (std::size_t offset = 0; offset < size; offset += SHAMIR_MAX_LEN) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            chunk[i] = values[i] + offset;
+        }
+        const auto length = std::min<std::size_t>(SHAMIR_MAX_LEN, size - offset);
+        if (!shamir_interpolate(result.data() + offset, x, indices.data(), chunk.data(), static_cast<uint8_t>(values.size()), length)) {
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+SecureData shareDigest(std::span<const byte> randomPart, std::span<const byte> secret) {
+    SecureData digest(SHA256_DIGEST_LENGTH);
+    hmac_sha256(randomPart.data(), static_cast<uint32_t>(randomPart.size()), secret.data(), static_cast<uint32_t>(secret.size()), digest.data());
+    digest.resize(DigestSize);
+    return digest;
+}
+
+std::vector<SecureData> splitSecret(uint8_t threshold, uint8_t count, std::span<const byte> secret) {
+    if (threshold == 1) {
+        return std::vector<SecureData>(count, SecureData(secret.begin(), secret.end()));
+    }
+
+    // threshold - 2 random shares, the digest share and the secret define the polynomial
+    const auto randomShareCount = static_cast<uint8_t>(threshold - 2);
+    std::vector<SecureData> shares(count);
+    std::vector<uint8_t> indices;
+    std::vector<const byte*> values;
+    for (uint8_t i = 0; i < randomShareCount; ++i) {
+        shares[i].resize(secret.size());
+        Random::fill(shares[i].data(), shares[i].size());
+        indices.push_back(i);
+        values.push_back(shares[i].data());
+    }
+    SecureData randomPart(secret.size() - DigestSize);
+    Random::fill(randomPart.data(), randomPart.size());
+    auto digestShare = shareDigest(randomPart, secret);
+    digestShare.insert(digestShare.end(), randomPart.begin(), randomPart.end());
+    indices.push_back(DigestIndex);
+    values.push_back(digestShare.data());
+    indices.push_back(SecretIndex);
+    values.push_back(secret.data());
+
+    for (auto i = randomShareCount; i < count; ++i) {
+        shares[i] = *interpolate(indices, values, secret.size(), i);
+    }
+    return shares;
+}
+
+/// Recovers a secret split by `splitSecret` and checks its digest.
+std::optional<SecureData> recoverSecret(uint8_t threshold, const std::vector<uint8_t>& indices, const std::vector<const byte*>& values, std::size_t size) {
+    if (values.size() < threshold || values.empty()) {
+        return std::nullopt;
+    }
+    if (threshold == 1) {
+        return SecureData(values.front(), values.front() + size);
+    }
+    auto secret = interpolate(indices, values, size, SecretIndex);
+    const auto digestShare = interpolate(indices, values, size, DigestIndex);
+    if (!secret || !digestShare) {
+        return std::nullopt;
+    }
+    const auto digest = shareDigest(std::span<const byte>(*digestShare).subspan(DigestSize), *secret);
+    byte difference = 0;
+    for (std::size_t i = 0; i < DigestSize; ++i) {
+        difference |= digest[i] ^ (*digestShare)[i];
+    }
+    if (difference != 0) {
+        return std::nullopt;
+    }
+    return secret;
+}
+
+/// Four-round Feistel network keyed by PBKDF2 of the passphrase, run forward to encrypt and backward to decrypt.
+SecureData feistel(std::span<const byte> input, const std::string& passphrase, uint8_t iterationExponent, uint16_t identifier,
+                   bool extendable, bool encrypt) {
+    const auto half = input.size() / 2;
+    SecureData left(input.begin(), input.begin() + half);
+    SecureData right(input.begin() + half, input.end());
+
+    SecureData salt;
+    if (!extendable) {
+        const auto prefix = customizationString(false);
+        salt.assign(prefix.begin(), prefix.end());
+        salt.push_back(static_cast<byte>(identifier >> 8));
+        salt.push_back(static_cast<byte>(identifier & 0xff));
+    }
+    const auto saltPrefixSize = salt.size();
+    SecureData password(1);
+    password.insert(password.end(), passphrase.begin(), passphrase.end());
+    const uint32_t iterations = (BaseIterationCount << iterationExponent) / RoundCount;
+
+    SecureData round(half);
+    for (uint8_t step = 0; step < RoundCount; ++step) {
+        password[0] = encrypt ? step : static_cast<byte>(RoundCount - 1 - step);
+        salt.resize(saltPrefixSize);
+        salt.insert(salt.end(), right.begin(), right.end());
+        pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), salt.data(), static_cast<int>(salt.size()),
+                           iterations, round.data(), static_cast<int>(half));
+        for (std::size_t i = 0; i < half; ++i) {
+            round[i] ^= left[i];
+        }
+        left.swap(right);
+        right.swap(round);
+    }
+    right.insert(right.end(), left.begin(), left.end());
+    return right;
+}
+
+/// Shares of a group, indexed by member.
+struct GroupShares {
+    uint8_t threshold = 0;
+    std::vector<uint8_t> indices;
+    std::vector<const byte*> values;
+};
+
+/// Decodes the mnemonics and groups their shares, nullopt if a share is invalid or the shares don't belong together.
+std::optional<std::map<uint8_t, GroupShares>> collectShares(const std::vector<std::string>& mnemonics, std::vector<Slip39::Share>& shares) {
+    shares.clear();
+    for (const auto& mnemonic : mnemonics) {
+        auto share = Slip39::Share::decode(mnemonic);
+        if (!share) {
+            return std::nullopt;
+        }
+        shares.push_back(std::move(*share));
+    }
+    if (shares.empty()) {
+        return std::nullopt;
+    }
+
+    const auto& first = shares.front();
+    std::map<uint8_t, GroupShares> groups;
+    for (const auto& share : shares) {
+        if (share.identifier != first.identifier || share.extendable != first.extendable ||
+            share.iterationExponent != first.iterationExponent || share.groupThreshold != first.groupThreshold ||
+            share.groupCount != first.groupCount || share.value.size() != first.value.size() || share.groupIndex >= share.groupCount) {
+            return std::nullopt;
+        }
+        auto& group = groups[share.groupIndex];
+        if (group.threshold == 0) {
+            group.threshold = share.memberThreshold;
+        } else if (group.threshold != share.memberThreshold) {
+            return std::nullopt;
+        }
+        const auto existing = std::find(group.indices.begin(), group.indices.end(), share.memberIndex);
+        if (existing != group.indices.end()) {
+            // the same share given twice is harmless, two different values for a member are not
+            if (!std::equal(share.value.begin(), share.value.end(), group.values[existing - group.indices.begin()])) {
+                return std::nullopt;
+            }
+            continue;
+        }
+        group.indices.push_back(share.memberIndex);
+        group.values.push_back(share.value.data());
+    }
+    return groups;
+}
+
+/// All subsets of `k` of the positions `[0, n)`, in lexicographic order.
+std::vector<std::vector<uint8_t>> combinations(std::size_t n, std::size_t k) {
+    std::vector<std::vector<uint8_t>> result;
+    if (k == 0 || k > n) {
+        return result;
+    }
+    std::vector<uint8_t> current(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        current[i] = static_cast<uint8_t>(i);
+    }
+    while (true) {
+        result.push_back(current);
+        auto i = k;
+        while (i > 0 && current[i - 1] == n - k + i - 1) {
+            --i;
+        }
+        if (i == 0) {
+            return result;
+        }
+        ++current[i - 1];
+        for (auto j = i; j < k; ++j) {
+            current[j] = static_cast<uint8_t>(current[j - 1] + 1);
+        }
+    }
+}
+
+std::string describe(const std::vector<uint8_t>& indices, const std::vector<uint8_t>& positions) {
+    std::string result;
+    for (const auto position : positions) {
+        result += (result.empty() ? "" : ",") + std::to_string(indices[position]);
+    }
+    return result;
+}
+
+} // namespace
+
+std::optional<Slip39::Share> Slip39::Share::decode(std::string_view mnemonic) {
+    std::vector<uint16_t> words;
+    std::string word;
+    for (std::size_t i = 0; i <= mnemonic.size(); ++i) {
+        if (i == mnemonic.size() || std::isspace(static_cast<unsigned char>(mnemonic[i]))) {
+            if (word.empty()) {
+                continue;
+            }
+            uint16_t index = 0;
+            if (word.size() > 8 || !word_index(&index, word.c_str(), static_cast<uint8_t>(word.size())) || word != get_word(index)) {
+                return std::nullopt;
+            }
+            words.push_back(index);
+            word.clear();
+        } else {
+            word.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(mnemonic[i]))));
+        }
+    }
+
+    const auto valueWords = words.size() < MetadataWords ? 0 : words.size() - MetadataWords;
+    const auto valueBits = valueWords * RadixBits;
+    const auto padding = valueBits % 16;
+    if (padding > 8 || (valueBits - padding) / 8 < MinSecretSize) {
+        return std::nullopt;
+    }
+    const auto extendable = ((words[1] >> 4) & 1) != 0;
+    if (rs1024Polymod(customizationString(extendable), words) != 1) {
+        return std::nullopt;
+    }
+
+    Share share;
+    const uint32_t identifierField = (uint32_t(words[0]) << RadixBits) | words[1];
+    const uint32_t groupField = (uint32_t(words[2]) << RadixBits) | words[3];
+    share.identifier = static_cast<uint16_t>(identifierField >> 5);
+    share.extendable = extendable;
+    share.iterationExponent = identifierField & 0xf;
+    share.groupIndex = (groupField >> 16) & 0xf;
+    share.groupThreshold = ((groupField >> 12) & 0xf) + 1;
+    share.groupCount = ((groupField >> 8) & 0xf) + 1;
+    share.memberIndex = (groupField >> 4) & 0xf;
+    share.memberThreshold = (groupField & 0xf) + 1;
+    if (share.groupThreshold > share.groupCount) {
+        return std::nullopt;
+    }
+
+    // the value is big-endian, left-padded with zero bits to a whole number of words
+    share.value.reserve((valueBits - padding) / 8);
+    uint32_t bits = 0;
+    std::size_t bitCount = 0;
+    for (std::size_t i = 4; i < 4 + valueWords; ++i) {
+        bits = (bits << RadixBits) | words[i];
+        bitCount += RadixBits;
+        if (i == 4) {
+            if ((bits >> (bitCount - padding)) != 0) {
+                return std::nullopt;
+            }
+            bitCount -= padding;
+            bits &= (1u << bitCount) - 1;
+        }
+        while (bitCount >= 8) {
+            bitCount -= 8;
+            share.value.push_back(static_cast<byte>(bits >> bitCount));
+            bits &= (1u << bitCount) - 1;
+        }
+    }
+    return share;
+}
+
+std::string Slip39::Share::encode() const {
+    const uint32_t identifierField = (uint32_t(identifier) << 5) | (uint32_t(extendable) << 4) | iterationExponent;
+    const uint32_t groupField = (uint32_t(groupIndex) << 16) | (uint32_t(groupThreshold - 1) << 12) |
+                                (uint32_t(groupCount - 1) << 8) | (uint32_t(memberIndex) << 4) | uint32_t(memberThreshold - 1);
+    std::vector<uint16_t> words = {
+        static_cast<uint16_t>(identifierField >> RadixBits), static_cast<uint16_t>(identifierField & WordMask),
+        static_cast<uint16_t>(groupField >> RadixBits), static_cast<uint16_t>(groupField & WordMask),
+    };
+
+    const auto valueWords = (value.size() * 8 + RadixBits - 1) / RadixBits;
+    uint32_t bits = 0;
+    std::size_t bitCount = valueWords * RadixBits - value.size() * 8;
+    for (const auto b : value) {
+        bits = (bits << 8) | b;
+        bitCount += 8;
+        if (bitCount >= RadixBits) {
+            bitCount -= RadixBits;
+            words.push_back(static_cast<uint16_t>((bits >> bitCount) & WordMask));
+            bits &= (1u << bitCount) - 1;
+        }
+    }
+
+    const auto customization = customizationString(extendable);
+    words.insert(words.end(), ChecksumWords, 0);
+    const auto checksum = rs1024Polymod(customization, words) ^ 1;
+    for (std::size_t i = 0; i < ChecksumWords; ++i) {
+        words[words.size() - ChecksumWords + i] = (checksum >> (RadixBits * (ChecksumWords - 1 - i))) & WordMask;
+    }
+
+    std::string result;
+    for (const auto index : words) {
+        if (!result.empty()) {
+            result += ' ';
+        }
+        result += get_word(index);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::string>> Slip39::generate(uint8_t groupThreshold, const std::vector<Group>& groups, std::span<const byte> masterSecret,
+                                                       const std::string& passphrase, uint8_t iterationExponent, bool extendable) {
+    if (masterSecret.size() < MinSecretSize || masterSecret.size() % 2 != 0) {
+        throw std::invalid_argument("master secret must be at least 16 bytes, of even length");
+    }
+    if (iterationExponent > 0xf) {
+        throw std::invalid_argument("iteration exponent must be at most 15");
+    }
+    if (groups.empty() || groups.size() > MaxShareCount || groupThreshold == 0 || groupThreshold > groups.size()) {
+        throw std::invalid_argument("invalid group threshold or count");
+    }
+    for (const auto& group : groups) {
+        if (group.threshold == 0 || group.threshold > group.count || group.count > MaxShareCount ||
+            (group.threshold == 1 && group.count > 1)) {
+            throw std::invalid_argument("invalid member threshold or count");
+        }
+    }
+
+    Share share;
+    share.identifier = static_cast<uint16_t>(Random::next32() & 0x7fff);
+    share.extendable = extendable;
+    share.iterationExponent = iterationExponent;
+    share.groupThreshold = groupThreshold;
+    share.groupCount = static_cast<uint8_t>(groups.size());
+
+    const auto encryptedSecret = feistel(masterSecret, passphrase, iterationExponent, share.identifier, extendable, true);
+    const auto groupSecrets = splitSecret(groupThreshold, share.groupCount, encryptedSecret);
+    std::vector<std::vector<std::string>> result(groups.size());
+    for (uint8_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex) {
+        const auto& group = groups[groupIndex];
+        auto memberSecrets = splitSecret(group.threshold, group.count, groupSecrets[groupIndex]);
+        share.groupIndex = groupIndex;
+        share.memberThreshold = group.threshold;
+        for (uint8_t memberIndex = 0; memberIndex < group.count; ++memberIndex) {
+            share.memberIndex = memberIndex;
+            share.value = std::move(memberSecrets[memberIndex]);
+            result[groupIndex].push_back(share.encode());
+        }
+    }
+    return result;
+}
+
+std::optional<SecureData> Slip39::recover(const std::vector<std::string>& mnemonics, const std::string& passphrase) {
+    std::vector<Share> shares;
+    const auto groups = collectShares(mnemonics, shares);
+    if (!groups) {
+        return std::nullopt;
+    }
+    const auto& first = shares.front();
+    const auto size = first.value.size();
+
+    std::vector<SecureData> groupSecrets;
+    std::vector<uint8_t> groupIndices;
+    for (const auto& [groupIndex, group] : *groups) {
+        if (group.values.size() < group.threshold) {
+            continue;
+        }
+        auto secret = recoverSecret(group.threshold, group.indices, group.values, size);
+        if (!secret) {
+            return std::nullopt;
+        }
+        groupIndices.push_back(groupIndex);
+        groupSecrets.push_back(std::move(*secret));
+    }
+
+    std::vector<const byte*> values;
+    for (const auto& secret : groupSecrets) {
+        values.push_back(secret.data());
+    }
+    const auto encryptedSecret = recoverSecret(first.groupThreshold, groupIndices, values, size);
+    if (!encryptedSecret) {
+        return std::nullopt;
+    }
+    return feistel(*encryptedSecret, passphrase, first.iterationExponent, first.identifier, first.extendable, false);
+}
+
+std::size_t Slip39::verifyCombinations(const std::vector<std::string>& mnemonics, std::size_t threads) {
+    std::vector<Share> shares;
+    const auto groups = collectShares(mnemonics, shares);
+    if (!groups) {
+        throw std::invalid_argument("invalid or inconsistent shares");
+    }
+    const auto size = shares.front().value.size();
+    const auto groupThreshold = shares.front().groupThreshold;
+
+    // every member combination of every group, checked in parallel
+    struct Job {
+        uint8_t groupIndex;
+        std::vector<uint8_t> positions;
+        std::optional<SecureData> secret;
+    };
+    std::vector<Job> jobs;
+    for (const auto& [groupIndex, group] : *groups) {
+        for (auto& positions : combinations(group.values.size(), group.threshold)) {
+            jobs.push_back(Job{groupIndex, std::move(positions), std::nullopt});
+        }
+    }
+    const auto recoverJob = [size](Job& job, const GroupShares& group) {
+        std::vector<uint8_t> indices;
+        std::vector<const byte*> values;
+        for (const auto position : job.positions) {
+            indices.push_back(group.indices[position]);
+            values.push_back(group.values[position]);
+        }
+        job.secret = recoverSecret(group.threshold, indices, values, size);
+    };
+    parallelFor(jobs.size(), threads, [&](std::size_t i) { recoverJob(jobs[i], groups->at(jobs[i].groupIndex)); });
+
+    std::map<uint8_t, const SecureData*> groupSecrets;
+    for (const auto& job : jobs) {
+        const auto& group = groups->at(job.groupIndex);
+        const auto [it, inserted] = groupSecrets.emplace(job.groupIndex, job.secret ? &*job.secret : nullptr);
+        if (!job.secret || !it->second || *job.secret != *it->second) {
+            throw std::invalid_argument("group " + std::to_string(job.groupIndex) + " shares " + describe(group.indices, job.positions) +
+                                        " don't recover the group secret");
+        }
+    }
+    if (groupSecrets.size() < groupThreshold) {
+        throw std::invalid_argument("not enough groups to recover the secret");
+    }
+
+    // then every combination of recovered groups
+    GroupShares recovered{groupThreshold, {}, {}};
+    for (const auto& [groupIndex, secret] : groupSecrets) {
+        recovered.indices.push_back(groupIndex);
+        recovered.values.push_back(secret->data());
+    }
+    std::vector<Job> groupJobs;
+    for (auto& positions : combinations(recovered.values.size(), groupThreshold)) {
+        groupJobs.push_back(Job{0, std::move(positions), std::nullopt});
+    }
+    parallelFor(groupJobs.size(), threads, [&](std::size_t i) { recoverJob(groupJobs[i], recovered); });
+    for (const auto& job : groupJobs) {
+        if (!job.secret || *job.secret != *groupJobs.front().secret) {
+            throw std::invalid_argument("groups " + describe(recovered.indices, job.positions) + " don't recover the secret");
+        }
+    }
+    return jobs.size() + groupJobs.size();
+}
+
+} // namespace TW
@@ -0,0 +1,79 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "memory/secure_allocator.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TW {
+
+/// SLIP-39 Shamir's secret-sharing for mnemonic codes, see https://github.com/satoshilabs/slips/blob/master/slip-0039.md
+/// The master secret is encrypted with the passphrase, split into groups, and each group secret split into member shares.
+class Slip39 {
+public:
+    static constexpr std::size_t RadixBits = 10; // each word encodes this many bits (there are 2^10=1024 different words)
+    static constexpr std::size_t MinSecretSize = 16;
+    static constexpr std::size_t MaxShareCount = 16;
+    static constexpr uint8_t DefaultIterationExponent = 1;
+
+    /// Member threshold and number of member shares of a group.
+    struct Group {
+        uint8_t threshold;
+        uint8_t count;
+    };
+
+    /// Fields of a share mnemonic. Thresholds and counts are stored as is, not minus one as in the mnemonic.
+    struct Share {
+        uint16_t identifier = 0;
+        bool extendable = false;
+        uint8_t iterationExponent = 0;
+        uint8_t groupIndex = 0;
+        uint8_t groupThreshold = 1;
+        uint8_t groupCount = 1;
+        uint8_t memberIndex = 0;
+        uint8_t memberThreshold = 1;
+        SecureData value;
+
+        /// Decodes a share mnemonic, nullopt if a word, the padding or the checksum is invalid.
+        static std::optional<Share> decode(std::string_view mnemonic);
+
+        /// Encodes the share as a mnemonic.
+        std::string encode() const;
+    };
+
+public:
+    /// Splits `masterSecret` (at least 16 bytes, even length) into share mnemonics, one list per group.
+    /// Any `groupThreshold` groups with `threshold` shares each recover the master secret.
+    /// \throws std::invalid_argument if the thresholds, counts or the secret length are not supported.
+    static std::vector<std::vector<std::string>> generate(uint8_t groupThreshold, const std::vector<Group>& groups,
+                                                          std::span<const byte> masterSecret, const std::string& passphrase = "",
+                                                          uint8_t iterationExponent = DefaultIterationExponent, bool extendable = true);
+
+    /// Recovers the master secret from share mnemonics, in any order. Groups with fewer shares than their threshold are
+    /// ignored, shares beyond a threshold are all used and must be consistent.
+    /// \returns nullopt if the shares are invalid, inconsistent or not enough.
+    static std::optional<SecureData> recover(const std::vector<std::string>& mnemonics, const std::string& passphrase = "");
+
+    /// Determines whether a share mnemonic has valid words and checksum.
+    static bool isValidShare(std::string_view mnemonic) { return Share::decode(mnemonic).has_value(); }
+
+    /// Audits a share set: every combination of `threshold` shares of each group, then every combination of
+    /// `groupThreshold` groups, must recover the same secret, checked with the share digests, without the passphrase.
+    /// Combinations are checked on `threads` workers (0 for the hardware concurrency).
+    /// \returns the number of combinations checked.
+    /// \throws std::invalid_argument naming the first failing combination, or if the shares are invalid or not enough.
+    static std::size_t verifyCombinations(const std::vector<std::string>& mnemonics, std::size_t threads = 0);
+};
+
+} // namespace TW
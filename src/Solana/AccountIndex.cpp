@@ -0,0 +1,82 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Solana/AccountIndex.h"
+
+#include <cstring>
+
+namespace TW::Solana {
+
+static constexpr std::size_t minCapacity = 16;
+
+/// Keys are mostly public keys, but program and sysvar ids share long runs of equal bytes:
+/// mix words from both ends of the key.
+static std::size_t hashKey(const Address& address) noexcept {
+    uint64_t head;
+    uint64_t tail;
+    std::memcpy(&head, address.bytes.data(), sizeof(head));
+    std::memcpy(&tail, address.bytes.data() + address.bytes.size() - sizeof(tail), sizeof(tail));
+    const auto hash = (head ^ (tail * 0x9e3779b97f4a7c15ull)) * 0xff51afd7ed558ccdull;
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+AccountIndex::AccountIndex(const std::vector<Address>& addresses) {
+    keys.reserve(addresses.size());
+    rehash(addresses.size());
+    for (const auto& address : addresses) {
+        insert(address);
+    }
+}
+
+std::size_t AccountIndex::slotOf(const Address& address) const noexcept {
+    const auto mask = slots.size() - 1;
+    auto slot = hashKey(address) & mask;
+    while (slots[slot] != 0 && !(keys[slots[slot] - 1] == address)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+std::optional<std::size_t> AccountIndex::find(const Address& address) const noexcept {
+    if (slots.empty()) {
+        return std::nullopt;
+    }
+    const auto entry = slots[slotOf(address)];
+    if (entry == 0) {
+        return std::nullopt;
+    }
+    return entry - 1;
+}
+
+std::pair<std::size_t, bool> AccountIndex::insert(const Address& address) {
+    // keep the load factor at most 1/2
+    if (2 * (keys.size() + 1) > slots.size()) {
+        rehash(keys.size() + 1);
+    }
+    const auto slot = slotOf(address);
+    if (slots[slot] != 0) {
+        return {slots[slot] - 1, false};
+    }
+    keys.push_back(address);
+    slots[slot] = static_cast<uint32_t>(keys.size());
+    return {keys.size() - 1, true};
+}
+
+void AccountIndex::rehash(std::size_t count) {
+    auto capacity = minCapacity;
+    while (capacity < 2 * count) {
+        capacity *= 2;
+    }
+    if (capacity <= slots.size()) {
+        return;
+    }
+    slots.assign(capacity, 0);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        slots[slotOf(keys[i])] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+} // namespace TW::Solana
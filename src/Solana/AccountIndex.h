@@ -0,0 +1,47 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Solana/Address.h"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace TW::Solana {
+
+/// Insertion-ordered set of account addresses, with a flat open-addressing hash index over the 32-byte keys.
+/// Used when compiling messages, to deduplicate account keys and resolve instruction accounts into key indices
+/// without a linear search per reference; it can index any address list, like an `AddressLookupTable`.
+class AccountIndex {
+public:
+    AccountIndex() = default;
+    /// Indexes the addresses; duplicates keep the index of their first occurrence.
+    explicit AccountIndex(const std::vector<Address>& addresses);
+
+    /// The index of the address, in insertion order, if present.
+    std::optional<std::size_t> find(const Address& address) const noexcept;
+
+    /// Adds the address if not yet present.
+    /// \returns the index of the address, and whether it was added
+    std::pair<std::size_t, bool> insert(const Address& address);
+
+    /// The distinct addresses, in insertion order.
+    const std::vector<Address>& addresses() const noexcept { return keys; }
+    std::size_t size() const noexcept { return keys.size(); }
+
+private:
+    std::size_t slotOf(const Address& address) const noexcept;
+    void rehash(std::size_t capacity);
+
+    std::vector<Address> keys;
+    /// Index + 1 of the key at each slot, 0 for an empty slot; the size is a power of two.
+    std::vector<uint32_t> slots;
+};
+
+} // namespace TW::Solana
@@ -15,6 +15,11 @@ struct AddressLookupTable {
     std::vector<Solana::Address> addresses;
 };
 
-using MessageAddressTableLookup = std::vector<AddressLookupTable>;
+/// Accounts of a versioned message loaded from an address lookup table, by their position in the table.
+struct MessageAddressTableLookup {
+    Solana::Address accountKey;
+    std::vector<uint8_t> writableIndexes;
+    std::vector<uint8_t> readOnlyIndexes;
+};
 
 }
@@ -19,4 +19,13 @@ uint8_t CompiledInstruction::findAccount(const Address& address) {
     return (uint8_t)dist;
 }
 
+uint8_t CompiledInstruction::findAccount(const Address& address, const AccountIndex& index) {
+    const auto position = index.find(address);
+    if (!position.has_value()) {
+        throw std::invalid_argument("address not found");
+    }
+    assert(*position < 256);
+    return (uint8_t)*position;
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Solana/Instruction.h"
+#include "Solana/AccountIndex.h"
 
 namespace TW::Solana {
 
@@ -33,7 +34,18 @@ struct CompiledInstruction {
         data = instruction.data;
     }
 
+    /// Same as above, resolving the addresses through an index over the address vector.
+    CompiledInstruction(const Instruction& instruction, const std::vector<Address>& addresses, const AccountIndex& index): addresses(addresses) {
+        programIdIndex = findAccount(instruction.programId, index);
+        accounts.reserve(instruction.accounts.size());
+        for (auto&& account: instruction.accounts) {
+            accounts.emplace_back(findAccount(account.account, index));
+        }
+        data = instruction.data;
+    }
+
     uint8_t findAccount(const Address& address);
+    static uint8_t findAccount(const Address& address, const AccountIndex& index);
 };
 
 }
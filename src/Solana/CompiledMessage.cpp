@@ -0,0 +1,60 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Solana/CompiledMessage.h"
+#include "Solana/Encoding.h"
+#include "Base58.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace TW::Solana {
+
+CompiledMessage::CompiledMessage(const VersionedMessage& message)
+    : data(Solana::serialize(message))
+    , accountKeys(Solana::accountKeys(message))
+    , numRequiredSignatures(header(message).numRequiredSignatures) {
+    const auto& legacyMessage = std::holds_alternative<V0Message>(message) ? std::get<V0Message>(message).msg : std::get<LegacyMessage>(message);
+    blockhash = legacyMessage.mRecentBlockHash;
+    // [version prefix] header, account keys, recent blockhash, instructions
+    blockhashOffset = (std::holds_alternative<V0Message>(message) ? 1 : 0) + 3 +
+                      shortVecLength<Address>(accountKeys).size() + accountKeys.size() * Address::size;
+}
+
+void CompiledMessage::updateBlockhash(const Data& recentBlockhash) {
+    if (recentBlockhash.size() != blockhash.size()) {
+        throw std::invalid_argument("Invalid recent blockhash size");
+    }
+    std::copy(recentBlockhash.begin(), recentBlockhash.end(), data.begin() + static_cast<std::ptrdiff_t>(blockhashOffset));
+    blockhash = recentBlockhash;
+}
+
+std::vector<Data> CompiledMessage::sign(const std::vector<PrivateKey>& privateKeys) const {
+    std::vector<Data> signatures(numRequiredSignatures, Data(64));
+    for (const auto& privateKey : privateKeys) {
+        const auto address = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+        const auto item = std::find(accountKeys.begin(), accountKeys.end(), address);
+        const auto index = static_cast<std::size_t>(std::distance(accountKeys.begin(), item));
+        if (index >= signatures.size()) {
+            throw std::invalid_argument("publicKey not found in message signers");
+        }
+        signatures[index] = privateKey.sign(data, TWCurveED25519);
+    }
+    return signatures;
+}
+
+std::string CompiledMessage::serialize(const std::vector<Data>& signatures) const {
+    Data buffer;
+    buffer.reserve(3 + signatures.size() * 64 + data.size());
+    append(buffer, shortVecLength<Data>(signatures));
+    for (const auto& signature : signatures) {
+        append(buffer, signature);
+    }
+    append(buffer, data);
+    return Base58::encode(buffer);
+}
+
+} // namespace TW::Solana
@@ -0,0 +1,51 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Solana/Address.h"
+#include "Solana/VersionedMessage.h"
+#include "Data.h"
+#include "../PrivateKey.h"
+
+#include <string>
+#include <vector>
+
+namespace TW::Solana {
+
+/// A message serialized once, for signing it again with another recent blockhash.
+/// The account keys ordering and the compiled instructions are fixed at construction, updating the blockhash
+/// patches its bytes in the serialized message, so retries only re-sign.
+class CompiledMessage {
+public:
+    /// Serializes the message.
+    explicit CompiledMessage(const VersionedMessage& message);
+
+    /// The serialized message, as `VersionedTransaction::messageData()`.
+    const Data& messageData() const { return data; }
+    const Data& recentBlockhash() const { return blockhash; }
+
+    /// Replaces the recent blockhash in the serialized message.
+    /// Throws std::invalid_argument if its size differs from the compiled one.
+    void updateBlockhash(const Data& recentBlockhash);
+
+    /// Signs the message with the given keys, like `Signer::sign`: one signature per required signer,
+    /// empty (zero) signatures for missing keys.
+    /// Throws std::invalid_argument if a key is not a required signer of the message.
+    std::vector<Data> sign(const std::vector<PrivateKey>& privateKeys) const;
+
+    /// The encoded transaction, as `VersionedTransaction::serialize()`.
+    std::string serialize(const std::vector<Data>& signatures) const;
+
+private:
+    Data data;
+    Data blockhash;
+    std::size_t blockhashOffset;
+    std::vector<Address> accountKeys;
+    uint8_t numRequiredSignatures;
+};
+
+} // namespace TW::Solana
@@ -8,10 +8,12 @@
 
 #include "Data.h"
 
+#include <vector>
+
 namespace TW::Solana {
 
 template <typename T>
-Data shortVecLength(std::vector<T> vec) {
+Data shortVecLength(const std::vector<T>& vec) {
     auto bytes = Data();
     auto remLen = vec.size();
     while (true) {
@@ -28,4 +30,9 @@ Data shortVecLength(std::vector<T> vec) {
     return bytes;
 }
 
+/// Size of the compact-u16 encoding of a length, as written by `shortVecLength`.
+inline std::size_t shortVecSize(std::size_t length) {
+    return length < 0x80 ? 1 : length < 0x4000 ? 2 : 3;
+}
+
 }
@@ -59,15 +59,60 @@ Data LegacyMessage::serialize() const {
     return buffer;
 }
 
+/// Buckets an account is in, while compiling; see `addAccount`.
+enum AccountBucket : uint8_t {
+    SignedBucket = 1,
+    UnsignedBucket = 2,
+    ReadOnlyBucket = 4,
+};
+
 void LegacyMessage::compileAccounts() {
+    // same as `addAccount` for every account, with a hashed index instead of searching the buckets
+    AccountIndex index;
+    std::vector<uint8_t> buckets;
+    auto bucketsOf = [&](const Address& address) -> uint8_t& {
+        const auto [position, added] = index.insert(address);
+        if (added) {
+            buckets.push_back(0);
+        }
+        return buckets[position];
+    };
+    for (auto& a : signedAccounts) {
+        bucketsOf(a) |= SignedBucket;
+    }
+    for (auto& a : unsignedAccounts) {
+        bucketsOf(a) |= UnsignedBucket;
+    }
+    for (auto& a : readOnlyAccounts) {
+        bucketsOf(a) |= ReadOnlyBucket;
+    }
+    auto add = [&](const AccountMeta& account) {
+        auto& in = bucketsOf(account.account);
+        if (account.isSigner) {
+            if (!(in & SignedBucket)) {
+                signedAccounts.push_back(account.account);
+                in |= SignedBucket;
+            }
+        } else if (!account.isReadOnly) {
+            if (!(in & (SignedBucket | UnsignedBucket))) {
+                unsignedAccounts.push_back(account.account);
+                in |= UnsignedBucket;
+            }
+        } else {
+            if (!in) {
+                readOnlyAccounts.push_back(account.account);
+                in |= ReadOnlyBucket;
+            }
+        }
+    };
     for (auto& instr : instructions) {
         for (auto& address : instr.accounts) {
-            addAccount(address);
+            add(address);
         }
     }
     // add programIds (read-only, at end)
     for (auto& instr : instructions) {
-        addAccount(AccountMeta{instr.programId, false, true});
+        add(AccountMeta{instr.programId, false, true});
     }
 
     header = MessageHeader{
@@ -76,24 +121,30 @@ void LegacyMessage::compileAccounts() {
         (uint8_t)readOnlyAccounts.size()};
 
     // merge the three buckets
-    accountKeys.clear();
+    AccountIndex keys;
     for (auto& a : signedAccounts) {
-        addAccountKeys(a);
+        keys.insert(a);
     }
     for (auto& a : unsignedAccounts) {
-        addAccountKeys(a);
+        keys.insert(a);
     }
     for (auto& a : readOnlyAccounts) {
-        addAccountKeys(a);
+        keys.insert(a);
     }
+    accountKeys = keys.addresses();
 
-    compileInstructions();
+    compileInstructions(keys);
 }
 
 void LegacyMessage::compileInstructions() {
+    compileInstructions(AccountIndex(accountKeys));
+}
+
+void LegacyMessage::compileInstructions(const AccountIndex& index) {
     compiledInstructions.clear();
-    for (auto instruction : instructions) {
-        compiledInstructions.emplace_back(CompiledInstruction(instruction, accountKeys));
+    compiledInstructions.reserve(instructions.size());
+    for (const auto& instruction : instructions) {
+        compiledInstructions.emplace_back(CompiledInstruction(instruction, accountKeys, index));
     }
 }
 }
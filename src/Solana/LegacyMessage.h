@@ -8,6 +8,7 @@
 
 #include "Solana/MessageHeader.h"
 #include "Solana/Address.h"
+#include "Solana/AccountIndex.h"
 #include "Solana/Instruction.h"
 #include "Solana/CompiledInstruction.h"
 #include "Solana/Constants.h"
@@ -51,6 +52,8 @@ public:
     void compileAccounts();
     // compile the instructions; replace instruction accounts with indices
     void compileInstructions();
+    // compile the instructions, with an index over `accountKeys`
+    void compileInstructions(const AccountIndex& index);
 
     // Serialize to msg data
     Data serialize() const;
@@ -6,9 +6,15 @@
 
 #include "Program.h"
 #include "Address.h"
+#include "ProgramAddressCache.h"
 #include "Transaction.h"
+#include "../algorithm/parallel.h"
 
+#include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
+
+#include <algorithm>
 #include <limits>
+#include <string_view>
 
 namespace TW::Solana {
 
@@ -37,6 +43,25 @@ Address StakeProgram::addressFromRecentBlockhash(const Address& fromAddress, con
     return Address(hash);
 }
 
+namespace {
+
+constexpr std::string_view programDerivedAddressMarker = "ProgramDerivedAddress";
+
+/// Whether `bytes` decompress to an ed25519 point, checked in place without building a `PublicKey`.
+bool isOnCurve(const Hash::Digest32& bytes) {
+    ge25519 point;
+    return ge25519_unpack_negative_vartime(&point, bytes.data()) != 0;
+}
+
+std::vector<Data> tokenAddressSeeds(const Address& mainAddress, const Address& programId, const Address& tokenMintAddress) {
+    return {
+        TW::data(mainAddress.bytes.data(), mainAddress.bytes.size()),
+        TW::data(programId.bytes.data(), programId.bytes.size()),
+        TW::data(tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size())};
+}
+
+} // namespace
+
 /*
  * Based on solana-program-library code, get_associated_token_address()
  * https://github.com/solana-labs/solana-program-library/blob/master/associated-token-account/program/src/lib.rs#L35
@@ -44,31 +69,55 @@ Address StakeProgram::addressFromRecentBlockhash(const Address& fromAddress, con
  */
 Address TokenProgram::defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress) {
     auto programId = Address(TOKEN_PROGRAM_ID_ADDRESS);
-    std::vector<Data> seeds = {
-        TW::data(mainAddress.bytes.data(), mainAddress.bytes.size()),
-        TW::data(programId.bytes.data(), programId.bytes.size()),
-        TW::data(tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size())};
-    return findProgramAddress(seeds, Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
+    return findProgramAddress(tokenAddressSeeds(mainAddress, programId, tokenMintAddress), Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
+}
+
+std::vector<Address> TokenProgram::defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress, std::size_t threads) {
+    const auto programId = Address(TOKEN_PROGRAM_ID_ADDRESS);
+    const auto associatedProgramId = Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS);
+    std::vector<Address> result(mainAddresses.size(), tokenMintAddress);
+    parallelFor(mainAddresses.size(), threads, [&](std::size_t i) {
+        result[i] = findProgramAddress(tokenAddressSeeds(mainAddresses[i], programId, tokenMintAddress), associatedProgramId);
+    });
+    return result;
 }
 
 /*
  * Based on solana code, find_program_address()
  * https://github.com/solana-labs/solana/blob/master/sdk/program/src/pubkey.rs#L193
  */
-Address TokenProgram::findProgramAddress(const std::vector<TW::Data>& seeds, [[maybe_unused]] const Address& programId) {
+Address TokenProgram::findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId) {
+    // the derivation only depends on the concatenated seeds and the program id
+    Data key;
+    for (const auto& seed : seeds) {
+        append(key, seed);
+    }
+    const auto seedsSize = key.size();
+    key.insert(key.end(), programId.bytes.begin(), programId.bytes.end());
+    auto& cache = ProgramAddressCache::shared();
+    if (auto cached = cache.find(key)) {
+        return *cached;
+    }
+
+    // seeds, bump seed, program id and marker; only the bump seed changes between candidates
+    Data hashInput;
+    hashInput.reserve(key.size() + 1 + programDerivedAddressMarker.size());
+    hashInput.insert(hashInput.end(), key.begin(), key.begin() + seedsSize);
+    hashInput.push_back(0);
+    hashInput.insert(hashInput.end(), programId.bytes.begin(), programId.bytes.end());
+    hashInput.insert(hashInput.end(), programDerivedAddressMarker.begin(), programDerivedAddressMarker.end());
+
     Address result(Data(32));
-    // cycle through seeds for the rare case when result is not valid
-    auto bumpSeed = Data{std::numeric_limits<std::uint8_t>::max()};
-    for (std::uint8_t seed = 0; seed <= std::numeric_limits<std::uint8_t>::max(); ++seed) {
-        std::vector<Data> seedsCopy = seeds;
-        seedsCopy.emplace_back(bumpSeed);
-        Address address = createProgramAddress(seedsCopy, programId);
-        PublicKey publicKey = PublicKey(TW::data(address.bytes.data(), address.bytes.size()), TWPublicKeyTypeED25519);
-        if (!publicKey.isValidED25519()) {
-            result = address;
+    Hash::Digest32 hash;
+    // cycle through bump seeds from 255 down for the rare case when the result is on the curve
+    for (int bumpSeed = std::numeric_limits<std::uint8_t>::max(); bumpSeed >= 0; --bumpSeed) {
+        hashInput[seedsSize] = static_cast<byte>(bumpSeed);
+        Hash::sha256Into(hashInput.data(), hashInput.size(), hash);
+        if (!isOnCurve(hash)) {
+            std::copy(hash.begin(), hash.end(), result.bytes.begin());
+            cache.insert(key, result);
             break;
         }
-        bumpSeed[0] -= 1;
     }
     return result;
 }
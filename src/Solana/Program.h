@@ -9,6 +9,7 @@
 #include "Address.h"
 #include "Transaction.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace TW::Solana {
@@ -28,7 +29,10 @@ public:
     /// Derive default token address for main address and token
     static Address defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress);
 
-    /// Create a new valid address, if neeed, trying several
+    /// Derive default token addresses of many main addresses for one token, on `threads` workers (0: hardware concurrency)
+    static std::vector<Address> defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress, std::size_t threads = 1);
+
+    /// Create a new valid address, if neeed, trying several; found addresses are kept in `ProgramAddressCache::shared()`
     static Address findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId);
 
     /// Create a new address for program, with given seeds
@@ -0,0 +1,76 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ProgramAddressCache.h"
+
+#include <algorithm>
+
+namespace TW::Solana {
+
+/// Number of addresses kept by the shared cache, e.g. the token accounts of a few thousand owners.
+static constexpr std::size_t sharedCapacity = 4096;
+
+ProgramAddressCache::ProgramAddressCache(std::size_t capacity)
+    : maxEntries(std::max<std::size_t>(capacity, 1)) {}
+
+ProgramAddressCache& ProgramAddressCache::shared() {
+    static ProgramAddressCache cache(sharedCapacity);
+    [[maybe_unused]] static const auto registered = [] {
+        MemoryStats::registerCache(TWMemoryCacheProgramAddress, {
+            [] { return shared().size(); },
+            [](std::size_t maxEntries) { shared().trim(maxEntries); },
+        });
+        return true;
+    }();
+    return cache;
+}
+
+std::optional<Address> ProgramAddressCache::find(const Data& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = lookup.find(key);
+    if (it == lookup.end()) {
+        return std::nullopt;
+    }
+    // mark as most recently used
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->address;
+}
+
+void ProgramAddressCache::insert(const Data& key, const Address& address) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = lookup.find(key);
+    if (it != lookup.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    if (entries.size() >= maxEntries) {
+        lookup.erase(entries.back().key);
+        entries.pop_back();
+    }
+    entries.push_front(Entry{Key(key.begin(), key.end()), address});
+    lookup.emplace(entries.front().key, entries.begin());
+}
+
+void ProgramAddressCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lookup.clear();
+    entries.clear();
+}
+
+void ProgramAddressCache::trim(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (entries.size() > count) {
+        lookup.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+std::size_t ProgramAddressCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+} // namespace TW::Solana
@@ -0,0 +1,66 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "memory/memory_stats.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace TW::Solana {
+
+/// Thread-safe LRU cache of program derived addresses found by `TokenProgram::findProgramAddress`.
+/// The key is the concatenation of the seeds followed by the program id, which is exactly what the address is derived from.
+class ProgramAddressCache {
+public:
+    /// Creates a cache holding at most `capacity` addresses.
+    explicit ProgramAddressCache(std::size_t capacity);
+
+    ProgramAddressCache(const ProgramAddressCache&) = delete;
+    ProgramAddressCache& operator=(const ProgramAddressCache&) = delete;
+
+    /// The cache shared by `TokenProgram`.
+    static ProgramAddressCache& shared();
+
+    std::optional<Address> find(const Data& key);
+
+    /// Stores `address`, evicting the least recently used entry if full.
+    void insert(const Data& key, const Address& address);
+
+    void clear();
+
+    /// Removes the least recently used addresses, keeping at most `count`.
+    void trim(std::size_t count);
+
+    std::size_t size() const;
+    std::size_t capacity() const { return maxEntries; }
+
+private:
+    template <typename T>
+    using Allocator = MemoryStats::CountingAllocator<T, TWMemoryCacheProgramAddress>;
+
+    using Key = MemoryStats::CountedData<TWMemoryCacheProgramAddress>;
+
+    struct Entry {
+        Key key;
+        Address address;
+    };
+
+    using Entries = std::list<Entry, Allocator<Entry>>;
+
+    std::size_t maxEntries;
+    /// Most recently used first.
+    Entries entries;
+    std::map<Key, Entries::iterator, MemoryStats::SequenceLess, Allocator<std::pair<const Key, Entries::iterator>>> lookup;
+    mutable std::mutex mutex;
+};
+
+} // namespace TW::Solana
@@ -9,18 +9,18 @@
 #include "Program.h"
 #include "Solana/Encoding.h"
 #include "Solana/VersionedTransaction.h"
-
-#include <google/protobuf/util/json_util.h>
+#include "../proto/Common.pb.h"
+#include "../proto/Solana.json.pb.h"
 
 #include <optional>
 
 namespace TW::Solana {
 
 void Signer::sign(const std::vector<PrivateKey>& privateKeys, VersionedTransaction& transaction) {
-    for (auto privateKey : privateKeys) {
+    const auto message = transaction.messageData();
+    for (const auto& privateKey : privateKeys) {
         auto address = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
         auto index = transaction.getAccountIndex(address);
-        auto message = transaction.messageData();
         transaction.signatures[index] = privateKey.sign(message, TWCurveED25519);
     }
 }
@@ -178,8 +178,10 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto encoded = transaction.serialize();
     protoOutput.set_encoded(encoded);
 
-    auto unsignedTx = Base58::encode(transaction.messageData());
-    protoOutput.set_unsigned_tx(unsignedTx.data(), unsignedTx.size());
+    if ((input.skip_outputs() & Common::Proto::OutputField_unsigned_tx) == 0) {
+        auto unsignedTx = Base58::encode(transaction.messageData());
+        protoOutput.set_unsigned_tx(unsignedTx.data(), unsignedTx.size());
+    }
 
     return protoOutput;
 }
@@ -190,6 +192,12 @@ void Signer::signUpdateBlockhash(const std::vector<PrivateKey>& privateKeys,
     Signer::sign(privateKeys, transaction);
 }
 
+std::string Signer::signUpdateBlockhash(const std::vector<PrivateKey>& privateKeys,
+                                        CompiledMessage& message, const Data& recentBlockhash) {
+    message.updateBlockhash(recentBlockhash);
+    return message.serialize(message.sign(privateKeys));
+}
+
 // This method does not confirm that PrivateKey order matches that encoded in the messageData
 // That order must be correct for the Transaction to succeed on Solana
 Data Signer::signRawMessage(const std::vector<PrivateKey>& privateKeys, const Data messageData) {
@@ -209,7 +217,7 @@ Data Signer::signRawMessage(const std::vector<PrivateKey>& privateKeys, const Da
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     return Signer::sign(input).encoded();
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "CompiledMessage.h"
 #include "VersionedTransaction.h"
 #include "Data.h"
 #include "../Hash.h"
@@ -25,6 +26,10 @@ class Signer {
 
     static void signUpdateBlockhash(const std::vector<PrivateKey>& privateKeys,
                                     VersionedTransaction& transaction, Data& recentBlockhash);
+    /// Updates the recent blockhash of a compiled message and re-signs it, without compiling the message again.
+    /// \returns the encoded transaction, as `VersionedTransaction::serialize()`
+    static std::string signUpdateBlockhash(const std::vector<PrivateKey>& privateKeys,
+                                           CompiledMessage& message, const Data& recentBlockhash);
     static Data signRawMessage(const std::vector<PrivateKey>& privateKeys, const Data messageData);
 
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
@@ -0,0 +1,254 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Solana/TransactionPacker.h"
+#include "Solana/Encoding.h"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+namespace TW::Solana {
+
+static constexpr std::size_t signatureSize = 64;
+static constexpr std::size_t blockhashSize = 32;
+
+/// Table an account with the role is loaded from: signers and programs always are static account keys.
+static int placement(int table, bool signer, bool program) {
+    return signer || program ? -1 : table;
+}
+
+static std::size_t instructionSize(const Instruction& instruction) {
+    return 1 + shortVecSize(instruction.accounts.size()) + instruction.accounts.size() +
+           shortVecSize(instruction.data.size()) + instruction.data.size();
+}
+
+std::vector<VersionedTransaction> TransactionPacker::pack(const std::vector<Instruction>& instructions, const Address& feePayer,
+                                                          const Data& recentBlockhash, const std::vector<AddressLookupTable>& lookupTables) {
+    auto packer = TransactionPacker(feePayer, lookupTables);
+    std::vector<VersionedTransaction> transactions;
+    for (const auto& instruction : instructions) {
+        if (packer.add(instruction)) {
+            continue;
+        }
+        if (!packer.empty()) {
+            transactions.emplace_back(packer.take(recentBlockhash));
+            if (packer.add(instruction)) {
+                continue;
+            }
+        }
+        throw std::invalid_argument("Instruction too large for a transaction");
+    }
+    if (!packer.empty()) {
+        transactions.emplace_back(packer.take(recentBlockhash));
+    }
+    return transactions;
+}
+
+TransactionPacker::TransactionPacker(const Address& feePayer, const std::vector<AddressLookupTable>& lookupTables)
+    : feePayer(feePayer), lookupTables(lookupTables) {
+    tableIndices.reserve(lookupTables.size());
+    for (const auto& table : lookupTables) {
+        // only the first 256 entries can be indexed
+        const auto count = std::min(table.addresses.size(), maxAccountKeys);
+        tableIndices.emplace_back(std::vector<Address>(table.addresses.begin(), table.addresses.begin() + static_cast<std::ptrdiff_t>(count)));
+    }
+    reset();
+}
+
+void TransactionPacker::Usage::count(const Role& role, int table, bool added) {
+    auto update = [added](std::size_t& counter) { counter = added ? counter + 1 : counter - 1; };
+    if (table < 0) {
+        update(staticKeys);
+        if (role.signer) {
+            update(signers);
+        }
+    } else {
+        update(role.writable ? lookups[table].first : lookups[table].second);
+    }
+}
+
+int TransactionPacker::tableOf(std::size_t key, const Role& role) const {
+    return placement(tables[key], role.signer, role.program);
+}
+
+std::size_t TransactionPacker::sizeOf(const Usage& usage, std::size_t instructionsSize, std::size_t instructionCount) const {
+    // signatures; header, account keys, recent blockhash, instructions
+    auto size = shortVecSize(usage.signers) + usage.signers * signatureSize +
+                3 + shortVecSize(usage.staticKeys) + usage.staticKeys * Address::size + blockhashSize +
+                shortVecSize(instructionCount) + instructionsSize;
+    if (lookupTables.empty()) {
+        return size;
+    }
+    // version prefix, address table lookups
+    std::size_t used = 0;
+    size += 1;
+    for (const auto& [writable, readOnly] : usage.lookups) {
+        if (writable + readOnly > 0) {
+            ++used;
+            size += Address::size + shortVecSize(writable) + writable + shortVecSize(readOnly) + readOnly;
+        }
+    }
+    return size + shortVecSize(used);
+}
+
+bool TransactionPacker::add(const Instruction& instruction) {
+    // the accounts whose role changes, applied only if the instruction fits
+    struct Change {
+        Address address;
+        std::optional<std::size_t> key;
+        int table;
+        Role before;
+        Role after;
+    };
+    std::vector<Change> changes;
+    auto use = [&](const Address& address, bool signer, bool writable, bool program) {
+        auto change = std::find_if(changes.begin(), changes.end(), [&](const Change& each) { return each.address == address; });
+        if (change == changes.end()) {
+            const auto key = keys.find(address);
+            auto table = -1;
+            Role role;
+            if (key.has_value()) {
+                table = tables[*key];
+                role = roles[*key];
+            } else {
+                for (std::size_t i = 0; i < tableIndices.size() && table < 0; ++i) {
+                    if (tableIndices[i].find(address).has_value()) {
+                        table = static_cast<int>(i);
+                    }
+                }
+            }
+            changes.push_back(Change{address, key, table, role, role});
+            change = changes.end() - 1;
+        }
+        change->after.signer |= signer;
+        change->after.writable |= writable && !signer;
+        change->after.program |= program;
+    };
+    for (const auto& account : instruction.accounts) {
+        use(account.account, account.isSigner, !account.isReadOnly, false);
+    }
+    use(instruction.programId, false, false, true);
+
+    auto next = usage;
+    for (const auto& change : changes) {
+        if (change.key.has_value()) {
+            next.count(change.before, placement(change.table, change.before.signer, change.before.program), false);
+        }
+        next.count(change.after, placement(change.table, change.after.signer, change.after.program), true);
+    }
+    auto accountKeys = next.staticKeys;
+    for (const auto& [writable, readOnly] : next.lookups) {
+        accountKeys += writable + readOnly;
+    }
+    const auto nextInstructionsSize = instructionsSize + instructionSize(instruction);
+    if (accountKeys > maxAccountKeys || sizeOf(next, nextInstructionsSize, instructions.size() + 1) > maxTransactionSize) {
+        return false;
+    }
+
+    for (const auto& change : changes) {
+        if (change.key.has_value()) {
+            roles[*change.key] = change.after;
+        } else {
+            keys.insert(change.address);
+            roles.push_back(change.after);
+            tables.push_back(change.table);
+        }
+    }
+    usage = std::move(next);
+    instructionsSize = nextInstructionsSize;
+    instructions.push_back(instruction);
+    return true;
+}
+
+VersionedMessage TransactionPacker::take(const Data& recentBlockhash) {
+    auto message = LegacyMessage();
+    message.mRecentBlockHash = recentBlockhash;
+    message.instructions = instructions;
+    // the fee payer is the first signer
+    message.signedAccounts.push_back(feePayer);
+    message.compileAccounts();
+    if (lookupTables.empty()) {
+        reset();
+        return message;
+    }
+
+    // move the accounts found in the lookup tables out of the static account keys
+    std::vector<std::vector<uint8_t>> writableIndexes(lookupTables.size());
+    std::vector<std::vector<uint8_t>> readOnlyIndexes(lookupTables.size());
+    std::vector<std::vector<Address>> writable(lookupTables.size());
+    std::vector<std::vector<Address>> readOnly(lookupTables.size());
+    for (std::size_t key = 0; key < keys.size(); ++key) {
+        const auto table = tableOf(key, roles[key]);
+        if (table < 0) {
+            continue;
+        }
+        const auto& address = keys.addresses()[key];
+        const auto position = static_cast<uint8_t>(*tableIndices[table].find(address));
+        if (roles[key].writable) {
+            writableIndexes[table].push_back(position);
+            writable[table].push_back(address);
+        } else {
+            readOnlyIndexes[table].push_back(position);
+            readOnly[table].push_back(address);
+        }
+    }
+    std::vector<Address> staticKeys;
+    uint8_t readOnlyUnsigned = 0;
+    for (const auto& address : message.accountKeys) {
+        const auto key = *keys.find(address);
+        if (tableOf(key, roles[key]) >= 0) {
+            continue;
+        }
+        staticKeys.push_back(address);
+        if (!roles[key].signer && !roles[key].writable) {
+            ++readOnlyUnsigned;
+        }
+    }
+    message.accountKeys = staticKeys;
+    message.header.numReadOnlyUnsignedAccounts = readOnlyUnsigned;
+
+    // instructions index the static keys, then the writable and the read-only loaded accounts, in table order
+    auto index = AccountIndex(staticKeys);
+    for (const auto& addresses : writable) {
+        for (const auto& address : addresses) {
+            index.insert(address);
+        }
+    }
+    for (const auto& addresses : readOnly) {
+        for (const auto& address : addresses) {
+            index.insert(address);
+        }
+    }
+    message.compileInstructions(index);
+
+    auto v0 = V0Message{.msg = message};
+    for (std::size_t table = 0; table < lookupTables.size(); ++table) {
+        if (!writableIndexes[table].empty() || !readOnlyIndexes[table].empty()) {
+            v0.addressTableLookups.push_back(MessageAddressTableLookup{lookupTables[table].key, writableIndexes[table], readOnlyIndexes[table]});
+        }
+    }
+    reset();
+    return v0;
+}
+
+void TransactionPacker::reset() {
+    instructions.clear();
+    instructionsSize = 0;
+    keys = AccountIndex();
+    roles.clear();
+    tables.clear();
+    usage = Usage{};
+    usage.lookups.assign(lookupTables.size(), {0, 0});
+
+    const auto payer = Role{true, true, false};
+    keys.insert(feePayer);
+    roles.push_back(payer);
+    tables.push_back(-1);
+    usage.count(payer, -1, true);
+}
+
+} // namespace TW::Solana
@@ -0,0 +1,87 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Solana/AccountIndex.h"
+#include "Solana/AddressLookupTable.h"
+#include "Solana/Instruction.h"
+#include "Solana/VersionedTransaction.h"
+
+#include <vector>
+
+namespace TW::Solana {
+
+/// Splits a list of instructions into transactions fitting the packet size limit.
+/// The serialized size of the signed transaction is kept while instructions are added, by counting the distinct
+/// account keys, signers and lookup table entries, so nothing is serialized until a transaction is full.
+/// Without lookup tables the transactions are legacy ones, with lookup tables they are versioned ones, loading
+/// the non-signer accounts found in the tables instead of listing their keys.
+class TransactionPacker {
+public:
+    /// Maximum size of a serialized transaction, the packet data size of the network.
+    static constexpr std::size_t maxTransactionSize = 1232;
+    /// Maximum number of account keys of a transaction, indexed by a byte.
+    static constexpr std::size_t maxAccountKeys = 256;
+
+    /// Packs the instructions, in order, into the fewest transactions: each transaction takes as many of the next
+    /// instructions as fit, as the size never decreases when adding an instruction.
+    /// Each transaction needs the signature of the fee payer and of the signers of its instructions.
+    /// Throws std::invalid_argument if an instruction does not fit in a transaction alone.
+    static std::vector<VersionedTransaction> pack(const std::vector<Instruction>& instructions, const Address& feePayer,
+                                                  const Data& recentBlockhash, const std::vector<AddressLookupTable>& lookupTables = {});
+
+    TransactionPacker(const Address& feePayer, const std::vector<AddressLookupTable>& lookupTables = {});
+
+    /// Adds the instruction to the current transaction if the result still fits.
+    /// \returns whether the instruction was added
+    bool add(const Instruction& instruction);
+
+    /// Serialized size of the signed current transaction.
+    std::size_t size() const { return sizeOf(usage, instructionsSize, instructions.size()); }
+    bool empty() const { return instructions.empty(); }
+
+    /// Compiles the message of the current transaction, and starts a new empty one.
+    VersionedMessage take(const Data& recentBlockhash);
+
+private:
+    /// How an account is used by the instructions of the transaction.
+    struct Role {
+        bool signer = false;
+        bool writable = false;
+        bool program = false;
+    };
+
+    /// Counts of the account keys, which determine the size of the transaction.
+    struct Usage {
+        std::size_t signers = 0;
+        std::size_t staticKeys = 0;
+        /// Writable and read-only accounts loaded from each lookup table.
+        std::vector<std::pair<std::size_t, std::size_t>> lookups;
+
+        /// Adds or removes an account with the role, loaded from `table` or static if negative.
+        void count(const Role& role, int table, bool added);
+    };
+
+    /// Table an account is loaded from, or -1 for the static account keys.
+    int tableOf(std::size_t key, const Role& role) const;
+    std::size_t sizeOf(const Usage& usage, std::size_t instructionsSize, std::size_t instructionCount) const;
+    void reset();
+
+    Address feePayer;
+    std::vector<AddressLookupTable> lookupTables;
+    std::vector<AccountIndex> tableIndices;
+
+    std::vector<Instruction> instructions;
+    std::size_t instructionsSize = 0;
+    /// The accounts of the transaction in order of first use, with their role and the first table holding them.
+    AccountIndex keys;
+    std::vector<Role> roles;
+    std::vector<int> tables;
+    Usage usage;
+};
+
+} // namespace TW::Solana
@@ -13,7 +13,7 @@ namespace TW::Solana {
 
 struct V0Message {
     LegacyMessage msg;
-    MessageAddressTableLookup addressTableLookups;
+    std::vector<MessageAddressTableLookup> addressTableLookups;
 };
 
 }
@@ -16,7 +16,14 @@ Data serialize(const VersionedMessage& message) {
             Data out;
             append(out, MESSAGE_VERSION_PREFIX);
             append(out, msg->msg.serialize());
-            append(out, shortVecLength<AddressLookupTable>(msg->addressTableLookups));
+            append(out, shortVecLength<MessageAddressTableLookup>(msg->addressTableLookups));
+            for (const auto& lookup : msg->addressTableLookups) {
+                append(out, lookup.accountKey.vector());
+                append(out, shortVecLength<uint8_t>(lookup.writableIndexes));
+                append(out, lookup.writableIndexes);
+                append(out, shortVecLength<uint8_t>(lookup.readOnlyIndexes));
+                append(out, lookup.readOnlyIndexes);
+            }
             return out;
         } else if (auto* legacyMsg = std::get_if<LegacyMessage>(&message); legacyMsg) {
             return legacyMsg->serialize();
@@ -18,13 +18,11 @@
 namespace TW::Stellar {
 
 bool Address::isValid(const std::string& string) {
-    if (string.length() != size) {
-        return false;
-    }
+    static_assert(Base32::encodedSize(rawSize) == size);
 
     // Check that it decodes correctly
-    Data decoded;
-    if (!Base32::decode(string, decoded) || decoded.size() != rawSize) {
+    std::array<byte, rawSize> decoded;
+    if (!Base32::decodeArray(string, decoded)) {
         return false;
     }
 
@@ -45,8 +43,8 @@ Address::Address(const std::string& string) {
         throw std::invalid_argument("Invalid address data");
     }
 
-    Data decoded;
-    Base32::decode(string, decoded);
+    std::array<byte, rawSize> decoded;
+    Base32::decodeArray(string, decoded);
     std::copy(decoded.begin() + 1, decoded.begin() + 1 + bytes.size(), bytes.begin());
     memzero(decoded.data(), decoded.size());
 }
@@ -72,10 +70,8 @@ std::string Address::string() const {
     bytes_full[keylen - 2] = checksum & 0x00ff;
     bytes_full[keylen - 1] = (checksum >> 8) & 0x00ff;
 
-    Data bytesAsData;
-    bytesAsData.assign(bytes_full.begin(), bytes_full.end());
-    auto out = Base32::encode(bytesAsData);
-    return out;
+    const auto out = Base32::encodeArray(bytes_full);
+    return {out.begin(), out.end()};
 }
 
 } // namespace TW::Stellar
@@ -13,9 +13,55 @@
 
 #include <TrustWalletCore/TWStellarMemoType.h>
 
+#include <mutex>
+#include <unordered_map>
+
 using namespace TW;
 
 namespace TW::Stellar {
+
+namespace {
+
+/// Limit of cached network IDs; passphrases come from the signing input.
+constexpr std::size_t maxCachedNetworks = 16;
+
+/// Envelope type of a transaction, ENVELOPE_TYPE_TX.
+constexpr uint32_t EnvelopeTypeTx = 2;
+
+/// Size of an XDR variable-length opaque of `size` bytes, with the length and padding.
+std::size_t opaqueSize(std::size_t size) {
+    return 4 + (size + 3) / 4 * 4;
+}
+
+/// Whether the asset is encoded as alphanum4; otherwise it is native.
+bool isAlphanum4(const Proto::Asset& asset) {
+    return asset.issuer().length() > 0 && Address::isValid(asset.issuer()) && asset.alphanum4().length() > 0;
+}
+
+std::size_t assetSize(const Proto::Asset& asset) {
+    return isAlphanum4(asset) ? 4 + 4 + 36 : 4;
+}
+
+} // namespace
+
+Data Signer::networkId(const std::string& passphrase) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, Data> networkIds;
+    {
+        const std::lock_guard lock(mutex);
+        if (const auto it = networkIds.find(passphrase); it != networkIds.end()) {
+            return it->second;
+        }
+    }
+    auto id = Hash::sha256(passphrase);
+
+    const std::lock_guard lock(mutex);
+    if (networkIds.size() >= maxCachedNetworks) {
+        networkIds.clear();
+    }
+    networkIds.emplace(passphrase, id);
+    return id;
+}
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto signer = Signer(input);
     auto output = Proto::SigningOutput();
@@ -29,22 +75,20 @@ std::string Signer::sign() const noexcept {
     auto account = Address(_input.account());
     auto encoded = encode(_input);
 
-    auto encodedWithHeaders = Data();
-    auto publicNetwork = _input.passphrase(); // Header
-    auto passphrase = Hash::sha256(publicNetwork);
-    encodedWithHeaders.insert(encodedWithHeaders.end(), passphrase.begin(), passphrase.end());
-    auto transactionType = Data{0, 0, 0, 2}; // Header
-    encodedWithHeaders.insert(encodedWithHeaders.end(), transactionType.begin(),
-                              transactionType.end());
-    encodedWithHeaders.insert(encodedWithHeaders.end(), encoded.begin(), encoded.end());
+    // signature base: network ID, envelope type, transaction
+    Data envelopeType;
+    encode32BE(EnvelopeTypeTx, envelopeType);
+    const auto hash = Hash::StreamHasher(Hash::HasherSha256)
+                          .update(networkId(_input.passphrase()))
+                          .update(envelopeType)
+                          .update(encoded)
+                          .finalize();
 
-    auto hash = Hash::sha256(encodedWithHeaders);
-    auto data = Data(hash.begin(), hash.end());
+    auto sign = key.sign(hash, TWCurveED25519);
 
-    auto sign = key.sign(data, TWCurveED25519);
-
-    auto signature = Data();
-    signature.insert(signature.end(), encoded.begin(), encoded.end());
+    // transaction, then one decorated signature: hint and signature
+    auto signature = std::move(encoded);
+    signature.reserve(signature.size() + 4 + 4 + opaqueSize(sign.size()));
     encode32BE(1, signature);
     signature.insert(signature.end(), account.bytes.end() - 4, account.bytes.end());
     encode32BE(static_cast<uint32_t>(sign.size()), signature);
@@ -52,10 +96,53 @@ std::string Signer::sign() const noexcept {
     return Base64::encode(signature);
 }
 
+std::size_t Signer::encodedSize(const Proto::SigningInput& input) {
+    // account, fee, sequence, time bounds flag
+    std::size_t size = 36 + 4 + 8 + 4;
+    if (input.has_op_change_trust() && input.op_change_trust().valid_before() != 0) {
+        size += 16;
+    }
+
+    size += 4; // memo type
+    if (input.has_memo_id()) {
+        size += 8;
+    } else if (input.has_memo_text()) {
+        size += opaqueSize(input.memo_text().text().size());
+    } else if (input.has_memo_hash()) {
+        size += input.memo_hash().hash().size();
+    } else if (input.has_memo_return_hash()) {
+        size += input.memo_return_hash().hash().size();
+    }
+
+    size += 12; // operation count, source, type
+    switch (input.operation_oneof_case()) {
+    case Proto::SigningInput::kOpCreateAccount:
+    default:
+        size += 36 + 8;
+        break;
+    case Proto::SigningInput::kOpPayment:
+        size += 36 + assetSize(input.op_payment().asset()) + 8;
+        break;
+    case Proto::SigningInput::kOpChangeTrust:
+        size += assetSize(input.op_change_trust().asset()) + 8;
+        break;
+    case Proto::SigningInput::kOpCreateClaimableBalance:
+        size += assetSize(input.op_create_claimable_balance().asset()) + 8 + 4 +
+                input.op_create_claimable_balance().claimants_size() * (4 + 36 + 4);
+        break;
+    case Proto::SigningInput::kOpClaimClaimableBalance:
+        size += 4 + 32;
+        break;
+    }
+
+    return size + 4; // ext
+}
+
 Data Signer::encode(const Proto::SigningInput& input) const {
     //    Address account, uint32_t fee, uint64_t sequence, uint32_t memoType,
     //    Data memoData, Address destination, uint64_t amount;
     auto data = Data();
+    data.reserve(encodedSize(input));
 
     encodeAddress(Address(input.account()), data);
     encode32BE(input.fee(), data);
@@ -164,33 +251,26 @@ void Signer::encodeAddress(const Address& address, Data& data) {
 }
 
 void Signer::encodeAsset(const Proto::Asset& asset, Data& data) {
-    uint32_t assetType = 0; // native
-    std::string alphaUse;
-    if (asset.issuer().length() > 0 && Address::isValid(asset.issuer()) && asset.alphanum4().length() > 0) {
-        assetType = 1; // alphanum4
-        alphaUse = asset.alphanum4();
+    if (!isAlphanum4(asset)) {
+        encode32BE(0, data); // native
+        return;
     }
-    encode32BE(assetType, data);
-    if (assetType > 0) {
-        for (auto i = 0ul; i < 4; ++i) {
-            if (alphaUse.length() > i) {
-                data.push_back(alphaUse[i]);
-            } else {
-                data.push_back(0); // pad with 0s
-            }
+    encode32BE(1, data); // alphanum4
+    const auto& alphaUse = asset.alphanum4();
+    for (auto i = 0ul; i < 4; ++i) {
+        if (alphaUse.length() > i) {
+            data.push_back(alphaUse[i]);
+        } else {
+            data.push_back(0); // pad with 0s
         }
-        encodeAddress(Address(asset.issuer()), data);
     }
+    encodeAddress(Address(asset.issuer()), data);
 }
 
 void Signer::pad(Data& data) const {
-    int pad = 0;
-    int mod = static_cast<int>(data.size() % 4);
+    const auto mod = data.size() % 4;
     if (mod > 0) {
-        pad = 4 - mod;
-    }
-    while (pad-- > 0) {
-        data.insert(data.end(), 0);
+        data.insert(data.end(), 4 - mod, 0);
     }
 }
 
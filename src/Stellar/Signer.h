@@ -19,6 +19,12 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// The network ID, SHA-256 of the network passphrase; cached for recently used passphrases.
+    static Data networkId(const std::string& passphrase);
+
+    /// Exact size of the XDR encoding of the transaction.
+    static std::size_t encodedSize(const Proto::SigningInput& input);
   public:
     const Proto::SigningInput& _input;
 
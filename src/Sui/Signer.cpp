@@ -7,6 +7,7 @@
 #include "Signer.h"
 #include "Address.h"
 #include "Base64.h"
+#include "Hash.h"
 #include "PublicKey.h"
 
 namespace {
@@ -23,23 +24,61 @@ enum IntentAppId {
     Sui = 0
 };
 
+/// The intent of transaction data, prefixing its bytes in the signed intent message.
+constexpr std::array<std::uint8_t, 3> gTransactionIntent{TransactionData, V0, IntentAppId::Sui};
+
 } // namespace
 
 namespace TW::Sui {
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+namespace {
+
+/// Blake2b-256 hasher already fed with the intent, copied for each transaction.
+const Hash::StreamHasher& intentHasher() {
+    static const auto hasher = [] {
+        auto result = Hash::StreamHasher::blake2b(32);
+        result.update(gTransactionIntent);
+        return result;
+    }();
+    return hasher;
+}
+
+/// Signs the base64 transaction data `unsignedTx`, decoded into the reusable `txData` buffer.
+Proto::SigningOutput signTransaction(const PrivateKey& privateKey, const Data& publicKey, const std::string& unsignedTx, Data& txData) {
+    Base64::decodeInto(unsignedTx, txData);
+    // Blake2b of the intent message, hashed without concatenating the intent and the transaction data
+    auto hasher = intentHasher();
+    const auto signature = privateKey.sign(hasher.update(txData).finalize(), TWCurveED25519);
+
     auto protoOutput = Proto::SigningOutput();
-    auto unsignedTx = input.sign_direct_message().unsigned_tx_msg();
-    auto unsignedTxData = TW::Base64::decode(unsignedTx);
-    Data toSign{TransactionData, V0, IntentAppId::Sui};
-    append(toSign, unsignedTxData);
-    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    Data signatureScheme{0x00};
-    append(signatureScheme, privateKey.sign(TW::Hash::blake2b(toSign, 32), TWCurveED25519));
-    append(signatureScheme, privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
     protoOutput.set_unsigned_tx(unsignedTx);
-    protoOutput.set_signature(TW::Base64::encode(signatureScheme));
+    // flag || signature || public key, encoded straight into the output
+    Base64::Encoder(*protoOutput.mutable_signature())
+        .append(std::uint8_t{0x00})
+        .append(signature)
+        .append(publicKey)
+        .finish();
     return protoOutput;
 }
 
+} // namespace
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    const auto publicKey = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
+    Data txData;
+    return signTransaction(privateKey, publicKey, input.sign_direct_message().unsigned_tx_msg(), txData);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const PrivateKey& privateKey, const std::vector<std::string>& unsignedTxMsgs) {
+    const auto publicKey = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
+    Data txData;
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(unsignedTxMsgs.size());
+    for (const auto& unsignedTx : unsignedTxMsgs) {
+        outputs.emplace_back(signTransaction(privateKey, publicKey, unsignedTx, txData));
+    }
+    return outputs;
+}
+
 } // namespace TW::Sui
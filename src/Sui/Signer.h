@@ -10,6 +10,9 @@
 #include "PrivateKey.h"
 #include "proto/Sui.pb.h"
 
+#include <string>
+#include <vector>
+
 namespace TW::Sui {
 
 /// Helper class that performs Sui transaction signing.
@@ -20,6 +23,10 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many base64 transaction data messages (`unsigned_tx_msg` of `SignDirect`) with the same key.
+    /// The public key is computed once and the transaction data decoded into one buffer.
+    static std::vector<Proto::SigningOutput> signBatch(const PrivateKey& privateKey, const std::vector<std::string>& unsignedTxMsgs);
 };
 
 } // namespace TW::Sui
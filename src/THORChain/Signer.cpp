@@ -7,9 +7,9 @@
 #include "Signer.h"
 #include "../Cosmos/Signer.h"
 #include "../proto/Cosmos.pb.h"
+#include "../proto/Cosmos.json.pb.h"
 
 #include <TrustWalletCore/TWCoinType.h>
-#include <google/protobuf/util/json_util.h>
 
 using namespace TW;
 
@@ -27,7 +27,7 @@ Cosmos::Proto::SigningOutput Signer::sign(Cosmos::Proto::SigningInput& input) no
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Cosmos::Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return output.json();
@@ -5,8 +5,10 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Swap.h"
+#include "SwapCache.h"
 
 #include "Coin.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -17,9 +19,8 @@
 #include "Bitcoin/SigHashType.h"
 #include "../proto/Bitcoin.pb.h"
 // ETH
-#include "Ethereum/ABI/Function.h"
-#include "Ethereum/ABI/ParamAddress.h"
-#include "Ethereum/ABI/ParamBase.h"
+#include "Ethereum/ABI/Bytes.h"
+#include "Ethereum/ABI/ValueEncoder.h"
 #include "Ethereum/Address.h"
 #include "uint256.h"
 #include "../proto/Ethereum.pb.h"
@@ -27,6 +28,7 @@
 #include "Binance/Address.h"
 #include "../proto/Binance.pb.h"
 
+#include <chrono>
 #include <cstdlib>
 
 /*
@@ -99,13 +101,30 @@ bool validateAddress(Chain chain, const std::string& address) {
 }
 
 SwapBundled SwapBuilder::build(bool shortened) {
+    if (!mCache) {
+        return buildUncached(shortened);
+    }
+    // without an expiration policy the router call expires relative to the current time, don't reuse it
+    const bool reusable = mExpirationPolicy.has_value();
+    auto key = buildKey(shortened);
+    if (reusable && mCache->lastBuild.has_value() && mCache->lastBuild->key == key) {
+        return mCache->lastBuild->result;
+    }
+    auto result = buildUncached(shortened);
+    if (reusable) {
+        mCache->lastBuild = SwapCache::LastBuild{.key = std::move(key), .result = result};
+    }
+    return result;
+}
+
+SwapBundled SwapBuilder::buildUncached(bool shortened) {
     auto fromChain = static_cast<Chain>(mFromAsset.chain());
     auto toChain = static_cast<Chain>(mToAsset.chain());
 
-    if (!validateAddress(fromChain, mFromAddress)) {
+    if (!isValidAddress(fromChain, mFromAddress)) {
         return {.status_code = static_cast<SwapErrorCode>(Proto::ErrorCode::Error_Invalid_from_address), .error = "Invalid from address"};
     }
-    if (!validateAddress(toChain, mToAddress)) {
+    if (!isValidAddress(toChain, mToAddress)) {
         return {.status_code = static_cast<SwapErrorCode>(Proto::ErrorCode::Error_Invalid_to_address), .error = "Invalid to address"};
     }
 
@@ -130,59 +149,129 @@ SwapBundled SwapBuilder::build(bool shortened) {
         return {.status_code = static_cast<SwapErrorCode>(Proto::ErrorCode::Error_Unsupported_from_chain), .error = "Unsupported from chain: " + std::to_string(fromChain)};
     }
 }
-std::string SwapBuilder::buildMemo(bool shortened) noexcept {
-    uint64_t toAmountLimitNum = std::stoull(mToAmountLimit);
 
-    // Memo: 'SWAP', or shortened '='; see https://dev.thorchain.org/thorchain-dev/concepts/memos
-    std::string prefix = shortened ? "=" : "SWAP";
-    const auto& toChain = static_cast<Chain>(mToAsset.chain());
+std::string SwapBuilder::buildKey(bool shortened) const {
+    // length-prefixed fields, unambiguous whatever their content
+    std::string key;
+    const auto add = [&key](const std::string& field) {
+        key += std::to_string(field.size());
+        key += ':';
+        key += field;
+    };
+    const auto addOptional = [&key, &add](const std::optional<std::string>& field) {
+        if (field.has_value()) {
+            add(*field);
+        } else {
+            key += '-';
+        }
+    };
+    add(mFromAsset.SerializeAsString());
+    add(mToAsset.SerializeAsString());
+    add(mFromAddress);
+    add(mToAddress);
+    add(mVaultAddress);
+    addOptional(mRouterAddress);
+    add(mFromAmount);
+    add(mToAmountLimit);
+    addOptional(mAffFeeAddress);
+    addOptional(mAffFeeRate);
+    addOptional(mExtraMemo);
+    add(std::to_string(mExpirationPolicy.value_or(0)));
+    key += shortened ? '=' : 'S';
+    return key;
+}
+
+bool SwapBuilder::isValidAddress(Chain chain, const std::string& address) {
+    if (!mCache) {
+        return validateAddress(chain, address);
+    }
+    auto& known = mCache->validAddresses;
+    auto key = std::make_pair(chain, address);
+    if (const auto found = known.find(key); found != known.end()) {
+        return found->second;
+    }
+    const auto valid = validateAddress(chain, address);
+    if (known.size() >= SwapCache::maxAddresses) {
+        known.clear();
+    }
+    known.emplace(std::move(key), valid);
+    return valid;
+}
+
+std::string SwapBuilder::memoPrefix(bool shortened) {
+    const auto toChain = static_cast<Chain>(mToAsset.chain());
     const auto& toTokenId = mToAsset.token_id();
     const auto& toSymbol = mToAsset.symbol();
-    const auto toCoinToken = (!toTokenId.empty() && toTokenId != "0x0000000000000000000000000000000000000000") ? toTokenId : toSymbol;
-    std::stringstream memo;
-    memo << prefix + ":" + chainName(toChain) + "." + toCoinToken + ":" + mToAddress;
+    const auto& toCoinToken = (!toTokenId.empty() && toTokenId != "0x0000000000000000000000000000000000000000") ? toTokenId : toSymbol;
+    if (mCache && mCache->memoPrefix.has_value()) {
+        const auto& cached = *mCache->memoPrefix;
+        if (cached.shortened == shortened && cached.toChain == toChain && cached.toCoinToken == toCoinToken && cached.toAddress == mToAddress) {
+            return cached.prefix;
+        }
+    }
+
+    // Memo: 'SWAP', or shortened '='; see https://dev.thorchain.org/thorchain-dev/concepts/memos
+    std::string prefix = shortened ? "=" : "SWAP";
+    prefix += ":" + chainName(toChain) + "." + toCoinToken + ":" + mToAddress;
+    if (mCache) {
+        mCache->memoPrefix = SwapCache::MemoPrefix{shortened, toChain, toCoinToken, mToAddress, prefix};
+    }
+    return prefix;
+}
+
+std::string SwapBuilder::buildMemo(bool shortened) noexcept {
+    uint64_t toAmountLimitNum = std::stoull(mToAmountLimit);
+
+    auto memo = memoPrefix(shortened);
     if (toAmountLimitNum > 0) {
-        memo << ":" << std::to_string(toAmountLimitNum);
+        memo += ":" + std::to_string(toAmountLimitNum);
     }
 
     if (mAffFeeAddress.has_value() || mAffFeeRate.has_value() || mExtraMemo.has_value()) {
-        memo << ":";
+        memo += ":";
         if (mAffFeeAddress.has_value()) {
-            memo << mAffFeeAddress.value();
+            memo += mAffFeeAddress.value();
         }
         if (mAffFeeRate.has_value() || mExtraMemo.has_value()) {
-            memo << ":";
+            memo += ":";
             if (mAffFeeRate.has_value()) {
-                memo << mAffFeeRate.value();
+                memo += mAffFeeRate.value();
             }
             if (mExtraMemo.has_value()) {
-                memo << ":" << mExtraMemo.value();
+                memo += ":" + mExtraMemo.value();
             }
         }
     }
 
-    return memo.str();
+    return memo;
 }
 
 SwapBundled SwapBuilder::buildBitcoin(uint256_t amount, const std::string& memo, Chain fromChain) {
-    auto input = Bitcoin::Proto::SigningInput();
-    Data out;
-    // Following fields must be set afterwards, before signing ...
-    auto coinType = chainCoinType(fromChain);
-    input.set_hash_type(Bitcoin::hashTypeForCoin(coinType));
-    input.set_byte_fee(1);
-    input.set_use_max_amount(false);
-    // private_key[]
-    // utxo[]
-    // scripts[]
-    // ... end
+    std::optional<SwapCache::BitcoinInput> uncached;
+    auto& cached = mCache ? mCache->bitcoinInput : uncached;
+    if (!cached.has_value() || cached->chain != fromChain || cached->vault != mVaultAddress || cached->from != mFromAddress) {
+        auto input = Bitcoin::Proto::SigningInput();
+        // Following fields must be set afterwards, before signing ...
+        auto coinType = chainCoinType(fromChain);
+        input.set_hash_type(Bitcoin::hashTypeForCoin(coinType));
+        input.set_byte_fee(1);
+        input.set_use_max_amount(false);
+        // private_key[]
+        // utxo[]
+        // scripts[]
+        // ... end
 
+        input.set_to_address(mVaultAddress);
+        input.set_change_address(mFromAddress);
+        input.set_coin_type(coinType);
+        cached = SwapCache::BitcoinInput{fromChain, mVaultAddress, mFromAddress, std::move(input)};
+    }
+
+    auto& input = cached->input;
     input.set_amount(static_cast<int64_t>(amount));
-    input.set_to_address(mVaultAddress);
-    input.set_change_address(mFromAddress);
-    input.set_coin_type(coinType);
     input.set_output_op_return(memo);
 
+    Data out;
     auto serialized = input.SerializeAsString();
     out.insert(out.end(), serialized.begin(), serialized.end());
     return {.out = std::move(out)};
@@ -240,7 +329,6 @@ SwapBundled SwapBuilder::buildEth(uint256_t amount, const std::string& memo) {
     if (!toTokenId.empty() && !Ethereum::Address::isValid(*mRouterAddress)) {
         return {.status_code = static_cast<int>(Proto::ErrorCode::Error_Invalid_router_address), .error = "Invalid router address: " + *mRouterAddress};
     }
-    Data toAssetAddressBin = ethAddressStringToData(toTokenId);
 
     // Following fields must be set afterwards, before signing ...
     const auto chainId = store(uint256_t(0));
@@ -257,20 +345,18 @@ SwapBundled SwapBuilder::buildEth(uint256_t amount, const std::string& memo) {
     input.set_to_address(*mRouterAddress);
     if (!toTokenId.empty()) {
         if (!mExpirationPolicy) {
-            std::cout << "here"<< std::endl;
             auto now = std::chrono::system_clock::now();
             auto in_15_minutes = now + std::chrono::minutes(15);
             mExpirationPolicy = std::chrono::duration_cast<std::chrono::seconds>(in_15_minutes.time_since_epoch()).count();
         }
         auto& transfer = *input.mutable_transaction()->mutable_contract_generic();
-        auto func = Ethereum::ABI::Function("depositWithExpiry", std::vector<std::shared_ptr<Ethereum::ABI::ParamBase>>{
-                                                                     std::make_shared<Ethereum::ABI::ParamAddress>(vaultAddressBin),
-                                                                     std::make_shared<Ethereum::ABI::ParamAddress>(toAssetAddressBin),
-                                                                     std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(amount)),
-                                                                     std::make_shared<Ethereum::ABI::ParamString>(memo),
-                                                                     std::make_shared<Ethereum::ABI::ParamUInt256>(uint256_t(*mExpirationPolicy))});
-        Data payload;
-        func.encode(payload);
+        // depositWithExpiry(vault, asset, amount, memo, expiry); the memo is the only dynamic parameter, after the 5 head words
+        using Ethereum::ABI::ValueEncoder;
+        Data payload = routerCallHead(toTokenId);
+        ValueEncoder::encodeUInt256(amount, payload);
+        ValueEncoder::encodeUInt256(uint256_t(5 * ValueEncoder::encodedIntSize), payload);
+        ValueEncoder::encodeUInt256(uint256_t(*mExpirationPolicy), payload);
+        Ethereum::ABI::ParamString::encodeString(memo, payload);
         transfer.set_data(payload.data(), payload.size());
         Data amountData = store(uint256_t(0));
         transfer.set_amount(amountData.data(), amountData.size());
@@ -287,6 +373,20 @@ SwapBundled SwapBuilder::buildEth(uint256_t amount, const std::string& memo) {
     return {.out = std::move(out)};
 }
 
+Data SwapBuilder::routerCallHead(const std::string& token) {
+    if (mCache && mCache->routerCall.has_value() && mCache->routerCall->vault == mVaultAddress && mCache->routerCall->token == token) {
+        return mCache->routerCall->head;
+    }
+    static const Data selector = subData(Hash::keccak256(std::string("depositWithExpiry(address,address,uint256,string,uint256)")), 0, 4);
+    Data head = selector;
+    Ethereum::ABI::ValueEncoder::encodeAddress(ethAddressStringToData(mVaultAddress), head);
+    Ethereum::ABI::ValueEncoder::encodeAddress(ethAddressStringToData(token), head);
+    if (mCache) {
+        mCache->routerCall = SwapCache::RouterCall{mVaultAddress, token, head};
+    }
+    return head;
+}
+
 SwapBundled SwapBuilder::buildAtom(uint256_t amount, const std::string& memo) {
     if (!Cosmos::Address::isValid(mVaultAddress, "cosmos")) {
         return {.status_code = static_cast<int>(Proto::ErrorCode::Error_Invalid_vault_address), .error = "Invalid vault address: " + mVaultAddress};
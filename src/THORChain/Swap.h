@@ -10,6 +10,7 @@
 #include "proto/THORChainSwap.pb.h"
 #include "uint256.h"
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -37,6 +38,8 @@ struct SwapBundled {
     std::string error{""};
 };
 
+class SwapCache;
+
 class SwapBuilder {
     Proto::Asset mFromAsset;
     Proto::Asset mToAsset;
@@ -50,7 +53,13 @@ class SwapBuilder {
     std::optional<std::string> mAffFeeRate{std::nullopt};
     std::optional<std::string> mExtraMemo{std::nullopt};
     std::optional<std::size_t> mExpirationPolicy{std::nullopt};
+    std::shared_ptr<SwapCache> mCache;
 
+    SwapBundled buildUncached(bool shortened);
+    std::string buildKey(bool shortened) const;
+    bool isValidAddress(Chain chain, const std::string& address);
+    std::string memoPrefix(bool shortened);
+    Data routerCallHead(const std::string& token);
     SwapBundled buildBitcoin(uint256_t amount, const std::string& memo, Chain fromChain);
     SwapBundled buildBinance(Proto::Asset fromAsset, uint256_t amount, const std::string& memo);
     SwapBundled buildEth(uint256_t amount, const std::string& memo);
@@ -139,6 +148,13 @@ public:
         return *this;
     }
 
+    /// Reuse the templates of `cache` (memo prefix, router call, Bitcoin input, address checks) and
+    /// the last output when the inputs did not change; share it between the builds of a re-quoted swap.
+    SwapBuilder& cache(std::shared_ptr<SwapCache> cache) noexcept {
+        mCache = std::move(cache);
+        return *this;
+    }
+
     std::string buildMemo(bool shortened = true) noexcept;
 
     SwapBundled build(bool shortened = true);
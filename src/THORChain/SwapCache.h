@@ -0,0 +1,73 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "Swap.h"
+#include "../proto/Bitcoin.pb.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace TW::THORChainSwap {
+
+/// Per-chain templates reused across builds of the same swap with different amounts (re-quoting).
+/// Each entry is keyed by the inputs it was made from, and rebuilt when one of them changes.
+/// Not thread safe: use one cache per builder thread.
+class SwapCache {
+public:
+    /// Memo up to and including the destination address, e.g. "=:BTC.BTC:bc1q..."
+    struct MemoPrefix {
+        bool shortened;
+        Chain toChain;
+        std::string toCoinToken;
+        std::string toAddress;
+        std::string prefix;
+    };
+
+    /// Router call `depositWithExpiry` head: selector, vault and asset words
+    struct RouterCall {
+        std::string vault;
+        std::string token;
+        Data head;
+    };
+
+    /// Bitcoin-family signing input with everything but amount and memo set
+    struct BitcoinInput {
+        Chain chain;
+        std::string vault;
+        std::string from;
+        Bitcoin::Proto::SigningInput input;
+    };
+
+    /// Last build output, keyed by all the builder inputs
+    struct LastBuild {
+        std::string key;
+        SwapBundled result;
+    };
+
+    /// Upper bound of the address validation results kept
+    static constexpr std::size_t maxAddresses = 256;
+
+    std::optional<MemoPrefix> memoPrefix;
+    std::optional<RouterCall> routerCall;
+    std::optional<BitcoinInput> bitcoinInput;
+    std::optional<LastBuild> lastBuild;
+    std::map<std::pair<Chain, std::string>, bool> validAddresses;
+
+    void clear() {
+        memoPrefix.reset();
+        routerCall.reset();
+        bitcoinInput.reset();
+        lastBuild.reset();
+        validAddresses.clear();
+    }
+};
+
+} // namespace TW::THORChainSwap
@@ -9,6 +9,7 @@
 #include "BinaryCoding.h"
 #include "../HexCoding.h"
 #include "../proto/Tezos.pb.h"
+#include <array>
 #include <sstream>
 
 namespace TW::Tezos {
@@ -23,6 +24,14 @@ void encodePrefix(const std::string& address, Data& forged) {
     forged.insert(forged.end(), decoded.begin() + prefixSize, decoded.end());
 }
 
+// Writes the 4-byte big endian length of what was forged after the placeholder at `offset`.
+void patchLength(Data& forged, std::size_t offset) {
+    const auto length = static_cast<uint32_t>(forged.size() - offset - 4);
+    for (int i = 3; i >= 0; --i) {
+        forged[offset + 3 - i] = static_cast<TW::byte>(length >> (8 * i));
+    }
+}
+
 } // namespace
 
 // Forge the given boolean into a hex encoded string.
@@ -31,43 +40,57 @@ Data forgeBool(bool input) {
     return Data{result};
 }
 
-Data forgeInt32(int value, int len) {
-    Data out(len);
+void forgeInt32(int value, int len, Data& forged) {
+    const auto offset = forged.size();
+    forged.resize(offset + len);
     for (int i = len - 1; i >= 0; i--, value >>= 8) {
-        out[i] = (value & 0xFF);
+        forged[offset + i] = (value & 0xFF);
     }
+}
+
+Data forgeInt32(int value, int len) {
+    Data out;
+    forgeInt32(value, len, out);
     return out;
 }
 
+void forgeString(const std::string& value, std::size_t len, Data& forged) {
+    forgeInt32(static_cast<int>(value.size()), static_cast<int>(len), forged);
+    forged.insert(forged.end(), value.begin(), value.end());
+}
+
 Data forgeString(const std::string& value, std::size_t len) {
-    auto bytes = data(value);
-    auto result = forgeInt32(static_cast<int>(bytes.size()), static_cast<int>(len));
-    append(result, bytes);
-    return result;
+    Data forged;
+    forgeString(value, len, forged);
+    return forged;
 }
 
-Data forgeEntrypoint(const std::string& value) {
+void forgeEntrypoint(const std::string& value, Data& forged) {
     if (value == "default")
-        return Data{0x00};
+        forged.push_back(0x00);
     else if (value == "root")
-        return Data{0x01};
+        forged.push_back(0x01);
     else if (value == "do")
-        return Data{0x02};
+        forged.push_back(0x02);
     else if (value == "set_delegate")
-        return Data{0x03};
+        forged.push_back(0x03);
     else if (value == "remove_delegate")
-        return Data{0x04};
+        forged.push_back(0x04);
     else {
-        Data forged{0xff};
-        append(forged, forgeString(value, 1));
-        return forged;
+        forged.push_back(0xff);
+        forgeString(value, 1, forged);
     }
 }
 
+Data forgeEntrypoint(const std::string& value) {
+    Data forged;
+    forgeEntrypoint(value, forged);
+    return forged;
+}
+
 // Forge the given public key hash into a hex encoded string.
 // Note: This function supports tz1, tz2 and tz3 addresses.
-Data forgePublicKeyHash(const std::string& publicKeyHash) {
-    Data forged = Data();
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged) {
     // Adjust prefix based on tz1, tz2 or tz3.
     switch ((char)publicKeyHash[2]) {
     case '1':
@@ -83,187 +106,261 @@ Data forgePublicKeyHash(const std::string& publicKeyHash) {
         throw std::invalid_argument("Invalid Prefix");
     }
     encodePrefix(publicKeyHash, forged);
+}
+
+Data forgePublicKeyHash(const std::string& publicKeyHash) {
+    Data forged;
+    forgePublicKeyHash(publicKeyHash, forged);
     return forged;
 }
 
-Data forgeAddress(const std::string& address) {
+void forgeAddress(const std::string& address, Data& forged) {
     if (address.size() < 3) {
         throw std::invalid_argument("Invalid address size");
     }
-    auto prefix = address.substr(0, 3);
 
-    if (prefix == "tz1" || prefix == "tz2" || prefix == "tz3") {
-        Data forged{0x00};
-        append(forged, forgePublicKeyHash(address));
-        return forged;
+    if (address.compare(0, 3, "tz1") == 0 || address.compare(0, 3, "tz2") == 0 || address.compare(0, 3, "tz3") == 0) {
+        forged.push_back(0x00);
+        forgePublicKeyHash(address, forged);
+        return;
     }
 
-    if (prefix == gTezosContractAddressPrefix) {
-        Data forged{0x01};
+    if (address.compare(0, 3, gTezosContractAddressPrefix) == 0) {
+        forged.push_back(0x01);
         encodePrefix(address, forged);
         forged.emplace_back(0x00);
-        return forged;
+        return;
     }
     throw std::invalid_argument("Invalid Prefix");
 }
 
-// Forge the given public key into a hex encoded string.
-Data forgePublicKey(PublicKey publicKey) {
-    std::array<uint8_t, 4> prefix = {13, 15, 37, 217};
-    auto data = Data(prefix.begin(), prefix.end());
-    auto bytes = Data(publicKey.bytes.begin(), publicKey.bytes.end());
-    append(data, bytes);
+Data forgeAddress(const std::string& address) {
+    Data forged;
+    forgeAddress(address, forged);
+    return forged;
+}
 
-    auto pk = Base58::encodeCheck(data);
-    auto decoded = "00" + base58ToHex(pk, 4);
-    return parse_hex(decoded);
+// Forge the given public key: a zero tag followed by the raw key bytes.
+void forgePublicKey(const PublicKey& publicKey, Data& forged) {
+    forged.push_back(0x00);
+    append(forged, publicKey.bytes);
+}
+
+Data forgePublicKey(PublicKey publicKey) {
+    Data forged;
+    forgePublicKey(publicKey, forged);
+    return forged;
 }
 
 // Forge the given zarith hash into a hex encoded string.
-Data forgeZarith(uint64_t input) {
-    Data forged = Data();
+void forgeZarith(uint64_t input, Data& forged) {
+    // 7 bits per byte, at most 10 bytes for 64 bits
+    std::array<TW::byte, 10> buffer;
+    std::size_t size = 0;
     while (input >= 0x80) {
-        forged.push_back(static_cast<TW::byte>((input & 0xff) | 0x80));
+        buffer[size++] = static_cast<TW::byte>((input & 0xff) | 0x80);
         input >>= 7;
     }
-    forged.push_back(static_cast<TW::byte>(input));
+    buffer[size++] = static_cast<TW::byte>(input);
+    forged.insert(forged.end(), buffer.begin(), buffer.begin() + size);
+}
+
+Data forgeZarith(uint64_t input) {
+    Data forged;
+    forgeZarith(input, forged);
     return forged;
 }
 
 // Forge the given operation.
-Data forgeOperation(const Proto::Operation& operation) {
+void forgeOperation(const Proto::Operation& operation, Data& forged) {
     using namespace Proto;
-    auto forged = Data();
-    auto source = Address(operation.source());
-    auto forgedSource = source.forge();
-    auto forgedFee = forgeZarith(operation.fee());
-    auto forgedCounter = forgeZarith(operation.counter());
-    auto forgedGasLimit = forgeZarith(operation.gas_limit());
-    auto forgedStorageLimit = forgeZarith(operation.storage_limit());
-
-    if (operation.kind() == Operation_OperationKind_REVEAL) {
+    const auto kind = operation.kind();
+    if (kind != Operation_OperationKind_REVEAL && kind != Operation_OperationKind_DELEGATION && kind != Operation_OperationKind_TRANSACTION) {
+        throw std::invalid_argument("Invalid operation kind");
+    }
+    // validate the source, it is forged from its string representation
+    const auto& source = operation.source();
+    [[maybe_unused]] const auto sourceAddress = Address(source);
+
+    forged.push_back(static_cast<TW::byte>(kind));
+    forgePublicKeyHash(source, forged);
+    forgeZarith(operation.fee(), forged);
+    forgeZarith(operation.counter(), forged);
+    forgeZarith(operation.gas_limit(), forged);
+    forgeZarith(operation.storage_limit(), forged);
+
+    if (kind == Operation_OperationKind_REVEAL) {
         auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
-        auto forgedPublicKey = forgePublicKey(publicKey);
-
-        forged.push_back(Operation_OperationKind_REVEAL);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedPublicKey);
-        return forged;
+        forgePublicKey(publicKey, forged);
+        return;
     }
 
-    if (operation.kind() == Operation_OperationKind_DELEGATION) {
-        auto delegate = operation.delegation_operation_data().delegate();
-
-        forged.push_back(Operation_OperationKind_DELEGATION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
+    if (kind == Operation_OperationKind_DELEGATION) {
+        const auto& delegate = operation.delegation_operation_data().delegate();
         if (!delegate.empty()) {
-            auto forgedPublicKeyHash = forgePublicKeyHash(delegate);
-
             append(forged, forgeBool(true));
-            append(forged, forgedPublicKeyHash);
+            forgePublicKeyHash(delegate, forged);
         } else {
             append(forged, forgeBool(false));
         }
-        return forged;
+        return;
     }
 
-    if (operation.kind() == Operation_OperationKind_TRANSACTION) {
-        auto forgedAmount = forgeZarith(operation.transaction_operation_data().amount());
-        auto forgedDestination = Address(operation.transaction_operation_data().destination()).forge();
-
-        forged.emplace_back(Operation_OperationKind_TRANSACTION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedAmount);
-        if (!operation.transaction_operation_data().has_parameters()) {
-            append(forged, forgeBool(false));
-            append(forged, forgedDestination);
-            append(forged, forgeBool(false));
-        } else if (operation.transaction_operation_data().has_parameters()) {
-            append(forged, forgeAddress(operation.transaction_operation_data().destination()));
-            append(forged, forgeBool(true));
-            auto& parameters = operation.transaction_operation_data().parameters();
-            switch (parameters.parameters_case()) {
-            case OperationParameters::kFa12Parameters:
-                append(forged, forgeEntrypoint(parameters.fa12_parameters().entrypoint()));
-                append(forged, forgeArray(forgeMichelson(FA12ParameterToMichelson(parameters.fa12_parameters()))));
-                break;
-            case OperationParameters::kFa2Parameters:
-                append(forged, forgeEntrypoint(parameters.fa2_parameters().entrypoint()));
-                append(forged, forgeArray(forgeMichelson(FA2ParameterToMichelson(parameters.fa2_parameters()))));
-                break;
-            case OperationParameters::PARAMETERS_NOT_SET:
-                break;
-            }
-        }
-        return forged;
+    // Operation_OperationKind_TRANSACTION
+    const auto& transaction = operation.transaction_operation_data();
+    const auto& destination = transaction.destination();
+    [[maybe_unused]] const auto destinationAddress = Address(destination);
+    forgeZarith(transaction.amount(), forged);
+    if (!transaction.has_parameters()) {
+        append(forged, forgeBool(false));
+        forgePublicKeyHash(destination, forged);
+        append(forged, forgeBool(false));
+        return;
     }
 
-    throw std::invalid_argument("Invalid operation kind");
+    forgeAddress(destination, forged);
+    append(forged, forgeBool(true));
+    const auto& parameters = transaction.parameters();
+    switch (parameters.parameters_case()) {
+    case OperationParameters::kFa12Parameters:
+        forgeEntrypoint(parameters.fa12_parameters().entrypoint(), forged);
+        forgeFA12Parameters(parameters.fa12_parameters(), forged);
+        break;
+    case OperationParameters::kFa2Parameters:
+        forgeEntrypoint(parameters.fa2_parameters().entrypoint(), forged);
+        forgeFA2Parameters(parameters.fa2_parameters(), forged);
+        break;
+    case OperationParameters::PARAMETERS_NOT_SET:
+        break;
+    }
 }
 
-Data forgePrim(const PrimValue& value) {
+Data forgeOperation(const Proto::Operation& operation) {
     Data forged;
+    forgeOperation(operation, forged);
+    return forged;
+}
+
+void forgePrim(const PrimValue& value, Data& forged) {
     if (value.prim == "Pair") {
         // https://tezos.gitlab.io/developer/encodings.html?highlight=pair#pairs
-        forged.reserve(2);
         constexpr uint8_t nbArgs = 2;
         // https://github.com/ecadlabs/taquito/blob/fd84d627171d24ce7ba81dd7b18763a95f16a99c/packages/taquito-local-forging/src/michelson/codec.ts#L195
         // https://github.com/baking-bad/netezos/blob/0bfd6db4e85ab1c99fb55503e476fe67cebd2dc5/Netezos/Forging/Local/LocalForge.Forgers.cs#L199
         const uint8_t preamble = static_cast<uint8_t>(std::min(2 * nbArgs + static_cast<uint8_t>(value.anots.size()) + 0x03, 9));
         forged.emplace_back(preamble);
         forged.emplace_back(PrimType::Pair);
-        Data subForged;
         for (auto&& cur : value.args) {
-            append(subForged, forgeMichelson(cur.value));
+            forgeMichelson(cur.value, forged);
         }
-        append(forged, subForged);
     }
+}
+
+Data forgePrim(const PrimValue& value) {
+    Data forged;
+    forgePrim(value, forged);
     return forged;
 }
 
+namespace {
+
+// Forged header of a `Pair` with two arguments and no annotations, see forgePrim.
+constexpr std::array<TW::byte, 2> gPairHeader{0x07, PrimType::Pair};
+
+void forgePairHeader(Data& forged) {
+    forged.insert(forged.end(), gPairHeader.begin(), gPairHeader.end());
+}
+
+void forgeMichelsonString(const std::string& value, Data& forged) {
+    forged.push_back(1);
+    forgeString(value, 4, forged);
+}
+
+void forgeMichelsonInt(const std::string& value, Data& forged) {
+    forged.push_back(0);
+    forgeMichelInt(int256_t(value), forged);
+}
+
+void forgeMichelsonValue(const PrimValue& value, Data& forged) {
+    forgePrim(value, forged);
+}
+
+void forgeMichelsonValue(const StringValue& value, Data& forged) {
+    forgeMichelsonString(value.string, forged);
+}
+
+void forgeMichelsonValue(const IntValue& value, Data& forged) {
+    forgeMichelsonInt(value._int, forged);
+}
+
+void forgeMichelsonValue([[maybe_unused]] const BytesValue& value, [[maybe_unused]] Data& forged) {
+}
+
+void forgeMichelsonValue(const MichelsonValue::MichelsonArray& array, Data& forged) {
+    forged.push_back(2);
+    // length prefix is patched once the elements are forged
+    const auto offset = forged.size();
+    forged.resize(offset + 4);
+    for (auto&& cur : array) {
+        std::visit([&forged](auto&& arg) { forgeMichelsonValue(arg, forged); }, cur);
+    }
+    patchLength(forged, offset);
+}
+
+} // namespace
+
+void forgeMichelson(const MichelsonValue::MichelsonVariant& value, Data& forged) {
+    std::visit([&forged](auto&& arg) { forgeMichelsonValue(arg, forged); }, value);
+}
+
 Data forgeMichelson(const MichelsonValue::MichelsonVariant& value) {
-    auto visit_functor = [](const MichelsonValue::MichelsonVariant& value) -> Data {
-        if (std::holds_alternative<PrimValue>(value)) {
-            return forgePrim(std::get<PrimValue>(value));
-        } else if (std::holds_alternative<StringValue>(value)) {
-            Data forged{1};
-            append(forged, forgeString(std::get<StringValue>(value).string));
-            return forged;
-        } else if (std::holds_alternative<IntValue>(value)) {
-            Data forged{0};
-            auto res = int256_t(std::get<IntValue>(value)._int);
-            append(forged, forgeMichelInt(res));
-            return forged;
-        } else if (std::holds_alternative<BytesValue>(value)) {
-            return {};
-        } else if (std::holds_alternative<MichelsonValue::MichelsonArray>(value)) {
-            // array
-            Data forged{2};
-            Data subForged;
-            auto array = std::get<MichelsonValue::MichelsonArray>(value);
-            for (auto&& cur : array) {
-                std::visit([&subForged](auto&& arg) { append(subForged, forgeMichelson(arg)); }, cur);
-            }
-            append(forged, forgeArray(subForged));
-            return forged;
-        } else {
-            throw std::invalid_argument("Invalid variant");
-        }
-    };
+    Data forged;
+    forgeMichelson(value, forged);
+    return forged;
+}
+
+void forgeArray(const MichelsonValue::MichelsonVariant& value, Data& forged) {
+    const auto offset = forged.size();
+    forged.resize(offset + 4);
+    forgeMichelson(value, forged);
+    patchLength(forged, offset);
+}
+
+// Pair(from, Pair(to, value)), as forged from FA12ParameterToMichelson, with only the variable slots written per call.
+void forgeFA12Parameters(const Proto::FA12Parameters& parameters, Data& forged) {
+    const auto offset = forged.size();
+    forged.resize(offset + 4);
+    forgePairHeader(forged);
+    forgeMichelsonString(parameters.from(), forged);
+    forgePairHeader(forged);
+    forgeMichelsonString(parameters.to(), forged);
+    forgeMichelsonInt(parameters.value(), forged);
+    patchLength(forged, offset);
+}
 
-    return std::visit(visit_functor, value);
+// [Pair(from, [Pair(to, Pair(token_id, amount))])], as forged from FA2ParameterToMichelson, for the first transfer.
+void forgeFA2Parameters(const Proto::FA2Parameters& parameters, Data& forged) {
+    const auto& txObj = parameters.txs_object(0);
+    const auto& tx = txObj.txs(0);
+
+    const auto offset = forged.size();
+    forged.resize(offset + 4);
+    forged.push_back(2);
+    const auto txsObjectOffset = forged.size();
+    forged.resize(txsObjectOffset + 4);
+    forgePairHeader(forged);
+    forgeMichelsonString(txObj.from(), forged);
+    forged.push_back(2);
+    const auto txsOffset = forged.size();
+    forged.resize(txsOffset + 4);
+    forgePairHeader(forged);
+    forgeMichelsonString(tx.to(), forged);
+    forgePairHeader(forged);
+    forgeMichelsonInt(tx.token_id(), forged);
+    forgeMichelsonInt(tx.amount(), forged);
+    patchLength(forged, txsOffset);
+    patchLength(forged, txsObjectOffset);
+    patchLength(forged, offset);
 }
 
 Data forgeArray(const Data& data) {
@@ -272,16 +369,20 @@ Data forgeArray(const Data& data) {
     return forged;
 }
 
-Data forgeMichelInt(const TW::int256_t& value) {
-    Data forged;
+void forgeMichelInt(const TW::int256_t& value, Data& forged) {
     auto abs = boost::multiprecision::abs(value);
     forged.emplace_back(static_cast<uint8_t>(value.sign() < 0 ? (abs & 0x3f - 0x40) : (abs & 0x3f)));
     abs >>= 6;
     while (abs > 0) {
-        forged[forged.size() - 1] |= 0x80;
+        forged.back() |= 0x80;
         forged.emplace_back(static_cast<uint8_t>(abs & 0x7F));
         abs >>= 7;
     }
+}
+
+Data forgeMichelInt(const TW::int256_t& value) {
+    Data forged;
+    forgeMichelInt(value, forged);
     return forged;
 }
 
@@ -33,4 +33,23 @@ Data forgeMichelson(const MichelsonValue::MichelsonVariant& value);
 Data forgeMichelInt(const TW::int256_t& value);
 Data forgePrim(const PrimValue& value);
 
+/// Variants appending to `forged`, so that a whole operation group is forged into a single buffer.
+void forgeOperation(const Proto::Operation& operation, Data& forged);
+void forgeAddress(const std::string& address, Data& forged);
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged);
+void forgePublicKey(const PublicKey& publicKey, Data& forged);
+void forgeZarith(uint64_t input, Data& forged);
+void forgeInt32(int value, int len, Data& forged);
+void forgeString(const std::string& value, std::size_t len, Data& forged);
+void forgeEntrypoint(const std::string& value, Data& forged);
+void forgeMichelson(const MichelsonValue::MichelsonVariant& value, Data& forged);
+/// Forges `value` prefixed by its 4-byte length, as forgeArray(forgeMichelson(value)).
+void forgeArray(const MichelsonValue::MichelsonVariant& value, Data& forged);
+void forgeMichelInt(const TW::int256_t& value, Data& forged);
+/// Forge token transfer parameters directly, without building the Michelson tree;
+/// same output as forgeArray(forgeMichelson(FA12ParameterToMichelson(parameters))), resp. FA2.
+void forgeFA12Parameters(const Proto::FA12Parameters& parameters, Data& forged);
+void forgeFA2Parameters(const Proto::FA2Parameters& parameters, Data& forged);
+void forgePrim(const PrimValue& value, Data& forged);
+
 } // namespace TW::Tezos
@@ -10,6 +10,9 @@
 
 namespace TW::Tezos {
 
+/// Typical size of a forged transaction, used to reserve the buffer of a group.
+static constexpr std::size_t estimatedOperationSize = 128;
+
 Tezos::OperationList::OperationList(const std::string& str) {
     branch = str;
 }
@@ -31,19 +34,26 @@ Data Tezos::OperationList::forgeBranch() const {
 }
 
 Data Tezos::OperationList::forge(const PrivateKey& privateKey) const {
-    auto forged = forgeBranch();
+    Data forged;
+    // branch, operations, and the signature the signer appends in place
+    forged.reserve(32 + operation_list.size() * estimatedOperationSize + 64);
+    append(forged, forgeBranch());
 
-    for (auto operation : operation_list) {
+    Data publicKey;
+    for (const auto& operation : operation_list) {
         // If it's REVEAL operation, inject the public key if not specified
-        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data()) {
-            auto* revealOperationData = operation.mutable_reveal_operation_data();
-            if (revealOperationData->public_key().empty()) {
-                auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-                revealOperationData->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
+        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data() &&
+            operation.reveal_operation_data().public_key().empty()) {
+            if (publicKey.empty()) {
+                publicKey = Data(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes);
             }
+            auto reveal = operation;
+            reveal.mutable_reveal_operation_data()->set_public_key(publicKey.data(), publicKey.size());
+            forgeOperation(reveal, forged);
+            continue;
         }
 
-        append(forged, forgeOperation(operation));
+        forgeOperation(operation, forged);
     }
 
     return forged;
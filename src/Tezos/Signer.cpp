@@ -7,9 +7,9 @@
 #include "Signer.h"
 #include "OperationList.h"
 #include "../HexCoding.h"
+#include "../proto/Tezos.json.pb.h"
 
 #include <TrustWalletCore/TWCurve.h>
-#include <google/protobuf/util/json_util.h>
 
 #include <string>
 
@@ -38,26 +38,34 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return hex(output.encoded());
 }
 
+/// Hashes the watermark and the data without concatenating them first.
+static Data hashForSigning(const Data& data) {
+    const byte watermark = 0x03;
+    return Hash::StreamHasher::blake2b(32)
+        .update(&watermark, 1)
+        .update(data)
+        .finalize();
+}
+
 Data Signer::signOperationList(const PrivateKey& privateKey, const OperationList& operationList) {
+    // The whole group is forged into one buffer, hashed in one pass, and the signature appended in place.
     auto forged = operationList.forge(privateKey);
-    return signData(privateKey, forged);
+    Data signature = privateKey.sign(hashForSigning(forged), TWCurve::TWCurveED25519);
+    append(forged, signature);
+    return forged;
 }
 
 Data Signer::signData(const PrivateKey& privateKey, const Data& data) {
-    Data watermarkedData = Data();
-    watermarkedData.push_back(0x03);
-    append(watermarkedData, data);
-
-    Data hash = Hash::blake2b(watermarkedData, 32);
-    Data signature = privateKey.sign(hash, TWCurve::TWCurveED25519);
+    Data signature = privateKey.sign(hashForSigning(data), TWCurve::TWCurveED25519);
 
-    Data signedData = Data();
+    Data signedData;
+    signedData.reserve(data.size() + signature.size());
     append(signedData, data);
     append(signedData, signature);
     return signedData;
@@ -0,0 +1,72 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Payloads.h"
+
+namespace TW::TheOpenNetwork {
+
+// Jetton wallet operation codes https://github.com/ton-blockchain/TEPs/blob/master/text/0074-jettons-standard.md
+static const uint32_t jettonTransferOperation = 0x0f8a7ea5;
+
+// addr_std$10 anycast:(Maybe Anycast) workchain_id:int8 address:bits256
+static void appendAddress(CellBuilder& builder, const Address& address) {
+    Data prefix{0x80};
+    builder.appendRaw(prefix, 2);
+    builder.appendBitZero();
+    builder.appendI8(address.addressData.workchainId);
+    builder.appendRaw(Data(address.addressData.hash.begin(), address.addressData.hash.end()), 256);
+}
+
+Cell::Ref commentPayload(const std::string& comment) {
+    CellBuilder bodyBuilder;
+    if (!comment.empty()) {
+        const auto& data = Data(comment.begin(), comment.end());
+        bodyBuilder.appendU32(0);
+        bodyBuilder.appendRaw(data, static_cast<uint16_t>(data.size()) * 8);
+    }
+    return bodyBuilder.intoCell();
+}
+
+Cell::Ref jettonTransferPayload(
+    const Address& responseAddress,
+    const Address& toOwner,
+    uint64_t jettonAmount,
+    uint64_t forwardAmount,
+    const std::string& comment,
+    uint64_t queryId
+) {
+    CellBuilder bodyBuilder;
+    bodyBuilder.appendU32(jettonTransferOperation);
+    bodyBuilder.appendU64(queryId);
+    bodyBuilder.appendU128(jettonAmount);
+    appendAddress(bodyBuilder, toOwner);
+    appendAddress(bodyBuilder, responseAddress);
+    bodyBuilder.appendBitZero(); // null custom_payload
+    bodyBuilder.appendU128(forwardAmount);
+    if (comment.empty()) {
+        bodyBuilder.appendBitZero(); // empty forward_payload in this cell
+    } else {
+        bodyBuilder.appendBitOne(); // forward_payload in a reference cell
+        bodyBuilder.appendReferenceCell(commentPayload(comment));
+    }
+    return bodyBuilder.intoCell();
+}
+
+JettonWalletAddresses::JettonWalletAddresses(const Address& master, const Data& walletCode)
+    : master(master), stateInit(walletCode.data(), walletCode.size()) {
+}
+
+Address JettonWalletAddresses::walletOf(const Address& owner) const {
+    CellBuilder builder;
+    builder.appendU128(0); // balance
+    appendAddress(builder, owner);
+    appendAddress(builder, master);
+    builder.appendReferenceCell(stateInit.code());
+    const auto data = builder.intoCell();
+    return Address(owner.addressData.workchainId, stateInit.hash(*data));
+}
+
+} // namespace TW::TheOpenNetwork
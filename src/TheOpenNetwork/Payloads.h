@@ -0,0 +1,43 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Message.h"
+
+namespace TW::TheOpenNetwork {
+
+/// Body of a simple transfer with a text comment, empty if the comment is.
+Cell::Ref commentPayload(const std::string& comment);
+
+/// Body of a jetton `transfer` (TEP-74), sent to the sender's jetton wallet.
+/// The comment, if any, is forwarded to the new owner.
+Cell::Ref jettonTransferPayload(
+    const Address& responseAddress,
+    const Address& toOwner,
+    uint64_t jettonAmount,
+    uint64_t forwardAmount,
+    const std::string& comment = "",
+    uint64_t queryId = 0
+);
+
+/// Jetton wallet addresses of a standard (TEP-74 reference) jetton, whose wallet data is
+/// balance, owner, master and wallet code. The wallet code is deserialized once and its
+/// StateInit layout precomputed, so each address costs the data cell and two hashes.
+class JettonWalletAddresses {
+public:
+    JettonWalletAddresses(const Address& master, const Data& walletCode);
+
+    /// Address of the jetton wallet of `owner`.
+    [[nodiscard]] Address walletOf(const Address& owner) const;
+
+private:
+    Address master;
+    CommonTON::StateInitTemplate stateInit;
+};
+
+} // namespace TW::TheOpenNetwork
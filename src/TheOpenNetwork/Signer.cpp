@@ -8,9 +8,13 @@
 
 #include "Base64.h"
 
+#include "TheOpenNetwork/Payloads.h"
 #include "TheOpenNetwork/wallet/WalletV4R2.h"
 #include "WorkchainType.h"
 
+#include <chrono>
+#include <optional>
+
 namespace TW::TheOpenNetwork {
 
 Data Signer::createTransferMessage(std::shared_ptr<Wallet> wallet, const PrivateKey& privateKey, const Proto::Transfer& transfer) {
@@ -29,6 +33,57 @@ Data Signer::createTransferMessage(std::shared_ptr<Wallet> wallet, const Private
     return result;
 }
 
+std::vector<Data> Signer::createBatchMessages(std::shared_ptr<Wallet> wallet, const PrivateKey& privateKey, const Proto::TransferBatch& batch) {
+    if (batch.payouts_size() == 0) {
+        throw std::invalid_argument("no payouts");
+    }
+
+    // the sender's jetton wallet is the same for all the jetton payouts
+    std::optional<Address> senderJettonWallet;
+    if (!batch.jetton_master().empty() && !batch.jetton_wallet_code().empty()) {
+        const auto jettonWallets = JettonWalletAddresses(Address(batch.jetton_master()), data(batch.jetton_wallet_code()));
+        senderJettonWallet = jettonWallets.walletOf(wallet->getAddress());
+    }
+
+    std::vector<InternalMessage> messages;
+    messages.reserve(batch.payouts_size());
+    for (const auto& payout : batch.payouts()) {
+        if (!payout.has_jetton_transfer()) {
+            messages.push_back(InternalMessage{Address(payout.dest(), payout.bounceable()), payout.amount(),
+                                               static_cast<uint8_t>(payout.mode()), commentPayload(payout.comment())});
+            continue;
+        }
+        const auto& jetton = payout.jetton_transfer();
+        if (payout.dest().empty() && !senderJettonWallet.has_value()) {
+            throw std::invalid_argument("missing jetton wallet address");
+        }
+        auto dest = payout.dest().empty() ? *senderJettonWallet : Address(payout.dest());
+        dest.isBounceable = payout.bounceable();
+        const auto body = jettonTransferPayload(Address(jetton.response_address()), Address(jetton.to_owner()), jetton.jetton_amount(),
+                                                jetton.forward_amount(), payout.comment(), jetton.query_id());
+        messages.push_back(InternalMessage{dest, payout.amount(), static_cast<uint8_t>(payout.mode()), body});
+    }
+
+    // one expiration for all the external messages, as they are sent together
+    auto expireAt = batch.expire_at();
+    if (expireAt == 0) {
+        expireAt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count()) + 60;
+    }
+
+    std::vector<Data> result;
+    result.reserve((messages.size() + Wallet::maxMessages - 1) / Wallet::maxMessages);
+    auto sequenceNumber = batch.sequence_number();
+    for (auto begin = messages.begin(); begin != messages.end(); ++sequenceNumber) {
+        const auto end = messages.end() - begin > static_cast<std::ptrdiff_t>(Wallet::maxMessages) ? begin + Wallet::maxMessages : messages.end();
+        const auto msg = wallet->createTransferMessage(privateKey, std::vector<InternalMessage>(begin, end), sequenceNumber, expireAt);
+        msg->serialize(result.emplace_back());
+        begin = end;
+    }
+    return result;
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     const auto& privateKey = PrivateKey(input.private_key());
     const auto& publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
@@ -45,7 +100,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
                 const int8_t workchainId = WorkchainType::Basechain;
                 auto wallet = std::make_shared<WalletV4R2>(publicKey, workchainId);
                 const auto& transferMessage = Signer::createTransferMessage(wallet, privateKey, transfer);
-                protoOutput.set_encoded(TW::Base64::encode(transferMessage));
+                TW::Base64::encodeInto(transferMessage, *protoOutput.mutable_encoded());
                 break;
             }
             default:
@@ -56,6 +111,31 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
         } catch (...) { }
         break;
     }
+    case Proto::SigningInput::ActionOneofCase::kBatch: {
+        const auto& batch = input.batch();
+
+        try {
+            switch (batch.wallet_version()) {
+            case Proto::WalletVersion::WALLET_V4_R2: {
+                const int8_t workchainId = WorkchainType::Basechain;
+                auto wallet = std::make_shared<WalletV4R2>(publicKey, workchainId);
+                for (const auto& message : Signer::createBatchMessages(wallet, privateKey, batch)) {
+                    TW::Base64::encodeInto(message, *protoOutput.add_encoded_messages());
+                }
+                break;
+            }
+            default:
+                protoOutput.set_error(Common::Proto::Error_invalid_params);
+                protoOutput.set_error_message("Unsupported wallet version");
+                break;
+            }
+        } catch (const std::exception& e) {
+            protoOutput.clear_encoded_messages();
+            protoOutput.set_error(Common::Proto::Error_invalid_params);
+            protoOutput.set_error_message(e.what());
+        }
+        break;
+    }
     default:
         break;
     }
@@ -23,6 +23,9 @@ public:
     /// Creates a signed transfer message
     static Data createTransferMessage(std::shared_ptr<Wallet> wallet, const PrivateKey& privateKey, const Proto::Transfer& transfer);
 
+    /// Creates the signed external messages of a batch, packing up to Wallet::maxMessages payouts in each
+    static std::vector<Data> createBatchMessages(std::shared_ptr<Wallet> wallet, const PrivateKey& privateKey, const Proto::TransferBatch& batch);
+
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 };
@@ -7,52 +7,46 @@
 #include "Wallet.h"
 
 #include "HexCoding.h"
+#include "TheOpenNetwork/Payloads.h"
 
 namespace TW::TheOpenNetwork {
 
 static const uint32_t standard_wallet_id = 698983191;
 
-Wallet::Wallet(PublicKey publicKey, int8_t workchainId, Data walletCode)
+Wallet::Wallet(PublicKey publicKey, int8_t workchainId, const CommonTON::StateInitTemplate& walletCode)
     : publicKey(std::move(publicKey))
     , workchainId(workchainId)
-    , walletCode(std::move(walletCode))
+    , walletCode(walletCode)
     , walletId(standard_wallet_id + workchainId) {
 }
 
 Address Wallet::getAddress() const {
-    const auto stateInit = this->createStateInit();
-    return Address(workchainId, stateInit.writeTo().intoCell()->hash);
+    const auto data = this->createDataCell();
+    return Address(workchainId, walletCode.hash(*data));
 }
 
 CommonTON::StateInit Wallet::createStateInit() const {
-    Cell::Ref code = Cell::deserialize(walletCode.data(), walletCode.size());
-    Cell::Ref data = this->createDataCell();
-    return StateInit{code, data};
+    return walletCode.withData(this->createDataCell());
 }
 
 Cell::Ref Wallet::createSigningMessage(
-    const Address& dest,
-    uint64_t amount,
+    const std::vector<InternalMessage>& messages,
     uint32_t sequence_number,
-    uint8_t mode,
-    uint32_t expireAt,
-    const std::string& comment
+    uint32_t expireAt
 ) const {
+    if (messages.empty() || messages.size() > maxMessages) {
+        throw std::invalid_argument("invalid number of internal messages");
+    }
+
     CellBuilder builder;
     this->writeSigningPayload(builder, sequence_number, expireAt);
-    builder.appendU8(mode);
 
-    { // Add internal message as a reference cell
-        const auto header = std::make_shared<CommonTON::InternalMessageHeader>(true, dest.isBounceable, dest.addressData, amount);
-        TheOpenNetwork::Message internalMessage = TheOpenNetwork::Message(MessageData(header));
+    for (const auto& message : messages) { // Add each internal message as a reference cell after its mode
+        builder.appendU8(message.mode);
 
-        CellBuilder bodyBuilder;
-        if (!comment.empty()) {
-            const auto& data = Data(comment.begin(), comment.end());
-            bodyBuilder.appendU32(0);
-            bodyBuilder.appendRaw(data, static_cast<uint16_t>(data.size()) * 8);
-        }
-        internalMessage.setBody(bodyBuilder.intoCell());
+        const auto header = std::make_shared<CommonTON::InternalMessageHeader>(true, message.dest.isBounceable, message.dest.addressData, message.amount);
+        TheOpenNetwork::Message internalMessage = TheOpenNetwork::Message(MessageData(header));
+        internalMessage.setBody(message.body);
 
         builder.appendReferenceCell(internalMessage.intoCell());
     }
@@ -68,6 +62,15 @@ Cell::Ref Wallet::createTransferMessage(
     uint8_t mode,
     uint32_t expireAt,
     const std::string& comment
+) const {
+    return createTransferMessage(privateKey, {InternalMessage{dest, amount, mode, commentPayload(comment)}}, sequence_number, expireAt);
+}
+
+Cell::Ref Wallet::createTransferMessage(
+    const PrivateKey& privateKey,
+    const std::vector<InternalMessage>& messages,
+    uint32_t sequence_number,
+    uint32_t expireAt
 ) const {
     const auto transferMessageHeader = std::make_shared<CommonTON::ExternalInboundMessageHeader>(this->getAddress().addressData);
     Message transferMessage = Message(MessageData(transferMessageHeader));
@@ -78,7 +81,7 @@ Cell::Ref Wallet::createTransferMessage(
 
     { // Set body of transfer message
         CellBuilder bodyBuilder;
-        const Cell::Ref signingMessage = this->createSigningMessage(dest, amount, sequence_number, mode, expireAt, comment);
+        const Cell::Ref signingMessage = this->createSigningMessage(messages, sequence_number, expireAt);
         Data data(signingMessage->hash.begin(), signingMessage->hash.end());
         const auto signature = privateKey.sign(data, TWCurveED25519);
 
@@ -16,17 +16,28 @@
 
 namespace TW::TheOpenNetwork {
 
+/// Internal message sent by the wallet: `amount` nanotons and a body to `dest`.
+struct InternalMessage {
+    Address dest;
+    uint64_t amount;
+    uint8_t mode;
+    Cell::Ref body;
+};
+
 class Wallet {
 protected:
     PublicKey publicKey;
     int8_t workchainId;
 
     // Explore standard codes: https://github.com/toncenter/tonweb/blob/master/src/contract/wallet/WalletSources.md
-    const Data walletCode;
+    const CommonTON::StateInitTemplate& walletCode;
     const uint32_t walletId;
 
 public:
-    explicit Wallet(PublicKey publicKey, int8_t workchainId, Data walletCode);
+    /// Maximum number of internal messages per external message, one per reference of the signed body.
+    static constexpr size_t maxMessages = Cell::MAX_REFS;
+
+    explicit Wallet(PublicKey publicKey, int8_t workchainId, const CommonTON::StateInitTemplate& walletCode);
     virtual ~Wallet() noexcept = default;
 
     [[nodiscard]] Address getAddress() const;
@@ -40,18 +51,23 @@ public:
         const std::string& comment = ""
     ) const;
 
+    /// Creates a signed external message sending up to `maxMessages` internal messages at once.
+    [[nodiscard]] Cell::Ref createTransferMessage(
+        const PrivateKey& privateKey,
+        const std::vector<InternalMessage>& messages,
+        uint32_t sequence_number,
+        uint32_t expireAt = 0
+    ) const;
+
 protected:
     [[nodiscard]] virtual Cell::Ref createDataCell() const = 0;
     virtual void writeSigningPayload(CellBuilder& builder, uint32_t sequence_number = 0, uint32_t expireAt = 0) const = 0;
 
 private:
     [[nodiscard]] Cell::Ref createSigningMessage(
-        const Address& dest,
-        uint64_t amount,
+        const std::vector<InternalMessage>& messages,
         uint32_t sequence_number,
-        uint8_t mode,
-        uint32_t expireAt = 0,
-        const std::string& comment = ""
+        uint32_t expireAt = 0
     ) const;
     [[nodiscard]] CommonTON::StateInit createStateInit() const;
 };
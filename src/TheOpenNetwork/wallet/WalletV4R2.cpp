@@ -20,16 +20,21 @@ WalletV4R2::WalletV4R2(PublicKey publicKey, int8_t workchainId)
     : Wallet(
           std::move(publicKey),
           workchainId,
-          WalletV4R2::code
+          WalletV4R2::stateInitTemplate()
       ) {
 }
 
+const CommonTON::StateInitTemplate& WalletV4R2::stateInitTemplate() {
+    static const CommonTON::StateInitTemplate stateInit(code.data(), code.size());
+    return stateInit;
+}
+
 Cell::Ref WalletV4R2::createDataCell() const {
     CellBuilder builder;
 
     builder.appendU32(0);                       // sequence_number
     builder.appendU32(walletId);
-    builder.appendRaw(publicKey.bytes, 256);
+    builder.appendRaw(Data(publicKey.bytes), 256);
     builder.appendBitZero();                    // no plugins
 
     return builder.intoCell();
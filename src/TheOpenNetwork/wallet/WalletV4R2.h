@@ -16,6 +16,9 @@ public:
 
     static const Data code;
 
+    /// StateInit of the wallet code, deserialized once.
+    static const CommonTON::StateInitTemplate& stateInitTemplate();
+
 private:
     [[nodiscard]] Cell::Ref createDataCell() const override;
     void writeSigningPayload(CellBuilder& builder, uint32_t sequence_number = 0, uint32_t expireAt = 0) const override;
@@ -44,20 +44,22 @@ Data Signer::encode(const Transaction& transaction) noexcept {
     const Ethereum::Address to = Ethereum::Address("0x0000000000000000000000000000000000000000");
     const uint256_t amount = 0;
 
-    auto encoded = Data();
-    /// Need to add the following prefix to the tx signbytes to be compatible with
-    /// the Ethereum tx format
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(gasPrice));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to.bytes));
-    append(encoded, RLP::encode(amount));
     /// Chain ID
-    auto payload = Data();
-    append(payload, RLP::encode(chainID));
+    auto payload = RLP::encode(chainID);
     append(payload, transaction.encode());
-    append(encoded, RLP::encode(payload));
-    return RLP::encodeList(encoded);
+
+    /// Need to add the following prefix to the tx signbytes to be compatible with
+    /// the Ethereum tx format
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writer.append(FixedUint256(nonce));
+        writer.append(gasPrice);
+        writer.append(FixedUint256(gasLimit));
+        writer.append(to.bytes);
+        writer.append(amount);
+        writer.append(payload);
+        writer.endList();
+    });
 }
 
 Data Signer::sign(const PrivateKey& privateKey, const Transaction& transaction) noexcept {
@@ -12,43 +12,27 @@ namespace TW::Theta {
 
 using RLP = Ethereum::RLP;
 
-Data encode(const Coins& coins) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(coins.thetaWei));
-    append(encoded, RLP::encode(coins.tfuelWei));
-    return RLP::encodeList(encoded);
+static void write(RLP::Writer& writer, const Coins& coins) {
+    writer.beginList();
+    writer.append(coins.thetaWei);
+    writer.append(coins.tfuelWei);
+    writer.endList();
 }
 
-Data encode(const TxInput& input) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(input.address.bytes));
-    append(encoded, encode(input.coins));
-    append(encoded, RLP::encode(input.sequence));
-    append(encoded, RLP::encode(input.signature));
-    return RLP::encodeList(encoded);
+static void write(RLP::Writer& writer, const TxInput& input) {
+    writer.beginList();
+    writer.append(input.address.bytes);
+    write(writer, input.coins);
+    writer.append(FixedUint256(input.sequence));
+    writer.append(input.signature);
+    writer.endList();
 }
 
-Data encode(const std::vector<TxInput>& inputs) noexcept {
-    auto encoded = Data();
-    for (const auto& input : inputs) {
-        append(encoded, encode(input));
-    }
-    return RLP::encodeList(encoded);
-}
-
-Data encode(const TxOutput& output) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(output.address.bytes));
-    append(encoded, encode(output.coins));
-    return RLP::encodeList(encoded);
-}
-
-Data encode(const std::vector<TxOutput>& outputs) noexcept {
-    auto encoded = Data();
-    for (const auto& output : outputs) {
-        append(encoded, encode(output));
-    }
-    return RLP::encodeList(encoded);
+static void write(RLP::Writer& writer, const TxOutput& output) {
+    writer.beginList();
+    writer.append(output.address.bytes);
+    write(writer, output.coins);
+    writer.endList();
 }
 
 Transaction::Transaction(Ethereum::Address from, Ethereum::Address to,
@@ -66,15 +50,23 @@ Transaction::Transaction(Ethereum::Address from, Ethereum::Address to,
 }
 
 Data Transaction::encode() const noexcept {
-    auto encoded = Data();
-    uint16_t txType = 2; // TxSend
-    append(encoded, RLP::encode(txType));
-    auto encodedData = Data();
-    append(encodedData, Theta::encode(_fee));
-    append(encodedData, Theta::encode(inputs));
-    append(encodedData, Theta::encode(outputs));
-    append(encoded, RLP::encodeList(encodedData));
-    return encoded;
+    const uint16_t txType = 2; // TxSend
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.append(FixedUint256(txType));
+        writer.beginList();
+        write(writer, _fee);
+        writer.beginList();
+        for (const auto& input : inputs) {
+            write(writer, input);
+        }
+        writer.endList();
+        writer.beginList();
+        for (const auto& output : outputs) {
+            write(writer, output);
+        }
+        writer.endList();
+        writer.endList();
+    });
 }
 
 bool Transaction::setSignature(const Ethereum::Address& address, const Data& signature) noexcept {
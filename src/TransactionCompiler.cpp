@@ -7,6 +7,10 @@
 #include "TransactionCompiler.h"
 
 #include "Coin.h"
+#include "Instrumentation.h"
+#include "algorithm/parallel.h"
+
+#include <stdexcept>
 
 using namespace TW;
 
@@ -21,18 +25,66 @@ Data TransactionCompiler::preImageHashes(TWCoinType coinType, const Data& txInpu
     return anyCoinPreImageHashes(coinType, txInputData);
 }
 
-Data TransactionCompiler::compileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<Data>& publicKeys) {
-    // input parameter conversion
+static std::vector<PublicKey> toPublicKeys(TWCoinType coinType, const std::vector<Data>& publicKeys) {
     const auto publicKeyType = ::publicKeyType(coinType);
     std::vector<PublicKey> pubs;
+    pubs.reserve(publicKeys.size());
     for (auto& p: publicKeys) {
         if (!PublicKey::isValid(p, publicKeyType)) {
             throw std::invalid_argument("Invalid public key");
         }
         pubs.emplace_back(p, publicKeyType);
     }
+    return pubs;
+}
+
+Data TransactionCompiler::compileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<Data>& publicKeys) {
+    // input parameter conversion
+    const auto pubs = toPublicKeys(coinType, publicKeys);
 
     Data txOutput;
     anyCoinCompileWithSignatures(coinType, txInputData, signatures, pubs, txOutput);
     return txOutput;
 }
+
+TransactionCompilerBatch::TransactionCompilerBatch(TWCoinType coinType, const std::vector<Data>& txInputs, std::size_t threads)
+    : coinType(coinType), inputSizes(txInputs.size()), contexts(txInputs.size()) {
+    parallelFor(txInputs.size(), threads, [&](std::size_t i) {
+        inputSizes[i] = txInputs[i].size();
+        contexts[i] = anyCoinCompileContext(coinType, txInputs[i]);
+    });
+}
+
+std::vector<Data> TransactionCompilerBatch::preImageHashes(std::size_t threads) {
+    std::vector<Data> hashes(contexts.size());
+    parallelFor(contexts.size(), threads, [&](std::size_t i) {
+        Instrumentation::Operation operation(coinType, TWInstrumentationOperationPreImageHashes, inputSizes[i]);
+        hashes[i] = contexts[i]->preImageHashes();
+        operation.setBytesOut(hashes[i].size());
+    });
+    return hashes;
+}
+
+Data TransactionCompilerBatch::compileWithSignatures(std::size_t index, const std::vector<Data>& signatures, const std::vector<Data>& publicKeys) {
+    if (index >= contexts.size()) {
+        throw std::out_of_range("Invalid transaction index");
+    }
+    const auto pubs = toPublicKeys(coinType, publicKeys);
+
+    Instrumentation::Operation operation(coinType, TWInstrumentationOperationCompile, inputSizes[index]);
+    Data txOutput;
+    contexts[index]->compile(signatures, pubs, txOutput);
+    operation.setBytesOut(txOutput.size());
+    return txOutput;
+}
+
+std::vector<Data> TransactionCompilerBatch::compileWithSignatures(const std::vector<std::vector<Data>>& signatures, const std::vector<std::vector<Data>>& publicKeys, std::size_t threads) {
+    if (signatures.size() != contexts.size() || publicKeys.size() != contexts.size()) {
+        throw std::invalid_argument("Signatures and public keys must be given for every transaction");
+    }
+    std::vector<Data> txOutputs(contexts.size());
+    parallelFor(contexts.size(), threads, [&](std::size_t i) {
+        txOutputs[i] = compileWithSignatures(i, signatures[i], publicKeys[i]);
+    });
+    return txOutputs;
+}
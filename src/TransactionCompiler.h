@@ -10,6 +10,7 @@
 #include "Data.h"
 #include "CoinEntry.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,4 +32,37 @@ public:
     static Data compileWithSignatures(TWCoinType coinType, const Data& txInputData, const std::vector<Data>& signatures, const std::vector<Data>& publicKeys);
 };
 
+/// External signing of a batch of transactions of one coin: each input is parsed, and planned where the coin plans,
+/// once for obtaining its pre-image hashes and then compiling it with the signatures of those hashes.
+/// The outputs are the same as those of `TransactionCompiler::preImageHashes` and `compileWithSignatures`.
+/// Not thread-safe.
+class TransactionCompilerBatch {
+public:
+    /// Parses (and plans) the inputs, on `threads` worker threads; 0 uses the hardware concurrency.
+    TransactionCompilerBatch(TWCoinType coinType, const std::vector<Data>& txInputs, std::size_t threads = 1);
+
+    std::size_t size() const noexcept { return contexts.size(); }
+
+    /// Obtains the pre-signing hashes of all the transactions, in input order.
+    std::vector<Data> preImageHashes(std::size_t threads = 1);
+
+    /// Compiles the transaction at `index` with external signatures.
+    /// @throws std::out_of_range for an invalid index, std::invalid_argument for an invalid public key
+    Data compileWithSignatures(std::size_t index, const std::vector<Data>& signatures, const std::vector<Data>& publicKeys);
+
+    /// Compiles all the transactions, with one list of signatures and public keys per transaction.
+    /// @throws std::invalid_argument if the lists don't match the transactions or for an invalid public key
+    std::vector<Data> compileWithSignatures(const std::vector<std::vector<Data>>& signatures, const std::vector<std::vector<Data>>& publicKeys, std::size_t threads = 1);
+
+private:
+    TWCoinType coinType;
+    std::vector<std::size_t> inputSizes;
+    std::vector<std::unique_ptr<CompileContext>> contexts;
+};
+
 } // namespace TW
+
+/// Wrapper for C interface.
+struct TWTransactionCompilerBatch {
+    TW::TransactionCompilerBatch impl;
+};
@@ -5,21 +5,107 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "Address.h"
 
 #include "Protobuf/TronInternal.pb.h"
 
 #include "../Base58.h"
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
+#include "../proto/Common.pb.h"
 #include "Serialization.h"
 
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include <array>
 #include <chrono>
 #include <cassert>
+#include <stdexcept>
 
 namespace TW::Tron {
 
 const std::string TRANSFER_TOKEN_FUNCTION = "0xa9059cbb";
 
+namespace {
+
+/// Selector of the TRC-20 `transfer(address,uint256)` function.
+const Data gTransferTokenSelector = parse_hex(TRANSFER_TOKEN_FUNCTION);
+
+/// Size of an ABI-encoded `transfer(address,uint256)` call.
+constexpr std::size_t gTransferTokenCallSize = 4 + 32 + 32;
+
+/// Default lifetime of a transaction, in milliseconds.
+constexpr uint64_t gDefaultExpiration = 10 * 60 * 60 * 1000; // 10 hours
+
+/// Output stream feeding the serialized bytes of a message into a hasher, without buffering the whole message.
+class HashingOutputStream final : public google::protobuf::io::ZeroCopyOutputStream {
+public:
+    explicit HashingOutputStream(Hash::StreamHasher& hasher) noexcept : hasher(hasher) {}
+    ~HashingOutputStream() override { flush(); }
+
+    bool Next(void** data, int* size) override {
+        flush();
+        *data = buffer.data();
+        *size = static_cast<int>(buffer.size());
+        pending = buffer.size();
+        return true;
+    }
+
+    void BackUp(int count) override { pending -= static_cast<std::size_t>(count); }
+
+    int64_t ByteCount() const override { return static_cast<int64_t>(written + pending); }
+
+    void flush() {
+        hasher.update(buffer.data(), pending);
+        written += pending;
+        pending = 0;
+    }
+
+private:
+    Hash::StreamHasher& hasher;
+    std::array<byte, 256> buffer;
+    std::size_t pending = 0;
+    std::size_t written = 0;
+};
+
+/// Computes the SHA-256 hash of the serialized message, streaming the serialization into the hasher.
+Data sha256Serialized(const google::protobuf::MessageLite& message) {
+    auto hasher = Hash::StreamHasher(Hash::HasherSha256);
+    {
+        auto stream = HashingOutputStream(hasher);
+        message.SerializeToZeroCopyStream(&stream);
+    }
+    return hasher.finalize();
+}
+
+/// Appends a protobuf varint field, omitted if zero (as proto3 does).
+void appendVarintField(Data& data, uint32_t fieldNumber, uint64_t value) {
+    if (value == 0) {
+        return;
+    }
+    data.push_back(static_cast<byte>(fieldNumber << 3));
+    while (value >= 0x80) {
+        data.push_back(static_cast<byte>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<byte>(value));
+}
+
+/// Returns the timestamp and expiration of a transaction, with the defaults applied.
+std::pair<uint64_t, uint64_t> transactionTimes(uint64_t timestamp, uint64_t expiration) {
+    if (timestamp == 0) {
+        timestamp = duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+    }
+    if (expiration == 0) {
+        expiration = timestamp + gDefaultExpiration;
+    }
+    return {timestamp, expiration};
+}
+
+} // namespace
+
 /// Converts an external TransferContract to an internal one used for signing.
 protocol::TransferContract to_internal(const Proto::TransferContract& transfer) {
     auto internal = protocol::TransferContract();
@@ -224,7 +310,8 @@ protocol::TriggerSmartContract to_internal(const Proto::TransferTRC20Contract& t
     Data amount = data(transferTrc20Contract.amount());
 
     // Encode smart contract call parameters
-    auto contract_params = parse_hex(TRANSFER_TOKEN_FUNCTION);
+    auto contract_params = gTransferTokenSelector;
+    contract_params.reserve(gTransferTokenCallSize);
     pad_left(toAddress, 32);
     pad_left(amount, 32);
     append(contract_params, toAddress);
@@ -253,8 +340,7 @@ protocol::BlockHeader to_internal(const Proto::BlockHeader& header) {
 }
 
 Data getBlockHash(const protocol::BlockHeader& header) {
-    const auto data = header.raw_data().SerializeAsString();
-    return Hash::sha256(data);
+    return sha256Serialized(header.raw_data());
 }
 
 void setBlockReference(const Proto::Transaction& transaction, protocol::Transaction& internal) {
@@ -281,6 +367,10 @@ Proto::SigningOutput signDirect(const Proto::SigningInput& input) {
 }
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    return sign(input, (input.skip_outputs() & Common::Proto::OutputField_json) == 0);
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, bool includeJson) noexcept {
     if (!input.txid().empty()) {
         return signDirect(input);
     }
@@ -403,17 +493,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         *contract->mutable_parameter() = any;
     }
 
-    // Get default timestamp and expiration
-    const uint64_t now = duration_cast<std::chrono::milliseconds>(
-                             std::chrono::system_clock::now().time_since_epoch())
-                             .count();
-    const uint64_t timestamp = input.transaction().timestamp() == 0
-                                   ? now
-                                   : input.transaction().timestamp();
-    const uint64_t expiration = input.transaction().expiration() == 0
-                                    ? timestamp + 10 * 60 * 60 * 1000 // 10 hours
-                                    : input.transaction().expiration();
-
+    const auto [timestamp, expiration] = transactionTimes(input.transaction().timestamp(), input.transaction().expiration());
     internal.mutable_raw_data()->set_timestamp(timestamp);
     internal.mutable_raw_data()->set_expiration(expiration);
     internal.mutable_raw_data()->set_fee_limit(input.transaction().fee_limit());
@@ -422,18 +502,91 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     output.set_ref_block_bytes(internal.raw_data().ref_block_bytes());
     output.set_ref_block_hash(internal.raw_data().ref_block_hash());
 
-    const auto serialized = internal.raw_data().SerializeAsString();
-    const auto hash = Hash::sha256(Data(serialized.begin(), serialized.end()));
+    const auto hash = sha256Serialized(internal.raw_data());
 
     const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     const auto signature = key.sign(hash, TWCurveSECP256k1);
 
-    const auto json = transactionJSON(internal, hash, signature).dump();
-
     output.set_id(hash.data(), hash.size());
     output.set_signature(signature.data(), signature.size());
-    output.set_json(json.data(), json.size());
+    if (includeJson) {
+        output.set_json(transactionJSON(internal, hash, signature).dump());
+    }
+
+    return output;
+}
+
+TRC20TransferTemplate::TRC20TransferTemplate(const std::string& ownerAddress, const std::string& contractAddress, uint64_t feeLimit, const Proto::BlockHeader& blockHeader) {
+    auto transaction = Proto::Transaction();
+    *transaction.mutable_block_header() = blockHeader;
+    auto internal = protocol::Transaction();
+    setBlockReference(transaction, internal);
+    mRefBlockBytes = internal.raw_data().ref_block_bytes();
+    mRefBlockHash = internal.raw_data().ref_block_hash();
+
+    // raw_data is serialized in field order: the block reference, expiration, contract, timestamp and fee limit;
+    // only the expiration, the call data at the end of the contract and the timestamp vary between transfers
+    const auto blockReference = internal.raw_data().SerializeAsString();
+    mPrefix = Data(blockReference.begin(), blockReference.end());
+
+    auto call = protocol::TriggerSmartContract();
+    const auto owner = Base58::decodeCheck(ownerAddress);
+    const auto contractAddr = Base58::decodeCheck(contractAddress);
+    call.set_owner_address(owner.data(), owner.size());
+    call.set_contract_address(contractAddr.data(), contractAddr.size());
+    // placeholder for the call data, which is serialized last
+    call.set_data(std::string(gTransferTokenCallSize, '\x01'));
+    auto raw = protocol::Transaction_raw();
+    auto* contract = raw.add_contract();
+    contract->set_type(protocol::Transaction_Contract_ContractType_TriggerSmartContract);
+    contract->mutable_parameter()->PackFrom(call);
+    const auto serializedContract = raw.SerializeAsString();
+    mContract = Data(serializedContract.begin(), serializedContract.end() - gTransferTokenCallSize);
+    append(mContract, gTransferTokenSelector);
+
+    auto fee = protocol::Transaction_raw();
+    fee.set_fee_limit(feeLimit);
+    const auto serializedFee = fee.SerializeAsString();
+    mSuffix = Data(serializedFee.begin(), serializedFee.end());
+}
+
+Proto::SigningOutput TRC20TransferTemplate::sign(const PrivateKey& privateKey, const std::string& toAddress, const uint256_t& amount, uint64_t timestamp, uint64_t expiration, bool includeJson) const {
+    const auto to = Base58::decodeCheck(toAddress);
+    if (to.size() != Address::size) {
+        throw std::invalid_argument("Invalid recipient address");
+    }
+    const auto [time, expiry] = transactionTimes(timestamp, expiration);
+
+    Data expirationField;
+    appendVarintField(expirationField, 8, expiry);
+    std::array<byte, 64> params{};
+    std::copy(to.begin(), to.end(), params.begin() + 32 - to.size());
+    const auto amountData = store(amount, 32);
+    std::copy(amountData.begin(), amountData.end(), params.begin() + 32);
+    Data timestampField;
+    appendVarintField(timestampField, 14, time);
+
+    auto hasher = Hash::StreamHasher(Hash::HasherSha256);
+    hasher.update(mPrefix).update(expirationField).update(mContract).update(params).update(timestampField).update(mSuffix);
+    const auto hash = hasher.finalize();
+    const auto signature = privateKey.sign(hash, TWCurveSECP256k1);
 
+    auto output = Proto::SigningOutput();
+    output.set_id(hash.data(), hash.size());
+    output.set_signature(signature.data(), signature.size());
+    output.set_ref_block_bytes(mRefBlockBytes);
+    output.set_ref_block_hash(mRefBlockHash);
+    if (includeJson) {
+        auto raw = mPrefix;
+        append(raw, expirationField);
+        append(raw, mContract);
+        append(raw, Data(params.begin(), params.end()));
+        append(raw, timestampField);
+        append(raw, mSuffix);
+        auto internal = protocol::Transaction();
+        internal.mutable_raw_data()->ParseFromArray(raw.data(), static_cast<int>(raw.size()));
+        output.set_json(transactionJSON(internal, hash, signature).dump());
+    }
     return output;
 }
 
@@ -8,8 +8,11 @@
 
 #include "Data.h"
 #include "../PrivateKey.h"
+#include "../uint256.h"
 #include "../proto/Tron.pb.h"
 
+#include <string>
+
 namespace TW::Tron {
 
 /// Helper class that performs Tron transaction signing.
@@ -19,6 +22,34 @@ class Signer {
 
     /// Signs the given transaction.
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs the given transaction, optionally without the JSON representation in the output.
+    static Proto::SigningOutput sign(const Proto::SigningInput& input, bool includeJson) noexcept;
+};
+
+/// A TRC-20 `transfer(address,uint256)` call serialized once, for signing many transfers of a token from the same sender.
+///
+/// The block reference, contract (with the ABI selector) and fee limit of `raw_data` are encoded when the template is
+/// created; signing hashes them together with the recipient, amount, timestamp and expiration, without building the
+/// transaction. Signing gives the same output as `Signer::sign` with the equivalent `TransferTRC20Contract`.
+/// Create a new template when the reference block changes.
+class TRC20TransferTemplate {
+  public:
+    TRC20TransferTemplate(const std::string& ownerAddress, const std::string& contractAddress, uint64_t feeLimit, const Proto::BlockHeader& blockHeader);
+
+    /// Signs a transfer of `amount` tokens to `toAddress`; a zero timestamp or expiration gets the same default as `Signer::sign`.
+    /// Throws `std::invalid_argument` if the recipient address is invalid.
+    Proto::SigningOutput sign(const PrivateKey& privateKey, const std::string& toAddress, const uint256_t& amount, uint64_t timestamp, uint64_t expiration, bool includeJson = true) const;
+
+  private:
+    std::string mRefBlockBytes;
+    std::string mRefBlockHash;
+    /// Serialized block reference.
+    Data mPrefix;
+    /// Serialized contract, up to and including the function selector.
+    Data mContract;
+    /// Serialized fee limit.
+    Data mSuffix;
 };
 
 } // namespace TW::Tron
@@ -8,16 +8,19 @@
 
 #include "../Hash.h"
 
+#include <optional>
+
 using namespace TW;
 
 namespace TW::VeChain {
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+/// The transaction of `input`, without signature.
+static Transaction transactionOf(const Proto::SigningInput& input) {
     auto transaction = Transaction();
     transaction.chainTag = static_cast<uint8_t>(input.chain_tag());
     transaction.blockRef = input.block_ref();
     transaction.expiration = input.expiration();
+    transaction.clauses.reserve(input.clauses_size());
     for (auto& clause : input.clauses()) {
         transaction.clauses.emplace_back(clause);
     }
@@ -25,17 +28,40 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     transaction.gas = input.gas();
     transaction.dependsOn = Data(input.depends_on().begin(), input.depends_on().end());
     transaction.nonce = input.nonce();
-    transaction.signature = sign(key, transaction);
+    return transaction;
+}
 
-    auto protoOutput = Proto::SigningOutput();
+/// Signs `input` with `key`; the transaction is encoded once, its signed encoding reuses the unsigned one.
+static Proto::SigningOutput signWithKey(const Proto::SigningInput& input, const PrivateKey& key) {
+    const auto unsignedEncoded = transactionOf(input).encode();
+    const auto signature = key.sign(Hash::blake2b(unsignedEncoded, 32), TWCurveSECP256k1);
+    const auto encoded = Transaction::encodeSigned(unsignedEncoded, signature);
 
-    auto encoded = transaction.encode();
+    auto protoOutput = Proto::SigningOutput();
     protoOutput.set_encoded(encoded.data(), encoded.size());
-    protoOutput.set_signature(transaction.signature.data(), transaction.signature.size());
-
+    protoOutput.set_signature(signature.data(), signature.size());
     return protoOutput;
 }
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    return signWithKey(input, key);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs) noexcept {
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(inputs.size());
+    std::optional<PrivateKey> key;
+    for (const auto& input : inputs) {
+        const auto keyData = Data(input.private_key().begin(), input.private_key().end());
+        if (!key.has_value() || key->bytes != keyData) {
+            key.emplace(keyData);
+        }
+        outputs.push_back(signWithKey(input, *key));
+    }
+    return outputs;
+}
+
 Data Signer::sign(const PrivateKey& privateKey, Transaction& transaction) noexcept {
     auto encoded = transaction.encode();
     auto hash = Hash::blake2b(encoded, 32);
@@ -8,42 +8,62 @@
 
 #include "../Ethereum/RLP.h"
 
+#include <algorithm>
+#include <span>
+
 namespace TW::VeChain {
 
 using RLP = Ethereum::RLP;
 
-Data encode(const Clause& clause) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(clause.to.bytes));
-    append(encoded, RLP::encode(clause.value));
-    append(encoded, RLP::encode(clause.data));
-    return RLP::encodeList(encoded);
+static void write(RLP::Writer& writer, const Clause& clause) {
+    writer.beginList();
+    writer.append(clause.to.bytes);
+    writer.append(clause.value);
+    writer.append(clause.data);
+    writer.endList();
 }
 
-Data encodeClauses(std::vector<Clause> clauses) noexcept {
-    auto encoded = Data();
-    for (const auto& clause : clauses) {
-        auto encodedClause = encode(clause);
-        append(encoded, encodedClause);
-    }
-    return RLP::encodeList(encoded);
+Data Transaction::encode() const noexcept {
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writer.append(FixedUint256(chainTag));
+        writer.append(FixedUint256(blockRef));
+        writer.append(FixedUint256(expiration));
+        writer.beginList();
+        for (const auto& clause : clauses) {
+            write(writer, clause);
+        }
+        writer.endList();
+        writer.append(FixedUint256(gasPriceCoef));
+        writer.append(FixedUint256(gas));
+        writer.append(dependsOn);
+        writer.append(FixedUint256(nonce));
+        writer.beginList();
+        for (const auto& item : reserved) {
+            writer.append(item);
+        }
+        writer.endList();
+        if (!signature.empty()) {
+            writer.append(signature);
+        }
+        writer.endList();
+    });
 }
 
-Data Transaction::encode() const noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(chainTag));
-    append(encoded, RLP::encode(blockRef));
-    append(encoded, RLP::encode(expiration));
-    append(encoded, encodeClauses(clauses));
-    append(encoded, RLP::encode(gasPriceCoef));
-    append(encoded, RLP::encode(gas));
-    append(encoded, RLP::encode(dependsOn));
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encodeList(reserved));
-    if (!signature.empty()) {
-        append(encoded, RLP::encode(signature));
+Data Transaction::encodeSigned(const Data& unsignedEncoded, const Data& signature) noexcept {
+    if (unsignedEncoded.empty()) {
+        return {};
     }
-    return RLP::encodeList(encoded);
+    // list header: one byte, or one byte and the size of the payload size
+    const auto first = unsignedEncoded[0];
+    const std::size_t headerSize = first <= 0xf7 ? 1 : 1 + (first - 0xf7);
+    const auto fields = std::span<const uint8_t>(unsignedEncoded).subspan(std::min(headerSize, unsignedEncoded.size()));
+    return RLP::encodeWith([&](RLP::Writer& writer) {
+        writer.beginList();
+        writer.appendEncoded(fields);
+        writer.append(signature);
+        writer.endList();
+    });
 }
 
 } // namespace TW::VeChain
@@ -57,6 +57,10 @@ class Transaction {
   public:
     /// Encodes the transaction.
     Data encode() const noexcept;
+
+    /// Encodes a transaction with `signature` from `unsignedEncoded`, its encoding without signature,
+    /// so that the clauses are encoded only once when signing.
+    static Data encodeSigned(const Data& unsignedEncoded, const Data& signature) noexcept;
 };
 
 } // namespace TW::VeChain
@@ -15,7 +15,7 @@ namespace TW::Waves {
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeCURVE25519);
-    auto transaction = Transaction(input, publicKey.bytes);
+    auto transaction = Transaction(input, Data(publicKey.bytes));
 
     Data signature = Signer::sign(privateKey, transaction);
 
@@ -10,6 +10,8 @@
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
 
+#include <optional>
+
 using namespace TW;
 
 namespace TW::Waves {
@@ -18,47 +20,53 @@ using json = nlohmann::json;
 
 const std::string Transaction::WAVES = "WAVES";
 
-Data serializeTransfer(int64_t amount, std::string asset, int64_t fee, std::string fee_asset, Address to, const Data& attachment, int64_t timestamp, const Data& pub_key) {
-    auto data = Data();
-    if (asset.empty()) {
-        asset = Transaction::WAVES;
-    }
-    if (fee_asset.empty()) {
-        fee_asset = Transaction::WAVES;
+/// The decoded ID of an asset, none for WAVES.
+static std::optional<Data> assetId(const std::string& asset) {
+    if (asset.empty() || asset == Transaction::WAVES) {
+        return std::nullopt;
     }
-    data.resize(2);
-    data[0] = static_cast<byte>(TransactionType::transfer);
-    data[1] = static_cast<byte>(TransactionVersion::V2);
-    append(data, pub_key);
-    if (asset == Transaction::WAVES) {
-        data.push_back(static_cast<uint8_t>(0));
-    } else {
-        data.push_back(static_cast<uint8_t>(1));
-        append(data, Base58::decode(asset));
-    }
-    if (fee_asset == Transaction::WAVES) {
+    return Base58::decode(asset);
+}
+
+/// Appends the asset flag, and the asset ID unless it is WAVES.
+static void appendAsset(const std::optional<Data>& assetId, Data& data) {
+    if (!assetId.has_value()) {
         data.push_back(static_cast<uint8_t>(0));
     } else {
         data.push_back(static_cast<uint8_t>(1));
-        append(data, Base58::decode(fee_asset));
+        append(data, *assetId);
     }
+}
+
+Data serializeTransfer(int64_t amount, const std::string& asset, int64_t fee, const std::string& fee_asset, const Address& to, const Data& attachment, int64_t timestamp, const Data& pub_key) {
+    const auto assetData = assetId(asset);
+    const auto feeAssetData = assetId(fee_asset);
+    const auto idSize = [](const std::optional<Data>& id) { return id.has_value() ? id->size() : 0; };
+    auto data = Data();
+    // type, version, key, assets with flags, timestamp, amount, fee, recipient, attachment with size
+    data.reserve(2 + pub_key.size() + 2 + idSize(assetData) + idSize(feeAssetData) + 3 * 8 + Address::size + 2 + attachment.size());
+    data.push_back(static_cast<byte>(TransactionType::transfer));
+    data.push_back(static_cast<byte>(TransactionVersion::V2));
+    append(data, pub_key);
+    appendAsset(assetData, data);
+    appendAsset(feeAssetData, data);
     encode64BE(timestamp, data);
     encode64BE(amount, data);
     encode64BE(fee, data);
-    append(data, Data(std::begin(to.bytes), std::end(to.bytes)));
+    data.insert(data.end(), to.bytes.begin(), to.bytes.end());
     encodeDynamicLengthBytes(attachment, data);
 
     return data;
 }
 
-Data serializeLease(int64_t amount, int64_t fee, Address to, int64_t timestamp, const Data& pub_key) {
+Data serializeLease(int64_t amount, int64_t fee, const Address& to, int64_t timestamp, const Data& pub_key) {
     auto data = Data();
-    data.resize(2);
-    data[0] = static_cast<byte>(TransactionType::lease);
-    data[1] = static_cast<byte>(TransactionVersion::V2);
+    data.reserve(3 + pub_key.size() + Address::size + 3 * 8);
+    data.push_back(static_cast<byte>(TransactionType::lease));
+    data.push_back(static_cast<byte>(TransactionVersion::V2));
     data.push_back(static_cast<uint8_t>(0));
     append(data, pub_key);
-    append(data, Data(std::begin(to.bytes), std::end(to.bytes)));
+    data.insert(data.end(), to.bytes.begin(), to.bytes.end());
     encode64BE(amount, data);
     encode64BE(fee, data);
     encode64BE(timestamp, data);
@@ -68,9 +76,9 @@ Data serializeLease(int64_t amount, int64_t fee, Address to, int64_t timestamp,
 
 Data serializeCancelLease(const Data& leaseId, int64_t fee, int64_t timestamp, const Data& pub_key) {
     auto data = Data();
-    data.resize(2);
-    data[0] = static_cast<byte>(TransactionType::cancelLease);
-    data[1] = static_cast<byte>(TransactionVersion::V2);
+    data.reserve(3 + pub_key.size() + 2 * 8 + leaseId.size());
+    data.push_back(static_cast<byte>(TransactionType::cancelLease));
+    data.push_back(static_cast<byte>(TransactionVersion::V2));
     data.push_back(static_cast<uint8_t>(87));
     append(data, pub_key);
     encode64BE(fee, data);
@@ -137,7 +145,7 @@ Data Transaction::serializeToSign() const {
         throw std::invalid_argument("Public key can't be empty");
     }
     if (input.has_transfer_message()) {
-        auto message = input.transfer_message();
+        const auto& message = input.transfer_message();
         auto attachment =
             Data(message.attachment().begin(), message.attachment().end());
         if (attachment.size() > 140) {
@@ -148,10 +156,10 @@ Data Transaction::serializeToSign() const {
                                  Address(message.to()), attachment,
                                  input.timestamp(), pub_key);
     } else if (input.has_lease_message()) {
-        auto message = input.lease_message();
+        const auto& message = input.lease_message();
         return serializeLease(message.amount(), message.fee(), Address(message.to()), input.timestamp(), pub_key);
     } else if (input.has_cancel_lease_message()) {
-        auto message = input.cancel_lease_message();
+        const auto& message = input.cancel_lease_message();
         auto leaseId = Base58::decode(message.lease_id());
         return serializeCancelLease(leaseId, message.fee(), input.timestamp(), pub_key);
     }
@@ -8,17 +8,17 @@
 #include "Cbor.h"
 #include "PublicKey.h"
 
-#include <iostream>
-#include <utility>
 #include <algorithm>
 #include <optional>
+#include <span>
+#include <string_view>
 
 namespace TW::WebAuthn {
 
-// https://www.w3.org/TR/webauthn-2/#authenticator-data
+/// Authenticator data, the fields refer into the parsed buffer.
+/// https://www.w3.org/TR/webauthn-2/#sctn-authenticator-data
 struct AuthData {
-    Data rpIdHash;
-    std::array<std::uint8_t, 1> flagsBuf;
+    std::span<const byte> rpIdHash;
     struct {
         bool up;
         bool uv;
@@ -27,88 +27,108 @@ struct AuthData {
         std::uint8_t flagsInt;
     } flags;
     std::uint32_t counter;
-    Data counterBuf;
-    Data aaguid;
-    Data credID;
-    Data COSEPublicKey;
+    std::span<const byte> aaguid;
+    std::span<const byte> credID;
+    /// Offset of the COSE public key in the buffer, if attested credential data is present
+    std::optional<std::size_t> COSEPublicKeyOffset;
 };
 
-AuthData parseAuthData(const Data& buffer) {
-    AuthData authData;
+std::optional<AuthData> parseAuthData(std::span<const byte> buffer) {
+    static constexpr std::size_t headerSize = 32 + 1 + 4;
+    static constexpr std::size_t attestedHeaderSize = 16 + 2;
+    if (buffer.size() < headerSize) {
+        return std::nullopt;
+    }
 
-    authData.rpIdHash = subData(buffer, 0, 32);
+    AuthData authData{};
+    authData.rpIdHash = buffer.subspan(0, 32);
 
-    auto it = buffer.begin() + 32;
-    authData.flagsBuf = { *it };
-    ++it;
-    std::uint8_t flagsInt = authData.flagsBuf[0];
+    std::uint8_t flagsInt = buffer[32];
     authData.flags.up = !!(flagsInt & 0x01);
     authData.flags.uv = !!(flagsInt & 0x04);
     authData.flags.at = !!(flagsInt & 0x40);
     authData.flags.ed = !!(flagsInt & 0x80);
     authData.flags.flagsInt = flagsInt;
 
-    authData.counterBuf = Data(it, it + 4);
-    authData.counter = static_cast<std::uint32_t>((authData.counterBuf[0] << 24) |
-                                                  (authData.counterBuf[1] << 16) |
-                                                  (authData.counterBuf[2] << 8) |
-                                                  authData.counterBuf[3]);
-    it += 4;
+    authData.counter = static_cast<std::uint32_t>((buffer[33] << 24) |
+                                                  (buffer[34] << 16) |
+                                                  (buffer[35] << 8) |
+                                                  buffer[36]);
 
     if (authData.flags.at) {
-        authData.aaguid = Data(it, it + 16);
-        it += 16;
-
-        std::array<std::uint8_t, 2> credIDLenBuf = { *(it), *(it + 1) };
-        std::uint16_t credIDLen = static_cast<std::uint16_t>((credIDLenBuf[0] << 8) |
-                                                             credIDLenBuf[1]);
-        it += 2;
-
-        authData.credID = Data(it, it + credIDLen);
-        it += credIDLen;
-
-        authData.COSEPublicKey = Data(it, buffer.end());
+        if (buffer.size() < headerSize + attestedHeaderSize) {
+            return std::nullopt;
+        }
+        authData.aaguid = buffer.subspan(headerSize, 16);
+
+        const auto credIDLen = static_cast<std::size_t>((buffer[headerSize + 16] << 8) | buffer[headerSize + 17]);
+        const auto credIDOffset = headerSize + attestedHeaderSize;
+        if (buffer.size() < credIDOffset + credIDLen) {
+            return std::nullopt;
+        }
+        authData.credID = buffer.subspan(credIDOffset, credIDLen);
+        authData.COSEPublicKeyOffset = credIDOffset + credIDLen;
     }
 
     return authData;
 }
 
-auto findIntKey = [](const auto& map, const auto& key) {
-    return std::find_if(map.begin(), map.end(), [&](const auto& p) {
-        return p.first.dumpToString() == key;
-    });
-};
+static bool isStringKey(const Cbor::Decode& key, std::string_view name) {
+    if (key.getMajorType() != Cbor::Decode::MT_string) {
+        return false;
+    }
+    const auto view = key.getBytesView();
+    return std::equal(view.begin(), view.end(), name.begin(), name.end());
+}
 
-auto findStringKey = [](const auto& map, const auto& key) {
-    return std::find_if(map.begin(), map.end(), [&](const auto& p) {
-        return p.first.getString() == key;
-    });
-};
+/// Whether the key is the negative integer `-1 - value`
+static bool isNegativeIntKey(const Cbor::Decode& key, uint64_t value) {
+    return key.getMajorType() == Cbor::Decode::MT_negint && key.getValue() == value;
+}
 
 std::optional<PublicKey> getPublicKey(const Data& attestationObject) {
-    const Data authData = findStringKey(TW::Cbor::Decode(attestationObject).getMapElements(), "authData")->second.getBytes();
-    if (authData.empty()) {
+    // The authenticator data and the COSE key in it are parsed in place, in the buffer of the attestation object
+    const auto attestation = TW::Cbor::Decode(attestationObject);
+    std::optional<Cbor::Decode> authDataElement;
+    for (const auto& [key, value] : attestation.mapElements()) {
+        if (isStringKey(key, "authData")) {
+            authDataElement = value;
+            break;
+        }
+    }
+    if (!authDataElement.has_value() || authDataElement->getBytesView().empty()) {
         return std::nullopt;
     }
 
-    const AuthData authDataParsed = parseAuthData(authData);
-    const auto COSEPublicKey = TW::Cbor::Decode(authDataParsed.COSEPublicKey).getMapElements();
-
-    if (COSEPublicKey.empty()) {
+    const auto authDataParsed = parseAuthData(authDataElement->getBytesView());
+    if (!authDataParsed.has_value() || !authDataParsed->COSEPublicKeyOffset.has_value()) {
+        return std::nullopt;
+    }
+    const auto COSEPublicKey = authDataElement->getBytesContent(static_cast<uint32_t>(*authDataParsed->COSEPublicKeyOffset));
+    if (COSEPublicKey.length() == 0) {
         return std::nullopt;
     }
 
     // https://www.w3.org/TR/webauthn-2/#sctn-encoded-credPubKey-examples
-    const std::string xKey = "-2";
-    const std::string yKey = "-3";
-
-    const auto x = findIntKey(COSEPublicKey, xKey);
-    const auto y = findIntKey(COSEPublicKey, yKey);
+    // x is under the key -2, y under -3
+    std::span<const byte> x;
+    std::span<const byte> y;
+    for (const auto& [key, value] : COSEPublicKey.mapElements()) {
+        if (isNegativeIntKey(key, 1)) {
+            x = value.getBytesView();
+        } else if (isNegativeIntKey(key, 2)) {
+            y = value.getBytesView();
+        }
+    }
+    if (x.empty() || y.empty()) {
+        return std::nullopt;
+    }
 
     Data publicKey;
+    publicKey.reserve(1 + x.size() + y.size());
     append(publicKey, 0x04);
-    append(publicKey, x->second.getBytes());
-    append(publicKey, y->second.getBytes());
+    publicKey.insert(publicKey.end(), x.begin(), x.end());
+    publicKey.insert(publicKey.end(), y.begin(), y.end());
 
     return PublicKey(publicKey, TWPublicKeyTypeNIST256p1Extended);
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -15,24 +16,46 @@ namespace TW::Ripple {
 
 enum class FieldType;
 
-/// Encodes a field type.
-inline void encodeType(FieldType type, int key, std::vector<uint8_t>& data) {
-    const auto typeValue = static_cast<int>(type);
-    if (typeValue <= 0xf) {
-        if (key <= 0xf) {
-            data.emplace_back(static_cast<uint8_t>((typeValue << 4) | key));
+/// A field identifier, type code and field code, with its encoded header.
+/// Fields are serialized in the order of their identifiers.
+/// See https://xrpl.org/serialization.html#field-ids
+struct FieldId {
+    int type;
+    int key;
+    std::array<uint8_t, 3> header{};
+    uint8_t headerSize = 0;
+
+    constexpr FieldId(FieldType fieldType, int key) : type(static_cast<int>(fieldType)), key(key) {
+        if (type <= 0xf) {
+            if (key <= 0xf) {
+                header = {static_cast<uint8_t>((type << 4) | key)};
+                headerSize = 1;
+            } else {
+                header = {static_cast<uint8_t>(type << 4), static_cast<uint8_t>(key)};
+                headerSize = 2;
+            }
+        } else if (key <= 0xf) {
+            header = {static_cast<uint8_t>(key), static_cast<uint8_t>(type)};
+            headerSize = 2;
         } else {
-            data.emplace_back(static_cast<uint8_t>(typeValue << 4));
-            data.emplace_back(static_cast<uint8_t>(key));
+            header = {0, static_cast<uint8_t>(type), static_cast<uint8_t>(key)};
+            headerSize = 3;
         }
-    } else if (key <= 0xf) {
-        data.emplace_back(static_cast<uint8_t>(key));
-        data.emplace_back(static_cast<uint8_t>(typeValue));
-    } else {
-        data.emplace_back(0);
-        data.emplace_back(static_cast<uint8_t>(typeValue));
-        data.emplace_back(static_cast<uint8_t>(key));
     }
+
+    constexpr bool operator<(const FieldId& other) const noexcept {
+        return type < other.type || (type == other.type && key < other.key);
+    }
+};
+
+/// Encodes a field header.
+inline void encodeField(const FieldId& field, std::vector<uint8_t>& data) {
+    data.insert(data.end(), field.header.begin(), field.header.begin() + field.headerSize);
+}
+
+/// Encodes a field type.
+inline void encodeType(FieldType type, int key, std::vector<uint8_t>& data) {
+    encodeField(FieldId(type, key), data);
 }
 
 /// Encodes a variable length.
@@ -52,13 +75,13 @@ inline void encodeVariableLength(size_t length, std::vector<uint8_t>& data) {
 }
 
 /// Encodes a variable length bytes.
-inline void encodeBytes(std::vector<uint8_t> bytes, std::vector<uint8_t>& data) {
+inline void encodeBytes(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& data) {
     encodeVariableLength(bytes.size(), data);
     data.insert(data.end(), bytes.begin(), bytes.end());
 }
 
 inline void encodeZeros(std::size_t len, std::vector<uint8_t>& data) {
-    append(data, Data(len));
+    data.insert(data.end(), len, 0);
 }
 
 } // namespace TW::Ripple
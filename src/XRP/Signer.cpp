@@ -10,6 +10,16 @@
 
 namespace TW::Ripple {
 
+namespace {
+
+/// First half of the SHA-512 hash, the digest signed by XRP Ledger keys.
+Data sha512Half(const Data& data) {
+    auto hash = Hash::sha512(data);
+    hash.resize(32);
+    return hash;
+}
+
+} // namespace
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto output = Proto::SigningOutput();
@@ -71,13 +81,47 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
 void Signer::sign(const PrivateKey& privateKey, Transaction& transaction) const noexcept {
     /// See https://github.com/trezor/trezor-core/blob/master/src/apps/ripple/sign_tx.py#L59
-    transaction.pub_key = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+    transaction.pub_key = Data(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
 
-    auto unsignedTx = transaction.getPreImage();
-    auto hash = Hash::sha512(unsignedTx);
-    auto half = Data(hash.begin(), hash.begin() + 32);
+    transaction.signature = privateKey.signAsDER(sha512Half(transaction.getPreImage()));
+}
 
-    transaction.signature = privateKey.signAsDER(half);
+Data Signer::multiSign(const PrivateKey& privateKey, const Transaction& transaction) const {
+    const auto signerAccount = Address(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1));
+    const auto signerAccountId = Data(signerAccount.bytes.begin() + 1, signerAccount.bytes.end());
+    return privateKey.signAsDER(sha512Half(transaction.getMultiSigningPreImage(signerAccountId)));
+}
+
+std::vector<Data> Signer::signSequence(const PrivateKey& privateKey, const Transaction& transaction, std::size_t count) const {
+    auto unsignedTx = transaction;
+    unsignedTx.pub_key = Data(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
+
+    // the fields before and after the signature are serialized once, only the sequence number changes
+    Data head;
+    encode32BE(Transaction::signingPrefix, head);
+    unsignedTx.serializeHead(head);
+    Data tail;
+    unsignedTx.serializeTail(tail);
+    const auto sequenceOffset = sizeof(uint32_t) + Transaction::sequenceOffset;
+
+    std::vector<Data> encoded;
+    encoded.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto sequence = static_cast<uint32_t>(transaction.sequence) + static_cast<uint32_t>(i);
+        for (std::size_t b = 0; b < sizeof(sequence); ++b) {
+            head[sequenceOffset + b] = static_cast<byte>(sequence >> (8 * (3 - b)));
+        }
+        const auto digest = Hash::StreamHasher(Hash::HasherSha512).update(head).update(tail).finalize();
+        const auto signature = privateKey.signAsDER(Data(digest.begin(), digest.begin() + 32));
+
+        Data tx;
+        tx.reserve(head.size() + signature.size() + 8 + tail.size());
+        tx.insert(tx.end(), head.begin() + sizeof(uint32_t), head.end());
+        Transaction::encodeSignature(signature, tx);
+        append(tx, tail);
+        encoded.push_back(std::move(tx));
+    }
+    return encoded;
 }
 
 void Signer::signPayment(const Proto::SigningInput& input,
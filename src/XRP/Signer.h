@@ -22,6 +22,13 @@ class Signer {
     /// Signs the given transaction.
     void sign(const PrivateKey& privateKey, Transaction& transaction) const noexcept;
 
+    /// Signs the given transaction as one of the signers of a multi-signed transaction, returns the DER signature.
+    Data multiSign(const PrivateKey& privateKey, const Transaction& transaction) const;
+
+    /// Signs `count` copies of the transaction with consecutive sequence numbers, starting at its sequence number.
+    /// The transaction is serialized once; returns the encoded signed transactions.
+    std::vector<Data> signSequence(const PrivateKey& privateKey, const Transaction& transaction, std::size_t count) const;
+
   private:
     static void signPayment(const Proto::SigningInput& input,
                      Proto::SigningOutput& output,
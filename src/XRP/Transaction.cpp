@@ -15,118 +15,176 @@
 
 namespace TW::Ripple {
 
-const int NETWORK_PREFIX = 0x53545800;
-
-Data Transaction::serialize() const {
-	// See https://xrpl.org/serialization.html
+namespace {
+
+namespace Fields {
+constexpr FieldId transactionType{FieldType::int16, 2};
+constexpr FieldId flags{FieldType::int32, 2};
+constexpr FieldId sequence{FieldType::int32, 4};
+constexpr FieldId destinationTag{FieldType::int32, 14};
+constexpr FieldId lastLedgerSequence{FieldType::int32, 27};
+constexpr FieldId nftokenId{FieldType::hash256, 10};
+constexpr FieldId nftokenSellOffer{FieldType::hash256, 29};
+constexpr FieldId amount{FieldType::amount, 1};
+constexpr FieldId limitAmount{FieldType::amount, 3};
+constexpr FieldId fee{FieldType::amount, 8};
+constexpr FieldId signingPubKey{FieldType::vl, 3};
+constexpr FieldId txnSignature{FieldType::vl, 4};
+constexpr FieldId account{FieldType::account, 1};
+constexpr FieldId destination{FieldType::account, 3};
+constexpr FieldId nftokenOffers{FieldType::vector256, 4};
+
+/// The fields in the order `serialize` writes them.
+constexpr std::array canonicalOrder = {
+    transactionType, flags, sequence, destinationTag, lastLedgerSequence, nftokenId, nftokenSellOffer,
+    amount, limitAmount, fee, signingPubKey, txnSignature, account, destination, nftokenOffers,
+};
+static_assert(std::is_sorted(canonicalOrder.begin(), canonicalOrder.end()), "fields must be sorted by type code, then field code");
+} // namespace Fields
+
+void appendAmount(int64_t amount, Data& data) {
+    if (amount < 0) {
+        return;
+    }
+    const auto start = data.size();
+    encode64BE(uint64_t(amount), data);
+    /// clear first bit to indicate XRP
+    data[start] &= 0x7F;
+    /// set second bit to indicate positive number
+    data[start] |= 0x40;
+}
 
-    auto data = Data();
+} // namespace
 
+void Transaction::serializeHead(Data& data, bool multiSigning) const {
+    // See https://xrpl.org/serialization.html
     /// field must be sorted by field type then by field name
     /// "type"
-    encodeType(FieldType::int16, 2, data);
+    encodeField(Fields::transactionType, data);
     encode16BE(uint16_t(transaction_type), data);
 
     /// "flags"
-    encodeType(FieldType::int32, 2, data);
+    encodeField(Fields::flags, data);
     encode32BE(static_cast<uint32_t>(flags), data);
 
     /// "sequence"
-    encodeType(FieldType::int32, 4, data);
-    encode32BE(sequence, data);
+    encodeField(Fields::sequence, data);
+    encode32BE(static_cast<uint32_t>(sequence), data);
 
     /// "destinationTag"
     if ((transaction_type == TransactionType::payment) && encode_tag) {
-        encodeType(FieldType::int32, 14, data);
+        encodeField(Fields::destinationTag, data);
         encode32BE(static_cast<uint32_t>(destination_tag), data);
     }
 
     /// "lastLedgerSequence"
     if (last_ledger_sequence > 0) {
-        encodeType(FieldType::int32, 27, data);
+        encodeField(Fields::lastLedgerSequence, data);
         encode32BE(last_ledger_sequence, data);
     }
 
     /// "NFTokenId"
     if ((transaction_type == TransactionType::NFTokenCreateOffer) ||
         (transaction_type == TransactionType::NFTokenBurn)) {
-        encodeType(FieldType::hash256, 10, data);
+        encodeField(Fields::nftokenId, data);
         data.insert(data.end(), nftoken_id.begin(), nftoken_id.end());
     }
 
     /// "NFTokenAcceptOffer"
     if (transaction_type == TransactionType::NFTokenAcceptOffer) {
-        encodeType(FieldType::hash256, 29, data);
+        encodeField(Fields::nftokenSellOffer, data);
         data.insert(data.end(), sell_offer.begin(), sell_offer.end());
     }
 
     /// "amount"
     if ((transaction_type == TransactionType::payment) ||
         (transaction_type == TransactionType::NFTokenCreateOffer)) {
-        encodeType(FieldType::amount, 1, data);
-        append(data,
-               (currency_amount.currency.size() > 0) ?
-                 serializeCurrencyAmount(currency_amount) :
-                 serializeAmount(amount));
+        encodeField(Fields::amount, data);
+        if (currency_amount.currency.size() > 0) {
+            append(data, serializeCurrencyAmount(currency_amount));
+        } else {
+            appendAmount(amount, data);
+        }
     } else if (transaction_type == TransactionType::TrustSet) {
-        encodeType(FieldType::amount, 3, data);
+        encodeField(Fields::limitAmount, data);
         append(data, serializeCurrencyAmount(limit_amount));
     }
 
     /// "fee"
-    encodeType(FieldType::amount, 8, data);
-    append(data, serializeAmount(fee));
-
-    /// "signingPubKey"
-    if (!pub_key.empty()) {
-        encodeType(FieldType::vl, 3, data);
+    encodeField(Fields::fee, data);
+    appendAmount(fee, data);
+
+    /// "signingPubKey", empty when multi-signing
+    if (multiSigning) {
+        encodeField(Fields::signingPubKey, data);
+        encodeVariableLength(0, data);
+    } else if (!pub_key.empty()) {
+        encodeField(Fields::signingPubKey, data);
         encodeBytes(pub_key, data);
     }
+}
 
-    /// "txnSignature"
-    if (!signature.empty()) {
-        encodeType(FieldType::vl, 4, data);
-        encodeBytes(signature, data);
-    }
-
+void Transaction::serializeTail(Data& data) const {
     /// "account"
-    encodeType(FieldType::account, 1, data);
-    encodeBytes(serializeAddress(account), data);
+    encodeField(Fields::account, data);
+    encodeVariableLength(Address::size - 1, data);
+    data.insert(data.end(), account.bytes.begin() + 1, account.bytes.end());
 
     /// "destination"
     if ((transaction_type == TransactionType::payment) ||
         (transaction_type == TransactionType::NFTokenCreateOffer)) {
-        encodeType(FieldType::account, 3, data);
+        encodeField(Fields::destination, data);
         encodeBytes(destination, data);
     }
 
     /// "NFTokenOffers"
     if (transaction_type == TransactionType::NFTokenCancelOffer) {
         // only support one offer
-        encodeType(FieldType::vector256, 4, data);
+        encodeField(Fields::nftokenOffers, data);
         encodeBytes(token_offers, data);
     }
+}
 
+void Transaction::encodeSignature(const Data& signature, Data& data) {
+    encodeField(Fields::txnSignature, data);
+    encodeBytes(signature, data);
+}
+
+Data Transaction::serialize() const {
+    auto data = Data();
+    data.reserve(256);
+    serializeHead(data);
+    /// "txnSignature"
+    if (!signature.empty()) {
+        encodeSignature(signature, data);
+    }
+    serializeTail(data);
     return data;
 }
 
 Data Transaction::getPreImage() const {
+    // the signature is not part of the signed data
     auto preImage = Data();
-    encode32BE(NETWORK_PREFIX, preImage);
-    append(preImage, serialize());
+    preImage.reserve(256);
+    encode32BE(signingPrefix, preImage);
+    serializeHead(preImage);
+    serializeTail(preImage);
+    return preImage;
+}
+
+Data Transaction::getMultiSigningPreImage(const Data& signerAccountId) const {
+    auto preImage = Data();
+    preImage.reserve(256);
+    encode32BE(multiSigningPrefix, preImage);
+    serializeHead(preImage, true);
+    serializeTail(preImage);
+    append(preImage, signerAccountId);
     return preImage;
 }
 
 Data Transaction::serializeAmount(int64_t amount) {
-    if (amount < 0) {
-        return Data();
-    }
     auto data = Data();
-    encode64BE(uint64_t(amount), data);
-    /// clear first bit to indicate XRP
-    data[0] &= 0x7F;
-    /// set second bit to indicate positive number
-    data[0] |= 0x40;
+    appendAmount(amount, data);
     return data;
 }
 
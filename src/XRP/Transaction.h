@@ -137,7 +137,24 @@ class Transaction {
     /// simplified serialization format tailored for Payment transaction type
     /// exclusively.
     Data serialize() const;
+    /// Signing data: the `STX\0` prefix and the fields without the signature.
     Data getPreImage() const;
+    /// Multi-signing data for the signer with the given 20-byte account ID: the `SMT\0` prefix, the fields with an
+    /// empty signing public key and without the signature, and the account ID.
+    Data getMultiSigningPreImage(const Data& signerAccountId) const;
+
+    /// Serializes the fields preceding the signature, up to the signing public key.
+    void serializeHead(Data& data, bool multiSigning = false) const;
+    /// Serializes the fields following the signature.
+    void serializeTail(Data& data) const;
+    /// Serializes the signature field.
+    static void encodeSignature(const Data& signature, Data& data);
+    /// Prefix of the single-signing data, `STX\0`.
+    static constexpr uint32_t signingPrefix = 0x53545800;
+    /// Prefix of the multi-signing data, `SMT\0`.
+    static constexpr uint32_t multiSigningPrefix = 0x534D5400;
+    /// Offset of the sequence number in the serialization, after the transaction type and flags fields.
+    static constexpr std::size_t sequenceOffset = 3 + 5 + 1;
 
     static Data serializeAmount(int64_t amount);
     static Data serializeCurrencyAmount(const CurrencyAmount& currency_amount);
@@ -26,11 +26,49 @@ const std::array<TW::byte, 4> SaplingBranchID = {0xbb, 0x09, 0xb8, 0x76};
 /// See https://github.com/zcash/zips/blob/master/zip-0206.rst#blossom-deployment BRANCH_ID section
 const std::array<TW::byte, 4> BlossomBranchID = {0x60, 0x0e, 0xb4, 0x2b};
 
+namespace {
+
+/// BLAKE2b-256 hasher with the parameter block for `personalization` initialized once; copies start from it.
+class PersonalizedHasher {
+public:
+    explicit PersonalizedHasher(const Data& personalization) : prototype(Hash::StreamHasher::blake2b(32, personalization)) {}
+
+    Hash::StreamHasher operator()() const { return prototype; }
+
+private:
+    Hash::StreamHasher prototype;
+};
+
+const PersonalizedHasher& prevoutsHasher() {
+    static const PersonalizedHasher hasher(prevoutsHashPersonalization);
+    return hasher;
+}
+
+const PersonalizedHasher& sequenceHasher() {
+    static const PersonalizedHasher hasher(sequenceHashPersonalization);
+    return hasher;
+}
+
+const PersonalizedHasher& outputsHasher() {
+    static const PersonalizedHasher hasher(outputsHashPersonalization);
+    return hasher;
+}
+
+} // namespace
+
 Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                              uint64_t amount) const {
+                              uint64_t amount, Bitcoin::SigHashCache* cache) const {
     assert(index < inputs.size());
 
     auto data = Data{};
+    encodePreImagePrefix(index, hashType, cache, data);
+    encodePreImageInput(scriptCode, index, amount, data);
+    return data;
+}
+
+void Transaction::encodePreImagePrefix(size_t index, enum TWBitcoinSigHashType hashType, Bitcoin::SigHashCache* cache,
+                                       Data& data) const {
+    using Bitcoin::SigHashCache;
 
     // header
     encode32LE(_version, data);
@@ -40,7 +78,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = SigHashCache::get(cache, &SigHashCache::prevoutHash, [this] { return getPrevoutHash(); });
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -49,7 +87,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = SigHashCache::get(cache, &SigHashCache::sequenceHash, [this] { return getSequenceHash(); });
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -57,13 +95,12 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Outputs (none/one/all, depending on flags)
     if (!Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = SigHashCache::get(cache, &SigHashCache::outputsHash, [this] { return getOutputsHash(); });
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         auto outputData = Data{};
         outputs[index].encode(outputData);
-        auto hashOutputs =
-            TW::Hash::blake2b(outputData, outputData.size(), outputsHashPersonalization);
+        auto hashOutputs = outputsHasher()().update(outputData).finalize();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else {
         fill_n(back_inserter(data), 32, 0);
@@ -92,7 +129,9 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Sighash type
     encode32LE(hashType, data);
+}
 
+void Transaction::encodePreImageInput(const Bitcoin::Script& scriptCode, size_t index, uint64_t amount, Data& data) const {
     // The input being signed (replacing the scriptSig with scriptCode + amount)
     // The prevout may already be contained in hashPrevout, and the nSequence
     // may already be contain in hashSequence.
@@ -101,36 +140,49 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     encode64LE(amount, data);
     encode32LE(inputs[index].sequence, data);
-
-    return data;
 }
 
 Data Transaction::getPrevoutHash() const {
-    auto data = Data{};
+    auto hasher = prevoutsHasher()();
+    Data data;
     for (auto& input : inputs) {
-        auto& outpoint = input.previousOutput;
-        outpoint.encode(data);
+        data.clear();
+        input.previousOutput.encode(data);
+        hasher.update(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, prevoutsHashPersonalization);
-    return hash;
+    return hasher.finalize();
 }
 
 Data Transaction::getSequenceHash() const {
-    auto data = Data{};
+    auto hasher = sequenceHasher()();
+    Data data;
     for (auto& input : inputs) {
+        data.clear();
         encode32LE(input.sequence, data);
+        hasher.update(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, sequenceHashPersonalization);
-    return hash;
+    return hasher.finalize();
 }
 
 Data Transaction::getOutputsHash() const {
-    auto data = Data{};
+    auto hasher = outputsHasher()();
+    Data data;
     for (auto& output : outputs) {
+        data.clear();
         output.encode(data);
+        hasher.update(data);
+    }
+    return hasher.finalize();
+}
+
+void Transaction::primeSigHashCache(Bitcoin::SigHashCache& cache, enum TWBitcoinSigHashType hashType) const {
+    cache.prevoutHash = getPrevoutHash();
+    cache.sequenceHash = getSequenceHash();
+    cache.outputsHash = getOutputsHash();
+    if (!Bitcoin::hashTypeIsSingle(hashType) && !inputs.empty()) {
+        cache.preImagePrefix.reset();
+        preImagePrefixHasher(0, hashType, &cache);
     }
-    auto hash = TW::Hash::blake2b(data, 32, outputsHashPersonalization);
-    return hash;
 }
 
 Data Transaction::getJoinSplitsHash() const {
@@ -176,17 +228,41 @@ void Transaction::encode(Data& data) const {
     encodeVarInt(0, data);
 }
 
-Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
-                                   enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   [[maybe_unused]] Bitcoin::SignatureVersion version) const {
+Hash::StreamHasher Transaction::preImagePrefixHasher(size_t index, enum TWBitcoinSigHashType hashType,
+                                                     Bitcoin::SigHashCache* cache) const {
+    // The prefix commits to the output of the input being signed for single, and can't be shared then
+    const auto shared = cache != nullptr && !Bitcoin::hashTypeIsSingle(hashType);
+    if (shared && cache->preImagePrefix.has_value() && cache->preImagePrefix->first == static_cast<uint32_t>(hashType)) {
+        return cache->preImagePrefix->second;
+    }
+
     Data personalization;
     personalization.reserve(16);
     std::copy(sigHashPersonalization.begin(), sigHashPersonalization.begin() + 12,
               std::back_inserter(personalization));
     std::copy(branchId.begin(), branchId.end(), std::back_inserter(personalization));
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
-    auto hash = Hash::blake2b(preimage, 32, personalization);
-    return hash;
+    auto hasher = Hash::StreamHasher::blake2b(32, personalization);
+
+    Data prefix;
+    encodePreImagePrefix(index, hashType, cache, prefix);
+    hasher.update(prefix);
+    // Only the first hash type is kept, so a primed cache is never written by concurrent signers
+    if (shared && !cache->preImagePrefix.has_value()) {
+        cache->preImagePrefix.emplace(static_cast<uint32_t>(hashType), hasher);
+    }
+    return hasher;
+}
+
+Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
+                                   enum TWBitcoinSigHashType hashType, uint64_t amount,
+                                   [[maybe_unused]] Bitcoin::SignatureVersion version,
+                                   Bitcoin::SigHashCache* cache) const {
+    assert(index < inputs.size());
+
+    auto hasher = preImagePrefixHasher(index, hashType, cache);
+    Data data;
+    encodePreImageInput(scriptCode, index, amount, data);
+    return hasher.update(data).finalize();
 }
 
 Bitcoin::Proto::Transaction Transaction::proto() const {
@@ -51,12 +51,18 @@ struct Transaction {
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
+    /// If `cache` is provided, the transaction-wide hashes are reused across calls.
     Data getPreImage(const Bitcoin::Script& scriptCode, size_t index,
-                     enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                     enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     Bitcoin::SigHashCache* cache = nullptr) const;
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the transaction-wide sighash parts into `cache` up front, inputs can then be hashed concurrently.
+    /// Besides the transparent hashes, this is the BLAKE2b state after the pre-image prefix for `hashType`.
+    void primeSigHashCache(Bitcoin::SigHashCache& cache, enum TWBitcoinSigHashType hashType) const;
+
     Data getJoinSplitsHash() const;
     Data getShieldedSpendsHash() const;
     Data getShieldedOutputsHash() const;
@@ -66,10 +72,22 @@ struct Transaction {
 
     Data getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                           enum TWBitcoinSigHashType hashType, uint64_t amount,
-                          enum Bitcoin::SignatureVersion version) const;
+                          enum Bitcoin::SignatureVersion version,
+                          Bitcoin::SigHashCache* cache = nullptr) const;
 
     /// Converts to Protobuf model
     Bitcoin::Proto::Transaction proto() const;
+
+private:
+    /// Appends the pre-image fields up to and including the hash type, shared by all inputs unless `hashType`
+    /// is single.
+    void encodePreImagePrefix(size_t index, enum TWBitcoinSigHashType hashType, Bitcoin::SigHashCache* cache,
+                              Data& data) const;
+    /// Appends the pre-image fields of the input being signed.
+    void encodePreImageInput(const Bitcoin::Script& scriptCode, size_t index, uint64_t amount, Data& data) const;
+    /// Returns a BLAKE2b hasher fed with the pre-image prefix, from `cache` when possible.
+    Hash::StreamHasher preImagePrefixHasher(size_t index, enum TWBitcoinSigHashType hashType,
+                                            Bitcoin::SigHashCache* cache) const;
 };
 
 } // namespace TW::Zcash
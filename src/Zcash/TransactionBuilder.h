@@ -27,10 +27,19 @@ struct TransactionBuilder {
     /// Builds a transaction by selecting UTXOs and calculating fees.
     template <typename Transaction>
     static Result<Transaction, Common::Proto::SigningError> build(const Bitcoin::TransactionPlan& plan, const std::string& toAddress,
-                             const std::string& changeAddress, enum TWCoinType coin, uint32_t lockTime) {
-        coin = TWCoinTypeZcash;
-        auto tx_result =
-            Bitcoin::TransactionBuilder::build<Transaction>(plan, toAddress, changeAddress, coin, lockTime);
+                             const std::string& changeAddress, [[maybe_unused]] enum TWCoinType coin, uint32_t lockTime) {
+        return withBranchId(plan, Bitcoin::TransactionBuilder::build<Transaction>(plan, toAddress, changeAddress, TWCoinTypeZcash, lockTime));
+    }
+
+    /// Builds a transaction for the addresses of `input`, resolved once per input.
+    template <typename Transaction>
+    static Result<Transaction, Common::Proto::SigningError> build(const Bitcoin::TransactionPlan& plan, const Bitcoin::SigningInput& input) {
+        return withBranchId(plan, Bitcoin::TransactionBuilder::build<Transaction>(plan, input, TWCoinTypeZcash));
+    }
+
+private:
+    template <typename Transaction>
+    static Result<Transaction, Common::Proto::SigningError> withBranchId(const Bitcoin::TransactionPlan& plan, const Result<Transaction, Common::Proto::SigningError>& tx_result) {
         if (!tx_result) { return Result<Transaction, Common::Proto::SigningError>::failure(tx_result.error()); }
         Transaction tx = tx_result.payload();
         // if not set, always use latest consensus branch id
@@ -12,65 +12,46 @@
 #include "Hash.h"
 #include "HexCoding.h"
 #include "uint256.h"
+#include "../proto/Zilliqa.json.pb.h"
 
 #include <cassert>
+#include <optional>
 
-#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/arena.h>
 #include <nlohmann/json.hpp>
 
 namespace TW::Zilliqa {
 
 using ByteArray = ZilliqaMessage::ByteArray;
 
-static inline Data prependZero(Data& data) {
-    if (data.size() < 16) {
-        Data zero = Data(16 - data.size(), 0);
-        zero.insert(zero.end(), data.begin(), data.end());
-        return zero;
+static inline void setPadded(ByteArray& array, const std::string& value) {
+    if (value.size() >= 16) {
+        array.set_data(value);
+        return;
     }
-    return Data(data);
+    auto* data = array.mutable_data();
+    data->assign(16 - value.size(), '\0');
+    data->append(value);
 }
 
-static inline ByteArray* byteArray(Data& amount) {
-    auto* array = new ByteArray();
-    amount = prependZero(amount);
-    array->set_data(amount.data(), amount.size());
-    return array;
-}
-
-static inline ByteArray* byteArray(const void* data, size_t size) {
-    auto* array = new ByteArray();
-    array->set_data(data, size);
-    return array;
-}
-
-Data Signer::getPreImage(const Proto::SigningInput& input, Address& address) noexcept {
-    auto internal = ZilliqaMessage::ProtoTransactionCoreInfo();
-    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    if (!Address::decode(input.to(), address)) {
-        // invalid input address
-        return Data(0);
-    }
-    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
-    auto gasPrice = Data(input.gas_price().begin(), input.gas_price().end());
+/// Serializes the transaction core signed by `publicKey`; messages are allocated on `arena`.
+static Data preImage(const Proto::SigningInput& input, const Data& publicKey, const Address& address, google::protobuf::Arena& arena) {
+    auto& internal = *google::protobuf::Arena::CreateMessage<ZilliqaMessage::ProtoTransactionCoreInfo>(&arena);
 
     internal.set_version(input.version());
     internal.set_nonce(input.nonce());
     internal.set_toaddr(address.getKeyHash().data(), address.getKeyHash().size());
     internal.set_gaslimit(input.gas_limit());
-    internal.set_allocated_senderpubkey(byteArray(pubKey.bytes.data(), pubKey.bytes.size()));
-    internal.set_allocated_gasprice(byteArray(gasPrice));
+    internal.mutable_senderpubkey()->set_data(publicKey.data(), publicKey.size());
+    setPadded(*internal.mutable_gasprice(), input.gas_price());
 
-    Data amount;
     switch (input.transaction().message_oneof_case()) {
-    case Proto::Transaction::kTransfer: {
-        const auto transfer = input.transaction().transfer();
-        amount = Data(transfer.amount().begin(), transfer.amount().end());
+    case Proto::Transaction::kTransfer:
+        setPadded(*internal.mutable_amount(), input.transaction().transfer().amount());
         break;
-    }
     case Proto::Transaction::kRawTransaction: {
-        const auto raw = input.transaction().raw_transaction();
-        amount = Data(raw.amount().begin(), raw.amount().end());
+        const auto& raw = input.transaction().raw_transaction();
+        setPadded(*internal.mutable_amount(), raw.amount());
         if (!raw.code().empty()) {
             internal.set_code(raw.code());
         }
@@ -80,23 +61,38 @@ Data Signer::getPreImage(const Proto::SigningInput& input, Address& address) noe
         break;
     }
     default:
+        setPadded(*internal.mutable_amount(), "");
         break;
     }
 
-    internal.set_allocated_amount(byteArray(amount));
+    Data serialized(internal.ByteSizeLong());
+    internal.SerializeWithCachedSizesToArray(serialized.data());
+    return serialized;
+}
 
-    const auto serialized = internal.SerializeAsString();
-    return Data(serialized.begin(), serialized.end());
+Data Signer::getPreImage(const Proto::SigningInput& input, Address& address) noexcept {
+    if (!Address::decode(input.to(), address)) {
+        // invalid input address
+        return Data(0);
+    }
+    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    google::protobuf::Arena arena;
+    return preImage(input, Data(pubKey.bytes), address, arena);
 }
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+/// Signs `input` with `key`, whose compressed public key is `pubKey`; `arena` is reset by the caller.
+static Proto::SigningOutput signWithKey(const Proto::SigningInput& input, const PrivateKey& key, const PublicKey& pubKey, google::protobuf::Arena& arena) {
     auto output = Proto::SigningOutput();
     Address address;
-    const auto preImage = Signer::getPreImage(input, address);
-    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
-    const auto signature = key.signZilliqa(preImage);
-    const auto transaction = input.transaction();
+    Data signature;
+    if (Address::decode(input.to(), address)) {
+        signature = key.signZilliqa(preImage(input, Data(pubKey.bytes), address, arena), pubKey);
+    } else {
+        // invalid input address, sign an empty pre-image as before
+        signature = key.signZilliqa(Data(), pubKey);
+    }
+    const auto& transaction = input.transaction();
 
     // build json
     nlohmann::json json = {
@@ -112,10 +108,10 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     };
 
     if (transaction.has_transfer()) {
-        const auto transfer = transaction.transfer();
+        const auto& transfer = transaction.transfer();
         json["amount"] = toString(load(transfer.amount()));
     } else if (transaction.has_raw_transaction()) {
-        const auto raw = transaction.raw_transaction();
+        const auto& raw = transaction.raw_transaction();
         json["amount"] = toString(load(raw.amount()));
         if (!raw.code().empty()) {
             json["code"] = hex(Data(raw.code().begin(), raw.code().end()));
@@ -131,9 +127,35 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return output;
 }
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    google::protobuf::Arena arena;
+    return signWithKey(input, key, pubKey, arena);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs) noexcept {
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(inputs.size());
+    google::protobuf::Arena arena;
+    std::optional<PrivateKey> key;
+    std::optional<PublicKey> pubKey;
+    for (const auto& input : inputs) {
+        // payouts usually come from one hot wallet: derive its public key once
+        const auto keyData = Data(input.private_key().begin(), input.private_key().end());
+        if (!key.has_value() || key->bytes != keyData) {
+            key.emplace(keyData);
+            pubKey.emplace(key->getPublicKey(TWPublicKeyTypeSECP256k1));
+        }
+        outputs.push_back(signWithKey(input, *key, *pubKey, arena));
+        arena.Reset();
+    }
+    return outputs;
+}
+
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    ProtoJson::parse(json, input);
     input.set_private_key(key.data(), key.size());
     return hex(Signer::sign(input).json());
 }
@@ -11,6 +11,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Zilliqa.pb.h"
 
+#include <vector>
+
 namespace TW::Zilliqa {
 
 /// Helper class that performs Zilliqa transaction signing.
@@ -21,6 +23,10 @@ class Signer {
     /// Signs the given signing input
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs the given inputs, e.g. exchange payouts; the key and public key derivation is shared by
+    /// consecutive inputs with the same private key. Outputs are the same as `sign` on each input.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs) noexcept;
+
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
 
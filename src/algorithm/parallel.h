@@ -0,0 +1,114 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace TW {
+
+/// Returns the number of workers to use for `count` jobs when `threads` were requested.
+/// `threads == 0` selects the number of threads of the shared executor.
+inline std::size_t parallelWorkerCount(std::size_t count, std::size_t threads) noexcept {
+    if (threads == 0) {
+        threads = std::max<std::size_t>(Executor::shared().threadCount(), 1);
+    }
+    return std::min(threads, count);
+}
+
+/// Invokes `func(i)` for every `i` in `[0, count)` with up to `threads` workers: the calling thread and helpers
+/// scheduled on the shared executor, so the number of threads stays bounded however many callers run concurrently.
+/// Workers pull the next index from a shared counter, so the order of invocations is unspecified,
+/// but every index is processed exactly once.
+/// With `threads == 1` everything runs sequentially in the calling thread, in index order.
+/// Helpers not started by the time the calling thread runs out of indices are cancelled, so nested calls and calls
+/// from executor jobs never wait for a queued job.
+/// The first exception thrown by `func` is rethrown after all started helpers have returned;
+/// remaining indices are not started once an exception has been observed.
+template <typename Func>
+void parallelFor(std::size_t count, std::size_t threads, Func&& func) {
+    const auto workers = parallelWorkerCount(count, threads);
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    // Shared with the helpers, which may start after this call returned.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::size_t active = 0;
+        bool closed = false;
+    };
+    auto state = std::make_shared<State>();
+    auto* body = &func;
+
+    auto worker = [count, body](State& state) {
+        while (!state.failed.load(std::memory_order_relaxed)) {
+            const auto i = state.next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) {
+                return;
+            }
+            try {
+                (*body)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (!state.error) {
+                    state.error = std::current_exception();
+                }
+                state.failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    try {
+        for (std::size_t i = 1; i < workers; ++i) {
+            Executor::shared().submit([state, worker] {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->closed) {
+                        return;
+                    }
+                    ++state->active;
+                }
+                worker(*state);
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    --state->active;
+                }
+                state->finished.notify_all();
+            });
+        }
+    } catch (const std::exception&) {
+        // Could not schedule all helpers; continue with the ones already queued.
+    }
+    // The calling thread takes part in the work as well.
+    worker(*state);
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->closed = true;
+        state->finished.wait(lock, [&state] { return state->active == 0; });
+    }
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace TW
@@ -0,0 +1,57 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWAESStream.h>
+
+#include "../Encrypt.h"
+
+using namespace TW;
+
+struct TWAESStream {
+    Encrypt::AESStream impl;
+};
+
+namespace {
+
+TWAESStream* create(enum TWAESMode mode, bool decrypt, TWData* key, TWData* iv, enum TWAESPaddingMode padding, TWData* aad) {
+    try {
+        const auto streamMode = mode == TWAESModeGCM ? Encrypt::AESStream::Mode::GCM
+                                : mode == TWAESModeCTR ? Encrypt::AESStream::Mode::CTR
+                                                       : Encrypt::AESStream::Mode::CBC;
+        return new TWAESStream{Encrypt::AESStream(streamMode, decrypt, *reinterpret_cast<const Data*>(key),
+                                                  *reinterpret_cast<const Data*>(iv), padding, *reinterpret_cast<const Data*>(aad))};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+struct TWAESStream* _Nullable TWAESStreamCreateEncryptor(enum TWAESMode mode, TWData* _Nonnull key, TWData* _Nonnull iv, enum TWAESPaddingMode padding, TWData* _Nonnull aad) {
+    return create(mode, false, key, iv, padding, aad);
+}
+
+struct TWAESStream* _Nullable TWAESStreamCreateDecryptor(enum TWAESMode mode, TWData* _Nonnull key, TWData* _Nonnull iv, enum TWAESPaddingMode padding, TWData* _Nonnull aad) {
+    return create(mode, true, key, iv, padding, aad);
+}
+
+void TWAESStreamDelete(struct TWAESStream* _Nonnull stream) {
+    delete stream;
+}
+
+TWData* _Nonnull TWAESStreamUpdate(struct TWAESStream* _Nonnull stream, TWData* _Nonnull data) {
+    const auto output = stream->impl.update(*reinterpret_cast<const Data*>(data));
+    return TWDataCreateWithBytes(output.data(), output.size());
+}
+
+TWData* _Nullable TWAESStreamFinish(struct TWAESStream* _Nonnull stream) {
+    try {
+        const auto output = stream->impl.finish();
+        return TWDataCreateWithBytes(output.data(), output.size());
+    } catch (...) {
+        return nullptr;
+    }
+}
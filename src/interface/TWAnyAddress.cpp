@@ -8,10 +8,13 @@
 #include <TrustWalletCore/TWAnyAddress.h>
 #include <TrustWalletCore/TWPublicKey.h>
 
+#include "BinaryCoding.h"
 #include "Data.h"
+#include "DataVector.h"
 #include "Coin.h"
 #include "CoinEntry.h"
 #include "AnyAddress.h"
+#include "TWData+Move.h"
 
 bool TWAnyAddressEqual(struct TWAnyAddress* _Nonnull lhs, struct TWAnyAddress* _Nonnull rhs) {
     return *lhs->impl == *rhs->impl;
@@ -33,6 +36,47 @@ bool TWAnyAddressIsValidBech32(TWString* _Nonnull string, enum TWCoinType coin,
     return TW::validateAddress(coin, address, hrpStr.c_str());
 }
 
+TWData* _Nonnull TWAnyAddressValidateBatch(const struct TWDataVector* _Nonnull addresses, enum TWCoinType coin) {
+    const auto count = addresses->impl.size();
+    TW::Data valid(count);
+    std::string address;
+    for (auto i = 0ul; i < count; ++i) {
+        const auto item = addresses->impl[i];
+        address.assign(item.begin(), item.end());
+        valid[i] = TW::validateAddress(coin, address) ? 1 : 0;
+    }
+    return TWDataCreateWithBytes(valid.data(), valid.size());
+}
+
+TWData* _Nonnull TWAnyAddressDecodeBatch(const struct TWDataVector* _Nonnull addresses, enum TWCoinType coin, uint32_t threads) {
+    const auto count = addresses->impl.size();
+    std::vector<std::string> strings(count);
+    for (auto i = 0ul; i < count; ++i) {
+        const auto item = addresses->impl[i];
+        strings[i].assign(item.begin(), item.end());
+    }
+
+    const auto decoded = TW::decodeAddressBatch(coin, strings, threads);
+
+    std::size_t size = 0;
+    for (const auto& result : decoded) {
+        size += result.valid ? 1 + 4 + result.normalized.size() + 4 + result.data.size() : 1;
+    }
+    TW::Data packed;
+    packed.reserve(size);
+    for (const auto& result : decoded) {
+        packed.push_back(result.valid ? 1 : 0);
+        if (!result.valid) {
+            continue;
+        }
+        TW::encode32LE(static_cast<uint32_t>(result.normalized.size()), packed);
+        packed.insert(packed.end(), result.normalized.begin(), result.normalized.end());
+        TW::encode32LE(static_cast<uint32_t>(result.data.size()), packed);
+        TW::append(packed, result.data);
+    }
+    return TWDataCreateWithDataMove(std::move(packed));
+}
+
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string,
                                                             enum TWCoinType coin) {
     const auto& address = *reinterpret_cast<const std::string*>(string);
@@ -7,6 +7,8 @@
 #include <TrustWalletCore/TWAnySigner.h>
 
 #include "Coin.h"
+#include "DataVector.h"
+#include "TWData+Move.h"
 
 using namespace TW;
 
@@ -14,7 +16,12 @@ TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     const Data& dataIn = *(reinterpret_cast<const Data*>(data));
     Data dataOut;
     TW::anyCoinSign(coin, dataIn, dataOut);
-    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+    return TWDataCreateWithDataMove(std::move(dataOut));
+}
+
+TWDataVector* _Nonnull TWAnySignerSignBatch(const TWDataVector* _Nonnull inputs, enum TWCoinType coin, uint32_t threads) {
+    const auto dataOut = TW::anyCoinSignBatch(coin, inputs->impl.toVector(), threads);
+    return new TWDataVector{DataVector(dataOut)};
 }
 
 TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin) {
@@ -31,5 +38,5 @@ TWData* _Nonnull TWAnySignerPlan(TWData* _Nonnull data, enum TWCoinType coin) {
     const Data& dataIn = *(reinterpret_cast<const Data*>(data));
     Data dataOut;
     TW::anyCoinPlan(coin, dataIn, dataOut);
-    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+    return TWDataCreateWithDataMove(std::move(dataOut));
 }
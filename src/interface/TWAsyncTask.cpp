@@ -0,0 +1,368 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWAsyncTask.h>
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWDataVector.h>
+#include <TrustWalletCore/TWHDWallet.h>
+#include <TrustWalletCore/TWStoredKey.h>
+
+#include "../Coin.h"
+#include "../DataVector.h"
+#include "../Executor.h"
+#include "../memory/memzero_wrapper.h"
+#include "Data.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+/// Inputs signed per batch call, between cancellation checks.
+constexpr std::size_t signBatchChunkSize = 16;
+
+void wipe(Data& data) {
+    memzero(data.data(), data.size());
+    data.clear();
+}
+
+void wipe(std::string& string) {
+    memzero(string.data(), string.size());
+    string.clear();
+}
+
+} // namespace
+
+struct TWAsyncTask {
+    using Operation = bool (*)(TWAsyncTask& task);
+
+    Operation operation;
+    TWAsyncTaskCallback callback;
+    void* context;
+
+    // Copies of the arguments, wiped once the operation has run.
+    TWCoinType coin = TWCoinTypeBitcoin;
+    Data data;
+    std::string first;
+    std::string second;
+    std::vector<Data> inputs;
+    uint32_t threads = 0;
+    TWStoredKey* storedKeyIn = nullptr;
+
+    // Results, set by the operation.
+    std::optional<Data> resultData;
+    std::optional<std::string> resultString;
+    std::optional<std::vector<Data>> resultDataVector;
+    TWHDWallet* resultWallet = nullptr;
+    TWStoredKey* resultStoredKey = nullptr;
+
+    std::atomic<bool> cancelRequested{false};
+    std::mutex mutex;
+    std::condition_variable done;
+    TWAsyncTaskStatus status = TWAsyncTaskStatusPending;
+    // Set once the callback has returned; the task can't be freed before.
+    bool finished = false;
+    // Set by TWAsyncTaskDelete called from the callback.
+    bool deleteRequested = false;
+    std::thread::id worker;
+
+    TWAsyncTask(Operation operation, TWAsyncTaskCallback callback, void* context)
+        : operation(operation), callback(callback), context(context) {}
+
+    ~TWAsyncTask() {
+        wipeArguments();
+        discardResults();
+    }
+
+    void wipeArguments() {
+        wipe(data);
+        wipe(first);
+        wipe(second);
+        for (auto& input : inputs) {
+            wipe(input);
+        }
+        inputs.clear();
+    }
+
+    void discardResults() {
+        if (resultData) {
+            wipe(*resultData);
+            resultData.reset();
+        }
+        if (resultString) {
+            wipe(*resultString);
+            resultString.reset();
+        }
+        if (resultDataVector) {
+            for (auto& output : *resultDataVector) {
+                wipe(output);
+            }
+            resultDataVector.reset();
+        }
+        if (resultWallet != nullptr) {
+            TWHDWalletDelete(resultWallet);
+            resultWallet = nullptr;
+        }
+        if (resultStoredKey != nullptr) {
+            TWStoredKeyDelete(resultStoredKey);
+            resultStoredKey = nullptr;
+        }
+    }
+
+    void run() {
+        {
+            std::lock_guard lock(mutex);
+            worker = std::this_thread::get_id();
+        }
+        auto result = TWAsyncTaskStatusCancelled;
+        if (!cancelRequested.load()) {
+            bool succeeded = false;
+            try {
+                succeeded = operation(*this);
+            } catch (...) {
+                succeeded = false;
+            }
+            if (cancelRequested.load()) {
+                discardResults();
+            } else {
+                result = succeeded ? TWAsyncTaskStatusCompleted : TWAsyncTaskStatusFailed;
+            }
+        }
+        wipeArguments();
+
+        {
+            std::lock_guard lock(mutex);
+            status = result;
+        }
+        done.notify_all();
+        if (callback != nullptr) {
+            callback(this, context);
+        }
+
+        bool deleteNow;
+        {
+            std::lock_guard lock(mutex);
+            finished = true;
+            deleteNow = deleteRequested;
+        }
+        done.notify_all();
+        if (deleteNow) {
+            delete this;
+        }
+    }
+};
+
+namespace {
+
+TWData* borrow(Data& data) {
+    return reinterpret_cast<TWData*>(&data);
+}
+
+TWString* borrow(std::string& string) {
+    return reinterpret_cast<TWString*>(&string);
+}
+
+TWAsyncTask* submit(TWAsyncTask* task) {
+    Executor::shared().submit([task] { task->run(); });
+    return task;
+}
+
+bool sign(TWAsyncTask& task) {
+    Data output;
+    anyCoinSign(task.coin, task.data, output);
+    task.resultData = std::move(output);
+    return true;
+}
+
+bool plan(TWAsyncTask& task) {
+    Data output;
+    anyCoinPlan(task.coin, task.data, output);
+    task.resultData = std::move(output);
+    return true;
+}
+
+bool signBatch(TWAsyncTask& task) {
+    std::vector<Data> outputs;
+    outputs.reserve(task.inputs.size());
+    for (std::size_t begin = 0; begin < task.inputs.size(); begin += signBatchChunkSize) {
+        if (task.cancelRequested.load()) {
+            return false;
+        }
+        const auto end = std::min(begin + signBatchChunkSize, task.inputs.size());
+        const std::vector<Data> chunk(task.inputs.begin() + begin, task.inputs.begin() + end);
+        for (auto& output : anyCoinSignBatch(task.coin, chunk, task.threads)) {
+            outputs.push_back(std::move(output));
+        }
+    }
+    task.resultDataVector = std::move(outputs);
+    return true;
+}
+
+bool createWallet(TWAsyncTask& task) {
+    task.resultWallet = TWHDWalletCreateWithMnemonic(borrow(task.first), borrow(task.second));
+    return task.resultWallet != nullptr;
+}
+
+bool importWallet(TWAsyncTask& task) {
+    task.resultStoredKey = TWStoredKeyImportHDWallet(borrow(task.first), borrow(task.second), borrow(task.data), task.coin);
+    return task.resultStoredKey != nullptr;
+}
+
+bool decryptPrivateKey(TWAsyncTask& task) {
+    auto* key = TWStoredKeyDecryptPrivateKey(task.storedKeyIn, borrow(task.data));
+    if (key == nullptr) {
+        return false;
+    }
+    task.resultData = *reinterpret_cast<const Data*>(key);
+    TWDataDelete(key);
+    return true;
+}
+
+bool decryptMnemonic(TWAsyncTask& task) {
+    auto* mnemonic = TWStoredKeyDecryptMnemonic(task.storedKeyIn, borrow(task.data));
+    if (mnemonic == nullptr) {
+        return false;
+    }
+    task.resultString = *reinterpret_cast<const std::string*>(mnemonic);
+    TWStringDelete(mnemonic);
+    return true;
+}
+
+} // namespace
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerSign(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(sign, callback, context);
+    task->coin = coin;
+    task->data = *reinterpret_cast<const Data*>(input);
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerPlan(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(plan, callback, context);
+    task->coin = coin;
+    task->data = *reinterpret_cast<const Data*>(input);
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskAnySignerSignBatch(const struct TWDataVector* _Nonnull inputs, enum TWCoinType coin, uint32_t threads, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(signBatch, callback, context);
+    task->coin = coin;
+    task->threads = threads;
+    task->inputs = inputs->impl.toVector();
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskHDWalletCreateWithMnemonic(TWString* _Nonnull mnemonic, TWString* _Nonnull passphrase, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(createWallet, callback, context);
+    task->first = *reinterpret_cast<const std::string*>(mnemonic);
+    task->second = *reinterpret_cast<const std::string*>(passphrase);
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyImportHDWallet(TWString* _Nonnull mnemonic, TWString* _Nonnull name, TWData* _Nonnull password, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(importWallet, callback, context);
+    task->coin = coin;
+    task->first = *reinterpret_cast<const std::string*>(mnemonic);
+    task->second = *reinterpret_cast<const std::string*>(name);
+    task->data = *reinterpret_cast<const Data*>(password);
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyDecryptPrivateKey(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(decryptPrivateKey, callback, context);
+    task->storedKeyIn = key;
+    task->data = *reinterpret_cast<const Data*>(password);
+    return submit(task);
+}
+
+struct TWAsyncTask* _Nonnull TWAsyncTaskStoredKeyDecryptMnemonic(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto* task = new TWAsyncTask(decryptMnemonic, callback, context);
+    task->storedKeyIn = key;
+    task->data = *reinterpret_cast<const Data*>(password);
+    return submit(task);
+}
+
+enum TWAsyncTaskStatus TWAsyncTaskGetStatus(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    return task->status;
+}
+
+enum TWAsyncTaskStatus TWAsyncTaskWait(struct TWAsyncTask* _Nonnull task) {
+    std::unique_lock lock(task->mutex);
+    task->done.wait(lock, [task] { return task->status != TWAsyncTaskStatusPending; });
+    return task->status;
+}
+
+bool TWAsyncTaskCancel(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status == TWAsyncTaskStatusCompleted || task->status == TWAsyncTaskStatusFailed) {
+        return false;
+    }
+    task->cancelRequested.store(true);
+    return true;
+}
+
+TWData* _Nullable TWAsyncTaskGetData(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted || !task->resultData) {
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(task->resultData->data(), task->resultData->size());
+}
+
+TWString* _Nullable TWAsyncTaskGetString(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted || !task->resultString) {
+        return nullptr;
+    }
+    return TWStringCreateWithUTF8Bytes(task->resultString->c_str());
+}
+
+struct TWDataVector* _Nullable TWAsyncTaskGetDataVector(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted || !task->resultDataVector) {
+        return nullptr;
+    }
+    return new TWDataVector{DataVector(*task->resultDataVector)};
+}
+
+struct TWHDWallet* _Nullable TWAsyncTaskTakeHDWallet(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted) {
+        return nullptr;
+    }
+    return std::exchange(task->resultWallet, nullptr);
+}
+
+struct TWStoredKey* _Nullable TWAsyncTaskTakeStoredKey(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted) {
+        return nullptr;
+    }
+    return std::exchange(task->resultStoredKey, nullptr);
+}
+
+void TWAsyncTaskDelete(struct TWAsyncTask* _Nonnull task) {
+    std::unique_lock lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusPending && !task->finished && task->worker == std::this_thread::get_id()) {
+        // Called from the callback; freed by the worker once it returns.
+        task->deleteRequested = true;
+        return;
+    }
+    task->cancelRequested.store(true);
+    task->done.wait(lock, [task] { return task->finished; });
+    lock.unlock();
+    delete task;
+}
@@ -0,0 +1,64 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWBitcoinUtxoPool.h>
+
+#include "../Bitcoin/TransactionBuilder.h"
+#include "../Bitcoin/UtxoPool.h"
+#include "Data.h"
+
+using namespace TW;
+
+struct TWBitcoinUtxoPool* _Nonnull TWBitcoinUtxoPoolCreate(enum TWCoinType coin) {
+    return new TWBitcoinUtxoPool{Bitcoin::UtxoPool(coin)};
+}
+
+void TWBitcoinUtxoPoolDelete(struct TWBitcoinUtxoPool* _Nonnull pool) {
+    delete pool;
+}
+
+bool TWBitcoinUtxoPoolAdd(struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull utxo) {
+    const auto& data = *reinterpret_cast<const Data*>(utxo);
+    Bitcoin::Proto::UnspentTransaction proto;
+    if (!proto.ParseFromArray(data.data(), static_cast<int>(data.size())) || proto.out_point().hash().size() != 32) {
+        return false;
+    }
+    pool->impl.add(Bitcoin::UTXO(proto));
+    return true;
+}
+
+bool TWBitcoinUtxoPoolSpend(struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull hash, uint32_t index) {
+    const auto& hashData = *reinterpret_cast<const Data*>(hash);
+    if (hashData.size() != 32) {
+        return false;
+    }
+    return pool->impl.spend(Bitcoin::OutPoint(hashData, index));
+}
+
+size_t TWBitcoinUtxoPoolSize(const struct TWBitcoinUtxoPool* _Nonnull pool) {
+    return pool->impl.size();
+}
+
+int64_t TWBitcoinUtxoPoolAmount(const struct TWBitcoinUtxoPool* _Nonnull pool) {
+    return pool->impl.amount();
+}
+
+int64_t TWBitcoinUtxoPoolSpendableAmount(const struct TWBitcoinUtxoPool* _Nonnull pool, int64_t byteFee) {
+    return pool->impl.spendableAmount(byteFee);
+}
+
+TWData* _Nonnull TWBitcoinUtxoPoolPlan(const struct TWBitcoinUtxoPool* _Nonnull pool, TWData* _Nonnull input) {
+    const auto& inputData = *reinterpret_cast<const Data*>(input);
+    Bitcoin::Proto::SigningInput proto;
+    Bitcoin::Proto::TransactionPlan plan;
+    if (!proto.ParseFromArray(inputData.data(), static_cast<int>(inputData.size()))) {
+        plan.set_error(Common::Proto::Error_input_parse);
+    } else {
+        plan = Bitcoin::TransactionBuilder::plan(Bitcoin::SigningInput(proto), pool->impl).proto();
+    }
+    const auto serialized = plan.SerializeAsString();
+    return TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+}
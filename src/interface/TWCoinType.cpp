@@ -8,6 +8,7 @@
 #include <TrustWalletCore/TWHRP.h>
 
 #include "../Coin.h"
+#include "TWString+Constant.h"
 
 enum TWBlockchain TWCoinTypeBlockchain(enum TWCoinType coin) {
     return TW::blockchain(coin);
@@ -72,7 +73,7 @@ uint8_t TWCoinTypeStaticPrefix(enum TWCoinType coin) {
 }
 
 TWString* _Nonnull TWCoinTypeChainId(enum TWCoinType coin) {
-    return TWStringCreateWithUTF8Bytes(TW::chainId(coin));
+    return TWStringCreateWithConstant(TW::chainId(coin));
 }
 
 uint32_t TWCoinTypeSlip44Id(enum TWCoinType coin) {
@@ -0,0 +1,15 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWData.h>
+
+#include "Data.h"
+
+/// Creates a TWData taking ownership of the bytes of `data`, without copying them.
+/// Internal to the C++ implementation of the interface functions.
+TWData* _Nonnull TWDataCreateWithDataMove(TW::Data&& data);
@@ -6,28 +6,39 @@
 
 #include <TrustWalletCore/TWData.h>
 #include <TrustWalletCore/TWString.h>
+#include "TWData+Move.h"
 #include "Data.h"
 #include "HexCoding.h"
+#include "memory/object_cache.h"
 #include <algorithm>
 #include <vector>
 
 using namespace TW;
 
+using DataCache = ObjectCache<Data>;
+
 TWData *_Nonnull TWDataCreateWithBytes(const uint8_t *_Nonnull bytes, size_t size) {
-    auto* data = new Data();
-    data->reserve(size);
-    std::copy(bytes, bytes + size, std::back_inserter(*data));
+    auto* data = DataCache::acquire();
+    data->assign(bytes, bytes + size);
     return data;
 }
 
+TWData* _Nonnull TWDataCreateWithDataMove(Data&& data) {
+    auto* result = DataCache::acquire();
+    result->swap(data);
+    return result;
+}
+
 TWData *_Nonnull TWDataCreateWithSize(size_t size) {
-    auto* data = new Data(size, 0);
+    auto* data = DataCache::acquire();
+    data->resize(size, 0);
     return data;
 }
 
 TWData *_Nonnull TWDataCreateWithData(TWData *_Nonnull data) {
     auto* other = reinterpret_cast<const Data*>(data);
-    auto* copy = new Data(*other);
+    auto* copy = DataCache::acquire();
+    copy->assign(other->begin(), other->end());
     return copy;
 }
 
@@ -97,8 +108,8 @@ void TWDataReset(TWData *_Nonnull data) {
 }
 
 void TWDataDelete(TWData *_Nonnull data) {
-    auto* v = reinterpret_cast<const Data*>(data);
-    delete v;
+    auto* v = const_cast<Data*>(reinterpret_cast<const Data*>(data));
+    DataCache::release(v);
 }
 
 bool TWDataEqual(TWData *_Nonnull lhs, TWData *_Nonnull rhs) {
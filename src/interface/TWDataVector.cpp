@@ -6,19 +6,15 @@
 
 #include <TrustWalletCore/TWDataVector.h>
 
-#include "Data.h"
+#include "BinaryCoding.h"
+#include "DataVector.h"
+#include "TWData+Move.h"
 
-#include <vector>
 #include <cassert>
+#include <limits>
 
 using namespace TW;
 
-
-struct TWDataVector {
-    std::vector<Data> impl;
-};
-
-
 struct TWDataVector *_Nonnull TWDataVectorCreate() {
     auto* obj = new struct TWDataVector();
     assert(obj != nullptr);
@@ -33,12 +29,29 @@ struct TWDataVector *_Nonnull TWDataVectorCreateWithData(TWData *_Nonnull data)
     return obj;
 }
 
+struct TWDataVector *_Nullable TWDataVectorCreateWithPacked(TWData *_Nonnull bytes, TWData *_Nonnull offsets) {
+    const auto& offsetBytes = *reinterpret_cast<const Data*>(offsets);
+    if (offsetBytes.size() % 4 != 0) {
+        return nullptr;
+    }
+    std::vector<std::size_t> offsetValues;
+    offsetValues.reserve(offsetBytes.size() / 4);
+    for (std::size_t i = 0; i < offsetBytes.size(); i += 4) {
+        offsetValues.push_back(decode32LE(offsetBytes.data() + i));
+    }
+    try {
+        return new TWDataVector{DataVector(*reinterpret_cast<const Data*>(bytes), std::move(offsetValues))};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
 void TWDataVectorDelete(struct TWDataVector *_Nonnull dataVector) {
     delete dataVector;
 }
 
 void TWDataVectorAdd(struct TWDataVector *_Nonnull dataVector, TWData *_Nonnull data) {
-    dataVector->impl.push_back(TW::data(TWDataBytes(data), TWDataSize(data)));
+    dataVector->impl.push_back(std::span<const byte>(TWDataBytes(data), TWDataSize(data)));
 }
 
 size_t TWDataVectorSize(const struct TWDataVector *_Nonnull dataVector) {
@@ -49,6 +62,22 @@ TWData *_Nullable TWDataVectorGet(const struct TWDataVector *_Nonnull dataVector
     if (index >= dataVector->impl.size()) {
         return nullptr;
     }
-    auto& elem = dataVector->impl[index];
+    const auto elem = dataVector->impl[index];
     return TWDataCreateWithBytes(elem.data(), elem.size());
 }
+
+TWData *_Nonnull TWDataVectorPackedBytes(const struct TWDataVector *_Nonnull dataVector) {
+    const auto& bytes = dataVector->impl.packedBytes();
+    return TWDataCreateWithBytes(bytes.data(), bytes.size());
+}
+
+TWData *_Nonnull TWDataVectorPackedOffsets(const struct TWDataVector *_Nonnull dataVector) {
+    const auto& offsets = dataVector->impl.packedOffsets();
+    Data result;
+    result.reserve(offsets.size() * 4);
+    for (const auto offset : offsets) {
+        assert(offset <= std::numeric_limits<uint32_t>::max());
+        encode32LE(static_cast<uint32_t>(offset), result);
+    }
+    return TWDataCreateWithDataMove(std::move(result));
+}
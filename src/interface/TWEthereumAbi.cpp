@@ -9,6 +9,7 @@
 
 #include "Data.h"
 #include "Ethereum/ABI.h"
+#include "Ethereum/ABI/FunctionCache.h"
 #include "Ethereum/ContractCall.h"
 #include "HexCoding.h"
 #include "uint256.h"
@@ -63,3 +64,30 @@ TWData* _Nonnull TWEthereumAbiEncodeTyped(TWString* _Nonnull messageJson) {
     } catch (...) {} // return empty
     return TWDataCreateWithBytes(data.data(), data.size());
 }
+
+TWData* _Nonnull TWEthereumAbiEncodeCompiled(TWString* _Nonnull signature, TWData* _Nonnull packedArguments) {
+    Data data;
+    try {
+        const auto& function = EthAbi::StaticFunction::get(TWStringUTF8Bytes(signature));
+        data = function.encodePacked(std::span(TWDataBytes(packedArguments), TWDataSize(packedArguments)));
+    } catch (...) {} // return empty
+    return TWDataCreateWithBytes(data.data(), data.size());
+}
+
+TWData* _Nonnull TWEthereumAbiEncodeCompiledJson(TWString* _Nonnull signature, TWString* _Nonnull argumentsJson) {
+    Data data;
+    try {
+        const auto& function = EthAbi::StaticFunction::get(TWStringUTF8Bytes(signature));
+        data = function.encodeJson(nlohmann::json::parse(TWStringUTF8Bytes(argumentsJson)));
+    } catch (...) {} // return empty
+    return TWDataCreateWithBytes(data.data(), data.size());
+}
+
+TWData* _Nonnull TWEthereumAbiDecodeCompiled(TWString* _Nonnull signature, TWData* _Nonnull encoded) {
+    Data data;
+    try {
+        const auto& function = EthAbi::StaticFunction::get(TWStringUTF8Bytes(signature));
+        data = function.decodePacked(std::span(TWDataBytes(encoded), TWDataSize(encoded)));
+    } catch (...) {} // return empty
+    return TWDataCreateWithBytes(data.data(), data.size());
+}
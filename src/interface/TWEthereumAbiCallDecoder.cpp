@@ -0,0 +1,44 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWEthereumAbiCallDecoder.h>
+
+#include "Data.h"
+#include "Ethereum/ContractCall.h"
+
+#include <cassert>
+#include <string>
+
+using namespace TW;
+
+struct TWEthereumAbiCallDecoder* _Nonnull TWEthereumAbiCallDecoderCreate() {
+    return new TWEthereumAbiCallDecoder{};
+}
+
+void TWEthereumAbiCallDecoderDelete(struct TWEthereumAbiCallDecoder* _Nonnull decoder) {
+    assert(decoder != nullptr);
+    delete decoder;
+}
+
+bool TWEthereumAbiCallDecoderAddAbi(struct TWEthereumAbiCallDecoder* _Nonnull decoder, TWString* _Nonnull abi) {
+    assert(decoder != nullptr);
+    try {
+        decoder->impl.add(nlohmann::json::parse(TWStringUTF8Bytes(abi)));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+TWString* _Nullable TWEthereumAbiCallDecoderDecode(struct TWEthereumAbiCallDecoder* _Nonnull decoder, TWData* _Nonnull callData) {
+    assert(decoder != nullptr);
+    const auto& call = *reinterpret_cast<const Data*>(callData);
+    const auto decoded = decoder->impl.decode(call);
+    if (!decoded.has_value()) {
+        return nullptr;
+    }
+    return TWStringCreateWithUTF8Bytes(decoded->c_str());
+}
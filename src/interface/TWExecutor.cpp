@@ -0,0 +1,33 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWExecutor.h>
+
+#include "Executor.h"
+
+using namespace TW;
+
+void TWExecutorConfigure(uint32_t threads, uint64_t affinityMask, int32_t priority) {
+    Executor::shared().configure(threads, affinityMask, priority);
+}
+
+uint32_t TWExecutorThreadCount() {
+    return static_cast<uint32_t>(Executor::shared().threadCount());
+}
+
+void TWExecutorSetHost(TWExecutorHostCallback callback, void* context) {
+    if (callback == nullptr) {
+        Executor::shared().setHost(nullptr);
+        return;
+    }
+    Executor::shared().setHost([callback, context](Executor::Job* job) {
+        callback(reinterpret_cast<TWExecutorJob*>(job), context);
+    });
+}
+
+void TWExecutorRunJob(TWExecutorJob* job) {
+    Executor::runHostJob(reinterpret_cast<Executor::Job*>(job));
+}
@@ -7,6 +7,7 @@
 #include <TrustWalletCore/TWHDWallet.h>
 
 #include "../Coin.h"
+#include "../DataVector.h"
 #include "../HDWallet.h"
 #include "../Mnemonic.h"
 
@@ -81,6 +82,20 @@ TWString *_Nonnull TWHDWalletGetAddressDerivation(struct TWHDWallet *wallet, TWC
     return TWStringCreateWithUTF8Bytes(address.c_str());
 }
 
+struct TWDataVector *_Nonnull TWHDWalletDeriveAddresses(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, enum TWDerivation derivation, uint32_t account, uint32_t change, uint32_t startIndex, uint32_t count, uint32_t threads) {
+    auto* result = TWDataVectorCreate();
+    try {
+        const auto addresses = wallet->impl.deriveAddresses(coin, derivation, account, change, startIndex, count, threads);
+        for (const auto& address : addresses) {
+            result->impl.push_back(std::span(reinterpret_cast<const byte*>(address.data()), address.size()));
+        }
+    } catch (...) {
+        TWDataVectorDelete(result);
+        return TWDataVectorCreate();
+    }
+    return result;
+}
+
 struct TWPrivateKey *_Nonnull TWHDWalletGetKey(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, TWString *_Nonnull derivationPath) {
     auto& s = *reinterpret_cast<const std::string*>(derivationPath);
     const auto path = DerivationPath(s);
@@ -0,0 +1,17 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWInstrumentation.h>
+
+#include "Instrumentation.h"
+
+void TWInstrumentationSetCallback(TWInstrumentationCallback callback, void* context) {
+    TW::Instrumentation::setCallback(callback, context);
+}
+
+void TWInstrumentationSetAllocationCounter(TWInstrumentationAllocationCounter counter, void* context) {
+    TW::Instrumentation::setAllocationCounter(counter, context);
+}
@@ -0,0 +1,65 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWMemoryStats.h>
+
+#include "HDNodeCache.h"
+#include "SigningCache.h"
+#include "memory/memory_stats.h"
+
+using namespace TW;
+
+static std::size_t entries(enum TWMemoryCache cache) {
+    switch (cache) {
+    case TWMemoryCacheHDNode:
+        return HDNodeCache::sizeOfAll();
+    case TWMemoryCacheProgramAddress:
+    case TWMemoryCacheFunctionSelector:
+        // blockchain caches, registered when created
+        return MemoryStats::entries(cache);
+    case TWMemoryCacheSigning:
+        return SigningCache::shared().size();
+    }
+    return 0;
+}
+
+struct TWMemoryCacheStats TWMemoryStatsCache(enum TWMemoryCache cache) {
+    if (cache > TWMemoryCacheSigning) {
+        return {};
+    }
+    return {MemoryStats::bytes(cache), MemoryStats::peakBytes(cache), entries(cache)};
+}
+
+uint64_t TWMemoryStatsTotalBytes() {
+    return MemoryStats::totalBytes();
+}
+
+uint64_t TWMemoryStatsOperationPeakBytes(enum TWInstrumentationOperation operation) {
+    return MemoryStats::operationPeakBytes(operation);
+}
+
+void TWMemoryStatsResetPeaks() {
+    MemoryStats::resetPeaks();
+}
+
+void TWMemoryStatsTrim(enum TWMemoryCache cache, uint32_t maxEntries) {
+    switch (cache) {
+    case TWMemoryCacheHDNode:
+        HDNodeCache::trimAll(maxEntries);
+        break;
+    case TWMemoryCacheProgramAddress:
+    case TWMemoryCacheFunctionSelector:
+        MemoryStats::trim(cache, maxEntries);
+        break;
+    case TWMemoryCacheSigning:
+        SigningCache::shared().trim(maxEntries);
+        break;
+    }
+}
+
+void TWMemoryStatsFlush(enum TWMemoryCache cache) {
+    TWMemoryStatsTrim(cache, 0);
+}
@@ -6,9 +6,9 @@
 
 #include "../PrivateKey.h"
 #include "../PublicKey.h"
+#include "../Random.h"
 
 #include <TrezorCrypto/ecdsa.h>
-#include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/secp256k1.h>
 #include <TrustWalletCore/TWPrivateKey.h>
 #include <TrustWalletCore/TWCoinType.h>
@@ -19,7 +19,11 @@ using namespace TW;
 
 struct TWPrivateKey *TWPrivateKeyCreate() {
     Data bytes(PrivateKey::_size);
-    random_buffer(bytes.data(), PrivateKey::_size);
+    try {
+        Random::fill(bytes.data(), PrivateKey::_size);
+    } catch (...) {
+        std::terminate();
+    }
     if (!PrivateKey::isValid(bytes)) {
         // Under no circumstance return an invalid private key. We'd rather
         // crash. This also captures cases where the random generator fails
@@ -42,7 +46,7 @@ struct TWPrivateKey *_Nullable TWPrivateKeyCreateWithData(TWData *_Nonnull data)
 }
 
 struct TWPrivateKey *_Nullable TWPrivateKeyCreateCopy(struct TWPrivateKey *_Nonnull key) {
-   return new TWPrivateKey{ PrivateKey(key->impl.bytes) };
+   return new TWPrivateKey{ key->impl };
 }
 
 void TWPrivateKeyDelete(struct TWPrivateKey *_Nonnull pk) {
@@ -6,8 +6,10 @@
 
 #include <TrustWalletCore/TWPublicKey.h>
 
+#include "../DataVector.h"
 #include "../HexCoding.h"
 #include "../PublicKey.h"
+#include "TWData+Move.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/secp256k1.h>
@@ -66,6 +68,45 @@ bool TWPublicKeyVerifyZilliqaSchnorr(struct TWPublicKey *_Nonnull pk, TWData *_N
     return pk->impl.verifyZilliqa(s, m);
 }
 
+TWData *_Nullable TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, uint32_t threads) {
+    const auto count = publicKeys->impl.size();
+    if (signatures->impl.size() != count || messages->impl.size() != count) {
+        return nullptr;
+    }
+    if (type != TWPublicKeyTypeED25519 && type != TWPublicKeyTypeED25519Blake2b && type != TWPublicKeyTypeED25519Cardano) {
+        return nullptr;
+    }
+
+    auto get = [](const struct TWDataVector* vector, size_t index) {
+        const auto item = vector->impl[index];
+        return TW::Data(item.begin(), item.end());
+    };
+
+    // Items with an invalid public key are reported as invalid without being verified.
+    std::vector<PublicKey> keys;
+    std::vector<TW::Data> sigs;
+    std::vector<TW::Data> msgs;
+    std::vector<size_t> indices;
+    keys.reserve(count);
+    for (auto i = 0ul; i < count; ++i) {
+        const auto key = get(publicKeys, i);
+        if (!PublicKey::isValid(key, type)) {
+            continue;
+        }
+        keys.emplace_back(key, type);
+        sigs.push_back(get(signatures, i));
+        msgs.push_back(get(messages, i));
+        indices.push_back(i);
+    }
+
+    const auto valid = PublicKey::verifyBatch(keys, sigs, msgs, threads);
+    TW::Data result(count, 0);
+    for (auto i = 0ul; i < indices.size(); ++i) {
+        result[indices[i]] = valid[i] ? 1 : 0;
+    }
+    return TWDataCreateWithDataMove(std::move(result));
+}
+
 enum TWPublicKeyType TWPublicKeyKeyType(struct TWPublicKey *_Nonnull publicKey) {
     return publicKey->impl.type;
 }
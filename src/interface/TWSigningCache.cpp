@@ -0,0 +1,21 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWSigningCache.h>
+
+#include "SigningCache.h"
+
+void TWSigningCacheConfigure(uint32_t capacity, uint32_t ttlSeconds) {
+    TW::SigningCache::shared().configure(capacity, std::chrono::seconds(ttlSeconds));
+}
+
+void TWSigningCacheFlush() {
+    TW::SigningCache::shared().clear();
+}
+
+uint32_t TWSigningCacheSize() {
+    return static_cast<uint32_t>(TW::SigningCache::shared().size());
+}
@@ -0,0 +1,81 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWSlip39.h>
+
+#include "../HDWallet.h"
+#include "../Slip39.h"
+
+#include <sstream>
+
+using namespace TW;
+
+namespace {
+
+std::vector<std::string> splitLines(TWString* _Nonnull text) {
+    std::vector<std::string> lines;
+    std::istringstream stream(TWStringUTF8Bytes(text));
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+TWString* _Nullable generate(std::span<const byte> masterSecret, uint8_t groupThreshold, TWData* _Nonnull groups, TWString* _Nonnull passphrase) {
+    const auto& groupBytes = *reinterpret_cast<const Data*>(groups);
+    if (groupBytes.size() % 2 != 0) {
+        return nullptr;
+    }
+    std::vector<Slip39::Group> groupList;
+    for (std::size_t i = 0; i < groupBytes.size(); i += 2) {
+        groupList.push_back(Slip39::Group{groupBytes[i], groupBytes[i + 1]});
+    }
+    try {
+        std::string result;
+        for (const auto& group : Slip39::generate(groupThreshold, groupList, masterSecret, TWStringUTF8Bytes(passphrase))) {
+            for (const auto& share : group) {
+                result += share;
+                result += '\n';
+            }
+        }
+        return TWStringCreateWithUTF8Bytes(result.c_str());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+TWString* _Nullable TWSlip39Generate(TWData* _Nonnull masterSecret, uint8_t groupThreshold, TWData* _Nonnull groups, TWString* _Nonnull passphrase) {
+    return generate(*reinterpret_cast<const Data*>(masterSecret), groupThreshold, groups, passphrase);
+}
+
+TWString* _Nullable TWSlip39GenerateWithWallet(struct TWHDWallet* _Nonnull wallet, uint8_t groupThreshold, TWData* _Nonnull groups, TWString* _Nonnull passphrase) {
+    return generate(wallet->impl.getEntropy(), groupThreshold, groups, passphrase);
+}
+
+TWData* _Nullable TWSlip39Recover(TWString* _Nonnull shares, TWString* _Nonnull passphrase) {
+    const auto secret = Slip39::recover(splitLines(shares), TWStringUTF8Bytes(passphrase));
+    if (!secret) {
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(secret->data(), secret->size());
+}
+
+bool TWSlip39IsValidShare(TWString* _Nonnull share) {
+    return Slip39::isValidShare(TWStringUTF8Bytes(share));
+}
+
+uint64_t TWSlip39VerifyCombinations(TWString* _Nonnull shares) {
+    try {
+        return Slip39::verifyCombinations(splitLines(shares));
+    } catch (...) {
+        return 0;
+    }
+}
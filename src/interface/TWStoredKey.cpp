@@ -8,8 +8,12 @@
 
 #include "../Coin.h"
 #include "Data.h"
+#include "../DataVector.h"
 #include "../HDWallet.h"
+#include "../Keystore/Bulk.h"
+#include "../Keystore/KdfTuning.h"
 #include "../Keystore/StoredKey.h"
+#include "../memory/memzero_wrapper.h"
 
 #include <stdexcept>
 #include <cassert>
@@ -77,13 +81,60 @@ struct TWStoredKey* _Nullable TWStoredKeyImportHDWalletWithEncryption(TWString*
 struct TWStoredKey* _Nullable TWStoredKeyImportJSON(TWData* _Nonnull json) {
     try {
         const auto& d = *reinterpret_cast<const TW::Data*>(json);
-        const auto parsed = nlohmann::json::parse(d);
-        return new TWStoredKey{ KeyStore::StoredKey::createWithJson(nlohmann::json::parse(d)) };
+        return new TWStoredKey{ KeyStore::StoredKey::createWithJsonText(std::string_view(reinterpret_cast<const char*>(d.data()), d.size())) };
     } catch (...) {
         return nullptr;
     }
 }
 
+namespace {
+
+std::vector<std::string> strings(const struct TWDataVector* _Nonnull vector) {
+    std::vector<std::string> result(vector->impl.size());
+    for (auto i = 0ul; i < result.size(); ++i) {
+        const auto item = vector->impl[i];
+        result[i].assign(item.begin(), item.end());
+    }
+    return result;
+}
+
+} // namespace
+
+struct TWDataVector* _Nonnull TWStoredKeyImportHDWalletBatch(const struct TWDataVector* _Nonnull mnemonics, const struct TWDataVector* _Nonnull names, TWData* _Nonnull password, enum TWCoinType coin, enum TWStoredKeyEncryption encryption, uint32_t threads) {
+    auto* result = TWDataVectorCreate();
+    auto mnemonicStrings = strings(mnemonics);
+    if (names->impl.size() != mnemonicStrings.size()) {
+        for (auto i = 0ul; i < mnemonicStrings.size(); ++i) {
+            result->impl.push_back({});
+        }
+    } else {
+        const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
+        const auto imported = KeyStore::Bulk::createWithMnemonics(mnemonicStrings, strings(names), passwordData, coin, encryption, threads);
+        std::string json;
+        for (const auto& each : imported) {
+            json.clear();
+            if (each.key.has_value()) {
+                each.key->writeJson(json);
+            }
+            result->impl.push_back(std::span(reinterpret_cast<const TW::byte*>(json.data()), json.size()));
+        }
+    }
+    for (auto& mnemonic : mnemonicStrings) {
+        TW::memzero(mnemonic.data(), mnemonic.size());
+    }
+    return result;
+}
+
+struct TWDataVector* _Nonnull TWStoredKeyDecryptJSONBatch(const struct TWDataVector* _Nonnull jsons, TWData* _Nonnull password, uint32_t threads) {
+    const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
+    const auto decrypted = KeyStore::Bulk::decryptTexts(strings(jsons), passwordData, threads);
+    auto* result = TWDataVectorCreate();
+    for (const auto& each : decrypted) {
+        result->impl.push_back(std::span(each.secret.data(), each.secret.size()));
+    }
+    return result;
+}
+
 void TWStoredKeyDelete(struct TWStoredKey* _Nonnull key) {
     delete key;
 }
@@ -186,7 +237,7 @@ TWString* _Nullable TWStoredKeyDecryptMnemonic(struct TWStoredKey* _Nonnull key,
     try {
         const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
         const auto data = key->impl.payload.decrypt(passwordData);
-        const auto string = std::string(data.begin(), data.end());
+        const auto string = TW::SecureString(data.begin(), data.end());
         return TWStringCreateWithUTF8Bytes(string.c_str());
     } catch (...) {
         return nullptr;
@@ -212,7 +263,8 @@ struct TWHDWallet* _Nullable TWStoredKeyWallet(struct TWStoredKey* _Nonnull key,
 }
 
 TWData* _Nullable TWStoredKeyExportJSON(struct TWStoredKey* _Nonnull key) {
-    const auto json = key->impl.json().dump();
+    std::string json;
+    key->impl.writeJson(json);
     return TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(json.data()), json.size());
 }
 
@@ -233,3 +285,19 @@ TWString* _Nullable TWStoredKeyEncryptionParameters(struct TWStoredKey* _Nonnull
     const std::string params = key->impl.payload.json().dump();
     return TWStringCreateWithUTF8Bytes(params.c_str());
 }
+
+TWString* _Nonnull TWStoredKeyTuneEncryptionParameters(enum TWStoredKeyEncryptionLevel encryptionLevel, enum TWStoredKeyEncryption encryption) {
+    const std::string params = KeyStore::KdfTuning::tune(encryptionLevel, encryption).json().dump();
+    return TWStringCreateWithUTF8Bytes(params.c_str());
+}
+
+bool TWStoredKeyUpdateEncryptionParameters(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWString* _Nonnull parameters) {
+    try {
+        const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
+        const auto params = KeyStore::EncryptionParameters(nlohmann::json::parse(TWStringUTF8Bytes(parameters)));
+        key->impl.updateEncryptionParameters(passwordData, params);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
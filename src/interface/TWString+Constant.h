@@ -0,0 +1,15 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWString.h>
+
+/// Returns the immortal TWString for `bytes`, a string with static storage (coin symbol, name, id, chain id).
+/// The same object is returned for the same pointer and `TWStringDelete` leaves it alone,
+/// so callers keep the usual create/delete contract without an allocation per call.
+/// Internal to the C++ implementation of the interface functions.
+TWString* _Nonnull TWStringCreateWithConstant(const char* _Nonnull bytes);
@@ -6,15 +6,74 @@
 
 
 #include <TrustWalletCore/TWString.h>
+#include "TWString+Constant.h"
+#include "memory/object_cache.h"
+
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+
+using StringCache = TW::ObjectCache<std::string>;
+
+namespace {
+
+/// Room for the constant strings of every coin (symbol, id, name, chain id).
+constexpr std::size_t constantCapacity = 2048;
+
+/// Storage of the immortal strings, constructed in place and never destroyed.
+alignas(std::string) std::byte constantStorage[constantCapacity * sizeof(std::string)];
+
+struct Constants {
+    std::shared_mutex mutex;
+    std::unordered_map<const char*, std::string*> strings;
+};
+
+Constants& constants() {
+    static auto* registry = new Constants();
+    return *registry;
+}
+
+bool isConstant(const std::string* s) {
+    const auto address = reinterpret_cast<std::uintptr_t>(s);
+    const auto begin = reinterpret_cast<std::uintptr_t>(constantStorage);
+    return address >= begin && address < begin + sizeof(constantStorage);
+}
+
+} // namespace
+
+TWString* _Nonnull TWStringCreateWithConstant(const char* _Nonnull bytes) {
+    auto& registry = constants();
+    {
+        std::shared_lock lock(registry.mutex);
+        if (const auto it = registry.strings.find(bytes); it != registry.strings.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock lock(registry.mutex);
+    if (const auto it = registry.strings.find(bytes); it != registry.strings.end()) {
+        return it->second;
+    }
+    if (registry.strings.size() == constantCapacity) {
+        return TWStringCreateWithUTF8Bytes(bytes);
+    }
+    auto* slot = reinterpret_cast<std::string*>(constantStorage) + registry.strings.size();
+    auto* s = new (slot) std::string(bytes);
+    registry.strings.emplace(bytes, s);
+    return s;
+}
 
 TWString *_Nonnull TWStringCreateWithUTF8Bytes(const char *_Nonnull bytes) {
-    auto* s = new std::string(bytes);
+    auto* s = StringCache::acquire();
+    s->assign(bytes);
     return s;
 }
 
 TWString *_Nonnull TWStringCreateWithRawBytes(const uint8_t *_Nonnull bytes, size_t size) {
-    auto* s = new std::string(bytes, bytes + size);
+    auto* s = StringCache::acquire();
+    s->assign(bytes, bytes + size);
     return s;
 }
 
@@ -34,8 +93,11 @@ const char *_Nonnull TWStringUTF8Bytes(TWString *_Nonnull string) {
 }
 
 void TWStringDelete(TWString *_Nonnull string) {
-    auto* s = reinterpret_cast<const std::string*>(string);
-    delete s;
+    auto* s = const_cast<std::string*>(reinterpret_cast<const std::string*>(string));
+    if (isConstant(s)) {
+        return;
+    }
+    StringCache::release(s);
 }
 
 bool TWStringEqual(TWString *_Nonnull lhs, TWString *_Nonnull rhs) {
@@ -7,7 +7,9 @@
 #include <TrustWalletCore/TWTransactionCompiler.h>
 
 #include "TransactionCompiler.h"
+#include "TWData+Move.h"
 #include "Data.h"
+#include "DataVector.h"
 #include "uint256.h"
 
 #include <cassert>
@@ -28,38 +30,29 @@ TWData *_Nonnull TWTransactionCompilerBuildInput(enum TWCoinType coinType, TWStr
             std::string(TWStringUTF8Bytes(chainId))
         );
     } catch (...) {} // return empty
-    return TWDataCreateWithBytes(result.data(), result.size());
+    return TWDataCreateWithDataMove(std::move(result));
 }
 
 static std::vector<Data> createFromTWDataVector(const struct TWDataVector* _Nonnull dataVector) {
-    std::vector<Data> ret;
-    const auto n = TWDataVectorSize(dataVector);
-    for (auto i = 0uL; i < n; ++i) {
-        const auto* const elem = TWDataVectorGet(dataVector, i);
-        if (const auto* const data = reinterpret_cast<const Data *>(elem); data) {
-            ret.emplace_back(*data);
-            TWDataDelete(elem);
-        }
-    }
-    return ret;
+    return dataVector->impl.toVector();
 }
 
 TWData *_Nonnull TWTransactionCompilerPreImageHashes(enum TWCoinType coinType, TWData *_Nonnull txInputData) {
     Data result;
     try {
         assert(txInputData != nullptr);
-        const Data inputData = data(TWDataBytes(txInputData), TWDataSize(txInputData));
+        const Data& inputData = *reinterpret_cast<const Data*>(txInputData);
 
         result = TransactionCompiler::preImageHashes(coinType, inputData);
     } catch (...) {} // return empty
-    return TWDataCreateWithBytes(result.data(), result.size());
+    return TWDataCreateWithDataMove(std::move(result));
 }
 
 TWData *_Nonnull TWTransactionCompilerCompileWithSignatures(enum TWCoinType coinType, TWData *_Nonnull txInputData, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull publicKeys) {
     Data result;
     try {
         assert(txInputData != nullptr);
-        const Data inputData = data(TWDataBytes(txInputData), TWDataSize(txInputData));
+        const Data& inputData = *reinterpret_cast<const Data*>(txInputData);
         assert(signatures != nullptr);
         const auto signaturesVec = createFromTWDataVector(signatures);
         assert(publicKeys != nullptr);
@@ -67,5 +60,5 @@ TWData *_Nonnull TWTransactionCompilerCompileWithSignatures(enum TWCoinType coin
 
         result  = TransactionCompiler::compileWithSignatures(coinType, inputData, signaturesVec, publicKeysVec);
     } catch (...) {} // return empty
-    return TWDataCreateWithBytes(result.data(), result.size());
+    return TWDataCreateWithDataMove(std::move(result));
 }
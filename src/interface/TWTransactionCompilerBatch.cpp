@@ -0,0 +1,42 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWTransactionCompilerBatch.h>
+
+#include "TransactionCompiler.h"
+#include "TWData+Move.h"
+#include "Data.h"
+#include "DataVector.h"
+
+using namespace TW;
+
+static std::vector<Data> createFromTWDataVector(const struct TWDataVector* _Nonnull dataVector) {
+    return dataVector->impl.toVector();
+}
+
+struct TWTransactionCompilerBatch* _Nonnull TWTransactionCompilerBatchCreate(enum TWCoinType coinType, const struct TWDataVector* _Nonnull txInputs, uint32_t threads) {
+    return new TWTransactionCompilerBatch{TransactionCompilerBatch(coinType, createFromTWDataVector(txInputs), threads)};
+}
+
+void TWTransactionCompilerBatchDelete(struct TWTransactionCompilerBatch* _Nonnull batch) {
+    delete batch;
+}
+
+size_t TWTransactionCompilerBatchSize(const struct TWTransactionCompilerBatch* _Nonnull batch) {
+    return batch->impl.size();
+}
+
+struct TWDataVector* _Nonnull TWTransactionCompilerBatchPreImageHashes(struct TWTransactionCompilerBatch* _Nonnull batch, uint32_t threads) {
+    return new TWDataVector{DataVector(batch->impl.preImageHashes(threads))};
+}
+
+TWData* _Nonnull TWTransactionCompilerBatchCompileWithSignatures(struct TWTransactionCompilerBatch* _Nonnull batch, size_t index, const struct TWDataVector* _Nonnull signatures, const struct TWDataVector* _Nonnull publicKeys) {
+    Data result;
+    try {
+        result = batch->impl.compileWithSignatures(index, createFromTWDataVector(signatures), createFromTWDataVector(publicKeys));
+    } catch (...) {} // return empty
+    return TWDataCreateWithDataMove(std::move(result));
+}
@@ -0,0 +1,103 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "memory_stats.h"
+
+#include <array>
+#include <atomic>
+
+namespace TW::MemoryStats {
+
+namespace {
+
+constexpr std::size_t cacheCount = TWMemoryCacheSigning + 1;
+constexpr std::size_t operationCount = TWInstrumentationOperationCompile + 1;
+
+struct Usage {
+    std::atomic<uint64_t> current{0};
+    std::atomic<uint64_t> peak{0};
+};
+
+std::array<Usage, cacheCount> caches;
+std::array<std::atomic<CacheHooks*>, cacheCount> hooks{};
+std::array<std::atomic<uint64_t>, operationCount> operationPeaks{};
+
+void raise(std::atomic<uint64_t>& peak, uint64_t value) noexcept {
+    auto previous = peak.load(std::memory_order_relaxed);
+    while (previous < value && !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+void allocated(TWMemoryCache cache, std::size_t size) noexcept {
+    auto& usage = caches[cache];
+    const auto current = usage.current.fetch_add(size, std::memory_order_relaxed) + size;
+    raise(usage.peak, current);
+}
+
+void deallocated(TWMemoryCache cache, std::size_t size) noexcept {
+    caches[cache].current.fetch_sub(size, std::memory_order_relaxed);
+}
+
+uint64_t bytes(TWMemoryCache cache) noexcept {
+    return caches[cache].current.load(std::memory_order_relaxed);
+}
+
+uint64_t peakBytes(TWMemoryCache cache) noexcept {
+    return caches[cache].peak.load(std::memory_order_relaxed);
+}
+
+uint64_t totalBytes() noexcept {
+    uint64_t total = 0;
+    for (const auto& usage : caches) {
+        total += usage.current.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void recordOperation(TWInstrumentationOperation operation) noexcept {
+    if (static_cast<std::size_t>(operation) < operationCount) {
+        raise(operationPeaks[operation], totalBytes());
+    }
+}
+
+uint64_t operationPeakBytes(TWInstrumentationOperation operation) noexcept {
+    if (static_cast<std::size_t>(operation) >= operationCount) {
+        return 0;
+    }
+    return operationPeaks[operation].load(std::memory_order_relaxed);
+}
+
+void registerCache(TWMemoryCache cache, CacheHooks cacheHooks) noexcept {
+    // registered once per process, by a static cache; never freed
+    static std::array<CacheHooks, cacheCount> registered;
+    registered[cache] = cacheHooks;
+    hooks[cache].store(&registered[cache], std::memory_order_release);
+}
+
+std::size_t entries(TWMemoryCache cache) {
+    const auto* cacheHooks = hooks[cache].load(std::memory_order_acquire);
+    return cacheHooks != nullptr ? cacheHooks->entries() : 0;
+}
+
+void trim(TWMemoryCache cache, std::size_t maxEntries) {
+    if (const auto* cacheHooks = hooks[cache].load(std::memory_order_acquire); cacheHooks != nullptr) {
+        cacheHooks->trim(maxEntries);
+    }
+}
+
+void resetPeaks() noexcept {
+    for (auto& usage : caches) {
+        usage.peak.store(usage.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    const auto total = totalBytes();
+    for (auto& peak : operationPeaks) {
+        peak.store(total, std::memory_order_relaxed);
+    }
+}
+
+} // namespace TW::MemoryStats
@@ -0,0 +1,100 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrustWalletCore/TWMemoryStats.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TW::MemoryStats {
+
+/// Adds `size` bytes to the current and peak usage of `cache`.
+void allocated(TWMemoryCache cache, std::size_t size) noexcept;
+
+/// Removes `size` bytes from the current usage of `cache`.
+void deallocated(TWMemoryCache cache, std::size_t size) noexcept;
+
+uint64_t bytes(TWMemoryCache cache) noexcept;
+uint64_t peakBytes(TWMemoryCache cache) noexcept;
+uint64_t totalBytes() noexcept;
+
+/// Raises the peak of `operation` to the current total, called when an instrumented operation ends.
+void recordOperation(TWInstrumentationOperation operation) noexcept;
+uint64_t operationPeakBytes(TWInstrumentationOperation operation) noexcept;
+
+/// Resets all peaks to the current usage.
+void resetPeaks() noexcept;
+
+/// Entry count and trimming of a cache of a blockchain, registered by the cache when it is created, so that the
+/// memory stats don't depend on the blockchains of the build.
+struct CacheHooks {
+    std::size_t (*entries)() = nullptr;
+    void (*trim)(std::size_t maxEntries) = nullptr;
+};
+
+void registerCache(TWMemoryCache cache, CacheHooks hooks) noexcept;
+
+/// Number of entries of a registered cache; 0 if it was never created, or is left out of the build.
+std::size_t entries(TWMemoryCache cache);
+
+/// Evicts entries of a registered cache down to `maxEntries`; nothing to do if it was never created.
+void trim(TWMemoryCache cache, std::size_t maxEntries);
+
+/// Standard allocator counting the memory it hands out to `Cache`, for the containers of the caches.
+template <typename T, TWMemoryCache Cache>
+struct CountingAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U, Cache>;
+    };
+
+    CountingAllocator() noexcept = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, Cache>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        auto* pointer = std::allocator<T>().allocate(count);
+        allocated(Cache, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        deallocated(Cache, count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U, Cache>&) const noexcept { return true; }
+};
+
+template <TWMemoryCache Cache>
+using CountedData = std::vector<byte, CountingAllocator<byte, Cache>>;
+
+template <TWMemoryCache Cache>
+using CountedString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char, Cache>>;
+
+/// Lexicographical order of byte or character sequences of any allocator, so that a container keyed by
+/// counted sequences can be searched with plain ones.
+struct SequenceLess {
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const noexcept {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
+
+} // namespace TW::MemoryStats
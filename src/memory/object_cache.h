@@ -0,0 +1,78 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrezorCrypto/memzero.h>
+
+#include <array>
+#include <cstddef>
+
+namespace TW {
+
+/// Per thread cache of released containers (`std::string`, `Data`), reused with their buffer.
+///
+/// Short results (addresses, hashes, keys) are returned over the C interface in a new heap object
+/// which the caller frees right away; recycling the object and its small buffer saves both allocations.
+/// Content is wiped on release, containers with a buffer over `MaxCapacity` bytes are freed.
+template <typename T, std::size_t MaxCapacity = 128, std::size_t Slots = 16>
+class ObjectCache {
+  public:
+    /// Returns an empty object, from the cache if possible.
+    static T* acquire() {
+        if (!closed) {
+            auto& pool = cache();
+            if (pool.count > 0) {
+                return pool.objects[--pool.count];
+            }
+        }
+        return new T();
+    }
+
+    /// Wipes `object` and keeps it for reuse, or deletes it.
+    static void release(T* object) noexcept {
+        wipe(*object);
+        if (object->capacity() <= MaxCapacity && !closed) {
+            auto& pool = cache();
+            if (pool.count < Slots) {
+                pool.objects[pool.count++] = object;
+                return;
+            }
+        }
+        delete object;
+    }
+
+  private:
+    struct Pool {
+        std::array<T*, Slots> objects{};
+        std::size_t count = 0;
+
+        ~Pool() {
+            closed = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                delete objects[i];
+            }
+        }
+    };
+
+    static Pool& cache() noexcept {
+        thread_local Pool pool;
+        return pool;
+    }
+
+    /// Clears `object`, zeroing its whole buffer, including bytes left over past the size.
+    static void wipe(T& object) noexcept {
+        object.resize(object.capacity());
+        ::memzero(object.data(), object.size() * sizeof(typename T::value_type));
+        object.clear();
+    }
+
+    /// Set once the thread's pool is destroyed, objects released later (from other thread_local
+    /// or static destructors) are deleted.
+    static inline thread_local bool closed = false;
+};
+
+} // namespace TW
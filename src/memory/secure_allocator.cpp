@@ -0,0 +1,196 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "secure_allocator.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace TW {
+
+namespace {
+
+/// Size of the slabs the size classes are carved from.
+constexpr std::size_t slabSize = 64 * 1024;
+
+std::size_t pageSize() {
+    static const auto size = [] {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+#else
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return size;
+}
+
+std::size_t roundToPages(std::size_t size) {
+    const auto page = pageSize();
+    return (size + page - 1) / page * page;
+}
+
+/// Index of the smallest size class holding `size` bytes, or `sizeClasses.size()` if none.
+std::size_t sizeClassIndex(std::size_t size) {
+    std::size_t index = 0;
+    while (index < SecureArena::sizeClasses.size() && SecureArena::sizeClasses[index] < size) {
+        ++index;
+    }
+    return index;
+}
+
+} // namespace
+
+SecureArena& SecureArena::instance() {
+    static auto* arena = new SecureArena();
+    return *arena;
+}
+
+void* SecureArena::map(std::size_t size) {
+#ifdef _WIN32
+    void* pointer = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    if (!VirtualLock(pointer, size)) {
+        ++failedLocks;
+    }
+#else
+    void* pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pointer == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    if (mlock(pointer, size) != 0) {
+        ++failedLocks;
+    }
+#ifdef MADV_DONTDUMP
+    // keep key material out of core dumps too
+    madvise(pointer, size, MADV_DONTDUMP);
+#endif
+#endif
+    return pointer;
+}
+
+void SecureArena::unmap(void* pointer, std::size_t size) noexcept {
+#ifdef _WIN32
+    VirtualUnlock(pointer, size);
+    VirtualFree(pointer, 0, MEM_RELEASE);
+#else
+    munlock(pointer, size);
+    munmap(pointer, size);
+#endif
+}
+
+void SecureArena::grow(std::size_t index) {
+    const auto blockSize = sizeClasses[index];
+    auto* slab = static_cast<std::byte*>(map(slabSize));
+    for (std::size_t offset = 0; offset + blockSize <= slabSize; offset += blockSize) {
+        auto* block = reinterpret_cast<FreeBlock*>(slab + offset);
+        block->next = freeLists[index];
+        freeLists[index] = block;
+    }
+}
+
+thread_local SecureArena::ThreadCache SecureArena::threadCache;
+thread_local SecureArena::ThreadCacheFlush SecureArena::threadCacheFlush;
+
+SecureArena::ThreadCacheFlush::~ThreadCacheFlush() {
+    auto& arena = instance();
+    auto& cache = threadCache;
+    std::lock_guard lock(arena.mutex);
+    for (std::size_t index = 0; index < sizeClasses.size(); ++index) {
+        arena.release(cache, index, cache.counts[index]);
+    }
+    cache.closed = true;
+}
+
+void SecureArena::refill(ThreadCache& cache, std::size_t index, std::size_t count) {
+    for (; count > 0; --count) {
+        if (freeLists[index] == nullptr) {
+            grow(index);
+        }
+        auto* block = freeLists[index];
+        freeLists[index] = block->next;
+        block->next = cache.freeLists[index];
+        cache.freeLists[index] = block;
+        ++cache.counts[index];
+    }
+}
+
+void SecureArena::release(ThreadCache& cache, std::size_t index, std::size_t count) noexcept {
+    for (; count > 0 && cache.freeLists[index] != nullptr; --count) {
+        auto* block = cache.freeLists[index];
+        cache.freeLists[index] = block->next;
+        block->next = freeLists[index];
+        freeLists[index] = block;
+        --cache.counts[index];
+    }
+}
+
+void* SecureArena::allocate(std::size_t size) {
+    const auto index = sizeClassIndex(size);
+    if (index == sizeClasses.size()) {
+        std::lock_guard lock(mutex);
+        return map(roundToPages(size));
+    }
+    auto& cache = threadCache;
+    if (cache.closed) {
+        std::lock_guard lock(mutex);
+        ThreadCache single;
+        refill(single, index, 1);
+        return single.freeLists[index];
+    }
+    // registers the flush at thread exit
+    static_cast<void>(&threadCacheFlush);
+    if (cache.freeLists[index] == nullptr) {
+        std::lock_guard lock(mutex);
+        refill(cache, index, threadCacheSize / 2);
+    }
+    auto* block = cache.freeLists[index];
+    cache.freeLists[index] = block->next;
+    --cache.counts[index];
+    block->next = nullptr;
+    return block;
+}
+
+void SecureArena::deallocate(void* pointer, std::size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    const auto index = sizeClassIndex(size);
+    if (index == sizeClasses.size()) {
+        memzero(pointer, size);
+        std::lock_guard lock(mutex);
+        unmap(pointer, roundToPages(size));
+        return;
+    }
+    memzero(pointer, sizeClasses[index]);
+    auto& cache = threadCache;
+    auto* block = static_cast<FreeBlock*>(pointer);
+    block->next = cache.freeLists[index];
+    cache.freeLists[index] = block;
+    ++cache.counts[index];
+    if (cache.closed || cache.counts[index] > threadCacheSize) {
+        std::lock_guard lock(mutex);
+        release(cache, index, cache.closed ? cache.counts[index] : threadCacheSize / 2);
+    }
+}
+
+std::size_t SecureArena::lockFailures() const noexcept {
+    std::lock_guard lock(mutex);
+    return failedLocks;
+}
+
+} // namespace TW
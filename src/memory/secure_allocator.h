@@ -0,0 +1,194 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace TW {
+
+/// Process wide pool of locked memory for key material (seeds, mnemonics, decrypted payloads).
+///
+/// Pages are mapped and locked with `mlock`/`VirtualLock`, so they are never written to swap,
+/// and every block is wiped when it is freed.  Blocks up to 192 bytes come from per size class
+/// free lists carved out of locked slabs, which also avoids heap fragmentation by the many
+/// short-lived buffers of bulk derivation; larger blocks get their own locked mapping.
+/// Each thread keeps a few free blocks per size class, so that parallel derivation and signing don't
+/// contend on the arena lock; they move to and from the shared lists in batches.
+/// Slabs are kept for the lifetime of the process.
+class SecureArena {
+  public:
+    /// Block sizes of the pool: private key, seed, 3 keys (key + extension + chain code), Cardano key.
+    static constexpr std::array<std::size_t, 4> sizeClasses = {32, 64, 96, 192};
+
+    /// Returns the arena; it is never destroyed, so that static objects can release their memory at exit.
+    static SecureArena& instance();
+
+    /// Allocates `size` bytes of locked memory, throws std::bad_alloc if memory can't be mapped.
+    void* allocate(std::size_t size);
+
+    /// Wipes and releases a block of `size` bytes obtained from `allocate`.
+    void deallocate(void* pointer, std::size_t size) noexcept;
+
+    /// Number of mappings which could not be locked, e.g. over RLIMIT_MEMLOCK.
+    /// The memory is still pooled and wiped, but may be swapped.
+    std::size_t lockFailures() const noexcept;
+
+  private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /// Free blocks of the calling thread, per size class.
+    struct ThreadCache {
+        std::array<FreeBlock*, sizeClasses.size()> freeLists{};
+        std::array<std::size_t, sizeClasses.size()> counts{};
+        /// Set when the thread exits, once its blocks are returned; later releases go to the shared lists.
+        bool closed = false;
+    };
+    /// Returns the blocks of the thread cache to the shared lists at thread exit.
+    struct ThreadCacheFlush {
+        ~ThreadCacheFlush();
+    };
+
+    /// Blocks kept per size class and thread; half of them move at once.
+    static constexpr std::size_t threadCacheSize = 32;
+
+    // Trivially destructible, so that it stays usable by static objects destroyed after the thread exit
+    static thread_local ThreadCache threadCache;
+    static thread_local ThreadCacheFlush threadCacheFlush;
+
+    SecureArena() = default;
+
+    /// Maps and locks `size` bytes, a multiple of the page size.
+    void* map(std::size_t size);
+    void unmap(void* pointer, std::size_t size) noexcept;
+    /// Adds a slab of blocks of size class `index` to its free list.
+    void grow(std::size_t index);
+    /// Moves up to `count` blocks of size class `index` from the shared list to the thread cache; the lock is held.
+    void refill(ThreadCache& cache, std::size_t index, std::size_t count);
+    /// Moves up to `count` blocks of size class `index` from the thread cache to the shared list; the lock is held.
+    void release(ThreadCache& cache, std::size_t index, std::size_t count) noexcept;
+
+    mutable std::mutex mutex;
+    std::array<FreeBlock*, sizeClasses.size()> freeLists{};
+    std::size_t failedLocks = 0;
+};
+
+/// Allocator of locked, wiped memory from `SecureArena`.
+template <typename T>
+struct SecureAllocator {
+    using value_type = T;
+
+    SecureAllocator() noexcept = default;
+    template <typename U>
+    SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(SecureArena::instance().allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        SecureArena::instance().deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SecureAllocator<U>&) const noexcept { return true; }
+};
+
+/// Bytes of key material, in locked memory wiped on release.
+using SecureData = std::vector<byte, SecureAllocator<byte>>;
+
+/// Fixed capacity storage from `SecureArena`, for `InlineData` holding key material (see `PrivateKey`).
+/// Copies get their own block, moves take over the block; the block is wiped when it is released.
+/// A moved-from storage has no block (`get()` is null) until it is assigned to.
+template <std::size_t Capacity>
+class SecureStorage {
+  public:
+    // Arena blocks are zeroed
+    SecureStorage() : bytes(allocate()) {}
+    SecureStorage(const SecureStorage& other) : SecureStorage() { copyFrom(other); }
+    SecureStorage(SecureStorage&& other) noexcept : bytes(std::exchange(other.bytes, nullptr)) {}
+    SecureStorage& operator=(const SecureStorage& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (bytes == nullptr) {
+            bytes = allocate();
+        }
+        copyFrom(other);
+        return *this;
+    }
+    SecureStorage& operator=(SecureStorage&& other) noexcept {
+        std::swap(bytes, other.bytes);
+        return *this;
+    }
+    ~SecureStorage() { SecureArena::instance().deallocate(bytes, Capacity); }
+
+    byte* get() noexcept { return bytes; }
+    const byte* get() const noexcept { return bytes; }
+
+  private:
+    static byte* allocate() { return static_cast<byte*>(SecureArena::instance().allocate(Capacity)); }
+
+    void copyFrom(const SecureStorage& other) noexcept {
+        if (other.bytes != nullptr) {
+            std::copy_n(other.bytes, Capacity, bytes);
+        } else {
+            std::fill_n(bytes, Capacity, byte(0));
+        }
+    }
+
+    byte* bytes;
+};
+
+/// Text key material (mnemonic, passphrase).
+/// The capacity is kept above the small string buffer of the standard library, so that short strings
+/// are in the arena as well, not inline in the owning object.  A moved-from string is empty and inline.
+class SecureString : public std::basic_string<char, std::char_traits<char>, SecureAllocator<char>> {
+  public:
+    using Base = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+
+    /// Larger than the small string buffer of libstdc++ (15), libc++ (22) and MSVC (15).
+    static constexpr std::size_t minCapacity = 31;
+
+    SecureString() { reserve(minCapacity); }
+    explicit SecureString(std::string_view text) : SecureString() { append(text); }
+    explicit SecureString(const char* text) : SecureString(std::string_view(text)) {}
+    SecureString(const char* text, std::size_t size) : SecureString(std::string_view(text, size)) {}
+    template <typename InputIt>
+    SecureString(InputIt first, InputIt last) : SecureString() { append(first, last); }
+
+    SecureString(const SecureString& other) : SecureString(std::string_view(other)) {}
+    SecureString(SecureString&& other) noexcept = default;
+
+    SecureString& operator=(const SecureString& other) { return *this = std::string_view(other); }
+    SecureString& operator=(SecureString&& other) noexcept = default;
+    SecureString& operator=(std::string_view text) {
+        reserve(std::max(minCapacity, text.size()));
+        Base::assign(text);
+        return *this;
+    }
+};
+
+inline bool operator==(const SecureData& lhs, const Data& rhs) noexcept {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+inline bool operator==(const SecureString& lhs, const std::string& rhs) noexcept {
+    return std::string_view(lhs) == std::string_view(rhs);
+}
+
+} // namespace TW
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Data.h"
+#include "FixedUint256.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
@@ -55,39 +56,57 @@ inline uint256_t load(const std::string& data) {
     return result;
 }
 
+/// Converts a `uint256_t` to the fixed-width representation used by encoders.
+inline FixedUint256 toFixed(const uint256_t& value) noexcept {
+    using boost::multiprecision::limb_type;
+    constexpr std::size_t limbBits = sizeof(limb_type) * 8;
+    const auto& backend = value.backend();
+    FixedUint256 result;
+    for (std::size_t i = 0; i < backend.size(); ++i) {
+        result.limbs[i * limbBits / 64] |= uint64_t(backend.limbs()[i]) << (i * limbBits % 64);
+    }
+    return result;
+}
+
+/// Converts a `FixedUint256` back to a `uint256_t`.
+inline uint256_t toBoost(const FixedUint256& value) {
+    using boost::multiprecision::limb_type;
+    constexpr std::size_t limbBits = sizeof(limb_type) * 8;
+    constexpr std::size_t limbCount = 256 / limbBits;
+    uint256_t result;
+    auto& backend = result.backend();
+    backend.resize(limbCount, limbCount);
+    for (std::size_t i = 0; i < limbCount; ++i) {
+        backend.limbs()[i] = static_cast<limb_type>(value.limbs[i * limbBits / 64] >> (i * limbBits % 64));
+    }
+    backend.normalize();
+    return result;
+}
+
 /// Stores a `uint256_t` as a collection of bytes, with optional padding (typically to 32 bytes).
 /// If minLen is given (non-zero), and result is shorter, it is padded (with zeroes, on the left, big endian)
 inline Data store(const uint256_t& v, byte minLen = 0) {
-    using boost::multiprecision::cpp_int;
     Data bytes;
-    bytes.reserve(32);
-    export_bits(v, std::back_inserter(bytes), 8);
-    if (minLen && bytes.size() < minLen) {
-        Data padded(minLen - bytes.size());
-        append(padded, bytes);
-        return padded;
-    }
+    // zero is stored as a single byte
+    toFixed(v).appendBE(bytes, std::max<std::size_t>(minLen, 1));
     return bytes;
 }
 
 // Append a uint256_t value as a big-endian byte array into the provided buffer, and limit
 // the array size by digit/8.
 inline void encode256BE(Data& data, const uint256_t& value, uint32_t digit) {
-    Data bytes = store(value);
-    Data buff(digit / 8);
-
-    for (int i = 0; i < (int)bytes.size(); ++i) {
-        int start = (int)buff.size() - (int)bytes.size() + i;
-        if (start >= 0) {
-            buff[start] = bytes[i];
-        }
+    const auto fixed = toFixed(value);
+    const std::size_t size = digit / 8;
+    const auto offset = data.size();
+    data.resize(offset + size, 0);
+    for (std::size_t i = 0; i < std::min<std::size_t>(size, 32); ++i) {
+        data[offset + size - 1 - i] = fixed.byteAt(i);
     }
-    data.insert(data.end(), buff.begin(), buff.end());
 }
 
 /// Return string representation of uint256_t
 inline std::string toString(uint256_t value) {
-    return boost::lexical_cast<std::string>(value);
+    return toFixed(value).toString();
 }
 
 } // namespace TW
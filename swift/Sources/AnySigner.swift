@@ -35,11 +35,9 @@ public final class AnySigner {
     /// - coin: CoinType
     /// - Returns: The serialized data of a SigningOutput
     public static func nativeSign(data: Data, coin: CoinType) -> Data {
-        let inputData = TWDataCreateWithNSData(data)
-        defer {
-            TWDataDelete(inputData)
+        return withTWData(data) { inputData in
+            TWDataNSData(TWAnySignerSign(inputData, TWCoinType(rawValue: coin.rawValue)))
         }
-        return TWDataNSData(TWAnySignerSign(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
 
     /// Check if AnySigner supports signing JSON representation of SigningInput for a given coin.
@@ -85,10 +83,8 @@ public final class AnySigner {
     /// - coin: CoinType
     /// - Returns: The serialized data of a TransactionPlan
     public static func nativePlan(data: Data, coin: CoinType) -> Data {
-        let inputData = TWDataCreateWithNSData(data)
-        defer {
-            TWDataDelete(inputData)
+        return withTWData(data) { inputData in
+            TWDataNSData(TWAnySignerPlan(inputData, TWCoinType(rawValue: coin.rawValue)))
         }
-        return TWDataNSData(TWAnySignerPlan(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
 }
@@ -7,14 +7,34 @@
 import Foundation
 
 /// Converts a Data struct to TWData/UnsafeRawPointer caller must delete it after use.
+/// The bytes are copied once, straight from the storage of `data`.
 public func TWDataCreateWithNSData(_ data: Data) -> UnsafeRawPointer {
-    return TWDataCreateWithBytes([UInt8](data), data.count)
+    return data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> UnsafeRawPointer in
+        guard let baseAddress = bytes.bindMemory(to: UInt8.self).baseAddress, !bytes.isEmpty else {
+            return TWDataCreateWithSize(0)
+        }
+        return TWDataCreateWithBytes(baseAddress, bytes.count)
+    }
 }
 
-/// Converts a TWData/UnsafeRawPointer (will be deleted within this call) to a Data struct.
+/// Converts a TWData/UnsafeRawPointer to a Data struct, which takes ownership of it.
+/// The bytes are not copied: the TWData is deleted when the returned Data is released.
 public func TWDataNSData(_ data: UnsafeRawPointer) -> Data {
-    defer {
+    let size = TWDataSize(data)
+    guard size > 0 else {
+        TWDataDelete(data)
+        return Data()
+    }
+    return Data(bytesNoCopy: TWDataBytes(data), count: size, deallocator: .custom { _, _ in
         TWDataDelete(data)
+    })
+}
+
+/// Calls `body` with a TWData created from `data`, deleted when `body` returns.
+public func withTWData<Result>(_ data: Data, _ body: (UnsafeRawPointer) throws -> Result) rethrows -> Result {
+    let twData = TWDataCreateWithNSData(data)
+    defer {
+        TWDataDelete(twData)
     }
-    return Data(bytes: TWDataBytes(data), count: TWDataSize(data))
+    return try body(twData)
 }
@@ -8,7 +8,7 @@ import Foundation
 
 /// Converts a String struct to TWString/UnsafeRawPointer, caller must delete it after use.
 public func TWStringCreateWithNSString(_ string: String) -> UnsafeRawPointer {
-    return TWStringCreateWithUTF8Bytes([CChar](string.utf8CString))
+    return string.withCString { TWStringCreateWithUTF8Bytes($0) }
 }
 
 /// Converts a TWString/UnsafeRawPointer (will be deleted within this call) to a String struct.
@@ -0,0 +1,57 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+import XCTest
+import WalletCore
+
+/// The binding benchmarks of benchmarks/BindingBenchmarks.cpp through the Swift wrapper.
+/// Compare `BM_Binding/<operation>/swift` with `BM_Binding/<operation>/c` of the native run for the wrapper overhead.
+class BindingBenchmarks: XCTestCase {
+    static let iterations = 2000
+    static let mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal"
+    static let ethereumInput = Data(hexString: "0a0101120109220504a817c8002a025208422a3078333533353335333533353335333533353335333533353335333533353335333533353335333533354a204646464646464646464646464646464646464646464646464646464646464646520c0a0a0a080de0b6b3a7640000")!
+    static let bitcoinInput = Data(hexString: "080110b0ff8ea001180122223142703955316f675633413134464d764b62524a6d7337637479736f345a345463782a2231465163354c646747484d48454e396e776b6a6d7a3674576b7868507078427642553220619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9424a0a2a0a20ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a100118ffffffff0f121600141d0f172a0ecb48aee1be1f2687d2963ae33f71a118808c8d9e02")!
+
+    /// Runs `operation`, which returns the number of bytes copied across the binding, and prints the time and the copied bytes per call.
+    func run(_ operation: String, _ body: () -> Int) {
+        var copied = 0
+        let start = DispatchTime.now().uptimeNanoseconds
+        for _ in 0..<Self.iterations {
+            copied += body()
+        }
+        let elapsed = DispatchTime.now().uptimeNanoseconds - start
+        let nsPerOp = Double(elapsed) / Double(Self.iterations)
+        print("BM_Binding/\(operation)/swift ns_per_op=\(nsPerOp) bytes_copied_per_op=\(copied / Self.iterations)")
+    }
+
+    func testHash() {
+        let input = Data(repeating: 0x5a, count: 1024)
+        run("hash") {
+            input.count + Hash.keccak256(data: input).count
+        }
+    }
+
+    func testDeriveAddress() {
+        let wallet = HDWallet(mnemonic: Self.mnemonic, passphrase: "")!
+        run("deriveAddress") {
+            wallet.getAddressForCoin(coin: .ethereum).utf8.count
+        }
+    }
+
+    func testSignEthereum() {
+        XCTAssertFalse(AnySigner.nativeSign(data: Self.ethereumInput, coin: .ethereum).isEmpty)
+        run("signEthereum") {
+            Self.ethereumInput.count + AnySigner.nativeSign(data: Self.ethereumInput, coin: .ethereum).count
+        }
+    }
+
+    func testSignBitcoin() {
+        XCTAssertFalse(AnySigner.nativeSign(data: Self.bitcoinInput, coin: .bitcoin).isEmpty)
+        run("signBitcoin") {
+            Self.bitcoinInput.count + AnySigner.nativeSign(data: Self.bitcoinInput, coin: .bitcoin).count
+        }
+    }
+}
@@ -16,6 +16,13 @@ class DataTests: XCTestCase {
         XCTAssertEqual(Array(data), bytes)
     }
 
+    func testNSDataRoundTrip() {
+        let data = Data([0xde, 0xad, 0xbe, 0xef])
+        XCTAssertEqual(TWDataNSData(TWDataCreateWithNSData(data)), data)
+        XCTAssertEqual(TWDataNSData(TWDataCreateWithNSData(Data())), Data())
+        XCTAssertEqual(withTWData(data) { TWDataSize($0) }, 4)
+    }
+
     func testOddLength() {
         XCTAssertNil(Data(hexString: "0x0"))
         XCTAssertNil(Data(hexString: "0x28fa6ae00"))
@@ -225,4 +225,62 @@ TEST(AlgorandSigner, ProtoSignerAssetTransaction) {
     ASSERT_EQ(hex(encoded), "82a3736967c440412720eff99a17280a437bdb8eeba7404b855d6433fffd5dde7f7966c1f9ae531a1af39e18b8a58b4a6c6acb709cca92f8a18c36d8328be9520c915311027005a374786e8aa461616d74ce000f4240a461726376c420325164cafa253b116f4b54c63bd960d610209d44df635d65e095f3855a96b956a3666565cd0924a26676ce00f0b7c3a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a26c76ce00f0bbaba3736e64c42082872d60c338cb928006070e02ec0942addcb79e7fbd01c76458aea526899bd3a474797065a56178666572a478616964ce00cc264a");
 }
 
+TEST(AlgorandSigner, EncodeKeys) {
+    Data data;
+    encodeKey(Keys::txlist, data);
+    Data expected;
+    encodeString("txlist", expected);
+    ASSERT_EQ(hex(data), hex(expected));
+}
+
+TEST(AlgorandSigner, SignGroup) {
+    // Same transactions as AlgorandSigner.Sign and AlgorandSigner.ProtoSignerAssetTransaction
+    const auto payKey = PrivateKey(parse_hex("c9d3cc16fecabe2747eab86b81528c6ed8b65efc1d6906d86aabc27187a1fe7c"));
+    auto pay = Proto::SigningInput();
+    const auto mainnetHash = Base64::decode("wGHE2Pwdvd7S12BL5FaOP20EGYesN73ktiC1qzkkit8=");
+    pay.set_genesis_hash(mainnetHash.data(), mainnetHash.size());
+    pay.set_genesis_id("mainnet-v1.0");
+    pay.set_private_key(payKey.bytes.data(), payKey.bytes.size());
+    pay.set_first_round(51);
+    pay.set_last_round(61);
+    pay.set_fee(488931);
+    pay.mutable_transfer()->set_to_address("UCE2U2JC4O4ZR6W763GUQCG57HQCDZEUJY4J5I6VYY4HQZUJDF7AKZO5GM");
+    pay.mutable_transfer()->set_amount(847);
+
+    const auto assetKey = PrivateKey(parse_hex("5a6a3cfe5ff4cc44c19381d15a0d16de2a76ee5c9b9d83b232e38cb5a2c84b04"));
+    auto asset = Proto::SigningInput();
+    const auto testnetHash = Base64::decode("SGO1GKSzyE7IEPItTxCByw9x8FmnrCDexi9/cOUJOiI=");
+    asset.set_genesis_hash(testnetHash.data(), testnetHash.size());
+    asset.set_genesis_id("testnet-v1.0");
+    asset.set_private_key(assetKey.bytes.data(), assetKey.bytes.size());
+    asset.set_first_round(15775683);
+    asset.set_last_round(15776683);
+    asset.set_fee(2340);
+    asset.mutable_asset_transfer()->set_asset_id(13379146);
+    asset.mutable_asset_transfer()->set_amount(1000000);
+    asset.mutable_asset_transfer()->set_to_address("GJIWJSX2EU5RC32LKTDDXWLA2YICBHKE35RV2ZPASXZYKWUWXFLKNFSS4U");
+
+    const auto outputs = Signer::signGroup({pay, asset});
+    ASSERT_EQ(outputs.size(), 2ul);
+
+    // the group field is inserted after the genesis hash
+    const std::vector<std::string> expectedTransactions = {
+        "8aa3616d74cd034fa3666565ce000775e3a2667633a367656eac6d61696e6e65742d76312e30a26768c420c061c4d8fc1dbdded2d7604be4568e3f6d041987ac37bde4b620b5ab39248adfa3677270c42094859d7ff8bd4b21585bdbdb045b209a47b1d21bf14a2b41b29735e050ff760ca26c763da3726376c420a089aa6922e3b998fadff6cd4808ddf9e021e4944e389ea3d5c638786689197ea3736e64c42074b000b6368551a6066d713e2866002e8dab34b69ede09a72e85a39bbb1f7928a474797065a3706179",
+        "8ba461616d74ce000f4240a461726376c420325164cafa253b116f4b54c63bd960d610209d44df635d65e095f3855a96b956a3666565cd0924a26676ce00f0b7c3a367656eac746573746e65742d76312e30a26768c4204863b518a4b3c84ec810f22d4f1081cb0f71f059a7ac20dec62f7f70e5093a22a3677270c42094859d7ff8bd4b21585bdbdb045b209a47b1d21bf14a2b41b29735e050ff760ca26c76ce00f0bbaba3736e64c42082872d60c338cb928006070e02ec0942addcb79e7fbd01c76458aea526899bd3a474797065a56178666572a478616964ce00cc264a",
+    };
+    const std::vector<const PrivateKey*> keys = {&payKey, &assetKey};
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        const auto encoded = hex(outputs[i].encoded());
+        const auto signature = Base64::decode(outputs[i].signature());
+        ASSERT_EQ(encoded, "82a3736967c440" + hex(signature) + "a374786e" + expectedTransactions[i]);
+
+        auto message = parse_hex("5458");
+        append(message, parse_hex(expectedTransactions[i]));
+        EXPECT_TRUE(keys[i]->getPublicKey(TWPublicKeyTypeED25519).verify(signature, message));
+    }
+
+    EXPECT_THROW(Signer::signGroup({}), std::invalid_argument);
+    EXPECT_THROW(Signer::signGroup(std::vector<Proto::SigningInput>(Signer::maxGroupSize + 1, pay)), std::invalid_argument);
+}
+
 } // namespace TW::Algorand::tests
@@ -0,0 +1,88 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Aptos/PreparedTransfer.h"
+#include "Aptos/Signer.h"
+#include "HexCoding.h"
+#include "TestUtilities.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Aptos::tests {
+
+const auto senderKey = PrivateKey(parse_hex("5d996aa76b3212142792d9130796cd2e11e3c445a93118c08414df4f66bc60ec"));
+const auto senderAddress = Address("0x07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30");
+
+TEST(AptosPreparedTransfer, AptosAccountTransfer) {
+    // Same transaction as AptosSigner.TxSign
+    const auto transfer = PreparedTransfer::aptosAccountTransfer(senderAddress, 3296766, 100, 33);
+    const auto result = transfer.sign(senderKey, 99, senderAddress, 1000, 3664390082);
+    ASSERT_EQ(hex(result.raw_txn()), "07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f3063000000000000000200000000000000000000000000000000000000000000000000000000000000010d6170746f735f6163636f756e74087472616e7366657200022007968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f3008e803000000000000fe4d3200000000006400000000000000c2276ada0000000021");
+    ASSERT_EQ(hex(result.authenticator().signature()), "5707246db31e2335edc4316a7a656a11691d1d1647f6e864d1ab12f43428aaaf806cf02120d0b608cdd89c5c904af7b137432aacdd60cc53f9fad7bd33578e01");
+    ASSERT_EQ(hex(result.encoded()), "07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f3063000000000000000200000000000000000000000000000000000000000000000000000000000000010d6170746f735f6163636f756e74087472616e7366657200022007968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f3008e803000000000000fe4d3200000000006400000000000000c2276ada00000000210020ea526ba1710343d953461ff68641f1b7df5f23b9042ffa2d2a798d3adb3f3d6c405707246db31e2335edc4316a7a656a11691d1d1647f6e864d1ab12f43428aaaf806cf02120d0b608cdd89c5c904af7b137432aacdd60cc53f9fad7bd33578e01");
+    nlohmann::json expectedJson = R"(
+                {
+                    "expiration_timestamp_secs": "3664390082",
+                    "gas_unit_price": "100",
+                    "max_gas_amount": "3296766",
+                    "payload": {
+                        "arguments": ["0x07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30","1000"],
+                        "function": "0x1::aptos_account::transfer",
+                        "type": "entry_function_payload",
+                        "type_arguments": []
+                    },
+                    "sender": "0x07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30",
+                    "sequence_number": "99",
+                    "signature": {
+                        "public_key": "0xea526ba1710343d953461ff68641f1b7df5f23b9042ffa2d2a798d3adb3f3d6c",
+                        "signature": "0x5707246db31e2335edc4316a7a656a11691d1d1647f6e864d1ab12f43428aaaf806cf02120d0b608cdd89c5c904af7b137432aacdd60cc53f9fad7bd33578e01",
+                        "type": "ed25519_signature"
+                    }
+                }
+        )"_json;
+    assertJSONEqual(expectedJson, nlohmann::json::parse(result.json()));
+}
+
+TEST(AptosPreparedTransfer, CoinTransfer) {
+    // Same transaction as AptosSigner.TokenTxSign
+    const auto coinType = StructTag(Address("0x43417434fd869edee76cca2a4d2301e528a1551b1d719b75c350c3c97d15b8b9"), "coins", "BTC", {});
+    const auto transfer = PreparedTransfer::coinTransfer(senderAddress, coinType, 3296766, 100, 32);
+    const auto result = transfer.sign(senderKey, 24, senderAddress, 100000, 3664390082);
+    ASSERT_EQ(hex(result.raw_txn()), "07968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f30180000000000000002000000000000000000000000000000000000000000000000000000000000000104636f696e087472616e73666572010743417434fd869edee76cca2a4d2301e528a1551b1d719b75c350c3c97d15b8b905636f696e730342544300022007968dab936c1bad187c60ce4082f307d030d780e91e694ae03aef16aba73f3008a086010000000000fe4d3200000000006400000000000000c2276ada0000000020");
+    ASSERT_EQ(hex(result.authenticator().signature()), "7643ec8aae6198bd13ca6ea2962265859cba5a228e7d181131f6c022700dd02a7a04dc0345ad99a0289e5ab80b130b3864e6404079980bc226f1a13aee7d280a");
+    const auto json = nlohmann::json::parse(result.json());
+    EXPECT_EQ(json["payload"]["function"], "0x1::coin::transfer");
+    EXPECT_EQ(json["payload"]["type_arguments"][0], "0x43417434fd869edee76cca2a4d2301e528a1551b1d719b75c350c3c97d15b8b9::coins::BTC");
+}
+
+TEST(AptosPreparedTransfer, MatchesSigner) {
+    const auto transfer = PreparedTransfer::coinTransfer(senderAddress, PreparedTransfer::aptosCoin(), 2000, 100, 2);
+    const auto recipient = Address("0xeeff357ea5c1a4e7bc11b2b17ff2dc2dcca69750bfef1e1ebcaccf8c8018175b");
+    for (std::uint64_t sequence = 0; sequence < 3; ++sequence) {
+        const auto result = transfer.sign(senderKey, sequence, recipient, 1000 * (sequence + 1), 1670240203 + sequence);
+
+        Proto::SigningInput input;
+        input.set_sender(senderAddress.string());
+        input.set_sequence_number(sequence);
+        auto& tf = *input.mutable_token_transfer();
+        tf.set_to(recipient.string());
+        tf.set_amount(1000 * (sequence + 1));
+        tf.mutable_function()->set_account_address("0x1");
+        tf.mutable_function()->set_module("aptos_coin");
+        tf.mutable_function()->set_name("AptosCoin");
+        input.set_max_gas_amount(2000);
+        input.set_gas_unit_price(100);
+        input.set_expiration_timestamp_secs(1670240203 + sequence);
+        input.set_chain_id(2);
+        input.set_private_key(senderKey.bytes.data(), senderKey.bytes.size());
+        const auto expected = Signer::sign(input);
+        EXPECT_EQ(hex(result.raw_txn()), hex(expected.raw_txn()));
+        EXPECT_EQ(hex(result.encoded()), hex(expected.encoded()));
+        assertJSONEqual(nlohmann::json::parse(expected.json()), nlohmann::json::parse(result.json()));
+    }
+}
+
+} // namespace TW::Aptos::tests
@@ -6,6 +6,7 @@
 
 #include "Bech32Address.h"
 #include "Binance/Address.h"
+#include "Binance/Serialization.h"
 #include "Binance/Signer.h"
 #include "Coin.h"
 #include "Ethereum/Address.h"
@@ -702,4 +703,66 @@ TEST(BinanceSigner, BuildTimeUnlockOrder) {
               "898f1b59137b3d8f1e00f842e409e18033b347180f2001");
 }
 
+TEST(BinanceSigner, SignDocWriter) {
+    auto input = Proto::SigningInput();
+    input.set_chain_id("chain-bnb");
+    input.set_account_number(12);
+    input.set_sequence(35);
+    input.set_memo("quote \" backslash \\ ünicode \n");
+    input.set_source(1);
+    auto& order = *input.mutable_cancel_trade_order();
+    auto address = Binance::Address(parse_hex("b6561dcc104130059a7c08f48c64610c1f6f9064"));
+    auto keyhash = address.getKeyHash();
+    order.set_sender(keyhash.data(), keyhash.size());
+    order.set_symbol("BTC-5C4_BNB");
+    order.set_refid("B6561DCC104130059A7C08F48C64610C1F6F9064-11");
+
+    EXPECT_EQ(SignDocWriter(input).write(orderJSON(input), input.sequence()), signatureJSON(input).dump());
+}
+
+TEST(BinanceSigner, SignBatch) {
+    auto envelope = Proto::SigningInput();
+    envelope.set_chain_id("chain-bnb");
+    envelope.set_account_number(1);
+    envelope.set_sequence(10);
+    envelope.set_memo("batch");
+    auto key = parse_hex("90335b9d2153ad1a9799a3ccc070bd64b4164e9642ee1dd48053c33f9a3a05e9");
+    envelope.set_private_key(key.data(), key.size());
+
+    auto address = Binance::Address(parse_hex("b6561dcc104130059a7c08f48c64610c1f6f9064"));
+    auto keyhash = address.getKeyHash();
+    std::vector<Proto::SigningInput> orders(3);
+    {
+        auto& order = *orders[0].mutable_trade_order();
+        order.set_sender(keyhash.data(), keyhash.size());
+        order.set_id("B6561DCC104130059A7C08F48C64610C1F6F9064-11");
+        order.set_symbol("BTC-5C4_BNB");
+        order.set_ordertype(2);
+        order.set_side(1);
+        order.set_price(100000000);
+        order.set_quantity(1200000000);
+        order.set_timeinforce(1);
+    }
+    {
+        auto& order = *orders[1].mutable_cancel_trade_order();
+        order.set_sender(keyhash.data(), keyhash.size());
+        order.set_symbol("BTC-5C4_BNB");
+        order.set_refid("B6561DCC104130059A7C08F48C64610C1F6F9064-11");
+    }
+    // envelope fields of orders are ignored
+    orders[2] = orders[0];
+    orders[2].set_chain_id("other-chain");
+    orders[2].set_sequence(1);
+
+    const auto outputs = Signer::signBatch(envelope, orders);
+    ASSERT_EQ(outputs.size(), 3ul);
+    for (auto i = 0ul; i < orders.size(); ++i) {
+        auto input = envelope;
+        input.MergeFrom(orders[i]);
+        input.set_chain_id(envelope.chain_id());
+        input.set_sequence(envelope.sequence() + static_cast<int64_t>(i));
+        EXPECT_EQ(hex(outputs[i].encoded()), hex(Signer(input).build()));
+    }
+}
+
 } // namespace TW::Binance
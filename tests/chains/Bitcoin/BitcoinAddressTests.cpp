@@ -6,7 +6,9 @@
 
 #include "Bitcoin/Address.h"
 #include "Bitcoin/Script.h"
+#include "Coin.h"
 #include "HexCoding.h"
+#include "PrivateKey.h"
 #include "PublicKey.h"
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -77,4 +79,30 @@ TEST(BitcoinAddress, P2SH_CreateFromData) {
     EXPECT_EQ(hex(address.bytes), TestP2shData1);
 }
 
+TEST(BitcoinAddress, DeriveAddresses) {
+    std::vector<PublicKey> publicKeys;
+    for (uint8_t i = 1; i <= 11; ++i) {
+        publicKeys.push_back(PrivateKey(Data(32, i)).getPublicKey(TWPublicKeyTypeSECP256k1));
+    }
+    const auto cases = {
+        std::make_pair(TWCoinTypeBitcoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy),
+        std::make_pair(TWCoinTypeBitcoin, TWDerivationBitcoinTestnet),
+        std::make_pair(TWCoinTypeLitecoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeDogecoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeBitcoinCash, TWDerivationDefault),
+    };
+    for (const auto& [coin, derivation] : cases) {
+        // the key hashes are computed together
+        const auto addresses = TW::deriveAddresses(coin, publicKeys, derivation);
+        ASSERT_EQ(addresses.size(), publicKeys.size());
+        for (size_t i = 0; i < publicKeys.size(); ++i) {
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, publicKeys[i], derivation)) << "coin " << coin << " key " << i;
+        }
+    }
+    EXPECT_EQ(TW::deriveAddresses(TWCoinTypeBitcoin, {publicKeys[0]})[0], "bc1q0xcqpzrky6eff2g52qdye53xkk9jxkvrh6yhyw");
+    EXPECT_TRUE(TW::deriveAddresses(TWCoinTypeBitcoin, {}).empty());
+    EXPECT_THROW(TW::deriveAddresses(TWCoinTypeBitcoin, {publicKeys[0].extended()}), std::invalid_argument);
+}
+
 } // namespace TW::Bitcoin::tests
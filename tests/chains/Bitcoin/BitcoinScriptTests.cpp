@@ -4,8 +4,11 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Bitcoin/Address.h"
+#include "Bitcoin/MultisigScript.h"
 #include "Bitcoin/Script.h"
 #include "Bitcoin/SignatureBuilder.h"
+#include "Bitcoin/SigningInput.h"
 #include "TestUtilities.h"
 #include "HexCoding.h"
 
@@ -356,6 +359,101 @@ TEST(BitcoinScript, OpReturnTooLong) {
     EXPECT_EQ(hex(script.bytes), "");
 }
 
+TEST(BitcoinScript, SigningInputLockScript) {
+    SigningInput input;
+    input.coinType = TWCoinTypeLitecoin;
+    const auto& script = input.lockScript("LgKiekick9Ka7gYoYzAWGrEq8rFBJzYiyf");
+    EXPECT_EQ(hex(script.bytes), "76a914e771c6695c5dd189ccc4ef00cd0f3db3096d79bd88ac");
+    // resolved once, later calls return the same script
+    EXPECT_EQ(&input.lockScript("LgKiekick9Ka7gYoYzAWGrEq8rFBJzYiyf"), &script);
+    EXPECT_EQ(hex(input.lockScript("MHhghmmCTASDnuwpgsPUNJVPTFaj61GzaG").bytes), "a9146b85b3dac9340f36b9d32bbacf2ffcb0851ef17987");
+    // the prefix depends on the coin
+    EXPECT_TRUE(input.lockScript("LgKiekick9Ka7gYoYzAWGrEq8rFBJzYiyf", TWCoinTypeBitcoin).empty());
+    EXPECT_TRUE(input.lockScript("invalid").empty());
+}
+
+TEST(BitcoinMultisigScript, SortedKeys) {
+    // BIP67 test vector
+    const auto script = MultisigScript({
+        parse_hex("02ff12471208c14bd580709cb2358d98975247d8765f92bc25eab3b2763ed605f8"),
+        parse_hex("02fe6f0a5a297eb38c391581c4413e084773ea23954d93f7753db7dc0adc188b2f"),
+    }, 2);
+    EXPECT_EQ(hex(script.script().bytes), "522102fe6f0a5a297eb38c391581c4413e084773ea23954d93f7753db7dc0adc188b2f2102ff12471208c14bd580709cb2358d98975247d8765f92bc25eab3b2763ed605f852ae");
+    Data addressData = {TWCoinTypeP2shPrefix(TWCoinTypeBitcoin)};
+    append(addressData, script.scriptHash());
+    EXPECT_EQ(Address(addressData).string(), "39bgKC7RFbpoCRbtD5KEdkYKtNyhpsNa3Z");
+    EXPECT_EQ(hex(script.witnessScriptHash()), hex(Hash::sha256(script.script().bytes)));
+    EXPECT_EQ(hex(script.keyHashes()[0]), hex(Hash::sha256ripemd(script.keys()[0].data(), script.keys()[0].size())));
+    EXPECT_EQ(script.indexOf(script.keyHashes()[1]), std::optional<std::size_t>(1));
+    EXPECT_FALSE(script.indexOf(Data(20)).has_value());
+
+    // matching keeps the order of the script
+    const auto unsorted = MultisigScript(script.keys(), 1, false);
+    const auto reversed = MultisigScript({script.keys()[1], script.keys()[0]}, 1, false);
+    EXPECT_NE(hex(unsorted.script().bytes), hex(reversed.script().bytes));
+    const auto matched = MultisigScript::match(reversed.script());
+    ASSERT_TRUE(matched.has_value());
+    EXPECT_EQ(matched->required(), 1);
+    EXPECT_EQ(hex(matched->keys()[0]), hex(script.keys()[1]));
+    EXPECT_EQ(hex(matched->scriptHash()), hex(reversed.scriptHash()));
+    EXPECT_FALSE(MultisigScript::match(PayToPublicKeyHash).has_value());
+
+    EXPECT_THROW(MultisigScript({}, 1), std::invalid_argument);
+    EXPECT_THROW(MultisigScript(script.keys(), 3), std::invalid_argument);
+    EXPECT_THROW(MultisigScript(script.keys(), 0), std::invalid_argument);
+    EXPECT_THROW(MultisigScript({Data(65, 0x04)}, 1), std::invalid_argument);
+    EXPECT_THROW(MultisigScript(std::vector<Data>(17, script.keys()[0]), 1), std::invalid_argument);
+}
+
+TEST(BitcoinMultisigScript, SignWitnessInputs) {
+    const std::vector<PrivateKey> keys = {
+        PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9")),
+        PrivateKey(parse_hex("a4eea09c6d2b7cbd6d86e6c2b7ebd3c1ba5c8aa4a1e8b52c0a1d7de3e0cf5e41")),
+        PrivateKey(parse_hex("2ed58b6e2e8e2a95a9c8a9e0c2f1b3d2b8c1a0e8f6d9c3b7a1e4d2c0b9f8e7d6")),
+    };
+    std::vector<Data> publicKeys;
+    for (const auto& key : keys) {
+        publicKeys.push_back(Data(key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    }
+    const auto multisig = MultisigScript(publicKeys, 2);
+    const auto lockScript = Script::buildPayToWitnessScriptHash(multisig.witnessScriptHash());
+
+    for (const auto threads : {1ul, 2ul}) {
+        SigningInput input;
+        input.privateKeys = keys;
+        input.scripts[hex(multisig.scriptHash())] = multisig.script();
+        input.signingThreads = threads;
+        TransactionPlan plan;
+        auto transaction = Transaction(2);
+        for (byte i = 0; i < 3; ++i) {
+            const auto outPoint = OutPoint(Data(32, i), 0);
+            UTXO utxo;
+            utxo.outPoint = outPoint;
+            utxo.script = lockScript;
+            utxo.amount = 100'000;
+            plan.utxos.push_back(utxo);
+            transaction.inputs.emplace_back(outPoint, Script(), 0xffffffff);
+        }
+        transaction.outputs.emplace_back(290'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 0xaa)));
+
+        const auto result = SignatureBuilder<Transaction>(input, plan, transaction).sign();
+        ASSERT_TRUE(result) << threads;
+        const auto& signedTransaction = result.payload();
+        for (std::size_t i = 0; i < signedTransaction.inputs.size(); ++i) {
+            const auto& witness = signedTransaction.inputs[i].scriptWitness;
+            ASSERT_EQ(witness.size(), 4ul);
+            EXPECT_TRUE(witness[0].empty());
+            EXPECT_EQ(witness[3], multisig.script().bytes);
+            // the signatures of the first two keys in script order
+            const auto sighash = transaction.getSignatureHash(multisig.script(), i, TWBitcoinSigHashTypeAll, 100'000, WITNESS_V0);
+            for (std::size_t slot = 0; slot < 2; ++slot) {
+                const auto signature = Data(witness[slot + 1].begin(), witness[slot + 1].end() - 1);
+                EXPECT_TRUE(PublicKey(multisig.keys()[slot], TWPublicKeyTypeSECP256k1).verifyAsDER(signature, sighash));
+            }
+        }
+    }
+}
+
 TEST(BitcoinTransactionSigner, PushAllEmpty) {
     {
         std::vector<Data> input = {};
@@ -401,4 +499,73 @@ TEST(BitcoinTransactionSigner, PushAllEmpty) {
         EXPECT_EQ(hex(res), hex(expected));
     }
 }
+
+TEST(BitcoinScriptView, Type) {
+    EXPECT_EQ(PayToScriptHash.view().type(), ScriptType::PayToScriptHash);
+    EXPECT_EQ(PayToWitnessScriptHash.view().type(), ScriptType::PayToWitnessScriptHash);
+    EXPECT_EQ(PayToWitnessPublicKeyHash.view().type(), ScriptType::PayToWitnessPublicKeyHash);
+    EXPECT_EQ(PayToPublicKeySecp256k1.view().type(), ScriptType::PayToPublicKey);
+    EXPECT_EQ(PayToPublicKeySecp256k1Extended.view().type(), ScriptType::PayToPublicKey);
+    EXPECT_EQ(PayToPublicKeyHash.view().type(), ScriptType::PayToPublicKeyHash);
+    EXPECT_EQ(Script::buildPayToV1WitnessProgram(Data(32, 1)).view().type(), ScriptType::PayToTaproot);
+    EXPECT_EQ(Script(parse_hex("5214" "0102030405060708091011121314151617181920")).view().type(), ScriptType::WitnessProgram);
+    EXPECT_EQ(Script(parse_hex("51" "21" "03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432" "51" "ae")).view().type(), ScriptType::Multisig);
+    EXPECT_EQ(Script::buildOpReturnScript(parse_hex("0102")).view().type(), ScriptType::Unknown);
+    EXPECT_EQ(ScriptView().type(), ScriptType::Unknown);
+}
+
+TEST(BitcoinScriptView, Match) {
+    // results point into the viewed bytes
+    const auto view = PayToWitnessPublicKeyHash.view();
+    const auto keyHash = view.matchPayToWitnessPublicKeyHash();
+    ASSERT_TRUE(keyHash.has_value());
+    EXPECT_EQ(keyHash->data(), PayToWitnessPublicKeyHash.bytes.data() + 2);
+    EXPECT_EQ(hex(*keyHash), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_FALSE(view.matchPayToPublicKeyHash().has_value());
+    EXPECT_FALSE(view.matchPayToWitnessScriptHash().has_value());
+
+    EXPECT_EQ(hex(*PayToPublicKeyHash.view().matchPayToPublicKeyHash()), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_EQ(hex(*PayToScriptHash.view().matchPayToScriptHash()), "4733f37cf4db86fbc2efed2500b4f4e49f312023");
+    EXPECT_EQ(hex(*PayToWitnessScriptHash.view().matchPayToWitnessScriptHash()), "ff25429251b5a84f452230a3c75fd886b7fc5a7865ce4a7bb7a9d7c5be6da3db");
+    EXPECT_EQ(hex(*PayToPublicKeySecp256k1.view().matchPayToPublicKey()), "03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432");
+}
+
+TEST(BitcoinScriptView, MatchMultisig) {
+    const auto script = Script(parse_hex("52" "21" "03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432" "21" "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1" "52" "ae"));
+    const auto multisig = script.view().matchMultisig();
+    ASSERT_TRUE(multisig.has_value());
+    EXPECT_EQ(multisig->required, 2);
+    EXPECT_EQ(multisig->count, 2ul);
+
+    std::vector<std::string> keys;
+    const auto keyOps = ScriptView(multisig->keys);
+    std::size_t index = 0;
+    ScriptView::Op op;
+    while (keyOps.nextOp(index, op)) {
+        EXPECT_EQ(op.opcode, 0x21);
+        keys.push_back(hex(op.operand));
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432", "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"}));
+
+    EXPECT_FALSE(ScriptView(parse_hex("51ae")).matchMultisig().has_value());
+}
+
+TEST(BitcoinScriptView, NextOp) {
+    const auto bytes = parse_hex("4f" "4c" "05" "0102030405" "4d" "0500" "010203");
+    const auto view = ScriptView(bytes);
+    std::size_t index = 0;
+    ScriptView::Op op;
+    ASSERT_TRUE(view.nextOp(index, op));
+    EXPECT_EQ(op.opcode, OP_1NEGATE);
+    EXPECT_TRUE(op.operand.empty());
+    ASSERT_TRUE(view.nextOp(index, op));
+    EXPECT_EQ(op.opcode, OP_PUSHDATA1);
+    EXPECT_EQ(op.operand.data(), bytes.data() + 3);
+    EXPECT_EQ(hex(op.operand), "0102030405");
+    EXPECT_EQ(index, 8ul);
+    // truncated push
+    EXPECT_FALSE(view.nextOp(index, op));
+    EXPECT_EQ(op.opcode, OP_PUSHDATA2);
+}
+
 } // namespace TW::Bitcoin::tests
@@ -501,4 +501,63 @@ TEST(BitcoinInputSelector, ManyUtxos_MaxAmount_5000) {
     EXPECT_TRUE(verifySelectedUTXOs(selected, subset));
 }
 
+
+TEST(BitcoinInputSelector, SelectBranchAndBound) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(5000, 1);
+
+    // no changeless set, knapsack fallback; lowest excess in effective value
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {2000, 4000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundChangeless) {
+    auto utxos = buildTestUTXOs({6000, 4200, 3000, 8000, 2500});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(9900, 1);
+
+    // excess over amount and changeless fee is below the cost of a change output
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {4200, 6000}));
+    auto& feeCalculator = getFeeCalculator(TWCoinTypeBitcoin);
+    EXPECT_LT(10200 - 9900 - feeCalculator.calculate(2, 1, 1), feeCalculator.calculate(0, 2, 1) - feeCalculator.calculate(0, 1, 1) + feeCalculator.calculateSingleInput(1));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundMaxIterations) {
+    auto utxos = buildTestUTXOs({6000, 4200, 3000, 8000, 2500});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(9900, 1, 2, 1);
+
+    // search budget exhausted, knapsack fallback
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {6000, 8000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundInsufficient) {
+    auto utxos = buildTestUTXOs({6000, 4200, 3000, 8000, 2500});
+
+    auto selector = InputSelector<UTXO>(utxos);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(23500, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(30000, 1), {}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundManyUtxos) {
+    const auto n = 5000;
+    const auto byteFee = 10;
+    std::vector<int64_t> values;
+    for (int i = 0; i < n; ++i) {
+        values.push_back((i + 1) * 100);
+    }
+    auto utxos = buildTestUTXOs(values);
+
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(10'000'000, byteFee);
+
+    ASSERT_FALSE(selected.empty());
+    auto& feeCalculator = getFeeCalculator(TWCoinTypeBitcoin);
+    EXPECT_GE(InputSelector<UTXO>::sum(selected), 10'000'000 + static_cast<uint64_t>(feeCalculator.calculate(selected.size(), 1, byteFee)));
+}
+
 } // namespace TW::Bitcoin
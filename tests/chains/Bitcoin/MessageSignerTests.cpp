@@ -7,6 +7,7 @@
 #include "Bitcoin/MessageSigner.h"
 #include <TrustWalletCore/TWBitcoinMessageSigner.h>
 #include "Bitcoin/Address.h"
+#include "Bitcoin/SegwitAddress.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
@@ -139,6 +140,64 @@ TEST(BitcoinMessageSigner, VerifyNegative) {
     ), "Input address invalid");
 }
 
+TEST(BitcoinMessageSigner, VerifyMessageBatch) {
+    const auto msg = std::string("test signature");
+    const auto pubKey = gPrivateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto signature = gPrivateKey.sign(MessageSigner::messageToHash(msg), TWCurveSECP256k1);
+    // BIP137 headers of segwit addresses: 35 for P2SH-P2WPKH, 39 for P2WPKH, plus the recovery id
+    auto segwitSignature = [&](byte header) {
+        auto adjusted = Data{static_cast<byte>(header + signature[64])};
+        append(adjusted, subData(signature, 0, 64));
+        return Base64::encode(adjusted);
+    };
+    const auto p2wpkh = SegwitAddress(pubKey, "bc").string();
+    auto script = Data{0x00, 0x14};
+    append(script, Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()));
+    auto p2shData = Data{TW::p2shPrefix(TWCoinTypeBitcoin)};
+    append(p2shData, Hash::sha256ripemd(script.data(), script.size()));
+    const auto p2sh = Address(p2shData).string();
+    const auto p2wpkhSignature = segwitSignature(39);
+    const auto p2shSignature = segwitSignature(35);
+
+    const std::string bip322 = "bc1q9vza2e8x573nczrlzms0wvx3gsqjx7vavgkx0l";
+    const std::string taproot = "bc1ppv609nr0vr25u07u95waq5lucwfm6tde4nydujnu8npg4q75mr5sxq8lt3";
+    const std::string empty;
+    const std::string hello = "Hello World";
+    const std::string emptySignature = "AkcwRAIgM2gBAQqvZX15ZiysmKmQpDrG83avLIT492QBzLnQIxYCIBaTpOaD20qRlEylyxFSeEA2ba9YOixpX8z46TSDtS40ASECx/EgAxlkQpQ9hYjgGu6EBCPMVPwVIVJqO4XCsMvViHI=";
+    const std::string helloSignature = "AkcwRAIgZRfIY3p7/DoVTty6YZbWS71bc5Vct9p9Fia83eRmw2QCICK/ENGfwLtptFluMGs2KsqoNSk89pO7F29zJLUx9a/sASECx/EgAxlkQpQ9hYjgGu6EBCPMVPwVIVJqO4XCsMvViHI=";
+    const std::string taprootSignature = "AUHd69PrJQEv+oKTfZ8l+WROBHuy9HKrbFCJu7U1iK2iiEy1vMU5EfMtjc+VSHM7aU0SDbak5IUZRVno2P5mjSafAQ==";
+
+    const std::string legacy = "1B8Qea79tsxmn4dTiKKRVvsJpHwL2fMQnr";
+    const std::string legacySignature = "H+3L5IbSVcejp4S2VwLXCxLEMQAWDvKbE8lQyq0ocdvyM1aoEudkzN/S/qLI3vnNOFY6V13BXWSFrPr3OjGa5Dk=";
+    const std::string uncompressed = "1E4T9JZ3mq6cdgiRJEWzHqDXb9t322fE6d";
+    const std::string uncompressedSignature = "HLH5K7JQLaRGaKGXXH5mYM6FIIy9IWyY4JUPI+PHYY4WaupxUbg+zy0bhBCrDuehy9x4WidwjkRR1GSLnWvOXBo=";
+    const std::string invalid = "__THIS_IS_NOT_A_VALID_ADDRESS__";
+
+    const std::vector<MessageVerification> items = {
+        {legacy, msg, legacySignature},
+        {uncompressed, msg, uncompressedSignature},
+        {p2wpkh, msg, p2wpkhSignature},
+        {p2sh, msg, p2shSignature},
+        {bip322, empty, emptySignature},
+        {bip322, hello, helloSignature},
+        {taproot, hello, taprootSignature},
+        // negatives
+        {legacy, hello, legacySignature},
+        {uncompressed, msg, legacySignature},
+        {p2wpkh, hello, p2wpkhSignature},
+        {bip322, hello, emptySignature},
+        {bip322, empty, taprootSignature},
+        {taproot, empty, taprootSignature},
+        {taproot, msg, p2wpkhSignature},
+        {invalid, msg, legacySignature},
+        {legacy, msg, invalid},
+    };
+    const auto expected = std::vector<bool>{true, true, true, true, true, true, true, false, false, false, false, false, false, false, false, false};
+    EXPECT_EQ(MessageSigner::verifyMessageBatch(items, 1), expected);
+    EXPECT_EQ(MessageSigner::verifyMessageBatch(items, 4), expected);
+    EXPECT_TRUE(MessageSigner::verifyMessageBatch({}).empty());
+}
+
 TEST(BitcoinMessageSigner, MessageToHash) {
     EXPECT_EQ(hex(MessageSigner::messageToHash("Hello, world!")), "02d6c0643e40b0db549cbbd7eb47dcab71a59d7017199ebde6b272f28fbbf95f");
     EXPECT_EQ(hex(MessageSigner::messageToHash("test signature")), "8e81cc5bca9862d8b7f22be1f7cb762b49121cf4e1611c27906a041f9a9eb21f");
@@ -0,0 +1,136 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/PayoutPlanner.h"
+#include "Bitcoin/SizeEstimator.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin::PayoutPlannerTests {
+
+const auto txHash = parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1f7fc8b8f4ab4d3c4fa4a6bb6");
+const auto payoutAddress = "1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx";
+
+UtxoPool buildPool(const std::vector<int64_t>& amounts) {
+    auto utxos = buildTestUTXOs(amounts);
+    for (auto i = 0ul; i < utxos.size(); ++i) {
+        utxos[i].outPoint = OutPoint(txHash, static_cast<uint32_t>(i), UINT32_MAX);
+    }
+    UtxoPool pool;
+    pool.add(utxos);
+    return pool;
+}
+
+/// Checks that the batch balances and that its fee is the exact estimated virtual size.
+void verifyBatch(const PayoutBatch& batch, const SigningInput& input) {
+    Amount outputs = 0;
+    std::vector<Script> outputScripts;
+    for (const auto& output : batch.transaction.outputs) {
+        outputs += output.value;
+        outputScripts.push_back(output.script);
+    }
+    EXPECT_EQ(outputs, batch.plan.amount + batch.plan.change);
+    EXPECT_EQ(batch.plan.availableAmount, batch.plan.amount + batch.plan.change + batch.plan.fee);
+    EXPECT_EQ(batch.transaction.inputs.size(), batch.plan.utxos.size());
+    const auto size = TransactionBuilder::sizeEstimator(input).transaction(batch.plan.utxos, outputScripts);
+    ASSERT_TRUE(size.has_value());
+    if (batch.plan.change > 0) {
+        EXPECT_EQ(batch.plan.fee, input.byteFee * static_cast<Amount>(size->virtualSize()));
+    } else {
+        EXPECT_GE(batch.plan.fee, input.byteFee * static_cast<Amount>(size->virtualSize()));
+    }
+}
+
+TEST(BitcoinPayoutPlanner, Batches) {
+    const auto pool = buildPool({20000, 100000, 30000, 50000});
+    const auto input = buildSigningInput(0, 1, {});
+    const std::vector<Payout> payouts(5, Payout{payoutAddress, 10000});
+
+    PayoutPlanner::Limits limits;
+    limits.maxOutputs = 2;
+    const auto plan = PayoutPlanner::plan(input, payouts, pool, limits);
+    EXPECT_EQ(plan.error, Common::Proto::OK);
+    EXPECT_TRUE(plan.unpaid.empty());
+    ASSERT_EQ(plan.batches.size(), 3ul);
+    EXPECT_EQ(plan.batches[0].payouts, (std::vector<std::size_t>{0, 1}));
+    EXPECT_EQ(plan.batches[1].payouts, (std::vector<std::size_t>{2, 3}));
+    EXPECT_EQ(plan.batches[2].payouts, (std::vector<std::size_t>{4}));
+    // largest UTXOs first
+    EXPECT_TRUE(verifySelectedUTXOs(plan.batches[0].plan.utxos, {100000}));
+    EXPECT_TRUE(verifySelectedUTXOs(plan.batches[1].plan.utxos, {50000}));
+    EXPECT_TRUE(verifySelectedUTXOs(plan.batches[2].plan.utxos, {30000}));
+    // 1 P2WPKH input, 2 P2PKH outputs and change: 153 bytes and 110 witness bytes
+    EXPECT_EQ(plan.batches[0].plan.fee, 181);
+    EXPECT_EQ(plan.batches[0].plan.change, 100000 - 20000 - 181);
+    for (const auto& batch : plan.batches) {
+        verifyBatch(batch, input);
+        EXPECT_EQ(batch.transaction.outputs.size(), batch.payouts.size() + 1);
+    }
+
+    // the batches sign like any prepared transaction
+    using Signer = TransactionSigner<Transaction, TransactionBuilder>;
+    const auto& batch = plan.batches[0];
+    const auto signedTx = Signer::sign(input, Signer::Prepared{batch.plan, batch.transaction}, SigningMode_Normal);
+    ASSERT_TRUE(signedTx);
+    EXPECT_EQ(signedTx.payload().outputs.size(), 3ul);
+    EXPECT_EQ(signedTx.payload().inputs.size(), 1ul);
+}
+
+TEST(BitcoinPayoutPlanner, Unpaid) {
+    const auto pool = buildPool({20000, 100000, 30000, 50000});
+    const auto input = buildSigningInput(0, 1, {});
+    const std::vector<Payout> payouts = {
+        {payoutAddress, 90000},
+        {payoutAddress, 60000},
+        {payoutAddress, 100000},
+        {payoutAddress, 1000},
+    };
+
+    const auto plan = PayoutPlanner::plan(input, payouts, pool);
+    EXPECT_EQ(plan.error, Common::Proto::OK);
+    ASSERT_EQ(plan.batches.size(), 1ul);
+    EXPECT_EQ(plan.batches[0].payouts, (std::vector<std::size_t>{0, 1}));
+    EXPECT_TRUE(verifySelectedUTXOs(plan.batches[0].plan.utxos, {100000, 50000, 30000}));
+    verifyBatch(plan.batches[0], input);
+    // payouts are paid in order: the later small one waits too
+    EXPECT_EQ(plan.unpaid, (std::vector<std::size_t>{2, 3}));
+}
+
+TEST(BitcoinPayoutPlanner, SizeLimit) {
+    const auto pool = buildPool({20000, 20000, 20000, 20000});
+    const auto input = buildSigningInput(0, 1, {});
+    const std::vector<Payout> payouts(3, Payout{payoutAddress, 15000});
+
+    PayoutPlanner::Limits limits;
+    // room for two P2WPKH inputs, not three
+    limits.maxVirtualSize = 300;
+    const auto plan = PayoutPlanner::plan(input, payouts, pool, limits);
+    EXPECT_TRUE(plan.unpaid.empty());
+    ASSERT_EQ(plan.batches.size(), 2ul);
+    EXPECT_EQ(plan.batches[0].payouts, (std::vector<std::size_t>{0, 1}));
+    EXPECT_EQ(plan.batches[0].plan.utxos.size(), 2ul);
+    EXPECT_EQ(plan.batches[1].payouts, (std::vector<std::size_t>{2}));
+    EXPECT_EQ(plan.batches[1].plan.utxos.size(), 1ul);
+    for (const auto& batch : plan.batches) {
+        verifyBatch(batch, input);
+    }
+}
+
+TEST(BitcoinPayoutPlanner, InvalidAddress) {
+    const auto pool = buildPool({100000});
+    const auto input = buildSigningInput(0, 1, {});
+    auto plan = PayoutPlanner::plan(input, {{payoutAddress, 1000}, {"invalid", 1000}}, pool);
+    EXPECT_EQ(plan.error, Common::Proto::Error_invalid_address);
+    EXPECT_TRUE(plan.batches.empty());
+
+    plan = PayoutPlanner::plan(input, {{payoutAddress, 0}}, pool);
+    EXPECT_EQ(plan.error, Common::Proto::Error_zero_amount_requested);
+}
+
+} // namespace TW::Bitcoin::PayoutPlannerTests
@@ -0,0 +1,189 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/Psbt.h"
+#include "Bitcoin/Script.h"
+#include "BinaryCoding.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+#include <list>
+
+namespace TW::Bitcoin::tests {
+
+namespace {
+
+const std::vector<PrivateKey> privateKeys = {
+    PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9")),
+    PrivateKey(parse_hex("a4eea09c6d2b7cbd6d86e6c2b7ebd3c1ba5c8aa4a1e8b52c0a1d7de3e0cf5e41")),
+    PrivateKey(parse_hex("2ed58b6e2e8e2a95a9c8a9e0c2f1b3d2b8c1a0e8f6d9c3b7a1e4d2c0b9f8e7d6")),
+};
+
+Data multisigScript(std::size_t required) {
+    Data script = {Script::encodeNumber(static_cast<int>(required))};
+    for (const auto& key : privateKeys) {
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+        script.push_back(static_cast<byte>(publicKey.size()));
+        append(script, publicKey);
+    }
+    script.push_back(Script::encodeNumber(static_cast<int>(privateKeys.size())));
+    script.push_back(OP_CHECKMULTISIG);
+    return script;
+}
+
+Transaction unsignedTransaction(std::size_t inputs) {
+    auto transaction = Transaction(2);
+    for (std::size_t i = 0; i < inputs; ++i) {
+        transaction.inputs.emplace_back(OutPoint(Data(32, static_cast<byte>(i + 1)), 0), Script(), 0xfffffffd);
+    }
+    transaction.outputs.emplace_back(90'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 0xaa)));
+    return transaction;
+}
+
+/// Entry of a value kept in `storage`, which has to outlive the PSBT.
+Psbt::Entry entry(std::list<Data>& storage, byte type, Data value) {
+    storage.push_back({type});
+    const Data& key = storage.back();
+    storage.push_back(std::move(value));
+    return {key, storage.back()};
+}
+
+Data witnessUtxo(Amount amount, const Script& script) {
+    Data utxo;
+    encode64LE(static_cast<uint64_t>(amount), utxo);
+    script.encode(utxo);
+    return utxo;
+}
+
+} // namespace
+
+TEST(BitcoinPsbt, ParseEncode) {
+    const auto psbt = Psbt::create(unsignedTransaction(2));
+    const auto encoded = psbt.encode();
+    EXPECT_EQ(hex(encoded).substr(0, 10), "70736274ff");
+
+    const auto parsed = Psbt::parse(encoded);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->version(), 0u);
+    EXPECT_EQ(parsed->inputs.size(), 2ul);
+    EXPECT_EQ(parsed->outputs.size(), 1ul);
+    EXPECT_EQ(parsed->encode(), encoded);
+
+    Data unsignedTx;
+    unsignedTransaction(2).encode(unsignedTx, Transaction::NonSegwit);
+    Data parsedTx;
+    parsed->unsignedTransaction()->encode(parsedTx, Transaction::NonSegwit);
+    EXPECT_EQ(hex(parsedTx), hex(unsignedTx));
+
+    EXPECT_FALSE(Psbt::parse(parse_hex("70736274ff00")).has_value());
+    EXPECT_FALSE(Psbt::parse(Data(encoded.begin(), encoded.end() - 1)).has_value());
+    EXPECT_FALSE(Psbt::parse(parse_hex("0102")).has_value());
+}
+
+TEST(BitcoinPsbt, CombineFinalizeMultisig) {
+    // 2-of-3 P2WSH inputs, signed by cosigners 2 and 0 independently
+    const auto witnessScript = multisigScript(2);
+    const auto lockScript = Script::buildPayToWitnessScriptHash(Hash::sha256(witnessScript));
+    const Amount amount = 100'000;
+    const auto transaction = unsignedTransaction(2);
+
+    std::list<Data> storage;
+    auto creator = Psbt::create(transaction);
+    for (auto& input : creator.inputs) {
+        input.set(entry(storage, Psbt::InputWitnessUtxo, witnessUtxo(amount, lockScript)));
+        input.set(entry(storage, Psbt::InputWitnessScript, witnessScript));
+    }
+    const auto created = creator.encode();
+
+    std::vector<Psbt> cosigners;
+    for (const auto signer : {2, 0}) {
+        auto psbt = *Psbt::parse(created);
+        for (std::size_t i = 0; i < transaction.inputs.size(); ++i) {
+            const auto sighash = transaction.getSignatureHash(Script(witnessScript), i, TWBitcoinSigHashTypeAll, amount, WITNESS_V0);
+            auto signature = privateKeys[signer].signAsDER(sighash);
+            signature.push_back(TWBitcoinSigHashTypeAll);
+            psbt.addPartialSignature(i, Data(privateKeys[signer].getPublicKey(TWPublicKeyTypeSECP256k1).bytes), signature);
+        }
+        cosigners.push_back(*Psbt::parse(psbt.encode()));
+    }
+
+    auto combined = cosigners[0];
+    ASSERT_TRUE(combined.combine(cosigners[1]));
+    EXPECT_EQ(combined.inputs[0].range(Psbt::InputPartialSig).size(), 2ul);
+    EXPECT_FALSE(combined.combine(Psbt::create(unsignedTransaction(1))));
+
+    // one signature is not enough
+    auto partial = cosigners[0];
+    const auto failed = partial.finalize();
+    ASSERT_FALSE(failed);
+    EXPECT_EQ(failed.error(), Common::Proto::Error_signatures_count);
+
+    ASSERT_TRUE(combined.finalize());
+    EXPECT_FALSE(combined.inputs[0].get(Psbt::InputPartialSig, privateKeys[0].getPublicKey(TWPublicKeyTypeSECP256k1).bytes).has_value());
+    EXPECT_FALSE(combined.inputs[0].get(Psbt::InputWitnessScript).has_value());
+    EXPECT_TRUE(combined.inputs[0].get(Psbt::InputWitnessUtxo).has_value());
+
+    const auto extracted = Psbt::parse(combined.encode())->extract();
+    ASSERT_TRUE(extracted);
+    const auto signedTransaction = extracted.payload();
+    for (const auto& input : signedTransaction.inputs) {
+        EXPECT_TRUE(input.script.empty());
+        ASSERT_EQ(input.scriptWitness.size(), 4ul);
+        EXPECT_TRUE(input.scriptWitness[0].empty());
+        EXPECT_EQ(input.scriptWitness[3], witnessScript);
+    }
+    // signatures in the order of the keys in the script
+    const auto sighash = transaction.getSignatureHash(Script(witnessScript), 0, TWBitcoinSigHashTypeAll, amount, WITNESS_V0);
+    const auto& witness = signedTransaction.inputs[0].scriptWitness;
+    EXPECT_TRUE(privateKeys[0].getPublicKey(TWPublicKeyTypeSECP256k1).verifyAsDER(Data(witness[1].begin(), witness[1].end() - 1), sighash));
+    EXPECT_TRUE(privateKeys[2].getPublicKey(TWPublicKeyTypeSECP256k1).verifyAsDER(Data(witness[2].begin(), witness[2].end() - 1), sighash));
+}
+
+TEST(BitcoinPsbt, FinalizeNestedWitnessPublicKeyHash) {
+    const auto publicKey = Data(privateKeys[1].getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
+    const auto redeemScript = Script::buildPayToWitnessPublicKeyHash(Hash::sha256ripemd(publicKey.data(), publicKey.size()));
+    const auto lockScript = Script::buildPayToScriptHash(Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size()));
+
+    std::list<Data> storage;
+    auto psbt = Psbt::create(unsignedTransaction(1));
+    psbt.inputs[0].set(entry(storage, Psbt::InputWitnessUtxo, witnessUtxo(100'000, lockScript)));
+    psbt.inputs[0].set(entry(storage, Psbt::InputRedeemScript, redeemScript.bytes));
+    const auto signature = parse_hex("3044022000112233445566778899aabbccddeeff00112233445566778899aabbccddeeff02200011223344556677889900aabbccddeeff00112233445566778899aabbccddee01");
+    psbt.addPartialSignature(0, publicKey, signature);
+
+    ASSERT_TRUE(psbt.finalize());
+    const auto transaction = psbt.extract().payload();
+    Data scriptSig = {static_cast<byte>(redeemScript.bytes.size())};
+    append(scriptSig, redeemScript.bytes);
+    EXPECT_EQ(hex(transaction.inputs[0].script.bytes), hex(scriptSig));
+    ASSERT_EQ(transaction.inputs[0].scriptWitness.size(), 2ul);
+    EXPECT_EQ(transaction.inputs[0].scriptWitness[0], signature);
+    EXPECT_EQ(transaction.inputs[0].scriptWitness[1], publicKey);
+}
+
+TEST(BitcoinPsbt, ExternalSignatures) {
+    // two inputs of the same key: each hash gets the signature of its own input
+    const auto publicKey = Data(privateKeys[0].getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
+    const auto publicKeyHash = Hash::sha256ripemd(publicKey.data(), publicKey.size());
+    auto psbt = Psbt::create(unsignedTransaction(2));
+    psbt.addPartialSignature(0, publicKey, parse_hex("3006020101020101" "01"));
+    psbt.addPartialSignature(1, publicKey, parse_hex("3006020101020102" "01"));
+
+    const auto signatures = psbt.externalSignatures({{Data(32), publicKeyHash}, {Data(32), publicKeyHash}});
+    ASSERT_TRUE(signatures.has_value());
+    ASSERT_EQ(signatures->size(), 2ul);
+    EXPECT_EQ(hex(signatures->at(0).first), "3006020101020101");
+    EXPECT_EQ(hex(signatures->at(1).first), "3006020101020102");
+    EXPECT_EQ(signatures->at(1).second, publicKey);
+
+    EXPECT_FALSE(psbt.externalSignatures({{Data(32), publicKeyHash}, {Data(32), publicKeyHash}, {Data(32), publicKeyHash}}).has_value());
+    EXPECT_FALSE(psbt.externalSignatures({{Data(32), Data(20)}}).has_value());
+}
+
+} // namespace TW::Bitcoin::tests
@@ -0,0 +1,92 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/Schnorr.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin::tests {
+
+// https://github.com/bitcoin/bips/blob/master/bip-0340/test-vectors.csv
+TEST(BitcoinSchnorr, SignVectors) {
+    const auto signer0 = SchnorrSigner(PrivateKey(parse_hex("0000000000000000000000000000000000000000000000000000000000000003")));
+    EXPECT_EQ(hex(signer0.publicKey().bytes()), "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9");
+    EXPECT_EQ(hex(signer0.sign(Data(32, 0), Data(32, 0))), "e907831f80848d1069a5371b402410364bdf1c5f8307b0084c55f1ce2dca821525f66a4a85ea8b71e482a74f382d2ce5ebeee8fdb2172f477df4900d310536c0");
+
+    const auto signer1 = SchnorrSigner(PrivateKey(parse_hex("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef")));
+    const auto message = parse_hex("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89");
+    const auto signature = signer1.sign(message, parse_hex("0000000000000000000000000000000000000000000000000000000000000001"));
+    EXPECT_EQ(hex(signer1.publicKey().bytes()), "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659");
+    EXPECT_EQ(hex(signature), "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de33418906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a");
+
+    EXPECT_TRUE(signer1.sign(Data(31), Data(32)).empty());
+    EXPECT_THROW(SchnorrSigner(PrivateKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"))), std::invalid_argument);
+}
+
+TEST(BitcoinSchnorr, Verify) {
+    const auto publicKey = XOnlyPublicKey(parse_hex("dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659"));
+    const auto message = parse_hex("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89");
+    auto signature = parse_hex("6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de33418906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a");
+    EXPECT_TRUE(publicKey.verify(signature, message));
+
+    signature[63] ^= 1;
+    EXPECT_FALSE(publicKey.verify(signature, message));
+    EXPECT_FALSE(publicKey.verify(Data(64, 0xff), message));
+    EXPECT_FALSE(publicKey.verify(Data(63), message));
+
+    // x coordinate not on the curve
+    EXPECT_THROW(XOnlyPublicKey(parse_hex("eefdea4cdb677750a420fee807eacf21eb9898ae79b9768766e4faa04a2d4a34")), std::invalid_argument);
+
+    // the y parity of a full public key is dropped
+    const auto privateKey = PrivateKey(parse_hex("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef"));
+    EXPECT_EQ(XOnlyPublicKey(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1)).bytes(), publicKey.bytes());
+}
+
+TEST(BitcoinSchnorr, TaggedHash) {
+    EXPECT_EQ(hex(TaggedHash("TapSighash").hash({})), hex(TaggedHash::tapSighash().hash({})));
+    const auto part = parse_hex("0102");
+    EXPECT_EQ(TaggedHash::challenge().hash({part, part}), TaggedHash::challenge().hash({parse_hex("01020102")}));
+}
+
+// https://github.com/bitcoin/bips/blob/master/bip-0086.mediawiki#test-vectors
+TEST(BitcoinSchnorr, TaprootKeyPath) {
+    const auto internal = XOnlyPublicKey(parse_hex("cc8a4bc64d897bddc5fbc2f670f7a8ba0b386779106cf1223c6fc5d7cd6fc115"));
+    EXPECT_EQ(hex(internal.tweak().bytes()), "a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c");
+
+    const auto privateKey = PrivateKey(parse_hex("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef"));
+    const auto signer = SchnorrSigner::taprootKeyPath(privateKey);
+    EXPECT_EQ(signer.publicKey().bytes(), SchnorrSigner(privateKey).publicKey().tweak().bytes());
+
+    const auto sighash = Data(32, 0x11);
+    const auto signature = signer.sign(sighash, Data(32, 0));
+    EXPECT_EQ(hex(signature), "693685d1705c55812be24c650c659c5ad63a79f2589894cdda2fc08b4bf2b11ffaa468681b1abbccb9a99e91fe7a9a43c59b004a987625f750e5e26ae8947e7a");
+    EXPECT_TRUE(signer.publicKey().verify(signature, sighash));
+}
+
+TEST(BitcoinSchnorr, Batch) {
+    const auto signer = SchnorrSigner::taprootKeyPath(PrivateKey(parse_hex("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef")));
+    std::vector<Data> messages;
+    for (auto i = 0; i < 20; ++i) {
+        messages.emplace_back(32, static_cast<byte>(i));
+    }
+    auto signatures = signer.signBatch(messages, 4);
+    ASSERT_EQ(signatures.size(), messages.size());
+
+    std::vector<SchnorrVerification> items;
+    for (auto i = 0ul; i < messages.size(); ++i) {
+        items.push_back({signer.publicKey(), signatures[i], messages[i]});
+    }
+    EXPECT_TRUE(verifySchnorrBatch(items, 4));
+    EXPECT_TRUE(verifySchnorrBatch({}));
+
+    signatures[7][40] ^= 1;
+    EXPECT_FALSE(verifySchnorrBatch(items, 4));
+    EXPECT_FALSE(verifySchnorrBatch(items, 1));
+}
+
+} // namespace TW::Bitcoin::tests
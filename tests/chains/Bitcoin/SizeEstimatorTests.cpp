@@ -0,0 +1,128 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/OpCodes.h"
+#include "Bitcoin/SizeEstimator.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin::SizeEstimatorTests {
+
+const auto keyHash = parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+const auto toScript = Script::buildPayToPublicKeyHash(parse_hex("769bdff96a02f9135a1d19b749db6a78fe07dc90"));
+
+Script multisigScript() {
+    Data bytes{OP_2};
+    for (const auto* key : {"afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5",
+                            "a4c0b2f2e5e9fb4aa0b7d5a4d4e37ad9e1f2b6b0bc5e0dbc6bb7a2ee1f38e3a1",
+                            "b2ea9e9d8ad7f0af5b8a9e1c7d3f5a8c0e2f4b6d8a0c2e4f6b8d0a2c4e6f8a0b"}) {
+        const auto publicKey = PrivateKey(parse_hex(key)).getPublicKey(TWPublicKeyTypeSECP256k1);
+        bytes.push_back(static_cast<uint8_t>(publicKey.bytes.size()));
+        append(bytes, publicKey.bytes);
+    }
+    append(bytes, Data{OP_3, OP_CHECKMULTISIG});
+    return Script(bytes);
+}
+
+TEST(BitcoinSizeEstimator, InputSizes) {
+    const auto estimator = SizeEstimator();
+    EXPECT_EQ(estimator.input(Script::buildPayToWitnessPublicKeyHash(keyHash)), (InputSize{41, 108}));
+    EXPECT_EQ(estimator.input(Script::buildPayToPublicKeyHash(keyHash)), (InputSize{148, 0}));
+    EXPECT_EQ(estimator.input(Script::buildPayToV1WitnessProgram(Data(32, 1))), (InputSize{41, 66}));
+    EXPECT_EQ(estimator.input(multisigScript()), (InputSize{188, 0}));
+
+    // unknown witness program
+    EXPECT_EQ(estimator.input(Script::buildPayToV0WitnessProgram(Data(25, 1))), std::nullopt);
+    EXPECT_EQ(estimator.input(Script::buildOpReturnScript(parse_hex("0102"))), std::nullopt);
+}
+
+TEST(BitcoinSizeEstimator, UncompressedKey) {
+    const auto estimator = SizeEstimator({}, {keyHash});
+    EXPECT_EQ(estimator.input(Script::buildPayToPublicKeyHash(keyHash)), (InputSize{180, 0}));
+    EXPECT_EQ(estimator.input(Script::buildPayToPublicKeyHash(Data(20, 1))), (InputSize{148, 0}));
+}
+
+TEST(BitcoinSizeEstimator, ScriptHash) {
+    const auto redeemScript = Script::buildPayToWitnessPublicKeyHash(keyHash);
+    const auto redeemHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    const auto witnessScript = multisigScript();
+    const auto witnessHash = Hash::sha256(witnessScript.bytes);
+    const auto nestedWitnessScript = Script::buildPayToWitnessScriptHash(witnessHash);
+    const auto nestedHash = Hash::sha256ripemd(nestedWitnessScript.bytes.data(), nestedWitnessScript.bytes.size());
+    const auto multisigHash = Hash::sha256ripemd(witnessScript.bytes.data(), witnessScript.bytes.size());
+
+    const auto estimator = SizeEstimator({
+        {hex(redeemHash), redeemScript},
+        {hex(Hash::ripemd(witnessHash)), witnessScript},
+        {hex(nestedHash), nestedWitnessScript},
+        {hex(multisigHash), witnessScript},
+    });
+
+    // P2SH-P2WPKH
+    EXPECT_EQ(estimator.input(Script::buildPayToScriptHash(redeemHash)), (InputSize{64, 108}));
+    // P2WSH 2-of-3 multisig
+    EXPECT_EQ(estimator.input(Script::buildPayToWitnessScriptHash(witnessHash)), (InputSize{41, 254}));
+    // P2SH-P2WSH 2-of-3 multisig
+    EXPECT_EQ(estimator.input(Script::buildPayToScriptHash(nestedHash)), (InputSize{76, 254}));
+
+    // non-witness P2SH is not supported
+    EXPECT_EQ(estimator.input(Script::buildPayToScriptHash(multisigHash)), std::nullopt);
+    // missing redeem script
+    EXPECT_EQ(SizeEstimator().input(Script::buildPayToScriptHash(redeemHash)), std::nullopt);
+}
+
+TEST(BitcoinSizeEstimator, TransactionSize) {
+    const auto estimator = SizeEstimator();
+    const auto changeScript = Script::buildPayToPublicKeyHash(keyHash);
+    EXPECT_EQ(SizeEstimator::output(toScript), 34ul);
+
+    // same as the size estimation by signing
+    auto size = estimator.transaction(buildTestUTXOs({10'000}), {toScript, changeScript});
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(size->base, 119ul);
+    EXPECT_EQ(size->witness, 110ul);
+    EXPECT_EQ(size->weight(), 586ul);
+    EXPECT_EQ(size->virtualSize(), 147ul);
+
+    size = estimator.transaction(buildTestUTXOs({10'000, 20'000}), {toScript, changeScript});
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(size->virtualSize(), 215ul);
+
+    // non-witness input in a segwit transaction has an empty witness
+    auto utxos = buildTestUTXOs({10'000, 20'000});
+    utxos[1].script = Script::buildPayToPublicKeyHash(keyHash);
+    size = estimator.transaction(utxos, {toScript});
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(size->base, 233ul);
+    EXPECT_EQ(size->witness, 111ul);
+
+    // no witness at all
+    utxos[0].script = Script::buildPayToPublicKeyHash(keyHash);
+    size = estimator.transaction(utxos, {toScript});
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(size->witness, 0ul);
+    EXPECT_EQ(size->virtualSize(), 340ul);
+
+    utxos[0].script = Script::buildOpReturnScript(parse_hex("0102"));
+    EXPECT_FALSE(estimator.transaction(utxos, {toScript}).has_value());
+}
+
+TEST(BitcoinSizeEstimator, ScriptFeeCalculator) {
+    const auto calculator = ScriptFeeCalculator(InputSize{41, 108}, 34);
+    EXPECT_EQ(calculator.calculateSingleInput(1), 68);
+    EXPECT_EQ(calculator.calculate(1, 2, 1), 147);
+    EXPECT_EQ(calculator.calculate(2, 2, 10), 2150);
+    EXPECT_EQ(calculator.calculate(0, 1, 1), 44);
+
+    const auto legacy = ScriptFeeCalculator(InputSize{148, 0}, 34);
+    EXPECT_EQ(legacy.calculate(2, 1, 1), 340);
+}
+
+} // namespace TW::Bitcoin::SizeEstimatorTests
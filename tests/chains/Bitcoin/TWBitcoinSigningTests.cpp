@@ -10,6 +10,7 @@
 #include "Bitcoin/Script.h"
 #include "Bitcoin/SegwitAddress.h"
 #include "Bitcoin/SigHashType.h"
+#include "Bitcoin/Signer.h"
 #include "Bitcoin/Transaction.h"
 #include "Bitcoin/TransactionBuilder.h"
 #include "Bitcoin/TransactionSigner.h"
@@ -125,6 +126,39 @@ TEST(BitcoinSigning, SignP2PKH_NegativeMissingKey) {
     EXPECT_EQ(result.error(), Common::Proto::Error_missing_private_key);
 }
 
+TEST(BitcoinSigning, SignSkipTransactionDetails) {
+    const auto key = parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866");
+    const auto hash0 = parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f");
+    const auto script0 = parse_hex("76a914b7cd046b6d522a3d61dbcb5235c0e9cc9726545788ac");
+
+    Proto::SigningInput input;
+    input.set_hash_type(hashTypeForCoin(TWCoinTypeBitcoin));
+    input.set_amount(335'790'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+    input.add_private_key(key.data(), key.size());
+    auto& utxo = *input.add_utxo();
+    utxo.set_script(script0.data(), script0.size());
+    utxo.set_amount(625'000'000);
+    utxo.mutable_out_point()->set_hash(hash0.data(), hash0.size());
+    utxo.mutable_out_point()->set_index(0);
+    utxo.mutable_out_point()->set_sequence(UINT32_MAX);
+
+    const auto output = Signer::sign(input);
+    ASSERT_EQ(output.error(), Common::Proto::OK);
+    EXPECT_EQ(output.transaction().inputs_size(), 1);
+    EXPECT_FALSE(output.transaction_id().empty());
+
+    input.set_skip_outputs(Common::Proto::OutputField_transaction_details);
+    const auto encodedOnly = Signer::sign(input);
+    ASSERT_EQ(encodedOnly.error(), Common::Proto::OK);
+    EXPECT_EQ(hex(encodedOnly.encoded()), hex(output.encoded()));
+    EXPECT_FALSE(encodedOnly.has_transaction());
+    EXPECT_TRUE(encodedOnly.transaction_id().empty());
+}
+
 TEST(BitcoinSigning, EncodeP2WPKH) {
     auto unsignedTx = Transaction(1, 0x11);
 
@@ -177,7 +211,7 @@ TEST(BitcoinSigning, SignP2WPKH_Bip143) {
     const auto pubKey0 = utxoKey0.getPublicKey(TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(hex(pubKey0.bytes), "03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432");
 
-    const auto utxo0Script = Script::buildPayToPublicKey(pubKey0.bytes);
+    const auto utxo0Script = Script::buildPayToPublicKey(Data(pubKey0.bytes));
     Data key2;
     utxo0Script.matchPayToPublicKey(key2);
     EXPECT_EQ(hex(key2), hex(pubKey0.bytes));
@@ -1337,6 +1371,67 @@ TEST(BitcoinSigning, Sign_ManyUtxos_400) {
     EXPECT_EQ(serialized.size(), 9871ul);
 }
 
+TEST(BitcoinSigning, Sign_ManyUtxos_Parallel) {
+    auto ownAddress = "bc1q0yy3juscd3zfavw76g4h3eqdqzda7qyf58rj4m";
+    auto ownPrivateKey = "eb696a065ef48a2192da5b28b694f87544b30fae8327c4510137a922f32c6dcf";
+
+    // Setup input, alternating P2WPKH and P2PKH utxos
+    SigningInput input;
+    const auto n = 40;
+    for (int i = 0; i < n; ++i) {
+        auto utxoScript = Script::lockScriptForAddress(ownAddress, TWCoinTypeBitcoin);
+        Data keyHash;
+        EXPECT_TRUE(utxoScript.matchPayToWitnessPublicKeyHash(keyHash));
+        if (i % 2 == 1) {
+            utxoScript = Script::buildPayToPublicKeyHash(keyHash);
+        }
+
+        UTXO utxo;
+        utxo.script = utxoScript;
+        utxo.amount = 10'000 + (i + 1) * 10;
+        auto hash = parse_hex("a85fd6a9a7f2f54cacb57e83dfd408e51c0a5fc82885e3fa06be8692962bc407");
+        std::reverse(hash.begin(), hash.end());
+        utxo.outPoint = OutPoint(hash, i, UINT32_MAX);
+        input.utxos.push_back(utxo);
+    }
+    input.coinType = TWCoinTypeBitcoin;
+    input.hashType = hashTypeForCoin(TWCoinTypeBitcoin);
+    input.useMaxAmount = true;
+    input.byteFee = 1;
+    input.toAddress = "bc1qauwlpmzamwlf9tah6z4w0t8sunh6pnyyjgk0ne";
+    input.changeAddress = ownAddress;
+    input.privateKeys.push_back(PrivateKey(parse_hex(ownPrivateKey)));
+    input.plan = TransactionBuilder::plan(input);
+    ASSERT_EQ(input.plan->utxos.size(), static_cast<size_t>(n));
+
+    auto sequential = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+    ASSERT_TRUE(sequential) << std::to_string(sequential.error());
+    auto sequentialHashes = TransactionSigner<Transaction, TransactionBuilder>::preImageHashes(input);
+    ASSERT_TRUE(sequentialHashes);
+    EXPECT_EQ(sequentialHashes.payload().size(), static_cast<size_t>(n));
+
+    for (const auto threads : {2ul, 4ul, 64ul}) {
+        input.signingThreads = threads;
+        auto parallel = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+        ASSERT_TRUE(parallel) << std::to_string(parallel.error());
+        Data serializedSequential;
+        Data serializedParallel;
+        sequential.payload().encode(serializedSequential);
+        parallel.payload().encode(serializedParallel);
+        EXPECT_EQ(hex(serializedParallel), hex(serializedSequential));
+
+        auto parallelHashes = TransactionSigner<Transaction, TransactionBuilder>::preImageHashes(input);
+        ASSERT_TRUE(parallelHashes);
+        EXPECT_EQ(parallelHashes.payload(), sequentialHashes.payload());
+    }
+
+    // the error of the first failing input is reported
+    input.privateKeys.clear();
+    auto failed = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+    ASSERT_FALSE(failed);
+    EXPECT_EQ(failed.error(), Common::Proto::Error_missing_private_key);
+}
+
 TEST(BitcoinSigning, Sign_ManyUtxos_2000) {
     auto ownAddress = "bc1q0yy3juscd3zfavw76g4h3eqdqzda7qyf58rj4m";
     auto ownPrivateKey = "eb696a065ef48a2192da5b28b694f87544b30fae8327c4510137a922f32c6dcf";
@@ -1472,7 +1567,7 @@ TEST(BitcoinSigning, EncodeThreeOutput) {
 
     // add witness stack
     unsignedTx.inputs[0].scriptWitness.push_back(sig);
-    unsignedTx.inputs[0].scriptWitness.push_back(pubkey.bytes);
+    unsignedTx.inputs[0].scriptWitness.push_back(Data(pubkey.bytes));
 
     unsignedData.clear();
     unsignedTx.encode(unsignedData, Transaction::SegwitFormatMode::Segwit);
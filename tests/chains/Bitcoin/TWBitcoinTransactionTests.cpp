@@ -36,4 +36,71 @@ TEST(BitcoinTransaction, Encode) {
               "02000000035897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f0000000000ffffffffbf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c1200000000ffffffff22a6f904655d53ae2ff70e701a0bbd90aa3975c0f40bfc6cc996a9049e31cdfc0100000000ffffffff0280a81201000000001976a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac0084d717000000001976a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac00000000");
 }
 
+TEST(BitcoinTransaction, SerializedSize) {
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18), Script(parse_hex("16001458efd4f8e4eb4e1b9b8b8b41b1e6e3b9ae8cb2a1")), 4294967295);
+    transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+
+    EXPECT_FALSE(transaction.hasWitness());
+    for (auto mode : {Transaction::NonSegwit, Transaction::IfHasWitness, Transaction::Segwit}) {
+        Data data;
+        transaction.encode(data, mode);
+        EXPECT_EQ(data.size(), transaction.serializedSize(mode));
+    }
+    EXPECT_EQ(transaction.serializedSize(Transaction::NonSegwit), 149ul);
+
+    transaction.inputs[0].scriptWitness = {Data(72), Data(33)};
+    EXPECT_EQ(transaction.witnessSize(), 109ul);
+    for (auto mode : {Transaction::NonSegwit, Transaction::IfHasWitness, Transaction::Segwit}) {
+        Data data = parse_hex("ff");
+        transaction.encode(data, mode);
+        EXPECT_EQ(data.size(), 1 + transaction.serializedSize(mode));
+    }
+    EXPECT_EQ(transaction.serializedSize(Transaction::IfHasWitness), 149ul + 2 + 109);
+
+    const auto scriptCode = Script(parse_hex("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac"));
+    const auto preImage = transaction.getPreImage(scriptCode, 1, TWBitcoinSigHashTypeAll, 1000);
+    EXPECT_EQ(preImage.size(), Transaction::preImageSize(scriptCode));
+    Data buffer = parse_hex("ff");
+    transaction.encodePreImage(scriptCode, 1, TWBitcoinSigHashTypeAll, 1000, nullptr, buffer);
+    EXPECT_EQ(hex(buffer), "ff" + hex(preImage));
+}
+
+TEST(BitcoinTransaction, SignatureHashWithCache) {
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18), Script(), 4294967294);
+    transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+    transaction.outputs.emplace_back(400000000, Script(parse_hex("76a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac")));
+
+    const auto scriptCode = Script(parse_hex("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac"));
+    const auto hashTypes = {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeSingle, TWBitcoinSigHashTypeNone,
+                            TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)};
+
+    SigHashCache cache;
+    for (auto hashType : hashTypes) {
+        for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+            const auto expected = transaction.getSignatureHash(scriptCode, index, hashType, 1000, WITNESS_V0);
+            const auto cached = transaction.getSignatureHash(scriptCode, index, hashType, 1000, WITNESS_V0, &cache);
+            EXPECT_EQ(hex(cached), hex(expected));
+        }
+    }
+    ASSERT_TRUE(cache.prevoutHash.has_value());
+    ASSERT_TRUE(cache.sequenceHash.has_value());
+    ASSERT_TRUE(cache.outputsHash.has_value());
+    EXPECT_EQ(hex(*cache.prevoutHash), hex(transaction.getPrevoutHash()));
+    EXPECT_EQ(hex(*cache.sequenceHash), hex(transaction.getSequenceHash()));
+    EXPECT_EQ(hex(*cache.outputsHash), hex(transaction.getOutputsHash()));
+
+    cache.clear();
+    EXPECT_FALSE(cache.prevoutHash.has_value());
+
+    // primed up front, the three parts hashed as a batch
+    transaction.primeSigHashCache(cache, TWBitcoinSigHashTypeAll);
+    EXPECT_EQ(hex(*cache.prevoutHash), hex(transaction.getPrevoutHash()));
+    EXPECT_EQ(hex(*cache.sequenceHash), hex(transaction.getSequenceHash()));
+    EXPECT_EQ(hex(*cache.outputsHash), hex(transaction.getOutputsHash()));
+}
+
 } // namespace TW::Bitcoin
@@ -0,0 +1,70 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TestUtilities.h"
+#include "TxComparisonHelper.h"
+#include "HexCoding.h"
+#include "proto/Bitcoin.pb.h"
+
+#include <TrustWalletCore/TWBitcoinUtxoPool.h>
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin::TWUtxoPoolTests {
+
+const auto txHash = parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1f7fc8b8f4ab4d3c4fa4a6bb6");
+
+std::shared_ptr<TWData> utxoData(int64_t amount, uint32_t index) {
+    auto utxo = buildTestUTXO(amount);
+    utxo.outPoint = OutPoint(txHash, index, UINT32_MAX);
+    const auto serialized = utxo.proto().SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+TEST(TWBitcoinUtxoPool, AddSpendPlan) {
+    const auto pool = WRAP(TWBitcoinUtxoPool, TWBitcoinUtxoPoolCreate(TWCoinTypeBitcoin));
+    const std::vector<int64_t> amounts = {4000, 2000, 6000, 1000, 11000, 12000, 500};
+    for (auto i = 0ul; i < amounts.size(); ++i) {
+        EXPECT_TRUE(TWBitcoinUtxoPoolAdd(pool.get(), utxoData(amounts[i], static_cast<uint32_t>(i)).get()));
+    }
+    EXPECT_FALSE(TWBitcoinUtxoPoolAdd(pool.get(), DATA("0102").get()));
+    EXPECT_EQ(TWBitcoinUtxoPoolSize(pool.get()), 7ul);
+    EXPECT_EQ(TWBitcoinUtxoPoolAmount(pool.get()), 36500);
+    EXPECT_EQ(TWBitcoinUtxoPoolSpendableAmount(pool.get(), 10), 36000);
+
+    // the input carries no UTXOs
+    Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(5000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+    const auto inputData = input.SerializeAsString();
+    const auto inputTWData = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(inputData.data()), inputData.size()));
+
+    Proto::TransactionPlan plan;
+    auto planData = WRAPD(TWBitcoinUtxoPoolPlan(pool.get(), inputTWData.get()));
+    ASSERT_TRUE(plan.ParseFromArray(TWDataBytes(planData.get()), static_cast<int>(TWDataSize(planData.get()))));
+    EXPECT_EQ(plan.error(), Common::Proto::OK);
+    ASSERT_EQ(plan.utxos_size(), 1);
+    EXPECT_EQ(plan.utxos(0).amount(), 11000);
+    EXPECT_EQ(plan.amount(), 5000);
+    EXPECT_EQ(plan.fee(), 147);
+
+    const auto hashData = WRAPD(TWDataCreateWithBytes(txHash.data(), txHash.size()));
+    EXPECT_TRUE(TWBitcoinUtxoPoolSpend(pool.get(), hashData.get(), 4));
+    EXPECT_FALSE(TWBitcoinUtxoPoolSpend(pool.get(), hashData.get(), 4));
+    EXPECT_FALSE(TWBitcoinUtxoPoolSpend(pool.get(), DATA("0102").get(), 0));
+    EXPECT_EQ(TWBitcoinUtxoPoolSize(pool.get()), 6ul);
+
+    planData = WRAPD(TWBitcoinUtxoPoolPlan(pool.get(), inputTWData.get()));
+    ASSERT_TRUE(plan.ParseFromArray(TWDataBytes(planData.get()), static_cast<int>(TWDataSize(planData.get()))));
+    ASSERT_EQ(plan.utxos_size(), 1);
+    EXPECT_EQ(plan.utxos(0).amount(), 12000);
+}
+
+} // namespace TW::Bitcoin::TWUtxoPoolTests
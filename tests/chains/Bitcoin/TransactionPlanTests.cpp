@@ -159,6 +159,28 @@ TEST(TransactionPlan, TwoBoth) {
     EXPECT_TRUE(verifyPlan(txPlan, {20'000, 80'000}, 90'000, 215));
 }
 
+TEST(TransactionPlan, BranchAndBoundChangeless) {
+    auto utxos = buildTestUTXOs({6'000, 4'100, 3'000, 8'000, 2'500});
+    auto sigingInput = buildSigningInput(9'900, 1, utxos);
+    sigingInput.coinSelection = Proto::BranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // excess over the changeless fee (19) is less than the cost of a change output (102), it goes to the fee
+    EXPECT_TRUE(verifyPlan(txPlan, {4'100, 6'000}, 9'900, 200));
+    EXPECT_EQ(txPlan.change, 0);
+}
+
+TEST(TransactionPlan, BranchAndBoundWithChange) {
+    auto utxos = buildTestUTXOs({20'000, 80'000});
+    auto sigingInput = buildSigningInput(15'000, 1, utxos);
+    sigingInput.coinSelection = Proto::BranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    EXPECT_TRUE(verifyPlan(txPlan, {20'000}, 15'000, 147));
+}
+
 TEST(TransactionPlan, TwoFirstEnoughButSecond) {
     auto utxos = buildTestUTXOs({20'000, 22'000});
     auto sigingInput = buildSigningInput(18'000, 1, utxos);
@@ -687,4 +709,70 @@ TEST(TransactionPlan, OpReturn) {
     EXPECT_EQ(feeCalculator.calculate(1, 3, byteFee), 205 * byteFee);
 }
 
+
+namespace {
+
+UTXOs buildReplaceableUTXOs(const std::vector<int64_t>& amounts) {
+    const auto hash = parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1f7fc8b8f4ab4d3c4fa4a6bb6");
+    auto utxos = buildTestUTXOs(amounts);
+    for (auto i = 0ul; i < utxos.size(); ++i) {
+        utxos[i].outPoint = OutPoint(hash, static_cast<uint32_t>(i), UINT32_MAX - 2);
+    }
+    return utxos;
+}
+
+} // namespace
+
+TEST(TransactionPlan, BumpFeeFromChange) {
+    const auto utxos = buildReplaceableUTXOs({100'000});
+    const auto input = buildSigningInput(50'000, 1, utxos);
+    const auto previous = TransactionBuilder::plan(input);
+    ASSERT_TRUE(verifyPlan(previous, {100'000}, 50'000, 147));
+
+    const auto plan = TransactionBuilder::bumpFee(input, previous, 10);
+    EXPECT_EQ(plan.error, Common::Proto::OK);
+    EXPECT_TRUE(verifyPlan(plan, {100'000}, 50'000, 1'470));
+    EXPECT_EQ(plan.change, 48'530);
+
+    // a small increase still pays the incremental relay fee
+    const auto minimal = TransactionBuilder::bumpFee(input, previous, 1);
+    EXPECT_TRUE(verifyPlan(minimal, {100'000}, 50'000, 294));
+}
+
+TEST(TransactionPlan, BumpFeeAddsInput) {
+    const auto utxos = buildReplaceableUTXOs({60'000, 20'000, 30'000});
+    auto input = buildSigningInput(55'000, 1, {utxos[0]});
+    const auto previous = TransactionBuilder::plan(input);
+    ASSERT_TRUE(verifyPlan(previous, {60'000}, 55'000, 147));
+
+    UtxoPool pool;
+    pool.add(utxos);
+    const auto plan = TransactionBuilder::bumpFee(input, previous, 50, &pool);
+    EXPECT_EQ(plan.error, Common::Proto::OK);
+    // the largest UTXO not spent yet is added
+    EXPECT_TRUE(verifySelectedUTXOs(plan.utxos, {60'000, 30'000}));
+    EXPECT_EQ(plan.amount, 55'000);
+    EXPECT_EQ(plan.availableAmount, plan.amount + plan.change + plan.fee);
+    EXPECT_GT(plan.change, 0);
+
+    // the previous UTXOs can't cover it without the pool
+    const auto failed = TransactionBuilder::bumpFee(input, previous, 50);
+    EXPECT_EQ(failed.error, Common::Proto::Error_not_enough_utxos);
+}
+
+TEST(TransactionPlan, BumpFeeMaxAmount) {
+    const auto utxos = buildReplaceableUTXOs({100'000, 50'000});
+    const auto input = buildSigningInput(0, 1, utxos, true);
+    const auto previous = TransactionBuilder::plan(input);
+    ASSERT_EQ(previous.error, Common::Proto::OK);
+    EXPECT_EQ(previous.change, 0);
+
+    const auto plan = TransactionBuilder::bumpFee(input, previous, 10);
+    EXPECT_EQ(plan.error, Common::Proto::OK);
+    EXPECT_EQ(plan.utxos.size(), 2ul);
+    EXPECT_EQ(plan.change, 0);
+    EXPECT_GT(plan.fee, previous.fee);
+    EXPECT_EQ(plan.amount, previous.availableAmount - plan.fee);
+}
+
 } // namespace TW::Bitcoin
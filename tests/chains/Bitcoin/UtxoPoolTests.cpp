@@ -0,0 +1,99 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/UtxoPool.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin::UtxoPoolTests {
+
+const auto txHash = parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1f7fc8b8f4ab4d3c4fa4a6bb6");
+
+UTXOs buildPoolUTXOs(const std::vector<int64_t>& amounts) {
+    auto utxos = buildTestUTXOs(amounts);
+    for (auto i = 0ul; i < utxos.size(); ++i) {
+        utxos[i].outPoint = OutPoint(txHash, static_cast<uint32_t>(i), UINT32_MAX);
+    }
+    return utxos;
+}
+
+TEST(BitcoinUtxoPool, AddSpend) {
+    UtxoPool pool;
+    EXPECT_TRUE(pool.empty());
+    pool.add(buildPoolUTXOs({4000, 2000, 6000, 1000}));
+    EXPECT_EQ(pool.size(), 4ul);
+    EXPECT_EQ(pool.amount(), 13000);
+    EXPECT_TRUE(verifySelectedUTXOs(pool.utxos(), {1000, 2000, 4000, 6000}));
+
+    auto utxo = buildTestUTXO(3000);
+    utxo.outPoint = OutPoint(txHash, 10, UINT32_MAX);
+    pool.add(utxo);
+    EXPECT_TRUE(verifySelectedUTXOs(pool.utxos(), {1000, 2000, 3000, 4000, 6000}));
+
+    // same out-point replaces
+    utxo.amount = 7000;
+    pool.add(utxo);
+    EXPECT_TRUE(verifySelectedUTXOs(pool.utxos(), {1000, 2000, 4000, 6000, 7000}));
+    EXPECT_EQ(pool.amount(), 20000);
+
+    EXPECT_TRUE(pool.spend(OutPoint(txHash, 0)));
+    EXPECT_FALSE(pool.spend(OutPoint(txHash, 0)));
+    EXPECT_TRUE(verifySelectedUTXOs(pool.utxos(), {1000, 2000, 6000, 7000}));
+    EXPECT_EQ(pool.amount(), 16000);
+
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0ul);
+    EXPECT_EQ(pool.amount(), 0);
+}
+
+TEST(BitcoinUtxoPool, Dust) {
+    UtxoPool pool;
+    pool.add(buildPoolUTXOs({2000, 500, 50000, 1020, 1000}));
+
+    // single input fee at 10 sat/byte is 1020
+    EXPECT_EQ(pool.dustCount(10), 3ul);
+    EXPECT_EQ(pool.spendableAmount(10), 52000);
+    EXPECT_TRUE(verifySelectedUTXOs(pool.spendable(10), {2000, 50000}));
+    EXPECT_EQ(pool.dustCount(1), 0ul);
+    EXPECT_EQ(pool.spendableAmount(1), 54520);
+
+    // classification follows updates
+    EXPECT_TRUE(pool.spend(OutPoint(txHash, 1)));
+    EXPECT_EQ(pool.dustCount(10), 2ul);
+    EXPECT_EQ(pool.spendableAmount(10), 52000);
+}
+
+TEST(BitcoinUtxoPool, Plan) {
+    const auto utxos = buildPoolUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+    UtxoPool pool;
+    pool.add(utxos);
+
+    // same plan as with the UTXO list
+    for (const auto amount : {5000, 15000, 40000}) {
+        const auto expected = TransactionBuilder::plan(buildSigningInput(amount, 1, utxos));
+        const auto plan = TransactionBuilder::plan(buildSigningInput(amount, 1, {}), pool);
+        EXPECT_EQ(plan.amount, expected.amount);
+        EXPECT_EQ(plan.fee, expected.fee);
+        EXPECT_EQ(plan.change, expected.change);
+        EXPECT_EQ(plan.utxos.size(), expected.utxos.size());
+    }
+
+    auto plan = TransactionBuilder::plan(buildSigningInput(5000, 1, {}), pool);
+    EXPECT_TRUE(verifyPlan(plan, {11000}, 5000, 147));
+
+    EXPECT_TRUE(pool.spend(plan.utxos[0].outPoint));
+    plan = TransactionBuilder::plan(buildSigningInput(5000, 1, {}), pool);
+    EXPECT_TRUE(verifyPlan(plan, {12000}, 5000, 147));
+
+    pool.clear();
+    plan = TransactionBuilder::plan(buildSigningInput(5000, 1, {}), pool);
+    EXPECT_EQ(plan.error, Common::Proto::Error_missing_input_utxos);
+}
+
+} // namespace TW::Bitcoin::UtxoPoolTests
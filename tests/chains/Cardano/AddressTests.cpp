@@ -99,6 +99,21 @@ TEST(CardanoAddress, FromStringV2) {
     }
 }
 
+TEST(CardanoAddress, FromStringV2Repeated) {
+    // the second parse of a string is served from the cache of parsed addresses
+    const auto byron = "DdzFFzCqrht7HGoJ87gznLktJGywK1LbAJT2sbd4txmgS7FcYLMQFhawb18ojS9Hx55mrbsHPr7PTraKh14TSQbGBPJHbDZ9QVh6Z6Di";
+    const auto address1 = AddressV2(byron);
+    const auto address2 = AddressV2(byron);
+    EXPECT_EQ(address1, address2);
+    EXPECT_EQ(address2.string(), byron);
+    EXPECT_EQ(hex(address2.getCborData()), hex(address1.getCborData()));
+
+    for (auto i = 0; i < 2; ++i) {
+        EXPECT_FALSE(AddressV2::isValid("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvm"));
+        EXPECT_TRUE(AddressV2::isValid("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvx"));
+    }
+}
+
 TEST(CardanoAddress, FromStringV3_Base) {
     {
         auto address = AddressV3("addr1qxxe304qg9py8hyyqu8evfj4wln7dnms943wsugpdzzsxnkvvjljtzuwxvx0pnwelkcruy95ujkq3aw6rl0vvg32x35qc92xkq");
@@ -265,6 +280,29 @@ TEST(CardanoAddress, MnemonicToAddressV3) {
     }
 }
 
+TEST(CardanoAddress, DeriveAddressesV3) {
+    const auto mnemonic = "cost dash dress stove morning robust group affair stomach vacant route volume yellow salute laugh";
+    auto wallet = HDWallet(mnemonic, "");
+    const std::vector<std::string> expected = {
+        "addr1qxxe304qg9py8hyyqu8evfj4wln7dnms943wsugpdzzsxnkvvjljtzuwxvx0pnwelkcruy95ujkq3aw6rl0vvg32x35qc92xkq",
+        "addr1q9068st87h22h3l6w6t5evnlm067rag94llqya2hkjrsd3wvvjljtzuwxvx0pnwelkcruy95ujkq3aw6rl0vvg32x35qpmxzjt",
+        "addr1qxteqxsgxrs4he9d28lh70qu7qfz7saj6dmxwsqyle2yp3xvvjljtzuwxvx0pnwelkcruy95ujkq3aw6rl0vvg32x35quehtx3",
+    };
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypeCardano, TWDerivationDefault, 0, 0, 0, 3), expected);
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypeCardano, TWDerivationDefault, 0, 0, 1, 2, 2), std::vector<std::string>(expected.begin() + 1, expected.end()));
+
+    // the same addresses with the account node cached
+    wallet.enableNodeCache();
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypeCardano, TWDerivationDefault, 0, 0, 0, 3), expected);
+    EXPECT_EQ(wallet.deriveAddress(TWCoinTypeCardano), expected[0]);
+    EXPECT_EQ(AddressV3(wallet.getKey(TWCoinTypeCardano, DerivationPath("m/1852'/1815'/0'/0/2")).getPublicKey(TWPublicKeyTypeED25519Cardano)).string(), expected[2]);
+
+    // change level 1 shares the staking key
+    const auto internal = wallet.deriveAddresses(TWCoinTypeCardano, TWDerivationDefault, 0, 1, 0, 1);
+    EXPECT_EQ(internal[0], AddressV3(wallet.getKey(TWCoinTypeCardano, DerivationPath("m/1852'/1815'/0'/1/0")).getPublicKey(TWPublicKeyTypeED25519Cardano)).string());
+    EXPECT_EQ(internal[0].substr(internal[0].size() - 50, 44), expected[0].substr(expected[0].size() - 50, 44));
+}
+
 TEST(CardanoAddress, KeyHashV2) {
     auto xpub = parse_hex("e6f04522f875c1563682ca876ddb04c2e2e3ae718e3ff9f11c03dd9f9dccf69869272d81c376382b8a87c21370a7ae9618df8da708d1a9490939ec54ebe43000");
     auto hash = AddressV2::keyHash(xpub);
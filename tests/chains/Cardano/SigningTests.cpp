@@ -17,6 +17,7 @@
 #include <TrustWalletCore/TWAnySigner.h>
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <vector>
 
 using namespace TW;
@@ -324,6 +325,21 @@ TEST(CardanoSigning, PlanMissingPrivateKey) {
     EXPECT_EQ(plan.error, Common::Proto::OK);
 }
 
+TEST(CardanoSigning, PlanFeeMatchesEncodedSize) {
+    // fee is estimated without signing; it has to match the size of the transaction encoded for size estimation
+    for (const auto missingPrivateKey : {false, true}) {
+        const auto input = createSampleInput(7000000, 10, "", missingPrivateKey);
+        const auto plan = Signer(input).doPlan();
+        ASSERT_EQ(plan.error, Common::Proto::OK);
+
+        Data encoded;
+        Data txId;
+        ASSERT_EQ(Signer::encodeTransaction(encoded, txId, input, plan, true), Common::Proto::OK);
+        const auto expectedFee = static_cast<Amount>(std::ceil(155381 + 500 + static_cast<double>(encoded.size()) * (43.946 + 0.1)));
+        EXPECT_EQ(plan.fee, expectedFee);
+    }
+}
+
 TEST(CardanoSigning, SignTransfer1) {
     const auto input = createSampleInput(7000000);
 
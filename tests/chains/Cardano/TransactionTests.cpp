@@ -47,6 +47,56 @@ TEST(CardanoTransaction, Encode) {
     }
 }
 
+TEST(CardanoTransaction, TokenBundleMerge) {
+    const auto policyId1 = "012345678901234567890POLICY1";
+    const auto policyId2 = "012345678901234567890POLICY2";
+    auto available = TokenBundle({
+        TokenAmount(policyId2, "TOK2", 20),
+        TokenAmount(policyId1, "TOK1", 10),
+    });
+    available.add(TokenBundle({
+        TokenAmount(policyId2, "TOK3", 30),
+        TokenAmount(policyId1, "TOK1", 5),
+    }));
+    ASSERT_EQ(available.size(), 3ul);
+    std::vector<std::string> keys;
+    for (const auto& token : available) {
+        keys.emplace_back(token.key());
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"012345678901234567890POLICY1_TOK1", "012345678901234567890POLICY2_TOK2", "012345678901234567890POLICY2_TOK3"}));
+    EXPECT_EQ(available.getAmount(policyId1, "TOK1"), 15);
+    EXPECT_EQ(available.getAmount("012345678901234567890POLICY2_TOK3"), 30);
+    EXPECT_EQ(available.getAmount(policyId1, "TOK2"), 0);
+    EXPECT_EQ(available.getAmount("TOK1"), 0);
+
+    const auto output = TokenBundle({
+        TokenAmount(policyId2, "TOK2", 20),
+        TokenAmount(policyId1, "TOK1", 5),
+        TokenAmount(policyId1, "TOK9", 5),
+    });
+    const auto change = available.subtract(output);
+    ASSERT_EQ(change.size(), 2ul);
+    EXPECT_EQ(change.getAmount(policyId1, "TOK1"), 10);
+    EXPECT_EQ(change.getAmount(policyId2, "TOK3"), 30);
+    EXPECT_EQ(available.subtract(output, true).size(), 3ul);
+    EXPECT_EQ(output.subtract(available).getAmount(policyId1, "TOK9"), 5);
+}
+
+TEST(CardanoTransaction, OutputEncodedSize) {
+    const auto address = AddressV3("addr1q8043m5heeaydnvtmmkyuhe6qv5havvhsf0d26q3jygsspxlyfpyk6yqkw0yhtyvtr0flekj84u64az82cufmqn65zdsylzk23").data();
+    auto tokens = TokenBundle();
+    for (auto i = 0; i < 30; ++i) {
+        tokens.add(TokenAmount("9a9693a9a37912a5097918f97918d15240c92ab729a0b7c4aa1" + std::to_string(44000 + i % 3), "ASSET" + std::to_string(i), uint256_t(1) << (i * 2)));
+    }
+    for (const auto& output : {TxOutput(address, 2000000), TxOutput(address, 17, tokens), TxOutput(address, 5000000000, tokens)}) {
+        Transaction tx = createTx();
+        tx.outputs.clear();
+        const auto emptySize = tx.encode().size();
+        tx.outputs.push_back(output);
+        EXPECT_EQ(output.encodedSize(), tx.encode().size() - emptySize);
+    }
+}
+
 TEST(CardanoTransaction, GetId) {
     const Transaction tx = createTx();
 
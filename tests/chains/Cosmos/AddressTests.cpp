@@ -68,6 +68,17 @@ TEST(CosmosAddress, ThorFromPublicKey) {
     ASSERT_EQ(hex(address.getKeyHash()), "1522e767db6eb19708b0038029bfbd607bc9bd0e");
 }
 
+TEST(CosmosAddress, StringsForCoins) {
+    const auto publicKey = PrivateKey(parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005")).getPublicKey(TWPublicKeyTypeSECP256k1);
+    const std::vector<TWCoinType> coins = {TWCoinTypeCosmos, TWCoinTypeOsmosis, TWCoinTypeNativeEvmos, TWCoinTypeJuno, TWCoinTypeTHORChain, TWCoinTypeNativeInjective};
+    const auto addresses = Address::strings(publicKey, coins);
+    ASSERT_EQ(addresses.size(), coins.size());
+    EXPECT_EQ(addresses[0], "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    for (size_t i = 0; i < coins.size(); ++i) {
+        EXPECT_EQ(addresses[i], Address(coins[i], publicKey).string()) << "coin " << coins[i];
+    }
+}
+
 TEST(CosmosAddress, ThorValid) {
     ASSERT_TRUE(Address::isValid(TWCoinTypeTHORChain, "thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2r"));
     ASSERT_FALSE(Address::isValid(TWCoinTypeTHORChain, "thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2s"));
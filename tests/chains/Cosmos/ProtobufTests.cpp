@@ -8,7 +8,9 @@
 #include "Cosmos/Address.h"
 #include "Cosmos/Protobuf/authz_tx.pb.h"
 #include "Cosmos/Protobuf/bank_tx.pb.h"
+#include "Cosmos/Protobuf/crypto_secp256k1_keys.pb.h"
 #include "Cosmos/Protobuf/tx.pb.h"
+#include "Cosmos/ProtobufSerialization.h"
 #include "Data.h"
 #include "HexCoding.h"
 
@@ -64,4 +66,54 @@ TEST(CosmosProtobuf, DeterministicSerialization_Article) {
     EXPECT_EQ(hex(serialized), "0a1b54686520776f726c64206e65656473206368616e676520f09f8cb318e8bebec8bc2e280138024a084e696365206f6e654a095468616e6b20796f75");
 }
 
+TEST(CosmosProtobuf, AuthInfoBuilder) {
+    const auto publicKey = parse_hex("02ecef5ce437a302c67f95468de4b31f36e911f467d7e6a52b41c1e13e1d563649");
+    auto fee = Proto::Fee();
+    fee.set_gas(200000);
+    auto* amount = fee.add_amounts();
+    amount->set_denom("muon");
+    amount->set_amount("200");
+
+    const auto builder = Protobuf::AuthInfoBuilder(publicKey, fee, TWCoinTypeCosmos);
+    for (uint64_t sequence : {0ull, 1ull, 127ull, 128ull, 300ull, 1ull << 40}) {
+        auto authInfo = cosmos::AuthInfo();
+        auto* signerInfo = authInfo.add_signer_infos();
+        auto pubKey = cosmos::crypto::secp256k1::PubKey();
+        pubKey.set_key(publicKey.data(), publicKey.size());
+        signerInfo->mutable_public_key()->PackFrom(pubKey, "");
+        signerInfo->mutable_mode_info()->mutable_single()->set_mode(cosmos::signing::v1beta1::SIGN_MODE_DIRECT);
+        signerInfo->set_sequence(sequence);
+        auto* authFee = authInfo.mutable_fee();
+        authFee->add_amount()->set_denom("muon");
+        authFee->mutable_amount(0)->set_amount("200");
+        authFee->set_gas_limit(200000);
+
+        EXPECT_EQ(hex(builder.build(sequence)), hex(authInfo.SerializeAsString())) << sequence;
+    }
+}
+
+TEST(CosmosProtobuf, SignDocAndTxRaw) {
+    const std::string body = "body";
+    const auto authInfo = std::string(200, 'a');
+    const auto signature = parse_hex("0102");
+
+    auto signDoc = cosmos::SignDoc();
+    signDoc.set_body_bytes(body);
+    signDoc.set_auth_info_bytes(authInfo);
+    signDoc.set_chain_id("cosmoshub-4");
+    signDoc.set_account_number(546179);
+    EXPECT_EQ(hex(Protobuf::buildSignDoc(body, authInfo, "cosmoshub-4", 546179)), hex(signDoc.SerializeAsString()));
+
+    // empty fields are omitted
+    auto partialSignDoc = cosmos::SignDoc();
+    partialSignDoc.set_auth_info_bytes(authInfo);
+    EXPECT_EQ(hex(Protobuf::buildSignDoc("", authInfo, "", 0)), hex(partialSignDoc.SerializeAsString()));
+
+    auto txRaw = cosmos::TxRaw();
+    txRaw.set_body_bytes(body);
+    txRaw.set_auth_info_bytes(authInfo);
+    *txRaw.add_signatures() = std::string(signature.begin(), signature.end());
+    EXPECT_EQ(hex(Protobuf::buildProtoTxRaw(body, authInfo, signature)), hex(txRaw.SerializeAsString()));
+}
+
 } // namespace TW::Cosmos::tests
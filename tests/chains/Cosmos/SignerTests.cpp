@@ -9,9 +9,12 @@
 #include "Base64.h"
 #include "proto/Cosmos.pb.h"
 #include "Cosmos/Address.h"
+#include "Cosmos/JsonSerialization.h"
+#include "Cosmos/ProtobufSerialization.h"
 #include "Cosmos/Signer.h"
 #include "TestUtilities.h"
 #include "Cosmos/Protobuf/bank_tx.pb.h"
+#include "uint256.h"
 
 #include <gtest/gtest.h>
 #include <google/protobuf/util/json_util.h>
@@ -87,6 +90,80 @@ TEST(CosmosSigner, SignProtobuf_ErrorMissingMessage) {
     EXPECT_EQ(hex(output.signature()), "");
 }
 
+TEST(CosmosSigner, PlanProtobuf) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::Protobuf);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_sequence(8);
+
+    auto& send = *input.add_messages()->mutable_send_coins_message();
+    send.set_from_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    send.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+    auto amountOfTx = send.add_amounts();
+    amountOfTx->set_denom("muon");
+    amountOfTx->set_amount("1");
+
+    auto& stake = *input.add_messages()->mutable_stake_message();
+    stake.set_delegator_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    stake.set_validator_address("cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp");
+    auto amountOfStake = stake.mutable_amount();
+    amountOfStake->set_denom("muon");
+    amountOfStake->set_amount("10");
+
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    auto amountOfFee = fee.add_amounts();
+    amountOfFee->set_denom("muon");
+    amountOfFee->set_amount("200");
+
+    // no private key needed
+    const auto plan = Signer::plan(input, TWCoinTypeCosmos);
+    EXPECT_EQ(plan.error(), "");
+    ASSERT_EQ(plan.message_gas_size(), 2);
+    EXPECT_EQ(plan.message_gas(0), 50000ul);
+    EXPECT_EQ(plan.message_gas(1), 150000ul);
+    EXPECT_EQ(plan.gas(), plan.tx_size() * 10 + 1000 + 50000 + 150000);
+
+    auto privateKey = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(privateKey.data(), privateKey.size());
+    const auto txRaw = Protobuf::buildProtoTxRaw(Protobuf::buildProtoTxBody(input), Protobuf::buildAuthInfo(input, TWCoinTypeCosmos), Data(64));
+    EXPECT_EQ(plan.tx_size(), txRaw.size());
+}
+
+TEST(CosmosSigner, PlanSignDirect) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::Protobuf);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+
+    auto& message = *input.add_messages()->mutable_sign_direct_message();
+    const auto bodyBytes = parse_hex("0a89010a1c2f636f736d6f732e62616e6b2e763162657461312e4d736753656e6412690a2d636f736d6f733168736b366a727979716a6668703564686335357463396a74636b796778306570683664643032122d636f736d6f73317a743530617a7570616e716c66616d356166687633686578777975746e756b656834633537331a090a046d756f6e120131");
+    message.set_body_bytes(bodyBytes.data(), bodyBytes.size());
+    const auto authInfoBytes = parse_hex("0a500a460a1f2f636f736d6f732e63727970746f2e736563703235366b312e5075624b657912230a210257286ec3f37d33557bbbaa000b27744ac9023aa9967cae75a181d1ff91fa9dc512040a020801180812110a0b0a046d756f6e120332303010c09a0c");
+    message.set_auth_info_bytes(authInfoBytes.data(), authInfoBytes.size());
+
+    const auto plan = Signer::plan(input, TWCoinTypeCosmos);
+    EXPECT_EQ(plan.error(), "");
+    // size of the tx_bytes of SignDirect1
+    EXPECT_EQ(plan.tx_size(), 312ul);
+    ASSERT_EQ(plan.message_gas_size(), 1);
+    EXPECT_EQ(plan.gas(), 312ul * 10 + 1000 + plan.message_gas(0));
+}
+
+TEST(CosmosSigner, PlanErrors) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::Protobuf);
+    auto plan = Signer::plan(input, TWCoinTypeCosmos);
+    EXPECT_EQ(plan.error(), "Error: No message found");
+    EXPECT_EQ(plan.tx_size(), 0ul);
+    EXPECT_EQ(plan.gas(), 0ul);
+
+    input.set_signing_mode(Proto::JSON);
+    plan = Signer::plan(input, TWCoinTypeCosmos);
+    EXPECT_EQ(plan.error(), "Error: plan is only supported in Protobuf signing mode");
+}
+
 TEST(CosmosSigner, SignTxJson) {
     auto input = Proto::SigningInput();
     input.set_signing_mode(Proto::JSON); // obsolete
@@ -322,4 +399,104 @@ TEST(CosmosSigner, MsgVote) {
     assertJSONEqual(output.serialized(), expected);
 }
 
+TEST(CosmosSigner, SignaturePreimageMatchesJsonTree) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::JSON);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_memo("quote \" backslash \\ newline \n tab \t bell \x07 unicode \xc3\xa9");
+    input.set_sequence(8);
+
+    const auto addCoin = [](auto* amount, const char* denom, const char* value) {
+        amount->set_denom(denom);
+        amount->set_amount(value);
+    };
+
+    auto& send = *input.add_messages()->mutable_send_coins_message();
+    send.set_from_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    send.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+    addCoin(send.add_amounts(), "muon", "1");
+    addCoin(send.add_amounts(), "atom", "2");
+
+    auto& stake = *input.add_messages()->mutable_stake_message();
+    stake.set_delegator_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    stake.set_validator_address("cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp");
+    addCoin(stake.mutable_amount(), "muon", "10");
+
+    auto& unstake = *input.add_messages()->mutable_unstake_message();
+    unstake.set_delegator_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    unstake.set_validator_address("cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp");
+    addCoin(unstake.mutable_amount(), "muon", "5");
+    unstake.set_type_prefix("custom/MsgUndelegate");
+
+    auto& withdraw = *input.add_messages()->mutable_withdraw_stake_reward_message();
+    withdraw.set_delegator_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    withdraw.set_validator_address("cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp");
+
+    auto& restake = *input.add_messages()->mutable_restake_message();
+    restake.set_delegator_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    restake.set_validator_src_address("cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp");
+    restake.set_validator_dst_address("cosmosvaloper1sxx9mszve0gaedz5ld7qdkjkfv8z992ax69k08");
+    addCoin(restake.mutable_amount(), "muon", "7");
+
+    auto& raw = *input.add_messages()->mutable_raw_json_message();
+    raw.set_type("custom/MsgRaw");
+    raw.set_value(R"({"z": [1, 2], "a": {"y": "x", "b": null}})");
+
+    auto& wasm = *input.add_messages()->mutable_wasm_terra_execute_contract_transfer_message();
+    wasm.set_sender_address("terra1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    wasm.set_contract_address("terra14z56l0fp2lsf86zy3hty2z47ezkhnthtr9yq76");
+    wasm.set_recipient_address("terra1jlgaqy9nvn2hf5t2sra9ycz8s77wnf9l0kmgcp");
+    const auto amount = store(uint256_t(250000));
+    wasm.set_amount(amount.data(), amount.size());
+
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    addCoin(fee.add_amounts(), "muon", "200");
+
+    EXPECT_EQ(Json::signaturePreimage(input), Json::signaturePreimageJSON(input).dump());
+
+    // every message type on its own
+    for (const auto& message : input.messages()) {
+        auto single = input;
+        single.clear_messages();
+        *single.add_messages() = message;
+        EXPECT_EQ(Json::signaturePreimage(single), Json::signaturePreimageJSON(single).dump());
+    }
+}
+
+TEST(CosmosSigner, SignaturePreimageRejectsInvalidUtf8) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::JSON);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_sequence(8);
+    auto& send = *input.add_messages()->mutable_send_coins_message();
+    send.set_from_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    send.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+
+    input.set_memo("\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf");
+    EXPECT_EQ(Json::signaturePreimage(input), Json::signaturePreimageJSON(input).dump());
+
+    // invalid byte, truncated sequence, overlong encoding, surrogate, above U+10FFFF
+    for (const auto* invalid : {"\xff", "a\xc3", "\xc0\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80"}) {
+        auto memo = input;
+        memo.set_memo(invalid);
+        EXPECT_THROW(Json::signaturePreimageJSON(memo).dump(), nlohmann::json::type_error);
+        EXPECT_THROW(Json::signaturePreimage(memo), std::invalid_argument);
+
+        auto field = input;
+        field.mutable_messages(0)->mutable_send_coins_message()->set_to_address(invalid);
+        EXPECT_THROW(Json::signaturePreimageJSON(field).dump(), nlohmann::json::type_error);
+        EXPECT_THROW(Json::signaturePreimage(field), std::invalid_argument);
+    }
+
+    auto privateKey = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_memo("\xff");
+    const auto output = Signer::sign(input, TWCoinTypeCosmos);
+    EXPECT_EQ(output.error(), "Error: Invalid UTF-8 in JSON string");
+    EXPECT_TRUE(output.json().empty());
+}
+
 } // namespace TW::Cosmos::tests
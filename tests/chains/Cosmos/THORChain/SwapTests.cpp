@@ -12,6 +12,7 @@
 #include "Ethereum/ABI/ParamBase.h"
 #include "Ethereum/Address.h"
 #include "THORChain/Swap.h"
+#include "THORChain/SwapCache.h"
 #include "proto/Binance.pb.h"
 #include "proto/Bitcoin.pb.h"
 #include "proto/Cosmos.pb.h"
@@ -1067,6 +1068,75 @@ TEST(THORChainSwap, Memo) {
     EXPECT_EQ(builder.to(toAssetBNB).buildMemo(), "=:BNB.TWT-8C2:bnb123:1234");
 }
 
+TEST(THORChainSwap, CachedBuild) {
+    Proto::Asset fromAsset;
+    fromAsset.set_token_id("0xB97EF9Ef8734C71904D8002F8b6Bc66Dd9c48a6E");
+    fromAsset.set_chain(static_cast<Proto::Chain>(Chain::AVAX));
+    Proto::Asset toAsset;
+    toAsset.set_chain(static_cast<Proto::Chain>(Chain::THOR));
+    toAsset.set_symbol("RUNE");
+    auto builder = SwapBuilder::builder()
+                       .from(fromAsset)
+                       .to(toAsset)
+                       .fromAddress("0xbe6523017422A983B900b614Baeac51Ef7C1d0A3")
+                       .toAddress("thor1ad6hapypumu7su5ad9qry2d74yt9d56fssa774")
+                       .vault("0xa56f6Cb1D66cd80150b1ea79643b4C5900D6E36E")
+                       .router("0x8f66c4ae756bebc49ec8b81966dd8bba9f127549")
+                       .toAmountLimit("51638857")
+                       .expirationPolicy(1775669796)
+                       .affFeeAddress("t")
+                       .affFeeRate("0");
+    auto cache = std::make_shared<SwapCache>();
+    auto cached = builder;
+    cached.cache(cache);
+
+    // re-quoted amounts give the same output as uncached builds
+    for (const auto* amount : {"1000000", "2000000", "1000000"}) {
+        const auto expected = builder.fromAmount(amount).build();
+        const auto result = cached.fromAmount(amount).build();
+        ASSERT_EQ(result.status_code, 0);
+        EXPECT_EQ(hex(result.out), hex(expected.out));
+    }
+    ASSERT_TRUE(cache->routerCall.has_value());
+    EXPECT_EQ(hex(cache->routerCall->head), "44bc937b000000000000000000000000a56f6cb1d66cd80150b1ea79643b4c5900d6e36e000000000000000000000000b97ef9ef8734c71904d8002f8b6bc66dd9c48a6e");
+    ASSERT_TRUE(cache->memoPrefix.has_value());
+    EXPECT_EQ(cache->memoPrefix->prefix, "=:THOR.RUNE:thor1ad6hapypumu7su5ad9qry2d74yt9d56fssa774");
+    ASSERT_TRUE(cache->lastBuild.has_value());
+
+    // a changed destination rebuilds the memo prefix
+    const auto expected = builder.toAddress(Address1Thor).build();
+    const auto result = cached.toAddress(Address1Thor).build();
+    EXPECT_EQ(hex(result.out), hex(expected.out));
+    EXPECT_EQ(cache->memoPrefix->prefix, "=:THOR.RUNE:thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2r");
+
+    // the same cache serves a Bitcoin swap
+    Proto::Asset btcAsset;
+    btcAsset.set_chain(static_cast<Proto::Chain>(Chain::BTC));
+    Proto::Asset ethAsset;
+    ethAsset.set_chain(static_cast<Proto::Chain>(Chain::ETH));
+    ethAsset.set_symbol("ETH");
+    auto btcBuilder = SwapBuilder::builder()
+                          .from(btcAsset)
+                          .to(ethAsset)
+                          .fromAddress(Address1Btc)
+                          .toAddress(Address1Eth)
+                          .vault(VaultBtc)
+                          .toAmountLimit("140000000000000000");
+    auto btcCached = btcBuilder;
+    btcCached.cache(cache);
+    for (const auto* amount : {"1000000", "1500000"}) {
+        const auto btcExpected = btcBuilder.fromAmount(amount).build();
+        const auto btcResult = btcCached.fromAmount(amount).build();
+        ASSERT_EQ(btcResult.status_code, 0);
+        EXPECT_EQ(hex(btcResult.out), hex(btcExpected.out));
+    }
+    ASSERT_TRUE(cache->bitcoinInput.has_value());
+    EXPECT_EQ(cache->bitcoinInput->input.change_address(), Address1Btc);
+
+    // invalid addresses are still reported
+    EXPECT_EQ(btcCached.fromAddress("bc1q").build().status_code, static_cast<int>(Proto::ErrorCode::Error_Invalid_from_address));
+}
+
 TEST(THORChainSwap, WrongFromAddress) {
     Proto::Asset fromAsset;
     fromAsset.set_chain(static_cast<Proto::Chain>(Chain::BNB));
@@ -429,6 +429,41 @@ TEST(DecredSigning, SignP2WPKH_NegativeAddressWrongType) {
 
     ASSERT_FALSE(result) << std::to_string(result.error());
 }
+
+TEST(DecredTransaction, SignatureHashCache) {
+    auto transaction = Transaction();
+    transaction.lockTime = 7;
+    transaction.expiry = 9;
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto txIn = TransactionInput();
+        txIn.previousOutput = OutPoint(std::array<byte, 32>{byte(i + 1)}, i, 0);
+        txIn.sequence = 100 + i;
+        txIn.script = Bitcoin::Script(Data{OP_1, byte(i)});
+        transaction.inputs.push_back(txIn);
+
+        auto txOut = TransactionOutput();
+        txOut.value = 1000 * (i + 1);
+        txOut.version = static_cast<uint16_t>(i);
+        txOut.script = Bitcoin::Script(Data{OP_DUP, byte(i)});
+        transaction.outputs.push_back(txOut);
+    }
+    const auto script = Bitcoin::Script(parse_hex("76a914000102030405060708090a0b0c0d0e0f1011121388ac"));
+
+    EXPECT_EQ(hex(transaction.computeSignatureHash(script, 0, TWBitcoinSigHashTypeAll)), "5bb5e593c9b75b7a400f4e28a5c609bac99e8939b04ddcb52030fed41cf804da");
+    EXPECT_EQ(hex(transaction.computeSignatureHash(script, 1, TWBitcoinSigHashTypeSingle)), "62e008870becdecbfa925c74c033f06894e579e0f1f508d63c24906479a4cb8a");
+    EXPECT_EQ(hex(transaction.computeSignatureHash(script, 2, TWBitcoinSigHashType(TWBitcoinSigHashTypeNone | TWBitcoinSigHashTypeAnyoneCanPay))), "8a7ed7b953353687c07a8ea218b5dee3b6173d8d021422c75e5c443688f32040");
+
+    // The cached prefix is only used by the hash types that don't depend on the input
+    Bitcoin::SigHashCache cache;
+    for (auto hashType : {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeNone, TWBitcoinSigHashTypeSingle,
+                          TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)}) {
+        for (auto index = 0ul; index < transaction.inputs.size(); ++index) {
+            EXPECT_EQ(hex(transaction.computeSignatureHash(script, index, hashType, &cache)),
+                      hex(transaction.computeSignatureHash(script, index, hashType)));
+        }
+    }
+    EXPECT_TRUE(cache.prefixHash.has_value());
+}
 // clang-format on
 
 } // namespace TW::Decred::tests
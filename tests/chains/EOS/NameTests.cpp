@@ -28,6 +28,21 @@ TEST(EOSName, Valid) {
     Data buf;
     Name(validName).serialize(buf);
     ASSERT_EQ(hex(buf), "458608d8354cb3c1");
+
+    EXPECT_EQ(Name("eosio.token").string(), "eosio.token");
+    EXPECT_EQ(Name("").string(), "");
+    EXPECT_EQ(Name("zzzzzzzzzzzzj").value, 0xffffffffffffffffull);
+}
+
+TEST(EOSName, Symbols) {
+    EXPECT_EQ(Name::toSymbol('.'), 0ul);
+    EXPECT_EQ(Name::toSymbol('1'), 1ul);
+    EXPECT_EQ(Name::toSymbol('5'), 5ul);
+    EXPECT_EQ(Name::toSymbol('a'), 6ul);
+    EXPECT_EQ(Name::toSymbol('z'), 31ul);
+    EXPECT_EQ(Name::toSymbol('0'), 0ul);
+    EXPECT_EQ(Name::toSymbol('A'), 0ul);
+    EXPECT_EQ(Name::toSymbol('\xff'), 0ul);
 }
 
 } // namespace TW::EOS::tests
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "EOS/Signer.h"
 #include "EOS/Action.h"
 #include "EOS/Address.h"
+#include "EOS/PackedTransaction.h"
 #include "PrivateKey.h"
 #include "HexCoding.h"
 #include "Hash.h"
@@ -46,6 +47,7 @@ TEST(EOSTransaction, Serialization) {
 
     Data buf;
     tx.serialize(buf);
+    EXPECT_EQ(buf.size(), tx.serializedSize());
 
     Signer signer {chainId};
 
@@ -104,6 +106,13 @@ TEST(EOSTransaction, Serialization) {
             r1Sigs[i]
         );
     }
+
+    tx2.contextFreeData = parse_hex("0102");
+    const PackedTransaction packed {tx2};
+    buf.clear();
+    packed.serialize(buf);
+    EXPECT_EQ(buf.size(), packed.serializedSize());
+    EXPECT_EQ(hex(packed.packedCFD), "01020102");
 }
 
 TEST(EOSTransaction, formatDate) {
@@ -8,6 +8,7 @@
 #include "Ethereum/Address.h"
 #include "Ethereum/Signer.h"
 #include "TestUtilities.h"
+#include <Hash.h>
 #include <HexCoding.h>
 #include <PrivateKey.h>
 
@@ -486,6 +487,86 @@ TEST(EthereumAbiStruct, hashStructJson) {
     }
 }
 
+TEST(EthereumAbiStruct, TypedDataDomain) {
+    const auto mail = TypedDataDomain(R"({
+        "types": {
+            "EIP712Domain": [
+                {"name": "name", "type": "string"},
+                {"name": "version", "type": "string"},
+                {"name": "chainId", "type": "uint256"},
+                {"name": "verifyingContract", "type": "address"}
+            ],
+            "Person": [
+                {"name": "name", "type": "string"},
+                {"name": "wallet", "type": "address"}
+            ],
+            "Mail": [
+                {"name": "from", "type": "Person"},
+                {"name": "to", "type": "Person"},
+                {"name": "contents", "type": "string"}
+            ]
+        },
+        "primaryType": "Mail",
+        "domain": {
+            "name": "Ether Mail",
+            "version": "1",
+            "chainId": 1,
+            "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"
+        }
+    })");
+    EXPECT_EQ(mail.primaryType(), "Mail");
+    EXPECT_EQ(mail.chainId(), 1ul);
+    EXPECT_EQ(hex(mail.domainSeparator()), "f2cee375fa42b42143804025fc449deafd50cc031ca257e0b194a650a912090f");
+    EXPECT_EQ(hex(mail.typeHash()), "a0cedeb2dc280ba39b857546d74f5549c3a1d7bdc2dd96bf881f76108e23dac2");
+
+    const std::vector<std::string> messages(100, R"({
+        "from": {"name": "Cow", "wallet": "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+        "to": {"name": "Bob", "wallet": "bBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+        "contents": "Hello, Bob!"
+    })");
+    EXPECT_EQ(hex(mail.hashMessageJson(messages.front())), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+    const auto hashes = mail.hashMessagesJson(messages, 4);
+    ASSERT_EQ(hashes.size(), messages.size());
+    for (const auto& hash : hashes) {
+        EXPECT_EQ(hex(hash), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+    }
+
+    EXPECT_EXCEPTION(mail.hashMessageJson("NOT_A_JSON"), "Could not parse value Json");
+    EXPECT_EXCEPTION(mail.hashMessageJson("[]"), "Expecting object");
+    EXPECT_EXCEPTION(mail.hashMessageEncoded(Data(64)), "Expecting 3 encoded members of Mail");
+    EXPECT_EXCEPTION(TypedDataDomain(R"({"primaryType": "Mail", "domain": {}, "types": {}})"), "Type not found, Mail");
+}
+
+TEST(EthereumAbiStruct, TypedDataDomainEncoded) {
+    const auto person = TypedDataDomain(R"({
+        "types": {
+            "EIP712Domain": [
+                {"name": "name", "type": "string"},
+                {"name": "version", "type": "string"},
+                {"name": "chainId", "type": "uint256"},
+                {"name": "verifyingContract", "type": "address"}
+            ],
+            "Person": [
+                {"name": "name", "type": "string"},
+                {"name": "wallet", "type": "address"}
+            ]
+        },
+        "primaryType": "Person",
+        "domain": {
+            "name": "Ether Person",
+            "version": "1",
+            "chainId": 1,
+            "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"
+        }
+    })");
+    EXPECT_EQ(hex(person.typeHash()), "b9d8c78acf9b987311de6c7b45bb6a9c8e1bf361fa7fd3467a2163f994c79500");
+
+    // keccak256("Cow"), and the address padded to 32 bytes
+    const auto encoded = parse_hex("8c1d2bd5348394761719da11ec67eedae9502d137e8940fee8ecd6f641ee1648000000000000000000000000cd2a3d9f938e13cd947ec05abc7fe734df8dd826");
+    EXPECT_EQ(hex(person.hashMessageEncoded(encoded)), "0b4bb85394b9ebb1c2425e283c9e734a9a7a832622e97c998f77e1c7a3f01a20");
+    EXPECT_EQ(person.hashMessagesEncoded(std::vector<Data>{encoded, encoded}), person.hashMessagesJson(std::vector<std::string>(2, R"({"name": "Cow", "wallet": "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"})")));
+}
+
 TEST(EthereumAbiStruct, hashStruct_emptyString) {
     auto path = TESTS_ROOT + "/chains/Ethereum/Data/eip712_emptyString.json";
     auto typeData = load_file(path);
@@ -674,6 +755,36 @@ TEST(EthereumAbiStruct, ParamStructMakeStruct) {
     }
 }
 
+TEST(EthereumAbiStruct, ParamStructMakeStructTypeHash) {
+    const auto types = R"({"Person": [{"name": "name", "type": "string"}, {"name": "wallet", "type": "address"}],"Mail": [{"name": "from", "type": "Person"},{"name": "to", "type": "Person[]"},{"name": "contents", "type": "string"}]})";
+    {
+        std::shared_ptr<ParamStruct> s = ParamStruct::makeStruct("Mail",
+            R"({"from": {"name": "Cow", "wallet": "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"}, "to": [{"name": "Bob", "wallet": "bBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"}, {"name": "Alice", "wallet": "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"}], "contents": "Hello!"})",
+            types);
+        ASSERT_NE(s.get(), nullptr);
+        EXPECT_EQ(s->encodeType(), "Mail(Person from,Person[] to,string contents)Person(string name,address wallet)");
+        EXPECT_EQ(hex(s->hashType()), hex(Hash::keccak256(s->encodeType())));
+        // memoized
+        EXPECT_EQ(hex(s->hashType()), hex(Hash::keccak256(s->encodeType())));
+
+        const auto from = std::dynamic_pointer_cast<ParamStruct>(s->findParamByName("from")->getParam());
+        const auto to = std::dynamic_pointer_cast<ParamArray>(s->findParamByName("to")->getParam());
+        ASSERT_NE(from.get(), nullptr);
+        ASSERT_NE(to.get(), nullptr);
+        EXPECT_EQ(hex(from->hashType()), hex(Hash::keccak256(std::string("Person(string name,address wallet)"))));
+        for (const auto& person : to->getVal()) {
+            EXPECT_EQ(hex(std::dynamic_pointer_cast<ParamStruct>(person)->hashType()), hex(from->hashType()));
+        }
+    }
+    { // missing sub-struct, the full type differs and is not shared
+        std::shared_ptr<ParamStruct> s = ParamStruct::makeStruct("Mail",
+            R"({"to": [{"name": "Bob", "wallet": "bBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"}], "contents": "Hello!"})",
+            types);
+        ASSERT_NE(s.get(), nullptr);
+        EXPECT_EQ(hex(s->hashType()), hex(Hash::keccak256(s->encodeType())));
+    }
+}
+
 TEST(EthereumAbiStruct, ParamFactoryMakeTypes) {
     {
         std::vector<std::shared_ptr<ParamStruct>> tt = ParamStruct::makeTypes(R"({"Person": [{"name": "name", "type": "string"}, {"name": "wallet", "type": "address"}]})");
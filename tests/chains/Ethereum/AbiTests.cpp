@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Ethereum/ABI.h"
+#include "Ethereum/ABI/FunctionCache.h"
 #include "HexCoding.h"
 #include "TestUtilities.h"
 
@@ -690,6 +691,53 @@ TEST(EthereumAbi, ParamTupleDynamic) {
     }
 }
 
+TEST(EthereumAbi, ParamArrayOfTuples) {
+    auto param = ParamArray();
+    for (auto i = 1; i <= 2; ++i) {
+        auto tuple = std::make_shared<ParamTuple>();
+        tuple->addParam(std::make_shared<ParamUInt64>(i));
+        tuple->addParam(std::make_shared<ParamByteArray>(Data{static_cast<uint8_t>(0x10 * i), 0x11}));
+        param.addParam(tuple);
+    }
+    EXPECT_EQ("(uint64,bytes)[]", param.getType());
+    EXPECT_EQ(11 * 32ul, param.getSize());
+    Data encoded;
+    param.encode(encoded);
+    EXPECT_EQ(
+        "0000000000000000000000000000000000000000000000000000000000000002" // count
+        "0000000000000000000000000000000000000000000000000000000000000040" // offset 2*32
+        "00000000000000000000000000000000000000000000000000000000000000c0" // offset 6*32
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000040" // offset 2*32
+        "0000000000000000000000000000000000000000000000000000000000000002" // len
+        "1011000000000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000040" // offset 2*32
+        "0000000000000000000000000000000000000000000000000000000000000002" // len
+        "2011000000000000000000000000000000000000000000000000000000000000",
+        hex(encoded));
+}
+
+TEST(EthereumAbi, ParamTupleDeeplyNested) {
+    // each level sizes its elements once, a naive sizing would visit the innermost tuple 3^depth times
+    const auto depth = 40;
+    auto inner = std::make_shared<ParamTuple>();
+    inner->addParam(std::make_shared<ParamByteArray>(parse_hex("01")));
+    for (auto i = 1; i < depth; ++i) {
+        auto outer = std::make_shared<ParamTuple>();
+        outer->addParam(std::make_shared<ParamByteArray>(parse_hex("01")));
+        outer->addParam(inner);
+        inner = outer;
+    }
+    // the offset of each tuple and its bytes, and the innermost one
+    const auto size = (depth * 4 - 1) * 32ul;
+    Data encoded;
+    inner->encode(encoded);
+    EXPECT_EQ(size, encoded.size());
+    EXPECT_EQ(size, inner->getSize());
+    EXPECT_EQ("0000000000000000000000000000000000000000000000000000000000000040", hex(subData(encoded, 0, 32)));
+}
+
 ///// Direct encode & decode
 
 TEST(EthereumAbi, EncodeVectorByte10) {
@@ -1643,4 +1691,96 @@ TEST(EthereumAbi, ParametersMethods) {
     EXPECT_EQ(hex(p.hashStruct()), "755311b9e2cee471a91b161ccc5deed933d844b5af2b885543cc3c04eb640983");
 }
 
+TEST(EthereumAbi, StaticFunctionEncode) {
+    const auto to = parse_hex("5322b34c88ed0691971bf52a7047448f0f4efc84");
+    const auto from = parse_hex("0x718046867b5b1782379a14eA4fc0c9b724DA94Fc");
+
+    auto func = Function("transferFrom", std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamAddress>(from),
+        std::make_shared<ParamAddress>(to),
+        std::make_shared<ParamUInt256>(uint256_t(1234567))});
+    Data expected;
+    func.encode(expected);
+
+    const auto& compiled = StaticFunction::get("transferFrom(address,address,uint256)");
+    EXPECT_EQ(&compiled, &StaticFunction::get("transferFrom(address,address,uint256)"));
+    EXPECT_EQ(compiled.encodedSize(), 100ul);
+    EXPECT_EQ(hex(compiled.encode({from, to, uint256_t(1234567)})), hex(expected));
+    // address as a number
+    EXPECT_EQ(hex(compiled.encode({load(from), to, uint256_t(1234567)})), hex(expected));
+
+    auto mixed = Function("f", std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamBool>(true),
+        std::make_shared<ParamUInt8>(0x12),
+        std::make_shared<ParamUIntN>(24, uint256_t(0x123456)),
+        std::make_shared<ParamByteArrayFix>(4, parse_hex("01020304")),
+        std::make_shared<ParamByteArrayFix>(32, parse_hex("abcd"))});
+    expected.clear();
+    mixed.encode(expected);
+    const auto& compiledMixed = StaticFunction::get("f(bool,uint8,uint24,bytes4,bytes32)");
+    EXPECT_EQ(hex(compiledMixed.encode({uint256_t(1), uint256_t(0x12), uint256_t(0x123456), parse_hex("01020304"), parse_hex("abcd")})), hex(expected));
+    // numbers are masked, bytes are cropped
+    EXPECT_EQ(hex(compiledMixed.encode({uint256_t(1), uint256_t(0x112), uint256_t(0x77123456), parse_hex("0102030405"), parse_hex("abcd")})), hex(expected));
+
+    EXPECT_EQ(hex(StaticFunction::get("empty()").encode({})), hex(Function("empty").getSignature()));
+}
+
+TEST(EthereumAbi, StaticFunctionInvalid) {
+    EXPECT_THROW(StaticFunction("transfer"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("(uint256)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(uint256,)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(bytes)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(string)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(int256)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(uint7)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(bytes33)"), std::invalid_argument);
+    EXPECT_THROW(StaticFunction("f(address[])"), std::invalid_argument);
+
+    const auto& func = StaticFunction::get("approve(address,uint256)");
+    EXPECT_THROW(func.encode({uint256_t(1)}), std::invalid_argument);
+    EXPECT_THROW(func.encode({uint256_t(1), Data{1}}), std::invalid_argument);
+}
+
+TEST(EthereumAbi, StaticFunctionPacked) {
+    const auto& func = StaticFunction::get("f(address,bool,uint24,bytes4,uint256)");
+    EXPECT_EQ(func.packedSize(), 20ul + 1 + 3 + 4 + 32);
+    const auto address = parse_hex("5322b34c88ed0691971bf52a7047448f0f4efc84");
+    Data packed = address;
+    append(packed, parse_hex("01" "123456" "01020304"));
+    append(packed, store(uint256_t(1234567), 32));
+
+    const auto encoded = func.encodePacked(packed);
+    EXPECT_EQ(hex(encoded), hex(func.encode({address, uint256_t(1), uint256_t(0x123456), parse_hex("01020304"), uint256_t(1234567)})));
+    EXPECT_EQ(hex(func.encodeJson(nlohmann::json::parse(R"(["0x5322b34c88ed0691971bf52a7047448f0f4efc84", true, "0x123456", "0x01020304", "1234567"])"))), hex(encoded));
+    EXPECT_EQ(hex(func.encodeJson(nlohmann::json::parse(R"(["5322b34c88ed0691971bf52a7047448f0f4efc84", true, 1193046, "01020304", 1234567])"))), hex(encoded));
+
+    // call data and return data
+    EXPECT_EQ(hex(func.decodePacked(encoded)), hex(packed));
+    EXPECT_EQ(hex(func.decodePacked(Data(encoded.begin() + 4, encoded.end()))), hex(packed));
+
+    EXPECT_THROW(func.encodePacked(Data(packed.begin(), packed.end() - 1)), std::invalid_argument);
+    EXPECT_THROW(func.encodeJson(nlohmann::json::parse(R"(["0x00", true, 1, "0x00"])")), std::invalid_argument);
+    EXPECT_THROW(func.encodeJson(nlohmann::json::parse(R"(["0x00", 1, 1, "0x00", 1])")), std::invalid_argument);
+    EXPECT_THROW(func.encodeJson(nlohmann::json::parse(R"(["0x00", true, -1, "0x00", 1])")), std::invalid_argument);
+    auto invalid = encoded;
+    invalid[0] ^= 1;
+    EXPECT_THROW(func.decodePacked(invalid), std::invalid_argument);
+    invalid = encoded;
+    invalid[4 + 32 + 30] = 1; // bool padding
+    EXPECT_THROW(func.decodePacked(invalid), std::invalid_argument);
+    invalid = encoded;
+    invalid[4 + 64 + 28] = 1; // uint24 upper bits
+    EXPECT_THROW(func.decodePacked(invalid), std::invalid_argument);
+    invalid = encoded;
+    invalid[4 + 96 + 4] = 1; // bytes4 padding
+    EXPECT_THROW(func.decodePacked(invalid), std::invalid_argument);
+    EXPECT_THROW(func.decodePacked(Data(encoded.begin(), encoded.end() - 1)), std::invalid_argument);
+}
+
+TEST(EthereumAbi, FunctionSelector) {
+    EXPECT_EQ(hex(functionSelector("transfer(address,uint256)")), "a9059cbb");
+    EXPECT_EQ(hex(functionSelector("transfer(address,uint256)")), "a9059cbb");
+    EXPECT_EQ(hex(StaticFunction::get("transfer(address,uint256)").selector()), "a9059cbb");
+}
+
 } // namespace TW::Ethereum::ABI::tests
@@ -5,6 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Ethereum/Address.h"
+#include "Ethereum/AddressChecksum.h"
+#include "HDWallet.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 
@@ -54,6 +56,64 @@ TEST(EthereumAddress, FromPrivateKey) {
 TEST(EthereumAddress, IsValid) {
     ASSERT_FALSE(Address::isValid("abc"));
     ASSERT_TRUE(Address::isValid("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed"));
+    ASSERT_TRUE(Address::isValid("0x5aaeb6053f3e94c9b9a09f33669435e7ef1beaed"));
+    ASSERT_FALSE(Address::isValid("0X5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed"));
+    ASSERT_FALSE(Address::isValid("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAeg"));
+    ASSERT_FALSE(Address::isValid("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAe"));
+    ASSERT_THROW(Address("0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAe "), std::invalid_argument);
+}
+
+TEST(EthereumAddress, ChecksumBatch) {
+    const auto addresses = std::vector<Address>{
+        Address("0x5aaeb6053f3e94c9b9a09f33669435e7ef1beaed"),
+        Address("0xFB6916095CA1DF60BB79CE92CE3EA74C37C5D359"),
+        Address("0xd1220a0cf47c7b9be7a2e6ba89f429762e7b9adb"),
+    };
+    const auto batch = checksumBatch(addresses);
+    ASSERT_EQ(batch.size(), 3 * checksumedSize);
+    EXPECT_EQ(batch, "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed"
+                     "0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359"
+                     "0xD1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb");
+    for (auto i = 0ul; i < addresses.size(); ++i) {
+        EXPECT_EQ(batch.substr(i * checksumedSize, checksumedSize), addresses[i].string());
+    }
+    EXPECT_EQ(checksumBatch({}), "");
+
+    // runs of four hashed together, and a leftover
+    std::vector<Address> many;
+    for (auto i = 0; i < 9; ++i) {
+        many.emplace_back(Data(Address::size, static_cast<byte>(0x11 * i)));
+    }
+    const auto manyBatch = checksumBatch(many);
+    for (auto i = 0ul; i < many.size(); ++i) {
+        EXPECT_EQ(manyBatch.substr(i * checksumedSize, checksumedSize), many[i].string());
+    }
+}
+
+TEST(EthereumAddress, FromPublicKeys) {
+    std::vector<PublicKey> publicKeys;
+    for (auto i = 1; i <= 6; ++i) {
+        publicKeys.push_back(PrivateKey(Data(32, static_cast<byte>(i))).getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+    }
+    const auto addresses = Address::fromPublicKeys(publicKeys);
+    ASSERT_EQ(addresses.size(), publicKeys.size());
+    for (auto i = 0ul; i < publicKeys.size(); ++i) {
+        EXPECT_EQ(addresses[i], Address(publicKeys[i]));
+    }
+    EXPECT_TRUE(Address::fromPublicKeys({}).empty());
+    EXPECT_THROW(Address::fromPublicKeys({publicKeys[0].compressed()}), std::invalid_argument);
+}
+
+TEST(EthereumAddress, DeriveAddresses) {
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    // more than one batch of hashes
+    const auto addresses = wallet.deriveAddresses(TWCoinTypeEthereum, TWDerivationDefault, 0, 0, 5, 70, 2);
+    ASSERT_EQ(addresses.size(), 70ul);
+    for (const auto i : {0u, 3u, 63u, 64u, 69u}) {
+        const auto path = DerivationPath("m/44'/60'/0'/0/" + std::to_string(5 + i));
+        EXPECT_EQ(addresses[i], Address(wallet.getKey(TWCoinTypeEthereum, path).getPublicKey(TWPublicKeyTypeSECP256k1Extended)).string());
+    }
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypePolygon, TWDerivationDefault, 0, 0, 5, 1)[0], addresses[0]);
 }
 
 } // namespace TW::Ethereum::tests
@@ -9,6 +9,7 @@
 #include <TrustWalletCore/TWBarz.h>
 #include <TrustWalletCore/TWHash.h>
 #include <Ethereum/Barz.h>
+#include <Ethereum/Signer.h>
 #include <PrivateKey.h>
 #include "proto/Ethereum.pb.h"
 #include "HexCoding.h"
@@ -94,6 +95,18 @@ TEST(Barz, GetCounterfactualAddressFromPublicKey) {
         const auto& result = WRAPS(TWBarzGetCounterfactualAddress(inputTWData.get()));
         assertStringsEqual(result, "0xb16Db98B365B1f89191996942612B14F1Da4Bd5f");
     }
+
+    // Batch
+    {
+        auto other = TW::Barz::Proto::ContractOwner();
+        other.set_public_key("0x04e6f4e0351e2f556fd7284a9a033832bae046ac31fd529ad02ab6220870624b79eb760e718fdaed7a037dd1d77a561759cee9f2706eb55a729dc953e0d5719b02");
+        const auto addresses = getCounterfactualAddresses(input, {owner, TW::Barz::Proto::ContractOwner(), other});
+        ASSERT_EQ(addresses.size(), 3ul);
+        EXPECT_EQ(addresses[0], "0xb16Db98B365B1f89191996942612B14F1Da4Bd5f");
+        EXPECT_EQ(addresses[1], "");
+        *input.mutable_owner() = other;
+        EXPECT_EQ(addresses[2], getCounterfactualAddress(input));
+    }
 }
 
 TEST(Barz, GetCounterfactualAddressFromAttestationObject) {
@@ -248,4 +261,47 @@ TEST(Barz, SignR1TransferAccountNotDeployed) {
         ASSERT_EQ(std::string(output.encoded()), expected);
     }
 }
+
+TEST(Barz, SignUserOperationsBatch) {
+    const auto chainID = uint256_t(97);
+    const auto entryPoint = parse_hex("0x5FF137D4b0FDCD49DcA30c7CF57E578a026d2789");
+    const auto sender = parse_hex("0xb16Db98B365B1f89191996942612B14F1Da4Bd5f");
+    const auto to = parse_hex("0x61061fCAE11fD5461535e134EfF67A98CFFF44E9");
+    const auto key = PrivateKey(parse_hex("0x3c90badc15c4d35733769093d3733501e92e7f16e101df284cee9a310d36c483"));
+
+    std::vector<std::shared_ptr<Ethereum::UserOperation>> operations;
+    for (auto nonce = 2; nonce < 8; ++nonce) {
+        const auto initCode = nonce % 2 == 0 ? Data() : parse_hex("0x3fc708630d85a3b5ec217e53100ec2b735d4f800296601cd");
+        operations.push_back(Ethereum::UserOperation::buildNativeTransfer(
+            entryPoint, sender, to, uint256_t(0x2386f26fc10000), uint256_t(nonce),
+            uint256_t(0x186A0), uint256_t(0x186a0), uint256_t(0x1a339c9e9), uint256_t(0x1a339c9e9), uint256_t(0xb708),
+            {}, initCode));
+    }
+
+    const auto hasher = Ethereum::UserOperationHasher(entryPoint, chainID);
+    // same as SignK1TransferAccountDeployed
+    EXPECT_EQ(hexEncoded(hasher.preHash(*operations[0])), "0x731dd74cbf212bee883c6decbad07ad8980be89ca2e6c64de310af04e562d866");
+
+    const auto preHashes = hasher.preHashes(operations, 3);
+    const auto signatures = Ethereum::Signer::signUserOperations(key, chainID, operations, 3);
+    ASSERT_EQ(preHashes.size(), operations.size());
+    ASSERT_EQ(signatures.size(), operations.size());
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        EXPECT_EQ(hex(preHashes[i]), hex(operations[i]->preHash(chainID)));
+        const auto expected = Ethereum::Signer::sign(key, chainID, operations[i]);
+        EXPECT_EQ(signatures[i].r, expected.r);
+        EXPECT_EQ(signatures[i].s, expected.s);
+        EXPECT_EQ(signatures[i].v, expected.v);
+    }
+    EXPECT_EQ(hex(store(signatures[0].r)), "3d29240a2decf2a1f47c88d1cb5923815ed50d24f8f01a9697e229ba69ce18d1");
+    EXPECT_EQ(hex(store(signatures[0].s)), "3779d2d96a5c93f5df29110677de62e75f4d751ab7baf5830276eb4ca257fb47");
+
+    EXPECT_TRUE(Ethereum::Signer::signUserOperations(key, chainID, {}).empty());
+
+    operations.push_back(Ethereum::UserOperation::buildNativeTransfer(
+        to, sender, to, uint256_t(1), uint256_t(1), uint256_t(1), uint256_t(1), uint256_t(1), uint256_t(1), uint256_t(1)));
+    EXPECT_THROW(hasher.preHashes(operations), std::invalid_argument);
+    EXPECT_THROW(Ethereum::Signer::signUserOperations(key, chainID, operations, 2), std::invalid_argument);
+}
+
 }
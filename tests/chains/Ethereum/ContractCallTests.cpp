@@ -217,4 +217,42 @@ TEST(ContractCall, TupleNested) {
     EXPECT_EQ(decoded.value(), expected);
 }
 
+TEST(ContractCall, CallDecoder) {
+    CallDecoder decoder;
+    decoder.add(load_json(TESTS_ROOT + "/chains/Ethereum/Data/erc20.json"));
+    const auto erc20Size = decoder.size();
+    EXPECT_GT(erc20Size, 0ul);
+
+    // standard ABI array, selectors computed from the signatures
+    const auto nested = load_json(TESTS_ROOT + "/chains/Ethereum/Data/tuple_nested.json");
+    auto array = nlohmann::json::array();
+    for (const auto& [selector, function] : nested.items()) {
+        array.push_back(function);
+    }
+    array.push_back({{"type", "event"}, {"name", "Transfer"}, {"inputs", nlohmann::json::array()}});
+    decoder.add(array);
+    EXPECT_EQ(decoder.size(), erc20Size + nested.size());
+
+    const auto approve = parse_hex("095ea7b30000000000000000000000005aaeb6053f3e94c9b9a09f33669435e7ef1beaed"
+                                   "0000000000000000000000000000000000000000000000000000000000000001");
+    EXPECT_EQ(decoder.decode(approve).value(), decodeCall(approve, load_json(TESTS_ROOT + "/chains/Ethereum/Data/erc20.json")).value());
+
+    const auto call = parse_hex(
+        "74b6ef0b"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000004"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "0000000000000000000000000000000000000000000000000000000000000001");
+    EXPECT_EQ(decoder.decode(call).value(), decodeCall(call, nested).value());
+
+    EXPECT_FALSE(decoder.decode(Data()).has_value());
+    EXPECT_FALSE(decoder.decode(parse_hex("a22cb46500")).has_value());
+    EXPECT_FALSE(decoder.decode(Data(approve.begin(), approve.end() - 32)).has_value());
+    EXPECT_THROW(decoder.add(nlohmann::json::parse(R"({"0x01": {}})")), std::invalid_argument);
+    EXPECT_THROW(decoder.add(nlohmann::json::parse(R"([{"type": "function"}])")), std::invalid_argument);
+    EXPECT_THROW(decoder.add("abi"), std::invalid_argument);
+}
+
 } // namespace TW::Ethereum::ABI::tests
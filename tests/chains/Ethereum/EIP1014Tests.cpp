@@ -86,4 +86,25 @@ namespace TW::Ethereum::tests {
         const auto& addressData = Ethereum::create2Address(from, salt, initCodeHash);
         ASSERT_EQ(Ethereum::checksumed(Ethereum::Address(hexEncoded(addressData))), "0x4455e5f0038795939c001aa4d296A45956C460AA");
     }
+
+    TEST(EthereumEip1014, Batch) {
+        const auto from = Ethereum::Address("0xdeadbeef00000000000000000000000000000000");
+        const Data zero(32, 0);
+        const Data feed = parse_hex("0x000000000000000000000000feed000000000000000000000000000000000000");
+        const Data initCodeHash = Hash::keccak256(parse_hex("0x00"));
+
+        const auto addresses = Ethereum::create2Addresses(from, {zero, feed, zero, feed, zero}, {initCodeHash, zero, initCodeHash, zero, initCodeHash});
+        ASSERT_EQ(addresses.size(), 5ul);
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            EXPECT_EQ(Ethereum::checksumed(addresses[i]), i % 2 == 0 ? "0xB928f69Bb1D91Cd65274e3c79d8986362984fDA3" : "0x2DB27D1d6BE32C9abfA484BA3d591101881D4B9f");
+        }
+
+        // a single init code hash shared by all the salts
+        const auto shared = Ethereum::create2Addresses(from, {zero, zero}, {initCodeHash});
+        ASSERT_EQ(shared.size(), 2ul);
+        EXPECT_EQ(Ethereum::checksumed(shared[1]), "0xB928f69Bb1D91Cd65274e3c79d8986362984fDA3");
+
+        EXPECT_THROW(Ethereum::create2Addresses(from, {zero, zero, zero}, {initCodeHash, initCodeHash}), std::runtime_error);
+        EXPECT_THROW(Ethereum::create2Addresses(from, {Data(31, 0)}, {initCodeHash}), std::runtime_error);
+    }
 }
@@ -243,4 +243,80 @@ namespace TW::Ethereum {
         EXPECT_EQ(std::string(TWStringUTF8Bytes(signature.get())), "446434e4c34d6b7456e5f07a1b994b88bf85c057234c68d1e10c936b1c85706c4e19147c0ac3a983bc2d56ebfd7146f8b62bcea6114900fe8e7d7351f44bf37624");
         EXPECT_TRUE(TWEthereumMessageSignerVerifyMessage(pubKey.get(), msg.get(), signature.get()));
     }
+
+    TEST(EthereumMessageSigner, RecoverAddresses) {
+        const auto keys = {
+            "03a9ca895dca1623c7dfd69693f7b4111f5d819d2e145536e0b03c136025a25d",
+            "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5",
+            "4646464646464646464646464646464646464646464646464646464646464646",
+        };
+        std::vector<Data> signatures;
+        std::vector<Data> digests;
+        std::vector<Address> expected;
+        for (const auto& key : keys) {
+            const PrivateKey privateKey(parse_hex(key));
+            for (const auto* message : {"Foo", "Bar"}) {
+                digests.push_back(MessageSigner::generateMessage(message));
+                signatures.push_back(parse_hex(MessageSigner::signMessage(privateKey, message, MessageType::Legacy)));
+                expected.emplace_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+            }
+            digests.push_back(MessageSigner::generateMessage("Baz"));
+            signatures.push_back(parse_hex(MessageSigner::signMessage(privateKey, "Baz", MessageType::Eip155, 1)));
+            expected.emplace_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+        }
+        // R = 0 is not a valid signature.
+        signatures.push_back(Data(65, 0));
+        digests.push_back(digests.front());
+
+        const auto addresses = MessageSigner::recoverAddresses(signatures, digests, 2);
+        ASSERT_EQ(addresses.size(), signatures.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_TRUE(addresses[i].has_value());
+            EXPECT_EQ(addresses[i]->string(), expected[i].string());
+        }
+        EXPECT_FALSE(addresses.back().has_value());
+    }
+
+    TEST(EthereumMessageSigner, SignBatch) {
+        PrivateKey ethKey(parse_hex("03a9ca895dca1623c7dfd69693f7b4111f5d819d2e145536e0b03c136025a25d"));
+        const std::vector<std::string> messages{"Foo", "Bar", "", "Baz"};
+        const auto signatures = MessageSigner::signMessageBatch(ethKey, messages, MessageType::Eip155, 1, 2);
+        ASSERT_EQ(signatures.size(), messages.size());
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            EXPECT_EQ(signatures[i], MessageSigner::signMessage(ethKey, messages[i], MessageType::Eip155, 1));
+        }
+
+        const auto typedData = R"(
+            {
+                "types": {
+                    "EIP712Domain": [
+                        {"name": "name", "type": "string"},
+                        {"name": "version", "type": "string"},
+                        {"name": "chainId", "type": "uint256"},
+                        {"name": "verifyingContract", "type": "address"}
+                    ],
+                    "Person": [
+                        {"name": "name", "type": "string"},
+                        {"name": "wallet", "type": "address"}
+                    ]
+                },
+                "primaryType": "Person",
+                "domain": {
+                    "name": "Ether Person",
+                    "version": "1",
+                    "chainId": 0,
+                    "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"
+                }
+            })";
+        const auto domain = ABI::TypedDataDomain(typedData);
+        const std::vector<std::string> orders(3, R"({"name": "Cow", "wallet": "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"})");
+        for (const auto& signature : MessageSigner::signTypedDataBatch(ethKey, domain, orders, MessageType::Legacy, std::nullopt, 2)) {
+            EXPECT_EQ(signature, "446434e4c34d6b7456e5f07a1b994b88bf85c057234c68d1e10c936b1c85706c4e19147c0ac3a983bc2d56ebfd7146f8b62bcea6114900fe8e7d7351f44bf3761c");
+        }
+        const auto encoded = parse_hex("8c1d2bd5348394761719da11ec67eedae9502d137e8940fee8ecd6f641ee1648000000000000000000000000cd2a3d9f938e13cd947ec05abc7fe734df8dd826");
+        const auto encodedSignatures = MessageSigner::signTypedDataEncodedBatch(ethKey, domain, std::vector<Data>{encoded}, MessageType::Eip155, 0);
+        EXPECT_EQ(encodedSignatures, std::vector<std::string>{"446434e4c34d6b7456e5f07a1b994b88bf85c057234c68d1e10c936b1c85706c4e19147c0ac3a983bc2d56ebfd7146f8b62bcea6114900fe8e7d7351f44bf37624"});
+
+        EXPECT_THROW(MessageSigner::signTypedDataBatch(ethKey, domain, orders, MessageType::Eip155, 1), std::invalid_argument);
+    }
 }
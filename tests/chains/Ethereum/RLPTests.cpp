@@ -130,6 +130,41 @@ TEST(RLP, EncodeListNested) {
     EXPECT_EQ(hex(encoded), "f8479cdb84c301020395d4856170706c658662616e616e6186636865727279a9e890cf83abcdef8a0001020304050607080996d587626974636f696e88626565656e62656583657468");
 }
 
+TEST(RLP, EncodeWith) {
+    const auto encoded = RLP::encodeWith([](RLP::Writer& writer) {
+        writer.beginList();
+        writer.beginList();
+        for (auto i : {1, 2, 3}) {
+            writer.append(i);
+        }
+        writer.endList();
+        writer.beginList();
+        writer.append(Data{'c', 'a', 't'});
+        writer.append(Data{'d', 'o', 'g'});
+        writer.endList();
+        writer.beginList();
+        writer.endList();
+        writer.endList();
+    });
+    EXPECT_EQ(hex(encoded), "ce" "c3010203" "c88363617483646f67" "c0");
+
+    // long list, long string, raw bytes
+    const auto longList = RLP::encodeWith([](RLP::Writer& writer) {
+        writer.appendEncoded(parse_hex("02"));
+        writer.beginList();
+        for (auto i = 0; i < 1024; ++i) {
+            writer.append(0);
+        }
+        writer.endList();
+        writer.append(Data(60, 0xab));
+    });
+    ASSERT_EQ(longList.size(), 1ul + 3 + 1024 + 2 + 60);
+    EXPECT_EQ(hex(subData(longList, 0, 6)), "02f9040080" "80");
+    EXPECT_EQ(hex(subData(longList, 1028, 3)), "b83cab");
+    EXPECT_EQ(hex(RLP::encode(uint256_t("0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20"))),
+              "a00102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+}
+
 TEST(RLP, EncodeInvalid) {
     ASSERT_TRUE(RLP::encode(-1).empty());
     ASSERT_TRUE(RLP::encodeList(std::vector<int>{0, -1}).empty());
@@ -309,4 +344,65 @@ TEST(RLP, decodeLenOverflow) {
     EXPECT_THROW(RLP::decode(parse_hex("cbfffffffffffffffff7c17f")), std::invalid_argument); // List length overflow (64 bit)
 }
 
+TEST(RLP, DecodeView) {
+    // signed EIP1559 transaction, type prefix removed
+    const auto encoded = parse_hex("f8710306847735940084b2d05e0082526c94b9f5771c27664bf2282d98e09d7f50cec7cb01a78701ee0c29f50cb180c080a092c336138f7d0231fe9422bb30ee9ef10bf222761fe9e04442e3a11e88880c64a06487026011dae03dc281bc21c7d7ede5c2226d197befb813a4ecad686b559e58");
+    const auto transaction = RLP::decodeView(encoded);
+    ASSERT_TRUE(transaction.isList());
+    EXPECT_EQ(transaction.encoded().data(), encoded.data());
+    EXPECT_EQ(transaction.size(), 12ul);
+
+    EXPECT_EQ(toBoost(transaction[0].toUint()), 3);
+    EXPECT_EQ(toBoost(transaction[1].toUint()), 6);
+    EXPECT_EQ(toBoost(transaction[4].toUint()), 21100);
+    EXPECT_EQ(hex(transaction[5].data()), "b9f5771c27664bf2282d98e09d7f50cec7cb01a7");
+    EXPECT_EQ(toBoost(transaction[6].toUint()), uint256_t(543210987654321));
+    EXPECT_TRUE(transaction[7].payload().empty());
+    EXPECT_TRUE(transaction[8].isList());
+    EXPECT_EQ(transaction[8].size(), 0ul);
+    EXPECT_EQ(toBoost(transaction[9].toUint()), 0);
+    EXPECT_EQ(hex(transaction[10].data()), "92c336138f7d0231fe9422bb30ee9ef10bf222761fe9e04442e3a11e88880c64");
+    EXPECT_THROW(transaction[12], std::out_of_range);
+
+    // views point into the buffer
+    const auto to = transaction[5].payload();
+    EXPECT_EQ(to.data() - encoded.data(), 18);
+
+    std::size_t count = 0;
+    for (const auto& item : transaction) {
+        EXPECT_FALSE(item.encoded().empty());
+        ++count;
+    }
+    EXPECT_EQ(count, 12ul);
+}
+
+TEST(RLP, DecodeViewNested) {
+    const auto encoded = parse_hex("c7c0c1c0c3c0c1c0");
+    const auto list = RLP::decodeView(encoded);
+    ASSERT_EQ(list.size(), 3ul);
+    EXPECT_EQ(list[0].size(), 0ul);
+    EXPECT_EQ(list[1].size(), 1ul);
+    EXPECT_EQ(list[2].size(), 2ul);
+    EXPECT_EQ(list[2][1][0].size(), 0ul);
+    EXPECT_THROW(list[2][1][0].data(), std::invalid_argument);
+    EXPECT_THROW(RLP::decodeView(parse_hex("80")).begin(), std::invalid_argument);
+}
+
+TEST(RLP, DecodeViewInvalid) {
+    EXPECT_THROW(RLP::decodeView(Data()), std::invalid_argument);
+    EXPECT_THROW(RLP::decodeView(parse_hex("8100")), std::invalid_argument);       // single byte not encoded as itself
+    EXPECT_THROW(RLP::decodeView(parse_hex("b80100")), std::invalid_argument);     // short string with long length
+    EXPECT_THROW(RLP::decodeView(parse_hex("b9000100")), std::invalid_argument);   // length with leading zero
+    EXPECT_THROW(RLP::decodeView(parse_hex("83646f")), std::invalid_argument);     // too short
+    EXPECT_THROW(RLP::decodeView(parse_hex("8364646464")), std::invalid_argument); // trailing data
+    EXPECT_THROW(RLP::decodeView(parse_hex("c28100")), std::invalid_argument);     // invalid nested item
+    EXPECT_THROW(RLP::decodeView(parse_hex("c3c28100")), std::invalid_argument);   // invalid deeper item
+    EXPECT_THROW(RLP::decodeView(parse_hex("c9bffffffffffffffff7")), std::invalid_argument);
+    EXPECT_THROW(RLP::decodeView(parse_hex("cbfffffffffffffffff7c17f")), std::invalid_argument);
+
+    EXPECT_THROW(RLP::decodeView(parse_hex("00")).toUint(), std::invalid_argument);       // not the encoding of 0
+    EXPECT_THROW(RLP::decodeView(parse_hex("820001")).toUint(), std::invalid_argument);   // leading zero
+    EXPECT_THROW(RLP::decodeView(parse_hex("a1" + std::string(66, '1'))).toUint(), std::invalid_argument);
+}
+
 } // namespace TW::Ethereum::tests
@@ -306,6 +306,53 @@ TEST(TWAnySignerEthereum, SignJSON) {
     assertStringsEqual(result, "f86a8084d693a400825208947d8bf18c7ce84b3e175b339c4ca93aed1dd166f1870348bca5a160008025a0fe5802b49e04c6b1705088310e133605ed8b549811a18968ad409ea02ad79f21a05bf845646fb1e1b9365f63a7fd5eb5e984094e3ed35c3bed7361aebbcbf41f10");
 }
 
+TEST(TWAnySignerEthereum, SignBatch) {
+    auto key = parse_hex("17209af590a86462395d5881e60d11c7fa7d482cfb02b5a01b93c2eeef243543");
+    auto chainId = store(uint256_t(1));
+    auto gasPrice = store(uint256_t(3600000000));
+    auto gasLimit = store(uint256_t(21000));
+    auto amount = store(uint256_t(924400000000000));
+
+    const auto count = 16;
+    auto inputs = WRAP(TWDataVector, TWDataVectorCreate());
+    std::vector<std::string> expected;
+    for (auto i = 0; i < count; ++i) {
+        Proto::SigningInput input;
+        auto nonce = store(uint256_t(i));
+        input.set_chain_id(chainId.data(), chainId.size());
+        input.set_nonce(nonce.data(), nonce.size());
+        input.set_gas_price(gasPrice.data(), gasPrice.size());
+        input.set_gas_limit(gasLimit.data(), gasLimit.size());
+        input.set_to_address("0x7d8bf18C7cE84b3E175b339c4Ca93aEd1dD166F1");
+        input.set_private_key(key.data(), key.size());
+        input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+
+        auto inputData = input.SerializeAsString();
+        auto inputTWData = WRAPD(TWDataCreateWithBytes((const uint8_t*)inputData.data(), inputData.size()));
+        TWDataVectorAdd(inputs.get(), inputTWData.get());
+
+        auto outputTWData = WRAPD(TWAnySignerSign(inputTWData.get(), TWCoinTypeEthereum));
+        expected.push_back(hex(*reinterpret_cast<const Data*>(outputTWData.get())));
+    }
+
+    for (auto threads : {0u, 1u, 4u}) {
+        auto outputs = WRAP(TWDataVector, TWAnySignerSignBatch(inputs.get(), TWCoinTypeEthereum, threads));
+        ASSERT_EQ(TWDataVectorSize(outputs.get()), static_cast<size_t>(count));
+        for (auto i = 0; i < count; ++i) {
+            auto outputTWData = WRAPD(TWDataVectorGet(outputs.get(), i));
+            EXPECT_EQ(hex(*reinterpret_cast<const Data*>(outputTWData.get())), expected[i]);
+
+            Proto::SigningOutput output;
+            output.ParseFromArray(TWDataBytes(outputTWData.get()), static_cast<int>(TWDataSize(outputTWData.get())));
+            EXPECT_EQ(output.error(), Common::Proto::OK);
+        }
+    }
+
+    auto empty = WRAP(TWDataVector, TWDataVectorCreate());
+    auto emptyOutputs = WRAP(TWDataVector, TWAnySignerSignBatch(empty.get(), TWCoinTypeEthereum, 4));
+    EXPECT_EQ(TWDataVectorSize(emptyOutputs.get()), 0ul);
+}
+
 TEST(TWAnySignerEthereum, PlanNotSupported) {
     // Ethereum does not use plan(), call it nonetheless
     Proto::SigningInput input;
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <TrustWalletCore/TWEthereumAbi.h>
+#include <TrustWalletCore/TWEthereumAbiCallDecoder.h>
 #include <TrustWalletCore/TWEthereumAbiFunction.h>
 #include <TrustWalletCore/TWString.h>
 
@@ -281,6 +282,18 @@ TEST(TWEthereumAbi, DecodeInvalidCall) {
     EXPECT_TRUE(decoded2 == nullptr);
 }
 
+TEST(TWEthereumAbi, CallDecoder) {
+    auto decoder = std::shared_ptr<TWEthereumAbiCallDecoder>(TWEthereumAbiCallDecoderCreate(), TWEthereumAbiCallDecoderDelete);
+    EXPECT_TRUE(TWEthereumAbiCallDecoderAddAbi(decoder.get(), STRING(R"|([{"inputs":[{"name":"name","type":"string"}],"name":"setName","outputs":[],"type":"function"}])|").get()));
+    EXPECT_FALSE(TWEthereumAbiCallDecoderAddAbi(decoder.get(), STRING(",,").get()));
+
+    auto call = DATA("c47f0027000000000000000000000000000000000000000000000000000000000000002000000000000000000000000000000000000000000000000000000000000000086465616462656566000000000000000000000000000000000000000000000000");
+    auto decoded = WRAPS(TWEthereumAbiCallDecoderDecode(decoder.get(), call.get()));
+    assertStringsEqual(decoded, R"|({"function":"setName(string)","inputs":[{"name":"name","type":"string","value":"deadbeef"}]})|");
+
+    EXPECT_TRUE(TWEthereumAbiCallDecoderDecode(decoder.get(), DATA("095ea7b300").get()) == nullptr);
+}
+
 TEST(TWEthereumAbi, encodeTyped) {
     auto message = WRAPS(TWStringCreateWithUTF8Bytes(
         R"({
@@ -337,4 +350,22 @@ TEST(TWEthereumAbi, encodeTyped) {
     );
 }
 
+TEST(TWEthereumAbi, EncodeDecodeCompiled) {
+    const auto signature = STRING("transfer(address,uint256)");
+    const auto packed = DATA("5322b34c88ed0691971bf52a7047448f0f4efc84" "0000000000000000000000000000000000000000000000000000000000bc614e");
+    const auto expected = "a9059cbb0000000000000000000000005322b34c88ed0691971bf52a7047448f0f4efc840000000000000000000000000000000000000000000000000000000000bc614e";
+
+    const auto encoded = WRAPD(TWEthereumAbiEncodeCompiled(signature.get(), packed.get()));
+    assertHexEqual(encoded, expected);
+    const auto encodedJson = WRAPD(TWEthereumAbiEncodeCompiledJson(signature.get(), STRING(R"(["0x5322b34c88ed0691971bf52a7047448f0f4efc84", 12345678])").get()));
+    assertHexEqual(encodedJson, expected);
+
+    const auto decoded = WRAPD(TWEthereumAbiDecodeCompiled(signature.get(), encoded.get()));
+    EXPECT_TRUE(TWDataEqual(decoded.get(), packed.get()));
+
+    EXPECT_EQ(TWDataSize(WRAPD(TWEthereumAbiEncodeCompiled(STRING("transfer(string)").get(), packed.get())).get()), 0ul);
+    EXPECT_EQ(TWDataSize(WRAPD(TWEthereumAbiEncodeCompiledJson(signature.get(), STRING("[").get())).get()), 0ul);
+    EXPECT_EQ(TWDataSize(WRAPD(TWEthereumAbiDecodeCompiled(signature.get(), packed.get())).get()), 0ul);
+}
+
 } // namespace TW::Ethereum
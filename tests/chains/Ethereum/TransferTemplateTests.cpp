@@ -0,0 +1,64 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/Signer.h"
+#include "Ethereum/Transaction.h"
+#include "Ethereum/TransferTemplate.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Ethereum::tests {
+
+const auto key = PrivateKey(parse_hex("4f96ed80e9a7555a6f74b3d658afdd9c756b0a40d4ca30c42c2039eb449bb904"));
+const auto recipient = parse_hex("B9F5771C27664bF2282D98E09D7F50cEc7cB01a7");
+const auto tokenContract = parse_hex("6b175474e89094c44da98b954eedeac495271d0f");
+const uint256_t chainID = 3;
+
+TEST(EthereumTransferTemplate, NativeTransfer) {
+    const auto transferTemplate = TransferTemplate(key, chainID, 2000000000, 3000000000, 21100);
+    const auto encoded = transferTemplate.sign(6, recipient, 543210987654321);
+    // https://ropsten.etherscan.io/tx/0x14429509307efebfdaa05227d84c147450d168c68539351fbc01ed87c916ab2e
+    EXPECT_EQ(hex(encoded), "02f8710306847735940084b2d05e0082526c94b9f5771c27664bf2282d98e09d7f50cec7cb01a78701ee0c29f50cb180c080a092c336138f7d0231fe9422bb30ee9ef10bf222761fe9e04442e3a11e88880c64a06487026011dae03dc281bc21c7d7ede5c2226d197befb813a4ecad686b559e58");
+
+    const auto transaction = TransactionEip1559::buildNativeTransfer(6, 2000000000, 3000000000, 21100, recipient, 543210987654321);
+    EXPECT_EQ(hex(transferTemplate.preHash(6, recipient, 543210987654321)), hex(transaction->preHash(chainID)));
+}
+
+TEST(EthereumTransferTemplate, ERC20Transfer) {
+    const auto transferTemplate = TransferTemplate(key, chainID, 2000000000, 3000000000, 60000, tokenContract);
+    for (const uint256_t nonce : {uint256_t(0), uint256_t(0x7f), uint256_t(0x80), uint256_t(123456789)}) {
+        for (const uint256_t amount : {uint256_t(0), uint256_t(1), uint256_t("1000000000000000000000")}) {
+            const auto transaction = TransactionEip1559::buildERC20Transfer(nonce, 2000000000, 3000000000, 60000, tokenContract, recipient, amount);
+            const auto signature = Signer::sign(key, chainID, transaction);
+            EXPECT_EQ(hex(transferTemplate.preHash(nonce, recipient, amount)), hex(transaction->preHash(chainID)));
+            EXPECT_EQ(hex(transferTemplate.sign(nonce, recipient, amount)), hex(transaction->encoded(signature, chainID)));
+        }
+    }
+}
+
+TEST(EthereumTransferTemplate, SignBatch) {
+    const auto transferTemplate = TransferTemplate(key, chainID, 2000000000, 3000000000, 60000, tokenContract);
+    std::vector<TransferTemplate::Transfer> transfers;
+    for (auto i = 0; i < 20; ++i) {
+        transfers.push_back({recipient, uint256_t(1000 + i)});
+    }
+    const auto encoded = transferTemplate.sign(41, transfers, 4);
+    ASSERT_EQ(encoded.size(), transfers.size());
+    for (auto i = 0ul; i < transfers.size(); ++i) {
+        EXPECT_EQ(encoded[i], transferTemplate.sign(41 + i, recipient, transfers[i].amount));
+    }
+}
+
+TEST(EthereumTransferTemplate, InvalidAddress) {
+    EXPECT_THROW(TransferTemplate(key, chainID, 1, 1, 60000, parse_hex("6b175474")), std::invalid_argument);
+
+    const auto transferTemplate = TransferTemplate(key, chainID, 1, 1, 60000, tokenContract);
+    EXPECT_THROW(transferTemplate.sign(0, parse_hex("b9f5771c"), 1), std::invalid_argument);
+    EXPECT_THROW(transferTemplate.sign(0, {{parse_hex("b9f5771c"), 1}}, 2), std::invalid_argument);
+}
+
+} // namespace TW::Ethereum::tests
@@ -0,0 +1,120 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/ABI.h"
+#include "Ethereum/ABI/ValueDecoder.h"
+#include "Ethereum/ABI/ValueReader.h"
+#include <HexCoding.h>
+
+#include <gtest/gtest.h>
+
+namespace TW::Ethereum::tests {
+
+using namespace ABI;
+
+const auto address1 = parse_hex("f784682c82526e245f50975190ef0fff4e4fc077");
+const auto address2 = parse_hex("2e00cd222cb42b616d86d037cc494e8ab7f5c9a3");
+
+Data encodeOutputs() {
+    // (uint256, string, address[], (uint256,bytes)[], bool, bytes4)
+    auto params = Parameters(std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamUInt256>(uint256_t(42)),
+        std::make_shared<ParamString>("Hello World!"),
+        std::make_shared<ParamArray>(std::vector<std::shared_ptr<ParamBase>>{
+            std::make_shared<ParamAddress>(address1),
+            std::make_shared<ParamAddress>(address2)}),
+        std::make_shared<ParamArray>(std::vector<std::shared_ptr<ParamBase>>{
+            std::make_shared<ParamTuple>(std::vector<std::shared_ptr<ParamBase>>{
+                std::make_shared<ParamUInt256>(uint256_t(1)),
+                std::make_shared<ParamByteArray>(parse_hex("0102030405"))}),
+            std::make_shared<ParamTuple>(std::vector<std::shared_ptr<ParamBase>>{
+                std::make_shared<ParamUInt256>(uint256_t(2)),
+                std::make_shared<ParamByteArray>(Data(40, 0xab))})}),
+        std::make_shared<ParamBool>(true),
+        std::make_shared<ParamByteArrayFix>(4, parse_hex("a9059cbb"))});
+    Data encoded;
+    params.encode(encoded);
+    return encoded;
+}
+
+TEST(EthereumAbiValueReader, ReadOutputs) {
+    const auto encoded = encodeOutputs();
+    const auto reader = ValueReader(encoded);
+
+    EXPECT_EQ(reader.uint256(0), uint256_t(42));
+    EXPECT_EQ(reader.string(1), "Hello World!");
+
+    const auto addresses = reader.array(2);
+    ASSERT_TRUE(addresses.has_value());
+    ASSERT_EQ(addresses->count, 2ul);
+    EXPECT_EQ(hex(*addresses->elements.address(0)), hex(address1));
+    EXPECT_EQ(hex(*addresses->elements.address(1)), hex(address2));
+
+    const auto results = reader.array(3);
+    ASSERT_TRUE(results.has_value());
+    ASSERT_EQ(results->count, 2ul);
+    const auto first = results->elements.tuple(0);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->uint256(0), uint256_t(1));
+    EXPECT_EQ(hex(*first->dynamicBytes(1)), "0102030405");
+    const auto second = results->elements.tuple(1);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->uint256(0), uint256_t(2));
+    EXPECT_EQ(hex(*second->dynamicBytes(1)), hex(Data(40, 0xab)));
+
+    EXPECT_EQ(reader.boolean(4), true);
+    EXPECT_EQ(hex(*reader.fixedBytes(5, 4)), "a9059cbb");
+
+    // views into the encoded data, no copies
+    EXPECT_GE(reader.string(1)->data(), reinterpret_cast<const char*>(encoded.data()));
+    EXPECT_LT(reader.string(1)->data(), reinterpret_cast<const char*>(encoded.data() + encoded.size()));
+}
+
+TEST(EthereumAbiValueReader, Malformed) {
+    const auto encoded = encodeOutputs();
+    const auto reader = ValueReader(encoded);
+    const auto words = encoded.size() / 32;
+    EXPECT_EQ(reader.uint256(words), std::nullopt);
+    EXPECT_EQ(reader.string(words), std::nullopt);
+    EXPECT_EQ(reader.array(words), std::nullopt);
+    EXPECT_EQ(reader.fixedBytes(5, 33), std::nullopt);
+    // offset beyond the data
+    EXPECT_EQ(ValueReader(parse_hex("00000000000000000000000000000000000000000000000000000000ffffffff")).string(0), std::nullopt);
+    EXPECT_EQ(ValueReader(parse_hex("ff00000000000000000000000000000000000000000000000000000000000000")).tuple(0), std::nullopt);
+
+    // truncated string
+    auto truncated = Data(encoded.begin(), encoded.begin() + 6 * 32 + 32);
+    EXPECT_EQ(ValueReader(truncated).string(1), std::nullopt);
+
+    // array length beyond the data
+    const auto array = parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000031"
+        "0000000000000000000000000000000000000000000000000000000000000032");
+    EXPECT_EQ(ValueReader(array).arrayAt(0), std::nullopt);
+    EXPECT_EQ(ValueReader(array).arrayAt(100), std::nullopt);
+    EXPECT_EQ(ValueReader(array).arrayAt(32), std::nullopt);
+    EXPECT_EQ(ValueReader(array).arrayAt(64), std::nullopt);
+}
+
+TEST(EthereumAbiValueReader, DecodeArray) {
+    const auto encoded = encodeOutputs();
+    const auto addresses = *ValueReader(encoded).uint256(2);
+    const auto values = ValueDecoder::decodeArray(Data(encoded.begin() + static_cast<std::ptrdiff_t>(addresses), encoded.end()), "address[]");
+    ASSERT_EQ(values.size(), 2ul);
+    EXPECT_EQ(values[0], hexEncoded(address1));
+    EXPECT_EQ(values[1], hexEncoded(address2));
+
+    const auto numbers = parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000031"
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    EXPECT_EQ(ValueDecoder::decodeArray(numbers, "uint256[]"),
+              (std::vector<std::string>{"49", "115792089237316195423570985008687907853269984665640564039457584007913129639935"}));
+    EXPECT_EQ(ValueDecoder::decodeArray(Data(numbers.begin(), numbers.end() - 1), "uint256[]"), std::vector<std::string>{});
+}
+
+} // namespace TW::Ethereum::tests
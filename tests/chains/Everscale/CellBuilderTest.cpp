@@ -47,7 +47,7 @@ TEST(EverscaleCell, ComputeContractAddress) {
     CellBuilder dataBuilder;
     dataBuilder.appendU32(seqno);
     dataBuilder.appendU32(walletId);
-    dataBuilder.appendRaw(publicKey.bytes, 256);
+    dataBuilder.appendRaw(Data(publicKey.bytes), 256);
 
     const auto data = dataBuilder.intoCell();
 
@@ -71,6 +71,10 @@ TEST(EverscaleCell, ComputeContractAddress) {
     auto stateInit = stateInitBuilder.intoCell();
 
     ASSERT_EQ(hex(stateInit->hash), "5a0f742c28067da91e05830f0b072a2069f0617a5f6529d295f6c517d63d67c6");
+
+    // Same hash from the precomputed wallet StateInit, without building the cell
+    ASSERT_EQ(hex(Wallet::stateInitTemplate().hash(*data)), hex(stateInit->hash));
+    ASSERT_EQ(Wallet::stateInitTemplate().code()->hash, code->hash);
 }
 
 TEST(EverscaleCell, UnalignedRead) {
@@ -51,6 +51,40 @@ TEST(EverscaleCell, SerializeWallet) {
     ASSERT_EQ(hex(decoded->hash), "84dafa449f98a6987789ba232358072bc0f76dc4524002a5d0918b9a75d2d599");
 }
 
+TEST(EverscaleCell, DeserializeDuplicateCells) {
+    // root cell with two references to separately stored, identical one-byte cells
+    const auto boc = parse_hex("b5ee9c720101030100" "0a" "00" "02000102" "000201" "000201");
+    const auto cell = Cell::deserialize(boc.data(), boc.size());
+    ASSERT_EQ(cell->refCount, 2);
+    // identical subtrees are shared
+    ASSERT_EQ(cell->references[0], cell->references[1]);
+
+    // and stored once when serialized
+    Data data;
+    cell->serialize(data);
+    ASSERT_EQ(hex(data), "b5ee9c72020200020001000000090000020000010001000201");
+    ASSERT_EQ(hex(Cell::deserialize(data.data(), data.size())->hash), hex(cell->hash));
+}
+
+TEST(EverscaleCell, SerializeWithCrc) {
+    const auto cell = Cell::fromBase64(TX);
+    Data plain;
+    cell->serialize(plain);
+    Data data;
+    cell->serialize(data, true);
+    ASSERT_EQ(data.size(), plain.size() + 4);
+
+    const auto decoded = Cell::deserialize(data.data(), data.size());
+    ASSERT_EQ(hex(decoded->hash), "88a02e7bd8833d384f37d63d4d01deef9a1806937b94a313cc5e8c3cc7643032");
+
+    data[20] ^= 1;
+    ASSERT_THROW(Cell::deserialize(data.data(), data.size()), std::runtime_error);
+
+    // Empty cell with CRC32C
+    const auto emptyCell = parse_hex("b5ee9c724101010100020000004cacb9cd");
+    ASSERT_EQ(hex(Cell::deserialize(emptyCell.data(), emptyCell.size())->hash), "96a296d224f285c67bee93c30f8a309157f0daa35dc5b87e410b78630a09cfc7");
+}
+
 TEST(EverscaleCell, EmptyCell) {
     const auto EMPTY_CELL = "96a296d224f285c67bee93c30f8a309157f0daa35dc5b87e410b78630a09cfc7";
 
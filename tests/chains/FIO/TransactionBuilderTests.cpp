@@ -106,6 +106,27 @@ TEST(FIOTransactionBuilder, NewFundsRequest) {
     EXPECT_EQ(R"({"compression":"none","packed_context_free_data":"","packed_trx":"289b295ec99b904215ff000000000100403ed4aa0ba85b00acba384dbdb89a01102b2f46fca756b200000000a8ed32328802106d6172696f4066696f746573746e657410616c6963654066696f746573746e6574c00141414543417751464267634943516f4c4441304f442f3575342f6b436b7042554c4a44682f546951334d31534f4e4938426668496c4e54766d39354249586d54396f616f7a55632f6c6c3942726e57426563464e767a76766f6d3751577a517250717241645035683433305732716b52355266416555446a704f514732364c347a6936767241553052764855474e382b685779736a6971506b2b7a455a444952534678426268796c69686d59334f4752342f5a46466358484967343241327834005ed0b2000000000c716466656a7a32613577706c0e726577617264734077616c6c657400","signatures":["SIG_K1_Kk79iVcQMpqpVgZwGTmC1rxgCTLy5BDFtHd8FvjRNm2FqNHR9dpeUmPTNqBKGMNG3BsPy4c5u26TuEDpS87SnyMpF43cZk"]})", t);
 }
 
+TEST(FIOTransactionBuilder, NewFundsRequests) {
+    ChainParams chainParams{chainId, 39881, 4279583376};
+    uint64_t fee = 3000000000;
+    const Data iv = parse_hex("000102030405060708090a0b0c0d0e0f"); // use fixed iv for testability
+    const auto payer = "FIO5kJKNHwctcfUM5XZyiWSqSTM5HTzznJP9F3ZdbhaQAHEVq575o";
+
+    const vector<NewFundsContent> contents = {
+        {"bc1qvy4074rggkdr2pzw5vpnn62eg0smzlxwp70d7v", "5", "BTC", "BTC", "Memo", "Hash", "https://trustwallet.com"},
+        {"0x6A86087Ee103DCC2494cA2804e4934b913df84E8", "0.25", "ETH", "ETH", "", "", ""},
+    };
+    const auto requests = TransactionBuilder::createNewFundsRequests(gAddr6M, gPrivKeyBA, "mario@fiotestnet", payer, "alice@fiotestnet",
+                                                                     contents, chainParams, fee, "rewards@wallet", 1579785000, iv);
+    ASSERT_EQ(requests.size(), 2ul);
+    for (size_t i = 0; i < contents.size(); ++i) {
+        const auto& content = contents[i];
+        EXPECT_EQ(requests[i], TransactionBuilder::createNewFundsRequest(gAddr6M, gPrivKeyBA, "mario@fiotestnet", payer, "alice@fiotestnet",
+                                                                         content.payeePublicAddress, content.amount, content.coinSymbol, content.memo, content.hash, content.offlineUrl,
+                                                                         chainParams, fee, "rewards@wallet", 1579785000, iv));
+    }
+}
+
 TEST(FIOTransaction, ActionRegisterFioAddressInternal) {
     RegisterFioAddressData radata("adam@fiotestnet", gAddr6M.string(),
                                   5000000000, "rewards@wallet", "qdfejz2a5wpl");
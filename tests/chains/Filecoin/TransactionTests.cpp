@@ -42,8 +42,28 @@ TEST(FilecoinTransaction, Serialize) {
     ASSERT_EQ(hex(tx.message().encoded()),
               "8a0055013d403ac3911e9f806228326fa68619d36a4641d455013d413d4c3fe3d89f99495a48c6046224"
               "a71f0cd71b0000001234567890430003e81ac6aea1554400a98ac744000516150040");
+    ASSERT_EQ(hex(tx.encoded()), hex(tx.message().encoded()));
     ASSERT_EQ(hex(tx.cid()),
               "0171a0e40220a3b06c2837a94e3a431a78b00536d0298455ceec3d304adf26a3868147c4e6e1");
+    ASSERT_EQ(hex(tx.preHash()), hex(Hash::blake2b(tx.cid(), 32)));
+}
+
+TEST(FilecoinTransaction, EncodeNegativeGasLimit) {
+    const Address fromAddress("f1hvadvq4rd2pyayrigjx2nbqz2nvemqouslw4wxi");
+    const Address toAddress("f0100");
+
+    Transaction tx(toAddress, fromAddress,
+                   /*nonce*/ 1,
+                   /*value*/ 0,
+                   /*gasLimit*/ -2,
+                   /*gasFeeCap*/ 0,
+                   /*gasPremium*/ 0,
+                   /*method*/ Transaction::MethodType::INVOKE_EVM,
+                   /*params*/ parse_hex("0102"));
+
+    ASSERT_EQ(hex(tx.encoded()),
+              "8a0042006455013d403ac3911e9f806228326fa68619d36a4641d401402040401ae525aa15420102");
+    ASSERT_EQ(hex(tx.message().encoded()), hex(tx.encoded()));
 }
 
 } // namespace TW::Filecoin
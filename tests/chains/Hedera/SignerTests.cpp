@@ -235,4 +235,31 @@ TEST(HederaSigner, ProtoTestsTransactionBodyWithMemo) {
     ASSERT_EQ(encoded, "0a150a0c08baddfe9a0610a1ceccc103120518cb889c17120218031880c2d72f22020878320b77616c6c657420636f7265721e0a1c0a0c0a0518e2f18d17108084af5f0a0c0a0518cb889c1710ff83af5f");
 }
 
+TEST(HederaSigner, SignBatch) {
+    // Transactions of HederaSigner.Sign and HederaSigner.SignWithMemo
+    auto privateKey = PrivateKey(parse_hex("e87a5584c0173263e138db689fdb2a7389025aaae7cb1a18a1017d76012130e8"));
+    std::vector<Proto::TransactionBody> bodies(2);
+    for (auto& body : bodies) {
+        *body.mutable_nodeaccountid() = "0.0.9";
+        body.set_transactionfee(100000000);
+        body.set_transactionvalidduration(120);
+        auto* transferMsg = body.mutable_transfer();
+        transferMsg->set_from("0.0.48694347");
+        transferMsg->set_to("0.0.48462050");
+        transferMsg->set_amount(100000000);
+        body.mutable_transactionid()->set_accountid("0.0.48694347");
+    }
+    bodies[0].mutable_transactionid()->mutable_transactionvalidstart()->set_seconds(1667222879);
+    bodies[0].mutable_transactionid()->mutable_transactionvalidstart()->set_nanos(749068449);
+    *bodies[1].mutable_memo() = "wallet core";
+    *bodies[1].mutable_nodeaccountid() = "0.0.7";
+    bodies[1].mutable_transactionid()->mutable_transactionvalidstart()->set_seconds(1667227300);
+    bodies[1].mutable_transactionid()->mutable_transactionvalidstart()->set_nanos(854561449);
+
+    const auto results = Signer::signBatch(privateKey, bodies);
+    ASSERT_EQ(results.size(), 2ul);
+    EXPECT_EQ(hex(results[0].encoded()), "0a440a150a0c08df9aff9a0610a1c197e502120518cb889c17120218091880c2d72f22020878721e0a1c0a0c0a0518e2f18d17108084af5f0a0c0a0518cb889c1710ff83af5f12660a640a205d3a70d08b2beafb72c7a68986b3ff819a306078b8c359d739e4966e82e6d40e1a40612589c3b15f1e3ed6084b5a3a5b1b81751578cac8d6c922f31731b3982a5bac80a22558b2197276f5bae49b62503a4d39448ceddbc5ef3ba9bee4c0f302f70c");
+    EXPECT_EQ(hex(results[1].encoded()), "0a510a150a0c08a4bdff9a0610a9a5be9703120518cb889c17120218071880c2d72f22020878320b77616c6c657420636f7265721e0a1c0a0c0a0518e2f18d17108084af5f0a0c0a0518cb889c1710ff83af5f12660a640a205d3a70d08b2beafb72c7a68986b3ff819a306078b8c359d739e4966e82e6d40e1a40ee1764c9acf79b68a675c1a78c8c43cb7d136f5f230b48b44992ad3e7ba87a8256758b823120a76142e58b94f082a0551000cf68cd3336fc4393c6b2191d8603");
+}
+
 } // namespace TW::Hedera::tests
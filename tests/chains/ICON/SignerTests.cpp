@@ -0,0 +1,40 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Icon/Signer.h"
+#include "HexCoding.h"
+#include "uint256.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Icon::tests {
+
+TEST(IconSigner, PreImage) {
+    auto input = Proto::SigningInput();
+    input.set_from_address("hxbe258ceb872e08851f1f59694dac2558708ece11");
+    input.set_to_address("hx5bfdb090f43a808005ffc27c25b213145e80b7cd");
+    const auto value = store(uint256_t(1000000000000000000));
+    input.set_value(value.data(), value.size());
+    const auto stepLimit = store(uint256_t(74565));
+    input.set_step_limit(stepLimit.data(), stepLimit.size());
+    const auto one = store(uint256_t(1));
+    input.set_network_id(one.data(), one.size());
+    const auto zero = Data{0x00, 0x00};
+    input.set_nonce(zero.data(), zero.size());
+    input.set_timestamp(1516942975500598);
+
+    EXPECT_EQ(Signer(input).preImage(), "icx_sendTransaction.from.hxbe258ceb872e08851f1f59694dac2558708ece11.nid.0x1.nonce.0x0.stepLimit.0x12345.timestamp.0x563a6cf330136.to.hx5bfdb090f43a808005ffc27c25b213145e80b7cd.value.0xde0b6b3a7640000.version.0x3");
+}
+
+TEST(IconSigner, EncodeEscapesAddresses) {
+    auto input = Proto::SigningInput();
+    input.set_from_address("hx\"from\\");
+    input.set_to_address("hx\nto");
+
+    EXPECT_EQ(Signer(input).encode(parse_hex("0102")), R"({"from":"hx\"from\\","nid":"0x0","nonce":"0x0","signature":"AQI=","stepLimit":"0x0","timestamp":"0x0","to":"hx\nto","value":"0x0","version":"0x3"})");
+}
+
+} // namespace TW::Icon::tests
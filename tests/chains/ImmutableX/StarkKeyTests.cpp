@@ -19,6 +19,16 @@ TEST(ImmutableX, PathFromAddress) {
     ASSERT_EQ(res, "m/2645'/579218131'/211006541'/1534045311'/1431804530'/1");
 }
 
+TEST(ImmutableX, PathBuilder) {
+    using namespace internal;
+    const auto builder = Ethereum::AccountPathBuilder(gLayer, gApplication);
+    const auto path = builder.path(Ethereum::Address(parse_hex("0xa76e3eeb2f7143165618ab8feaabcd395b6fac7f")), 1);
+    ASSERT_EQ(path.string(), "m/2645'/579218131'/211006541'/1534045311'/1431804530'/1");
+
+    const auto address = "0xa4864d977b944315389d1765ffa7e66F74ee8cd7";
+    ASSERT_EQ(builder.path(Ethereum::Address(parse_hex(address)), 7).string(), Ethereum::accountPathFromAddress(address, gLayer, gApplication, "7"));
+}
+
 TEST(ImmutableX, ExtraGrinding) {
     using namespace internal;
     std::string signature = "0x6d1550458c7a9a1257d73adbcf0fabc12f4497e970d9fa62dd88bf7d9e12719148c96225c1402d8707fd061b1aae2222bdf13571dfc82b3aa9974039f247f2b81b";
@@ -26,7 +36,7 @@ TEST(ImmutableX, ExtraGrinding) {
     auto data = parse_hex(signature);
     auto path = DerivationPath(Ethereum::accountPathFromAddress(address, gLayer, gApplication, gIndex));
     auto privKey = ImmutableX::getPrivateKeyFromRawSignature(parse_hex(signature), path);
-    auto pubKey = hexEncoded(getPublicKeyFromPrivateKey(privKey.bytes));
+    auto pubKey = hexEncoded(getPublicKeyFromPrivateKey(Data(privKey.bytes)));
     ASSERT_EQ(pubKey, "0x035919acd61e97b3ecdc75ff8beed8d1803f7ea3cad2937926ae59cc3f8070d4");
 }
 
@@ -52,7 +62,26 @@ TEST(ImmutableX, GetPrivateKeyFromSignature) {
     auto path = DerivationPath(Ethereum::accountPathFromAddress(address, gLayer, gApplication, gIndex));
     auto privKey = ImmutableX::getPrivateKeyFromRawSignature(parse_hex(signature), path);
     ASSERT_EQ(hex(privKey.bytes), "058ab7989d625b1a690400dcbe6e070627adedceff7bd196e58d4791026a8afe");
-    ASSERT_TRUE(PrivateKey::isValid(privKey.bytes));
+    ASSERT_TRUE(PrivateKey::isValid(Data(privKey.bytes)));
+}
+
+TEST(ImmutableX, GetPrivateKeysFromSeed) {
+    using namespace internal;
+    std::string signature = "0x5a263fad6f17f23e7c7ea833d058f3656d3fe464baf13f6f5ccba9a2466ba2ce4c4a250231bcac7beb165aec4c9b049b4ba40ad8dd287dc79b92b1ffcf20cdcf1b";
+    const auto seed = store(Ethereum::Signer::signatureDataToStructSimple(parse_hex(signature)).s);
+    const auto builder = Ethereum::AccountPathBuilder(gLayer, gApplication);
+    std::vector<DerivationPath> paths;
+    for (uint32_t index = 0; index < 4; ++index) {
+        paths.push_back(builder.path(Ethereum::Address(parse_hex("0xa76e3eeb2f7143165618ab8feaabcd395b6fac7f")), index));
+        paths.push_back(builder.path(Ethereum::Address(parse_hex("0xa4864d977b944315389d1765ffa7e66F74ee8cd7")), index));
+    }
+
+    const auto keys = getPrivateKeysFromSeed(seed, paths, 2);
+    ASSERT_EQ(keys.size(), paths.size());
+    ASSERT_EQ(hex(keys[2].bytes), "058ab7989d625b1a690400dcbe6e070627adedceff7bd196e58d4791026a8afe");
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        EXPECT_EQ(hex(keys[i].bytes), hex(getPrivateKeyFromSeed(seed, paths[i]).bytes));
+    }
 }
 
 TEST(ImmutableX, GetPublicKeyFromPrivateKey) {
@@ -105,4 +134,30 @@ TEST(ImmutableX, VerifySign) {
     }
 }
 
+TEST(ImmutableX, SignBatch) {
+    const auto privKey = parse_hex("0139fe4d6f02e666e86a6f58e65060f115cd3c185bd9e98bd829636931458f79");
+    const auto digest = parse_hex("06fea80189363a786037ed3e7ba546dad0ef7de49fccae0e31eb658b7dd4ea76");
+    // digests shorter than 32 bytes are left-padded
+    const auto shortDigest = parse_hex("fea80189363a786037ed3e7ba546dad0ef7de49fccae0e31eb658b7dd4ea76");
+    const auto expectedSignature = "061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9a";
+
+    const auto signatures = signBatch(privKey, {digest, shortDigest});
+    ASSERT_EQ(signatures.size(), 2ul);
+    EXPECT_EQ(hex(signatures[0]), expectedSignature);
+    EXPECT_EQ(hex(signatures[1]), expectedSignature);
+
+    EXPECT_TRUE(signBatch(privKey, {digest, Data(33, 1)}).empty());
+    EXPECT_TRUE(signBatch(privKey, {}).empty());
+}
+
+TEST(ImmutableX, VerifyBatch) {
+    const auto pubKey = parse_hex("02c5dbad71c92a45cc4b40573ae661f8147869a91d57b8d9b8f48c8af7f83159");
+    const auto digest = parse_hex("06fea80189363a786037ed3e7ba546dad0ef7de49fccae0e31eb658b7dd4ea76");
+    const auto valid = parse_hex("061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9a");
+    const auto invalid = parse_hex("061ec782f76a66f6984efc3a1b6d152a124c701c00abdd2bf76641b4135c770f04e44e759cea02c23568bb4d8a09929bbca8768ab68270d50c18d214166ccd9b");
+
+    EXPECT_EQ(verifyBatch(pubKey, {valid, invalid, Data(63), valid}, {digest, digest, digest, digest}), std::vector<bool>({true, false, false, true}));
+    EXPECT_EQ(verifyBatch(pubKey, {valid}, {digest, digest}), std::vector<bool>({false, false}));
+}
+
 } // namespace TW::ImmutableX::tests
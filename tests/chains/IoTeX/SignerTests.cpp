@@ -57,4 +57,33 @@ TEST(IoTeXSigner, Build) {
     ASSERT_EQ(hex(h), "6c84ac119058e859a015221f87a4e187c393d0c6ee283959342eac95fad08c33");
 }
 
+TEST(IoTeXSigner, SignBatch) {
+    auto input = Proto::SigningInput();
+    input.set_version(1);
+    input.set_nonce(123);
+    input.set_gaslimit(888);
+    input.set_gasprice("999");
+    auto keyhex = parse_hex("0806c458b262edd333a191e92f561aff338211ee3e18ab315a074a2d82aa343f");
+    input.set_privatekey(keyhex.data(), keyhex.size());
+    auto tsf = input.mutable_transfer();
+    tsf->set_amount("456");
+    tsf->set_recipient("io187wzp08vnhjjpkydnr97qlh8kh0dpkkytfam8j");
+    auto text = parse_hex("68656c6c6f20776f726c6421"); // "hello world!"
+    tsf->set_payload(text.data(), text.size());
+
+    auto stake = input;
+    auto& create = *stake.mutable_stakecreate();
+    create.set_candidatename("io19d0p3ah4g8ww9d7kcxfq87yxe7fnr8rpth5shj");
+    create.set_stakedamount("100");
+    create.set_stakedduration(10000);
+
+    const auto outputs = Signer::signBatch({input, stake, input});
+    ASSERT_EQ(outputs.size(), 3ul);
+    EXPECT_EQ(hex(outputs[0].hash()), "6c84ac119058e859a015221f87a4e187c393d0c6ee283959342eac95fad08c33");
+    EXPECT_EQ(outputs[2].encoded(), outputs[0].encoded());
+    const auto single = Signer::sign(stake);
+    EXPECT_EQ(hex(outputs[1].encoded()), hex(single.encoded()));
+    EXPECT_EQ(hex(outputs[1].encoded()), hex(Signer(stake).build().encoded()));
+}
+
 } // namespace TW::IoTeX
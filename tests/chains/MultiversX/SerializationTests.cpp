@@ -114,4 +114,32 @@ TEST(MultiversXSerialization, SerializeTransactionWithGuardianAddress) {
     ASSERT_EQ(expected, actual);
 }
 
+TEST(MultiversXSerialization, SerializeSignedTransaction) {
+    Transaction transaction;
+    transaction.nonce = 7;
+    transaction.value = "0";
+    transaction.sender = ALICE_BECH32;
+    transaction.receiver = BOB_BECH32;
+    transaction.guardian = CAROL_BECH32;
+    transaction.gasPrice = 1000000000;
+    transaction.gasLimit = 100000;
+    transaction.chainID = "T\"\\\n\x01/é";
+    transaction.version = 2;
+    transaction.options = TransactionOptions::Guarded;
+
+    string expected =
+        "{"
+        R"("nonce":7,"value":"0",)"
+        R"("receiver":"erd1spyavw0956vq68xj8y4tenjpq2wd5a9p2c6j8gsz7ztyrnpxrruqzu66jx",)"
+        R"("sender":"erd1qyu5wthldzr8wx5c9ucg8kjagg0jfs53s8nr3zpz3hypefsdd8ssycr6th",)"
+        R"("gasPrice":1000000000,"gasLimit":100000,"chainID":)" + json(transaction.chainID).dump() + R"(,"version":2,)"
+        R"("signature":"abcd","options":2,)"
+        R"("guardian":"erd1k2s324ww2g0yj38qn2ch2jwctdy8mnfxep94q9arncc6xecg3xaq6mjse8")"
+        "}";
+
+    string actual = serializeSignedTransaction(transaction, "abcd");
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(json::parse(actual)["chainID"], transaction.chainID);
+}
+
 } // namespace TW::MultiversX::tests
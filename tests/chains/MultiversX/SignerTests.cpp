@@ -261,7 +261,7 @@ TEST(MultiversXSigner, SignGenericActionJSON) {
         })";
 
     auto privateKey = PrivateKey(parse_hex(ALICE_SEED_HEX));
-    auto encoded = Signer::signJSON(input, privateKey.bytes);
+    auto encoded = Signer::signJSON(input, Data(privateKey.bytes));
     nlohmann::json expected = R"(
                                     {
                                      "chainID":"1",
@@ -334,7 +334,7 @@ TEST(MultiversXSigner, SignJSONWithoutData) {
         })";
 
     auto privateKey = PrivateKey(parse_hex(ALICE_SEED_HEX));
-    auto encoded = Signer::signJSON(input, privateKey.bytes);
+    auto encoded = Signer::signJSON(input, Data(privateKey.bytes));
     nlohmann::json expected = R"(
                                     {
                                      "chainID":"1",
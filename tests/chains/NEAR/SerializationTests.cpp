@@ -8,6 +8,7 @@
 #include "Base58.h"
 #include "proto/NEAR.pb.h"
 #include "NEAR/Serialization.h"
+#include "PrivateKey.h"
 
 #include <TrustWalletCore/TWHRP.h>
 #include <gtest/gtest.h>
@@ -275,4 +276,37 @@ TEST(NEARSerialization, SerializeDeleteAccountTransaction) {
     ASSERT_EQ(serializedHex, "09000000746573742e6e65617200917b3d268d4b58f7fec1b150bd68d69be3ee5d4cc39855e341538465bb77860d01000000000000000d00000077686174657665722e6e6561720fa473fd26901df296be6adc4cc4df34d040efa2435224b6986910e630c2fef6010000000703000000313233");
 }
 
+TEST(NEARSerialization, SerializeMultipleActionsSignedInPlace) {
+    auto input = Proto::SigningInput();
+    input.set_signer_id("test.near");
+    input.set_nonce(1);
+    input.set_receiver_id("whatever.near");
+
+    Data deposit(16, 0);
+    deposit[0] = 1;
+    input.add_actions()->mutable_transfer()->set_deposit(deposit.data(), deposit.size());
+    auto& functionCall = *input.add_actions()->mutable_function_call();
+    functionCall.set_method_name("qqq");
+    functionCall.set_args(std::string(300, 'a'));
+    functionCall.set_gas(1000);
+    functionCall.set_deposit(deposit.data(), deposit.size());
+    input.add_actions()->mutable_delete_account()->set_beneficiary_id("123");
+
+    auto blockHash = Base58::decode("244ZQ9cgj3CQ6bWBdytfrJMuMQ1jdXLFGnr4HhvtCTnM");
+    input.set_block_hash(blockHash.data(), blockHash.size());
+
+    auto privateKey = Base58::decode("3hoMW1HvnRLSFCLZnvPzWeoGwtdHzke34B2cTHM8rhcbG3TbuLKtShTv3DvyejnXKXKBiV7YPkLeqUHN1ghnqpFv");
+    input.set_private_key(privateKey.data(), 32);
+
+    const auto serialized = transactionData(input);
+    const auto publicKey = PrivateKey(Data(privateKey.begin(), privateKey.begin() + 32)).getPublicKey(TWPublicKeyTypeED25519);
+    auto inPlace = transactionData(input, publicKey, 65);
+    ASSERT_EQ(inPlace, serialized);
+    ASSERT_GE(inPlace.capacity(), serialized.size() + 65);
+
+    const Data signature(64, 0x42);
+    appendSignature(inPlace, signature);
+    ASSERT_EQ(inPlace, signedTransactionData(serialized, signature));
+}
+
 }
@@ -206,6 +206,11 @@ TEST(NEOTransaction, SerializeDeserialize) {
 
     deserializedTransaction.deserialize(serialized);
     EXPECT_EQ(transaction, deserializedTransaction);
+
+    transaction.witnesses.push_back(Witness());
+    transaction.witnesses[0].invocationScript = parse_hex("bdecbb623eee6f9ade28d5a8ff5fb3ea9c9d73af039e0286201b3b0291fb4d4a");
+    transaction.witnesses[0].verificationScript = parse_hex("cbb23e6f9ade28d5a8ff3eac9d73af039e821b1b");
+    EXPECT_EQ(transaction.size(), transaction.serialize().size());
 }
 
 TEST(NEOTransaction, SerializeDeserializeMiner) {
@@ -215,6 +220,7 @@ TEST(NEOTransaction, SerializeDeserializeMiner) {
     std::unique_ptr<Transaction> serializedTransaction(Transaction::deserializeFrom(serialized));
 
     EXPECT_EQ(*deserializedTransaction, *serializedTransaction);
+    EXPECT_EQ(deserializedTransaction->size(), serialized.size());
 
     string notMiner = "1000d11f7a2800000000";
     EXPECT_THROW(
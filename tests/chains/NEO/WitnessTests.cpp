@@ -28,6 +28,12 @@ TEST(NEOWitness, Serialize) {
     witness.invocationScript = parse_hex(invocationScript);
     witness.verificationScript = parse_hex(verificationScript);
     EXPECT_EQ("21" + invocationScript + "13" + verificationScript, hex(witness.serialize()));
+    EXPECT_EQ(witness.size(), witness.serialize().size());
+
+    // appends to the output
+    auto out = parse_hex("ff");
+    witness.serialize(out);
+    EXPECT_EQ("ff21" + invocationScript + "13" + verificationScript, hex(out));
 }
 
 TEST(NEOWitness, Deserialize) {
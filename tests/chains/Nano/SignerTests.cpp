@@ -207,4 +207,43 @@ TEST(NanoSigner, signInvalid7) {
     ASSERT_THROW(Signer signer(input), std::invalid_argument);
 }
 
+TEST(NanoSigner, ValidateWork) {
+    std::array<byte, 32> root;
+    const auto rootData = parse_hex("718cc2121c3e641059bc1c2cfc45666c99e8ae922f7a807b7d07b62c995d79e2");
+    std::copy(rootData.begin(), rootData.end(), root.begin());
+
+    EXPECT_EQ(Signer::workValue(root, 0x2bf29ef00786a6bc), 0xffffffd21c3933f4ull);
+    // above the epoch 1 threshold 0xffffffc000000000, valid for receiving only since epoch 2
+    EXPECT_TRUE(Signer::validateWork(root, 0x2bf29ef00786a6bc, Signer::workThresholdReceive));
+    EXPECT_FALSE(Signer::validateWork(root, 0x2bf29ef00786a6bc));
+    EXPECT_FALSE(Signer::validateWork(root, 0x2bf29ef00786a6bd, Signer::workThresholdReceive));
+    EXPECT_EQ(Signer::workString(0x2bf29ef00786a6bc), "2bf29ef00786a6bc");
+}
+
+TEST(NanoSigner, GenerateWork) {
+    const auto privateKey = PrivateKey(parse_hex(kPrivateKey));
+    const auto linkBlock = parse_hex("491fca2c69a84607d374aaf1f6acd3ce70744c5be0721b5ed394653e85233507");
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+    input.set_link_block(linkBlock.data(), linkBlock.size());
+    input.set_representative(kRepOfficial1);
+    input.set_balance("96242336390000000000000000000");
+    const auto signer = Signer(input);
+
+    // the first block of the account is rooted at the account
+    const auto root = signer.workRoot();
+    EXPECT_EQ(hex(root), hex(signer.publicKey.bytes));
+
+    // low threshold, found after a few hundred attempts
+    const uint64_t threshold = 0xff00000000000000;
+    for (const std::size_t threads : {1, 4}) {
+        const auto work = Signer::generateWork(root, threshold, threads);
+        ASSERT_TRUE(work.has_value());
+        EXPECT_TRUE(Signer::validateWork(root, *work, threshold));
+    }
+
+    const std::atomic<bool> cancelled{true};
+    EXPECT_FALSE(Signer::generateWork(root, Signer::workThresholdSend, 2, &cancelled).has_value());
+}
+
 } // namespace TW::Nano::tests
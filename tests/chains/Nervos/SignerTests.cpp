@@ -7,6 +7,8 @@
 #include "HexCoding.h"
 #include "Nervos/Address.h"
 #include "Nervos/Cell.h"
+#include "Nervos/CellIndex.h"
+#include "Nervos/Constants.h"
 #include "Nervos/Serialization.h"
 #include "Nervos/Signer.h"
 #include "Nervos/Transaction.h"
@@ -176,6 +178,31 @@ TEST(NervosSigner, PlanAndSign_Native_Simple) {
     checkOutput1(tx);
 }
 
+TEST(NervosSigner, PlanWithCellIndex) {
+    auto input = getInput1();
+    const auto cellIndex = CellIndex(input);
+    ASSERT_EQ(cellIndex.byCapacity(), (std::vector<size_t>{1, 0}));
+
+    // the index is reused across plans and the cells of the input are ignored
+    input.clear_cell();
+    for (auto i = 0; i < 2; i++) {
+        TransactionPlan txPlan;
+        txPlan.plan(input, cellIndex);
+        checkPlan1(txPlan);
+        Transaction tx;
+        tx.build(txPlan);
+        Data encoded;
+        tx.encode(encoded);
+        EXPECT_EQ(Hash::blake2b(encoded, 32, Constants::gHashPersonalization), tx.hash());
+        ASSERT_EQ(tx.sign(getPrivateKeys(input), tx.hash()), Common::Proto::SigningError::OK);
+        checkOutput1(tx);
+    }
+
+    TransactionPlan txPlan;
+    txPlan.plan(input);
+    ASSERT_EQ(txPlan.error, Common::Proto::SigningError::Error_missing_input_utxos);
+}
+
 TEST(NervosSigner, Sign_NegativeMissingKey) {
     auto input = getInput1();
     TransactionPlan txPlan;
@@ -58,4 +58,26 @@ TEST(OntologyOnt, transfer) {
               rawTx);
 }
 
+TEST(OntologyOnt, multiTransfer) {
+    auto signer1 = Signer(
+        PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646")));
+    auto signer2 = Signer(
+        PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464652")));
+    auto toAddress1 = Address("Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDn");
+    auto toAddress2 = Address("AVY6LfvxauVQAVHDV9hC3ZCv7cQqzfDotH");
+    uint32_t nonce = 0;
+    uint64_t gasPrice = 500, gasLimit = 20000;
+
+    // a single payout is a transfer
+    auto tx = Ont().multiTransfer(signer1, {{toAddress1, 1}}, signer2, gasPrice, gasLimit, nonce);
+    EXPECT_EQ(hex(tx.serialize()), hex(Ont().transfer(signer1, toAddress1, 1, signer2, gasPrice, gasLimit, nonce).serialize()));
+
+    tx = Ont().multiTransfer(signer1, {{toAddress1, 1}, {toAddress2, 2}}, signer2, gasPrice, gasLimit, nonce);
+    auto rawTx = hex(tx.serialize());
+    // both transfer states, packed in one array
+    EXPECT_NE(rawTx.find("14feec06b79ed299ea06fcb94abac41aaf3ead76586a7cc8516a7cc86c"), std::string::npos);
+    EXPECT_NE(rawTx.find("52c1087472616e73666572"), std::string::npos);
+    EXPECT_EQ(tx.sigVec.size(), 2ul);
+}
+
 } // namespace TW::Ontology::tests
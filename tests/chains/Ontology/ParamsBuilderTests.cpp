@@ -82,6 +82,42 @@ TEST(ParamsBuilder, transferInvokeCode) {
     EXPECT_EQ(hexInvokeCode, hex(invokeCode));
 }
 
+TEST(ParamsBuilder, multiTransferInvokeCode) {
+    auto fromAddress = Address("ANDfjwrUroaVtvBguDtrWKRMyxFwvVwnZD");
+    auto toAddress1 = Address("Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDn");
+    auto toAddress2 = Address("AVY6LfvxauVQAVHDV9hC3ZCv7cQqzfDotH");
+    const auto suffix = ParamsBuilder::buildNativeInvokeSuffix(Ont().contractAddress(), 0x00, "transfer");
+    EXPECT_EQ(hex(suffix), "087472616e736665721400000000000000000000000000000000000000010068164f6e746f6c6f67792e4e61746976652e496e766f6b65");
+
+    auto invokeCode = ParamsBuilder::buildNativeTransferInvokeCode({{fromAddress, toAddress1, 1}}, suffix);
+    EXPECT_EQ(
+        "00c66b1446b1a18af6b7c9f8a4602f9f73eeb3030f0c29b76a7cc814feec06b79ed299ea06fcb94abac41aaf3e"
+        "ad76586a7cc8516a7cc86c51c1087472616e736665721400000000000000000000000000000000000000010068"
+        "164f6e746f6c6f67792e4e61746976652e496e766f6b65",
+        hex(invokeCode));
+
+    // same as the generic encoding of an array of transfer states
+    NeoVmParamValue::ParamArray args{
+        NeoVmParamValue::ParamList{fromAddress._data, toAddress1._data, uint64_t(1)},
+        NeoVmParamValue::ParamList{fromAddress._data, toAddress2._data, uint64_t(1000000000)}};
+    invokeCode = ParamsBuilder::buildNativeTransferInvokeCode({{fromAddress, toAddress1, 1}, {fromAddress, toAddress2, 1000000000}}, suffix);
+    EXPECT_EQ(hex(ParamsBuilder::buildNativeInvokeCode(Ont().contractAddress(), 0x00, "transfer", {args})), hex(invokeCode));
+}
+
+TEST(ParamsBuilder, reuse) {
+    ParamsBuilder builder;
+    builder.reserve(64);
+    builder.push(std::string("transfer"));
+    EXPECT_EQ(builder.size(), 9ul);
+    EXPECT_EQ(hex(builder.takeBytes()), "087472616e73666572");
+
+    builder.cleanUp();
+    builder.push(uint64_t(1000));
+    EXPECT_EQ(hex(builder.getBytes()), "02e803");
+    builder.cleanUp();
+    EXPECT_EQ(builder.size(), 0ul);
+}
+
 TEST(ParamsBuilder, invokeOep4Code) {
     std::string wing_hex{"ff31ec74d01f7b7d45ed2add930f5d2239f7de33"};
     auto wing_addr = Address(parse_hex(wing_hex));
@@ -4,6 +4,7 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "HDWallet.h"
 #include "HexCoding.h"
 #include "Polkadot/Address.h"
 #include "PublicKey.h"
@@ -49,4 +50,17 @@ TEST(PolkadotAddress, FromString) {
     ASSERT_EQ(address.string(), "15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyu");
 }
 
+TEST(PolkadotAddress, DeriveAddresses) {
+    const auto wallet = HDWallet("chief menu kingdom stereo hope hazard into island bag trick egg route", "");
+    // more than one batch of checksums
+    const auto addresses = wallet.deriveAddresses(TWCoinTypePolkadot, TWDerivationDefault, 0, 0, 3, 70, 2);
+    ASSERT_EQ(addresses.size(), 70ul);
+    for (const auto i : {0u, 1u, 63u, 64u, 69u}) {
+        const auto path = DerivationPath("m/44'/354'/0'/0'/" + std::to_string(3 + i) + "'");
+        const auto publicKey = wallet.getKey(TWCoinTypePolkadot, path).getPublicKey(TWPublicKeyTypeED25519);
+        EXPECT_EQ(addresses[i], Address(publicKey).string());
+    }
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypePolkadot, TWDerivationDefault, 0, 0, 0, 1)[0], wallet.deriveAddress(TWCoinTypePolkadot));
+}
+
 } // namespace TW::Polkadot::tests
@@ -143,4 +143,61 @@ TEST(SS58Address, EncodeNetwork) {
     EXPECT_FALSE(SS58Address::encodeNetwork(0x8000, data));
 }
 
+TEST(SS58Address, Strings) {
+    std::vector<SS58Address> addresses;
+    for (const auto network : {0u, 2u, 42u, 5000u, 0u, 2u}) {
+        const auto publicKey = PublicKey(Data(32, static_cast<byte>(addresses.size() + 1)), TWPublicKeyTypeED25519);
+        addresses.emplace_back(publicKey, network);
+    }
+    const auto strings = SS58Address::strings(addresses);
+    ASSERT_EQ(strings.size(), addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        EXPECT_EQ(strings[i], addresses[i].string());
+    }
+    EXPECT_TRUE(SS58Address::strings({}).empty());
+}
+
+TEST(SS58Address, EncodeBatch) {
+    const auto publicKey = PublicKey(parse_hex(pubkeyString1), TWPublicKeyTypeED25519);
+    const std::vector<PublicKey> publicKeys(6, publicKey);
+    const std::vector<uint32_t> networks{0, 5, 172, 5, 0, 172};
+    const auto strings = SS58Address::encodeBatch(publicKeys, networks);
+    ASSERT_EQ(strings.size(), publicKeys.size());
+    for (size_t i = 0; i < publicKeys.size(); ++i) {
+        EXPECT_EQ(strings[i], SS58Address(publicKey, networks[i]).string());
+    }
+    EXPECT_EQ(strings[0], "14KjL5vGAYJCbKgZJmFKDSjewtBpvaxx9YvRZvi7qmb5s8CC");
+    EXPECT_EQ(strings[2], "p8EGHjWt7e1MYoD7V6WXvbPZWK9GSJiiK85kv2R7Ur7FisPUL");
+    EXPECT_TRUE(SS58Address::encodeBatch({}, {}).empty());
+
+    EXPECT_EXCEPTION(SS58Address::encodeBatch(publicKeys, std::vector<uint32_t>{0}), "SS58Address expects a network for each public key.");
+    EXPECT_EXCEPTION(SS58Address::encodeBatch(std::vector<PublicKey>{publicKey}, std::vector<uint32_t>{32771}), "network out of range 32771");
+    const auto secp256k1 = PublicKey(parse_hex("0298b09bba5e4a9a2e9d6d2a4ce1c1e1fb5f11ac42ff4c3e7a9b1b7f0f1f0c4f3b"), TWPublicKeyTypeSECP256k1);
+    EXPECT_EXCEPTION(SS58Address::encodeBatch(std::vector<PublicKey>{secp256k1}, std::vector<uint32_t>{0}), "SS58Address expects an ed25519 public key.");
+}
+
+TEST(SS58Address, ValidateBatch) {
+    const std::vector<std::string> strings{
+        "15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyu",
+        "ZG2d3dH5zfqNchsqReS6x4nBJuJCW7Z6Fh5eLvdA3ZXGkPd",
+        "ZG2d3dH5zfqNchsqReS6x4nBJuJCW7Z6Fh5eLvdA3ZXGkPd",
+        "cEYtw6AVMB27hFUs4gVukajLM7GqxwxUfJkbPY3rNToHMcCgb",
+        "p8EGHjWt7e1MYoD7V6WXvbPZWK9GSJiiK85kv2R7Ur7FisPUL",
+        "VDSyeURSP7ykE1zJPJGeqx6GcDZQF2DT3hAKhPMuwM5FuN9HE",
+        "YDTv3GdhXPP3pQMqQtntGVg5hMno4jqanfYUgMPX2rLGJBKX6",
+        "JCViCkwMdGWKpf7Wogb8EFtDmaYTEZGEg6ah4svUPGnnpc7A",
+        "15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyv",
+        "0OIl",
+        "",
+    };
+    const std::vector<uint32_t> networks{0, 5, 6, 64, 172, 4096, 8219, 64, 0, 0, 0};
+    const auto valid = SS58Address::validateBatch(strings, networks);
+    ASSERT_EQ(valid.size(), strings.size());
+    for (size_t i = 0; i < strings.size(); ++i) {
+        EXPECT_EQ(valid[i], SS58Address::isValid(strings[i], networks[i])) << strings[i];
+    }
+    EXPECT_EQ(valid, (std::vector<bool>{true, true, false, true, true, true, true, false, false, false, false}));
+    EXPECT_EXCEPTION(SS58Address::validateBatch(strings, std::vector<uint32_t>{0}), "SS58Address expects a network for each string.");
+}
+
 } // namespace TW::Polkadot::tests
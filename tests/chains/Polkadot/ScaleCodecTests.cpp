@@ -39,6 +39,20 @@ TEST(PolkadotCodec, EncodeCompact) {
     ASSERT_EQ(hex(encodeCompact(18446744073709551615u)), "13ffffffffffffffff");
 }
 
+TEST(PolkadotCodec, EncodeCompactAppend) {
+    const std::vector<uint64_t> values = {0, 63, 64, 16383, 16384, 1073741823, 1073741824, 4294967296, 18446744073709551615u};
+    for (auto value : values) {
+        Data data = {0xff};
+        encodeCompact(value, data);
+        ASSERT_EQ(data.size(), 1 + compactSize(value));
+        ASSERT_EQ(Data(data.begin() + 1, data.end()), encodeCompact(CompactInteger(value)));
+    }
+
+    auto big = CompactInteger(1) << 64;
+    ASSERT_EQ(hex(encodeCompact(big)), "17000000000000000001");
+    ASSERT_EQ(compactSize(big), 10ul);
+}
+
 TEST(PolkadotCodec, EncodeBool) {
     ASSERT_EQ(hex(encodeBool(true)), "01");    
     ASSERT_EQ(hex(encodeBool(false)), "00");
@@ -337,4 +337,45 @@ TEST(PolkadotSigner, SignChillAndUnbond) {
     ASSERT_EQ(hex(output.encoded()), "d10184008361bd08ddca5fda28b5e2aa84dc2621de566e23e089e555a42194c3eaf2da7900c891ba102db672e378945d74cf7f399226a76b43cab502436971599255451597fc2599902e4b62c7ce85ecc3f653c693fef3232be620984b5bb5bcecbbd7b209d50318001a02080706070207004d446617");
 }
 
+TEST(PolkadotSigner, SignBatch) {
+    auto blockHash = parse_hex("7d5fa17b70251d0806f26156b1b698dfd09e040642fa092595ce0a78e9e84fcd");
+
+    auto input = Proto::SigningInput();
+    input.set_genesis_hash(genesisHash.data(), genesisHash.size());
+    input.set_block_hash(blockHash.data(), blockHash.size());
+    input.set_nonce(1);
+    input.set_spec_version(28);
+    input.set_private_key(privateKeyIOS.bytes.data(), privateKeyIOS.bytes.size());
+    input.set_network(ss58Prefix(TWCoinTypePolkadot));
+    input.set_transaction_version(6);
+
+    auto& era = *input.mutable_era();
+    era.set_block_number(3910736);
+    era.set_period(64);
+
+    auto& transfer = *input.mutable_balance_call()->mutable_transfer();
+    auto value = store(uint256_t(10000000000));
+    transfer.set_to_address("13ZLCqJNPsRZYEbwjtZZFpWt9GyFzg5WahXCVWKpWdUJqrQ5");
+    transfer.set_value(value.data(), value.size());
+
+    auto transferInput = input;
+    auto bondInput = input;
+    bondInput.set_nonce(2);
+    auto& bond = *bondInput.mutable_staking_call()->mutable_bond();
+    bond.set_controller(addressThrow2);
+    bond.set_value(value.data(), value.size());
+    bond.set_reward_destination(Proto::RewardDestination::STASH);
+
+    const auto outputs = Signer::signBatch(input, {
+        {Extrinsic::encodeCall(transferInput), transferInput.nonce()},
+        {Extrinsic::encodeCall(bondInput), bondInput.nonce()},
+    });
+
+    ASSERT_EQ(outputs.size(), 2ul);
+    // same as SignTransfer_72dd5b
+    EXPECT_EQ(hex(outputs[0].encoded()), "410284008d96660f14babe708b5e61853c9f5929bc90dd9874485bf4d6dc32d3e6f22eaa0038ec4973ab9773dfcbf170b8d27d36d89b85c3145e038d68914de83cf1f7aca24af64c55ec51ba9f45c5a4d74a9917dee380e9171108921c3e5546e05be15206050104000500007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0700e40b5402");
+    EXPECT_EQ(hex(outputs[0].encoded()), hex(Signer::sign(transferInput).encoded()));
+    EXPECT_EQ(hex(outputs[1].encoded()), hex(Signer::sign(bondInput).encoded()));
+}
+
 } // namespace Polkadot::tests
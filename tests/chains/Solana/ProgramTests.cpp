@@ -8,6 +8,9 @@
 #include "PrivateKey.h"
 #include "Solana/Address.h"
 #include "Solana/Program.h"
+#include "Solana/ProgramAddressCache.h"
+
+#include <TrustWalletCore/TWMemoryStats.h>
 
 #include <gtest/gtest.h>
 
@@ -47,6 +50,50 @@ TEST(SolanaTokenProgram, defaultTokenAddress) {
               "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
 }
 
+TEST(SolanaTokenProgram, defaultTokenAddresses) {
+    const Address serumToken = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const std::vector<Address> mainAddresses = {
+        Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp"),
+        Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V"),
+        Address("Eg5jqooyG6ySaXKbQUu4Lpvu2SqUPZrNkM4zXs9iUDLJ"),
+    };
+    for (const auto threads : {1ul, 0ul}) {
+        ProgramAddressCache::shared().clear();
+        const auto addresses = TokenProgram::defaultTokenAddresses(mainAddresses, serumToken, threads);
+        ASSERT_EQ(addresses.size(), 3ul);
+        EXPECT_EQ(addresses[0].string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+        EXPECT_EQ(addresses[1].string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+        EXPECT_EQ(addresses[2].string(), "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+        EXPECT_EQ(ProgramAddressCache::shared().size(), 3ul);
+    }
+}
+
+TEST(SolanaTokenProgram, ProgramAddressCache) {
+    const Address serumToken = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const Address mainAddress = Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp");
+    auto& cache = ProgramAddressCache::shared();
+    cache.clear();
+    const auto first = TokenProgram::defaultTokenAddress(mainAddress, serumToken);
+    EXPECT_EQ(cache.size(), 1ul);
+    EXPECT_EQ(TokenProgram::defaultTokenAddress(mainAddress, serumToken), first);
+    EXPECT_EQ(cache.size(), 1ul);
+    // the shared cache registers with the memory stats
+    EXPECT_EQ(TWMemoryStatsCache(TWMemoryCacheProgramAddress).entries, 1ul);
+    TWMemoryStatsFlush(TWMemoryCacheProgramAddress);
+    EXPECT_EQ(cache.size(), 0ul);
+
+    ProgramAddressCache small(2);
+    small.insert(Data{1}, mainAddress);
+    small.insert(Data{2}, serumToken);
+    ASSERT_TRUE(small.find(Data{1}).has_value());
+    // evicts the least recently used key 2
+    small.insert(Data{3}, first);
+    EXPECT_EQ(small.size(), 2ul);
+    EXPECT_EQ(*small.find(Data{1}), mainAddress);
+    EXPECT_FALSE(small.find(Data{2}).has_value());
+    EXPECT_EQ(*small.find(Data{3}), first);
+}
+
 TEST(SolanaTokenProgram, findProgramAddress) {
     std::vector<Data> seeds = {
         Base58::decode("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V"),
@@ -244,6 +244,40 @@ TEST(SolanaSigner, SignUpdateBlockhash) {
     ASSERT_EQ(transaction.serialize(), expectedString);
 }
 
+TEST(SolanaSigner, SignUpdateBlockhashCompiledMessage) {
+    const auto privateKey =
+        PrivateKey(Base58::decode("G4VSzrknPBWZ1z2YwUnWTxD1td7wmqR5jMPEJRN6wm8S"));
+    const auto from = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+    const auto to = Address("4iSnyfDKaejniaPc2pBBckwQqV3mDS93go15NdxWJq2y");
+    const auto message = LegacyMessage::createTransfer(from, to, 42, Base58::decode("11111111111111111111111111111111"));
+    const std::vector<PrivateKey> signerKeys{privateKey};
+
+    auto compiled = CompiledMessage(message);
+    auto newBlockhash = Base58::decode("GgBaCs3NCBuZN12kCJgAW63ydqohFkHEdfdEXBPzLHq");
+    // same as SignUpdateBlockhash
+    auto expectedString =
+        "62ABadDCoPfGGRnhLoBhfcPekMHyN5ee8DgTY8wD4iwKDjyFAsNbsaahTcqMWxmwa61q9iAGCQB"
+        "v1bETcYzWsTwLKMVGLoEpwqA84mPjqHyr5sQD5dcghyQiQ1ckYNub9K7s8FspVwwowK8gJG69xe"
+        "DEaqi7G1zrChBVbQYTmVUwJETyDmP1Vs8QU3CaxBs8qwcxoziU52KWLBpRj9o38QVBdxJtJ7hig"
+        "hgPKJubfqUfTWdN94PzqEfyPqwoCpFD39nvBn8C5xe1caPKivicg6U7Lzm9s8RYTLCEB";
+    EXPECT_EQ(Signer::signUpdateBlockhash(signerKeys, compiled, newBlockhash), expectedString);
+    EXPECT_EQ(compiled.recentBlockhash(), newBlockhash);
+
+    // versioned message: same as a transaction signed after updating its blockhash
+    for (auto i = 0; i < 3; ++i) {
+        newBlockhash[i] ^= 0x5a;
+        auto transaction = VersionedTransaction(VersionedMessage(V0Message{.msg = message}));
+        auto compiledV0 = CompiledMessage(transaction.message);
+        Signer::signUpdateBlockhash(signerKeys, transaction, newBlockhash);
+        EXPECT_EQ(Signer::signUpdateBlockhash(signerKeys, compiledV0, newBlockhash), transaction.serialize());
+        EXPECT_EQ(compiledV0.messageData(), transaction.messageData());
+    }
+
+    EXPECT_THROW(compiled.updateBlockhash(Data(31)), std::invalid_argument);
+    const auto otherKey = PrivateKey(Base58::decode("96PKHuMPtniu1T74RvUNkbDPXPPRZ8Mg1zXwciCAyaDq"));
+    EXPECT_THROW(compiled.sign({otherKey}), std::invalid_argument);
+}
+
 TEST(SolanaSigner, SignRawMessage) {
     const auto privateKey =
         PrivateKey(Base58::decode("GjXseuD8JavBjKMdd6GEsPYZPV7tMMa46GS2JRS5tHRq"));
@@ -4,9 +4,11 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Solana/AccountIndex.h"
 #include "Solana/Address.h"
 #include "Solana/Transaction.h"
 #include "Solana/Program.h"
+#include "Solana/TransactionPacker.h"
 #include "HexCoding.h"
 
 #include "BinaryCoding.h"
@@ -179,4 +181,110 @@ TEST(SolanaTransaction, TransferTokenTransaction_3vZ67C) {
     EXPECT_EQ(transaction.serialize(), expectedString);
 }
 
+TEST(SolanaTransaction, AccountIndex) {
+    std::vector<Address> addresses;
+    for (auto i = 0; i < 100; ++i) {
+        // program-id like keys, differing in one byte only
+        auto key = Data(32, 0);
+        key[i % 32] = static_cast<byte>(i + 1);
+        addresses.emplace_back(key);
+    }
+    addresses.push_back(addresses[5]);
+
+    const auto index = AccountIndex(addresses);
+    ASSERT_EQ(index.size(), 100ul);
+    for (auto i = 0ul; i < 100; ++i) {
+        EXPECT_EQ(index.find(addresses[i]), i);
+    }
+    EXPECT_EQ(index.find(Address(Data(32, 0))), std::nullopt);
+    EXPECT_EQ(AccountIndex().find(addresses[0]), std::nullopt);
+
+    auto copy = index;
+    EXPECT_EQ(copy.insert(addresses[7]), std::make_pair(7ul, false));
+    EXPECT_EQ(copy.insert(Address(Data(32, 0))), std::make_pair(100ul, true));
+    EXPECT_EQ(copy.addresses().size(), 101ul);
+}
+
+static Address packerAddress(byte tag, byte index) {
+    auto key = Data(32, 0);
+    key[0] = tag;
+    key[1] = index;
+    return Address(key);
+}
+
+static std::size_t serializedSize(const VersionedTransaction& transaction) {
+    return Base58::decode(transaction.serialize()).size();
+}
+
+TEST(SolanaTransaction, PackTokenTransfers) {
+    const auto owner = packerAddress(1, 0);
+    const auto senderToken = packerAddress(2, 0);
+    const auto mint = packerAddress(3, 0);
+    const auto recentBlockhash = Base58::decode("11111111111111111111111111111111");
+    std::vector<Instruction> instructions;
+    std::vector<Address> recipients;
+    for (byte i = 0; i < 50; ++i) {
+        recipients.push_back(packerAddress(4, i));
+        instructions.push_back(Instruction::createTokenTransfer({
+            AccountMeta(senderToken, false, false),
+            AccountMeta(mint, false, true),
+            AccountMeta(recipients.back(), false, false),
+            AccountMeta(owner, true, false),
+        }, 1000 + i, 6));
+    }
+
+    // legacy transactions: the size tracked while adding is the serialized one
+    auto packer = TransactionPacker(owner);
+    std::size_t packed = 0;
+    std::vector<std::size_t> counts;
+    while (packed < instructions.size()) {
+        std::size_t count = 0;
+        while (packed < instructions.size() && packer.add(instructions[packed])) {
+            ++packed;
+            ++count;
+        }
+        const auto size = packer.size();
+        EXPECT_LE(size, TransactionPacker::maxTransactionSize);
+        const auto transaction = VersionedTransaction(packer.take(recentBlockhash));
+        EXPECT_EQ(serializedSize(transaction), size);
+        EXPECT_EQ(transaction.signatures.size(), 1ul);
+        EXPECT_EQ(Solana::accountKeys(transaction.message)[0], owner);
+        counts.push_back(count);
+    }
+    EXPECT_EQ(counts, (std::vector<std::size_t>{20, 20, 10}));
+
+    const auto transactions = TransactionPacker::pack(instructions, owner, recentBlockhash);
+    ASSERT_EQ(transactions.size(), 3ul);
+    EXPECT_EQ(std::get<LegacyMessage>(transactions[2].message).instructions.size(), 10ul);
+
+    // versioned transactions loading the recipients from a lookup table
+    const auto table = AddressLookupTable{packerAddress(5, 0), recipients};
+    const auto versioned = TransactionPacker::pack(instructions, owner, recentBlockhash, {table});
+    ASSERT_EQ(versioned.size(), 1ul);
+    const auto& message = std::get<V0Message>(versioned[0].message);
+    EXPECT_EQ(message.msg.accountKeys.size(), 4ul);
+    ASSERT_EQ(message.addressTableLookups.size(), 1ul);
+    EXPECT_EQ(message.addressTableLookups[0].accountKey, table.key);
+    EXPECT_EQ(message.addressTableLookups[0].writableIndexes.size(), 50ul);
+    EXPECT_EQ(message.addressTableLookups[0].readOnlyIndexes.size(), 0ul);
+    // the recipient of the last transfer is the last loaded account
+    EXPECT_EQ(message.msg.compiledInstructions[49].accounts[2], 4 + 49);
+    EXPECT_LE(serializedSize(versioned[0]), TransactionPacker::maxTransactionSize);
+
+    auto versionedPacker = TransactionPacker(owner, {table});
+    for (const auto& instruction : instructions) {
+        ASSERT_TRUE(versionedPacker.add(instruction));
+    }
+    const auto size = versionedPacker.size();
+    EXPECT_EQ(serializedSize(VersionedTransaction(versionedPacker.take(recentBlockhash))), size);
+    EXPECT_TRUE(versionedPacker.empty());
+}
+
+TEST(SolanaTransaction, PackInstructionTooLarge) {
+    const auto owner = packerAddress(1, 0);
+    const auto memo = Instruction::createMemo(std::string(1200, 'm'));
+    EXPECT_THROW(TransactionPacker::pack({memo}, owner, Data(32)), std::invalid_argument);
+    EXPECT_TRUE(TransactionPacker::pack({}, owner, Data(32)).empty());
+}
+
 } // namespace TW::Solana
@@ -142,4 +142,36 @@ TEST(StellarTransaction, signAcreateAccount) {
     ASSERT_EQ(signature, "AAAAAAmpZryqzBA+OIlrquP4wvBsIf1H3U+GT/DTP5gZ31yiAAAD6AAAAAAAAAACAAAAAAAAAAIAAAAASZYC0gAAAAEAAAAAAAAAAAAAAADFgLYxeg6zm/f81Po8Gf2rS4m7q79hCV7kUFr27O16rgAAAAAAmJaAAAAAAAAAAAEZ31yiAAAAQNgqNDqbe0X60gyH+1xf2Tv2RndFiJmyfbrvVjsTfjZAVRrS2zE9hHlqPQKpZkGKEFka7+1ElOS+/m/1JDnauQg=");
 }
 
+TEST(StellarTransaction, networkId) {
+    // the same for every call
+    EXPECT_EQ(hex(Signer::networkId(TWStellarPassphrase_Stellar)), "7ac33997544e3175d266bd022439b22cdb16508c01163f26e5cb2a3e1045a979");
+    EXPECT_EQ(hex(Signer::networkId(TWStellarPassphrase_Stellar)), "7ac33997544e3175d266bd022439b22cdb16508c01163f26e5cb2a3e1045a979");
+    EXPECT_EQ(hex(Signer::networkId("Test SDF Network ; September 2015")), "cee0302d59844d32bdca915c8203dd44b33fbb7edc19051ea37abedf28ecd472");
+}
+
+TEST(StellarTransaction, encodedSize) {
+    auto input = Proto::SigningInput();
+    input.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    input.set_fee(1000);
+    input.set_sequence(2);
+    input.mutable_memo_text()->set_text("Hello, world!");
+    input.mutable_op_payment()->set_destination("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+    input.mutable_op_payment()->mutable_asset()->set_issuer("GA6HCMBLTZS5VYYBCATRBRZ3BZJMAFUDKYYF6AH6MVCMGWMRDNSWJPIH");
+    input.mutable_op_payment()->mutable_asset()->set_alphanum4("MOBI");
+    input.mutable_op_payment()->set_amount(10000000);
+    const auto signer = Signer(input);
+    EXPECT_EQ(signer.encode(input).size(), Signer::encodedSize(input));
+
+    input.mutable_memo_id()->set_id(1234);
+    auto& claimable = *input.mutable_op_create_claimable_balance();
+    claimable.set_amount(10000000);
+    claimable.add_claimants()->set_account("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+    claimable.add_claimants()->set_account("GA6HCMBLTZS5VYYBCATRBRZ3BZJMAFUDKYYF6AH6MVCMGWMRDNSWJPIH");
+    EXPECT_EQ(signer.encode(input).size(), Signer::encodedSize(input));
+
+    input.mutable_op_change_trust()->set_valid_before(1613336576);
+    input.mutable_op_change_trust()->mutable_asset()->set_alphanum4("MOBI");
+    EXPECT_EQ(signer.encode(input).size(), Signer::encodedSize(input));
+}
+
 } // namespace TW::Stellar::tests
@@ -75,6 +75,18 @@ TEST(Forging, ForgeZarithLarge) {
     ASSERT_EQ(hex(output), expected);
 }
 
+TEST(Forging, ForgeZarithMax) {
+    ASSERT_EQ(hex(forgeZarith(UINT64_MAX)), "ffffffffffffffffff01");
+}
+
+TEST(Forging, ForgeAppends) {
+    Data forged{0xaa};
+    forgeZarith(2107451, forged);
+    forgePublicKeyHash("tz1eZwq8b5cvE2bPKokatLkVMzkxz24z3Don", forged);
+    forgeEntrypoint("transfer", forged);
+    ASSERT_EQ(hex(forged), "aabbd0800100cfa4aae60f5d9389752d41e320da224d43287fe2ff087472616e73666572");
+}
+
 TEST(Forging, forge_tz1) {
     auto expected = "00cfa4aae60f5d9389752d41e320da224d43287fe2";
 
@@ -132,6 +144,29 @@ TEST(Forging, ForgeMichelsonFA12) {
     data.set_value("123");
     auto v = FA12ParameterToMichelson(data);
     ASSERT_EQ(hex(forgeMichelson(v)), "07070100000024747a31696f7a36326b447736476d35484170655174633150476d4e32775042744a4b555007070100000024747a31696f7a36326b447736476d35484170655174633150476d4e32775042744a4b555000bb01");
+
+    Data forged{0xff};
+    forgeArray(v, forged);
+    ASSERT_EQ(Data(forged.begin() + 1, forged.end()), forgeArray(forgeMichelson(v)));
+
+    Data direct;
+    forgeFA12Parameters(data, direct);
+    ASSERT_EQ(hex(direct), hex(forgeArray(forgeMichelson(v))));
+}
+
+TEST(Forging, ForgeFA2ParametersDirect) {
+    Tezos::Proto::FA2Parameters data;
+    data.set_entrypoint("transfer");
+    auto& txObject = *data.add_txs_object();
+    txObject.set_from("tz1ioz62kDw6Gm5HApeQtc1PGmN2wPBtJKUP");
+    auto& tx = *txObject.add_txs();
+    tx.set_amount("-1234567890123456789");
+    tx.set_token_id("42");
+    tx.set_to("tz2Rh3NYeLxrqTuvaZJmaMiVMqCajeXMWtYo");
+
+    Data direct;
+    forgeFA2Parameters(data, direct);
+    ASSERT_EQ(hex(direct), hex(forgeArray(forgeMichelson(FA2ParameterToMichelson(data)))));
 }
 
 TEST(TezosTransaction, forgeTransaction) {
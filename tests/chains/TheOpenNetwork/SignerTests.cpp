@@ -6,7 +6,9 @@
 
 #include "HexCoding.h"
 
+#include "TheOpenNetwork/Payloads.h"
 #include "TheOpenNetwork/Signer.h"
+#include "TheOpenNetwork/wallet/WalletV4R2.h"
 #include "Everscale/CommonTON/Cell.h"
 
 #include <gtest/gtest.h>
@@ -170,4 +172,128 @@ TEST(TheOpenNetworkSigner, InvalidWalletVersion) {
     ASSERT_EQ(output.error(), 22);
 }
 
+TEST(TheOpenNetworkSigner, BatchSinglePayoutMatchesTransfer) {
+    auto input = Proto::SigningInput();
+
+    auto& batch = *input.mutable_batch();
+    batch.set_wallet_version(Proto::WALLET_V4_R2);
+    batch.set_sequence_number(6);
+    batch.set_expire_at(1671132440);
+    auto& payout = *batch.add_payouts();
+    payout.set_dest("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    payout.set_amount(10);
+    payout.set_mode(Proto::SendMode::PAY_FEES_SEPARATELY | Proto::SendMode::IGNORE_ACTION_PHASE_ERRORS);
+    payout.set_bounceable(true);
+
+    const auto privateKey = parse_hex("c38f49de2fb13223a9e7d37d5d0ffbdd89a5eb7c8b0ee4d1c299f2cefe7dc4a0");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    auto output = Signer::sign(input);
+
+    // same as TransferOrdinary
+    ASSERT_EQ(output.encoded_messages_size(), 1);
+    EXPECT_EQ(output.encoded_messages(0), "te6ccgICAAQAAQAAALAAAAFFiAGwt/q8k4SrjbFbQCjJZfQr64ExRxcUMsWqaQODqTUijgwAAQGcEUPkil2aZ4s8KKparSep/OKHMC8vuXafFbW2HGp/9AcTRv0J5T4dwyW1G0JpHw+g5Ov6QI3Xo0O9RFr3KidICimpoxdjm3UYAAAABgADAAIBYmIAM33x4uAd+uQTyXyCZPxflESlNVHpCeoOECtNsqVW9tmIUAAAAAAAAAAAAAAAAAEAAwAA");
+}
+
+TEST(TheOpenNetworkSigner, BatchPacksPayouts) {
+    auto input = Proto::SigningInput();
+
+    auto& batch = *input.mutable_batch();
+    batch.set_wallet_version(Proto::WALLET_V4_R2);
+    batch.set_sequence_number(6);
+    batch.set_expire_at(1671132440);
+    for (auto i = 0; i < 5; ++i) {
+        auto& payout = *batch.add_payouts();
+        payout.set_dest("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+        payout.set_amount(10 + i);
+        payout.set_mode(Proto::SendMode::PAY_FEES_SEPARATELY);
+        payout.set_comment("payout " + std::to_string(i));
+    }
+    auto& jettonPayout = *batch.add_payouts();
+    jettonPayout.set_dest("EQBiaD8PO1NwfbxSkwbcNT9rXDjqhiIvXWymNO-edV0H5lja");
+    jettonPayout.set_amount(100000000);
+    jettonPayout.set_mode(Proto::SendMode::PAY_FEES_SEPARATELY);
+    jettonPayout.set_bounceable(true);
+    auto& jetton = *jettonPayout.mutable_jetton_transfer();
+    jetton.set_jetton_amount(500);
+    jetton.set_to_owner("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    jetton.set_response_address("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    jetton.set_forward_amount(1);
+
+    const auto privateKey = parse_hex("c38f49de2fb13223a9e7d37d5d0ffbdd89a5eb7c8b0ee4d1c299f2cefe7dc4a0");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    auto output = Signer::sign(input);
+
+    ASSERT_EQ(output.error(), Common::Proto::OK);
+    ASSERT_EQ(output.encoded_messages_size(), 2);
+    for (auto i = 0; i < 2; ++i) {
+        const auto message = CommonTON::Cell::fromBase64(output.encoded_messages(i));
+        ASSERT_NE(message, nullptr);
+        // body reference: signature and signed payload, with one reference per internal message
+        EXPECT_EQ(message->references[0]->refCount, i == 0 ? 4 : 2);
+    }
+}
+
+TEST(TheOpenNetworkSigner, BatchJettonWalletDerived) {
+    auto input = Proto::SigningInput();
+
+    auto& batch = *input.mutable_batch();
+    batch.set_wallet_version(Proto::WALLET_V4_R2);
+    batch.set_sequence_number(1);
+    batch.set_expire_at(1671132440);
+    auto& payout = *batch.add_payouts();
+    payout.set_amount(100000000);
+    payout.set_bounceable(true);
+    auto& jetton = *payout.mutable_jetton_transfer();
+    jetton.set_jetton_amount(500);
+    jetton.set_to_owner("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    jetton.set_response_address("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+
+    const auto privateKey = parse_hex("c38f49de2fb13223a9e7d37d5d0ffbdd89a5eb7c8b0ee4d1c299f2cefe7dc4a0");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    // no jetton wallet address nor jetton master
+    auto output = Signer::sign(input);
+    EXPECT_EQ(output.error(), Common::Proto::Error_invalid_params);
+    EXPECT_EQ(output.encoded_messages_size(), 0);
+
+    batch.set_jetton_master("EQBiaD8PO1NwfbxSkwbcNT9rXDjqhiIvXWymNO-edV0H5lja");
+    batch.set_jetton_wallet_code(WalletV4R2::code.data(), WalletV4R2::code.size());
+    output = Signer::sign(input);
+    EXPECT_EQ(output.error(), Common::Proto::OK);
+    EXPECT_EQ(output.encoded_messages_size(), 1);
+}
+
+TEST(TheOpenNetworkPayloads, JettonWalletAddress) {
+    // any code works for the address computation, the wallet code stands in for a jetton wallet code
+    const auto master = Address("EQBiaD8PO1NwfbxSkwbcNT9rXDjqhiIvXWymNO-edV0H5lja");
+    const auto owner = Address("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    const auto addresses = JettonWalletAddresses(master, WalletV4R2::code);
+
+    const auto code = Cell::deserialize(WalletV4R2::code.data(), WalletV4R2::code.size());
+    CellBuilder dataBuilder;
+    dataBuilder.appendU128(0);
+    for (const auto* address : {&owner, &master}) {
+        dataBuilder.appendRaw(Data{0x80}, 2);
+        dataBuilder.appendBitZero();
+        dataBuilder.appendI8(address->addressData.workchainId);
+        dataBuilder.appendRaw(Data(address->addressData.hash.begin(), address->addressData.hash.end()), 256);
+    }
+    dataBuilder.appendReferenceCell(code);
+    const auto stateInit = StateInit{code, dataBuilder.intoCell()}.writeTo().intoCell();
+
+    EXPECT_EQ(hex(addresses.walletOf(owner).addressData.hash), hex(stateInit->hash));
+}
+
+TEST(TheOpenNetworkPayloads, JettonTransfer) {
+    const auto address = Address("EQBm--PFwDv1yCeS-QTJ-L8oiUpqo9IT1BwgVptlSq3ts90Q");
+    const auto body = jettonTransferPayload(address, address, 500, 1, "", 7);
+    // op, query id, amounts of 2 and 1 bytes, two addresses, custom and forward payload flags
+    EXPECT_EQ(body->bitLen, 32 + 64 + (4 + 16) + 267 + 267 + 1 + (4 + 8) + 1);
+    EXPECT_EQ(hex(Data(body->data.begin(), body->data.begin() + 4)), "0f8a7ea5");
+    EXPECT_EQ(body->refCount, 0);
+    EXPECT_EQ(jettonTransferPayload(address, address, 500, 1, "comment", 7)->refCount, 1);
+}
+
 } // namespace TW::TheOpenNetwork::tests
@@ -9,6 +9,7 @@
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "uint256.h"
+#include "proto/Common.pb.h"
 #include "proto/Tron.pb.h"
 #include "Tron/Signer.h"
 
@@ -89,6 +90,14 @@ TEST(TronSigner, SignTransfer) {
 
     ASSERT_EQ(hex(output.id()), "dc6f6d9325ee44ab3c00528472be16e1572ab076aa161ccd12515029869d0451");
     ASSERT_EQ(hex(output.signature()), "ede769f6df28aefe6a846be169958c155e23e7e5c9621d2e8dce1719b4d952b63e8a8bf9f00e41204ac1bf69b1a663dacdf764367e48e4a5afcd6b055a747fb200");
+
+    EXPECT_FALSE(output.json().empty());
+
+    input.set_skip_outputs(Common::Proto::OutputField_json);
+    const auto outputWithoutJson = Signer::sign(input);
+    EXPECT_EQ(hex(outputWithoutJson.id()), hex(output.id()));
+    EXPECT_EQ(hex(outputWithoutJson.signature()), hex(output.signature()));
+    EXPECT_TRUE(outputWithoutJson.json().empty());
 }
 
 TEST(TronSigner, SignFreezeBalanceV2) {
@@ -516,4 +525,75 @@ TEST(TronSigner, SignTransferTrc20Contract) {
     ASSERT_EQ(hex(output.id()), "0d644290e3cf554f6219c7747f5287589b6e7e30e1b02793b48ba362da6a5058");
     ASSERT_EQ(hex(output.signature()), "bec790877b3a008640781e3948b070740b1f6023c29ecb3f7b5835433c13fc5835e5cad3bd44360ff2ddad5ed7dc9d7dee6878f90e86a40355b7697f5954b88c01");
 }
+
+TEST(TronSigner, SignWithoutJson) {
+    auto input = Proto::SigningInput();
+    auto& transaction = *input.mutable_transaction();
+    auto& transfer = *transaction.mutable_transfer();
+    transfer.set_owner_address("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC");
+    transfer.set_to_address("THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV");
+    transfer.set_amount(2000000);
+    transaction.set_timestamp(1539295479000);
+    transaction.mutable_block_header()->set_number(3111739);
+    const auto privateKey = PrivateKey(parse_hex("2d8f68944bdbfbc0769542fba8fc2d2a3de67393334471624364c7006da2aa54"));
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+
+    const auto output = Signer::sign(input, false);
+    const auto expected = Signer::sign(input);
+    EXPECT_TRUE(output.json().empty());
+    EXPECT_FALSE(expected.json().empty());
+    EXPECT_EQ(hex(output.id()), hex(expected.id()));
+    EXPECT_EQ(hex(output.signature()), hex(expected.signature()));
+}
+
+TEST(TronSigner, TRC20TransferTemplate) {
+    auto blockHeader = Proto::BlockHeader();
+    blockHeader.set_timestamp(1539295479000);
+    const auto txTrieRoot = parse_hex("64288c2db0641316762a99dbb02ef7c90f968b60f9f2e410835980614332f86d");
+    blockHeader.set_tx_trie_root(txTrieRoot.data(), txTrieRoot.size());
+    const auto parentHash = parse_hex("00000000002f7b3af4f5f8b9e23a30c530f719f165b742e7358536b280eead2d");
+    blockHeader.set_parent_hash(parentHash.data(), parentHash.size());
+    blockHeader.set_number(3111739);
+    const auto witnessAddress = parse_hex("415863f6091b8e71766da808b1dd3159790f61de7d");
+    blockHeader.set_witness_address(witnessAddress.data(), witnessAddress.size());
+    blockHeader.set_version(3);
+    const auto privateKey = PrivateKey(parse_hex("2d8f68944bdbfbc0769542fba8fc2d2a3de67393334471624364c7006da2aa54"));
+
+    // Same transaction as TronSigner.SignTransferTrc20Contract
+    const auto transfer = TRC20TransferTemplate("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC", "THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV", 0, blockHeader);
+    const auto output = transfer.sign(privateKey, "TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z", 1000, 1539295479000, 0, false);
+    EXPECT_EQ(hex(output.id()), "0d644290e3cf554f6219c7747f5287589b6e7e30e1b02793b48ba362da6a5058");
+    EXPECT_EQ(hex(output.signature()), "bec790877b3a008640781e3948b070740b1f6023c29ecb3f7b5835433c13fc5835e5cad3bd44360ff2ddad5ed7dc9d7dee6878f90e86a40355b7697f5954b88c01");
+    EXPECT_TRUE(output.json().empty());
+
+    const auto feeLimitTransfer = TRC20TransferTemplate("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC", "THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV", 10000000, blockHeader);
+    for (uint64_t i = 0; i < 3; ++i) {
+        const uint256_t amount = uint256_t(1) << (100 * i);
+        const auto result = feeLimitTransfer.sign(privateKey, "TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z", amount, 1539295479000 + i, 1539295479000 + 1000000 * i);
+
+        auto input = Proto::SigningInput();
+        auto& transaction = *input.mutable_transaction();
+        auto& contract = *transaction.mutable_transfer_trc20_contract();
+        contract.set_owner_address("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC");
+        contract.set_contract_address("THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV");
+        contract.set_to_address("TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z");
+        const auto amountData = store(amount);
+        contract.set_amount(amountData.data(), amountData.size());
+        transaction.set_timestamp(1539295479000 + i);
+        transaction.set_expiration(1539295479000 + 1000000 * i);
+        transaction.set_fee_limit(10000000);
+        *transaction.mutable_block_header() = blockHeader;
+        input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+        const auto expected = Signer::sign(input);
+
+        EXPECT_EQ(hex(result.id()), hex(expected.id()));
+        EXPECT_EQ(hex(result.signature()), hex(expected.signature()));
+        EXPECT_EQ(hex(result.ref_block_bytes()), hex(expected.ref_block_bytes()));
+        EXPECT_EQ(hex(result.ref_block_hash()), hex(expected.ref_block_hash()));
+        EXPECT_EQ(result.json(), expected.json());
+    }
+
+    EXPECT_THROW(transfer.sign(privateKey, "TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9", 1000, 1539295479000, 0), std::invalid_argument);
+}
+
 } // namespace TW::Tron
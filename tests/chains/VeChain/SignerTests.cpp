@@ -31,4 +31,39 @@ TEST(Signer, Sign) {
     ASSERT_EQ(hex(signature), "3181b1094150f8e4f51f370b805cc9c5b107504145b9e316e846d5e5dbeedb5c1c2b5d217f197a105983dfaad6a198414d5731c7447493cb6b5169907d73dbe101");
 }
 
+TEST(Signer, SignBatchManyClauses) {
+    auto input = Proto::SigningInput();
+    input.set_chain_tag(1);
+    input.set_block_ref(1);
+    input.set_expiration(1);
+    input.set_gas(21000);
+    input.set_nonce(1);
+    const auto key = parse_hex("0x4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_private_key(key.data(), key.size());
+    const auto amount = parse_hex("31303030");
+    auto transaction = Transaction();
+    transaction.chainTag = 1;
+    transaction.blockRef = 1;
+    transaction.expiration = 1;
+    transaction.gasPriceCoef = 0;
+    transaction.gas = 21000;
+    transaction.nonce = 1;
+    // long enough for a multi-byte list header
+    for (size_t i = 0; i < 40; ++i) {
+        auto& clause = *input.add_clauses();
+        clause.set_to("0x3535353535353535353535353535353535353535");
+        clause.set_value(amount.data(), amount.size());
+        clause.set_data(std::string(i * 7, 'x'));
+        transaction.clauses.emplace_back(clause);
+    }
+
+    transaction.signature = Signer::sign(PrivateKey(key), transaction);
+    const auto expected = transaction.encode();
+    const auto outputs = Signer::signBatch({input, input});
+    ASSERT_EQ(outputs.size(), 2ul);
+    EXPECT_EQ(hex(outputs[1].encoded()), hex(expected));
+    EXPECT_EQ(hex(outputs[0].signature()), hex(transaction.signature));
+    EXPECT_EQ(Signer::sign(input).encoded(), outputs[0].encoded());
+}
+
 } // namespace TW::VeChain
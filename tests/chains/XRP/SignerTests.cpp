@@ -0,0 +1,49 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "XRP/Signer.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Ripple::tests {
+
+TEST(RippleSigner, SignSequence) {
+    const auto key = PrivateKey(parse_hex("ba005cd605d8a02e3d5dfd04234cef3a3ee4f76bfbad2722d1fb5af8e12e6764"));
+    auto transaction = Transaction(
+        /* fee */10,
+        /* flags */0,
+        /* sequence */32268248,
+        /* last_ledger_sequence */32268269,
+        /* account */Address("rfxdLwsZnoespnTDDb1Xhvbc8EFNdztaoq"));
+    transaction.createXrpPayment(10, "rU893viamSnsfP3zjzM2KPxjqZjXSXK6VF", 0);
+
+    const auto signer = Signer();
+    const auto encoded = signer.signSequence(key, transaction, 3);
+    ASSERT_EQ(encoded.size(), 3ul);
+    for (std::size_t i = 0; i < encoded.size(); ++i) {
+        auto expected = transaction;
+        expected.sequence = transaction.sequence + static_cast<int32_t>(i);
+        signer.sign(key, expected);
+        EXPECT_EQ(hex(encoded[i]), hex(expected.serialize()));
+    }
+}
+
+TEST(RippleSigner, MultiSign) {
+    const auto key = PrivateKey(parse_hex("ba005cd605d8a02e3d5dfd04234cef3a3ee4f76bfbad2722d1fb5af8e12e6764"));
+    auto transaction = Transaction(10, 0, 1, 0, Address("r9LqNeG6qHxjeUocjvVki2XR35weJ9mZgQ"));
+    transaction.createXrpPayment(1000, "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh", 0);
+
+    const auto signature = Signer().multiSign(key, transaction);
+
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto account = Address(publicKey);
+    const auto preImage = transaction.getMultiSigningPreImage(Data(account.bytes.begin() + 1, account.bytes.end()));
+    const auto hash = Hash::sha512(preImage);
+    EXPECT_TRUE(publicKey.verifyAsDER(signature, Data(hash.begin(), hash.begin() + 32)));
+}
+
+} // namespace TW::Ripple::tests
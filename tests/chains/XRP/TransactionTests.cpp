@@ -135,4 +135,52 @@ TEST(RippleTransaction, preImage) {
     ASSERT_EQ(unsignedTx.size(), 114ul);
 }
 
+TEST(RippleTransaction, multiSigningPreImage) {
+    auto tx1 = Transaction(
+        /* fee */10,
+        /* flags */2147483648,
+        /* sequence */1,
+        /* last_ledger_sequence */0,
+        /* account */Address("r9LqNeG6qHxjeUocjvVki2XR35weJ9mZgQ")
+    );
+    tx1.createXrpPayment(
+        /* amount */1000,
+        /* destination */"rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+        /* destination_tag*/0
+    );
+    tx1.pub_key = parse_hex("ed5f5ac8b98974a3ca843326d9b88cebd0560177b973ee0b149f782cfaa06dc66a");
+    const auto signer = Address("r4BPgS7DHebQiU31xWELvZawwSG2fSPJ7C");
+    auto preImage = tx1.getMultiSigningPreImage(Data(signer.bytes.begin() + 1, signer.bytes.end()));
+
+    ASSERT_EQ(hex(preImage),
+          /* prefix */      "534d5400"
+          /* tx type */     "120000"
+          /* flags */       "2280000000"
+          /* sequence */    "2400000001"
+          /* amount */      "6140000000000003e8"
+          /* fee */         "68400000000000000a"
+          /* pub key */     "7300"
+          /* account */     "81145b812c9d57731e27a2da8b1830195f88ef32a3b6"
+          /* destination */ "8314b5f762798a53d543a014caf8b297cff8f2f937e8"
+          /* signer */      "e851bbbe79e328e43d68f43445368133df5fba5a"
+    );
+
+    // the signature is not signed
+    tx1.signature = parse_hex("3045");
+    EXPECT_EQ(hex(tx1.getPreImage()).substr(0, 8), "53545800");
+    EXPECT_EQ(tx1.getPreImage().size(), 114ul);
+}
+
+TEST(RippleTransaction, fieldIds) {
+    EXPECT_EQ(FieldId(FieldType::int32, 2).headerSize, 1);
+    EXPECT_EQ(FieldId(FieldType::int32, 2).header[0], 0x22);
+    const auto lastLedgerSequence = FieldId(FieldType::int32, 27);
+    EXPECT_EQ(hex(Data(lastLedgerSequence.header.begin(), lastLedgerSequence.header.begin() + lastLedgerSequence.headerSize)), "201b");
+    const auto vector256 = FieldId(FieldType::vector256, 4);
+    EXPECT_EQ(hex(Data(vector256.header.begin(), vector256.header.begin() + vector256.headerSize)), "0413");
+    const auto large = FieldId(FieldType::vector256, 19);
+    EXPECT_EQ(hex(Data(large.header.begin(), large.header.begin() + large.headerSize)), "001313");
+    EXPECT_TRUE(FieldId(FieldType::amount, 8) < FieldId(FieldType::vl, 3));
+}
+
 } // namespace TW::Ripple::tests
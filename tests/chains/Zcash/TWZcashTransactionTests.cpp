@@ -79,6 +79,35 @@ TEST(TWZcashTransaction, Encode) {
 
     auto sighash = transaction.getSignatureHash(scriptCode, 0, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE);
     ASSERT_EQ(hex(sighash), "f3148f80dfab5e573d5edfe7a850f5fd39234f80b5429d3a57edcc11e34c585b");
+
+    Bitcoin::SigHashCache cache;
+    for (int i = 0; i < 2; ++i) {
+        auto cachedSighash = transaction.getSignatureHash(scriptCode, 0, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE, &cache);
+        EXPECT_EQ(hex(cachedSighash), "f3148f80dfab5e573d5edfe7a850f5fd39234f80b5429d3a57edcc11e34c585b");
+    }
+    ASSERT_TRUE(cache.prevoutHash.has_value());
+    EXPECT_EQ(hex(*cache.prevoutHash), "fae31b8dec7b0b77e2c8d6b6eb0e7e4e55abc6574c26dd44464d9408a8e33f11");
+    EXPECT_EQ(hex(*cache.sequenceHash), "6c80d37f12d89b6f17ff198723e7db1247c4811d1a695d74d930f99e98418790");
+    EXPECT_EQ(hex(*cache.outputsHash), "d2b04118469b7810a0d1cc59568320aad25a84f407ecac40b4f605a4e6868454");
+    ASSERT_TRUE(cache.preImagePrefix.has_value());
+    EXPECT_EQ(cache.preImagePrefix->first, uint32_t(TWBitcoinSigHashTypeAll));
+
+    // Other hash types don't use the cached prefix
+    const auto hashTypes = {TWBitcoinSigHashTypeSingle, TWBitcoinSigHashTypeNone,
+                            TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)};
+    for (auto hashType : hashTypes) {
+        auto personalization = parse_hex("5a6361736853696748617368"); // ZcashSigHash
+        append(personalization, Data(transaction.branchId.begin(), transaction.branchId.end()));
+        const auto expected = Hash::blake2b(transaction.getPreImage(scriptCode, 0, hashType, 0x02faf080), 32, personalization);
+        EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, 0, hashType, 0x02faf080, Bitcoin::BASE, &cache)), hex(expected));
+    }
+    EXPECT_EQ(cache.preImagePrefix->first, uint32_t(TWBitcoinSigHashTypeAll));
+
+    Bitcoin::SigHashCache primed;
+    transaction.primeSigHashCache(primed, TWBitcoinSigHashTypeAll);
+    ASSERT_TRUE(primed.preImagePrefix.has_value());
+    EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, 0, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE, &primed)),
+              "f3148f80dfab5e573d5edfe7a850f5fd39234f80b5429d3a57edcc11e34c585b");
 }
 
 TEST(TWZcashTransaction, SaplingSigning) {
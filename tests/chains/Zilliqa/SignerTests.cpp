@@ -108,4 +108,44 @@ TEST(ZilliqaSigner, SigningData) {
     ASSERT_EQ(hex(output.signature()), "437fb5c3ce2c6b01f9d490f670539fae4533c82a21fa7edfe6b23df70d732937e8c578c8d6ed24be9150f5126f7b7c977a467af8947ef92a720908a761a6eb0d");
 }
 
+TEST(ZilliqaSigner, SignBatch) {
+    const auto payer = parse_hex("0x68ffa8ec149ce50da647166036555f73d57f662eb420e154621e5f24f6cf9748");
+    const auto other = parse_hex("0E891B9DFF485000C7D1DC22ECF3A583CC50328684321D61947A86E57CF6C638");
+    const auto gasData = store(uint256_t(1000000000));
+
+    std::vector<Proto::SigningInput> inputs;
+    for (auto i = 0; i < 4; ++i) {
+        auto input = Proto::SigningInput();
+        const auto amountData = store(uint256_t(1000000000000) * (i + 1));
+        input.mutable_transaction()->mutable_transfer()->set_amount(amountData.data(), amountData.size());
+        input.set_version(65537);
+        input.set_nonce(2 + i);
+        input.set_to("zil1g029nmzsf36r99vupp4s43lhs40fsscx3jjpuy");
+        input.set_gas_price(gasData.data(), gasData.size());
+        input.set_gas_limit(uint64_t(1));
+        const auto& key = i == 2 ? other : payer;
+        input.set_private_key(key.data(), key.size());
+        inputs.push_back(input);
+    }
+
+    const auto outputs = Signer::signBatch(inputs);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (auto i = 0ul; i < inputs.size(); ++i) {
+        const auto expected = Signer::sign(inputs[i]);
+        EXPECT_EQ(hex(outputs[i].signature()), hex(expected.signature()));
+        EXPECT_EQ(outputs[i].json(), expected.json());
+    }
+    EXPECT_TRUE(Signer::signBatch({}).empty());
+}
+
+TEST(ZilliqaSigner, SignWithPublicKey) {
+    const auto privateKey = PrivateKey(parse_hex("0x68ffa8ec149ce50da647166036555f73d57f662eb420e154621e5f24f6cf9748"));
+    const auto pubKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto message = parse_hex("0881800410021a147fccacf066a5f26ee3affc2ed1fa9810deaa632c");
+
+    const auto signature = privateKey.signZilliqa(message, pubKey);
+    EXPECT_EQ(hex(signature), hex(privateKey.signZilliqa(message)));
+    EXPECT_TRUE(pubKey.verifyZilliqa(signature, message));
+}
+
 } // namespace TW::Zilliqa::tests
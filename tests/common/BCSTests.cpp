@@ -162,4 +162,56 @@ TEST(BCS, Vector) {
     ASSERT_EQ(os.bytes, parse_hex("0101"));
 }
 
+TEST(BCS, VectorBulk) {
+    Serializer os;
+    os << std::vector<uint16_t>{0x0102, 0x0304};
+    ASSERT_EQ(os.bytes, parse_hex("0202010403"));
+
+    os.clear();
+    os << std::vector<bool>{true, false, true};
+    ASSERT_EQ(os.bytes, parse_hex("03010001"));
+
+    os.clear();
+    os << std::vector<std::string>{"a", "bc"};
+    ASSERT_EQ(os.bytes, parse_hex("020161026263"));
+}
+
+TEST(BCS, Array) {
+    static_assert(details::fixed_size<std::array<uint32_t, 4>>() == 16);
+    static_assert(details::fixed_size<std::pair<uint8_t, std::array<uint64_t, 2>>>() == 17);
+    static_assert(details::fixed_size<std::tuple<uint8_t, std::string>>() == 0);
+
+    Serializer os;
+    os << std::array<uint8_t, 3>{1, 2, 3};
+    ASSERT_EQ(os.bytes, parse_hex("010203"));
+
+    os.clear();
+    os << std::array<uint32_t, 2>{0xAABBCCDD, 1};
+    ASSERT_EQ(os.bytes, parse_hex("DDCCBBAA01000000"));
+}
+
+struct large_struct {
+    uint8_t a0, a1, a2, a3, a4, a5, a6, a7, a8, a9;
+    std::string a10;
+    uint16_t a11;
+};
+
+TEST(BCS, LargeStruct) {
+    Serializer os;
+    os << large_struct{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, "ab", 0x0102};
+    ASSERT_EQ(os.bytes, parse_hex("000102030405060708090261620201"));
+}
+
+TEST(BCS, Serialize) {
+    const auto bytes = serialize(uint8_t(1), std::vector<uint64_t>(100, 7), std::string_view("abc"), raw_bytes{parse_hex("ffee")});
+    EXPECT_EQ(bytes.size(), 1ul + 1 + 800 + 4 + 2);
+    EXPECT_EQ(bytes.capacity(), bytes.size());
+    EXPECT_EQ(hex(Data(bytes.end() - 6, bytes.end())), "03616263ffee");
+
+    auto counter = Serializer::counter();
+    counter << std::vector<std::array<uint32_t, 2>>(1000) << std::vector<std::string>{"abc"};
+    EXPECT_EQ(counter.size(), 2ul + 8000 + 1 + 4);
+    EXPECT_TRUE(counter.bytes.empty());
+}
+
 }
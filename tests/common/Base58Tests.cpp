@@ -0,0 +1,120 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Base58::tests {
+
+TEST(Base58, EncodeDecode) {
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        {"", ""},
+        {"00", "1"},
+        {"0000", "11"},
+        {"61", "2g"},
+        {"626262", "a3gV"},
+        {"636363", "aPEr"},
+        {"73696d706c792061206c6f6e6720737472696e67", "2cFupjhnEsSn59qHXstmK2ffpLv2"},
+        {"00eb15231dfceb60925886b67d065299925915aeb172c06647", "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L"},
+        {"516b6fcd0f", "ABnLTmg"},
+        {"bf4f89001e670274dd", "3SEo3LWLoPntC"},
+        {"572e4794", "3EFU7m"},
+        {"ecac89cad93923c02321", "EJDM8drfXA6uyA"},
+        {"10c8511e", "Rt5zm"},
+        {"00000000000000000000", "1111111111"},
+        {"ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff", "JEKNVnkbo3jma5nREBBJCDoXFVeKkD56V3xKrvRmWxFG"},
+    };
+    for (const auto& [hex, base58] : vectors) {
+        EXPECT_EQ(encode(parse_hex(hex)), base58) << hex;
+        EXPECT_EQ(TW::hex(decode(base58)), hex) << base58;
+    }
+}
+
+TEST(Base58, DecodeInvalid) {
+    EXPECT_TRUE(decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tc0").empty());
+    EXPECT_TRUE(decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4TcI").empty());
+    EXPECT_TRUE(decode(" 1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx").empty());
+
+    Data out = {0x01};
+    EXPECT_FALSE(appendDecoded("1l", out));
+    EXPECT_EQ(out, Data{0x01});
+}
+
+TEST(Base58, Ripple) {
+    const std::string address = "rnBFvgZphmN39GWzUJeUitaP22Fr9be75H";
+    const auto bytes = decodeCheck(address, Rust::Base58Alphabet::Ripple);
+    ASSERT_EQ(bytes.size(), 21ul);
+    EXPECT_EQ(bytes[0], 0x00);
+    EXPECT_EQ(encodeCheck(bytes, Rust::Base58Alphabet::Ripple), address);
+    EXPECT_TRUE(decodeCheck(address).empty());
+}
+
+TEST(Base58, RoundTripLengths) {
+    for (std::size_t size = 0; size <= 100; ++size) {
+        Data bytes(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            bytes[i] = static_cast<byte>(i < size / 5 ? 0 : i * 97 + 13);
+        }
+        EXPECT_EQ(decode(encode(bytes)), bytes) << size;
+        EXPECT_EQ(decodeCheck(encodeCheck(bytes)), bytes) << size;
+    }
+}
+
+TEST(Base58, CompileTimeHasher) {
+    const auto payload = parse_hex("073f0415e993935a68154fda7018b887c4e3fe8b4e10");
+    const auto encoded = encodeCheck<Hash::HasherBlake256d>(payload);
+    EXPECT_EQ(encoded, encodeCheck(payload, Rust::Base58Alphabet::Bitcoin, Hash::HasherBlake256d));
+    EXPECT_EQ(decodeCheck<Hash::HasherBlake256d>(encoded), payload);
+    EXPECT_TRUE(decodeCheck<Hash::HasherSha256d>(encoded).empty());
+    EXPECT_EQ(encodeCheck<Hash::HasherSha256d>(payload), encodeCheck(payload));
+}
+
+TEST(Base58, EncodeCheckBatch) {
+    const std::vector<Data> payloads = {
+        parse_hex("00769bdff96a02f9135a1d19b749db6a78fe07dc90"),
+        {},
+        parse_hex("05bcfeb728b584253d5f3f70bcb780e9ef218a68f4"),
+    };
+    std::vector<std::size_t> offsets;
+    const auto arena = encodeCheckBatch(payloads, offsets);
+    ASSERT_EQ(offsets.size(), payloads.size() + 1);
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        EXPECT_EQ(arena.substr(offsets[i], offsets[i + 1] - offsets[i]), encodeCheck(payloads[i]));
+    }
+    EXPECT_EQ(arena.substr(0, offsets[1]), "1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+}
+
+TEST(Base58, EncodeDecodeBatch) {
+    const std::vector<Data> payloads = {
+        parse_hex("00769bdff96a02f9135a1d19b749db6a78fe07dc90"),
+        {},
+        parse_hex("0001"),
+    };
+    std::vector<std::size_t> offsets;
+    const auto arena = encodeBatch(payloads, offsets);
+    ASSERT_EQ(offsets.size(), payloads.size() + 1);
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        strings.push_back(arena.substr(offsets[i], offsets[i + 1] - offsets[i]));
+        EXPECT_EQ(strings.back(), encode(payloads[i]));
+    }
+
+    Data decoded;
+    ASSERT_TRUE(decodeBatch(strings, decoded, offsets));
+    ASSERT_EQ(offsets.size(), payloads.size() + 1);
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        EXPECT_EQ(Data(decoded.begin() + offsets[i], decoded.begin() + offsets[i + 1]), payloads[i]);
+    }
+
+    strings.emplace_back("0OIl");
+    EXPECT_FALSE(decodeBatch(strings, decoded, offsets));
+    EXPECT_TRUE(decoded.empty());
+    EXPECT_TRUE(offsets.empty());
+}
+
+} // namespace TW::Base58::tests
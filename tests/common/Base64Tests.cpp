@@ -47,6 +47,23 @@ TEST(Base64, decode) {
 }
 
 
+TEST(Base64, decodeInto) {
+    Data buffer;
+    ASSERT_TRUE(decodeInto("SGVsbG8sIHdvcmxkIQ==", buffer));
+    EXPECT_EQ(hex(data("Hello, world!")), hex(buffer));
+    const auto capacity = buffer.capacity();
+    ASSERT_TRUE(decodeInto("MTI=", buffer));
+    EXPECT_EQ(hex(data("12")), hex(buffer));
+    EXPECT_EQ(buffer.capacity(), capacity);
+    ASSERT_TRUE(decodeInto("MTIz", buffer));
+    EXPECT_EQ(hex(data("123")), hex(buffer));
+    ASSERT_TRUE(decodeInto("", buffer));
+    EXPECT_TRUE(buffer.empty());
+
+    EXPECT_FALSE(decodeInto("MTI", buffer));
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(decodeInto("_This_is_an_invalid_base64_", buffer));
+}
 
 TEST(Base64, EncodeDecodeSui) {
     auto v = "AAIAAAAAAAAAAAAAAAAAAAAAAAAAAgEAAAAAAAAAINaXMihjlCd4CQVFRPjcNb7QfYP4wGgQyl1xbplvEKUCA3N1aQh0cmFuc2ZlcgACAQCDlY9/fBVEt0yclyDF8RrjSRBfRRsAAAAAAAAAIJttZrU/26Bim7ku4dwY8d3fdabngn0B6dY/hLKgb6+xABQv0f6HrJCZ/1cuDVuxh1BL12XMeC21AKyRnN3jUaw243EdgyxtuXZpG62iKzFvYdk6RMGXxnoWd8RcfwkUAQAAAAAAACDi9GYNIZ0FXpPPi+zdDUuzHfs6MDoxzPuXGPZJq8ZfOAEAAAAAAAAA0AcAAAAAAAA=";
@@ -81,4 +98,84 @@ TEST(Base64, isBase64) {
     EXPECT_FALSE(isBase64orBase64Url("MwCKhieGGl3ZbJ2zzggHsSLaXtRzk0znVopbSxw2HLsors=#"));
 }
 
+TEST(Base64, EncodeDecodeBatch) {
+    const std::vector<Data> payloads = {
+        data("hello world"),
+        {},
+        parse_hex("fffe"),
+    };
+    std::vector<std::size_t> offsets;
+    const auto arena = encodeBatch(payloads, offsets, true);
+    ASSERT_EQ(offsets.size(), payloads.size() + 1);
+    EXPECT_EQ(arena, "aGVsbG8gd29ybGQ=__4=");
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        strings.push_back(arena.substr(offsets[i], offsets[i + 1] - offsets[i]));
+        EXPECT_EQ(strings.back(), encodeBase64Url(payloads[i]));
+    }
+
+    Data decoded;
+    ASSERT_TRUE(decodeBatch(strings, decoded, offsets, true));
+    ASSERT_EQ(offsets.size(), payloads.size() + 1);
+    for (std::size_t i = 0; i < payloads.size(); ++i) {
+        EXPECT_EQ(Data(decoded.begin() + offsets[i], decoded.begin() + offsets[i + 1]), payloads[i]);
+    }
+
+    strings.emplace_back("!!!!");
+    EXPECT_FALSE(decodeBatch(strings, decoded, offsets, true));
+    EXPECT_TRUE(decoded.empty());
+}
+
+TEST(Base64, DecodeIntoSpan) {
+    EXPECT_EQ(decodedSize("SGVsbG8sIHdvcmxkIQ=="), 13ul);
+    EXPECT_EQ(decodedSize("MTI="), 2ul);
+    EXPECT_EQ(decodedSize("MTIz"), 3ul);
+    EXPECT_EQ(decodedSize(""), 0ul);
+    EXPECT_EQ(decodedSize("MTI"), 0ul);
+
+    std::array<byte, 13> decoded{};
+    ASSERT_TRUE(decodeInto("SGVsbG8sIHdvcmxkIQ==", decoded));
+    EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "Hello, world!");
+
+    std::array<byte, 5> url{};
+    ASSERT_TRUE(decodeInto("Kyc_YWI=", url, true));
+    EXPECT_EQ(std::string(url.begin(), url.end()), "+'?ab");
+    EXPECT_FALSE(decodeInto("Kyc_YWI=", url)); // not in the regular alphabet
+
+    std::array<byte, 12> tooLong{};
+    EXPECT_FALSE(decodeInto("SGVsbG8sIHdvcmxkIQ==", tooLong)); // output of another size
+    EXPECT_FALSE(decodeInto("SGVsbG8sIHdvcmxkIQ", decoded));   // missing padding
+    EXPECT_TRUE(decodeInto("", std::span<byte>()));
+}
+
+TEST(Base64, Encoder) {
+    std::string out = "prefix:";
+    encodeInto(data("Hello, world!"), out);
+    EXPECT_EQ(out, "prefix:SGVsbG8sIHdvcmxkIQ==");
+
+    // every split of the input gives the one-shot encoding
+    const auto input = data("Lorem ipsum dolor sit amet");
+    const auto expected = encode(input);
+    for (std::size_t first = 0; first <= input.size(); ++first) {
+        for (std::size_t second = first; second <= input.size(); ++second) {
+            std::string encoded;
+            const auto span = std::span<const byte>(input);
+            Encoder(encoded)
+                .append(span.first(first))
+                .append(span.subspan(first, second - first))
+                .append(span.subspan(second))
+                .finish();
+            ASSERT_EQ(encoded, expected) << first << " " << second;
+        }
+    }
+
+    std::string url;
+    Encoder encoder(url, true);
+    for (const auto c : std::string("+'?ab")) {
+        encoder.append(static_cast<byte>(c));
+    }
+    encoder.finish();
+    EXPECT_EQ(url, "Kyc_YWI=");
+}
+
 } // namespace TW::Base64::tests
@@ -68,4 +68,55 @@ TEST(Base32, DecodeInvalid) {
     ASSERT_FALSE(decode("ABC", decoded)); // invalid odd length
 }
 
+TEST(Base32, EncodeInto) {
+    const auto data = parse_hex("48450c2745890def7da06fc2551f912a14f9fc581c12db6e4d6f73f2fd0b2ad50df3d396");
+    std::string encoded(encodedSize(data.size()), '\0');
+    encodeInto(data, encoded.data());
+    EXPECT_EQ(encoded, "JBCQYJ2FREG667NAN7BFKH4RFIKPT7CYDQJNW3SNN5Z7F7ILFLKQ346TSY");
+
+    static constexpr Alphabet filecoin{"abcdefghijklmnopqrstuvwxyz234567"};
+    const std::array<byte, 3> array{0x01, 0x02, 0x03};
+    const auto lower = encodeArray(array, filecoin);
+    EXPECT_EQ(std::string(lower.begin(), lower.end()), "aebag");
+}
+
+TEST(Base32, DecodeInto) {
+    const std::string encoded = "PITDOF57RHOVLT37KM7DCXDCETLDL3OA5CBAN7LQ44Z36LGFC27IJ2IQ64";
+    Data decoded(decodedSize(encoded.size()));
+    ASSERT_TRUE(decodeInto(encoded, decoded.data()));
+    EXPECT_EQ(hex(decoded), "7a263717bf89dd55cf7f533e315c6224d635edc0e88206fd70e733bf2cc516be84e910f7");
+
+    std::array<byte, 3> array{};
+    ASSERT_TRUE(decodeArray("aebag", array, Alphabet("abcdefghijklmnopqrstuvwxyz234567")));
+    EXPECT_EQ(hex(array), "010203");
+    EXPECT_FALSE(decodeArray("AEBAG", array, Alphabet("abcdefghijklmnopqrstuvwxyz234567"))); // case-sensitive
+    EXPECT_FALSE(decodeArray("AEBA", array)); // length doesn't match the array
+}
+
+TEST(Base32, DecodeIntoInvalid) {
+    byte out[8];
+    EXPECT_FALSE(decodeInto("+-", out));  // invalid characters
+    EXPECT_FALSE(decodeInto("A", out));   // invalid odd length
+    EXPECT_FALSE(decodeInto("ABC", out)); // invalid odd length
+    EXPECT_FALSE(decodeInto("AF", out));  // non-zero trailing bits
+    EXPECT_FALSE(decodeInto("ae", out));  // lowercase in the default alphabet
+}
+
+TEST(Base32, Batch) {
+    const auto data = parse_hex("010203040506");
+    std::string encoded(2 * encodedSize(3), '\0');
+    encodeBatch(data.data(), 3, 2, encoded.data());
+    EXPECT_EQ(encoded, "AEBAGAQCQM");
+
+    const std::array<std::string_view, 3> inputs{"AEBAG", "AQCQ!", "AQCQM"};
+    Data decoded(inputs.size() * 3);
+    bool valid[3];
+    EXPECT_EQ(decodeBatch(inputs, 3, decoded.data(), valid), 2ul);
+    EXPECT_TRUE(valid[0]);
+    EXPECT_FALSE(valid[1]);
+    EXPECT_TRUE(valid[2]);
+    EXPECT_EQ(hex(Data(decoded.begin(), decoded.begin() + 3)), "010203");
+    EXPECT_EQ(hex(Data(decoded.begin() + 6, decoded.end())), "040506");
+}
+
 } // namespace TW::Base32::tests
@@ -61,6 +61,18 @@ TEST(Bech32Address, Invalid) {
     ASSERT_FALSE(Bech32Address::isValid("xerd19nu5t7hszckwah5nlcadmk5rlchtugzplznskffpwecygcu0520s9tnyy0", "erd"));
 }
 
+TEST(Bech32Address, ValidBatch) {
+    const std::vector<std::string> addresses = {
+        "bnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2",
+        "bnb1grpf0955h0ykzq3ar6nmum7y6gdfl6lxfn46h2",
+        "BNB1GRPF0955H0YKZQ3AR5NMUM7Y6GDFL6LXFN46H2",
+        "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02",
+        "",
+    };
+    EXPECT_EQ(Bech32Address::isValidBatch(addresses, "bnb"), std::vector<bool>({true, false, true, false, false}));
+    EXPECT_EQ(Bech32Address::isValidBatch(addresses, ""), std::vector<bool>({true, false, true, true, false}));
+}
+
 TEST(Bech32Address, InvalidWrongPrefix) {
     ASSERT_TRUE(Bech32Address::isValid("one1a50tun737ulcvwy0yvve0pvu5skq0kjargvhwe", "one"));
     ASSERT_FALSE(Bech32Address::isValid("one1a50tun737ulcvwy0yvve0pvu5skq0kjargvhwe", "two"));
@@ -172,3 +184,17 @@ TEST(Bech32Address, Prefixes) {
     const auto address3 = Bech32Address("hrpthree", Hash::HasherSha256ripemd, publicKey);
     ASSERT_EQ("hrpthree186zwn9h0z9fyvwfqs4jl92cw3kexusm4wuqkvd", address3.string());
 }
+
+TEST(Bech32Address, StringsForPrefixes) {
+    const auto keyHash = parse_hex("bc2da90c84049370d1b7c528bc164bc588833f21");
+    const std::vector<std::string> hrps = {"cosmos", "thor", "osmo", "Cosmos", ""};
+    const auto addresses = Bech32Address::strings(keyHash, hrps);
+    ASSERT_EQ(addresses.size(), hrps.size());
+    EXPECT_EQ(addresses[0], "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    for (size_t i = 0; i < hrps.size(); ++i) {
+        EXPECT_EQ(addresses[i], Bech32Address(hrps[i], keyHash).string()) << hrps[i];
+    }
+    // mixed case prefix fails the check back
+    EXPECT_EQ(addresses[3], "");
+    EXPECT_TRUE(Bech32Address::strings(keyHash, {}).empty());
+}
@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+
 using namespace TW;
 
 struct DecodeTestData {
@@ -118,3 +120,37 @@ TEST(Bech32, encodeM) {
         EXPECT_EQ(res, encodedLow);
     }
 }
+
+TEST(Bech32, verify) {
+    for (auto& td: testData) {
+        std::size_t separator = 0;
+        const auto variant = Bech32::verify(td.encoded, separator);
+        if (td.isValid) {
+            EXPECT_EQ(variant, Bech32::ChecksumVariant::Bech32) << td.encoded;
+        } else if (td.isValidM) {
+            EXPECT_EQ(variant, Bech32::ChecksumVariant::Bech32M) << td.encoded;
+        } else {
+            EXPECT_EQ(variant, Bech32::ChecksumVariant::None) << td.encoded;
+            continue;
+        }
+        EXPECT_EQ(separator, td.hrp.size());
+        EXPECT_EQ(td.encoded.size() - separator - 7, td.dataHex.size() / 2);
+    }
+}
+
+TEST(Bech32, convertBitsIntoBuffer) {
+    const auto bytes = parse_hex("751e76e8199196d454941c45d1b3a323f1433bd6");
+    std::array<byte, Bech32::convertedSize<8, 5, true>(20)> groups;
+    std::size_t size = 0;
+    ASSERT_TRUE((Bech32::convertBits<8, 5, true>(bytes.data(), bytes.size(), groups.data(), size)));
+    EXPECT_EQ(size, 32ul);
+
+    Data fromVector;
+    ASSERT_TRUE((Bech32::convertBits<8, 5, true>(fromVector, bytes)));
+    EXPECT_EQ(fromVector, Data(groups.begin(), groups.begin() + size));
+
+    std::array<byte, 20> back;
+    ASSERT_TRUE((Bech32::convertBits<5, 8, false>(groups.data(), size, back.data(), size)));
+    EXPECT_EQ(size, 20ul);
+    EXPECT_EQ(Data(back.begin(), back.end()), bytes);
+}
@@ -118,6 +118,42 @@ TEST(Cbor, EncNull) {
     }
 }
 
+TEST(Cbor, WriterSample1) {
+    Writer writer;
+    writer.array(2).uint(5)
+        .map(2)
+            .string("x").uint(100)
+            .string("y").negInt(50);
+    EXPECT_EQ("8205a26178186461793831", hex(writer.encoded()));
+    EXPECT_TRUE(Decode(writer.encoded()).isValid());
+}
+
+TEST(Cbor, WriterSameAsEncode) {
+    const auto bytes = parse_hex("0102030405060708090a0b0c0d0e0f101112131415161718191a");
+    Writer writer(64);
+    writer.array(7)
+        .uint(0xffffffffffffffff)
+        .negInt(0)
+        .bytes(bytes)
+        .tag(5).uint(6)
+        .null()
+        .encode(Encode::string("abc"))
+        .raw(Encode::array({Encode::uint(1), Encode::uint(2)}).encoded());
+    const auto expected = Encode::array({
+        Encode::uint(0xffffffffffffffff),
+        Encode::negInt(0),
+        Encode::bytes(bytes),
+        Encode::tag(5, Encode::uint(6)),
+        Encode::null(),
+        Encode::string("abc"),
+        Encode::array({Encode::uint(1), Encode::uint(2)}),
+    }).encoded();
+    EXPECT_EQ(hex(expected), hex(writer.encoded()));
+
+    const auto released = writer.release();
+    EXPECT_EQ(hex(expected), hex(released));
+}
+
 TEST(Cbor, EncInvalid) {
     Data invalid = parse_hex("5b99999999999999991234"); // invalid very looong string
     EXPECT_FALSE(Decode(invalid).isValid());
@@ -519,5 +555,71 @@ TEST(Cbor, GetTagElementNotTag) {
     }
     FAIL() << "Expected exception";
 }
+TEST(Cbor, LazyElements) {
+    Data cbor = parse_hex("a261610161629f0203ff"); // {"a": 1, "b": [_ 2, 3]}
+    Decode decode(cbor);
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : decode.mapElements()) {
+        keys.emplace_back(key.getString());
+        if (key.getString() == "b") {
+            uint64_t sum = 0;
+            for (const auto& elem : value.arrayElements()) {
+                sum += elem.getValue();
+            }
+            EXPECT_EQ(5ul, sum);
+        }
+    }
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), keys);
+
+    const auto empty = Decode(parse_hex("80")).arrayElements();
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_THROW(decode.arrayElements(), invalid_argument);
+}
+
+TEST(Cbor, Indexed) {
+    Data cbor = Encode::array({
+        Encode::uint(5),
+        Encode::map({
+            make_pair(Encode::string("x"), Encode::array({Encode::uint(1), Encode::bytes(parse_hex("0102"))})),
+            make_pair(Encode::string("y"), Encode::tag(5, Encode::negInt(50))),
+        }),
+    }).encoded();
+
+    const auto decode = Decode::indexed(cbor);
+    EXPECT_EQ(Decode(cbor).dumpToString(), decode.dumpToString());
+    const auto elems = decode.getArrayElements();
+    ASSERT_EQ(2ul, elems.size());
+    const auto map = elems[1].getMapElements();
+    ASSERT_EQ(2ul, map.size());
+    EXPECT_EQ("x", map[0].first.getString());
+    EXPECT_EQ("0102", hex(map[0].second.getArrayElements()[1].getBytes()));
+    EXPECT_EQ(hex(cbor), hex(decode.encoded()));
+
+    EXPECT_THROW(Decode::indexed(parse_hex("8301")), invalid_argument);
+}
+
+TEST(Cbor, BytesContent) {
+    // CBOR embedded in a byte string, after a 2-byte prefix
+    const auto embedded = Encode::map({make_pair(Encode::negInt(2), Encode::bytes(parse_hex("0a0b")))}).encoded();
+    auto content = parse_hex("ffff");
+    append(content, embedded);
+    const auto decode = Decode(Encode::array({Encode::bytes(content)}).encoded());
+
+    const auto bytes = decode.getArrayElements()[0];
+    EXPECT_EQ(Decode::MT_bytes, bytes.getMajorType());
+    const auto view = bytes.getBytesView();
+    EXPECT_EQ(hex(content), hex(Data(view.begin(), view.end())));
+
+    const auto map = bytes.getBytesContent(2).getMapElements();
+    ASSERT_EQ(1ul, map.size());
+    EXPECT_EQ(Decode::MT_negint, map[0].first.getMajorType());
+    EXPECT_EQ(1ul, map[0].first.getValue());
+    EXPECT_EQ("0a0b", hex(map[0].second.getBytes()));
+
+    EXPECT_THROW(bytes.getBytesContent(uint32_t(content.size() + 1)), invalid_argument);
+    EXPECT_THROW(decode.getBytesView(), invalid_argument);
+}
+
 // clang-format on
 } // namespace TW::Cbor::tests
@@ -0,0 +1,139 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CryptoBackend.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "SigningContext.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace TW::CryptoBackendTests {
+
+const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+
+/// Delegates to trezor-crypto and counts the calls per curve.
+class CountingBackend : public CryptoBackend {
+public:
+    mutable std::map<TWCurve, int> calls;
+
+    bool ecdsaGetPublicKey(TWCurve curve, const byte* key, bool compressed, byte* publicKey) const override {
+        ++calls[curve];
+        return CryptoBackend::ecdsaGetPublicKey(curve, key, compressed, publicKey);
+    }
+    bool ecdsaSign(TWCurve curve, const byte* key, const byte* digest, byte* signature, byte* recoveryId, CanonicalChecker checker) const override {
+        ++calls[curve];
+        return CryptoBackend::ecdsaSign(curve, key, digest, signature, recoveryId, checker);
+    }
+    bool ecdsaVerify(TWCurve curve, const byte* publicKey, const byte* signature, const byte* digest) const override {
+        ++calls[curve];
+        return CryptoBackend::ecdsaVerify(curve, publicKey, signature, digest);
+    }
+    int ecdsaRecover(TWCurve curve, const byte* signature, int recoveryId, const byte* digest, byte* publicKey) const override {
+        ++calls[curve];
+        return CryptoBackend::ecdsaRecover(curve, signature, recoveryId, digest, publicKey);
+    }
+    bool eddsaGetPublicKey(TWCurve curve, const byte* key, byte* publicKey) const override {
+        ++calls[curve];
+        return CryptoBackend::eddsaGetPublicKey(curve, key, publicKey);
+    }
+    bool eddsaSign(TWCurve curve, const byte* key, const byte* extension, const byte* message, std::size_t size, byte* signature) const override {
+        ++calls[curve];
+        return CryptoBackend::eddsaSign(curve, key, extension, message, size, signature);
+    }
+    bool eddsaVerify(TWCurve curve, const byte* publicKey, const byte* message, std::size_t size, const byte* signature) const override {
+        ++calls[curve];
+        return CryptoBackend::eddsaVerify(curve, publicKey, message, size, signature);
+    }
+};
+
+/// Refuses to sign with secp256k1, like a hardware module without that key.
+class RefusingBackend : public CryptoBackend {
+public:
+    bool ecdsaSign(TWCurve curve, const byte* key, const byte* digest, byte* signature, byte* recoveryId, CanonicalChecker checker) const override {
+        if (curve == TWCurveSECP256k1) {
+            return false;
+        }
+        return CryptoBackend::ecdsaSign(curve, key, digest, signature, recoveryId, checker);
+    }
+};
+
+/// Installs a backend for the scope of a test.
+struct ScopedBackend {
+    explicit ScopedBackend(const CryptoBackend& backend) { CryptoBackend::install(&backend); }
+    ~ScopedBackend() { CryptoBackend::install(nullptr); }
+};
+
+TEST(CryptoBackend, DefaultIsTrezor) {
+    EXPECT_TRUE(CryptoBackend::isDefault());
+    const auto& backend = CryptoBackend::current();
+    Data publicKey(PublicKey::secp256k1Size);
+    ASSERT_TRUE(backend.ecdsaGetPublicKey(TWCurveSECP256k1, privateKey.key().data(), true, publicKey.data()));
+    EXPECT_EQ(hex(publicKey), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
+
+    // unsupported curves are rejected
+    EXPECT_FALSE(backend.ecdsaGetPublicKey(TWCurveED25519, privateKey.key().data(), true, publicKey.data()));
+    EXPECT_FALSE(backend.eddsaGetPublicKey(TWCurveSECP256k1, privateKey.key().data(), publicKey.data()));
+    EXPECT_NE(backend.ecdsaRecover(TWCurveCurve25519, publicKey.data(), 0, publicKey.data(), publicKey.data()), 0);
+}
+
+TEST(CryptoBackend, InstalledBackendIsUsed) {
+    CountingBackend counting;
+    const auto digest = Hash::keccak256(TW::data("hello"));
+    const auto expectedSignature = privateKey.sign(digest, TWCurveSECP256k1);
+    const auto expectedEd25519 = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    {
+        ScopedBackend scope(counting);
+        EXPECT_FALSE(CryptoBackend::isDefault());
+
+        const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+        const auto signature = privateKey.sign(digest, TWCurveSECP256k1);
+        EXPECT_EQ(hex(signature), hex(expectedSignature));
+        EXPECT_TRUE(publicKey.verify(signature, digest));
+        EXPECT_EQ(hex(PublicKey::recover(signature, digest).bytes), hex(publicKey.bytes));
+        EXPECT_EQ(counting.calls[TWCurveSECP256k1], 4);
+
+        const auto context = SigningContext(privateKey, TWCurveNIST256p1);
+        EXPECT_TRUE(context.publicKey().verify(context.sign(digest), digest));
+        EXPECT_EQ(counting.calls[TWCurveNIST256p1], 3);
+
+        const auto ed25519 = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+        EXPECT_EQ(hex(ed25519.bytes), hex(expectedEd25519.bytes));
+        EXPECT_TRUE(ed25519.verify(privateKey.sign(digest, TWCurveED25519), digest));
+        EXPECT_EQ(counting.calls[TWCurveED25519], 3);
+
+        // batches go through the backend key by key
+        const std::vector<PrivateKey> keys(3, privateKey);
+        const auto publicKeys = PrivateKey::getPublicKeys(keys, TWPublicKeyTypeSECP256k1Extended);
+        EXPECT_EQ(hex(publicKeys[2].bytes), hex(publicKey.bytes));
+        const std::vector<Data> signatures(3, signature);
+        const std::vector<Data> digests(3, digest);
+        Data recovered(3 * PublicKey::secp256k1ExtendedSize);
+        EXPECT_EQ(PublicKey::recoverBatch(signatures, digests, recovered.data()), std::vector<bool>(3, true));
+        EXPECT_EQ(counting.calls[TWCurveSECP256k1], 10);
+    }
+    EXPECT_TRUE(CryptoBackend::isDefault());
+    privateKey.sign(digest, TWCurveSECP256k1);
+    EXPECT_EQ(counting.calls[TWCurveSECP256k1], 10);
+}
+
+TEST(CryptoBackend, FailuresPropagate) {
+    RefusingBackend refusing;
+    ScopedBackend scope(refusing);
+    const auto digest = Hash::keccak256(TW::data("hello"));
+    EXPECT_TRUE(privateKey.sign(digest, TWCurveSECP256k1).empty());
+    EXPECT_TRUE(privateKey.signAsDER(digest).empty());
+    EXPECT_FALSE(privateKey.sign(digest, TWCurveNIST256p1).empty());
+
+    const auto context = SigningContext(privateKey, TWCurveSECP256k1);
+    EXPECT_TRUE(context.sign(digest).empty());
+}
+
+} // namespace TW::CryptoBackendTests
@@ -9,6 +9,7 @@
 #include "HexCoding.h"
 
 #include <TrustWalletCore/TWAESPaddingMode.h>
+#include <TrezorCrypto/aes.h>
 
 #include <gtest/gtest.h>
 
@@ -202,4 +203,155 @@ TEST(Encrypt, AESCTRDecryptInvalidKeySize) {
     ADD_FAILURE() << "Missed expected exeption";
 }
 
+TEST(Encrypt, AESMatchesPortableImplementation) {
+    // Compares with trezor-crypto across key sizes, block counts and partial blocks,
+    // which also covers the hardware paths when they are in use.
+    for (const auto keySize : {16, 24, 32}) {
+        Data key(keySize);
+        for (int i = 0; i < keySize; ++i) {
+            key[i] = static_cast<byte>(7 * i + keySize);
+        }
+        for (const auto size : {0, 1, 15, 16, 17, 64, 100, 127, 128, 129, 300}) {
+            // A fresh context each time, trezor-crypto keeps the CTR position in it.
+            aes_encrypt_ctx encryptCtx;
+            aes_decrypt_ctx decryptCtx;
+            ASSERT_EQ(aes_encrypt_key(key.data(), keySize, &encryptCtx), EXIT_SUCCESS);
+            ASSERT_EQ(aes_decrypt_key(key.data(), keySize, &decryptCtx), EXIT_SUCCESS);
+
+            Data data(size);
+            for (int i = 0; i < size; ++i) {
+                data[i] = static_cast<byte>(31 * i + 5);
+            }
+            // Counter close to overflowing its low bytes.
+            const auto initialIv = parse_hex("000102030405060708090a0bfffffffe");
+
+            Data iv = initialIv;
+            Data expectedIv = initialIv;
+            Data expected(size);
+            aes_ctr_encrypt(data.data(), expected.data(), size, expectedIv.data(), aes_ctr_cbuf_inc, &encryptCtx);
+            EXPECT_EQ(hex(AESCTREncrypt(key, data, iv)), hex(expected)) << keySize << " " << size;
+            EXPECT_EQ(hex(iv), hex(expectedIv));
+
+            if (size % 16 != 0) {
+                continue;
+            }
+            iv = initialIv;
+            expectedIv = initialIv;
+            aes_cbc_encrypt(data.data(), expected.data(), size, expectedIv.data(), &encryptCtx);
+            EXPECT_EQ(hex(AESCBCEncrypt(key, data, iv)), hex(expected)) << keySize << " " << size;
+            EXPECT_EQ(hex(iv), hex(expectedIv));
+
+            iv = initialIv;
+            expectedIv = initialIv;
+            aes_cbc_decrypt(data.data(), expected.data(), size, expectedIv.data(), &decryptCtx);
+            EXPECT_EQ(hex(AESCBCDecrypt(key, data, iv)), hex(expected)) << keySize << " " << size;
+            EXPECT_EQ(hex(iv), hex(expectedIv));
+        }
+    }
+}
+
+const Data gGCMKey = parse_hex("feffe9928665731c6d6a8f9467308308");
+const Data gGCMPlaintext = parse_hex("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39");
+const Data gGCMAad = parse_hex("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+
+TEST(Encrypt, AESGCMEncrypt) {
+    // Test vectors from the GCM specification (McGrew & Viega), test cases 2, 4, 6 and 16.
+    assertHexEqual(AESGCMEncrypt(Data(16), Data(16), Data(12)),
+                   "0388dace60b6a392f328c2b971b2fe78ab6e47d42cec13bdf53a67b21257bddf");
+    assertHexEqual(AESGCMEncrypt(gGCMKey, gGCMPlaintext, parse_hex("cafebabefacedbaddecaf888"), gGCMAad),
+                   "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"
+                   "5bc94fbc3221a5db94fae95ae7121a47");
+    // 60-byte IV.
+    assertHexEqual(AESGCMEncrypt(gGCMKey, gGCMPlaintext, parse_hex("9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b"), gGCMAad),
+                   "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca701e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5"
+                   "619cc5aefffe0bfa462af43c1699d050");
+    // AES-256.
+    const auto key256 = parse_hex("feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308");
+    assertHexEqual(AESGCMEncrypt(key256, gGCMPlaintext, parse_hex("cafebabefacedbaddecaf888"), gGCMAad),
+                   "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662"
+                   "76fc6ece0f4e1768cddf8853bb2d551b");
+    // Empty message, tag only.
+    assertHexEqual(AESGCMEncrypt(gKey, {}, parse_hex("cafebabefacedbaddecaf888")), "baf97f018b0972029bf15b41956729c3");
+}
+
+TEST(Encrypt, AESGCMDecrypt) {
+    const auto iv = parse_hex("cafebabefacedbaddecaf888");
+    const auto sealed = AESGCMEncrypt(gGCMKey, gGCMPlaintext, iv, gGCMAad);
+    EXPECT_EQ(hex(AESGCMDecrypt(gGCMKey, sealed, iv, gGCMAad)), hex(gGCMPlaintext));
+
+    auto tampered = sealed;
+    tampered[3] ^= 1;
+    EXPECT_THROW(AESGCMDecrypt(gGCMKey, tampered, iv, gGCMAad), std::invalid_argument);
+    tampered = sealed;
+    tampered.back() ^= 0x80;
+    EXPECT_THROW(AESGCMDecrypt(gGCMKey, tampered, iv, gGCMAad), std::invalid_argument);
+    EXPECT_THROW(AESGCMDecrypt(gGCMKey, sealed, iv, {}), std::invalid_argument);
+    EXPECT_THROW(AESGCMDecrypt(gGCMKey, Data(15), iv, gGCMAad), std::invalid_argument);
+}
+
+TEST(Encrypt, AESGCMInvalidParameters) {
+    EXPECT_THROW(AESGCMEncrypt(Data(15), gGCMPlaintext, Data(12)), std::invalid_argument);
+    EXPECT_THROW(AESGCMEncrypt(gGCMKey, gGCMPlaintext, {}), std::invalid_argument);
+    EXPECT_THROW(AESGCMDecrypt(Data(15), Data(16), Data(12)), std::invalid_argument);
+}
+
+namespace {
+
+/// Runs the stream over `input` split in chunks of `chunk` bytes.
+Data stream(AESStream&& aes, const Data& input, size_t chunk) {
+    Data output;
+    for (size_t offset = 0; offset < input.size(); offset += chunk) {
+        append(output, aes.update(Data(input.begin() + offset, input.begin() + std::min(input.size(), offset + chunk))));
+    }
+    append(output, aes.finish());
+    return output;
+}
+
+} // namespace
+
+TEST(Encrypt, AESStreamMatchesOneShot) {
+    Data plaintext(1000);
+    for (size_t i = 0; i < plaintext.size(); ++i) {
+        plaintext[i] = static_cast<byte>(i * 7 + 3);
+    }
+    const auto iv = parse_hex("000102030405060708090a0b0c0d0e0f");
+    const auto nonce = parse_hex("cafebabefacedbaddecaf888");
+    for (const size_t size : {0, 1, 15, 16, 17, 64, 1000}) {
+        const auto input = Data(plaintext.begin(), plaintext.begin() + size);
+        for (const size_t chunk : {1, 5, 16, 33, 1000}) {
+            for (const auto padding : {TWAESPaddingModeZero, TWAESPaddingModePKCS7}) {
+                auto cbcIv = iv;
+                const auto cbc = AESCBCEncrypt(gKey, input, cbcIv, padding);
+                EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::CBC, false, gKey, iv, padding), input, chunk)), hex(cbc)) << size << " " << chunk;
+                cbcIv = iv;
+                EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::CBC, true, gKey, iv, padding), cbc, chunk)), hex(AESCBCDecrypt(gKey, cbc, cbcIv, padding)));
+            }
+
+            auto ctrIv = iv;
+            const auto ctr = AESCTREncrypt(gKey, input, ctrIv);
+            EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::CTR, false, gKey, iv), input, chunk)), hex(ctr)) << size << " " << chunk;
+            EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::CTR, true, gKey, iv), ctr, chunk)), hex(input));
+
+            const auto gcm = AESGCMEncrypt(gKey, input, nonce, gGCMAad);
+            EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::GCM, false, gKey, nonce, TWAESPaddingModeZero, gGCMAad), input, chunk)), hex(gcm)) << size << " " << chunk;
+            EXPECT_EQ(hex(stream(AESStream(AESStream::Mode::GCM, true, gKey, nonce, TWAESPaddingModeZero, gGCMAad), gcm, chunk)), hex(input));
+        }
+    }
+}
+
+TEST(Encrypt, AESStreamErrors) {
+    const auto iv = parse_hex("000102030405060708090a0b0c0d0e0f");
+    EXPECT_THROW(AESStream(AESStream::Mode::CBC, false, Data(15), iv), std::invalid_argument);
+    EXPECT_THROW(AESStream(AESStream::Mode::CTR, false, gKey, Data(12)), std::invalid_argument);
+    EXPECT_THROW(AESStream(AESStream::Mode::GCM, false, gKey, {}), std::invalid_argument);
+
+    EXPECT_THROW(stream(AESStream(AESStream::Mode::CBC, true, gKey, iv), Data(20), 7), std::invalid_argument);
+
+    const auto nonce = parse_hex("cafebabefacedbaddecaf888");
+    auto sealed = AESGCMEncrypt(gGCMKey, gGCMPlaintext, nonce, gGCMAad);
+    sealed[3] ^= 1;
+    EXPECT_THROW(stream(AESStream(AESStream::Mode::GCM, true, gGCMKey, nonce, TWAESPaddingModeZero, gGCMAad), sealed, 16), std::invalid_argument);
+    EXPECT_THROW(stream(AESStream(AESStream::Mode::GCM, true, gGCMKey, nonce), Data(15), 16), std::invalid_argument);
+}
+
 } // namespace TW::Encrypt::tests
@@ -0,0 +1,107 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Executor.h"
+#include "algorithm/parallel.h"
+
+#include <TrustWalletCore/TWExecutor.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace TW::tests {
+
+TEST(Executor, SubmitRunsAllJobs) {
+    std::mutex mutex;
+    std::condition_variable done;
+    auto count = 0;
+    for (auto i = 0; i < 100; ++i) {
+        Executor::shared().submit([&] {
+            std::lock_guard lock(mutex);
+            ++count;
+            done.notify_all();
+        });
+    }
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&] { return count == 100; });
+    EXPECT_EQ(count, 100);
+}
+
+TEST(Executor, NestedParallelFor) {
+    // inner loops run on workers busy with the outer one, and must not wait for queued helpers
+    std::atomic<std::size_t> sum{0};
+    parallelFor(16, 0, [&](std::size_t) {
+        parallelFor(100, 0, [&](std::size_t i) { sum += i; });
+    });
+    EXPECT_EQ(sum.load(), 16ul * 4950);
+}
+
+TEST(Executor, ConfigureThreads) {
+    TWExecutorConfigure(2, 0, 0);
+    EXPECT_EQ(TWExecutorThreadCount(), 2u);
+    EXPECT_EQ(parallelWorkerCount(10, 0), 2ul);
+
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    std::vector<int> seen(1000, 0);
+    parallelFor(seen.size(), 8, [&](std::size_t i) {
+        std::lock_guard lock(mutex);
+        ids.insert(std::this_thread::get_id());
+        ++seen[i];
+    });
+    for (auto count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+    // the calling thread and the workers, the helpers beyond two are cancelled or picked by a retiring worker
+    EXPECT_LE(ids.size(), 8ul);
+
+    TWExecutorConfigure(0, 0, 0);
+    EXPECT_EQ(TWExecutorThreadCount(), std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+TEST(Executor, HostExecutor) {
+    std::vector<TWExecutorJob*> jobs;
+    TWExecutorSetHost([](TWExecutorJob* job, void* context) { static_cast<std::vector<TWExecutorJob*>*>(context)->push_back(job); }, &jobs);
+
+    // the host runs nothing before the loop is over: the calling thread does all the work
+    std::vector<int> seen(100, 0);
+    parallelFor(seen.size(), 4, [&](std::size_t i) { ++seen[i]; });
+    TWExecutorSetHost(nullptr, nullptr);
+    ASSERT_EQ(jobs.size(), 3ul);
+    for (auto count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+    // the helpers were cancelled and return at once
+    for (auto* job : jobs) {
+        TWExecutorRunJob(job);
+    }
+    for (auto count : seen) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(Executor, HostExecutorThreads) {
+    std::vector<std::thread> threads;
+    TWExecutorSetHost([](TWExecutorJob* job, void* context) {
+        static_cast<std::vector<std::thread>*>(context)->emplace_back([job] { TWExecutorRunJob(job); });
+    }, &threads);
+
+    std::atomic<std::size_t> sum{0};
+    parallelFor(1000, 4, [&](std::size_t i) { sum += i; });
+    TWExecutorSetHost(nullptr, nullptr);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(sum.load(), 499500ul);
+}
+
+} // namespace TW::tests
@@ -0,0 +1,85 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "FixedUint256.h"
+#include "HexCoding.h"
+#include "uint256.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+namespace TW {
+
+const auto maxValue = uint256_t("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+
+static_assert(FixedUint256(2) * FixedUint256(21) == FixedUint256(42));
+static_assert((FixedUint256(1) << 255 >> 255) == FixedUint256(1));
+static_assert((FixedUint256(0) - FixedUint256(1)).bitLength() == 256);
+
+TEST(FixedUint256, LoadStore) {
+    const auto bytes = parse_hex("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef");
+    const auto value = FixedUint256::loadBE(bytes);
+    EXPECT_EQ(value.limbs[0], 0x0123456789abcdefULL);
+    EXPECT_EQ(value.byteLength(), 32ul);
+
+    std::array<byte, 32> stored{};
+    value.storeBE(stored);
+    EXPECT_EQ(hex(stored), hex(bytes));
+
+    // only the rightmost 32 bytes of a longer input are used, like load
+    auto longer = parse_hex("ff");
+    append(longer, bytes);
+    EXPECT_EQ(FixedUint256::loadBE(longer), value);
+    EXPECT_EQ(FixedUint256::loadBE(Data()), FixedUint256());
+
+    Data appended = parse_hex("aa");
+    FixedUint256::loadBE(parse_hex("0100")).appendBE(appended);
+    FixedUint256().appendBE(appended, 3);
+    EXPECT_EQ(hex(appended), "aa0100000000");
+}
+
+TEST(FixedUint256, MatchesBoost) {
+    std::mt19937_64 random(49);
+    const auto next = [&random] {
+        Data bytes(random() % 33);
+        for (auto& byte : bytes) {
+            byte = static_cast<TW::byte>(random());
+        }
+        return bytes;
+    };
+    for (int i = 0; i < 200; ++i) {
+        const auto a = next(), b = next();
+        const auto fixedA = FixedUint256::loadBE(a), fixedB = FixedUint256::loadBE(b);
+        const auto boostA = load(a), boostB = load(b);
+        const auto shift = static_cast<unsigned>(random() % 260);
+
+        ASSERT_EQ(toFixed(boostA), fixedA);
+        ASSERT_EQ(toBoost(fixedA), boostA);
+        EXPECT_EQ(toBoost(fixedA + fixedB), (boostA + boostB) & maxValue);
+        EXPECT_EQ(toBoost(fixedA - fixedB), boostA >= boostB ? boostA - boostB : maxValue - (boostB - boostA) + 1);
+        EXPECT_EQ(toBoost(fixedA * fixedB), boostA * boostB);
+        EXPECT_EQ(toBoost(fixedA << shift), shift < 256 ? uint256_t(boostA << shift) : uint256_t(0));
+        EXPECT_EQ(toBoost(fixedA >> shift), shift < 256 ? uint256_t(boostA >> shift) : uint256_t(0));
+        EXPECT_EQ(toBoost(fixedA & fixedB), boostA & boostB);
+        EXPECT_EQ(toBoost(fixedA | fixedB), boostA | boostB);
+        EXPECT_EQ(toBoost(fixedA ^ fixedB), boostA ^ boostB);
+        EXPECT_EQ(toBoost(~fixedA), maxValue - boostA);
+        EXPECT_EQ(fixedA < fixedB, boostA < boostB);
+        EXPECT_EQ(fixedA.bitLength(), boostA == 0 ? 0 : boost::multiprecision::msb(boostA) + 1);
+        EXPECT_EQ(fixedA.toString(), boost::lexical_cast<std::string>(boostA));
+    }
+}
+
+TEST(FixedUint256, ToString) {
+    EXPECT_EQ(FixedUint256().toString(), "0");
+    EXPECT_EQ(FixedUint256(1000000000).toString(), "1000000000");
+    EXPECT_EQ(toFixed(maxValue).toString(),
+              "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+}
+
+} // namespace TW
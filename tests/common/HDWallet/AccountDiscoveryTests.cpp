@@ -0,0 +1,144 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AccountDiscovery.h"
+#include "Coin.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace TW::AccountDiscoveryTests {
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+std::string expectedAddress(const HDWallet<>& wallet, TWCoinType coin, TWDerivation derivation, const DerivationPath& path) {
+    return TW::deriveAddress(coin, wallet.getKey(coin, path), derivation);
+}
+
+TEST(AccountDiscovery, Plan) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto discovery = AccountDiscovery(wallet, {
+        {TWCoinTypeEthereum, TWDerivationDefault, 0, 2, 5},
+        {TWCoinTypePolygon, TWDerivationDefault, 0, 2, 5},
+        {TWCoinTypeSmartChain, TWDerivationDefault, 1, 1, 5},
+        {TWCoinTypeBitcoin, TWDerivationDefault, 0, 1, 20},
+        {TWCoinTypeBitcoin, TWDerivationBitcoinLegacy, 0, 1, 20},
+        {TWCoinTypeSolana, TWDerivationDefault, 0, 3, 20},
+        {TWCoinTypeEthereum, TWDerivationDefault, 0, 1, 5},
+    });
+
+    const auto& plan = discovery.plan();
+    ASSERT_EQ(plan.size(), 7ul);
+    EXPECT_EQ(plan[0].path.string(), "m/44'/60'/0'/0/0");
+    ASSERT_EQ(plan[0].members.size(), 2ul);
+    EXPECT_EQ(plan[0].members[0].coin, TWCoinTypeEthereum);
+    EXPECT_EQ(plan[0].members[1].coin, TWCoinTypePolygon);
+    EXPECT_TRUE(plan[0].gapScan);
+    EXPECT_EQ(plan[1].path.string(), "m/44'/60'/1'/0/0");
+    EXPECT_EQ(plan[1].account, 1u);
+    ASSERT_EQ(plan[1].members.size(), 3ul);
+    EXPECT_EQ(plan[1].members[2].coin, TWCoinTypeSmartChain);
+    EXPECT_EQ(plan[2].path.string(), "m/84'/0'/0'/0/0");
+    EXPECT_EQ(plan[3].path.string(), "m/44'/0'/0'/0/0");
+    EXPECT_EQ(plan[4].path.string(), "m/44'/501'/0'");
+    EXPECT_FALSE(plan[4].gapScan);
+    EXPECT_EQ(plan[6].path.string(), "m/44'/501'/2'");
+
+    EXPECT_THROW(AccountDiscovery(wallet, {{TWCoinTypeEthereum, TWDerivationDefault, 0x7fffffff, 2, 5}}), std::invalid_argument);
+}
+
+TEST(AccountDiscovery, Run) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto discovery = AccountDiscovery(wallet, {
+        {TWCoinTypeEthereum, TWDerivationDefault, 0, 1, 5},
+        {TWCoinTypePolygon, TWDerivationDefault, 0, 1, 3},
+        {TWCoinTypeBitcoin, TWDerivationDefault, 0, 2, 4},
+        {TWCoinTypeSolana, TWDerivationDefault, 0, 2, 20},
+    });
+
+    auto ethPath = DerivationPath("m/44'/60'/0'/0/0");
+    ethPath.indices[4].value = 3;
+    const auto ethUsed = expectedAddress(wallet, TWCoinTypeEthereum, TWDerivationDefault, ethPath);
+    const auto bitcoinUsed = expectedAddress(wallet, TWCoinTypeBitcoin, TWDerivationDefault, DerivationPath("m/84'/0'/1'/0/0"));
+    const auto solanaUsed = expectedAddress(wallet, TWCoinTypeSolana, TWDerivationDefault, DerivationPath("m/44'/501'/1'"));
+
+    for (const auto threads : {1ul, 0ul}) {
+        std::map<std::pair<TWCoinType, uint32_t>, uint32_t> scanned;
+        const auto used = discovery.run(
+            [&](const DiscoveredAddress& address) {
+                return (address.coin == TWCoinTypeEthereum && address.address == ethUsed) ||
+                       (address.coin == TWCoinTypeBitcoin && address.address == bitcoinUsed) ||
+                       (address.coin == TWCoinTypeSolana && address.address == solanaUsed);
+            },
+            [&](const DiscoveredAddress& address, bool) {
+                EXPECT_EQ(address.address, expectedAddress(wallet, address.coin, address.derivation, address.path));
+                auto& count = scanned[{address.coin, address.account}];
+                EXPECT_EQ(address.index, address.path.indices.size() == 5 ? count : 0u);
+                ++count;
+            },
+            threads);
+
+        ASSERT_EQ(used.size(), 3ul);
+        EXPECT_EQ(used[0].coin, TWCoinTypeEthereum);
+        EXPECT_EQ(used[0].index, 3u);
+        EXPECT_EQ(used[0].address, ethUsed);
+        EXPECT_EQ(used[1].coin, TWCoinTypeBitcoin);
+        EXPECT_EQ(used[1].account, 1u);
+        EXPECT_EQ(used[1].index, 0u);
+        EXPECT_EQ(used[2].coin, TWCoinTypeSolana);
+        EXPECT_EQ(used[2].account, 1u);
+
+        // the gap limit of each coin counts from its last used address
+        EXPECT_EQ((scanned[{TWCoinTypeEthereum, 0}]), 9u);
+        EXPECT_EQ((scanned[{TWCoinTypePolygon, 0}]), 3u);
+        EXPECT_EQ((scanned[{TWCoinTypeBitcoin, 0}]), 4u);
+        EXPECT_EQ((scanned[{TWCoinTypeBitcoin, 1}]), 5u);
+        EXPECT_EQ((scanned[{TWCoinTypeSolana, 0}]), 1u);
+        EXPECT_EQ((scanned[{TWCoinTypeSolana, 1}]), 1u);
+    }
+}
+
+TEST(AccountDiscovery, CosmosChains) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto discovery = AccountDiscovery(wallet, {
+        {TWCoinTypeCosmos, TWDerivationDefault, 0, 1, 3},
+        {TWCoinTypeOsmosis, TWDerivationDefault, 0, 1, 4},
+        {TWCoinTypeKava, TWDerivationDefault, 0, 1, 3},
+        {TWCoinTypeJuno, TWDerivationDefault, 0, 1, 2},
+        {TWCoinTypeNativeEvmos, TWDerivationDefault, 0, 1, 2},
+    });
+
+    // the coins using m/44'/118' share the keys, their addresses only differ by HRP
+    const auto& plan = discovery.plan();
+    ASSERT_EQ(plan.size(), 3ul);
+    ASSERT_EQ(plan[0].members.size(), 3ul);
+    EXPECT_EQ(plan[0].members[2].coin, TWCoinTypeJuno);
+    EXPECT_EQ(plan[1].path.string(), "m/44'/459'/0'/0/0");
+    EXPECT_EQ(plan[2].path.string(), "m/44'/60'/0'/0/0");
+
+    std::map<TWCoinType, uint32_t> scanned;
+    const auto used = discovery.run(
+        [](const DiscoveredAddress&) { return false; },
+        [&](const DiscoveredAddress& address, bool) {
+            EXPECT_EQ(address.address, expectedAddress(wallet, address.coin, address.derivation, address.path));
+            ++scanned[address.coin];
+        },
+        1);
+    EXPECT_TRUE(used.empty());
+    EXPECT_EQ(scanned[TWCoinTypeCosmos], 3u);
+    EXPECT_EQ(scanned[TWCoinTypeOsmosis], 4u);
+    EXPECT_EQ(scanned[TWCoinTypeJuno], 2u);
+    EXPECT_EQ(scanned[TWCoinTypeNativeEvmos], 2u);
+}
+
+TEST(AccountDiscovery, CallbackException) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto discovery = AccountDiscovery(wallet, {{TWCoinTypeEthereum, TWDerivationDefault, 0, 4, 5}});
+    EXPECT_THROW(discovery.run([](const DiscoveredAddress&) -> bool { throw std::runtime_error("offline"); }, nullptr, 2), std::runtime_error);
+}
+
+} // namespace TW::AccountDiscoveryTests
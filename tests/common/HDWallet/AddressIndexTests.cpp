@@ -0,0 +1,89 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressIndex.h"
+#include "ExtendedPublicKey.h"
+#include "TestUtilities.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace TW::AddressIndexTests {
+
+const auto zpub = "zpub6rFR7y4Q2AijBEqTUquhVz398htDFrtymD9xYYfG1m4wAcvPhXNfE3EfH1r1ADqtfSdVCToUG868RvUUkgDKf31mGDtKsAYz2oz2AGutZYs";
+
+std::string indexPath(const std::string& name) {
+    return getTestTempDir() + "/" + name;
+}
+
+TEST(AddressIndex, BuildAndFind) {
+    const auto path = indexPath("address_index_find.bin");
+    auto options = AddressIndex::Options();
+    options.count = 300;
+    options.threads = 4;
+    EXPECT_EQ(AddressIndex::build(path, {{zpub, TWCoinTypeBitcoin}}, options), 600ul);
+
+    const auto index = AddressIndex(path);
+    EXPECT_EQ(index.size(), 600ul);
+    EXPECT_TRUE(index.hasBloomFilter());
+
+    const auto location = index.find("bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+    ASSERT_TRUE(location.has_value());
+    EXPECT_EQ(*location, (AddressIndex::Location{TWCoinTypeBitcoin, 0, 0, 4}));
+    EXPECT_TRUE(index.mayContain("bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n"));
+
+    // past the first chunk, on the internal chain
+    const auto key = ExtendedPublicKey::parse(zpub, TWCoinTypeBitcoin);
+    ASSERT_TRUE(key.has_value());
+    const auto change = key->derive(1, 299);
+    ASSERT_TRUE(change.has_value());
+    EXPECT_EQ(index.find(change->address()), (AddressIndex::Location{TWCoinTypeBitcoin, 0, 1, 299}));
+
+    // not derived
+    const auto beyond = key->derive(0, 300);
+    ASSERT_TRUE(beyond.has_value());
+    EXPECT_FALSE(index.find(beyond->address()).has_value());
+    EXPECT_FALSE(index.find("bc1qxyz").has_value());
+
+    std::remove(path.c_str());
+}
+
+TEST(AddressIndex, WithoutBloomFilter) {
+    const auto path = indexPath("address_index_nobloom.bin");
+    auto options = AddressIndex::Options();
+    options.changeCount = 1;
+    options.startIndex = 2;
+    options.count = 5;
+    options.bloomBitsPerAddress = 0;
+    EXPECT_EQ(AddressIndex::build(path, {{zpub, TWCoinTypeBitcoin}}, options), 5ul);
+
+    const auto index = AddressIndex(path);
+    EXPECT_FALSE(index.hasBloomFilter());
+    EXPECT_TRUE(index.mayContain("bc1qxyz"));
+    EXPECT_EQ(index.find("bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n"), (AddressIndex::Location{TWCoinTypeBitcoin, 0, 0, 4}));
+
+    std::remove(path.c_str());
+}
+
+TEST(AddressIndex, Invalid) {
+    const auto path = indexPath("address_index_invalid.bin");
+    EXPECT_THROW(AddressIndex::build(path, {{"xpub0000", TWCoinTypeBitcoin}}, {}), std::invalid_argument);
+    auto options = AddressIndex::Options();
+    options.startIndex = 0x7fffffff;
+    EXPECT_THROW(AddressIndex::build(path, {{zpub, TWCoinTypeBitcoin}}, options), std::invalid_argument);
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "TWAI but not an index, not even close";
+    }
+    EXPECT_THROW(AddressIndex{path}, std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(AddressIndex{path}, std::runtime_error);
+}
+
+} // namespace TW::AddressIndexTests
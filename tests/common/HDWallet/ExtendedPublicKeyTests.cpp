@@ -0,0 +1,90 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Coin.h"
+#include "ExtendedPublicKey.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::ExtendedPublicKeyTests {
+
+const auto mnemonic1 = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const auto zpub = "zpub6rFR7y4Q2AijBEqTUquhVz398htDFrtymD9xYYfG1m4wAcvPhXNfE3EfH1r1ADqtfSdVCToUG868RvUUkgDKf31mGDtKsAYz2oz2AGutZYs";
+
+TEST(ExtendedPublicKey, ParseAndDerive) {
+    const auto key = ExtendedPublicKey::parse(zpub, TWCoinTypeBitcoin);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key->depth(), 3ul);
+
+    const auto child4 = key->derive(0, 4);
+    ASSERT_TRUE(child4.has_value());
+    EXPECT_EQ(child4->depth(), 5ul);
+    EXPECT_EQ(child4->childNumber(), 4ul);
+    EXPECT_EQ(hex(child4->publicKey().bytes), "03995137c8eb3b223c904259e9b571a8939a0ec99b0717684c3936407ca8538c1b");
+    EXPECT_EQ(child4->address(), "bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+
+    const auto child11 = key->derive(0, 11);
+    ASSERT_TRUE(child11.has_value());
+    EXPECT_EQ(hex(child11->publicKey().bytes), "0226a07edd0227fa6bc36239c0bd4db83d5e488f8fb1eeb68f89a5be916aad2d60");
+
+    EXPECT_FALSE(key->derive(0x80000000).has_value());
+}
+
+TEST(ExtendedPublicKey, AddressIterator) {
+    const auto key = ExtendedPublicKey::parse(zpub, TWCoinTypeBitcoin);
+    ASSERT_TRUE(key.has_value());
+
+    auto iterator = key->addresses(0, 3);
+    EXPECT_EQ(iterator.index(), 3ul);
+    const auto address3 = iterator.next();
+    EXPECT_EQ(iterator.next(), "bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+    EXPECT_EQ(iterator.index(), 5ul);
+
+    const auto range = key->range(0, 3, 2);
+    ASSERT_EQ(range.size(), 2ul);
+    EXPECT_EQ(range[0], address3);
+    EXPECT_EQ(range[1], "bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+
+    auto last = key->addresses(0, 0x7fffffff);
+    EXPECT_NO_THROW(last.next());
+    EXPECT_THROW(last.next(), std::out_of_range);
+
+    EXPECT_THROW(key->addresses(0x80000000), std::invalid_argument);
+    EXPECT_THROW(key->range(0, 0x7fffffff, 2), std::invalid_argument);
+}
+
+TEST(ExtendedPublicKey, MatchesPrivateDerivation) {
+    const auto wallet = HDWallet(mnemonic1, "");
+    for (auto coin : {TWCoinTypeEthereum, TWCoinTypeBitcoin, TWCoinTypeFilecoin, TWCoinTypeNEO}) {
+        const auto xpub = wallet.getExtendedPublicKey(TW::purpose(coin), coin, TWHDVersionXPUB);
+        const auto key = ExtendedPublicKey::parse(xpub, coin);
+        ASSERT_TRUE(key.has_value());
+
+        const auto addresses = key->range(0, 0, 5);
+        ASSERT_EQ(addresses.size(), 5ul);
+        for (auto i = 0u; i < addresses.size(); ++i) {
+            const auto path = DerivationPath(TW::purpose(coin), TW::slip44Id(coin), 0, 0, i);
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path)));
+        }
+    }
+}
+
+TEST(ExtendedPublicKey, Invalid) {
+    EXPECT_FALSE(ExtendedPublicKey::parse("xpub0000", TWCoinTypeBitcoin).has_value());
+    // no public derivation on ed25519 curves
+    EXPECT_FALSE(ExtendedPublicKey::parse(zpub, TWCoinTypeSolana).has_value());
+    EXPECT_FALSE(ExtendedPublicKey::parse(zpub, TWCoinTypeCardano).has_value());
+    // secp256k1 point is not on nist256p1
+    EXPECT_FALSE(ExtendedPublicKey::parse("xpub6BosfCnifzxcFwrSzQiqu2DBVTshkCXacvNsWGYJVVhhawA7d4R5WSWGFNbi8Aw6ZRc1brxMyWMzG3DSSSSoekkudhUd9yLb6qx39T9nMdj", TWCoinTypeNEO).has_value());
+    // private extended key
+    const auto wallet = HDWallet(mnemonic1, "");
+    const auto xprv = wallet.getExtendedPrivateKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPRV);
+    EXPECT_FALSE(ExtendedPublicKey::parse(xprv, TWCoinTypeBitcoin).has_value());
+}
+
+} // namespace TW::ExtendedPublicKeyTests
@@ -33,7 +33,7 @@ std::string nodeToHexString(const HDNode& node) {
 }
 
 Data publicKeyFromPrivateKey(const Data& privateKey) {
-    return PrivateKey(privateKey).getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+    return Data(PrivateKey(privateKey).getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
 }
 
 TEST(HDWalletInternal, SquareDerivationRoutes) {
@@ -16,6 +16,7 @@
 #include "Ethereum/EIP2645.h"
 #include "Ethereum/MessageSigner.h"
 #include "Ethereum/Signer.h"
+#include "HDNodeCache.h"
 #include "HDWallet.h"
 #include "Hash.h"
 #include "Hedera/DER.h"
@@ -29,6 +30,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 extern std::string TESTS_ROOT;
 
 namespace TW::HDWalletTests {
@@ -296,6 +299,38 @@ TEST(HDWallet, Bip39Vectors) {
     }
 }
 
+TEST(HDWallet, Bip39VectorsBatch) {
+    const auto vectors = getVectors();
+    std::vector<std::string> mnemonics;
+    for (const auto& v : vectors) {
+        mnemonics.push_back(v[1]);
+    }
+    for (const auto threads : {1ul, 0ul}) {
+        const auto wallets = HDWallet<>::createBatch(mnemonics, {"TREZOR"}, true, threads);
+        ASSERT_EQ(wallets.size(), vectors.size());
+        for (size_t i = 0; i < wallets.size(); ++i) {
+            EXPECT_EQ(wallets[i].getMnemonic(), mnemonics[i]);
+            EXPECT_EQ(wallets[i].getPassphrase(), "TREZOR");
+            EXPECT_EQ(hex(wallets[i].getEntropy()), vectors[i][0].get<std::string>());
+            EXPECT_EQ(hex(wallets[i].getSeed()), vectors[i][2].get<std::string>());
+        }
+    }
+}
+
+TEST(HDWallet, CreateBatch) {
+    const std::vector<std::string> passphrases = {"", gPassphrase, "a", "bb", "ccc", std::string(300, 'x')};
+    const auto wallets = HDWallet<>::createBatch({mnemonic1}, passphrases);
+    ASSERT_EQ(wallets.size(), passphrases.size());
+    for (size_t i = 0; i < passphrases.size(); ++i) {
+        EXPECT_EQ(hex(wallets[i].getSeed()), hex(HDWallet(mnemonic1, passphrases[i]).getSeed()));
+    }
+
+    EXPECT_TRUE(HDWallet<>::createBatch({}, {}).empty());
+    EXPECT_THROW(HDWallet<>::createBatch({mnemonic1, mnemonic1}, {"a", "b", "c"}), std::invalid_argument);
+    EXPECT_THROW(HDWallet<>::createBatch({mnemonic1, "ripple scissors"}, {""}), std::invalid_argument);
+    EXPECT_NO_THROW(HDWallet<>::createBatch({mnemonic1, "ripple scissors"}, {""}, false));
+}
+
 TEST(HDWallet, getExtendedPrivateKey) {
     const HDWallet wallet = HDWallet(mnemonic1, "");
     const auto purpose = TWPurposeBIP44;
@@ -433,6 +468,85 @@ TEST(HDWallet, getKey) {
     }
 }
 
+TEST(HDWallet, getKeyWithNodeCache) {
+    HDWallet wallet = HDWallet(mnemonic1, "");
+    HDWallet cached = HDWallet(mnemonic1, "");
+    cached.enableNodeCache(4);
+    ASSERT_NE(cached.getNodeCache(), nullptr);
+
+    for (auto i = 0; i < 5; ++i) {
+        const auto path = DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(TWCoinTypeEthereum), 0, 0, i);
+        EXPECT_EQ(hex(cached.getKey(TWCoinTypeEthereum, path).bytes), hex(wallet.getKey(TWCoinTypeEthereum, path).bytes));
+    }
+    // m/44', m/44'/60', m/44'/60'/0' and m/44'/60'/0'/0
+    EXPECT_EQ(cached.getNodeCache()->size(), 4ul);
+
+    // Same prefix on another curve must not be served from the secp256k1 entries
+    const auto derivPath = DerivationPath("m/44'/539'/0'/0/0");
+    EXPECT_EQ(hex(cached.getKeyByCurve(TWCurveSECP256k1, derivPath).bytes), "4fb8657d6464adcaa086d6758d7f0b6b6fc026c98dc1671fcc6460b5a74abc62");
+    EXPECT_EQ(hex(cached.getKeyByCurve(TWCurveNIST256p1, derivPath).bytes), "a13df52d5a5b438bbf921bbf86276e4347fe8e2f2ed74feaaee12b77d6d26f86");
+    EXPECT_EQ(hex(cached.getKeyByCurve(TWCurveSECP256k1, derivPath).bytes), "4fb8657d6464adcaa086d6758d7f0b6b6fc026c98dc1671fcc6460b5a74abc62");
+    EXPECT_EQ(cached.getNodeCache()->size(), 4ul);
+
+    // Cardano keys use a different derivation scheme
+    const auto cardanoPath = TW::derivationPath(TWCoinTypeCardano);
+    EXPECT_EQ(hex(cached.getKey(TWCoinTypeCardano, cardanoPath).bytes), hex(wallet.getKey(TWCoinTypeCardano, cardanoPath).bytes));
+
+    const auto copy = cached;
+    ASSERT_NE(copy.getNodeCache(), nullptr);
+    EXPECT_EQ(copy.getNodeCache()->size(), 0ul);
+    EXPECT_EQ(copy.getNodeCache()->capacity(), 4ul);
+
+    cached.disableNodeCache();
+    EXPECT_EQ(cached.getNodeCache(), nullptr);
+    EXPECT_EQ(hex(cached.getKeyByCurve(TWCurveSECP256k1, derivPath).bytes), "4fb8657d6464adcaa086d6758d7f0b6b6fc026c98dc1671fcc6460b5a74abc62");
+}
+
+TEST(HDWallet, getKeyWithThreadNodeCache) {
+    const HDWallet wallet1 = HDWallet(mnemonic1, "");
+    const HDWallet wallet2 = HDWallet(mnemonic1, gPassphrase);
+    std::vector<std::string> expected;
+    for (auto i = 0; i < 4; ++i) {
+        const auto path = DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(TWCoinTypeEthereum), 0, 0, i);
+        expected.push_back(hex(wallet1.getKey(TWCoinTypeEthereum, path).bytes));
+        expected.push_back(hex(wallet2.getKey(TWCoinTypeEthereum, path).bytes));
+    }
+
+    HDWallet<>::setThreadNodeCacheCapacity(4);
+    // both wallets alternate on every thread, their parent nodes are cached side by side
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::string>> results(4);
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto round = 0; round < 2; ++round) {
+                for (auto i = 0; i < 4; ++i) {
+                    const auto path = DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(TWCoinTypeEthereum), 0, 0, i);
+                    results[t].push_back(hex(wallet1.getKey(TWCoinTypeEthereum, path).bytes));
+                    results[t].push_back(hex(wallet2.getKey(TWCoinTypeEthereum, path).bytes));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        ASSERT_EQ(result.size(), 2 * expected.size());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin() + expected.size()));
+    }
+
+    // deeper than the cached paths, and from a raw seed
+    const auto seed = parse_hex("0x000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f");
+    const auto starkPath = DerivationPath("m/2645'/579218131'/211006541'/1534045311'/1431804530'/1");
+    const auto starkKey = hex(HDWallet<32>::bip32DeriveRawSeed(TWCoinTypeEthereum, seed, starkPath).bytes);
+    EXPECT_EQ(hex(HDWallet<32>::bip32DeriveRawSeed(TWCoinTypeEthereum, seed, starkPath).bytes), starkKey);
+
+    HDWallet<>::setThreadNodeCacheCapacity(0);
+    EXPECT_EQ(hex(HDWallet<32>::bip32DeriveRawSeed(TWCoinTypeEthereum, seed, starkPath).bytes), starkKey);
+    EXPECT_EQ(hex(wallet2.getKey(TWCoinTypeEthereum, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(TWCoinTypeEthereum), 0, 0, 3)).bytes), expected[7]);
+}
+
 TEST(HDWallet, AptosKey) {
     const auto derivPath = "m/44'/637'/0'/0'/0'";
     HDWallet wallet = HDWallet(mnemonic1, "");
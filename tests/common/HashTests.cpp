@@ -5,6 +5,10 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Hash.h"
+#include "Blake2b.h"
+#include "Groestl.h"
+#include "Keccak.h"
+#include "Sha256.h"
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
@@ -33,6 +37,36 @@ TEST(HashTests, Blake2bPersonal) {
     ASSERT_EQ(result, string("20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4"));
 }
 
+TEST(HashTests, Blake2bContext) {
+    const auto personal = TW::data("MyApp Files Hash");
+    const auto content = TW::data("the same content");
+    EXPECT_EQ(hex(Blake2b::Context(32, personal).hash(content)), "20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4");
+    EXPECT_EQ(hex(Blake2b::Context(64).hash(TW::data("Hello world"))), hex(Hash::blake2b(string("Hello world"), 64)));
+    EXPECT_THROW(Blake2b::Context(0), std::invalid_argument);
+    EXPECT_THROW(Blake2b::Context(65), std::invalid_argument);
+    EXPECT_THROW(Blake2b::Context(32, Data(17)), std::invalid_argument);
+
+    // mixed sizes, so that runs of equal sizes and leftovers both go through the batch
+    const auto context = Blake2b::Context(28, TW::data("personal"));
+    std::vector<Data> messages;
+    for (size_t i = 0; i < 23; ++i) {
+        const auto size = i < 12 ? 32 : i * 13;
+        messages.emplace_back(size, static_cast<uint8_t>(i));
+    }
+    const auto digests = context.hashBatch(messages);
+    ASSERT_EQ(digests.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(digests[i]), hex(Hash::blake2b(messages[i], 28, TW::data("personal")))) << "message " << i;
+    }
+
+    const auto views = std::vector<std::span<const uint8_t>>(messages.begin(), messages.end());
+    Data packed(views.size() * context.hashSize());
+    context.hashBatch(views, packed.data());
+    for (size_t i = 0; i < views.size(); ++i) {
+        EXPECT_EQ(hex(Data(packed.begin() + i * 28, packed.begin() + (i + 1) * 28)), hex(digests[i])) << "message " << i;
+    }
+}
+
 TEST(HashTests, Sha512_256) {
     auto tests = {
         make_tuple(string(""), string("c672b8d1ef56ed28ab87c3622c5114069bdd3ad7b8f9737498d0c01ecef0967a")),
@@ -93,4 +127,221 @@ TEST(HashTests, allHashEnum) {
     }
 }
 
+TEST(HashTests, FixedSizeInto) {
+    const auto input = TW::data(brownFox);
+
+    Hash::Digest20 digest20;
+    Hash::Digest32 digest32;
+    Hash::Digest64 digest64;
+
+    Hash::sha1Into(input.data(), input.size(), digest20);
+    EXPECT_EQ(hex(digest20), "2fd4e1c67a2d28fced849ee1bb76e7391b93eb12");
+    Hash::sha256Into(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
+    Hash::sha512Into(input.data(), input.size(), digest64);
+    EXPECT_EQ(hex(digest64), "07e547d9586f6a73f73fbac0435ed76951218fb7d0c8d788a309d785436bbb642e93a252a954f23912547d1e8a3b5ed6e1bfd7097821233fa0538f3db854fee6");
+    Hash::sha512_256Into(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "dd9d67b371519c339ed8dbd25af90e976a1eeefd4ad3d889005e532fc5bef04d");
+    Hash::keccak256Into(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+    Hash::keccak512Into(input.data(), input.size(), digest64);
+    EXPECT_EQ(hex(digest64), "d135bb84d0439dbac432247ee573a23ea7d3c9deb2a968eb31d47c4fb45f1ef4422d6c531b5b9bd6f449ebcc449ea94d0a8f05f62130fda612da53c79659f609");
+    Hash::sha3_256Into(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "69070dda01975c8c120c3aada1b282394e7f032fa9cf32f4cb2259a0897dfc04");
+    Hash::sha3_512Into(input.data(), input.size(), digest64);
+    EXPECT_EQ(hex(digest64), "01dedd5de4ef14642445ba5f5b97c15e47b9ad931326e4b0727cd94cefc44fff23f07bf543139939b49128caf436dc1bdee54fcb24023a08d9403f9b4bf0d450");
+    Hash::ripemdInto(input.data(), input.size(), digest20);
+    EXPECT_EQ(hex(digest20), "37f332f68db77bd9d7edd4969571ad671cf9dd3b");
+    Hash::blake256Into(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "7576698ee9cad30173080678e5965916adbb11cb5245d386bf1ffda1cb26c9d7");
+    Hash::groestl512Into(input.data(), input.size(), digest64);
+    EXPECT_EQ(hex(digest64), "badc1f70ccd69e0cf3760c3f93884289da84ec13c70b3d12a53a7a8a4a513f99715d46288f55e1dbf926e6d084a0538e4eebfc91cf2b21452921ccde9131718d");
+    Hash::sha256dInto(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "6d37795021e544d82b41850edf7aabab9a0ebe274e54a519840c4666f35b3937");
+    Hash::sha256ripemdInto(input.data(), input.size(), digest20);
+    EXPECT_EQ(hex(digest20), "0e3397b4abc7a382b3ea2365883c3c7ca5f07600");
+    Hash::blake256dInto(input.data(), input.size(), digest32);
+    EXPECT_EQ(hex(digest32), "4511ab8713d8d580cae73061345df903f603b99e7ec699ddae63c56eea200059");
+    Hash::blake256ripemdInto(input.data(), input.size(), digest20);
+    EXPECT_EQ(hex(digest20), "b4b44de1e854f7f3c0520b654204163f75f704e5");
+    Hash::blake2bInto(input.data(), input.size(), digest64);
+    EXPECT_EQ(hex(digest64), hex(Hash::blake2b(input, 64)));
+
+    // Blake2b digests are 1 to 64 bytes
+    std::array<uint8_t, 65> digest65;
+    EXPECT_THROW(Hash::blake2bInto(input.data(), input.size(), digest65), std::invalid_argument);
+    EXPECT_THROW(Hash::blake2bInto(input.data(), input.size(), digest64.data(), 0), std::invalid_argument);
+}
+
+TEST(HashTests, FixedSizeIntoMatchesData) {
+    const auto input = TW::data(brownFoxDot);
+    EXPECT_EQ(hex(Hash::sha256Into(input)), hex(Hash::sha256(input)));
+    EXPECT_EQ(hex(Hash::keccak256Into(input)), hex(Hash::keccak256(input)));
+    EXPECT_EQ(hex(Hash::sha256ripemdInto(input)), hex(Hash::sha256ripemd(input.data(), input.size())));
+    EXPECT_EQ(hex(Hash::sha256dInto(input.data(), input.size())), hex(Hash::sha256d(input.data(), input.size())));
+    EXPECT_EQ(hex(Hash::blake256Into(input.data(), input.size())), hex(Hash::blake256(input)));
+}
+
+TEST(HashTests, CompileTimeHasher) {
+    const auto input = TW::data(brownFox);
+    for (auto hasher = Hash::HasherSha1; hasher <= Hash::HasherGroestl512d; hasher = Hash::Hasher(hasher + 1)) {
+        const auto digest = Hash::withHasher(hasher, [&](auto selected) {
+            const auto hash = Hash::hashInto<decltype(selected)::value>(input);
+            return Data(hash.begin(), hash.end());
+        });
+        EXPECT_EQ(hex(digest), hex(Hash::hash(hasher, input))) << hasher;
+        EXPECT_EQ(digest.size(), Hash::digestSize(hasher)) << hasher;
+    }
+    static_assert(std::tuple_size_v<Hash::Digest<Hash::HasherSha256ripemd>> == 20);
+    static_assert(std::tuple_size_v<Hash::Digest<Hash::HasherGroestl512d>> == 64);
+}
+
+TEST(HashTests, HashBatch) {
+    const std::vector<Data> inputs = {data(brownFox), {}, data(brownFoxDot)};
+    for (const auto hasher : {Hash::HasherSha1, Hash::HasherSha256, Hash::HasherKeccak256, Hash::HasherRipemd, Hash::HasherGroestl512}) {
+        const auto digests = Hash::hashBatch(hasher, inputs);
+        ASSERT_FALSE(digests.empty());
+        const auto size = digests.size() / inputs.size();
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            EXPECT_EQ(Data(digests.begin() + i * size, digests.begin() + (i + 1) * size), Hash::hash(hasher, inputs[i]));
+        }
+    }
+
+    // only single round, fixed-size hashers are batched
+    EXPECT_TRUE(Hash::hashBatch(Hash::HasherSha256d, inputs).empty());
+    Data out(31);
+    EXPECT_FALSE(Hash::hashBatchInto(Hash::HasherSha256, inputs, out.data(), out.size()));
+}
+
+TEST(HashTests, Keccak256Batch) {
+    // mixed sizes around the rate, so that runs of four and single inputs both occur
+    std::vector<Data> inputs;
+    for (size_t i = 0; i < 22; ++i) {
+        const auto size = i < 8 ? 64 : (i < 13 ? 135 + i % 3 : i * 11);
+        inputs.emplace_back(size, static_cast<uint8_t>(i));
+    }
+    const auto digests = Hash::keccak256Batch(inputs);
+    ASSERT_EQ(digests.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(hex(digests[i]), hex(Hash::keccak256(inputs[i]))) << "input " << i;
+    }
+    // the generic batch takes the same path
+    const auto concatenated = Hash::hashBatch(Hash::HasherKeccak256, inputs);
+    ASSERT_EQ(concatenated.size(), inputs.size() * Keccak::digest256Size);
+    EXPECT_EQ(hex(Data(concatenated.end() - Keccak::digest256Size, concatenated.end())), hex(digests.back()));
+    EXPECT_TRUE(Hash::keccak256Batch({}).empty());
+
+    if (Keccak::avx2Supported()) {
+        const auto input = TW::data(brownFox);
+        Data out(4 * Keccak::digest256Size);
+        ASSERT_TRUE(Keccak::hash256x4({input.data(), input.data(), input.data(), input.data()}, input.size(), out.data()));
+        EXPECT_EQ(hex(Data(out.end() - Keccak::digest256Size, out.end())), "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+    }
+}
+
+TEST(HashTests, Sha256Batch) {
+    // mixed sizes around the block size, so that runs of eight and single inputs both occur
+    std::vector<Data> inputs;
+    for (size_t i = 0; i < 27; ++i) {
+        const auto size = i < 16 ? 33 : (i < 21 ? 55 + i % 3 : i * 7);
+        inputs.emplace_back(size, static_cast<uint8_t>(i));
+    }
+    const auto concatenated = Hash::hashBatch(Hash::HasherSha256, inputs);
+    ASSERT_EQ(concatenated.size(), inputs.size() * Sha256::digestSize);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto digest = Data(concatenated.begin() + i * Sha256::digestSize, concatenated.begin() + (i + 1) * Sha256::digestSize);
+        EXPECT_EQ(hex(digest), hex(Hash::sha256(inputs[i]))) << "input " << i;
+    }
+    const auto doubleDigests = Hash::sha256dBatch(inputs);
+    const auto keyHashes = Hash::sha256ripemdBatch(inputs);
+    ASSERT_EQ(doubleDigests.size(), inputs.size());
+    ASSERT_EQ(keyHashes.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(hex(doubleDigests[i]), hex(Hash::sha256d(inputs[i].data(), inputs[i].size()))) << "input " << i;
+        EXPECT_EQ(hex(keyHashes[i]), hex(Hash::sha256ripemd(inputs[i].data(), inputs[i].size()))) << "input " << i;
+    }
+    EXPECT_TRUE(Hash::sha256dBatch({}).empty());
+
+    const auto input = TW::data(brownFox);
+    const auto expected = "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592";
+    if (Sha256::shaniSupported()) {
+        Data out(Sha256::digestSize);
+        ASSERT_TRUE(Sha256::hash(input.data(), input.size(), out.data()));
+        EXPECT_EQ(hex(out), expected);
+    }
+    if (Sha256::avx2Supported()) {
+        Data out(Sha256::lanes * Sha256::digestSize);
+        std::array<const TW::byte*, Sha256::lanes> messages;
+        messages.fill(input.data());
+        ASSERT_TRUE(Sha256::hash8(messages, input.size(), out.data()));
+        EXPECT_EQ(hex(Data(out.end() - Sha256::digestSize, out.end())), expected);
+    }
+}
+
+TEST(HashTests, StreamHasherMatchesSingleShot) {
+    const auto input = TW::data(brownFox);
+    const auto hashers = {
+        Hash::HasherSha1, Hash::HasherSha256, Hash::HasherSha512, Hash::HasherSha512_256,
+        Hash::HasherKeccak256, Hash::HasherKeccak512, Hash::HasherSha3_256, Hash::HasherSha3_512,
+        Hash::HasherRipemd, Hash::HasherBlake2b, Hash::HasherBlake256, Hash::HasherGroestl512,
+        Hash::HasherSha256d, Hash::HasherSha256ripemd, Hash::HasherSha3_256ripemd,
+        Hash::HasherBlake256d, Hash::HasherBlake256ripemd, Hash::HasherGroestl512d,
+    };
+
+    for (auto hasher : hashers) {
+        auto stream = Hash::StreamHasher(hasher);
+        // Feed the input in uneven chunks.
+        size_t offset = 0;
+        for (size_t chunk = 1; offset < input.size(); ++chunk) {
+            const auto size = std::min(chunk, input.size() - offset);
+            stream.update(input.data() + offset, size);
+            offset += size;
+        }
+        EXPECT_EQ(hex(stream.finalize()), hex(Hash::hash(hasher, input))) << "hasher " << hasher;
+    }
+}
+
+TEST(HashTests, StreamHasherBlake2bPersonal) {
+    const auto personal = TW::data("MyApp Files Hash");
+    auto stream = Hash::StreamHasher::blake2b(32, personal);
+    stream.update(string("the same ")).update(string("content"));
+    EXPECT_EQ(hex(stream.finalize()), "20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4");
+
+    EXPECT_THROW(Hash::StreamHasher::blake2b(65), std::invalid_argument);
+    EXPECT_THROW(Hash::StreamHasher::blake2b(32, Data(17)), std::invalid_argument);
+}
+
+TEST(HashTests, StreamHasherCopyMidstate) {
+    auto prefix = Hash::StreamHasher(Hash::HasherSha256);
+    prefix.update(string("The quick brown fox "));
+
+    auto copy = prefix;
+    copy.update(string("jumps over the lazy dog"));
+    EXPECT_EQ(hex(copy.finalize()), "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
+
+    prefix.update(string("jumps over the lazy dog."));
+    EXPECT_EQ(hex(prefix.finalize()), hex(Hash::sha256(brownFoxDot)));
+
+    EXPECT_THROW(prefix.update(string("more")), std::logic_error);
+    EXPECT_THROW(prefix.finalize(), std::logic_error);
+}
+
+TEST(HashTests, Groestl512Hardware) {
+    if (!Groestl::hardwareSupported()) {
+        GTEST_SKIP() << "AES-NI not supported";
+    }
+    // lengths around the block size and the padding limit, against the streaming (portable) implementation
+    Data input(300);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    for (size_t size = 0; size <= input.size(); ++size) {
+        Hash::Digest64 digest;
+        ASSERT_TRUE(Groestl::hash512(input.data(), size, digest.data()));
+        auto stream = Hash::StreamHasher(Hash::HasherGroestl512);
+        stream.update(input.data(), size);
+        EXPECT_EQ(hex(digest), hex(stream.finalize())) << "size " << size;
+    }
+}
+
 // More tests in TWHashTests
@@ -9,6 +9,9 @@
 #include "uint256.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+
 namespace TW {
 
 TEST(HexCoding, validation) {
@@ -28,6 +31,69 @@ TEST(HexCoding, OddLength) {
     ASSERT_EQ(number, 11000000000);
 }
 
+TEST(HexCoding, LongInputs) {
+    // Lengths around the 16-byte block size, so both the vector and the scalar paths are covered.
+    for (std::size_t size = 0; size <= 70; ++size) {
+        Data bytes(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            bytes[i] = static_cast<byte>(i * 37 + 11);
+        }
+        std::string expected;
+        for (auto b : bytes) {
+            expected.push_back("0123456789abcdef"[b >> 4]);
+            expected.push_back("0123456789abcdef"[b & 0x0f]);
+        }
+        const auto encoded = hex(bytes);
+        ASSERT_EQ(encoded, expected);
+        EXPECT_EQ(parse_hex(encoded), bytes);
+        EXPECT_EQ(parse_hex("0x" + encoded), bytes);
+
+        std::string upper = encoded;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        EXPECT_EQ(parse_hex(upper), bytes);
+
+        for (std::size_t i = 0; i < encoded.size(); i += 7) {
+            for (const char invalid : {'g', 'G', '/', ':', '@', '`', ' ', '\x80'}) {
+                auto corrupted = encoded;
+                corrupted[i] = invalid;
+                EXPECT_TRUE(parse_hex(corrupted).empty()) << corrupted;
+            }
+        }
+    }
+}
+
+TEST(HexCoding, IntoBuffers) {
+    const auto bytes = parse_hex("000102030405060708090a0b0c0d0e0f10111213ff");
+    std::string out = "0x";
+    appendHex(bytes.data(), bytes.size(), out);
+    EXPECT_EQ(out, "0x000102030405060708090a0b0c0d0e0f10111213ff");
+
+    Data parsed = {0xaa};
+    EXPECT_TRUE(appendParsedHex("0x0102", parsed));
+    EXPECT_EQ(hex(parsed), "aa0102");
+    EXPECT_FALSE(appendParsedHex("0x010", parsed));
+    EXPECT_FALSE(appendParsedHex("zz", parsed));
+    EXPECT_EQ(hex(parsed), "aa0102");
+
+    char chars[4];
+    encodeHex(parsed.data() + 1, 2, chars);
+    EXPECT_EQ(std::string(chars, 4), "0102");
+    byte decoded[2];
+    EXPECT_TRUE(decodeHex("BEEF", 2, decoded));
+    EXPECT_EQ(decoded[0], 0xbe);
+    EXPECT_EQ(decoded[1], 0xef);
+}
+
+TEST(HexCoding, Prefixes) {
+    EXPECT_EQ(hex(Data{0x12, 0x34}, true), "0x1234");
+    EXPECT_EQ(hexEncoded(Data{}), "0x");
+    EXPECT_EQ(hex(std::string("ab")), "6162");
+    EXPECT_EQ(hex(std::array<byte, 2>{0xde, 0xad}), "dead");
+    EXPECT_EQ(parse_hex("0x0x12"), Data{0x12});
+    EXPECT_TRUE(parse_hex("0x").empty());
+    EXPECT_TRUE(parse_hex("123").empty());
+}
+
 TEST(HexCoding, isHexEncoded) {
     ASSERT_TRUE(is_hex_encoded("66fbe3c5c03bf5c82792f904c9f8bf28894a6aa3d213d41c20569b654aadedb3"));
     ASSERT_TRUE(is_hex_encoded("0x66fbe3c5c03bf5c82792f904c9f8bf28894a6aa3d213d41c20569b654aadedb3"));
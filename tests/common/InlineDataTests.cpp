@@ -0,0 +1,79 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "InlineData.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::InlineDataTests {
+
+TEST(InlineDataTests, FromData) {
+    const InlineData<8> data = parse_hex("010203");
+    EXPECT_EQ(data.size(), 3ul);
+    EXPECT_EQ(data.capacity(), 8ul);
+    EXPECT_EQ(data[1], 2);
+    EXPECT_EQ(hex(data), "010203");
+    EXPECT_EQ(data, parse_hex("010203"));
+    EXPECT_NE(data, parse_hex("0102"));
+
+    const auto copy = Data(data);
+    EXPECT_EQ(hex(copy), "010203");
+}
+
+TEST(InlineDataTests, ExceedsCapacity) {
+    EXPECT_THROW(InlineData<2>(parse_hex("010203")), std::invalid_argument);
+
+    InlineData<4> data;
+    EXPECT_TRUE(data.empty());
+    EXPECT_THROW(data = parse_hex("0102030405"), std::invalid_argument);
+    EXPECT_TRUE(data.empty());
+}
+
+TEST(InlineDataTests, AssignShorterClearsTail) {
+    InlineData<4> data = parse_hex("01020304");
+    data = parse_hex("05");
+    EXPECT_EQ(hex(data), "05");
+    EXPECT_EQ(data.data()[1], 0);
+    EXPECT_EQ(data.data()[3], 0);
+}
+
+TEST(InlineDataTests, View) {
+    const InlineData<8> data = parse_hex("0102030405");
+    EXPECT_EQ(hex(data.view(1, 2)), "0203");
+    EXPECT_EQ(hex(data.view(3, 10)), "0405");
+    EXPECT_TRUE(data.view(5, 1).empty());
+    EXPECT_EQ(hex(data.view()), "0102030405");
+}
+
+TEST(InlineDataTests, AppendAndSubData) {
+    const InlineData<8> data = parse_hex("0102030405");
+    Data out = parse_hex("aa");
+    append(out, data);
+    EXPECT_EQ(hex(out), "aa0102030405");
+    EXPECT_EQ(hex(subData(data, 1, 2)), "0203");
+    EXPECT_EQ(hex(subData(data, 3)), "0405");
+    EXPECT_EQ(hex(subData(data, 5)), "");
+}
+
+TEST(InlineDataTests, Wipe) {
+    InlineData<4> data = parse_hex("01020304");
+    data.wipe();
+    EXPECT_EQ(data.size(), 4ul);
+    EXPECT_EQ(hex(data), "00000000");
+}
+
+TEST(InlineDataTests, PrivateKeyCleanup) {
+    auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    EXPECT_EQ(hex(privateKey.key()), "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+    EXPECT_TRUE(privateKey.chainCode().empty());
+
+    privateKey.cleanup();
+    EXPECT_EQ(hex(privateKey.bytes), "0000000000000000000000000000000000000000000000000000000000000000");
+}
+
+} // namespace TW::InlineDataTests
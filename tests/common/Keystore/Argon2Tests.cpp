@@ -0,0 +1,79 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/Argon2.h"
+#include "Keystore/Argon2Parameters.h"
+#include "Keystore/StoredKey.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Keystore::tests {
+
+TEST(Argon2, RFC9106) {
+    // https://www.rfc-editor.org/rfc/rfc9106#section-5.3
+    const auto password = Data(32, 0x01);
+    const auto salt = Data(16, 0x02);
+    const auto secret = Data(8, 0x03);
+    const auto associatedData = Data(12, 0x04);
+    for (const auto threads : {1ul, 4ul}) {
+        Data derived(32);
+        argon2id(password, salt, 3, 32, 4, derived.data(), derived.size(), threads, secret, associatedData);
+        EXPECT_EQ(hex(derived), "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+    }
+}
+
+TEST(Argon2, ReferenceImplementation) {
+    // argon2 somesalt -id -t 2 -m 16 -p 1 <<< -n password
+    EXPECT_EQ(hex(argon2id(TW::data("password"), TW::data("somesalt"), 2, 1 << 16, 1, 32)),
+              "09316115d5cf24ed5a15a31a3ba326e5cf32edc24702987c02b6566f61913cf7");
+}
+
+TEST(Argon2, LanesMatchSingleThread) {
+    const auto expected = hex(argon2id(TW::data("password"), TW::data("somesalt"), 2, 1024, 4, 32, 1));
+    EXPECT_EQ(hex(argon2id(TW::data("password"), TW::data("somesalt"), 2, 1024, 4, 32, 2)), expected);
+    EXPECT_EQ(hex(argon2id(TW::data("password"), TW::data("somesalt"), 2, 1024, 4, 32)), expected);
+}
+
+TEST(Argon2, InvalidParameters) {
+    EXPECT_THROW(argon2id(TW::data("password"), TW::data("somesalt"), 0, 1024, 1, 32), std::invalid_argument);
+    EXPECT_THROW(argon2id(TW::data("password"), TW::data("somesalt"), 1, 1024, 0, 32), std::invalid_argument);
+    EXPECT_THROW(argon2id(TW::data("password"), TW::data("somesalt"), 1, 31, 4, 32), std::invalid_argument);
+    EXPECT_THROW(argon2id(TW::data("password"), TW::data("somesalt"), 1, 1024, 1, 3), std::invalid_argument);
+}
+
+TEST(Argon2Parameters, Validate) {
+    EXPECT_FALSE(Argon2Parameters().validate().has_value());
+    EXPECT_FALSE(Argon2Parameters::Standard.validate().has_value());
+    EXPECT_THROW(Argon2Parameters(Data(32), 64, 1, 0, 32), Argon2ValidationError);
+    EXPECT_THROW(Argon2Parameters(Data(32), 64, 0, 1, 32), Argon2ValidationError);
+    EXPECT_THROW(Argon2Parameters(Data(32), 31, 1, 4, 32), Argon2ValidationError);
+    EXPECT_THROW(Argon2Parameters(Data(4), 64, 1, 1, 32), Argon2ValidationError);
+}
+
+TEST(Argon2Parameters, StoredKeyJson) {
+    const auto password = TW::data("password");
+    const auto mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+    auto key = StoredKey::createWithMnemonic("name", password, mnemonic, TWStoredKeyEncryptionLevelMinimal);
+    key.updateEncryptionParameters(password, EncryptionParameters(AESParameters(), Argon2Parameters(Data(32), 256, 2, 4, 32)));
+
+    const auto json = key.json();
+    EXPECT_EQ(json["crypto"]["kdf"], "argon2id");
+    EXPECT_EQ(json["crypto"]["kdfparams"]["m"], 256);
+    EXPECT_EQ(json["crypto"]["kdfparams"]["t"], 2);
+    EXPECT_EQ(json["crypto"]["kdfparams"]["p"], 4);
+
+    std::string written;
+    key.writeJson(written);
+    EXPECT_EQ(written, json.dump());
+    const auto fromText = StoredKey::createWithJsonText(written);
+    EXPECT_EQ(fromText.json(), json);
+    EXPECT_EQ(hex(fromText.payload.decrypt(password)), hex(TW::data(mnemonic)));
+    EXPECT_EQ(hex(StoredKey::createWithJson(json).payload.decrypt(password)), hex(TW::data(mnemonic)));
+    EXPECT_THROW(fromText.payload.decrypt(TW::data("wrong")), DecryptionError);
+}
+
+} // namespace TW::Keystore::tests
@@ -0,0 +1,155 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/Bulk.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <sstream>
+
+extern std::string TESTS_ROOT;
+
+namespace TW::Keystore::tests {
+
+const auto gBulkPassword = TW::data(std::string("password"));
+
+std::vector<StoredKey> bulkKeys() {
+    std::vector<StoredKey> keys;
+    for (auto i = 0; i < 4; ++i) {
+        keys.push_back(StoredKey::createWithMnemonic("key" + std::to_string(i), gBulkPassword,
+                                                     "team engine square letter hero song dizzy scrub tornado fabric divert saddle",
+                                                     TWStoredKeyEncryptionLevelMinimal));
+    }
+    return keys;
+}
+
+TEST(KeystoreBulk, StreamRoundTrip) {
+    const auto keys = bulkKeys();
+    std::stringstream stream;
+    Bulk::exportStream(keys, stream, 2);
+    stream << "\n{\"name\":\"no crypto\"}\n";
+
+    const auto results = Bulk::importStream(stream, 2, gBulkPassword);
+    ASSERT_EQ(results.size(), keys.size() + 1);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(results[i].source, std::to_string(i + 1));
+        EXPECT_EQ(results[i].error, "");
+        ASSERT_TRUE(results[i].key.has_value());
+        EXPECT_EQ(results[i].key->json(), keys[i].json());
+    }
+    EXPECT_EQ(results.back().source, "6");
+    EXPECT_FALSE(results.back().key.has_value());
+    EXPECT_EQ(results.back().error, "invalid key file");
+}
+
+TEST(KeystoreBulk, ImportTextsWrongPassword) {
+    std::string text;
+    bulkKeys()[0].writeJson(text);
+
+    const auto results = Bulk::importTexts({text, "{"}, 0, TW::data(std::string("wrong")));
+    ASSERT_EQ(results.size(), 2ul);
+    EXPECT_FALSE(results[0].key.has_value());
+    EXPECT_EQ(results[0].error, "invalid password");
+    EXPECT_FALSE(results[1].key.has_value());
+    EXPECT_NE(results[1].error, "");
+
+    const auto unchecked = Bulk::importTexts({text});
+    ASSERT_TRUE(unchecked[0].key.has_value());
+    EXPECT_EQ(unchecked[0].key->name, "key0");
+}
+
+TEST(KeystoreBulk, DecryptTexts) {
+    std::vector<std::string> texts(2);
+    bulkKeys()[0].writeJson(texts[0]);
+    texts[1] = "{";
+
+    const auto results = Bulk::decryptTexts(texts, gBulkPassword, 2);
+    ASSERT_EQ(results.size(), 2ul);
+    EXPECT_EQ(results[0].error, "");
+    EXPECT_EQ(std::string(results[0].secret.begin(), results[0].secret.end()),
+              "team engine square letter hero song dizzy scrub tornado fabric divert saddle");
+    EXPECT_TRUE(results[1].secret.empty());
+    EXPECT_NE(results[1].error, "");
+
+    const auto wrong = Bulk::decryptTexts({texts[0]}, TW::data(std::string("wrong")));
+    EXPECT_TRUE(wrong[0].secret.empty());
+    EXPECT_EQ(wrong[0].error, "invalid password");
+}
+
+TEST(KeystoreBulk, CreateWithMnemonics) {
+    const auto results = Bulk::createWithMnemonics({"team engine square letter hero song dizzy scrub tornado fabric divert saddle", "invalid mnemonic"},
+                                                    {"first", "second"}, gBulkPassword, TWCoinTypeBitcoin, TWStoredKeyEncryptionAes128Ctr);
+    ASSERT_EQ(results.size(), 2ul);
+    ASSERT_TRUE(results[0].key.has_value()) << results[0].error;
+    EXPECT_EQ(results[0].key->name, "first");
+    ASSERT_EQ(results[0].key->accounts.size(), 1ul);
+    EXPECT_EQ(results[0].key->accounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    const auto mnemonic = results[0].key->payload.decrypt(gBulkPassword);
+    EXPECT_EQ(std::string(mnemonic.begin(), mnemonic.end()), "team engine square letter hero song dizzy scrub tornado fabric divert saddle");
+    EXPECT_FALSE(results[1].key.has_value());
+    EXPECT_NE(results[1].error, "");
+
+    EXPECT_THROW(Bulk::createWithMnemonics({"invalid mnemonic"}, {}, gBulkPassword, TWCoinTypeBitcoin, TWStoredKeyEncryptionAes128Ctr), std::invalid_argument);
+}
+
+TEST(KeystoreBulk, DirectoryRoundTrip) {
+    const auto directory = std::filesystem::temp_directory_path() / "keystore-bulk-test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    const auto keys = bulkKeys();
+    const auto paths = Bulk::exportDirectory(keys, directory.string(), 2);
+    ASSERT_EQ(paths.size(), keys.size());
+    EXPECT_EQ(paths[0], (directory / (*keys[0].id + ".json")).string());
+
+    const auto results = Bulk::importDirectory(directory.string(), 2, gBulkPassword);
+    ASSERT_EQ(results.size(), keys.size());
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.key.has_value()) << result.error;
+        const auto path = std::find(paths.begin(), paths.end(), result.source);
+        ASSERT_NE(path, paths.end());
+        EXPECT_EQ(result.key->json(), keys[path - paths.begin()].json());
+    }
+
+    std::filesystem::remove_all(directory);
+    EXPECT_THROW(Bulk::importDirectory(directory.string()), std::invalid_argument);
+}
+
+TEST(KeystoreBulk, ImportTestData) {
+    const auto results = Bulk::importDirectory(TESTS_ROOT + "/common/Keystore/Data", 0);
+    EXPECT_GT(results.size(), 10ul);
+    for (const auto& result : results) {
+        if (result.source.ends_with("watch.json")) {
+            // no encrypted payload
+            EXPECT_EQ(result.error, "invalid key file");
+        } else {
+            EXPECT_TRUE(result.key.has_value()) << result.source << ": " << result.error;
+        }
+    }
+}
+
+TEST(KeystoreBulk, UpdateEncryptionParameters) {
+    auto keys = bulkKeys();
+    keys.push_back(StoredKey::createWithMnemonic("other", TW::data(std::string("other")),
+                                                 "team engine square letter hero song dizzy scrub tornado fabric divert saddle",
+                                                 TWStoredKeyEncryptionLevelMinimal));
+    const auto params = EncryptionParameters::getPreset(TWStoredKeyEncryptionLevelMinimal, TWStoredKeyEncryptionAes256Ctr);
+
+    const auto errors = Bulk::updateEncryptionParameters(keys, gBulkPassword, params, 2);
+    ASSERT_EQ(errors.size(), keys.size());
+    for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+        EXPECT_EQ(errors[i], "");
+        EXPECT_EQ(keys[i].payload.params.cipher(), "aes-256-ctr");
+        EXPECT_NO_THROW(keys[i].payload.decrypt(gBulkPassword));
+    }
+    EXPECT_NE(std::get<ScryptParameters>(keys[0].payload.params.kdfParams).salt,
+              std::get<ScryptParameters>(keys[1].payload.params.kdfParams).salt);
+    EXPECT_EQ(errors.back(), "invalid password");
+    EXPECT_EQ(keys.back().payload.params.cipher(), "aes-128-ctr");
+}
+
+} // namespace TW::Keystore::tests
@@ -10,6 +10,8 @@
 
 #include <gtest/gtest.h>
 
+extern const TW::CoinInfo& getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+
 namespace TW {
 
 TEST(DerivationPath, InitWithIndices) {
@@ -43,6 +45,35 @@ TEST(DerivationPath, InitInvalid) {
     ASSERT_THROW(DerivationPath("m/44'/60''/"), std::invalid_argument);
 }
 
+TEST(DerivationPath, InitInvalidNumber) {
+    ASSERT_THROW(DerivationPath("m/44'/-60'"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/ 60'"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/4294967296"), std::invalid_argument);
+    ASSERT_EQ(DerivationPath("m/44'/4294967295").indices[1].value, 4294967295u);
+}
+
+TEST(DerivationPath, MaxDepth) {
+    const auto path = DerivationPath("m/0/1/2/3/4/5/6/7'");
+    ASSERT_EQ(path.indices.size(), 8ul);
+    EXPECT_EQ(path.indices.back(), DerivationPathIndex(7, /* hardened: */ true));
+    EXPECT_EQ(path.string(), "m/0/1/2/3/4/5/6/7'");
+
+    EXPECT_THROW(DerivationPath("m/0/1/2/3/4/5/6/7/8"), std::invalid_argument);
+    auto copy = path;
+    EXPECT_THROW(copy.indices.emplace_back(8, false), std::invalid_argument);
+    copy.indices.pop_back();
+    EXPECT_NE(copy, path);
+    copy.indices.emplace_back(7, true);
+    EXPECT_EQ(copy, path);
+}
+
+TEST(DerivationPath, Constexpr) {
+    static constexpr auto path = DerivationPath({{44, true}, {60, true}, {0, true}, {0, false}, {0, false}});
+    static_assert(path.indices.size() == 5);
+    static_assert(path.indices[1].derivationIndex() == 0x8000003c);
+    EXPECT_EQ(path, DerivationPath("m/44'/60'/0'/0/0"));
+}
+
 TEST(DerivationPath, IndexOutOfBounds) {
     DerivationPath path;
 
@@ -77,6 +108,16 @@ TEST(Derivation, derivationPath) {
     EXPECT_EQ(TW::derivationPath(TWCoinTypeSolana).string(), "m/44'/501'/0'");
 }
 
+TEST(Derivation, parsedPath) {
+    for (const auto coin : TW::getCoinTypes()) {
+        for (const auto& derivation : ::getCoinInfo(coin).derivation) {
+            EXPECT_EQ(derivation.parsedPath, DerivationPath(derivation.path)) << derivation.path;
+        }
+    }
+    const auto& legacy = ::getCoinInfo(TWCoinTypeBitcoin).derivationByName(TWDerivationBitcoinLegacy);
+    EXPECT_EQ(&legacy, &::getCoinInfo(TWCoinTypeBitcoin).derivationByName(TWDerivationBitcoinLegacy));
+}
+
 TEST(Derivation, alternativeDerivation) {
     EXPECT_EQ(TW::derivationPath(TWCoinTypeBitcoin).string(), "m/84'/0'/0'/0/0");
     EXPECT_EQ(TW::derivationPath(TWCoinTypeBitcoin, TWDerivationDefault).string(), "m/84'/0'/0'/0/0");
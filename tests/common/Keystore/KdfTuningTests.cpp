@@ -0,0 +1,83 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/KdfTuning.h"
+#include "Keystore/StoredKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Keystore::tests {
+
+using namespace std::chrono_literals;
+
+TEST(KdfTuning, TargetTime) {
+    EXPECT_EQ(KdfTuning::targetTime(TWStoredKeyEncryptionLevelMinimal), 100ms);
+    EXPECT_EQ(KdfTuning::targetTime(TWStoredKeyEncryptionLevelDefault), 250ms);
+    EXPECT_EQ(KdfTuning::targetTime(TWStoredKeyEncryptionLevelWeak), 250ms);
+    EXPECT_EQ(KdfTuning::targetTime(TWStoredKeyEncryptionLevelStandard), 1000ms);
+}
+
+TEST(KdfTuning, Scrypt) {
+    const auto params = KdfTuning::tuneScrypt(50ms);
+    EXPECT_FALSE(params.validate().has_value());
+    EXPECT_EQ(params.salt.size(), 32ul);
+    EXPECT_EQ(params.r, 8u);
+    EXPECT_GE(params.n, 4096u);
+    EXPECT_EQ(params.n & (params.n - 1), 0u);
+    EXPECT_NE(params.salt, KdfTuning::tuneScrypt(50ms).salt);
+}
+
+TEST(KdfTuning, ScryptMinimal) {
+    // too short a target still gets the minimal cost
+    const auto params = KdfTuning::tuneScrypt(0ms);
+    EXPECT_EQ(params.n, 4096u);
+    EXPECT_EQ(params.p, 1u);
+}
+
+TEST(KdfTuning, ScryptMemoryLimit) {
+    // 512KB allows n = 512, below the minimum, then the remaining time goes into p
+    const auto params = KdfTuning::tuneScrypt(200ms, 512 * 1024);
+    EXPECT_EQ(params.n, 4096u);
+    EXPECT_GT(params.p, 1u);
+    EXPECT_LE(params.p, 256u);
+}
+
+TEST(KdfTuning, PBKDF2) {
+    EXPECT_EQ(KdfTuning::tunePBKDF2(0ms).iterations, 4096u);
+
+    const auto params = KdfTuning::tunePBKDF2(50ms);
+    EXPECT_EQ(params.salt.size(), 32ul);
+    EXPECT_GE(params.iterations, 4096u);
+    EXPECT_LT(KdfTuning::benchmark(params), 500ms);
+}
+
+TEST(KdfTuning, UpdateEncryptionParameters) {
+    const auto password = TW::data(std::string("password"));
+    const auto mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+    auto key = StoredKey::createWithMnemonic("name", password, mnemonic, TWStoredKeyEncryptionLevelMinimal);
+
+    const auto tuned = KdfTuning::tune(20ms, TWStoredKeyEncryptionAes256Ctr);
+    key.updateEncryptionParameters(password, tuned);
+    const auto& scrypt = std::get<ScryptParameters>(key.payload.params.kdfParams);
+    EXPECT_EQ(scrypt.n, std::get<ScryptParameters>(tuned.kdfParams).n);
+    EXPECT_NE(scrypt.salt, std::get<ScryptParameters>(tuned.kdfParams).salt);
+    EXPECT_NE(key.payload.params.cipherParams.iv, tuned.cipherParams.iv);
+    EXPECT_EQ(key.payload.params.cipher(), "aes-256-ctr");
+    EXPECT_EQ(TW::data(mnemonic), key.payload.decrypt(password));
+
+    const auto pbkdf2 = EncryptionParameters(AESParameters::AESParametersFromEncryption(TWStoredKeyEncryptionAes128Ctr), KdfTuning::tunePBKDF2(20ms));
+    key.updateEncryptionParameters(password, pbkdf2);
+    EXPECT_TRUE(std::holds_alternative<PBKDF2Parameters>(key.payload.params.kdfParams));
+    EXPECT_EQ(TW::data(mnemonic), key.payload.decrypt(password));
+    const auto reloaded = StoredKey::createWithJson(key.json());
+    EXPECT_EQ(TW::data(mnemonic), reloaded.payload.decrypt(password));
+
+    const auto before = key.payload.encrypted;
+    EXPECT_THROW(key.updateEncryptionParameters(TW::data(std::string("wrong")), tuned), DecryptionError);
+    EXPECT_EQ(key.payload.encrypted, before);
+}
+
+} // namespace TW::Keystore::tests
@@ -0,0 +1,69 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/Scrypt.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/scrypt.h>
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace TW::Keystore::tests {
+
+TEST(Scrypt, RFC7914) {
+    // https://www.rfc-editor.org/rfc/rfc7914#section-12
+    EXPECT_EQ(hex(scrypt(TW::data("password"), TW::data("NaCl"), 1024, 8, 16, 64)),
+              "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+    EXPECT_EQ(hex(scrypt(Data(), Data(), 16, 1, 1, 64)),
+              "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+}
+
+TEST(Scrypt, MatchesTrezor) {
+    const auto password = TW::data("password");
+    const auto salt = parse_hex("ab0c7876052600dd703518d6fc3fe8984592145b591fc8fb5c6d43190334ba19");
+    for (const auto p : {1u, 3u, 6u}) {
+        Data expected(32);
+        ::scrypt(password.data(), password.size(), salt.data(), salt.size(), 4096, 8, p, expected.data(), expected.size());
+        for (const auto threads : {0ul, 1ul, 4ul}) {
+            EXPECT_EQ(hex(scrypt(password, salt, 4096, 8, p, 32, threads)), hex(expected));
+        }
+    }
+}
+
+TEST(Scrypt, MemoryBudget) {
+    // each lane needs about 512KB
+    ScryptMemoryBudget::setLimit(1024 * 1024);
+    EXPECT_EQ(ScryptMemoryBudget::lanesWithinLimit(6, 512 * 1024), 2ul);
+    EXPECT_EQ(ScryptMemoryBudget::lanesWithinLimit(6, 4 * 1024 * 1024), 1ul);
+
+    const auto expected = hex(scrypt(TW::data("password"), TW::data("salt"), 4096, 1, 6, 32));
+    std::vector<std::thread> threads;
+    std::vector<std::string> results(4);
+    for (auto i = 0ul; i < results.size(); ++i) {
+        threads.emplace_back([&results, i] {
+            results[i] = hex(scrypt(TW::data("password"), TW::data("salt"), 4096, 1, 6, 32));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        EXPECT_EQ(result, expected);
+    }
+    EXPECT_EQ(ScryptMemoryBudget::used(), 0ul);
+
+    ScryptMemoryBudget::setLimit(0);
+    EXPECT_EQ(ScryptMemoryBudget::lanesWithinLimit(6, 512 * 1024), 6ul);
+}
+
+TEST(Scrypt, InvalidParameters) {
+    EXPECT_THROW(scrypt(TW::data("password"), TW::data("salt"), 1000, 8, 1, 32), std::invalid_argument);
+    EXPECT_THROW(scrypt(TW::data("password"), TW::data("salt"), 1024, 0, 1, 32), std::invalid_argument);
+    EXPECT_THROW(scrypt(TW::data("password"), TW::data("salt"), 1024, 8, 0, 32), std::invalid_argument);
+}
+
+} // namespace TW::Keystore::tests
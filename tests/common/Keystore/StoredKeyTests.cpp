@@ -13,6 +13,8 @@
 #include "Mnemonic.h"
 #include "Bitcoin/Address.h"
 
+#include <filesystem>
+#include <fstream>
 #include <stdexcept>
 #include <gtest/gtest.h>
 
@@ -38,7 +40,7 @@ const std::string testDataPath(const char* subpath) {
 TEST(StoredKey, CreateWithMnemonic) {
     auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
@@ -63,7 +65,7 @@ TEST(StoredKey, CreateWithMnemonicRandom) {
     const auto key = StoredKey::createWithMnemonicRandom("name", gPassword, TWStoredKeyEncryptionLevelDefault);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     // random mnemonic: check only length and validity
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_TRUE(mnemo2Data.size() >= 36);
     EXPECT_TRUE(Mnemonic::isValid(string(mnemo2Data.begin(), mnemo2Data.end())));
     EXPECT_EQ(key.accounts.size(), 0ul);
@@ -73,7 +75,7 @@ TEST(StoredKey, CreateWithMnemonicAddDefaultAddress) {
     auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", gPassword, gMnemonic, coinTypeBc);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
 
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
 
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 1ul);
@@ -89,7 +91,7 @@ TEST(StoredKey, CreateWithMnemonicAddDefaultAddressAes256) {
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
     auto header = key.payload;
     EXPECT_EQ(header.params.cipher(), "aes-256-ctr");
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
 
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 1ul);
@@ -296,6 +298,68 @@ TEST(StoredKey, FixAddress) {
     }
 }
 
+TEST(StoredKey, DecryptedKeyShared) {
+    auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
+    auto decrypted = key.decrypt(gPassword);
+    EXPECT_EQ(decrypted.type(), StoredKeyType::mnemonicPhrase);
+    EXPECT_EQ(decrypted.wallet().getMnemonic(), gMnemonic);
+    EXPECT_THROW(decrypted.privateKey(), std::invalid_argument);
+
+    const auto btcAccount = key.account(coinTypeBc, &decrypted.wallet());
+    const auto ethAccount = key.account(coinTypeEth, &decrypted.wallet());
+    ASSERT_TRUE(btcAccount.has_value());
+    ASSERT_TRUE(ethAccount.has_value());
+    EXPECT_EQ(btcAccount->address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(hex(key.privateKey(coinTypeEth, TWDerivationDefault, decrypted).bytes), hex(key.privateKey(coinTypeEth, gPassword).bytes));
+    key.fixAddresses(decrypted);
+    EXPECT_EQ(key.accounts.size(), 2ul);
+
+    decrypted.wipe();
+    EXPECT_TRUE(decrypted.isWiped());
+    EXPECT_THROW(decrypted.wallet(), std::invalid_argument);
+
+    const auto privateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+    auto privateKeyKey = StoredKey::createWithPrivateKeyAddDefaultAddress("name", gPassword, coinTypeBc, privateKey);
+    const auto decryptedPrivateKey = privateKeyKey.decrypt(gPassword);
+    EXPECT_EQ(hex(decryptedPrivateKey.privateKey().bytes), hex(privateKey));
+    EXPECT_THROW(decryptedPrivateKey.wallet(), std::invalid_argument);
+    EXPECT_THROW(key.decrypt(TW::data("wrong")), DecryptionError);
+}
+
+TEST(StoredKey, AccountIndex) {
+    auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
+    const auto derivationPath = DerivationPath("m/44'/60'/0'/0/0");
+    for (auto i = 0; i < 300; ++i) {
+        key.addAccount("address" + std::to_string(i), i % 2 == 0 ? coinTypeEth : coinTypeBsc,
+                       i < 2 ? TWDerivationDefault : TWDerivationCustom, derivationPath, "", "");
+    }
+    // duplicate address for the coin is not added
+    key.addAccount("address2", coinTypeEth, TWDerivationDefault, derivationPath, "", "");
+    EXPECT_EQ(key.accounts.size(), 300ul);
+
+    EXPECT_EQ(key.getAccounts(coinTypeEth).size(), 150ul);
+    EXPECT_EQ(key.getAccounts(coinTypeEth)[1].address, "address2");
+    EXPECT_EQ(key.getAccounts(coinTypeBnb).size(), 0ul);
+    EXPECT_EQ(key.account(coinTypeBsc)->address, "address1");
+
+    key.removeAccount(coinTypeEth, TWDerivationDefault);
+    EXPECT_EQ(key.accounts.size(), 299ul);
+    EXPECT_EQ(key.account(coinTypeEth)->address, "address2");
+
+    // direct modification of an element, followed by reindexing
+    key.accounts[0].address = "renamed";
+    key.reindexAccounts();
+    EXPECT_EQ(key.account(coinTypeBsc)->address, "renamed");
+    key.addAccount("address1", coinTypeBsc, TWDerivationDefault, derivationPath, "", "");
+    EXPECT_EQ(key.accounts.size(), 300ul);
+
+    // a copy has its own index
+    auto copy = key;
+    copy.removeAccount(coinTypeBsc);
+    EXPECT_EQ(copy.getAccounts(coinTypeBsc).size(), 0ul);
+    EXPECT_EQ(key.getAccounts(coinTypeBsc).size(), 151ul);
+}
+
 TEST(StoredKey, WalletInvalid) {
     const auto privateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
     auto key = StoredKey::createWithPrivateKeyAddDefaultAddress("name", gPassword, coinTypeBc, privateKey);
@@ -395,6 +459,48 @@ TEST(StoredKey, ReadMyEtherWallet) {
     ASSERT_NO_THROW(StoredKey::load(testDataPath("myetherwallet.uu")));
 }
 
+TEST(StoredKey, JsonTextMatchesJsonObject) {
+    for (const auto& entry : std::filesystem::directory_iterator(testDataPath(""))) {
+        std::ifstream stream(entry.path());
+        const auto text = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        SCOPED_TRACE(entry.path().string());
+
+        std::optional<StoredKey> expected;
+        try {
+            expected = StoredKey::createWithJson(nlohmann::json::parse(text));
+        } catch (...) {
+            EXPECT_ANY_THROW(StoredKey::createWithJsonText(text));
+            continue;
+        }
+        const auto key = StoredKey::createWithJsonText(text);
+        EXPECT_EQ(key.json(), expected->json());
+
+        std::string written;
+        key.writeJson(written);
+        EXPECT_EQ(written, expected->json().dump());
+    }
+}
+
+TEST(StoredKey, JsonTextWrite) {
+    auto key = StoredKey::createWithMnemonic("name \"quoted\" \u00e9", gPassword, gMnemonic, TWStoredKeyEncryptionLevelMinimal);
+    key.addAccount("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", coinTypeBc, TWDerivationBitcoinLegacy, DerivationPath("m/84'/0'/0'/0/0"), "02df6f", "zpub6");
+    key.addAccount("0xC0d97f61A84A0708225F15d54978D628Fe2C5E62", coinTypeEth, TWDerivationDefault, DerivationPath("m/44'/60'/0'/0/0"), "", "");
+
+    std::string written;
+    key.writeJson(written);
+    EXPECT_EQ(written, key.json().dump());
+    EXPECT_EQ(StoredKey::createWithJsonText(written).json(), key.json());
+    EXPECT_EQ(hex(StoredKey::createWithJsonText(written).payload.decrypt(gPassword)), hex(TW::data(gMnemonic)));
+}
+
+TEST(StoredKey, JsonTextInvalid) {
+    EXPECT_THROW(StoredKey::createWithJsonText("{\"crypto\":"), nlohmann::json::parse_error);
+    EXPECT_THROW(StoredKey::createWithJsonText("{\"name\":\"a\"}"), DecryptionError);
+    EXPECT_THROW(StoredKey::createWithJsonText("{\"crypto\":{\"cipher\":\"aes-128-ctr\"}}"), std::invalid_argument);
+    EXPECT_THROW(StoredKey::createWithJsonText("{\"name\":1,\"crypto\":{}}"), std::invalid_argument);
+    EXPECT_THROW(StoredKey::createWithJsonText("{\"activeAccounts\":[1]}"), std::invalid_argument);
+}
+
 TEST(StoredKey, InvalidPassword) {
     const auto key = StoredKey::load(testDataPath("key.json"));
 
@@ -523,7 +629,7 @@ TEST(StoredKey, EtherWalletAddressNo0x) {
 TEST(StoredKey, CreateMinimalEncryptionParameters) {
     const auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelMinimal);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
@@ -541,7 +647,7 @@ TEST(StoredKey, CreateMinimalEncryptionParameters) {
 TEST(StoredKey, CreateWeakEncryptionParameters) {
     const auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelWeak);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
@@ -559,7 +665,7 @@ TEST(StoredKey, CreateWeakEncryptionParameters) {
 TEST(StoredKey, CreateStandardEncryptionParameters) {
     const auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelStandard);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 0ul);
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
@@ -577,7 +683,7 @@ TEST(StoredKey, CreateStandardEncryptionParameters) {
 TEST(StoredKey, CreateMultiAccounts) { // Multiple accounts for the same coin
     auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
-    const Data& mnemo2Data = key.payload.decrypt(gPassword);
+    const auto& mnemo2Data = key.payload.decrypt(gPassword);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(gMnemonic));
     EXPECT_EQ(key.wallet(gPassword).getMnemonic(), string(gMnemonic));
     EXPECT_EQ(key.accounts.size(), 0ul);
@@ -770,4 +770,67 @@ namespace TW::LiquidStaking::tests {
             // Successfully broadcasted https://etherscan.io/tx/0x4d509fd50f474a568419ade4df13b43943b5c8233e980d2217784c512941b3bd
         }
     }
+
+    TEST(LiquidStaking, BuildBatch) {
+        Proto::InputBatch batch;
+        {
+            auto& input = *batch.add_inputs();
+            input.set_blockchain(Proto::POLYGON);
+            input.set_protocol(Proto::Strader);
+            input.set_smart_contract_address("0xfd225c9e6601c9d38d8f98d8731bf59efcf8c0e3");
+            input.mutable_stake()->set_amount("1000000000000000000");
+        }
+        {
+            auto& input = *batch.add_inputs();
+            input.set_blockchain(Proto::POLYGON);
+            input.set_protocol(Proto::Strader);
+            input.set_smart_contract_address("0xfd225c9e6601c9d38d8f98d8731bf59efcf8c0e3");
+            input.mutable_unstake()->set_amount("1000000000000000000");
+        }
+        {
+            auto& input = *batch.add_inputs();
+            input.set_blockchain(Proto::POLYGON);
+            input.set_protocol(Proto::Strader);
+            input.set_smart_contract_address("0xfd225c9e6601c9d38d8f98d8731bf59efcf8c0e3");
+            input.mutable_withdraw()->set_idx("0");
+        }
+        {
+            auto& input = *batch.add_inputs();
+            input.set_blockchain(Proto::ETHEREUM);
+            input.set_protocol(Proto::Lido);
+            input.set_smart_contract_address("0xae7ab96520de3a18e5e111b5eaab095312d7fe84");
+            input.mutable_stake()->set_amount("1000000000000000");
+        }
+        batch.add_inputs();
+
+        const auto inputData = data(batch.SerializeAsString());
+        const auto inputTWData = WRAPD(TWDataCreateWithBytes(inputData.data(), inputData.size()));
+        const auto outputTWData = WRAPD(TWLiquidStakingBuildRequests(inputTWData.get()));
+        Proto::OutputBatch outputs;
+        ASSERT_TRUE(outputs.ParseFromArray(TWDataBytes(outputTWData.get()), static_cast<int>(TWDataSize(outputTWData.get()))));
+        ASSERT_EQ(outputs.status().code(), Proto::OK);
+        ASSERT_EQ(outputs.outputs_size(), 5);
+
+        const std::vector<std::string> expected = {
+            "0xc78cf1a0",
+            "0x48eaf6d60000000000000000000000000000000000000000000000000de0b6b3a7640000",
+            "0x77baf2090000000000000000000000000000000000000000000000000000000000000000",
+            "0xa1903eab0000000000000000000000000000000000000000000000000000000000000000",
+        };
+        for (auto i = 0ul; i < expected.size(); ++i) {
+            const auto& output = outputs.outputs(static_cast<int>(i));
+            ASSERT_EQ(output.status().code(), Proto::OK);
+            EXPECT_EQ(hex(output.ethereum().transaction().contract_generic().data(), true), expected[i]);
+            // same as one by one
+            EXPECT_EQ(output.SerializeAsString(), build(batch.inputs(static_cast<int>(i))).SerializeAsString());
+        }
+        EXPECT_EQ(outputs.outputs(4).status().code(), Proto::ERROR_ACTION_NOT_SET);
+
+        const auto invalid = data("Invalid");
+        const auto invalidTWData = WRAPD(TWDataCreateWithBytes(invalid.data(), invalid.size()));
+        const auto errorTWData = WRAPD(TWLiquidStakingBuildRequests(invalidTWData.get()));
+        ASSERT_TRUE(outputs.ParseFromArray(TWDataBytes(errorTWData.get()), static_cast<int>(TWDataSize(errorTWData.get()))));
+        EXPECT_EQ(outputs.status().code(), Proto::ERROR_INPUT_PROTO_DESERIALIZATION);
+        EXPECT_EQ(outputs.outputs_size(), 0);
+    }
 }
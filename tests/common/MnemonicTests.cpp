@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Mnemonic.h"
+#include "HexCoding.h"
 
 #include <gtest/gtest.h>
 
@@ -96,4 +97,35 @@ TEST(Mnemonic, suggest) {
     EXPECT_EQ(Mnemonic::suggest("program"), "program");
 }
 
+TEST(Mnemonic, wordIndex) {
+    EXPECT_EQ(Mnemonic::wordIndex("abandon"), 0);
+    EXPECT_EQ(Mnemonic::wordIndex("ability"), 1);
+    EXPECT_EQ(Mnemonic::wordIndex("zoo"), 2047);
+    EXPECT_EQ(Mnemonic::wordIndex("credit"), 408);
+
+    EXPECT_EQ(Mnemonic::wordIndex(""), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("z"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("abando"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("Abandon"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("zoology"), -1);
+}
+
+TEST(Mnemonic, toBits) {
+    Mnemonic::Bits bits;
+    EXPECT_EQ(Mnemonic::toBits("abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about", bits), 132);
+    EXPECT_EQ(hex(Data(bits.begin(), bits.begin() + 17)), "0000000000000000000000000000000030");
+    EXPECT_EQ(Mnemonic::toBits("zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo wrong", bits), 132);
+    EXPECT_EQ(hex(Data(bits.begin(), bits.begin() + 17)), "ffffffffffffffffffffffffffffffff50");
+
+    EXPECT_EQ(Mnemonic::toBits("abandon abandon abandon", bits), 0);
+    EXPECT_EQ(Mnemonic::toBits("abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon  about", bits), 0);
+}
+
+TEST(Mnemonic, suggestLimit) {
+    EXPECT_EQ(Mnemonic::suggest("A"), "abandon ability able about above absent absorb abstract absurd abuse");
+    EXPECT_EQ(Mnemonic::suggest("zo"), "zone zoo");
+    EXPECT_EQ(Mnemonic::suggest("zz"), "");
+    EXPECT_EQ(Mnemonic::suggest("1"), "");
+}
+
 } // namespace
@@ -221,6 +221,47 @@ TEST(PrivateKey, PrivateKeyExtendedError) {
     FAIL() << "Should throw Invalid empty key extension";
 }
 
+TEST(PrivateKey, GetPublicKeys) {
+    // 70 keys cover a full and a partial chunk
+    std::vector<PrivateKey> keys;
+    std::vector<PrivateKey> cardanoKeys;
+    for (uint32_t i = 0; i < 70; ++i) {
+        const auto seed = Hash::sha256(TW::data(std::to_string(i)));
+        keys.emplace_back(seed);
+        auto cardanoKey = Hash::sha512(seed);
+        append(cardanoKey, Hash::sha512(cardanoKey));
+        append(cardanoKey, Hash::sha512(cardanoKey));
+        cardanoKey.resize(PrivateKey::cardanoKeySize);
+        cardanoKeys.emplace_back(cardanoKey);
+    }
+
+    auto expectSame = [](const std::vector<PrivateKey>& privateKeys, TWPublicKeyType type, std::size_t threads, unsigned windowBits) {
+        const auto publicKeys = PrivateKey::getPublicKeys(privateKeys, type, threads, windowBits);
+        ASSERT_EQ(publicKeys.size(), privateKeys.size());
+        for (std::size_t i = 0; i < privateKeys.size(); ++i) {
+            const auto expected = privateKeys[i].getPublicKey(type);
+            EXPECT_EQ(publicKeys[i].type, type);
+            EXPECT_EQ(hex(publicKeys[i].bytes), hex(expected.bytes)) << "type " << type << ", key " << i;
+        }
+    };
+    for (auto type : {TWPublicKeyTypeSECP256k1, TWPublicKeyTypeSECP256k1Extended, TWPublicKeyTypeNIST256p1, TWPublicKeyTypeNIST256p1Extended}) {
+        expectSame(keys, type, 1, 4);
+        expectSame(keys, type, 3, 8);
+    }
+    expectSame(keys, TWPublicKeyTypeED25519, 1, 4);
+    expectSame(keys, TWPublicKeyTypeED25519, 3, 4);
+    expectSame(keys, TWPublicKeyTypeED25519Blake2b, 2, 4);
+    expectSame(cardanoKeys, TWPublicKeyTypeED25519Cardano, 1, 4);
+    expectSame(cardanoKeys, TWPublicKeyTypeED25519Cardano, 3, 4);
+    EXPECT_TRUE(PrivateKey::getPublicKeys({}, TWPublicKeyTypeSECP256k1).empty());
+
+    EXPECT_THROW(PrivateKey::getPublicKeys(keys, TWPublicKeyTypeSECP256k1, 1, 5), std::invalid_argument);
+    EXPECT_THROW(PrivateKey::getPublicKeys(keys, TWPublicKeyTypeED25519Cardano), std::invalid_argument);
+    const std::vector<PrivateKey> invalid = {keys[0], PrivateKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"))};
+    EXPECT_THROW(PrivateKey::getPublicKeys(invalid, TWPublicKeyTypeSECP256k1, 1, 8), std::invalid_argument);
+    EXPECT_THROW(PrivateKey::getPublicKeys(invalid, TWPublicKeyTypeSECP256k1Extended), std::invalid_argument);
+}
+
 TEST(PrivateKey, getSharedKey) {
     Data privKeyData = parse_hex("9cd3b16e10bd574fed3743d8e0de0b7b4e6c69f3245ab5a168ef010d22bfefa0");
     EXPECT_TRUE(PrivateKey::isValid(privKeyData, TWCurveSECP256k1));
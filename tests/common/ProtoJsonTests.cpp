@@ -0,0 +1,160 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ProtoJson.h"
+#include "proto/Ethereum.json.pb.h"
+
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace TW::ProtoJson::tests {
+
+using google::protobuf::util::JsonStringToMessage;
+using google::protobuf::util::MessageDifferencer;
+
+TEST(ProtoJson, ReadValues) {
+    Reader reader(R"( {"a": "x\u00e9\ud83d\ude00\n", "b": -12, "c": "18446744073709551615", "d": [true, false], "e": "AQID", "f": "NaN"} )");
+    std::string_view key;
+    ASSERT_TRUE(reader.beginObject());
+
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_EQ(key, "a");
+    std::string string;
+    ASSERT_TRUE(reader.readString(string));
+    EXPECT_EQ(string, "x\xc3\xa9\xf0\x9f\x98\x80\n");
+
+    ASSERT_TRUE(reader.nextKey(key));
+    int32_t int32 = 0;
+    ASSERT_TRUE(reader.readInt32(int32));
+    EXPECT_EQ(int32, -12);
+
+    ASSERT_TRUE(reader.nextKey(key));
+    uint64_t uint64 = 0;
+    ASSERT_TRUE(reader.readUint64(uint64));
+    EXPECT_EQ(uint64, 18446744073709551615ull);
+
+    ASSERT_TRUE(reader.nextKey(key));
+    ASSERT_TRUE(reader.beginArray());
+    std::vector<bool> bools;
+    while (reader.nextElement()) {
+        bool value = false;
+        ASSERT_TRUE(reader.readBool(value));
+        bools.push_back(value);
+    }
+    EXPECT_EQ(bools, std::vector<bool>({true, false}));
+
+    ASSERT_TRUE(reader.nextKey(key));
+    std::string bytes;
+    ASSERT_TRUE(reader.readBytes(bytes));
+    EXPECT_EQ(bytes, "\x01\x02\x03");
+
+    ASSERT_TRUE(reader.nextKey(key));
+    double number = 0;
+    ASSERT_TRUE(reader.readDouble(number));
+    EXPECT_TRUE(std::isnan(number));
+
+    EXPECT_FALSE(reader.nextKey(key));
+    EXPECT_TRUE(reader.finish());
+}
+
+TEST(ProtoJson, ReadInvalid) {
+    const auto failsInt = [](const char* json) {
+        Reader reader(json);
+        int32_t value = 0;
+        return !reader.readInt32(value) && !reader.ok();
+    };
+    EXPECT_TRUE(failsInt("1.5"));
+    EXPECT_TRUE(failsInt("1e3"));
+    EXPECT_TRUE(failsInt("2147483648"));
+    EXPECT_TRUE(failsInt("\"12a\""));
+
+    std::string out;
+    EXPECT_FALSE(Reader("\"\xc0\xaf\"").readString(out));
+    EXPECT_FALSE(Reader("\"\\ud800\"").readString(out));
+    EXPECT_FALSE(Reader("\"a\nb\"").readString(out));
+    EXPECT_FALSE(Reader("\"A\"").readBytes(out));
+
+    Reader trailing("{} {}");
+    ASSERT_TRUE(trailing.beginObject());
+    std::string_view key;
+    EXPECT_FALSE(trailing.nextKey(key));
+    EXPECT_FALSE(trailing.finish());
+
+    const auto nested = std::string(Reader::maxDepth + 1, '[');
+    Reader deep(nested);
+    for (std::size_t i = 0; i < Reader::maxDepth; ++i) {
+        ASSERT_TRUE(deep.beginArray());
+        ASSERT_TRUE(deep.nextElement());
+    }
+    EXPECT_FALSE(deep.beginArray());
+}
+
+TEST(ProtoJson, ParseLikeJsonStringToMessage) {
+    const std::string json = R"({
+        "chainId": "AQ==",
+        "nonce": "CQ==",
+        "txMode": "Enveloped",
+        "gasPrice": null,
+        "max_fee_per_gas": "BKgXyAA=",
+        "gasLimit": "Ugg=",
+        "toAddress": "0x3535353535353535353535353535353535353535",
+        "transaction": {
+            "erc1155Transfer": {
+                "from": "0x718046867b5b1782379a14eA4fc0c9b724DA94Fc",
+                "to": "0x5322b34c88ed0691971bf52a7047448f0f4efc84",
+                "tokenId": "I0U=",
+                "value": "AYag",
+                "data": "AQIDBA"
+            }
+        },
+        "userOperation": {"entryPoint": "0x1306b01bC3e4AD202612D3843387e94737673F53"}
+    })";
+    Ethereum::Proto::SigningInput parsed;
+    ASSERT_TRUE(parse(json, parsed));
+
+    Ethereum::Proto::SigningInput expected;
+    ASSERT_TRUE(JsonStringToMessage(json, &expected).ok());
+    EXPECT_TRUE(MessageDifferencer::Equals(parsed, expected));
+
+    Reader reader(json);
+    Ethereum::Proto::SigningInput generated;
+    EXPECT_TRUE(parseJson(reader, generated) && reader.finish());
+    EXPECT_EQ(generated.tx_mode(), Ethereum::Proto::Enveloped);
+    EXPECT_EQ(generated.transaction().erc1155_transfer().data(), "\x01\x02\x03\x04");
+
+    // rejected by JsonStringToMessage: two members of a oneof, an unknown field even if null
+    for (const auto* invalid : {
+             R"({"transaction": {"transfer": {"amount": "AQ=="}, "erc20Transfer": {"to": "0x5322b34c88ed0691971bf52a7047448f0f4efc84"}}})",
+             R"({"transaction": {"transfer": {"amount": "AQ=="}, "transfer": {"amount": "Ag=="}}})",
+             R"({"nonce": "CQ==", "zzz": null})",
+         }) {
+        SCOPED_TRACE(invalid);
+        Ethereum::Proto::SigningInput input;
+        EXPECT_FALSE(JsonStringToMessage(invalid, &input).ok());
+        EXPECT_FALSE(parse(invalid, input));
+        Reader invalidReader(invalid);
+        EXPECT_FALSE(parseJson(invalidReader, input) && invalidReader.finish());
+    }
+}
+
+TEST(ProtoJson, ParseFallback) {
+    Ethereum::Proto::SigningInput input;
+    Reader reader(R"({"nonce": "CQ==", "txMode": 1})");
+    EXPECT_TRUE(parseJson(reader, input));
+    EXPECT_EQ(input.tx_mode(), Ethereum::Proto::Enveloped);
+
+    // unknown to the generated parser, left to JsonStringToMessage
+    EXPECT_FALSE(parse(R"({"nonce": "CQ==", "unknown": 1})", input));
+    EXPECT_EQ(input.nonce(), "");
+    EXPECT_FALSE(parse(R"({"nonce": "CQ==")", input));
+    EXPECT_TRUE(parse(R"({"nonce": "CQ==", "gasLimit": "Ugg="} )", input));
+    EXPECT_EQ(input.nonce(), "\x09");
+}
+
+} // namespace TW::ProtoJson::tests
@@ -152,6 +152,13 @@ TEST(PublicKeyTests, CompressedExtendedED25519) {
     EXPECT_EQ(compressed.isCompressed(), true);
 }
 
+TEST(PublicKeyTests, HashCompileTimeHasher) {
+    const auto publicKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5")).getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+    EXPECT_EQ(hex(publicKey.hash<Hash::HasherSha256ripemd>()), hex(publicKey.hash({})));
+    EXPECT_EQ(hex(publicKey.hash<Hash::HasherKeccak256>(true)), hex(publicKey.hash({}, Hash::HasherKeccak256, true)));
+    EXPECT_EQ(hex(publicKey.hash(Data{0x00}, Hash::HasherSha256ripemd)), "00" + hex(publicKey.hash<Hash::HasherSha256ripemd>()));
+}
+
 TEST(PublicKeyTests, IsValidWrongType) {
     EXPECT_FALSE(PublicKey::isValid(parse_hex("deadbeef"), (enum TWPublicKeyType)99));
 }
@@ -211,6 +218,11 @@ TEST(PublicKeyTests, VerifyAsDER) {
         const auto publicKeyWrong = privateKey.getPublicKey(TWPublicKeyTypeNIST256p1Extended);
         EXPECT_FALSE(publicKeyWrong.verifyAsDER(signature, digest));
     }
+    { // Negative: trailing data after the DER sequence
+        auto extended = signature;
+        extended.push_back(0x00);
+        EXPECT_FALSE(publicKey.verifyAsDER(extended, digest));
+    }
 }
 
 TEST(PublicKeyTests, VerifyEd25519Extended) {
@@ -225,6 +237,37 @@ TEST(PublicKeyTests, VerifyEd25519Extended) {
     EXPECT_TRUE(valid);
 }
 
+TEST(PublicKeyTests, VerifyBatch) {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> signatures;
+    std::vector<Data> messages;
+    for (auto i = 0; i < 20; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(TW::data(std::to_string(i))));
+        const auto message = Hash::sha256(TW::data("message " + std::to_string(i)));
+        const auto blake = i % 2 == 1;
+        publicKeys.push_back(privateKey.getPublicKey(blake ? TWPublicKeyTypeED25519Blake2b : TWPublicKeyTypeED25519));
+        signatures.push_back(privateKey.sign(message, blake ? TWCurveED25519Blake2bNano : TWCurveED25519));
+        messages.push_back(message);
+    }
+    // Corrupt a signature, swap a message and truncate a signature.
+    signatures[3][10] ^= 1;
+    messages[7] = messages[8];
+    signatures[12].resize(63);
+
+    for (const auto threads : {0ul, 1ul, 4ul}) {
+        const auto valid = PublicKey::verifyBatch(publicKeys, signatures, messages, threads);
+        ASSERT_EQ(valid.size(), publicKeys.size());
+        for (auto i = 0ul; i < valid.size(); ++i) {
+            EXPECT_EQ(valid[i], i != 3 && i != 7 && i != 12) << i;
+        }
+    }
+
+    EXPECT_TRUE(PublicKey::verifyBatch({}, {}, {}).empty());
+    EXPECT_THROW(PublicKey::verifyBatch(publicKeys, signatures, std::span(messages).first(3)), std::invalid_argument);
+    const auto secp256k1 = PrivateKey(Hash::sha256(TW::data("0"))).getPublicKey(TWPublicKeyTypeSECP256k1);
+    EXPECT_THROW(PublicKey::verifyBatch(std::vector{secp256k1}, std::span(signatures).first(1), std::span(messages).first(1)), std::invalid_argument);
+}
+
 TEST(PublicKeyTests, VerifySchnorr) {
     const auto key = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
     const auto privateKey = PrivateKey(key);
@@ -302,6 +345,62 @@ TEST(PublicKeyTests, RecoverRawNegative) {
         "digest too short");
 }
 
+TEST(PublicKeyTests, RecoverBatch) {
+    std::vector<Data> signatures;
+    std::vector<Data> digests;
+    for (auto i = 0; i < 150; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(TW::data("key " + std::to_string(i))));
+        // An all-zero digest exercises the case without a generator term.
+        const auto digest = i == 5 ? Data(32) : Hash::keccak256(TW::data("message " + std::to_string(i)));
+        auto signature = privateKey.sign(digest, TWCurveSECP256k1);
+        if (i % 3 == 0) {
+            signature[64] += PublicKey::SignatureVOffset;
+        }
+        signatures.push_back(signature);
+        digests.push_back(digest);
+    }
+    // Arbitrary R and S, with every recovery id, mostly not on the curve or recovering some other key.
+    for (auto i = 0; i < 24; ++i) {
+        auto signature = Hash::sha512(TW::data("garbage " + std::to_string(i)));
+        signature.push_back(static_cast<byte>(i % 4));
+        signatures.push_back(signature);
+        digests.push_back(Hash::sha256(signature));
+    }
+    // R = 0, S = order, short signature, short digest, invalid recovery id.
+    signatures.push_back(parse_hex("0000000000000000000000000000000000000000000000000000000000000000" "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef" "00"));
+    signatures.push_back(parse_hex("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef" "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141" "00"));
+    signatures.push_back(Data(64, 1));
+    signatures.push_back(signatures[0]);
+    signatures.push_back(signatures[1]);
+    signatures.back()[64] = 4;
+    for (auto i = 0; i < 5; ++i) {
+        digests.push_back(i == 3 ? Data(31, 1) : digests[0]);
+    }
+
+    for (const auto threads : {1ul, 3ul}) {
+        Data keys(signatures.size() * PublicKey::secp256k1ExtendedSize);
+        const auto valid = PublicKey::recoverBatch(signatures, digests, keys.data(), threads);
+        ASSERT_EQ(valid.size(), signatures.size());
+        auto recovered = 0;
+        for (auto i = 0ul; i < signatures.size(); ++i) {
+            std::optional<PublicKey> expected;
+            try {
+                expected = PublicKey::recover(signatures[i], digests[i]);
+            } catch (const std::invalid_argument&) {
+            }
+            ASSERT_EQ(valid[i], expected.has_value()) << i;
+            if (expected.has_value()) {
+                const Data key(keys.begin() + i * PublicKey::secp256k1ExtendedSize, keys.begin() + (i + 1) * PublicKey::secp256k1ExtendedSize);
+                EXPECT_EQ(hex(key), hex(expected->bytes)) << i;
+                ++recovered;
+            }
+        }
+        EXPECT_GT(recovered, 150);
+    }
+
+    EXPECT_THROW(PublicKey::recoverBatch(signatures, std::span(digests).first(1), nullptr), std::invalid_argument);
+}
+
 TEST(PublicKeyTests, Recover) {
     {
         const auto message = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
@@ -354,3 +453,39 @@ TEST(PublicKeyTests, isValidED25519) {
     EXPECT_FALSE(PublicKey::isValid(parse_hex("0101beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519));
     EXPECT_FALSE(PublicKey(parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"), TWPublicKeyTypeSECP256k1).isValidED25519());
 }
+
+TEST(PublicKeyTests, FromTrusted) {
+    const auto key = parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
+    const auto publicKey = PublicKey::fromTrusted(key.data(), key.size(), TWPublicKeyTypeSECP256k1);
+    EXPECT_EQ(publicKey, PublicKey(key, TWPublicKeyTypeSECP256k1));
+    EXPECT_EQ(publicKey.type, TWPublicKeyTypeSECP256k1);
+    EXPECT_EQ(publicKey.extended().compressed(), publicKey);
+
+    // a compressed key off the curve passes the format check, and fails when extended
+    const auto offCurve = PublicKey(parse_hex("020000000000000000000000000000000000000000000000000000000000000005"), TWPublicKeyTypeSECP256k1);
+    EXPECT_THROW(offCurve.extended(), std::invalid_argument);
+}
+
+TEST(PublicKeyTests, IsValidBatch) {
+    const std::vector<Data> secp256k1Keys{
+        parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"),
+        parse_hex("020000000000000000000000000000000000000000000000000000000000000005"), // not on the curve
+        parse_hex("0499c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c166b5ec26bd0c2ebf3dea0c7c92e4bbd3b6af7d7c0fdc4ad8ad1a1e6b4c234600"), // wrong y
+        parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196"), // too short
+        Data(PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5")).getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes),
+    };
+    EXPECT_EQ(PublicKey::isValidBatch(secp256k1Keys, TWPublicKeyTypeSECP256k1, 2), std::vector<bool>({true, false, false, false, false}));
+    EXPECT_EQ(PublicKey::isValidBatch(secp256k1Keys, TWPublicKeyTypeSECP256k1Extended, 2), std::vector<bool>({false, false, false, false, true}));
+    for (std::size_t i = 0; i < secp256k1Keys.size(); ++i) {
+        EXPECT_EQ(PublicKey::isValid(secp256k1Keys[i], TWPublicKeyTypeSECP256k1), i < 2);
+    }
+
+    const std::vector<Data> ed25519Keys{
+        parse_hex("beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"),
+        parse_hex("01beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"),
+        parse_hex("8eaf04151687736326c9fea17e25fc5287613693c912909cb226aa4794f26a48"), // not on the curve
+        parse_hex("1234"),
+    };
+    EXPECT_EQ(PublicKey::isValidBatch(ed25519Keys, TWPublicKeyTypeED25519), std::vector<bool>({true, true, false, false}));
+    EXPECT_TRUE(PublicKey::isValidBatch({}, TWPublicKeyTypeED25519).empty());
+}
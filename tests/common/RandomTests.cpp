@@ -0,0 +1,74 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Random.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace TW::Random::tests {
+
+TEST(Random, Generate) {
+    const auto first = generate(32);
+    const auto second = generate(32);
+    EXPECT_EQ(first.size(), 32ul);
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(std::any_of(first.begin(), first.end(), [](byte b) { return b != 0; }));
+}
+
+TEST(Random, FillAcrossReseed) {
+    // larger than one generate call and than the reseed interval
+    Data buffer(reseedInterval + 100000);
+    fill(buffer.data(), buffer.size());
+    const Data head(buffer.begin(), buffer.begin() + 64);
+    const Data tail(buffer.end() - 64, buffer.end());
+    EXPECT_NE(head, tail);
+    EXPECT_NE(Data(64), tail);
+}
+
+TEST(Random, Threads) {
+    Data other;
+    std::thread thread([&other] { other = generate(32); });
+    thread.join();
+    EXPECT_EQ(other.size(), 32ul);
+    EXPECT_NE(other, generate(32));
+    EXPECT_NE(next32(), next32());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(Random, Fork) {
+    // seeded before the fork
+    generate(32);
+
+    int pipes[2];
+    ASSERT_EQ(pipe(pipes), 0);
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        const auto bytes = generate(32);
+        const auto written = write(pipes[1], bytes.data(), bytes.size());
+        _exit(written == static_cast<ssize_t>(bytes.size()) ? 0 : 1);
+    }
+    const auto bytes = generate(32);
+    Data child(32);
+    EXPECT_EQ(read(pipes[0], child.data(), child.size()), 32);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(pipes[0]);
+    close(pipes[1]);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_NE(child, bytes);
+}
+#endif
+
+} // namespace TW::Random::tests
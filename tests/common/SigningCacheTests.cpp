@@ -0,0 +1,99 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+#include "SigningCache.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace TW::tests {
+
+using Operation = SigningCache::Operation;
+
+TEST(SigningCache, Disabled) {
+    SigningCache cache;
+    const auto input = parse_hex("0a0b0c");
+    auto calls = 0;
+    Data output;
+    for (auto i = 0; i < 2; ++i) {
+        cache.getOrCompute(TWCoinTypeBitcoin, Operation::Sign, input, output, [&] { output = parse_hex("01"); ++calls; });
+    }
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(cache.size(), 0ul);
+}
+
+TEST(SigningCache, GetOrCompute) {
+    SigningCache cache;
+    cache.configure(4, std::chrono::seconds(0));
+    const auto input = parse_hex("0a0b0c");
+    auto calls = 0;
+    const auto compute = [&](Data& output) {
+        cache.getOrCompute(TWCoinTypeBitcoin, Operation::Sign, input, output, [&] { output = parse_hex("01"); ++calls; });
+    };
+
+    Data first;
+    compute(first);
+    Data second;
+    compute(second);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(hex(second), "01");
+
+    // another coin or operation is another entry
+    Data other;
+    cache.getOrCompute(TWCoinTypeLitecoin, Operation::Sign, input, other, [&] { other = parse_hex("02"); });
+    cache.getOrCompute(TWCoinTypeBitcoin, Operation::Plan, input, other, [&] { other = parse_hex("03"); });
+    EXPECT_EQ(hex(other), "03");
+    EXPECT_EQ(cache.size(), 3ul);
+
+    cache.clear();
+    compute(second);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(SigningCache, EvictLeastRecentlyUsed) {
+    SigningCache cache;
+    cache.configure(2, std::chrono::seconds(0));
+    const auto keyA = SigningCache::key(TWCoinTypeBitcoin, Operation::Sign, parse_hex("0a"));
+    const auto keyB = SigningCache::key(TWCoinTypeBitcoin, Operation::Sign, parse_hex("0b"));
+    const auto keyC = SigningCache::key(TWCoinTypeBitcoin, Operation::Sign, parse_hex("0c"));
+    cache.insert(keyA, parse_hex("aa"));
+    cache.insert(keyB, parse_hex("bb"));
+    Data output;
+    ASSERT_TRUE(cache.find(keyA, output));
+    cache.insert(keyC, parse_hex("cc"));
+
+    EXPECT_TRUE(cache.find(keyA, output));
+    EXPECT_EQ(hex(output), "aa");
+    EXPECT_FALSE(cache.find(keyB, output));
+    EXPECT_TRUE(cache.find(keyC, output));
+
+    cache.configure(1, std::chrono::seconds(0));
+    EXPECT_EQ(cache.size(), 1ul);
+    EXPECT_TRUE(cache.find(keyC, output));
+
+    cache.configure(0, std::chrono::seconds(0));
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(cache.size(), 0ul);
+    cache.insert(keyA, parse_hex("aa"));
+    EXPECT_EQ(cache.size(), 0ul);
+}
+
+TEST(SigningCache, Expiry) {
+    SigningCache cache;
+    cache.configure(2, std::chrono::milliseconds(20));
+    const auto key = SigningCache::key(TWCoinTypeBitcoin, Operation::Plan, parse_hex("0a"));
+    cache.insert(key, parse_hex("aa"));
+    Data output;
+    EXPECT_TRUE(cache.find(key, output));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_FALSE(cache.find(key, output));
+    EXPECT_EQ(cache.size(), 0ul);
+}
+
+} // namespace TW::tests
@@ -0,0 +1,69 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningContext.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::SigningContextTests {
+
+const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+
+int acceptAll([[maybe_unused]] uint8_t by, [[maybe_unused]] uint8_t sig[64]) {
+    return 1;
+}
+
+TEST(SigningContext, SignSECP256k1) {
+    const auto context = SigningContext(privateKey, TWCurveSECP256k1);
+    EXPECT_EQ(context.curve(), TWCurveSECP256k1);
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    EXPECT_EQ(hex(context.extendedPublicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes));
+
+    const auto hash = Hash::keccak256(TW::data("hello"));
+    SigningContext::Signature signature;
+    ASSERT_TRUE(context.sign(hash, signature));
+    EXPECT_EQ(hex(signature), "8720a46b5b3963790d94bcc61ad57ca02fd153584315bfa161ed3455e336ba624d68df010ed934b8792c5b6a57ba86c3da31d039f9612b44d1bf054132254de901");
+    EXPECT_EQ(context.sign(hash), privateKey.sign(hash, TWCurveSECP256k1));
+
+    // same context, many digests
+    for (auto i = 0; i < 16; ++i) {
+        const auto digest = Hash::sha256(TW::data(std::to_string(i)));
+        ASSERT_TRUE(context.sign(digest, signature));
+        EXPECT_EQ(hex(signature), hex(privateKey.sign(digest, TWCurveSECP256k1)));
+        EXPECT_TRUE(context.publicKey().verify(Data(signature.begin(), signature.begin() + 64), digest));
+    }
+
+    ASSERT_TRUE(context.signCanonical(hash, signature, acceptAll));
+    EXPECT_EQ(hex(signature), "208720a46b5b3963790d94bcc61ad57ca02fd153584315bfa161ed3455e336ba624d68df010ed934b8792c5b6a57ba86c3da31d039f9612b44d1bf054132254de9");
+}
+
+TEST(SigningContext, SignNIST256p1) {
+    const auto context = SigningContext(privateKey, TWCurveNIST256p1);
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeNIST256p1).bytes));
+
+    const auto hash = Hash::keccak256(TW::data("hello"));
+    SigningContext::Signature signature;
+    ASSERT_TRUE(context.sign(hash, signature));
+    EXPECT_EQ(hex(signature), "8859e63a0c0cc2fc7f788d7e78406157b288faa6f76f76d37c4cd1534e8d83c468f9fd6ca7dde378df594625dcde98559389569e039282275e3d87c26e36447401");
+}
+
+TEST(SigningContext, Invalid) {
+    EXPECT_THROW(SigningContext(privateKey, TWCurveED25519), std::invalid_argument);
+    // not a valid key on secp256k1 (above the curve order)
+    const auto overOrder = PrivateKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364142"));
+    EXPECT_THROW(SigningContext(overOrder, TWCurveSECP256k1), std::invalid_argument);
+
+    const auto context = SigningContext(privateKey, TWCurveSECP256k1);
+    SigningContext::Signature signature;
+    const auto shortDigest = parse_hex("0102030405");
+    EXPECT_FALSE(context.sign(shortDigest, signature));
+    EXPECT_EQ(hex(signature), std::string(2 * SigningContext::signatureSize, '0'));
+    EXPECT_TRUE(context.sign(shortDigest).empty());
+}
+
+} // namespace TW::SigningContextTests
@@ -0,0 +1,88 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Slip39.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::tests {
+
+// https://github.com/trezor/python-shamir-mnemonic/blob/master/vectors.json
+TEST(Slip39, VectorWithoutSharing) {
+    const auto mnemonic = "duckling enlarge academic academic agency result length solution fridge kidney coal piece deal husband erode duke ajar critical decision keyboard";
+    const auto share = Slip39::Share::decode(mnemonic);
+    ASSERT_TRUE(share.has_value());
+    EXPECT_EQ(share->encode(), mnemonic);
+    EXPECT_FALSE(share->extendable);
+    EXPECT_EQ(hex(*Slip39::recover({mnemonic}, "TREZOR")), "bb54aac4b89dc868ba37d9cc21b2cece");
+}
+
+TEST(Slip39, VectorBasicSharing) {
+    const std::vector<std::string> shares = {
+        "shadow pistol academic always adequate wildlife fancy gross oasis cylinder mustang wrist rescue view short owner flip making coding armed",
+        "shadow pistol academic acid actress prayer class unknown daughter sweater depict flip twice unkind craft early superior advocate guest smoking",
+    };
+    EXPECT_EQ(hex(*Slip39::recover(shares, "TREZOR")), "b43ceb7e57a0ea8766221624d01b0864");
+    EXPECT_FALSE(Slip39::recover({shares[0]}, "TREZOR").has_value());
+}
+
+TEST(Slip39, InvalidShares) {
+    // invalid checksum
+    EXPECT_FALSE(Slip39::isValidShare("duckling enlarge academic academic agency result length solution fridge kidney coal piece deal husband erode duke ajar critical decision kidney"));
+    // not a word, too short
+    EXPECT_FALSE(Slip39::isValidShare("duckling enlarge academic academic agency result length solution fridge kidney coal piece deal husband erode duke ajar critical decision keyboardz"));
+    EXPECT_FALSE(Slip39::isValidShare("duckling enlarge academic academic"));
+}
+
+TEST(Slip39, GenerateRecover) {
+    const auto secret = parse_hex("0c94f2ad1f5ed0e3ebd5e4d1e5cbc9a10c94f2ad1f5ed0e3ebd5e4d1e5cbc9a1");
+    const auto groups = Slip39::generate(2, {{1, 1}, {2, 3}, {3, 5}}, secret, "passphrase", 0);
+    ASSERT_EQ(groups.size(), 3ul);
+    EXPECT_EQ(groups[2].size(), 5ul);
+    for (const auto& group : groups) {
+        for (const auto& share : group) {
+            EXPECT_TRUE(Slip39::isValidShare(share));
+            EXPECT_EQ(Slip39::Share::decode(share)->encode(), share);
+        }
+    }
+
+    EXPECT_EQ(hex(*Slip39::recover({groups[0][0], groups[1][2], groups[1][0]}, "passphrase")), hex(secret));
+    EXPECT_EQ(hex(*Slip39::recover({groups[2][4], groups[1][1], groups[2][0], groups[1][2], groups[2][1]}, "passphrase")), hex(secret));
+    // all the shares at once
+    std::vector<std::string> all;
+    for (const auto& group : groups) {
+        all.insert(all.end(), group.begin(), group.end());
+    }
+    EXPECT_EQ(hex(*Slip39::recover(all, "passphrase")), hex(secret));
+    EXPECT_NE(hex(*Slip39::recover(all, "")), hex(secret));
+    // one group only
+    EXPECT_FALSE(Slip39::recover({groups[2][0], groups[2][1], groups[2][2]}, "passphrase").has_value());
+
+    EXPECT_THROW(Slip39::generate(1, {{1, 2}}, secret), std::invalid_argument);
+    EXPECT_THROW(Slip39::generate(2, {{1, 1}}, secret), std::invalid_argument);
+    EXPECT_THROW(Slip39::generate(1, {{2, 3}}, Data(15)), std::invalid_argument);
+}
+
+TEST(Slip39, VerifyCombinations) {
+    const auto secret = parse_hex("bb54aac4b89dc868ba37d9cc21b2cece");
+    const auto groups = Slip39::generate(2, {{2, 3}, {3, 5}, {2, 2}}, secret, "", 0, false);
+    std::vector<std::string> all;
+    for (const auto& group : groups) {
+        all.insert(all.end(), group.begin(), group.end());
+    }
+    // C(3,2) + C(5,3) + C(2,2) member combinations, C(3,2) group combinations
+    EXPECT_EQ(Slip39::verifyCombinations(all, 1), 3ul + 10ul + 1ul + 3ul);
+    EXPECT_EQ(Slip39::verifyCombinations(all, 4), 17ul);
+
+    // a share of another split with the same header fails its combinations
+    auto share = *Slip39::Share::decode(all[4]);
+    share.value[0] ^= 1;
+    all[4] = share.encode();
+    EXPECT_THROW(Slip39::verifyCombinations(all), std::invalid_argument);
+}
+
+} // namespace TW::tests
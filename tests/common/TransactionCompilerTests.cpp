@@ -317,6 +317,30 @@ TEST(TransactionCompiler, BitcoinCompileWithSignatures) {
         EXPECT_EQ(output.encoded().size(), 0ul);
         EXPECT_EQ(output.error(), Common::Proto::Error_signing);
     }
+
+    {   // Batch: same hashes and transactions as the single calls, the input is planned once
+        auto batch = TransactionCompilerBatch(coin, {txInputData, txInputData, data("invalid")}, 2);
+        EXPECT_EQ(batch.size(), 3ul);
+
+        const auto hashes = batch.preImageHashes(2);
+        ASSERT_EQ(hashes.size(), 3ul);
+        EXPECT_EQ(hex(hashes[0]), hex(preImageHashes));
+        EXPECT_EQ(hex(hashes[1]), hex(preImageHashes));
+        EXPECT_EQ(hex(hashes[2]), hex(TransactionCompiler::preImageHashes(coin, data("invalid"))));
+
+        EXPECT_EQ(hex(batch.compileWithSignatures(1, signatureVec, pubkeyVec)), hex(compileWithSignatures));
+        EXPECT_EQ(hex(batch.compileWithSignatures(0, {signatureVec[0]}, pubkeyVec)),
+                  hex(TransactionCompiler::compileWithSignatures(coin, txInputData, {signatureVec[0]}, pubkeyVec)));
+
+        const auto compiled = batch.compileWithSignatures({signatureVec, signatureVec, signatureVec}, {pubkeyVec, pubkeyVec, pubkeyVec}, 2);
+        ASSERT_EQ(compiled.size(), 3ul);
+        EXPECT_EQ(hex(compiled[0]), hex(compileWithSignatures));
+        EXPECT_EQ(hex(compiled[1]), hex(compileWithSignatures));
+        EXPECT_EQ(hex(compiled[2]), hex(TransactionCompiler::compileWithSignatures(coin, data("invalid"), signatureVec, pubkeyVec)));
+
+        EXPECT_THROW(batch.compileWithSignatures(3, signatureVec, pubkeyVec), std::out_of_range);
+        EXPECT_THROW(batch.compileWithSignatures({signatureVec}, {pubkeyVec}), std::invalid_argument);
+    }
 }
 
 TEST(TransactionCompiler, EthereumCompileWithSignatures) {
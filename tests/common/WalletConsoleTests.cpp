@@ -6,6 +6,7 @@
 
 #include "../walletconsole/lib/CommandExecutor.h"
 #include "../walletconsole/lib/WalletConsole.h"
+#include "../walletconsole/lib/BatchRunner.h"
 
 #include <sstream>
 #include <cstdio>
@@ -483,4 +484,51 @@ TEST(WalletConsole, harmonyAddressDerivation) {
     EXPECT_TRUE(res1.find("rror") == string::npos);
 }
 
+TEST(WalletConsole, batchCommandLine) {
+    EXPECT_EQ(BatchRunner::commandLine("  addrDP m/84'/0'/0'/0/0"), "addrDP m/84'/0'/0'/0/0");
+    EXPECT_EQ(BatchRunner::commandLine(R"({"cmd": "addrXpub", "params": ["xpub", 3]})"), "addrXpub xpub 3");
+    EXPECT_EQ(BatchRunner::commandLine(R"({"params": ["m/0"]})"), "");
+    EXPECT_EQ(BatchRunner::commandLine("{not json"), "");
+    EXPECT_TRUE(CommandExecutor::isStateless("addrDP m/84'/0'/0'/0/0"));
+    EXPECT_FALSE(CommandExecutor::isStateless("addrPub #"));
+    EXPECT_FALSE(CommandExecutor::isStateless("coin btc"));
+}
+
+TEST(WalletConsole, batch) {
+    stringstream inss;
+    inss << "coin btc" << endl
+         << "setMnemonic " << mnemonic1 << endl
+         << "addrDP m/84'/0'/0'/0/0" << endl
+         << R"({"cmd": "addrDP", "params": ["m/84'/0'/0'/0/1"]})" << endl
+         << "hex Hello" << endl
+         << "addrDP _Invalid_This_is_not_a_valid_DP_///" << endl
+         << "base64Encode #3" << endl
+         << "exit" << endl
+         << "hex NotExecuted" << endl;
+    stringstream outss;
+    BatchRunner runner(outss, 4);
+    runner.init();
+    EXPECT_EQ(runner.run(inss), 7ul);
+
+    const string res = outss.str();
+    const auto first = res.find("bc1q5mv7jf4uzyf0524sxzrpucdf6tnrd0maq9k8zv");
+    const auto second = res.find("bc1qejkm69ert6jqrp2u4n0m6g9ds4ravas2dw3af0");
+    const auto hello = res.find("Result:  48656c6c6f");
+    const auto error = res.find("rror while executing command, Invalid component");
+    ASSERT_NE(first, string::npos);
+    ASSERT_NE(second, string::npos);
+    ASSERT_NE(hello, string::npos);
+    ASSERT_NE(error, string::npos);
+    // printed in script order
+    EXPECT_LT(first, second);
+    EXPECT_LT(second, hello);
+    EXPECT_LT(hello, error);
+    // #3 is the third result, the hex, taken after the parallel commands
+    EXPECT_NE(res.find("Result:  SGVsbG8="), string::npos);
+    EXPECT_EQ(res.find("NotExecuted"), string::npos);
+    EXPECT_GE(countLines(res), 7 * 2);
+    EXPECT_NE(res.find("Time:  "), string::npos);
+    EXPECT_NE(res.find("Executed 7 commands"), string::npos);
+}
+
 } // namespace TW::WalletConsole::tests
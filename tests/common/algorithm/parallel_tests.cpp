@@ -0,0 +1,50 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "algorithm/parallel.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+
+using namespace TW;
+
+TEST(Algorithms, ParallelForVisitsEveryIndexOnce) {
+    const std::size_t count = 1000;
+    for (auto threads : {0ul, 1ul, 3ul, 64ul}) {
+        std::vector<std::atomic<int>> visits(count);
+        parallelFor(count, threads, [&](std::size_t i) { visits[i]++; });
+        for (std::size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(visits[i].load(), 1);
+        }
+    }
+}
+
+TEST(Algorithms, ParallelForSingleThreadIsSequential) {
+    const auto caller = std::this_thread::get_id();
+    std::vector<std::size_t> order;
+    parallelFor(10, 1, [&](std::size_t i) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        order.push_back(i);
+    });
+    ASSERT_EQ(order, (std::vector<std::size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(Algorithms, ParallelForRethrows) {
+    EXPECT_THROW(parallelFor(100, 4, [](std::size_t i) {
+        if (i == 42) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(Algorithms, ParallelWorkerCount) {
+    EXPECT_EQ(parallelWorkerCount(0, 4), 0ul);
+    EXPECT_EQ(parallelWorkerCount(2, 4), 2ul);
+    EXPECT_EQ(parallelWorkerCount(10, 4), 4ul);
+    EXPECT_GE(parallelWorkerCount(10, 0), 1ul);
+}
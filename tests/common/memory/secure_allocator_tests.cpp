@@ -0,0 +1,118 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "memory/secure_allocator.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <thread>
+
+using namespace TW;
+
+TEST(Memory, SecureDataSizeClasses) {
+    std::vector<SecureData> buffers;
+    for (const auto size : {1ul, 32ul, 33ul, 64ul, 96ul, 192ul, 193ul, 5000ul}) {
+        buffers.emplace_back(size, static_cast<byte>(size));
+        EXPECT_EQ(buffers.back().size(), size);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffers.back().data()) % alignof(std::max_align_t), 0ul);
+    }
+    for (const auto& buffer : buffers) {
+        EXPECT_EQ(buffer, Data(buffer.size(), static_cast<byte>(buffer.size())));
+    }
+}
+
+TEST(Memory, SecureDataReusesWipedBlocks) {
+    auto& arena = SecureArena::instance();
+    auto* block = static_cast<byte*>(arena.allocate(64));
+    std::fill_n(block, 64, 0xab);
+    arena.deallocate(block, 64);
+    // the block is back on the free list, wiped
+    auto* reused = static_cast<byte*>(arena.allocate(64));
+    EXPECT_EQ(reused, block);
+    EXPECT_EQ(Data(reused, reused + 64), Data(64, 0));
+    arena.deallocate(reused, 64);
+}
+
+TEST(Memory, SecureString) {
+    const std::string mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto secure = SecureString(mnemonic);
+    EXPECT_EQ(secure, mnemonic);
+    EXPECT_EQ(mnemonic, secure);
+    EXPECT_EQ(secure, "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal");
+    EXPECT_EQ(std::string_view(secure), mnemonic);
+}
+
+namespace {
+
+/// Whether `pointer` is inside `object`, e.g. in a small string buffer.
+template <typename T>
+bool isInside(const void* pointer, const T& object) {
+    const auto* begin = reinterpret_cast<const std::byte*>(&object);
+    const auto* target = static_cast<const std::byte*>(pointer);
+    return target >= begin && target < begin + sizeof(T);
+}
+
+} // namespace
+
+TEST(Memory, SecureStringShortIsNotInline) {
+    auto secure = SecureString("short");
+    EXPECT_GE(secure.capacity(), SecureString::minCapacity);
+    EXPECT_FALSE(isInside(secure.data(), secure));
+
+    const auto copy = secure;
+    EXPECT_EQ(copy, std::string("short"));
+    EXPECT_FALSE(isInside(copy.data(), copy));
+
+    secure = std::string("");
+    EXPECT_TRUE(secure.empty());
+    EXPECT_FALSE(isInside(secure.data(), secure));
+}
+
+TEST(Memory, PrivateKeyInArena) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    EXPECT_FALSE(isInside(privateKey.bytes.data(), privateKey));
+
+    const auto copy = privateKey;
+    EXPECT_NE(copy.bytes.data(), privateKey.bytes.data());
+    EXPECT_EQ(hex(copy.bytes), "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+}
+
+TEST(Memory, PrivateKeyMoveTakesBlock) {
+    auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto* block = privateKey.bytes.data();
+
+    auto moved = std::move(privateKey);
+    EXPECT_EQ(moved.bytes.data(), block);
+    EXPECT_EQ(hex(moved.bytes), "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+
+    // a moved-from key can be assigned again
+    privateKey = moved;
+    EXPECT_EQ(hex(privateKey.bytes), "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+}
+
+TEST(Memory, SecureDataThreads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            std::vector<SecureData> buffers;
+            for (int i = 0; i < 1000; ++i) {
+                buffers.emplace_back(32 * (1 + i % 6), static_cast<byte>(t));
+                if (i % 3 == 0) {
+                    buffers.erase(buffers.begin());
+                }
+            }
+            for (const auto& buffer : buffers) {
+                EXPECT_EQ(buffer, Data(buffer.size(), static_cast<byte>(t)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
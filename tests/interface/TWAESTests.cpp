@@ -7,6 +7,7 @@
 #include "TestUtilities.h"
 
 #include <TrustWalletCore/TWAES.h>
+#include <TrustWalletCore/TWAESStream.h>
 
 #include <gtest/gtest.h>
 
@@ -60,3 +61,35 @@ TEST(TWAES, CTRDecrypt) {
     auto decryptResult = WRAPD(TWAESDecryptCTR(key.get(), cipher.get(), iv.get()));
     assertHexEqual(decryptResult, "6bc1bee22e409f96e93d7e117393172a");
 }
+
+TEST(TWAES, StreamGCM) {
+    auto nonce = DATA("cafebabefacedbaddecaf888");
+    auto aad = DATA("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+    auto first = DATA("6bc1bee22e409f96e93d7e117393172aae2d");
+    auto second = DATA("8a571e03ac9c9eb76fac45af8e51");
+
+    auto encryptor = TWAESStreamCreateEncryptor(TWAESModeGCM, key.get(), nonce.get(), TWAESPaddingModeZero, aad.get());
+    ASSERT_NE(encryptor, nullptr);
+    auto sealed1 = WRAPD(TWAESStreamUpdate(encryptor, first.get()));
+    auto sealed2 = WRAPD(TWAESStreamUpdate(encryptor, second.get()));
+    auto tag = WRAPD(TWAESStreamFinish(encryptor));
+    TWAESStreamDelete(encryptor);
+    EXPECT_EQ(TWDataSize(sealed1.get()), 18ul);
+    EXPECT_EQ(TWDataSize(tag.get()), 16ul);
+
+    // the tag is expected at the end of the input
+    auto decryptor = TWAESStreamCreateDecryptor(TWAESModeGCM, key.get(), nonce.get(), TWAESPaddingModeZero, aad.get());
+    ASSERT_NE(decryptor, nullptr);
+    auto opened1 = WRAPD(TWAESStreamUpdate(decryptor, sealed1.get()));
+    auto opened2 = WRAPD(TWAESStreamUpdate(decryptor, sealed2.get()));
+    auto opened3 = WRAPD(TWAESStreamUpdate(decryptor, tag.get()));
+    auto end = WRAPD(TWAESStreamFinish(decryptor));
+    TWAESStreamDelete(decryptor);
+    ASSERT_NE(end.get(), nullptr);
+    EXPECT_EQ(TWDataSize(end.get()), 0ul);
+    TWDataAppendData(opened1.get(), opened2.get());
+    TWDataAppendData(opened1.get(), opened3.get());
+    assertHexEqual(opened1, "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51");
+
+    EXPECT_EQ(TWAESStreamCreateEncryptor(TWAESModeCTR, key.get(), nonce.get(), TWAESPaddingModeZero, aad.get()), nullptr);
+}
@@ -13,6 +13,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 using namespace TW;
 
 TEST(TWAnyAddress, InvalidString) {
@@ -25,6 +27,31 @@ TEST(TWAnyAddress, InvalidString) {
     ASSERT_EQ(TWAnyAddressCoin(ethAaddress.get()), TWCoinTypeEthereum);
 }
 
+TEST(TWAnyAddress, ValidateBatch) {
+    const auto addresses = WRAP(TWDataVector, TWDataVectorCreate());
+    for (const auto* address : {"0x4E5B2e1dc63F6b91cb6Cd759936495434C7e972F", "0x4E5B2e1dc63F6b91cb6Cd759936495434C7e972", "", "bc1qcj2vfjec3c3luf9fx9vddnglhh9gawmncmgxhz"}) {
+        const auto data = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(address), strlen(address)));
+        TWDataVectorAdd(addresses.get(), data.get());
+    }
+    const auto ethereum = WRAPD(TWAnyAddressValidateBatch(addresses.get(), TWCoinTypeEthereum));
+    assertHexEqual(ethereum, "01000000");
+    const auto bitcoin = WRAPD(TWAnyAddressValidateBatch(addresses.get(), TWCoinTypeBitcoin));
+    assertHexEqual(bitcoin, "00000001");
+}
+
+TEST(TWAnyAddress, DecodeBatch) {
+    const auto addresses = WRAP(TWDataVector, TWDataVectorCreate());
+    for (const auto* address : {"0x4e5b2e1dc63f6b91cb6cd759936495434c7e972f", "bc1qcj2vfjec3c3luf9fx9vddnglhh9gawmncmgxhz"}) {
+        const auto data = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(address), strlen(address)));
+        TWDataVectorAdd(addresses.get(), data.get());
+    }
+    const auto expected = "012a000000307834453542326531646336334636623931636236436437353939333634393534333443376539373246140000004e5b2e1dc63f6b91cb6cd759936495434c7e972f00";
+    for (const auto threads : {1u, 2u}) {
+        const auto decoded = WRAPD(TWAnyAddressDecodeBatch(addresses.get(), TWCoinTypeEthereum, threads));
+        assertHexEqual(decoded, expected);
+    }
+}
+
 TEST(TWAnyAddress, Data) {
     // ethereum
     {
@@ -15,6 +15,16 @@ TEST(TWAsnParser, EcdsaSignatureFromDer) {
     auto decodedResult = WRAPD(TWAsnParserEcdsaSignatureFromDer(encoded.get()));
     assertHexEqual(decodedResult, "db421231f23d0320dbb8f1284b600cd34b8e9218628139539ff4f1f6c05495daff715aab70d5317dbf8ee224eb18bec3120cfb9db1000dbb31eadaf96c71c1b1");
 
+    auto shortValues = DATA("3006020101020102");
+    auto decodedShort = WRAPD(TWAsnParserEcdsaSignatureFromDer(shortValues.get()));
+    assertHexEqual(decodedShort, "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000002");
+
     auto invalid = DATA("");
     ASSERT_EQ(TWAsnParserEcdsaSignatureFromDer(invalid.get()), nullptr);
+
+    // trailing data, negative value, non-minimal integer
+    for (const auto* hex : {"300602010102010200", "3006020181020102", "300702020001020102"}) {
+        auto nonCanonical = DATA(hex);
+        ASSERT_EQ(TWAsnParserEcdsaSignatureFromDer(nonCanonical.get()), nullptr) << hex;
+    }
 }
@@ -0,0 +1,73 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TestUtilities.h"
+
+#include <TrustWalletCore/TWAsyncTask.h>
+#include <TrustWalletCore/TWHDWallet.h>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+namespace TW::AsyncTask::tests {
+
+const auto gMnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const auto gSeedHex = "7ae6f661157bda6492f6162701e570097fc726b6235011ea5ad09bf04986731ed4d92bc43cbdee047b60ea0dd1b1fa4274377c9bf5bd14ab1982c272d8076f29";
+
+TEST(TWAsyncTask, HDWalletCreateWithMnemonic) {
+    std::atomic<int> calls{0};
+    const auto callback = [](TWAsyncTask* task, void* context) {
+        EXPECT_EQ(TWAsyncTaskGetStatus(task), TWAsyncTaskStatusCompleted);
+        ++*static_cast<std::atomic<int>*>(context);
+    };
+    auto* task = TWAsyncTaskHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("TREZOR").get(), callback, &calls);
+    ASSERT_EQ(TWAsyncTaskWait(task), TWAsyncTaskStatusCompleted);
+    EXPECT_FALSE(TWAsyncTaskCancel(task));
+
+    const auto wallet = WRAP(TWHDWallet, TWAsyncTaskTakeHDWallet(task));
+    ASSERT_NE(wallet, nullptr);
+    assertHexEqual(WRAPD(TWHDWalletSeed(wallet.get())), gSeedHex);
+    EXPECT_EQ(TWAsyncTaskTakeHDWallet(task), nullptr);
+    EXPECT_EQ(TWAsyncTaskGetData(task), nullptr);
+
+    TWAsyncTaskDelete(task);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+TEST(TWAsyncTask, InvalidMnemonicFails) {
+    auto* task = TWAsyncTaskHDWalletCreateWithMnemonic(STRING("THIS IS INVALID MNEMONIC").get(), STRING("").get(), nullptr, nullptr);
+    EXPECT_EQ(TWAsyncTaskWait(task), TWAsyncTaskStatusFailed);
+    EXPECT_EQ(TWAsyncTaskTakeHDWallet(task), nullptr);
+    TWAsyncTaskDelete(task);
+}
+
+TEST(TWAsyncTask, Cancel) {
+    auto* task = TWAsyncTaskHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get(), nullptr, nullptr);
+    const auto cancelled = TWAsyncTaskCancel(task);
+    const auto status = TWAsyncTaskWait(task);
+    if (cancelled) {
+        EXPECT_EQ(status, TWAsyncTaskStatusCancelled);
+        EXPECT_EQ(TWAsyncTaskTakeHDWallet(task), nullptr);
+    } else {
+        EXPECT_EQ(status, TWAsyncTaskStatusCompleted);
+    }
+    TWAsyncTaskDelete(task);
+}
+
+TEST(TWAsyncTask, DeleteFromCallback) {
+    std::atomic<bool> deleted{false};
+    const auto callback = [](TWAsyncTask* task, void* context) {
+        TWAsyncTaskDelete(task);
+        static_cast<std::atomic<bool>*>(context)->store(true);
+    };
+    TWAsyncTaskHDWalletCreateWithMnemonic(STRING(gMnemonic).get(), STRING("").get(), callback, &deleted);
+    while (!deleted.load()) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace TW::AsyncTask::tests
@@ -81,3 +81,37 @@ TEST(TWDataVector, Get) {
         EXPECT_EQ(readElem, nullptr);
     }
 }
+
+TEST(TWDataVector, Packed) {
+    const auto bytes = DATA("deadbeef0202");
+    const auto offsets = DATA("00000000" "04000000" "04000000" "06000000");
+    const auto vec = WRAP(TWDataVector, TWDataVectorCreateWithPacked(bytes.get(), offsets.get()));
+
+    ASSERT_TRUE(vec.get() != nullptr);
+    ASSERT_EQ(TWDataVectorSize(vec.get()), 3ul);
+    assertHexEqual(WRAPD(TWDataVectorGet(vec.get(), 0)), "deadbeef");
+    assertHexEqual(WRAPD(TWDataVectorGet(vec.get(), 1)), "");
+    assertHexEqual(WRAPD(TWDataVectorGet(vec.get(), 2)), "0202");
+
+    const auto elem = DATA("03");
+    TWDataVectorAdd(vec.get(), elem.get());
+    assertHexEqual(WRAPD(TWDataVectorPackedBytes(vec.get())), "deadbeef020203");
+    assertHexEqual(WRAPD(TWDataVectorPackedOffsets(vec.get())), "00000000040000000400000006000000" "07000000");
+
+    const auto empty = WRAP(TWDataVector, TWDataVectorCreate());
+    assertHexEqual(WRAPD(TWDataVectorPackedBytes(empty.get())), "");
+    assertHexEqual(WRAPD(TWDataVectorPackedOffsets(empty.get())), "00000000");
+}
+
+TEST(TWDataVector, PackedInvalid) {
+    const auto bytes = DATA("deadbeef");
+    // not ending at the size of the bytes
+    EXPECT_EQ(TWDataVectorCreateWithPacked(bytes.get(), DATA("0000000002000000").get()), nullptr);
+    // decreasing
+    EXPECT_EQ(TWDataVectorCreateWithPacked(bytes.get(), DATA("000000000300000001000000" "04000000").get()), nullptr);
+    // not starting at 0
+    EXPECT_EQ(TWDataVectorCreateWithPacked(bytes.get(), DATA("0100000004000000").get()), nullptr);
+    // no offsets, or not 4 bytes each
+    EXPECT_EQ(TWDataVectorCreateWithPacked(bytes.get(), DATA("").get()), nullptr);
+    EXPECT_EQ(TWDataVectorCreateWithPacked(bytes.get(), DATA("0000000004").get()), nullptr);
+}
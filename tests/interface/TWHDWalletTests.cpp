@@ -10,6 +10,7 @@
 
 #include <TrustWalletCore/TWHash.h>
 #include <TrustWalletCore/TWData.h>
+#include <TrustWalletCore/TWDataVector.h>
 #include <TrustWalletCore/TWHDWallet.h>
 #include <TrustWalletCore/TWMnemonic.h>
 #include <TrustWalletCore/TWPrivateKey.h>
@@ -173,6 +174,51 @@ TEST(HDWallet, DeriveAddressBitcoinDerivation) {
     }
 }
 
+TEST(HDWallet, DeriveAddresses) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(gWords.get(), gPassphrase.get()));
+
+    const auto check = [&wallet](TWCoinType coin, TWDerivation derivation, uint32_t account, uint32_t change, uint32_t start, uint32_t count) {
+        auto path = TW::derivationPath(coin, derivation);
+        for (auto threads : {1u, 3u}) {
+            auto addresses = WRAP(TWDataVector, TWHDWalletDeriveAddresses(wallet.get(), coin, derivation, account, change, start, count, threads));
+            ASSERT_EQ(TWDataVectorSize(addresses.get()), count);
+            for (auto i = 0u; i < count; ++i) {
+                path.indices[2].value = account;
+                path.indices[3].value = change;
+                path.indices[4].value = start + i;
+                auto key = WRAP(TWPrivateKey, TWHDWalletGetKey(wallet.get(), coin, STRING(path.string().c_str()).get()));
+                const auto expected = TW::deriveAddress(coin, key->impl, derivation);
+                auto address = WRAPD(TWDataVectorGet(addresses.get(), i));
+                const auto& bytes = *reinterpret_cast<const Data*>(address.get());
+                EXPECT_EQ(std::string(bytes.begin(), bytes.end()), expected);
+            }
+        }
+    };
+
+    {
+        auto addresses = WRAP(TWDataVector, TWHDWalletDeriveAddresses(wallet.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 1, 1));
+        auto address = WRAPD(TWDataVectorGet(addresses.get(), 0));
+        const auto& bytes = *reinterpret_cast<const Data*>(address.get());
+        EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85");
+    }
+    // public derivation
+    check(TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 8);
+    check(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy, 1, 1, 100, 4);
+    check(TWCoinTypeEthereum, TWDerivationDefault, 0, 0, 10, 8);
+    check(TWCoinTypeFilecoin, TWDerivationDefault, 0, 0, 0, 3);
+    check(TWCoinTypeNEO, TWDerivationDefault, 0, 0, 0, 3);
+    // hardened address level, private derivation
+    check(TWCoinTypeAptos, TWDerivationDefault, 0, 0, 0, 3);
+    // extra derivation steps
+    check(TWCoinTypeCardano, TWDerivationDefault, 0, 0, 0, 2);
+
+    // unsupported path layout (m/44'/501'/0'), out of range indices
+    auto empty = WRAP(TWDataVector, TWHDWalletDeriveAddresses(wallet.get(), TWCoinTypeSolana, TWDerivationDefault, 0, 0, 0, 2, 1));
+    EXPECT_EQ(TWDataVectorSize(empty.get()), 0ul);
+    empty = WRAP(TWDataVector, TWHDWalletDeriveAddresses(wallet.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0x7fffffff, 2, 1));
+    EXPECT_EQ(TWDataVectorSize(empty.get()), 0ul);
+}
+
 TEST(HDWallet, DeriveEthereum) {
     auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(gWords.get(), gPassphrase.get()));
     auto key = WRAP(TWPrivateKey, TWHDWalletGetKeyForCoin(wallet.get(), TWCoinTypeEthereum));
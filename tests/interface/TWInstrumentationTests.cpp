@@ -0,0 +1,139 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWInstrumentation.h>
+#include <TrustWalletCore/TWTransactionCompiler.h>
+
+#include "HexCoding.h"
+#include "Instrumentation.h"
+#include "proto/Ethereum.pb.h"
+#include "uint256.h"
+#include "TestUtilities.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace TW::InstrumentationTests {
+
+/// Collects the spans and counts one allocation per sample of the counter.
+struct Recorder {
+    std::vector<TWInstrumentationSpan> spans;
+    uint64_t allocations = 0;
+
+    static void record(const TWInstrumentationSpan* span, void* context) {
+        static_cast<Recorder*>(context)->spans.push_back(*span);
+    }
+    static uint64_t count(void* context) {
+        return ++static_cast<Recorder*>(context)->allocations;
+    }
+};
+
+/// Installs a recorder for the scope of a test.
+struct ScopedRecorder {
+    Recorder recorder;
+    ScopedRecorder() {
+        TWInstrumentationSetCallback(Recorder::record, &recorder);
+        TWInstrumentationSetAllocationCounter(Recorder::count, &recorder);
+    }
+    ~ScopedRecorder() {
+        TWInstrumentationSetCallback(nullptr, nullptr);
+        TWInstrumentationSetAllocationCounter(nullptr, nullptr);
+    }
+};
+
+Data ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return data(input.SerializeAsString());
+}
+
+TEST(TWInstrumentation, NestedOperationsAndPhases) {
+    ScopedRecorder scope;
+    {
+        Instrumentation::Operation outer(TWCoinTypeBitcoin, TWInstrumentationOperationPlan, 10);
+        {
+            Instrumentation::Phase parse(&TWInstrumentationSpan::parseNanos);
+        }
+        {
+            Instrumentation::Operation inner(TWCoinTypeEthereum, TWInstrumentationOperationSign, 20);
+            Instrumentation::Phase sign(&TWInstrumentationSpan::signNanos);
+            inner.setBytesOut(5);
+        }
+        outer.setBytesOut(30);
+    }
+    const auto& spans = scope.recorder.spans;
+    ASSERT_EQ(spans.size(), 2ul);
+    EXPECT_EQ(spans[0].coin, TWCoinTypeEthereum);
+    EXPECT_EQ(spans[0].operation, TWInstrumentationOperationSign);
+    EXPECT_EQ(spans[0].bytesIn, 20ul);
+    EXPECT_EQ(spans[0].bytesOut, 5ul);
+    EXPECT_EQ(spans[0].parseNanos, 0ul);
+    EXPECT_EQ(spans[0].allocations, 1ul);
+    EXPECT_EQ(spans[1].coin, TWCoinTypeBitcoin);
+    EXPECT_EQ(spans[1].operation, TWInstrumentationOperationPlan);
+    EXPECT_EQ(spans[1].bytesIn, 10ul);
+    EXPECT_EQ(spans[1].bytesOut, 30ul);
+    EXPECT_EQ(spans[1].signNanos, 0ul);
+    EXPECT_EQ(spans[1].allocations, 3ul);
+    EXPECT_GE(spans[1].totalNanos, spans[0].totalNanos + spans[1].parseNanos);
+    EXPECT_EQ(Instrumentation::currentSpan, nullptr);
+}
+
+TEST(TWInstrumentation, DisabledByDefault) {
+    Recorder recorder;
+    TWInstrumentationSetAllocationCounter(Recorder::count, &recorder);
+    {
+        Instrumentation::Operation operation(TWCoinTypeBitcoin, TWInstrumentationOperationSign, 10);
+        EXPECT_EQ(Instrumentation::currentSpan, nullptr);
+    }
+    TWInstrumentationSetAllocationCounter(nullptr, nullptr);
+    EXPECT_EQ(recorder.allocations, 0ul);
+}
+
+TEST(TWInstrumentation, AnySignerSign) {
+    const auto input = ethereumInput();
+    ScopedRecorder scope;
+    const auto output = WRAPD(TWAnySignerSign(WRAPD(TWDataCreateWithBytes(input.data(), input.size())).get(), TWCoinTypeEthereum));
+
+    const auto& spans = scope.recorder.spans;
+    ASSERT_EQ(spans.size(), 1ul);
+    const auto& span = spans[0];
+    EXPECT_EQ(span.coin, TWCoinTypeEthereum);
+    EXPECT_EQ(span.operation, TWInstrumentationOperationSign);
+    EXPECT_EQ(span.bytesIn, input.size());
+    EXPECT_EQ(span.bytesOut, TWDataSize(output.get()));
+    EXPECT_GT(span.signNanos, 0ul);
+    EXPECT_GE(span.totalNanos, span.parseNanos + span.signNanos + span.serializeNanos);
+    EXPECT_EQ(span.allocations, 1ul);
+}
+
+TEST(TWInstrumentation, PreImageHashes) {
+    const auto input = ethereumInput();
+    ScopedRecorder scope;
+    const auto output = WRAPD(TWTransactionCompilerPreImageHashes(TWCoinTypeEthereum, WRAPD(TWDataCreateWithBytes(input.data(), input.size())).get()));
+
+    const auto& spans = scope.recorder.spans;
+    ASSERT_EQ(spans.size(), 1ul);
+    EXPECT_EQ(spans[0].operation, TWInstrumentationOperationPreImageHashes);
+    EXPECT_EQ(spans[0].bytesOut, TWDataSize(output.get()));
+    EXPECT_GT(spans[0].signNanos, 0ul);
+}
+
+} // namespace TW::InstrumentationTests
@@ -0,0 +1,105 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWInstrumentation.h>
+#include <TrustWalletCore/TWMemoryStats.h>
+#include <TrustWalletCore/TWSigningCache.h>
+
+#include "Ethereum/ABI/FunctionCache.h"
+#include "HDNodeCache.h"
+#include "Instrumentation.h"
+#include "SigningCache.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::MemoryStatsTests {
+
+TEST(TWMemoryStats, SigningCache) {
+    TWSigningCacheConfigure(4, 0);
+    TWMemoryStatsFlush(TWMemoryCacheSigning);
+    const auto empty = TWMemoryStatsCache(TWMemoryCacheSigning);
+    EXPECT_EQ(empty.entries, 0ul);
+
+    const auto key = SigningCache::key(TWCoinTypeBitcoin, SigningCache::Operation::Sign, Data{1, 2, 3});
+    SigningCache::shared().insert(key, Data(1000));
+    const auto filled = TWMemoryStatsCache(TWMemoryCacheSigning);
+    EXPECT_EQ(filled.entries, 1ul);
+    EXPECT_GE(filled.bytes, empty.bytes + 1000);
+    EXPECT_GE(filled.peakBytes, filled.bytes);
+    EXPECT_GE(TWMemoryStatsTotalBytes(), filled.bytes);
+
+    TWMemoryStatsTrim(TWMemoryCacheSigning, 1);
+    EXPECT_EQ(TWMemoryStatsCache(TWMemoryCacheSigning).entries, 1ul);
+
+    TWMemoryStatsFlush(TWMemoryCacheSigning);
+    const auto flushed = TWMemoryStatsCache(TWMemoryCacheSigning);
+    EXPECT_EQ(flushed.entries, 0ul);
+    EXPECT_EQ(flushed.bytes, empty.bytes);
+    EXPECT_GE(flushed.peakBytes, filled.bytes);
+
+    TWMemoryStatsResetPeaks();
+    EXPECT_EQ(TWMemoryStatsCache(TWMemoryCacheSigning).peakBytes, flushed.bytes);
+    TWSigningCacheConfigure(0, 0);
+}
+
+TEST(TWMemoryStats, FunctionSelectorCache) {
+    Ethereum::ABI::functionSelector("memoryStats(address,uint256)");
+    const auto filled = TWMemoryStatsCache(TWMemoryCacheFunctionSelector);
+    EXPECT_GE(filled.entries, 1ul);
+    EXPECT_GT(filled.bytes, 0ul);
+
+    TWMemoryStatsFlush(TWMemoryCacheFunctionSelector);
+    const auto flushed = TWMemoryStatsCache(TWMemoryCacheFunctionSelector);
+    EXPECT_EQ(flushed.entries, 0ul);
+    EXPECT_EQ(flushed.bytes, 0ul);
+}
+
+TEST(TWMemoryStats, HDNodeCaches) {
+    const auto before = TWMemoryStatsCache(TWMemoryCacheHDNode);
+    {
+        HDNodeCache first(4);
+        HDNodeCache second(4);
+        const std::vector<uint32_t> indices{0x8000002c, 0x8000003c, 0x80000000, 0, 0};
+        for (std::size_t length = 1; length <= 3; ++length) {
+            first.insert(TWCurveSECP256k1, indices, length, HDNode{});
+        }
+        second.insert(TWCurveED25519, indices, 2, HDNode{});
+        const auto filled = TWMemoryStatsCache(TWMemoryCacheHDNode);
+        EXPECT_EQ(filled.entries, before.entries + 4);
+        EXPECT_GT(filled.bytes, before.bytes + 4 * sizeof(HDNode));
+
+        TWMemoryStatsTrim(TWMemoryCacheHDNode, 1);
+        EXPECT_EQ(first.size(), 1ul);
+        EXPECT_EQ(second.size(), 1ul);
+
+        TWMemoryStatsFlush(TWMemoryCacheHDNode);
+        EXPECT_EQ(first.size(), 0ul);
+        EXPECT_EQ(TWMemoryStatsCache(TWMemoryCacheHDNode).bytes, before.bytes);
+    }
+    EXPECT_EQ(TWMemoryStatsCache(TWMemoryCacheHDNode).entries, before.entries);
+}
+
+TEST(TWMemoryStats, OperationPeaks) {
+    TWMemoryStatsResetPeaks();
+    TWSigningCacheConfigure(4, 0);
+    const auto key = SigningCache::key(TWCoinTypeEthereum, SigningCache::Operation::Plan, Data{4, 5, 6});
+    SigningCache::shared().insert(key, Data(500));
+    const auto total = TWMemoryStatsTotalBytes();
+
+    // sampled only while the instrumentation is enabled
+    { Instrumentation::Operation operation(TWCoinTypeEthereum, TWInstrumentationOperationPlan, 0); }
+    EXPECT_LT(TWMemoryStatsOperationPeakBytes(TWInstrumentationOperationPlan), total);
+
+    TWInstrumentationSetCallback([](const TWInstrumentationSpan*, void*) {}, nullptr);
+    { Instrumentation::Operation operation(TWCoinTypeEthereum, TWInstrumentationOperationPlan, 0); }
+    TWInstrumentationSetCallback(nullptr, nullptr);
+    EXPECT_EQ(TWMemoryStatsOperationPeakBytes(TWInstrumentationOperationPlan), total);
+
+    TWSigningCacheConfigure(0, 0);
+    EXPECT_EQ(TWMemoryStatsOperationPeakBytes(TWInstrumentationOperationPlan), total);
+}
+
+} // namespace TW::MemoryStatsTests
@@ -35,7 +35,7 @@ TEST(TWPublicKeyTests, CreateFromPrivateSecp256k1) {
     auto publicKeyData = WRAPD(TWPublicKeyData(publicKey.get()));
     EXPECT_EQ(hex(*((Data*)(publicKeyData.get()))), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
     EXPECT_EQ(*((std::string*)(WRAPS(TWPublicKeyDescription(publicKey.get())).get())), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
     EXPECT_TRUE(TWPublicKeyIsCompressed(publicKey.get()));
 }
 
@@ -51,20 +51,20 @@ TEST(TWPublicKeyTests, CompressedExtended) {
     EXPECT_EQ(TWPublicKeyKeyType(publicKey.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(publicKey.get()->impl.bytes.size(), 33ul);
     EXPECT_EQ(TWPublicKeyIsCompressed(publicKey.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
 
     auto extended = WRAP(TWPublicKey, TWPublicKeyUncompressed(publicKey.get()));
     EXPECT_EQ(TWPublicKeyKeyType(extended.get()), TWPublicKeyTypeSECP256k1Extended);
     EXPECT_EQ(extended.get()->impl.bytes.size(), 65ul);
     EXPECT_EQ(TWPublicKeyIsCompressed(extended.get()), false);
-    EXPECT_TRUE(TWPublicKeyIsValid(extended.get(), TWPublicKeyTypeSECP256k1Extended));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(extended.get())).get(), TWPublicKeyTypeSECP256k1Extended));
 
     auto compressed = WRAP(TWPublicKey, TWPublicKeyCompressed(extended.get()));
     //EXPECT_TRUE(compressed == publicKey.get());
     EXPECT_EQ(TWPublicKeyKeyType(compressed.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(compressed.get()->impl.bytes.size(), 33ul);
     EXPECT_EQ(TWPublicKeyIsCompressed(compressed.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(compressed.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(compressed.get())).get(), TWPublicKeyTypeSECP256k1));
 }
 
 TEST(TWPublicKeyTests, Verify) {
@@ -116,6 +116,36 @@ TEST(TWPublicKeyTests, VerifyEd25519) {
     ASSERT_TRUE(TWPublicKeyVerify(publicKey2.get(), signature2.get(), digest.get()));
 }
 
+TEST(TWPublicKeyTests, VerifyBatch) {
+    const PrivateKey key(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto digest = TW::Hash::sha256(TW::data("Hello"));
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+    const Data publicKeyData(publicKey.bytes.begin(), publicKey.bytes.end());
+    const auto signature = key.sign(digest, TWCurveED25519);
+
+    const auto publicKeys = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto signatures = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto messages = WRAP(TWDataVector, TWDataVectorCreate());
+    auto add = [&](const Data& pk, const Data& sig, const Data& msg) {
+        TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(pk.data(), pk.size())).get());
+        TWDataVectorAdd(signatures.get(), WRAPD(TWDataCreateWithBytes(sig.data(), sig.size())).get());
+        TWDataVectorAdd(messages.get(), WRAPD(TWDataCreateWithBytes(msg.data(), msg.size())).get());
+    };
+    add(publicKeyData, signature, digest);
+    add(publicKeyData, signature, TW::data("Hello"));
+    add(Data(5), signature, digest);
+    add(publicKeyData, signature, digest);
+
+    for (const auto threads : {1u, 2u}) {
+        const auto valid = WRAPD(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeED25519, signatures.get(), messages.get(), threads));
+        assertHexEqual(valid, "01000001");
+    }
+    EXPECT_EQ(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeSECP256k1, signatures.get(), messages.get(), 1), nullptr);
+    add(publicKeyData, signature, digest);
+    TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(publicKeyData.data(), publicKeyData.size())).get());
+    EXPECT_EQ(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeED25519, signatures.get(), messages.get(), 1), nullptr);
+}
+
 TEST(TWPublicKeyTests, Recover) {
     const auto message = DATA("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
     const auto signature = DATA("00000000000000000000000000000000000000000000000000000000000000020123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef80");
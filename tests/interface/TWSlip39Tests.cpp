@@ -0,0 +1,34 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TestUtilities.h"
+
+#include <TrustWalletCore/TWHDWallet.h>
+#include <TrustWalletCore/TWSlip39.h>
+
+TEST(TWSlip39, GenerateWithWalletRecover) {
+    const auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(STRING("credit expect life fade cover suit response wash pear what skull force").get(), STRING("").get()));
+    const auto groups = DATA("0203");
+    const auto shares = WRAPS(TWSlip39GenerateWithWallet(wallet.get(), 1, groups.get(), STRING("").get()));
+    ASSERT_NE(shares.get(), nullptr);
+
+    const auto secret = WRAPD(TWSlip39Recover(shares.get(), STRING("").get()));
+    ASSERT_NE(secret.get(), nullptr);
+    EXPECT_TRUE(TWDataEqual(secret.get(), WRAPD(TWHDWalletEntropy(wallet.get())).get()));
+    // three pairs of members, then the single group
+    EXPECT_EQ(TWSlip39VerifyCombinations(shares.get()), 4ul);
+
+    const auto text = std::string(TWStringUTF8Bytes(shares.get()));
+    const auto firstShare = text.substr(0, text.find('\n'));
+    EXPECT_TRUE(TWSlip39IsValidShare(STRING(firstShare.c_str()).get()));
+    EXPECT_EQ(TWSlip39Recover(STRING(firstShare.c_str()).get(), STRING("").get()), nullptr);
+}
+
+TEST(TWSlip39, GenerateInvalid) {
+    const auto secret = DATA("0102030405060708090a0b0c0d0e0f10");
+    EXPECT_EQ(TWSlip39Generate(secret.get(), 1, DATA("0102").get(), STRING("").get()), nullptr);
+    EXPECT_EQ(TWSlip39Generate(secret.get(), 1, DATA("02").get(), STRING("").get()), nullptr);
+}
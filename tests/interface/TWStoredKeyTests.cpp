@@ -11,6 +11,7 @@
 #include <TrustWalletCore/TWPrivateKey.h>
 #include <TrustWalletCore/TWStoredKey.h>
 #include <TrustWalletCore/TWData.h>
+#include <TrustWalletCore/TWDataVector.h>
 #include "../src/HexCoding.h"
 
 #include <gtest/gtest.h>
@@ -362,3 +363,69 @@ TEST(TWStoredKey, encryptionParameters) {
         }        
     )");
 }
+
+TEST(TWStoredKey, updateEncryptionParameters) {
+    const auto passwordString = WRAPS(TWStringCreateWithUTF8Bytes("password"));
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(passwordString.get())), TWStringSize(passwordString.get())));
+    const auto key = createDefaultStoredKey();
+
+    const auto tuned = WRAPS(TWStoredKeyTuneEncryptionParameters(TWStoredKeyEncryptionLevelMinimal, TWStoredKeyEncryptionAes256Ctr));
+    const auto tunedJson = nlohmann::json::parse(string(TWStringUTF8Bytes(tuned.get())));
+    EXPECT_EQ(tunedJson["cipher"], "aes-256-ctr");
+    EXPECT_EQ(tunedJson["kdf"], "scrypt");
+    EXPECT_GE(tunedJson["kdfparams"]["n"], 4096);
+
+    EXPECT_TRUE(TWStoredKeyUpdateEncryptionParameters(key.get(), password.get(), tuned.get()));
+    const auto params = WRAPS(TWStoredKeyEncryptionParameters(key.get()));
+    const auto jsonParams = nlohmann::json::parse(string(TWStringUTF8Bytes(params.get())));
+    EXPECT_EQ(jsonParams["cipher"], "aes-256-ctr");
+    EXPECT_EQ(jsonParams["kdfparams"]["n"], tunedJson["kdfparams"]["n"]);
+    EXPECT_NE(jsonParams["kdfparams"]["salt"], tunedJson["kdfparams"]["salt"]);
+    EXPECT_NE(WRAPS(TWStoredKeyDecryptMnemonic(key.get(), password.get())).get(), nullptr);
+
+    const auto wrongString = WRAPS(TWStringCreateWithUTF8Bytes("wrong"));
+    const auto wrong = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(wrongString.get())), TWStringSize(wrongString.get())));
+    EXPECT_FALSE(TWStoredKeyUpdateEncryptionParameters(key.get(), wrong.get(), tuned.get()));
+    const auto invalid = WRAPS(TWStringCreateWithUTF8Bytes("{"));
+    EXPECT_FALSE(TWStoredKeyUpdateEncryptionParameters(key.get(), password.get(), invalid.get()));
+}
+
+TEST(TWStoredKey, importAndDecryptBatch) {
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>("password"), 8));
+    const std::string mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+    const std::string invalid = "_THIS_IS_AN_INVALID_MNEMONIC_";
+    const std::string name = "name";
+
+    const auto mnemonics = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto names = WRAP(TWDataVector, TWDataVectorCreate());
+    for (const auto& each : {mnemonic, invalid}) {
+        const auto data = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(each.data()), each.size()));
+        TWDataVectorAdd(mnemonics.get(), data.get());
+        const auto nameData = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(name.data()), name.size()));
+        TWDataVectorAdd(names.get(), nameData.get());
+    }
+
+    const auto jsons = WRAP(TWDataVector, TWStoredKeyImportHDWalletBatch(mnemonics.get(), names.get(), password.get(), TWCoinTypeBitcoin, TWStoredKeyEncryptionAes128Ctr, 0));
+    ASSERT_EQ(TWDataVectorSize(jsons.get()), 2ul);
+    const auto json = WRAPD(TWDataVectorGet(jsons.get(), 0));
+    const auto key = WRAP(TWStoredKey, TWStoredKeyImportJSON(json.get()));
+    ASSERT_NE(key.get(), nullptr);
+    const auto account = WRAP(TWAccount, TWStoredKeyAccount(key.get(), 0));
+    assertStringsEqual(WRAPS(TWAccountAddress(account.get())), "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(TWDataSize(WRAPD(TWDataVectorGet(jsons.get(), 1)).get()), 0ul);
+
+    const auto secrets = WRAP(TWDataVector, TWStoredKeyDecryptJSONBatch(jsons.get(), password.get(), 0));
+    ASSERT_EQ(TWDataVectorSize(secrets.get()), 2ul);
+    const auto secret = WRAPD(TWDataVectorGet(secrets.get(), 0));
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(TWDataBytes(secret.get())), TWDataSize(secret.get())), mnemonic);
+    EXPECT_EQ(TWDataSize(WRAPD(TWDataVectorGet(secrets.get(), 1)).get()), 0ul);
+
+    const auto wrong = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>("wrong"), 5));
+    const auto failed = WRAP(TWDataVector, TWStoredKeyDecryptJSONBatch(jsons.get(), wrong.get(), 1));
+    EXPECT_EQ(TWDataSize(WRAPD(TWDataVectorGet(failed.get(), 0)).get()), 0ul);
+
+    const auto noNames = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto none = WRAP(TWDataVector, TWStoredKeyImportHDWalletBatch(mnemonics.get(), noNames.get(), password.get(), TWCoinTypeBitcoin, TWStoredKeyEncryptionAes128Ctr, 0));
+    ASSERT_EQ(TWDataVectorSize(none.get()), 2ul);
+    EXPECT_EQ(TWDataSize(WRAPD(TWDataVectorGet(none.get(), 0)).get()), 0ul);
+}
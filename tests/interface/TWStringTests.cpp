@@ -5,6 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TestUtilities.h"
+#include "interface/TWString+Constant.h"
+
+#include <TrustWalletCore/TWCoinTypeConfiguration.h>
 
 #include <gtest/gtest.h>
 
@@ -21,3 +24,25 @@ TEST(StringTests, HexNumber) {
     auto string = WRAPS(TWStringCreateWithHexData(data.get()));
     ASSERT_STREQ(TWStringUTF8Bytes(string.get()), "deadbeef");
 }
+
+TEST(StringTests, ConstantIsInterned) {
+    static const char* symbol = "BTC";
+    auto* first = TWStringCreateWithConstant(symbol);
+    auto* second = TWStringCreateWithConstant(symbol);
+    EXPECT_EQ(first, second);
+    TWStringDelete(first);
+    // still alive after delete
+    ASSERT_STREQ(TWStringUTF8Bytes(second), "BTC");
+    TWStringDelete(second);
+
+    const auto coinSymbol = WRAPS(TWCoinTypeConfigurationGetSymbol(TWCoinTypeBitcoin));
+    assertStringsEqual(coinSymbol, "BTC");
+}
+
+TEST(StringTests, RecycledStringIsReset) {
+    auto* address = TWStringCreateWithUTF8Bytes("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4");
+    TWStringDelete(address);
+    const auto next = WRAPS(TWStringCreateWithUTF8Bytes("ab"));
+    EXPECT_EQ(TWStringSize(next.get()), 2ul);
+    assertStringsEqual(next, "ab");
+}
@@ -0,0 +1,219 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Framing.h"
+#include "Server.h"
+
+#include "HexCoding.h"
+#include "Keystore/StoredKey.h"
+#include "proto/Ethereum.pb.h"
+#include "uint256.h"
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace TW::Signerd::tests {
+
+const auto gMnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const auto gPassword = "password";
+
+std::string keystoreJson() {
+    const auto key = Keystore::StoredKey::createWithMnemonic("name", data(gPassword), gMnemonic, TWStoredKeyEncryptionLevelMinimal);
+    return key.json().dump();
+}
+
+std::string ethereumTransfer(uint64_t nonce) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonceData = store(uint256_t(nonce));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonceData.data(), nonceData.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return input.SerializeAsString();
+}
+
+TEST(Signerd, Framing) {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    const std::string message(70000, 'x');
+    ASSERT_TRUE(writeFrame(fds[0], message));
+    ASSERT_TRUE(writeFrame(fds[0], ""));
+    ASSERT_TRUE(writeFrame(fds[0], message));
+
+    std::string read;
+    ASSERT_TRUE(readFrame(fds[1], read, message.size()));
+    EXPECT_EQ(read, message);
+    ASSERT_TRUE(readFrame(fds[1], read, message.size()));
+    EXPECT_EQ(read, "");
+    // Too large
+    EXPECT_FALSE(readFrame(fds[1], read, message.size() - 1));
+
+    close(fds[0]);
+    EXPECT_FALSE(readFrame(fds[1], read, message.size()));
+    close(fds[1]);
+}
+
+TEST(Signerd, SignCoalesced) {
+    Options options;
+    options.maxBatch = 4;
+    options.batchWindow = std::chrono::milliseconds(50);
+    options.threads = 2;
+    Server server(options);
+
+    std::vector<std::future<Proto::Response>> responses;
+    for (uint64_t i = 0; i < 10; ++i) {
+        responses.push_back(std::async(std::launch::async, [&server, i] {
+            Proto::Request request;
+            request.set_id(i);
+            request.mutable_sign()->set_coin(TWCoinTypeEthereum);
+            request.mutable_sign()->set_input(ethereumTransfer(i));
+            return server.handle(request);
+        }));
+    }
+    std::vector<std::string> outputs;
+    for (uint64_t i = 0; i < responses.size(); ++i) {
+        const auto response = responses[i].get();
+        outputs.push_back(response.output());
+        EXPECT_EQ(response.id(), i);
+        EXPECT_EQ(response.error(), "");
+        Ethereum::Proto::SigningOutput output;
+        ASSERT_TRUE(output.ParseFromString(response.output()));
+        EXPECT_FALSE(output.encoded().empty());
+    }
+
+    // The same output as signed on its own
+    options.batchWindow = std::chrono::microseconds(0);
+    Proto::Request request;
+    request.mutable_sign()->set_coin(TWCoinTypeEthereum);
+    request.mutable_sign()->set_input(ethereumTransfer(9));
+    EXPECT_EQ(Server(options).handle(request).output(), outputs[9]);
+
+    Proto::Request metrics;
+    metrics.mutable_metrics();
+    const auto text = server.handle(metrics).text();
+    EXPECT_NE(text.find("walletcore_signerd_request_duration_seconds_count{coin=\"ethereum\",operation=\"sign\"} 10"), std::string::npos);
+}
+
+TEST(Signerd, Sessions) {
+    Server server(Options{});
+
+    Proto::Request unlock;
+    unlock.mutable_unlock()->set_keystore_json(keystoreJson());
+    unlock.mutable_unlock()->set_password("wrong");
+    EXPECT_NE(server.handle(unlock).error(), "");
+
+    unlock.mutable_unlock()->set_password(gPassword);
+    const auto session = server.handle(unlock).session();
+    ASSERT_FALSE(session.empty());
+    EXPECT_EQ(server.sessions().size(), 1ul);
+
+    Proto::Request derive;
+    derive.mutable_derive_address()->set_session(session);
+    derive.mutable_derive_address()->set_coin(TWCoinTypeEthereum);
+    const auto expected = HDWallet<>(gMnemonic, "").deriveAddress(TWCoinTypeEthereum);
+    EXPECT_EQ(server.handle(derive).text(), expected);
+
+    Proto::Request signHashes;
+    signHashes.mutable_sign_hashes()->set_session(session);
+    signHashes.mutable_sign_hashes()->set_coin(TWCoinTypeEthereum);
+    signHashes.mutable_sign_hashes()->set_derivation_path("m/44'/60'/0'/0/0");
+    const auto hash = parse_hex("0x4646464646464646464646464646464646464646464646464646464646464646");
+    signHashes.mutable_sign_hashes()->add_hashes(std::string(hash.begin(), hash.end()));
+    const auto signature = server.handle(signHashes);
+    EXPECT_EQ(signature.error(), "");
+    ASSERT_EQ(signature.outputs_size(), 1);
+    EXPECT_EQ(signature.outputs(0).size(), 65ul);
+    EXPECT_EQ(signature.output().size(), 65ul);
+
+    Proto::Request lock;
+    lock.mutable_lock()->set_session(session);
+    EXPECT_EQ(server.handle(lock).error(), "");
+    EXPECT_EQ(server.sessions().size(), 0ul);
+    EXPECT_NE(server.handle(derive).error(), "");
+}
+
+TEST(Signerd, Errors) {
+    Server server(Options{});
+    Proto::Request request;
+    request.set_id(7);
+    EXPECT_EQ(server.handle(request).error(), "Missing operation");
+
+    request.mutable_sign()->set_coin(0xffffffff);
+    const auto response = server.handle(request);
+    EXPECT_EQ(response.id(), 7ul);
+    EXPECT_EQ(response.error(), "Unsupported coin");
+}
+
+TEST(Signerd, DefaultSocketPath) {
+    const char* runtimeDir = getenv("XDG_RUNTIME_DIR");
+    const std::string saved = runtimeDir != nullptr ? runtimeDir : "";
+    setenv("XDG_RUNTIME_DIR", "/run/user/1000", 1);
+    EXPECT_EQ(defaultSocketPath(), "/run/user/1000/walletcore-signerd.sock");
+    unsetenv("XDG_RUNTIME_DIR");
+    EXPECT_EQ(defaultSocketPath(), "/tmp/walletcore-signerd.sock");
+    if (runtimeDir != nullptr) {
+        setenv("XDG_RUNTIME_DIR", saved.c_str(), 1);
+    }
+}
+
+TEST(Signerd, Socket) {
+    Options options;
+    options.socketPath = "/tmp/walletcore-signerd-tests-" + std::to_string(getpid()) + ".sock";
+    Server server(options);
+    std::thread listener([&server] { server.listen(); });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    for (int attempt = 0; connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 && attempt < 100; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    struct stat status {};
+    ASSERT_EQ(stat(options.socketPath.c_str(), &status), 0);
+    EXPECT_EQ(status.st_mode & 0777, static_cast<mode_t>(0600));
+
+    Proto::Request request;
+    request.set_id(3);
+    request.mutable_sign()->set_coin(TWCoinTypeEthereum);
+    request.mutable_sign()->set_input(ethereumTransfer(0));
+    ASSERT_TRUE(writeFrame(fd, request.SerializeAsString()));
+    ASSERT_TRUE(writeFrame(fd, "invalid"));
+
+    std::string frame;
+    Proto::Response response;
+    ASSERT_TRUE(readFrame(fd, frame, options.maxMessageSize));
+    ASSERT_TRUE(response.ParseFromString(frame));
+    EXPECT_EQ(response.id(), 3ul);
+    EXPECT_EQ(response.error(), "");
+    ASSERT_TRUE(readFrame(fd, frame, options.maxMessageSize));
+    ASSERT_TRUE(response.ParseFromString(frame));
+    EXPECT_EQ(response.error(), "Invalid request");
+
+    server.stop();
+    listener.join();
+    EXPECT_FALSE(readFrame(fd, frame, options.maxMessageSize));
+    close(fd);
+}
+
+} // namespace TW::Signerd::tests
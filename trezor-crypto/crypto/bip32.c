@@ -376,90 +376,118 @@ void hdnode_public_ckd_address_optimized(const curve_point *pub,
   }
 }
 
-#if USE_BIP32_CACHE
-bool private_ckd_cache_root_set = false;
-CONFIDENTIAL HDNode private_ckd_cache_root;
-int private_ckd_cache_index = 0;
+// [wallet-core] The parent nodes are cached in caller-owned caches, which may
+// hold nodes derived from several roots, instead of a single global cache.
+
+static bool same_root(const HDNode *a, const HDNode *b) {
+  return a->depth == b->depth && a->child_num == b->child_num &&
+         a->curve == b->curve &&
+         memcmp(a->chain_code, b->chain_code, sizeof(a->chain_code)) == 0 &&
+         memcmp(a->private_key, b->private_key, sizeof(a->private_key)) == 0 &&
+         memcmp(a->private_key_extension, b->private_key_extension,
+                sizeof(a->private_key_extension)) == 0;
+}
 
-CONFIDENTIAL struct {
-  bool set;
-  size_t depth;
-  uint32_t i[BIP32_CACHE_MAXDEPTH];
-  HDNode node;
-} private_ckd_cache[BIP32_CACHE_SIZE];
+void bip32_cache_init(bip32_cache *cache, size_t capacity) {
+  memzero(cache, sizeof(bip32_cache));
+  cache->capacity = capacity < BIP32_CACHE_SIZE ? capacity : BIP32_CACHE_SIZE;
+}
 
-void bip32_cache_clear(void) {
-  private_ckd_cache_root_set = false;
-  private_ckd_cache_index = 0;
-  memzero(&private_ckd_cache_root, sizeof(private_ckd_cache_root));
-  memzero(private_ckd_cache, sizeof(private_ckd_cache));
+void bip32_cache_wipe(bip32_cache *cache) {
+  bip32_cache_init(cache, cache->capacity);
 }
 
-int hdnode_private_ckd_cached(HDNode *inout, const uint32_t *i, size_t i_count,
-                              uint32_t *fingerprint) {
+int hdnode_private_ckd_with_cache(bip32_cache *cache, HDNode *inout,
+                                  const uint32_t *i, size_t i_count,
+                                  uint32_t *fingerprint) {
   if (i_count == 0) {
     // no way how to compute parent fingerprint
     return 1;
   }
-  if (i_count == 1) {
+  const size_t depth = i_count - 1;
+  if (cache == NULL || cache->capacity == 0 || depth == 0 ||
+      depth > BIP32_CACHE_MAXDEPTH) {
+    for (size_t k = 0; k < depth; k++) {
+      if (hdnode_private_ckd(inout, i[k]) == 0) return 0;
+    }
     if (fingerprint) {
       *fingerprint = hdnode_fingerprint(inout);
     }
-    if (hdnode_private_ckd(inout, i[0]) == 0) return 0;
+    if (hdnode_private_ckd(inout, i[depth]) == 0) return 0;
     return 1;
   }
 
+  // try to find the parent, derived from the same root
   bool found = false;
-  // if root is not set or not the same
-  if (!private_ckd_cache_root_set ||
-      memcmp(&private_ckd_cache_root, inout, sizeof(HDNode)) != 0) {
-    // clear the cache
-    private_ckd_cache_index = 0;
-    memzero(private_ckd_cache, sizeof(private_ckd_cache));
-    // setup new root
-    memcpy(&private_ckd_cache_root, inout, sizeof(HDNode));
-    private_ckd_cache_root_set = true;
-  } else {
-    // try to find parent
-    int j = 0;
-    for (j = 0; j < BIP32_CACHE_SIZE; j++) {
-      if (private_ckd_cache[j].set &&
-          private_ckd_cache[j].depth == i_count - 1 &&
-          memcmp(private_ckd_cache[j].i, i, (i_count - 1) * sizeof(uint32_t)) ==
-              0 &&
-          private_ckd_cache[j].node.curve == inout->curve) {
-        memcpy(inout, &(private_ckd_cache[j].node), sizeof(HDNode));
-        found = true;
-        break;
-      }
+  for (size_t j = 0; j < cache->capacity; j++) {
+    bip32_cache_entry *entry = &cache->entries[j];
+    if (entry->set && entry->depth == depth &&
+        memcmp(entry->i, i, depth * sizeof(uint32_t)) == 0 &&
+        same_root(&entry->root, inout)) {
+      memcpy(inout, &entry->node, sizeof(HDNode));
+      found = true;
+      break;
     }
   }
 
   // else derive parent
   if (!found) {
-    size_t k = 0;
-    for (k = 0; k < i_count - 1; k++) {
-      if (hdnode_private_ckd(inout, i[k]) == 0) return 0;
+    bip32_cache_entry *entry = &cache->entries[cache->index];
+    memzero(entry, sizeof(bip32_cache_entry));
+    memcpy(&entry->root, inout, sizeof(HDNode));
+    for (size_t k = 0; k < depth; k++) {
+      if (hdnode_private_ckd(inout, i[k]) == 0) {
+        memzero(entry, sizeof(bip32_cache_entry));
+        return 0;
+      }
     }
     // and save it
-    memzero(&(private_ckd_cache[private_ckd_cache_index]),
-            sizeof(private_ckd_cache[private_ckd_cache_index]));
-    private_ckd_cache[private_ckd_cache_index].set = true;
-    private_ckd_cache[private_ckd_cache_index].depth = i_count - 1;
-    memcpy(private_ckd_cache[private_ckd_cache_index].i, i,
-           (i_count - 1) * sizeof(uint32_t));
-    memcpy(&(private_ckd_cache[private_ckd_cache_index].node), inout,
-           sizeof(HDNode));
-    private_ckd_cache_index = (private_ckd_cache_index + 1) % BIP32_CACHE_SIZE;
+    entry->set = true;
+    entry->depth = depth;
+    memcpy(entry->i, i, depth * sizeof(uint32_t));
+    memcpy(&entry->node, inout, sizeof(HDNode));
+    cache->index = (cache->index + 1) % cache->capacity;
   }
 
   if (fingerprint) {
     *fingerprint = hdnode_fingerprint(inout);
   }
-  if (hdnode_private_ckd(inout, i[i_count - 1]) == 0) return 0;
+  if (hdnode_private_ckd(inout, i[depth]) == 0) return 0;
 
   return 1;
 }
+
+#if USE_BIP32_CACHE
+// The default cache of hdnode_private_ckd_cached is thread-local, and is not
+// wiped when the thread exits.
+#if defined(_MSC_VER)
+#define BIP32_THREAD_LOCAL __declspec(thread)
+#else
+#define BIP32_THREAD_LOCAL _Thread_local
+#endif
+
+static BIP32_THREAD_LOCAL bool thread_cache_initialized = false;
+static BIP32_THREAD_LOCAL CONFIDENTIAL bip32_cache thread_cache;
+
+static bip32_cache *get_thread_cache(void) {
+  if (!thread_cache_initialized) {
+    bip32_cache_init(&thread_cache, BIP32_CACHE_SIZE);
+    thread_cache_initialized = true;
+  }
+  return &thread_cache;
+}
+
+void bip32_cache_clear(void) { bip32_cache_wipe(get_thread_cache()); }
+
+void bip32_cache_set_capacity(size_t capacity) {
+  bip32_cache_init(get_thread_cache(), capacity);
+}
+
+int hdnode_private_ckd_cached(HDNode *inout, const uint32_t *i, size_t i_count,
+                              uint32_t *fingerprint) {
+  return hdnode_private_ckd_with_cache(get_thread_cache(), inout, i, i_count,
+                                       fingerprint);
+}
 #endif
 
 int hdnode_get_address_raw(HDNode *node, uint32_t version, uint8_t *addr_raw) {
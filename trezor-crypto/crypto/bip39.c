@@ -252,6 +252,32 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
 #endif
 }
 
+// [wallet-core]
+void mnemonic_to_seed_lanes(const char *const mnemonics[],
+                            const char *const passphrases[],
+                            uint8_t *const seeds[], int count) {
+  CONFIDENTIAL PBKDF2_HMAC_SHA512_CTX pctx[SHA512_LANES];
+  PBKDF2_HMAC_SHA512_CTX *lanes[SHA512_LANES] = {0};
+  uint8_t salt[8 + 256] = {0};
+
+  if (count > SHA512_LANES) {
+    count = SHA512_LANES;
+  }
+  memcpy(salt, "mnemonic", 8);
+  for (int l = 0; l < count; l++) {
+    int passphraselen = strnlen(passphrases[l], 256);
+    memcpy(salt + 8, passphrases[l], passphraselen);
+    pbkdf2_hmac_sha512_Init(&pctx[l], (const uint8_t *)mnemonics[l],
+                            strlen(mnemonics[l]), salt, passphraselen + 8, 1);
+    lanes[l] = &pctx[l];
+  }
+  pbkdf2_hmac_sha512_Update_lanes(lanes, count, BIP39_PBKDF2_ROUNDS);
+  for (int l = 0; l < count; l++) {
+    pbkdf2_hmac_sha512_Final(&pctx[l], seeds[l]);
+  }
+  memzero(salt, sizeof(salt));
+}
+
 // binary search for finding the word in the wordlist
 int mnemonic_find_word(const char *word) {
   int lo = 0, hi = BIP39_WORD_COUNT - 1;
@@ -1075,6 +1075,417 @@ int ecdsa_recover_pub_from_sig(const ecdsa_curve *curve, uint8_t *pub_key,
   return 0;
 }
 
+// Number of points brought to affine coordinates together by the batch
+// functions below; bounds the stack usage.
+#define BATCH_SIZE 16
+
+static void jacobian_from_affine(const curve_point *p,
+                                 jacobian_curve_point *jp) {
+  jp->x = p->x;
+  jp->y = p->y;
+  bn_one(&jp->z);
+}
+
+// Replaces x[i] by 1/x[i] mod prime for every i with active[i], using a
+// single modular inversion (Montgomery's trick). The x[i] must be nonzero.
+static void batch_inverse(bignum256 *x, bignum256 *scratch,
+                          const uint8_t *active, size_t count,
+                          const bignum256 *prime) {
+  bignum256 acc = {0}, inv = {0};
+  size_t i = 0;
+
+  bn_one(&acc);
+  for (i = 0; i < count; i++) {
+    if (!active[i]) continue;
+    // scratch[i] = x[0] * ... * x[i-1]
+    scratch[i] = acc;
+    bn_multiply(&x[i], &acc, prime);
+  }
+  bn_mod(&acc, prime);
+  bn_inverse(&acc, prime);
+  for (i = count; i-- > 0;) {
+    if (!active[i]) continue;
+    // acc = 1 / (x[0] * ... * x[i])
+    inv = scratch[i];
+    bn_multiply(&acc, &inv, prime);
+    bn_multiply(&x[i], &acc, prime);
+    bn_mod(&inv, prime);
+    x[i] = inv;
+  }
+}
+
+// p = jp for a jacobian point whose z coordinate has been inverted to zinv.
+static void jacobian_to_curve_inverted(const jacobian_curve_point *jp,
+                                       const bignum256 *zinv, curve_point *p,
+                                       const bignum256 *prime) {
+  p->x = *zinv;
+  bn_multiply(&p->x, &p->x, prime);
+  p->y = p->x;
+  bn_multiply(zinv, &p->y, prime);
+  bn_multiply(&jp->x, &p->x, prime);
+  bn_multiply(&jp->y, &p->y, prime);
+  bn_mod(&p->x, prime);
+  bn_mod(&p->y, prime);
+}
+
+// res = k * p for 0 < k < order, using a non-adjacent form.
+// Variable time: only for public k and p.
+static void point_multiply_vartime(const ecdsa_curve *curve,
+                                   const bignum256 *k, const curve_point *p,
+                                   jacobian_curve_point *res) {
+  int8_t naf[257] = {0};
+  int i = 0, top = 0;
+  uint32_t carry = 0;
+  curve_point neg = *p;
+
+  for (i = 0; i < 257; i++) {
+    uint32_t value = (i < 256 ? bn_testbit(k, i) : 0) + carry;
+    if (value == 1) {
+      uint32_t next = i < 255 ? bn_testbit(k, i + 1) : 0;
+      naf[i] = next ? -1 : 1;
+      carry = next;
+    } else {
+      naf[i] = 0;
+      carry = value >> 1;
+    }
+    if (naf[i] != 0) top = i;
+  }
+  bn_subtract(&curve->prime, &p->y, &neg.y);
+
+  // the most significant digit of a non-adjacent form is always 1
+  jacobian_from_affine(p, res);
+  for (i = top - 1; i >= 0; i--) {
+    point_jacobian_double(res, curve);
+    if (naf[i] > 0) {
+      point_jacobian_add(p, res, curve);
+    } else if (naf[i] < 0) {
+      point_jacobian_add(&neg, res, curve);
+    }
+  }
+}
+
+// res = k * G for 0 < k < order, with the signed odd digit recoding of
+// scalar_multiply applied to windows of window_bits bits, which must divide
+// 256. table[i * 2^(window_bits - 1) + j] = (2j + 1) * 2^(window_bits * i) * G,
+// so curve->cp is the table for 4-bit windows. The z coordinate of the result
+// is randomized if randomize is set; the result stays in jacobian coordinates.
+static void scalar_multiply_table(const ecdsa_curve *curve,
+                                  const curve_point *table, int window_bits,
+                                  const bignum256 *k, int randomize,
+                                  jacobian_curve_point *res) {
+  const uint32_t digit_mask = (1u << window_bits) - 1;
+  const size_t entries = (size_t)1 << (window_bits - 1);
+  const int windows = 256 / window_bits;
+  int i = 0, j = 0;
+  CONFIDENTIAL bignum256 a = {0};
+  uint32_t is_even = (k->val[0] & 1) - 1;
+  uint32_t lowbits = 0;
+  const bignum256 *prime = &curve->prime;
+
+  // a = k + 2^256 (mod order), made odd; see scalar_multiply
+  uint32_t tmp = 1;
+  for (j = 0; j < 8; j++) {
+    tmp += (BN_BASE - 1) + k->val[j] - (curve->order.val[j] & is_even);
+    a.val[j] = tmp & (BN_BASE - 1);
+    tmp >>= BN_BITS_PER_LIMB;
+  }
+  a.val[j] = tmp + 0xffffff + k->val[j] - (curve->order.val[j] & is_even);
+
+  lowbits = a.val[0] & ((digit_mask << 1) | 1);
+  lowbits ^= (lowbits >> window_bits) - 1;
+  lowbits &= digit_mask;
+  if (randomize) {
+    curve_to_jacobian(&table[lowbits >> 1], res, prime);
+  } else {
+    jacobian_from_affine(&table[lowbits >> 1], res);
+  }
+  for (i = 1; i < windows; i++) {
+    for (j = 0; j < 8; j++) {
+      a.val[j] = (a.val[j] >> window_bits) |
+                 ((a.val[j + 1] & digit_mask)
+                  << (BN_BITS_PER_LIMB - window_bits));
+    }
+    a.val[j] >>= window_bits;
+
+    lowbits = a.val[0] & ((digit_mask << 1) | 1);
+    lowbits ^= (lowbits >> window_bits) - 1;
+    lowbits &= digit_mask;
+    bn_cnegate(~lowbits & 1, &res->y, prime);
+    point_jacobian_add(&table[i * entries + (lowbits >> 1)], res, curve);
+  }
+  bn_cnegate(~(a.val[0] >> window_bits) & 1, &res->y, prime);
+  memzero(&a, sizeof(a));
+}
+
+// res = k * G for 0 < k < order, like scalar_multiply but without the
+// randomization and the final conversion to affine coordinates.
+static void scalar_multiply_jacobian(const ecdsa_curve *curve,
+                                     const bignum256 *k,
+                                     jacobian_curve_point *res) {
+#if USE_PRECOMPUTED_CP
+  scalar_multiply_table(curve, &curve->cp[0][0], 4, k, 0, res);
+#else
+  point_multiply_vartime(curve, k, &curve->G, res);
+#endif
+}
+
+static void recover_pub_from_sig_chunk(const ecdsa_curve *curve,
+                                       uint8_t *pub_keys, const uint8_t *sigs,
+                                       const uint8_t *digests,
+                                       const uint8_t *recids, int *results,
+                                       size_t count) {
+  curve_point rp[BATCH_SIZE];
+  bignum256 rinv[BATCH_SIZE], u1[BATCH_SIZE],
+      u2[BATCH_SIZE], z[BATCH_SIZE],
+      scratch[BATCH_SIZE];
+  jacobian_curve_point acc[BATCH_SIZE], accg[BATCH_SIZE];
+  uint8_t active[BATCH_SIZE] = {0}, with_g[BATCH_SIZE] = {0};
+  const bignum256 *order = &curve->order;
+  const bignum256 *prime = &curve->prime;
+  curve_point p = {0};
+  size_t i = 0;
+
+  for (i = 0; i < count; i++) {
+    results[i] = 1;
+    // same checks as ecdsa_recover_pub_from_sig
+    bn_read_be(sigs + 64 * i, &rinv[i]);
+    bn_read_be(sigs + 64 * i + 32, &u2[i]);
+    if (!bn_is_less(&rinv[i], order) || bn_is_zero(&rinv[i])) continue;
+    if (!bn_is_less(&u2[i], order) || bn_is_zero(&u2[i])) continue;
+    rp[i].x = rinv[i];
+    if (recids[i] & 2) {
+      bn_add(&rp[i].x, order);
+      if (!bn_is_less(&rp[i].x, prime)) continue;
+    }
+    uncompress_coords(curve, recids[i] & 1, &rp[i].x, &rp[i].y);
+    if (!ecdsa_validate_pubkey(curve, &rp[i])) continue;
+    // u1 = -digest
+    bn_read_be(digests + 32 * i, &u1[i]);
+    bn_mod(&u1[i], order);
+    bn_subtract(order, &u1[i], &u1[i]);
+    bn_mod(&u1[i], order);
+    active[i] = 1;
+  }
+
+  batch_inverse(rinv, scratch, active, count, order);
+
+  for (i = 0; i < count; i++) {
+    if (!active[i]) continue;
+    // u1 = -digest * r^-1, u2 = s * r^-1
+    bn_multiply(&rinv[i], &u1[i], order);
+    bn_mod(&u1[i], order);
+    bn_multiply(&rinv[i], &u2[i], order);
+    bn_mod(&u2[i], order);
+    // acc = u2 * R, accg = u1 * G
+    point_multiply_vartime(curve, &u2[i], &rp[i], &acc[i]);
+    if (!bn_is_zero(&u1[i])) {
+      scalar_multiply_jacobian(curve, &u1[i], &accg[i]);
+      z[i] = accg[i].z;
+      bn_mod(&z[i], prime);
+      with_g[i] = 1;
+    }
+  }
+
+  // bring the u1 * G terms to affine coordinates and add them
+  batch_inverse(z, scratch, with_g, count, prime);
+  for (i = 0; i < count; i++) {
+    if (!with_g[i]) continue;
+    jacobian_to_curve_inverted(&accg[i], &z[i], &p, prime);
+    point_jacobian_add(&p, &acc[i], curve);
+  }
+
+  for (i = 0; i < count; i++) {
+    if (!active[i]) continue;
+    z[i] = acc[i].z;
+    bn_mod(&z[i], prime);
+    // The point at infinity is not considered to be a valid public key.
+    if (bn_is_zero(&z[i])) active[i] = 0;
+  }
+  batch_inverse(z, scratch, active, count, prime);
+  for (i = 0; i < count; i++) {
+    if (!active[i]) continue;
+    jacobian_to_curve_inverted(&acc[i], &z[i], &p, prime);
+    pub_keys[65 * i] = 0x04;
+    bn_write_be(&p.x, pub_keys + 65 * i + 1);
+    bn_write_be(&p.y, pub_keys + 65 * i + 33);
+    results[i] = 0;
+  }
+}
+
+// Recovers the public keys of count signatures, like
+// ecdsa_recover_pub_from_sig applied to every (sig, digest, recid).
+// pub_keys receives 65 bytes per signature, sigs holds 64 bytes and digests
+// 32 bytes per signature; results[i] is 0 if the i-th key was recovered.
+// Modular inversions are shared across the batch and the point
+// multiplications run in variable time, as signatures and digests are public.
+// returns 0 if all keys were recovered
+int ecdsa_recover_pub_from_sig_batch(const ecdsa_curve *curve,
+                                     uint8_t *pub_keys, const uint8_t *sigs,
+                                     const uint8_t *digests,
+                                     const uint8_t *recids, int *results,
+                                     size_t count) {
+  size_t offset = 0, i = 0;
+  int failed = 0;
+
+  while (offset < count) {
+    size_t chunk = count - offset;
+    if (chunk > BATCH_SIZE) chunk = BATCH_SIZE;
+    recover_pub_from_sig_chunk(curve, pub_keys + 65 * offset,
+                               sigs + 64 * offset, digests + 32 * offset,
+                               recids + offset, results + offset, chunk);
+    offset += chunk;
+  }
+  for (i = 0; i < count; i++) {
+    failed |= results[i];
+  }
+  return failed;
+}
+
+// Number of points in a table of generator multiples for windows of
+// window_bits bits, or 0 if window_bits is not supported.
+size_t ecdsa_base_table_size(int window_bits) {
+  if (window_bits < 1 || window_bits > 8 || 256 % window_bits != 0) {
+    return 0;
+  }
+  return (size_t)(256 / window_bits) << (window_bits - 1);
+}
+
+// Fills table with the odd multiples of the generator used by
+// ecdsa_get_public_keys65, see scalar_multiply_table.
+// table must hold ecdsa_base_table_size(window_bits) points.
+// returns 0 on success
+int ecdsa_base_table_fill(const ecdsa_curve *curve, int window_bits,
+                          curve_point *table) {
+  jacobian_curve_point multiples[BATCH_SIZE];
+  bignum256 z[BATCH_SIZE], scratch[BATCH_SIZE];
+  uint8_t active[BATCH_SIZE];
+  const bignum256 *prime = &curve->prime;
+  curve_point base = curve->G, twice = {0};
+  jacobian_curve_point acc = {0};
+  size_t entries = 0, offset = 0, chunk = 0, j = 0;
+  int i = 0, windows = 0;
+
+  if (ecdsa_base_table_size(window_bits) == 0) {
+    return 1;
+  }
+  entries = (size_t)1 << (window_bits - 1);
+  windows = 256 / window_bits;
+  memset(active, 1, sizeof(active));
+
+  for (i = 0; i < windows; i++) {
+    curve_point *row = table + i * entries;
+    // row[j] = (2j + 1) * base, with base = 2^(window_bits * i) * G
+    twice = base;
+    point_double(curve, &twice);
+    jacobian_from_affine(&base, &acc);
+    for (offset = 0; offset < entries; offset += chunk) {
+      chunk = entries - offset;
+      if (chunk > BATCH_SIZE) chunk = BATCH_SIZE;
+      for (j = 0; j < chunk; j++) {
+        if (offset + j > 0) {
+          point_jacobian_add(&twice, &acc, curve);
+        }
+        multiples[j] = acc;
+        z[j] = acc.z;
+        bn_mod(&z[j], prime);
+      }
+      batch_inverse(z, scratch, active, chunk, prime);
+      for (j = 0; j < chunk; j++) {
+        jacobian_to_curve_inverted(&multiples[j], &z[j], &row[offset + j],
+                                   prime);
+      }
+    }
+    for (j = 0; j < (size_t)window_bits; j++) {
+      point_double(curve, &base);
+    }
+  }
+  return 0;
+}
+
+static void get_public_keys65_chunk(const ecdsa_curve *curve,
+                                    const curve_point *table, int window_bits,
+                                    const uint8_t *priv_keys,
+                                    uint8_t *pub_keys, int *results,
+                                    size_t count) {
+  CONFIDENTIAL jacobian_curve_point res[BATCH_SIZE];
+  CONFIDENTIAL bignum256 k = {0};
+  bignum256 z[BATCH_SIZE], scratch[BATCH_SIZE];
+  uint8_t active[BATCH_SIZE] = {0};
+  const bignum256 *prime = &curve->prime;
+  curve_point p = {0};
+  size_t i = 0;
+
+  for (i = 0; i < count; i++) {
+    results[i] = -1;
+    bn_read_be(priv_keys + 32 * i, &k);
+    if (bn_is_zero(&k) || !bn_is_less(&k, &curve->order)) {
+      // Invalid private key.
+      memzero(pub_keys + 65 * i, 65);
+      continue;
+    }
+    scalar_multiply_table(curve, table, window_bits, &k, 1, &res[i]);
+    z[i] = res[i].z;
+    bn_mod(&z[i], prime);
+    active[i] = 1;
+  }
+  memzero(&k, sizeof(k));
+
+  batch_inverse(z, scratch, active, count, prime);
+  for (i = 0; i < count; i++) {
+    if (!active[i]) continue;
+    jacobian_to_curve_inverted(&res[i], &z[i], &p, prime);
+    pub_keys[65 * i] = 0x04;
+    bn_write_be(&p.x, pub_keys + 65 * i + 1);
+    bn_write_be(&p.y, pub_keys + 65 * i + 33);
+    results[i] = 0;
+  }
+  memzero(res, sizeof(res));
+  memzero(z, sizeof(z));
+  memzero(scratch, sizeof(scratch));
+}
+
+// Derives the uncompressed public keys of count private keys, like
+// ecdsa_get_public_key65 applied to every key, sharing the conversions to
+// affine coordinates across the batch. table is either NULL, to use the
+// built-in curve->cp, or filled by ecdsa_base_table_fill with window_bits.
+// priv_keys holds 32 bytes and pub_keys receives 65 bytes per key;
+// results[i] is 0 if the i-th key was derived and -1 if it is invalid.
+// returns 0 if all keys were derived
+int ecdsa_get_public_keys65(const ecdsa_curve *curve, const curve_point *table,
+                            int window_bits, const uint8_t *priv_keys,
+                            uint8_t *pub_keys, int *results, size_t count) {
+  size_t offset = 0, i = 0;
+  int failed = 0;
+
+  if (table == NULL) {
+#if USE_PRECOMPUTED_CP
+    table = &curve->cp[0][0];
+    window_bits = 4;
+#else
+    for (i = 0; i < count; i++) {
+      results[i] = ecdsa_get_public_key65(curve, priv_keys + 32 * i,
+                                          pub_keys + 65 * i);
+      failed |= results[i];
+    }
+    return failed;
+#endif
+  } else if (ecdsa_base_table_size(window_bits) == 0) {
+    return 1;
+  }
+
+  while (offset < count) {
+    size_t chunk = count - offset;
+    if (chunk > BATCH_SIZE) chunk = BATCH_SIZE;
+    get_public_keys65_chunk(curve, table, window_bits, priv_keys + 32 * offset,
+                            pub_keys + 65 * offset, results + offset, chunk);
+    offset += chunk;
+  }
+  for (i = 0; i < count; i++) {
+    failed |= results[i];
+  }
+  return failed;
+}
+
 // returns 0 if verification succeeded
 int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
                         const uint8_t *sig, const uint8_t *digest) {
@@ -204,6 +204,90 @@ ed25519_publickey_ext(const ed25519_secret_key extsk, ed25519_public_key pk) {
 	ge25519_pack(pk, &A);
 }
 
+/* Number of keys whose final inversion is shared by ed25519_publickey_ext_batch */
+#define ED25519_PUBLICKEY_BATCH 16
+
+/* ge25519_pack for a point whose z coordinate has been inverted to zi */
+static void
+ed25519_pack_inverted(ed25519_public_key pk, const ge25519 *p, const bignum25519 zi) {
+	bignum25519 tx = {0}, ty = {0};
+	unsigned char parity[32] = {0};
+	curve25519_mul(tx, p->x, zi);
+	curve25519_mul(ty, p->y, zi);
+	curve25519_contract(pk, ty);
+	curve25519_contract(parity, tx);
+	pk[31] ^= ((parity[0] & 1) << 7);
+}
+
+static void
+ed25519_publickey_ext_chunk(const ed25519_secret_key *extsks, ed25519_public_key *pks, size_t count) {
+	bignum256modm a = {0};
+	ge25519 ALIGN(16) A[ED25519_PUBLICKEY_BATCH];
+	bignum25519 prefix[ED25519_PUBLICKEY_BATCH];
+	bignum25519 inv = {0}, zi = {0};
+	size_t i = 0;
+
+	for (i = 0; i < count; i++) {
+		expand256_modm(a, extsks[i], 32);
+		ge25519_scalarmult_base_niels(&A[i], ge25519_niels_base_multiples, a);
+	}
+	memzero(&a, sizeof(a));
+
+	/* invert all z coordinates at once: prefix[i] = z[0] * ... * z[i] */
+	curve25519_copy(prefix[0], A[0].z);
+	for (i = 1; i < count; i++) {
+		curve25519_mul(prefix[i], prefix[i - 1], A[i].z);
+	}
+	curve25519_recip(inv, prefix[count - 1]);
+	for (i = count - 1; i > 0; i--) {
+		/* inv = 1 / (z[0] * ... * z[i]) */
+		curve25519_mul(zi, inv, prefix[i - 1]);
+		curve25519_mul(inv, inv, A[i].z);
+		ed25519_pack_inverted(pks[i], &A[i], zi);
+	}
+	ed25519_pack_inverted(pks[0], &A[0], inv);
+	memzero(A, sizeof(A));
+}
+
+/*
+	ed25519_publickey_ext for count keys, sharing the final inversion;
+	extsks holds the first half of every expanded secret key
+*/
+void
+ed25519_publickey_ext_batch(const ed25519_secret_key *extsks, ed25519_public_key *pks, size_t count) {
+	size_t offset = 0, chunk = 0;
+
+	for (offset = 0; offset < count; offset += chunk) {
+		chunk = count - offset;
+		if (chunk > ED25519_PUBLICKEY_BATCH) {
+			chunk = ED25519_PUBLICKEY_BATCH;
+		}
+		ed25519_publickey_ext_chunk(extsks + offset, pks + offset, chunk);
+	}
+}
+
+/* ed25519_publickey for count keys, sharing the final inversion */
+void
+ed25519_publickey_batch(const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count) {
+	hash_512bits extsk = {0};
+	ed25519_secret_key extsks[ED25519_PUBLICKEY_BATCH];
+	size_t offset = 0, chunk = 0, i = 0;
+
+	for (offset = 0; offset < count; offset += chunk) {
+		chunk = count - offset;
+		if (chunk > ED25519_PUBLICKEY_BATCH) {
+			chunk = ED25519_PUBLICKEY_BATCH;
+		}
+		for (i = 0; i < chunk; i++) {
+			ed25519_extsk(extsk, sks[offset + i]);
+			memcpy(extsks[i], extsk, 32);
+		}
+		ed25519_publickey_ext_chunk(extsks, pks + offset, chunk);
+	}
+	memzero(&extsk, sizeof(extsk));
+	memzero(extsks, sizeof(extsks));
+}
+
 int
 ed25519_cosi_combine_publickeys(ed25519_public_key res, CONST ed25519_public_key *pks, size_t n) {
 	size_t i = 0;
@@ -143,6 +143,56 @@ void pbkdf2_hmac_sha512_Update(PBKDF2_HMAC_SHA512_CTX *pctx,
   pctx->first = 0;
 }
 
+// [wallet-core]
+void pbkdf2_hmac_sha512_Update_lanes(PBKDF2_HMAC_SHA512_CTX *const pctx[],
+                                     int count, uint32_t iterations) {
+  const uint32_t words = SHA512_DIGEST_LENGTH / sizeof(uint64_t);
+  uint64_t odig[8][SHA512_LANES] = {0};
+  uint64_t idig[8][SHA512_LANES] = {0};
+  uint64_t f[8][SHA512_LANES] = {0};
+  uint64_t g[16][SHA512_LANES] = {0};
+
+  if (count <= 0) {
+    return;
+  }
+  if (count > SHA512_LANES) {
+    count = SHA512_LANES;
+  }
+  // lane-interleaved copies; unused lanes compute on zeros
+  for (int l = 0; l < count; l++) {
+    for (uint32_t k = 0; k < words; k++) {
+      odig[k][l] = pctx[l]->odig[k];
+      idig[k][l] = pctx[l]->idig[k];
+      f[k][l] = pctx[l]->f[k];
+    }
+    for (uint32_t k = 0; k < SHA512_BLOCK_LENGTH / sizeof(uint64_t); k++) {
+      g[k][l] = pctx[l]->g[k];
+    }
+  }
+
+  for (uint32_t i = pctx[0]->first; i < iterations; i++) {
+    sha512_Transform_lanes(idig, g, g);
+    sha512_Transform_lanes(odig, g, g);
+    for (uint32_t k = 0; k < words; k++) {
+      for (int l = 0; l < SHA512_LANES; l++) {
+        f[k][l] ^= g[k][l];
+      }
+    }
+  }
+
+  for (int l = 0; l < count; l++) {
+    for (uint32_t k = 0; k < words; k++) {
+      pctx[l]->f[k] = f[k][l];
+      pctx[l]->g[k] = g[k][l];
+    }
+    pctx[l]->first = 0;
+  }
+  memzero(odig, sizeof(odig));
+  memzero(idig, sizeof(idig));
+  memzero(f, sizeof(f));
+  memzero(g, sizeof(g));
+}
+
 void pbkdf2_hmac_sha512_Final(PBKDF2_HMAC_SHA512_CTX *pctx, uint8_t *key) {
 #if BYTE_ORDER == LITTLE_ENDIAN
   for (uint32_t k = 0; k < SHA512_DIGEST_LENGTH / sizeof(uint64_t); k++) {
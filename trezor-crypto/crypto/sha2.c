@@ -1153,6 +1153,83 @@ void sha512_Transform(const sha2_word64* state_in, const sha2_word64* data, sha2
 
 #endif /* SHA2_UNROLL_TRANSFORM */
 
+// [wallet-core]
+#if defined(__GNUC__) || defined(__clang__)
+
+/* One word of each lane; the compiler maps it onto the SIMD registers of the
+ * target (SSE2/AVX2, NEON, wasm SIMD), or onto scalar code. */
+typedef sha2_word64 sha2_lanes64 __attribute__((vector_size(8 * SHA512_LANES)));
+
+void sha512_Transform_lanes(const sha2_word64 state_in[8][SHA512_LANES], const sha2_word64 data[16][SHA512_LANES], sha2_word64 state_out[8][SHA512_LANES]) {
+	sha2_lanes64	state[8], W512[16];
+	sha2_lanes64	a, b, c, d, e, f, g, h, s0, s1, T1, T2;
+	int		j = 0;
+
+	/* data and state_out may be the same array, as in PBKDF2 */
+	memcpy(state, state_in, sizeof(state));
+	memcpy(W512, data, sizeof(W512));
+
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
+
+	for (j = 0; j < 80; j++) {
+		if (j >= 16) {
+			s0 = W512[(j+1)&0x0f];
+			s0 = sigma0_512(s0);
+			s1 = W512[(j+14)&0x0f];
+			s1 = sigma1_512(s1);
+			W512[j&0x0f] += s1 + W512[(j+9)&0x0f] + s0;
+		}
+		T1 = h + Sigma1_512(e) + Ch(e, f, g) + K512[j] + W512[j&0x0f];
+		T2 = Sigma0_512(a) + Maj(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + T1;
+		d = c;
+		c = b;
+		b = a;
+		a = T1 + T2;
+	}
+
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+	memcpy(state_out, state, sizeof(state));
+
+	memzero(W512, sizeof(W512));
+	memzero(state, sizeof(state));
+}
+
+#else
+
+void sha512_Transform_lanes(const sha2_word64 state_in[8][SHA512_LANES], const sha2_word64 data[16][SHA512_LANES], sha2_word64 state_out[8][SHA512_LANES]) {
+	sha2_word64	lane_state[8], lane_data[16];
+	int		i = 0, l = 0;
+
+	for (l = 0; l < SHA512_LANES; l++) {
+		for (i = 0; i < 8; i++) lane_state[i] = state_in[i][l];
+		for (i = 0; i < 16; i++) lane_data[i] = data[i][l];
+		sha512_Transform(lane_state, lane_data, lane_state);
+		for (i = 0; i < 8; i++) state_out[i][l] = lane_state[i];
+	}
+	memzero(lane_state, sizeof(lane_state));
+	memzero(lane_data, sizeof(lane_data));
+}
+
+#endif
+
 void sha512_Update(SHA512_CTX* context, const sha2_byte *data, size_t len) {
 	unsigned int	freespace = 0, usedspace = 0;
 
@@ -28,6 +28,14 @@
 #include <TrezorCrypto/memzero.h>
 
 int zil_schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *msg, const uint32_t msg_len, uint8_t *sig)
+{
+	uint8_t pub_key[33];
+	ecdsa_get_public_key33(curve, priv_key, pub_key);
+	return zil_schnorr_sign_with_public_key(curve, priv_key, pub_key, msg, msg_len, sig);
+}
+
+int zil_schnorr_sign_with_public_key(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *pub_key,
+                                     const uint8_t *msg, const uint32_t msg_len, uint8_t *sig)
 {
 	int i;
 	bignum256 k;
@@ -47,7 +55,7 @@ int zil_schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key, const ui
 		}
 
 		schnorr_sign_pair sign;
-		if (zil_schnorr_sign_k(curve, priv_key, &k, msg, msg_len, &sign) != 0) {
+		if (zil_schnorr_sign_k_with_public_key(curve, priv_key, pub_key, &k, msg, msg_len, &sign) != 0) {
 			continue;
 		}
 
@@ -91,6 +99,14 @@ int zil_schnorr_sign_k(const ecdsa_curve *curve, const uint8_t *priv_key,
                  const bignum256 *k, const uint8_t *msg, const uint32_t msg_len,
                  schnorr_sign_pair *result) {
   uint8_t pub_key[33];
+  ecdsa_get_public_key33(curve, priv_key, pub_key);
+  return zil_schnorr_sign_k_with_public_key(curve, priv_key, pub_key, k, msg, msg_len, result);
+}
+
+// Returns 0 if signing succeeded
+int zil_schnorr_sign_k_with_public_key(const ecdsa_curve *curve, const uint8_t *priv_key,
+                 const uint8_t *pub_key, const bignum256 *k, const uint8_t *msg,
+                 const uint32_t msg_len, schnorr_sign_pair *result) {
   curve_point Q;
   bignum256 private_key_scalar;
   bignum256 r_temp;
@@ -98,7 +114,6 @@ int zil_schnorr_sign_k(const ecdsa_curve *curve, const uint8_t *priv_key,
   bignum256 r_kpriv_result;
 
   bn_read_be(priv_key, &private_key_scalar);
-  ecdsa_get_public_key33(curve, priv_key, pub_key);
 
   // Compute commitment Q = kG
   point_multiply(curve, k, &curve->G, &Q);
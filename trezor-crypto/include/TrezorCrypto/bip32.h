@@ -92,8 +92,40 @@ void hdnode_public_ckd_address_optimized(const curve_point *pub,
                                          HasherType hasher_base58, char *addr,
                                          int addrsize, int addrformat);
 
+// [wallet-core] Cache of parent nodes for hdnode_private_ckd_with_cache, keyed
+// by root node and path. Not synchronized: use one cache per thread, or guard
+// it. Holds private keys, wipe it with bip32_cache_wipe before releasing it.
+typedef struct {
+  bool set;
+  size_t depth;
+  uint32_t i[BIP32_CACHE_MAXDEPTH];
+  HDNode root;
+  HDNode node;
+} bip32_cache_entry;
+
+typedef struct {
+  size_t capacity;
+  size_t index;
+  bip32_cache_entry entries[BIP32_CACHE_SIZE];
+} bip32_cache;
+
+// Empties the cache and sets how many parent nodes it holds, at most
+// BIP32_CACHE_SIZE; 0 disables it.
+void bip32_cache_init(bip32_cache *cache, size_t capacity);
+// Wipes all cached nodes, keeping the capacity.
+void bip32_cache_wipe(bip32_cache *cache);
+// Derives `inout` along path `i`, taking the parent node (the first
+// `i_count - 1` indices) from `cache` if derived before from the same root.
+int hdnode_private_ckd_with_cache(bip32_cache *cache, HDNode *inout,
+                                  const uint32_t *i, size_t i_count,
+                                  uint32_t *fingerprint);
+
 #if USE_BIP32_CACHE
+// Same with the cache of the calling thread, BIP32_CACHE_SIZE nodes unless
+// set with bip32_cache_set_capacity. The cache is not wiped when the thread
+// exits: call bip32_cache_clear before, or use a caller-owned cache.
 void bip32_cache_clear(void);
+void bip32_cache_set_capacity(size_t capacity);
 int hdnode_private_ckd_cached(HDNode *inout, const uint32_t *i, size_t i_count,
                               uint32_t *fingerprint);
 #endif
@@ -59,6 +59,13 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
                       void (*progress_callback)(uint32_t current,
                                                 uint32_t total));
 
+// [wallet-core]
+// Computes up to SHA512_LANES seeds at once, like mnemonic_to_seed without
+// the cache and progress callback.
+void mnemonic_to_seed_lanes(const char *const mnemonics[],
+                            const char *const passphrases[],
+                            uint8_t *const seeds[], int count);
+
 int mnemonic_find_word(const char *word);
 const char *mnemonic_complete_word(const char *prefix, int len);
 const char *mnemonic_get_word(int index);
@@ -23,6 +23,10 @@
 #include <TrezorCrypto/chacha20poly1305/chacha20poly1305.h>
 #include <TrezorCrypto/sha2.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // A very fast deterministic random bit generator based on CTR_DRBG in NIST SP
 // 800-90A. Chacha is used instead of a block cipher in the counter mode, SHA256
 // is used as a derivation function. The highest supported security strength is
@@ -51,4 +55,9 @@ void chacha_drbg_generate(CHACHA_DRBG_CTX *ctx, uint8_t *output,
 void chacha_drbg_reseed(CHACHA_DRBG_CTX *ctx, const uint8_t *entropy,
                         size_t entropy_length, const uint8_t *additional_input,
                         size_t additional_input_length);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif  // __CHACHA_DRBG__
@@ -97,6 +97,12 @@ int ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key,
                            uint8_t *pub_key);
 int ecdsa_get_public_key65(const ecdsa_curve *curve, const uint8_t *priv_key,
                            uint8_t *pub_key);
+size_t ecdsa_base_table_size(int window_bits);
+int ecdsa_base_table_fill(const ecdsa_curve *curve, int window_bits,
+                          curve_point *table);
+int ecdsa_get_public_keys65(const ecdsa_curve *curve, const curve_point *table,
+                            int window_bits, const uint8_t *priv_keys,
+                            uint8_t *pub_keys, int *results, size_t count);
 void ecdsa_get_pubkeyhash(const uint8_t *pub_key, HasherType hasher_pubkey,
                           uint8_t *pubkeyhash);
 void ecdsa_get_address_raw(const uint8_t *pub_key, uint32_t version,
@@ -127,6 +133,11 @@ int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
 int ecdsa_recover_pub_from_sig(const ecdsa_curve *curve, uint8_t *pub_key,
                                const uint8_t *sig, const uint8_t *digest,
                                int recid);
+int ecdsa_recover_pub_from_sig_batch(const ecdsa_curve *curve,
+                                     uint8_t *pub_keys, const uint8_t *sigs,
+                                     const uint8_t *digests,
+                                     const uint8_t *recids, int *results,
+                                     size_t count);
 int ecdsa_sig_to_der(const uint8_t *sig, uint8_t *der);
 int ecdsa_sig_from_der(const uint8_t *der, size_t der_len, uint8_t sig[64]);
 
@@ -17,6 +17,8 @@ typedef unsigned char ed25519_cosi_signature[32];
 
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
 void ed25519_publickey_ext(const ed25519_secret_key extsk, ed25519_public_key pk);
+void ed25519_publickey_batch(const ed25519_secret_key *sks, ed25519_public_key *pks, size_t count);
+void ed25519_publickey_ext_batch(const ed25519_secret_key *extsks, ed25519_public_key *pks, size_t count);
 
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, ed25519_signature RS);
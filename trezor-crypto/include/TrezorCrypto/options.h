@@ -54,7 +54,13 @@
 // implement BIP32 caching
 #ifndef USE_BIP32_CACHE
 #define USE_BIP32_CACHE 0 // [wallet-core]
+#endif
+
+// [wallet-core] size of the caller-owned caches, available whatever USE_BIP32_CACHE
+#ifndef BIP32_CACHE_SIZE
 #define BIP32_CACHE_SIZE 10
+#endif
+#ifndef BIP32_CACHE_MAXDEPTH
 #define BIP32_CACHE_MAXDEPTH 8
 #endif
 
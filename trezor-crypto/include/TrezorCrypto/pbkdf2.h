@@ -63,6 +63,11 @@ void pbkdf2_hmac_sha512_Init(PBKDF2_HMAC_SHA512_CTX *pctx, const uint8_t *pass,
 void pbkdf2_hmac_sha512_Update(PBKDF2_HMAC_SHA512_CTX *pctx,
                                uint32_t iterations);
 void pbkdf2_hmac_sha512_Final(PBKDF2_HMAC_SHA512_CTX *pctx, uint8_t *key);
+// [wallet-core]
+// Runs pbkdf2_hmac_sha512_Update on up to SHA512_LANES contexts at once.
+// The contexts must be at the same iteration, e.g. all just initialized.
+void pbkdf2_hmac_sha512_Update_lanes(PBKDF2_HMAC_SHA512_CTX *const pctx[],
+                                     int count, uint32_t iterations);
 void pbkdf2_hmac_sha512(const uint8_t *pass, int passlen, const uint8_t *salt,
                         int saltlen, uint32_t iterations, uint8_t *key,
                         int keylen);
@@ -47,6 +47,8 @@ extern "C" {
 #define SHA512_BLOCK_LENGTH		128
 #define SHA512_DIGEST_LENGTH		64
 #define SHA512_DIGEST_STRING_LENGTH	(SHA512_DIGEST_LENGTH * 2 + 1)
+// [wallet-core] number of messages hashed at once by sha512_Transform_lanes
+#define SHA512_LANES			4
 
 typedef struct _SHA1_CTX {
 	uint32_t	state[5];
@@ -110,6 +112,9 @@ void sha256_Raw(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
 char* sha256_Data(const uint8_t*, size_t, char[SHA256_DIGEST_STRING_LENGTH]);
 
 void sha512_Transform(const uint64_t* state_in, const uint64_t* data, uint64_t* state_out);
+// [wallet-core]
+// Runs SHA512_LANES independent sha512_Transform at once; word i of lane l is at [i][l].
+void sha512_Transform_lanes(const uint64_t state_in[8][SHA512_LANES], const uint64_t data[16][SHA512_LANES], uint64_t state_out[8][SHA512_LANES]);
 void sha512_Init(SHA512_CTX*);
 void sha512_Update(SHA512_CTX*, const uint8_t*, size_t);
 void sha512_Final(SHA512_CTX*, uint8_t[SHA512_DIGEST_LENGTH]);
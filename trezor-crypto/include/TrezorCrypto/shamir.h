@@ -34,6 +34,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define SHAMIR_MAX_LEN 32
 
 /*
@@ -67,4 +71,8 @@ bool shamir_interpolate(uint8_t *result, uint8_t result_index,
                         const uint8_t **share_values, uint8_t share_count,
                         size_t len);
 
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif /* __SHAMIR_H__ */
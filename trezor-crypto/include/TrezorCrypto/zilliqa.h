@@ -40,6 +40,9 @@ typedef struct {
 
 int zil_schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key, 
                 const uint8_t *msg, const uint32_t msg_len, uint8_t *sig);
+// pub_key is the 33 bytes compressed public key of priv_key, saves deriving it on each signature
+int zil_schnorr_sign_with_public_key(const ecdsa_curve *curve, const uint8_t *priv_key,
+                const uint8_t *pub_key, const uint8_t *msg, const uint32_t msg_len, uint8_t *sig);
 int zil_schnorr_verify(const ecdsa_curve *curve, const uint8_t *pub_key, 
                 const uint8_t *sig, const uint8_t *msg, const uint32_t msg_len);
 
@@ -47,6 +50,9 @@ int zil_schnorr_verify(const ecdsa_curve *curve, const uint8_t *pub_key,
 int zil_schnorr_sign_k(const ecdsa_curve *curve, const uint8_t *priv_key,
                  const bignum256 *k, const uint8_t *msg, const uint32_t msg_len,
                  schnorr_sign_pair *result);
+int zil_schnorr_sign_k_with_public_key(const ecdsa_curve *curve, const uint8_t *priv_key,
+                 const uint8_t *pub_key, const bignum256 *k, const uint8_t *msg,
+                 const uint32_t msg_len, schnorr_sign_pair *result);
 int zil_schnorr_verify_pair(const ecdsa_curve *curve, const uint8_t *pub_key,
                    const uint8_t *msg, const uint32_t msg_len,
                    const schnorr_sign_pair *sign);
@@ -69,7 +69,7 @@ bool Address::addrDefault(const string& coinid, string& res) {
     Coin coin;
     if (!_coins.findCoin(coinid, coin)) { return false; }
     auto ctype = (TWCoinType)coin.c;
-    string mnemo = _keys.getMnemo();
+    const auto& mnemo = _keys.getMnemo();
     assert(mnemo.length() > 0); // a mnemonic is always set
     HDWallet wallet(mnemo, "");
 
@@ -86,7 +86,7 @@ bool Address::deriveFromPath(const string& coinid, const string& derivPath, stri
 
     DerivationPath dp(derivPath);
     // get the private key
-    string mnemo = _keys.getMnemo();
+    const auto& mnemo = _keys.getMnemo();
     assert(mnemo.length() > 0); // a mnemonic is always set
     HDWallet wallet(mnemo, "");
     PrivateKey priKey = wallet.getKey(ctype, dp);
@@ -0,0 +1,139 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BatchRunner.h"
+#include "WalletConsole.h"
+#include "Util.h"
+
+#include "algorithm/parallel.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <iomanip>
+
+namespace TW::WalletConsole {
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+static double millisSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+BatchRunner::BatchRunner(ostream& out, size_t threads)
+    : _out(out), _threads(threads), _executor(out) {
+}
+
+void BatchRunner::init() {
+    _executor.init();
+}
+
+string BatchRunner::commandLine(const string& line) {
+    string trimmed = line;
+    Util::trimLeft(trimmed);
+    if (trimmed.length() == 0 || trimmed[0] != '{') {
+        return trimmed;
+    }
+    const auto json = nlohmann::json::parse(trimmed, nullptr, false);
+    if (json.is_discarded() || !json.contains("cmd") || !json["cmd"].is_string()) {
+        return "";
+    }
+    string command = json["cmd"].get<string>();
+    if (json.contains("params")) {
+        for (const auto& param : json["params"]) {
+            command += " " + (param.is_string() ? param.get<string>() : param.dump());
+        }
+    }
+    return command;
+}
+
+size_t BatchRunner::run(istream& in) {
+    const auto start = Clock::now();
+    size_t count = 0;
+    vector<string> pending;
+    string line;
+    while (getline(in, line)) {
+        auto command = commandLine(line);
+        if (command.length() == 0) {
+            if (line.find_first_not_of(" \t\r") != string::npos) {
+                _out << "Invalid line: " << line << endl;
+            }
+            continue;
+        }
+        if (WalletConsole::isExit(command)) {
+            break;
+        }
+        ++count;
+        if (CommandExecutor::isStateless(command)) {
+            pending.push_back(command);
+            continue;
+        }
+        runParallel(pending);
+        pending.clear();
+        runSequential(command);
+    }
+    runParallel(pending);
+
+    const auto millis = millisSince(start);
+    _out << "Executed " << count << " commands in " << fixed << setprecision(3) << millis << " ms";
+    if (millis > 0) {
+        _out << " (" << setprecision(1) << count * 1000 / millis << " commands/s)";
+    }
+    _out << endl;
+    return count;
+}
+
+void BatchRunner::runSequential(const string& line) {
+    _out << "> " << line << endl;
+    const auto start = Clock::now();
+    _executor.executeLine(line);
+    _out << "Time:  " << fixed << setprecision(3) << millisSince(start) << " ms" << endl;
+}
+
+void BatchRunner::runParallel(const vector<string>& lines) {
+    if (lines.empty()) {
+        return;
+    }
+    const auto workerCount = parallelWorkerCount(lines.size(), _threads);
+    while (_workers.size() < workerCount) {
+        auto worker = make_unique<Worker>();
+        worker->executor.init();
+        _workers.push_back(move(worker));
+    }
+    for (size_t w = 0; w < workerCount; ++w) {
+        _workers[w]->executor.copyState(_executor);
+        _workers[w]->out.str("");
+    }
+
+    // worker w takes lines w, w + workerCount, ...
+    vector<Output> outputs(lines.size());
+    parallelFor(workerCount, workerCount, [&](size_t w) {
+        auto& worker = *_workers[w];
+        for (size_t i = w; i < lines.size(); i += workerCount) {
+            auto& output = outputs[i];
+            const auto start = Clock::now();
+            output.hasResult = worker.executor.executeLine(lines[i], output.result);
+            output.millis = millisSince(start);
+            output.text = worker.out.str();
+            worker.out.str("");
+        }
+    });
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        printCommand(lines[i], outputs[i]);
+    }
+}
+
+void BatchRunner::printCommand(const string& line, const Output& output) {
+    _out << "> " << line << endl << output.text;
+    if (output.hasResult) {
+        _executor.addResult(output.result);
+    }
+    _out << "Time:  " << fixed << setprecision(3) << output.millis << " ms" << endl;
+}
+
+} // namespace TW::WalletConsole
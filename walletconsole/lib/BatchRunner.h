@@ -0,0 +1,62 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "CommandExecutor.h"
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TW::WalletConsole {
+
+using namespace std;
+
+/// Non-interactive mode: runs a script of commands, one per line, either in console syntax
+/// or as JSON lines of the form {"cmd": "addrPri", "params": ["<priKey>"]}.
+/// Consecutive stateless commands (derivation, addresses, encoding, see CommandExecutor::isStateless)
+/// run in parallel on worker executors; outputs are printed in script order, each with its execution time.
+/// Commands changing the state (coin, setMnemonic, ...) or using previous results (#) run in order.
+class BatchRunner {
+protected:
+    struct Worker {
+        ostringstream out;
+        CommandExecutor executor;
+        Worker() : executor(out) {}
+    };
+
+    struct Output {
+        string text;
+        string result;
+        bool hasResult = false;
+        double millis = 0;
+    };
+
+    ostream& _out;
+    size_t _threads;
+    CommandExecutor _executor;
+    vector<unique_ptr<Worker>> _workers;
+
+public:
+    /// threads: number of parallel workers, 0 for the hardware concurrency
+    BatchRunner(ostream& out, size_t threads);
+    void init();
+    /// Run all commands of the script, until its end or an exit command. Return the number of executed commands.
+    size_t run(istream& in);
+    /// Convert a JSON line to a console command line, other lines are returned trimmed; empty if invalid.
+    static string commandLine(const string& line);
+
+protected:
+    void runSequential(const string& line);
+    void runParallel(const vector<string>& lines);
+    void printCommand(const string& line, const Output& output);
+};
+
+} // namespace TW::WalletConsole
@@ -15,6 +15,7 @@
 #include "HexCoding.h"
 #include "Data.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cassert>
@@ -153,20 +154,55 @@ void CommandExecutor::executeLine(const string& line) {
     execute(cmd, params);
 }
 
+bool CommandExecutor::executeLine(const string& line, string& result) {
+    vector<string> params;
+    auto cmd = parseLine(line, params);
+    try {
+        return executeOne(cmd, params, result) && result.length() > 0;
+    } catch (exception& ex) {
+        _out << "Error while executing command, " << ex.what() << endl;
+        return false;
+    }
+}
+
 void CommandExecutor::execute(const string& cmd, const vector<string>& params) {
     try {
         string resultStr;
         bool res = executeOne(cmd, params, resultStr);
         if (res && resultStr.length() > 0) {
             // there is a new result
-            _out << "Result:  " << resultStr << endl;
-            _buffer.addResult(resultStr);
+            addResult(resultStr);
         }
     } catch (exception& ex) {
         _out << "Error while executing command, " << ex.what() << endl;
     }
 }
 
+void CommandExecutor::addResult(const string& result) {
+    _out << "Result:  " << result << endl;
+    _buffer.addResult(result);
+}
+
+void CommandExecutor::copyState(const CommandExecutor& other) {
+    _activeCoin = other._activeCoin;
+    _keys.restoreMnemonic(other._keys.getMnemo());
+}
+
+bool CommandExecutor::isStateless(const string& line) {
+    static const vector<string> stateless = {
+        "newkey", "pubpri", "pripub", "dumpseed", "dumpmnemonic", "dumpdp", "dumpxpub", "pridp",
+        "addrpub", "addrpri", "addr", "addrdefault", "addrdp", "addrxpub",
+        "hex", "base64encode", "base64decode",
+    };
+    vector<string> params;
+    auto cmd = parseLine(line, params);
+    if (find(stateless.begin(), stateless.end(), cmd) == stateless.end()) {
+        return false;
+    }
+    // results of previous commands are only known in order
+    return none_of(params.begin() + 1, params.end(), [](const string& p) { return p.length() > 0 && p[0] == '#'; });
+}
+
 bool CommandExecutor::prepareInputs(const vector<string>& p_in, vector<string>& p_out) {
     p_out = vector<string>{};
     for (auto p: p_in) {
@@ -37,6 +37,16 @@ public:
     CommandExecutor(ostream& out);
     void init();
     void executeLine(const string& line);
+    /// Execute a line without printing its result or adding it to the buffer, for batch mode.
+    /// Return true if a meaningful result is returned in result.
+    bool executeLine(const string& line, string& result);
+    /// Print a result and add it to the buffer, as after an executed line
+    void addResult(const string& result);
+    /// Take over the active coin and the mnemonic of another executor
+    void copyState(const CommandExecutor& other);
+    /// Whether the line only depends on the active coin and mnemonic, and changes no state,
+    /// so that it can run in parallel with its neighbours in batch mode.
+    static bool isStateless(const string& line);
 
 protected:
     /// Put result in res.  Return true if meaningful result is returned. 
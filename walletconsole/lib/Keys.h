@@ -9,6 +9,7 @@
 #include "Coins.h"
 #include "HexCoding.h"
 #include "Data.h"
+#include "memory/secure_allocator.h"
 
 #include <string>
 #include <iostream>
@@ -21,7 +22,7 @@ class Keys {
 private:
     ostream& _out;
     const Coins& _coins;
-    string _currentMnemonic;
+    SecureString _currentMnemonic;
     
 public:
     Keys(ostream& out, const Coins& coins);
@@ -29,7 +30,9 @@ public:
     /// Public key from private key, ED25519
     bool pubPri(const string& coinid, const string& p, string& res);
     bool priPub(const string& p, string& res);
-    string getMnemo() const { return _currentMnemonic; }
+    const SecureString& getMnemo() const { return _currentMnemonic; }
+    /// Set a mnemonic taken from another instance, no check
+    void restoreMnemonic(const SecureString& mnemonic) { _currentMnemonic = mnemonic; }
     /// Set given mnemonic; list of separate words
     void setMnemonic(const vector<string>& param);
     /// Generate and store new mnemonic
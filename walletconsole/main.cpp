@@ -5,9 +5,56 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "WalletConsole.h"
+#include "BatchRunner.h"
+
+#include <fstream>
 #include <iostream>
+#include <string>
+
+static void usage() {
+    std::cerr << "Usage: walletconsole [--batch [<file>|-]] [--threads <n>]" << std::endl;
+    std::cerr << "  --batch    Run the commands of the file (default: stdin), one per line or as JSON lines" << std::endl;
+    std::cerr << "  --threads  Number of parallel workers in batch mode (default: hardware concurrency)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    bool batch = false;
+    std::string file = "-";
+    std::size_t threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                file = argv[++i];
+            } else if (i + 1 < argc && std::string(argv[i + 1]) == "-") {
+                ++i;
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!batch) {
+        TW::WalletConsole::WalletConsole console(std::cin, std::cout);
+        console.loop();
+        return 0;
+    }
 
-int main() {
-    TW::WalletConsole::WalletConsole console(std::cin, std::cout);
-    console.loop();
+    TW::WalletConsole::BatchRunner runner(std::cout, threads);
+    runner.init();
+    if (file == "-") {
+        runner.run(std::cin);
+        return 0;
+    }
+    std::ifstream in(file);
+    if (!in) {
+        std::cerr << "Cannot open " << file << std::endl;
+        return 1;
+    }
+    runner.run(in);
+    return 0;
 }
@@ -0,0 +1,54 @@
+// Copyright © 2017-2023 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// The binding benchmarks of benchmarks/BindingBenchmarks.cpp through the wasm wrapper, see `npm run bench`.
+// Compare `BM_Binding/<operation>/wasm` with `BM_Binding/<operation>/c` of the native run for the wrapper overhead.
+
+import { initWasm } from "../dist";
+
+const iterations = 2000;
+const mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const ethereumInput = "0a0101120109220504a817c8002a025208422a3078333533353335333533353335333533353335333533353335333533353335333533353335333533354a204646464646464646464646464646464646464646464646464646464646464646520c0a0a0a080de0b6b3a7640000";
+const bitcoinInput = "080110b0ff8ea001180122223142703955316f675633413134464d764b62524a6d7337637479736f345a345463782a2231465163354c646747484d48454e396e776b6a6d7a3674576b7868507078427642553220619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9424a0a2a0a20ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a100118ffffffff0f121600141d0f172a0ecb48aee1be1f2687d2963ae33f71a118808c8d9e02";
+
+// Runs `body`, which returns the number of bytes copied across the binding, and prints the time and the copied bytes per call.
+function run(operation: string, body: () => number) {
+  let copied = 0;
+  const start = process.hrtime();
+  for (let i = 0; i < iterations; ++i) {
+    copied += body();
+  }
+  const [seconds, nanoseconds] = process.hrtime(start);
+  const nsPerOp = (seconds * 1e9 + nanoseconds) / iterations;
+  console.log(`BM_Binding/${operation}/wasm ns_per_op=${nsPerOp.toFixed(0)} bytes_copied_per_op=${Math.round(copied / iterations)}`);
+}
+
+async function main() {
+  const { AnySigner, CoinType, HDWallet, Hash, HexCoding } = await initWasm();
+
+  const input = new Uint8Array(1024).fill(0x5a);
+  run("hash", () => input.length + Hash.keccak256(input).length);
+
+  const wallet = HDWallet.createWithMnemonic(mnemonic, "");
+  run("deriveAddress", () => Buffer.byteLength(wallet.getAddressForCoin(CoinType.ethereum)));
+  wallet.delete();
+
+  for (const [operation, hex, coin] of [
+    ["signEthereum", ethereumInput, CoinType.ethereum],
+    ["signBitcoin", bitcoinInput, CoinType.bitcoin],
+  ] as const) {
+    const data = HexCoding.decode(hex);
+    if (AnySigner.sign(data, coin).length === 0) {
+      throw new Error(`${operation} failed`);
+    }
+    run(operation, () => data.length + AnySigner.sign(data, coin).length);
+  }
+}
+
+main().catch((error) => {
+  console.error(error);
+  process.exit(1);
+});
@@ -5,11 +5,32 @@
 // file LICENSE at the root of the source code distribution tree.
 
 import * as Loader from "./lib/wallet-core";
+import * as SimdLoader from "./lib/wallet-core-simd";
 import { TW } from "./generated/core_proto";
 import { WalletCore } from "./src/wallet-core";
 import * as KeyStore from "./src/keystore";
 
 declare function load(): Promise<WalletCore>;
 
-export const initWasm: typeof load = Loader;
+// Smallest module using a SIMD instruction (i8x16.splat, i8x16.popcnt).
+const simdProbe = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+// Whether the runtime can run the SIMD and threads module: Wasm SIMD, and shared memory for the workers,
+// which browsers only grant to cross-origin isolated pages.
+export function supportsSimdThreads(): boolean {
+  try {
+    if (typeof SharedArrayBuffer === "undefined" || (globalThis as any).crossOriginIsolated === false) {
+      return false;
+    }
+    new WebAssembly.Memory({ initial: 1, maximum: 1, shared: true } as WebAssembly.MemoryDescriptor);
+    return WebAssembly.validate(simdProbe);
+  } catch {
+    return false;
+  }
+}
+
+// Loads the SIMD and threads module when the runtime supports it, the default module otherwise.
+export const initWasm: typeof load = () => (supportsSimdThreads() ? SimdLoader : Loader)();
 export { TW, WalletCore, KeyStore };
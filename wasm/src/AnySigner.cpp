@@ -17,26 +17,67 @@ namespace TW::Wasm {
 
 class AnySigner {
   public:
-    static auto sign(const std::string& string, TWCoinType coin) {
+    static auto sign(const val& input, TWCoinType coin) {
         Data out;
-        TW::anyCoinSign(coin, TW::data(string), out);
+        TW::anyCoinSign(coin, ValToData(input), out);
         return DataToVal(out);
     }
 
+    /// Returns a view of `size` bytes of the input buffer, which stays in the wasm heap between calls.
+    /// Write the signing input into it and call `signInput`, no copy is made on the way in.
+    /// The view is invalidated when the wasm memory grows, so it has to be written before any other call.
+    static auto inputBuffer(size_t size) {
+        auto& buffer = input();
+        buffer.resize(size);
+        return val(typed_memory_view(buffer.size(), buffer.data()));
+    }
+
+    /// Signs the content of the input buffer.
+    static auto signInput(TWCoinType coin) {
+        Data out;
+        TW::anyCoinSign(coin, input(), out);
+        return DataToVal(out);
+    }
+
+    /// Signs the inputs on `threads` workers, see `TWAnySignerSignBatch`.
+    /// Workers only run in parallel in the SIMD and threads build, the default build signs sequentially.
+    static auto signBatch(const val& inputs, TWCoinType coin, uint32_t threads) {
+        const auto count = inputs["length"].as<size_t>();
+        std::vector<Data> dataIn;
+        dataIn.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            dataIn.emplace_back(ValToData(inputs[i]));
+        }
+        auto outputs = val::array();
+        for (const auto& out : TW::anyCoinSignBatch(coin, dataIn, threads)) {
+            outputs.call<void>("push", DataToVal(out));
+        }
+        return outputs;
+    }
+
     static auto supportsJSON(TWCoinType coin) {
         return TW::supportsJSONSigning(coin);
     }
 
-    static auto plan(const std::string& string, TWCoinType coin) {
+    static auto plan(const val& input, TWCoinType coin) {
         Data out;
-        TW::anyCoinPlan(coin, TW::data(string), out);
+        TW::anyCoinPlan(coin, ValToData(input), out);
         return DataToVal(out);
     }
+
+  private:
+    static Data& input() {
+        static Data buffer;
+        return buffer;
+    }
 };
 
 EMSCRIPTEN_BINDINGS(Wasm_TWAnySigner) {
     class_<AnySigner>("AnySigner")
         .class_function("sign", &AnySigner::sign)
+        .class_function("signBatch", &AnySigner::signBatch)
+        .class_function("inputBuffer", &AnySigner::inputBuffer)
+        .class_function("signInput", &AnySigner::signInput)
         .class_function("plan", &AnySigner::plan)
         .class_function("supportsJSON", &AnySigner::supportsJSON);
 }
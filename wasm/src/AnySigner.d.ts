@@ -1,5 +1,8 @@
 export class AnySigner {
     static sign(data: Uint8Array | Buffer, coin: CoinType): Uint8Array;
+    static signBatch(data: (Uint8Array | Buffer)[], coin: CoinType, threads: number): Uint8Array[];
+    static inputBuffer(size: number): Uint8Array;
+    static signInput(coin: CoinType): Uint8Array;
     static plan(data: Uint8Array | Buffer, coin: CoinType): Uint8Array;
     static supportsJSON(coin: CoinType): boolean;
 }
@@ -12,13 +12,19 @@ using namespace emscripten;
 
 namespace TW::Wasm {
 
-auto DataToVal(Data data) -> val {
+auto DataToVal(const Data& data) -> val {
     auto view = val(typed_memory_view(data.size(), data.data()));
     auto jsArray = val::global("Uint8Array").new_(data.size());
     jsArray.call<void>("set", view);
     return jsArray;
 }
 
+auto ValToData(const val& array) -> Data {
+    Data data(array["length"].as<size_t>());
+    val(typed_memory_view(data.size(), data.data())).call<void>("set", array);
+    return data;
+}
+
 auto TWDataToVal(TWData* _Nonnull data) -> val {
     defer {
         TWDataDelete(data);
@@ -14,7 +14,10 @@
 
 namespace TW::Wasm {
 
-auto DataToVal(Data data) -> emscripten::val;
+auto DataToVal(const Data& data) -> emscripten::val;
+
+/// Converts a Uint8Array (or Buffer) to Data, with one bulk copy straight into the wasm heap.
+auto ValToData(const emscripten::val& array) -> Data;
 
 /// Converts a TWData * to Uint8Array, deleting the TWData * when done.
 auto TWDataToVal(TWData *_Nonnull data) -> emscripten::val;
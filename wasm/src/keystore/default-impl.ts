@@ -4,10 +4,13 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
-import {WalletCore, CoinType, PrivateKey, StoredKey, StoredKeyEncryption} from "../wallet-core";
+import {WalletCore, CoinType, DataVector, PrivateKey, StoredKey, StoredKeyEncryption} from "../wallet-core";
 import * as Types from "./types";
 
 export class Default implements Types.IKeyStore {
+  // Number of wallets of each call into the module by the bulk operations, between progress callbacks
+  static readonly batchSize = 16;
+
   private readonly core: WalletCore;
   private readonly storage: Types.IStorage;
 
@@ -31,6 +34,10 @@ export class Default implements Types.IKeyStore {
     return this.storage.loadAll();
   }
 
+  loadBatch(ids: string[]): Promise<Types.Wallet[]> {
+    return this.storage.getMany(ids);
+  }
+
   delete(id: string, password: string): Promise<void> {
     return this.storage.delete(id, password);
   }
@@ -79,6 +86,49 @@ export class Default implements Types.IKeyStore {
     });
   }
 
+  importBatch(
+    entries: Types.MnemonicEntry[],
+    password: string,
+    coins: CoinType[],
+    encryption: StoredKeyEncryption,
+    onProgress?: Types.Progress
+  ): Promise<Types.Wallet[]> {
+    const { Mnemonic, StoredKey, HDWallet } = this.core;
+    if (entries.some((entry) => !Mnemonic.isValid(entry.mnemonic))) {
+      return Promise.reject(Types.Error.InvalidMnemonic);
+    }
+    let pass = Buffer.from(password);
+    return this.inBatches(
+      entries,
+      (batch) => {
+        let mnemonics = this.dataVector(batch.map((entry) => Buffer.from(entry.mnemonic)));
+        let names = this.dataVector(batch.map((entry) => Buffer.from(entry.name)));
+        let jsons = StoredKey.importHDWalletBatch(mnemonics, names, pass, coins[0], encryption, 0);
+        mnemonics.delete();
+        names.delete();
+        let wallets = batch.map((entry, index) => {
+          let json = jsons.get(index);
+          if (json.length === 0) {
+            throw Types.Error.InvalidMnemonic;
+          }
+          let storedKey = StoredKey.importJSON(json);
+          // the other accounts are derived from the mnemonic, without decrypting the new key
+          let hdWallet = HDWallet.createWithMnemonic(entry.mnemonic, "");
+          coins.slice(1).forEach((coin) => {
+            storedKey.accountForCoin(coin, hdWallet);
+          });
+          let wallet = this.mapWallet(storedKey);
+          storedKey.delete();
+          hdWallet.delete();
+          return wallet;
+        });
+        jsons.delete();
+        return wallets;
+      },
+      onProgress
+    ).then((wallets) => this.storage.setMany(wallets).then(() => wallets));
+  }
+
   importKey(
     key: Uint8Array,
     name: string,
@@ -158,4 +208,68 @@ export class Default implements Types.IKeyStore {
       return value;
     });
   }
+
+  exportBatch(
+    ids: string[],
+    password: string,
+    onProgress?: Types.Progress
+  ): Promise<(string | Uint8Array)[]> {
+    let pass = Buffer.from(password);
+    return this.loadBatch(ids).then((wallets) => {
+      wallets.forEach((wallet) => {
+        if (wallet.type !== Types.WalletType.Mnemonic && wallet.type !== Types.WalletType.PrivateKey) {
+          throw Types.Error.InvalidJSON;
+        }
+      });
+      return this.inBatches(
+        wallets,
+        (batch) => {
+          let jsons = this.dataVector(batch.map((wallet) => Buffer.from(JSON.stringify(wallet))));
+          let secrets = this.core.StoredKey.decryptJSONBatch(jsons, pass, 0);
+          jsons.delete();
+          let values = batch.map((wallet, index) => {
+            let secret = secrets.get(index);
+            if (secret.length === 0) {
+              throw Types.Error.InvalidPassword;
+            }
+            return wallet.type === Types.WalletType.Mnemonic
+              ? Buffer.from(secret).toString()
+              : secret;
+          });
+          secrets.delete();
+          return values;
+        },
+        onProgress
+      );
+    });
+  }
+
+  private dataVector(items: Uint8Array[]): DataVector {
+    let vector = this.core.DataVector.create();
+    items.forEach((item) => vector.add(item));
+    return vector;
+  }
+
+  // Runs `run` on consecutive batches of `items`, yielding to the event loop before each batch and reporting the
+  // progress after it
+  private inBatches<T, R>(
+    items: T[],
+    run: (batch: T[]) => R[],
+    onProgress?: Types.Progress
+  ): Promise<R[]> {
+    let results: R[] = [];
+    let chain = Promise.resolve();
+    for (let start = 0; start < items.length; start += Default.batchSize) {
+      chain = chain
+        .then(() => new Promise<void>((resolve) => setTimeout(resolve, 0)))
+        .then(() => {
+          let batch = items.slice(start, start + Default.batchSize);
+          results = results.concat(run(batch));
+          if (onProgress) {
+            onProgress(start + batch.length, items.length);
+          }
+        });
+    }
+    return chain.then(() => results);
+  }
 }
@@ -27,6 +27,21 @@ export class ExtensionStorage implements Types.IStorage {
     });
   }
 
+  getMany(ids: string[]): Promise<Types.Wallet[]> {
+    if (ids.length === 0) {
+      return Promise.resolve([]);
+    }
+    return this.storage.get(ids).then((object) =>
+      ids.map((id) => {
+        let wallet = object[id];
+        if (wallet === undefined) {
+          throw Types.Error.WalletNotFound;
+        }
+        return wallet as Types.Wallet;
+      })
+    );
+  }
+
   set(id: string, wallet: Types.Wallet): Promise<void> {
     return this.getWalletIds().then((ids) => {
       if (ids.indexOf(id) === -1) {
@@ -39,6 +54,21 @@ export class ExtensionStorage implements Types.IStorage {
     });
   }
 
+  // Stores the wallets and their ids in a single write
+  setMany(wallets: Types.Wallet[]): Promise<void> {
+    return this.getWalletIds().then((ids) => {
+      let items: Record<string, any> = {};
+      wallets.forEach((wallet) => {
+        if (ids.indexOf(wallet.id) === -1) {
+          ids.push(wallet.id);
+        }
+        items[wallet.id] = wallet;
+      });
+      items[this.walletIdsKey] = ids;
+      return this.storage.set(items);
+    });
+  }
+
   loadAll(): Promise<Types.Wallet[]> {
     return this.getWalletIds().then((ids) => {
       if (ids.length === 0) {
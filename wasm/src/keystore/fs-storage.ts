@@ -25,10 +25,18 @@ export class FileSystemStorage implements Types.IStorage {
       .then((data) => JSON.parse(data.toString()) as Types.Wallet);
   }
 
+  getMany(ids: string[]): Promise<Types.Wallet[]> {
+    return Promise.all(ids.map((id) => this.get(id)));
+  }
+
   set(id: string, wallet: Types.Wallet): Promise<void> {
     return fs.writeFile(this.getFilename(id), JSON.stringify(wallet));
   }
 
+  setMany(wallets: Types.Wallet[]): Promise<void> {
+    return Promise.all(wallets.map((wallet) => this.set(wallet.id, wallet))).then(() => {});
+  }
+
   loadAll(): Promise<Types.Wallet[]> {
     return fs.readdir(this.directory).then((files) => {
       return Promise.all(
@@ -39,6 +39,14 @@ export interface Wallet {
   activeAccounts: ActiveAccount[];
 }
 
+// Progress of a bulk operation, called after each batch of wallets
+export type Progress = (done: number, total: number) => void;
+
+export interface MnemonicEntry {
+  mnemonic: string;
+  name: string;
+}
+
 export interface IKeyStore {
   // Check if wallet id exists
   hasWallet(id: string): Promise<boolean>;
@@ -49,6 +57,9 @@ export interface IKeyStore {
   // Load all wallets
   loadAll(): Promise<Wallet[]>;
 
+  // Load wallets by wallet ids
+  loadBatch(ids: string[]): Promise<Wallet[]>;
+
   // Import a wallet by mnemonic, name, password and initial active accounts (from coinTypes)
   import(
     mnemonic: string,
@@ -58,6 +69,16 @@ export interface IKeyStore {
     encryption: StoredKeyEncryption
   ): Promise<Wallet>;
 
+  // Import wallets by mnemonic and name, sharing a password and the initial active accounts (from coinTypes).
+  // The keys are encrypted in batches, on worker threads with the pthreads build of the module
+  importBatch(
+    entries: MnemonicEntry[],
+    password: string,
+    coins: CoinType[],
+    encryption: StoredKeyEncryption,
+    onProgress?: Progress
+  ): Promise<Wallet[]>;
+
   // Import a wallet by private key, name and password
   importKey(
     key: Uint8Array,
@@ -85,11 +106,21 @@ export interface IKeyStore {
 
   // Export a wallet by wallet id and password, returns mnemonic or private key
   export(id: string, password: string): Promise<string | Uint8Array>;
+
+  // Export wallets sharing a password by wallet ids, returns their mnemonics or private keys.
+  // The keys are decrypted in batches, on worker threads with the pthreads build of the module
+  exportBatch(
+    ids: string[],
+    password: string,
+    onProgress?: Progress
+  ): Promise<(string | Uint8Array)[]>;
 }
 
 export interface IStorage {
   get(id: string): Promise<Wallet>;
+  getMany(ids: string[]): Promise<Wallet[]>;
   set(id: string, wallet: Wallet): Promise<void>;
+  setMany(wallets: Wallet[]): Promise<void>;
   loadAll(): Promise<Wallet[]>;
   delete(id: string, password: string): Promise<void>;
 }
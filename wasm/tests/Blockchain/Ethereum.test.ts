@@ -67,6 +67,50 @@ describe("Ethereum", () => {
     );
   });
 
+  it("test batch signing transfer txs", () => {
+    const { HexCoding, AnySigner, CoinType } = globalThis.core;
+    const input = TW.Ethereum.Proto.SigningInput.create({
+      toAddress: "0x3535353535353535353535353535353535353535",
+      chainId: Buffer.from("01", "hex"),
+      nonce: Buffer.from("09", "hex"),
+      gasPrice: Buffer.from("04a817c800", "hex"),
+      gasLimit: Buffer.from("5208", "hex"),
+      transaction: TW.Ethereum.Proto.Transaction.create({
+        transfer: TW.Ethereum.Proto.Transaction.Transfer.create({
+          amount: Buffer.from("0de0b6b3a7640000", "hex"),
+        }),
+      }),
+      privateKey: HexCoding.decode(
+        "4646464646464646464646464646464646464646464646464646464646464646"
+      ),
+    });
+    const encoded = TW.Ethereum.Proto.SigningInput.encode(input).finish();
+
+    const outputs = AnySigner.signBatch([encoded, encoded, encoded], CoinType.ethereum, 2);
+    assert.equal(outputs.length, 3);
+    for (const outputData of outputs) {
+      const output = TW.Ethereum.Proto.SigningOutput.decode(outputData);
+      assert.equal(
+        HexCoding.encode(output.encoded),
+        "0xf86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83"
+      );
+    }
+  });
+
+  it("test signing from the input buffer", () => {
+    const { HexCoding, AnySigner, CoinType } = globalThis.core;
+    const encoded = HexCoding.decode(
+      "0x0a0101120109220504a817c8002a025208422a3078333533353335333533353335333533353335333533353335333533353335333533353335333533354a204646464646464646464646464646464646464646464646464646464646464646520c0a0a0a080de0b6b3a7640000"
+    );
+
+    AnySigner.inputBuffer(encoded.length).set(encoded);
+    const output = TW.Ethereum.Proto.SigningOutput.decode(AnySigner.signInput(CoinType.ethereum));
+    assert.equal(
+      HexCoding.encode(output.encoded),
+      "0xf86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83"
+    );
+  });
+
   it("test signing eip1559 erc20 transfer tx", () => {
     const { HexCoding, AnySigner, CoinType } = globalThis.core;;
 
@@ -125,4 +125,49 @@ describe("KeyStore", async () => {
       keystore.delete(w.id, password);
     });
   }).timeout(10000);
+
+  it("test FileSystemStorage bulk operations", async () => {
+    const { CoinType, StoredKeyEncryption } = globalThis.core;
+    const mnemonic = globalThis.mnemonic as string;
+    const password = globalThis.password as string;
+    const testDir = "/tmp/wasm-test-bulk";
+
+    fs.mkdirSync(testDir, { recursive: true });
+
+    const storage = new KeyStore.FileSystemStorage(testDir);
+    const keystore = new KeyStore.Default(globalThis.core, storage);
+
+    const entries = [0, 1, 2].map((i) => ({ mnemonic: mnemonic, name: "Bulk" + i }));
+    const progress: number[] = [];
+    const wallets = await keystore.importBatch(entries, password, [
+      CoinType.bitcoin,
+      CoinType.ethereum,
+    ], StoredKeyEncryption.aes128Ctr, (done, total) => progress.push(done, total));
+
+    assert.deepEqual(progress, [3, 3]);
+    assert.equal(wallets.length, 3);
+    wallets.forEach((wallet, i) => {
+      assert.equal(wallet.name, "Bulk" + i);
+      assert.equal(wallet.activeAccounts.length, 2);
+      assert.equal(wallet.activeAccounts[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    });
+
+    const ids = wallets.map((wallet) => wallet.id);
+    const loaded = await keystore.loadBatch(ids);
+    assert.deepEqual(loaded.map((wallet) => wallet.name), ["Bulk0", "Bulk1", "Bulk2"]);
+
+    const exported = await keystore.exportBatch(ids, password);
+    assert.deepEqual(exported, [mnemonic, mnemonic, mnemonic]);
+
+    try {
+      await keystore.exportBatch(ids, "wrong password");
+      assert.fail("expected an invalid password");
+    } catch (error) {
+      assert.equal(error, KeyStore.Error.InvalidPassword);
+    }
+
+    for (const id of ids) {
+      await keystore.delete(id, password);
+    }
+  }).timeout(20000);
 });